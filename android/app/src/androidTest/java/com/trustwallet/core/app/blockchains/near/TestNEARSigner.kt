@@ -2,6 +2,7 @@ package com.trustwallet.core.app.blockchains.solana
 
 import com.google.protobuf.ByteString
 import com.trustwallet.core.app.utils.toHexByteArray
+import java.nio.ByteBuffer
 import java.util.Base64
 import org.junit.Assert.assertEquals
 import org.junit.Test
@@ -17,12 +18,11 @@ class TestNEARSigner {
         System.loadLibrary("TrustWalletCore")
     }
 
-    @Test
-    fun testTransferSign() {
+    private fun signingInput(): NEAR.SigningInput {
         val transferAction = NEAR.Transfer.newBuilder().apply {
             deposit = ByteString.copyFrom("01000000000000000000000000000000".toHexByteArray())
         }.build()
-        val signingInput = NEAR.SigningInput.newBuilder().apply {
+        return NEAR.SigningInput.newBuilder().apply {
             signerId = "test.near"
             nonce = 1
             receiverId = "whatever.near"
@@ -32,11 +32,34 @@ class TestNEARSigner {
             blockHash = ByteString.copyFrom(Base58.decodeNoCheck("244ZQ9cgj3CQ6bWBdytfrJMuMQ1jdXLFGnr4HhvtCTnM"))
             privateKey = ByteString.copyFrom(Base58.decodeNoCheck("3hoMW1HvnRLSFCLZnvPzWeoGwtdHzke34B2cTHM8rhcbG3TbuLKtShTv3DvyejnXKXKBiV7YPkLeqUHN1ghnqpFv").sliceArray(0..31))
         }.build()
+    }
 
-        val output = AnySigner.sign(signingInput, CoinType.NEAR, SigningOutput.parser())
+    @Test
+    fun testTransferSign() {
+        val output = AnySigner.sign(signingInput(), CoinType.NEAR, SigningOutput.parser())
 
         val expectedBase64String = "CQAAAHRlc3QubmVhcgCRez0mjUtY9/7BsVC9aNab4+5dTMOYVeNBU4Rlu3eGDQEAAAAAAAAADQAAAHdoYXRldmVyLm5lYXIPpHP9JpAd8pa+atxMxN800EDvokNSJLaYaRDmMML+9gEAAAADAQAAAAAAAAAAAAAAAAAAAACWmoMzIYbul1Xkg5MlUlgG4Ymj0tK7S0dg6URD6X4cTyLe7vAFmo6XExAO2m4ZFE2n6KDvflObIHCLodjQIb0B"
         assertEquals(Base64.getEncoder().encodeToString(output.signedTransaction.toByteArray()), expectedBase64String)
     }
 
+    @Test
+    fun testTransferSignDirect() {
+        val scratch = ByteBuffer.allocateDirect(1024)
+        val output = ByteBuffer.allocateDirect(1024)
+        val expected = AnySigner.sign(signingInput(), CoinType.NEAR, SigningOutput.parser())
+
+        // Buffers are reused across calls
+        for (i in 0..1) {
+            val signed = AnySigner.sign(signingInput(), CoinType.NEAR, SigningOutput.parser(), scratch, output)
+            assertEquals(signed, expected)
+        }
+
+        val input = ByteBuffer.allocateDirect(1024)
+        input.put(signingInput().toByteArray())
+        input.flip()
+        val small = ByteBuffer.allocateDirect(8)
+        val size = AnySigner.signDirect(input, small, CoinType.NEAR)
+        assertEquals(-expected.serializedSize, size)
+        assertEquals(0, small.position())
+    }
 }
@@ -0,0 +1,210 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+#include "Coin.h"
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Aeternity.pb.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Cosmos.pb.h"
+#include "proto/Ethereum.pb.h"
+#include "proto/NULS.pb.h"
+#include "proto/Nimiq.pb.h"
+#include "proto/Solana.pb.h"
+
+#include <TrustWalletCore/TWBitcoinSigHashType.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+
+// Signing inputs of the unit tests
+
+static Data serialize(const google::protobuf::Message& message) {
+    const auto serialized = message.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+static Data ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return serialize(input);
+}
+
+static Data bitcoinInput() {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_amount(335'790'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_coin_type(TWCoinTypeBitcoin);
+
+    const auto key0 = parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866");
+    const auto key1 = parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9");
+    input.add_private_key(key0.data(), key0.size());
+    input.add_private_key(key1.data(), key1.size());
+
+    const auto hash0 = parse_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f");
+    const auto script0 = parse_hex("2103c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432ac");
+    auto utxo0 = input.add_utxo();
+    utxo0->set_script(script0.data(), script0.size());
+    utxo0->set_amount(625'000'000);
+    utxo0->mutable_out_point()->set_hash(hash0.data(), hash0.size());
+    utxo0->mutable_out_point()->set_index(0);
+    utxo0->mutable_out_point()->set_sequence(UINT32_MAX);
+
+    const auto hash1 = parse_hex("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
+    const auto script1 = parse_hex("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+    auto utxo1 = input.add_utxo();
+    utxo1->set_script(script1.data(), script1.size());
+    utxo1->set_amount(600'000'000);
+    utxo1->mutable_out_point()->set_hash(hash1.data(), hash1.size());
+    utxo1->mutable_out_point()->set_index(1);
+    utxo1->mutable_out_point()->set_sequence(UINT32_MAX);
+    return serialize(input);
+}
+
+static Data cosmosInput() {
+    Cosmos::Proto::SigningInput input;
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_sequence(8);
+    auto& message = *input.add_messages()->mutable_send_coins_message();
+    message.set_from_address("cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02");
+    message.set_to_address("cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573");
+    auto amount = message.add_amounts();
+    amount->set_denom("muon");
+    amount->set_amount(1);
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(200000);
+    auto feeAmount = fee.add_amounts();
+    feeAmount->set_denom("muon");
+    feeAmount->set_amount(200);
+    const auto key = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(key.data(), key.size());
+    return serialize(input);
+}
+
+static Data solanaInput() {
+    Solana::Proto::SigningInput input;
+    const auto key = Base58::bitcoin.decode("A7psj2GW7ZMdY4E5hJq14KMeYg7HFjULSsWSrTXZLvYr");
+    auto& message = *input.mutable_transfer_transaction();
+    message.set_recipient("EN2sCsJ1WDV8UFqsiTXHcUPUxQ4juE71eCknHYYMifkd");
+    message.set_value(42);
+    input.set_private_key(key.data(), key.size());
+    input.set_recent_blockhash("11111111111111111111111111111111");
+    return serialize(input);
+}
+
+static Data nimiqInput() {
+    Nimiq::Proto::SigningInput input;
+    const auto key = parse_hex("e3cc33575834add098f8487123cd4bca543ee859b3e8cfe624e7e6a97202b756");
+    input.set_destination("NQ86 2H8F YGU5 RM77 QSN9 LYLH C56A CYYR 0MLA");
+    input.set_fee(1000);
+    input.set_value(42042042);
+    input.set_validity_start_height(314159);
+    input.set_private_key(key.data(), key.size());
+    return serialize(input);
+}
+
+static Data nulsInput() {
+    NULS::Proto::SigningInput input;
+    const auto key = parse_hex("9ce21dad67e0f0af2599b41b515a7f7018059418bab892a7b68f283d489abc4b");
+    const auto amount = store(uint256_t(10000000));
+    const auto balance = store(uint256_t(100000000));
+    const std::string nonce = "0000000000000000";
+    input.set_from("NULSd6Hgj7ZoVgsPN9ybB4C1N2TbvkgLc8Z9H");
+    input.set_to("NULSd6Hgied7ym6qMEfVzZanMaa9qeqA6TZSe");
+    input.set_amount(amount.data(), amount.size());
+    input.set_chain_id(1);
+    input.set_idassets_id(1);
+    input.set_private_key(key.data(), key.size());
+    input.set_balance(balance.data(), balance.size());
+    input.set_timestamp(1569228280);
+    input.set_nonce(nonce.data(), nonce.size());
+    return serialize(input);
+}
+
+static Data aeternityInput() {
+    Aeternity::Proto::SigningInput input;
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    const auto amount = store(uint256_t(10));
+    const auto fee = store(uint256_t(20000000000000));
+    input.set_from_address("ak_2p5878zbFhxnrm7meL7TmqwtvBaqcBddyp5eGzZbovZ5FeVfcw");
+    input.set_to_address("ak_Egp9yVdpxmvAfQ7vsXGvpnyfNq71msbdUpkMNYGTeTe8kPL3v");
+    input.set_amount(amount.data(), amount.size());
+    input.set_fee(fee.data(), fee.size());
+    input.set_payload("Hello World");
+    input.set_ttl(82757);
+    input.set_nonce(49);
+    input.set_private_key(key.data(), key.size());
+    return serialize(input);
+}
+
+static Data signingInput(TWCoinType coin) {
+    switch (coin) {
+    case TWCoinTypeBitcoin:
+        return bitcoinInput();
+    case TWCoinTypeCosmos:
+        return cosmosInput();
+    case TWCoinTypeSolana:
+        return solanaInput();
+    case TWCoinTypeNimiq:
+        return nimiqInput();
+    case TWCoinTypeNULS:
+        return nulsInput();
+    case TWCoinTypeAeternity:
+        return aeternityInput();
+    default:
+        return ethereumInput();
+    }
+}
+
+static void BM_AnyCoinSign(benchmark::State& state) {
+    const auto coin = static_cast<TWCoinType>(state.range(0));
+    const auto input = signingInput(coin);
+    for (auto _ : state) {
+        Data output;
+        anyCoinSign(coin, input, output);
+        benchmark::DoNotOptimize(output);
+    }
+}
+BENCHMARK(BM_AnyCoinSign)
+    ->ArgName("coin")
+    ->Arg(TWCoinTypeBitcoin)
+    ->Arg(TWCoinTypeEthereum)
+    ->Arg(TWCoinTypeCosmos)
+    ->Arg(TWCoinTypeSolana)
+    ->Arg(TWCoinTypeNimiq)
+    ->Arg(TWCoinTypeNULS)
+    ->Arg(TWCoinTypeAeternity);
+
+static void BM_AnyCoinSignBatch(benchmark::State& state) {
+    const auto inputs = std::vector<std::pair<TWCoinType, Data>>(state.range(0), {TWCoinTypeEthereum, ethereumInput()});
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(anyCoinSignBatch(inputs, static_cast<size_t>(state.range(1))));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_AnyCoinSignBatch)
+    ->ArgNames({"count", "threads"})
+    ->ArgsProduct({{100}, {1, 0}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,50 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BulkDerivation.h"
+#include "Coin.h"
+#include "Mnemonic.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+using namespace TW;
+
+/// Candidates of a recovery with the last two words forgotten: one in 16 has a valid checksum.
+static std::vector<std::string> lastWordCandidates(std::size_t count) {
+    const std::string prefix = "credit expect life fade cover suit response wash pear what ";
+    const std::vector<std::string> words = {
+        "ripple", "scissors", "kick", "mammal", "hire", "column", "oak", "again", "sun", "offer", "wealth", "tomorrow",
+        "wagon", "turn", "fatal", "shoot", "island", "position", "soft", "burden", "budget", "tooth", "cruel", "issue",
+        "economy", "destroy", "above", "skull", "force", "credit", "expect", "life"};
+    std::vector<std::string> candidates;
+    for (std::size_t i = 0; i < count; ++i) {
+        candidates.push_back(prefix + words[i / words.size() % words.size()] + " " + words[i % words.size()]);
+    }
+    return candidates;
+}
+
+static void BM_BulkDeriveAddresses(benchmark::State& state) {
+    const auto coin = static_cast<TWCoinType>(state.range(0));
+    const auto deriver = BulkDeriver(coin, {TW::derivationPath(coin)});
+    const auto candidates = lastWordCandidates(static_cast<std::size_t>(state.range(1)));
+    std::size_t valid = 0;
+    for (const auto& candidate : candidates) {
+        valid += Mnemonic::isValid(candidate) ? 1 : 0;
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(deriver.derive(candidates, {""}));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(1));
+    state.counters["valid"] = static_cast<double>(valid);
+}
+BENCHMARK(BM_BulkDeriveAddresses)
+    ->ArgNames({"coin", "candidates"})
+    ->ArgsProduct({{TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeSolana}, {64, 1024}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
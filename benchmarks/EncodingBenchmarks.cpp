@@ -0,0 +1,72 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+#include "Bech32.h"
+#include "HexCoding.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+
+static void BM_Base58Encode(benchmark::State& state) {
+    const auto data = Data(state.range(0), 0xa5);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base58::bitcoin.encode(data));
+    }
+}
+BENCHMARK(BM_Base58Encode)->Arg(25)->Arg(32)->Arg(64)->Arg(256);
+
+static void BM_Base58Decode(benchmark::State& state) {
+    const auto encoded = Base58::bitcoin.encode(Data(state.range(0), 0xa5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base58::bitcoin.decode(encoded));
+    }
+}
+BENCHMARK(BM_Base58Decode)->Arg(25)->Arg(32)->Arg(64)->Arg(256);
+
+static void BM_Base58DecodeCheckAddress(benchmark::State& state) {
+    const std::string address = "1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx";
+    std::array<byte, 21> payload;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Base58::bitcoin.decodeCheck(address, payload));
+    }
+}
+BENCHMARK(BM_Base58DecodeCheckAddress);
+
+static void BM_Bech32Encode(benchmark::State& state) {
+    // 5-bit groups of a 20-byte witness program
+    const auto values = Data(32, 0x0f);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Bech32::encode("bc", values, Bech32::ChecksumVariant::Bech32));
+    }
+}
+BENCHMARK(BM_Bech32Encode);
+
+static void BM_Bech32Decode(benchmark::State& state) {
+    const std::string address = "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Bech32::decode(address));
+    }
+}
+BENCHMARK(BM_Bech32Decode);
+
+static void BM_Bech32Verifier(benchmark::State& state) {
+    const auto verifier = Bech32::Verifier("bc");
+    const std::string address = "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4";
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(verifier.verify(address));
+    }
+}
+BENCHMARK(BM_Bech32Verifier);
+
+static void BM_HexDecode(benchmark::State& state) {
+    const auto encoded = hex(Data(state.range(0), 0xa5));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(parse_hex(encoded));
+    }
+}
+BENCHMARK(BM_HexDecode)->Arg(32)->Arg(1024);
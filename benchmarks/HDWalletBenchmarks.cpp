@@ -0,0 +1,58 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+
+static const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+static void BM_HDWalletSeed(benchmark::State& state) {
+    uint64_t counter = 0;
+    for (auto _ : state) {
+        // the passphrase changes to bypass the seed cache
+        benchmark::DoNotOptimize(HDWallet(mnemonic, std::to_string(++counter)));
+    }
+}
+BENCHMARK(BM_HDWalletSeed)->Unit(benchmark::kMillisecond);
+
+static void BM_HDWalletGetKeyDepth(benchmark::State& state) {
+    const auto wallet = HDWallet(mnemonic, "");
+    auto indices = std::vector<DerivationPathIndex>{{44, true}, {0, true}, {0, true}};
+    while (indices.size() < static_cast<size_t>(state.range(0))) {
+        indices.emplace_back(static_cast<uint32_t>(indices.size()), false);
+    }
+    const auto path = DerivationPath(indices);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(wallet.getKey(TWCoinTypeBitcoin, path));
+    }
+}
+BENCHMARK(BM_HDWalletGetKeyDepth)->ArgName("depth")->DenseRange(3, 9, 2);
+
+static void BM_HDWalletDeriveAddressesWidth(benchmark::State& state) {
+    const auto coin = static_cast<TWCoinType>(state.range(0));
+    const auto wallet = HDWallet(mnemonic, "");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(wallet.deriveAddresses(coin, 0, 0, 0, static_cast<uint32_t>(state.range(1))));
+    }
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(1));
+}
+BENCHMARK(BM_HDWalletDeriveAddressesWidth)
+    ->ArgNames({"coin", "width"})
+    ->ArgsProduct({{TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeSolana}, {1, 20, 100}});
+
+static void BM_HDWalletDeriveAllCoins(benchmark::State& state) {
+    const auto wallet = HDWallet(mnemonic, "");
+    const auto coins = std::vector<TWCoinType>{TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeBinance, TWCoinTypeCosmos,
+                                               TWCoinTypeSolana, TWCoinTypePolkadot, TWCoinTypeTron, TWCoinTypeXRP};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(wallet.deriveAddresses(coins, 1));
+    }
+}
+BENCHMARK(BM_HDWalletDeriveAllCoins);
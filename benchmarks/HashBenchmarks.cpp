@@ -0,0 +1,46 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Hash.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+
+template <Data (*Hasher)(const byte*, size_t)>
+static void BM_Hash(benchmark::State& state) {
+    const auto data = Data(state.range(0), 0x5a);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hasher(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_Hash, Hash::sha256)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+BENCHMARK_TEMPLATE(BM_Hash, Hash::sha512)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+BENCHMARK_TEMPLATE(BM_Hash, Hash::keccak256)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+BENCHMARK_TEMPLATE(BM_Hash, Hash::sha3_256)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Hash, Hash::ripemd)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Hash, Hash::blake256)->Arg(32)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_Hash, Hash::groestl512)->Arg(32)->Arg(1024);
+
+static void BM_HashBlake2b(benchmark::State& state) {
+    const auto data = Data(state.range(0), 0x5a);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hash::blake2b(data, 32));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HashBlake2b)->Arg(32)->Arg(1024)->Arg(64 * 1024);
+
+static void BM_HashSha256d(benchmark::State& state) {
+    const auto data = Data(state.range(0), 0x5a);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Hash::sha256d(data.data(), data.size()));
+    }
+    state.SetBytesProcessed(int64_t(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_HashSha256d)->Arg(32)->Arg(1024);
@@ -0,0 +1,31 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+#include "Keystore/StoredKey.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+static const auto password = Data{'p', 'a', 's', 's', 'w', 'o', 'r', 'd'};
+static const auto keyData = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+
+static void BM_StoredKeyEncrypt(benchmark::State& state) {
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(StoredKey::createWithPrivateKey("name", password, keyData));
+    }
+}
+BENCHMARK(BM_StoredKeyEncrypt)->Unit(benchmark::kMillisecond);
+
+static void BM_StoredKeyUnlock(benchmark::State& state) {
+    auto key = StoredKey::createWithPrivateKey("name", password, keyData);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(key.privateKey(TWCoinTypeEthereum, password));
+    }
+}
+BENCHMARK(BM_StoredKeyUnlock)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,54 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+
+static const auto keyData = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+static const auto digest = parse_hex("b5bd079c4d57cc7fc28ecf8213a6b791625b8183d5dda2b5f3d0a66105c7b2e0");
+
+static void BM_PrivateKeySign(benchmark::State& state) {
+    const auto curve = static_cast<TWCurve>(state.range(0));
+    const auto key = PrivateKey(keyData);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(key.sign(digest, curve));
+    }
+}
+BENCHMARK(BM_PrivateKeySign)
+    ->ArgName("curve")
+    ->Arg(TWCurveSECP256k1)
+    ->Arg(TWCurveNIST256p1)
+    ->Arg(TWCurveED25519)
+    ->Arg(TWCurveED25519Blake2bNano)
+    ->Arg(TWCurveCurve25519);
+
+static void BM_PrivateKeyPublicKey(benchmark::State& state) {
+    const auto type = static_cast<TWPublicKeyType>(state.range(0));
+    const auto key = PrivateKey(keyData);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(key.getPublicKey(type));
+    }
+}
+BENCHMARK(BM_PrivateKeyPublicKey)
+    ->ArgName("type")
+    ->Arg(TWPublicKeyTypeSECP256k1)
+    ->Arg(TWPublicKeyTypeSECP256k1Extended)
+    ->Arg(TWPublicKeyTypeNIST256p1)
+    ->Arg(TWPublicKeyTypeED25519);
+
+static void BM_PublicKeyVerify(benchmark::State& state) {
+    const auto key = PrivateKey(keyData);
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto signature = key.sign(digest, TWCurveSECP256k1);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(publicKey.verify(signature, digest));
+    }
+}
+BENCHMARK(BM_PublicKeyVerify);
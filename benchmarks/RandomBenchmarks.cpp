@@ -0,0 +1,33 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Data.h"
+
+#include <TrezorCrypto/rand.h>
+
+#include <benchmark/benchmark.h>
+
+using namespace TW;
+
+static void BM_RandomBuffer(benchmark::State& state) {
+    Data buffer(state.range(0));
+    for (auto _ : state) {
+        random_buffer(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RandomBuffer)->Arg(16)->Arg(32)->Arg(4096)->ThreadRange(1, 8);
+
+static void BM_RandomEntropy(benchmark::State& state) {
+    Data buffer(state.range(0));
+    for (auto _ : state) {
+        random_entropy(buffer.data(), buffer.size());
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RandomEntropy)->Arg(32);
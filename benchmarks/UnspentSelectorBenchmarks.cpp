@@ -0,0 +1,43 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/UnspentSelector.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+static std::vector<Proto::UnspentTransaction> buildUtxos(size_t count) {
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int64_t> amounts(1'000, 10'000'000);
+    std::vector<Proto::UnspentTransaction> utxos(count);
+    for (auto& utxo : utxos) {
+        utxo.set_amount(amounts(random));
+    }
+    return utxos;
+}
+
+static void BM_UnspentSelectorSelect(benchmark::State& state) {
+    const auto utxos = buildUtxos(state.range(0));
+    const auto target = UnspentSelector::sum(utxos) / 3;
+    auto selector = UnspentSelector();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(selector.select(utxos, target, 10));
+    }
+}
+BENCHMARK(BM_UnspentSelectorSelect)->RangeMultiplier(10)->Range(10, 100'000)->Unit(benchmark::kMicrosecond);
+
+static void BM_UnspentSelectorSelectMaxAmount(benchmark::State& state) {
+    const auto utxos = buildUtxos(state.range(0));
+    auto selector = UnspentSelector();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(selector.selectMaxAmount(utxos, 10));
+    }
+}
+BENCHMARK(BM_UnspentSelectorSelectMaxAmount)->RangeMultiplier(10)->Range(10, 100'000)->Unit(benchmark::kMicrosecond);
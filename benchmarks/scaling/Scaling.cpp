@@ -0,0 +1,412 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Multi-core scaling benchmark: throughput of signing, derivation, address validation and keystore unlock
+// when many threads call the library at once, as a wallet backend serving parallel requests does.
+//
+// Usage: scaling [--threads=1,2,4,8,16,32,64] [--duration=<seconds per run>] [--workloads=sign,derive,validate,unlock]
+//                [--json=<results file>] [--baseline=<results file>] [--tolerance=<fraction>]
+//
+// For each workload and thread count, all threads run the operation for the duration; reported per run:
+// - ops/s, speedup over one thread, and efficiency (speedup over the number of threads, at most the hardware threads);
+// - cpu: CPU time of the process over the wall time of the threads that can run at once.  Below 100%, threads sleep
+//   waiting for each other, and vcsw/s (voluntary context switches per second) tells how often: a lock or a blocking call serializes them;
+// - cycles/op, instructions per cycle and last level cache misses per op, from the perf counters on Linux when
+//   available (see /proc/sys/kernel/perf_event_paranoid).  Full CPU despite a falling efficiency, with cycles/op and
+//   misses/op growing with the threads, point to cache lines bouncing between cores: false sharing, shared
+//   counters or caches written by all threads, or memory bandwidth.
+// With --baseline, the throughputs are compared with the same runs of an earlier --json output, the exit code is 2 if
+// one is below by more than the tolerance (0.1 by default).  See tools/scaling-benchmarks.
+
+#include "Coin.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+#include "Keystore/StoredKey.h"
+#include "uint256.h"
+#include "proto/Ethereum.pb.h"
+
+#include <nlohmann/json.hpp>
+
+#include <sys/resource.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+// Ethereum transfer of the signing unit tests
+Data ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+const auto password = TW::data("password");
+const auto keyData = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+
+const std::array<std::pair<TWCoinType, const char*>, 3> addresses = {{
+    {TWCoinTypeEthereum, "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed"},
+    {TWCoinTypeBitcoin, "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4"},
+    {TWCoinTypeBitcoin, "1BvBMSEYstWetqTFn5Au4m4GFg7xJaNVN2"},
+}};
+
+/// Operation of a thread, called with the number of operations it already ran.
+using Operation = std::function<void(uint64_t)>;
+
+/// A workload makes the operation of each thread, with its own state.
+struct Workload {
+    const char* name;
+    std::function<Operation(std::size_t thread)> prepare;
+};
+
+std::vector<Workload> workloads() {
+    // shared by all threads, as an app shares its wallet
+    static const auto wallet = HDWallet(mnemonic, "");
+    static const auto storedKey = StoredKey::createWithPrivateKey("name", password, keyData);
+    return {
+        {"sign", [](std::size_t) -> Operation {
+             auto output = Data();
+             return [input = ethereumInput(), output](uint64_t) mutable {
+                 anyCoinSign(TWCoinTypeEthereum, input, output);
+                 if (output.empty()) {
+                     std::abort();
+                 }
+             };
+         }},
+        {"derive", [](std::size_t thread) -> Operation {
+             return [thread](uint64_t count) {
+                 const auto path = DerivationPath(TWPurposeBIP44, 60, static_cast<uint32_t>(thread), 0, static_cast<uint32_t>(count));
+                 wallet.getKey(TWCoinTypeEthereum, path);
+             };
+         }},
+        {"validate", [](std::size_t) -> Operation {
+             return [](uint64_t count) {
+                 const auto& address = addresses[count % addresses.size()];
+                 if (!validateAddress(address.first, address.second)) {
+                     std::abort();
+                 }
+             };
+         }},
+        {"unlock", [](std::size_t) -> Operation {
+             auto key = storedKey;
+             return [key](uint64_t) mutable { key.privateKey(TWCoinTypeEthereum, password); };
+         }},
+    };
+}
+
+/// Hardware counters of the process, its threads included; off when they can't be opened.
+class PerfCounters {
+  public:
+    static constexpr std::size_t cycles = 0;
+    static constexpr std::size_t instructions = 1;
+    static constexpr std::size_t cacheMisses = 2;
+
+    /// Starts counting, for the threads created afterwards too.
+    PerfCounters() {
+#if defined(__linux__)
+        const std::array<uint64_t, 3> configs = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+        for (std::size_t i = 0; i < configs.size(); ++i) {
+            perf_event_attr attributes = {};
+            attributes.size = sizeof(attributes);
+            attributes.type = PERF_TYPE_HARDWARE;
+            attributes.config = configs[i];
+            attributes.inherit = 1;
+            // user space only, allowed with the default paranoid level
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            descriptors[i] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#if defined(__linux__)
+        for (const auto descriptor : descriptors) {
+            if (descriptor >= 0) {
+                close(descriptor);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// Count of a counter, of the exited threads included; -1 if not available.
+    double value(std::size_t counter) const {
+#if defined(__linux__)
+        uint64_t count = 0;
+        if (descriptors[counter] >= 0 && read(descriptors[counter], &count, sizeof(count)) == sizeof(count)) {
+            return static_cast<double>(count);
+        }
+#endif
+        return -1;
+    }
+
+  private:
+    std::array<int, 3> descriptors = {-1, -1, -1};
+};
+
+struct Result {
+    std::string workload;
+    std::size_t threads = 0;
+    double opsPerSecond = 0;
+    double speedup = 0;
+    double efficiency = 0;
+    double cpu = 0;
+    double voluntarySwitchesPerSecond = 0;
+    /// -1 when the counters are not available
+    double cyclesPerOp = -1;
+    double instructionsPerCycle = -1;
+    double cacheMissesPerOp = -1;
+};
+
+double seconds(const timeval& time) {
+    return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_usec) / 1e6;
+}
+
+/// Runs `threadCount` threads of the workload for `duration` seconds.
+Result run(const Workload& workload, std::size_t threadCount, std::size_t hardwareThreads, double duration) {
+    // one cache line per counter, so that the measurement doesn't add false sharing
+    struct alignas(64) Count {
+        uint64_t value = 0;
+    };
+    std::vector<Count> counts(threadCount);
+    std::vector<Operation> operations;
+    for (std::size_t thread = 0; thread < threadCount; ++thread) {
+        operations.push_back(workload.prepare(thread));
+    }
+    // warm-up of lazily initialized state, not measured
+    operations[0](0);
+
+    std::atomic<std::size_t> ready{0};
+    std::atomic<bool> started{false};
+    std::atomic<bool> stopped{false};
+    rusage usageBefore = {};
+    getrusage(RUSAGE_SELF, &usageBefore);
+    const auto counters = PerfCounters();
+    std::vector<std::thread> threads;
+    for (std::size_t thread = 0; thread < threadCount; ++thread) {
+        threads.emplace_back([&, thread] {
+            ++ready;
+            while (!started.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+            uint64_t count = 0;
+            while (!stopped.load(std::memory_order_relaxed)) {
+                operations[thread](count);
+                ++count;
+            }
+            counts[thread].value = count;
+        });
+    }
+    while (ready < threadCount) {
+        std::this_thread::yield();
+    }
+    const auto start = Clock::now();
+    started.store(true, std::memory_order_release);
+    std::this_thread::sleep_for(std::chrono::duration<double>(duration));
+    stopped = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    rusage usageAfter = {};
+    getrusage(RUSAGE_SELF, &usageAfter);
+
+    uint64_t ops = 0;
+    for (const auto& count : counts) {
+        ops += count.value;
+    }
+    auto result = Result();
+    result.workload = workload.name;
+    result.threads = threadCount;
+    result.opsPerSecond = static_cast<double>(ops) / elapsed;
+    const auto cpuTime = seconds(usageAfter.ru_utime) - seconds(usageBefore.ru_utime) + seconds(usageAfter.ru_stime) - seconds(usageBefore.ru_stime);
+    result.cpu = cpuTime / (elapsed * static_cast<double>(std::min(threadCount, hardwareThreads)));
+    result.voluntarySwitchesPerSecond = static_cast<double>(usageAfter.ru_nvcsw - usageBefore.ru_nvcsw) / elapsed;
+    const auto cycles = counters.value(PerfCounters::cycles);
+    const auto instructions = counters.value(PerfCounters::instructions);
+    const auto cacheMisses = counters.value(PerfCounters::cacheMisses);
+    if (ops > 0 && cycles > 0) {
+        result.cyclesPerOp = cycles / static_cast<double>(ops);
+        if (instructions >= 0) {
+            result.instructionsPerCycle = instructions / cycles;
+        }
+    }
+    if (ops > 0 && cacheMisses >= 0) {
+        result.cacheMissesPerOp = cacheMisses / static_cast<double>(ops);
+    }
+    return result;
+}
+
+nlohmann::json toJson(const Result& result) {
+    return {
+        {"workload", result.workload},
+        {"threads", result.threads},
+        {"ops_per_second", result.opsPerSecond},
+        {"speedup", result.speedup},
+        {"efficiency", result.efficiency},
+        {"cpu", result.cpu},
+        {"voluntary_switches_per_second", result.voluntarySwitchesPerSecond},
+        {"cycles_per_op", result.cyclesPerOp},
+        {"instructions_per_cycle", result.instructionsPerCycle},
+        {"cache_misses_per_op", result.cacheMissesPerOp},
+    };
+}
+
+std::string counter(double value, const char* format) {
+    if (value < 0) {
+        return "n/a";
+    }
+    char text[32];
+    std::snprintf(text, sizeof(text), format, value);
+    return text;
+}
+
+void print(const Result& result) {
+    std::printf("%-9s %7zu %12.1f %8.2f %6.0f%% %5.0f%% %10.1f %12s %6s %12s\n", result.workload.c_str(), result.threads,
+                result.opsPerSecond, result.speedup, result.efficiency * 100, result.cpu * 100, result.voluntarySwitchesPerSecond,
+                counter(result.cyclesPerOp, "%.0f").c_str(), counter(result.instructionsPerCycle, "%.2f").c_str(),
+                counter(result.cacheMissesPerOp, "%.1f").c_str());
+    std::fflush(stdout);
+}
+
+/// Value of an option `--name=value`, empty if absent.
+std::string option(int argc, char* argv[], const std::string& name) {
+    const auto prefix = "--" + name + "=";
+    for (int i = 1; i < argc; ++i) {
+        const auto argument = std::string(argv[i]);
+        if (argument.compare(0, prefix.size(), prefix) == 0) {
+            return argument.substr(prefix.size());
+        }
+    }
+    return "";
+}
+
+std::vector<std::string> split(const std::string& list) {
+    std::vector<std::string> items;
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        const auto end = std::min(list.find(',', begin), list.size());
+        if (end > begin) {
+            items.push_back(list.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+    return items;
+}
+
+/// Number of runs with a throughput below the baseline by more than the tolerance.
+int compare(const std::vector<Result>& results, const nlohmann::json& baseline, double tolerance) {
+    int regressions = 0;
+    for (const auto& result : results) {
+        for (const auto& expected : baseline["results"]) {
+            if (expected["workload"] != result.workload || expected["threads"] != result.threads) {
+                continue;
+            }
+            const auto ratio = result.opsPerSecond / expected["ops_per_second"].get<double>();
+            const auto regressed = ratio < 1 - tolerance;
+            std::printf("%-9s %7zu %+7.1f%%%s\n", result.workload.c_str(), result.threads, (ratio - 1) * 100, regressed ? "  REGRESSION" : "");
+            regressions += regressed ? 1 : 0;
+        }
+    }
+    return regressions;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    const auto hardwareThreads = static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()));
+    auto threadCounts = std::vector<std::size_t>{1, 2, 4, 8, 16, 32, 64};
+    if (const auto list = option(argc, argv, "threads"); !list.empty()) {
+        threadCounts.clear();
+        for (const auto& item : split(list)) {
+            threadCounts.push_back(std::max<std::size_t>(1, std::stoul(item)));
+        }
+    }
+    const auto durationOption = option(argc, argv, "duration");
+    const auto duration = durationOption.empty() ? 1.0 : std::stod(durationOption);
+    const auto toleranceOption = option(argc, argv, "tolerance");
+    const auto tolerance = toleranceOption.empty() ? 0.1 : std::stod(toleranceOption);
+    const auto selected = split(option(argc, argv, "workloads"));
+
+    std::printf("%zu hardware threads, %.1f s per run\n", hardwareThreads, duration);
+    std::printf("%-9s %7s %12s %8s %7s %6s %10s %12s %6s %12s\n", "workload", "threads", "ops/s", "speedup", "effic.", "cpu",
+                "vcsw/s", "cycles/op", "IPC", "misses/op");
+    std::vector<Result> results;
+    for (const auto& workload : workloads()) {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), workload.name) == selected.end()) {
+            continue;
+        }
+        double single = 0;
+        for (const auto threadCount : threadCounts) {
+            auto result = run(workload, threadCount, hardwareThreads, duration);
+            if (single == 0) {
+                // the first count is the reference, normally one thread
+                single = result.opsPerSecond / static_cast<double>(threadCount);
+            }
+            result.speedup = result.opsPerSecond / single;
+            result.efficiency = result.speedup / static_cast<double>(std::min(threadCount, hardwareThreads));
+            print(result);
+            results.push_back(result);
+        }
+    }
+
+    if (const auto path = option(argc, argv, "json"); !path.empty()) {
+        auto json = nlohmann::json{{"context", {{"hardware_threads", hardwareThreads}, {"duration", duration}}}, {"results", nlohmann::json::array()}};
+        for (const auto& result : results) {
+            json["results"].push_back(toJson(result));
+        }
+        std::ofstream(path) << json.dump(2) << std::endl;
+    }
+    if (const auto path = option(argc, argv, "baseline"); !path.empty()) {
+        std::ifstream stream(path);
+        if (!stream) {
+            std::fprintf(stderr, "cannot read %s\n", path.c_str());
+            return 1;
+        }
+        std::printf("\nthroughput against %s:\n", path.c_str());
+        if (compare(results, nlohmann::json::parse(stream), tolerance) > 0) {
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,120 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Cold start benchmark: time from dlopen of the shared library to the end of the first signature,
+// as paid by a mobile app launch or a short-lived CLI/serverless invocation.
+//
+// Usage: startup <path to libTrustWalletCore.so> [runs]
+// Each run is a fresh process, so that nothing is loaded or initialized yet.
+
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWData.h>
+
+#include <dlfcn.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// Ethereum transfer of the signing unit tests, serialized
+static const char* const ethereumInput =
+    "0a01011201091a0504a817c800220252082a2a3078333533353335333533353335333533353335333533353335333533353335"
+    "333533353335333533352046464646464646464646464646464646464646464646464646464646464646463a0c0a0a0a080de0"
+    "b6b3a7640000";
+
+static std::vector<uint8_t> parseHex(const char* hex) {
+    std::vector<uint8_t> bytes;
+    for (; hex[0] != 0 && hex[1] != 0; hex += 2) {
+        bytes.push_back(static_cast<uint8_t>(std::stoul(std::string(hex, 2), nullptr, 16)));
+    }
+    return bytes;
+}
+
+template <typename Function>
+static Function symbol(void* library, const char* name) {
+    auto address = dlsym(library, name);
+    if (address == nullptr) {
+        std::fprintf(stderr, "missing symbol %s\n", name);
+        std::exit(1);
+    }
+    return reinterpret_cast<Function>(address);
+}
+
+/// Loads the library and signs once, prints the load and total times in microseconds.
+static int child(const char* path) {
+    const auto input = parseHex(ethereumInput);
+
+    const auto start = Clock::now();
+    auto library = dlopen(path, RTLD_NOW | RTLD_LOCAL);
+    if (library == nullptr) {
+        std::fprintf(stderr, "%s\n", dlerror());
+        return 1;
+    }
+    const auto loaded = Clock::now();
+
+    const auto createData = symbol<decltype(&TWDataCreateWithBytes)>(library, "TWDataCreateWithBytes");
+    const auto dataSize = symbol<decltype(&TWDataSize)>(library, "TWDataSize");
+    const auto deleteData = symbol<decltype(&TWDataDelete)>(library, "TWDataDelete");
+    const auto sign = symbol<decltype(&TWAnySignerSign)>(library, "TWAnySignerSign");
+
+    auto data = createData(input.data(), input.size());
+    auto output = sign(data, TWCoinTypeEthereum);
+    const auto done = Clock::now();
+    if (dataSize(output) == 0) {
+        std::fprintf(stderr, "signing failed\n");
+        return 1;
+    }
+    deleteData(output);
+    deleteData(data);
+
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    std::printf("%lld %lld\n", static_cast<long long>(duration_cast<microseconds>(loaded - start).count()),
+                static_cast<long long>(duration_cast<microseconds>(done - start).count()));
+    return 0;
+}
+
+static long long median(std::vector<long long> values) {
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && std::string(argv[1]) == "--child") {
+        return child(argv[2]);
+    }
+    if (argc < 2) {
+        std::fprintf(stderr, "usage: %s <path to libTrustWalletCore.so> [runs]\n", argv[0]);
+        return 1;
+    }
+    const int runs = argc >= 3 ? std::max(1, std::atoi(argv[2])) : 20;
+
+    const auto command = std::string("'") + argv[0] + "' --child '" + argv[1] + "'";
+    std::vector<long long> loads;
+    std::vector<long long> totals;
+    for (int i = 0; i < runs; ++i) {
+        auto pipe = popen(command.c_str(), "r");
+        long long load = 0;
+        long long total = 0;
+        const auto read = pipe != nullptr ? std::fscanf(pipe, "%lld %lld", &load, &total) : 0;
+        if (pipe == nullptr || pclose(pipe) != 0 || read != 2) {
+            std::fprintf(stderr, "run %d failed\n", i);
+            return 1;
+        }
+        loads.push_back(load);
+        totals.push_back(total);
+    }
+
+    std::printf("runs: %d\n", runs);
+    std::printf("dlopen:             median %lld us, min %lld us\n", median(loads), *std::min_element(loads.begin(), loads.end()));
+    std::printf("dlopen to signed:   median %lld us, min %lld us\n", median(totals), *std::min_element(totals.begin(), totals.end()));
+    return 0;
+}
@@ -0,0 +1,80 @@
+# Blockchain selection: -DTW_COINS="Bitcoin;Ethereum" compiles only the listed src/ directories, those they
+# build on, and their protobuf messages. The coins of the other blockchains are unsupported at runtime, like
+# unknown coins: no address is valid and signing outputs are empty. All blockchains are built when empty.
+#
+# Sets TW_EXCLUDED_BLOCKCHAINS, and filters the sources with tw_filter_blockchain_sources.
+
+set(TW_COINS "" CACHE STRING "Blockchains to build, as src/ directory names (all when empty)")
+
+set(TW_BLOCKCHAINS
+    Aeternity Aion Algorand Binance Bitcoin Cardano Cosmos Decred Elrond EOS Ethereum Filecoin FIO Groestlcoin
+    Harmony Icon IoTeX Kusama Nano NEAR Nebulas NEO Nimiq NULS Oasis Ontology Polkadot Ripple Solana Stellar
+    Tezos Theta THORChain TON Tron VeChain Waves Zcash Zilliqa
+)
+
+# Blockchains using code of others (Cosmos: address format of TWAnyAddressData)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Aion Ethereum)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Binance Ethereum Cosmos)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Bitcoin Decred Groestlcoin Zcash)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Decred Bitcoin)
+set(TW_BLOCKCHAIN_DEPENDENCIES_FIO EOS)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Groestlcoin Bitcoin)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Harmony Ethereum)
+set(TW_BLOCKCHAIN_DEPENDENCIES_IoTeX Cosmos)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Kusama Polkadot)
+set(TW_BLOCKCHAIN_DEPENDENCIES_NEO Ontology)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Theta Ethereum)
+set(TW_BLOCKCHAIN_DEPENDENCIES_THORChain Cosmos)
+set(TW_BLOCKCHAIN_DEPENDENCIES_VeChain Ethereum)
+set(TW_BLOCKCHAIN_DEPENDENCIES_Zcash Bitcoin)
+
+set(TW_EXCLUDED_BLOCKCHAINS "")
+if(TW_COINS)
+    if(ANDROID OR IOS_PLATFORM)
+        # the JNI and Swift bindings are generated for every blockchain
+        message(FATAL_ERROR "TW_COINS is only supported by standalone and WebAssembly builds")
+    endif()
+
+    # Bitcoin is always needed, by HD wallets and extended keys
+    set(TW_SELECTED_BLOCKCHAINS "")
+    set(pending ${TW_COINS} Bitcoin)
+    while(pending)
+        list(GET pending 0 name)
+        list(REMOVE_AT pending 0)
+        if(NOT name IN_LIST TW_BLOCKCHAINS)
+            message(FATAL_ERROR "Unknown blockchain in TW_COINS: ${name}")
+        endif()
+        if(NOT name IN_LIST TW_SELECTED_BLOCKCHAINS)
+            list(APPEND TW_SELECTED_BLOCKCHAINS ${name})
+            list(APPEND pending ${TW_BLOCKCHAIN_DEPENDENCIES_${name}})
+        endif()
+    endwhile()
+
+    foreach(name ${TW_BLOCKCHAINS})
+        if(NOT name IN_LIST TW_SELECTED_BLOCKCHAINS)
+            list(APPEND TW_EXCLUDED_BLOCKCHAINS ${name})
+        endif()
+    endforeach()
+    list(SORT TW_SELECTED_BLOCKCHAINS)
+    message("Blockchains: ${TW_SELECTED_BLOCKCHAINS}")
+endif()
+
+# Removes the directory, protobuf messages and C interface classes (TW<Name>*.cpp) of the excluded
+# blockchains from the list named `sources_var`.
+function(tw_filter_blockchain_sources sources_var)
+    set(list ${${sources_var}})
+    foreach(name ${TW_EXCLUDED_BLOCKCHAINS})
+        list(FILTER list EXCLUDE REGEX "/src/${name}/")
+        list(FILTER list EXCLUDE REGEX "/src/proto/${name}\\.pb\\.(cc|h)$")
+        list(FILTER list EXCLUDE REGEX "/src/interface/TW${name}[A-Z][A-Za-z]*\\.cpp$")
+    endforeach()
+    set(${sources_var} ${list} PARENT_SCOPE)
+endfunction()
+
+# Defines TW_EXCLUDE_<NAME> for the excluded blockchains, which leaves them out of the coin dispatcher.
+function(tw_exclude_blockchain_definitions target)
+    foreach(name ${TW_EXCLUDED_BLOCKCHAINS})
+        string(TOUPPER ${name} upper)
+        target_compile_definitions(${target} PRIVATE TW_EXCLUDE_${upper})
+    endforeach()
+endfunction()
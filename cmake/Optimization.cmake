@@ -0,0 +1,51 @@
+# Release build profile: ThinLTO and profile-guided optimization (clang), applied to every target so that
+# wallet-core, trezor-crypto and protobuf are optimized together, e.g. Hash.cpp inlining the trezor hashes.
+#
+# - TW_LTO: ThinLTO across all libraries and executables
+# - TW_PGO_GENERATE: instrumented build, runs write LLVM_PROFILE_FILE (default.profraw)
+# - TW_PGO_USE: profile (.profdata, from llvm-profdata merge) to optimize with
+#
+# tools/pgo-build trains the profile on the unit tests and benchmarks, and builds with it.
+
+option(TW_LTO "Link with ThinLTO across wallet-core, trezor-crypto and protobuf" OFF)
+option(TW_PGO_GENERATE "Instrument for profile-guided optimization" OFF)
+set(TW_PGO_USE "" CACHE FILEPATH "Profile (.profdata) for profile-guided optimization")
+
+if(TW_PGO_GENERATE AND TW_PGO_USE)
+    message(FATAL_ERROR "TW_PGO_GENERATE and TW_PGO_USE are exclusive")
+endif()
+
+set(TW_OPTIMIZATION_FLAGS "")
+if(TW_LTO)
+    set(TW_OPTIMIZATION_FLAGS "${TW_OPTIMIZATION_FLAGS} -flto=thin")
+    if(NOT APPLE)
+        # bitcode objects: archives need the LLVM tools for their symbol index, and the GNU linker a plugin
+        find_program(TW_LLVM_AR NAMES llvm-ar)
+        find_program(TW_LLVM_RANLIB NAMES llvm-ranlib)
+        if(NOT TW_LLVM_AR OR NOT TW_LLVM_RANLIB)
+            message(FATAL_ERROR "TW_LTO needs llvm-ar and llvm-ranlib")
+        endif()
+        set(CMAKE_AR ${TW_LLVM_AR})
+        set(CMAKE_RANLIB ${TW_LLVM_RANLIB})
+        set(TW_OPTIMIZATION_LINKER_FLAGS "-fuse-ld=lld")
+    endif()
+endif()
+if(TW_PGO_GENERATE)
+    set(TW_OPTIMIZATION_FLAGS "${TW_OPTIMIZATION_FLAGS} -fprofile-instr-generate")
+endif()
+if(TW_PGO_USE)
+    if(NOT EXISTS ${TW_PGO_USE})
+        message(FATAL_ERROR "Missing profile ${TW_PGO_USE}, see tools/pgo-build")
+    endif()
+    # functions that changed since the training run keep the default heuristics
+    set(TW_OPTIMIZATION_FLAGS
+        "${TW_OPTIMIZATION_FLAGS} -fprofile-instr-use=${TW_PGO_USE} -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date")
+endif()
+
+if(TW_OPTIMIZATION_FLAGS)
+    message("Optimization flags:${TW_OPTIMIZATION_FLAGS}")
+    set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS}${TW_OPTIMIZATION_FLAGS}")
+    set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS}${TW_OPTIMIZATION_FLAGS}")
+    set(CMAKE_EXE_LINKER_FLAGS "${CMAKE_EXE_LINKER_FLAGS}${TW_OPTIMIZATION_FLAGS} ${TW_OPTIMIZATION_LINKER_FLAGS}")
+    set(CMAKE_SHARED_LINKER_FLAGS "${CMAKE_SHARED_LINKER_FLAGS}${TW_OPTIMIZATION_FLAGS} ${TW_OPTIMIZATION_LINKER_FLAGS}")
+endif()
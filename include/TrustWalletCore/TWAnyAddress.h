@@ -27,6 +27,11 @@ bool TWAnyAddressEqual(struct TWAnyAddress* _Nonnull lhs, struct TWAnyAddress* _
 TW_EXPORT_STATIC_METHOD
 bool TWAnyAddressIsValid(TWString* _Nonnull string, enum TWCoinType coin);
 
+/// Validates many addresses at once, separated by a newline character.
+/// Returns one byte per address, in the same order: 1 if valid, 0 otherwise.
+TW_EXPORT_STATIC_METHOD
+TWData* _Nonnull TWAnyAddressValidateAddresses(TWString* _Nonnull addresses, enum TWCoinType coin);
+
 /// Creates an address from a string representaion.
 TW_EXPORT_STATIC_METHOD
 struct TWAnyAddress* _Nullable TWAnyAddressCreateWithString(TWString* _Nonnull string, enum TWCoinType coin);
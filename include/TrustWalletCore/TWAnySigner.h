@@ -18,6 +18,26 @@ struct TWAnySigner;
 /// Signs a transaction.
 extern TWData *_Nonnull TWAnySignerSign(TWData *_Nonnull input, enum TWCoinType coin);
 
+/// Fields of the signing outputs, to leave out those a caller doesn't need with TWAnySignerSignWithFields.
+/// The fields a coin's output doesn't have are ignored.
+enum TWAnySignerOutputField {
+    /// Raw signed transaction: `encoded` (Bitcoin, Ethereum families), `serialized` (Cosmos protobuf mode).
+    TWAnySignerOutputFieldEncoded = 1 << 0,
+    /// Transaction id: `transaction_id` (Bitcoin family).
+    TWAnySignerOutputFieldTransactionId = 1 << 1,
+    /// Decoded transaction: `transaction` (Bitcoin family), `data` (Ethereum).
+    TWAnySignerOutputFieldTransaction = 1 << 2,
+    /// Separate signature: `signature` (Cosmos, Waves), `v`, `r` and `s` (Ethereum).
+    TWAnySignerOutputFieldSignature = 1 << 3,
+    /// JSON transaction: `json` (Cosmos amino mode, Waves).
+    TWAnySignerOutputFieldJSON = 1 << 4,
+    TWAnySignerOutputFieldAll = 0xffff,
+};
+
+/// Signs a transaction like TWAnySignerSign, with only the output fields of the `fields` mask of
+/// TWAnySignerOutputField values, skipping the encodings and hashes of the others.
+extern TWData *_Nonnull TWAnySignerSignWithFields(TWData *_Nonnull input, enum TWCoinType coin, uint32_t fields);
+
 /// Signs a json transaction with private key.
 extern TWString *_Nonnull TWAnySignerSignJSON(TWString *_Nonnull json, TWData *_Nonnull key, enum TWCoinType coin);
 
@@ -26,4 +46,65 @@ extern bool TWAnySignerSupportsJSON(enum TWCoinType coin);
 /// Plan a transaction (for UTXO chains).
 extern TWData *_Nonnull TWAnySignerPlan(TWData *_Nonnull input, enum TWCoinType coin);
 
+/// Digests to sign out of process for a signing input, whose private keys are replaced with the public keys
+/// (compressed or not for secp256k1, 0x01 || key for ed25519); returns a serialized TxCompiler.Proto.PreSigningOutput.
+/// Supported by the coins whose signer accepts a signer backend: the Bitcoin and Ethereum families, the Cosmos
+/// family and NEAR.  The other coins return an Error_signing output.
+extern TWData *_Nonnull TWAnySignerPreImageHashes(TWData *_Nonnull input, enum TWCoinType coin);
+
+/// Signs a transaction with the signatures of the TWAnySignerPreImageHashes digests of its input: `signatures` holds
+/// them concatenated in the same order, 64 bytes each (r || s for ECDSA, s in either half of the order).
+/// Returns the serialized signing output, empty if the signatures don't match the input.
+extern TWData *_Nonnull TWAnySignerCompileWithSignatures(TWData *_Nonnull input, TWData *_Nonnull signatures, enum TWCoinType coin);
+
+/// Signs a transaction from `inputSize` bytes of serialized input, and writes the serialized output into the caller's
+/// `output` buffer, without intermediate TWData allocations.
+/// Returns the output size.  Nothing is written if it exceeds `outputCapacity`: `output` can be null to query the size,
+/// and the call then has to be repeated with a large enough buffer, which signs again.  Signing outputs are a few
+/// kilobytes at most, so a reusable buffer of that size avoids the second call.
+extern size_t TWAnySignerSignBytes(const uint8_t *_Nonnull input, size_t inputSize, enum TWCoinType coin, uint8_t *_Nullable output, size_t outputCapacity);
+
+/// Plans a transaction (for UTXO chains) into the caller's buffer, like TWAnySignerSignBytes.
+extern size_t TWAnySignerPlanBytes(const uint8_t *_Nonnull input, size_t inputSize, enum TWCoinType coin, uint8_t *_Nullable output, size_t outputCapacity);
+
+/// Error code of a transaction signed in a batch.
+enum TWAnySignerBatchError {
+    TWAnySignerBatchErrorNone = 0,
+    TWAnySignerBatchErrorUnsupportedCoin = 1,
+    TWAnySignerBatchErrorSigningFailed = 2,
+};
+
+/// Transactions of any coins, to be signed together with TWAnySignerSignBatch.
+struct TWAnySignerBatch;
+
+/// Creates an empty batch.  It must be deleted at the end.
+extern struct TWAnySignerBatch *_Nonnull TWAnySignerBatchCreate(void);
+
+/// Deletes a batch created with 'TWAnySignerBatchCreate'.
+extern void TWAnySignerBatchDelete(struct TWAnySignerBatch *_Nonnull batch);
+
+/// Adds a signing input for a coin to the batch, returns the index of the transaction (0-based).
+extern int TWAnySignerBatchAdd(struct TWAnySignerBatch *_Nonnull batch, TWData *_Nonnull input, enum TWCoinType coin);
+
+/// Adds `inputSize` bytes of serialized signing input to the batch, like TWAnySignerBatchAdd.
+extern int TWAnySignerBatchAddBytes(struct TWAnySignerBatch *_Nonnull batch, const uint8_t *_Nonnull input, size_t inputSize, enum TWCoinType coin);
+
+/// Number of transactions in the batch.
+extern int TWAnySignerBatchSize(struct TWAnySignerBatch *_Nonnull batch);
+
+/// Signs all transactions of the batch, on up to `threadCount` threads (0: one per hardware thread).
+/// Signing is thread-safe: the lazily detected hardware features in trezor-crypto (SHA-256, Keccak)
+/// are initialized atomically, and the shared caches (seeds, HD nodes, secp256k1 tables) are locked.
+extern void TWAnySignerSignBatch(struct TWAnySignerBatch *_Nonnull batch, uint32_t threadCount);
+
+/// Signing output of the transaction at `index`, from the last TWAnySignerSignBatch call (empty on error).
+extern TWData *_Nonnull TWAnySignerBatchOutput(struct TWAnySignerBatch *_Nonnull batch, int index);
+
+/// Copies the signing output of the transaction at `index` into the caller's buffer, returns its size (0 on error).
+/// Nothing is written if the size exceeds `outputCapacity`, `output` can be null to query the size.
+extern size_t TWAnySignerBatchOutputBytes(struct TWAnySignerBatch *_Nonnull batch, int index, uint8_t *_Nullable output, size_t outputCapacity);
+
+/// Error code of the transaction at `index`, from the last TWAnySignerSignBatch call.
+extern enum TWAnySignerBatchError TWAnySignerBatchGetError(struct TWAnySignerBatch *_Nonnull batch, int index);
+
 TW_EXTERN_C_END
@@ -0,0 +1,33 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWData.h"
+#include "TWString.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Signer of transactions that differ only in nonce, recipient and amount, prepared once from a base signing input.
+/// Supported by account-based coins: Ethereum and EVM chains (transfers and ERC20 transfers), Harmony,
+/// VeChain (single clause), Theta (TFUEL amount), Aion and Tron (transfers and TRC20 transfers, no nonce).
+struct TWAnySignerTemplate;
+
+/// Prepares a template from a serialized signing input, whose nonce, recipient and amount are replaced when signing.
+/// Returns null if the coin or the kind of transaction is not supported, or if the input is invalid.
+/// It must be deleted at the end.
+extern struct TWAnySignerTemplate *_Nullable TWAnySignerTemplateCreate(TWData *_Nonnull input, enum TWCoinType coin);
+
+/// Deletes a template created with 'TWAnySignerTemplateCreate'.
+extern void TWAnySignerTemplateDelete(struct TWAnySignerTemplate *_Nonnull signerTemplate);
+
+/// Signs the template transaction with the given nonce, recipient and amount (uint256, big-endian).
+/// Returns the serialized signing output of the coin, empty on error.  Thread-safe.
+extern TWData *_Nonnull TWAnySignerTemplateSign(struct TWAnySignerTemplate *_Nonnull signerTemplate, uint64_t nonce, TWString *_Nonnull toAddress, TWData *_Nonnull amount);
+
+TW_EXTERN_C_END
@@ -0,0 +1,63 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+#include "TWData.h"
+
+TW_EXTERN_C_BEGIN
+
+struct TWStoredKey;
+
+/// Operation running in the background, on a shared pool of one worker thread per hardware thread.
+/// The result can be awaited, polled, or delivered by a completion callback.
+struct TWAsyncTask;
+
+/// State of an asynchronous task.
+enum TWAsyncTaskStatus {
+    TWAsyncTaskStatusPending = 0,
+    TWAsyncTaskStatusCompleted = 1,
+    TWAsyncTaskStatusFailed = 2,
+    TWAsyncTaskStatusCancelled = 3,
+};
+
+/// Called once on a worker thread when the task is no longer pending, unless the task was deleted before.
+/// The task can be read and deleted from the callback.
+typedef void (*TWAsyncTaskCallback)(void *_Nullable context, struct TWAsyncTask *_Nonnull task);
+
+/// Signs a transaction in the background, see TWAnySignerSign.  The input is copied.
+extern struct TWAsyncTask *_Nonnull TWAnySignerSignAsync(TWData *_Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void *_Nullable context);
+
+/// Plans a transaction in the background, see TWAnySignerPlan.  The input is copied.
+extern struct TWAsyncTask *_Nonnull TWAnySignerPlanAsync(TWData *_Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void *_Nullable context);
+
+/// Decrypts the private key of a stored key in the background, see TWStoredKeyDecryptPrivateKey.
+/// The key and password are copied; the key derivation stops early when the task is cancelled.
+/// Fails on a wrong password.
+extern struct TWAsyncTask *_Nonnull TWStoredKeyDecryptPrivateKeyAsync(struct TWStoredKey *_Nonnull key, TWData *_Nonnull password, TWAsyncTaskCallback _Nullable callback, void *_Nullable context);
+
+/// Decrypts the mnemonic of a stored key in the background, the result holds its UTF-8 bytes.
+/// See TWStoredKeyDecryptPrivateKeyAsync.
+extern struct TWAsyncTask *_Nonnull TWStoredKeyDecryptMnemonicAsync(struct TWStoredKey *_Nonnull key, TWData *_Nonnull password, TWAsyncTaskCallback _Nullable callback, void *_Nullable context);
+
+/// Current state of the task.
+extern enum TWAsyncTaskStatus TWAsyncTaskGetStatus(struct TWAsyncTask *_Nonnull task);
+
+/// Blocks until the task is no longer pending, and returns its final state.
+extern enum TWAsyncTaskStatus TWAsyncTaskWait(struct TWAsyncTask *_Nonnull task);
+
+/// Requests cancellation, from any thread.  Tasks that have not started are cancelled right away, key derivations
+/// stop within milliseconds, other running operations complete normally.
+extern void TWAsyncTaskCancel(struct TWAsyncTask *_Nonnull task);
+
+/// Result of a completed task, null in any other state.
+extern TWData *_Nullable TWAsyncTaskResult(struct TWAsyncTask *_Nonnull task);
+
+/// Deletes a task, cancelling it if still pending; its callback is not called afterwards.
+extern void TWAsyncTaskDelete(struct TWAsyncTask *_Nonnull task);
+
+TW_EXTERN_C_END
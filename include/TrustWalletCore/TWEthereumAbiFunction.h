@@ -101,6 +101,14 @@ TW_EXPORT_METHOD
 TW_METHOD_DISCARDABLE_RESULT
 int TWEthereumAbiFunctionAddParamArray(struct TWEthereumAbiFunction *_Nonnull fn, bool isOutput);
 
+/// Adds an array parameter of a static type, "address" (20 bytes each), "uint256" (32 bytes each, big endian) or
+/// "bytes32", with all its elements from a buffer holding them one after the other; much faster than adding the
+/// elements one by one for arrays of thousands of elements.  Returns the index of the parameter, or -1 if the type
+/// is not supported or the buffer is not a whole number of elements.  Elements cannot be added to it later.
+TW_EXPORT_METHOD
+TW_METHOD_DISCARDABLE_RESULT
+int TWEthereumAbiFunctionAddParamArrayFromBuffer(struct TWEthereumAbiFunction *_Nonnull fn, TWString *_Nonnull elementType, TWData *_Nonnull elements, bool isOutput);
+
 /// Methods for accessing the value of an output or input parameter, of different types.
 TW_EXPORT_METHOD
 uint8_t TWEthereumAbiFunctionGetParamUInt8(struct TWEthereumAbiFunction *_Nonnull fn, int idx, bool isOutput);
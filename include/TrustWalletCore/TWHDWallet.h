@@ -37,6 +37,11 @@ struct TWHDWallet *_Nonnull TWHDWalletCreateWithMnemonic(TWString *_Nonnull mnem
 TW_EXPORT_STATIC_METHOD
 struct TWHDWallet *_Nonnull TWHDWalletCreateWithData(TWData *_Nonnull data, TWString *_Nonnull passphrase);
 
+/// Sets the maximum number of seeds cached in memory, to skip the seed computation of recently used
+/// mnemonics and passphrases; 0 disables the cache.  Clears the cache.
+TW_EXPORT_STATIC_METHOD
+void TWHDWalletSetSeedCacheCapacity(uint32_t capacity);
+
 /// Deletes a wallet.
 TW_EXPORT_METHOD
 void TWHDWalletDelete(struct TWHDWallet *_Nonnull wallet);
@@ -71,6 +76,12 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetKey(struct TWHDWallet *_Nonnull walle
 TW_EXPORT_METHOD
 struct TWPrivateKey *_Nonnull TWHDWalletGetDerivedKey(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t address);
 
+/// Derives `count` consecutive addresses (bip44 standard) for the specified coin, account and change, starting at address index `firstIndex`.
+/// The parent node is derived only once, making this much faster than repeated TWHDWalletGetDerivedKey calls.
+/// Addresses are returned in index order, separated by a newline character; none if an index is 2^31 or more.
+TW_EXPORT_METHOD
+TWString *_Nonnull TWHDWalletDeriveAddresses(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count);
+
 /// Returns the extended private key.
 TW_EXPORT_METHOD
 TWString *_Nonnull TWHDWalletGetExtendedPrivateKey(struct TWHDWallet *_Nonnull wallet, enum TWPurpose purpose, enum TWCoinType coin, enum TWHDVersion version);
@@ -79,6 +90,12 @@ TWString *_Nonnull TWHDWalletGetExtendedPrivateKey(struct TWHDWallet *_Nonnull w
 TW_EXPORT_METHOD
 TWString *_Nonnull TWHDWalletGetExtendedPublicKey(struct TWHDWallet *_Nonnull wallet, enum TWPurpose purpose, enum TWCoinType coin, enum TWHDVersion version);
 
+/// Returns the extended public keys of `count` coins, each with its default purpose and xpub version, for instance
+/// to register a wallet with a sync service.  Keys are returned in the order of `coins`, separated by a newline
+/// character, an empty line for a coin without extended keys.  Cached by the wallet.  Returned object needs to be deleted.
+TW_EXPORT_METHOD
+TWString *_Nonnull TWHDWalletGetExtendedPublicKeys(struct TWHDWallet *_Nonnull wallet, const enum TWCoinType *_Nonnull coins, size_t count);
+
 /// Computes the public key from an exteded public key representation.  Returned object needs to be deleted.
 TW_EXPORT_STATIC_METHOD
 struct TWPublicKey *_Nullable TWHDWalletGetPublicKeyFromExtended(TWString *_Nonnull extended, enum TWCoinType coin, TWString *_Nonnull derivationPath);
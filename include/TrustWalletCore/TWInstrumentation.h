@@ -0,0 +1,22 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Receives the measurements of instrumented operations: the operation name (a static string),
+/// its duration in nanoseconds (0 for counters) and a count (1 for timers, e.g. a number of bytes for counters).
+/// It is called on the thread doing the operation, so it must be thread-safe and fast.
+typedef void (*TWInstrumentationSink)(void *_Nullable context, const char *_Nonnull operation, uint64_t durationNanoseconds, uint64_t count);
+
+/// Sets the sink of the measurements, null to remove it.  `context` is passed back to the sink.
+/// Measurements are only taken when the library is built with TW_INSTRUMENTATION, otherwise the sink is never called.
+/// The sink should be set before using the library from several threads.
+extern void TWInstrumentationSetSink(TWInstrumentationSink _Nullable sink, void *_Nullable context);
+
+TW_EXTERN_C_END
@@ -55,4 +55,10 @@ TWString *_Nonnull TWPublicKeyDescription(struct TWPublicKey *_Nonnull publicKey
 TW_EXPORT_STATIC_METHOD
 struct TWPublicKey *_Nullable TWPublicKeyRecover(TWData *_Nonnull signature, TWData *_Nonnull message);
 
+/// Sets the maximum number of successful signature verifications and recoveries remembered in memory,
+/// so that the same public key, message and signature are accepted again without a new verification;
+/// 0 (the default) disables the cache.  Clears the cache.
+TW_EXPORT_STATIC_METHOD
+void TWPublicKeySetSignatureCacheCapacity(uint32_t capacity);
+
 TW_EXTERN_C_END
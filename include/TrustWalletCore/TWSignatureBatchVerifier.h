@@ -0,0 +1,45 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "TWBase.h"
+#include "TWData.h"
+#include "TWPublicKey.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Collects signatures to verify them all at once; ED25519 signatures verify faster in a batch.
+TW_EXPORT_CLASS
+struct TWSignatureBatchVerifier;
+
+/// Creates an empty batch.  It must be deleted at the end.
+TW_EXPORT_STATIC_METHOD
+struct TWSignatureBatchVerifier *_Nonnull TWSignatureBatchVerifierCreate(void);
+
+/// Deletes a batch created with 'TWSignatureBatchVerifierCreate'.
+TW_EXPORT_METHOD
+void TWSignatureBatchVerifierDelete(struct TWSignatureBatchVerifier *_Nonnull verifier);
+
+/// Adds the signature of a message by a public key to the batch.
+/// Returns the index of the signature (0-based).
+TW_EXPORT_METHOD
+TW_METHOD_DISCARDABLE_RESULT
+int TWSignatureBatchVerifierAdd(struct TWSignatureBatchVerifier *_Nonnull verifier, struct TWPublicKey *_Nonnull publicKey, TWData *_Nonnull signature, TWData *_Nonnull message);
+
+/// Number of signatures in the batch.
+TW_EXPORT_PROPERTY
+int TWSignatureBatchVerifierSize(struct TWSignatureBatchVerifier *_Nonnull verifier);
+
+/// Verifies all signatures of the batch, returns true if they are all valid.
+TW_EXPORT_METHOD
+bool TWSignatureBatchVerifierVerify(struct TWSignatureBatchVerifier *_Nonnull verifier);
+
+/// Returns whether the signature at the given index was found valid by the last 'TWSignatureBatchVerifierVerify' call.
+TW_EXPORT_METHOD
+bool TWSignatureBatchVerifierIsValid(struct TWSignatureBatchVerifier *_Nonnull verifier, int index);
+
+TW_EXTERN_C_END
@@ -74,7 +74,12 @@ void TWStoredKeyRemoveAccountForCoin(struct TWStoredKey* _Nonnull key, enum TWCo
 TW_EXPORT_METHOD
 void TWStoredKeyAddAccount(struct TWStoredKey* _Nonnull key, TWString* _Nonnull address, enum TWCoinType coin, TWString* _Nonnull derivationPath, TWString* _Nonnull extetndedPublicKey);
 
-/// Saves the key to a file.
+/// Changes the encryption password, keeping the key derivation parameters of the key; store the key to save it.
+/// @returns `false` if the password is incorrect.
+TW_EXPORT_METHOD
+bool TWStoredKeyChangePassword(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWData* _Nonnull newPassword);
+
+/// Saves the key to a file, replacing it atomically.
 TW_EXPORT_METHOD
 bool TWStoredKeyStore(struct TWStoredKey* _Nonnull key, TWString* _Nonnull path);
 
@@ -105,4 +110,20 @@ TWData* _Nullable TWStoredKeyExportJSON(struct TWStoredKey* _Nonnull key);
 TW_EXPORT_METHOD
 bool TWStoredKeyFixAddresses(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password);
 
+/// Calibrates the scrypt parameters of the keys created from now on, for an unlock time of about
+/// `targetMilliseconds` on this device with at most `maxMemoryKilobytes` of memory.  The device is
+/// benchmarked once.  The parameters are stored in the key JSON, so keys unlock on any device.
+/// @returns `false` if the memory budget is less than 1MB, the parameters are unchanged then.
+TW_EXPORT_STATIC_METHOD
+bool TWStoredKeyCalibrateScrypt(uint32_t targetMilliseconds, uint32_t maxMemoryKilobytes);
+
+/// Calibrates the keys created from now on to use PBKDF2, for an unlock time of about
+/// `targetMilliseconds` on this device.
+TW_EXPORT_STATIC_METHOD
+void TWStoredKeyCalibratePBKDF2(uint32_t targetMilliseconds);
+
+/// Restores the default key derivation parameters of new keys, the light scrypt parameters.
+TW_EXPORT_STATIC_METHOD
+void TWStoredKeyResetKDFParameters(void);
+
 TW_EXTERN_C_END
@@ -0,0 +1,41 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+
+TW_EXTERN_C_BEGIN
+
+/// Configuration of the threads shared by the parallel operations of the library (batch signing and verification,
+/// address derivation, scrypt lanes, keystore loading...).  The `threadCount` arguments of these operations are upper
+/// bounds, 0 using all the threads of the pool.  A configuration change waits for the running tasks of the previous
+/// configuration; it is best made once, before using the library.
+
+/// Sets the number of threads, 0 for one per hardware thread, or one per CPU of the affinity.
+extern void TWThreadPoolSetThreadCount(uint32_t threadCount);
+
+/// Number of threads of the pool, or concurrency of the executor.
+extern uint32_t TWThreadPoolThreadCount(void);
+
+/// Pins thread i to CPU `cpus[i % count]`, null or 0 CPUs to remove the pinning.
+/// Returns false if CPU affinity is not supported on this platform.
+extern bool TWThreadPoolSetAffinity(const uint32_t *_Nullable cpus, size_t count);
+
+/// Pins the threads to the CPUs of a NUMA node, so that the memory they touch stays local to the node.
+/// Returns false if the node is not known, or the NUMA topology not available (Linux only).
+extern bool TWThreadPoolSetNumaNode(uint32_t node);
+
+/// Function to call once, with its argument, to run a task.
+typedef void (*TWThreadPoolTask)(void *_Nonnull task);
+
+/// Runs `run(task)` exactly once, on a thread of the executor.  Called from any thread.
+typedef void (*TWThreadPoolExecutor)(void *_Nullable context, TWThreadPoolTask _Nonnull run, void *_Nonnull task);
+
+/// Hands the tasks of the library to an external executor, which runs `concurrency` tasks at once (0: one per hardware
+/// thread), instead of the threads of the pool.  A null executor restores the threads.
+extern void TWThreadPoolSetExecutor(TWThreadPoolExecutor _Nullable executor, void *_Nullable context, uint32_t concurrency);
+
+TW_EXTERN_C_END
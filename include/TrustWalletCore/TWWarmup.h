@@ -0,0 +1,36 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+#pragma once
+
+#include "TWBase.h"
+#include "TWCoinType.h"
+
+TW_EXTERN_C_BEGIN
+
+/// What TWWarmup prepares, combined with |.
+enum TWWarmupFlags {
+    /// Maps the precomputed tables of the curves (secp256k1, nist256p1, ed25519) and builds the secp256k1 comb table.
+    TWWarmupFlagsCurveTables = 1 << 0,
+    /// Builds the index of the BIP39 wordlist.
+    TWWarmupFlagsWordlist = 1 << 1,
+    /// Constructs the dispatchers of the coins and derives an address of each, which also starts the thread pool.
+    TWWarmupFlagsCoins = 1 << 2,
+    /// Builds the protobuf descriptors, used by JSON signing and reflection.
+    TWWarmupFlagsProtobuf = 1 << 3,
+    /// Locks the curve tables in RAM (best effort, limited by RLIMIT_MEMLOCK for instance), with TWWarmupFlagsCurveTables.
+    TWWarmupFlagsLockTables = 1 << 4,
+    /// Everything but the locking.
+    TWWarmupFlagsDefault = TWWarmupFlagsCurveTables | TWWarmupFlagsWordlist | TWWarmupFlagsCoins | TWWarmupFlagsProtobuf,
+};
+
+/// Initializes the lazily built state of the library ahead of the first requests, whose latency would otherwise
+/// include page faults and one-time initialization.  `coins` lists the coins to prepare, null or 0 coins for all of
+/// them.  Safe to call from any thread, and more than once.
+///
+/// Returns the time spent, in nanoseconds.
+extern uint64_t TWWarmup(const enum TWCoinType *_Nullable coins, size_t count, uint32_t flags);
+
+TW_EXTERN_C_END
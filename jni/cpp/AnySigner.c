@@ -39,3 +39,27 @@ jbyteArray JNICALL Java_wallet_core_java_AnySigner_nativePlan(JNIEnv *env, jclas
     TWDataDelete(inputData);
     return resultData;
 }
+
+static jint signDirect(JNIEnv *env, jobject input, jint inputOffset, jint inputLength, jobject output, jint outputOffset, jint outputLength, jint coin,
+                       size_t (*function)(const uint8_t *_Nonnull, size_t, enum TWCoinType, uint8_t *_Nullable, size_t)) {
+    const uint8_t *inputBytes = (*env)->GetDirectBufferAddress(env, input);
+    uint8_t *outputBytes = (*env)->GetDirectBufferAddress(env, output);
+    if (inputBytes == NULL || outputBytes == NULL || inputOffset < 0 || inputLength < 0 || outputOffset < 0 || outputLength < 0
+            || (jlong) inputOffset + inputLength > (*env)->GetDirectBufferCapacity(env, input)
+            || (jlong) outputOffset + outputLength > (*env)->GetDirectBufferCapacity(env, output)) {
+        jclass exceptionClass = (*env)->FindClass(env, "java/lang/IllegalArgumentException");
+        (*env)->ThrowNew(env, exceptionClass, "input and output must be direct ByteBuffers containing the given ranges");
+        return 0;
+    }
+    // The signer reads and writes the JVM buffers in place
+    size_t size = function(inputBytes + inputOffset, (size_t) inputLength, coin, outputBytes + outputOffset, (size_t) outputLength);
+    return size <= (size_t) outputLength ? (jint) size : -(jint) size;
+}
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativeSignDirect(JNIEnv *env, jclass thisClass, jobject input, jint inputOffset, jint inputLength, jobject output, jint outputOffset, jint outputLength, jint coin) {
+    return signDirect(env, input, inputOffset, inputLength, output, outputOffset, outputLength, coin, TWAnySignerSignBytes);
+}
+
+jint JNICALL Java_wallet_core_java_AnySigner_nativePlanDirect(JNIEnv *env, jclass thisClass, jobject input, jint inputOffset, jint inputLength, jobject output, jint outputOffset, jint outputLength, jint coin) {
+    return signDirect(env, input, inputOffset, inputLength, output, outputOffset, outputLength, coin, TWAnySignerPlanBytes);
+}
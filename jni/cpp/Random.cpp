@@ -10,8 +10,7 @@
 static JavaVM* cachedJVM;
 
 extern "C" {
-    uint32_t random32();
-    void random_buffer(uint8_t *buf, size_t len);
+    void random_entropy(uint8_t *buf, size_t len);
 }
 
 JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved) {
@@ -19,13 +18,8 @@ JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *jvm, void *reserved) {
     return JNI_VERSION_1_2;
 }
 
-uint32_t random32() {
-    uint32_t result;
-    random_buffer((uint8_t*) &result, sizeof(uint32_t));
-    return result;
-}
-
-void random_buffer(uint8_t *buf, size_t len) {
+// Seeds the generators of random_buffer (trezor-crypto rand.c)
+void random_entropy(uint8_t *buf, size_t len) {
     JNIEnv *env;
     cachedJVM->AttachCurrentThread(&env, NULL);
 
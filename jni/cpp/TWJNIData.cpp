@@ -18,7 +18,9 @@ jbyteArray TWDataJByteArray(TWData *_Nonnull data, JNIEnv *env) {
 }
 
 TWData *_Nonnull TWDataCreateWithJByteArray(JNIEnv *env, jbyteArray _Nonnull array) {
+    // Copy straight into the new buffer, GetByteArrayElements may copy the array a second time
     jsize size = env->GetArrayLength(array);
-    jbyte *bytes = env->GetByteArrayElements(array, nullptr);
-    return TWDataCreateWithBytes((uint8_t *) bytes, size);
+    TWData *data = TWDataCreateWithSize(size);
+    env->GetByteArrayRegion(array, 0, size, (jbyte *) TWDataBytes(data));
+    return data;
 }
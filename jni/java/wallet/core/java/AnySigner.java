@@ -6,9 +6,13 @@
 
 package wallet.core.java;
 
+import com.google.protobuf.CodedOutputStream;
 import com.google.protobuf.Message;
 import com.google.protobuf.Parser;
 
+import java.nio.BufferOverflowException;
+import java.nio.ByteBuffer;
+
 import wallet.core.jni.CoinType;
 
 public class AnySigner {
@@ -33,4 +37,52 @@ public class AnySigner {
         return output;
     }
     public static native byte[] nativePlan(byte[] data, int coin);
+
+    /**
+     * Signs using caller-owned direct buffers, avoiding the intermediate Java byte arrays.
+     *
+     * The serialized input is read from {@code input}'s position to its limit. The output is written at
+     * {@code output}'s position and both positions are advanced. Returns the output size, or its negated value
+     * if {@code output} has too little space, in which case nothing is written and no position changes.
+     */
+    public static int signDirect(ByteBuffer input, ByteBuffer output, CoinType coin) {
+        return direct(input, output, nativeSignDirect(input, input.position(), input.remaining(), output, output.position(), output.remaining(), coin.value()));
+    }
+
+    /**
+     * Signs a message, marshalling through the given direct buffers instead of allocating byte arrays per call.
+     * {@code scratch} holds the serialized input, {@code output} receives the serialized signing output; both are
+     * cleared first and can be reused across calls.
+     */
+    public static <T extends Message> T sign(Message input, CoinType coin, Parser<T> parser, ByteBuffer scratch, ByteBuffer output) throws Exception {
+        scratch.clear();
+        CodedOutputStream stream = CodedOutputStream.newInstance(scratch);
+        input.writeTo(stream);
+        stream.flush();
+        scratch.flip();
+        output.clear();
+        int size = signDirect(scratch, output, coin);
+        if (size < 0) {
+            throw new BufferOverflowException();
+        }
+        output.flip();
+        return parser.parseFrom(output);
+    }
+
+    public static native int nativeSignDirect(ByteBuffer input, int inputOffset, int inputLength, ByteBuffer output, int outputOffset, int outputLength, int coin);
+
+    /** Plans using caller-owned direct buffers, see {@link #signDirect}. */
+    public static int planDirect(ByteBuffer input, ByteBuffer output, CoinType coin) {
+        return direct(input, output, nativePlanDirect(input, input.position(), input.remaining(), output, output.position(), output.remaining(), coin.value()));
+    }
+
+    public static native int nativePlanDirect(ByteBuffer input, int inputOffset, int inputLength, ByteBuffer output, int outputOffset, int outputLength, int coin);
+
+    private static int direct(ByteBuffer input, ByteBuffer output, int size) {
+        if (size >= 0) {
+            input.position(input.limit());
+            output.position(output.position() + size);
+        }
+        return size;
+    }
 }
@@ -0,0 +1,124 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+// Wire protocol of the sample daemon: length-prefixed frames over TCP, whose payloads are the serialized
+// SigningInput and SigningOutput messages of src/proto/*.proto, without any re-encoding.
+//
+// Request:  u32 length | u8 kind | u32 id | u32 coin | payload
+// Response: u32 length | u8 status | u32 id | payload
+//
+// Integers are big-endian, `length` counts the bytes after it.  Responses of a connection come in the order
+// of its requests, so that a client can pipeline them.
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace daemon_protocol {
+
+enum Kind : uint8_t {
+    /// Payload: the serialized SigningInput of the coin; response: its SigningOutput.
+    KindSign = 1,
+    /// Payload: a digest, signed with the key of the unlocked keystore; response: the signature.
+    KindSignDigest = 2,
+    /// No payload; response: the address of the unlocked keystore for the coin.
+    KindAddress = 3,
+};
+
+enum Status : uint8_t {
+    StatusOk = 0,
+    StatusUnsupportedCoin = 1,
+    StatusFailed = 2,
+    StatusBadRequest = 3,
+    StatusLocked = 4,
+};
+
+constexpr std::size_t requestHeaderSize = 9;
+constexpr std::size_t responseHeaderSize = 5;
+/// Largest frame accepted, larger ones close the connection.
+constexpr uint32_t maxFrameSize = 16 * 1024 * 1024;
+
+inline void putUInt32(std::vector<uint8_t>& data, uint32_t value) {
+    data.push_back(static_cast<uint8_t>(value >> 24));
+    data.push_back(static_cast<uint8_t>(value >> 16));
+    data.push_back(static_cast<uint8_t>(value >> 8));
+    data.push_back(static_cast<uint8_t>(value));
+}
+
+inline uint32_t getUInt32(const uint8_t* data) {
+    return uint32_t(data[0]) << 24 | uint32_t(data[1]) << 16 | uint32_t(data[2]) << 8 | uint32_t(data[3]);
+}
+
+/// Reads exactly `size` bytes; false on end of stream or error.
+inline bool readFully(int socket, uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        const auto result = ::recv(socket, data, size, 0);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        data += result;
+        size -= static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+inline bool writeFully(int socket, const uint8_t* data, std::size_t size) {
+    while (size > 0) {
+        const auto result = ::send(socket, data, size, MSG_NOSIGNAL);
+        if (result < 0 && errno == EINTR) {
+            continue;
+        }
+        if (result <= 0) {
+            return false;
+        }
+        data += result;
+        size -= static_cast<std::size_t>(result);
+    }
+    return true;
+}
+
+/// Reads a frame without its length prefix; false on end of stream, error or oversized frame.
+inline bool readFrame(int socket, std::vector<uint8_t>& frame) {
+    uint8_t length[4];
+    if (!readFully(socket, length, sizeof(length))) {
+        return false;
+    }
+    const auto size = getUInt32(length);
+    if (size > maxFrameSize) {
+        return false;
+    }
+    frame.resize(size);
+    return readFully(socket, frame.data(), frame.size());
+}
+
+/// Appends a request frame to `out`.
+inline void appendRequest(std::vector<uint8_t>& out, Kind kind, uint32_t id, uint32_t coin, const std::string& payload) {
+    putUInt32(out, static_cast<uint32_t>(requestHeaderSize + payload.size()));
+    out.push_back(kind);
+    putUInt32(out, id);
+    putUInt32(out, coin);
+    out.insert(out.end(), payload.begin(), payload.end());
+}
+
+/// Appends a response frame to `out`.
+inline void appendResponse(std::vector<uint8_t>& out, Status status, uint32_t id, const uint8_t* payload, std::size_t size) {
+    putUInt32(out, static_cast<uint32_t>(responseHeaderSize + size));
+    out.push_back(status);
+    putUInt32(out, id);
+    out.insert(out.end(), payload, payload + size);
+}
+
+} // namespace daemon_protocol
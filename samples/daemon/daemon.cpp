@@ -0,0 +1,459 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Reference signing daemon: serves signing requests of many concurrent clients with the micro-batching
+// scheduler of wallet-core, see README.md.
+
+#include "Protocol.h"
+
+#include "BatchScheduler.h"
+#include "Keystore/StoredKey.h"
+#include "Keystore/UnlockedKey.h"
+
+#include <TrustWalletCore/TWInstrumentation.h>
+#include <TrustWalletCore/TWThreadPool.h>
+#include <TrustWalletCore/TWWarmup.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TW;
+using namespace daemon_protocol;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+std::atomic<bool> stopping(false);
+
+void onSignal(int) {
+    stopping = true;
+}
+
+struct Config {
+    uint16_t port = 9000;
+    std::size_t maxBatchSize = 64;
+    std::chrono::microseconds maxDelay = std::chrono::microseconds(500);
+    uint32_t threads = 0;
+    std::string keystore;
+    std::string passwordVariable = "WALLET_PASSWORD";
+    std::chrono::seconds ttl = std::chrono::hours(1);
+    std::chrono::seconds statsInterval = std::chrono::seconds(10);
+    bool warmup = true;
+};
+
+/// Latencies of the requests of a kind and coin, in power of 2 microsecond buckets.
+struct Latency {
+    std::array<std::atomic<uint64_t>, 32> buckets{};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> totalMicroseconds{0};
+
+    void record(std::chrono::microseconds latency) {
+        const auto micros = static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0));
+        std::size_t bucket = 0;
+        while (bucket + 1 < buckets.size() && (uint64_t(1) << bucket) < micros) {
+            ++bucket;
+        }
+        ++buckets[bucket];
+        ++count;
+        totalMicroseconds += micros;
+    }
+
+    /// Upper bound of the bucket holding the `fraction` percentile.
+    uint64_t percentile(double fraction) const {
+        const auto target = static_cast<uint64_t>(fraction * static_cast<double>(count.load()));
+        uint64_t seen = 0;
+        for (std::size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+            seen += buckets[bucket];
+            if (seen > target) {
+                return uint64_t(1) << bucket;
+            }
+        }
+        return uint64_t(1) << (buckets.size() - 1);
+    }
+};
+
+class Stats {
+  public:
+    void record(Kind kind, uint32_t coin, std::chrono::microseconds elapsed) {
+        latency(kind, coin).record(elapsed);
+    }
+
+    /// Measurements of the library, with TW_INSTRUMENTATION builds.
+    static void sink(void* context, const char* operation, uint64_t durationNanoseconds, uint64_t count) {
+        auto& stats = *static_cast<Stats*>(context);
+        std::lock_guard<std::mutex> lock(stats.mutex);
+        auto& entry = stats.operations[operation];
+        entry.first += durationNanoseconds;
+        entry.second += count;
+    }
+
+    void print(std::ostream& out, std::chrono::duration<double> elapsed) {
+        std::lock_guard<std::mutex> lock(mutex);
+        out << "--- " << std::fixed << std::setprecision(1) << elapsed.count() << " s" << std::endl;
+        for (const auto& entry : latencies) {
+            const auto& latency = *entry.second;
+            const auto count = latency.count.load();
+            if (count == 0) {
+                continue;
+            }
+            out << kindName(static_cast<Kind>(entry.first.first)) << " coin " << entry.first.second
+                << ": " << count << " requests, " << static_cast<double>(count) / elapsed.count() << " /s"
+                << ", mean " << latency.totalMicroseconds / count << " us"
+                << ", p50 <" << latency.percentile(0.5) << " us, p99 <" << latency.percentile(0.99) << " us" << std::endl;
+        }
+        for (const auto& entry : operations) {
+            out << "  " << entry.first << ": " << entry.second.second << " items, "
+                << entry.second.first / 1000000 << " ms" << std::endl;
+        }
+    }
+
+  private:
+    std::mutex mutex;
+    std::map<std::pair<uint8_t, uint32_t>, std::unique_ptr<Latency>> latencies;
+    /// Total nanoseconds and count by operation.
+    std::map<std::string, std::pair<uint64_t, uint64_t>> operations;
+
+    Latency& latency(Kind kind, uint32_t coin) {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& entry = latencies[{kind, coin}];
+        if (!entry) {
+            entry = std::make_unique<Latency>();
+        }
+        return *entry;
+    }
+
+    static const char* kindName(Kind kind) {
+        switch (kind) {
+        case KindSign: return "sign";
+        case KindSignDigest: return "sign-digest";
+        case KindAddress: return "address";
+        default: return "?";
+        }
+    }
+};
+
+/// Services shared by the connections.
+struct Service {
+    BatchScheduler& scheduler;
+    const Keystore::UnlockedKey* unlocked;
+    Stats& stats;
+};
+
+/// Requests of a connection in progress, answered in order by the writer thread.
+class Pending {
+  public:
+    /// Returns the response frame, waiting for it if needed.
+    using Completion = std::function<std::vector<uint8_t>()>;
+
+    struct Entry {
+        Kind kind;
+        uint32_t coin;
+        Clock::time_point received;
+        Completion complete;
+    };
+
+    /// Queues an entry, waiting while `maxDepth` entries are in progress; false once closed.
+    bool push(Entry entry) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return entries.size() < maxDepth || closed; });
+        if (closed) {
+            return false;
+        }
+        entries.push_back(std::move(entry));
+        changed.notify_all();
+        return true;
+    }
+
+    /// Takes the oldest entry; false once closed and empty.
+    bool pop(Entry& entry) {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this] { return !entries.empty() || closed; });
+        if (entries.empty()) {
+            return false;
+        }
+        entry = std::move(entries.front());
+        entries.pop_front();
+        changed.notify_all();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        changed.notify_all();
+    }
+
+  private:
+    static constexpr std::size_t maxDepth = 1024;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<Entry> entries;
+    bool closed = false;
+};
+
+std::vector<uint8_t> response(Status status, uint32_t id, const Data& payload = {}) {
+    std::vector<uint8_t> frame;
+    appendResponse(frame, status, id, payload.data(), payload.size());
+    return frame;
+}
+
+/// Starts a request, returning how to complete it.
+Pending::Completion start(Service& service, Kind kind, uint32_t id, TWCoinType coin, Data payload) {
+    switch (kind) {
+    case KindSign: {
+        auto future = std::make_shared<std::future<BatchSigningResult>>(service.scheduler.sign(coin, std::move(payload)));
+        return [future, id] {
+            const auto result = future->get();
+            switch (result.error) {
+            case TWAnySignerBatchErrorNone: return response(StatusOk, id, result.output);
+            case TWAnySignerBatchErrorUnsupportedCoin: return response(StatusUnsupportedCoin, id);
+            default: return response(StatusFailed, id);
+            }
+        };
+    }
+    case KindSignDigest:
+    case KindAddress: {
+        // the unlocked key signs and derives without a key derivation, on the writer thread
+        const auto unlocked = service.unlocked;
+        return [unlocked, kind, id, coin, payload = std::move(payload)] {
+            if (unlocked == nullptr) {
+                return response(StatusLocked, id);
+            }
+            try {
+                if (kind == KindSignDigest) {
+                    return response(StatusOk, id, unlocked->sign(coin, payload));
+                }
+                const auto address = unlocked->deriveAddress(coin);
+                return response(StatusOk, id, Data(address.begin(), address.end()));
+            } catch (const Keystore::KeyLockedError&) {
+                return response(StatusLocked, id);
+            } catch (const std::exception&) {
+                return response(StatusFailed, id);
+            }
+        };
+    }
+    default:
+        return [id] { return response(StatusBadRequest, id); };
+    }
+}
+
+struct Connection {
+    int socket;
+    std::atomic<bool> done{false};
+    std::thread thread;
+};
+
+/// Serves the requests of a connection until the client closes it; the socket is closed by the caller.
+void serveConnection(Service& service, int socket) {
+    Pending pending;
+    std::thread writer([&] {
+        Pending::Entry entry;
+        std::vector<uint8_t> out;
+        while (pending.pop(entry)) {
+            const auto frame = entry.complete();
+            service.stats.record(entry.kind, entry.coin, std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - entry.received));
+            if (!writeFully(socket, frame.data(), frame.size())) {
+                pending.close();
+                ::shutdown(socket, SHUT_RDWR);
+            }
+        }
+    });
+
+    std::vector<uint8_t> frame;
+    while (!stopping && readFrame(socket, frame)) {
+        const auto received = Clock::now();
+        if (frame.size() < requestHeaderSize) {
+            break;
+        }
+        const auto kind = static_cast<Kind>(frame[0]);
+        const auto id = getUInt32(frame.data() + 1);
+        const auto coin = getUInt32(frame.data() + 5);
+        auto payload = Data(frame.begin() + requestHeaderSize, frame.end());
+        auto complete = start(service, kind, id, static_cast<TWCoinType>(coin), std::move(payload));
+        if (!pending.push({kind, coin, received, std::move(complete)})) {
+            break;
+        }
+    }
+    pending.close();
+    writer.join();
+}
+
+bool parseArguments(int argc, char* argv[], Config& config) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("missing value of " + argument);
+            }
+            return argv[++i];
+        };
+        if (argument == "--port") {
+            config.port = static_cast<uint16_t>(std::stoul(value()));
+        } else if (argument == "--batch") {
+            config.maxBatchSize = std::stoul(value());
+        } else if (argument == "--delay-us") {
+            config.maxDelay = std::chrono::microseconds(std::stoul(value()));
+        } else if (argument == "--threads") {
+            config.threads = static_cast<uint32_t>(std::stoul(value()));
+        } else if (argument == "--keystore") {
+            config.keystore = value();
+        } else if (argument == "--password-env") {
+            config.passwordVariable = value();
+        } else if (argument == "--ttl") {
+            config.ttl = std::chrono::seconds(std::stoul(value()));
+        } else if (argument == "--stats") {
+            config.statsInterval = std::chrono::seconds(std::stoul(value()));
+        } else if (argument == "--no-warmup") {
+            config.warmup = false;
+        } else {
+            std::cerr << "usage: daemon [--port 9000] [--batch 64] [--delay-us 500] [--threads 0] [--keystore file.json "
+                         "[--password-env WALLET_PASSWORD] [--ttl 3600]] [--stats 10] [--no-warmup]"
+                      << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int listenOn(uint16_t port) {
+    const auto listener = ::socket(AF_INET6, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return -1;
+    }
+    int yes = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof(yes));
+    sockaddr_in6 address{};
+    address.sin6_family = AF_INET6;
+    address.sin6_addr = in6addr_any;
+    address.sin6_port = htons(port);
+    if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || ::listen(listener, 128) != 0) {
+        ::close(listener);
+        return -1;
+    }
+    return listener;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Config config;
+    try {
+        if (!parseArguments(argc, argv, config)) {
+            return 2;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+
+    Stats stats;
+    TWInstrumentationSetSink(&Stats::sink, &stats);
+    TWThreadPoolSetThreadCount(config.threads);
+    if (config.warmup) {
+        const auto nanoseconds = TWWarmup(nullptr, 0, TWWarmupFlagsDefault | TWWarmupFlagsLockTables);
+        std::cout << "warm-up: " << nanoseconds / 1000000 << " ms" << std::endl;
+    }
+
+    std::unique_ptr<Keystore::UnlockedKey> unlocked;
+    if (!config.keystore.empty()) {
+        const auto password = std::getenv(config.passwordVariable.c_str());
+        if (password == nullptr) {
+            std::cerr << "set the keystore password in " << config.passwordVariable << std::endl;
+            return 2;
+        }
+        try {
+            const auto key = Keystore::StoredKey::load(config.keystore);
+            unlocked = key.unlock(Data(password, password + std::strlen(password)), config.ttl);
+        } catch (const std::exception& error) {
+            std::cerr << "cannot unlock " << config.keystore << ": " << error.what() << std::endl;
+            return 1;
+        }
+    }
+
+    BatchScheduler::Options options;
+    options.maxBatchSize = config.maxBatchSize;
+    options.maxDelay = config.maxDelay;
+    BatchScheduler scheduler(options);
+    Service service{scheduler, unlocked.get(), stats};
+
+    const auto listener = listenOn(config.port);
+    if (listener < 0) {
+        std::cerr << "cannot listen on port " << config.port << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    ::signal(SIGINT, onSignal);
+    ::signal(SIGTERM, onSignal);
+    std::cout << "listening on port " << config.port << ", " << TWThreadPoolThreadCount() << " threads" << std::endl;
+
+    const auto started = Clock::now();
+    auto nextStats = started + config.statsInterval;
+    std::vector<std::unique_ptr<Connection>> connections;
+    const auto reap = [&connections](bool all) {
+        for (auto it = connections.begin(); it != connections.end();) {
+            auto& connection = **it;
+            if (!all && !connection.done) {
+                ++it;
+                continue;
+            }
+            // wakes up the reader, the writer finishes the requests in progress
+            ::shutdown(connection.socket, SHUT_RD);
+            connection.thread.join();
+            ::close(connection.socket);
+            it = connections.erase(it);
+        }
+    };
+    while (!stopping) {
+        pollfd poll{listener, POLLIN, 0};
+        if (::poll(&poll, 1, 200) > 0) {
+            const auto socket = ::accept(listener, nullptr, nullptr);
+            if (socket >= 0) {
+                int yes = 1;
+                ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+                auto connection = std::make_unique<Connection>();
+                connection->socket = socket;
+                connection->thread = std::thread([&service, connection = connection.get()] {
+                    serveConnection(service, connection->socket);
+                    connection->done = true;
+                });
+                connections.push_back(std::move(connection));
+            }
+        }
+        reap(false);
+        if (config.statsInterval.count() > 0 && Clock::now() >= nextStats) {
+            stats.print(std::cout, Clock::now() - started);
+            nextStats += config.statsInterval;
+        }
+    }
+
+    ::close(listener);
+    reap(true);
+    stats.print(std::cout, Clock::now() - started);
+    TWInstrumentationSetSink(nullptr, nullptr);
+    return 0;
+}
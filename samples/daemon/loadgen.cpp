@@ -0,0 +1,246 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Load generator of the sample daemon: pipelines requests on several connections, and reports the throughput
+// and the latency percentiles seen by the clients.
+
+#include "Protocol.h"
+
+#include "uint256.h"
+#include "proto/Ethereum.pb.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace TW;
+using namespace daemon_protocol;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+
+struct Config {
+    std::string host = "127.0.0.1";
+    std::string port = "9000";
+    std::size_t connections = 8;
+    std::size_t depth = 32;
+    std::size_t requests = 100000;
+    Kind kind = KindSign;
+    uint32_t coin = TWCoinTypeEthereum;
+    /// Serialized SigningInput sent for all requests, generated Ethereum transfers if empty.
+    std::string input;
+};
+
+std::string ethereumInput(uint64_t nonce) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonceData = store(uint256_t(nonce));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = Data(32, 0x46);
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonceData.data(), nonceData.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return input.SerializeAsString();
+}
+
+std::string payload(const Config& config, uint64_t index) {
+    switch (config.kind) {
+    case KindSign: return config.input.empty() ? ethereumInput(index) : config.input;
+    case KindSignDigest: return std::string(32, static_cast<char>(index));
+    default: return "";
+    }
+}
+
+int connectTo(const Config& config) {
+    addrinfo hints{};
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (::getaddrinfo(config.host.c_str(), config.port.c_str(), &hints, &addresses) != 0) {
+        return -1;
+    }
+    int socket = -1;
+    for (auto address = addresses; address != nullptr && socket < 0; address = address->ai_next) {
+        socket = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+        if (socket >= 0 && ::connect(socket, address->ai_addr, address->ai_addrlen) != 0) {
+            ::close(socket);
+            socket = -1;
+        }
+    }
+    ::freeaddrinfo(addresses);
+    if (socket >= 0) {
+        int yes = 1;
+        ::setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &yes, sizeof(yes));
+    }
+    return socket;
+}
+
+struct Result {
+    std::vector<uint32_t> latencies;
+    std::size_t errors = 0;
+    bool disconnected = false;
+};
+
+/// Sends `count` requests on a connection, keeping `depth` of them in flight.
+Result runConnection(const Config& config, std::size_t connection, std::size_t count) {
+    Result result;
+    result.latencies.reserve(count);
+    const auto socket = connectTo(config);
+    if (socket < 0) {
+        result.disconnected = true;
+        return result;
+    }
+    // payloads are prepared ahead, so that the measurement doesn't include them
+    std::vector<std::string> payloads;
+    for (std::size_t i = 0; i < std::min<std::size_t>(count, 256); ++i) {
+        payloads.push_back(payload(config, connection * count + i));
+    }
+
+    std::deque<Clock::time_point> inFlight;
+    std::vector<uint8_t> out;
+    std::vector<uint8_t> frame;
+    std::size_t sent = 0;
+    while (result.latencies.size() + result.errors < count) {
+        out.clear();
+        while (sent < count && inFlight.size() < config.depth) {
+            appendRequest(out, config.kind, static_cast<uint32_t>(sent), config.coin, payloads[sent % payloads.size()]);
+            inFlight.push_back(Clock::now());
+            ++sent;
+        }
+        if (!out.empty() && !writeFully(socket, out.data(), out.size())) {
+            result.disconnected = true;
+            break;
+        }
+        if (!readFrame(socket, frame) || frame.size() < responseHeaderSize) {
+            result.disconnected = true;
+            break;
+        }
+        const auto latency = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - inFlight.front());
+        inFlight.pop_front();
+        if (frame[0] != StatusOk) {
+            ++result.errors;
+        } else {
+            result.latencies.push_back(static_cast<uint32_t>(latency.count()));
+        }
+    }
+    ::close(socket);
+    return result;
+}
+
+bool parseArguments(int argc, char* argv[], Config& config) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        const auto value = [&]() -> std::string {
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("missing value of " + argument);
+            }
+            return argv[++i];
+        };
+        if (argument == "--host") {
+            config.host = value();
+        } else if (argument == "--port") {
+            config.port = value();
+        } else if (argument == "--connections") {
+            config.connections = std::max<std::size_t>(std::stoul(value()), 1);
+        } else if (argument == "--depth") {
+            config.depth = std::max<std::size_t>(std::stoul(value()), 1);
+        } else if (argument == "--requests") {
+            config.requests = std::stoul(value());
+        } else if (argument == "--coin") {
+            config.coin = static_cast<uint32_t>(std::stoul(value()));
+        } else if (argument == "--input") {
+            std::ifstream file(value(), std::ios::binary);
+            config.input.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        } else if (argument == "--kind") {
+            const auto kind = value();
+            config.kind = kind == "digest" ? KindSignDigest : (kind == "address" ? KindAddress : KindSign);
+        } else {
+            std::cerr << "usage: loadgen [--host 127.0.0.1] [--port 9000] [--connections 8] [--depth 32] [--requests 100000] "
+                         "[--kind sign|digest|address] [--coin 60] [--input signing_input.bin]"
+                      << std::endl;
+            return false;
+        }
+    }
+    if (config.kind == KindSign && config.input.empty() && config.coin != TWCoinTypeEthereum) {
+        std::cerr << "--input is needed to sign for coin " << config.coin << std::endl;
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Config config;
+    try {
+        if (!parseArguments(argc, argv, config)) {
+            return 2;
+        }
+    } catch (const std::exception& error) {
+        std::cerr << error.what() << std::endl;
+        return 2;
+    }
+
+    std::vector<Result> results(config.connections);
+    std::vector<std::thread> threads;
+    const auto start = Clock::now();
+    for (std::size_t c = 0; c < config.connections; ++c) {
+        const auto count = config.requests / config.connections + (c < config.requests % config.connections ? 1 : 0);
+        threads.emplace_back([&, c, count] { results[c] = runConnection(config, c, count); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const auto elapsed = std::chrono::duration<double>(Clock::now() - start);
+
+    std::vector<uint32_t> latencies;
+    std::size_t errors = 0;
+    std::size_t disconnected = 0;
+    for (const auto& result : results) {
+        latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+        errors += result.errors;
+        disconnected += result.disconnected ? 1 : 0;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&latencies](double fraction) -> uint32_t {
+        if (latencies.empty()) {
+            return 0;
+        }
+        return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(fraction * static_cast<double>(latencies.size())))];
+    };
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "coin " << config.coin << ", " << config.connections << " connections x " << config.depth << " in flight" << std::endl;
+    std::cout << latencies.size() << " ok, " << errors << " errors, " << disconnected << " connections lost, in "
+              << elapsed.count() << " s: " << static_cast<double>(latencies.size()) / elapsed.count() << " requests/s" << std::endl;
+    std::cout << "latency (us): p50 " << percentile(0.5) << ", p90 " << percentile(0.9) << ", p99 " << percentile(0.99)
+              << ", p99.9 " << percentile(0.999) << ", max " << (latencies.empty() ? 0 : latencies.back()) << std::endl;
+    return errors == 0 && disconnected == 0 ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AddressFilter.h"
+#include "BinaryCoding.h"
+#include "Coin.h"
+#include "XXHash64.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+constexpr char magic[4] = {'T', 'W', 'A', 'F'};
+constexpr byte version = 1;
+constexpr std::size_t headerSize = sizeof(magic) + 1 + 4 + 8 + 8;
+
+/// Multipliers selecting a bit in each word of a block, from Parquet's split block Bloom filters.
+constexpr uint32_t salts[8] = {0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947, 0x5c6bfb31};
+
+uint64_t hashKey(DataView key) {
+    return XXHash64::hash(key.data(), key.size(), 0);
+}
+
+/// The bit of each word of a block set by a key.
+inline void mask(uint32_t hash, uint32_t bits[8]) {
+    for (int i = 0; i < 8; ++i) {
+        bits[i] = uint32_t(1) << ((hash * salts[i]) >> 27);
+    }
+}
+
+} // namespace
+
+AddressFilter::AddressFilter(std::size_t capacity, std::size_t bitsPerKey) : keyCapacity(capacity) {
+    const auto bits = std::max<std::size_t>(capacity * std::max<std::size_t>(bitsPerKey, 1), 1);
+    // fast range reduction of 32 bits
+    blocks.resize(std::min<std::size_t>((bits + 255) / 256, UINT32_MAX), Block{});
+}
+
+AddressFilter::AddressFilter(const Data& serialized) {
+    if (serialized.size() < headerSize || !std::equal(magic, magic + sizeof(magic), serialized.begin()) || serialized[4] != version) {
+        throw std::invalid_argument("Invalid address filter");
+    }
+    const auto blockCount = decode32LE(serialized.data() + 5);
+    keyCapacity = static_cast<std::size_t>(decode64LE(serialized.data() + 9));
+    count = static_cast<std::size_t>(decode64LE(serialized.data() + 17));
+    if (blockCount == 0 || serialized.size() != headerSize + std::size_t(blockCount) * sizeof(Block)) {
+        throw std::invalid_argument("Invalid address filter");
+    }
+    blocks.resize(blockCount);
+    const auto* data = serialized.data() + headerSize;
+    for (auto& block : blocks) {
+        for (auto& word : block.words) {
+            word = decode32LE(data);
+            data += 4;
+        }
+    }
+}
+
+bool AddressFilter::key(TWCoinType coin, const std::string& address, Data& key) {
+    const auto script = Bitcoin::Script::lockScriptForAddress(address, coin);
+    DataView destination;
+    if (script.matchDestination(destination)) {
+        key.assign(destination.data(), destination.data() + destination.size());
+        return true;
+    }
+    auto parsed = TW::parseAddress(coin, address);
+    if (!parsed) {
+        return false;
+    }
+    if (parsed->hasData && !parsed->data.empty()) {
+        key = std::move(parsed->data);
+    } else {
+        key.assign(parsed->normalized.begin(), parsed->normalized.end());
+    }
+    return true;
+}
+
+void AddressFilter::insert(DataView key) {
+    const auto hash = hashKey(key);
+    uint32_t bits[8];
+    mask(static_cast<uint32_t>(hash), bits);
+    auto& target = blocks[blockIndex(hash)];
+    for (int i = 0; i < 8; ++i) {
+        target.words[i] |= bits[i];
+    }
+    ++count;
+}
+
+bool AddressFilter::insert(TWCoinType coin, const std::string& address) {
+    Data bytes;
+    if (!key(coin, address, bytes)) {
+        return false;
+    }
+    insert(bytes);
+    return true;
+}
+
+void AddressFilter::insert(TWCoinType coin, const std::vector<std::string>& addresses) {
+    Data bytes;
+    for (const auto& address : addresses) {
+        if (key(coin, address, bytes)) {
+            insert(bytes);
+        }
+    }
+}
+
+bool AddressFilter::mayContain(DataView key) const {
+    const auto hash = hashKey(key);
+    uint32_t bits[8];
+    mask(static_cast<uint32_t>(hash), bits);
+    const auto& target = blocks[blockIndex(hash)];
+    uint32_t missing = 0;
+    for (int i = 0; i < 8; ++i) {
+        missing |= bits[i] & ~target.words[i];
+    }
+    return missing == 0;
+}
+
+bool AddressFilter::mayContain(const Bitcoin::Script& script) const {
+    DataView destination;
+    return script.matchDestination(destination) && mayContain(destination);
+}
+
+Data AddressFilter::serialize() const {
+    Data result(magic, magic + sizeof(magic));
+    result.reserve(headerSize + blocks.size() * sizeof(Block));
+    result.push_back(version);
+    encode32LE(static_cast<uint32_t>(blocks.size()), result);
+    encode64LE(keyCapacity, result);
+    encode64LE(count, result);
+    for (const auto& block : blocks) {
+        for (const auto word : block.words) {
+            encode32LE(word, result);
+        }
+    }
+    return result;
+}
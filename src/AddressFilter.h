@@ -0,0 +1,80 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Bitcoin/Script.h"
+#include "Data.h"
+#include "Ethereum/Address.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Probabilistic prefilter of the destinations of a wallet's addresses (key hashes, script hashes, Ethereum
+/// addresses), for rejecting most outputs of a block before an exact lookup, in AddressIndex for instance.
+/// A split block Bloom filter: each key sets 8 bits in a single 32-byte block, so that a query reads one cache line.
+/// There are no false negatives; with the default 16 bits per key, about 0.1% false positives up to its capacity.
+class AddressFilter {
+  public:
+    static constexpr std::size_t defaultBitsPerKey = 16;
+
+    /// An empty filter for `capacity` keys.
+    explicit AddressFilter(std::size_t capacity, std::size_t bitsPerKey = defaultBitsPerKey);
+
+    /// A filter from its serialized form.
+    ///
+    /// @throws std::invalid_argument if the data isn't a serialized filter.
+    explicit AddressFilter(const Data& serialized);
+
+    /// The key of an address: the destination of its output script for UTXO coins, its decoded data, or its
+    /// normalized string for coins without; false if the address isn't valid.
+    static bool key(TWCoinType coin, const std::string& address, Data& key);
+
+    void insert(DataView key);
+
+    /// Inserts the key of an address; returns false if the address isn't valid.
+    bool insert(TWCoinType coin, const std::string& address);
+
+    /// Inserts the keys of addresses, such as those derived by HDWallet::deriveAddresses; invalid ones are skipped.
+    void insert(TWCoinType coin, const std::vector<std::string>& addresses);
+
+    /// False if the key was never inserted, true if it probably was.
+    bool mayContain(DataView key) const;
+
+    /// Whether a script may pay to an inserted destination; false for scripts without a standard destination.
+    bool mayContain(const Bitcoin::Script& script) const;
+
+    bool mayContain(const Ethereum::Address& address) const { return mayContain(DataView(address.bytes)); }
+
+    /// Number of keys inserted, counting repeated ones.
+    std::size_t size() const { return count; }
+
+    std::size_t capacity() const { return keyCapacity; }
+
+    /// Whether more keys than its capacity were inserted; a filter can't grow, it is rebuilt larger from the keys.
+    bool isFull() const { return count > keyCapacity; }
+
+    Data serialize() const;
+
+  private:
+    struct alignas(32) Block {
+        uint32_t words[8];
+    };
+
+    std::vector<Block> blocks;
+    std::size_t keyCapacity = 0;
+    std::size_t count = 0;
+
+    /// The block of a key, from the high bits of its hash.
+    std::size_t blockIndex(uint64_t hash) const { return static_cast<std::size_t>(((hash >> 32) * blocks.size()) >> 32); }
+};
+
+} // namespace TW
@@ -0,0 +1,294 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AddressIndex.h"
+#include "Coin.h"
+#include "XXHash64.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace TW;
+
+namespace {
+
+constexpr char magic[8] = {'T', 'W', 'A', 'D', 'D', 'R', 'I', 'X'};
+constexpr uint32_t version = 1;
+constexpr std::size_t initialCapacity = 1024;
+constexpr std::size_t maxKeySize = 32;
+
+} // namespace
+
+/// Start of the mapping, followed by the slots.
+struct AddressIndex::Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t capacity;
+    uint64_t count;
+    byte reserved[32];
+};
+
+/// An address and its location; a power of two of them, probed linearly.
+struct AddressIndex::Slot {
+    /// Hash of the coin and key, never 0, which marks an empty slot.
+    uint64_t tag;
+    uint32_t coin;
+    uint32_t account;
+    uint32_t change;
+    uint32_t index;
+    uint8_t keySize;
+    /// Decoded address, or its SHA256 hash if longer.
+    byte key[maxKeySize];
+    byte reserved[7];
+};
+
+std::size_t AddressIndex::mappingSize(std::size_t capacity) {
+    static_assert(sizeof(Header) == 64 && sizeof(Slot) == 64, "the file layout must not depend on the platform");
+    return sizeof(Header) + capacity * sizeof(Slot);
+}
+
+AddressIndex::AddressIndex(HDWallet wallet, uint32_t gapLimit, const std::string& path)
+    : wallet(std::move(wallet)), gap(gapLimit) {
+    if (path.empty()) {
+        map(initialCapacity);
+        return;
+    }
+    fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        throw std::runtime_error("Can't open address index file");
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Can't open address index file");
+    }
+    if (status.st_size == 0) {
+        try {
+            map(initialCapacity);
+        } catch (...) {
+            ::close(fd);
+            throw;
+        }
+        return;
+    }
+
+    const auto size = static_cast<std::size_t>(status.st_size);
+    void* mapping = size >= sizeof(Header) ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    if (mapping == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Invalid address index file");
+    }
+    header = static_cast<Header*>(mapping);
+    const auto capacity = header->capacity;
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version || header->slotSize != sizeof(Slot) ||
+        capacity == 0 || (capacity & (capacity - 1)) != 0 || mappingSize(capacity) != size) {
+        munmap(mapping, size);
+        ::close(fd);
+        throw std::runtime_error("Invalid address index file");
+    }
+    // the chains derived so far
+    const auto* slot = slots();
+    for (std::size_t i = 0; i < capacity; ++i, ++slot) {
+        if (slot->tag != 0) {
+            auto& count = derived[Chain(static_cast<TWCoinType>(slot->coin), slot->account, slot->change)];
+            count = std::max(count, slot->index + 1);
+        }
+    }
+}
+
+AddressIndex::~AddressIndex() {
+    unmap();
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void AddressIndex::track(TWCoinType coin, uint32_t account, uint32_t change) {
+    extend(Chain(coin, account, change), gap);
+}
+
+void AddressIndex::markUsed(const Location& location) {
+    extend(Chain(location.coin, location.account, location.change), location.index + 1 + gap);
+}
+
+std::optional<AddressIndex::Location> AddressIndex::find(TWCoinType coin, const std::string& address) const {
+    Slot key;
+    if (!makeSlot(coin, address, key)) {
+        return std::nullopt;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    return findLocked(key);
+}
+
+std::vector<std::optional<AddressIndex::Location>> AddressIndex::find(TWCoinType coin, const std::vector<std::string>& addresses) const {
+    // decoded outside of the lock
+    std::vector<Slot> keys(addresses.size());
+    std::vector<bool> valid(addresses.size());
+    for (std::size_t i = 0; i < addresses.size(); ++i) {
+        valid[i] = makeSlot(coin, addresses[i], keys[i]);
+    }
+    std::vector<std::optional<Location>> result(addresses.size());
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::size_t i = 0; i < addresses.size(); ++i) {
+        if (valid[i]) {
+            result[i] = findLocked(keys[i]);
+        }
+    }
+    return result;
+}
+
+std::size_t AddressIndex::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return static_cast<std::size_t>(header->count);
+}
+
+bool AddressIndex::makeSlot(TWCoinType coin, const std::string& address, Slot& slot) {
+    const auto parsed = TW::parseAddress(coin, address);
+    if (!parsed) {
+        return false;
+    }
+    std::memset(&slot, 0, sizeof(slot));
+    // binary where the coin decodes its addresses, the normalized string otherwise
+    const auto* bytes = reinterpret_cast<const byte*>(parsed->normalized.data());
+    auto size = parsed->normalized.size();
+    if (parsed->hasData && !parsed->data.empty()) {
+        bytes = parsed->data.data();
+        size = parsed->data.size();
+    }
+    if (size > maxKeySize) {
+        const auto hash = Hash::sha256Digest(DataView(bytes, size));
+        std::memcpy(slot.key, hash.data(), hash.size());
+        slot.keySize = static_cast<uint8_t>(hash.size());
+    } else {
+        std::memcpy(slot.key, bytes, size);
+        slot.keySize = static_cast<uint8_t>(size);
+    }
+    slot.coin = static_cast<uint32_t>(coin);
+    slot.tag = std::max<uint64_t>(XXHash64::hash(slot.key, slot.keySize, slot.coin), 1);
+    return true;
+}
+
+void AddressIndex::extend(const Chain& chain, uint32_t count) {
+    uint32_t first;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        first = derived[chain];
+        if (first >= count) {
+            return;
+        }
+    }
+    // derived outside of the lock, a concurrent extension of the chain inserts the same slots
+    const auto [coin, account, change] = chain;
+    const auto addresses = wallet.deriveAddresses(coin, account, change, first, count - first);
+    std::vector<Slot> slots;
+    slots.reserve(addresses.size());
+    for (uint32_t i = 0; i < addresses.size(); ++i) {
+        Slot slot;
+        if (makeSlot(coin, addresses[i], slot)) {
+            slot.account = account;
+            slot.change = change;
+            slot.index = first + i;
+            slots.push_back(slot);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& slot : slots) {
+        insertLocked(slot);
+    }
+    auto& total = derived[chain];
+    total = std::max(total, count);
+}
+
+void AddressIndex::map(std::size_t capacity) {
+    const auto size = mappingSize(capacity);
+    if (fd >= 0 && ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        throw std::runtime_error("Can't resize address index file");
+    }
+    void* mapping = fd >= 0 ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                            : mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Can't map address index");
+    }
+    std::memset(mapping, 0, size);
+    header = static_cast<Header*>(mapping);
+    std::memcpy(header->magic, magic, sizeof(magic));
+    header->version = version;
+    header->slotSize = sizeof(Slot);
+    header->capacity = capacity;
+}
+
+void AddressIndex::unmap() {
+    if (header != nullptr) {
+        munmap(header, mappingSize(header->capacity));
+        header = nullptr;
+    }
+}
+
+AddressIndex::Slot* AddressIndex::slots() const {
+    return reinterpret_cast<Slot*>(header + 1);
+}
+
+void AddressIndex::insertLocked(const Slot& slot) {
+    // at most 70% full
+    if ((header->count + 1) * 10 > header->capacity * 7) {
+        growLocked();
+    }
+    const auto mask = header->capacity - 1;
+    auto* table = slots();
+    for (auto i = slot.tag & mask;; i = (i + 1) & mask) {
+        auto& entry = table[i];
+        if (entry.tag == 0) {
+            entry = slot;
+            ++header->count;
+            return;
+        }
+        if (entry.tag == slot.tag && entry.coin == slot.coin && entry.keySize == slot.keySize &&
+            std::memcmp(entry.key, slot.key, slot.keySize) == 0) {
+            entry = slot;
+            return;
+        }
+    }
+}
+
+void AddressIndex::growLocked() {
+    std::vector<Slot> entries;
+    entries.reserve(static_cast<std::size_t>(header->count));
+    const auto* table = slots();
+    for (std::size_t i = 0; i < header->capacity; ++i) {
+        if (table[i].tag != 0) {
+            entries.push_back(table[i]);
+        }
+    }
+    const auto capacity = static_cast<std::size_t>(header->capacity) * 2;
+    unmap();
+    map(capacity);
+    for (const auto& entry : entries) {
+        insertLocked(entry);
+    }
+}
+
+std::optional<AddressIndex::Location> AddressIndex::findLocked(const Slot& key) const {
+    const auto mask = header->capacity - 1;
+    const auto* table = slots();
+    for (auto i = key.tag & mask;; i = (i + 1) & mask) {
+        const auto& entry = table[i];
+        if (entry.tag == 0) {
+            return std::nullopt;
+        }
+        if (entry.tag == key.tag && entry.coin == key.coin && entry.keySize == key.keySize &&
+            std::memcmp(entry.key, key.key, key.keySize) == 0) {
+            return Location{static_cast<TWCoinType>(entry.coin), entry.account, entry.change, entry.index};
+        }
+    }
+}
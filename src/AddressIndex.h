@@ -0,0 +1,93 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "HDWallet.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace TW {
+
+/// Reverse index from the addresses of a wallet to their derivation paths, for attributing deposits.
+/// Addresses are derived ahead, up to a gap limit beyond the last one used on each chain (coin, account, change),
+/// and stored as compact binary keys (the decoded address, such as a public key hash) in an open-addressing
+/// table, in memory or mapped from a file.
+class AddressIndex {
+  public:
+    /// Where an address was derived: m/purpose'/coin'/account'/change/index.
+    struct Location {
+        TWCoinType coin;
+        uint32_t account;
+        uint32_t change;
+        uint32_t index;
+    };
+
+    static constexpr uint32_t defaultGapLimit = 20;
+
+    /// Index of the addresses of `wallet`, in anonymous memory, or in the file at `path`, created if missing.
+    /// An existing file is reused: its addresses are found, and its chains extended, without deriving them again.
+    ///
+    /// @throws std::runtime_error if the file can't be mapped or isn't an address index.
+    explicit AddressIndex(HDWallet wallet, uint32_t gapLimit = defaultGapLimit, const std::string& path = "");
+    ~AddressIndex();
+
+    AddressIndex(const AddressIndex&) = delete;
+    AddressIndex& operator=(const AddressIndex&) = delete;
+
+    /// Derives the addresses of a chain up to the gap limit, if not done yet.
+    void track(TWCoinType coin, uint32_t account = 0, uint32_t change = 0);
+
+    /// Marks an address as used, deriving the addresses of its chain up to the gap limit beyond it.
+    void markUsed(const Location& location);
+
+    /// Location of an address of a coin, if indexed.
+    std::optional<Location> find(TWCoinType coin, const std::string& address) const;
+
+    /// Locations of many addresses of a coin, in the same order.
+    std::vector<std::optional<Location>> find(TWCoinType coin, const std::vector<std::string>& addresses) const;
+
+    /// Number of addresses indexed.
+    std::size_t size() const;
+
+    /// Number of addresses derived beyond the last one used.
+    uint32_t gapLimit() const { return gap; }
+
+  private:
+    struct Header;
+    struct Slot;
+    using Chain = std::tuple<TWCoinType, uint32_t, uint32_t>;
+
+    HDWallet wallet;
+    uint32_t gap;
+    int fd = -1;
+    Header* header = nullptr;
+    /// Number of addresses derived on each chain, from index 0.
+    std::map<Chain, uint32_t> derived;
+    mutable std::mutex mutex;
+
+    static std::size_t mappingSize(std::size_t capacity);
+    /// The key of an address, tagged with a hash; false if the address isn't valid.
+    static bool makeSlot(TWCoinType coin, const std::string& address, Slot& slot);
+    /// Derives the addresses of a chain up to `count`.
+    void extend(const Chain& chain, uint32_t count);
+    void map(std::size_t capacity);
+    void unmap();
+    void insertLocked(const Slot& slot);
+    void growLocked();
+    std::optional<Location> findLocked(const Slot& key) const;
+    Slot* slots() const;
+};
+
+} // namespace TW
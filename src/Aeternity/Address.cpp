@@ -30,7 +30,7 @@ Address::Address(const PublicKey &publicKey) {
         throw std::invalid_argument("Invalid public key type");
     }
 
-    bytes = publicKey.bytes;
+    bytes = publicKey.bytes.toData();
 }
 
 /// Initializes an address from a string representation.
@@ -11,7 +11,8 @@
 #include "HexCoding.h"
 #include "Identifiers.h"
 #include <Data.h>
-#include <Ethereum/RLP.h>
+#include <Ethereum/RLPWriter.h>
+#include <Hash.h>
 
 using namespace TW;
 using namespace TW::Aeternity;
@@ -49,22 +50,20 @@ Proto::SigningOutput Signer::sign(const TW::PrivateKey &privateKey, Transaction
 }
 
 Data Signer::buildRlpTxRaw(Data& txRaw, Data& sigRaw) {
-    auto rlpTxRaw = Data();
-    auto signaturesList = Data();
-    append(signaturesList, Ethereum::RLP::encode(sigRaw));
-
-    append(rlpTxRaw, Ethereum::RLP::encode(Identifiers::objectTagSignedTransaction));
-    append(rlpTxRaw, Ethereum::RLP::encode(Identifiers::rlpMessageVersion));
-    append(rlpTxRaw, Ethereum::RLP::encodeList(signaturesList));
-    append(rlpTxRaw, Ethereum::RLP::encode(txRaw));
-
-    return Ethereum::RLP::encodeList(rlpTxRaw);
+    return Ethereum::rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(Identifiers::objectTagSignedTransaction)
+                .item(Identifiers::rlpMessageVersion)
+                .list([&](auto& signatures) { signatures.item(sigRaw); })
+                .item(txRaw);
+        });
+    });
 }
 
 Data Signer::buildMessageToSign(Data& txRaw) {
     auto data = Data();
-    Data bytes(Identifiers::networkId.begin(), Identifiers::networkId.end());
-    append(data, bytes);
+    data.reserve(Identifiers::networkId.size() + txRaw.size());
+    data.insert(data.end(), Identifiers::networkId.begin(), Identifiers::networkId.end());
     append(data, txRaw);
     return data;
 }
@@ -78,12 +77,12 @@ Proto::SigningOutput Signer::createProtoOutput(std::string& signature, const std
 }
 
 std::string Signer::encodeBase64WithChecksum(const std::string& prefix, const TW::Data& rawTx) {
-    auto checksum = Hash::sha256(Hash::sha256(rawTx));
-    std::vector<unsigned char> checksumPart(checksum.begin(), checksum.begin() + checkSumSize);
+    const auto checksum = Hash::sha256dDigest(rawTx);
 
     auto data = Data();
+    data.reserve(rawTx.size() + checkSumSize);
     append(data, rawTx);
-    append(data, checksumPart);
+    data.insert(data.end(), checksum.begin(), checksum.begin() + checkSumSize);
 
     return prefix + TW::Base64::encode(data);
-}
\ No newline at end of file
+}
@@ -7,31 +7,60 @@
 #include "Transaction.h"
 #include "Identifiers.h"
 #include <Base58.h>
-#include <Ethereum/RLP.h>
+#include <Ethereum/RLPWriter.h>
 #include <Hash.h>
 
+#include <array>
+
 using namespace TW;
 using namespace TW::Aeternity;
 
+namespace {
+
+/// Writes a value as encodeSafeZero() does
+template <typename RLP>
+void writeSafeZero(RLP& rlp, const uint256_t& value) {
+    if (value == 0) {
+        const byte zero = 0;
+        rlp.string(DataView(&zero, 1));
+    } else {
+        rlp.item(value);
+    }
+}
+
+} // namespace
+
 /// RLP returns a byte serialized representation
 Data Transaction::encode() {
-    auto encoded = Data();
-    append(encoded, Ethereum::RLP::encode(Identifiers::objectTagSpendTransaction));
-    append(encoded, Ethereum::RLP::encode(Identifiers::rlpMessageVersion));
-    append(encoded, Ethereum::RLP::encode(buildTag(sender_id)));
-    append(encoded, Ethereum::RLP::encode(buildTag(recipient_id)));
-    append(encoded, encodeSafeZero(amount));
-    append(encoded, encodeSafeZero(fee));
-    append(encoded, encodeSafeZero(ttl));
-    append(encoded, encodeSafeZero(nonce));
-    append(encoded, Ethereum::RLP::encode(payload));
-
-    const Data& raw = Ethereum::RLP::encodeList(encoded);
-    return raw;
+    const auto sender = buildTag(sender_id);
+    const auto recipient = buildTag(recipient_id);
+    return Ethereum::rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(Identifiers::objectTagSpendTransaction)
+                .item(Identifiers::rlpMessageVersion)
+                .item(sender)
+                .item(recipient);
+            writeSafeZero(list, amount);
+            writeSafeZero(list, fee);
+            writeSafeZero(list, ttl);
+            writeSafeZero(list, nonce);
+            list.item(payload);
+        });
+    });
 }
 
 TW::Data Transaction::buildTag(const std::string& address) {
-    auto payload = address.substr(Identifiers::prefixTransaction.size(), address.size());
+    const auto prefixSize = Identifiers::prefixTransaction.size();
+
+    // an account public key, decoded in place
+    std::array<byte, 33> tag;
+    tag[0] = Identifiers::iDTagAccount;
+    if (address.size() >= prefixSize &&
+        Base58::bitcoin.decodeCheck(address.data() + prefixSize, address.data() + address.size(), tag.data() + 1, tag.size() - 1)) {
+        return Data(tag.begin(), tag.end());
+    }
+
+    auto payload = address.substr(prefixSize, address.size());
 
     auto data = Data();
     append(data, Identifiers::iDTagAccount);
@@ -41,9 +70,5 @@ TW::Data Transaction::buildTag(const std::string& address) {
 }
 
 TW::Data Transaction::encodeSafeZero(uint256_t value) {
-    if (value == 0) {
-        return Ethereum::RLP::encode(Data{0});
-    } else {
-        return Ethereum::RLP::encode(value);
-    }
-}
\ No newline at end of file
+    return Ethereum::rlpEncode([&](auto& rlp) { writeSafeZero(rlp, value); });
+}
@@ -8,6 +8,7 @@
 
 #include "Address.h"
 #include "Signer.h"
+#include "../uint256.h"
 
 using namespace TW::Aion;
 using namespace std;
@@ -22,6 +23,23 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
+
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
+std::unique_ptr<TW::SigningTemplate> Entry::signingTemplate(TWCoinType coin, const TW::Data& dataIn) const {
+    auto input = Proto::SigningInput();
+    if (!input.ParseFromArray(dataIn.data(), static_cast<int>(dataIn.size()))) {
+        return nullptr;
+    }
+    return std::make_unique<InputSigningTemplate<Signer, Proto::SigningInput>>(std::move(input), [](Proto::SigningInput& input, const SigningPatch& patch) {
+        const auto nonce = store(uint256_t(patch.nonce));
+        input.set_nonce(nonce.data(), nonce.size());
+        input.set_to_address(patch.toAddress);
+        input.set_amount(patch.amount.data(), patch.amount.size());
+    });
+}
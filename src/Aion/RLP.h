@@ -9,9 +9,11 @@
 #include "Transaction.h"
 
 #include "Ethereum/RLP.h"
+#include "Ethereum/RLPReader.h"
 
 #include <boost/multiprecision/cpp_int.hpp>
 #include <cstdint>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -32,6 +34,37 @@ struct RLP {
         }
         return result;
     }
+
+    /// Writes a long as encodeLong() does to an Ethereum::RLPSizer or RLPWriter.
+    template <typename Writer>
+    static void writeLong(Writer& rlp, boost::multiprecision::uint128_t l) {
+        if ((l & 0x00000000FFFFFFFFL) == l) {
+            rlp.item(static_cast<uint32_t>(l));
+            return;
+        }
+        byte result[9];
+        result[0] = 0x80 + 8;
+        for (int i = 8; i > 0; i--) {
+            result[i] = (byte)(l & 0xFF);
+            l >>= 8;
+        }
+        rlp.encoded(DataView(result, sizeof(result)));
+    }
+
+    /// Decodes a long encoded with encodeLong, where numbers above 32 bits are padded to 8 bytes.
+    ///
+    /// @throws std::invalid_argument if the item is not a string of at most 8 bytes.
+    static boost::multiprecision::uint128_t decodeLong(const Ethereum::RLPItem& item) {
+        const auto bytes = item.payload();
+        if (item.isList() || bytes.size() > 8) {
+            throw std::invalid_argument("Invalid Aion long");
+        }
+        boost::multiprecision::uint128_t result = 0;
+        for (const auto b : bytes) {
+            result = (result << 8) | b;
+        }
+        return result;
+    }
 };
 
 } // namespace TW::Aion
@@ -7,17 +7,22 @@
 #include "Signer.h"
 
 #include "../Hash.h"
+#include "../Hashers.h"
 #include "../uint256.h"
+#include "../BatchSigning.h"
 #include <boost/multiprecision/cpp_int.hpp>
 
+#include <optional>
+
 using namespace TW;
 using namespace TW::Aion;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+namespace {
+
+Transaction transactionFrom(const Proto::SigningInput& input) {
     using boost::multiprecision::uint128_t;
 
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto transaction = Transaction(
+    return Transaction(
         /* nonce: */ static_cast<uint128_t>(load(input.nonce())),
         /* gasPrice: */ static_cast<uint128_t>(load(input.gas_price())),
         /* gasLimit: */ static_cast<uint128_t>(load(input.gas_limit())),
@@ -25,8 +30,18 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         /* amount: */ static_cast<uint128_t>(load(input.amount())),
         /* timestamp */ static_cast<uint128_t>(input.timestamp()),
         /* payload: */ Data(input.payload().begin(), input.payload().end()));
-    Signer::sign(key, transaction);
+}
+
+/// Aion signature = pubKeyBytes + signatureBytes
+Data aionSignature(const PublicKey& publicKey, const Data& signature) {
+    Data result;
+    result.reserve(publicKey.bytes.size() + signature.size());
+    append(result, publicKey.bytes);
+    append(result, signature);
+    return result;
+}
 
+Proto::SigningOutput signingOutput(const Transaction& transaction) {
     auto output = Proto::SigningOutput();
     auto encoded = transaction.encode();
     output.set_encoded(encoded.data(), encoded.size());
@@ -34,15 +49,49 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     return output;
 }
 
+} // namespace
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto transaction = transactionFrom(input);
+    Signer::sign(key, transaction);
+    return signingOutput(transaction);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto& keyBytes = inputs[begin].private_key();
+        const auto key = PrivateKey(Data(keyBytes.begin(), keyBytes.end()));
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeED25519);
+        std::vector<std::optional<Transaction>> transactions;
+        std::vector<Data> encoded;
+        for (auto i = begin; i < end; ++i) {
+            try {
+                transactions.emplace_back(transactionFrom(inputs[i]));
+                encoded.push_back(transactions.back()->encode());
+            } catch (const std::exception&) {
+                // invalid recipient
+                transactions.emplace_back();
+                encoded.emplace_back();
+                outputs[i].set_error(Common::Proto::Error_general);
+            }
+        }
+        // several messages per blake2b call
+        std::vector<Data> signatures;
+        key.signBatch(Hash::Blake2bHasher(32).finalBatch(encoded), TWCurveED25519, signatures);
+        for (auto i = begin; i < end; ++i) {
+            auto& transaction = transactions[i - begin];
+            if (transaction) {
+                transaction->signature = aionSignature(publicKey, signatures[i - begin]);
+                outputs[i] = signingOutput(*transaction);
+            }
+        }
+    });
+}
+
 void Signer::sign(const PrivateKey& privateKey, Transaction& transaction) noexcept {
     auto encoded = transaction.encode();
     auto hashData = Hash::blake2b(encoded, 32);
     auto hashSignature = privateKey.sign(hashData, TWCurveED25519);
-    auto publicKeyData = privateKey.getPublicKey(TWPublicKeyTypeED25519).bytes;
-
-    // Aion signature = pubKeyBytes + signatureBytes
-    Data result(publicKeyData.begin(), publicKeyData.end());
-    result.insert(result.end(), hashSignature.begin(), hashSignature.end());
-
-    transaction.signature = result;
+    transaction.signature = aionSignature(privateKey.getPublicKey(TWPublicKeyTypeED25519), hashSignature);
 }
@@ -26,6 +26,11 @@ class Signer {
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys). The public key is
+    /// derived once per run of inputs with the same private key, whose transactions are hashed several at a
+    /// time. An invalid recipient gives Error_general.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
     /// Signs the given transaction.
     static void sign(const PrivateKey& privateKey, Transaction& transaction) noexcept;
 };
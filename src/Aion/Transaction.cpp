@@ -6,24 +6,22 @@
 
 #include "RLP.h"
 #include "Transaction.h"
-#include "../Ethereum/RLP.h"
+#include "../Ethereum/RLPWriter.h"
 
 using namespace TW;
 using namespace TW::Aion;
 using boost::multiprecision::uint128_t;
 
 Data Transaction::encode() const noexcept {
-    auto encoded = Data();
-    append(encoded, Ethereum::RLP::encode(nonce));
-    append(encoded, Ethereum::RLP::encode(to.bytes));
-    append(encoded, Ethereum::RLP::encode(amount));
-    append(encoded, Ethereum::RLP::encode(payload));
-    append(encoded, Ethereum::RLP::encode(timestamp));
-    append(encoded, RLP::encodeLong(gasLimit));
-    append(encoded, RLP::encodeLong(gasPrice));
-    append(encoded, RLP::encodeLong(uint128_t(1))); // Aion transaction type
-    if (!signature.empty()) {
-        append(encoded, Ethereum::RLP::encode(signature));
-    }
-    return Ethereum::RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(uint256_t(nonce)).item(to.bytes).item(uint256_t(amount)).item(payload).item(uint256_t(timestamp));
+            RLP::writeLong(list, gasLimit);
+            RLP::writeLong(list, gasPrice);
+            RLP::writeLong(list, uint128_t(1)); // Aion transaction type
+            if (!signature.empty()) {
+                list.item(signature);
+            }
+        });
+    });
 }
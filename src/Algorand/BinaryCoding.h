@@ -9,33 +9,56 @@
 #include "Data.h"
 #include "../BinaryCoding.h"
 
+#include <array>
+#include <string>
+
 namespace TW::Algorand {
 
 #pragma GCC diagnostic ignored "-Wtautological-constant-out-of-range-compare"
 
-static inline void encodeString(std::string string, Data& data) {
+/// Size of the msgpack header of a string of the given length.
+constexpr size_t stringHeaderSize(size_t length) {
+    return length < 0x20 ? 1 : length < 0x100 ? 2 : length < 0x10000 ? 3 : 5;
+}
+
+/// Size of the msgpack encoding of an unsigned number.
+constexpr size_t numberSize(uint64_t number) {
+    return number < 0x80 ? 1 : number < 0x100 ? 2 : number < 0x10000 ? 3 : number < 0x100000000 ? 5 : 9;
+}
+
+/// Size of the msgpack header of a binary of the given length.
+constexpr size_t bytesHeaderSize(size_t length) {
+    return length < 0x100 ? 2 : length < 0x10000 ? 3 : 5;
+}
+
+/// Size of the msgpack header of a map or array with the given number of entries.
+constexpr size_t containerHeaderSize(size_t count) {
+    return count < 0x10 ? 1 : count < 0x10000 ? 3 : 5;
+}
+
+static inline void encodeString(const std::string& string, Data& data) {
     // encode string header
-    auto bytes = Data(string.begin(), string.end());
-    if (bytes.size() < 0x20) {
+    const auto size = string.size();
+    if (size < 0x20) {
         // fixstr
-        data.push_back(static_cast<uint8_t>(0xa0 + bytes.size()));
-    } else if (bytes.size() < 0x100) {
+        data.push_back(static_cast<uint8_t>(0xa0 + size));
+    } else if (size < 0x100) {
         // str 8
         data.push_back(static_cast<uint8_t>(0xd9));
-        data.push_back(static_cast<uint8_t>(bytes.size()));
-    } else if (bytes.size() < 0x10000) {
+        data.push_back(static_cast<uint8_t>(size));
+    } else if (size < 0x10000) {
         // str 16
         data.push_back(static_cast<uint8_t>(0xda));
-        encode16BE(static_cast<uint16_t>(bytes.size()), data);
-    } else if (bytes.size() < 0x100000000) { // depending on size_t size on platform, may be always true 
+        encode16BE(static_cast<uint16_t>(size), data);
+    } else if (size < 0x100000000) { // depending on size_t size on platform, may be always true 
         // str 32
         data.push_back(static_cast<uint8_t>(0xdb));
-        encode32BE(static_cast<uint32_t>(bytes.size()), data);
+        encode32BE(static_cast<uint32_t>(size), data);
     } else {
         // too long string
         return;
     }
-    append(data, bytes);
+    data.insert(data.end(), string.begin(), string.end());
 }
 
 static inline void encodeNumber(uint64_t number, Data& data) {
@@ -61,7 +84,7 @@ static inline void encodeNumber(uint64_t number, Data& data) {
     }
 }
 
-static inline void encodeBytes(const Data& bytes, Data& data) {
+static inline void encodeBytes(DataView bytes, Data& data) {
     auto size = bytes.size();
     if (size < 0x100) {
         // bin 8
@@ -82,4 +105,162 @@ static inline void encodeBytes(const Data& bytes, Data& data) {
     append(data, bytes);
 }
 
+/// Encodes the header of a map (`base` 0x80) or an array (`base` 0x90).
+static inline void encodeContainerHeader(byte base, size_t count, Data& data) {
+    if (count < 0x10) {
+        // fixmap / fixarray
+        data.push_back(static_cast<uint8_t>(base + count));
+    } else if (count < 0x10000) {
+        // map 16 / array 16
+        data.push_back(static_cast<uint8_t>(base == 0x80 ? 0xde : 0xdc));
+        encode16BE(static_cast<uint16_t>(count), data);
+    } else {
+        // map 32 / array 32
+        data.push_back(static_cast<uint8_t>(base == 0x80 ? 0xdf : 0xdd));
+        encode32BE(static_cast<uint32_t>(count), data);
+    }
+}
+
+/// Map key, encoded as a msgpack fixstr at compile time.
+template <size_t N>
+struct Key {
+    /// Encoded key: fixstr header followed by the name, without the terminating zero.
+    std::array<byte, N> encoded{};
+
+    constexpr explicit Key(const char (&name)[N]) {
+        static_assert(N > 1 && N - 1 < 0x20, "key must be a non-empty fixstr");
+        encoded[0] = static_cast<byte>(0xa0 + N - 1);
+        for (size_t i = 0; i + 1 < N; ++i) {
+            encoded[i + 1] = static_cast<byte>(name[i]);
+        }
+    }
+};
+
+/// Returns true if key `lhs` sorts strictly before key `rhs`, in msgpack canonical order.
+template <size_t N, size_t M>
+constexpr bool precedes(const Key<N>& lhs, const Key<M>& rhs) {
+    for (size_t i = 1; i < N && i < M; ++i) {
+        if (lhs.encoded[i] != rhs.encoded[i]) {
+            return lhs.encoded[i] < rhs.encoded[i];
+        }
+    }
+    return N < M;
+}
+
+/// Returns true if the keys are listed in canonical order, to be used in a `static_assert`
+/// next to a schema.
+template <size_t N>
+constexpr bool isCanonical(const Key<N>&) {
+    return true;
+}
+
+template <size_t N, size_t M, class... Keys>
+constexpr bool isCanonical(const Key<N>& first, const Key<M>& second, const Keys&... rest) {
+    return precedes(first, second) && isCanonical(second, rest...);
+}
+
+/// Returns true if a field value is empty, so omitted from canonical encoding.
+constexpr bool isEmptyValue(uint64_t value) {
+    return value == 0;
+}
+
+static inline bool isEmptyValue(const std::string& value) {
+    return value.empty();
+}
+
+constexpr bool isEmptyValue(DataView value) {
+    return value.empty();
+}
+
+/// Number of non-empty values, i.e. the size of the map holding them.
+template <class... Values>
+constexpr size_t countNonEmpty(const Values&... values) {
+    return (size_t(0) + ... + (isEmptyValue(values) ? 0 : 1));
+}
+
+/// Streaming msgpack writer, appending to an existing buffer.
+///
+/// `field()` skips empty values, matching the omit-empty rule of Algorand canonical encoding;
+/// the map header has to count only the non-empty fields (see `countNonEmpty`).
+class Writer {
+  public:
+    explicit Writer(Data& data) : data(data) {}
+
+    void mapHeader(size_t count) { encodeContainerHeader(0x80, count, data); }
+    void arrayHeader(size_t count) { encodeContainerHeader(0x90, count, data); }
+
+    template <size_t N>
+    void key(const Key<N>& key) {
+        data.insert(data.end(), key.encoded.begin(), key.encoded.end());
+    }
+
+    void number(uint64_t number) { encodeNumber(number, data); }
+    void string(const std::string& string) { encodeString(string, data); }
+    void bytes(DataView bytes) { encodeBytes(bytes, data); }
+
+    /// Appends an already encoded msgpack object.
+    void raw(DataView encoded) { append(data, encoded); }
+
+    template <size_t N>
+    void field(const Key<N>& key, uint64_t value) {
+        if (!isEmptyValue(value)) {
+            this->key(key);
+            number(value);
+        }
+    }
+
+    template <size_t N>
+    void field(const Key<N>& key, const std::string& value) {
+        if (!isEmptyValue(value)) {
+            this->key(key);
+            string(value);
+        }
+    }
+
+    template <size_t N>
+    void field(const Key<N>& key, DataView value) {
+        if (!isEmptyValue(value)) {
+            this->key(key);
+            bytes(value);
+        }
+    }
+
+  private:
+    Data& data;
+};
+
+/// Writer counterpart computing the size of the encoding, without writing it.
+/// Both share the same interface, so an encoding template instantiated with each
+/// yields the exact size to reserve, then the bytes.
+class SizeCounter {
+  public:
+    size_t size = 0;
+
+    void mapHeader(size_t count) { size += containerHeaderSize(count); }
+    void arrayHeader(size_t count) { size += containerHeaderSize(count); }
+
+    template <size_t N>
+    void key(const Key<N>&) {
+        size += N;
+    }
+
+    void number(uint64_t number) { size += numberSize(number); }
+    void string(const std::string& string) { size += stringHeaderSize(string.size()) + string.size(); }
+    void bytes(DataView bytes) { size += bytesHeaderSize(bytes.size()) + bytes.size(); }
+    void raw(DataView encoded) { size += encoded.size(); }
+
+    template <size_t N, class Value>
+    void field(const Key<N>& key, const Value& value) {
+        if (!isEmptyValue(value)) {
+            this->key(key);
+            write(value);
+        }
+    }
+
+  private:
+    void write(uint64_t value) { number(value); }
+    void write(const std::string& value) { string(value); }
+    void write(DataView value) { bytes(value); }
+};
+
 } // namespace TW::Algorand
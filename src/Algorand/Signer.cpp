@@ -6,14 +6,22 @@
 
 #include "Signer.h"
 #include "Address.h"
+#include "BinaryCoding.h"
 #include "../PublicKey.h"
 
 using namespace TW;
 using namespace TW::Algorand;
 
-const Data TRANSACTION_TAG = {84, 88};
 const std::string TRANSACTION_PAY = "pay";
 
+// Fields of a signed transaction, see Transaction::serialize
+static constexpr auto keySignature = Key("sig");
+static constexpr auto keyTransaction = Key("txn");
+static constexpr size_t signatureSize = 64;
+/// Size of a signed transaction, minus the size of the transaction itself
+static constexpr size_t signedOverhead = containerHeaderSize(2) + sizeof(keySignature.encoded) +
+    bytesHeaderSize(signatureSize) + signatureSize + sizeof(keyTransaction.encoded);
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
     auto protoOutput = Proto::SigningOutput();
     auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
@@ -29,8 +37,9 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
 
         auto transaction = Transaction(from, to, message.fee(), message.amount(), message.first_round(),
                                    message.last_round(), note, TRANSACTION_PAY, genesisId, genesisHash);
-        auto signature = sign(key, transaction);
-        auto serialized = transaction.serialize(signature);
+        Data scratch;
+        Data serialized;
+        appendSigned(key, transaction, scratch, serialized);
         protoOutput.set_encoded(serialized.data(), serialized.size());
     }
     
@@ -38,9 +47,40 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
 }
 
 Data Signer::sign(const PrivateKey &privateKey, Transaction &transaction) noexcept {
-    Data data;
-    append(data, TRANSACTION_TAG);
-    append(data, transaction.serialize());
+    Data data(Transaction::signingPrefix.begin(), Transaction::signingPrefix.end());
+    transaction.encode(data);
     auto signature = privateKey.sign(data, TWCurveED25519);
     return Data(signature.begin(), signature.end());
 }
+
+Data Signer::signGroup(const PrivateKey& privateKey, std::vector<Transaction>& transactions) {
+    const auto group = Transaction::groupId(transactions);
+    size_t size = 0;
+    for (auto& transaction : transactions) {
+        transaction.group = group;
+        size += signedOverhead + transaction.encodedSize();
+    }
+
+    Data message;
+    Data output;
+    output.reserve(size);
+    for (const auto& transaction : transactions) {
+        appendSigned(privateKey, transaction, message, output);
+    }
+    return output;
+}
+
+void Signer::appendSigned(const PrivateKey& privateKey, const Transaction& transaction, Data& message, Data& output) {
+    // encode once: the signed message is the prefixed transaction, reused as is in the output
+    message.assign(Transaction::signingPrefix.begin(), Transaction::signingPrefix.end());
+    transaction.encode(message);
+    const auto signature = privateKey.sign(message, TWCurveED25519);
+    const auto encoded = DataView(message).subView(Transaction::signingPrefix.size(), message.size());
+
+    Writer writer(output);
+    writer.mapHeader(2);
+    writer.key(keySignature);
+    writer.bytes(signature);
+    writer.key(keyTransaction);
+    writer.raw(encoded);
+}
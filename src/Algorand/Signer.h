@@ -11,6 +11,8 @@
 #include "../Data.h"
 #include "../PrivateKey.h"
 
+#include <vector>
+
 namespace TW::Algorand {
 
 /// Helper class that performs Algorand transaction signing.
@@ -23,6 +25,16 @@ class Signer {
 
     /// Signs the given transaction.
     static Data sign(const PrivateKey& privateKey, Transaction& transaction) noexcept;
+
+    /// Makes an atomic transfer of the given transactions: assigns their group id,
+    /// signs them all with the private key, and returns the concatenated signed transactions,
+    /// ready to be broadcast.
+    static Data signGroup(const PrivateKey& privateKey, std::vector<Transaction>& transactions);
+
+  private:
+    /// Signs the transaction and appends the signed transaction to `output`.
+    /// `message` is a scratch buffer, reused across calls.
+    static void appendSigned(const PrivateKey& privateKey, const Transaction& transaction, Data& message, Data& output);
 };
 
 } // namespace TW::Algorand
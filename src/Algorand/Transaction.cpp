@@ -6,68 +6,85 @@
 
 #include "Transaction.h"
 #include "BinaryCoding.h"
+#include "../Hash.h"
 #include "../HexCoding.h"
 
 using namespace TW;
 using namespace TW::Algorand;
 
-Data Transaction::serialize() const {
-    /* Algorand transaction is encoded with msgpack
-    {
-        amt: 847,
-        fee: 488931,
-        fv: 51,
-        gen: 'mainnet-v1.0',
-        gh: <Buffer>
-        lv: 61,
-        note: <Buffer>
-        rcv: <Buffer>
-        snd: <Buffer>
-        type: 'pay',
-    }
-    */
-    Data data;
-
-    // encode map length
-    uint8_t size = 9;
-    if (!note.empty()) {
-        // note is optional
-        size += 1;
-    }
-    data.push_back(0x80 + size);
-
-    // encode fields one by one (sorted by name)
-    encodeString("amt", data);
-    encodeNumber(amount, data);
-
-    encodeString("fee", data);
-    encodeNumber(fee, data);
-
-    encodeString("fv", data);
-    encodeNumber(firstRound, data);
-
-    encodeString("gen", data);
-    encodeString(genesisId, data);
-
-    encodeString("gh", data);
-    encodeBytes(genesisHash, data);
-
-    encodeString("lv", data);
-    encodeNumber(lastRound, data);
-
-    if (!note.empty()) {
-        encodeString("note", data);
-        encodeBytes(note, data);
-    }
+/* Algorand transaction is encoded with msgpack, fields sorted by name, empty ones omitted
+{
+    amt: 847,
+    fee: 488931,
+    fv: 51,
+    gen: 'mainnet-v1.0',
+    gh: <Buffer>
+    grp: <Buffer>
+    lv: 61,
+    note: <Buffer>
+    rcv: <Buffer>
+    snd: <Buffer>
+    type: 'pay',
+}
+*/
+static constexpr auto keyAmount = Key("amt");
+static constexpr auto keyFee = Key("fee");
+static constexpr auto keyFirstRound = Key("fv");
+static constexpr auto keyGenesisId = Key("gen");
+static constexpr auto keyGenesisHash = Key("gh");
+static constexpr auto keyGroup = Key("grp");
+static constexpr auto keyLastRound = Key("lv");
+static constexpr auto keyNote = Key("note");
+static constexpr auto keyReceiver = Key("rcv");
+static constexpr auto keySender = Key("snd");
+static constexpr auto keyType = Key("type");
+static_assert(isCanonical(keyAmount, keyFee, keyFirstRound, keyGenesisId, keyGenesisHash, keyGroup,
+                          keyLastRound, keyNote, keyReceiver, keySender, keyType),
+              "transaction fields must be sorted");
+
+static constexpr auto keySignature = Key("sig");
+static constexpr auto keyTransaction = Key("txn");
+static_assert(isCanonical(keySignature, keyTransaction), "signed transaction fields must be sorted");
+
+static constexpr auto keyTransactionList = Key("txlist");
+
+template <class Output>
+void Transaction::write(Output& output) const {
+    const auto receiver = DataView(to.bytes);
+    const auto sender = DataView(from.bytes);
+    // sender and receiver are always present
+    output.mapHeader(countNonEmpty(amount, fee, firstRound, genesisId, DataView(genesisHash), DataView(group),
+                                   lastRound, DataView(note), type) + 2);
+    output.field(keyAmount, amount);
+    output.field(keyFee, fee);
+    output.field(keyFirstRound, firstRound);
+    output.field(keyGenesisId, genesisId);
+    output.field(keyGenesisHash, DataView(genesisHash));
+    output.field(keyGroup, DataView(group));
+    output.field(keyLastRound, lastRound);
+    output.field(keyNote, DataView(note));
+    output.key(keyReceiver);
+    output.bytes(receiver);
+    output.key(keySender);
+    output.bytes(sender);
+    output.field(keyType, type);
+}
 
-    encodeString("rcv", data);
-    encodeBytes(Data(to.bytes.begin(), to.bytes.end()), data);
+size_t Transaction::encodedSize() const {
+    SizeCounter counter;
+    write(counter);
+    return counter.size;
+}
 
-    encodeString("snd", data);
-    encodeBytes(Data(from.bytes.begin(), from.bytes.end()), data);
+void Transaction::encode(Data& data) const {
+    data.reserve(data.size() + encodedSize());
+    Writer writer(data);
+    write(writer);
+}
 
-    encodeString("type", data);
-    encodeString(type, data);
+Data Transaction::serialize() const {
+    Data data;
+    encode(data);
     return data;
 }
 
@@ -79,14 +96,46 @@ Data Transaction::serialize(Data& signature) const {
     }
     */
     Data data;
-    // encode map length
-    data.push_back(0x80 + 2);
+    data.reserve(containerHeaderSize(2) + sizeof(keySignature.encoded) + bytesHeaderSize(signature.size()) +
+                 signature.size() + sizeof(keyTransaction.encoded) + encodedSize());
+    Writer writer(data);
+    writer.mapHeader(2);
     // signature
-    encodeString("sig", data);
-    encodeBytes(signature, data);
+    writer.key(keySignature);
+    writer.bytes(signature);
 
     // transaction
-    encodeString("txn", data);
-    append(data, serialize());
+    writer.key(keyTransaction);
+    write(writer);
     return data;
 }
+
+Data Transaction::id() const {
+    Data data(signingPrefix.begin(), signingPrefix.end());
+    encode(data);
+    return Hash::sha512_256(data);
+}
+
+Data Transaction::groupId(const std::vector<Transaction>& transactions) {
+    /* Group id is the hash of the prefixed msgpack encoding of the transaction ids:
+    {
+        "txlist": [<raw transaction id>, ...]
+    }
+    */
+    Data data(groupPrefix.begin(), groupPrefix.end());
+    data.reserve(data.size() + containerHeaderSize(1) + sizeof(keyTransactionList.encoded) +
+                 containerHeaderSize(transactions.size()) + transactions.size() * (bytesHeaderSize(32) + 32));
+    Writer writer(data);
+    writer.mapHeader(1);
+    writer.key(keyTransactionList);
+    writer.arrayHeader(transactions.size());
+
+    // one buffer reused for hashing every transaction
+    Data message;
+    for (const auto& transaction : transactions) {
+        message.assign(signingPrefix.begin(), signingPrefix.end());
+        transaction.encode(message);
+        writer.bytes(Hash::sha512_256(message));
+    }
+    return Hash::sha512_256(data);
+}
@@ -10,6 +10,9 @@
 #include "../Data.h"
 #include "../proto/Algorand.pb.h"
 
+#include <array>
+#include <vector>
+
 namespace TW::Algorand {
 
 class Transaction {
@@ -26,6 +29,14 @@ class Transaction {
     std::string genesisId;
     Data genesisHash;
 
+    /// Group id of an atomic transfer (see `groupId`), empty if the transaction is not part of a group.
+    Data group;
+
+    /// Prefix of the hashed and signed transaction bytes.
+    static constexpr std::array<byte, 2> signingPrefix{{'T', 'X'}};
+    /// Prefix of the hashed transaction group.
+    static constexpr std::array<byte, 2> groupPrefix{{'T', 'G'}};
+
     Transaction(Address &from, Address &to, uint64_t fee, uint64_t amount, uint64_t firstRound,
                 uint64_t lastRound, Data& note, std::string type, std::string& genesisIdg, Data& genesisHash)
         : from(from) , to(to)
@@ -37,6 +48,24 @@ class Transaction {
   public:
     Data serialize() const;
     Data serialize(Data& signature) const;
+
+    /// Appends the canonical msgpack encoding of the transaction to `data`.
+    void encode(Data& data) const;
+
+    /// Size of the canonical msgpack encoding, computed without encoding.
+    size_t encodedSize() const;
+
+    /// Returns the raw transaction id, the SHA512/256 hash of the prefixed encoding.
+    Data id() const;
+
+    /// Computes the group id of an atomic transfer made of the given transactions,
+    /// whose `group` must not be assigned yet.
+    static Data groupId(const std::vector<Transaction>& transactions);
+
+  private:
+    /// Sole definition of the encoding, instantiated with a Writer and a SizeCounter.
+    template <class Output>
+    void write(Output& output) const;
 };
 
 } // namespace TW::Algorand
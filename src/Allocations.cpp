@@ -0,0 +1,138 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Allocations.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+using namespace TW;
+
+namespace {
+
+/// Counters of a thread; trivial, so that operator new can use them at any time.
+struct Counters {
+    uint64_t count;
+    uint64_t bytes;
+    int64_t live;
+    int64_t peak;
+};
+
+thread_local Counters counters{};
+
+} // namespace
+
+#ifdef TW_ALLOCATION_TRACKING
+
+namespace {
+
+/// Each block starts with its size, in a header keeping the alignment of malloc.
+constexpr std::size_t headerSize = alignof(std::max_align_t);
+
+void* allocate(std::size_t size) noexcept {
+    auto* block = static_cast<unsigned char*>(std::malloc(size + headerSize));
+    if (block == nullptr) {
+        return nullptr;
+    }
+    *reinterpret_cast<std::size_t*>(block) = size;
+    auto& current = counters;
+    ++current.count;
+    current.bytes += size;
+    current.live += static_cast<int64_t>(size);
+    current.peak = std::max(current.peak, current.live);
+    return block + headerSize;
+}
+
+void deallocate(void* pointer) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    auto* block = static_cast<unsigned char*>(pointer) - headerSize;
+    counters.live -= static_cast<int64_t>(*reinterpret_cast<std::size_t*>(block));
+    std::free(block);
+}
+
+void* allocateOrThrow(std::size_t size) {
+    for (;;) {
+        if (auto* pointer = allocate(size)) {
+            return pointer;
+        }
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+// The aligned forms are left to the standard library, they allocate and free their blocks together.
+void* operator new(std::size_t size) {
+    return allocateOrThrow(size);
+}
+void* operator new[](std::size_t size) {
+    return allocateOrThrow(size);
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+void operator delete(void* pointer) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, std::size_t) noexcept {
+    deallocate(pointer);
+}
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+    deallocate(pointer);
+}
+
+bool Allocations::enabled() {
+    return true;
+}
+
+#else
+
+bool Allocations::enabled() {
+    return false;
+}
+
+#endif
+
+Allocations::Scope::Scope()
+    : startCount(counters.count), startBytes(counters.bytes), startLive(counters.live), previousPeak(counters.peak) {
+    counters.peak = counters.live;
+}
+
+Allocations::Scope::~Scope() {
+    counters.peak = std::max(previousPeak, counters.peak);
+}
+
+uint64_t Allocations::Scope::count() const {
+    return counters.count - startCount;
+}
+
+uint64_t Allocations::Scope::bytes() const {
+    return counters.bytes - startBytes;
+}
+
+uint64_t Allocations::Scope::peak() const {
+    return static_cast<uint64_t>(std::max<int64_t>(counters.peak - startLive, 0));
+}
@@ -0,0 +1,38 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <cstdint>
+
+namespace TW::Allocations {
+
+/// True if the library is built with TW_ALLOCATION_TRACKING (CMake option of the same name), which replaces the
+/// global operator new and delete to count the allocations of each thread.  Without it, all counts are 0.
+bool enabled();
+
+/// Allocations of the calling thread in its scope: their number, their bytes, and the peak of the memory allocated
+/// in the scope and not freed yet.  Memory freed by another thread is subtracted on that thread.  Scopes nest.
+class Scope {
+  public:
+    Scope();
+    ~Scope();
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    uint64_t count() const;
+    uint64_t bytes() const;
+    uint64_t peak() const;
+
+  private:
+    uint64_t startCount;
+    uint64_t startBytes;
+    int64_t startLive;
+    int64_t previousPeak;
+};
+
+} // namespace TW::Allocations
@@ -0,0 +1,64 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Async.h"
+
+#include <algorithm>
+
+using namespace TW;
+
+WorkerPool::WorkerPool(std::size_t threadCount)
+    : threadCount(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (threads.empty()) {
+            threads.reserve(threadCount);
+            for (std::size_t i = 0; i < threadCount; ++i) {
+                threads.emplace_back(&WorkerPool::run, this);
+            }
+        }
+        jobs.push_back(std::move(job));
+    }
+    available.notify_one();
+}
+
+void WorkerPool::run() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) {
+                return;
+            }
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        try {
+            job();
+        } catch (...) {
+        }
+    }
+}
+
+WorkerPool& WorkerPool::shared() {
+    // never destroyed, jobs may still be running during static destruction
+    static auto* pool = new WorkerPool();
+    return *pool;
+}
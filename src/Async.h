@@ -0,0 +1,83 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+/// Thrown by long computations (scrypt) when the flag of the enclosing ScopedCancellation gets set.
+class Cancelled : public std::runtime_error {
+  public:
+    Cancelled() : std::runtime_error("Cancelled") {}
+};
+
+/// Makes long computations on the current thread poll `cancelled`, and throw Cancelled once it is set, while in scope.
+/// Without one, computations are not cancellable.
+class ScopedCancellation {
+  public:
+    explicit ScopedCancellation(const std::atomic<bool>& cancelled) : previous(currentFlag) { currentFlag = &cancelled; }
+    ~ScopedCancellation() { currentFlag = previous; }
+    ScopedCancellation(const ScopedCancellation&) = delete;
+    ScopedCancellation& operator=(const ScopedCancellation&) = delete;
+
+    /// Flag of the innermost scope on the current thread, or null.
+    static const std::atomic<bool>* current() { return currentFlag; }
+
+    /// Throws Cancelled if the flag of the innermost scope is set.
+    static void check() {
+        if (currentFlag != nullptr && currentFlag->load(std::memory_order_relaxed)) {
+            throw Cancelled();
+        }
+    }
+
+  private:
+    static inline thread_local const std::atomic<bool>* currentFlag = nullptr;
+    const std::atomic<bool>* previous;
+};
+
+/// Fixed set of worker threads, running submitted jobs in submission order.
+/// Threads are started with the first job.
+class WorkerPool {
+  public:
+    /// Pool of `threadCount` threads, 0 for one per hardware thread.
+    explicit WorkerPool(std::size_t threadCount = 0);
+
+    /// Runs the jobs still queued, and joins the threads.
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    /// Queues a job; exceptions thrown by jobs are discarded.
+    void submit(std::function<void()> job);
+
+    std::size_t size() const { return threadCount; }
+
+    /// Pool used by the asynchronous C interface, living until the process exits.
+    static WorkerPool& shared();
+
+  private:
+    std::size_t threadCount;
+    std::mutex mutex;
+    std::condition_variable available;
+    std::deque<std::function<void()>> jobs;
+    std::vector<std::thread> threads;
+    bool stopping = false;
+
+    void run();
+};
+
+} // namespace TW
@@ -0,0 +1,125 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base32.h"
+
+#include <array>
+
+namespace TW::Base32 {
+
+namespace {
+
+constexpr char rfcCharacters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+using Values = std::array<int8_t, 256>;
+
+/// Values of the RFC 4648 characters, in either case, -1 for others.
+constexpr Values makeRfcValues() {
+    Values values = {};
+    for (auto& value : values) {
+        value = -1;
+    }
+    for (int i = 0; i < 32; ++i) {
+        const auto c = rfcCharacters[i];
+        values[static_cast<unsigned char>(c)] = static_cast<int8_t>(i);
+        if (c >= 'A' && c <= 'Z') {
+            values[static_cast<unsigned char>(c - 'A' + 'a')] = static_cast<int8_t>(i);
+        }
+    }
+    return values;
+}
+
+constexpr Values rfcValues = makeRfcValues();
+
+bool isRfc(const char* alphabet) {
+    return alphabet == nullptr || alphabet == BASE32_ALPHABET_RFC4648;
+}
+
+/// Values of the first 32 characters of a custom alphabet, which is case sensitive.
+Values makeValues(const char* alphabet) {
+    Values values;
+    values.fill(-1);
+    for (int i = 31; i >= 0; --i) {
+        // the first occurrence wins
+        values[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+    }
+    values[0] = -1;
+    return values;
+}
+
+/// Writes the `count` first characters of the 40 bits of `group`.
+inline void encodeGroup(uint64_t group, std::size_t count, char* out, const char* alphabet) {
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = alphabet[(group >> (35 - 5 * i)) & 0x1f];
+    }
+}
+
+/// Reads `count` characters, up to 8, into the high bits of 40; returns false if one isn't in the alphabet.
+inline bool decodeGroup(const char* string, std::size_t count, const Values& values, uint64_t& group) {
+    group = 0;
+    int8_t invalid = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto value = values[static_cast<unsigned char>(string[i])];
+        invalid |= value;
+        group |= static_cast<uint64_t>(value & 0x1f) << (35 - 5 * i);
+    }
+    return invalid >= 0;
+}
+
+} // namespace
+
+void encode(const byte* data, std::size_t size, char* out, const char* alphabet) {
+    if (isRfc(alphabet)) {
+        alphabet = rfcCharacters;
+    }
+    std::size_t i = 0;
+    for (; i + 5 <= size; i += 5, out += 8) {
+        uint64_t group = 0;
+        for (std::size_t j = 0; j < 5; ++j) {
+            group = (group << 8) | data[i + j];
+        }
+        encodeGroup(group, 8, out, alphabet);
+    }
+    if (i < size) {
+        uint64_t group = 0;
+        for (std::size_t j = 0; j < 5; ++j) {
+            group = (group << 8) | (i + j < size ? data[i + j] : 0);
+        }
+        encodeGroup(group, encodedSize(size - i), out, alphabet);
+    }
+}
+
+bool decode(const char* string, std::size_t size, byte* out, const char* alphabet) {
+    const auto remainder = size % 8;
+    if (remainder == 1 || remainder == 3 || remainder == 6) {
+        return false;
+    }
+    const auto custom = isRfc(alphabet) ? Values() : makeValues(alphabet);
+    const auto& values = isRfc(alphabet) ? rfcValues : custom;
+
+    uint64_t group = 0;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8, out += 5) {
+        if (!decodeGroup(string + i, 8, values, group)) {
+            return false;
+        }
+        for (std::size_t j = 0; j < 5; ++j) {
+            out[j] = static_cast<byte>(group >> (32 - 8 * j));
+        }
+    }
+    if (i < size) {
+        // the bits left over are ignored
+        if (!decodeGroup(string + i, remainder, values, group)) {
+            return false;
+        }
+        for (std::size_t j = 0; j < decodedSize(remainder); ++j) {
+            out[j] = static_cast<byte>(group >> (32 - 8 * j));
+        }
+    }
+    return true;
+}
+
+} // namespace TW::Base32
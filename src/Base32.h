@@ -10,48 +10,46 @@
 
 #include <TrezorCrypto/base32.h>
 
-#include <cassert>
+#include <cstddef>
+#include <string>
 
 namespace TW::Base32 {
 
+/// Number of characters encoding `size` bytes, without padding.
+inline std::size_t encodedSize(std::size_t size) {
+    return size / 5 * 8 + (size % 5 * 8 + 4) / 5;
+}
+
+/// Number of bytes decoded from `size` characters.
+inline std::size_t decodedSize(std::size_t size) {
+    return size / 8 * 5 + size % 8 * 5 / 8;
+}
+
+/// Writes the encoding of `size` bytes to `out`, encodedSize(size) characters without a terminator.
+/// alphabet: Optional alphabet of 32 characters, if missing, default ALPHABET_RFC4648
+void encode(const byte* data, std::size_t size, char* out, const char* alphabet = nullptr);
+
+/// Decodes `size` characters into `out`, of decodedSize(size) bytes; returns false if the input isn't valid.
+/// alphabet: Optional alphabet of 32 characters, if missing, default ALPHABET_RFC4648, which is case insensitive
+bool decode(const char* string, std::size_t size, byte* out, const char* alphabet = nullptr);
+
 /// Decode Base32 string, return bytes as Data
 /// alphabet: Optional alphabet, if missing, default ALPHABET_RFC4648
 inline bool decode(const std::string& encoded_in, Data& decoded_out, const char* alphabet_in = nullptr) {
-    size_t inLen = encoded_in.size();
-    // obtain output length first
-    size_t outLen = base32_decoded_length(inLen);
-    uint8_t buf[outLen];
-    if (alphabet_in == nullptr) {
-        alphabet_in = BASE32_ALPHABET_RFC4648;
-    }
-    // perform the base32 decode
-    uint8_t* retval = base32_decode(encoded_in.data(), inLen, buf, outLen, alphabet_in);
-    if (retval == nullptr) {
+    Data decoded(decodedSize(encoded_in.size()));
+    if (!decode(encoded_in.data(), encoded_in.size(), decoded.data(), alphabet_in)) {
         return false;
     }
-    decoded_out.assign(buf, buf + outLen);
+    decoded_out = std::move(decoded);
     return true;
 }
 
 /// Encode bytes in Data to Base32 string
 /// alphabet: Optional alphabet, if missing, default ALPHABET_RFC4648
 inline std::string encode(const Data& val, const char* alphabet = nullptr) {
-    size_t inLen = val.size();
-    // obtain output length first, reserve for terminator
-    size_t outLen = base32_encoded_length(inLen) + 1;
-    char buf[outLen];
-    if (alphabet == nullptr) {
-        alphabet = BASE32_ALPHABET_RFC4648;
-    }
-    // perform the base32 encode
-    char* retval = base32_encode(val.data(), inLen, buf, outLen, alphabet);
-    if (retval == nullptr) {
-        // return empty string if failed
-        return std::string();
-    }
-    // make sure there is a terminator ath the end
-    buf[outLen - 1] = '\0';
-    return std::string(buf);
+    std::string encoded(encodedSize(val.size()), '\0');
+    encode(val.data(), val.size(), encoded.data(), alphabet);
+    return encoded;
 }
 
 } // namespace TW::Base32
@@ -8,23 +8,25 @@
 #include "Base58.h"
 
 #include "Hash.h"
+#include "Instrumentation.h"
 
 #include <algorithm>
 #include <cctype>
-#include <cassert>
+#include <cstdint>
+#include <vector>
 
 using namespace TW;
 
 // clang-format off
 
-static const std::array<char, 58> bitcoinDigits = {
+static constexpr std::array<char, 58> bitcoinDigits = {
     '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F',
     'G', 'H', 'J', 'K', 'L', 'M', 'N', 'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W',
     'X', 'Y', 'Z', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'm',
     'n', 'o', 'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z'
 };
 
-static const std::array<signed char, 128> bitcoinCharacterMap = {
+static constexpr std::array<signed char, 128> bitcoinCharacterMap = {
 	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
 	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
 	-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
@@ -35,14 +37,14 @@ static const std::array<signed char, 128> bitcoinCharacterMap = {
 	47,48,49,50,51,52,53,54,55,56,57,-1,-1,-1,-1,-1,
 };
 
-static const std::array<char, 58> rippleDigits = {
+static constexpr std::array<char, 58> rippleDigits = {
     'r', 'p', 's', 'h', 'n', 'a', 'f', '3', '9', 'w', 'B', 'U', 'D', 'N', 'E',
     'G', 'H', 'J', 'K', 'L', 'M', '4', 'P', 'Q', 'R', 'S', 'T', '7', 'V', 'W',
     'X', 'Y', 'Z', '2', 'b', 'c', 'd', 'e', 'C', 'g', '6', '5', 'j', 'k', 'm',
     '8', 'o', 'F', 'q', 'i', '1', 't', 'u', 'v', 'A', 'x', 'y', 'z'
 };
 
-static const std::array<signed char, 128> rippleCharacterMap = {
+static constexpr std::array<signed char, 128> rippleCharacterMap = {
     -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
     -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
     -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,
@@ -59,6 +61,212 @@ Base58 Base58::bitcoin = Base58(bitcoinDigits, bitcoinCharacterMap);
 
 Base58 Base58::ripple = Base58(rippleDigits, rippleCharacterMap);
 
+namespace {
+
+/// Number of base58 digits in a 32-bit chunk, and the matching powers of 58.
+constexpr size_t chunkDigits = 5;
+constexpr uint32_t powers58[chunkDigits + 1] = {1, 58, 3364, 195112, 11316496, 656356768};
+
+/// Maximum number of base58 digits needed to encode `size` bytes, log(256) / log(58), rounded up.
+constexpr size_t maxEncodedSize(size_t size) {
+    return size * 138 / 100 + 1;
+}
+
+/// Maximum number of bytes decoded from `length` base58 digits, log(58) / log(256), rounded up.
+constexpr size_t maxDecodedSize(size_t length) {
+    return length * 733 / 1000 + 1;
+}
+
+/// Number of 32-bit limbs needed for `size` bytes.
+constexpr size_t limbCount(size_t size) {
+    return (size + 3) / 4;
+}
+
+/// Inputs up to this size use stack buffers.
+constexpr size_t maxStackSize = 128;
+
+bool isSpace(char c) {
+    return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+/// Strips leading and trailing whitespace.
+void trim(const char*& begin, const char*& end) {
+    while (begin != end && isSpace(*begin)) {
+        ++begin;
+    }
+    while (end != begin && isSpace(*(end - 1))) {
+        --end;
+    }
+}
+
+/// Converts a big-endian number of `size` bytes into little-endian base58 values in `values`,
+/// without the leading zeroes, returns the number of values.
+///
+/// `limbs` needs room for `limbCount(size)` entries, and `values` for `maxEncodedSize(size) + chunkDigits`.
+/// The number is divided by 58^5 on 32-bit limbs, yielding 5 digits with each pass.
+inline size_t toBase58(const byte* data, size_t size, uint32_t* limbs, byte* values) {
+    const auto count = limbCount(size);
+    const auto padding = count * 4 - size;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t limb = 0;
+        for (size_t j = i * 4; j < i * 4 + 4; ++j) {
+            limb = (limb << 8) | (j < padding ? 0 : data[j - padding]);
+        }
+        limbs[i] = limb;
+    }
+
+    size_t first = 0;
+    size_t length = 0;
+    while (first < count && limbs[first] == 0) {
+        ++first;
+    }
+    while (first < count) {
+        uint64_t remainder = 0;
+        for (size_t i = first; i < count; ++i) {
+            const auto current = (remainder << 32) | limbs[i];
+            limbs[i] = static_cast<uint32_t>(current / powers58[chunkDigits]);
+            remainder = current % powers58[chunkDigits];
+        }
+        while (first < count && limbs[first] == 0) {
+            ++first;
+        }
+        auto chunk = static_cast<uint32_t>(remainder);
+        for (size_t j = 0; j < chunkDigits; ++j) {
+            values[length++] = static_cast<byte>(chunk % 58);
+            chunk /= 58;
+        }
+    }
+
+    while (length > 0 && values[length - 1] == 0) {
+        --length;
+    }
+    return length;
+}
+
+/// Accumulates base58 digits into `count` big-endian 32-bit limbs, 5 digits at a time.
+/// Returns `false` on an invalid character or if the number doesn't fit.
+inline bool fromBase58(const char* begin, const char* end, const std::array<signed char, 128>& characterMap,
+                       uint32_t* limbs, size_t count) {
+    std::fill(limbs, limbs + count, 0);
+    auto first = count; // limbs before `first` are zero
+    auto it = begin;
+    auto digits = static_cast<size_t>(end - begin) % chunkDigits;
+    if (digits == 0) {
+        digits = chunkDigits;
+    }
+    while (it != end) {
+        uint32_t chunk = 0;
+        for (size_t j = 0; j < digits; ++j, ++it) {
+            const auto c = static_cast<unsigned char>(*it);
+            if (c >= 128 || characterMap[c] == -1) {
+                return false;
+            }
+            chunk = chunk * 58 + static_cast<uint32_t>(characterMap[c]);
+        }
+
+        uint64_t carry = chunk;
+        const uint64_t multiplier = powers58[digits];
+        for (auto i = count; i-- > first;) {
+            const auto current = limbs[i] * multiplier + carry;
+            limbs[i] = static_cast<uint32_t>(current);
+            carry = current >> 32;
+        }
+        if (carry != 0) {
+            if (first == 0) {
+                return false;
+            }
+            limbs[--first] = static_cast<uint32_t>(carry);
+        }
+        digits = chunkDigits;
+    }
+    return true;
+}
+
+/// Big-endian byte `index` of the limbs.
+inline byte limbByte(const uint32_t* limbs, size_t index) {
+    return static_cast<byte>(limbs[index / 4] >> (8 * (3 - index % 4)));
+}
+
+/// Decodes into exactly `size` bytes, `limbs` needs room for `limbCount(size)` entries.
+inline bool decodeSized(const char* begin, const char* end, const std::array<char, 58>& digits,
+                        const std::array<signed char, 128>& characterMap, uint32_t* limbs, byte* result,
+                        size_t size) {
+    size_t zeroes = 0;
+    while (begin != end && *begin == digits[0]) {
+        if (zeroes == size) {
+            return false;
+        }
+        result[zeroes++] = 0;
+        ++begin;
+    }
+    const auto remaining = size - zeroes;
+    if (begin == end) {
+        return remaining == 0;
+    }
+    if (remaining == 0 || static_cast<size_t>(end - begin) > maxEncodedSize(remaining)) {
+        return false;
+    }
+
+    const auto count = limbCount(remaining);
+    if (!fromBase58(begin, end, characterMap, limbs, count)) {
+        return false;
+    }
+    // The number needs exactly `remaining` bytes: padding is zero and the first byte isn't.
+    const auto padding = count * 4 - remaining;
+    for (size_t i = 0; i < padding; ++i) {
+        if (limbByte(limbs, i) != 0) {
+            return false;
+        }
+    }
+    if (limbByte(limbs, padding) == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < remaining; ++i) {
+        result[zeroes + i] = limbByte(limbs, padding + i);
+    }
+    return true;
+}
+
+/// Fixed-size decoding, used for the common address sizes.
+template <size_t N>
+bool decodeFixed(const char* begin, const char* end, const std::array<char, 58>& digits,
+                 const std::array<signed char, 128>& characterMap, byte* result) {
+    std::array<uint32_t, limbCount(N)> limbs;
+    return decodeSized(begin, end, digits, characterMap, limbs.data(), result, N);
+}
+
+/// Fixed-size encoding, used for the common address sizes.
+template <size_t N>
+std::string encodeFixed(const byte* data, const std::array<char, 58>& digits) {
+    std::array<uint32_t, limbCount(N)> limbs;
+    std::array<byte, maxEncodedSize(N) + chunkDigits> values;
+
+    size_t zeroes = 0;
+    while (zeroes < N && data[zeroes] == 0) {
+        ++zeroes;
+    }
+    const auto length = toBase58(data + zeroes, N - zeroes, limbs.data(), values.data());
+    std::string str(zeroes + length, digits[0]);
+    for (size_t i = 0; i < length; ++i) {
+        str[zeroes + i] = digits[values[length - 1 - i]];
+    }
+    return str;
+}
+
+/// Computes the 4-byte checksum, avoiding allocations for the default hasher.
+void checksum(const Hash::Hasher& hasher, const byte* data, size_t size, byte* result) {
+    const auto target = hasher.target<Hash::HasherSimpleType>();
+    if (target != nullptr && *target == static_cast<Hash::HasherSimpleType>(Hash::sha256d)) {
+        const auto hash = Hash::sha256dDigest(DataView(data, size));
+        std::copy(hash.begin(), hash.begin() + 4, result);
+        return;
+    }
+    const auto hash = hasher(data, size);
+    std::copy(hash.begin(), hash.begin() + 4, result);
+}
+
+} // namespace
+
 Data Base58::decodeCheck(const char* begin, const char* end, Hash::Hasher hasher) const {
     auto result = decode(begin, end);
     if (result.size() < 4) {
@@ -66,130 +274,152 @@ Data Base58::decodeCheck(const char* begin, const char* end, Hash::Hasher hasher
     }
 
     // re-calculate the checksum, ensure it matches the included 4-byte checksum
-    auto hash = hasher(result.data(), result.size() - 4);
-    if (!std::equal(hash.begin(), hash.begin() + 4, result.end() - 4)) {
+    byte check[4];
+    checksum(hasher, result.data(), result.size() - 4, check);
+    if (!std::equal(check, check + 4, result.end() - 4)) {
         return {};
     }
 
-    return Data(result.begin(), result.end() - 4);
+    result.resize(result.size() - 4);
+    return result;
 }
 
-Data Base58::decode(const char* begin, const char* end) const {
-    auto it = begin;
+bool Base58::decodeCheck(const char* begin, const char* end, byte* result, size_t size, Hash::Hasher hasher) const {
+    const auto checkedSize = size + 4;
+    std::array<byte, maxStackSize> stack;
+    Data heap;
+    auto buffer = stack.data();
+    if (checkedSize > stack.size()) {
+        heap.resize(checkedSize);
+        buffer = heap.data();
+    }
+    if (!decode(begin, end, buffer, checkedSize)) {
+        return false;
+    }
+
+    byte check[4];
+    checksum(hasher, buffer, size, check);
+    if (!std::equal(check, check + 4, buffer + size)) {
+        return false;
+    }
+    std::copy(buffer, buffer + size, result);
+    return true;
+}
 
-    // Skip leading spaces.
-    it = std::find_if_not(it, end, std::isspace);
+Data Base58::decode(const char* begin, const char* end) const {
+    TW_INSTRUMENT_SCOPE("Base58::decode");
+    trim(begin, end);
 
     // Skip and count leading zeros.
     std::size_t zeroes = 0;
-    std::size_t length = 0;
-    while (it != end && *it == digits[0]) {
+    while (begin != end && *begin == digits[0]) {
         zeroes += 1;
-        it += 1;
+        begin += 1;
     }
 
-    // Allocate enough space in big-endian base256 representation.
-    std::size_t base258Size = (end - it) * 733 / 1000 + 1; // log(58) / log(256), rounded up.
-    Data b256(base258Size);
-
-    // Process the characters.
-    while (it != end && !std::isspace(*it)) {
-        if (static_cast<unsigned char>(*it) >= 128) {
-            // Invalid b58 character
-            return {};
-        }
-
-        // Decode base58 character
-        int carry = characterMap[static_cast<unsigned char>(*it)];
-        if (carry == -1) {
-            // Invalid b58 character
-            return {};
-        }
-
-        std::size_t i = 0;
-        for (auto b256it = b256.rbegin(); (carry != 0 || i < length) && (b256it != b256.rend());
-             ++b256it, ++i) {
-            carry += 58 * (*b256it);
-            *b256it = static_cast<uint8_t>(carry % 256);
-            carry /= 256;
-        }
-        assert(carry == 0);
-        length = i;
-        it += 1;
+    const auto count = limbCount(maxDecodedSize(end - begin));
+    std::array<uint32_t, limbCount(maxStackSize)> stack;
+    std::vector<uint32_t> heap;
+    auto limbs = stack.data();
+    if (count > stack.size()) {
+        heap.resize(count);
+        limbs = heap.data();
     }
-
-    // Skip trailing spaces.
-    it = std::find_if_not(it, end, std::isspace);
-    if (it != end) {
-        // Extra charaters at the end
+    if (!fromBase58(begin, end, characterMap, limbs, count)) {
         return {};
     }
 
-    // Skip leading zeroes in b256.
-    auto b256it = b256.begin() + (base258Size - length);
-    while (b256it != b256.end() && *b256it == 0) {
-        b256it++;
+    // Skip leading zeroes in the number.
+    std::size_t first = 0;
+    while (first < count * 4 && limbByte(limbs, first) == 0) {
+        first += 1;
     }
 
-    // Copy result into output vector.
-    Data result;
-    result.reserve(zeroes + (b256.end() - b256it));
-    result.assign(zeroes, 0x00);
-    std::copy(b256it, b256.end(), std::back_inserter(result));
-
+    Data result(zeroes + count * 4 - first);
+    for (std::size_t i = first; i < count * 4; ++i) {
+        result[zeroes + i - first] = limbByte(limbs, i);
+    }
     return result;
 }
 
+bool Base58::decode(const char* begin, const char* end, byte* result, size_t size) const {
+    trim(begin, end);
+    switch (size) {
+    case 21:
+        return decodeFixed<21>(begin, end, digits, characterMap, result);
+    case 24:
+        return decodeFixed<24>(begin, end, digits, characterMap, result);
+    case 25:
+        return decodeFixed<25>(begin, end, digits, characterMap, result);
+    case 32:
+        return decodeFixed<32>(begin, end, digits, characterMap, result);
+    case 34:
+        return decodeFixed<34>(begin, end, digits, characterMap, result);
+    case 35:
+        return decodeFixed<35>(begin, end, digits, characterMap, result);
+    case 36:
+        return decodeFixed<36>(begin, end, digits, characterMap, result);
+    case 38:
+        return decodeFixed<38>(begin, end, digits, characterMap, result);
+    default:
+        break;
+    }
+    std::vector<uint32_t> limbs(limbCount(size));
+    return decodeSized(begin, end, digits, characterMap, limbs.data(), result, size);
+}
+
 std::string Base58::encodeCheck(const byte* begin, const byte* end, Hash::Hasher hasher) const {
     // add 4-byte hash check to the end
-    Data dataWithCheck(begin, end);
-    auto hash = hasher(begin, end - begin);
-    dataWithCheck.insert(dataWithCheck.end(), hash.begin(), hash.begin() + 4);
-    return encode(dataWithCheck);
+    const auto size = static_cast<size_t>(end - begin);
+    std::array<byte, maxStackSize> stack;
+    Data heap;
+    auto buffer = stack.data();
+    if (size + 4 > stack.size()) {
+        heap.resize(size + 4);
+        buffer = heap.data();
+    }
+    std::copy(begin, end, buffer);
+    checksum(hasher, begin, size, buffer + size);
+    return encode(buffer, buffer + size + 4);
 }
 
 std::string Base58::encode(const byte* begin, const byte* end) const {
+    TW_INSTRUMENT_SCOPE("Base58::encode");
+    switch (end - begin) {
+    case 21:
+        return encodeFixed<21>(begin, digits);
+    case 25:
+        return encodeFixed<25>(begin, digits);
+    case 32:
+        return encodeFixed<32>(begin, digits);
+    case 34:
+        return encodeFixed<34>(begin, digits);
+    case 35:
+        return encodeFixed<35>(begin, digits);
+    case 36:
+        return encodeFixed<36>(begin, digits);
+    case 38:
+        return encodeFixed<38>(begin, digits);
+    default:
+        break;
+    }
+
     // Skip & count leading zeroes.
-    int zeroes = 0;
-    int length = 0;
+    std::size_t zeroes = 0;
     while (begin != end && *begin == 0) {
         begin += 1;
         zeroes += 1;
     }
 
-    // Allocate enough space in big-endian base58 representation.
-    auto base58Size = (end - begin) * 138 / 100 + 1; // log(256) / log(58), rounded up.
-    Data b58(base58Size);
-
-    while (begin != end) {
-        int carry = *begin;
-        int i = 0;
-        // Apply "b58 = b58 * 256 + ch".
-        for (auto b58it = b58.rbegin(); (carry != 0 || i < length) && (b58it != b58.rend());
-             b58it++, i++) {
-            carry += 256 * (*b58it);
-            *b58it = carry % 58;
-            carry /= 58;
-        }
-
-        assert(carry == 0);
-        length = i;
-        begin += 1;
-    }
-
-    // Skip leading zeroes in base58 result.
-    auto it = b58.begin() + (base58Size - length);
-    while (it != b58.end() && *it == 0) {
-        it++;
-    }
+    const auto size = static_cast<std::size_t>(end - begin);
+    std::vector<uint32_t> limbs(limbCount(size));
+    Data values(maxEncodedSize(size) + chunkDigits);
+    const auto length = toBase58(begin, size, limbs.data(), values.data());
 
     // Translate the result into a string.
-    std::string str;
-    str.reserve(zeroes + (b58.end() - it));
-    str.assign(zeroes, digits[0]);
-    while (it != b58.end()) {
-        str += digits[*it];
-        it += 1;
+    std::string str(zeroes + length, digits[0]);
+    for (std::size_t i = 0; i < length; ++i) {
+        str[zeroes + i] = digits[values[length - 1 - i]];
     }
     return str;
 }
@@ -14,6 +14,10 @@
 
 namespace TW {
 
+/// Base58 coder.
+///
+/// Conversions work on 32-bit limbs, 5 base58 digits at a time, with fixed-size
+/// buffers for the common address sizes.
 class Base58 {
   public:
     /// Base58 coder with Bitcoin character map.
@@ -30,7 +34,8 @@ class Base58 {
     const std::array<signed char, 128> characterMap;
 
     /// Initializes a Base58 class with custom digit mapping.
-    Base58(const std::array<char, 58>& digits, const std::array<signed char, 128>& characterMap)
+    /// Constant expression, so that the static coders need no initialization when the library is loaded.
+    constexpr Base58(const std::array<char, 58>& digits, const std::array<signed char, 128>& characterMap)
         : digits(digits), characterMap(characterMap) {}
 
     /// Decodes a base 58 string verifying the checksum, returns empty on failure.
@@ -41,14 +46,34 @@ class Base58 {
     /// Decodes a base 58 string verifying the checksum, returns empty on failure.
     Data decodeCheck(const char* begin, const char* end, Hash::Hasher hasher = Hash::sha256d) const;
 
-    /// Decodes a base 58 string into `result`, returns `false` on failure.
+    /// Decodes a base 58 string of exactly `size` bytes into `result`, verifying the checksum (not included in `size`).
+    /// Returns `false` on failure, or if the decoded size doesn't match.
+    bool decodeCheck(const char* begin, const char* end, byte* result, size_t size, Hash::Hasher hasher = Hash::sha256d) const;
+
+    /// Decodes a base 58 string of exactly `N` bytes into `result`, verifying the checksum.
+    template <size_t N>
+    bool decodeCheck(const std::string& string, std::array<byte, N>& result, Hash::Hasher hasher = Hash::sha256d) const {
+        return decodeCheck(string.data(), string.data() + string.size(), result.data(), N, hasher);
+    }
+
+    /// Decodes a base 58 string, returns empty on failure.
     Data decode(const std::string& string) const {
         return decode(string.data(), string.data() + string.size());
     }
 
-    /// Decodes a base 58 string into `result`, returns `false` on failure.
+    /// Decodes a base 58 string, returns empty on failure.
     Data decode(const char* begin, const char* end) const;
 
+    /// Decodes a base 58 string of exactly `size` bytes into `result`, without allocations.
+    /// Returns `false` on failure, or if the decoded size doesn't match.
+    bool decode(const char* begin, const char* end, byte* result, size_t size) const;
+
+    /// Decodes a base 58 string of exactly `N` bytes into `result`.
+    template <size_t N>
+    bool decode(const std::string& string, std::array<byte, N>& result) const {
+        return decode(string.data(), string.data() + string.size(), result.data(), N);
+    }
+
     /// Encodes data as a base 58 string with a checksum.
     template <typename T>
     std::string encodeCheck(const T& data, Hash::Hasher hasher = Hash::sha256d) const {
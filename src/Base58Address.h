@@ -10,6 +10,7 @@
 #include "Data.h"
 #include "PublicKey.h"
 
+#include <algorithm>
 #include <array>
 #include <string>
 
@@ -33,22 +34,19 @@ class Base58Address {
 
     /// Determines whether a string makes a valid address.
     static bool isValid(const std::string& string) {
-        const auto decoded = Base58::bitcoin.decodeCheck(string);
-        if (decoded.size() != Base58Address::size) {
-            return false;
-        }
-        return true;
+        std::array<byte, size> decoded;
+        return Base58::bitcoin.decodeCheck(string, decoded);
     }
 
     /// Determines whether a string makes a valid address, and the prefix is
     /// within the valid set.
     static bool isValid(const std::string& string, const std::vector<Data>& validPrefixes) {
-        const auto decoded = Base58::bitcoin.decodeCheck(string);
-        if (decoded.size() != Base58Address::size) {
+        std::array<byte, size> decoded;
+        if (!Base58::bitcoin.decodeCheck(string, decoded)) {
             return false;
         }
         for (const auto& prefix : validPrefixes) {
-            if (has_prefix(decoded, prefix)) {
+            if (prefix.size() <= size && std::equal(prefix.begin(), prefix.end(), decoded.begin())) {
                 return true;
             }
         }
@@ -59,12 +57,9 @@ class Base58Address {
 
     /// Initializes an address with a string representation.
     explicit Base58Address(const std::string& string) {
-        const auto decoded = Base58::bitcoin.decodeCheck(string);
-        if (decoded.size() != Base58Address::size) {
+        if (!Base58::bitcoin.decodeCheck(string, bytes)) {
             throw std::invalid_argument("Invalid address string");
         }
-
-        std::copy(decoded.begin(), decoded.end(), bytes.begin());
     }
 
     /// Initializes an address with a collection of bytes.
@@ -6,75 +6,349 @@
 
 #include "Base64.h"
 
-#include <boost/algorithm/string.hpp>
-#include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
-#include <boost/archive/iterators/transform_width.hpp>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TW_BASE64_SSSE3 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define TW_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace TW::Base64 {
 
 using namespace TW;
 using namespace std;
 
-Data decode(const string& val) {
-    using namespace boost::archive::iterators;
-    using It = transform_width<binary_from_base64<string::const_iterator>, 8, 6>;
-    return boost::algorithm::trim_right_copy_if(Data(It(begin(val)), It(end(val))),
-                                                [](char c) { return c == '\0'; });
+namespace {
+
+constexpr char standardCharacters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char urlCharacters[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+/// Characters of the values 62 and 63 of an alphabet, twice the same when it has one of each.
+struct Specials {
+    char value62[2];
+    char value63[2];
+};
+
+constexpr Specials specials(Alphabet alphabet) {
+    switch (alphabet) {
+    case Alphabet::Standard:
+        return {{'+', '+'}, {'/', '/'}};
+    case Alphabet::Url:
+        return {{'-', '-'}, {'_', '_'}};
+    default:
+        return {{'+', '-'}, {'/', '_'}};
+    }
 }
 
-string encode(const Data& val) {
-    using namespace boost::archive::iterators;
-    using It = base64_from_binary<transform_width<Data::const_iterator, 6, 8>>;
-    auto encoded = string(It(begin(val)), It(end(val)));
-    return encoded.append((3 - val.size() % 3) % 3, '=');
+const char* characters(Alphabet alphabet) {
+    return alphabet == Alphabet::Url ? urlCharacters : standardCharacters;
+}
+
+/// Value of each character of an alphabet, -1 for others.
+constexpr std::array<int8_t, 256> makeValues(Alphabet alphabet) {
+    std::array<int8_t, 256> values = {};
+    for (auto& value : values) {
+        value = -1;
+    }
+    for (int i = 0; i < 62; ++i) {
+        values[static_cast<unsigned char>(standardCharacters[i])] = static_cast<int8_t>(i);
+    }
+    const auto chars = specials(alphabet);
+    for (const auto c : chars.value62) {
+        values[static_cast<unsigned char>(c)] = 62;
+    }
+    for (const auto c : chars.value63) {
+        values[static_cast<unsigned char>(c)] = 63;
+    }
+    return values;
+}
+
+constexpr std::array<std::array<int8_t, 256>, 3> characterValues = {
+    makeValues(Alphabet::Standard), makeValues(Alphabet::Url), makeValues(Alphabet::Any)};
+
+#if TW_BASE64_SSSE3
+
+bool hasSSSE3() {
+    static const bool supported = []() {
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & (1u << 9)) != 0;
+    }();
+    return supported;
+}
+
+/// Encodes 12 bytes, of the 16 read, into 16 characters.
+__attribute__((target("ssse3"))) inline void encode12(const byte* data, char* out, Alphabet alphabet) {
+    // 4 groups of 3 bytes, as 32-bit lanes holding the bytes b1 b0 b2 b1
+    auto input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    input = _mm_shuffle_epi8(input, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+    // the 4 values of 6 bits of each lane, one per byte
+    const auto high = _mm_mulhi_epu16(_mm_and_si128(input, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const auto low = _mm_mullo_epi16(_mm_and_si128(input, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    const auto values = _mm_or_si128(high, low);
+
+    // offset to the character, by range: 26-51, 52-61, 62, 63, then 13 for 0-25
+    const auto chars = specials(alphabet);
+    auto range = _mm_subs_epu8(values, _mm_set1_epi8(51));
+    range = _mm_or_si128(range, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+    const auto offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                       '0' - 52, '0' - 52, '0' - 52, static_cast<char>(chars.value62[0] - 62),
+                                       static_cast<char>(chars.value63[0] - 63), 'A', 0, 0);
+    const auto result = _mm_add_epi8(_mm_shuffle_epi8(offsets, range), values);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), result);
+}
+
+/// Mask of the bytes of `chars` from `first` to `last`, both below 0x80.
+__attribute__((target("ssse3"))) inline __m128i inRange(__m128i chars, char first, char last) {
+    return _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8(first - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8(last + 1)));
 }
 
-/// Convert from Base64Url format to regular
-void convertFromBase64Url(string& b) {
-    // '-' and '_' (Base64URL format) are changed to '+' and '/'
-    // in-place replace
-    size_t n = b.length();
-    char* start = b.data();
-    char* end = start + n;
-    for(auto p = start; p < end; ++p) {
-        if (*p == '-') { *p = '+'; }
-        else if (*p == '_') { *p = '/'; }
+/// Decodes 16 characters into 12 bytes; returns false if a character isn't in the alphabet.
+__attribute__((target("ssse3"))) inline bool decode16(const char* string, byte* out, Alphabet alphabet) {
+    const auto chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(string));
+    // compared as signed, characters from 0x80 are in no range
+    const auto upper = inRange(chars, 'A', 'Z');
+    const auto lower = inRange(chars, 'a', 'z');
+    const auto digit = inRange(chars, '0', '9');
+    const auto special = specials(alphabet);
+    const auto is62 = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(special.value62[0])),
+                                   _mm_cmpeq_epi8(chars, _mm_set1_epi8(special.value62[1])));
+    const auto is63 = _mm_or_si128(_mm_cmpeq_epi8(chars, _mm_set1_epi8(special.value63[0])),
+                                   _mm_cmpeq_epi8(chars, _mm_set1_epi8(special.value63[1])));
+    const auto valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+    if (_mm_movemask_epi8(valid) != 0xffff) {
+        return false;
     }
+    auto values = _mm_and_si128(upper, _mm_sub_epi8(chars, _mm_set1_epi8('A')));
+    values = _mm_or_si128(values, _mm_and_si128(lower, _mm_sub_epi8(chars, _mm_set1_epi8('a' - 26))));
+    values = _mm_or_si128(values, _mm_and_si128(digit, _mm_add_epi8(chars, _mm_set1_epi8(52 - '0'))));
+    values = _mm_or_si128(values, _mm_and_si128(is62, _mm_set1_epi8(62)));
+    values = _mm_or_si128(values, _mm_and_si128(is63, _mm_set1_epi8(63)));
+
+    // 4 values of 6 bits into 3 bytes per 32-bit lane, then the bytes of the lanes in order
+    const auto pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const auto lanes = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    const auto bytes = _mm_shuffle_epi8(lanes, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    alignas(16) byte result[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(result), bytes);
+    std::memcpy(out, result, 12);
+    return true;
 }
 
-/// Convert from regular format to Base64Url
-void convertToBase64Url(string& b) {
-    // '+' and '/' are changed to '-' and '_' (Base64URL format)
-    // in-place replace
-    size_t n = b.length();
-    char* start = b.data();
-    char* end = start + n;
-    for(auto p = start; p < end; ++p) {
-        if (*p == '+') { *p = '-'; }
-        else if (*p == '/') { *p = '_'; }
+/// Encodes the blocks of the input; returns the number of bytes encoded.
+std::size_t encodeBlocks(const byte* data, std::size_t size, char* out, Alphabet alphabet) {
+    if (!hasSSSE3()) {
+        return 0;
+    }
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 12) {
+        encode12(data + i, out + i / 3 * 4, alphabet);
     }
+    return i;
 }
 
-Data decodeBase64Url(const string& val) {
-    Data bytes;
-    try {
-        return decode(val);
-    } catch (const exception& ex) {
-        // 2nd try: Base64URL format (replaced by '-' and '_' by '+' and '/' )
-        string base64Url = val;
-        convertFromBase64Url(base64Url);
-        return decode(base64Url);
+/// Decodes the blocks of the input; returns the number of characters decoded, or -1 if a block isn't valid.
+std::ptrdiff_t decodeBlocks(const char* string, std::size_t size, byte* out, Alphabet alphabet) {
+    if (!hasSSSE3()) {
+        return 0;
+    }
+    std::size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        if (!decode16(string + i, out + i / 4 * 3, alphabet)) {
+            return -1;
+        }
     }
+    return static_cast<std::ptrdiff_t>(i);
 }
 
-string encodeBase64Url(const Data& val) {
-    using namespace boost::archive::iterators;
-    using It = base64_from_binary<transform_width<Data::const_iterator, 6, 8>>;
-    auto encoded = string(It(begin(val)), It(end(val)));
-    encoded.append((3 - val.size() % 3) % 3, '=');
-    convertToBase64Url(encoded);
+#elif TW_BASE64_NEON
+
+/// Mask of the bytes of `chars` from `first` to `last`.
+inline uint8x16_t inRange(uint8x16_t chars, char first, char last) {
+    return vcleq_u8(vsubq_u8(chars, vdupq_n_u8(first)), vdupq_n_u8(last - first));
+}
+
+/// Values of 16 characters; clears the bits of `valid` of characters which aren't in the alphabet.
+inline uint8x16_t charsToValues(uint8x16_t chars, uint8x16_t& valid, Alphabet alphabet) {
+    const auto upper = inRange(chars, 'A', 'Z');
+    const auto lower = inRange(chars, 'a', 'z');
+    const auto digit = inRange(chars, '0', '9');
+    const auto special = specials(alphabet);
+    const auto is62 = vorrq_u8(vceqq_u8(chars, vdupq_n_u8(special.value62[0])), vceqq_u8(chars, vdupq_n_u8(special.value62[1])));
+    const auto is63 = vorrq_u8(vceqq_u8(chars, vdupq_n_u8(special.value63[0])), vceqq_u8(chars, vdupq_n_u8(special.value63[1])));
+    valid = vandq_u8(valid, vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(is62, is63))));
+    auto values = vandq_u8(upper, vsubq_u8(chars, vdupq_n_u8('A')));
+    values = vorrq_u8(values, vandq_u8(lower, vsubq_u8(chars, vdupq_n_u8('a' - 26))));
+    values = vorrq_u8(values, vandq_u8(digit, vaddq_u8(chars, vdupq_n_u8(52 - '0'))));
+    values = vorrq_u8(values, vandq_u8(is62, vdupq_n_u8(62)));
+    return vorrq_u8(values, vandq_u8(is63, vdupq_n_u8(63)));
+}
+
+/// Encodes the blocks of the input, 48 bytes at a time; returns the number of bytes encoded.
+std::size_t encodeBlocks(const byte* data, std::size_t size, char* out, Alphabet alphabet) {
+    const auto* table = reinterpret_cast<const uint8_t*>(characters(alphabet));
+    uint8x16x4_t lookup;
+    for (int i = 0; i < 4; ++i) {
+        lookup.val[i] = vld1q_u8(table + 16 * i);
+    }
+    std::size_t i = 0;
+    for (; i + 48 <= size; i += 48) {
+        // deinterleaved, first bytes of the groups of 3 first
+        const auto bytes = vld3q_u8(data + i);
+        uint8x16x4_t values;
+        values.val[0] = vshrq_n_u8(bytes.val[0], 2);
+        values.val[1] = vorrq_u8(vshlq_n_u8(vandq_u8(bytes.val[0], vdupq_n_u8(0x03)), 4), vshrq_n_u8(bytes.val[1], 4));
+        values.val[2] = vorrq_u8(vshlq_n_u8(vandq_u8(bytes.val[1], vdupq_n_u8(0x0f)), 2), vshrq_n_u8(bytes.val[2], 6));
+        values.val[3] = vandq_u8(bytes.val[2], vdupq_n_u8(0x3f));
+        for (int j = 0; j < 4; ++j) {
+            values.val[j] = vqtbl4q_u8(lookup, values.val[j]);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(out + i / 3 * 4), values);
+    }
+    return i;
+}
+
+/// Decodes the blocks of the input, 64 characters at a time; returns the number of characters decoded, or -1 if a
+/// block isn't valid.
+std::ptrdiff_t decodeBlocks(const char* string, std::size_t size, byte* out, Alphabet alphabet) {
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        const auto chars = vld4q_u8(reinterpret_cast<const uint8_t*>(string + i));
+        auto valid = vdupq_n_u8(0xff);
+        uint8x16_t values[4];
+        for (int j = 0; j < 4; ++j) {
+            values[j] = charsToValues(chars.val[j], valid, alphabet);
+        }
+        if (vminvq_u8(valid) != 0xff) {
+            return -1;
+        }
+        uint8x16x3_t bytes;
+        bytes.val[0] = vorrq_u8(vshlq_n_u8(values[0], 2), vshrq_n_u8(values[1], 4));
+        bytes.val[1] = vorrq_u8(vshlq_n_u8(values[1], 4), vshrq_n_u8(values[2], 2));
+        bytes.val[2] = vorrq_u8(vshlq_n_u8(values[2], 6), values[3]);
+        vst3q_u8(out + i / 4 * 3, bytes);
+    }
+    return static_cast<std::ptrdiff_t>(i);
+}
+
+#else
+
+std::size_t encodeBlocks(const byte*, std::size_t, char*, Alphabet) {
+    return 0;
+}
+
+std::ptrdiff_t decodeBlocks(const char*, std::size_t, byte*, Alphabet) {
+    return 0;
+}
+
+#endif
+
+} // namespace
+
+void encode(const byte* data, std::size_t size, char* out, Alphabet alphabet) {
+    const auto* chars = characters(alphabet);
+    auto i = encodeBlocks(data, size, out, alphabet);
+    out += i / 3 * 4;
+    for (; i + 3 <= size; i += 3) {
+        const uint32_t group = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        *out++ = chars[(group >> 18) & 0x3f];
+        *out++ = chars[(group >> 12) & 0x3f];
+        *out++ = chars[(group >> 6) & 0x3f];
+        *out++ = chars[group & 0x3f];
+    }
+    if (i < size) {
+        const auto two = i + 1 < size;
+        const uint32_t group = (data[i] << 16) | (two ? data[i + 1] << 8 : 0);
+        *out++ = chars[(group >> 18) & 0x3f];
+        *out++ = chars[(group >> 12) & 0x3f];
+        *out++ = two ? chars[(group >> 6) & 0x3f] : '=';
+        *out++ = '=';
+    }
+}
+
+std::ptrdiff_t decode(const char* string, std::size_t size, byte* out, Alphabet alphabet) {
+    // padding is optional
+    for (int i = 0; i < 2 && size > 0 && string[size - 1] == '='; ++i) {
+        --size;
+    }
+    if (size % 4 == 1) {
+        return -1;
+    }
+
+    const auto blocks = decodeBlocks(string, size, out, alphabet);
+    if (blocks < 0) {
+        return -1;
+    }
+    const auto& values = characterValues[static_cast<std::size_t>(alphabet)];
+    const auto value = [&values, string](std::size_t i) { return values[static_cast<unsigned char>(string[i])]; };
+    auto i = static_cast<std::size_t>(blocks);
+    auto* begin = out;
+    out += i / 4 * 3;
+    for (; i + 4 <= size; i += 4) {
+        const auto v0 = value(i), v1 = value(i + 1), v2 = value(i + 2), v3 = value(i + 3);
+        if ((v0 | v1 | v2 | v3) < 0) {
+            return -1;
+        }
+        const uint32_t group = (v0 << 18) | (v1 << 12) | (v2 << 6) | v3;
+        *out++ = static_cast<byte>(group >> 16);
+        *out++ = static_cast<byte>(group >> 8);
+        *out++ = static_cast<byte>(group);
+    }
+    if (i < size) {
+        // 2 or 3 characters, for 1 or 2 bytes; the bits left over are ignored
+        const auto three = i + 2 < size;
+        const auto v0 = value(i), v1 = value(i + 1), v2 = three ? value(i + 2) : int8_t(0);
+        if ((v0 | v1 | v2) < 0) {
+            return -1;
+        }
+        const uint32_t group = (v0 << 18) | (v1 << 12) | (v2 << 6);
+        *out++ = static_cast<byte>(group >> 16);
+        if (three) {
+            *out++ = static_cast<byte>(group >> 8);
+        }
+    }
+    return out - begin;
+}
+
+namespace {
+
+string encode(const Data& val, Alphabet alphabet) {
+    string encoded(encodedSize(val.size()), '\0');
+    encode(val.data(), val.size(), encoded.data(), alphabet);
     return encoded;
 }
 
+Data decode(const string& val, Alphabet alphabet) {
+    Data decoded(decodedSize(val.size()));
+    const auto size = decode(val.data(), val.size(), decoded.data(), alphabet);
+    if (size < 0) {
+        throw invalid_argument("Invalid Base64 string");
+    }
+    decoded.resize(static_cast<std::size_t>(size));
+    return decoded;
+}
+
+} // namespace
+
+Data decode(const string& val) {
+    return decode(val, Alphabet::Standard);
+}
+
+string encode(const Data& val) {
+    return encode(val, Alphabet::Standard);
+}
+
+Data decodeBase64Url(const string& val) {
+    return decode(val, Alphabet::Any);
+}
+
+string encodeBase64Url(const Data& val) {
+    return encode(val, Alphabet::Url);
+}
+
 } // namespace TW::Base64
@@ -8,9 +8,38 @@
 
 #include "Data.h"
 
+#include <cstddef>
+#include <string>
+
 namespace TW::Base64 {
 
-// Decode a Base64-format string
+/// Characters used for the values 62 and 63: '+' and '/' in Base64, '-' and '_' in Base64Url.
+enum class Alphabet {
+    Standard,
+    Url,
+    /// Decodes both
+    Any,
+};
+
+/// Number of characters encoding `size` bytes, with padding.
+inline std::size_t encodedSize(std::size_t size) {
+    return (size + 2) / 3 * 4;
+}
+
+/// Maximum number of bytes decoded from `size` characters.
+inline std::size_t decodedSize(std::size_t size) {
+    return (size + 3) / 4 * 3;
+}
+
+/// Writes the encoding of `size` bytes to `out`, encodedSize(size) characters padded with '=', without a terminator.
+/// Vectorized with SSSE3 or NEON where available.
+void encode(const byte* data, std::size_t size, char* out, Alphabet alphabet = Alphabet::Standard);
+
+/// Decodes `size` characters, padded or not, into `out`, of at least decodedSize(size) bytes; returns the number of
+/// bytes written, or -1 if the input isn't valid. Vectorized with SSSE3 or NEON where available.
+std::ptrdiff_t decode(const char* string, std::size_t size, byte* out, Alphabet alphabet = Alphabet::Standard);
+
+// Decode a Base64-format string; throws std::invalid_argument if it isn't valid
 Data decode(const std::string& val);
 
 // Encode bytes into Base64 string
@@ -0,0 +1,273 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BatchScheduler.h"
+#include "Instrumentation.h"
+#include "Secp256k1Comb.h"
+#include "ThreadPool.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+using namespace TW;
+
+namespace {
+
+/// Total wait of the requests of a batch, until `start`.
+template <typename Queued>
+uint64_t queueingNanoseconds(const Queued& queued, BatchScheduler::Clock::time_point start) {
+    BatchScheduler::Clock::duration total{};
+    for (const auto& time : queued) {
+        total += start - time;
+    }
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(total).count());
+}
+
+} // namespace
+
+BatchScheduler::BatchScheduler(const Options& options) : options(options) {
+    if (options.maxBatchSize == 0) {
+        throw std::invalid_argument("Invalid batch size");
+    }
+    timer = std::thread(&BatchScheduler::runTimer, this);
+}
+
+BatchScheduler::~BatchScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeup.notify_one();
+    timer.join();
+    flush();
+    std::unique_lock<std::mutex> lock(mutex);
+    idle.wait(lock, [this] { return running == 0; });
+}
+
+std::future<BatchSigningResult> BatchScheduler::sign(TWCoinType coin, Data input) {
+    auto request = SignRequest{coin, std::move(input), {}};
+    auto result = request.result.get_future();
+    enqueue(signGroups, coin, std::move(request));
+    return result;
+}
+
+std::future<bool> BatchScheduler::verify(const PublicKey& publicKey, Data signature, Data message) {
+    auto request = VerifyRequest{publicKey, std::move(signature), std::move(message), {}};
+    auto result = request.result.get_future();
+    enqueue(verifyGroups, publicKey.type, std::move(request));
+    return result;
+}
+
+std::future<std::string> BatchScheduler::deriveAddress(TWCoinType coin, const PrivateKey& privateKey) {
+    auto request = DeriveRequest{coin, privateKey, {}};
+    auto result = request.result.get_future();
+    enqueue(deriveGroups, coin, std::move(request));
+    return result;
+}
+
+template <typename Key, typename Request>
+void BatchScheduler::enqueue(std::map<Key, Group<Request>>& groups, Key key, Request&& request) {
+    std::vector<std::function<void()>> jobs;
+    bool first = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& group = groups[key];
+        first = group.requests.empty();
+        group.requests.push_back(std::move(request));
+        group.queued.push_back(Clock::now());
+        if (group.requests.size() >= options.maxBatchSize) {
+            auto full = std::make_shared<Group<Request>>(std::move(group));
+            jobs.emplace_back([full] { run(*full); });
+            groups.erase(key);
+        }
+    }
+    if (!jobs.empty()) {
+        start(jobs);
+    } else if (first) {
+        // a new deadline, possibly earlier than the one the timer waits for
+        wakeup.notify_one();
+    }
+}
+
+template <typename Key, typename Request>
+void BatchScheduler::takeGroups(std::map<Key, Group<Request>>& groups, Clock::time_point deadline, std::vector<std::function<void()>>& jobs) {
+    for (auto it = groups.begin(); it != groups.end();) {
+        if (it->second.queued.front() > deadline) {
+            ++it;
+            continue;
+        }
+        auto group = std::make_shared<Group<Request>>(std::move(it->second));
+        jobs.emplace_back([group] { run(*group); });
+        it = groups.erase(it);
+    }
+}
+
+void BatchScheduler::flush() {
+    std::vector<std::function<void()>> jobs;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto all = Clock::time_point::max();
+        takeGroups(signGroups, all, jobs);
+        takeGroups(verifyGroups, all, jobs);
+        takeGroups(deriveGroups, all, jobs);
+    }
+    start(jobs);
+}
+
+void BatchScheduler::start(std::vector<std::function<void()>>& jobs) {
+    if (jobs.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running += jobs.size();
+    }
+    for (auto& job : jobs) {
+        ThreadPool::shared().submit([this, job = std::move(job)] {
+            try {
+                job();
+            } catch (...) {
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--running == 0) {
+                idle.notify_all();
+            }
+        });
+    }
+}
+
+std::size_t BatchScheduler::pending() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t count = 0;
+    for (const auto& entry : signGroups) {
+        count += entry.second.requests.size();
+    }
+    for (const auto& entry : verifyGroups) {
+        count += entry.second.requests.size();
+    }
+    for (const auto& entry : deriveGroups) {
+        count += entry.second.requests.size();
+    }
+    return count;
+}
+
+void BatchScheduler::runTimer() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping) {
+        std::vector<std::function<void()>> jobs;
+        const auto deadline = Clock::now() - options.maxDelay;
+        takeGroups(signGroups, deadline, jobs);
+        takeGroups(verifyGroups, deadline, jobs);
+        takeGroups(deriveGroups, deadline, jobs);
+        if (!jobs.empty()) {
+            lock.unlock();
+            start(jobs);
+            lock.lock();
+            continue;
+        }
+
+        // the groups left are younger than maxDelay, wait for the oldest one
+        auto oldest = Clock::time_point::max();
+        const auto updateOldest = [&oldest](const auto& groups) {
+            for (const auto& entry : groups) {
+                oldest = std::min(oldest, entry.second.queued.front());
+            }
+        };
+        updateOldest(signGroups);
+        updateOldest(verifyGroups);
+        updateOldest(deriveGroups);
+        if (oldest == Clock::time_point::max()) {
+            wakeup.wait(lock);
+        } else {
+            wakeup.wait_until(lock, oldest + options.maxDelay);
+        }
+    }
+}
+
+void BatchScheduler::run(Group<SignRequest>& group) {
+    auto& requests = group.requests;
+    TW_INSTRUMENT_DURATION("BatchScheduler::queue", queueingNanoseconds(group.queued, Clock::now()), requests.size());
+    TW_INSTRUMENT_SCOPE_COUNT("BatchScheduler::sign", requests.size());
+    std::vector<std::pair<TWCoinType, Data>> inputs;
+    inputs.reserve(requests.size());
+    for (auto& request : requests) {
+        inputs.emplace_back(request.coin, std::move(request.input));
+    }
+    // the pool runs batches side by side, one thread each
+    auto results = anyCoinSignBatch(inputs, 1);
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        requests[i].result.set_value(std::move(results[i]));
+    }
+}
+
+void BatchScheduler::run(Group<VerifyRequest>& group) {
+    auto& requests = group.requests;
+    TW_INSTRUMENT_DURATION("BatchScheduler::queue", queueingNanoseconds(group.queued, Clock::now()), requests.size());
+    TW_INSTRUMENT_SCOPE_COUNT("BatchScheduler::verify", requests.size());
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> messages;
+    std::vector<Data> signatures;
+    publicKeys.reserve(requests.size());
+    messages.reserve(requests.size());
+    signatures.reserve(requests.size());
+    for (auto& request : requests) {
+        publicKeys.push_back(request.publicKey);
+        messages.push_back(std::move(request.message));
+        signatures.push_back(std::move(request.signature));
+    }
+    std::vector<bool> valid;
+    PublicKey::verifyBatch(publicKeys, messages, signatures, valid);
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        requests[i].result.set_value(valid[i]);
+    }
+}
+
+void BatchScheduler::run(Group<DeriveRequest>& group) {
+    auto& requests = group.requests;
+    TW_INSTRUMENT_DURATION("BatchScheduler::queue", queueingNanoseconds(group.queued, Clock::now()), requests.size());
+    TW_INSTRUMENT_SCOPE_COUNT("BatchScheduler::derive", requests.size());
+    const auto coin = requests.front().coin;
+    const auto keyType = TW::publicKeyType(coin);
+
+    // secp256k1 public keys are computed together, with a single field inversion
+    const auto count = requests.size();
+    const auto batchable = TWCoinTypeCurve(coin) == TWCurveSECP256k1 &&
+                           (keyType == TWPublicKeyTypeSECP256k1 || keyType == TWPublicKeyTypeSECP256k1Extended) &&
+                           std::all_of(requests.begin(), requests.end(), [](const auto& request) { return request.privateKey.bytes.size() == PrivateKey::size; });
+    const auto publicKeySize = keyType == TWPublicKeyTypeSECP256k1 ? PublicKey::secp256k1Size : PublicKey::secp256k1ExtendedSize;
+    Data publicKeys;
+    if (batchable) {
+        Data privateKeys(count * PrivateKey::size);
+        for (std::size_t i = 0; i < count; ++i) {
+            std::memcpy(privateKeys.data() + i * PrivateKey::size, requests[i].privateKey.bytes.data(), PrivateKey::size);
+        }
+        publicKeys.resize(count * publicKeySize);
+        if (!Secp256k1Comb::publicKeys(privateKeys.data(), count, keyType == TWPublicKeyTypeSECP256k1, publicKeys.data())) {
+            publicKeys.clear();
+        }
+        memzero(privateKeys.data(), privateKeys.size());
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& request = requests[i];
+        try {
+            if (!publicKeys.empty()) {
+                const auto begin = publicKeys.begin() + i * publicKeySize;
+                request.result.set_value(TW::deriveAddress(coin, PublicKey(Data(begin, begin + publicKeySize), keyType)));
+            } else {
+                request.result.set_value(TW::deriveAddress(coin, request.privateKey));
+            }
+        } catch (...) {
+            request.result.set_exception(std::current_exception());
+        }
+    }
+}
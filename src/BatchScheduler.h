@@ -0,0 +1,135 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Coin.h"
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWPublicKeyType.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+/// Coalesces single signing, verification and address derivation requests, made from many threads, into
+/// batches for anyCoinSignBatch, PublicKey::verifyBatch and the batched secp256k1 public keys.
+///
+/// Requests are grouped by coin (signing, derivation) or public key type (verification), so that a batch
+/// goes to a single kernel.  A group is flushed as soon as it holds `maxBatchSize` requests, or once its
+/// oldest request has waited `maxDelay`, which bounds the latency added to a request.  Batches run on the
+/// shared ThreadPool, one thread per batch.  With instrumentation, "BatchScheduler::queue" reports the total wait
+/// of the requests of each batch, and "BatchScheduler::sign", "::verify" and "::derive" the execution of
+/// each batch, both with the number of requests.  Thread-safe.
+class BatchScheduler {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Options {
+        /// Requests per batch, a full group is flushed at once.
+        std::size_t maxBatchSize = 64;
+        /// Longest wait of a request before its group is flushed.
+        std::chrono::microseconds maxDelay = std::chrono::microseconds(500);
+    };
+
+    /// @throws std::invalid_argument if `maxBatchSize` is 0.
+    explicit BatchScheduler(const Options& options);
+    BatchScheduler() : BatchScheduler(Options()) {}
+
+    /// Flushes the pending requests and waits for all batches to complete.
+    ~BatchScheduler();
+
+    BatchScheduler(const BatchScheduler&) = delete;
+    BatchScheduler& operator=(const BatchScheduler&) = delete;
+
+    /// Queues a serialized signing input, as anyCoinSign takes.
+    std::future<BatchSigningResult> sign(TWCoinType coin, Data input);
+
+    /// Queues a signature verification, as PublicKey::verify does.
+    std::future<bool> verify(const PublicKey& publicKey, Data signature, Data message);
+
+    /// Queues the derivation of the address of a private key; the future throws what TW::deriveAddress throws.
+    std::future<std::string> deriveAddress(TWCoinType coin, const PrivateKey& privateKey);
+
+    /// Starts the batches of all pending requests, without waiting for their deadline.
+    void flush();
+
+    /// Number of queued requests, not yet in a started batch.
+    std::size_t pending() const;
+
+  private:
+    struct SignRequest {
+        TWCoinType coin;
+        Data input;
+        std::promise<BatchSigningResult> result;
+    };
+
+    struct VerifyRequest {
+        PublicKey publicKey;
+        Data signature;
+        Data message;
+        std::promise<bool> result;
+    };
+
+    struct DeriveRequest {
+        TWCoinType coin;
+        PrivateKey privateKey;
+        std::promise<std::string> result;
+    };
+
+    template <typename Request>
+    struct Group {
+        /// Requests in queue order, with their queueing times.
+        std::vector<Request> requests;
+        std::vector<Clock::time_point> queued;
+    };
+
+    Options options;
+    mutable std::mutex mutex;
+    /// Notified when a group gets its first request, or on stop.
+    std::condition_variable wakeup;
+    /// Notified when the last started batch completes.
+    std::condition_variable idle;
+    /// Batches started and not completed yet.
+    std::size_t running = 0;
+    std::map<TWCoinType, Group<SignRequest>> signGroups;
+    std::map<TWPublicKeyType, Group<VerifyRequest>> verifyGroups;
+    std::map<TWCoinType, Group<DeriveRequest>> deriveGroups;
+    bool stopping = false;
+    /// Flushes the groups at their deadline.
+    std::thread timer;
+
+    /// Queues a request in the group of `key`, starting the batch of the group if full.
+    template <typename Key, typename Request>
+    void enqueue(std::map<Key, Group<Request>>& groups, Key key, Request&& request);
+
+    /// Moves out the groups whose oldest request was queued at `deadline` or before, as jobs for the pool.
+    template <typename Key, typename Request>
+    static void takeGroups(std::map<Key, Group<Request>>& groups, Clock::time_point deadline, std::vector<std::function<void()>>& jobs);
+
+    void runTimer();
+
+    /// Runs batch jobs on the shared pool.
+    void start(std::vector<std::function<void()>>& jobs);
+
+    static void run(Group<SignRequest>& group);
+    static void run(Group<VerifyRequest>& group);
+    static void run(Group<DeriveRequest>& group);
+};
+
+} // namespace TW
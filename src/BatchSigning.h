@@ -0,0 +1,75 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "ThreadPool.h"
+#include "proto/Common.pb.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+namespace TW {
+
+/// Inputs handed to a thread at a time by signInRuns().
+constexpr std::size_t batchSigningChunkSize = 64;
+
+/// Calls `body(first, last)` on the ranges of `chunkSize` items out of `count`, from up to `threadCount` threads
+/// (0 for the hardware concurrency).
+template <typename Body>
+void forEachChunk(std::size_t count, std::size_t chunkSize, std::size_t threadCount, Body&& body) {
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (auto first = next.fetch_add(chunkSize); first < count; first = next.fetch_add(chunkSize)) {
+            body(first, std::min(first + chunkSize, count));
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, (count + chunkSize - 1) / chunkSize, worker);
+}
+
+/// Run predicate of signInRuns() for inputs with a `private_key` field: the same key.
+struct SamePrivateKey {
+    template <typename Input>
+    bool operator()(const Input& first, const Input& input) const { return input.private_key() == first.private_key(); }
+};
+
+/// Signs many inputs of a coin, for the signBatch() of its signer, on up to `threadCount` threads (0 for the
+/// hardware concurrency).
+///
+/// Inputs are split into runs of consecutive inputs for which `sameRun(first, input)` holds, typically those
+/// with the same private key, as in a payout from one account; `signRun(begin, end, outputs)` then sets up the
+/// key state once and fills the outputs of the inputs [begin, end).  Failures of single inputs are for
+/// `signRun` to report in their outputs; if it throws, the key of the run is taken as invalid, and the outputs
+/// of the run are empty but for the error Error_missing_private_key.
+template <typename Output, typename Input, typename SameRun, typename SignRun>
+std::vector<Output> signInRuns(const std::vector<Input>& inputs, std::size_t threadCount, SameRun&& sameRun, SignRun&& signRun) {
+    std::vector<Output> outputs(inputs.size());
+    forEachChunk(inputs.size(), batchSigningChunkSize, threadCount, [&](std::size_t first, std::size_t last) {
+        // runs don't cross chunks, so that a thread owns all the outputs it writes
+        for (auto begin = first; begin < last;) {
+            auto end = begin + 1;
+            while (end < last && sameRun(inputs[begin], inputs[end])) {
+                ++end;
+            }
+            try {
+                signRun(begin, end, outputs);
+            } catch (const std::exception&) {
+                for (auto i = begin; i < end; ++i) {
+                    outputs[i] = Output();
+                    outputs[i].set_error(Common::Proto::Error_missing_private_key);
+                }
+            }
+            begin = end;
+        }
+    });
+    return outputs;
+}
+
+} // namespace TW
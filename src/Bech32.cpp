@@ -7,7 +7,9 @@
 
 #include "Bech32.h"
 #include "Data.h"
+#include "Instrumentation.h"
 
+#include <algorithm>
 #include <array>
 
 // Bech32 address encoding
@@ -35,14 +37,38 @@ const uint32_t BECH32_XOR_CONST = 0x01;
 const uint32_t BECH32M_XOR_CONST = 0x2bc830a3;
 
 
+/** Update the polynomial checksum with one value. */
+constexpr uint32_t polymodStep(uint32_t chk, uint8_t value) {
+    uint8_t top = chk >> 25;
+    return (chk & 0x1ffffff) << 5 ^ value ^ (-((top >> 0) & 1) & 0x3b6a57b2UL) ^
+           (-((top >> 1) & 1) & 0x26508e6dUL) ^ (-((top >> 2) & 1) & 0x1ea119faUL) ^
+           (-((top >> 3) & 1) & 0x3d4233ddUL) ^ (-((top >> 4) & 1) & 0x2a1462b3UL);
+}
+
+/** Reduction of the top 10 bits of the checksum over two steps; the polymod is linear over GF(2). */
+constexpr std::array<uint32_t, 1024> makePolymodTable() {
+    std::array<uint32_t, 1024> table = {};
+    for (uint32_t top = 0; top < 1024; ++top) {
+        table[top] = polymodStep(polymodStep(top << 20, 0), 0);
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 1024> polymodTable = makePolymodTable();
+
+/** Update the polynomial checksum with two values. */
+inline uint32_t polymodPair(uint32_t chk, uint8_t first, uint8_t second) {
+    return (chk & 0xfffff) << 10 ^ polymodTable[chk >> 20] ^ (uint32_t(first) << 5) ^ second;
+}
+
 /** Find the polynomial with value coefficients mod the generator as 30-bit. */
-uint32_t polymod(const Data& values) {
-    uint32_t chk = 1;
-    for (const auto& value : values) {
-        uint8_t top = chk >> 25;
-        chk = (chk & 0x1ffffff) << 5 ^ value ^ (-((top >> 0) & 1) & 0x3b6a57b2UL) ^
-              (-((top >> 1) & 1) & 0x26508e6dUL) ^ (-((top >> 2) & 1) & 0x1ea119faUL) ^
-              (-((top >> 3) & 1) & 0x3d4233ddUL) ^ (-((top >> 4) & 1) & 0x2a1462b3UL);
+uint32_t polymod(uint32_t chk, const byte* values, size_t size) {
+    size_t i = 0;
+    for (; i + 1 < size; i += 2) {
+        chk = polymodPair(chk, values[i], values[i + 1]);
+    }
+    if (i < size) {
+        chk = polymodStep(chk, values[i]);
     }
     return chk;
 }
@@ -52,17 +78,17 @@ unsigned char lc(unsigned char c) {
     return (c >= 'A' && c <= 'Z') ? (c - 'A') + 'a' : c;
 }
 
-/** Expand a HRP for use in checksum computation. */
-Data expand_hrp(const std::string& hrp) {
-    Data ret;
-    ret.resize(hrp.size() * 2 + 1);
-    for (size_t i = 0; i < hrp.size(); ++i) {
-        unsigned char c = hrp[i];
-        ret[i] = c >> 5;
-        ret[i + hrp.size() + 1] = c & 0x1f;
+/** Polynomial of the expanded HRP, the checksum computation starts with it. */
+uint32_t polymodHrp(const std::string& hrp) {
+    uint32_t chk = 1;
+    for (const auto c : hrp) {
+        chk = polymodStep(chk, static_cast<unsigned char>(c) >> 5);
     }
-    ret[hrp.size()] = 0;
-    return ret;
+    chk = polymodStep(chk, 0);
+    for (const auto c : hrp) {
+        chk = polymodStep(chk, static_cast<unsigned char>(c) & 0x1f);
+    }
+    return chk;
 }
 
 inline uint32_t xorConstant(ChecksumVariant variant) {
@@ -73,11 +99,9 @@ inline uint32_t xorConstant(ChecksumVariant variant) {
     return BECH32M_XOR_CONST;
 }
 
-/** Verify a checksum. */
-ChecksumVariant verify_checksum(const std::string& hrp, const Data& values) {
-    Data enc = expand_hrp(hrp);
-    append(enc, values);
-    auto poly = polymod(enc);
+/** Verify a checksum, `chk` is the polynomial of the HRP. */
+ChecksumVariant verify_checksum(uint32_t chk, const byte* values, size_t size) {
+    auto poly = polymod(chk, values, size);
     if (poly == BECH32_XOR_CONST) {
         return ChecksumVariant::Bech32;
     }
@@ -88,79 +112,127 @@ ChecksumVariant verify_checksum(const std::string& hrp, const Data& values) {
 }
 
 /** Create a checksum. */
-Data create_checksum(const std::string& hrp, const Data& values, ChecksumVariant variant) {
-    Data enc = expand_hrp(hrp);
-    append(enc, values);
-    enc.resize(enc.size() + 6);
+std::array<byte, 6> create_checksum(const std::string& hrp, DataView values, ChecksumVariant variant) {
+    auto chk = polymod(polymodHrp(hrp), values.data(), values.size());
+    for (size_t i = 0; i < 3; ++i) {
+        chk = polymodPair(chk, 0, 0);
+    }
     auto xorConst = xorConstant(variant);
-    uint32_t mod = polymod(enc) ^ xorConst;
-    Data ret;
-    ret.resize(6);
+    uint32_t mod = chk ^ xorConst;
+    std::array<byte, 6> ret;
     for (size_t i = 0; i < 6; ++i) {
         ret[i] = (mod >> (5 * (5 - i))) & 31;
     }
     return ret;
 }
 
-} // namespace
-
-/** Encode a Bech32 string. */
-std::string Bech32::encode(const std::string& hrp, const Data& values, ChecksumVariant variant) {
-    Data checksum = create_checksum(hrp, values, variant);
-    Data combined = values;
-    append(combined, checksum);
-    std::string ret = hrp + '1';
-    ret.reserve(ret.size() + combined.size());
-    for (const auto& value : combined) {
-        ret += charset[value];
-    }
-    return ret;
-}
-
-/** Decode a Bech32 string. */
-std::tuple<std::string, Data, ChecksumVariant> Bech32::decode(const std::string& str) {
+/** Check the length, character range and case of a string. */
+bool checkCharacters(const std::string& str) {
     if (str.length() > 120 || str.length() < 2) {
         // too long or too short
-        return std::make_tuple(std::string(), Data(), None);
+        return false;
     }
     bool lower = false, upper = false;
-    bool ok = true;
-    for (size_t i = 0; ok && i < str.size(); ++i) {
-        unsigned char c = str[i];
+    for (const auto ch : str) {
+        const auto c = static_cast<unsigned char>(ch);
         if (c < 33 || c > 126) {
-            ok = false;
-        }
-        if (c >= 'a' && c <= 'z') {
-            lower = true;
+            return false;
         }
-        if (c >= 'A' && c <= 'Z') {
-            upper = true;
+        lower |= (c >= 'a' && c <= 'z');
+        upper |= (c >= 'A' && c <= 'Z');
+    }
+    return !(lower && upper);
+}
+
+/** Decode and verify the data part, following the separator at `pos`; `chk` is the polynomial of the HRP.
+    On success, the values without the checksum are stored in `values`, if given. */
+ChecksumVariant verifyData(const std::string& str, size_t pos, uint32_t chk, Data* values) {
+    if (pos < 1 || pos + 7 > str.size()) {
+        return None;
+    }
+    const auto size = str.size() - 1 - pos;
+    std::array<byte, 120> buffer;
+    for (size_t i = 0; i < size; ++i) {
+        const auto value = charset_rev[static_cast<unsigned char>(str[i + pos + 1])];
+        if (value == -1) {
+            return None;
         }
+        buffer[i] = static_cast<byte>(value);
+    }
+    const auto variant = verify_checksum(chk, buffer.data(), size);
+    if (variant != None && values != nullptr) {
+        values->assign(buffer.begin(), buffer.begin() + size - 6);
+    }
+    return variant;
+}
+
+} // namespace
+
+/** Encode a Bech32 string. */
+std::string Bech32::encode(const std::string& hrp, DataView values, ChecksumVariant variant) {
+    TW_INSTRUMENT_SCOPE("Bech32::encode");
+    std::string ret(encodedSize(hrp, values), '\0');
+    encode(hrp, values, variant, &ret[0], ret.size());
+    return ret;
+}
+
+size_t Bech32::encode(const std::string& hrp, DataView values, ChecksumVariant variant, char* out, size_t size) {
+    const auto length = encodedSize(hrp, values);
+    if (size < length) {
+        return 0;
     }
-    if (lower && upper) {
-        ok = false;
+    const auto checksum = create_checksum(hrp, values, variant);
+    out = std::copy(hrp.begin(), hrp.end(), out);
+    *out++ = '1';
+    for (const auto& value : values) {
+        *out++ = charset[value];
+    }
+    for (const auto& value : checksum) {
+        *out++ = charset[value];
     }
-    size_t pos = str.rfind('1');
-    if (ok && pos != str.npos && pos >= 1 && pos + 7 <= str.size()) {
+    return length;
+}
+
+/** Decode a Bech32 string. */
+std::tuple<std::string, Data, ChecksumVariant> Bech32::decode(const std::string& str) {
+    TW_INSTRUMENT_SCOPE("Bech32::decode");
+    const size_t pos = str.rfind('1');
+    if (checkCharacters(str) && pos != str.npos) {
+        std::string hrp(pos, '\0');
+        std::transform(str.begin(), str.begin() + pos, hrp.begin(), lc);
         Data values;
-        values.resize(str.size() - 1 - pos);
-        for (size_t i = 0; i < str.size() - 1 - pos; ++i) {
-            unsigned char c = str[i + pos + 1];
-            if (charset_rev[c] == -1) {
-                ok = false;
-            }
-            values[i] = charset_rev[c];
-        }
-        if (ok) {
-            std::string hrp;
-            for (size_t i = 0; i < pos; ++i) {
-                hrp += lc(str[i]);
-            }
-            auto variant = verify_checksum(hrp, values);
-            if (variant != None) {
-                return std::make_tuple(hrp, Data(values.begin(), values.end() - 6), variant);
-            }
+        auto variant = verifyData(str, pos, polymodHrp(hrp), &values);
+        if (variant != None) {
+            return std::make_tuple(hrp, std::move(values), variant);
         }
     }
     return std::make_tuple(std::string(), Data(), None);
 }
+
+Verifier::Verifier(const std::string& hrp) : hrp(hrp) {
+    std::transform(this->hrp.begin(), this->hrp.end(), this->hrp.begin(), lc);
+    hrpChecksum = polymodHrp(this->hrp);
+}
+
+ChecksumVariant Verifier::verify(const std::string& str, Data* values) const {
+    const auto pos = hrp.size();
+    if (str.size() <= pos || str[pos] != '1' || !checkCharacters(str)) {
+        return None;
+    }
+    for (size_t i = 0; i < pos; ++i) {
+        if (lc(str[i]) != static_cast<unsigned char>(hrp[i])) {
+            return None;
+        }
+    }
+    // the data part can't contain a '1', so `pos` is the last one
+    return verifyData(str, pos, hrpChecksum, values);
+}
+
+std::vector<ChecksumVariant> Verifier::verify(const std::vector<std::string>& strings) const {
+    std::vector<ChecksumVariant> result;
+    result.reserve(strings.size());
+    for (const auto& str : strings) {
+        result.push_back(verify(str));
+    }
+    return result;
+}
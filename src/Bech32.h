@@ -5,6 +5,8 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#pragma once
+
 #include "Data.h"
 
 #include <cstdint>
@@ -23,7 +25,17 @@ enum ChecksumVariant {
 /// Encodes a Bech32 string.
 ///
 /// \returns the encoded string, or an empty string in case of failure.
-std::string encode(const std::string& hrp, const Data& values, ChecksumVariant variant);
+std::string encode(const std::string& hrp, DataView values, ChecksumVariant variant);
+
+/// Number of characters of an encoded Bech32 string.
+inline size_t encodedSize(const std::string& hrp, DataView values) {
+    return hrp.size() + 1 + values.size() + 6;
+}
+
+/// Encodes a Bech32 string into `out`, of capacity `size`, without allocations.
+///
+/// \returns the number of characters written (see `encodedSize`), or 0 if `size` is too small.
+size_t encode(const std::string& hrp, DataView values, ChecksumVariant variant, char* out, size_t size);
 
 /// Decodes a Bech32 string.
 ///
@@ -34,9 +46,31 @@ std::string encode(const std::string& hrp, const Data& values, ChecksumVariant v
 /// or empty values on failure.
 std::tuple<std::string, Data, ChecksumVariant> decode(const std::string& str);
 
+/// Verifies many strings with the same human-readable part, whose checksum polynomial is computed once.
+class Verifier {
+  public:
+    /// Expected human-readable part, in lower case.
+    std::string hrp;
+
+    /// Initializes a verifier for a human-readable part (case-insensitive).
+    explicit Verifier(const std::string& hrp);
+
+    /// Verifies a string with the expected human-readable part.
+    /// The data part is stored in `values` (without the checksum) if given.
+    ///
+    /// \returns the checksum variant used, `None` if invalid.
+    ChecksumVariant verify(const std::string& str, Data* values = nullptr) const;
+
+    /// Verifies many strings, returned in the same order.
+    std::vector<ChecksumVariant> verify(const std::vector<std::string>& strings) const;
+
+  private:
+    uint32_t hrpChecksum;
+};
+
 /// Converts from one power-of-2 number base to another.
 template <int frombits, int tobits, bool pad>
-inline bool convertBits(Data& out, const Data& in) {
+inline bool convertBits(Data& out, DataView in) {
     int acc = 0;
     int bits = 0;
     const int maxv = (1 << tobits) - 1;
@@ -11,6 +11,21 @@
 
 using namespace TW;
 
+namespace {
+
+/// Checks that 5-bit values convert to 2 to 40 bytes, like Bech32::convertBits<5, 8, false> but without allocating.
+bool isValidKeyHashData(const Data& values) {
+    const auto bits = values.size() * 5;
+    const auto size = bits / 8;
+    const auto padding = bits % 8;
+    if (size < 2 || size > 40 || padding >= 5) {
+        return false;
+    }
+    return (values.back() & ((1 << padding) - 1)) == 0;
+}
+
+} // namespace
+
 bool Bech32Address::isValid(const std::string& addr) {
     return isValid(addr, "");
 }
@@ -34,6 +49,17 @@ bool Bech32Address::isValid(const std::string& addr, const std::string& hrp) {
     return true;
 }
 
+std::vector<bool> Bech32Address::isValid(const std::vector<std::string>& addrs, const std::string& hrp) {
+    const auto verifier = Bech32::Verifier(hrp);
+    std::vector<bool> result;
+    result.reserve(addrs.size());
+    Data values;
+    for (const auto& addr : addrs) {
+        result.push_back(verifier.verify(addr, &values) != Bech32::None && isValidKeyHashData(values));
+    }
+    return result;
+}
+
 bool Bech32Address::decode(const std::string& addr, Bech32Address& obj_out, const std::string& hrp) {
     auto dec = Bech32::decode(addr);
     // check hrp prefix (if given)
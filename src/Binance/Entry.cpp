@@ -20,10 +20,14 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
 
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
 string Entry::signJSON(TWCoinType coin, const std::string& json, const Data& key) const { 
     return Signer::signJSON(json, key);
 }
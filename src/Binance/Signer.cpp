@@ -9,11 +9,16 @@
 #include "../Hash.h"
 #include "../HexCoding.h"
 #include "../PrivateKey.h"
+#include "../ThreadPool.h"
 
 #include <google/protobuf/io/coded_stream.h>
-#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <google/protobuf/util/json_util.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
+#include <optional>
 #include <string>
 
 using namespace TW;
@@ -21,174 +26,224 @@ using namespace TW::Binance;
 
 // Message prefixes
 // see https://docs.binance.org/api-reference/transactions.html#amino-types
-static const auto sendOrderPrefix = Data{0x2A, 0x2C, 0x87, 0xFA};
-static const auto tradeOrderPrefix = Data{0xCE, 0x6D, 0xC0, 0x43};
-static const auto cancelTradeOrderPrefix = Data{0x16, 0x6E, 0x68, 0x1B};
-static const auto HTLTOrderPrefix = Data{0xB3, 0x3F, 0x9A, 0x24};
-static const auto depositHTLTOrderPrefix = Data{0x63, 0x98, 0x64, 0x96};
-static const auto claimHTLTOrderPrefix = Data{0xC1, 0x66, 0x53, 0x00};
-static const auto refundHTLTOrderPrefix = Data{0x34, 0x54, 0xA2, 0x7C};
-static const auto pubKeyPrefix = Data{0xEB, 0x5A, 0xE9, 0x87};
-static const auto transactionPrefix = Data{0xF0, 0x62, 0x5D, 0xEE};
-static const auto tokenIssueOrderPrefix = Data{0x17, 0xEF, 0xAB, 0x80};
-static const auto tokenMintOrderPrefix = Data{0x46, 0x7E, 0x08, 0x29};
-static const auto tokenBurnOrderPrefix = Data{0x7E, 0xD2, 0xD2, 0xA0};
-static const auto tokenFreezeOrderPrefix = Data{0xE7, 0x74, 0xB3, 0x2D};
-static const auto tokenUnfreezeOrderPrefix = Data{0x65, 0x15, 0xFF, 0x0D};
-static const auto transferOutOrderPrefix = Data{0x80, 0x08, 0x19, 0xC0};
-static const auto sideDelegateOrderPrefix = Data{0xE3, 0xA0, 0x7F, 0xD2};
-static const auto sideRedelegateOrderPrefix = Data{0xE3, 0xCE, 0xD3, 0x64};
-static const auto sideUndelegateOrderPrefix = Data{0x51, 0x4F, 0x7E, 0x0E};
-static const auto timeLockOrderPrefix = Data{0x07, 0x92, 0x15, 0x31};
-static const auto timeRelockOrderPrefix = Data{0x50, 0x47, 0x11, 0xDA};
-static const auto timeUnlockOrderPrefix = Data{0xC4, 0x05, 0x0C, 0x6C};
-
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto signer = Signer(input);
-    auto encoded = signer.build();
-    auto output = Proto::SigningOutput();
-    output.set_encoded(encoded.data(), encoded.size());
-    return output;
-}
-
-std::string Signer::signJSON(const std::string& json, const Data& key) {
-    auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
-    input.set_private_key(key.data(), key.size());
-    auto output = Signer::sign(input);
-    return hex(output.encoded());
-}
-
-Data Signer::build() const {
-    auto signature = encodeSignature(sign());
-    return encodeTransaction(signature);
-}
-
-Data Signer::sign() const {
-    auto key = PrivateKey(input.private_key());
-    auto hash = Hash::sha256(signaturePreimage());
-    auto signature = key.sign(hash, TWCurveSECP256k1);
-    return Data(signature.begin(), signature.end() - 1);
-}
-
-std::string Signer::signaturePreimage() const {
-    auto json = signatureJSON(input);
-    return json.dump();
-}
-
-Data Signer::encodeTransaction(const Data& signature) const {
-    auto msg = encodeOrder();
-    auto transaction = Binance::Proto::Transaction();
-    transaction.add_msgs(msg.data(), msg.size());
-    transaction.add_signatures(signature.data(), signature.size());
-    transaction.set_memo(input.memo());
-    transaction.set_source(input.source());
-
-    auto data = transaction.SerializeAsString();
-    return aminoWrap(data, transactionPrefix, true);
-}
-
-Data Signer::encodeOrder() const {
-    std::string data;
-    Data prefix;
+using AminoPrefix = std::array<byte, 4>;
+static constexpr AminoPrefix sendOrderPrefix{{0x2A, 0x2C, 0x87, 0xFA}};
+static constexpr AminoPrefix tradeOrderPrefix{{0xCE, 0x6D, 0xC0, 0x43}};
+static constexpr AminoPrefix cancelTradeOrderPrefix{{0x16, 0x6E, 0x68, 0x1B}};
+static constexpr AminoPrefix HTLTOrderPrefix{{0xB3, 0x3F, 0x9A, 0x24}};
+static constexpr AminoPrefix depositHTLTOrderPrefix{{0x63, 0x98, 0x64, 0x96}};
+static constexpr AminoPrefix claimHTLTOrderPrefix{{0xC1, 0x66, 0x53, 0x00}};
+static constexpr AminoPrefix refundHTLTOrderPrefix{{0x34, 0x54, 0xA2, 0x7C}};
+static constexpr AminoPrefix pubKeyPrefix{{0xEB, 0x5A, 0xE9, 0x87}};
+static constexpr AminoPrefix transactionPrefix{{0xF0, 0x62, 0x5D, 0xEE}};
+static constexpr AminoPrefix tokenIssueOrderPrefix{{0x17, 0xEF, 0xAB, 0x80}};
+static constexpr AminoPrefix tokenMintOrderPrefix{{0x46, 0x7E, 0x08, 0x29}};
+static constexpr AminoPrefix tokenBurnOrderPrefix{{0x7E, 0xD2, 0xD2, 0xA0}};
+static constexpr AminoPrefix tokenFreezeOrderPrefix{{0xE7, 0x74, 0xB3, 0x2D}};
+static constexpr AminoPrefix tokenUnfreezeOrderPrefix{{0x65, 0x15, 0xFF, 0x0D}};
+static constexpr AminoPrefix transferOutOrderPrefix{{0x80, 0x08, 0x19, 0xC0}};
+static constexpr AminoPrefix sideDelegateOrderPrefix{{0xE3, 0xA0, 0x7F, 0xD2}};
+static constexpr AminoPrefix sideRedelegateOrderPrefix{{0xE3, 0xCE, 0xD3, 0x64}};
+static constexpr AminoPrefix sideUndelegateOrderPrefix{{0x51, 0x4F, 0x7E, 0x0E}};
+static constexpr AminoPrefix timeLockOrderPrefix{{0x07, 0x92, 0x15, 0x31}};
+static constexpr AminoPrefix timeRelockOrderPrefix{{0x50, 0x47, 0x11, 0xDA}};
+static constexpr AminoPrefix timeUnlockOrderPrefix{{0xC4, 0x05, 0x0C, 0x6C}};
+
+/// Order message of the input and its amino prefix, or a null message if there is none.
+static std::pair<const google::protobuf::MessageLite*, const AminoPrefix*> order(const Proto::SigningInput& input) {
     if (input.has_trade_order()) {
-        data = input.trade_order().SerializeAsString();
-        prefix = tradeOrderPrefix;
+        return {&input.trade_order(), &tradeOrderPrefix};
     } else if (input.has_cancel_trade_order()) {
-        data = input.cancel_trade_order().SerializeAsString();
-        prefix = cancelTradeOrderPrefix;
+        return {&input.cancel_trade_order(), &cancelTradeOrderPrefix};
     } else if (input.has_send_order()) {
-        data = input.send_order().SerializeAsString();
-        prefix = sendOrderPrefix;
+        return {&input.send_order(), &sendOrderPrefix};
     } else if (input.has_issue_order()) {
-        data = input.issue_order().SerializeAsString();
-        prefix = tokenIssueOrderPrefix;
+        return {&input.issue_order(), &tokenIssueOrderPrefix};
     } else if (input.has_mint_order()) {
-        data = input.mint_order().SerializeAsString();
-        prefix = tokenMintOrderPrefix;
+        return {&input.mint_order(), &tokenMintOrderPrefix};
     } else if (input.has_burn_order()) {
-        data = input.burn_order().SerializeAsString();
-        prefix = tokenBurnOrderPrefix;
+        return {&input.burn_order(), &tokenBurnOrderPrefix};
     } else if (input.has_freeze_order()) {
-        data = input.freeze_order().SerializeAsString();
-        prefix = tokenFreezeOrderPrefix;
+        return {&input.freeze_order(), &tokenFreezeOrderPrefix};
     } else if (input.has_unfreeze_order()) {
-        data = input.unfreeze_order().SerializeAsString();
-        prefix = tokenUnfreezeOrderPrefix;
+        return {&input.unfreeze_order(), &tokenUnfreezeOrderPrefix};
     } else if (input.has_htlt_order()) {
-        data = input.htlt_order().SerializeAsString();
-        prefix = HTLTOrderPrefix;
+        return {&input.htlt_order(), &HTLTOrderPrefix};
     } else if (input.has_deposithtlt_order()) {
-        data = input.deposithtlt_order().SerializeAsString();
-        prefix = depositHTLTOrderPrefix;
+        return {&input.deposithtlt_order(), &depositHTLTOrderPrefix};
     } else if (input.has_claimhtlt_order()) {
-        data = input.claimhtlt_order().SerializeAsString();
-        prefix = claimHTLTOrderPrefix;
+        return {&input.claimhtlt_order(), &claimHTLTOrderPrefix};
     } else if (input.has_refundhtlt_order()) {
-        data = input.refundhtlt_order().SerializeAsString();
-        prefix = refundHTLTOrderPrefix;
+        return {&input.refundhtlt_order(), &refundHTLTOrderPrefix};
     } else if (input.has_transfer_out_order()) {
-        data = input.transfer_out_order().SerializeAsString();
-        prefix = transferOutOrderPrefix;
+        return {&input.transfer_out_order(), &transferOutOrderPrefix};
     } else if (input.has_side_delegate_order()) {
-        data = input.side_delegate_order().SerializeAsString();
-        prefix = sideDelegateOrderPrefix;
+        return {&input.side_delegate_order(), &sideDelegateOrderPrefix};
     } else if (input.has_side_redelegate_order()) {
-        data = input.side_redelegate_order().SerializeAsString();
-        prefix = sideRedelegateOrderPrefix;
+        return {&input.side_redelegate_order(), &sideRedelegateOrderPrefix};
     } else if (input.has_side_undelegate_order()) {
-        data = input.side_undelegate_order().SerializeAsString();
-        prefix = sideUndelegateOrderPrefix;
+        return {&input.side_undelegate_order(), &sideUndelegateOrderPrefix};
     } else if (input.has_time_lock_order()) {
-        data = input.time_lock_order().SerializeAsString();
-        prefix = timeLockOrderPrefix;
+        return {&input.time_lock_order(), &timeLockOrderPrefix};
     } else if (input.has_time_relock_order()) {
-        data = input.time_relock_order().SerializeAsString();
-        prefix = timeRelockOrderPrefix;
+        return {&input.time_relock_order(), &timeRelockOrderPrefix};
     } else if (input.has_time_unlock_order()) {
-        data = input.time_unlock_order().SerializeAsString();
-        prefix = timeUnlockOrderPrefix;
-    } else {
-        return {};
+        return {&input.time_unlock_order(), &timeUnlockOrderPrefix};
     }
-    return aminoWrap(data, prefix, false);
+    return {nullptr, nullptr};
 }
 
-Data Signer::encodeSignature(const Data& signature) const {
-    auto key = PrivateKey(input.private_key());
-    auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+namespace {
 
-    auto encodedPublicKey = pubKeyPrefix;
-    encodedPublicKey.insert(encodedPublicKey.end(), static_cast<uint8_t>(publicKey.bytes.size()));
-    encodedPublicKey.insert(encodedPublicKey.end(), publicKey.bytes.begin(), publicKey.bytes.end());
+using google::protobuf::io::CodedOutputStream;
 
-    auto object = Binance::Proto::Signature();
-    object.set_pub_key(encodedPublicKey.data(), encodedPublicKey.size());
-    object.set_signature(signature.data(), signature.size());
-    object.set_account_number(input.account_number());
-    object.set_sequence(input.sequence());
+/// Protobuf field writer into a buffer of precomputed size.
+class AminoWriter {
+  public:
+    explicit AminoWriter(byte* output) : output(output) {}
 
-    return aminoWrap(object.SerializeAsString(), {}, false);
-}
+    /// Size of a length-delimited field.
+    static size_t bytesFieldSize(size_t size) { return 1 + CodedOutputStream::VarintSize64(size) + size; }
+
+    /// Size of a varint field, omitted if 0.
+    static size_t varintFieldSize(int64_t value) {
+        return value == 0 ? 0 : 1 + CodedOutputStream::VarintSize64(static_cast<uint64_t>(value));
+    }
+
+    void varint(uint64_t value) { output = CodedOutputStream::WriteVarint64ToArray(value, output); }
+
+    void raw(const byte* data, size_t size) { output = std::copy(data, data + size, output); }
+
+    /// Writes the header of a length-delimited field.
+    void bytesHeader(uint32_t field, size_t size) {
+        output = CodedOutputStream::WriteTagToArray(field << 3 | 2, output);
+        varint(size);
+    }
 
-Data Signer::aminoWrap(const std::string& raw, const Data& typePrefix, bool prefixWithSize) const {
-    const auto contentsSize = raw.size() + typePrefix.size();
-    auto size = contentsSize;
-    if (prefixWithSize) {
-        size += 10;
+    void bytesField(uint32_t field, const byte* data, size_t size) {
+        bytesHeader(field, size);
+        raw(data, size);
     }
 
-    std::string msg;
-    msg.reserve(size);
-    {
-        google::protobuf::io::StringOutputStream output(&msg);
-        google::protobuf::io::CodedOutputStream cos(&output);
-        if (prefixWithSize) {
-            cos.WriteVarint64(contentsSize);
+    void varintField(uint32_t field, int64_t value) {
+        if (value != 0) {
+            output = CodedOutputStream::WriteTagToArray(field << 3, output);
+            varint(static_cast<uint64_t>(value));
         }
-        cos.WriteRaw(typePrefix.data(), static_cast<int>(typePrefix.size()));
-        cos.WriteRaw(raw.data(), static_cast<int>(raw.size()));
     }
 
-    return Data(msg.begin(), msg.end());
+    /// Writes a message, after its size was computed with ByteSizeLong().
+    void message(const google::protobuf::MessageLite& message) {
+        output = message.SerializeWithCachedSizesToArray(output);
+    }
+
+    byte* output;
+};
+
+} // namespace
+
+/// Signs the sign doc of the input, returns the signature without recovery id.
+static Data signPreimage(const Proto::SigningInput& input, const PrivateKey& key) {
+    auto hash = Hash::sha256(signatureJSON(input).dump());
+    auto signature = key.sign(hash, TWCurveSECP256k1);
+    return Data(signature.begin(), signature.end() - 1);
+}
+
+/// Amino-encodes the signed transaction in one pass: all nested sizes are computed first.
+static Data encodeTransaction(const Proto::SigningInput& input, const PublicKey& publicKey, const Data& signature) {
+    const auto [orderMessage, orderPrefix] = order(input);
+    const auto orderSize = orderMessage == nullptr ? 0 : orderPrefix->size() + orderMessage->ByteSizeLong();
+
+    const auto publicKeySize = pubKeyPrefix.size() + 1 + publicKey.bytes.size();
+    const auto signatureSize = AminoWriter::bytesFieldSize(publicKeySize) +
+                               AminoWriter::bytesFieldSize(signature.size()) +
+                               AminoWriter::varintFieldSize(input.account_number()) +
+                               AminoWriter::varintFieldSize(input.sequence());
+    const auto transactionSize = AminoWriter::bytesFieldSize(orderSize) +
+                                 AminoWriter::bytesFieldSize(signatureSize) +
+                                 (input.memo().empty() ? 0 : AminoWriter::bytesFieldSize(input.memo().size())) +
+                                 AminoWriter::varintFieldSize(input.source());
+    const auto contentsSize = transactionPrefix.size() + transactionSize;
+
+    Data encoded(CodedOutputStream::VarintSize64(contentsSize) + contentsSize);
+    auto writer = AminoWriter(encoded.data());
+    writer.varint(contentsSize);
+    writer.raw(transactionPrefix.data(), transactionPrefix.size());
+
+    // msgs
+    writer.bytesHeader(1, orderSize);
+    if (orderMessage != nullptr) {
+        writer.raw(orderPrefix->data(), orderPrefix->size());
+        writer.message(*orderMessage);
+    }
+
+    // signatures
+    writer.bytesHeader(2, signatureSize);
+    writer.bytesHeader(1, publicKeySize);
+    writer.raw(pubKeyPrefix.data(), pubKeyPrefix.size());
+    writer.varint(publicKey.bytes.size());
+    writer.raw(publicKey.bytes.data(), publicKey.bytes.size());
+    writer.bytesField(2, signature.data(), signature.size());
+    writer.varintField(3, input.account_number());
+    writer.varintField(4, input.sequence());
+
+    if (!input.memo().empty()) {
+        writer.bytesField(3, reinterpret_cast<const byte*>(input.memo().data()), input.memo().size());
+    }
+    writer.varintField(4, input.source());
+
+    assert(writer.output == encoded.data() + encoded.size());
+    return encoded;
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto signer = Signer(input);
+    auto encoded = signer.build();
+    auto output = Proto::SigningOutput();
+    output.set_encoded(encoded.data(), encoded.size());
+    return output;
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    std::vector<Proto::SigningOutput> outputs(inputs.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        // consecutive inputs usually share the key, derive its public key once
+        std::optional<PrivateKey> key;
+        std::optional<PublicKey> publicKey;
+        for (auto index = next++; index < inputs.size(); index = next++) {
+            const auto& input = inputs[index];
+            try {
+                if (!key || key->bytes != data(input.private_key())) {
+                    key.emplace(data(input.private_key()));
+                    publicKey.emplace(key->getPublicKey(TWPublicKeyTypeSECP256k1));
+                }
+                const auto encoded = encodeTransaction(input, *publicKey, signPreimage(input, *key));
+                outputs[index].set_encoded(encoded.data(), encoded.size());
+            } catch (const std::exception& e) {
+                // leave the output empty
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, inputs.size(), worker);
+    return outputs;
+}
+
+std::string Signer::signJSON(const std::string& json, const Data& key) {
+    auto input = Proto::SigningInput();
+    google::protobuf::util::JsonStringToMessage(json, &input);
+    input.set_private_key(key.data(), key.size());
+    auto output = Signer::sign(input);
+    return hex(output.encoded());
+}
+
+Data Signer::build() const {
+    auto key = PrivateKey(input.private_key());
+    auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    return encodeTransaction(input, publicKey, signPreimage(input, key));
+}
+
+Data Signer::sign() const {
+    return signPreimage(input, PrivateKey(input.private_key()));
 }
@@ -10,6 +10,8 @@
 #include "../proto/Binance.pb.h"
 
 #include <cstdint>
+#include <string>
+#include <vector>
 
 namespace TW::Binance {
 
@@ -20,6 +22,10 @@ class Signer {
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
+
+    /// Signs many transactions, as `sign` does. Inputs that fail to sign produce an empty output.
+    /// threadCount 0 uses the available hardware concurrency.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
   public:
     Proto::SigningInput input;
 
@@ -37,14 +43,6 @@ class Signer {
     /// \returns the transaction signature or an empty vector if there is an
     /// error.
     TW::Data sign() const;
-
-  private:
-    std::string signaturePreimage() const;
-    TW::Data encodeTransaction(const TW::Data& signature) const;
-    TW::Data encodeOrder() const;
-    TW::Data encodeSignature(const TW::Data& signature) const;
-    TW::Data aminoWrap(const std::string& raw, const TW::Data& typePrefix,
-                       bool isPrefixLength) const;
 };
 
 } // namespace TW::Binance
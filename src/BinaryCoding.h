@@ -88,6 +88,14 @@ inline void encode32BE(uint32_t val, std::vector<uint8_t>& data) {
     data.push_back(static_cast<uint8_t>(val));
 }
 
+/// Encodes a 32-bit big-endian value into the 4 bytes at `dst`.
+inline void encode32BE(uint32_t val, uint8_t* _Nonnull dst) {
+    dst[0] = static_cast<uint8_t>((val >> 24));
+    dst[1] = static_cast<uint8_t>((val >> 16));
+    dst[2] = static_cast<uint8_t>((val >> 8));
+    dst[3] = static_cast<uint8_t>(val);
+}
+
 /// Decodes a 32-bit big-endian value from the provided buffer.
 inline uint32_t decode32BE(const uint8_t* _Nonnull src) {
     // clang-format off
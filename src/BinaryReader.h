@@ -0,0 +1,102 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "BinaryCoding.h"
+#include "Data.h"
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+namespace TW {
+
+/// Cursor over borrowed bytes, for reading binary encodings field by field without copies.
+///
+/// Reads are bounds-checked and advance the position; byte strings are returned as views into
+/// the source, which must outlive them.
+///
+/// @throws std::invalid_argument when reading past the end, the position is then unchanged.
+class BinaryReader {
+  public:
+    explicit BinaryReader(DataView data, size_t position = 0) : data(data), offset(position) {
+        if (position > data.size()) {
+            throw std::invalid_argument("BinaryReader: position past the end");
+        }
+    }
+
+    /// Number of bytes read from the start of the data.
+    size_t position() const { return offset; }
+
+    /// Number of bytes left to read.
+    size_t remaining() const { return data.size() - offset; }
+
+    /// Returns a view of the next `count` bytes.
+    DataView readBytes(size_t count) {
+        require(count);
+        const auto bytes = data.subView(offset, count);
+        offset += count;
+        return bytes;
+    }
+
+    /// Returns a view of the bytes left.
+    DataView readRemaining() { return readBytes(remaining()); }
+
+    byte readByte() { return readBytes(1)[0]; }
+    uint16_t read16LE() { return decode16LE(readBytes(2).data()); }
+    uint32_t read32LE() { return decode32LE(readBytes(4).data()); }
+    uint64_t read64LE() { return decode64LE(readBytes(8).data()); }
+
+    /// Reads a variable-length integer, as written by encodeVarInt().
+    ///
+    /// @throws std::invalid_argument if the value is larger than `max`.
+    uint64_t readVarInt(uint64_t max = std::numeric_limits<uint64_t>::max()) {
+        const auto start = offset;
+        const auto prefix = readByte();
+        uint64_t value = prefix;
+        try {
+            if (prefix == 0xFD) {
+                value = read16LE();
+            } else if (prefix == 0xFE) {
+                value = read32LE();
+            } else if (prefix == 0xFF) {
+                value = read64LE();
+            }
+        } catch (const std::invalid_argument&) {
+            offset = start;
+            throw;
+        }
+        if (value > max) {
+            offset = start;
+            throw std::invalid_argument("BinaryReader: variable-length integer too large");
+        }
+        return value;
+    }
+
+    /// Reads a byte string prefixed by its variable-length size.
+    DataView readVarBytes(uint64_t maxSize = std::numeric_limits<uint64_t>::max()) {
+        const auto start = offset;
+        const auto size = readVarInt(maxSize);
+        if (size > remaining()) {
+            offset = start;
+            throw std::invalid_argument("BinaryReader: not enough bytes");
+        }
+        return readBytes(static_cast<size_t>(size));
+    }
+
+  private:
+    DataView data;
+    size_t offset;
+
+    void require(size_t count) const {
+        if (count > remaining()) {
+            throw std::invalid_argument("BinaryReader: not enough bytes");
+        }
+    }
+};
+
+} // namespace TW
@@ -0,0 +1,253 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bip340.h"
+
+#include "Hash.h"
+#include "ThreadPool.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+using Bytes32 = std::array<byte, 32>;
+
+const ecdsa_curve& curve = secp256k1;
+
+/// Reads a 32-byte big-endian number, returns false if it is not below `limit`.
+bool readNumber(DataView bytes, const bignum256& limit, bignum256& number) {
+    if (bytes.size() != 32) {
+        return false;
+    }
+    bn_read_be(bytes.data(), &number);
+    return bn_is_less(&number, &limit) != 0;
+}
+
+/// Reads a private key as a non-zero scalar.
+bool readPrivateKey(const PrivateKey& privateKey, bignum256& scalar) {
+    return readNumber(privateKey.bytes, curve.order, scalar) && bn_is_zero(&scalar) == 0;
+}
+
+/// Returns the point with the x coordinate and an even y (lift_x).
+bool liftX(DataView x, curve_point& point) {
+    if (!readNumber(x, curve.prime, point.x)) {
+        return false;
+    }
+    uncompress_coords(&curve, 0, &point.x, &point.y);
+    return ecdsa_validate_pubkey(&curve, &point) == 1;
+}
+
+/// Multiplies G by a scalar read from a hash, reduced modulo the order.
+void reduce(const Bytes32& hash, bignum256& scalar) {
+    bn_read_be(hash.data(), &scalar);
+    bn_mod(&scalar, &curve.order);
+}
+
+Bytes32 writeNumber(const bignum256& number) {
+    Bytes32 bytes;
+    bn_write_be(&number, bytes.data());
+    return bytes;
+}
+
+/// Computes the public key point of a private key scalar, and negates the scalar if the point has an odd y.
+curve_point evenPublicKey(bignum256& scalar) {
+    curve_point point;
+    scalar_multiply(&curve, &scalar, &point);
+    if (bn_is_odd(&point.y)) {
+        bn_subtract(&curve.order, &scalar, &scalar);
+    }
+    return point;
+}
+
+Bytes32 challenge(const Bytes32& r, DataView publicKey, DataView message) {
+    return Bip340::taggedHasher(Bip340::Tag::challenge).update(r).update(publicKey).update(message).final();
+}
+
+} // namespace
+
+Hash::Sha256Hasher Bip340::taggedHasher(const std::string& tag) {
+    const auto tagHash = Hash::sha256(tag);
+    auto hasher = Hash::Sha256Hasher();
+    hasher.update(tagHash).update(tagHash);
+    return hasher;
+}
+
+Hash::Sha256Hasher Bip340::taggedHasher(Tag tag) {
+    static const Hash::Sha256Hasher midstates[] = {
+        taggedHasher("BIP0340/aux"),
+        taggedHasher("BIP0340/nonce"),
+        taggedHasher("BIP0340/challenge"),
+        taggedHasher("TapLeaf"),
+        taggedHasher("TapBranch"),
+        taggedHasher("TapTweak"),
+        taggedHasher("TapSighash"),
+    };
+    return midstates[static_cast<size_t>(tag)];
+}
+
+Data Bip340::xOnlyPublicKey(const PrivateKey& privateKey) {
+    const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
+    return Data(publicKey.bytes.begin() + 1, publicKey.bytes.end());
+}
+
+Data Bip340::sign(const PrivateKey& privateKey, DataView message, DataView auxRand) {
+    bignum256 d;
+    if (auxRand.size() != 32 || !readPrivateKey(privateKey, d)) {
+        return {};
+    }
+    const auto publicKey = evenPublicKey(d);
+    const auto px = writeNumber(publicKey.x);
+
+    auto t = writeNumber(d);
+    const auto auxHash = taggedHasher(Tag::aux).update(auxRand).final();
+    for (size_t i = 0; i < t.size(); ++i) {
+        t[i] ^= auxHash[i];
+    }
+    bignum256 k;
+    reduce(taggedHasher(Tag::nonce).update(t).update(px).update(message).final(), k);
+    memzero(t.data(), t.size());
+    if (bn_is_zero(&k)) {
+        memzero(&d, sizeof(d));
+        return {};
+    }
+    const auto nonce = evenPublicKey(k);
+    const auto rx = writeNumber(nonce.x);
+
+    // s = k + e * d
+    bignum256 s;
+    reduce(challenge(rx, px, message), s);
+    bn_multiply(&d, &s, &curve.order);
+    bn_mod(&s, &curve.order);
+    bn_addmod(&s, &k, &curve.order);
+    bn_mod(&s, &curve.order);
+    memzero(&d, sizeof(d));
+    memzero(&k, sizeof(k));
+
+    auto signature = Data(rx.begin(), rx.end());
+    append(signature, writeNumber(s));
+    // Checked as recommended by BIP340, against faults
+    if (!verify(px, message, signature)) {
+        return {};
+    }
+    return signature;
+}
+
+bool Bip340::verify(DataView publicKey, DataView message, DataView signature) {
+    curve_point point;
+    bignum256 r;
+    bignum256 s;
+    if (signature.size() != 64 || !liftX(publicKey, point) ||
+        !readNumber(signature.subView(0, 32), curve.prime, r) || !readNumber(signature.subView(32, 32), curve.order, s)) {
+        return false;
+    }
+    Bytes32 rBytes;
+    std::copy(signature.begin(), signature.begin() + 32, rBytes.begin());
+    bignum256 e;
+    reduce(challenge(rBytes, publicKey, message), e);
+
+    // R = s * G - e * P
+    curve_point nonce;
+    point_set_infinity(&nonce);
+    if (!bn_is_zero(&s)) {
+        scalar_multiply(&curve, &s, &nonce);
+    }
+    if (!bn_is_zero(&e)) {
+        bn_subtract(&curve.order, &e, &e);
+        curve_point product;
+        point_multiply(&curve, &e, &point, &product);
+        point_add(&curve, &product, &nonce);
+    }
+    if (point_is_infinity(&nonce)) {
+        return false;
+    }
+    bn_mod(&nonce.x, &curve.prime);
+    bn_mod(&nonce.y, &curve.prime);
+    return bn_is_even(&nonce.y) && bn_is_equal(&nonce.x, &r);
+}
+
+bool Bip340::verifyBatch(const std::vector<Data>& publicKeys, const std::vector<Data>& messages, const std::vector<Data>& signatures,
+                         std::vector<bool>& valid, size_t threadCount) {
+    if (messages.size() != publicKeys.size() || signatures.size() != publicKeys.size()) {
+        throw std::invalid_argument("Batch inputs have different sizes");
+    }
+    const auto count = publicKeys.size();
+    // Not vector<bool>, whose elements can't be written from different threads
+    std::vector<char> results(count, 0);
+    std::atomic<size_t> next(0);
+    const auto worker = [&]() {
+        for (auto index = next++; index < count; index = next++) {
+            results[index] = verify(publicKeys[index], messages[index], signatures[index]) ? 1 : 0;
+        }
+    };
+    ThreadPool::shared().run(threadCount, count, worker);
+
+    valid.assign(results.begin(), results.end());
+    return std::find(results.begin(), results.end(), 0) == results.end();
+}
+
+Data Bip340::tweakPublicKey(DataView publicKey, DataView tweak, bool& oddY) {
+    curve_point point;
+    bignum256 t;
+    if (!liftX(publicKey, point) || !readNumber(tweak, curve.order, t)) {
+        return {};
+    }
+    curve_point tweaked;
+    point_set_infinity(&tweaked);
+    if (!bn_is_zero(&t)) {
+        scalar_multiply(&curve, &t, &tweaked);
+    }
+    point_add(&curve, &point, &tweaked);
+    if (point_is_infinity(&tweaked)) {
+        return {};
+    }
+    bn_mod(&tweaked.x, &curve.prime);
+    bn_mod(&tweaked.y, &curve.prime);
+    oddY = bn_is_odd(&tweaked.y);
+    const auto x = writeNumber(tweaked.x);
+    return Data(x.begin(), x.end());
+}
+
+Data Bip340::tweakPrivateKey(const PrivateKey& privateKey, DataView tweak) {
+    bignum256 d;
+    bignum256 t;
+    if (!readPrivateKey(privateKey, d) || !readNumber(tweak, curve.order, t)) {
+        return {};
+    }
+    evenPublicKey(d);
+    bn_addmod(&d, &t, &curve.order);
+    bn_mod(&d, &curve.order);
+    auto bytes = writeNumber(d);
+    memzero(&d, sizeof(d));
+    if (std::all_of(bytes.begin(), bytes.end(), [](byte b) { return b == 0; })) {
+        return {};
+    }
+    auto result = Data(bytes.begin(), bytes.end());
+    memzero(bytes.data(), bytes.size());
+    return result;
+}
+
+Data Bip340::taprootTweak(DataView internalKey, DataView merkleRoot) {
+    const auto tweak = taggedHasher(Tag::tapTweak).update(internalKey).update(merkleRoot).final();
+    return Data(tweak.begin(), tweak.end());
+}
+
+Data Bip340::taprootOutputKey(DataView internalKey, DataView merkleRoot) {
+    bool oddY;
+    return tweakPublicKey(internalKey, taprootTweak(internalKey, merkleRoot), oddY);
+}
+
+Data Bip340::taprootPrivateKey(const PrivateKey& privateKey, DataView merkleRoot) {
+    return tweakPrivateKey(privateKey, taprootTweak(xOnlyPublicKey(privateKey), merkleRoot));
+}
@@ -0,0 +1,76 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "Hashers.h"
+#include "PrivateKey.h"
+
+#include <string>
+#include <vector>
+
+/// BIP340 Schnorr signatures over secp256k1, with 32-byte x-only public keys.
+///
+/// Not to be confused with `PrivateKey::signSchnorr`, the older Schnorr variant used by Zilliqa and Bitcoin Cash.
+namespace TW::Bip340 {
+
+/// Tags of the BIP340 and BIP341 tagged hashes.
+enum class Tag {
+    aux,
+    nonce,
+    challenge,
+    tapLeaf,
+    tapBranch,
+    tapTweak,
+    tapSighash,
+};
+
+/// Returns a hasher for the tagged hash `sha256(sha256(tag) || sha256(tag) || data)`, with the tag prefix
+/// already hashed.  The midstates of the known tags are computed once.
+Hash::Sha256Hasher taggedHasher(Tag tag);
+Hash::Sha256Hasher taggedHasher(const std::string& tag);
+
+/// Returns the x-only public key of a private key.
+Data xOnlyPublicKey(const PrivateKey& privateKey);
+
+/// Signs a message with the given 32 bytes of auxiliary randomness.
+///
+/// \returns the 64-byte signature, or empty data if the key is invalid.
+Data sign(const PrivateKey& privateKey, DataView message, DataView auxRand);
+
+/// Verifies a signature with an x-only public key.
+bool verify(DataView publicKey, DataView message, DataView signature);
+
+/// Verifies many signatures on several threads (threadCount 0 uses the available hardware concurrency),
+/// storing in `valid` whether each of them is valid.
+///
+/// \returns whether all signatures are valid.
+/// @throws std::invalid_argument if the vectors have different sizes.
+bool verifyBatch(const std::vector<Data>& publicKeys, const std::vector<Data>& messages, const std::vector<Data>& signatures,
+                 std::vector<bool>& valid, size_t threadCount = 0);
+
+/// Adds `tweak * G` to the point with even y of an x-only public key.
+///
+/// \returns the x-only tweaked key, or empty data if the key or the tweak are invalid.  `oddY` is set to the parity of the tweaked point.
+Data tweakPublicKey(DataView publicKey, DataView tweak, bool& oddY);
+
+/// Adds a tweak to a private key, negated first if its public key has an odd y, so that the result matches `tweakPublicKey`.
+///
+/// \returns the tweaked 32-byte private key, or empty data if the key or the tweak are invalid.
+Data tweakPrivateKey(const PrivateKey& privateKey, DataView tweak);
+
+/// Returns the BIP341 tweak of an internal key, the `TapTweak` hash of the key and of the script tree's merkle root,
+/// if any.
+Data taprootTweak(DataView internalKey, DataView merkleRoot);
+
+/// Returns the x-only taproot output key of an internal key, or empty data if the key is invalid.
+Data taprootOutputKey(DataView internalKey, DataView merkleRoot);
+
+/// Returns the private key for key-path spending of the taproot output of a private key, or empty data if the key is invalid.
+Data taprootPrivateKey(const PrivateKey& privateKey, DataView merkleRoot);
+
+} // namespace TW::Bip340
@@ -0,0 +1,302 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BlockFilter.h"
+#include "OpCodes.h"
+#include "Reader.h"
+#include "ScriptCache.h"
+#include "../BinaryCoding.h"
+#include "../Hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+inline uint64_t rotateLeft(uint64_t x, int bits) {
+    return (x << bits) | (x >> (64 - bits));
+}
+
+inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+    v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);
+    v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;
+    v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;
+    v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);
+}
+
+/// SipHash-2-4 of `data`.
+uint64_t sipHash(uint64_t k0, uint64_t k1, DataView data) {
+    uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ k1;
+    const auto* bytes = data.data();
+    const auto size = data.size();
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        const auto word = decode64LE(bytes + i);
+        v3 ^= word;
+        sipRound(v0, v1, v2, v3);
+        sipRound(v0, v1, v2, v3);
+        v0 ^= word;
+    }
+    // the last bytes, and the size in the top byte
+    uint64_t last = static_cast<uint64_t>(size) << 56;
+    for (std::size_t j = 0; i + j < size; ++j) {
+        last |= static_cast<uint64_t>(bytes[i + j]) << (8 * j);
+    }
+    v3 ^= last;
+    sipRound(v0, v1, v2, v3);
+    sipRound(v0, v1, v2, v3);
+    v0 ^= last;
+    v2 ^= 0xff;
+    for (int round = 0; round < 4; ++round) {
+        sipRound(v0, v1, v2, v3);
+    }
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+/// Maps a 64-bit hash uniformly to [0, range).
+inline uint64_t reduce(uint64_t hash, uint64_t range) {
+    return static_cast<uint64_t>((static_cast<unsigned __int128>(hash) * range) >> 64);
+}
+
+/// Writes bits, most significant first.
+class BitWriter {
+  public:
+    explicit BitWriter(Data& out) : out(out) {}
+
+    /// Writes the `count` lower bits of `value`, up to 32.
+    void write(uint64_t value, int count) {
+        buffer = (buffer << count) | (value & ((uint64_t(1) << count) - 1));
+        bits += count;
+        while (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<byte>(buffer >> bits));
+        }
+        buffer &= (uint64_t(1) << bits) - 1;
+    }
+
+    /// Writes a Golomb-Rice coded value: the quotient in unary, then the remainder.
+    void writeGolomb(uint64_t value, uint8_t p) {
+        for (auto quotient = value >> p; quotient > 0;) {
+            const auto ones = static_cast<int>(std::min<uint64_t>(quotient, 32));
+            write(~uint64_t(0), ones);
+            quotient -= ones;
+        }
+        write(0, 1);
+        write(value, p);
+    }
+
+    void flush() {
+        if (bits > 0) {
+            out.push_back(static_cast<byte>(buffer << (8 - bits)));
+            bits = 0;
+            buffer = 0;
+        }
+    }
+
+  private:
+    Data& out;
+    uint64_t buffer = 0;
+    int bits = 0;
+};
+
+/// Reads the Golomb-Rice coded values written by BitWriter.
+class BitReader {
+  public:
+    BitReader(const byte* data, std::size_t size) : data(data), end(data + size) {}
+
+    /// Reads a value; false past the end of the data.
+    bool readGolomb(uint8_t p, uint64_t& value) {
+        uint64_t quotient = 0;
+        for (;;) {
+            int bit;
+            if (!readBit(bit)) {
+                return false;
+            }
+            if (bit == 0) {
+                break;
+            }
+            ++quotient;
+        }
+        uint64_t remainder = 0;
+        for (int i = 0; i < p; ++i) {
+            int bit;
+            if (!readBit(bit)) {
+                return false;
+            }
+            remainder = (remainder << 1) | static_cast<uint64_t>(bit);
+        }
+        value = (quotient << p) | remainder;
+        return true;
+    }
+
+  private:
+    const byte* data;
+    const byte* end;
+    int position = 0;
+
+    bool readBit(int& bit) {
+        if (data == end) {
+            return false;
+        }
+        bit = (*data >> (7 - position)) & 1;
+        if (++position == 8) {
+            position = 0;
+            ++data;
+        }
+        return true;
+    }
+};
+
+bool lessBytes(DataView a, DataView b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+
+bool equalBytes(DataView a, DataView b) {
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+}
+
+void readKey(DataView blockHash, uint64_t& k0, uint64_t& k1) {
+    if (blockHash.size() < 16) {
+        throw std::invalid_argument("Invalid block hash");
+    }
+    k0 = decode64LE(blockHash.data());
+    k1 = decode64LE(blockHash.data() + 8);
+}
+
+std::vector<DataView> scriptViews(const std::vector<Script>& scripts) {
+    std::vector<DataView> views;
+    views.reserve(scripts.size());
+    for (const auto& script : scripts) {
+        views.emplace_back(script.bytes);
+    }
+    return views;
+}
+
+} // namespace
+
+BlockFilter BlockFilter::basic(DataView blockHash, const std::vector<TransactionView>& transactions,
+                               const std::vector<DataView>& spentScripts) {
+    std::vector<DataView> elements;
+    for (const auto& transaction : transactions) {
+        for (const auto& output : transaction.outputs) {
+            if (!output.script.empty() && output.script[0] != OP_RETURN) {
+                elements.push_back(output.script);
+            }
+        }
+    }
+    for (const auto& script : spentScripts) {
+        if (!script.empty()) {
+            elements.push_back(script);
+        }
+    }
+    return BlockFilter(blockHash, elements);
+}
+
+BlockFilter::BlockFilter(DataView blockHash, const std::vector<DataView>& elements, uint8_t p, uint64_t m) : p(p), m(m) {
+    readKey(blockHash, k0, k1);
+    auto unique = elements;
+    std::sort(unique.begin(), unique.end(), lessBytes);
+    unique.erase(std::unique(unique.begin(), unique.end(), equalBytes), unique.end());
+    count = unique.size();
+
+    const auto range = count * m;
+    std::vector<uint64_t> values;
+    values.reserve(unique.size());
+    for (const auto& element : unique) {
+        values.push_back(reduce(sipHash(k0, k1, element), range));
+    }
+    std::sort(values.begin(), values.end());
+
+    encodeVarInt(count, filter);
+    dataOffset = filter.size();
+    BitWriter writer(filter);
+    uint64_t previous = 0;
+    for (const auto value : values) {
+        writer.writeGolomb(value - previous, p);
+        previous = value;
+    }
+    writer.flush();
+}
+
+BlockFilter::BlockFilter(DataView blockHash, Data encoded, uint8_t p, uint64_t m) : p(p), m(m), filter(std::move(encoded)) {
+    readKey(blockHash, k0, k1);
+    Reader reader(filter);
+    count = reader.varInt();
+    dataOffset = reader.offset();
+}
+
+std::vector<std::pair<uint64_t, std::size_t>> BlockFilter::hashElements(const std::vector<DataView>& elements) const {
+    const auto range = count * m;
+    std::vector<std::pair<uint64_t, std::size_t>> hashes;
+    hashes.reserve(elements.size());
+    for (std::size_t i = 0; i < elements.size(); ++i) {
+        hashes.emplace_back(reduce(sipHash(k0, k1, elements[i]), range), i);
+    }
+    std::sort(hashes.begin(), hashes.end());
+    return hashes;
+}
+
+std::vector<std::size_t> BlockFilter::matchSorted(const std::vector<std::pair<uint64_t, std::size_t>>& queries, bool first) const {
+    std::vector<std::size_t> result;
+    BitReader reader(filter.data() + dataOffset, filter.size() - dataOffset);
+    std::size_t query = 0;
+    uint64_t value = 0;
+    for (uint64_t i = 0; i < count && query < queries.size(); ++i) {
+        uint64_t delta;
+        if (!reader.readGolomb(p, delta)) {
+            break;
+        }
+        value += delta;
+        while (query < queries.size() && queries[query].first < value) {
+            ++query;
+        }
+        for (; query < queries.size() && queries[query].first == value; ++query) {
+            result.push_back(queries[query].second);
+            if (first) {
+                return result;
+            }
+        }
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+bool BlockFilter::match(DataView element) const {
+    return matchAny(std::vector<DataView>{element});
+}
+
+bool BlockFilter::matchAny(const std::vector<DataView>& elements) const {
+    return !matchSorted(hashElements(elements), true).empty();
+}
+
+bool BlockFilter::matchAny(const std::vector<Script>& scripts) const {
+    return matchAny(scriptViews(scripts));
+}
+
+std::vector<std::size_t> BlockFilter::matches(const std::vector<DataView>& elements) const {
+    return matchSorted(hashElements(elements), false);
+}
+
+std::vector<std::size_t> BlockFilter::matches(const std::vector<Script>& scripts) const {
+    return matches(scriptViews(scripts));
+}
+
+Data BlockFilter::header(const Data& previousHeader) const {
+    auto data = Hash::sha256d(filter.data(), filter.size());
+    append(data, previousHeader);
+    return Hash::sha256d(data.data(), data.size());
+}
+
+std::vector<Script> BlockFilter::scripts(const std::vector<std::string>& addresses, TWCoinType coin) {
+    return ScriptCache::shared().lockScripts(addresses, coin);
+}
@@ -0,0 +1,86 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Script.h"
+#include "TransactionView.h"
+#include "../Data.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// BIP158 compact block filter: the Golomb-Rice coded set of the scripts of a block, hashed with SipHash-2-4 keyed by
+/// the block hash, for light clients to find the blocks paying to or spending from their addresses without
+/// downloading all of them. False positives happen at a rate of 1/M, there are no false negatives.
+class BlockFilter {
+  public:
+    /// Parameters of the basic filter type.
+    static constexpr uint8_t basicP = 19;
+    static constexpr uint64_t basicM = 784931;
+
+    /// Builds the basic filter of a block, from the output scripts of its transactions, except empty and OP_RETURN
+    /// ones, and the scripts of the outputs they spend, which aren't in the block: the caller provides them, except
+    /// for the coinbase. `blockHash` is in serialized (little-endian) order.
+    static BlockFilter basic(DataView blockHash, const std::vector<TransactionView>& transactions,
+                             const std::vector<DataView>& spentScripts);
+
+    /// Builds the filter of a set of elements, duplicates removed.
+    BlockFilter(DataView blockHash, const std::vector<DataView>& elements, uint8_t p = basicP, uint64_t m = basicM);
+
+    /// A filter in its serialized form, the number of elements as a CompactSize then the coded set, as served by
+    /// nodes (BIP157 cfilter messages).
+    ///
+    /// @throws std::invalid_argument if the block hash is shorter than 16 bytes or the number of elements is missing.
+    BlockFilter(DataView blockHash, Data encoded, uint8_t p = basicP, uint64_t m = basicM);
+
+    /// Serialized form.
+    const Data& encoded() const { return filter; }
+
+    /// Number of elements.
+    uint64_t size() const { return count; }
+
+    /// Whether an element may be in the set.
+    bool match(DataView element) const;
+
+    /// Whether any of the elements may be in the set, decoding the filter once.
+    bool matchAny(const std::vector<DataView>& elements) const;
+    bool matchAny(const std::vector<Script>& scripts) const;
+
+    /// Indices of the elements which may be in the set, in increasing order, decoding the filter once.
+    std::vector<std::size_t> matches(const std::vector<DataView>& elements) const;
+    std::vector<std::size_t> matches(const std::vector<Script>& scripts) const;
+
+    /// Filter header (BIP157), chaining the filters: double SHA256 of the filter hash and the previous header,
+    /// 32 zero bytes for the genesis block.
+    Data header(const Data& previousHeader) const;
+
+    /// Locking scripts of addresses, to match against filters; empty for invalid addresses.
+    static std::vector<Script> scripts(const std::vector<std::string>& addresses, TWCoinType coin);
+
+  private:
+    uint64_t k0;
+    uint64_t k1;
+    uint8_t p;
+    uint64_t m;
+    uint64_t count = 0;
+    Data filter;
+    /// Start of the coded set in `filter`.
+    std::size_t dataOffset = 0;
+
+    /// Sorted ranged hashes of elements paired with their indices.
+    std::vector<std::pair<uint64_t, std::size_t>> hashElements(const std::vector<DataView>& elements) const;
+    /// Merges sorted queries with the decoded set; stops at the first match if `first`.
+    std::vector<std::size_t> matchSorted(const std::vector<std::pair<uint64_t, std::size_t>>& queries, bool first) const;
+};
+
+} // namespace TW::Bitcoin
@@ -5,9 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "CashAddress.h"
+#include "../Base58.h"
 #include "../Coin.h"
 
-#include <TrezorCrypto/cash_addr.h>
 #include <TrezorCrypto/ecdsa.h>
 
 #include <array>
@@ -16,49 +16,160 @@
 
 using namespace TW::Bitcoin;
 
+/// From https://github.com/bitcoincashorg/bitcoincash.org/blob/master/spec/cashaddr.md
+
 /// Cash address human-readable part
 static const std::string cashHRP = "bitcoincash";
 
-/// From https://github.com/bitcoincashorg/bitcoincash.org/blob/master/spec/cashaddr.md
-
 static const uint8_t p2khVersion = 0x00;
 static const uint8_t p2shVersion = 0x08;
 
-static constexpr size_t maxHRPSize = 20;
-static constexpr size_t maxDataSize = 104;
+static constexpr size_t checksumSize = 8;
 
-bool CashAddress::isValid(const std::string& string) {
-    auto withPrefix = string;
-    if (!std::equal(cashHRP.begin(), cashHRP.end(), string.begin())) {
-        withPrefix = cashHRP + ":" + string;
+static constexpr char charset[] = "qpzry9x8gf2tvdw0s3jn54khce6mua7l";
+
+namespace {
+
+/// XOR of the generators selected by each of the 5 bits of an index, so that a polymod step is a single lookup.
+constexpr std::array<uint64_t, 32> makePolymodTable() {
+    constexpr uint64_t generators[] = {0x98f2bc8e61, 0x79b76d99e2, 0xf33e5fb3c4, 0xae2eabe2a8, 0x1e4f43e470};
+    std::array<uint64_t, 32> table = {};
+    for (size_t i = 0; i < table.size(); ++i) {
+        for (size_t bit = 0; bit < 5; ++bit) {
+            if ((i >> bit) & 1) {
+                table[i] ^= generators[bit];
+            }
+        }
     }
+    return table;
+}
 
-    std::array<char, maxHRPSize + 1> hrp = {0};
-    std::array<uint8_t, maxDataSize> data;
-    size_t dataLen;
-    if (cash_decode(hrp.data(), data.data(), &dataLen, withPrefix.c_str()) == 0 || dataLen != CashAddress::size) {
-        return false;
+constexpr auto polymodTable = makePolymodTable();
+
+/// Feeds a 5-bit value to the 40-bit BCH checksum.
+constexpr uint64_t polymodStep(uint64_t checksum, uint8_t value) {
+    return ((checksum & 0x7ffffffff) << 5) ^ polymodTable[checksum >> 35] ^ value;
+}
+
+/// Checksum state after the lower 5 bits of each character of the human-readable part, and its separator.
+constexpr uint64_t hrpChecksum() {
+    constexpr char hrp[] = "bitcoincash";
+    uint64_t checksum = 1;
+    for (size_t i = 0; hrp[i] != 0; ++i) {
+        checksum = polymodStep(checksum, hrp[i] & 0x1f);
     }
-    if (std::strncmp(hrp.data(), cashHRP.c_str(), std::min(cashHRP.size(), maxHRPSize)) != 0) {
+    return polymodStep(checksum, 0);
+}
+
+constexpr auto prefixChecksum = hrpChecksum();
+
+/// Value of each lowercase character of the charset, -1 for others.
+constexpr std::array<int8_t, 128> makeCharsetIndex() {
+    std::array<int8_t, 128> index = {};
+    for (auto& value : index) {
+        value = -1;
+    }
+    for (size_t i = 0; i < 32; ++i) {
+        index[static_cast<size_t>(charset[i])] = static_cast<int8_t>(i);
+    }
+    return index;
+}
+
+constexpr auto charsetIndex = makeCharsetIndex();
+
+/// Regroups the bits of the payload, padded, into the 5-bit groups of an address.
+void payloadToGroups(const CashAddress::Payload& payload, std::array<TW::byte, CashAddress::size>& groups) {
+    uint32_t value = 0;
+    size_t bits = 0;
+    size_t count = 0;
+    for (const auto byte : payload) {
+        value = (value << 8) | byte;
+        bits += 8;
+        while (bits >= 5) {
+            bits -= 5;
+            groups[count++] = (value >> bits) & 0x1f;
+        }
+    }
+    if (bits > 0) {
+        groups[count++] = (value << (5 - bits)) & 0x1f;
+    }
+    assert(count == CashAddress::size);
+}
+
+} // namespace
+
+bool CashAddress::decode(const std::string& string, std::array<byte, size>& bytes) {
+    // the prefix is optional
+    size_t offset = 0;
+    if (string.size() > cashHRP.size() && string.compare(0, cashHRP.size(), cashHRP) == 0 && string[cashHRP.size()] == ':') {
+        offset = cashHRP.size() + 1;
+    }
+    if (string.size() - offset != size + checksumSize) {
         return false;
     }
-    return true;
+
+    auto checksum = prefixChecksum;
+    for (size_t i = 0; i < size + checksumSize; ++i) {
+        const auto ch = static_cast<unsigned char>(string[offset + i]);
+        // lowercase only, as the prefix is
+        const auto value = ch < charsetIndex.size() ? charsetIndex[ch] : -1;
+        if (value < 0) {
+            return false;
+        }
+        checksum = polymodStep(checksum, static_cast<uint8_t>(value));
+        if (i < size) {
+            bytes[i] = static_cast<byte>(value);
+        }
+    }
+    return checksum == 1;
 }
 
-CashAddress::CashAddress(const std::string& string) {
-    auto withPrefix = string;
-    if (!std::equal(cashHRP.begin(), cashHRP.end(), string.begin())) {
-        withPrefix = cashHRP + ":" + string;
+bool CashAddress::isValid(const std::string& string) {
+    std::array<byte, size> bytes;
+    return decode(string, bytes);
+}
+
+std::vector<bool> CashAddress::validate(const std::vector<std::string>& strings) {
+    std::vector<bool> result;
+    result.reserve(strings.size());
+    std::array<byte, size> bytes;
+    for (const auto& string : strings) {
+        result.push_back(decode(string, bytes));
+    }
+    return result;
+}
+
+std::vector<std::string> CashAddress::toLegacy(const std::vector<std::string>& strings) {
+    std::vector<std::string> result;
+    result.reserve(strings.size());
+    CashAddress address;
+    for (const auto& string : strings) {
+        result.push_back(decode(string, address.bytes) ? address.legacyAddress().string() : "");
     }
+    return result;
+}
 
-    std::array<char, maxHRPSize + 1> hrp;
-    std::array<uint8_t, maxDataSize> data;
-    size_t dataLen;
-    auto success = cash_decode(hrp.data(), data.data(), &dataLen, withPrefix.c_str()) != 0;
-    if (!success || std::strncmp(hrp.data(), cashHRP.c_str(), std::min(cashHRP.size(), maxHRPSize)) != 0 || dataLen != CashAddress::size) {
+std::vector<std::string> CashAddress::fromLegacy(const std::vector<std::string>& strings) {
+    const auto p2pkh = TW::p2pkhPrefix(TWCoinTypeBitcoinCash);
+    const auto p2sh = TW::p2shPrefix(TWCoinTypeBitcoinCash);
+    std::vector<std::string> result;
+    result.reserve(strings.size());
+    Payload payload;
+    for (const auto& string : strings) {
+        if (!Base58::bitcoin.decodeCheck(string, payload) || (payload[0] != p2pkh && payload[0] != p2sh)) {
+            result.emplace_back();
+            continue;
+        }
+        payload[0] = payload[0] == p2pkh ? p2khVersion : p2shVersion;
+        result.push_back(fromPayload(payload).string());
+    }
+    return result;
+}
+
+CashAddress::CashAddress(const std::string& string) {
+    if (!decode(string, bytes)) {
         throw std::invalid_argument("Invalid address string");
     }
-    std::copy(data.begin(), data.begin() + dataLen, bytes.begin());
 }
 
 CashAddress::CashAddress(const std::vector<uint8_t>& data) {
@@ -72,32 +183,62 @@ CashAddress::CashAddress(const PublicKey& publicKey) {
     if (publicKey.type != TWPublicKeyTypeSECP256k1) {
         throw std::invalid_argument("CashAddress needs a compressed SECP256k1 public key.");
     }
-    std::array<uint8_t, 21> payload;
-    payload[0] = 0;
+    Payload payload;
+    payload[0] = p2khVersion;
     ecdsa_get_pubkeyhash(publicKey.bytes.data(), HASHER_SHA2_RIPEMD, payload.data() + 1);
+    payloadToGroups(payload, bytes);
+}
 
-    size_t outlen = 0;
-    auto success = cash_addr_to_data(bytes.data(), &outlen, payload.data(), 21) != 0;
-    if (!success || outlen != CashAddress::size) {
-        throw std::invalid_argument("unable to cash_addr_to_data");
-    }
+CashAddress CashAddress::fromPayload(const Payload& payload) {
+    CashAddress address;
+    payloadToGroups(payload, address.bytes);
+    return address;
 }
 
 std::string CashAddress::string() const {
-    std::array<char, 129> result;
-    cash_encode(result.data(), cashHRP.c_str(), bytes.data(), CashAddress::size);
-    return result.data();
+    std::string result;
+    result.reserve(cashHRP.size() + 1 + size + checksumSize);
+    result.append(cashHRP);
+    result.push_back(':');
+    auto checksum = prefixChecksum;
+    for (const auto value : bytes) {
+        checksum = polymodStep(checksum, value);
+        result.push_back(charset[value]);
+    }
+    for (size_t i = 0; i < checksumSize; ++i) {
+        checksum = polymodStep(checksum, 0);
+    }
+    checksum ^= 1;
+    for (size_t i = 0; i < checksumSize; ++i) {
+        result.push_back(charset[(checksum >> ((checksumSize - 1 - i) * 5)) & 0x1f]);
+    }
+    return result;
+}
+
+CashAddress::Payload CashAddress::payload(const std::array<byte, size>& bytes) {
+    // 34 groups of 5 bits, the last 2 bits are padding
+    Payload result;
+    uint32_t value = 0;
+    size_t bits = 0;
+    size_t count = 0;
+    for (const auto group : bytes) {
+        value = (value << 5) | group;
+        bits += 5;
+        if (bits >= 8) {
+            bits -= 8;
+            result[count++] = static_cast<byte>(value >> bits);
+        }
+    }
+    assert(count == payloadSize);
+    return result;
 }
 
 Address CashAddress::legacyAddress() const {
-    std::vector<uint8_t> result(Address::size);
-    size_t outlen = 0;
-    cash_data_to_addr(result.data(), &outlen, bytes.data(), CashAddress::size);
-    assert(outlen == 21 && "Invalid length");
+    auto result = payload();
     if (result[0] == p2khVersion) {
         result[0] = TW::p2pkhPrefix(TWCoinTypeBitcoinCash);
     } else if (result[0] == p2shVersion) {
         result[0] = TW::p2shPrefix(TWCoinTypeBitcoinCash);
     }
-    return Address(result);
+    return Address(Data(result.begin(), result.end()));
 }
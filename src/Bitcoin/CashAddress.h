@@ -9,8 +9,10 @@
 #include "Address.h"
 #include "../PublicKey.h"
 
+#include <array>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 namespace TW::Bitcoin {
 
@@ -19,8 +21,13 @@ class CashAddress {
     /// Number of bytes in an address.
     static const size_t size = 34;
 
+    /// Size of the payload, a version byte followed by the hash.
+    static const size_t payloadSize = 21;
+
+    using Payload = std::array<byte, payloadSize>;
+
     /// Address data consisting of a prefix byte followed by the public key
-    /// hash.
+    /// hash, as 5-bit groups.
     std::array<byte, size> bytes;
 
     /// Determines whether a collection of bytes makes a valid  address.
@@ -32,6 +39,19 @@ class CashAddress {
     /// Determines whether a string makes a valid  address.
     static bool isValid(const std::string& string);
 
+    /// Decodes a string, with or without the `bitcoincash:` prefix, into the 5-bit groups of an address; returns false
+    /// if it isn't a valid address.  Doesn't allocate.
+    static bool decode(const std::string& string, std::array<byte, size>& bytes);
+
+    /// Validates addresses, see isValid.
+    static std::vector<bool> validate(const std::vector<std::string>& strings);
+
+    /// Converts addresses to legacy addresses, empty for invalid addresses.
+    static std::vector<std::string> toLegacy(const std::vector<std::string>& strings);
+
+    /// Converts legacy addresses to cash addresses with the `bitcoincash:` prefix, empty for invalid addresses.
+    static std::vector<std::string> fromLegacy(const std::vector<std::string>& strings);
+
     /// Initializes a  address with a string representation.
     explicit CashAddress(const std::string& string);
 
@@ -44,8 +64,20 @@ class CashAddress {
     /// Returns a string representation of the address.
     std::string string() const;
 
+    /// Returns the version byte, 0 for P2KH or 8 for P2SH, followed by the hash.
+    Payload payload() const { return payload(bytes); }
+
+    /// Returns the payload of the 5-bit groups of an address, see decode.
+    static Payload payload(const std::array<byte, size>& bytes);
+
     /// Returns the legacy address representation.
     Address legacyAddress() const;
+
+  private:
+    CashAddress() = default;
+
+    /// Initializes an address with a payload.
+    static CashAddress fromPayload(const Payload& payload);
 };
 
 inline bool operator==(const CashAddress& lhs, const CashAddress& rhs) {
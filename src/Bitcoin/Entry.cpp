@@ -10,6 +10,7 @@
 #include "CashAddress.h"
 #include "SegwitAddress.h"
 #include "Signer.h"
+#include "../Base58.h"
 
 using namespace TW::Bitcoin;
 using namespace std;
@@ -43,9 +44,9 @@ string Entry::normalizeAddress(TWCoinType coin, const string& address) const {
     switch (coin) {
         case TWCoinTypeBitcoinCash:
             // normalized with bitcoincash: prefix
-            if (CashAddress::isValid(address)) {
+            try {
                 return CashAddress(address).string();
-            } else {
+            } catch (const std::invalid_argument&) {
                 return std::string(address);
             }
 
@@ -55,6 +56,64 @@ string Entry::normalizeAddress(TWCoinType coin, const string& address) const {
     }
 }
 
+bool Entry::parseAddress(TWCoinType coin, const string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp, ParsedAddress& parsed) const {
+    switch (coin) {
+        case TWCoinTypeBitcoin:
+        case TWCoinTypeDigiByte:
+        case TWCoinTypeLitecoin:
+        case TWCoinTypeViacoin: {
+            // the data is the witness program, legacy addresses have none
+            const auto decoded = SegwitAddress::decode(address);
+            if (std::get<2>(decoded) && hrp != nullptr && std::get<1>(decoded) == hrp) {
+                parsed.data = std::get<0>(decoded).witnessProgram;
+            } else if (!Address::isValid(address, {{p2pkh}, {p2sh}})) {
+                return false;
+            }
+            parsed.normalized = address;
+            parsed.hasData = true;
+            return true;
+        }
+
+        case TWCoinTypeDash:
+        case TWCoinTypeDogecoin:
+        case TWCoinTypeRavencoin:
+        case TWCoinTypeZcoin: {
+            // the data is the key hash, without the prefix
+            std::array<byte, Address::size> decoded;
+            if (!Base58::bitcoin.decodeCheck(address, decoded) || (decoded[0] != p2pkh && decoded[0] != p2sh)) {
+                return false;
+            }
+            parsed.normalized = address;
+            parsed.data = Data(decoded.begin() + 1, decoded.end());
+            parsed.hasData = true;
+            return true;
+        }
+
+        case TWCoinTypeBitcoinCash: {
+            // the data is the key hash, of a cash or legacy address
+            std::array<byte, CashAddress::size> groups;
+            if (CashAddress::decode(address, groups)) {
+                const auto payload = CashAddress::payload(groups);
+                parsed.normalized = CashAddress(Data(groups.begin(), groups.end())).string();
+                parsed.data = Data(payload.begin() + 1, payload.end());
+                parsed.hasData = true;
+                return true;
+            }
+            std::array<byte, Address::size> decoded;
+            if (!Base58::bitcoin.decodeCheck(address, decoded) || (decoded[0] != p2pkh && decoded[0] != p2sh)) {
+                return false;
+            }
+            parsed.normalized = address;
+            parsed.data = Data(decoded.begin() + 1, decoded.end());
+            parsed.hasData = true;
+            return true;
+        }
+
+        default:
+            return CoinEntry::parseAddress(coin, address, p2pkh, p2sh, hrp, parsed);
+    }
+}
+
 string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte p2pkh, const char* hrp) const {
     switch (coin) {
         case TWCoinTypeBitcoin:
@@ -78,10 +137,14 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     }
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
 
-void Entry::plan(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
+void Entry::plan(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     planTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
@@ -32,9 +32,11 @@ public:
     }
     virtual bool validateAddress(TWCoinType coin, const std::string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp) const;
     virtual std::string normalizeAddress(TWCoinType coin, const std::string& address) const;
+    virtual bool parseAddress(TWCoinType coin, const std::string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp, ParsedAddress& parsed) const;
     virtual std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte p2pkh, const char* hrp) const;
-    virtual void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
-    virtual void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
+    virtual void sign(TWCoinType coin, DataView dataIn, Data& dataOut) const;
+    virtual bool signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const;
+    virtual void plan(TWCoinType coin, DataView dataIn, Data& dataOut) const;
 };
 
 } // namespace TW::Bitcoin
@@ -11,6 +11,6 @@
 using namespace TW::Bitcoin;
 
 void OutPoint::encode(std::vector<uint8_t>& data) const {
-    std::copy(std::begin(hash), std::end(hash), std::back_inserter(data));
+    data.insert(data.end(), hash.begin(), hash.end());
     encode32LE(index, data);
 }
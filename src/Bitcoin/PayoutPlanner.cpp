@@ -0,0 +1,154 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "PayoutPlanner.h"
+
+#include "FeeCalculator.h"
+#include "SizeEstimator.h"
+
+#include "../BinaryCoding.h"
+
+#include <algorithm>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+/// Running totals of a transaction being planned, cheap to copy.
+struct BatchState {
+    /// Range of the batch's UTXOs in the sorted UTXOs.
+    size_t utxoBegin = 0;
+    size_t utxoEnd = 0;
+    Amount available = 0;
+
+    size_t payouts = 0;
+    Amount amount = 0;
+
+    int64_t inputsBase = 0;
+    int64_t inputsWitness = 0;
+    bool hasWitness = false;
+    int64_t outputsBase = 0;
+
+    /// Virtual size, with an additional output of the given size if not 0.
+    int64_t virtualSize(int64_t changeOutputSize) const {
+        const auto inputs = static_cast<uint64_t>(utxoEnd - utxoBegin);
+        const auto outputs = static_cast<uint64_t>(payouts + (changeOutputSize > 0 ? 1 : 0));
+        // version, locktime
+        const auto base = 4 + 4 + varIntSize(inputs) + varIntSize(outputs) + inputsBase + outputsBase + changeOutputSize;
+        if (!hasWitness) {
+            return base;
+        }
+        // marker and flag
+        const auto witness = inputsWitness + 2;
+        return base + witness / 4 + (witness % 4 != 0);
+    }
+};
+
+} // namespace
+
+PayoutPlan PayoutPlanner::plan(const Proto::SigningInput& input, const std::vector<Payout>& payouts, const Limits& limits) {
+    auto result = PayoutPlan();
+    const auto coin = static_cast<TWCoinType>(input.coin_type());
+    const auto byteFee = input.byte_fee();
+    const auto& feeCalculator = getFeeCalculator(coin);
+    const auto dustThreshold = feeCalculator.calculateSingleInput(byteFee);
+    // payouts often repeat addresses, converted once and cached across plans
+    std::vector<std::string> addresses;
+    addresses.reserve(payouts.size() + 1);
+    for (const auto& payout : payouts) {
+        addresses.push_back(payout.address);
+    }
+    addresses.push_back(input.change_address());
+    const auto scripts = ScriptCache::shared().lockScripts(addresses, coin);
+    const auto& changeScript = scripts.back();
+    if (changeScript.empty()) {
+        result.error = Common::Proto::Error_script_output;
+        return result;
+    }
+    const auto changeOutputSize = SizeEstimator::outputSize(changeScript);
+
+    // largest first
+    auto utxos = std::vector<Proto::UnspentTransaction>(input.utxo().begin(), input.utxo().end());
+    std::stable_sort(utxos.begin(), utxos.end(), [](const auto& lhs, const auto& rhs) { return lhs.amount() > rhs.amount(); });
+    const auto inputSizes = SizeEstimator::inputSizes(utxos, input);
+
+    const auto fee = [byteFee](const BatchState& batch, int64_t changeSize) { return batch.virtualSize(changeSize) * byteFee; };
+    const auto withinLimits = [&](const BatchState& batch) {
+        return batch.virtualSize(changeOutputSize) <= limits.maxVirtualSize &&
+               (limits.maxOutputs == 0 || batch.payouts + 1 <= limits.maxOutputs);
+    };
+    const auto close = [&](const BatchState& batch) {
+        auto& closed = result.batches.emplace_back();
+        closed.first = result.planned;
+        closed.count = batch.payouts;
+        auto& plan = closed.plan;
+        plan.utxos.assign(utxos.begin() + batch.utxoBegin, utxos.begin() + batch.utxoEnd);
+        plan.amount = batch.amount;
+        plan.availableAmount = batch.available;
+        plan.fee = fee(batch, changeOutputSize);
+        plan.change = batch.available - batch.amount - plan.fee;
+        if (plan.change < dustThreshold) {
+            // without change, the excess goes to the fee
+            plan.fee += plan.change;
+            plan.change = 0;
+        }
+        plan.error = Common::Proto::OK;
+        result.planned += batch.payouts;
+    };
+
+    auto batch = BatchState();
+    for (size_t i = 0; i < payouts.size(); ++i) {
+        const auto& payout = payouts[i];
+        if (payout.amount <= 0) {
+            result.error = Common::Proto::Error_zero_amount_requested;
+            break;
+        }
+        const auto& script = scripts[i];
+        if (script.empty()) {
+            result.error = Common::Proto::Error_script_output;
+            break;
+        }
+
+        // adds the payout, and the UTXOs to pay it, to a copy of the batch
+        const auto addPayout = [&](BatchState candidate) {
+            candidate.payouts += 1;
+            candidate.amount += payout.amount;
+            candidate.outputsBase += SizeEstimator::outputSize(script);
+            while (candidate.available < candidate.amount + fee(candidate, changeOutputSize) && candidate.utxoEnd < utxos.size()) {
+                const auto& size = inputSizes[candidate.utxoEnd];
+                const auto inputSize = size.value_or(SizeEstimator::Size{feeCalculator.calculateSingleInput(1), 0});
+                candidate.available += utxos[candidate.utxoEnd].amount();
+                candidate.inputsBase += inputSize.base;
+                candidate.inputsWitness += inputSize.witness;
+                candidate.hasWitness = candidate.hasWitness || inputSize.witness > varIntSize(0);
+                candidate.utxoEnd += 1;
+            }
+            return candidate;
+        };
+        auto candidate = addPayout(batch);
+        if (!withinLimits(candidate) && batch.payouts > 0) {
+            close(batch);
+            const auto next = batch.utxoEnd;
+            batch = BatchState();
+            batch.utxoBegin = batch.utxoEnd = next;
+            candidate = addPayout(batch);
+        }
+        if (!withinLimits(candidate)) {
+            result.error = Common::Proto::Error_tx_too_big;
+            break;
+        }
+        if (candidate.available < candidate.amount + fee(candidate, changeOutputSize)) {
+            result.error = Common::Proto::Error_not_enough_utxos;
+            break;
+        }
+        batch = candidate;
+    }
+    if (batch.payouts > 0) {
+        close(batch);
+    }
+    return result;
+}
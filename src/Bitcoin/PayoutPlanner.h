@@ -0,0 +1,106 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Amount.h"
+#include "Script.h"
+#include "ScriptCache.h"
+#include "TransactionOutput.h"
+#include "TransactionPlan.h"
+#include "../proto/Bitcoin.pb.h"
+#include "../proto/Common.pb.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <string>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Payment of an amount to an address.
+struct Payout {
+    std::string address;
+    Amount amount;
+};
+
+/// Transaction paying consecutive payouts of a queue.
+struct PayoutBatch {
+    /// Index in the queue of the first payout of the batch.
+    size_t first = 0;
+
+    /// Number of payouts of the batch.
+    size_t count = 0;
+
+    /// Plan of the transaction: the amount is the total of the payouts, change goes to the change address of the input.
+    TransactionPlan plan;
+};
+
+/// Result of batching a queue of payouts.
+struct PayoutPlan {
+    std::vector<PayoutBatch> batches;
+
+    /// Number of payouts planned, from the start of the queue.
+    size_t planned = 0;
+
+    /// Why the payout after the planned ones couldn't be planned, OK if all are.
+    Common::Proto::SigningError error = Common::Proto::OK;
+};
+
+/// Plans the transactions paying a queue of payouts in order, many payouts per transaction.
+///
+/// Each transaction spends the largest UTXOs among the remaining ones, until they cover its payouts and fee, so that UTXOs
+/// are selected once per transaction, and planning is O(n log n) in the number of UTXOs and payouts.
+class PayoutPlanner {
+  public:
+    /// Standard transactions are at most 400000 weight units.
+    static constexpr int64_t maxStandardVirtualSize = 100'000;
+
+    struct Limits {
+        /// Maximum virtual size of a transaction.
+        int64_t maxVirtualSize = maxStandardVirtualSize;
+
+        /// Maximum number of outputs of a transaction, change included, 0 for no limit.
+        size_t maxOutputs = 0;
+    };
+
+    /// Plans the payouts with the UTXOs, byte fee, coin and change address of the input; its amount and addresses are ignored.
+    ///
+    /// Planning stops at the first payout which can't be paid, with the error `Error_not_enough_utxos`,
+    /// `Error_script_output` for an invalid address, `Error_zero_amount_requested`, or `Error_tx_too_big` if the payout
+    /// alone exceeds the limits.
+    static PayoutPlan plan(const Proto::SigningInput& input, const std::vector<Payout>& payouts, const Limits& limits);
+    static PayoutPlan plan(const Proto::SigningInput& input, const std::vector<Payout>& payouts) { return plan(input, payouts, Limits()); }
+
+    /// Builds the unsigned transaction of a batch: its payouts in order, then the change.
+    template <typename Transaction>
+    static Transaction build(const PayoutBatch& batch, const std::vector<Payout>& payouts, const std::string& changeAddress,
+                             enum TWCoinType coin) {
+        std::vector<std::string> addresses;
+        addresses.reserve(batch.count + 1);
+        for (size_t i = batch.first; i < batch.first + batch.count; ++i) {
+            addresses.push_back(payouts[i].address);
+        }
+        addresses.push_back(changeAddress);
+        const auto scripts = ScriptCache::shared().lockScripts(addresses, coin);
+
+        Transaction tx;
+        tx.outputs.reserve(batch.count + 1);
+        for (size_t i = 0; i < batch.count; ++i) {
+            tx.outputs.push_back(TransactionOutput(payouts[batch.first + i].amount, scripts[i]));
+        }
+        if (batch.plan.change > 0) {
+            tx.outputs.push_back(TransactionOutput(batch.plan.change, scripts.back()));
+        }
+        const auto emptyScript = Script();
+        for (auto& utxo : batch.plan.utxos) {
+            tx.inputs.emplace_back(utxo.out_point(), emptyScript, utxo.out_point().sequence());
+        }
+        return tx;
+    }
+};
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,499 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Psbt.h"
+
+#include "Reader.h"
+#include "SigHashType.h"
+#include "SignatureVersion.h"
+#include "TransactionBuilder.h"
+#include "TransactionSigner.h"
+#include "TransactionView.h"
+
+#include "../BinaryCoding.h"
+#include "../Hash.h"
+#include "../PublicKey.h"
+#include "../ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+const byte psbtMagic[] = {'p', 's', 'b', 't', 0xff};
+
+// Key types
+const byte globalUnsignedTransaction = 0x00;
+const byte inputNonWitnessUtxo = 0x00;
+const byte inputWitnessUtxo = 0x01;
+const byte inputPartialSignature = 0x02;
+const byte inputSighashType = 0x03;
+const byte inputRedeemScript = 0x04;
+const byte inputWitnessScript = 0x05;
+const byte inputBip32Derivation = 0x06;
+const byte inputFinalScriptSig = 0x07;
+const byte inputFinalScriptWitness = 0x08;
+
+/// Reads a map up to its separator.
+Psbt::Map readMap(Reader& reader) {
+    auto map = Psbt::Map();
+    while (true) {
+        const auto keyLength = reader.varInt();
+        if (keyLength == 0) {
+            return map;
+        }
+        auto key = reader.bytes(keyLength).toData();
+        auto value = reader.varBytes().toData();
+        if (!map.emplace(std::move(key), std::move(value)).second) {
+            throw std::invalid_argument("Duplicate key");
+        }
+    }
+}
+
+void writeMap(const Psbt::Map& map, Data& data) {
+    for (const auto& entry : map) {
+        encodeVarInt(entry.first.size(), data);
+        append(data, entry.first);
+        encodeVarInt(entry.second.size(), data);
+        append(data, entry.second);
+    }
+    data.push_back(0);
+}
+
+Psbt::Input decodeInput(Psbt::Map&& map) {
+    auto input = Psbt::Input();
+    for (auto& entry : map) {
+        const auto& key = entry.first;
+        auto& value = entry.second;
+        if (key.size() == 1) {
+            switch (key[0]) {
+            case inputNonWitnessUtxo:
+                input.nonWitnessUtxo = std::move(value);
+                continue;
+            case inputWitnessUtxo: {
+                auto reader = Reader(value);
+                const auto amount = static_cast<Amount>(reader.uint64());
+                const auto script = reader.varBytes();
+                if (!reader.empty()) {
+                    throw std::invalid_argument("Invalid witness UTXO");
+                }
+                input.witnessUtxo = TransactionOutput(amount, Script(script.begin(), script.end()));
+                continue;
+            }
+            case inputSighashType:
+                if (value.size() != 4) {
+                    throw std::invalid_argument("Invalid sighash type");
+                }
+                input.sighashType = decode32LE(value.data());
+                continue;
+            case inputRedeemScript:
+                input.redeemScript = Script(value);
+                continue;
+            case inputWitnessScript:
+                input.witnessScript = Script(value);
+                continue;
+            case inputFinalScriptSig:
+                input.finalScriptSig = Script(value);
+                continue;
+            case inputFinalScriptWitness: {
+                auto reader = Reader(value);
+                auto witness = std::vector<Data>();
+                const auto itemCount = reader.varInt();
+                for (uint64_t i = 0; i < itemCount; ++i) {
+                    witness.push_back(reader.varBytes().toData());
+                }
+                if (!reader.empty()) {
+                    throw std::invalid_argument("Invalid final script witness");
+                }
+                input.finalScriptWitness = std::move(witness);
+                continue;
+            }
+            default:
+                break;
+            }
+        }
+        if (key[0] == inputPartialSignature &&
+            (key.size() == 1 + PublicKey::secp256k1Size || key.size() == 1 + PublicKey::secp256k1ExtendedSize)) {
+            input.partialSignatures.emplace(Data(key.begin() + 1, key.end()), std::move(value));
+            continue;
+        }
+        input.unknown.emplace(key, std::move(value));
+    }
+    return input;
+}
+
+Psbt::Map encodeInput(const Psbt::Input& input) {
+    auto map = input.unknown;
+    if (!input.nonWitnessUtxo.empty()) {
+        map[{inputNonWitnessUtxo}] = input.nonWitnessUtxo;
+    }
+    if (input.witnessUtxo) {
+        auto& value = map[{inputWitnessUtxo}];
+        input.witnessUtxo->encode(value);
+    }
+    for (const auto& signature : input.partialSignatures) {
+        auto key = Data{inputPartialSignature};
+        append(key, signature.first);
+        map[key] = signature.second;
+    }
+    if (input.sighashType) {
+        encode32LE(*input.sighashType, map[{inputSighashType}]);
+    }
+    if (!input.redeemScript.empty()) {
+        map[{inputRedeemScript}] = input.redeemScript.bytes;
+    }
+    if (!input.witnessScript.empty()) {
+        map[{inputWitnessScript}] = input.witnessScript.bytes;
+    }
+    if (input.finalScriptSig) {
+        map[{inputFinalScriptSig}] = input.finalScriptSig->bytes;
+    }
+    if (input.finalScriptWitness) {
+        auto& value = map[{inputFinalScriptWitness}];
+        encodeVarInt(input.finalScriptWitness->size(), value);
+        for (const auto& item : *input.finalScriptWitness) {
+            encodeVarInt(item.size(), value);
+            append(value, item);
+        }
+    }
+    return map;
+}
+
+/// How an input is spent.
+struct Spending {
+    /// Script satisfied by the signatures: the output, redeem or witness script, P2PKH for a P2WPKH program.
+    Script script;
+
+    SignatureVersion version = BASE;
+
+    /// Whether the script sig ends with the redeem script.
+    bool pushRedeemScript = false;
+
+    /// Whether the witness ends with the witness script.
+    bool pushWitnessScript = false;
+};
+
+std::optional<Spending> spending(const Psbt::Input& input, const Script& outputScript) {
+    auto result = Spending();
+    result.script = outputScript;
+    DataView hash;
+    if (result.script.matchPayToScriptHash(hash)) {
+        const auto redeemHash = input.redeemScript.hash();
+        if (input.redeemScript.empty() || !std::equal(hash.begin(), hash.end(), redeemHash.begin(), redeemHash.end())) {
+            return {};
+        }
+        result.script = input.redeemScript;
+        result.pushRedeemScript = true;
+    }
+    if (result.script.matchPayToWitnessPublicKeyHash(hash)) {
+        result.script = Script::buildPayToPublicKeyHash(hash);
+        result.version = WITNESS_V0;
+    } else if (result.script.matchPayToWitnessScriptHash(hash)) {
+        const auto witnessHash = Hash::sha256(input.witnessScript.bytes);
+        if (input.witnessScript.empty() || !std::equal(hash.begin(), hash.end(), witnessHash.begin(), witnessHash.end())) {
+            return {};
+        }
+        result.script = input.witnessScript;
+        result.version = WITNESS_V0;
+        result.pushWitnessScript = true;
+    } else if (result.script.isWitnessProgram()) {
+        return {};
+    }
+    return result;
+}
+
+/// Whether the script refers to the public key, or to its hash.
+bool scriptUsesKey(const Script& script, const Data& publicKey, const Data& keyHash) {
+    size_t index = 0;
+    uint8_t opcode;
+    DataView operand;
+    while (script.getScriptOp(index, opcode, operand)) {
+        if (std::equal(operand.begin(), operand.end(), publicKey.begin(), publicKey.end()) ||
+            std::equal(operand.begin(), operand.end(), keyHash.begin(), keyHash.end())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Builds the stack satisfying a script from the available signatures, returns false if signatures are missing.
+bool satisfy(const Script& script, const std::map<Data, Data>& signatures, std::vector<Data>& stack) {
+    DataView hash;
+    std::vector<Data> keys;
+    int required;
+    if (script.matchPayToPublicKeyHash(hash)) {
+        for (const auto& signature : signatures) {
+            const auto keyHash = Hash::sha256ripemd(signature.first.data(), signature.first.size());
+            if (std::equal(hash.begin(), hash.end(), keyHash.begin(), keyHash.end())) {
+                stack = {signature.second, signature.first};
+                return true;
+            }
+        }
+        return false;
+    }
+    if (script.matchPayToPublicKey(hash)) {
+        const auto publicKey = Data(script.bytes.begin() + 1, script.bytes.end() - 1);
+        const auto found = signatures.find(publicKey);
+        if (found == signatures.end()) {
+            return false;
+        }
+        stack = {found->second};
+        return true;
+    }
+    if (script.matchMultisig(keys, required)) {
+        stack = {Data()}; // CHECKMULTISIG pops an extra element
+        for (const auto& key : keys) {
+            const auto found = signatures.find(key);
+            if (found != signatures.end() && stack.size() < static_cast<size_t>(required) + 1) {
+                stack.push_back(found->second);
+            }
+        }
+        return stack.size() == static_cast<size_t>(required) + 1;
+    }
+    return false;
+}
+
+} // namespace
+
+Psbt::Psbt(Transaction transaction) : transaction(std::move(transaction)) {
+    for (const auto& input : this->transaction.inputs) {
+        if (!input.script.empty() || !input.scriptWitness.empty()) {
+            throw std::invalid_argument("Transaction is not unsigned");
+        }
+    }
+    inputs.resize(this->transaction.inputs.size());
+    outputs.resize(this->transaction.outputs.size());
+}
+
+Psbt Psbt::decode(DataView data) {
+    auto reader = Reader(data);
+    const auto magic = reader.bytes(sizeof(psbtMagic));
+    if (!std::equal(magic.begin(), magic.end(), std::begin(psbtMagic))) {
+        throw std::invalid_argument("Not a PSBT");
+    }
+
+    auto global = readMap(reader);
+    const auto found = global.find({globalUnsignedTransaction});
+    if (found == global.end()) {
+        throw std::invalid_argument("Missing unsigned transaction");
+    }
+    auto psbt = Psbt(TransactionView::decode(found->second).toTransaction());
+    global.erase(found);
+    psbt.unknown = std::move(global);
+
+    for (auto& input : psbt.inputs) {
+        input = decodeInput(readMap(reader));
+    }
+    for (auto& output : psbt.outputs) {
+        output = readMap(reader);
+    }
+    if (!reader.empty()) {
+        throw std::invalid_argument("Data after the PSBT");
+    }
+    return psbt;
+}
+
+Data Psbt::encode() const {
+    auto data = Data(std::begin(psbtMagic), std::end(psbtMagic));
+
+    auto global = unknown;
+    transaction.encode(global[{globalUnsignedTransaction}], Transaction::NonSegwit);
+    writeMap(global, data);
+
+    for (const auto& input : inputs) {
+        writeMap(encodeInput(input), data);
+    }
+    for (const auto& output : outputs) {
+        writeMap(output, data);
+    }
+    return data;
+}
+
+void Psbt::combine(const Psbt& other) {
+    Data encoded;
+    transaction.encode(encoded, Transaction::NonSegwit);
+    Data otherEncoded;
+    other.transaction.encode(otherEncoded, Transaction::NonSegwit);
+    if (encoded != otherEncoded) {
+        throw std::invalid_argument("Different unsigned transactions");
+    }
+
+    // Existing values are kept
+    unknown.insert(other.unknown.begin(), other.unknown.end());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        auto& input = inputs[i];
+        const auto& from = other.inputs[i];
+        if (input.nonWitnessUtxo.empty()) {
+            input.nonWitnessUtxo = from.nonWitnessUtxo;
+        }
+        if (!input.witnessUtxo) {
+            input.witnessUtxo = from.witnessUtxo;
+        }
+        input.partialSignatures.insert(from.partialSignatures.begin(), from.partialSignatures.end());
+        if (!input.sighashType) {
+            input.sighashType = from.sighashType;
+        }
+        if (input.redeemScript.empty()) {
+            input.redeemScript = from.redeemScript;
+        }
+        if (input.witnessScript.empty()) {
+            input.witnessScript = from.witnessScript;
+        }
+        if (!input.finalScriptSig) {
+            input.finalScriptSig = from.finalScriptSig;
+        }
+        if (!input.finalScriptWitness) {
+            input.finalScriptWitness = from.finalScriptWitness;
+        }
+        input.unknown.insert(from.unknown.begin(), from.unknown.end());
+    }
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        outputs[i].insert(other.outputs[i].begin(), other.outputs[i].end());
+    }
+}
+
+std::optional<TransactionOutput> Psbt::spentOutput(size_t index) const {
+    const auto& input = inputs[index];
+    if (input.witnessUtxo) {
+        return input.witnessUtxo;
+    }
+    if (input.nonWitnessUtxo.empty()) {
+        return {};
+    }
+    try {
+        const auto previous = TransactionView::decode(input.nonWitnessUtxo);
+        const auto hash = previous.txid();
+        const auto& outPoint = transaction.inputs[index].previousOutput;
+        if (!std::equal(hash.begin(), hash.end(), outPoint.hash.begin(), outPoint.hash.end()) ||
+            outPoint.index >= previous.outputs.size()) {
+            return {};
+        }
+        const auto& output = previous.outputs[outPoint.index];
+        return TransactionOutput(output.value, Script(output.script.begin(), output.script.end()));
+    } catch (const std::invalid_argument&) {
+        return {};
+    }
+}
+
+size_t Psbt::sign(const std::vector<PrivateKey>& keys, size_t threadCount) {
+    struct Signer {
+        const PrivateKey* key;
+        Data publicKey;
+        Data keyHash;
+    };
+    std::vector<Signer> signers;
+    for (const auto& key : keys) {
+        for (const auto type : {TWPublicKeyTypeSECP256k1, TWPublicKeyTypeSECP256k1Extended}) {
+            auto publicKey = key.getPublicKey(type).bytes.toData();
+            auto keyHash = Hash::sha256ripemd(publicKey.data(), publicKey.size());
+            signers.push_back({&key, std::move(publicKey), std::move(keyHash)});
+        }
+    }
+
+    // The signature hashes are computed from the unsigned transaction, with its shared parts cached
+    auto unsignedTransaction = transaction;
+    unsignedTransaction.cacheSignatureHashes();
+
+    std::atomic<size_t> added(0);
+    std::atomic<size_t> next(0);
+    const auto worker = [&]() {
+        for (auto index = next++; index < inputs.size(); index = next++) {
+            auto& input = inputs[index];
+            if (input.isFinal()) {
+                continue;
+            }
+            const auto spent = spentOutput(index);
+            if (!spent) {
+                continue;
+            }
+            const auto how = spending(input, spent->script);
+            const auto hashType = static_cast<TWBitcoinSigHashType>(input.sighashType.value_or(TWBitcoinSigHashTypeAll));
+            if (!how || (hashTypeIsSingle(hashType) && index >= transaction.outputs.size())) {
+                continue;
+            }
+            Data sighash;
+            for (const auto& signer : signers) {
+                if (input.partialSignatures.count(signer.publicKey) != 0 ||
+                    !scriptUsesKey(how->script, signer.publicKey, signer.keyHash)) {
+                    continue;
+                }
+                if (sighash.empty()) {
+                    sighash = unsignedTransaction.getSignatureHash(how->script, index, hashType, spent->value, how->version);
+                }
+                auto signature = signer.key->signAsDER(sighash, TWCurveSECP256k1);
+                if (signature.empty()) {
+                    continue;
+                }
+                signature.push_back(static_cast<byte>(hashType));
+                input.partialSignatures.emplace(signer.publicKey, std::move(signature));
+                ++added;
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, inputs.size(), worker);
+    return added;
+}
+
+bool Psbt::finalize() {
+    auto complete = true;
+    for (size_t index = 0; index < inputs.size(); ++index) {
+        auto& input = inputs[index];
+        if (input.isFinal()) {
+            continue;
+        }
+        const auto spent = spentOutput(index);
+        const auto how = spent ? spending(input, spent->script) : std::nullopt;
+        std::vector<Data> stack;
+        if (!how || !satisfy(how->script, input.partialSignatures, stack)) {
+            complete = false;
+            continue;
+        }
+
+        std::vector<Data> scriptSig;
+        if (how->version == WITNESS_V0) {
+            if (how->pushWitnessScript) {
+                stack.push_back(how->script.bytes);
+            }
+            input.finalScriptWitness = std::move(stack);
+        } else {
+            scriptSig = std::move(stack);
+        }
+        if (how->pushRedeemScript) {
+            scriptSig.push_back(input.redeemScript.bytes);
+        }
+        if (!scriptSig.empty()) {
+            input.finalScriptSig = Script(TransactionSigner<Transaction, TransactionBuilder>::pushAll(scriptSig));
+        }
+
+        // The finalizer removes what was only needed for signing
+        input.partialSignatures.clear();
+        input.sighashType.reset();
+        input.redeemScript = Script();
+        input.witnessScript = Script();
+        for (auto it = input.unknown.begin(); it != input.unknown.end();) {
+            it = it->first[0] == inputBip32Derivation ? input.unknown.erase(it) : std::next(it);
+        }
+    }
+    return complete;
+}
+
+Transaction Psbt::extract() const {
+    auto signedTransaction = transaction;
+    for (size_t index = 0; index < inputs.size(); ++index) {
+        const auto& input = inputs[index];
+        if (!input.isFinal()) {
+            throw std::invalid_argument("Input is not finalized");
+        }
+        signedTransaction.inputs[index].script = input.finalScriptSig.value_or(Script());
+        signedTransaction.inputs[index].scriptWitness = input.finalScriptWitness.value_or(std::vector<Data>());
+    }
+    return signedTransaction;
+}
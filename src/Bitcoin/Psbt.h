@@ -0,0 +1,111 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Script.h"
+#include "Transaction.h"
+#include "TransactionOutput.h"
+#include "../Data.h"
+#include "../PrivateKey.h"
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Partially signed Bitcoin transaction (BIP174, version 0), with the signer, combiner, finalizer
+/// and extractor roles.
+///
+/// The fields needed for signing are decoded; all other key-value pairs, BIP32 derivations
+/// included, are kept as serialized, so that a decode-encode round trip preserves them.
+class Psbt {
+  public:
+    /// Key-value pairs of a map, by serialized key (type and key data).
+    using Map = std::map<Data, Data>;
+
+    struct Input {
+        /// Previous transaction of the spent output, serialized.
+        Data nonWitnessUtxo;
+
+        /// Spent output, for witness inputs.
+        std::optional<TransactionOutput> witnessUtxo;
+
+        /// Signatures with their hash type byte, by public key.
+        std::map<Data, Data> partialSignatures;
+
+        /// Hash type for the signatures, SIGHASH_ALL if not set.
+        std::optional<uint32_t> sighashType;
+
+        Script redeemScript;
+        Script witnessScript;
+
+        /// Set once the input is finalized.
+        std::optional<Script> finalScriptSig;
+        std::optional<std::vector<Data>> finalScriptWitness;
+
+        /// Other key-value pairs.
+        Map unknown;
+
+        /// Whether the input has its final script sig or witness.
+        bool isFinal() const { return finalScriptSig.has_value() || finalScriptWitness.has_value(); }
+    };
+
+    /// Unsigned transaction, without script sigs and witnesses.
+    Transaction transaction;
+
+    /// Global key-value pairs other than the unsigned transaction.
+    Map unknown;
+
+    /// Input maps, one per transaction input.
+    std::vector<Input> inputs;
+
+    /// Output maps, one per transaction output, kept as serialized.
+    std::vector<Map> outputs;
+
+    /// Creates an empty PSBT for an unsigned transaction.
+    ///
+    /// @throws std::invalid_argument if an input has a script sig or a witness.
+    explicit Psbt(Transaction transaction);
+
+    /// Decodes a serialized PSBT.
+    ///
+    /// @throws std::invalid_argument if the PSBT is malformed.
+    static Psbt decode(DataView data);
+
+    /// Encodes the PSBT, maps in key order.
+    Data encode() const;
+
+    /// Adds the fields and signatures of a PSBT of the same transaction from another party.
+    ///
+    /// @throws std::invalid_argument if the unsigned transactions differ.
+    void combine(const Psbt& other);
+
+    /// Signs the non-final inputs which can be signed with the given keys, on several threads
+    /// (threadCount 0 uses the available hardware concurrency).  Returns the number of signatures added.
+    ///
+    /// Supported are P2PKH, P2WPKH and P2PK outputs, multisig redeem and witness scripts, and P2SH-wrapped witness programs.
+    size_t sign(const std::vector<PrivateKey>& keys, size_t threadCount = 0);
+
+    /// Builds the final script sig and witness of the inputs which have all their signatures,
+    /// and removes the signing data.  Returns whether all inputs are final.
+    bool finalize();
+
+    /// Returns the signed transaction.
+    ///
+    /// @throws std::invalid_argument if an input is not final.
+    Transaction extract() const;
+
+  private:
+    Psbt() = default;
+
+    /// Returns the output spent by an input, from the witness or non-witness UTXO.
+    std::optional<TransactionOutput> spentOutput(size_t index) const;
+};
+
+} // namespace TW::Bitcoin
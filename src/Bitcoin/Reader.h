@@ -0,0 +1,66 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../BinaryCoding.h"
+#include "../Data.h"
+
+#include <stdexcept>
+
+namespace TW::Bitcoin {
+
+/// Bounds-checked reader of serialized data, returning views into it.
+///
+/// @throws std::invalid_argument when reading past the end of the data.
+class Reader {
+  public:
+    explicit Reader(DataView data) : data(data) {}
+
+    bool empty() const { return position == data.size(); }
+
+    size_t remaining() const { return data.size() - position; }
+
+    /// Offset of the next byte to read.
+    size_t offset() const { return position; }
+
+    byte peek(size_t offset) const { return data[position + offset]; }
+
+    DataView bytes(uint64_t count) {
+        if (count > remaining()) {
+            throw std::invalid_argument("Unexpected end of data");
+        }
+        const auto view = DataView(data.data() + position, static_cast<size_t>(count));
+        position += static_cast<size_t>(count);
+        return view;
+    }
+
+    uint32_t uint32() { return decode32LE(bytes(4).data()); }
+
+    uint64_t uint64() { return decode64LE(bytes(8).data()); }
+
+    uint64_t varInt() {
+        const auto first = bytes(1)[0];
+        switch (first) {
+        case 0xfd:
+            return decode16LE(bytes(2).data());
+        case 0xfe:
+            return uint32();
+        case 0xff:
+            return uint64();
+        default:
+            return first;
+        }
+    }
+
+    DataView varBytes() { return bytes(varInt()); }
+
+  private:
+    DataView data;
+    size_t position = 0;
+};
+
+} // namespace TW::Bitcoin
@@ -50,6 +50,11 @@ bool Script::isPayToWitnessPublicKeyHash() const {
     return bytes.size() == 22 && bytes[0] == OP_0 && bytes[1] == 0x14;
 }
 
+bool Script::isPayToTaproot() const {
+    // Extra-fast test for pay-to-taproot
+    return bytes.size() == payToTaprootSize && bytes[0] == OP_1 && bytes[1] == 0x20;
+}
+
 bool Script::isWitnessProgram() const {
     if (bytes.size() < 4 || bytes.size() > 42) {
         return false;
@@ -60,61 +65,97 @@ bool Script::isWitnessProgram() const {
     return bytes[1] + 2 == bytes.size();
 }
 
-bool Script::matchPayToPublicKey(Data& result) const {
+bool Script::matchPayToPublicKey(DataView& result) const {
     if (bytes.size() == PublicKey::secp256k1ExtendedSize + 2 &&
         bytes[0] == PublicKey::secp256k1ExtendedSize && bytes.back() == OP_CHECKSIG) {
-        result.clear();
-        std::copy(std::begin(bytes) + 1, std::begin(bytes) + 1 + PublicKey::secp256k1Size,
-                  std::back_inserter(result));
+        result = DataView(bytes.data() + 1, PublicKey::secp256k1Size);
         return true;
     }
     if (bytes.size() == PublicKey::secp256k1Size + 2 && bytes[0] == PublicKey::secp256k1Size &&
         bytes.back() == OP_CHECKSIG) {
-        result.clear();
-        std::copy(std::begin(bytes) + 1, std::begin(bytes) + 1 + PublicKey::secp256k1Size,
-                  std::back_inserter(result));
+        result = DataView(bytes.data() + 1, PublicKey::secp256k1Size);
         return true;
     }
     return false;
 }
 
-bool Script::matchPayToPublicKeyHash(Data& result) const {
-    if (bytes.size() == 25 && bytes[0] == OP_DUP && bytes[1] == OP_HASH160 && bytes[2] == 20 &&
+bool Script::matchPayToPublicKeyHash(DataView& result) const {
+    if (bytes.size() == payToPublicKeyHashSize && bytes[0] == OP_DUP && bytes[1] == OP_HASH160 && bytes[2] == 20 &&
         bytes[23] == OP_EQUALVERIFY && bytes[24] == OP_CHECKSIG) {
-        result.clear();
-        std::copy(std::begin(bytes) + 3, std::begin(bytes) + 3 + 20, std::back_inserter(result));
+        result = DataView(bytes.data() + 3, 20);
         return true;
     }
     return false;
 }
 
-bool Script::matchPayToScriptHash(Data& result) const {
+bool Script::matchPayToScriptHash(DataView& result) const {
     if (!isPayToScriptHash()) {
         return false;
     }
-    result.clear();
-    std::copy(std::begin(bytes) + 2, std::begin(bytes) + 22, std::back_inserter(result));
+    result = DataView(bytes.data() + 2, 20);
     return true;
 }
 
-bool Script::matchPayToWitnessPublicKeyHash(Data& result) const {
+bool Script::matchPayToWitnessPublicKeyHash(DataView& result) const {
     if (!isPayToWitnessPublicKeyHash()) {
         return false;
     }
-    result.clear();
-    std::copy(std::begin(bytes) + 2, std::end(bytes), std::back_inserter(result));
+    result = DataView(bytes.data() + 2, bytes.size() - 2);
     return true;
 }
 
-bool Script::matchPayToWitnessScriptHash(Data& result) const {
+bool Script::matchPayToWitnessScriptHash(DataView& result) const {
     if (!isPayToWitnessScriptHash()) {
         return false;
     }
-    result.clear();
-    std::copy(std::begin(bytes) + 2, std::end(bytes), std::back_inserter(result));
+    result = DataView(bytes.data() + 2, bytes.size() - 2);
+    return true;
+}
+
+bool Script::matchPayToTaproot(DataView& result) const {
+    if (!isPayToTaproot()) {
+        return false;
+    }
+    result = DataView(bytes.data() + 2, bytes.size() - 2);
+    return true;
+}
+
+bool Script::matchDestination(DataView& result) const {
+    return matchPayToWitnessPublicKeyHash(result) || matchPayToPublicKeyHash(result) || matchPayToScriptHash(result) ||
+           matchPayToWitnessScriptHash(result) || matchPayToTaproot(result);
+}
+
+/// Calls the non-allocating matcher, and copies the result.
+template <typename Match>
+static bool copyMatch(const Script& script, Match match, Data& result) {
+    DataView view;
+    if (!(script.*match)(view)) {
+        return false;
+    }
+    result.assign(view.begin(), view.end());
     return true;
 }
 
+bool Script::matchPayToPublicKey(Data& result) const {
+    return copyMatch(*this, static_cast<bool (Script::*)(DataView&) const>(&Script::matchPayToPublicKey), result);
+}
+
+bool Script::matchPayToPublicKeyHash(Data& result) const {
+    return copyMatch(*this, static_cast<bool (Script::*)(DataView&) const>(&Script::matchPayToPublicKeyHash), result);
+}
+
+bool Script::matchPayToScriptHash(Data& result) const {
+    return copyMatch(*this, static_cast<bool (Script::*)(DataView&) const>(&Script::matchPayToScriptHash), result);
+}
+
+bool Script::matchPayToWitnessPublicKeyHash(Data& result) const {
+    return copyMatch(*this, static_cast<bool (Script::*)(DataView&) const>(&Script::matchPayToWitnessPublicKeyHash), result);
+}
+
+bool Script::matchPayToWitnessScriptHash(Data& result) const {
+    return copyMatch(*this, static_cast<bool (Script::*)(DataView&) const>(&Script::matchPayToWitnessScriptHash), result);
+}
+
 bool Script::matchMultisig(std::vector<Data>& keys, int& required) const {
     keys.clear();
     required = 0;
@@ -125,7 +166,7 @@ bool Script::matchMultisig(std::vector<Data>& keys, int& required) const {
 
     size_t it = 0;
     uint8_t opcode;
-    Data operand;
+    DataView operand;
 
     auto op = getScriptOp(it, opcode, operand);
     if (!op || !TWOpCodeIsSmallInteger(opcode)) {
@@ -137,10 +178,10 @@ bool Script::matchMultisig(std::vector<Data>& keys, int& required) const {
         if (!res) {
             break;
         }
-        if (!PublicKey::isValid(operand, TWPublicKeyTypeSECP256k1)) {
+        if (!PublicKey::isValid(operand.toData(), TWPublicKeyTypeSECP256k1)) {
             break;
         }
-        keys.push_back(operand);
+        keys.push_back(operand.toData());
     }
 
     if (!TWOpCodeIsSmallInteger(opcode)) {
@@ -159,7 +200,14 @@ bool Script::matchMultisig(std::vector<Data>& keys, int& required) const {
 }
 
 bool Script::getScriptOp(size_t& index, uint8_t& opcode, Data& operand) const {
-    operand.clear();
+    DataView view;
+    const auto result = getScriptOp(index, opcode, view);
+    operand.assign(view.begin(), view.end());
+    return result;
+}
+
+bool Script::getScriptOp(size_t& index, uint8_t& opcode, DataView& operand) const {
+    operand = DataView();
 
     // Read instruction
     if (index >= bytes.size()) {
@@ -199,15 +247,16 @@ bool Script::getScriptOp(size_t& index, uint8_t& opcode, Data& operand) const {
     if (bytes.size() - index < size) {
         return false;
     }
-    operand = Data(bytes.begin() + index, bytes.begin() + index + size);
+    operand = DataView(bytes.data() + index, size);
     index += size;
 
     return true;
 }
 
-Script Script::buildPayToPublicKeyHash(const Data& hash) {
+Script Script::buildPayToPublicKeyHash(DataView hash) {
     assert(hash.size() == 20);
     Script script;
+    script.bytes.reserve(payToPublicKeyHashSize);
     script.bytes.push_back(OP_DUP);
     script.bytes.push_back(OP_HASH160);
     script.bytes.push_back(20);
@@ -217,9 +266,10 @@ Script Script::buildPayToPublicKeyHash(const Data& hash) {
     return script;
 }
 
-Script Script::buildPayToScriptHash(const Data& scriptHash) {
+Script Script::buildPayToScriptHash(DataView scriptHash) {
     assert(scriptHash.size() == 20);
     Script script;
+    script.bytes.reserve(payToScriptHashSize);
     script.bytes.push_back(OP_HASH160);
     script.bytes.push_back(20);
     script.bytes.insert(script.bytes.end(), scriptHash.begin(), scriptHash.end());
@@ -227,85 +277,114 @@ Script Script::buildPayToScriptHash(const Data& scriptHash) {
     return script;
 }
 
-Script Script::buildPayToWitnessProgram(const Data& program) {
+Script Script::buildPayToWitnessProgram(DataView program) {
     assert(program.size() == 20 || program.size() == 32);
     Script script;
+    script.bytes.reserve(2 + program.size());
     script.bytes.push_back(OP_0);
     script.bytes.push_back(static_cast<byte>(program.size()));
     script.bytes.insert(script.bytes.end(), program.begin(), program.end());
-    assert(script.bytes.size() == 22 || script.bytes.size() == 34);
+    assert(script.bytes.size() == payToWitnessPublicKeyHashSize || script.bytes.size() == payToWitnessScriptHashSize);
     return script;
 }
 
-Script Script::buildPayToWitnessPublicKeyHash(const Data& hash) {
+Script Script::buildPayToWitnessPublicKeyHash(DataView hash) {
     assert(hash.size() == 20);
     return Script::buildPayToWitnessProgram(hash);
 }
 
-Script Script::buildPayToWitnessScriptHash(const Data& scriptHash) {
+Script Script::buildPayToWitnessScriptHash(DataView scriptHash) {
     assert(scriptHash.size() == 32);
     return Script::buildPayToWitnessProgram(scriptHash);
 }
 
+Script Script::buildPayToTaproot(DataView outputKey) {
+    assert(outputKey.size() == 32);
+    Script script;
+    script.bytes.reserve(payToTaprootSize);
+    script.bytes.push_back(OP_1);
+    script.bytes.push_back(static_cast<byte>(outputKey.size()));
+    script.bytes.insert(script.bytes.end(), outputKey.begin(), outputKey.end());
+    return script;
+}
+
 void Script::encode(Data& data) const {
     encodeVarInt(bytes.size(), data);
-    std::copy(std::begin(bytes), std::end(bytes), std::back_inserter(data));
+    data.insert(data.end(), bytes.begin(), bytes.end());
+}
+
+size_t Script::encodedSize() const {
+    return varIntSize(bytes.size()) + bytes.size();
 }
 
 Script Script::lockScriptForAddress(const std::string& string, enum TWCoinType coin) {
-    if (Address::isValid(string)) {
-        auto address = Address(string);
-        auto p2pkh = TW::p2pkhPrefix(coin);
-        auto p2sh = TW::p2shPrefix(coin);
-        if (p2pkh == address.bytes[0]) {
+    // each format is decoded once, in turn
+    std::array<byte, Address::size> bytes;
+    if (Base58::bitcoin.decodeCheck(string, bytes)) {
+        auto data = Data(bytes.begin() + 1, bytes.end());
+        if (TW::p2pkhPrefix(coin) == bytes[0]) {
             // address starts with 1/L
-            auto data = Data();
-            data.reserve(Address::size - 1);
-            std::copy(address.bytes.begin() + 1, address.bytes.end(), std::back_inserter(data));
             return buildPayToPublicKeyHash(data);
-        } else if (p2sh == address.bytes[0]) {
+        } else if (TW::p2shPrefix(coin) == bytes[0]) {
             // address starts with 3/M
-            auto data = Data();
-            data.reserve(Address::size - 1);
-            std::copy(address.bytes.begin() + 1, address.bytes.end(), std::back_inserter(data));
             return buildPayToScriptHash(data);
         }
-    } else if (SegwitAddress::isValid(string)) {
-        auto result = SegwitAddress::decode(string);
+        return {};
+    }
+    const auto segwit = SegwitAddress::decode(string);
+    if (std::get<2>(segwit)) {
         // address starts with bc/ltc
-        auto program = std::get<0>(result).witnessProgram;
-        return buildPayToWitnessProgram(program);
-    } else if (CashAddress::isValid(string)) {
-        auto address = CashAddress(string);
-        auto bitcoinAddress = address.legacyAddress();
-        return lockScriptForAddress(bitcoinAddress.string(), TWCoinTypeBitcoinCash);
-    } else if (Decred::Address::isValid(string)) {
-        auto bytes = Base58::bitcoin.decodeCheck(string, Hash::blake256d);
-        if (bytes[1] == TW::p2pkhPrefix(TWCoinTypeDecred)) {
-            return buildPayToPublicKeyHash(Data(bytes.begin() + 2, bytes.end()));
+        const auto& address = std::get<0>(segwit);
+        if (address.witnessVersion == 1 && address.witnessProgram.size() == 32) {
+            // address starts with bc1p
+            return buildPayToTaproot(address.witnessProgram);
         }
-        if (bytes[1] == TW::p2shPrefix(TWCoinTypeDecred)) {
-            return buildPayToScriptHash(Data(bytes.begin() + 2, bytes.end()));
+        if (address.witnessVersion != 0) {
+            // future witness versions, not supported
+            return {};
         }
-    } else if (Groestlcoin::Address::isValid(string)) {
-        auto address = Groestlcoin::Address(string);
-        auto data = Data();
-        data.reserve(Address::size - 1);
-        std::copy(address.bytes.begin() + 1, address.bytes.end(), std::back_inserter(data));
-        if (address.bytes[0] == TW::p2pkhPrefix(TWCoinTypeGroestlcoin)) {
+        return buildPayToWitnessProgram(address.witnessProgram);
+    }
+    std::array<byte, CashAddress::size> cashGroups;
+    if (CashAddress::decode(string, cashGroups)) {
+        const auto payload = CashAddress::payload(cashGroups);
+        const auto hash = DataView(payload.data() + 1, payload.size() - 1);
+        switch (payload[0]) {
+        case 0x00:
+            return buildPayToPublicKeyHash(hash);
+        case 0x08:
+            return buildPayToScriptHash(hash);
+        default:
+            return {};
+        }
+    }
+    decltype(Decred::Address::bytes) decred;
+    if (Base58::bitcoin.decodeCheck(string, decred, Hash::blake256d) && decred[0] == TW::staticPrefix(TWCoinTypeDecred)) {
+        auto data = Data(decred.begin() + 2, decred.end());
+        if (decred[1] == TW::p2pkhPrefix(TWCoinTypeDecred)) {
             return buildPayToPublicKeyHash(data);
         }
-        if (address.bytes[0] == TW::p2shPrefix(TWCoinTypeGroestlcoin)) {
+        if (decred[1] == TW::p2shPrefix(TWCoinTypeDecred)) {
             return buildPayToScriptHash(data);
         }
-    } else if (Zcash::TAddress::isValid(string)) {
-        auto address = Zcash::TAddress(string);
-        auto data = Data();
-        data.reserve(Address::size - 2);
-        std::copy(address.bytes.begin() + 2, address.bytes.end(), std::back_inserter(data));
-        if (address.bytes[1] == TW::p2pkhPrefix(TWCoinTypeZcash)) {
+    }
+    std::array<byte, Groestlcoin::Address::size> groestl;
+    if (Base58::bitcoin.decodeCheck(string, groestl, Hash::groestl512d)) {
+        auto data = Data(groestl.begin() + 1, groestl.end());
+        if (groestl[0] == TW::p2pkhPrefix(TWCoinTypeGroestlcoin)) {
+            return buildPayToPublicKeyHash(data);
+        }
+        if (groestl[0] == TW::p2shPrefix(TWCoinTypeGroestlcoin)) {
+            return buildPayToScriptHash(data);
+        }
+        return {};
+    }
+    std::array<byte, Zcash::TAddress::size> zcash;
+    if (Base58::bitcoin.decodeCheck(string, zcash) && zcash[0] == Zcash::TAddress::staticPrefix) {
+        auto data = Data(zcash.begin() + 2, zcash.end());
+        if (zcash[1] == TW::p2pkhPrefix(TWCoinTypeZcash)) {
             return buildPayToPublicKeyHash(data);
-        } else if (address.bytes[1] == TW::p2shPrefix(TWCoinTypeZcash)) {
+        } else if (zcash[1] == TW::p2shPrefix(TWCoinTypeZcash)) {
             return buildPayToScriptHash(data);
         }
     }
@@ -19,6 +19,13 @@ namespace TW::Bitcoin {
 
 class Script {
   public:
+    /// Sizes of the standard scripts with a fixed length.
+    static constexpr size_t payToPublicKeyHashSize = 25;
+    static constexpr size_t payToScriptHashSize = 23;
+    static constexpr size_t payToWitnessPublicKeyHashSize = 22;
+    static constexpr size_t payToWitnessScriptHashSize = 34;
+    static constexpr size_t payToTaprootSize = 34;
+
     /// Script raw bytes.
     Data bytes;
 
@@ -47,6 +54,9 @@ class Script {
     /// Determines whether this is a pay-to-witness-public-key-hash (P2WPKH) script.
     bool isPayToWitnessPublicKeyHash() const;
 
+    /// Determines whether this is a pay-to-taproot (P2TR) script, a witness version 1 program with a 32-byte key.
+    bool isPayToTaproot() const;
+
     /// Determines whether this is a witness programm script.
     bool isWitnessProgram() const;
 
@@ -65,24 +75,43 @@ class Script {
     /// Matches the script to a pay-to-witness-script-hash (P2WSH).  Returns the script hash, a SHA256 of the witness script.
     bool matchPayToWitnessScriptHash(Data& scriptHash) const;
 
+    // Non-allocating versions of the matchers, the result is a view into `bytes`,
+    // valid as long as the script is alive and unchanged.
+
+    bool matchPayToPublicKey(DataView& publicKey) const;
+    bool matchPayToPublicKeyHash(DataView& keyHash) const;
+    bool matchPayToScriptHash(DataView& scriptHash) const;
+    bool matchPayToWitnessPublicKeyHash(DataView& keyHash) const;
+    bool matchPayToWitnessScriptHash(DataView& scriptHash) const;
+
+    /// Matches the script to a pay-to-taproot (P2TR) script.  Returns the x-only output key.
+    bool matchPayToTaproot(DataView& outputKey) const;
+
+    /// Matches the script to a standard output paying to a hash or key (P2PKH, P2SH, P2WPKH, P2WSH or P2TR).
+    /// Returns the key hash, script hash or output key, without the script type.
+    bool matchDestination(DataView& destination) const;
+
     /// Matches the script to a multisig script.
     bool matchMultisig(std::vector<Data>& publicKeys, int& required) const;
 
     /// Builds a pay-to-public-key-hash (P2PKH) script from a public key hash.
-    static Script buildPayToPublicKeyHash(const Data& hash);
+    static Script buildPayToPublicKeyHash(DataView hash);
 
     /// Builds a pay-to-script-hash (P2SH) script from a script hash.
-    static Script buildPayToScriptHash(const Data& scriptHash);
+    static Script buildPayToScriptHash(DataView scriptHash);
 
     /// Builds a pay-to-witness-program script, P2WSH or P2WPKH.
-    static Script buildPayToWitnessProgram(const Data& program);
+    static Script buildPayToWitnessProgram(DataView program);
 
     /// Builds a pay-to-witness-public-key-hash (P2WPKH) script from a public
     /// key hash.
-    static Script buildPayToWitnessPublicKeyHash(const Data& hash);
+    static Script buildPayToWitnessPublicKeyHash(DataView hash);
 
     /// Builds a pay-to-witness-script-hash (P2WSH) script from a script hash.
-    static Script buildPayToWitnessScriptHash(const Data& scriptHash);
+    static Script buildPayToWitnessScriptHash(DataView scriptHash);
+
+    /// Builds a pay-to-taproot (P2TR) script from an x-only output key.
+    static Script buildPayToTaproot(DataView outputKey);
 
     /// Builds a appropriate lock script for the given
     /// address.
@@ -91,6 +120,9 @@ class Script {
     /// Encodes the script.
     void encode(Data& data) const;
 
+    /// Size of the encoded script, with its length prefix.
+    size_t encodedSize() const;
+
     /// Encodes a small integer
     static inline uint8_t encodeNumber(int n) {
         assert(n >= 0 && n <= 16);
@@ -117,6 +149,9 @@ class Script {
     /// operand [out] the opcode's operand. \returns whether an opcode was
     /// available.
     bool getScriptOp(size_t& index, uint8_t& opcode, Data& operand) const;
+
+    /// Extracts a single opcode at the given index, the operand is a view into `bytes`.
+    bool getScriptOp(size_t& index, uint8_t& opcode, DataView& operand) const;
 };
 
 inline bool operator==(const Script& lhs, const Script& rhs) {
@@ -0,0 +1,128 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ScriptCache.h"
+
+using namespace TW::Bitcoin;
+
+ScriptCache& ScriptCache::shared() {
+    static ScriptCache cache;
+    return cache;
+}
+
+Script ScriptCache::lockScript(const std::string& address, enum TWCoinType coin) {
+    Script script;
+    if (find(address, coin, script)) {
+        return script;
+    }
+    script = Script::lockScriptForAddress(address, coin);
+    if (!script.empty()) {
+        insert(address, coin, script);
+    }
+    return script;
+}
+
+std::vector<Script> ScriptCache::lockScripts(const std::vector<std::string>& addresses, enum TWCoinType coin) {
+    auto scripts = std::vector<Script>(addresses.size());
+    // index of the first occurrence of each address missing from the cache
+    std::map<std::string, std::size_t> missing;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::size_t i = 0; i < addresses.size(); ++i) {
+            if (!findLocked(Key(coin, addresses[i]), scripts[i])) {
+                missing.emplace(addresses[i], i);
+            }
+        }
+    }
+    if (missing.empty()) {
+        return scripts;
+    }
+
+    // converted without holding the lock
+    for (const auto& [address, i] : missing) {
+        scripts[i] = Script::lockScriptForAddress(address, coin);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& [address, i] : missing) {
+            if (!scripts[i].empty()) {
+                insertLocked(Key(coin, address), scripts[i]);
+            }
+        }
+    }
+    for (std::size_t i = 0; i < addresses.size(); ++i) {
+        const auto found = missing.find(addresses[i]);
+        if (found != missing.end() && found->second != i) {
+            scripts[i] = scripts[found->second];
+        }
+    }
+    return scripts;
+}
+
+bool ScriptCache::find(const std::string& address, enum TWCoinType coin, Script& script) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return findLocked(Key(coin, address), script);
+}
+
+void ScriptCache::insert(const std::string& address, enum TWCoinType coin, const Script& script) {
+    std::lock_guard<std::mutex> lock(mutex);
+    insertLocked(Key(coin, address), script);
+}
+
+void ScriptCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+}
+
+std::size_t ScriptCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t ScriptCache::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maxSize;
+}
+
+void ScriptCache::setCapacity(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex);
+    maxSize = capacity;
+    index.clear();
+    entries.clear();
+}
+
+bool ScriptCache::findLocked(const Key& key, Script& script) {
+    if (maxSize == 0 || entries.empty()) {
+        return false;
+    }
+    const auto found = index.find(key);
+    if (found == index.end()) {
+        return false;
+    }
+    // move to front
+    entries.splice(entries.begin(), entries, found->second);
+    script = found->second->second;
+    return true;
+}
+
+void ScriptCache::insertLocked(Key key, const Script& script) {
+    if (maxSize == 0) {
+        return;
+    }
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        found->second->second = script;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    while (entries.size() >= maxSize) {
+        index.erase(entries.back().first);
+        entries.pop_back();
+    }
+    entries.emplace_front(key, script);
+    index.emplace(std::move(key), entries.begin());
+}
@@ -0,0 +1,80 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Script.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <cstddef>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Thread-safe LRU cache of locking scripts, keyed by coin and address.
+///
+/// Used by the transaction builders and planners, which convert the same output and change addresses over and over
+/// (payouts to a set of customers, for example), to skip trying the address formats each time.
+/// Invalid addresses are not cached.
+class ScriptCache {
+  public:
+    static constexpr std::size_t defaultCapacity = 1024;
+
+    explicit ScriptCache(std::size_t capacity = defaultCapacity) : maxSize(capacity) {}
+
+    ScriptCache(const ScriptCache&) = delete;
+    ScriptCache& operator=(const ScriptCache&) = delete;
+
+    /// Cache used by the transaction builders.
+    static ScriptCache& shared();
+
+    /// Returns the locking script of an address, see Script::lockScriptForAddress; empty if the address is invalid.
+    Script lockScript(const std::string& address, enum TWCoinType coin);
+
+    /// Returns the locking scripts of addresses, in order, locking the cache once for all lookups and once for all
+    /// insertions. Repeated addresses are converted once.
+    std::vector<Script> lockScripts(const std::vector<std::string>& addresses, enum TWCoinType coin);
+
+    /// Looks up the locking script of an address; returns false if not cached.
+    bool find(const std::string& address, enum TWCoinType coin, Script& script);
+
+    /// Stores the locking script of an address, evicting the least recently used entry if full.
+    void insert(const std::string& address, enum TWCoinType coin, const Script& script);
+
+    /// Removes all cached scripts.
+    void clear();
+
+    /// Number of cached scripts.
+    std::size_t size() const;
+
+    /// Maximum number of cached scripts.
+    std::size_t capacity() const;
+
+    /// Changes the maximum number of cached scripts, 0 disables the cache. Clears the cache.
+    void setCapacity(std::size_t capacity);
+
+  private:
+    using Key = std::pair<enum TWCoinType, std::string>;
+    using Entry = std::pair<Key, Script>;
+
+    mutable std::mutex mutex;
+    std::size_t maxSize;
+    /// Cached entries, most recently used first.
+    std::list<Entry> entries;
+    std::map<Key, std::list<Entry>::iterator> index;
+
+    /// Both expect the mutex to be locked.
+    bool findLocked(const Key& key, Script& script);
+    void insertLocked(Key key, const Script& script);
+};
+
+} // namespace TW::Bitcoin
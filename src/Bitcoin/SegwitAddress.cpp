@@ -7,6 +7,7 @@
 
 #include "SegwitAddress.h"
 #include "../Bech32.h"
+#include "../Bip340.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrustWalletCore/TWHRP.h>
@@ -22,13 +23,8 @@ bool SegwitAddress::isValid(const std::string& string, const std::string& hrp) {
     if (!std::get<2>(decoded)) {
         return false;
     }
-    // extra step to check hrp
-    auto dec = Bech32::decode(string);
-    if (std::get<0>(dec) != hrp) {
-        return false;
-    }
-
-    return true;
+    // extra step to check hrp, as decoded
+    return std::get<1>(decoded) == hrp;
 }
 
 SegwitAddress::SegwitAddress(const PublicKey& publicKey, int witver, std::string hrp)
@@ -41,6 +37,19 @@ SegwitAddress::SegwitAddress(const PublicKey& publicKey, int witver, std::string
                          witnessProgram.data());
 }
 
+SegwitAddress SegwitAddress::taproot(const PublicKey& internalKey, std::string hrp) {
+    if (internalKey.type != TWPublicKeyTypeSECP256k1 && internalKey.type != TWPublicKeyTypeSECP256k1Extended) {
+        throw std::invalid_argument("Taproot address needs a SECP256k1 public key.");
+    }
+    const auto compressed = internalKey.compressed();
+    const auto xOnlyKey = DataView(compressed.bytes.data() + 1, compressed.bytes.size() - 1);
+    auto outputKey = Bip340::taprootOutputKey(xOnlyKey, DataView());
+    if (outputKey.empty()) {
+        throw std::invalid_argument("Invalid taproot internal key.");
+    }
+    return SegwitAddress(std::move(hrp), 1, std::move(outputKey));
+}
+
 std::tuple<SegwitAddress, std::string, bool> SegwitAddress::decode(const std::string& addr) {
     auto resp = std::make_tuple(SegwitAddress(), "", false);
     auto dec = Bech32::decode(addr);
@@ -46,6 +46,12 @@ class SegwitAddress {
     /// Initializes a Bech32 address with a public key and a HRP prefix.
     SegwitAddress(const PublicKey& publicKey, int witver, std::string hrp);
 
+    /// Initializes a pay-to-taproot (witness version 1) address for key-path spending by an internal public key,
+    /// without a script tree (BIP86).
+    ///
+    /// @throws std::invalid_argument if the key is not a SECP256k1 public key.
+    static SegwitAddress taproot(const PublicKey& internalKey, std::string hrp);
+
     /// Decodes a SegWit address.
     ///
     /// \returns a tuple with the address, hrp, and a success flag.
@@ -7,6 +7,8 @@
 #include "Signer.h"
 #include "Hash.h"
 #include "HexCoding.h"
+#include "SignerTraits.h"
+#include "../SigningOutputFields.h"
 #include "Transaction.h"
 #include "TransactionBuilder.h"
 #include "TransactionSigner.h"
@@ -29,18 +31,27 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
     }
 
     const auto& tx = result.payload();
-    *output.mutable_transaction() = tx.proto();
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldTransaction)) {
+        *output.mutable_transaction() = tx.proto();
+    }
 
+    const auto withId = SigningOutputFields::requested(TWAnySignerOutputFieldTransactionId);
+    if (!withId && !SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
+        return output;
+    }
     Data encoded;
     signer.encodeTx(tx, encoded);
-    output.set_encoded(encoded.data(), encoded.size());
-
-    Data txHashData = encoded;
-    if (tx.hasWitness()) {
-        txHashData.clear();
-        tx.encode(txHashData, Transaction::SegwitFormatMode::NonSegwit);
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
+        output.set_encoded(encoded.data(), encoded.size());
     }
-    auto txHash = Hash::sha256d(txHashData.data(), txHashData.size());
+    if (!withId) {
+        return output;
+    }
+
+    // the id hashes the encoding without the witnesses
+    const auto txHashData = tx.hasWitness() ? tx.stripWitness(encoded) : Data();
+    const auto& hashed = tx.hasWitness() ? txHashData : encoded;
+    auto txHash = SignerTraits<Transaction>::txidHasher(hashed.data(), hashed.size());
     std::reverse(txHash.begin(), txHash.end());
     output.set_transaction_id(hex(txHash));
     return output;
@@ -0,0 +1,59 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Hash.h"
+
+namespace TW::Bitcoin {
+struct Transaction;
+}
+namespace TW::Groestlcoin {
+struct Transaction;
+}
+namespace TW::Zcash {
+struct Transaction;
+}
+
+namespace TW::Bitcoin {
+
+/// Compile-time parameters of the coins signed with a transaction type of the Bitcoin family, the first template
+/// parameter of TransactionSigner.  The coin, only known at runtime, selects the transaction type in its Entry;
+/// the signer branches on these constants, so each instantiation only contains the code of its coins.
+///
+/// Parameters given by each signing input, like the fork id of the hash type, stay runtime values.
+template <typename Transaction>
+struct SignerTraits {
+    /// Hash of the non-witness encoding giving the transaction id.
+    static constexpr Hash::HasherSimpleType txidHasher = Hash::sha256d;
+    /// Whether taproot (BIP341) key-path spends can be signed.
+    static constexpr bool taproot = false;
+    /// Whether the signature hashes commit to an expiry height and a consensus branch (ZIP 243).
+    static constexpr bool expiry = false;
+};
+
+template <>
+struct SignerTraits<Bitcoin::Transaction> {
+    static constexpr Hash::HasherSimpleType txidHasher = Hash::sha256d;
+    static constexpr bool taproot = true;
+    static constexpr bool expiry = false;
+};
+
+template <>
+struct SignerTraits<Groestlcoin::Transaction> {
+    static constexpr Hash::HasherSimpleType txidHasher = Hash::sha256;
+    static constexpr bool taproot = false;
+    static constexpr bool expiry = false;
+};
+
+template <>
+struct SignerTraits<Zcash::Transaction> {
+    static constexpr Hash::HasherSimpleType txidHasher = Hash::sha256d;
+    static constexpr bool taproot = false;
+    static constexpr bool expiry = true;
+};
+
+} // namespace TW::Bitcoin
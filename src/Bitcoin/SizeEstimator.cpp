@@ -0,0 +1,187 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SizeEstimator.h"
+
+#include "OpCodes.h"
+#include "ScriptCache.h"
+#include "SigHashType.h"
+#include "../Hash.h"
+#include "../HexCoding.h"
+#include "../PrivateKey.h"
+#include "../PublicKey.h"
+
+#include <TrustWalletCore/TWBitcoinSigHashType.h>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+/// Signature placeholder size used in estimation mode.
+const int64_t signatureSize = 72;
+const int64_t publicKeySize = PublicKey::secp256k1Size;
+const int64_t uncompressedPublicKeySize = PublicKey::secp256k1ExtendedSize;
+
+int64_t varIntSize(uint64_t value) {
+    if (value < 0xfd) {
+        return 1;
+    }
+    if (value <= 0xffff) {
+        return 3;
+    }
+    if (value <= 0xffffffff) {
+        return 5;
+    }
+    return 9;
+}
+
+/// Size of a data push in a script, see TransactionSigner::pushAll().
+int64_t pushSize(int64_t size) {
+    if (size < OP_PUSHDATA1) {
+        return 1 + size;
+    }
+    if (size <= 0xff) {
+        return 2 + size;
+    }
+    if (size <= 0xffff) {
+        return 3 + size;
+    }
+    return 5 + size;
+}
+
+/// Size of a witness item.
+int64_t witnessItemSize(int64_t size) {
+    return varIntSize(size) + size;
+}
+
+/// Size of an input with the given scriptSig size, excluding the witness.
+int64_t baseInputSize(int64_t scriptSize) {
+    // outpoint, script, sequence
+    return 32 + 4 + varIntSize(scriptSize) + scriptSize + 4;
+}
+
+std::optional<Data> redeemScript(const Data& hash, const Proto::SigningInput& input) {
+    const auto it = input.scripts().find(hex(hash));
+    if (it == input.scripts().end() || it->second.empty()) {
+        return {};
+    }
+    return Data(it->second.begin(), it->second.end());
+}
+
+} // namespace
+
+std::optional<SizeEstimator::Size> SizeEstimator::inputSize(const Script& lockScript, const Proto::SigningInput& input) {
+    auto uncompressedKeyHashes = KeyHashes();
+    return inputSize(lockScript, input, uncompressedKeyHashes);
+}
+
+std::optional<SizeEstimator::Size> SizeEstimator::inputSize(const Script& lockScript, const Proto::SigningInput& input, KeyHashes& uncompressedKeyHashes) {
+    // witness of a P2WPKH spend: signature and public key
+    const auto keyWitnessSize = varIntSize(2) + witnessItemSize(signatureSize) + witnessItemSize(publicKeySize);
+    // an input without witness still encodes an empty item count
+    const auto emptyWitnessSize = varIntSize(0);
+
+    Data data;
+    std::vector<Data> keys;
+    int required;
+    if (lockScript.matchPayToPublicKeyHash(data)) {
+        if (!uncompressedKeyHashes.has_value()) {
+            uncompressedKeyHashes = std::set<Data>();
+            for (const auto& key : input.private_key()) {
+                const auto keyData = Data(key.begin(), key.end());
+                // a key of a signer backend is given by its public key
+                const auto publicKey = PublicKey::isValid(keyData, TWPublicKeyTypeSECP256k1)
+                                           ? PublicKey(keyData, TWPublicKeyTypeSECP256k1).extended()
+                                       : PublicKey::isValid(keyData, TWPublicKeyTypeSECP256k1Extended)
+                                           ? PublicKey(keyData, TWPublicKeyTypeSECP256k1Extended)
+                                           : PrivateKey(key).getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+                uncompressedKeyHashes->insert(Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size()));
+            }
+        }
+        const auto keySize = uncompressedKeyHashes->count(data) > 0 ? uncompressedPublicKeySize : publicKeySize;
+        return Size{baseInputSize(pushSize(signatureSize) + pushSize(keySize)), emptyWitnessSize};
+    }
+    if (lockScript.matchPayToPublicKey(data)) {
+        return Size{baseInputSize(pushSize(signatureSize)), emptyWitnessSize};
+    }
+    if (lockScript.matchPayToWitnessPublicKeyHash(data)) {
+        return Size{baseInputSize(0), keyWitnessSize};
+    }
+    if (lockScript.matchPayToScriptHash(data)) {
+        const auto redeem = redeemScript(data, input);
+        if (!redeem || !Script(*redeem).matchPayToWitnessPublicKeyHash(data)) {
+            return {};
+        }
+        // P2SH-P2WPKH, the scriptSig pushes the redeem script
+        return Size{baseInputSize(pushSize(static_cast<int64_t>(redeem->size()))), keyWitnessSize};
+    }
+    if (lockScript.matchPayToWitnessScriptHash(data)) {
+        const auto witnessScript = redeemScript(Hash::ripemd(data), input);
+        if (!witnessScript || !Script(*witnessScript).matchMultisig(keys, required)) {
+            return {};
+        }
+        // empty item (CHECKMULTISIG bug), signatures, witness script
+        const auto items = 1 + required + 1;
+        const auto witness = varIntSize(items) + witnessItemSize(0) + required * witnessItemSize(signatureSize) +
+                             witnessItemSize(static_cast<int64_t>(witnessScript->size()));
+        return Size{baseInputSize(0), witness};
+    }
+    return {};
+}
+
+int64_t SizeEstimator::outputSize(const Script& lockScript) {
+    const auto scriptSize = static_cast<int64_t>(lockScript.bytes.size());
+    // value, script
+    return 8 + varIntSize(scriptSize) + scriptSize;
+}
+
+std::optional<int64_t> SizeEstimator::virtualSize(const TransactionPlan& plan, const Proto::SigningInput& input) {
+    const auto coin = static_cast<TWCoinType>(input.coin_type());
+    auto& scriptCache = ScriptCache::shared();
+    const auto lockScriptTo = scriptCache.lockScript(input.to_address(), coin);
+    if (plan.utxos.empty() || lockScriptTo.empty()) {
+        return {};
+    }
+    std::vector<Script> outputScripts = {lockScriptTo};
+    if (plan.change > 0) {
+        outputScripts.push_back(scriptCache.lockScript(input.change_address(), coin));
+    }
+
+    // version, locktime
+    int64_t base = 4 + 4 + varIntSize(plan.utxos.size()) + varIntSize(outputScripts.size());
+    for (const auto& script : outputScripts) {
+        base += outputSize(script);
+    }
+
+    // with SIGHASH_SINGLE, inputs without a corresponding output are not signed
+    const auto hashSingle = hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
+    int64_t witness = 0;
+    auto hasWitness = false;
+    auto uncompressedKeyHashes = KeyHashes();
+    for (size_t i = 0; i < plan.utxos.size(); ++i) {
+        if (hashSingle && i >= outputScripts.size()) {
+            base += baseInputSize(0);
+            witness += varIntSize(0);
+            continue;
+        }
+        const auto& utxo = plan.utxos[i];
+        const auto size = inputSize(Script(utxo.script().begin(), utxo.script().end()), input, uncompressedKeyHashes);
+        if (!size) {
+            return {};
+        }
+        base += size->base;
+        witness += size->witness;
+        hasWitness = hasWitness || size->witness > varIntSize(0);
+    }
+
+    if (!hasWitness) {
+        return base;
+    }
+    // marker and flag
+    witness += 2;
+    return base + witness / 4 + (witness % 4 != 0);
+}
@@ -0,0 +1,65 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Script.h"
+#include "TransactionPlan.h"
+#include "../proto/Bitcoin.pb.h"
+
+#include <cstdint>
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Analytic size model of signed transactions, by script type, without building or signing them.
+///
+/// Sizes are the ones TransactionSigner produces in estimation mode: 72-byte signature placeholders,
+/// and compressed public keys unless a P2PKH output belongs to an uncompressed key of the input.
+/// Supported inputs: P2PK, P2PKH, P2WPKH, P2SH-P2WPKH and P2WSH multisig.
+class SizeEstimator {
+  public:
+    /// Serialized size of a transaction part, in bytes.
+    struct Size {
+        /// Size in the non-witness serialization.
+        int64_t base = 0;
+        /// Size of the witness data.
+        int64_t witness = 0;
+    };
+
+    /// Returns the size of an input spending the given locking script, nullopt if the script type is not supported
+    /// or a needed redeem script is not in `input`.
+    static std::optional<Size> inputSize(const Script& lockScript, const Proto::SigningInput& input);
+
+    /// Returns the sizes of inputs spending the given UTXOs, like `inputSize`, deriving the keys of `input` only once.
+    template <typename Utxos>
+    static std::vector<std::optional<Size>> inputSizes(const Utxos& utxos, const Proto::SigningInput& input) {
+        auto uncompressedKeyHashes = KeyHashes();
+        std::vector<std::optional<Size>> sizes;
+        sizes.reserve(utxos.size());
+        for (const auto& utxo : utxos) {
+            sizes.push_back(inputSize(Script(utxo.script().begin(), utxo.script().end()), input, uncompressedKeyHashes));
+        }
+        return sizes;
+    }
+
+    /// Returns the size of an output with the given locking script.
+    static int64_t outputSize(const Script& lockScript);
+
+    /// Returns the virtual size of the transaction built for the plan (recipient output, and change output if any),
+    /// computed like TransactionBuilder does for segwit transactions; nullopt if an input is not supported.
+    static std::optional<int64_t> virtualSize(const TransactionPlan& plan, const Proto::SigningInput& input);
+
+  private:
+    /// Hashes of the uncompressed public keys of the input's private keys, computed when first needed.
+    using KeyHashes = std::optional<std::set<Data>>;
+
+    static std::optional<Size> inputSize(const Script& lockScript, const Proto::SigningInput& input, KeyHashes& uncompressedKeyHashes);
+};
+
+} // namespace TW::Bitcoin
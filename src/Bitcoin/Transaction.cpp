@@ -8,7 +8,9 @@
 #include "Transaction.h"
 #include "SigHashType.h"
 #include "../BinaryCoding.h"
+#include "../Bip340.h"
 #include "../Hash.h"
+#include "../Hashers.h"
 #include "../Data.h"
 
 #include "SignatureVersion.h"
@@ -76,6 +78,9 @@ Data Transaction::getPreImage(const Script& scriptCode, size_t index,
 }
 
 Data Transaction::getPrevoutHash() const {
+    if (signatureHashCache) {
+        return signatureHashCache->prevoutHash;
+    }
     Data data;
     for (auto& input : inputs) {
         auto& outpoint = reinterpret_cast<const OutPoint&>(input.previousOutput);
@@ -86,6 +91,9 @@ Data Transaction::getPrevoutHash() const {
 }
 
 Data Transaction::getSequenceHash() const {
+    if (signatureHashCache) {
+        return signatureHashCache->sequenceHash;
+    }
     Data data;
     for (auto& input : inputs) {
         encode32LE(input.sequence, data);
@@ -95,6 +103,9 @@ Data Transaction::getSequenceHash() const {
 }
 
 Data Transaction::getOutputsHash() const {
+    if (signatureHashCache) {
+        return signatureHashCache->outputsHash;
+    }
     Data data;
     for (auto& output : outputs) {
         output.encode(data);
@@ -103,6 +114,27 @@ Data Transaction::getOutputsHash() const {
     return hash;
 }
 
+void Transaction::cacheSignatureHashes() {
+    signatureHashCache.reset();
+    auto cache = SignatureHashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash(), {}, {}};
+
+    encode32LE(version, cache.legacyInputs);
+    encodeVarInt(inputs.size(), cache.legacyInputs);
+    for (auto& input : inputs) {
+        reinterpret_cast<const OutPoint&>(input.previousOutput).encode(cache.legacyInputs);
+        encodeVarInt(0, cache.legacyInputs);
+        encode32LE(input.sequence, cache.legacyInputs);
+    }
+
+    encodeVarInt(outputs.size(), cache.legacyOutputs);
+    for (auto& output : outputs) {
+        output.encode(cache.legacyOutputs);
+    }
+    encode32LE(lockTime, cache.legacyOutputs);
+
+    signatureHashCache = std::move(cache);
+}
+
 void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
     bool useWitnessFormat = true;
     switch (segwitFormat) {
@@ -111,6 +143,7 @@ void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
         case Segwit: useWitnessFormat = true; break;
     }
 
+    data.reserve(data.size() + serializedSize(useWitnessFormat ? Segwit : NonSegwit));
     encode32LE(version, data);
 
     if (useWitnessFormat) {
@@ -139,15 +172,136 @@ void Transaction::encode(Data& data, enum SegwitFormatMode segwitFormat) const {
 }
 
 void Transaction::encodeWitness(Data& data) const {
+    data.reserve(data.size() + witnessSize());
     for (auto& input : inputs) {
         input.encodeWitness(data);
     }
 }
 
+size_t Transaction::serializedSize(enum SegwitFormatMode segwitFormat) const {
+    // version, lock time
+    size_t size = 4 + 4 + varIntSize(inputs.size()) + varIntSize(outputs.size());
+    for (auto& input : inputs) {
+        size += input.encodedSize();
+    }
+    for (auto& output : outputs) {
+        size += output.encodedSize();
+    }
+    if (segwitFormat == Segwit || (segwitFormat == IfHasWitness && hasWitness())) {
+        // marker, flag
+        size += 2 + witnessSize();
+    }
+    return size;
+}
+
+size_t Transaction::witnessSize() const {
+    size_t size = 0;
+    for (auto& input : inputs) {
+        size += input.witnessSize();
+    }
+    return size;
+}
+
+size_t Transaction::vsize() const {
+    const auto size = serializedSize(NonSegwit);
+    if (!hasWitness()) {
+        return size;
+    }
+    const auto witness = 2 + witnessSize();
+    return size + witness / 4 + (witness % 4 != 0);
+}
+
+Data Transaction::stripWitness(const Data& encoded) const {
+    const auto witness = witnessSize();
+    assert(encoded.size() == serializedSize(Segwit));
+    Data data;
+    data.reserve(encoded.size() - 2 - witness);
+    // version, then the inputs and outputs after the marker and flag, then the lock time after the witnesses
+    data.insert(data.end(), encoded.begin(), encoded.begin() + 4);
+    data.insert(data.end(), encoded.begin() + 6, encoded.end() - 4 - static_cast<std::ptrdiff_t>(witness));
+    data.insert(data.end(), encoded.end() - 4, encoded.end());
+    return data;
+}
+
 bool Transaction::hasWitness() const {
     return std::any_of(inputs.begin(), inputs.end(), [](auto& input) { return !input.scriptWitness.empty(); });    
 }
 
+TaprootSignatureHashCache Transaction::getTaprootSignatureHashes(const std::vector<TransactionOutput>& spentOutputs) const {
+    Data prevouts;
+    Data sequences;
+    for (auto& input : inputs) {
+        reinterpret_cast<const OutPoint&>(input.previousOutput).encode(prevouts);
+        encode32LE(input.sequence, sequences);
+    }
+    Data amounts;
+    Data scriptPubKeys;
+    for (auto& output : spentOutputs) {
+        encode64LE(output.value, amounts);
+        output.script.encode(scriptPubKeys);
+    }
+    Data serializedOutputs;
+    for (auto& output : outputs) {
+        output.encode(serializedOutputs);
+    }
+    return TaprootSignatureHashCache{Hash::sha256(prevouts), Hash::sha256(amounts), Hash::sha256(scriptPubKeys),
+                                     Hash::sha256(sequences), Hash::sha256(serializedOutputs)};
+}
+
+void Transaction::cacheTaprootSignatureHashes(const std::vector<TransactionOutput>& spentOutputs) {
+    taprootSignatureHashCache = getTaprootSignatureHashes(spentOutputs);
+}
+
+Data Transaction::getSignatureHashTaproot(size_t index, uint8_t hashType, const std::vector<TransactionOutput>& spentOutputs) const {
+    const auto baseType = hashType & ~TWBitcoinSigHashTypeAnyoneCanPay;
+    if ((hashType != 0 && (baseType < TWBitcoinSigHashTypeAll || baseType > TWBitcoinSigHashTypeSingle)) ||
+        index >= inputs.size() || spentOutputs.size() != inputs.size()) {
+        return {};
+    }
+    const auto anyoneCanPay = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0;
+    const auto single = baseType == TWBitcoinSigHashTypeSingle;
+    const auto none = baseType == TWBitcoinSigHashTypeNone;
+    if (single && index >= outputs.size()) {
+        return {};
+    }
+    const auto hashes = taprootSignatureHashCache ? *taprootSignatureHashCache : getTaprootSignatureHashes(spentOutputs);
+
+    Data message;
+    message.reserve(1 + 206);
+    // Epoch
+    message.push_back(0);
+    message.push_back(hashType);
+    encode32LE(version, message);
+    encode32LE(lockTime, message);
+    if (!anyoneCanPay) {
+        append(message, hashes.prevoutsHash);
+        append(message, hashes.amountsHash);
+        append(message, hashes.scriptPubKeysHash);
+        append(message, hashes.sequencesHash);
+    }
+    if (!single && !none) {
+        append(message, hashes.outputsHash);
+    }
+    // Spend type: key path, no annex
+    message.push_back(0);
+    if (anyoneCanPay) {
+        reinterpret_cast<const OutPoint&>(inputs[index].previousOutput).encode(message);
+        encode64LE(spentOutputs[index].value, message);
+        spentOutputs[index].script.encode(message);
+        encode32LE(inputs[index].sequence, message);
+    } else {
+        encode32LE(static_cast<uint32_t>(index), message);
+    }
+    if (single) {
+        Data output;
+        outputs[index].encode(output);
+        append(message, Hash::sha256(output));
+    }
+
+    const auto hash = Bip340::taggedHasher(Bip340::Tag::tapSighash).update(message).final();
+    return Data(hash.begin(), hash.end());
+}
+
 Data Transaction::getSignatureHash(const Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
                                    enum SignatureVersion version) const {
@@ -173,6 +327,11 @@ Data Transaction::getSignatureHashBase(const Script& scriptCode, size_t index,
                                        enum TWBitcoinSigHashType hashType) const {
     assert(index < inputs.size());
 
+    if (signatureHashCache && (hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
+        !hashTypeIsSingle(hashType) && !hashTypeIsNone(hashType)) {
+        return getSignatureHashBaseCached(scriptCode, index, hashType);
+    }
+
     Data data;
 
     encode32LE(version, data);
@@ -207,6 +366,45 @@ Data Transaction::getSignatureHashBase(const Script& scriptCode, size_t index,
     return hash;
 }
 
+/// Generates the legacy SIGHASH_ALL signature hash from the cached parts: the empty script of the
+/// signed input is replaced by scriptCode, the pre-image is never assembled for sha256d.
+Data Transaction::getSignatureHashBaseCached(const Script& scriptCode, size_t index,
+                                             enum TWBitcoinSigHashType hashType) const {
+    // outpoint, empty script and sequence
+    static const size_t emptyInputSize = 32 + 4 + 1 + 4;
+    const auto& inputsPart = signatureHashCache->legacyInputs;
+    const auto scriptOffset = inputsPart.size() - (inputs.size() - index) * emptyInputSize + 32 + 4;
+
+    Data script;
+    scriptCode.encode(script);
+    Data type;
+    encode32LE(hashType, type);
+
+    const DataView parts[] = {
+        DataView(inputsPart.data(), scriptOffset),
+        script,
+        DataView(inputsPart.data() + scriptOffset + 1, inputsPart.size() - scriptOffset - 1),
+        signatureHashCache->legacyOutputs,
+        type,
+    };
+
+    const auto function = hasher.target<Data (*)(const byte*, size_t)>();
+    if (function != nullptr && *function == &Hash::sha256d) {
+        auto sha256 = Hash::Sha256Hasher();
+        for (const auto& part : parts) {
+            sha256.update(part);
+        }
+        const auto hash = Hash::sha256Digest(sha256.final());
+        return Data(hash.begin(), hash.end());
+    }
+
+    Data preimage;
+    for (const auto& part : parts) {
+        preimage.insert(preimage.end(), part.begin(), part.end());
+    }
+    return Hash::hash(hasher, preimage);
+}
+
 void Transaction::serializeInput(size_t subindex, const Script& scriptCode, size_t index,
                                  enum TWBitcoinSigHashType hashType, Data& data) const {
     // In case of SIGHASH_ANYONECANPAY, only the input being signed is
@@ -14,10 +14,32 @@
 #include "../Data.h"
 
 #include "SignatureVersion.h"
+#include <optional>
 #include <vector>
 
 namespace TW::Bitcoin {
 
+/// Hashes of the signature pre-image that are the same for all inputs (BIP143 hashPrevouts, hashSequence, hashOutputs),
+/// and the serialized parts of the legacy SIGHASH_ALL pre-image, where only the script of the signed input differs.
+struct SignatureHashCache {
+    Data prevoutHash;
+    Data sequenceHash;
+    Data outputsHash;
+    /// Version and inputs, all with an empty script.
+    Data legacyInputs;
+    /// Outputs and lock time.
+    Data legacyOutputs;
+};
+
+/// Single SHA256 hashes of the BIP341 signature message that are the same for all inputs.
+struct TaprootSignatureHashCache {
+    Data prevoutsHash;
+    Data amountsHash;
+    Data scriptPubKeysHash;
+    Data sequencesHash;
+    Data outputsHash;
+};
+
 struct Transaction {
 public:
     /// Transaction data format version (note, this is signed)
@@ -61,6 +83,18 @@ public:
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the prevout, sequence and outputs hashes once, to be reused by the signature hash of every input.
+    /// The cache has to be cleared when the inputs' outpoints or sequences, or the outputs, are changed.
+    void cacheSignatureHashes();
+    void clearSignatureHashCache() {
+        signatureHashCache.reset();
+        taprootSignatureHashCache.reset();
+    }
+
+    /// Computes the hashes of the BIP341 signature message once, to be reused by the taproot signature hash of every input.
+    /// Like the other hashes, the cache has to be cleared when the inputs or the outputs are changed.
+    void cacheTaprootSignatureHashes(const std::vector<TransactionOutput>& spentOutputs);
+
     enum SegwitFormatMode {
         NonSegwit,
         IfHasWitness,
@@ -76,18 +110,48 @@ public:
     /// Encodes the witness part of the transaction into the provided buffer.
     void encodeWitness(Data& data) const;
 
+    /// Size of the encoding written by encode(), computed without encoding.
+    size_t serializedSize(enum SegwitFormatMode segwitFormat = SegwitFormatMode::IfHasWitness) const;
+
+    /// Size of the witness part written by encodeWitness().
+    size_t witnessSize() const;
+
+    /// Virtual size (BIP141): the non-witness size, plus a quarter of the witness part with the marker and flag,
+    /// rounded up.  The non-witness size if there is no witness.
+    size_t vsize() const;
+
+    /// Returns the non-witness encoding, the pre-image of the transaction id, from the encoding with the
+    /// witnesses (Segwit or IfHasWitness with a witness) of this transaction, without encoding it again.
+    Data stripWitness(const Data& encoded) const;
+
     bool hasWitness() const;
 
     /// Generates the signature hash for this transaction.
     Data getSignatureHash(const Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
                           uint64_t amount, enum SignatureVersion version) const;
 
+    /// Generates the BIP341 signature hash for a taproot key-path spend, given the outputs spent by all inputs.
+    /// The hash type 0 (SIGHASH_DEFAULT) signs like SIGHASH_ALL, with a signature without hash type byte.
+    ///
+    /// \returns the signature hash, or empty data if the hash type is invalid, the spent outputs don't match the inputs,
+    /// or there is no output for SIGHASH_SINGLE.
+    Data getSignatureHashTaproot(size_t index, uint8_t hashType, const std::vector<TransactionOutput>& spentOutputs) const;
+
     void serializeInput(size_t subindex, const Script&, size_t index, enum TWBitcoinSigHashType hashType, Data& data) const;
 
     /// Converts to Protobuf model
     Proto::Transaction proto() const;
 
 private:
+    /// Precomputed hashes, see cacheSignatureHashes().
+    std::optional<SignatureHashCache> signatureHashCache;
+
+    /// Precomputed hashes, see cacheTaprootSignatureHashes().
+    std::optional<TaprootSignatureHashCache> taprootSignatureHashCache;
+
+    /// Computes the BIP341 hashes, all single SHA256.
+    TaprootSignatureHashCache getTaprootSignatureHashes(const std::vector<TransactionOutput>& spentOutputs) const;
+
     /// Generates the signature hash for Witness version 0 scripts.
     Data getSignatureHashWitnessV0(const Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount) const;
@@ -95,6 +159,10 @@ private:
     /// Generates the signature hash for for scripts other than witness scripts.
     Data getSignatureHashBase(const Script& scriptCode, size_t index,
                               enum TWBitcoinSigHashType hashType) const;
+
+    /// Generates the legacy SIGHASH_ALL signature hash from the cached pre-image parts.
+    Data getSignatureHashBaseCached(const Script& scriptCode, size_t index,
+                                    enum TWBitcoinSigHashType hashType) const;
 };
 
 } // namespace TW::Bitcoin
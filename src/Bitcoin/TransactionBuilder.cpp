@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TransactionBuilder.h"
+#include "SizeEstimator.h"
 #include "TransactionSigner.h"
 
 #include "../Coin.h"
@@ -12,6 +13,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <optional>
 
 namespace TW::Bitcoin {
 
@@ -20,7 +22,7 @@ int64_t estimateSimpleFee(const FeeCalculator& feeCalculator, const TransactionP
     return feeCalculator.calculate(plan.utxos.size(), outputSize, byteFee);
 }
 
-/// Estimate encoded size by invoking sign(sizeOnly), get actual size
+/// Estimate encoded size with the analytic size model, or else by invoking sign(sizeOnly) to get the actual size
 int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionPlan& plan, int outputSize, const Bitcoin::Proto::SigningInput& input) {
     TWPurpose coinPurpose = TW::purpose(static_cast<TWCoinType>(input.coin_type()));
     if (coinPurpose != TWPurposeBIP84) {
@@ -28,6 +30,11 @@ int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionP
         return estimateSimpleFee(feeCalculator, plan, outputSize, input.byte_fee());
     }
 
+    // Analytic size for the common script types; for the others, sign to get the size
+    if (const auto vSize = SizeEstimator::virtualSize(plan, input); vSize.has_value()) {
+        return input.byte_fee() * *vSize;
+    }
+
     // duplicate input, with the current plan
     auto inputWithPlan = std::move(input);
     *inputWithPlan.mutable_plan() = plan.proto();
@@ -39,30 +46,107 @@ int64_t estimateSegwitFee(const FeeCalculator& feeCalculator, const TransactionP
         return estimateSimpleFee(feeCalculator, plan, outputSize, input.byte_fee());
     }
 
-    // Obtain the encoded size
-    auto transaction = result.payload();
-    Data dataNonSegwit;
-    transaction.encode(dataNonSegwit, Transaction::SegwitFormatMode::NonSegwit);
-    int64_t sizeNonSegwit = dataNonSegwit.size();
-    uint64_t vSize = 0;
-    // Check if there is segwit
-    if (!transaction.hasWitness()) {
-        // no segwit, virtual size is defined as non-segwit size
-        vSize = sizeNonSegwit;
-    } else {
-        Data dataWitness;
-        transaction.encodeWitness(dataWitness);
-        int64_t witnessSize = 2 + dataWitness.size();
-        // compute virtual size:  (smaller) non-segwit + 1/4 of the diff (witness-only)
-        // (in other way: 3/4 of (smaller) non-segwit + 1/4 of segwit size)
-        vSize = sizeNonSegwit + witnessSize/4 + (witnessSize % 4 != 0);
-    }
+    // Obtain the virtual size, without encoding
+    const auto vSize = static_cast<uint64_t>(result.payload().vsize());
     uint64_t fee = input.byte_fee() * vSize;
 
     return fee;
 }
 
-TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& input) {
+/// Returns the fee needed by a plan, with or without change output.
+static Amount requiredFee(const FeeCalculator& feeCalculator, TransactionPlan plan, bool withChange,
+                          const Bitcoin::Proto::SigningInput& input, std::optional<Amount> replacedFee, Amount extraFee) {
+    // a placeholder change, so that the change output is counted
+    plan.change = withChange ? 1 : 0;
+    plan.fee = 0;
+    auto fee = estimateSegwitFee(feeCalculator, plan, withChange ? 2 : 1, input);
+    if (replacedFee.has_value()) {
+        const auto virtualSize = input.byte_fee() > 0 ? fee / input.byte_fee() : fee;
+        fee = std::max(fee, *replacedFee + virtualSize);
+    }
+    return fee + extraFee;
+}
+
+/// Adjusts the change, or the amount in the max amount case, of a plan to pay the required fee, adding UTXOs which are not
+/// in the plan yet if needed.
+static TransactionPlan adjustFee(TransactionPlan plan, const Bitcoin::Proto::SigningInput& input, std::optional<Amount> replacedFee,
+                                 Amount extraFee) {
+    const auto& feeCalculator = getFeeCalculator(static_cast<TWCoinType>(input.coin_type()));
+    const auto dustThreshold = feeCalculator.calculateSingleInput(input.byte_fee());
+    // like plan(), an amount not less than the available one is a max amount
+    const auto maxAmount = input.use_max_amount() || input.amount() >= UnspentSelector::sum(input.utxo());
+
+    auto candidates = std::vector<Proto::UnspentTransaction>();
+    for (const auto& utxo : input.utxo()) {
+        const auto used = std::any_of(plan.utxos.begin(), plan.utxos.end(), [&utxo](const auto& selected) {
+            return selected.out_point().hash() == utxo.out_point().hash() && selected.out_point().index() == utxo.out_point().index();
+        });
+        if (!used) {
+            candidates.push_back(utxo);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) { return lhs.amount() > rhs.amount(); });
+
+    auto failed = plan;
+    failed.error = Common::Proto::Error_not_enough_utxos;
+    for (auto next = candidates.begin();; plan.utxos.push_back(*next++)) {
+        plan.availableAmount = UnspentSelector::sum(plan.utxos);
+        if (maxAmount) {
+            const auto fee = requiredFee(feeCalculator, plan, false, input, replacedFee, extraFee);
+            if (fee < plan.availableAmount) {
+                plan.fee = fee;
+                plan.amount = plan.availableAmount - fee;
+                plan.change = 0;
+                return plan;
+            }
+        } else {
+            const auto fee = requiredFee(feeCalculator, plan, true, input, replacedFee, extraFee);
+            if (plan.availableAmount >= plan.amount + fee + dustThreshold) {
+                plan.fee = fee;
+                plan.change = plan.availableAmount - plan.amount - fee;
+                return plan;
+            }
+            // without change, the excess goes to the fee
+            if (plan.availableAmount >= plan.amount + requiredFee(feeCalculator, plan, false, input, replacedFee, extraFee)) {
+                plan.fee = plan.availableAmount - plan.amount;
+                plan.change = 0;
+                return plan;
+            }
+        }
+        if (next == candidates.end()) {
+            return failed;
+        }
+    }
+}
+
+TransactionPlan TransactionBuilder::bumpFee(const TransactionPlan& previous, const Bitcoin::Proto::SigningInput& input, int64_t byteFee) {
+    if (previous.error != Common::Proto::OK) {
+        return previous;
+    }
+    if (previous.utxos.empty()) {
+        auto plan = previous;
+        plan.error = Common::Proto::Error_missing_input_utxos;
+        return plan;
+    }
+    auto bumpedInput = input;
+    bumpedInput.set_byte_fee(byteFee);
+    bumpedInput.clear_plan();
+    return adjustFee(previous, bumpedInput, previous.fee, 0);
+}
+
+TransactionPlan TransactionBuilder::planChildPaysForParent(const Bitcoin::Proto::SigningInput& input, int64_t parentVirtualSize,
+                                                           Amount parentFee) {
+    auto plan = TransactionBuilder::plan(input);
+    if (plan.error != Common::Proto::OK) {
+        return plan;
+    }
+    const auto parentDeficit = std::max(Amount(0), input.byte_fee() * parentVirtualSize - parentFee);
+    return adjustFee(plan, input, std::nullopt, parentDeficit);
+}
+
+/// Plans a transaction spending some of the given UTXOs, the input's or those of a UtxoSource.
+template <typename Utxos>
+static TransactionPlan planWithUtxos(const Bitcoin::Proto::SigningInput& input, const Utxos& utxos) {
     auto plan = TransactionPlan();
 
     const auto& feeCalculator = getFeeCalculator(static_cast<TWCoinType>(input.coin_type()));
@@ -71,7 +155,7 @@ TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& inp
 
     if (input.amount() == 0 && !maxAmount) {
         plan.error = Common::Proto::Error_zero_amount_requested;
-    } else if (input.utxo().empty()) {
+    } else if (utxos.empty()) {
         plan.error = Common::Proto::Error_missing_input_utxos;
     } else {
         // select UTXOs
@@ -79,17 +163,36 @@ TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& inp
 
         // if amount requested is the same or more than available amount, it cannot be satisifed, but
         // treat this case as MaxAmount, and send maximum available (which will be less)
-        if (!maxAmount && input.amount() >= UnspentSelector::sum(input.utxo())) {
+        if (!maxAmount && input.amount() >= UnspentSelector::sum(utxos)) {
             maxAmount = true;
         }
 
         auto output_size = 2;
+        // selected to need no change output, the excess goes to the fee
+        auto changeless = false;
         if (!maxAmount) {
             output_size = 2; // output + change
-            plan.utxos = unspentSelector.select(input.utxo(), plan.amount, input.byte_fee(), output_size);
+            switch (input.utxo_selection()) {
+            case Proto::BRANCH_AND_BOUND:
+                plan.utxos = unspentSelector.selectBranchAndBound(utxos, plan.amount, input.byte_fee());
+                if (!plan.utxos.empty()) {
+                    changeless = true;
+                    output_size = 1;
+                    break;
+                }
+                // no exact match, use knapsack
+                plan.utxos = unspentSelector.selectKnapsack(utxos, plan.amount, input.byte_fee(), output_size);
+                break;
+            case Proto::KNAPSACK:
+                plan.utxos = unspentSelector.selectKnapsack(utxos, plan.amount, input.byte_fee(), output_size);
+                break;
+            default:
+                plan.utxos = unspentSelector.select(utxos, plan.amount, input.byte_fee(), output_size);
+                break;
+            }
         } else {
             output_size = 1; // no change
-            plan.utxos = unspentSelector.selectMaxAmount(input.utxo(), input.byte_fee());
+            plan.utxos = unspentSelector.selectMaxAmount(utxos, input.byte_fee());
         }
 
         if (plan.utxos.size() == 0) {
@@ -104,7 +207,7 @@ TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& inp
                 assert(input.amount() <= plan.availableAmount);
                 plan.amount = input.amount();
                 plan.fee = 0;
-                plan.change = plan.availableAmount - plan.amount;
+                plan.change = changeless ? 0 : plan.availableAmount - plan.amount;
             } else {
                 plan.amount = plan.availableAmount;
                 plan.fee = 0;
@@ -127,6 +230,10 @@ TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& inp
 
             // compute change
             plan.change = plan.availableAmount - plan.amount - plan.fee;
+            if (changeless) {
+                plan.fee += plan.change;
+                plan.change = 0;
+            }
         }
     }
     assert(plan.change >= 0 && plan.change <= plan.availableAmount);
@@ -137,4 +244,12 @@ TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& inp
     return plan;
 }
 
+TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& input) {
+    return planWithUtxos(input, input.utxo());
+}
+
+TransactionPlan TransactionBuilder::plan(const Bitcoin::Proto::SigningInput& input, const UtxoSource& utxos) {
+    return planWithUtxos(input, UtxoSourceView(utxos));
+}
+
 } // namespace TW::Bitcoin
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include "ScriptCache.h"
 #include "Transaction.h"
 #include "TransactionPlan.h"
 #include "UnspentSelector.h"
+#include "UtxoSource.h"
 #include "../proto/Bitcoin.pb.h"
 #include <TrustWalletCore/TWCoinType.h>
 
@@ -21,11 +23,31 @@ public:
     /// Plans a transaction by selecting UTXOs and calculating fees.
     static TransactionPlan plan(const Bitcoin::Proto::SigningInput& input);
 
-    /// Builds a transaction by selecting UTXOs and calculating fees.
+    /// Plans a transaction spending some of the UTXOs of a source, in place of those of the input, which are ignored.
+    /// Only the selected UTXOs are materialized, into the plan.  To sign, set the plan in the input: the signer spends
+    /// the UTXOs of the plan.
+    static TransactionPlan plan(const Bitcoin::Proto::SigningInput& input, const UtxoSource& utxos);
+
+    /// Replans a transaction for a replacement (BIP125) at a higher byte fee, keeping its UTXOs in the same order,
+    /// so that the replacement can reuse their signatures if the hash type allows it.  The fee is taken from the change,
+    /// or from the amount with `use_max_amount`, and the fewest additional UTXOs of the input are added, largest first,
+    /// if that's not enough.  The new fee also pays for the relay of the replacement, 1 satoshi per virtual byte
+    /// over the fee of the replaced transaction.
+    ///
+    /// The replaced transaction has to signal replaceability, with an input sequence below 0xfffffffe.
+    static TransactionPlan bumpFee(const TransactionPlan& previous, const Bitcoin::Proto::SigningInput& input, int64_t byteFee);
+
+    /// Plans a child transaction spending an unconfirmed output of a parent (CPFP), whose fee raises the byte fee of
+    /// both together to the input's byte fee.
+    static TransactionPlan planChildPaysForParent(const Bitcoin::Proto::SigningInput& input, int64_t parentVirtualSize,
+                                                  Amount parentFee);
+
+    /// Builds a transaction by selecting UTXOs and calculating fees.  Locking scripts come from ScriptCache::shared().
     template <typename Transaction>
     static Transaction build(const TransactionPlan& plan, const std::string& toAddress,
                              const std::string& changeAddress, enum TWCoinType coin) {
-        auto lockingScriptTo = Script::lockScriptForAddress(toAddress, coin);
+        auto& scriptCache = ScriptCache::shared();
+        auto lockingScriptTo = scriptCache.lockScript(toAddress, coin);
         if (lockingScriptTo.empty()) {
             return {};
         }
@@ -34,7 +56,7 @@ public:
         tx.outputs.push_back(TransactionOutput(plan.amount, lockingScriptTo));
 
         if (plan.change > 0) {
-            auto lockingScriptChange = Script::lockScriptForAddress(changeAddress, coin);
+            auto lockingScriptChange = scriptCache.lockScript(changeAddress, coin);
             tx.outputs.push_back(TransactionOutput(plan.change, lockingScriptChange));
         }
 
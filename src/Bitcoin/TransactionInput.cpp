@@ -21,6 +21,19 @@ void TransactionInput::encodeWitness(Data& data) const {
     encodeVarInt(scriptWitness.size(), data);
     for (auto& item : scriptWitness) {
         encodeVarInt(item.size(), data);
-        std::copy(std::begin(item), std::end(item), std::back_inserter(data));
+        data.insert(data.end(), item.begin(), item.end());
     }
 }
+
+size_t TransactionInput::encodedSize() const {
+    // outpoint, script, sequence
+    return 32 + 4 + script.encodedSize() + 4;
+}
+
+size_t TransactionInput::witnessSize() const {
+    size_t size = varIntSize(scriptWitness.size());
+    for (auto& item : scriptWitness) {
+        size += varIntSize(item.size()) + item.size();
+    }
+    return size;
+}
@@ -42,6 +42,12 @@ class TransactionInput {
 
     /// Encodes the witness data into the provided buffer.
     void encodeWitness(Data& data) const;
+
+    /// Size of the encoded input, without the witness.
+    size_t encodedSize() const;
+
+    /// Size of the encoded witness data.
+    size_t witnessSize() const;
 };
 
 } // namespace TW::Bitcoin
@@ -30,6 +30,9 @@ struct TransactionOutput {
 
     /// Encodes the output into the provided buffer.
     void encode(std::vector<uint8_t>& data) const;
+
+    /// Size of the encoded output.
+    size_t encodedSize() const { return 8 + script.encodedSize(); }
 };
 
 } // namespace TW::Bitcoin
@@ -11,19 +11,72 @@
 #include "TransactionOutput.h"
 #include "UnspentSelector.h"
 #include "SigHashType.h"
+#include "SignerTraits.h"
 
 #include "../BinaryCoding.h"
+#include "../Bip340.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
+#include "../ThreadPool.h"
 #include "../Zcash/Transaction.h"
 #include "../Groestlcoin/Transaction.h"
+#include <algorithm>
 #include <tuple>
+#include <utility>
 
 using namespace TW;
 using namespace TW::Bitcoin;
 
+/// Calls a function with each index below count, on the threads of the shared pool.
+template <typename Function>
+static void forEachIndex(size_t count, const Function& function) {
+    ThreadPool::shared().parallelFor(count, 0, function);
+}
+
 template <typename Transaction, typename TransactionBuilder>
 Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign() {
+    return sign(nullptr);
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign(const Transaction& previous) {
+    return sign(&previous);
+}
+
+template <typename Transaction, typename TransactionBuilder>
+bool TransactionSigner<Transaction, TransactionBuilder>::canReuseSignature(const Transaction& previous, const Transaction& transaction,
+                                                                           size_t index, uint32_t hashType) {
+    // All signature hashes commit to the version and lock time
+    if (index >= previous.inputs.size() || index >= transaction.inputs.size() ||
+        (hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 || previous.version != transaction.version ||
+        previous.lockTime != transaction.lockTime) {
+        return false;
+    }
+    if constexpr (SignerTraits<Transaction>::expiry) {
+        if (previous.expiryHeight != transaction.expiryHeight || previous.branchId != transaction.branchId) {
+            return false;
+        }
+    }
+    const auto& previousInput = previous.inputs[index];
+    const auto& input = transaction.inputs[index];
+    if (!(previousInput.previousOutput == input.previousOutput) || previousInput.sequence != input.sequence ||
+        (previousInput.script.empty() && previousInput.scriptWitness.empty())) {
+        return false;
+    }
+    const auto type = static_cast<TWBitcoinSigHashType>(hashType);
+    if (hashTypeIsNone(type)) {
+        return true;
+    }
+    if (!hashTypeIsSingle(type) || index >= previous.outputs.size() || index >= transaction.outputs.size()) {
+        return false;
+    }
+    const auto& previousOutput = previous.outputs[index];
+    const auto& output = transaction.outputs[index];
+    return previousOutput.value == output.value && previousOutput.script == output.script;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign(const Transaction* previous) {
     if (plan.error != Common::Proto::OK) {
         // plan with error, fail
         return Result<Transaction, Common::Proto::SigningError>::failure(plan.error);
@@ -36,20 +89,47 @@ Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction,
     std::copy(std::begin(transaction.inputs), std::end(transaction.inputs),
               std::back_inserter(signedInputs));
 
-    const auto hashSingle = hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
-    for (auto i = 0; i < plan.utxos.size(); i++) {
-        // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
-        if (hashSingle && i >= transaction.outputs.size()) {
-            continue;
-        }
-        auto& utxo = plan.utxos[i];
-        auto script = Script(utxo.script().begin(), utxo.script().end());
-        if (i < transaction.inputs.size()) {
-            auto result = sign(script, i, utxo);
-            if (!result) {
-                return Result<Transaction, Common::Proto::SigningError>::failure(result.error());
+    // Outpoints, sequences and outputs don't change while signing, hash them only once
+    transaction.cacheSignatureHashes();
+    spentOutputs.clear();
+    if constexpr (SignerTraits<Transaction>::taproot) {
+        const auto spendsTaproot = std::any_of(plan.utxos.begin(), plan.utxos.end(), [](const auto& utxo) {
+            return Script(utxo.script().begin(), utxo.script().end()).isPayToTaproot();
+        });
+        if (spendsTaproot && plan.utxos.size() >= transaction.inputs.size()) {
+            for (size_t i = 0; i < transaction.inputs.size(); ++i) {
+                const auto& utxo = plan.utxos[i];
+                spentOutputs.emplace_back(utxo.amount(), Script(utxo.script().begin(), utxo.script().end()));
             }
+            transaction.cacheTaprootSignatureHashes(spentOutputs);
+        }
+    }
+    signMultisig(previous);
+
+    auto* backend = SignerBackend::current();
+    backendRequests.clear();
+    backendRequestKeys.clear();
+    backendSignatures.clear();
+    if (backend != nullptr && !backendKeys.empty() && !estimationMode) {
+        // A first pass collects the signature hashes of the backend keys, to sign them in a single request
+        collectingBackendDigests = true;
+        const auto collected = signInputs(previous);
+        collectingBackendDigests = false;
+        if (!collected) {
+            transaction.clearSignatureHashCache();
+            return Result<Transaction, Common::Proto::SigningError>::failure(collected.error());
         }
+        if (!signBackendDigests(*backend)) {
+            transaction.clearSignatureHashCache();
+            return Result<Transaction, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
+        }
+    }
+    const auto result = signInputs(previous);
+    backendRequestKeys.clear();
+    backendSignatures.clear();
+    transaction.clearSignatureHashCache();
+    if (!result) {
+        return Result<Transaction, Common::Proto::SigningError>::failure(result.error());
     }
 
     Transaction tx(transaction);
@@ -63,6 +143,159 @@ Result<Transaction, Common::Proto::SigningError> TransactionSigner<Transaction,
     return Result<Transaction, Common::Proto::SigningError>::success(std::move(tx));
 }
 
+template <typename Transaction, typename TransactionBuilder>
+Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::signInputs(const Transaction* previous) {
+    const auto hashSingle = hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
+    const auto count = std::min(plan.utxos.size(), transaction.inputs.size());
+    std::vector<Common::Proto::SigningError> errors(count, Common::Proto::OK);
+    const auto signInput = [&](size_t i) {
+        // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
+        if (hashSingle && i >= transaction.outputs.size()) {
+            return;
+        }
+        if (previous != nullptr && canReuseSignature(*previous, transaction, i, input.hash_type())) {
+            signedInputs[i] = previous->inputs[i];
+            return;
+        }
+        const auto& utxo = plan.utxos[i];
+        const auto result = sign(Script(utxo.script().begin(), utxo.script().end()), i, utxo);
+        if (!result) {
+            errors[i] = result.error();
+        }
+    };
+
+    if (collectingBackendDigests || estimationMode) {
+        // The backend requests are collected in order; estimation doesn't sign
+        for (size_t i = 0; i < count; ++i) {
+            signInput(i);
+            if (errors[i] != Common::Proto::OK) {
+                return Result<void, Common::Proto::SigningError>::failure(std::move(errors[i]));
+            }
+        }
+        return Result<void, Common::Proto::SigningError>::success();
+    }
+    // The signature hashes are precomputed and each input is signed into its own entry of signedInputs, sign them
+    // on several threads
+    forEachIndex(count, signInput);
+    for (auto error : errors) {
+        if (error != Common::Proto::OK) {
+            // the error of the first input which failed, as when signing in order
+            return Result<void, Common::Proto::SigningError>::failure(std::move(error));
+        }
+    }
+    return Result<void, Common::Proto::SigningError>::success();
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<std::vector<std::map<Data, Data>>, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::signPartial() {
+    if (plan.error != Common::Proto::OK) {
+        return Result<std::vector<std::map<Data, Data>>, Common::Proto::SigningError>::failure(plan.error);
+    }
+    if (transaction.inputs.size() == 0 || plan.utxos.size() == 0) {
+        return Result<std::vector<std::map<Data, Data>>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_input_utxos);
+    }
+
+    transaction.cacheSignatureHashes();
+    signMultisig(nullptr);
+    transaction.clearSignatureHashCache();
+    for (const auto& signatures : multisigSignatures) {
+        for (const auto& signature : signatures) {
+            if (signature.second.empty()) {
+                return Result<std::vector<std::map<Data, Data>>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
+            }
+        }
+    }
+    auto signatures = multisigSignatures;
+    return Result<std::vector<std::map<Data, Data>>, Common::Proto::SigningError>::success(std::move(signatures));
+}
+
+template <typename Transaction, typename TransactionBuilder>
+uint32_t TransactionSigner<Transaction, TransactionBuilder>::signatureVersion() const {
+    if ((input.hash_type() & TWBitcoinSigHashTypeFork) != 0) {
+        return WITNESS_V0;
+    }
+    return BASE;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Script TransactionSigner<Transaction, TransactionBuilder>::multisigScript(Script script, uint32_t& version) const {
+    DataView data;
+    if (script.matchPayToScriptHash(data)) {
+        script = Script(scriptForScriptHash(data));
+    }
+    if (script.matchPayToWitnessScriptHash(data)) {
+        script = Script(scriptForScriptHash(Hash::ripemd(data)));
+        version = WITNESS_V0;
+    }
+    std::vector<Data> keys;
+    int required;
+    if (!script.matchMultisig(keys, required)) {
+        return Script();
+    }
+    return script;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+void TransactionSigner<Transaction, TransactionBuilder>::signMultisig(const Transaction* previous) {
+    multisigSignatures.assign(transaction.inputs.size(), {});
+    if (estimationMode) {
+        return;
+    }
+
+    struct Task {
+        size_t index;
+        Data publicKey;
+        PrivateKey key;
+    };
+    const auto count = std::min(plan.utxos.size(), transaction.inputs.size());
+    const auto hashType = static_cast<TWBitcoinSigHashType>(input.hash_type());
+    std::vector<Script> scripts(count);
+    std::vector<uint32_t> versions(count);
+    std::vector<Task> tasks;
+    for (size_t i = 0; i < count; ++i) {
+        if ((hashTypeIsSingle(hashType) && i >= transaction.outputs.size()) ||
+            (previous != nullptr && canReuseSignature(*previous, transaction, i, input.hash_type()))) {
+            continue;
+        }
+        const auto& utxo = plan.utxos[i];
+        auto version = signatureVersion();
+        auto script = multisigScript(Script(utxo.script().begin(), utxo.script().end()), version);
+        std::vector<Data> keys;
+        int required;
+        if (!script.matchMultisig(keys, required)) {
+            continue;
+        }
+        for (auto& publicKey : keys) {
+            const auto pair = keyPairForPubKeyHash(Hash::sha256ripemd(publicKey.data(), publicKey.size()));
+            if (pair.has_value()) {
+                tasks.push_back(Task{i, std::move(publicKey), std::get<0>(pair.value())});
+            }
+        }
+        scripts[i] = std::move(script);
+        versions[i] = version;
+    }
+
+    // The signature hash of an input is the same for all its keys
+    std::vector<Data> sighashes(count);
+    forEachIndex(count, [&](size_t index) {
+        if (!scripts[index].empty()) {
+            sighashes[index] = transaction.getSignatureHash(scripts[index], index, hashType, plan.utxos[index].amount(),
+                                                            static_cast<SignatureVersion>(versions[index]));
+        }
+    });
+    std::vector<Data> signatures(tasks.size());
+    forEachIndex(tasks.size(), [&](size_t task) {
+        auto signature = tasks[task].key.signAsDER(sighashes[tasks[task].index], TWCurveSECP256k1);
+        if (!signature.empty()) {
+            signature.push_back(static_cast<uint8_t>(input.hash_type()));
+        }
+        signatures[task] = std::move(signature);
+    });
+    for (size_t task = 0; task < tasks.size(); ++task) {
+        multisigSignatures[tasks[task].index].emplace(std::move(tasks[task].publicKey), std::move(signatures[task]));
+    }
+}
+
 template <typename Transaction, typename TransactionBuilder>
 Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::sign(Script script, size_t index,
                                                   const Proto::UnspentTransaction& utxo) {
@@ -71,14 +304,7 @@ Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, Transac
     Script redeemScript;
     std::vector<Data> results;
 
-    uint32_t signatureVersion = [this]() {
-        if ((input.hash_type() & TWBitcoinSigHashTypeFork) != 0) {
-            return WITNESS_V0;
-        } else {
-            return BASE;
-        }
-    }();
-    auto result = signStep(script, index, utxo, signatureVersion);
+    auto result = signStep(script, index, utxo, signatureVersion());
     if (!result) {
         return Result<void, Common::Proto::SigningError>::failure(result.error());
     }
@@ -88,7 +314,7 @@ Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, Transac
 
     if (script.isPayToScriptHash()) {
         script = Script(results[0]);
-        auto result = signStep(script, index, utxo, signatureVersion);
+        auto result = signStep(script, index, utxo, signatureVersion());
         if (!result) {
             return Result<void, Common::Proto::SigningError>::failure(result.error());
         }
@@ -98,7 +324,7 @@ Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, Transac
     }
 
     std::vector<Data> witnessStack;
-    Data data;
+    DataView data;
     if (script.matchPayToWitnessPublicKeyHash(data)) {
         auto witnessScript = Script::buildPayToPublicKeyHash(results[0]);
         auto result = signStep(witnessScript, index, utxo, WITNESS_V0);
@@ -116,6 +342,13 @@ Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, Transac
         witnessStack = result.payload();
         witnessStack.push_back(move(witnessScript.bytes));
         results.clear();
+    } else if (script.matchPayToTaproot(data) && redeemScript.empty()) {
+        auto result = createTaprootSignature(data, index);
+        if (!result) {
+            return Result<void, Common::Proto::SigningError>::failure(result.error());
+        }
+        witnessStack = {result.payload()};
+        results.clear();
     } else if (script.isWitnessProgram()) {
         // Error: Unrecognized witness program.
         return Result<void, Common::Proto::SigningError>::failure(Common::Proto::Error_script_witness_program);
@@ -134,11 +367,10 @@ Result<void, Common::Proto::SigningError> TransactionSigner<Transaction, Transac
 template <typename Transaction, typename TransactionBuilder>
 Result<std::vector<Data>, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::signStep(
     Script script, size_t index, const Proto::UnspentTransaction& utxo, uint32_t version) const {
-    Transaction transactionToSign(transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = transaction.outputs;
+    // The signature hash doesn't depend on the scripts of the other inputs, sign the unsigned transaction
+    const auto& transactionToSign = transaction;
 
-    Data data;
+    DataView data;
     std::vector<Data> keys;
     int required;
 
@@ -159,8 +391,8 @@ Result<std::vector<Data>, Common::Proto::SigningError> TransactionSigner<Transac
         }
         return Result<std::vector<Data>, Common::Proto::SigningError>::success({redeemScript});
     }
-    if (script.matchPayToWitnessPublicKeyHash(data)) {
-        return Result<std::vector<Data>, Common::Proto::SigningError>::success({data});
+    if (script.matchPayToWitnessPublicKeyHash(data) || script.matchPayToTaproot(data)) {
+        return Result<std::vector<Data>, Common::Proto::SigningError>::success({data.toData()});
     }
     if (script.isWitnessProgram()) {
         // Error: Invalid sutput script
@@ -169,33 +401,50 @@ Result<std::vector<Data>, Common::Proto::SigningError> TransactionSigner<Transac
     if (script.matchMultisig(keys, required)) {
         auto results = std::vector<Data>{{}}; // workaround CHECKMULTISIG bug
         for (auto& pubKey : keys) {
-            if (results.size() >= required + 1) {
+            if (results.size() >= static_cast<size_t>(required) + 1) {
                 break;
             }
-            auto keyHash = Hash::ripemd(Hash::sha256(pubKey));
-            auto pair = keyPairForPubKeyHash(keyHash);
-            if (!pair.has_value() && !estimationMode) {
-                // Error: missing key
-                return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
+            if (estimationMode) {
+                results.push_back(createSignature(transactionToSign, script, std::nullopt, index, utxo.amount(), version));
+                continue;
+            }
+            // CHECKMULTISIG takes the signatures in the order of the keys, skip the keys without one
+            Data signature;
+            if (index < multisigSignatures.size() && multisigSignatures[index].count(pubKey) != 0) {
+                signature = multisigSignatures[index].at(pubKey);
+            } else if (auto pair = keyPairForPubKeyHash(Hash::ripemd(Hash::sha256(pubKey))); pair.has_value()) {
+                signature = createSignature(transactionToSign, script, pair, index, utxo.amount(), version);
+            } else if (auto backendKey = backendKeyForPubKeyHash(Hash::ripemd(Hash::sha256(pubKey))); backendKey.has_value()) {
+                signature = createBackendSignature(transactionToSign, script, *backendKey, index, utxo.amount(), version);
+            } else {
+                if (index < partialSignatures.size() && partialSignatures[index].count(pubKey) != 0) {
+                    results.push_back(partialSignatures[index].at(pubKey));
+                }
+                continue;
             }
-            auto signature = createSignature(transactionToSign, script, pair, index, utxo.amount(), version);
             if (signature.empty()) {
                 // Error: Failed to sign
                 return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
             }
             results.push_back(signature);
         }
-        results.resize(required + 1);
+        if (results.size() < static_cast<size_t>(required) + 1) {
+            // Error: missing key
+            return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
+        }
         return Result<std::vector<Data>, Common::Proto::SigningError>::success(std::move(results));
     }
     if (script.matchPayToPublicKey(data)) {
         auto keyHash = Hash::ripemd(Hash::sha256(data));
         auto pair = keyPairForPubKeyHash(keyHash);
-        if (!pair.has_value() && !estimationMode) {
+        const auto backendKey = pair.has_value() || estimationMode ? std::nullopt : backendKeyForPubKeyHash(keyHash);
+        if (!pair.has_value() && !estimationMode && !backendKey.has_value()) {
             // Error: Missing key
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
         }
-        auto signature = createSignature(transactionToSign, script, pair, index, utxo.amount(), version);
+        auto signature = backendKey.has_value()
+            ? createBackendSignature(transactionToSign, script, *backendKey, index, utxo.amount(), version)
+            : createSignature(transactionToSign, script, pair, index, utxo.amount(), version);
         if (signature.empty()) {
             // Error: Failed to sign
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
@@ -204,21 +453,27 @@ Result<std::vector<Data>, Common::Proto::SigningError> TransactionSigner<Transac
     }
     if (script.matchPayToPublicKeyHash(data)) {
         auto pair = keyPairForPubKeyHash(data);
-        if (!pair.has_value() && !estimationMode) {
+        const auto backendKey = pair.has_value() || estimationMode ? std::nullopt : backendKeyForPubKeyHash(data);
+        if (!pair.has_value() && !estimationMode && !backendKey.has_value()) {
             // Error: Missing keys
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
         }
-        auto signature = createSignature(transactionToSign, script, pair, index, utxo.amount(), version);
+        auto signature = backendKey.has_value()
+            ? createBackendSignature(transactionToSign, script, *backendKey, index, utxo.amount(), version)
+            : createSignature(transactionToSign, script, pair, index, utxo.amount(), version);
         if (signature.empty()) {
             // Error: Failed to sign
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
         }
+        if (backendKey.has_value()) {
+            return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, backendKey->bytes.toData()});
+        }
         if (!pair.has_value() && estimationMode) {
             // estimation mode, key is missing: use placeholder for public key
             return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, Data(PublicKey::secp256k1Size)});
         }
         auto pubkey = std::get<1>(pair.value());
-        return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, pubkey.bytes});
+        return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, pubkey.bytes.toData()});
     }
     // Error: Invalid output script
     return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_script_output);
@@ -248,6 +503,94 @@ Data TransactionSigner<Transaction, TransactionBuilder>::createSignature(
     return sig;
 }
 
+template <typename Transaction, typename TransactionBuilder>
+Data TransactionSigner<Transaction, TransactionBuilder>::createBackendSignature(const Transaction& transaction, const Script& script,
+                                                                               const PublicKey& publicKey, size_t index,
+                                                                               Amount amount, uint32_t version) const {
+    auto key = std::make_pair(index, publicKey.bytes.toData());
+    if (collectingBackendDigests) {
+        if (backendSignatures.emplace(key, Data()).second) {
+            auto sighash = transaction.getSignatureHash(script, index, static_cast<TWBitcoinSigHashType>(input.hash_type()), amount,
+                                                        static_cast<SignatureVersion>(version));
+            backendRequests.push_back(DigestSigningRequest{publicKey, std::move(sighash), TWCurveSECP256k1});
+            backendRequestKeys.push_back(std::move(key));
+        }
+        // Placeholder of the size of a DER signature
+        return Data(72);
+    }
+    const auto found = backendSignatures.find(key);
+    return found == backendSignatures.end() ? Data() : found->second;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+bool TransactionSigner<Transaction, TransactionBuilder>::signBackendDigests(SignerBackend& backend) {
+    if (backendRequests.empty()) {
+        return true;
+    }
+    const auto count = backendRequests.size();
+    std::vector<Data> signatures;
+    try {
+        signatures = backend.signVerified(std::move(backendRequests));
+    } catch (...) {
+        // backend failure, such as a lost connection
+        return false;
+    }
+    backendRequests.clear();
+    for (size_t i = 0; i < count; ++i) {
+        auto signature = backendDERSignature(signatures[i], TWCurveSECP256k1);
+        if (signature.empty()) {
+            return false;
+        }
+        signature.push_back(static_cast<uint8_t>(input.hash_type()));
+        backendSignatures[backendRequestKeys[i]] = std::move(signature);
+    }
+    return true;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+Result<Data, Common::Proto::SigningError> TransactionSigner<Transaction, TransactionBuilder>::createTaprootSignature(
+    DataView outputKey, size_t index) const {
+    if constexpr (!SignerTraits<Transaction>::taproot) {
+        // Error: Unrecognized witness program.
+        return Result<Data, Common::Proto::SigningError>::failure(Common::Proto::Error_script_witness_program);
+    } else {
+        // SIGHASH_ALL is signed as SIGHASH_DEFAULT, which saves the hash type byte
+        const auto hashType = input.hash_type() == TWBitcoinSigHashTypeAll ? 0 : input.hash_type();
+        if (hashType > UINT8_MAX || spentOutputs.empty()) {
+            return Result<Data, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
+        }
+        if (estimationMode) {
+            // Don't sign, only estimate signature size.  Return placeholder.
+            return Result<Data, Common::Proto::SigningError>::success(Data(hashType == 0 ? 64 : 65));
+        }
+        for (const auto& key : input.private_key()) {
+            if (!PrivateKey::isValid(Data(key.begin(), key.end()), TWCurveSECP256k1)) {
+                continue;
+            }
+            const auto tweaked = Bip340::taprootPrivateKey(PrivateKey(key), DataView());
+            if (tweaked.empty()) {
+                continue;
+            }
+            const auto tweakedKey = PrivateKey(tweaked);
+            const auto xOnlyKey = Bip340::xOnlyPublicKey(tweakedKey);
+            if (!std::equal(xOnlyKey.begin(), xOnlyKey.end(), outputKey.begin(), outputKey.end())) {
+                continue;
+            }
+            const auto sighash = transaction.getSignatureHashTaproot(index, static_cast<uint8_t>(hashType), spentOutputs);
+            // Deterministic like the ECDSA signatures, the auxiliary randomness is only a side-channel protection
+            auto signature = sighash.empty() ? Data() : Bip340::sign(tweakedKey, sighash, Data(32));
+            if (signature.empty()) {
+                return Result<Data, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
+            }
+            if (hashType != 0) {
+                signature.push_back(static_cast<byte>(hashType));
+            }
+            return Result<Data, Common::Proto::SigningError>::success(std::move(signature));
+        }
+        return Result<Data, Common::Proto::SigningError>::failure(Common::Proto::Error_missing_private_key);
+    }
+}
+
 template <typename Transaction, typename TransactionBuilder>
 Data TransactionSigner<Transaction, TransactionBuilder>::pushAll(const std::vector<Data>& results) {
     Data data;
@@ -274,22 +617,102 @@ Data TransactionSigner<Transaction, TransactionBuilder>::pushAll(const std::vect
 }
 
 template <typename Transaction, typename TransactionBuilder>
-std::optional<KeyPair> TransactionSigner<Transaction, TransactionBuilder>::keyPairForPubKeyHash(const Data& hash) const {
-    for (auto& key : input.private_key()) {
-        auto privKey = PrivateKey(key);
-        auto pubKeyExtended = privKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
-        auto pubKey = pubKeyExtended.compressed();
-        if (Hash::sha256ripemd(pubKey.bytes.data(), pubKey.bytes.size()) == hash) {
-            return std::make_tuple(privKey, pubKey);
-        } else if (Hash::sha256ripemd(pubKeyExtended.bytes.data(), pubKeyExtended.bytes.size()) == hash) {
-            return std::make_tuple(privKey, pubKeyExtended);
-        }
-    }
-    return {};
+std::map<typename TransactionSigner<Transaction, TransactionBuilder>::KeyHash, KeyPair>
+TransactionSigner<Transaction, TransactionBuilder>::indexKeyPairs(const Proto::SigningInput& input) {
+    struct Derived {
+        std::optional<KeyPair> pair;
+        std::optional<KeyPair> extendedPair;
+    };
+    const auto count = static_cast<size_t>(input.private_key_size());
+    std::vector<Derived> derived(count);
+    forEachIndex(count, [&](size_t index) {
+        try {
+            const auto& key = input.private_key(static_cast<int>(index));
+            auto privKey = PrivateKey(key);
+            auto pubKeyExtended = privKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+            auto pubKey = pubKeyExtended.compressed();
+            auto& entry = derived[index];
+            entry.pair = std::make_tuple(privKey, pubKey);
+            entry.extendedPair = std::make_tuple(privKey, pubKeyExtended);
+        } catch (...) {
+            // invalid key, never matches
+        }
+    });
+
+    // The hashes of both public keys of every valid key, in one batch
+    std::vector<Data> publicKeys;
+    publicKeys.reserve(2 * count);
+    for (const auto& entry : derived) {
+        if (entry.pair) {
+            publicKeys.push_back(std::get<1>(*entry.pair).bytes.toData());
+            publicKeys.push_back(std::get<1>(*entry.extendedPair).bytes.toData());
+        }
+    }
+    const auto hashes = Hash::sha256ripemdBatch(publicKeys);
+
+    // The first key matching a hash is used
+    std::map<KeyHash, KeyPair> index;
+    auto hash = hashes.begin();
+    for (auto& entry : derived) {
+        if (entry.pair) {
+            index.emplace(*hash++, std::move(*entry.pair));
+            index.emplace(*hash++, std::move(*entry.extendedPair));
+        }
+    }
+    return index;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+std::optional<KeyPair> TransactionSigner<Transaction, TransactionBuilder>::keyPairForPubKeyHash(DataView hash) const {
+    KeyHash key;
+    if (hash.size() != key.size()) {
+        return {};
+    }
+    std::copy(hash.begin(), hash.end(), key.begin());
+    const auto found = keyPairs.find(key);
+    if (found == keyPairs.end()) {
+        return {};
+    }
+    return found->second;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+std::map<typename TransactionSigner<Transaction, TransactionBuilder>::KeyHash, PublicKey>
+TransactionSigner<Transaction, TransactionBuilder>::indexBackendKeys(const Proto::SigningInput& input) {
+    std::map<KeyHash, PublicKey> index;
+    for (const auto& key : input.private_key()) {
+        const auto bytes = Data(key.begin(), key.end());
+        const auto type = bytes.size() == PublicKey::secp256k1Size ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeSECP256k1Extended;
+        if (!PublicKey::isValid(bytes, type)) {
+            continue;
+        }
+        const auto publicKey = PublicKey(bytes, type);
+        for (const auto& form : {publicKey.compressed(), publicKey.extended()}) {
+            const auto hash = Hash::sha256ripemd(form.bytes.data(), form.bytes.size());
+            KeyHash keyHash;
+            std::copy(hash.begin(), hash.end(), keyHash.begin());
+            index.emplace(keyHash, form);
+        }
+    }
+    return index;
+}
+
+template <typename Transaction, typename TransactionBuilder>
+std::optional<PublicKey> TransactionSigner<Transaction, TransactionBuilder>::backendKeyForPubKeyHash(DataView hash) const {
+    KeyHash key;
+    if (hash.size() != key.size() || backendKeys.empty()) {
+        return {};
+    }
+    std::copy(hash.begin(), hash.end(), key.begin());
+    const auto found = backendKeys.find(key);
+    if (found == backendKeys.end()) {
+        return {};
+    }
+    return found->second;
 }
 
 template <typename Transaction, typename TransactionBuilder>
-Data TransactionSigner<Transaction, TransactionBuilder>::scriptForScriptHash(const Data& hash) const {
+Data TransactionSigner<Transaction, TransactionBuilder>::scriptForScriptHash(DataView hash) const {
     auto hashString = hex(hash);
     auto it = input.scripts().find(hashString);
     if (it == input.scripts().end()) {
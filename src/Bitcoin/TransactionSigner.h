@@ -16,10 +16,13 @@
 #include "../PrivateKey.h"
 #include "../KeyPair.h"
 #include "../Result.h"
+#include "../SignerBackend.h"
 #include "../Zcash/Transaction.h"
 #include "../Zcash/TransactionBuilder.h"
 #include "../proto/Bitcoin.pb.h"
 
+#include <array>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -41,17 +44,44 @@ class TransactionSigner {
     /// Transaction being signed.
     Transaction transaction;
 
+    /// Multisig signatures of cosigners, with their hash type byte, by input index and public key, such as returned
+    /// by their `signPartial`; used for the keys of multisig scripts whose private key is not in the signing input.
+    std::vector<std::map<Data, Data>> partialSignatures;
+
   private:
     /// List of signed inputs.
     std::vector<TransactionInput> signedInputs;
 
     bool estimationMode = false;
 
+    /// Hash160 of a public key.
+    using KeyHash = std::array<byte, 20>;
+
+    /// Key pairs of the input's private keys, by hash of the compressed and the extended public key.
+    std::map<KeyHash, KeyPair> keyPairs;
+
+    /// Public keys given in place of private keys, whose private keys are in the SignerBackend of the signing thread,
+    /// by hash of the compressed and the extended public key.
+    std::map<KeyHash, PublicKey> backendKeys;
+
+    /// Set while the first pass of `sign` collects the signature hashes of the backend keys, into `backendRequests`.
+    mutable bool collectingBackendDigests = false;
+    mutable std::vector<DigestSigningRequest> backendRequests;
+    mutable std::vector<std::pair<size_t, Data>> backendRequestKeys;
+    /// Signatures of the backend keys, with their hash type byte, by input index and public key.
+    mutable std::map<std::pair<size_t, Data>, Data> backendSignatures;
+
+    /// Outputs spent by the inputs, for the taproot signature hash; empty if no input spends a taproot output.
+    std::vector<TransactionOutput> spentOutputs;
+
+    /// Multisig signatures with the input's private keys, by input index and public key; empty if signing failed.
+    std::vector<std::map<Data, Data>> multisigSignatures;
+
   public:
     /// Initializes a transaction signer with signing input.
     /// estimationMode: is set, no real signing is performed, only as much as needed to get the almost-exact signed size 
     TransactionSigner(const Bitcoin::Proto::SigningInput& input, bool estimationMode = false) :
-    input(input), estimationMode(estimationMode) {
+    input(input), estimationMode(estimationMode), keyPairs(indexKeyPairs(input)), backendKeys(indexBackendKeys(input)) {
       if (input.has_plan()) {
         plan = TransactionPlan(input.plan());
       } else {
@@ -62,11 +92,32 @@ class TransactionSigner {
       );
     }
 
-    /// Signs the transaction.
+    /// Initializes a transaction signer for an unsigned transaction spending the UTXOs of a plan, in order,
+    /// such as a payout batch.
+    TransactionSigner(const Bitcoin::Proto::SigningInput& input, TransactionPlan plan, Transaction transaction) :
+    input(input), plan(std::move(plan)), transaction(std::move(transaction)), keyPairs(indexKeyPairs(input)),
+    backendKeys(indexBackendKeys(input)) {}
+
+    /// Signs the transaction, the inputs on the threads of the shared pool.  The keys given by public key are signed with
+    /// by the SignerBackend of the current thread, in a single request for the entire transaction (not for taproot
+    /// key-path spends).
     ///
     /// \returns the signed transaction or an error.
     Result<Transaction, Common::Proto::SigningError> sign();
 
+    /// Signs a replacement of a signed transaction, such as one planned by `TransactionBuilder::bumpFee`, reusing the
+    /// signatures of the inputs whose signature hash is the same: inputs spending the same outpoint at the same index,
+    /// signed with ANYONECANPAY and NONE, or with ANYONECANPAY and SINGLE and the same output at their index.
+    Result<Transaction, Common::Proto::SigningError> sign(const Transaction& previous);
+
+    /// Signs the multisig inputs with the keys of the signing input only, for cosigners which hold the other keys.
+    ///
+    /// \returns the signatures, with their hash type byte, by input index and public key, or an error.
+    Result<std::vector<std::map<Data, Data>>, Common::Proto::SigningError> signPartial();
+
+    /// Whether the signature of an input of a previous transaction is valid for the same input of a transaction.
+    static bool canReuseSignature(const Transaction& previous, const Transaction& transaction, size_t index, uint32_t hashType);
+
     // helper, return binary encoded transaction (used right after sign())
     static void encodeTx(const Transaction& tx, Data& outData) { tx.encode(outData); }
 
@@ -74,17 +125,52 @@ class TransactionSigner {
     static Data pushAll(const std::vector<Data>& results);
 
   private:
+    Result<Transaction, Common::Proto::SigningError> sign(const Transaction* previous);
+    /// Signs the inputs into `signedInputs`, on several threads unless collecting the backend signature hashes or
+    /// estimating.  Fails with the error of the first input which can't be signed.
+    Result<void, Common::Proto::SigningError> signInputs(const Transaction* previous);
     Result<void, Common::Proto::SigningError> sign(Script script, size_t index, const Proto::UnspentTransaction& utxo);
     Result<std::vector<Data>, Common::Proto::SigningError> signStep(Script script, size_t index,
                                        const Proto::UnspentTransaction& utxo, uint32_t version) const;
     Data createSignature(const Transaction& transaction, const Script& script, const std::optional<KeyPair>&,
                          size_t index, Amount amount, uint32_t version) const;
 
+    /// Signature of a backend key: a placeholder while collecting the signature hashes, then the backend signature;
+    /// empty if the backend didn't sign it.
+    Data createBackendSignature(const Transaction& transaction, const Script& script, const PublicKey& publicKey,
+                                size_t index, Amount amount, uint32_t version) const;
+
+    /// Signs the collected signature hashes with `backend`; false if a signature is missing or invalid.
+    bool signBackendDigests(SignerBackend& backend);
+
+    /// Signature version of the signing input's hash type, for non-witness scripts.
+    uint32_t signatureVersion() const;
+
+    /// Returns the multisig script spent by a UTXO script, bare or through P2SH and P2WSH, and sets its signature
+    /// version; empty if the UTXO is not a multisig or its scripts are missing.
+    Script multisigScript(Script script, uint32_t& version) const;
+
+    /// Computes the multisig signatures of the inputs, the signature hash once per input and the (input, key)
+    /// signatures on several threads.  Inputs whose previous signature can be reused are skipped.
+    void signMultisig(const Transaction* previous);
+
+    /// Creates the BIP340 signature of a taproot key-path spend, with the key whose tweaked public key is the output key.
+    Result<Data, Common::Proto::SigningError> createTaprootSignature(DataView outputKey, size_t index) const;
+
+    /// Derives the public keys of the input's private keys, on several threads.
+    static std::map<KeyHash, KeyPair> indexKeyPairs(const Proto::SigningInput& input);
+
+    /// Indexes the secp256k1 public keys given in place of private keys.
+    static std::map<KeyHash, PublicKey> indexBackendKeys(const Proto::SigningInput& input);
+
     /// Returns the private key for the given public key hash.
-    std::optional<KeyPair> keyPairForPubKeyHash(const Data& hash) const;
+    std::optional<KeyPair> keyPairForPubKeyHash(DataView hash) const;
+
+    /// Returns the backend key for the given public key hash.
+    std::optional<PublicKey> backendKeyForPubKeyHash(DataView hash) const;
 
     /// Returns the redeem script for the given script hash.
-    Data scriptForScriptHash(const Data& hash) const;
+    Data scriptForScriptHash(DataView hash) const;
 };
 
 } // namespace TW::Bitcoin
@@ -0,0 +1,216 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TransactionView.h"
+
+#include "OpCodes.h"
+#include "Reader.h"
+#include "Script.h"
+
+#include "../Groestlcoin/Transaction.h"
+#include "../Hash.h"
+#include "../Hashers.h"
+#include "../PublicKey.h"
+#include "../ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+// Zcash Sapling
+const uint32_t zcashSaplingVersion = 0x80000004;
+const uint32_t zcashSaplingVersionGroupId = 0x892F2085;
+const size_t zcashSpendDescriptionSize = 384;
+const size_t zcashOutputDescriptionSize = 948;
+const size_t zcashJoinSplitSize = 1698;
+const size_t zcashJoinSplitKeyAndSignatureSize = 32 + 64;
+const size_t zcashBindingSignatureSize = 64;
+
+void readInputsAndOutputs(Reader& reader, TransactionView& view) {
+    const auto inputCount = reader.varInt();
+    // Each input has at least 41 bytes, don't let a bogus count reserve memory
+    view.inputs.reserve(static_cast<size_t>(std::min<uint64_t>(inputCount, reader.remaining() / 41)));
+    for (uint64_t i = 0; i < inputCount; ++i) {
+        auto& input = view.inputs.emplace_back();
+        input.previousHash = reader.bytes(32);
+        input.previousIndex = reader.uint32();
+        input.script = reader.varBytes();
+        input.sequence = reader.uint32();
+    }
+    const auto outputCount = reader.varInt();
+    view.outputs.reserve(static_cast<size_t>(std::min<uint64_t>(outputCount, reader.remaining() / 9)));
+    for (uint64_t i = 0; i < outputCount; ++i) {
+        auto& output = view.outputs.emplace_back();
+        output.value = static_cast<Amount>(reader.uint64());
+        output.script = reader.varBytes();
+    }
+}
+
+/// Skips `count` items of a fixed size, after their count.
+void skipItems(Reader& reader, uint64_t& count, size_t size) {
+    count = reader.varInt();
+    if (count > reader.remaining() / size) {
+        throw std::invalid_argument("Unexpected end of data");
+    }
+    reader.bytes(count * size);
+}
+
+/// Hashes consecutive parts of the serialized transaction, like Hash::sha256d or Hash::sha256.
+Data hashParts(std::initializer_list<DataView> parts, bool doubleHash) {
+    auto hasher = Hash::Sha256Hasher();
+    for (const auto& part : parts) {
+        hasher.update(part);
+    }
+    const auto hash = hasher.final();
+    if (doubleHash) {
+        return Hash::sha256(hash);
+    }
+    return Data(hash.begin(), hash.end());
+}
+
+} // namespace
+
+ScriptType Bitcoin::classifyScript(DataView script) {
+    const auto size = script.size();
+    if (size == Script::payToPublicKeyHashSize && script[0] == OP_DUP && script[1] == OP_HASH160 && script[2] == 20 &&
+        script[23] == OP_EQUALVERIFY && script[24] == OP_CHECKSIG) {
+        return ScriptType::payToPublicKeyHash;
+    }
+    if (size == Script::payToScriptHashSize && script[0] == OP_HASH160 && script[1] == 20 && script[22] == OP_EQUAL) {
+        return ScriptType::payToScriptHash;
+    }
+    if (size == Script::payToWitnessPublicKeyHashSize && script[0] == OP_0 && script[1] == 20) {
+        return ScriptType::payToWitnessPublicKeyHash;
+    }
+    if (size == Script::payToWitnessScriptHashSize && script[0] == OP_0 && script[1] == 32) {
+        return ScriptType::payToWitnessScriptHash;
+    }
+    if (size == Script::payToTaprootSize && script[0] == OP_1 && script[1] == 32) {
+        return ScriptType::payToTaproot;
+    }
+    if ((size == PublicKey::secp256k1Size + 2 || size == PublicKey::secp256k1ExtendedSize + 2) && script[0] == size - 2 &&
+        script[size - 1] == OP_CHECKSIG) {
+        return ScriptType::payToPublicKey;
+    }
+    if (size >= 1 && script[0] == OP_RETURN) {
+        return ScriptType::nullData;
+    }
+    return ScriptType::nonStandard;
+}
+
+TransactionView TransactionView::decode(DataView data, Format format) {
+    auto reader = Reader(data);
+    auto view = TransactionView();
+    view.format = format;
+    view.raw = data;
+    view.version = reader.uint32();
+
+    if (format == Format::zcash) {
+        view.versionGroupId = reader.uint32();
+        if (view.version != zcashSaplingVersion || view.versionGroupId != zcashSaplingVersionGroupId) {
+            throw std::invalid_argument("Not a Zcash Sapling transaction");
+        }
+        readInputsAndOutputs(reader, view);
+        view.lockTime = reader.uint32();
+        view.expiryHeight = reader.uint32();
+        view.valueBalance = static_cast<int64_t>(reader.uint64());
+        const auto shieldedOffset = reader.offset();
+        uint64_t spends;
+        uint64_t outputs;
+        uint64_t joinSplits;
+        skipItems(reader, spends, zcashSpendDescriptionSize);
+        skipItems(reader, outputs, zcashOutputDescriptionSize);
+        skipItems(reader, joinSplits, zcashJoinSplitSize);
+        if (joinSplits > 0) {
+            reader.bytes(zcashJoinSplitKeyAndSignatureSize);
+        }
+        if (spends > 0 || outputs > 0) {
+            reader.bytes(zcashBindingSignatureSize);
+        }
+        view.shieldedData = data.subView(shieldedOffset, reader.offset() - shieldedOffset);
+    } else {
+        // Segwit marker and flag (BIP144); like Bitcoin Core, a transaction without inputs is read as a segwit one
+        if (reader.remaining() >= 2 && reader.peek(0) == 0 && reader.peek(1) == 1) {
+            reader.bytes(2);
+            view.inputsOffset = reader.offset();
+        }
+        readInputsAndOutputs(reader, view);
+        if (view.inputsOffset != 0) {
+            view.witnessOffset = reader.offset();
+            for (auto& input : view.inputs) {
+                const auto itemCount = reader.varInt();
+                input.witness.reserve(static_cast<size_t>(std::min<uint64_t>(itemCount, reader.remaining())));
+                for (uint64_t i = 0; i < itemCount; ++i) {
+                    input.witness.push_back(reader.varBytes());
+                }
+            }
+        }
+        view.lockTime = reader.uint32();
+    }
+
+    if (!reader.empty()) {
+        throw std::invalid_argument("Data after the transaction");
+    }
+    return view;
+}
+
+Data TransactionView::txid() const {
+    const auto doubleHash = format != Format::groestlcoin;
+    if (!hasWitness()) {
+        return hashParts({raw}, doubleHash);
+    }
+    // Version, inputs and outputs, lock time
+    return hashParts({raw.subView(0, 4), raw.subView(inputsOffset, witnessOffset - inputsOffset), raw.subView(raw.size() - 4, 4)},
+                     doubleHash);
+}
+
+Data TransactionView::wtxid() const {
+    return hashParts({raw}, format != Format::groestlcoin);
+}
+
+void TransactionView::computeIds(const std::vector<TransactionView>& transactions, std::vector<Data>& txids,
+                                 std::vector<Data>& wtxids, size_t threadCount) {
+    const auto count = transactions.size();
+    txids.assign(count, Data());
+    wtxids.assign(count, Data());
+    std::atomic<size_t> next(0);
+    const auto worker = [&]() {
+        for (auto index = next++; index < count; index = next++) {
+            const auto& transaction = transactions[index];
+            wtxids[index] = transaction.wtxid();
+            txids[index] = transaction.hasWitness() ? transaction.txid() : wtxids[index];
+        }
+    };
+    ThreadPool::shared().run(threadCount, count, worker);
+}
+
+Transaction TransactionView::toTransaction() const {
+    if (format == Format::zcash) {
+        throw std::invalid_argument("Zcash transactions can't be converted");
+    }
+    auto transaction = format == Format::groestlcoin ? Transaction(Groestlcoin::Transaction()) : Transaction();
+    transaction.version = static_cast<int32_t>(version);
+    transaction.lockTime = lockTime;
+    transaction.inputs.reserve(inputs.size());
+    for (const auto& input : inputs) {
+        auto& converted = transaction.inputs.emplace_back(OutPoint(input.previousHash, input.previousIndex),
+                                                          Script(input.script.begin(), input.script.end()), input.sequence);
+        converted.scriptWitness.reserve(input.witness.size());
+        for (const auto& item : input.witness) {
+            converted.scriptWitness.push_back(item.toData());
+        }
+    }
+    transaction.outputs.reserve(outputs.size());
+    for (const auto& output : outputs) {
+        transaction.outputs.emplace_back(output.value, Script(output.script.begin(), output.script.end()));
+    }
+    return transaction;
+}
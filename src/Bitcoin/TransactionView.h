@@ -0,0 +1,112 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Amount.h"
+#include "Transaction.h"
+#include "../Data.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// Kinds of standard output scripts.
+enum class ScriptType {
+    nonStandard,
+    payToPublicKey,
+    payToPublicKeyHash,
+    payToScriptHash,
+    payToWitnessPublicKeyHash,
+    payToWitnessScriptHash,
+    payToTaproot,
+    nullData,
+};
+
+/// Classifies an output script, without copying it.
+ScriptType classifyScript(DataView script);
+
+/// Decoded serialized transaction, whose scripts, witness items and hashes are views into the serialized data.
+///
+/// The views are valid as long as the serialized data is; the decoded view doesn't own or copy it.
+class TransactionView {
+  public:
+    /// Serialization formats.
+    enum class Format {
+        /// Bitcoin and most forks, with or without witness data (BIP144).
+        bitcoin,
+        /// Bitcoin format, but transaction ids with a single SHA256.
+        groestlcoin,
+        /// Zcash version 4 (Sapling) transaction.
+        zcash,
+    };
+
+    struct Input {
+        /// Hash of the previous transaction, in serialized (little-endian) order.
+        DataView previousHash;
+        uint32_t previousIndex;
+        DataView script;
+        uint32_t sequence;
+        std::vector<DataView> witness;
+    };
+
+    struct Output {
+        Amount value;
+        DataView script;
+
+        ScriptType type() const { return classifyScript(script); }
+    };
+
+    Format format = Format::bitcoin;
+
+    /// Serialized transaction.
+    DataView raw;
+
+    /// Version, for Zcash including the overwintered flag.
+    uint32_t version = 0;
+    uint32_t lockTime = 0;
+
+    std::vector<Input> inputs;
+    std::vector<Output> outputs;
+
+    /// Zcash fields, shielded spends, outputs and join splits are not decoded but kept serialized.
+    uint32_t versionGroupId = 0;
+    uint32_t expiryHeight = 0;
+    int64_t valueBalance = 0;
+    DataView shieldedData;
+
+    /// Decodes a serialized transaction.
+    ///
+    /// @throws std::invalid_argument if the transaction is malformed or has data after it.
+    static TransactionView decode(DataView data, Format format = Format::bitcoin);
+
+    /// Whether the transaction is serialized with witness data.
+    bool hasWitness() const { return witnessOffset != 0; }
+
+    /// Transaction id, hash of the transaction without witness data, in serialized order.
+    Data txid() const;
+
+    /// Witness transaction id, hash of the whole serialized transaction; the txid without witness data.
+    Data wtxid() const;
+
+    /// Computes the transaction ids and witness transaction ids of many transactions, on several threads
+    /// (threadCount 0 uses the available hardware concurrency).
+    static void computeIds(const std::vector<TransactionView>& transactions, std::vector<Data>& txids,
+                           std::vector<Data>& wtxids, size_t threadCount = 0);
+
+    /// Copies the decoded transaction into a `Transaction`.
+    ///
+    /// @throws std::invalid_argument for Zcash transactions.
+    Transaction toTransaction() const;
+
+  private:
+    /// Offsets of the inputs after the segwit marker and flag, and of the witness data, if any.
+    size_t inputsOffset = 0;
+    size_t witnessOffset = 0;
+};
+
+} // namespace TW::Bitcoin
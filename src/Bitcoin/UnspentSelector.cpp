@@ -5,6 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "UnspentSelector.h"
+#include "UtxoSource.h"
+
+#include "../Instrumentation.h"
 
 #include <algorithm>
 #include <cassert>
@@ -12,11 +15,143 @@
 using namespace TW;
 using namespace TW::Bitcoin;
 
-/// A selection of unspent transactions.
-struct Selection {
-    std::vector<Proto::UnspentTransaction> utxos;
-    int64_t total;
-};
+namespace {
+
+/// Compact view of UTXOs: amount (or effective value) and position in the original list.
+using IndexedAmounts = std::vector<std::pair<int64_t, size_t>>;
+
+/// Returns the amounts of the UTXOs, sorted increasing (by position for equal amounts).
+template <typename T>
+IndexedAmounts sortedAmounts(const T& utxos) {
+    auto amounts = IndexedAmounts();
+    amounts.reserve(utxos.size());
+    for (size_t i = 0; i < static_cast<size_t>(utxos.size()); ++i) {
+        amounts.emplace_back(utxos[i].amount(), i);
+    }
+    std::sort(amounts.begin(), amounts.end());
+    return amounts;
+}
+
+/// Returns the values of the UTXOs less their input fee, positive only, sorted decreasing.
+template <typename T>
+IndexedAmounts sortedEffectiveValues(const T& utxos, int64_t inputFee) {
+    auto values = IndexedAmounts();
+    for (size_t i = 0; i < static_cast<size_t>(utxos.size()); ++i) {
+        const auto value = utxos[i].amount() - inputFee;
+        if (value > 0) {
+            values.emplace_back(value, i);
+        }
+    }
+    std::sort(values.begin(), values.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+    });
+    return values;
+}
+
+/// Copies the UTXOs of the given entries, those with an amount above minAmount.
+template <typename T, typename Iterator>
+std::vector<Proto::UnspentTransaction> collect(const T& utxos, Iterator begin, Iterator end, int64_t minAmount) {
+    std::vector<Proto::UnspentTransaction> selected;
+    for (auto it = begin; it != end; ++it) {
+        const auto& utxo = utxos[it->second];
+        if (utxo.amount() > minAmount) {
+            selected.push_back(utxo);
+        }
+    }
+    return selected;
+}
+
+/// Depth-first search for the subset of candidates (decreasing values) with a total in [target, target + tolerance],
+/// the smallest excess found within a bounded number of tries.  Returns the positions of the subset in candidates.
+std::vector<size_t> branchAndBound(const IndexedAmounts& candidates, int64_t target, int64_t tolerance) {
+    static const size_t maxTries = 100000;
+
+    int64_t available = 0;
+    for (const auto& candidate : candidates) {
+        available += candidate.first;
+    }
+    if (available < target) {
+        return {};
+    }
+
+    // inclusion of the candidates decided so far, and best found
+    std::vector<bool> path;
+    std::vector<bool> best;
+    int64_t bestExcess = tolerance + 1;
+    int64_t value = 0;
+    for (size_t tries = 0; tries < maxTries; ++tries) {
+        auto backtrack = false;
+        if (value + available < target || value > target + tolerance) {
+            backtrack = true;
+        } else if (value >= target) {
+            if (value - target < bestExcess) {
+                best = path;
+                bestExcess = value - target;
+                if (bestExcess == 0) {
+                    break;
+                }
+            }
+            backtrack = true;
+        }
+
+        if (backtrack) {
+            // undo the trailing exclusions, then exclude the last included candidate instead
+            while (!path.empty() && !path.back()) {
+                available += candidates[path.size() - 1].first;
+                path.pop_back();
+            }
+            if (path.empty()) {
+                break;
+            }
+            path.back() = false;
+            value -= candidates[path.size() - 1].first;
+        } else {
+            const auto depth = path.size();
+            const auto candidateValue = candidates[depth].first;
+            available -= candidateValue;
+            if (depth > 0 && !path.back() && candidates[depth - 1].first == candidateValue) {
+                // same value as the excluded previous one, including it would repeat that branch
+                path.push_back(false);
+            } else {
+                path.push_back(true);
+                value += candidateValue;
+            }
+        }
+    }
+
+    std::vector<size_t> selected;
+    for (size_t i = 0; i < best.size(); ++i) {
+        if (best[i]) {
+            selected.push_back(i);
+        }
+    }
+    return selected;
+}
+
+/// Single pass over candidates (decreasing values): the lowest one covering target alone,
+/// or the largest ones below target, accumulated until they cover it, if their total is lower.
+std::vector<size_t> knapsack(const IndexedAmounts& candidates, int64_t target) {
+    size_t lowestLarger = candidates.size();
+    std::vector<size_t> smaller;
+    int64_t smallerTotal = 0;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (candidates[i].first >= target) {
+            lowestLarger = i;
+        } else if (smallerTotal < target) {
+            smaller.push_back(i);
+            smallerTotal += candidates[i].first;
+        }
+    }
+    if (smallerTotal >= target && (lowestLarger == candidates.size() || smallerTotal <= candidates[lowestLarger].first)) {
+        return smaller;
+    }
+    if (lowestLarger != candidates.size()) {
+        return {lowestLarger};
+    }
+    return {};
+}
+
+} // namespace
 
 // Filters utxos that are dust
 template <typename T>
@@ -24,7 +159,7 @@ std::vector<Proto::UnspentTransaction>
 UnspentSelector::filterDustInput(const T& selectedUtxos, int64_t byteFee) {
     auto inputFeeLimit = feeCalculator.calculateSingleInput(byteFee);
     std::vector<Proto::UnspentTransaction> filteredUtxos;
-    for (auto utxo: selectedUtxos) {
+    for (const auto& utxo: selectedUtxos) {
         if (utxo.amount() > inputFeeLimit) {
             filteredUtxos.push_back(utxo);
         }
@@ -32,27 +167,10 @@ UnspentSelector::filterDustInput(const T& selectedUtxos, int64_t byteFee) {
     return filteredUtxos;
 }
 
-// Slice Array
-// [0,1,2,3,4,5,6,7,8,9].eachSlices(3)
-// >
-// [[0, 1, 2], [1, 2, 3], [2, 3, 4], [3, 4, 5], [4, 5, 6], [5, 6, 7], [6, 7, 8],
-// [7, 8, 9]]
-template <typename T>
-static inline auto slice(const T& elements, size_t sliceSize) {
-    std::vector<std::vector<Proto::UnspentTransaction>> slices;
-    for (auto i = 0; i <= elements.size() - sliceSize; i += 1) {
-        slices.emplace_back();
-        slices[i].reserve(sliceSize);
-        for (auto j = i; j < i + sliceSize; j += 1) {
-            slices[i].push_back(elements[j]);
-        }
-    }
-    return slices;
-}
-
 template <typename T>
 std::vector<Proto::UnspentTransaction>
 UnspentSelector::select(const T& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs) {
+    TW_INSTRUMENT_SCOPE("UnspentSelector::select");
     // if target value is zero, no UTXOs are needed
     if (targetValue == 0) {
         return {};
@@ -67,21 +185,21 @@ UnspentSelector::select(const T& utxos, int64_t targetValue, int64_t byteFee, in
     // definitions for the following caluculation
     const auto doubleTargetValue = targetValue * 2;
 
-    // Get all possible utxo selections up to a maximum size, sort by total amount, increasing
-    auto sortedUtxos = utxos;
-    std::sort(sortedUtxos.begin(), sortedUtxos.end(),
-              [](const Proto::UnspentTransaction& lhs, const Proto::UnspentTransaction& rhs) {
-                  return lhs.amount() < rhs.amount();
-              });
-    // Precompute maximum amount possible to obtain with given number of UTXOs
-    const auto n = sortedUtxos.size();
-    std::vector<uint64_t> maxWithXInputs = std::vector<uint64_t>();
-    maxWithXInputs.push_back(0);
-    int64_t maxSum = 0;
+    // Selections are windows of consecutive UTXOs, sorted by amount, increasing.
+    // Work on the amounts only; with prefix sums, the total of any window takes constant time.
+    const auto sorted = sortedAmounts(utxos);
+    const auto n = static_cast<int64_t>(sorted.size());
+    std::vector<int64_t> prefixSums(n + 1, 0);
     for (auto i = 0; i < n; ++i) {
-        maxSum += sortedUtxos[n - 1 - i].amount();
-        maxWithXInputs.push_back(maxSum);
+        prefixSums[i + 1] = prefixSums[i] + sorted[i].first;
     }
+    auto windowSum = [&prefixSums](int64_t start, int64_t size) {
+        return prefixSums[start + size] - prefixSums[start];
+    };
+    auto selection = [&](int64_t start, int64_t size) {
+        return collect(utxos, sorted.begin() + start, sorted.begin() + start + size,
+                       feeCalculator.calculateSingleInput(byteFee));
+    };
 
     // difference from 2x targetValue
     auto distFrom2x = [doubleTargetValue](int64_t val) -> int64_t {
@@ -100,50 +218,88 @@ UnspentSelector::select(const T& utxos, int64_t targetValue, int64_t byteFee, in
     for (int64_t numInputs = 1; numInputs <= n; ++numInputs) {
         const auto fee = feeCalculator.calculate(numInputs, numOutputs, byteFee);
         const auto targetWithFeeAndDust = targetValue + fee + dustThreshold;
-        if (maxWithXInputs[numInputs] < targetWithFeeAndDust) {
+        // the largest numInputs UTXOs make the last window
+        if (windowSum(n - numInputs, numInputs) < targetWithFeeAndDust) {
             // no way to satisfy with only numInputs inputs, skip
             continue;
         }
-        auto slices = slice(sortedUtxos, static_cast<size_t>(numInputs));
-        slices.erase(
-            std::remove_if(slices.begin(), slices.end(),
-                [targetWithFeeAndDust](const std::vector<Proto::UnspentTransaction>& slice) {
-                    return sum(slice) < targetWithFeeAndDust;
-                }),
-            slices.end());
-        if (!slices.empty()) {
-            std::sort(slices.begin(), slices.end(),
-                [distFrom2x](const std::vector<Proto::UnspentTransaction>& lhs,
-                            const std::vector<Proto::UnspentTransaction>& rhs) {
-                    return distFrom2x(sum(lhs)) < distFrom2x(sum(rhs));
-                });
-            return filterDustInput(slices.front(), byteFee);
+        auto best = n - numInputs;
+        for (auto start = best - 1; start >= 0; --start) {
+            const auto total = windowSum(start, numInputs);
+            if (total >= targetWithFeeAndDust && distFrom2x(total) <= distFrom2x(windowSum(best, numInputs))) {
+                best = start;
+            }
         }
+        return selection(best, numInputs);
     }
 
     // 2. If not, find a valid combination of outputs even if they produce dust change.
     for (int64_t numInputs = 1; numInputs <= n; ++numInputs) {
         const auto fee = feeCalculator.calculate(numInputs, numOutputs, byteFee);
         const auto targetWithFee = targetValue + fee;
-        if (maxWithXInputs[numInputs] < targetWithFee) {
+        if (windowSum(n - numInputs, numInputs) < targetWithFee) {
             // no way to satisfy with only numInputs inputs, skip
             continue;
         }
-        auto slices = slice(sortedUtxos, static_cast<size_t>(numInputs));
-        slices.erase(
-            std::remove_if(slices.begin(), slices.end(),
-                [targetWithFee](const std::vector<Proto::UnspentTransaction>& slice) {
-                    return sum(slice) < targetWithFee;
-                }),
-            slices.end());
-        if (!slices.empty()) {
-            return filterDustInput(slices.front(), byteFee);
+        // window totals increase with the start, take the first one large enough
+        auto start = int64_t(0);
+        while (windowSum(start, numInputs) < targetWithFee) {
+            ++start;
         }
+        return selection(start, numInputs);
     }
 
     return {};
 }
 
+template <typename T>
+std::vector<Proto::UnspentTransaction>
+UnspentSelector::selectBranchAndBound(const T& utxos, int64_t targetValue, int64_t byteFee) {
+    if (targetValue == 0 || utxos.empty()) {
+        return {};
+    }
+
+    const auto inputFee = feeCalculator.calculateSingleInput(byteFee);
+    // a change output costs its own fee, and the fee to spend it later
+    const auto noChangeFee = feeCalculator.calculate(0, 1, byteFee);
+    const auto costOfChange = feeCalculator.calculate(0, 2, byteFee) - noChangeFee + inputFee;
+
+    const auto candidates = sortedEffectiveValues(utxos, inputFee);
+    const auto positions = branchAndBound(candidates, targetValue + noChangeFee, costOfChange);
+
+    std::vector<Proto::UnspentTransaction> selected;
+    selected.reserve(positions.size());
+    for (auto position : positions) {
+        selected.push_back(utxos[candidates[position].second]);
+    }
+    return selected;
+}
+
+template <typename T>
+std::vector<Proto::UnspentTransaction>
+UnspentSelector::selectKnapsack(const T& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs) {
+    if (targetValue == 0 || utxos.empty()) {
+        return {};
+    }
+
+    const auto inputFee = feeCalculator.calculateSingleInput(byteFee);
+    const auto fee = feeCalculator.calculate(0, numOutputs, byteFee);
+    const auto candidates = sortedEffectiveValues(utxos, inputFee);
+
+    // prefer a change that is not dust, if possible
+    auto positions = knapsack(candidates, targetValue + fee + inputFee);
+    if (positions.empty()) {
+        positions = knapsack(candidates, targetValue + fee);
+    }
+
+    std::vector<Proto::UnspentTransaction> selected;
+    selected.reserve(positions.size());
+    for (auto position : positions) {
+        selected.push_back(utxos[candidates[position].second]);
+    }
+    return selected;
+}
+
 template <typename T>
 std::vector<Proto::UnspentTransaction>
 UnspentSelector::selectMaxAmount(const T& utxos, int64_t byteFee) {
@@ -152,5 +308,13 @@ UnspentSelector::selectMaxAmount(const T& utxos, int64_t byteFee) {
 
 template std::vector<Proto::UnspentTransaction> UnspentSelector::select(const ::google::protobuf::RepeatedPtrField<Proto::UnspentTransaction>& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs);
 template std::vector<Proto::UnspentTransaction> UnspentSelector::select(const std::vector<Proto::UnspentTransaction>& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectBranchAndBound(const ::google::protobuf::RepeatedPtrField<Proto::UnspentTransaction>& utxos, int64_t targetValue, int64_t byteFee);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectBranchAndBound(const std::vector<Proto::UnspentTransaction>& utxos, int64_t targetValue, int64_t byteFee);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectKnapsack(const ::google::protobuf::RepeatedPtrField<Proto::UnspentTransaction>& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectKnapsack(const std::vector<Proto::UnspentTransaction>& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs);
 template std::vector<Proto::UnspentTransaction> UnspentSelector::selectMaxAmount(const ::google::protobuf::RepeatedPtrField<Proto::UnspentTransaction>& utxos, int64_t byteFee);
 template std::vector<Proto::UnspentTransaction> UnspentSelector::selectMaxAmount(const std::vector<Proto::UnspentTransaction>& utxos, int64_t byteFee);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::select(const UtxoSourceView& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectBranchAndBound(const UtxoSourceView& utxos, int64_t targetValue, int64_t byteFee);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectKnapsack(const UtxoSourceView& utxos, int64_t targetValue, int64_t byteFee, int64_t numOutputs);
+template std::vector<Proto::UnspentTransaction> UnspentSelector::selectMaxAmount(const UtxoSourceView& utxos, int64_t byteFee);
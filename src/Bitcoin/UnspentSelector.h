@@ -25,6 +25,22 @@ class UnspentSelector {
     std::vector<Proto::UnspentTransaction> select(const T& utxos, int64_t targetValue,
                                                   int64_t byteFee, int64_t numOutputs = 2);
 
+    /// Selects UTXOs with a branch and bound search (as in Bitcoin Core) for a combination that needs no change output:
+    /// its total, less the input fees, exceeds the target and the fee of a single output by less than the cost of a change.
+    ///
+    /// \returns the list of selected utxos or an empty list if there is no such combination.
+    template <typename T>
+    std::vector<Proto::UnspentTransaction> selectBranchAndBound(const T& utxos, int64_t targetValue, int64_t byteFee);
+
+    /// Selects UTXOs in a single pass over them, largest first: the smallest UTXO that covers the target and fees alone,
+    /// or the largest of the smaller ones until they cover it, whichever has the lower total.
+    ///
+    /// \returns the list of selected utxos or an empty list if there are
+    /// insufficient funds.
+    template <typename T>
+    std::vector<Proto::UnspentTransaction> selectKnapsack(const T& utxos, int64_t targetValue,
+                                                          int64_t byteFee, int64_t numOutputs = 2);
+
     /// Selects UTXOs for max amount; select all except those which would reduce output (dust).
     /// One output and no change is assumed.
     template <typename T>
@@ -37,7 +53,7 @@ class UnspentSelector {
     template <typename T>
     static inline int64_t sum(const T& utxos) {
         int64_t sum = 0;
-        for (auto& utxo : utxos) {
+        for (const auto& utxo : utxos) {
             sum += utxo.amount();
         }
         return sum;
@@ -0,0 +1,47 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "UtxoSource.h"
+
+#include <stdexcept>
+#include <type_traits>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+static_assert(std::is_trivially_copyable_v<UtxoRecord> && sizeof(UtxoRecord) == 56);
+
+CompactUtxoSource::CompactUtxoSource(const UtxoRecord* records, std::size_t count, std::vector<Data> scripts)
+    : external(records), externalCount(count), scriptTable(std::move(scripts)) {
+    for (std::size_t i = 0; i < count; ++i) {
+        if (records[i].script >= scriptTable.size()) {
+            throw std::invalid_argument("Invalid script index");
+        }
+    }
+}
+
+void CompactUtxoSource::add(const std::array<byte, 32>& hash, uint32_t index, uint32_t sequence, Amount amount, const Data& script) {
+    if (external != nullptr) {
+        throw std::logic_error("Cannot add to external records");
+    }
+    auto [position, inserted] = scriptIndices.emplace(script, static_cast<uint32_t>(scriptTable.size()));
+    if (inserted) {
+        scriptTable.push_back(script);
+    }
+    ownedRecords.push_back(UtxoRecord{amount, hash, index, sequence, position->second});
+}
+
+Proto::UnspentTransaction CompactUtxoSource::utxo(std::size_t index) const {
+    const auto& record = records()[index];
+    const auto& script = scriptTable[record.script];
+    auto utxo = Proto::UnspentTransaction();
+    utxo.mutable_out_point()->set_hash(record.hash.data(), record.hash.size());
+    utxo.mutable_out_point()->set_index(record.index);
+    utxo.mutable_out_point()->set_sequence(record.sequence);
+    utxo.set_script(script.data(), script.size());
+    utxo.set_amount(record.amount);
+    return utxo;
+}
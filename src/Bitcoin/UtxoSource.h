@@ -0,0 +1,138 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Amount.h"
+#include "../Data.h"
+#include "../proto/Bitcoin.pb.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+/// UTXOs to plan a transaction with, in place of the `utxo` list of a signing input, for sets too large to be
+/// materialized as protobuf messages.  The selection only reads the amounts; only the selected UTXOs are
+/// materialized, into the plan.  Thread-safe for concurrent reads.
+class UtxoSource {
+  public:
+    virtual ~UtxoSource() = default;
+
+    /// Number of UTXOs.
+    virtual std::size_t size() const = 0;
+
+    /// Amount of a UTXO, cheap: called for every UTXO by each selection.
+    virtual Amount amount(std::size_t index) const = 0;
+
+    /// Materializes a UTXO, called for the selected ones only.
+    virtual Proto::UnspentTransaction utxo(std::size_t index) const = 0;
+};
+
+/// UTXO of compact records, 56 bytes, with the amount first for the selection.  Records are trivially copyable,
+/// so an array of them can be written to a file as is and memory-mapped.
+struct UtxoRecord {
+    Amount amount;
+    /// Hash of the transaction of the output.
+    std::array<byte, 32> hash;
+    /// Index of the output in its transaction.
+    uint32_t index;
+    /// Sequence of the input spending it.
+    uint32_t sequence;
+    /// Index of the locking script in the script table of the source.
+    uint32_t script;
+};
+
+/// UTXOs of compact records, with a table of their locking scripts: the UTXOs of an address share one script.
+/// The records are either added, or an external array, such as a memory-mapped file, that must outlive the source.
+class CompactUtxoSource : public UtxoSource {
+  public:
+    CompactUtxoSource() = default;
+
+    /// Source of external records (not copied) whose script indices are in `scripts`.
+    ///
+    /// @throws std::invalid_argument if a record has an invalid script index.
+    CompactUtxoSource(const UtxoRecord* records, std::size_t count, std::vector<Data> scripts);
+
+    /// Adds a UTXO, sharing the script with the previous UTXOs of the same script.  Only for sources without
+    /// external records.
+    ///
+    /// @throws std::logic_error if the records are external.
+    void add(const std::array<byte, 32>& hash, uint32_t index, uint32_t sequence, Amount amount, const Data& script);
+
+    std::size_t size() const override { return external != nullptr ? externalCount : ownedRecords.size(); }
+    Amount amount(std::size_t index) const override { return records()[index].amount; }
+    Proto::UnspentTransaction utxo(std::size_t index) const override;
+
+    const std::vector<Data>& scripts() const { return scriptTable; }
+
+  private:
+    const UtxoRecord* records() const { return external != nullptr ? external : ownedRecords.data(); }
+
+    /// External records, null for records added with `add`.
+    const UtxoRecord* external = nullptr;
+    std::size_t externalCount = 0;
+    std::vector<UtxoRecord> ownedRecords;
+    std::vector<Data> scriptTable;
+    std::map<Data, uint32_t> scriptIndices;
+};
+
+/// Random-access view of a UtxoSource with the interface of a UTXO list, for the selections of UnspentSelector:
+/// the elements have the amount of a UTXO, and are converted to the protobuf message when selected.
+class UtxoSourceView {
+  public:
+    class Element {
+      public:
+        Element(const UtxoSource& source, std::size_t index) : source(&source), index(index) {}
+
+        Amount amount() const { return source->amount(index); }
+        operator Proto::UnspentTransaction() const { return source->utxo(index); }
+
+      private:
+        const UtxoSource* source;
+        std::size_t index;
+    };
+
+    class Iterator {
+      public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = Element;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Element;
+
+        Iterator(const UtxoSource& source, std::size_t index) : source(&source), index(index) {}
+
+        Element operator*() const { return Element(*source, index); }
+        Iterator& operator++() {
+            ++index;
+            return *this;
+        }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+
+      private:
+        const UtxoSource* source;
+        std::size_t index;
+    };
+
+    explicit UtxoSourceView(const UtxoSource& source) : source(source) {}
+
+    std::size_t size() const { return source.size(); }
+    bool empty() const { return source.size() == 0; }
+    Element operator[](std::size_t index) const { return Element(source, index); }
+    Iterator begin() const { return Iterator(source, 0); }
+    Iterator end() const { return Iterator(source, source.size()); }
+
+  private:
+    const UtxoSource& source;
+};
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,116 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "BinaryCoding.h"
+#include "Data.h"
+
+#include <cstdint>
+#include <string>
+
+/// Borsh binary serialization (https://borsh.io), used by NEAR and Solana programs.
+///
+/// Serialization code is written once as a template over the output, and run with a SizeCounter
+/// to reserve the exact size, then with a Writer.
+namespace TW::Borsh {
+
+/// Appends Borsh values to a buffer.
+class Writer {
+  public:
+    explicit Writer(Data& data, size_t reservedSize = 0) : data(data) {
+        data.reserve(data.size() + reservedSize);
+    }
+
+    void writeU8(uint8_t value) { data.push_back(value); }
+    void writeU32(uint32_t value) { encode32LE(value, data); }
+    void writeU64(uint64_t value) { encode64LE(value, data); }
+    /// Writes bytes as they are: fixed-size arrays, or u128 values already in little endian.
+    void writeRaw(DataView bytes) { append(data, bytes); }
+    void writeRaw(const std::string& bytes) { data.insert(data.end(), bytes.begin(), bytes.end()); }
+    /// Writes a string or a Vec<u8>, prefixed by its u32 length.
+    void writeBytes(DataView bytes) {
+        writeU32(static_cast<uint32_t>(bytes.size()));
+        writeRaw(bytes);
+    }
+    void writeBytes(const std::string& bytes) {
+        writeU32(static_cast<uint32_t>(bytes.size()));
+        writeRaw(bytes);
+    }
+
+  private:
+    Data& data;
+};
+
+/// Counts the bytes a Writer would write, with the same interface.
+class SizeCounter {
+  public:
+    size_t size = 0;
+
+    void writeU8(uint8_t) { size += 1; }
+    void writeU32(uint32_t) { size += 4; }
+    void writeU64(uint64_t) { size += 8; }
+    void writeRaw(DataView bytes) { size += bytes.size(); }
+    void writeRaw(const std::string& bytes) { size += bytes.size(); }
+    void writeBytes(DataView bytes) { size += 4 + bytes.size(); }
+    void writeBytes(const std::string& bytes) { size += 4 + bytes.size(); }
+};
+
+/// Reads Borsh values from a view, without copying; reads fail once past the end.
+class Reader {
+  public:
+    explicit Reader(DataView data) : data(data) {}
+
+    size_t remaining() const { return data.size() - offset; }
+
+    bool readU8(uint8_t& value) {
+        if (remaining() < 1) {
+            return false;
+        }
+        value = data[offset++];
+        return true;
+    }
+
+    bool readU32(uint32_t& value) {
+        if (remaining() < 4) {
+            return false;
+        }
+        value = decode32LE(data.data() + offset);
+        offset += 4;
+        return true;
+    }
+
+    bool readU64(uint64_t& value) {
+        if (remaining() < 8) {
+            return false;
+        }
+        value = decode64LE(data.data() + offset);
+        offset += 8;
+        return true;
+    }
+
+    /// Reads `count` bytes, as a view into the source.
+    bool readRaw(size_t count, DataView& bytes) {
+        if (remaining() < count) {
+            return false;
+        }
+        bytes = data.subView(offset, count);
+        offset += count;
+        return true;
+    }
+
+    /// Reads a string or a Vec<u8>, prefixed by its u32 length.
+    bool readBytes(DataView& bytes) {
+        uint32_t size = 0;
+        return readU32(size) && readRaw(size, bytes);
+    }
+
+  private:
+    DataView data;
+    size_t offset = 0;
+};
+
+} // namespace TW::Borsh
@@ -0,0 +1,136 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BulkDerivation.h"
+#include "Coin.h"
+#include "Mnemonic.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+#include "Secp256k1Comb.h"
+#include "ThreadPool.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+using namespace TW;
+
+namespace {
+
+BulkDerivationBackend& cpuBackend() {
+    static BulkDerivationBackend backend;
+    return backend;
+}
+
+} // namespace
+
+std::vector<std::array<byte, HDWallet::seedSize>> BulkDerivationBackend::seeds(const std::vector<std::string>& mnemonics,
+                                                                               const std::vector<std::string>& passphrases) {
+    return HDWallet::seedsFromMnemonics(mnemonics, passphrases);
+}
+
+bool BulkDerivationBackend::publicKeys(const byte* privateKeys, std::size_t count, bool compressed, byte* publicKeys) {
+    return Secp256k1Comb::publicKeys(privateKeys, count, compressed, publicKeys);
+}
+
+BulkDeriver::BulkDeriver(TWCoinType coin, std::vector<DerivationPath> paths, BulkDerivationBackend* backend)
+    : coin(coin), paths(std::move(paths)), backend(backend != nullptr ? *backend : cpuBackend()) {
+    if (this->paths.empty()) {
+        throw std::invalid_argument("No derivation path");
+    }
+}
+
+std::vector<std::vector<std::string>> BulkDeriver::derive(const std::vector<std::string>& mnemonics,
+                                                          const std::vector<std::string>& passphrases) const {
+    if (passphrases.size() != mnemonics.size() && passphrases.size() != 1) {
+        throw std::invalid_argument("Invalid number of passphrases");
+    }
+    auto& pool = ThreadPool::shared();
+    std::vector<char> valid(mnemonics.size());
+    pool.parallelFor(mnemonics.size(), 0, [&](std::size_t i) { valid[i] = Mnemonic::isValid(mnemonics[i]) ? 1 : 0; });
+    std::vector<std::size_t> candidates;
+    for (std::size_t i = 0; i < mnemonics.size(); ++i) {
+        if (valid[i] != 0) {
+            candidates.push_back(i);
+        }
+    }
+
+    std::vector<std::vector<std::string>> addresses(mnemonics.size());
+    const auto batchSize = std::max<std::size_t>(backend.seedBatchSize(), 1);
+    const auto batchCount = (candidates.size() + batchSize - 1) / batchSize;
+    pool.parallelFor(batchCount, 0, [&](std::size_t batch) {
+        const auto begin = candidates.begin() + static_cast<std::ptrdiff_t>(batch * batchSize);
+        const auto end = candidates.begin() + static_cast<std::ptrdiff_t>(std::min(candidates.size(), (batch + 1) * batchSize));
+        deriveBatch(mnemonics, passphrases, std::vector<std::size_t>(begin, end), addresses);
+    });
+    return addresses;
+}
+
+void BulkDeriver::deriveBatch(const std::vector<std::string>& mnemonics, const std::vector<std::string>& passphrases,
+                              const std::vector<std::size_t>& candidates, std::vector<std::vector<std::string>>& addresses) const {
+    const auto passphrase = [&passphrases](std::size_t i) -> const std::string& {
+        return passphrases[passphrases.size() == 1 ? 0 : i];
+    };
+    std::vector<std::string> batchMnemonics;
+    std::vector<std::string> batchPassphrases;
+    for (const auto i : candidates) {
+        batchMnemonics.push_back(mnemonics[i]);
+        batchPassphrases.push_back(passphrase(i));
+    }
+    auto seeds = backend.seeds(batchMnemonics, batchPassphrases);
+    if (seeds.size() != candidates.size()) {
+        throw std::runtime_error("Invalid number of seeds");
+    }
+
+    // the private keys of the batch, candidate by candidate and path by path
+    const auto curve = TWCoinTypeCurve(coin);
+    const auto keyType = TW::publicKeyType(coin);
+    std::vector<PrivateKey> keys;
+    keys.reserve(candidates.size() * paths.size());
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        const auto wallet = HDWallet(mnemonics[candidates[c]], passphrase(candidates[c]), seeds[c]);
+        memzero(seeds[c].data(), seeds[c].size());
+        for (const auto& path : paths) {
+            keys.push_back(wallet.getKey(coin, path));
+        }
+    }
+
+    std::vector<std::string> batchAddresses;
+    batchAddresses.reserve(keys.size());
+    const auto batchable = curve == TWCurveSECP256k1 && (keyType == TWPublicKeyTypeSECP256k1 || keyType == TWPublicKeyTypeSECP256k1Extended);
+    if (batchable) {
+        // one field inversion for all the public keys of the batch
+        const auto compressed = keyType == TWPublicKeyTypeSECP256k1;
+        const auto publicKeySize = compressed ? PublicKey::secp256k1Size : PublicKey::secp256k1ExtendedSize;
+        Data privateKeys(keys.size() * PrivateKey::size);
+        for (std::size_t k = 0; k < keys.size(); ++k) {
+            std::memcpy(privateKeys.data() + k * PrivateKey::size, keys[k].bytes.data(), PrivateKey::size);
+        }
+        Data publicKeys(keys.size() * publicKeySize);
+        const auto computed = backend.publicKeys(privateKeys.data(), keys.size(), compressed, publicKeys.data());
+        memzero(privateKeys.data(), privateKeys.size());
+        for (std::size_t k = 0; k < keys.size(); ++k) {
+            if (computed) {
+                const auto begin = publicKeys.begin() + static_cast<std::ptrdiff_t>(k * publicKeySize);
+                batchAddresses.push_back(TW::deriveAddress(coin, PublicKey(Data(begin, begin + publicKeySize), keyType)));
+            } else {
+                batchAddresses.push_back(TW::deriveAddress(coin, keys[k]));
+            }
+        }
+    } else {
+        for (const auto& key : keys) {
+            batchAddresses.push_back(TW::deriveAddress(coin, key));
+        }
+    }
+
+    for (std::size_t c = 0; c < candidates.size(); ++c) {
+        const auto begin = batchAddresses.begin() + static_cast<std::ptrdiff_t>(c * paths.size());
+        addresses[candidates[c]].assign(std::make_move_iterator(begin), std::make_move_iterator(begin + static_cast<std::ptrdiff_t>(paths.size())));
+    }
+}
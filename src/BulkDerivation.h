@@ -0,0 +1,75 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "DerivationPath.h"
+#include "HDWallet.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Stages of BulkDeriver that an accelerator (a GPU or FPGA kernel) can take over: the BIP39 seeds, most of the
+/// cost with 4096 SHA-512 compressions each, and the secp256k1 public keys.  The default implementations are the
+/// CPU paths of HDWallet and Secp256k1Comb.  An implementation must return the same bytes; BulkDeriver does not
+/// check them, compare them with the default implementation in the tests of the accelerator.
+class BulkDerivationBackend {
+  public:
+    virtual ~BulkDerivationBackend() = default;
+
+    /// BIP39 seeds of the mnemonics, as HDWallet::seedsFromMnemonics.  Called from several threads at once, with
+    /// at most `seedBatchSize()` mnemonics each.
+    virtual std::vector<std::array<byte, HDWallet::seedSize>> seeds(const std::vector<std::string>& mnemonics,
+                                                                    const std::vector<std::string>& passphrases);
+
+    /// secp256k1 public keys of `count` private keys of 32 bytes, 33 or 65 bytes each; false if a key is invalid.
+    virtual bool publicKeys(const byte* privateKeys, std::size_t count, bool compressed, byte* publicKeys);
+
+    /// Number of mnemonics per `seeds` call, larger for accelerators with a high cost per call.
+    virtual std::size_t seedBatchSize() const { return 16; }
+};
+
+/// Derives the addresses of many candidate wallets at a set of paths, for recovery and audit tools.
+///
+/// Mnemonics failing the BIP39 checksum are skipped before their seed derivation, which saves most of the work
+/// when candidates are enumerated.  Seeds are derived in batches on the shared thread pool, and not cached; the
+/// paths of a candidate share the derivation of their common prefix, and the secp256k1 public keys of a batch are
+/// computed together.  The addresses are the ones of HDWallet::getKey and deriveAddress.  Thread-safe.
+class BulkDeriver {
+  public:
+    /// Coin of the addresses.
+    const TWCoinType coin;
+
+    /// Paths of the addresses of each candidate.
+    const std::vector<DerivationPath> paths;
+
+    /// Deriver using `backend` (not owned) for the seeds and public keys, the CPU if null.
+    ///
+    /// @throws std::invalid_argument if there is no path.
+    BulkDeriver(TWCoinType coin, std::vector<DerivationPath> paths, BulkDerivationBackend* backend = nullptr);
+
+    /// Addresses of each candidate at the paths, in their order; none for a candidate whose mnemonic is invalid.
+    /// `passphrases` holds one passphrase per mnemonic, or a single one for all.
+    ///
+    /// @throws std::invalid_argument if the number of passphrases does not match.
+    std::vector<std::vector<std::string>> derive(const std::vector<std::string>& mnemonics,
+                                                 const std::vector<std::string>& passphrases) const;
+
+  private:
+    BulkDerivationBackend& backend;
+
+    void deriveBatch(const std::vector<std::string>& mnemonics, const std::vector<std::string>& passphrases,
+                     const std::vector<std::size_t>& candidates, std::vector<std::vector<std::string>>& addresses) const;
+};
+
+} // namespace TW
@@ -8,48 +8,167 @@
 #include "../Cbor.h"
 #include "../Data.h"
 #include "../Base58.h"
+#include "../BinaryCoding.h"
 #include "../Crc.h"
 #include "../HexCoding.h"
 #include "../Hash.h"
 
+#include <TrezorCrypto/bip32.h>
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/curves.h>
+#include <TrezorCrypto/memzero.h>
+
 #include <array>
+#include <cstring>
 
 using namespace TW;
 using namespace TW::Cardano;
 using namespace std;
 
+namespace {
+
+/// Size of an Icarus style address, with a 4-byte CRC:
+/// [tag 24 (bytes(33) payload), uint32 crc], payload being [bytes(28) root, {}, 0].
+constexpr size_t icarusSize = 43;
+constexpr size_t icarusPayloadSize = 33;
+constexpr size_t icarusPayloadOffset = 5;
+constexpr size_t icarusCrcOffset = icarusPayloadOffset + icarusPayloadSize;
+const std::array<TW::byte, icarusPayloadOffset> icarusPrefix = {0x82, 0xd8, AddressV2::PayloadTag, 0x58, icarusPayloadSize};
+const std::array<TW::byte, 3> icarusPayloadPrefix = {0x83, 0x58, AddressV2::RootSize};
+const std::array<TW::byte, 2> icarusPayloadSuffix = {0xa0, 0x00};
+
+/// Hashed spending data encoding, [0, [0, bytes(64) xpub], {}], with the key at keyOffset.
+constexpr size_t keyDataSize = 6 + 64 + 1;
+constexpr size_t keyOffset = 6;
+
+std::array<TW::byte, keyDataSize> keyDataTemplate() {
+    std::array<TW::byte, keyDataSize> data = {0x83, 0x00, 0x82, 0x00, 0x58, 0x40};
+    data[keyDataSize - 1] = 0xa0;
+    return data;
+}
+
+/// Computes the root hash of the key data, SHA3 then Blake2b-224.
+void hashKeyData(const std::array<TW::byte, keyDataSize>& keyData, std::array<TW::byte, AddressV2::RootSize>& root) {
+    const auto firstHash = Hash::sha3_256Digest(DataView(keyData));
+    blake2b(firstHash.data(), static_cast<uint32_t>(firstHash.size()), root.data(), root.size());
+}
+
+} // namespace
+
+bool AddressV2::decodeIcarus(const std::string& addr, std::array<TW::byte, RootSize>& root_out) {
+    std::array<TW::byte, icarusSize> data;
+    if (!Base58::bitcoin.decode(addr, data)) {
+        return false;
+    }
+    const auto payload = data.data() + icarusPayloadOffset;
+    if (!std::equal(icarusPrefix.begin(), icarusPrefix.end(), data.begin()) ||
+        !std::equal(icarusPayloadPrefix.begin(), icarusPayloadPrefix.end(), payload) ||
+        !std::equal(icarusPayloadSuffix.begin(), icarusPayloadSuffix.end(), payload + icarusPayloadSize - icarusPayloadSuffix.size()) ||
+        data[icarusCrcOffset] != 0x1a) {
+        return false;
+    }
+    if (decode32BE(data.data() + icarusCrcOffset + 1) != TW::Crc::crc32(DataView(payload, icarusPayloadSize))) {
+        return false;
+    }
+    std::copy(payload + icarusPayloadPrefix.size(), payload + icarusPayloadPrefix.size() + RootSize, root_out.begin());
+    return true;
+}
+
+std::string AddressV2::icarusString(const std::array<TW::byte, RootSize>& root) {
+    std::array<TW::byte, icarusSize> data;
+    std::copy(icarusPrefix.begin(), icarusPrefix.end(), data.begin());
+    auto payload = data.data() + icarusPayloadOffset;
+    std::copy(icarusPayloadPrefix.begin(), icarusPayloadPrefix.end(), payload);
+    std::copy(root.begin(), root.end(), payload + icarusPayloadPrefix.size());
+    std::copy(icarusPayloadSuffix.begin(), icarusPayloadSuffix.end(), payload + icarusPayloadPrefix.size() + RootSize);
+
+    // crc as a CBOR unsigned integer, in its shortest form
+    const auto crc = TW::Crc::crc32(DataView(payload, icarusPayloadSize));
+    auto end = data.data() + icarusCrcOffset;
+    if (crc < 24) {
+        *end++ = static_cast<TW::byte>(crc);
+    } else if (crc <= 0xff) {
+        *end++ = 0x18;
+        *end++ = static_cast<TW::byte>(crc);
+    } else if (crc <= 0xffff) {
+        *end++ = 0x19;
+        *end++ = static_cast<TW::byte>(crc >> 8);
+        *end++ = static_cast<TW::byte>(crc);
+    } else {
+        *end++ = 0x1a;
+        for (auto shift = 24; shift >= 0; shift -= 8) {
+            *end++ = static_cast<TW::byte>(crc >> shift);
+        }
+    }
+    return Base58::bitcoin.encode(data.data(), end);
+}
+
+std::vector<std::string> AddressV2::deriveAddresses(const PrivateKey& changeKey, uint32_t firstIndex, uint32_t count) {
+    if (changeKey.extensionBytes.size() != PrivateKey::size || changeKey.chainCodeBytes.size() != PrivateKey::size) {
+        throw invalid_argument("Extended private key expected");
+    }
+    HDNode parent;
+    memzero(&parent, sizeof(parent));
+    parent.curve = get_curve_by_name(ED25519_CARDANO_NAME);
+    std::copy(changeKey.bytes.begin(), changeKey.bytes.end(), parent.private_key);
+    std::copy(changeKey.extensionBytes.begin(), changeKey.extensionBytes.end(), parent.private_key_extension);
+    std::copy(changeKey.chainCodeBytes.begin(), changeKey.chainCodeBytes.end(), parent.chain_code);
+
+    auto keyData = keyDataTemplate();
+    std::array<TW::byte, RootSize> root;
+    std::vector<std::string> addresses;
+    addresses.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto node = parent;
+        hdnode_private_ckd_cardano(&node, firstIndex + i);
+        hdnode_fill_public_key(&node);
+        // extended public key: public key (after the curve tag byte) and chain code
+        std::memcpy(keyData.data() + keyOffset, node.public_key + 1, 32);
+        std::memcpy(keyData.data() + keyOffset + 32, node.chain_code, 32);
+        memzero(&node, sizeof(node));
+        hashKeyData(keyData, root);
+        addresses.push_back(icarusString(root));
+    }
+    memzero(&parent, sizeof(parent));
+    return addresses;
+}
+
 bool AddressV2::parseAndCheck(const std::string& addr, Data& root_out, Data& attrs_out, byte& type_out) {
     // Decode Bas58, decode payload + crc, decode root, attr
     Data base58decoded = Base58::bitcoin.decode(addr);
     if (base58decoded.size() == 0) {
         throw invalid_argument("Invalid address: could not Base58 decode");
     }
-    auto elems = Cbor::Decode(base58decoded).getArrayElements();
-    if (elems.size() < 2) {
+    auto reader = Cbor::Reader(base58decoded);
+    if (reader.readArrayHeader() < 2) {
         throw invalid_argument("Could not parse address payload from CBOR data");
     }
-    auto tag = elems[0].getTagValue();
+    auto tag = reader.readTag();
     if (tag != PayloadTag) {
         throw invalid_argument("wrong tag value");
     }
-    Data payload = elems[0].getTagElement().getBytes();
-    uint64_t crcPresent = (uint32_t)elems[1].getValue();
+    const auto payload = reader.readBytes();
+    uint64_t crcPresent = (uint32_t)reader.readValue();
     uint32_t crcComputed = TW::Crc::crc32(payload);
     if (crcPresent != crcComputed) {
         throw invalid_argument("CRC mismatch");
     }
     // parse payload, 3 elements
-    auto payloadElems = Cbor::Decode(payload).getArrayElements();
-    if (payloadElems.size() < 3) {
+    auto payloadReader = Cbor::Reader(payload);
+    if (payloadReader.readArrayHeader() < 3) {
         throw invalid_argument("Could not parse address root and attrs from CBOR data");
     }
-    root_out = payloadElems[0].getBytes();
-    attrs_out = payloadElems[1].encoded(); // map, but encoded as bytes
-    type_out = (TW::byte)payloadElems[2].getValue();
+    root_out = payloadReader.readBytes().toData();
+    attrs_out = payloadReader.readItem().toData(); // map, but encoded as bytes
+    type_out = (TW::byte)payloadReader.readValue();
     return true;
 }
 
 bool AddressV2::isValid(const std::string& string) {
+    std::array<TW::byte, RootSize> root;
+    if (decodeIcarus(string, root)) {
+        return true;
+    }
     try {
         Data root;
         Data attrs;
@@ -63,6 +182,13 @@ bool AddressV2::isValid(const std::string& string) {
 }
 
 AddressV2::AddressV2(const std::string& string) {
+    std::array<TW::byte, RootSize> icarusRoot;
+    if (decodeIcarus(string, icarusRoot)) {
+        root = Data(icarusRoot.begin(), icarusRoot.end());
+        attrs = Data{0xa0};
+        type = 0;
+        return;
+    }
     if (!parseAndCheck(string, root, attrs, type)) {
         throw std::invalid_argument("Invalid address string");
     }
@@ -77,31 +203,31 @@ AddressV2::AddressV2(const PublicKey& publicKey) {
     type = 0; // public key
     root = keyHash(publicKey.bytes);
     // address attributes: empty map for V2, for V1 encrypted derivation path
-    Cbor::Encode emptyMap = Cbor::Encode::map({});
-    attrs = emptyMap.encoded();
+    attrs = Data{0xa0};
 }
 
 Data AddressV2::getCborData() const {
     // put together string represenatation, CBOR representation
     // inner data: pubkey, attrs, type
-    auto cbor1 = Cbor::Encode::array({
-        Cbor::Encode::bytes(root),
-        Cbor::Encode::fromRaw(attrs),
-        Cbor::Encode::uint(type),
-    });
-    auto payloadData = cbor1.encoded();
-    
-    // crc checksum 
+    Data payloadData;
+    payloadData.reserve(Cbor::Writer::headerSize(root.size()) + root.size() + attrs.size() + 3);
+    Cbor::Writer(payloadData).arrayHeader(3).bytes(root).raw(attrs).uint(type);
+
+    // crc checksum
     auto crc = TW::Crc::crc32(payloadData);
     // second pack: tag, base, crc
-    auto cbor2 = Cbor::Encode::array({
-        Cbor::Encode::tag(PayloadTag, Cbor::Encode::bytes(payloadData)),
-        Cbor::Encode::uint(crc),
-    });
-    return cbor2.encoded();
+    Data data;
+    data.reserve(payloadData.size() + 16);
+    Cbor::Writer(data).arrayHeader(2).tag(PayloadTag).bytes(payloadData).uint(crc);
+    return data;
 }
 
 string AddressV2::string() const {
+    if (type == 0 && root.size() == RootSize && attrs.size() == 1 && attrs[0] == 0xa0) {
+        std::array<TW::byte, RootSize> icarusRoot;
+        std::copy(root.begin(), root.end(), icarusRoot.begin());
+        return icarusString(icarusRoot);
+    }
     // Base58 encode the CBOR data
     return Base58::bitcoin.encode(getCborData());
 }
@@ -110,16 +236,9 @@ Data AddressV2::keyHash(const TW::Data& xpub) {
     if (xpub.size() != 64) { throw invalid_argument("invalid xbub length"); }
     // hash of follwoing Cbor-array: [0, [0, xbub], {} ]
     // 3rd entry map is empty map for V2, contains derivation path for V1
-    Data cborData = Cbor::Encode::array({
-        Cbor::Encode::uint(0),
-        Cbor::Encode::array({
-            Cbor::Encode::uint(0),
-            Cbor::Encode::bytes(xpub)
-        }),
-        Cbor::Encode::map({}),
-    }).encoded();
-    // SHA3 hash, then blake
-    Data firstHash = Hash::sha3_256(cborData);
-    Data blake = Hash::blake2b(firstHash, 28);
-    return blake;
+    auto keyData = keyDataTemplate();
+    std::copy(xpub.begin(), xpub.end(), keyData.begin() + keyOffset);
+    std::array<TW::byte, RootSize> root;
+    hashKeyData(keyData, root);
+    return Data(root.begin(), root.end());
 }
@@ -7,9 +7,12 @@
 #pragma once
 
 #include "Data.h"
+#include "../PrivateKey.h"
 #include "../PublicKey.h"
 
+#include <array>
 #include <string>
+#include <vector>
 
 namespace TW::Cardano {
 
@@ -49,7 +52,10 @@ class AddressV2 {
     TW::byte type;
 
     static const TW::byte PayloadTag = 24;
-    
+
+    /// Size of the root key hash.
+    static const size_t RootSize = 28;
+
     /// Determines whether a string makes a valid address.
     static bool isValid(const std::string& string);
 
@@ -70,6 +76,18 @@ class AddressV2 {
 
     /// Check validity and parse elements of a string address.  Throws on error. Used internally by isValid and ctor.
     static bool parseAndCheck(const std::string& addr, TW::Data& root_out, TW::Data& attrs_out, TW::byte& type_out);
+
+    /// Decodes an Icarus style address (public key type, empty attributes) without allocations.
+    /// Returns false if the address is invalid or of another form (V1 addresses with attributes).
+    static bool decodeIcarus(const std::string& addr, std::array<TW::byte, RootSize>& root_out);
+
+    /// Returns the Icarus style address string of a root key hash.
+    static std::string icarusString(const std::array<TW::byte, RootSize>& root);
+
+    /// Derives `count` Icarus style addresses at consecutive indices starting at `firstIndex`,
+    /// from the extended private key of the change level (m/44'/1815'/account'/change).
+    /// The change node is reused, each address costs one child derivation and one key hash.
+    static std::vector<std::string> deriveAddresses(const PrivateKey& changeKey, uint32_t firstIndex, uint32_t count);
 };
 
 inline bool operator==(const AddressV2& lhs, const AddressV2& rhs) {
@@ -24,6 +24,6 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return AddressV3(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     // not implemented yet
 }
@@ -7,6 +7,7 @@
 #include "Cbor.h"
 #include "HexCoding.h"
 
+#include <algorithm>
 #include <sstream>
 #include <cassert>
 
@@ -16,6 +17,10 @@ using namespace std;
 
 
 TW::Data Encode::encoded() const {
+    return checkedData();
+}
+
+const TW::Data& Encode::checkedData() const {
     if (openIndefCount > 0) {
         throw invalid_argument("CBOR Unclosed indefinite length building");
     }
@@ -44,29 +49,39 @@ Encode Encode::bytes(const Data& str) {
 
 Encode Encode::array(const vector<Encode>& elems) {
     Encode e;
-    auto n = elems.size();
-    e.appendValue(Decode::MT_array, n);
-    for (int i = 0; i < n; ++i) {
-        e.append(elems[i].encoded());
+    auto size = Writer::headerSize(elems.size());
+    for (const auto& elem : elems) {
+        size += elem.checkedData().size();
+    }
+    e.data.reserve(size);
+    Writer writer(e.data);
+    writer.arrayHeader(elems.size());
+    for (const auto& elem : elems) {
+        writer.raw(elem.data);
     }
     return e;
 }
 
 Encode Encode::map(const vector<std::pair<Encode, Encode>>& elems) {
     Encode e;
-    auto n = elems.size();
-    e.appendValue(Decode::MT_map, n);
-    for (int i = 0; i < n; ++i) {
-        e.append(elems[i].first.encoded());
-        e.append(elems[i].second.encoded());
+    auto size = Writer::headerSize(elems.size());
+    for (const auto& elem : elems) {
+        size += elem.first.checkedData().size() + elem.second.checkedData().size();
+    }
+    e.data.reserve(size);
+    Writer writer(e.data);
+    writer.mapHeader(elems.size());
+    for (const auto& elem : elems) {
+        writer.raw(elem.first.data);
+        writer.raw(elem.second.data);
     }
     return e;
 }
 
 Encode Encode::tag(uint64_t value, const Encode& elem) {
     Encode e;
-    e.appendValue(Decode::MT_tag, value);
-    e.append(elem.encoded());
+    e.data.reserve(Writer::headerSize(value) + elem.checkedData().size());
+    Writer(e.data).tag(value).raw(elem.data);
     return e;
 }
 
@@ -81,7 +96,7 @@ Encode Encode::addIndefArrayElem(const Encode& elem) {
     if (openIndefCount == 0) {
         throw invalid_argument("CBOR Not inside indefinite-length array");
     }
-    append(elem.encoded());
+    append(elem.checkedData());
     return *this;
 }
 
@@ -104,32 +119,7 @@ Encode Encode::fromRaw(const TW::Data& rawData) {
 }
 
 Encode Encode::appendValue(byte majorType, uint64_t value) {
-    byte byteCount = 0;
-    byte minorType = 0;
-    if (value < 24) {
-        byteCount = 1;
-        minorType = (byte)value;
-    } else if (value <= 0xFF) {
-        byteCount = 1 + 1;
-        minorType = 24;
-    } else if (value <= 0xFFFF) {
-        byteCount = 1 + 2;
-        minorType = 25;
-    } else if (value <= 0xFFFFFFFF) {
-        byteCount = 1 + 4;
-        minorType = 26;
-    } else {
-        byteCount = 1 + 8;
-        minorType = 27;
-    }
-    // add bytes
-    TW::append(data, (byte)((majorType << 5) | (minorType & 0x1F)));
-    Data valBytes = Data(byteCount - 1);
-    for (int i = 0; i < valBytes.size(); ++i) {
-        valBytes[valBytes.size() - 1 - i] = (byte)(value & 0xFF);
-        value = value >> 8;
-    }
-    append(valBytes);
+    Writer(data).header(static_cast<Decode::MajorType>(majorType), value);
     return *this;
 }
 
@@ -160,79 +150,19 @@ Decode Decode::skipClone(uint32_t offset) const {
 }
 
 Decode::TypeDesc Decode::getTypeDesc() const {
+    const auto header = Reader(view()).peekHeader();
     TypeDesc typeDesc;
-    typeDesc.isIndefiniteValue = false;
-    typeDesc.majorType = (MajorType)(getByte(0) >> 5);
-    assert((int)typeDesc.majorType >= 0 && (int)typeDesc.majorType <= 7);
-    auto minorType = (TW::byte)((uint8_t)getByte(0) & 0x1F);
-    if (minorType < 24) {
-        // direct value
-        typeDesc.byteCount = 1;
-        typeDesc.value = minorType;
-        return typeDesc;
-    }
-    if (minorType == 24) {
-        typeDesc.byteCount = 1 + 1;
-        typeDesc.value = getByte(1);
-        return typeDesc;
-    }
-    if (minorType == 25) {
-        typeDesc.byteCount = 1 + 2;
-        typeDesc.value = (uint16_t)(((uint16_t)getByte(1) << 8) + (uint16_t)getByte(2));
-        return typeDesc;
-    }
-    if (minorType == 26) {
-        typeDesc.byteCount = 1 + 4;
-        typeDesc.value = (uint32_t)(((uint32_t)getByte(1) << 24) + ((uint32_t)getByte(2) << 16) + ((uint32_t)getByte(3) << 8) + (uint32_t)getByte(4));
-        return typeDesc;
-    }
-    if (minorType == 27) {
-        typeDesc.byteCount = 1 + 8;
-        typeDesc.value =
-            (uint64_t)(
-                ((uint64_t)getByte(1) << 56) +
-                ((uint64_t)getByte(2) << 48) +
-                ((uint64_t)getByte(3) << 40) +
-                ((uint64_t)getByte(4) << 32) +
-                ((uint64_t)getByte(5) << 24) +
-                ((uint64_t)getByte(6) << 16) +
-                ((uint64_t)getByte(7) << 8) +
-                ((uint64_t)getByte(8)));
-        return typeDesc;
-    }
-    if (minorType >= 28 && minorType <= 30) {
-        throw std::invalid_argument("CBOR unassigned type not supported");
-    }
-    // minorType == 31
-    // stop code
-    typeDesc.byteCount = 1;
-    typeDesc.value = 0;
-    typeDesc.isIndefiniteValue = true;
+    typeDesc.majorType = header.majorType;
+    typeDesc.byteCount = header.size;
+    typeDesc.value = header.value;
+    typeDesc.isIndefiniteValue = header.isIndefinite;
     return typeDesc;
 }
 
 uint32_t Decode::getTotalLen() const {
-    TypeDesc typeDesc = getTypeDesc();
-    switch (typeDesc.majorType) {
-        case MT_uint:
-        case MT_negint:
-        case MT_special:
-            // simple types
-            return typeDesc.byteCount;
-        case MT_bytes:
-        case MT_string:
-            return (uint32_t)typeDesc.byteCount + (uint32_t)typeDesc.value;
-        case MT_array:
-            return getCompoundLength(1);
-        case MT_map:
-            return getCompoundLength(2);
-        default:
-        case MT_tag:
-            {
-                uint32_t dataLen = skipClone(typeDesc.byteCount).getTotalLen();
-                return typeDesc.byteCount + dataLen;
-            }
-    }
+    Reader reader(view());
+    reader.skip();
+    return (uint32_t)reader.position();
 }
 
 uint64_t Decode::getValue() const {
@@ -261,55 +191,27 @@ Data Decode::getBytes() const {
     return TW::data(data->origData.data() + (subStart + typeDesc.byteCount), len); 
 }
 
-bool Decode::isBreak() const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType == MT_special && typeDesc.isIndefiniteValue) { return true; }
-    return false;
-}
-
-uint32_t Decode::getCompoundLength(uint32_t countMultiplier) const {
-    uint32_t len = 0;
-    TypeDesc typeDesc = getTypeDesc();
-    uint32_t count = typeDesc.isIndefiniteValue ? 0 : (uint32_t)(typeDesc.value * countMultiplier);
-    // process elements
-    len += typeDesc.byteCount;
-    for (int i = 0; i < count || typeDesc.isIndefiniteValue; ++i) {
-        Decode nextElem = skipClone(len);
-        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
-            // end of indefinite-length
-            len += 1; // account for break
-            break;
-        }
-        uint32_t elemLen = nextElem.getTotalLen();
-        if (len + elemLen > length()) {
-            throw std::invalid_argument("CBOR array data too short");
-        }
-        len += elemLen;
-    }
-    return len;
-}
-
 vector<Decode> Decode::getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const {
-    TypeDesc typeDesc = getTypeDesc();
-    if (typeDesc.majorType != expectedType) {
+    Reader reader(view());
+    const auto header = reader.readHeader();
+    if (header.majorType != expectedType) {
         throw std::invalid_argument("CBOR data type mismatch");
     }
     vector<Decode> elems;
-    uint32_t count = typeDesc.isIndefiniteValue ? 0 : (uint32_t)(typeDesc.value * countMultiplier);
-    // process elements
-    uint32_t idx = typeDesc.byteCount;
-    for (int i = 0; i < count || typeDesc.isIndefiniteValue; ++i) {
-        Decode nextElem = skipClone(idx);
-        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) {
+    uint64_t count = header.isIndefinite ? 0 : header.value * countMultiplier;
+    // each element takes at least one byte
+    elems.reserve((size_t)std::min<uint64_t>(count, subLen));
+    for (uint64_t i = 0; i < count || header.isIndefinite; ++i) {
+        if (header.isIndefinite && reader.isBreak()) {
             // end of indefinite-length
             break;
         }
-        uint32_t elemLen = nextElem.getTotalLen();
-        if (idx + elemLen > length()) {
+        const auto start = reader.position();
+        reader.skip();
+        if (reader.position() > subLen) {
             throw std::invalid_argument("CBOR array data too short");
         }
-        elems.push_back(Decode(data, subStart + idx, elemLen));
-        idx += elemLen;
+        elems.push_back(Decode(data, subStart + (uint32_t)start, (uint32_t)(reader.position() - start)));
     }
     return elems;
 }
@@ -341,42 +243,9 @@ Decode Decode::getTagElement() const {
 
 bool Decode::isValid() const {
     try {
-        TypeDesc typeDesc = getTypeDesc();
-        switch (typeDesc.majorType) {
-            case MT_uint:
-            case MT_negint:
-            case MT_special:
-                return (typeDesc.byteCount <= subLen);
-
-            case MT_bytes:
-            case MT_string:
-                {
-                    auto len = (uint32_t)(typeDesc.byteCount + typeDesc.value);
-                    return (len <= subLen);
-                }
-
-            case MT_array:
-            case MT_map:
-                {
-                    uint32_t countMultiplier = (typeDesc.majorType == MT_map) ? 2 : 1;
-                    uint32_t len = getCompoundLength(countMultiplier);
-                    if (len > subLen) { return false; }
-                    auto count = typeDesc.isIndefiniteValue ? 0 : countMultiplier * typeDesc.value;
-                    uint32_t idx = typeDesc.byteCount;
-                    for (int i = 0; i < count || typeDesc.isIndefiniteValue; ++i)
-                    {
-                        Decode nextElem = skipClone(idx);
-                        if (typeDesc.isIndefiniteValue && nextElem.isBreak()) { break; }
-                        if (!nextElem.isValid()) { return false; }
-                        idx += nextElem.getTotalLen();
-                    }
-                    return true;
-                }
-
-            default:
-            case MT_tag:
-                return skipClone(typeDesc.byteCount).isValid();
-        }
+        Reader reader(view());
+        reader.skip();
+        return reader.position() <= subLen;
     } catch (exception& ex) {
         return false;
     }
@@ -462,4 +331,202 @@ Data Decode::encoded() const
     return TW::data(data->origData.data() + subStart, subLen);
 }
 
+Writer& Writer::header(Decode::MajorType majorType, uint64_t value) {
+    const auto prefix = (byte)(majorType << 5);
+    if (value < 24) {
+        buffer.push_back(prefix | (byte)value);
+        return *this;
+    }
+    size_t size;
+    if (value <= 0xFF) {
+        buffer.push_back(prefix | 24);
+        size = 1;
+    } else if (value <= 0xFFFF) {
+        buffer.push_back(prefix | 25);
+        size = 2;
+    } else if (value <= 0xFFFFFFFF) {
+        buffer.push_back(prefix | 26);
+        size = 4;
+    } else {
+        buffer.push_back(prefix | 27);
+        size = 8;
+    }
+    for (auto i = size; i-- > 0;) {
+        buffer.push_back((byte)(value >> (8 * i)));
+    }
+    return *this;
+}
+
+size_t Writer::headerSize(uint64_t value) {
+    if (value < 24) {
+        return 1;
+    } else if (value <= 0xFF) {
+        return 1 + 1;
+    } else if (value <= 0xFFFF) {
+        return 1 + 2;
+    } else if (value <= 0xFFFFFFFF) {
+        return 1 + 4;
+    }
+    return 1 + 8;
+}
+
+Writer& Writer::negInt(uint64_t value) {
+    if (value == 0) {
+        // special handling for -1, to avoid underflow
+        return header(Decode::MT_uint, 0);
+    }
+    return header(Decode::MT_negint, value - 1);
+}
+
+Writer& Writer::string(const std::string& str) {
+    header(Decode::MT_string, str.size());
+    buffer.insert(buffer.end(), str.begin(), str.end());
+    return *this;
+}
+
+Writer& Writer::bytes(DataView data) {
+    header(Decode::MT_bytes, data.size());
+    return raw(data);
+}
+
+Writer& Writer::raw(DataView encoded) {
+    buffer.insert(buffer.end(), encoded.begin(), encoded.end());
+    return *this;
+}
+
+void Reader::require(size_t size) const {
+    if (size > data.size() - offset) {
+        throw std::invalid_argument("CBOR data too short");
+    }
+}
+
+Reader::Header Reader::peekHeader() const {
+    require(1);
+    Header header;
+    header.majorType = (Decode::MajorType)(data[offset] >> 5);
+    const auto minorType = (byte)(data[offset] & 0x1F);
+    if (minorType < 24) {
+        // direct value
+        header.size = 1;
+        header.value = minorType;
+        return header;
+    }
+    if (minorType <= 27) {
+        const auto size = (byte)(1 << (minorType - 24));
+        require(1 + size);
+        header.size = 1 + size;
+        for (size_t i = 1; i <= size; ++i) {
+            header.value = (header.value << 8) | data[offset + i];
+        }
+        return header;
+    }
+    if (minorType <= 30) {
+        throw std::invalid_argument("CBOR unassigned type not supported");
+    }
+    // minorType == 31, indefinite length or stop code
+    header.size = 1;
+    header.isIndefinite = true;
+    return header;
+}
+
+Reader::Header Reader::readHeader() {
+    const auto header = peekHeader();
+    offset += header.size;
+    return header;
+}
+
+bool Reader::isBreak() const {
+    const auto header = peekHeader();
+    return header.majorType == Decode::MT_special && header.isIndefinite;
+}
+
+uint64_t Reader::readValue() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_uint && header.majorType != Decode::MT_negint) {
+        throw std::invalid_argument("CBOR data type not a value-type");
+    }
+    return header.value;
+}
+
+DataView Reader::readBytes() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_bytes && header.majorType != Decode::MT_string) {
+        throw std::invalid_argument("CBOR data type not bytes/string");
+    }
+    require(header.value);
+    const auto bytes = DataView(data.data() + offset, (size_t)header.value);
+    offset += (size_t)header.value;
+    return bytes;
+}
+
+uint64_t Reader::readArrayHeader() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_array || header.isIndefinite) {
+        throw std::invalid_argument("CBOR definite-length array expected");
+    }
+    return header.value;
+}
+
+uint64_t Reader::readMapHeader() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_map || header.isIndefinite) {
+        throw std::invalid_argument("CBOR definite-length map expected");
+    }
+    return header.value;
+}
+
+uint64_t Reader::readTag() {
+    const auto header = readHeader();
+    if (header.majorType != Decode::MT_tag) {
+        throw std::invalid_argument("CBOR data type not tag");
+    }
+    return header.value;
+}
+
+DataView Reader::readItem() {
+    const auto start = offset;
+    skip();
+    return DataView(data.data() + start, offset - start);
+}
+
+void Reader::skip(size_t depth) {
+    if (depth > maxDepth) {
+        throw std::invalid_argument("CBOR nesting too deep");
+    }
+    const auto header = readHeader();
+    switch (header.majorType) {
+        case Decode::MT_uint:
+        case Decode::MT_negint:
+        case Decode::MT_special:
+            // simple types
+            return;
+
+        case Decode::MT_bytes:
+        case Decode::MT_string:
+            require(header.value);
+            offset += (size_t)header.value;
+            return;
+
+        case Decode::MT_array:
+        case Decode::MT_map: {
+            const uint64_t countMultiplier = (header.majorType == Decode::MT_map) ? 2 : 1;
+            const auto count = header.isIndefinite ? 0 : header.value * countMultiplier;
+            for (uint64_t i = 0; i < count || header.isIndefinite; ++i) {
+                if (header.isIndefinite && isBreak()) {
+                    // end of indefinite-length, skip the break
+                    ++offset;
+                    return;
+                }
+                skip(depth + 1);
+            }
+            return;
+        }
+
+        default:
+        case Decode::MT_tag:
+            skip(depth + 1);
+            return;
+    }
+}
+
 } // namespace TW::Cbor
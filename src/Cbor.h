@@ -10,6 +10,7 @@
 
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace TW::Cbor {
 
@@ -55,6 +56,8 @@ public:
 private:
     Encode() {}
     Encode(const TW::Data& rawData) : data(rawData) {}
+    /// Encoded bytes, throws if an indefinite-length building is still open.
+    const TW::Data& checkedData() const;
     /// Append types + value, on variable number of bytes (1..8). Return object to support chain syntax.
     Encode appendValue(byte majorType, uint64_t value);
     inline Encode append(const TW::Data& data) { TW::append(this->data, data); return *this; }
@@ -117,6 +120,10 @@ private:
     Decode(const std::shared_ptr<OrigDataRef>& nData, uint32_t nSubIdx, uint32_t nSubLen);
     /// Skip ahead: form other Decode data with offset
     Decode skipClone(uint32_t offset) const;
+    /// Original data from the start of this element to the end.
+    DataView view() const {
+        return DataView(data->origData.data() + subStart, data->origData.size() - subStart);
+    }
     /// Get the Nth byte
     inline TW::byte getByte(uint32_t idx) const {
         if (subStart + idx >= data->origData.size()) { throw std::invalid_argument("CBOR data too short"); }
@@ -131,9 +138,7 @@ private:
     /// Parse out type sepcifiers
     TypeDesc getTypeDesc() const;
     uint32_t getTotalLen() const;
-    uint32_t getCompoundLength(uint32_t countMultiplier) const;
     std::vector<Decode> getCompoundElements(uint32_t countMultiplier, TW::byte expectedType) const;
-    bool isBreak() const;
     std::string dumpToStringInternal() const;
 
 private:
@@ -144,4 +149,90 @@ private:
     uint32_t subLen;
 };
 
+/// Streaming CBOR writer, appending to a buffer without intermediate copies.
+/// Arrays and maps are written with their element count up front, followed by their elements.
+class Writer {
+public:
+    explicit Writer(Data& buffer) : buffer(buffer) {}
+
+    /// Writes a major type with its argument (value, length or count), in the shortest form.
+    Writer& header(Decode::MajorType majorType, uint64_t value);
+    /// Writes an unsigned int
+    Writer& uint(uint64_t value) { return header(Decode::MT_uint, value); }
+    /// Writes a negative int, -value (positive is given), as Encode::negInt
+    Writer& negInt(uint64_t value);
+    /// Writes a string
+    Writer& string(const std::string& str);
+    /// Writes a byte array
+    Writer& bytes(DataView data);
+    /// Writes the header of an array of `count` elements
+    Writer& arrayHeader(uint64_t count) { return header(Decode::MT_array, count); }
+    /// Writes the header of a map of `count` key-value pairs
+    Writer& mapHeader(uint64_t count) { return header(Decode::MT_map, count); }
+    /// Writes a tag, to be followed by its element
+    Writer& tag(uint64_t value) { return header(Decode::MT_tag, value); }
+    /// Writes already encoded CBOR data
+    Writer& raw(DataView encoded);
+
+    /// Size of a header with the given argument.
+    static size_t headerSize(uint64_t value);
+
+private:
+    Data& buffer;
+};
+
+/// Cursor based CBOR reader over borrowed data; does not allocate.
+/// Throws std::invalid_argument on malformed or truncated data.
+class Reader {
+public:
+    /// Type specifier of an element.
+    struct Header {
+        Decode::MajorType majorType = Decode::MT_uint;
+        /// Value, length or count
+        uint64_t value = 0;
+        /// Encoded size of the header
+        TW::byte size = 0;
+        bool isIndefinite = false;
+    };
+
+    /// Maximum nesting of arrays, maps and tags.
+    static const size_t maxDepth = 64;
+
+    explicit Reader(DataView data) : data(data) {}
+
+    /// Offset of the next element.
+    size_t position() const { return offset; }
+    /// Whether all data has been read.
+    bool atEnd() const { return offset == data.size(); }
+
+    /// Parses the header of the next element, without consuming it.
+    Header peekHeader() const;
+    /// Parses and consumes the header of the next element.
+    Header readHeader();
+    /// Whether the next element is the break code closing an indefinite-length element.
+    bool isBreak() const;
+
+    /// Reads an unsigned or negative int value.
+    uint64_t readValue();
+    /// Reads the content of a byte array or string.
+    DataView readBytes();
+    /// Reads a definite-length array header, returns the element count.
+    uint64_t readArrayHeader();
+    /// Reads a definite-length map header, returns the pair count.
+    uint64_t readMapHeader();
+    /// Reads a tag value, the tagged element follows.
+    uint64_t readTag();
+    /// Skips the next complete element.
+    void skip() { skip(0); }
+    /// Skips the next complete element, returns its encoded form.
+    DataView readItem();
+
+private:
+    void skip(size_t depth);
+    void require(size_t size) const;
+
+    DataView data;
+    size_t offset = 0;
+};
+
 } // namespace TW::Cbor
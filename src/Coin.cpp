@@ -7,10 +7,15 @@
 #include "Coin.h"
 
 #include "CoinEntry.h"
+#include "Instrumentation.h"
+#include "ThreadPool.h"
 #include <TrustWalletCore/TWCoinTypeConfiguration.h>
 #include <TrustWalletCore/TWHRP.h>
 
+#include <algorithm>
+#include <atomic>
 #include <map>
+#include <stdexcept>
 
 // #coin-list# Includes for entry points for coin implementations
 #include "Aeternity/Entry.h"
@@ -57,148 +62,276 @@
 using namespace TW;
 using namespace std;
 
-// #coin-list# Global coin entry dispatcher entries
-Aeternity::Entry aeternityDP;
-Aion::Entry aionDP;
-Algorand::Entry algorandDP;
-Binance::Entry binanceDP;
-Bitcoin::Entry bitcoinDP;
-Cardano::Entry cardanoDP;
-Cosmos::Entry cosmosDP;
-Elrond::Entry elrondDP;
-EOS::Entry eosDP;
-Ethereum::Entry ethereumDP;
-Decred::Entry decredDP;
-Filecoin::Entry filecoinDP;
-FIO::Entry fioDP;
-Groestlcoin::Entry groestlcoinDP;
-Harmony::Entry harmonyDP;
-Icon::Entry iconDP;
-IoTeX::Entry iotexDP;
-Kusama::Entry kusamaDP;
-Nano::Entry nanoDP;
-NEAR::Entry nearDP;
-Nebulas::Entry nebulasDP;
-NEO::Entry neoDP;
-Nimiq::Entry nimiqDP;
-NULS::Entry nulsDP;
-Ontology::Entry ontologyDP;
-Oasis::Entry oasisDP;
-Polkadot::Entry polkadotDP;
-Ripple::Entry rippleDP;
-Solana::Entry solanaDP;
-Stellar::Entry stellarDP;
-Tezos::Entry tezosDP;
-Theta::Entry thetaDP;
-THORChain::Entry thorchainDP;
-TON::Entry tonDP;
-Tron::Entry tronDP;
-VeChain::Entry vechainDP;
-Waves::Entry wavesDP;
-Zcash::Entry zcashDP;
-Zilliqa::Entry zilliqaDP;
-// end_of_coin_dipatcher_declarations_marker_do_not_modify
-
-CoinEntry* coinDispatcher(TWCoinType coinType) {
+/// Returns the coin entry dispatcher of a blockchain, constructed on its first dispatch (thread-safe),
+/// so that loading the library doesn't pay for the coins that are never used.
+template <typename Entry>
+CoinEntry* lazyEntry() {
+    static Entry entry;
+    return &entry;
+}
+
+using EntryAccessor = CoinEntry* (*)();
+
+EntryAccessor coinDispatcher(TWCoinType coinType) {
     // switch is preferred instead of a data structure, due to initialization issues
-    CoinEntry* entry = nullptr;
+    EntryAccessor entry = nullptr;
+    // blockchains left out of the build (TW_COINS option) have no dispatcher, their coins are unsupported
     switch (coinType) {
         // #coin-list#
-        case TWCoinTypeAeternity: entry = &aeternityDP; break;
-        case TWCoinTypeAion: entry = &aionDP; break;
-        case TWCoinTypeAlgorand: entry = &algorandDP; break;
-        case TWCoinTypeBinance: entry = &binanceDP; break;
-        case TWCoinTypeBitcoin: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinCash: entry = &bitcoinDP; break;
-        case TWCoinTypeBitcoinGold: entry = &bitcoinDP; break;
-        case TWCoinTypeDash: entry = &bitcoinDP; break;
-        case TWCoinTypeDigiByte: entry = &bitcoinDP; break;
-        case TWCoinTypeDogecoin: entry = &bitcoinDP; break;
-        case TWCoinTypeLitecoin: entry = &bitcoinDP; break;
-        case TWCoinTypeMonacoin: entry = &bitcoinDP; break;
-        case TWCoinTypeQtum: entry = &bitcoinDP; break;
-        case TWCoinTypeRavencoin: entry = &bitcoinDP; break;
-        case TWCoinTypeViacoin: entry = &bitcoinDP; break;
-        case TWCoinTypeZcoin: entry = &bitcoinDP; break;
-        case TWCoinTypeCardano: entry = &cardanoDP; break;
-        case TWCoinTypeCosmos: entry = &cosmosDP; break;
-        case TWCoinTypeKava: entry = &cosmosDP; break;
-        case TWCoinTypeTerra: entry = &cosmosDP; break;
-        case TWCoinTypeBandChain: entry = &cosmosDP; break;
-        case TWCoinTypeBluzelle: entry = &cosmosDP; break;
-        case TWCoinTypeElrond: entry = &elrondDP; break;
-        case TWCoinTypeEOS: entry = &eosDP; break;
-        case TWCoinTypeCallisto: entry = &ethereumDP; break;
-        case TWCoinTypeEthereum: entry = &ethereumDP; break;
-        case TWCoinTypeEthereumClassic: entry = &ethereumDP; break;
-        case TWCoinTypeGoChain: entry = &ethereumDP; break;
-        case TWCoinTypePOANetwork: entry = &ethereumDP; break;
-        case TWCoinTypeThunderToken: entry = &ethereumDP; break;
-        case TWCoinTypeTomoChain: entry = &ethereumDP; break;
-        case TWCoinTypeSmartChainLegacy: entry = &ethereumDP; break;
-        case TWCoinTypeSmartChain: entry = &ethereumDP; break;
-        case TWCoinTypeDecred: entry = &decredDP; break;
-        case TWCoinTypeFilecoin: entry = &filecoinDP; break;
-        case TWCoinTypeFIO: entry = &fioDP; break;
-        case TWCoinTypeGroestlcoin: entry = &groestlcoinDP; break;
-        case TWCoinTypeHarmony: entry = &harmonyDP; break;
-        case TWCoinTypeICON: entry = &iconDP; break;
-        case TWCoinTypeIoTeX: entry = &iotexDP; break;
-        case TWCoinTypeKusama: entry = &kusamaDP; break;
-        case TWCoinTypeNano: entry = &nanoDP; break;
-        case TWCoinTypeNEAR: entry = &nearDP; break;
-        case TWCoinTypeNebulas: entry = &nebulasDP; break;
-        case TWCoinTypeNEO: entry = &neoDP; break;
-        case TWCoinTypeNimiq: entry = &nimiqDP; break;
-        case TWCoinTypeNULS: entry = &nulsDP; break;
-        case TWCoinTypeOasis: entry = &oasisDP; break;
-        case TWCoinTypeOntology: entry = &ontologyDP; break;
-        case TWCoinTypePolkadot: entry = &polkadotDP; break;
-        case TWCoinTypeXRP: entry = &rippleDP; break;
-        case TWCoinTypeSolana: entry = &solanaDP; break;
-        case TWCoinTypeStellar: entry = &stellarDP; break;
-        case TWCoinTypeKin: entry = &stellarDP; break;
-        case TWCoinTypeTezos: entry = &tezosDP; break;
-        case TWCoinTypeTheta: entry = &thetaDP; break;
-        case TWCoinTypeTHORChain: entry = &thorchainDP; break;
-        case TWCoinTypeTON: entry = &tonDP; break;
-        case TWCoinTypeTron: entry = &tronDP; break;
-        case TWCoinTypeVeChain: entry = &vechainDP; break;
-        case TWCoinTypeWanchain: entry = &ethereumDP; break;
-        case TWCoinTypeWaves: entry = &wavesDP; break;
-        case TWCoinTypeZcash: entry = &zcashDP; break;
-        case TWCoinTypeZelcash: entry = &zcashDP; break;
-        case TWCoinTypeZilliqa: entry = &zilliqaDP; break;
-        case TWCoinTypePolygon: entry = &ethereumDP; break;
+#ifndef TW_EXCLUDE_AETERNITY
+        case TWCoinTypeAeternity: entry = &lazyEntry<Aeternity::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_AION
+        case TWCoinTypeAion: entry = &lazyEntry<Aion::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ALGORAND
+        case TWCoinTypeAlgorand: entry = &lazyEntry<Algorand::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_BINANCE
+        case TWCoinTypeBinance: entry = &lazyEntry<Binance::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_BITCOIN
+        case TWCoinTypeBitcoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeBitcoinCash: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeBitcoinGold: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeDash: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeDigiByte: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeDogecoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeLitecoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeMonacoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeQtum: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeRavencoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeViacoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+        case TWCoinTypeZcoin: entry = &lazyEntry<Bitcoin::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_CARDANO
+        case TWCoinTypeCardano: entry = &lazyEntry<Cardano::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_COSMOS
+        case TWCoinTypeCosmos: entry = &lazyEntry<Cosmos::Entry>; break;
+        case TWCoinTypeKava: entry = &lazyEntry<Cosmos::Entry>; break;
+        case TWCoinTypeTerra: entry = &lazyEntry<Cosmos::Entry>; break;
+        case TWCoinTypeBandChain: entry = &lazyEntry<Cosmos::Entry>; break;
+        case TWCoinTypeBluzelle: entry = &lazyEntry<Cosmos::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ELROND
+        case TWCoinTypeElrond: entry = &lazyEntry<Elrond::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_EOS
+        case TWCoinTypeEOS: entry = &lazyEntry<EOS::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ETHEREUM
+        case TWCoinTypeCallisto: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeEthereum: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeEthereumClassic: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeGoChain: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypePOANetwork: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeThunderToken: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeTomoChain: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeSmartChainLegacy: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeSmartChain: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypeWanchain: entry = &lazyEntry<Ethereum::Entry>; break;
+        case TWCoinTypePolygon: entry = &lazyEntry<Ethereum::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_DECRED
+        case TWCoinTypeDecred: entry = &lazyEntry<Decred::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_FILECOIN
+        case TWCoinTypeFilecoin: entry = &lazyEntry<Filecoin::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_FIO
+        case TWCoinTypeFIO: entry = &lazyEntry<FIO::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_GROESTLCOIN
+        case TWCoinTypeGroestlcoin: entry = &lazyEntry<Groestlcoin::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_HARMONY
+        case TWCoinTypeHarmony: entry = &lazyEntry<Harmony::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ICON
+        case TWCoinTypeICON: entry = &lazyEntry<Icon::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_IOTEX
+        case TWCoinTypeIoTeX: entry = &lazyEntry<IoTeX::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_KUSAMA
+        case TWCoinTypeKusama: entry = &lazyEntry<Kusama::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_NANO
+        case TWCoinTypeNano: entry = &lazyEntry<Nano::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_NEAR
+        case TWCoinTypeNEAR: entry = &lazyEntry<NEAR::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_NEBULAS
+        case TWCoinTypeNebulas: entry = &lazyEntry<Nebulas::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_NEO
+        case TWCoinTypeNEO: entry = &lazyEntry<NEO::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_NIMIQ
+        case TWCoinTypeNimiq: entry = &lazyEntry<Nimiq::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_NULS
+        case TWCoinTypeNULS: entry = &lazyEntry<NULS::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_OASIS
+        case TWCoinTypeOasis: entry = &lazyEntry<Oasis::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ONTOLOGY
+        case TWCoinTypeOntology: entry = &lazyEntry<Ontology::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_POLKADOT
+        case TWCoinTypePolkadot: entry = &lazyEntry<Polkadot::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_RIPPLE
+        case TWCoinTypeXRP: entry = &lazyEntry<Ripple::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_SOLANA
+        case TWCoinTypeSolana: entry = &lazyEntry<Solana::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_STELLAR
+        case TWCoinTypeStellar: entry = &lazyEntry<Stellar::Entry>; break;
+        case TWCoinTypeKin: entry = &lazyEntry<Stellar::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_TEZOS
+        case TWCoinTypeTezos: entry = &lazyEntry<Tezos::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_THETA
+        case TWCoinTypeTheta: entry = &lazyEntry<Theta::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_THORCHAIN
+        case TWCoinTypeTHORChain: entry = &lazyEntry<THORChain::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_TON
+        case TWCoinTypeTON: entry = &lazyEntry<TON::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_TRON
+        case TWCoinTypeTron: entry = &lazyEntry<Tron::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_VECHAIN
+        case TWCoinTypeVeChain: entry = &lazyEntry<VeChain::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_WAVES
+        case TWCoinTypeWaves: entry = &lazyEntry<Waves::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ZCASH
+        case TWCoinTypeZcash: entry = &lazyEntry<Zcash::Entry>; break;
+        case TWCoinTypeZelcash: entry = &lazyEntry<Zcash::Entry>; break;
+#endif
+#ifndef TW_EXCLUDE_ZILLIQA
+        case TWCoinTypeZilliqa: entry = &lazyEntry<Zilliqa::Entry>; break;
+#endif
         // end_of_coin_dipatcher_switch_marker_do_not_modify
 
         default: entry = nullptr; break;
     }
-    assert(entry != nullptr);
     return entry;
 }
 
+// Coin info accessors
+
+extern const CoinInfo& getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+
+namespace {
+
+/// Per-coin values derived from the coin info, computed once.
+struct CoinConfig {
+    /// Accessor of the dispatcher, which is only constructed when first used.
+    EntryAccessor entry;
+    DerivationPath derivationPath;
+    TW::byte p2pkhPrefix;
+    TW::byte p2shPrefix;
+    const char* hrp;
+
+    /// Dispatcher of the coin, null for unknown coins.
+    CoinEntry* dispatcher() const { return entry == nullptr ? nullptr : entry(); }
+};
+
+/// Returns the config of a coin from a table indexed by `coinOrdinal`.
+const CoinConfig& coinConfig(TWCoinType coin) {
+    static const std::vector<CoinConfig> configs = [] {
+        std::vector<CoinConfig> configs(coinCount, CoinConfig{nullptr, DerivationPath(), 0, 0, nullptr});
+        for (auto coin : getCoinTypes()) {
+            const auto& info = getCoinInfo(coin);
+            configs[coinOrdinal(coin)] = CoinConfig{coinDispatcher(coin), DerivationPath(info.derivationPath),
+                                                    info.p2pkhPrefix, info.p2shPrefix, stringForHRP(info.hrp)};
+        }
+        return configs;
+    }();
+    static const CoinConfig missing = {nullptr, DerivationPath(), 0, 0, nullptr};
+
+    const auto ordinal = coinOrdinal(coin);
+    if (ordinal >= configs.size()) {
+        return missing;
+    }
+    return configs[ordinal];
+}
+
+} // namespace
+
 bool TW::validateAddress(TWCoinType coin, const std::string& string) {
-    auto p2pkh = TW::p2pkhPrefix(coin);
-    auto p2sh = TW::p2shPrefix(coin);
-    auto hrp = stringForHRP(TW::hrp(coin));
+    const auto& config = coinConfig(coin);
 
     // dispatch
-    auto dispatcher = coinDispatcher(coin);
-    assert(dispatcher != nullptr);
-    return dispatcher->validateAddress(coin, string, p2pkh, p2sh, hrp);
+    const auto dispatcher = config.dispatcher();
+    if (dispatcher == nullptr) {
+        return false;
+    }
+    return dispatcher->validateAddress(coin, string, config.p2pkhPrefix, config.p2shPrefix, config.hrp);
+}
+
+std::vector<bool> TW::validateAddresses(TWCoinType coin, const std::vector<std::string>& addresses, size_t threadCount) {
+    // Addresses handed to a thread at a time, also the minimum batch size worth a thread
+    const size_t chunkSize = 256;
+
+    const auto& config = coinConfig(coin);
+    const auto p2pkh = config.p2pkhPrefix;
+    const auto p2sh = config.p2shPrefix;
+    const auto hrp = config.hrp;
+    const auto dispatcher = config.dispatcher();
+    if (dispatcher == nullptr) {
+        return std::vector<bool>(addresses.size(), false);
+    }
+
+    // one byte per address, so that threads never write to the same word
+    std::vector<byte> valid(addresses.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto first = next.fetch_add(chunkSize); first < addresses.size(); first = next.fetch_add(chunkSize)) {
+            const auto last = std::min(first + chunkSize, addresses.size());
+            for (auto i = first; i < last; ++i) {
+                valid[i] = dispatcher->validateAddress(coin, addresses[i], p2pkh, p2sh, hrp);
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, (addresses.size() + chunkSize - 1) / chunkSize, worker);
+    return std::vector<bool>(valid.begin(), valid.end());
 }
 
 std::string TW::normalizeAddress(TWCoinType coin, const std::string& address) {
-    if (!TW::validateAddress(coin, address)) {
+    auto parsed = TW::parseAddress(coin, address);
+    if (!parsed) {
         // invalid address, not normalizing
         return "";
     }
+    return std::move(parsed->normalized);
+}
+
+std::optional<ParsedAddress> TW::parseAddress(TWCoinType coin, const std::string& address) {
+    const auto& config = coinConfig(coin);
 
     // dispatch
-    auto dispatcher = coinDispatcher(coin);
-    assert(dispatcher != nullptr);
-    return dispatcher->normalizeAddress(coin, address);
+    const auto dispatcher = config.dispatcher();
+    if (dispatcher == nullptr) {
+        return std::nullopt;
+    }
+    ParsedAddress parsed;
+    if (!dispatcher->parseAddress(coin, address, config.p2pkhPrefix, config.p2shPrefix, config.hrp, parsed)) {
+        return std::nullopt;
+    }
+    return parsed;
 }
 
 std::string TW::deriveAddress(TWCoinType coin, const PrivateKey& privateKey) {
@@ -207,42 +340,114 @@ std::string TW::deriveAddress(TWCoinType coin, const PrivateKey& privateKey) {
 }
 
 std::string TW::deriveAddress(TWCoinType coin, const PublicKey& publicKey) {
-    auto p2pkh = TW::p2pkhPrefix(coin);
-    auto hrp = stringForHRP(TW::hrp(coin));
+    TW_INSTRUMENT_SCOPE("deriveAddress");
+    const auto& config = coinConfig(coin);
 
     // dispatch
-    auto dispatcher = coinDispatcher(coin);
-    assert(dispatcher != nullptr);
-    return dispatcher->deriveAddress(coin, publicKey, p2pkh, hrp);
+    const auto dispatcher = config.dispatcher();
+    if (dispatcher == nullptr) {
+        return "";
+    }
+    return dispatcher->deriveAddress(coin, publicKey, config.p2pkhPrefix, config.hrp);
 }
 
-void TW::anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
-    auto dispatcher = coinDispatcher(coinType);
-    assert(dispatcher != nullptr);
+void TW::anyCoinSign(TWCoinType coinType, DataView dataIn, Data& dataOut) {
+    TW_INSTRUMENT_SCOPE("anyCoinSign");
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return;
+    }
     dispatcher->sign(coinType, dataIn, dataOut);
 }
 
+void TW::anyCoinSign(TWCoinType coinType, const google::protobuf::Message& input, google::protobuf::Message& output) {
+    TW_INSTRUMENT_SCOPE("anyCoinSign");
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        throw std::invalid_argument("Unsupported coin");
+    }
+    if (!dispatcher->signMessage(coinType, input, output)) {
+        throw std::invalid_argument("Signing message types don't match the coin");
+    }
+}
+
+std::vector<BatchSigningResult> TW::anyCoinSignBatch(const std::vector<std::pair<TWCoinType, Data>>& inputs, size_t threadCount) {
+    std::vector<BatchSigningResult> results(inputs.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        // inputs of a worker are parsed in the same arena, reset after each transaction
+        google::protobuf::Arena arena;
+        ScopedSigningArena scope(arena);
+        for (auto index = next++; index < inputs.size(); index = next++, arena.Reset()) {
+            const auto coin = inputs[index].first;
+            auto& result = results[index];
+            const auto dispatcher = coinConfig(coin).dispatcher();
+            if (dispatcher == nullptr) {
+                result.error = TWAnySignerBatchErrorUnsupportedCoin;
+                continue;
+            }
+            try {
+                TW_INSTRUMENT_SCOPE("anyCoinSign");
+                dispatcher->sign(coin, inputs[index].second, result.output);
+            } catch (...) {
+                result.output.clear();
+                result.error = TWAnySignerBatchErrorSigningFailed;
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, inputs.size(), worker);
+    return results;
+}
+
+std::unique_ptr<SigningTemplate> TW::anyCoinSigningTemplate(TWCoinType coinType, const Data& dataIn) {
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return nullptr;
+    }
+    try {
+        return dispatcher->signingTemplate(coinType, dataIn);
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
 std::string TW::anySignJSON(TWCoinType coinType, const std::string& json, const Data& key) {
-    auto dispatcher = coinDispatcher(coinType);
-    assert(dispatcher != nullptr);
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return "";
+    }
     return dispatcher->signJSON(coinType, json, key);
 }
 
 bool TW::supportsJSONSigning(TWCoinType coinType) {
-    auto dispatcher = coinDispatcher(coinType);
-    assert(dispatcher != nullptr);
-    return dispatcher->supportsJSONSigning();
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    return dispatcher != nullptr && dispatcher->supportsJSONSigning();
 }
 
-void TW::anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut) {
-    auto dispatcher = coinDispatcher(coinType);
-    assert(dispatcher != nullptr);
+void TW::anyCoinPlan(TWCoinType coinType, DataView dataIn, Data& dataOut) {
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return;
+    }
     dispatcher->plan(coinType, dataIn, dataOut);
 }
 
-// Coin info accessors
+void TW::anyCoinPreImageHashes(TWCoinType coinType, DataView dataIn, Data& dataOut) {
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return;
+    }
+    dispatcher->preImageHashes(coinType, dataIn, dataOut);
+}
 
-extern const CoinInfo getCoinInfo(TWCoinType coin); // in generated CoinInfoData.cpp file
+void TW::anyCoinCompileWithSignatures(TWCoinType coinType, DataView dataIn, const std::vector<Data>& signatures, Data& dataOut) {
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return;
+    }
+    dispatcher->compileWithSignatures(coinType, dataIn, signatures, dataOut);
+}
 
 TWBlockchain TW::blockchain(TWCoinType coin) {
     return getCoinInfo(coin).blockchain;
@@ -265,7 +470,7 @@ TWHDVersion TW::xprvVersion(TWCoinType coin) {
 }
 
 DerivationPath TW::derivationPath(TWCoinType coin) {
-    return DerivationPath(getCoinInfo(coin).derivationPath);
+    return coinConfig(coin).derivationPath;
 }
 
 enum TWPublicKeyType TW::publicKeyType(TWCoinType coin) {
@@ -329,8 +534,10 @@ TWString *_Nonnull TWCoinTypeConfigurationGetName(enum TWCoinType coin) {
 }
 
 const std::vector<TWCoinType> TW::getSimilarCoinTypes(TWCoinType coinType) {
-    const auto dispatcher = coinDispatcher(coinType);
-    assert(dispatcher != nullptr);
+    const auto dispatcher = coinConfig(coinType).dispatcher();
+    if (dispatcher == nullptr) {
+        return {};
+    }
     return dispatcher->coinTypes();
 }
 
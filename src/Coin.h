@@ -9,29 +9,54 @@
 #include "Data.h"
 #include "Hash.h"
 #include "DerivationPath.h"
+#include "ParsedAddress.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
+#include "SigningTemplate.h"
 
+#include <TrustWalletCore/TWAnySigner.h>
 #include <TrustWalletCore/TWBlockchain.h>
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWCurve.h>
 #include <TrustWalletCore/TWHDVersion.h>
 #include <TrustWalletCore/TWPurpose.h>
 
+#include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+namespace google::protobuf {
+class Message;
+} // namespace google::protobuf
+
 namespace TW {
 
 // Return the set of supported coin types.
 std::vector<TWCoinType> getCoinTypes();
 
+/// Number of supported coin types.
+extern const size_t coinCount;
+
+/// Returns a dense index of the coin type, in [0, coinCount), or coinCount if the coin is not supported.
+size_t coinOrdinal(TWCoinType coin);
+
 /// Validates an address for a particular coin.
 bool validateAddress(TWCoinType coin, const std::string& address);
 
+/// Validates many addresses for a particular coin, returned in the same order as `addresses`.
+/// The coin configuration is looked up once, the work is spread over `threadCount` threads
+/// (0: one per hardware thread, small batches use the calling thread only).
+std::vector<bool> validateAddresses(TWCoinType coin, const std::vector<std::string>& addresses, size_t threadCount = 0);
+
 /// Validates and normalizes an address for a particular coin.
 std::string normalizeAddress(TWCoinType coin, const std::string& address);
 
+/// Validates, normalizes and, for coins that support it, decodes an address for a particular coin, in one pass.
+/// Returns nothing if the address is invalid.
+std::optional<ParsedAddress> parseAddress(TWCoinType coin, const std::string& address);
+
 /// Returns the blockchain for a coin type.
 TWBlockchain blockchain(TWCoinType coin);
 
@@ -78,7 +103,21 @@ byte p2shPrefix(TWCoinType coin);
 enum TWHRP hrp(TWCoinType coin);
 
 // Note: use output parameter to avoid unneeded copies
-void anyCoinSign(TWCoinType coinType, const Data& dataIn, Data& dataOut);
+void anyCoinSign(TWCoinType coinType, DataView dataIn, Data& dataOut);
+
+/// Signs with typed messages, passed by reference instead of serialized bytes.
+/// `input` and `output` must be the SigningInput and SigningOutput messages of the coin.
+/// \throws std::invalid_argument if the message types don't match the coin, or if the coin isn't supported.
+void anyCoinSign(TWCoinType coinType, const google::protobuf::Message& input, google::protobuf::Message& output);
+
+/// Signs with typed messages, e.g. `anyCoinSign<Ethereum::Proto::SigningInput, Ethereum::Proto::SigningOutput>(coin, input)`.
+/// \throws std::invalid_argument if the message types don't match the coin.
+template <typename Input, typename Output>
+Output anyCoinSign(TWCoinType coinType, const Input& input) {
+    Output output;
+    anyCoinSign(coinType, static_cast<const google::protobuf::Message&>(input), static_cast<google::protobuf::Message&>(output));
+    return output;
+}
 
 uint32_t slip44Id(TWCoinType coin);
 
@@ -86,7 +125,32 @@ std::string anySignJSON(TWCoinType coinType, const std::string& json, const Data
 
 bool supportsJSONSigning(TWCoinType coinType);
 
-void anyCoinPlan(TWCoinType coinType, const Data& dataIn, Data& dataOut);
+void anyCoinPlan(TWCoinType coinType, DataView dataIn, Data& dataOut);
+
+/// Digests to sign for a signing input referencing its keys by public key, as a serialized
+/// TxCompiler::Proto::PreSigningOutput; see CoinEntry::preImageHashes.
+void anyCoinPreImageHashes(TWCoinType coinType, DataView dataIn, Data& dataOut);
+
+/// Signing output of a signing input with the signatures of its anyCoinPreImageHashes digests, in the same order;
+/// empty if they don't match.
+void anyCoinCompileWithSignatures(TWCoinType coinType, DataView dataIn, const std::vector<Data>& signatures, Data& dataOut);
+
+/// Result of a transaction signed by anyCoinSignBatch.
+struct BatchSigningResult {
+    /// Serialized signing output, empty on error.
+    Data output;
+    TWAnySignerBatchError error = TWAnySignerBatchErrorNone;
+};
+
+/// Signs serialized signing inputs of any coins, returned in the same order.
+/// Transactions are handed to `threadCount` threads (0: one per hardware thread) one at a time,
+/// so that slow ones don't hold back the others.  An exception fails only its own transaction.
+/// Each thread parses its inputs in a reused protobuf arena (see ScopedSigningArena).
+std::vector<BatchSigningResult> anyCoinSignBatch(const std::vector<std::pair<TWCoinType, Data>>& inputs, size_t threadCount = 0);
+
+/// Prepares a signing template from a serialized base signing input, see SigningTemplate.
+/// Returns null if the coin or the kind of transaction doesn't support templates, or if the input is invalid.
+std::unique_ptr<SigningTemplate> anyCoinSigningTemplate(TWCoinType coinType, const Data& dataIn);
 
 // Return coins handled by the same dispatcher as the given coin (mostly for testing)
 const std::vector<TWCoinType> getSimilarCoinTypes(TWCoinType coinType);
@@ -106,8 +170,8 @@ struct CoinInfo {
     byte p2pkhPrefix;
     byte p2shPrefix;
     TWHRP hrp;
-    Hash::Hasher publicKeyHasher;
-    Hash::Hasher base58Hasher;
+    Hash::HasherSimpleType publicKeyHasher;
+    Hash::HasherSimpleType base58Hasher;
     const char* symbol;
     int decimals;
     const char* explorerTransactionUrl;
@@ -0,0 +1,94 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CoinEntry.h"
+#include "SignerBackend.h"
+#include "proto/TxCompiler.pb.h"
+
+#include <utility>
+
+using namespace TW;
+
+namespace {
+
+/// Records the digests of the signer, and fails them.
+class RecordingBackend : public SignerBackend {
+  public:
+    std::vector<DigestSigningRequest> requests;
+
+    std::future<std::vector<Data>> sign(std::vector<DigestSigningRequest> requests) override {
+        std::promise<std::vector<Data>> result;
+        result.set_value(std::vector<Data>(requests.size()));
+        for (auto& request : requests) {
+            this->requests.push_back(std::move(request));
+        }
+        return result.get_future();
+    }
+};
+
+/// Answers the digests of the signer with the given signatures, in order.
+class ReplayingBackend : public SignerBackend {
+  public:
+    explicit ReplayingBackend(const std::vector<Data>& signatures) : signatures(signatures) {}
+
+    /// Number of signatures used.
+    std::size_t used = 0;
+
+    std::future<std::vector<Data>> sign(std::vector<DigestSigningRequest> requests) override {
+        std::vector<Data> answers(requests.size());
+        for (auto& answer : answers) {
+            if (used < signatures.size()) {
+                answer = signatures[used];
+            }
+            ++used;
+        }
+        std::promise<std::vector<Data>> result;
+        result.set_value(std::move(answers));
+        return result.get_future();
+    }
+
+  private:
+    const std::vector<Data>& signatures;
+};
+
+} // namespace
+
+void CoinEntry::preImageHashes(TWCoinType coin, DataView dataIn, Data& dataOut) const {
+    RecordingBackend backend;
+    {
+        ScopedSignerBackend scope(backend);
+        Data ignored;
+        sign(coin, dataIn, ignored);
+    }
+    TxCompiler::Proto::PreSigningOutput output;
+    for (const auto& request : backend.requests) {
+        auto* hash = output.add_hashes();
+        hash->set_digest(request.digest.data(), request.digest.size());
+        hash->set_curve(static_cast<uint32_t>(request.curve));
+        hash->set_public_key(request.publicKey.bytes.data(), request.publicKey.bytes.size());
+        hash->set_public_key_type(static_cast<uint32_t>(request.publicKey.type));
+    }
+    if (backend.requests.empty()) {
+        // the signer doesn't take a backend, or the input is invalid
+        output.set_error(Common::Proto::Error_signing);
+    }
+    const auto serialized = output.SerializeAsString();
+    dataOut.insert(dataOut.end(), serialized.begin(), serialized.end());
+}
+
+void CoinEntry::compileWithSignatures(TWCoinType coin, DataView dataIn, const std::vector<Data>& signatures, Data& dataOut) const {
+    ReplayingBackend backend(signatures);
+    Data output;
+    {
+        ScopedSignerBackend scope(backend);
+        sign(coin, dataIn, output);
+    }
+    if (backend.used != signatures.size()) {
+        // not the signatures of this input
+        return;
+    }
+    dataOut.insert(dataOut.end(), output.begin(), output.end());
+}
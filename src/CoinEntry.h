@@ -9,10 +9,17 @@
 #include <TrustWalletCore/TWCoinType.h>
 
 #include "Data.h"
+#include "ParsedAddress.h"
 #include "PublicKey.h"
 #include "PrivateKey.h"
+#include "SigningTemplate.h"
 
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message.h>
+
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace TW {
@@ -26,35 +33,108 @@ public:
     virtual bool validateAddress(TWCoinType coin, const std::string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp) const = 0;
     // normalizeAddress is optional, it may leave this default, no-change implementation
     virtual std::string normalizeAddress(TWCoinType coin, const std::string& address) const { return address; }
+    // parseAddress validates, normalizes and possibly decodes an address at once; returns false if it is invalid.
+    // It is optional, the default implementation calls validateAddress and normalizeAddress and leaves the data unset;
+    // coins decoding addresses to validate them override it to keep the decoded data.
+    virtual bool parseAddress(TWCoinType coin, const std::string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp, ParsedAddress& parsed) const {
+        if (!validateAddress(coin, address, p2pkh, p2sh, hrp)) {
+            return false;
+        }
+        parsed.normalized = normalizeAddress(coin, address);
+        return true;
+    }
     virtual std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte p2pkh, const char* hrp) const = 0;
     // Signing
-    virtual void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const = 0;
+    virtual void sign(TWCoinType coin, DataView dataIn, Data& dataOut) const = 0;
+    // Typed signing, with the coin's SigningInput and SigningOutput messages; returns false if the message types don't match.
+    // The default implementation goes through the serialized form, coins using signTemplate override it with signMessageTemplate.
+    virtual bool signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+        const auto serializedIn = input.SerializeAsString();
+        Data dataOut;
+        sign(coin, DataView(reinterpret_cast<const byte*>(serializedIn.data()), serializedIn.size()), dataOut);
+        return output.ParseFromArray(dataOut.data(), (int)dataOut.size());
+    }
     virtual bool supportsJSONSigning() const { return false; }
     // It is optional, Signing JSON input with private key
     virtual std::string signJSON(TWCoinType coin, const std::string& json, const Data& key) const { return ""; }
     // Planning, for UTXO chains, in preparation for signing
     // It is optional, only UTXO chains need it, default impl. leaves empty result.
-    virtual void plan(TWCoinType coin, const Data& dataIn, Data& dataOut) const { return; }
+    virtual void plan(TWCoinType coin, DataView dataIn, Data& dataOut) const { return; }
+    // Two-phase signing, for signatures made out of process.  preImageHashes outputs the digests a transaction needs
+    // signed (a serialized TxCompiler::Proto::PreSigningOutput), compileWithSignatures its signing output with their
+    // 64-byte signatures, in the same order.  The signing input references its keys by public key, as for a
+    // SignerBackend.  The default implementations run the coin signer with a backend recording or replaying the
+    // digests, they support the coins whose signer accepts a SignerBackend, and return an error for the others.
+    virtual void preImageHashes(TWCoinType coin, DataView dataIn, Data& dataOut) const;
+    virtual void compileWithSignatures(TWCoinType coin, DataView dataIn, const std::vector<Data>& signatures, Data& dataOut) const;
+    // Template signing of transactions that differ only in nonce, recipient and amount, from a serialized base input.
+    // It is optional, for account-based chains; returns null if the coin or the kind of transaction isn't supported.
+    virtual std::unique_ptr<SigningTemplate> signingTemplate(TWCoinType coin, const Data& dataIn) const { return nullptr; }
+};
+
+/// Makes signTemplate and planTemplate parse signing inputs into `arena` on the current thread, while in scope.
+/// Without one, each call uses its own short-lived arena.  The arena is not reset, this is up to the owner.
+class ScopedSigningArena {
+public:
+    explicit ScopedSigningArena(google::protobuf::Arena& arena) : previous(currentArena) { currentArena = &arena; }
+    ~ScopedSigningArena() { currentArena = previous; }
+    ScopedSigningArena(const ScopedSigningArena&) = delete;
+    ScopedSigningArena& operator=(const ScopedSigningArena&) = delete;
+
+    /// Arena of the innermost scope on the current thread, or null.
+    static google::protobuf::Arena* current() { return currentArena; }
+
+private:
+    static inline thread_local google::protobuf::Arena* currentArena = nullptr;
+    google::protobuf::Arena* previous;
 };
 
+// Parses a signing input in an arena, so that the submessages (UTXOs, repeated messages) are not allocated one by one.
+template <typename Input, typename Function>
+void withArenaInput(DataView dataIn, Function&& function) {
+    auto* arena = ScopedSigningArena::current();
+    if (arena == nullptr) {
+        google::protobuf::Arena localArena;
+        auto* input = google::protobuf::Arena::CreateMessage<Input>(&localArena);
+        input->ParseFromArray(dataIn.data(), (int)dataIn.size());
+        function(*input);
+        return;
+    }
+    auto* input = google::protobuf::Arena::CreateMessage<Input>(arena);
+    input->ParseFromArray(dataIn.data(), (int)dataIn.size());
+    function(*input);
+}
+
 // In each coin's Entry.cpp the specific types of the coin are used, this template enforces the Signer implement:
 // static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 // Note: use output parameter to avoid unneeded copies
 template <typename Signer, typename Input>
-void signTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Signer::sign(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+void signTemplate(DataView dataIn, Data& dataOut) {
+    withArenaInput<Input>(dataIn, [&](Input& input) {
+        auto serializedOut = Signer::sign(input).SerializeAsString();
+        dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+    });
+}
+
+// Typed counterpart of signTemplate, the messages are passed by reference without serialization.
+// Returns false if `input` and `output` are not the Input and Signer output types.
+template <typename Signer, typename Input>
+bool signMessageTemplate(const google::protobuf::Message& input, google::protobuf::Message& output) {
+    using Output = decltype(Signer::sign(std::declval<const Input&>()));
+    if (input.GetDescriptor() != Input::descriptor() || output.GetDescriptor() != Output::descriptor()) {
+        return false;
+    }
+    static_cast<Output&>(output) = Signer::sign(static_cast<const Input&>(input));
+    return true;
 }
 
 // Note: use output parameter to avoid unneeded copies
 template <typename Planner, typename Input>
-void planTemplate(const Data& dataIn, Data& dataOut) {
-    auto input = Input();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Planner::plan(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+void planTemplate(DataView dataIn, Data& dataOut) {
+    withArenaInput<Input>(dataIn, [&](Input& input) {
+        auto serializedOut = Planner::plan(input).SerializeAsString();
+        dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+    });
 }
 
 } // namespace TW
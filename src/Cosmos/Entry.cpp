@@ -18,14 +18,29 @@ bool Entry::validateAddress(TWCoinType coin, const string& address, TW::byte, TW
     return Address::isValid(address, hrp);
 }
 
+bool Entry::parseAddress(TWCoinType coin, const string& address, TW::byte, TW::byte, const char* hrp, ParsedAddress& parsed) const {
+    Address decoded;
+    if (!Bech32Address::decode(address, decoded, hrp)) {
+        return false;
+    }
+    parsed.normalized = address;
+    parsed.data = decoded.getKeyHash();
+    parsed.hasData = true;
+    return true;
+}
+
 string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte, const char* hrp) const {
     return Address(hrp, publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
 
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
 string Entry::signJSON(TWCoinType coin, const std::string& json, const Data& key) const { 
     return Signer::signJSON(json, key);
 }
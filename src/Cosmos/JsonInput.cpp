@@ -0,0 +1,200 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "JsonInput.h"
+
+#include "../ProtoJSON.h"
+
+#include <google/protobuf/util/json_util.h>
+
+using namespace TW;
+using namespace TW::Cosmos;
+using namespace TW::ProtoJSON;
+
+static bool parseAmount(const json& value, Proto::Amount& amount) {
+    static const Field<Proto::Amount> fields[] = {
+        {"denom", "denom", [](const json& v, Proto::Amount& m) { return readString(v, *m.mutable_denom()); }},
+        {"amount", "amount", [](const json& v, Proto::Amount& m) {
+            int64_t amount = 0;
+            if (!readInt64(v, amount)) {
+                return false;
+            }
+            m.set_amount(amount);
+            return true;
+        }},
+    };
+    return parseObject(value, amount, fields);
+}
+
+static bool parseAmounts(const json& value, google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
+    if (!value.is_array()) {
+        return false;
+    }
+    for (const auto& item : value) {
+        if (!parseAmount(item, *amounts.Add())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parseFee(const json& value, Proto::Fee& fee) {
+    static const Field<Proto::Fee> fields[] = {
+        {"amounts", "amounts", [](const json& v, Proto::Fee& m) { return parseAmounts(v, *m.mutable_amounts()); }},
+        {"gas", "gas", [](const json& v, Proto::Fee& m) {
+            uint64_t gas = 0;
+            if (!readUInt64(v, gas)) {
+                return false;
+            }
+            m.set_gas(gas);
+            return true;
+        }},
+    };
+    return parseObject(value, fee, fields);
+}
+
+static bool parseSend(const json& value, Proto::Message_Send& message) {
+    using Message = Proto::Message_Send;
+    static const Field<Message> fields[] = {
+        {"fromAddress", "from_address", [](const json& v, Message& m) { return readString(v, *m.mutable_from_address()); }},
+        {"toAddress", "to_address", [](const json& v, Message& m) { return readString(v, *m.mutable_to_address()); }},
+        {"amounts", "amounts", [](const json& v, Message& m) { return parseAmounts(v, *m.mutable_amounts()); }},
+        {"typePrefix", "type_prefix", [](const json& v, Message& m) { return readString(v, *m.mutable_type_prefix()); }},
+    };
+    return parseObject(value, message, fields);
+}
+
+/// Delegate and Undelegate have the same fields.
+template <typename Message>
+static bool parseDelegation(const json& value, Message& message) {
+    static const Field<Message> fields[] = {
+        {"delegatorAddress", "delegator_address", [](const json& v, Message& m) { return readString(v, *m.mutable_delegator_address()); }},
+        {"validatorAddress", "validator_address", [](const json& v, Message& m) { return readString(v, *m.mutable_validator_address()); }},
+        {"amount", "amount", [](const json& v, Message& m) { return parseAmount(v, *m.mutable_amount()); }},
+        {"typePrefix", "type_prefix", [](const json& v, Message& m) { return readString(v, *m.mutable_type_prefix()); }},
+    };
+    return parseObject(value, message, fields);
+}
+
+static bool parseRedelegate(const json& value, Proto::Message_BeginRedelegate& message) {
+    using Message = Proto::Message_BeginRedelegate;
+    static const Field<Message> fields[] = {
+        {"delegatorAddress", "delegator_address", [](const json& v, Message& m) { return readString(v, *m.mutable_delegator_address()); }},
+        {"validatorSrcAddress", "validator_src_address", [](const json& v, Message& m) { return readString(v, *m.mutable_validator_src_address()); }},
+        {"validatorDstAddress", "validator_dst_address", [](const json& v, Message& m) { return readString(v, *m.mutable_validator_dst_address()); }},
+        {"amount", "amount", [](const json& v, Message& m) { return parseAmount(v, *m.mutable_amount()); }},
+        {"typePrefix", "type_prefix", [](const json& v, Message& m) { return readString(v, *m.mutable_type_prefix()); }},
+    };
+    return parseObject(value, message, fields);
+}
+
+static bool parseWithdrawReward(const json& value, Proto::Message_WithdrawDelegationReward& message) {
+    using Message = Proto::Message_WithdrawDelegationReward;
+    static const Field<Message> fields[] = {
+        {"delegatorAddress", "delegator_address", [](const json& v, Message& m) { return readString(v, *m.mutable_delegator_address()); }},
+        {"validatorAddress", "validator_address", [](const json& v, Message& m) { return readString(v, *m.mutable_validator_address()); }},
+        {"typePrefix", "type_prefix", [](const json& v, Message& m) { return readString(v, *m.mutable_type_prefix()); }},
+    };
+    return parseObject(value, message, fields);
+}
+
+static bool parseRawJSON(const json& value, Proto::Message_RawJSON& message) {
+    using Message = Proto::Message_RawJSON;
+    static const Field<Message> fields[] = {
+        {"type", "type", [](const json& v, Message& m) { return readString(v, *m.mutable_type()); }},
+        {"value", "value", [](const json& v, Message& m) { return readString(v, *m.mutable_value()); }},
+    };
+    return parseObject(value, message, fields);
+}
+
+static bool parseMessage(const json& value, Proto::Message& message) {
+    using Message = Proto::Message;
+    // Setting a second member of the oneof would silently replace the first one, reject it like protobuf does
+    static const Field<Message> fields[] = {
+        {"sendCoinsMessage", "send_coins_message", [](const json& v, Message& m) {
+            return m.message_oneof_case() == Message::MESSAGE_ONEOF_NOT_SET && parseSend(v, *m.mutable_send_coins_message());
+        }},
+        {"stakeMessage", "stake_message", [](const json& v, Message& m) {
+            return m.message_oneof_case() == Message::MESSAGE_ONEOF_NOT_SET && parseDelegation(v, *m.mutable_stake_message());
+        }},
+        {"unstakeMessage", "unstake_message", [](const json& v, Message& m) {
+            return m.message_oneof_case() == Message::MESSAGE_ONEOF_NOT_SET && parseDelegation(v, *m.mutable_unstake_message());
+        }},
+        {"restakeMessage", "restake_message", [](const json& v, Message& m) {
+            return m.message_oneof_case() == Message::MESSAGE_ONEOF_NOT_SET && parseRedelegate(v, *m.mutable_restake_message());
+        }},
+        {"withdrawStakeRewardMessage", "withdraw_stake_reward_message", [](const json& v, Message& m) {
+            return m.message_oneof_case() == Message::MESSAGE_ONEOF_NOT_SET && parseWithdrawReward(v, *m.mutable_withdraw_stake_reward_message());
+        }},
+        {"rawJsonMessage", "raw_json_message", [](const json& v, Message& m) {
+            return m.message_oneof_case() == Message::MESSAGE_ONEOF_NOT_SET && parseRawJSON(v, *m.mutable_raw_json_message());
+        }},
+    };
+    return parseObject(value, message, fields);
+}
+
+static bool parseInput(const json& value, Proto::SigningInput& input) {
+    using Message = Proto::SigningInput;
+    static const char* const modes[] = {"BLOCK", "SYNC", "ASYNC"};
+    static const Field<Message> fields[] = {
+        {"accountNumber", "account_number", [](const json& v, Message& m) {
+            uint64_t accountNumber = 0;
+            if (!readUInt64(v, accountNumber)) {
+                return false;
+            }
+            m.set_account_number(accountNumber);
+            return true;
+        }},
+        {"chainId", "chain_id", [](const json& v, Message& m) { return readString(v, *m.mutable_chain_id()); }},
+        {"fee", "fee", [](const json& v, Message& m) { return parseFee(v, *m.mutable_fee()); }},
+        {"memo", "memo", [](const json& v, Message& m) { return readString(v, *m.mutable_memo()); }},
+        {"sequence", "sequence", [](const json& v, Message& m) {
+            uint64_t sequence = 0;
+            if (!readUInt64(v, sequence)) {
+                return false;
+            }
+            m.set_sequence(sequence);
+            return true;
+        }},
+        {"messages", "messages", [](const json& v, Message& m) {
+            if (!v.is_array()) {
+                return false;
+            }
+            for (const auto& item : v) {
+                if (!parseMessage(item, *m.add_messages())) {
+                    return false;
+                }
+            }
+            return true;
+        }},
+        {"mode", "mode", [](const json& v, Message& m) {
+            int mode = 0;
+            if (!readEnum(v, modes, mode)) {
+                return false;
+            }
+            m.set_mode(static_cast<Proto::BroadcastMode>(mode));
+            return true;
+        }},
+    };
+    return parseObject(value, input, fields);
+}
+
+bool Cosmos::parseSigningInputJSON(const std::string& string, Proto::SigningInput& input) {
+    const auto value = json::parse(string, nullptr, false);
+    if (value.is_discarded()) {
+        return false;
+    }
+    return parseInput(value, input);
+}
+
+Proto::SigningInput Cosmos::signingInputFromJSON(const std::string& json) {
+    auto input = Proto::SigningInput();
+    if (!parseSigningInputJSON(json, input)) {
+        input.Clear();
+        google::protobuf::util::JsonStringToMessage(json, &input);
+    }
+    return input;
+}
@@ -0,0 +1,24 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../proto/Cosmos.pb.h"
+
+#include <string>
+
+namespace TW::Cosmos {
+
+/// Parses a SigningInput in the proto3 JSON mapping without protobuf reflection.
+///
+/// Handles the fields used for JSON signing; returns false for anything else
+/// (including `privateKey`, which signJSON replaces anyway), leaving `input` in an unspecified state.
+bool parseSigningInputJSON(const std::string& json, Proto::SigningInput& input);
+
+/// Parses a SigningInput from JSON, falling back to protobuf's parser when the fast path doesn't apply.
+Proto::SigningInput signingInputFromJSON(const std::string& json);
+
+} // namespace TW::Cosmos
@@ -0,0 +1,182 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ProtobufSerialization.h"
+
+#include "Base64.h"
+#include "Hash.h"
+#include "JsonWriter.h"
+#include "ProtobufWriter.h"
+
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Cosmos;
+
+namespace {
+
+const std::string TYPE_URL_MSG_SEND = "/cosmos.bank.v1beta1.MsgSend";
+const std::string TYPE_URL_MSG_DELEGATE = "/cosmos.staking.v1beta1.MsgDelegate";
+const std::string TYPE_URL_MSG_UNDELEGATE = "/cosmos.staking.v1beta1.MsgUndelegate";
+const std::string TYPE_URL_MSG_REDELEGATE = "/cosmos.staking.v1beta1.MsgBeginRedelegate";
+const std::string TYPE_URL_MSG_WITHDRAW_REWARD = "/cosmos.distribution.v1beta1.MsgWithdrawDelegatorReward";
+const std::string TYPE_URL_MSG_THORCHAIN_SEND = "/types.MsgSend";
+const std::string TYPE_URL_PUBLIC_KEY = "/cosmos.crypto.secp256k1.PubKey";
+
+// tx.v1beta1.ModeInfo.Single.mode
+const uint64_t SIGN_MODE_DIRECT = 1;
+
+/// cosmos.base.v1beta1.Coin
+Data coin(const Proto::Amount& amount) {
+    Data data;
+    ProtobufWriter(data).bytes(1, amount.denom()).bytes(2, std::to_string(amount.amount()));
+    return data;
+}
+
+void writeCoins(ProtobufWriter& writer, uint32_t field, const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
+    for (const auto& amount : amounts) {
+        writer.message(field, coin(amount));
+    }
+}
+
+/// google.protobuf.Any
+Data any(const std::string& typeUrl, const Data& value) {
+    Data data;
+    data.reserve(ProtobufWriter::fieldSize(1, typeUrl.size()) + ProtobufWriter::fieldSize(2, value.size()));
+    ProtobufWriter(data).bytes(1, typeUrl).bytes(2, value);
+    return data;
+}
+
+template <typename Message>
+Data delegation(const Message& message) {
+    Data data;
+    ProtobufWriter(data)
+        .bytes(1, message.delegator_address())
+        .bytes(2, message.validator_address())
+        .message(3, coin(message.amount()));
+    return data;
+}
+
+/// The message packed in an Any
+Data message(const Proto::Message& msg) {
+    Data data;
+    ProtobufWriter writer(data);
+    if (msg.has_send_coins_message()) {
+        const auto& send = msg.send_coins_message();
+        writer.bytes(1, send.from_address()).bytes(2, send.to_address());
+        writeCoins(writer, 3, send.amounts());
+        return any(TYPE_URL_MSG_SEND, data);
+    }
+    if (msg.has_thorchain_send_message()) {
+        const auto& send = msg.thorchain_send_message();
+        writer.bytes(1, send.from_address()).bytes(2, send.to_address());
+        writeCoins(writer, 3, send.amounts());
+        return any(TYPE_URL_MSG_THORCHAIN_SEND, data);
+    }
+    if (msg.has_stake_message()) {
+        return any(TYPE_URL_MSG_DELEGATE, delegation(msg.stake_message()));
+    }
+    if (msg.has_unstake_message()) {
+        return any(TYPE_URL_MSG_UNDELEGATE, delegation(msg.unstake_message()));
+    }
+    if (msg.has_restake_message()) {
+        const auto& restake = msg.restake_message();
+        writer.bytes(1, restake.delegator_address())
+            .bytes(2, restake.validator_src_address())
+            .bytes(3, restake.validator_dst_address())
+            .message(4, coin(restake.amount()));
+        return any(TYPE_URL_MSG_REDELEGATE, data);
+    }
+    if (msg.has_withdraw_stake_reward_message()) {
+        const auto& withdraw = msg.withdraw_stake_reward_message();
+        writer.bytes(1, withdraw.delegator_address()).bytes(2, withdraw.validator_address());
+        return any(TYPE_URL_MSG_WITHDRAW_REWARD, data);
+    }
+    throw std::invalid_argument("Message not supported in Protobuf signing mode");
+}
+
+const char* broadcastMode(Proto::BroadcastMode mode) {
+    switch (mode) {
+    case Proto::BroadcastMode::BLOCK:
+        return "BROADCAST_MODE_BLOCK";
+    case Proto::BroadcastMode::ASYNC:
+        return "BROADCAST_MODE_ASYNC";
+    default: return "BROADCAST_MODE_SYNC";
+    }
+}
+
+} // namespace
+
+Data Cosmos::protobufTxBody(const Proto::SigningInput& input) {
+    Data body;
+    ProtobufWriter writer(body);
+    for (const auto& msg : input.messages()) {
+        if (msg.message_oneof_case() == Proto::Message::MESSAGE_ONEOF_NOT_SET) {
+            continue;
+        }
+        writer.message(1, message(msg));
+    }
+    writer.bytes(2, input.memo());
+    return body;
+}
+
+Data Cosmos::protobufAuthInfo(const Proto::SigningInput& input, const PublicKey& publicKey) {
+    // secp256k1.PubKey
+    Data key;
+    ProtobufWriter(key).bytes(1, publicKey.bytes);
+    // ModeInfo, with its Single
+    Data single;
+    ProtobufWriter(single).varint(1, SIGN_MODE_DIRECT);
+    Data modeInfo;
+    ProtobufWriter(modeInfo).message(1, single);
+
+    Data signerInfo;
+    ProtobufWriter(signerInfo)
+        .message(1, any(TYPE_URL_PUBLIC_KEY, key))
+        .message(2, modeInfo)
+        .varint(3, input.sequence());
+
+    Data fee;
+    ProtobufWriter feeWriter(fee);
+    writeCoins(feeWriter, 1, input.fee().amounts());
+    feeWriter.varint(2, input.fee().gas());
+
+    Data authInfo;
+    authInfo.reserve(signerInfo.size() + fee.size() + 6);
+    ProtobufWriter(authInfo).message(1, signerInfo).message(2, fee);
+    return authInfo;
+}
+
+Data Cosmos::protobufSignDocHash(const Proto::SigningInput& input, const Data& body, const Data& authInfo) {
+    Data signDoc;
+    signDoc.reserve(ProtobufWriter::fieldSize(1, body.size()) + ProtobufWriter::fieldSize(2, authInfo.size()) +
+                    ProtobufWriter::fieldSize(3, input.chain_id().size()) + 11);
+    ProtobufWriter(signDoc)
+        .bytes(1, body)
+        .bytes(2, authInfo)
+        .bytes(3, input.chain_id())
+        .varint(4, input.account_number());
+    return Hash::sha256(signDoc);
+}
+
+Data Cosmos::protobufTxRaw(const Data& body, const Data& authInfo, const Data& signature) {
+    Data txRaw;
+    txRaw.reserve(ProtobufWriter::fieldSize(1, body.size()) + ProtobufWriter::fieldSize(2, authInfo.size()) +
+                  ProtobufWriter::fieldSize(3, signature.size()));
+    ProtobufWriter(txRaw).bytes(1, body).bytes(2, authInfo).message(3, signature);
+    return txRaw;
+}
+
+std::string Cosmos::protobufTxJSON(const Data& txRaw, Proto::BroadcastMode mode) {
+    std::string result;
+    JsonStringSink sink(result);
+    JsonWriter<JsonStringSink> writer(sink);
+    writer.beginObject();
+    writer.field("mode", broadcastMode(mode));
+    writer.field("tx_bytes", Base64::encode(txRaw));
+    writer.endObject();
+    return result;
+}
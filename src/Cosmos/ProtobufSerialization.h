@@ -0,0 +1,37 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../proto/Cosmos.pb.h"
+#include "Data.h"
+#include "PublicKey.h"
+
+#include <string>
+
+namespace TW::Cosmos {
+
+// Protobuf encoding of transactions, signed in SIGN_MODE_DIRECT: messages of the cosmos.tx.v1beta1
+// package, written in their deterministic encoding (fields in order, default values omitted).
+
+/// TxBody of the transaction.
+///
+/// @throws std::invalid_argument for messages without a protobuf form (raw JSON).
+Data protobufTxBody(const Proto::SigningInput& input);
+
+/// AuthInfo of the transaction, with its signer in SIGN_MODE_DIRECT.
+Data protobufAuthInfo(const Proto::SigningInput& input, const PublicKey& publicKey);
+
+/// SHA-256 of the SignDoc of the transaction, the signed hash.
+Data protobufSignDocHash(const Proto::SigningInput& input, const Data& body, const Data& authInfo);
+
+/// TxRaw of the signed transaction.
+Data protobufTxRaw(const Data& body, const Data& authInfo, const Data& signature);
+
+/// Broadcast request of a TxRaw, as JSON.
+std::string protobufTxJSON(const Data& txRaw, Proto::BroadcastMode mode);
+
+} // namespace TW::Cosmos
@@ -9,7 +9,10 @@
 #include "../Cosmos/Address.h"
 #include "../proto/Cosmos.pb.h"
 #include "Base64.h"
-#include "PrivateKey.h"
+#include "JsonWriter.h"
+#include "SignerBackend.h"
+
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Cosmos;
@@ -24,7 +27,7 @@ const string TYPE_PREFIX_MSG_REDELEGATE = "cosmos-sdk/MsgBeginRedelegate";
 const string TYPE_PREFIX_MSG_WITHDRAW_REWARD = "cosmos-sdk/MsgWithdrawDelegationReward";
 const string TYPE_PREFIX_PUBLIC_KEY = "tendermint/PubKeySecp256k1";
 
-static string broadcastMode(Proto::BroadcastMode mode) {
+static const char* broadcastMode(Proto::BroadcastMode mode) {
     switch (mode) {
     case Proto::BroadcastMode::BLOCK:
         return "block";
@@ -34,163 +37,174 @@ static string broadcastMode(Proto::BroadcastMode mode) {
     }
 }
 
-static json broadcastJSON(json& j, Proto::BroadcastMode mode) {
-    return {
-        {"tx", j},
-        {"mode", broadcastMode(mode)}
-    };
-}
+// Fields are written in sorted key order, matching json::dump() of the equivalent object.
 
-static json amountJSON(const Proto::Amount& amount) {
-    return {
-        {"amount", std::to_string(amount.amount())},
-        {"denom", amount.denom()}
-    };
+template <typename Sink>
+static void writeAmount(JsonWriter<Sink>& writer, const Proto::Amount& amount) {
+    writer.beginObject();
+    writer.field("amount", std::to_string(amount.amount()));
+    writer.field("denom", amount.denom());
+    writer.endObject();
 }
 
-static json amountsJSON(const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
-    json j = json::array();
+template <typename Sink>
+static void writeAmounts(JsonWriter<Sink>& writer, const ::google::protobuf::RepeatedPtrField<Proto::Amount>& amounts) {
+    writer.beginArray();
     for (auto& amount : amounts) {
-        j.push_back(amountJSON(amount));
+        writeAmount(writer, amount);
     }
-    return j;
+    writer.endArray();
 }
 
-static json feeJSON(const Proto::Fee& fee) {
-    json js = json::array();
-
-    for (auto& amount : fee.amounts()) {
-        js.push_back(amountJSON(amount));
-    }
-
-    return {
-        {"amount", js},
-        {"gas", std::to_string(fee.gas())}
-    };
+template <typename Sink>
+static void writeFee(JsonWriter<Sink>& writer, const Proto::Fee& fee) {
+    writer.beginObject();
+    writer.key("amount");
+    writeAmounts(writer, fee.amounts());
+    writer.field("gas", std::to_string(fee.gas()));
+    writer.endObject();
 }
 
-static json messageSend(const Proto::Message_Send& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_SEND : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountsJSON(message.amounts())},
-            {"from_address", message.from_address()},
-            {"to_address", message.to_address()}
-        }}
-    };
+template <typename Sink>
+static void writeMessageSend(JsonWriter<Sink>& writer, const Proto::Message_Send& message) {
+    writer.field("type", message.type_prefix().empty() ? TYPE_PREFIX_MSG_SEND : message.type_prefix());
+    writer.key("value");
+    writer.beginObject();
+    writer.key("amount");
+    writeAmounts(writer, message.amounts());
+    writer.field("from_address", message.from_address());
+    writer.field("to_address", message.to_address());
+    writer.endObject();
 }
 
-static json messageDelegate(const Proto::Message_Delegate& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_DELEGATE : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+template <typename Sink, typename Message>
+static void writeMessageDelegation(JsonWriter<Sink>& writer, const Message& message, const string& defaultTypePrefix) {
+    writer.field("type", message.type_prefix().empty() ? defaultTypePrefix : message.type_prefix());
+    writer.key("value");
+    writer.beginObject();
+    writer.key("amount");
+    writeAmount(writer, message.amount());
+    writer.field("delegator_address", message.delegator_address());
+    writer.field("validator_address", message.validator_address());
+    writer.endObject();
 }
 
-static json messageUndelegate(const Proto::Message_Undelegate& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_UNDELEGATE : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+template <typename Sink>
+static void writeMessageRedelegate(JsonWriter<Sink>& writer, const Proto::Message_BeginRedelegate& message) {
+    writer.field("type", message.type_prefix().empty() ? TYPE_PREFIX_MSG_REDELEGATE : message.type_prefix());
+    writer.key("value");
+    writer.beginObject();
+    writer.key("amount");
+    writeAmount(writer, message.amount());
+    writer.field("delegator_address", message.delegator_address());
+    writer.field("validator_dst_address", message.validator_dst_address());
+    writer.field("validator_src_address", message.validator_src_address());
+    writer.endObject();
 }
 
-static json messageRedelegate(const Proto::Message_BeginRedelegate& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_REDELEGATE : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"amount", amountJSON(message.amount())},
-            {"delegator_address", message.delegator_address()},
-            {"validator_src_address", message.validator_src_address()},
-            {"validator_dst_address", message.validator_dst_address()},
-        }}
-    };
+template <typename Sink>
+static void writeMessageWithdrawReward(JsonWriter<Sink>& writer, const Proto::Message_WithdrawDelegationReward& message) {
+    writer.field("type", message.type_prefix().empty() ? TYPE_PREFIX_MSG_WITHDRAW_REWARD : message.type_prefix());
+    writer.key("value");
+    writer.beginObject();
+    writer.field("delegator_address", message.delegator_address());
+    writer.field("validator_address", message.validator_address());
+    writer.endObject();
 }
 
-static json messageWithdrawReward(const Proto::Message_WithdrawDelegationReward& message) {
-    auto typePrefix = message.type_prefix().empty() ? TYPE_PREFIX_MSG_WITHDRAW_REWARD : message.type_prefix();
-
-    return {
-        {"type", typePrefix},
-        {"value", {
-            {"delegator_address", message.delegator_address()},
-            {"validator_address", message.validator_address()}
-        }}
-    };
+template <typename Sink>
+static void writeMessageRawJSON(JsonWriter<Sink>& writer, const Proto::Message_RawJSON& message) {
+    writer.field("type", message.type());
+    writer.key("value");
+    // arbitrary content, normalized through the DOM
+    writer.rawValue(json::parse(message.value()).dump());
 }
 
-static json messageRawJSON(const Proto::Message_RawJSON& message) {
-    return {
-        {"type", message.type()},
-        {"value", json::parse(message.value())},
-    };
-}
-static json messagesJSON(const Proto::SigningInput& input) {
-    json j = json::array();
+template <typename Sink>
+static void writeMessages(JsonWriter<Sink>& writer, const Proto::SigningInput& input) {
+    writer.beginArray();
     for (auto& msg : input.messages()) {
+        if (msg.message_oneof_case() == Proto::Message::MESSAGE_ONEOF_NOT_SET) {
+            continue;
+        }
+        writer.beginObject();
         if (msg.has_send_coins_message()) {
-            j.push_back(messageSend(msg.send_coins_message()));
+            writeMessageSend(writer, msg.send_coins_message());
         } else if (msg.has_stake_message()) {
-            j.push_back(messageDelegate(msg.stake_message()));
+            writeMessageDelegation(writer, msg.stake_message(), TYPE_PREFIX_MSG_DELEGATE);
         } else if (msg.has_unstake_message()) {
-            j.push_back(messageUndelegate(msg.unstake_message()));
+            writeMessageDelegation(writer, msg.unstake_message(), TYPE_PREFIX_MSG_UNDELEGATE);
         } else if (msg.has_withdraw_stake_reward_message()) {
-            j.push_back(messageWithdrawReward(msg.withdraw_stake_reward_message()));
+            writeMessageWithdrawReward(writer, msg.withdraw_stake_reward_message());
         } else if (msg.has_restake_message()) {
-            j.push_back(messageRedelegate(msg.restake_message()));
+            writeMessageRedelegate(writer, msg.restake_message());
         } else if (msg.has_raw_json_message()) {
-            j.push_back(messageRawJSON(msg.raw_json_message()));
+            writeMessageRawJSON(writer, msg.raw_json_message());
+        } else {
+            throw std::invalid_argument("Message not supported in JSON signing mode");
         }
+        writer.endObject();
     }
-    return j;
+    writer.endArray();
+}
+
+template <typename Sink>
+static void writeSignaturePreimage(JsonWriter<Sink>& writer, const Proto::SigningInput& input) {
+    writer.beginObject();
+    writer.field("account_number", std::to_string(input.account_number()));
+    writer.field("chain_id", input.chain_id());
+    writer.key("fee");
+    writeFee(writer, input.fee());
+    writer.field("memo", input.memo());
+    writer.key("msgs");
+    writeMessages(writer, input);
+    writer.field("sequence", std::to_string(input.sequence()));
+    writer.endObject();
 }
 
-static json signatureJSON(const Data& signature, const Data& pubkey) {
-    return {
-        {"pub_key", {
-            {"type", TYPE_PREFIX_PUBLIC_KEY},
-            {"value", Base64::encode(pubkey)}
-        }},
-        {"signature", Base64::encode(signature)}
-    };
+string Cosmos::signaturePreimage(const Proto::SigningInput& input) {
+    string result;
+    JsonStringSink sink(result);
+    JsonWriter<JsonStringSink> writer(sink);
+    writeSignaturePreimage(writer, input);
+    return result;
 }
 
-json Cosmos::signaturePreimage(const Proto::SigningInput& input) {
-    return {
-        {"account_number", std::to_string(input.account_number())},
-        {"chain_id", input.chain_id()},
-        {"fee", feeJSON(input.fee())},
-        {"memo", input.memo()},
-        {"msgs", messagesJSON(input)},
-        {"sequence", std::to_string(input.sequence())}
-    };
+Data Cosmos::signaturePreimageHash(const Proto::SigningInput& input) {
+    JsonSha256Sink sink;
+    JsonWriter<JsonSha256Sink> writer(sink);
+    writeSignaturePreimage(writer, input);
+    return sink.digest();
 }
 
-json Cosmos::transactionJSON(const Proto::SigningInput& input, const Data& signature) {
-    auto privateKey = PrivateKey(input.private_key());
-    auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
-    json tx = {
-        {"fee", feeJSON(input.fee())},
-        {"memo", input.memo()},
-        {"msg", messagesJSON(input)},
-        {"signatures", json::array({
-            signatureJSON(signature, Data(publicKey.bytes))
-        })}
-    };
-    return broadcastJSON(tx, input.mode());
+string Cosmos::transactionJSON(const Proto::SigningInput& input, const Data& signature) {
+    auto key = SigningKey(input.private_key(), TWPublicKeyTypeSECP256k1);
+    auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+
+    string result;
+    JsonStringSink sink(result);
+    JsonWriter<JsonStringSink> writer(sink);
+    writer.beginObject();
+    writer.field("mode", broadcastMode(input.mode()));
+    writer.key("tx");
+    writer.beginObject();
+    writer.key("fee");
+    writeFee(writer, input.fee());
+    writer.field("memo", input.memo());
+    writer.key("msg");
+    writeMessages(writer, input);
+    writer.key("signatures");
+    writer.beginArray();
+    writer.beginObject();
+    writer.key("pub_key");
+    writer.beginObject();
+    writer.field("type", TYPE_PREFIX_PUBLIC_KEY);
+    writer.field("value", Base64::encode(publicKey.bytes.toData()));
+    writer.endObject();
+    writer.field("signature", Base64::encode(signature));
+    writer.endObject();
+    writer.endArray();
+    writer.endObject();
+    writer.endObject();
+    return result;
 }
@@ -22,7 +22,16 @@ extern const string TYPE_PREFIX_PUBLIC_KEY;
 
 namespace TW::Cosmos {
 
-json signaturePreimage(const Proto::SigningInput& input);
-json transactionJSON(const Proto::SigningInput& input, const Data& signature);
+// Amino JSON encoding of transactions; these throw std::invalid_argument for messages without an amino
+// JSON form (THORChainSend).
+
+/// Canonical JSON of the sign doc, keys sorted, without whitespace.
+string signaturePreimage(const Proto::SigningInput& input);
+
+/// SHA-256 of the sign doc JSON, hashed while it is serialized.
+Data signaturePreimageHash(const Proto::SigningInput& input);
+
+/// Signed transaction JSON, to be broadcast.
+string transactionJSON(const Proto::SigningInput& input, const Data& signature);
 
 } // namespace
@@ -5,34 +5,61 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
-#include "PrivateKey.h"
+#include "JsonInput.h"
+#include "ProtobufSerialization.h"
 #include "Serialization.h"
+#include "SignerBackend.h"
+#include "SigningOutputFields.h"
 
 #include "Data.h"
-#include "Hash.h"
 
-#include <google/protobuf/util/json_util.h>
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Cosmos;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(input.private_key());
-    auto preimage = signaturePreimage(input).dump();
-    auto hash = Hash::sha256(preimage);
+/// r and s, without the recovery id
+static Data compactSignature(const SigningKey& key, const Data& hash) {
     auto signedHash = key.sign(hash, TWCurveSECP256k1);
+    if (signedHash.empty()) {
+        throw std::runtime_error("Signing failed");
+    }
+    return Data(signedHash.begin(), signedHash.end() - 1);
+}
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto output = Proto::SigningOutput();
-    auto signature = Data(signedHash.begin(), signedHash.end() - 1);
-    auto txJson = transactionJSON(input, signature);
-    output.set_json(txJson.dump());
-    output.set_signature(signature.data(), signature.size());
+    try {
+        auto key = SigningKey(input.private_key(), TWPublicKeyTypeSECP256k1);
+        if (input.signing_mode() == Proto::Protobuf) {
+            auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+            auto body = protobufTxBody(input);
+            auto authInfo = protobufAuthInfo(input, publicKey);
+            auto signature = compactSignature(key, protobufSignDocHash(input, body, authInfo));
+            if (SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
+                output.set_serialized(protobufTxJSON(protobufTxRaw(body, authInfo, signature), input.mode()));
+            }
+            if (SigningOutputFields::requested(TWAnySignerOutputFieldSignature)) {
+                output.set_signature(signature.data(), signature.size());
+            }
+        } else {
+            auto signature = compactSignature(key, signaturePreimageHash(input));
+            if (SigningOutputFields::requested(TWAnySignerOutputFieldJSON)) {
+                output.set_json(transactionJSON(input, signature));
+            }
+            if (SigningOutputFields::requested(TWAnySignerOutputFieldSignature)) {
+                output.set_signature(signature.data(), signature.size());
+            }
+        }
+    } catch (const std::exception&) {
+        output = Proto::SigningOutput();
+        output.set_error(Common::Proto::Error_general);
+    }
     return output;
 }
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
-    auto input = Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    auto input = signingInputFromJSON(json);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return output.json();
@@ -14,7 +14,8 @@ namespace TW::Cosmos {
 /// Helper class that performs Cosmos transaction signing.
 class Signer {
   public:
-    /// Signs a Proto::SigningInput transaction
+    /// Signs a Proto::SigningInput transaction, in the encoding selected by its signing mode: the output has
+    /// either its JSON or its serialized broadcast request set, or an error.
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
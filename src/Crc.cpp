@@ -6,43 +6,232 @@
 
 #include "Crc.h"
 
-#include <boost/crc.hpp>  // for boost::crc_32_type
+#include <array>
+#include <cstring>
 
-#include <string>
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define TW_CRC_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define TW_CRC_ARM 1
+#include <arm_acle.h>
+#endif
 
 using namespace TW;
 
-uint16_t Crc::crc16(uint8_t* bytes, uint32_t length) {
-    // Calculate checksum for existing bytes
-    uint16_t crc = 0x0000;
-    const uint16_t polynomial = 0x1021;
-
-    for (auto i = 0; i < length; i++) {
-        const auto byte = bytes[i];
-        for (auto bitidx = 0; bitidx < 8; bitidx++) {
-            const auto bit = ((byte >> (7 - bitidx) & 1) == 1);
-            const auto c15 = ((crc >> 15 & 1) == 1);
-            crc <<= 1;
-            if (c15 ^ bit) {
-                crc ^= polynomial;
-            }
+namespace {
+
+/// Table of the CRC16-XModem (polynomial 0x1021, most significant bit first) of each byte.
+constexpr std::array<uint16_t, 256> makeCrc16Table() {
+    std::array<uint16_t, 256> table = {};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint16_t crc = static_cast<uint16_t>(i << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = static_cast<uint16_t>((crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr auto crc16Table = makeCrc16Table();
+
+using Crc32Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+/// Slicing-by-8 tables of a reflected CRC32: table k holds the CRC of a byte followed by k zero bytes.
+constexpr Crc32Tables makeCrc32Tables(uint32_t polynomial) {
+    Crc32Tables tables = {};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ polynomial : crc >> 1;
+        }
+        tables[0][i] = crc;
+    }
+    for (size_t k = 1; k < tables.size(); ++k) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xff];
+        }
+    }
+    return tables;
+}
+
+constexpr auto crc32Tables = makeCrc32Tables(0xedb88320);
+constexpr auto crc32CTables = makeCrc32Tables(0x82f63b78);
+
+/// Updates a CRC state, not inverted, 8 bytes at a time.
+uint32_t slicingBy8(const Crc32Tables& tables, uint32_t crc, const byte* data, size_t size) {
+    for (; size >= 8; data += 8, size -= 8) {
+        const uint32_t low = crc ^ (data[0] | (data[1] << 8) | (data[2] << 16) | (uint32_t(data[3]) << 24));
+        crc = tables[7][low & 0xff] ^ tables[6][(low >> 8) & 0xff] ^ tables[5][(low >> 16) & 0xff] ^ tables[4][low >> 24] ^
+              tables[3][data[4]] ^ tables[2][data[5]] ^ tables[1][data[6]] ^ tables[0][data[7]];
+    }
+    for (; size > 0; ++data, --size) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ *data) & 0xff];
+    }
+    return crc;
+}
+
+#if TW_CRC_X86
+
+struct Features {
+    bool pclmul = false;
+    bool sse42 = false;
+};
+
+const Features& features() {
+    static const Features supported = []() {
+        Features result;
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+            // PCLMULQDQ with SSE4.1 for the extraction, SSE4.2
+            result.pclmul = (ecx & (1u << 1)) != 0 && (ecx & (1u << 19)) != 0;
+            result.sse42 = (ecx & (1u << 20)) != 0;
         }
+        return result;
+    }();
+    return supported;
+}
+
+__attribute__((target("pclmul,sse4.1"))) inline __m128i load(const byte* data) {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/// Multiplies both halves of `x` by the constants of `k`, into the next block.
+__attribute__((target("pclmul,sse4.1"))) inline __m128i fold(__m128i x, __m128i k, __m128i next) {
+    const auto low = _mm_clmulepi64_si128(x, k, 0x00);
+    const auto high = _mm_clmulepi64_si128(x, k, 0x11);
+    return _mm_xor_si128(_mm_xor_si128(high, low), next);
+}
+
+/// Folds 64 bytes at a time with carry-less multiplication, then reduces to 32 bits (Intel, "Fast CRC Computation
+/// for Generic Polynomials Using PCLMULQDQ Instruction"); `size` is at least 64, a multiple of 16.
+__attribute__((target("pclmul,sse4.1"))) uint32_t crc32Fold(uint32_t crc, const byte* data, size_t size) {
+    alignas(16) static const uint64_t k1k2[] = {0x0154442bd4, 0x01c6e41596};
+    alignas(16) static const uint64_t k3k4[] = {0x01751997d0, 0x00ccaa009e};
+    alignas(16) static const uint64_t k5k0[] = {0x0163cd6124, 0x0000000000};
+    alignas(16) static const uint64_t poly[] = {0x01db710641, 0x01f7011641};
+    auto x1 = _mm_xor_si128(load(data), _mm_cvtsi32_si128(static_cast<int>(crc)));
+    auto x2 = load(data + 16);
+    auto x3 = load(data + 32);
+    auto x4 = load(data + 48);
+    data += 64;
+    size -= 64;
+
+    // 4 lanes in parallel
+    auto k = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+    for (; size >= 64; data += 64, size -= 64) {
+        x1 = fold(x1, k, load(data));
+        x2 = fold(x2, k, load(data + 16));
+        x3 = fold(x3, k, load(data + 32));
+        x4 = fold(x4, k, load(data + 48));
+    }
+
+    // into 128 bits, then the blocks of 16 left
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+    x1 = fold(x1, k, x2);
+    x1 = fold(x1, k, x3);
+    x1 = fold(x1, k, x4);
+    for (; size >= 16; data += 16, size -= 16) {
+        x1 = fold(x1, k, load(data));
+    }
+
+    // 128 bits into 64
+    const auto mask = _mm_setr_epi32(~0, 0, ~0, 0);
+    x2 = _mm_clmulepi64_si128(x1, k, 0x10);
+    x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+    k = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+    x2 = _mm_srli_si128(x1, 4);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x00), x2);
+
+    // Barrett reduction to 32 bits
+    k = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), k, 0x10);
+    x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), k, 0x00);
+    x1 = _mm_xor_si128(x1, x2);
+    return static_cast<uint32_t>(_mm_extract_epi32(x1, 1));
+}
+
+__attribute__((target("sse4.2"))) uint32_t crc32CInstruction(uint32_t crc, const byte* data, size_t size) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    for (; size > 0; ++data, --size) {
+        crc = _mm_crc32_u8(crc, *data);
+    }
+    return crc;
+}
+
+#elif TW_CRC_ARM
+
+uint32_t crc32Instruction(uint32_t crc, const byte* data, size_t size) {
+    for (; size >= 8; data += 8, size -= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc = __crc32d(crc, value);
+    }
+    for (; size > 0; ++data, --size) {
+        crc = __crc32b(crc, *data);
     }
+    return crc;
+}
 
-    return crc & 0xffff;
+uint32_t crc32CInstruction(uint32_t crc, const byte* data, size_t size) {
+    for (; size >= 8; data += 8, size -= 8) {
+        uint64_t value;
+        std::memcpy(&value, data, sizeof(value));
+        crc = __crc32cd(crc, value);
+    }
+    for (; size > 0; ++data, --size) {
+        crc = __crc32cb(crc, *data);
+    }
+    return crc;
 }
 
-uint32_t Crc::crc32(const Data& data)
-{
-    boost::crc_32_type result;
-    result.process_bytes((const void*)data.data(), data.size());
-    return (uint32_t)result.checksum();
+#endif
+
+} // namespace
+
+uint16_t Crc::crc16(const uint8_t* bytes, uint32_t length) {
+    uint16_t crc = 0x0000;
+    for (uint32_t i = 0; i < length; ++i) {
+        crc = static_cast<uint16_t>((crc << 8) ^ crc16Table[(crc >> 8) ^ bytes[i]]);
+    }
+    return crc;
+}
+
+uint32_t Crc::crc32(DataView data) {
+    const auto* bytes = data.data();
+    auto size = data.size();
+    uint32_t crc = 0xffffffff;
+#if TW_CRC_X86
+    if (size >= 64 && features().pclmul) {
+        const auto folded = size & ~size_t(15);
+        crc = crc32Fold(crc, bytes, folded);
+        bytes += folded;
+        size -= folded;
+    }
+#elif TW_CRC_ARM
+    return ~crc32Instruction(crc, bytes, size);
+#endif
+    return ~slicingBy8(crc32Tables, crc, bytes, size);
 }
 
-uint32_t Crc::crc32C(const Data& data)
-{
-    using crc_32c_type = boost::crc_optimal<32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true>;
-    crc_32c_type result;
-    result.process_bytes((const void*)data.data(), data.size());
-    return (uint32_t)result.checksum();
+uint32_t Crc::crc32C(DataView data) {
+    const uint32_t crc = 0xffffffff;
+#if TW_CRC_X86
+    if (features().sse42) {
+        return ~crc32CInstruction(crc, data.data(), data.size());
+    }
+#elif TW_CRC_ARM
+    return ~crc32CInstruction(crc, data.data(), data.size());
+#endif
+    return ~slicingBy8(crc32CTables, crc, data.data(), data.size());
 }
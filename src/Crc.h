@@ -12,11 +12,13 @@ namespace TW::Crc {
 
 /// CRC16 implementation compatible with the Stellar version
 /// Ported from this implementation: http://introcs.cs.princeton.edu/java/61data/CRC16CCITT.java.html
-/// Initial value changed to 0x0000 to match Stellar
-uint16_t crc16(uint8_t* bytes, uint32_t length);
+/// Initial value changed to 0x0000 to match Stellar (CRC-16/XMODEM), computed a byte at a time from a table
+uint16_t crc16(const uint8_t* bytes, uint32_t length);
 
-uint32_t crc32(const TW::Data& data);
+/// CRC32 (ISO-HDLC, as zlib); folded with carry-less multiplication where the CPU supports it, slicing-by-8 otherwise
+uint32_t crc32(TW::DataView data);
 
-uint32_t crc32C(const TW::Data& data);
+/// CRC32-C (Castagnoli); with the SSE4.2 or ARMv8 CRC32 instructions where available, slicing-by-8 otherwise
+uint32_t crc32C(TW::DataView data);
 
 } // namespace TW::Crc
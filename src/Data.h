@@ -10,12 +10,145 @@
 #include <vector>
 #include <string>
 #include <array>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
 
 namespace TW {
 
 using byte = std::uint8_t;
 using Data = std::vector<byte>;
 
+/// Byte array of at most `Capacity` bytes stored inline, for values of small bounded size such as keys:
+/// copies and construction do not allocate. Has the read and write interface of a Data of fixed capacity.
+/// There is no implicit conversion to Data, so that copies of key bytes to the heap, which are not wiped,
+/// are explicit: a DataView is taken where a view is enough, toData() otherwise.
+template <size_t Capacity>
+class FixedData {
+  public:
+    using value_type = byte;
+    using size_type = size_t;
+    using iterator = byte*;
+    using const_iterator = const byte*;
+
+    FixedData() noexcept = default;
+
+    /// @throws std::length_error if `data` is longer than `Capacity`.
+    FixedData(const Data& data) { assign(data.begin(), data.end()); }
+
+    /// @throws std::length_error if `size` is larger than `Capacity`.
+    FixedData(const byte* data, size_t size) { assign(data, data + size); }
+
+    /// Replaces the contents with a range of bytes.
+    ///
+    /// @throws std::length_error if the range is longer than `Capacity`.
+    template <typename Iter>
+    void assign(Iter first, Iter last) {
+        const auto count = static_cast<size_t>(std::distance(first, last));
+        if (count > Capacity) {
+            throw std::length_error("FixedData capacity exceeded");
+        }
+        std::copy(first, last, bytes.begin());
+        length = count;
+    }
+
+    /// Resizes, new bytes being zero.
+    ///
+    /// @throws std::length_error if `size` is larger than `Capacity`.
+    void resize(size_t size) {
+        if (size > Capacity) {
+            throw std::length_error("FixedData capacity exceeded");
+        }
+        if (size > length) {
+            std::fill(bytes.begin() + length, bytes.begin() + size, 0);
+        }
+        length = size;
+    }
+
+    void clear() noexcept { length = 0; }
+
+    static constexpr size_t capacity() noexcept { return Capacity; }
+    size_t size() const noexcept { return length; }
+    bool empty() const noexcept { return length == 0; }
+
+    byte* data() noexcept { return bytes.data(); }
+    const byte* data() const noexcept { return bytes.data(); }
+    byte* begin() noexcept { return bytes.data(); }
+    const byte* begin() const noexcept { return bytes.data(); }
+    byte* end() noexcept { return bytes.data() + length; }
+    const byte* end() const noexcept { return bytes.data() + length; }
+    byte& operator[](size_t index) noexcept { return bytes[index]; }
+    const byte& operator[](size_t index) const noexcept { return bytes[index]; }
+
+    /// Returns a copy as Data.
+    Data toData() const { return Data(begin(), end()); }
+
+  private:
+    std::array<byte, Capacity> bytes{};
+    size_t length = 0;
+};
+
+template <size_t N, size_t M>
+inline bool operator==(const FixedData<N>& lhs, const FixedData<M>& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+template <size_t N>
+inline bool operator==(const FixedData<N>& lhs, const Data& rhs) {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+template <size_t N>
+inline bool operator==(const Data& lhs, const FixedData<N>& rhs) {
+    return rhs == lhs;
+}
+template <size_t N, size_t M>
+inline bool operator!=(const FixedData<N>& lhs, const FixedData<M>& rhs) {
+    return !(lhs == rhs);
+}
+template <size_t N>
+inline bool operator!=(const FixedData<N>& lhs, const Data& rhs) {
+    return !(lhs == rhs);
+}
+template <size_t N>
+inline bool operator!=(const Data& lhs, const FixedData<N>& rhs) {
+    return !(rhs == lhs);
+}
+
+/// Non-owning view of a contiguous range of bytes, such as a Data, a std::array or a part of either.
+///
+/// A view does not extend the lifetime of the bytes it refers to.
+class DataView {
+  public:
+    constexpr DataView() noexcept = default;
+    constexpr DataView(const byte* data, size_t size) noexcept : pointer(data), length(size) {}
+    DataView(const Data& data) noexcept : pointer(data.data()), length(data.size()) {}
+    template <size_t N>
+    constexpr DataView(const std::array<byte, N>& data) noexcept : pointer(data.data()), length(N) {}
+    template <size_t N>
+    DataView(const FixedData<N>& data) noexcept : pointer(data.data()), length(data.size()) {}
+
+    constexpr const byte* data() const noexcept { return pointer; }
+    constexpr size_t size() const noexcept { return length; }
+    constexpr bool empty() const noexcept { return length == 0; }
+    constexpr const byte* begin() const noexcept { return pointer; }
+    constexpr const byte* end() const noexcept { return pointer + length; }
+    constexpr const byte& operator[](size_t index) const noexcept { return pointer[index]; }
+
+    /// Returns a view of the requested part, truncated to the end of this view.
+    constexpr DataView subView(size_t index, size_t count) const noexcept {
+        if (index > length) {
+            index = length;
+        }
+        return DataView(pointer + index, count < length - index ? count : length - index);
+    }
+
+    /// Returns an owning copy of the bytes.
+    Data toData() const { return Data(begin(), end()); }
+
+  private:
+    const byte* pointer = nullptr;
+    size_t length = 0;
+};
+
 inline void pad_left(Data& data, const uint32_t size) {
     data.insert(data.begin(), size - data.size(), 0);
 }
@@ -32,6 +165,15 @@ inline void append(Data& data, const Data& suffix) {
     data.insert(data.end(), suffix.begin(), suffix.end());
 }
 
+inline void append(Data& data, DataView suffix) {
+    data.insert(data.end(), suffix.begin(), suffix.end());
+}
+
+template <size_t N>
+inline void append(Data& data, const FixedData<N>& suffix) {
+    data.insert(data.end(), suffix.begin(), suffix.end());
+}
+
 inline void append(Data& data, const byte suffix) {
     data.push_back(suffix);
 }
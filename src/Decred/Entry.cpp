@@ -20,10 +20,14 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Bitcoin::Proto::SigningInput>(dataIn, dataOut);
 }
 
-void Entry::plan(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Bitcoin::Proto::SigningInput>(input, output);
+}
+
+void Entry::plan(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     planTemplate<Signer, Bitcoin::Proto::SigningInput>(dataIn, dataOut);
 }
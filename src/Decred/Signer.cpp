@@ -14,9 +14,12 @@
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
+#include "../ThreadPool.h"
 
 #include "Bitcoin/OpCodes.h"
 
+#include <algorithm>
+
 using namespace TW;
 using namespace TW::Decred;
 
@@ -54,23 +57,34 @@ Result<Transaction, Common::Proto::SigningError> Signer::sign() {
     signedInputs.clear();
     std::copy(std::begin(transaction.inputs), std::end(transaction.inputs),
               std::back_inserter(signedInputs));
+    transaction.cacheSignatureHashes();
 
+    // The inputs are signed independently, on several threads
     const auto hashSingle = Bitcoin::hashTypeIsSingle(static_cast<enum TWBitcoinSigHashType>(input.hash_type()));
-    for (auto i = 0; i < txPlan.utxos.size(); i += 1) {
-        auto& utxo = txPlan.utxos[i];
-
+    const auto count = std::min(txPlan.utxos.size(), transaction.inputs.size());
+    std::vector<Common::Proto::SigningError> errors(count, Common::Proto::OK);
+    ThreadPool::shared().parallelFor(count, 0, [&](size_t i) {
         // Only sign TWBitcoinSigHashTypeSingle if there's a corresponding output
         if (hashSingle && i >= transaction.outputs.size()) {
-            continue;
+            return;
         }
-        auto script = Bitcoin::Script(utxo.script().begin(), utxo.script().end());
-        auto result = sign(script, i);
+        const auto& utxo = txPlan.utxos[i];
+        auto result = sign(Bitcoin::Script(utxo.script().begin(), utxo.script().end()), i);
         if (!result) {
-            return Result<Transaction, Common::Proto::SigningError>::failure(result.error());
+            errors[i] = result.error();
+            return;
         }
         signedInputs[i].script = result.payload();
+    });
+    for (auto error : errors) {
+        if (error != Common::Proto::OK) {
+            // the error of the first input which failed, as when signing in order
+            transaction.clearSignatureHashCache();
+            return Result<Transaction, Common::Proto::SigningError>::failure(error);
+        }
     }
 
+    transaction.clearSignatureHashCache();
     Transaction tx(transaction);
     tx.inputs = move(signedInputs);
     tx.outputs = transaction.outputs;
@@ -107,9 +121,8 @@ Result<Bitcoin::Script, Common::Proto::SigningError> Signer::sign(Bitcoin::Scrip
 }
 
 Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin::Script script, size_t index) {
-    Transaction transactionToSign(transaction);
-    transactionToSign.inputs = signedInputs;
-    transactionToSign.outputs = transaction.outputs;
+    // The signature hash only covers the script of the input being signed, sign the unsigned transaction
+    const auto& transactionToSign = transaction;
 
     Data data;
     std::vector<Data> keys;
@@ -141,7 +154,7 @@ Result<std::vector<Data>, Common::Proto::SigningError> Signer::signStep(Bitcoin:
             // Error: Failed to sign
             return Result<std::vector<Data>, Common::Proto::SigningError>::failure(Common::Proto::Error_signing);
         }
-        return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, pubkey.bytes});
+        return Result<std::vector<Data>, Common::Proto::SigningError>::success({signature, pubkey.bytes.toData()});
     } else if (script.matchPayToScriptHash(data)) {
         auto redeemScript = scriptForScriptHash(data);
         if (redeemScript.empty()) {
@@ -24,8 +24,32 @@ static const uint32_t sigHashSerializePrefix = 1;
 // Indicates the serialization only contains witness data.
 static const uint32_t sigHashSerializeWitness = 3;
 
-std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
-                               const Bitcoin::Script& signScript);
+/// Returns true if the hash type commits to all inputs and outputs.
+bool hashTypeIsAll(enum TWBitcoinSigHashType hashType) {
+    return (hashType & TWBitcoinSigHashTypeAnyoneCanPay) == 0 &&
+           !Bitcoin::hashTypeIsNone(hashType) && !Bitcoin::hashTypeIsSingle(hashType);
+}
+
+/// Starts the witness hash, with the version, serialization type and input count.
+Hash::Blake256Hasher witnessHasher(uint16_t version, std::size_t inputCount) {
+    Data header;
+    encode32LE(static_cast<uint32_t>(version) |
+                   (static_cast<uint32_t>(sigHashSerializeWitness) << 16),
+               header);
+    encodeVarInt(inputCount, header);
+    auto hasher = Hash::Blake256Hasher();
+    hasher.update(header);
+    return hasher;
+}
+
+/// Hashes the empty scripts of `count` inputs, each encoded as a single 0x00.
+void updateEmptyScripts(Hash::Blake256Hasher& hasher, std::size_t count) {
+    static const std::array<byte, 64> zeros = {0};
+    for (; count > zeros.size(); count -= zeros.size()) {
+        hasher.update(zeros);
+    }
+    hasher.update(DataView(zeros).subView(0, count));
+}
 } // namespace
 
 Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, size_t index,
@@ -37,46 +61,46 @@ Data Transaction::computeSignatureHash(const Bitcoin::Script& prevOutScript, siz
                                     "larger than the number of outputs");
     }
 
-    auto inputsToSign = inputs;
-    auto signIndex = index;
-    if ((hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0) {
-        inputsToSign = {inputs[index]};
-        signIndex = 0;
-    }
+    auto preimage = Data();
+    preimage.reserve(Hash::sha256Size * 2 + 4);
+    encode32LE(hashType, preimage);
 
-    auto outputsToSign = outputs;
+    const auto prefixHash = signatureHashCache && hashTypeIsAll(hashType)
+        ? signatureHashCache->prefixHash
+        : computePrefixHash(index, hashType);
+    append(preimage, prefixHash);
+
+    const auto anyoneCanPay = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0;
+    const auto witnessHash = anyoneCanPay
+        ? computeWitnessHash(1, prevOutScript, 0)
+        : computeWitnessHash(inputs.size(), prevOutScript, index);
+    append(preimage, witnessHash);
+
+    return Hash::blake256(preimage);
+}
+
+Data Transaction::computePrefixHash(std::size_t index, enum TWBitcoinSigHashType hashType) const {
+    // With AnyoneCanPay, only the input being signed is committed to
+    const auto anyoneCanPay = (hashType & TWBitcoinSigHashTypeAnyoneCanPay) != 0;
+    const auto firstInput = anyoneCanPay ? index : 0;
+    const auto inputCount = anyoneCanPay ? 1 : inputs.size();
+
+    auto outputCount = outputs.size();
     switch (hashType & Bitcoin::SigHashMask) {
     case TWBitcoinSigHashTypeNone:
-        outputsToSign = {};
+        outputCount = 0;
         break;
     case TWBitcoinSigHashTypeSingle:
-        outputsToSign.clear();
-        std::copy(outputs.begin(), outputs.begin() + index + 1, outputsToSign.end());
+        // Outputs up to the one being signed
+        outputCount = index + 1;
         break;
     default:
         // Keep all outputs
         break;
     }
 
-    auto preimage = Data();
-    preimage.reserve(Hash::sha256Size * 2 + 4);
-    encode32LE(hashType, preimage);
-
-    const auto prefixHash =
-        computePrefixHash(inputsToSign, outputsToSign, signIndex, index, hashType);
-    std::copy(prefixHash.begin(), prefixHash.end(), std::back_inserter(preimage));
-
-    const auto witnessHash = computeWitnessHash(inputsToSign, prevOutScript, signIndex);
-    std::copy(witnessHash.begin(), witnessHash.end(), std::back_inserter(preimage));
-
-    return Hash::blake256(preimage);
-}
-
-Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
-                                    const std::vector<TransactionOutput>& outputsToSign,
-                                    std::size_t signIndex, std::size_t index,
-                                    enum TWBitcoinSigHashType hashType) const {
     auto preimage = Data{};
+    preimage.reserve(4 + 9 + inputCount * 41 + 9 + outputCount * 45 + 8);
 
     // Commit to the version and hash serialization type.
     encode32LE(static_cast<uint32_t>(version) |
@@ -84,32 +108,33 @@ Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsT
                preimage);
 
     // Commit to the relevant transaction inputs.
-    encodeVarInt(inputsToSign.size(), preimage);
-    for (auto i = 0; i < inputsToSign.size(); i += 1) {
-        auto& input = inputsToSign[i];
+    encodeVarInt(inputCount, preimage);
+    for (auto i = firstInput; i < firstInput + inputCount; i += 1) {
+        auto& input = inputs[i];
         input.previousOutput.encode(preimage);
 
         auto sequence = input.sequence;
         if ((Bitcoin::hashTypeIsNone(hashType) || Bitcoin::hashTypeIsSingle(hashType)) &&
-            i != signIndex) {
+            i != index) {
             sequence = 0;
         }
         encode32LE(sequence, preimage);
     }
 
     // Commit to the relevant transaction outputs.
-    encodeVarInt(outputsToSign.size(), preimage);
-    for (auto i = 0; i < outputsToSign.size(); i += 1) {
-        auto& output = outputsToSign[i];
-        auto value = output.value;
-        auto pkScript = output.script;
-        if (Bitcoin::hashTypeIsSingle(hashType) && i != index) {
-            value = -1;
-            pkScript = {};
-        }
+    encodeVarInt(outputCount, preimage);
+    for (auto i = 0; i < outputCount; i += 1) {
+        auto& output = outputs[i];
+        // Outputs before the one being signed are blanked
+        const auto blank = Bitcoin::hashTypeIsSingle(hashType) && i != index;
+        auto value = blank ? -1 : output.value;
         encode64LE(value, preimage);
         encode16LE(output.version, preimage);
-        pkScript.encode(preimage);
+        if (blank) {
+            Bitcoin::Script().encode(preimage);
+        } else {
+            output.script.encode(preimage);
+        }
     }
 
     encode32LE(lockTime, preimage);
@@ -118,29 +143,47 @@ Data Transaction::computePrefixHash(const std::vector<TransactionInput>& inputsT
     return Hash::blake256(preimage);
 }
 
-Data Transaction::computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
-                                     const Bitcoin::Script& signScript,
-                                     std::size_t signIndex) const {
-    const auto size = sigHashWitnessSize(inputsToSign, signScript);
-    auto witnessBuf = Data();
-    witnessBuf.reserve(size);
+Hash::Digest<Hash::sha256Size> Transaction::computeWitnessHash(std::size_t inputCount,
+                                                               const Bitcoin::Script& signScript,
+                                                               std::size_t signIndex) const {
+    // Commit to the version, hash serialization type and to the relevant transaction inputs:
+    // empty scripts, except for the input being signed.
+    // The hasher resumes from the closest cached midstate before the signed input.
+    auto hasher = Hash::Blake256Hasher();
+    std::size_t position = 0;
+    if (signatureHashCache && inputCount == inputs.size()) {
+        const auto& midstates = signatureHashCache->witnessMidstates;
+        const auto checkpoint = std::min(signIndex / SignatureHashCache::witnessCheckpointInterval, midstates.size() - 1);
+        hasher = midstates[checkpoint];
+        position = checkpoint * SignatureHashCache::witnessCheckpointInterval;
+    } else {
+        hasher = witnessHasher(version, inputCount);
+    }
+    updateEmptyScripts(hasher, signIndex - position);
 
-    // Commit to the version and hash serialization type.
-    encode32LE(static_cast<uint32_t>(version) |
-                   (static_cast<uint32_t>(sigHashSerializeWitness) << 16),
-               witnessBuf);
+    auto script = Data();
+    script.reserve(9 + signScript.bytes.size());
+    signScript.encode(script);
+    hasher.update(script);
 
-    // Commit to the relevant transaction inputs.
-    encodeVarInt(inputsToSign.size(), witnessBuf);
-    for (auto i = 0; i < inputsToSign.size(); i += 1) {
-        if (i == signIndex) {
-            signScript.encode(witnessBuf);
-        } else {
-            Bitcoin::Script().encode(witnessBuf);
-        }
-    }
+    updateEmptyScripts(hasher, inputCount - signIndex - 1);
+    return hasher.final();
+}
+
+void Transaction::cacheSignatureHashes() {
+    signatureHashCache.reset();
+    auto cache = SignatureHashCache();
+    cache.prefixHash = computePrefixHash(0, TWBitcoinSigHashTypeAll);
 
-    return Hash::blake256(witnessBuf);
+    auto hasher = witnessHasher(version, inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); i += SignatureHashCache::witnessCheckpointInterval) {
+        cache.witnessMidstates.push_back(hasher);
+        updateEmptyScripts(hasher, std::min(SignatureHashCache::witnessCheckpointInterval, inputs.size() - i));
+    }
+    if (cache.witnessMidstates.empty()) {
+        cache.witnessMidstates.push_back(hasher);
+    }
+    signatureHashCache = std::move(cache);
 }
 
 Data Transaction::hash() const {
@@ -213,28 +256,3 @@ Proto::Transaction Transaction::proto() const {
 
     return protoTx;
 }
-
-namespace {
-/// Returns the number of bytes the passed parameters would take when encoded
-/// with the format used by the witness hash portion of the overall signature
-/// hash.
-std::size_t sigHashWitnessSize(const std::vector<TransactionInput>& inputs,
-                               const Bitcoin::Script& signScript) {
-    // 1) 4 bytes version/serialization type
-    // 2) number of inputs varint
-    // 3) per input:
-    //    a) prevout pkscript varint (1 byte if not input being signed)
-    //    b) N bytes prevout pkscript (0 bytes if not input being signed)
-    //
-    // NOTE: The prevout pkscript is replaced by nil for all inputs except
-    // the input being signed.  Thus, all other inputs (aka numTxIns-1) commit
-    // to a nil script which gets encoded as a single 0x00 byte.  This is
-    // because encoding 0 as a varint results in 0x00 and there is no script
-    // to write.  So, rather than looping through all inputs and manually
-    // calculating the size per input, use (numTxIns - 1) as an
-    // optimization.
-    const auto numTxIns = inputs.size();
-    return 4 + varIntSize(numTxIns) + (numTxIns - 1) + varIntSize(signScript.bytes.size()) +
-           signScript.bytes.size();
-}
-} // namespace
@@ -11,15 +11,29 @@
 #include "TransactionOutput.h"
 #include "Bitcoin/Script.h"
 #include "../Data.h"
+#include "../Hashers.h"
 #include "../proto/Decred.pb.h"
 
 #include "Bitcoin/SignatureVersion.h"
+#include <optional>
 #include <vector>
 
 namespace TW::Decred {
 
 enum class SerializeType : uint16_t { full, noWitness, onlyWitness };
 
+/// Parts of the signature hash that are the same for all inputs.
+struct SignatureHashCache {
+    /// Prefix hash of the hash types committing to all inputs and outputs.
+    Data prefixHash;
+
+    /// Witness hash midstates: the i-th one has hashed the serialization header and the empty
+    /// scripts of the first `i * witnessCheckpointInterval` inputs.
+    std::vector<Hash::Blake256Hasher> witnessMidstates;
+
+    static constexpr size_t witnessCheckpointInterval = 64;
+};
+
 struct Transaction {
     /// Serialization format
     SerializeType serializeType = SerializeType::full;
@@ -52,6 +66,11 @@ struct Transaction {
     Data computeSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                               enum TWBitcoinSigHashType hashType) const;
 
+    /// Computes the signature hash parts shared by all inputs once, to be reused when signing each input.
+    /// The cache has to be cleared when the inputs' outpoints or sequences, or the outputs, are changed.
+    void cacheSignatureHashes();
+    void clearSignatureHashCache() { signatureHashCache.reset(); }
+
     /// Generates the transaction hash.
     Data hash() const;
 
@@ -62,11 +81,12 @@ struct Transaction {
     Proto::Transaction proto() const;
 
   private:
-    Data computePrefixHash(const std::vector<TransactionInput>& inputsToSign,
-                           const std::vector<TransactionOutput>& outputsToSign,
-                           std::size_t signIndex, std::size_t index, enum TWBitcoinSigHashType hashType) const;
-    Data computeWitnessHash(const std::vector<TransactionInput>& inputsToSign,
-                            const Bitcoin::Script& signScript, std::size_t signIndex) const;
+    /// Precomputed hashes, see cacheSignatureHashes().
+    std::optional<SignatureHashCache> signatureHashCache;
+
+    Data computePrefixHash(std::size_t index, enum TWBitcoinSigHashType hashType) const;
+    Hash::Digest<Hash::sha256Size> computeWitnessHash(std::size_t inputCount, const Bitcoin::Script& signScript,
+                                                      std::size_t signIndex) const;
 
     void encodePrefix(Data& data) const;
     void encodeWitness(Data& data) const;
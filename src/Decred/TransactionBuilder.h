@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Transaction.h"
+#include "../Bitcoin/ScriptCache.h"
 #include "../Bitcoin/TransactionPlan.h"
 #include "../Bitcoin/TransactionBuilder.h"
 #include "../proto/Bitcoin.pb.h"
@@ -28,7 +29,8 @@ struct TransactionBuilder {
     static Transaction build(const Bitcoin::TransactionPlan& plan, const std::string& toAddress,
                              const std::string& changeAddress) {
         auto coin = TWCoinTypeDecred;                                 
-        auto lockingScriptTo = Bitcoin::Script::lockScriptForAddress(toAddress, coin);
+        auto& scriptCache = Bitcoin::ScriptCache::shared();
+        auto lockingScriptTo = scriptCache.lockScript(toAddress, coin);
         if (lockingScriptTo.empty()) {
             return {};
         }
@@ -37,7 +39,7 @@ struct TransactionBuilder {
         tx.outputs.emplace_back(TransactionOutput(plan.amount, /* version: */ 0, lockingScriptTo));
 
         if (plan.change > 0) {
-            auto lockingScriptChange = Bitcoin::Script::lockScriptForAddress(changeAddress, coin);
+            auto lockingScriptChange = scriptCache.lockScript(changeAddress, coin);
             tx.outputs.emplace_back(
                 TransactionOutput(plan.change, /* version: */ 0, lockingScriptChange));
         }
@@ -9,8 +9,12 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWPurpose.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -20,11 +24,11 @@ struct DerivationPathIndex {
     uint32_t value = 0;
     bool hardened = true;
 
-    DerivationPathIndex() = default;
-    DerivationPathIndex(uint32_t value, bool hardened = true) : value(value), hardened(hardened) {}
+    constexpr DerivationPathIndex() = default;
+    constexpr DerivationPathIndex(uint32_t value, bool hardened = true) : value(value), hardened(hardened) {}
 
     /// The derivation index.
-    uint32_t derivationIndex() const {
+    constexpr uint32_t derivationIndex() const {
         if (hardened) {
             return value | 0x80000000;
         } else {
@@ -41,68 +45,155 @@ struct DerivationPathIndex {
     }
 };
 
+/// Indices of a derivation path, stored inline: copying or extending a path does not allocate.
+///
+/// Holds up to `capacity` indices, more than the paths in use; adding more throws std::length_error.
+class DerivationPathIndices {
+  public:
+    static constexpr std::size_t capacity = 8;
+
+    constexpr DerivationPathIndices() = default;
+    constexpr DerivationPathIndices(std::initializer_list<DerivationPathIndex> l) {
+        for (const auto& index : l) {
+            push_back(index);
+        }
+    }
+    explicit DerivationPathIndices(const std::vector<DerivationPathIndex>& v) {
+        for (const auto& index : v) {
+            push_back(index);
+        }
+    }
+    /// `count` hardened 0 indices
+    constexpr explicit DerivationPathIndices(std::size_t count) { resize(count); }
+
+    constexpr std::size_t size() const { return count; }
+    constexpr bool empty() const { return count == 0; }
+
+    constexpr DerivationPathIndex& operator[](std::size_t i) { return items[i]; }
+    constexpr const DerivationPathIndex& operator[](std::size_t i) const { return items[i]; }
+    constexpr DerivationPathIndex& back() { return items[count - 1]; }
+    constexpr const DerivationPathIndex& back() const { return items[count - 1]; }
+
+    constexpr DerivationPathIndex* begin() { return items.data(); }
+    constexpr DerivationPathIndex* end() { return items.data() + count; }
+    constexpr const DerivationPathIndex* begin() const { return items.data(); }
+    constexpr const DerivationPathIndex* end() const { return items.data() + count; }
+
+    constexpr void push_back(const DerivationPathIndex& index) {
+        if (count == capacity) {
+            throw std::length_error("Derivation path too long");
+        }
+        items[count++] = index;
+    }
+    constexpr void emplace_back(uint32_t value, bool hardened = true) { push_back(DerivationPathIndex(value, hardened)); }
+    constexpr void pop_back() { --count; }
+    constexpr void clear() { count = 0; }
+
+    constexpr void resize(std::size_t size) {
+        if (size > capacity) {
+            throw std::length_error("Derivation path too long");
+        }
+        for (auto i = count; i < size; ++i) {
+            items[i] = DerivationPathIndex();
+        }
+        count = size;
+    }
+
+  private:
+    std::array<DerivationPathIndex, capacity> items{};
+    std::size_t count = 0;
+};
+
 /// A BIP32 HD wallet derivation path.
 struct DerivationPath {
-    std::vector<DerivationPathIndex> indices;
+    DerivationPathIndices indices;
 
-    TWPurpose purpose() const {
+    constexpr TWPurpose purpose() const {
         if (indices.size() == 0) { return TWPurposeBIP44; }
         return static_cast<TWPurpose>(indices[0].value);
     }
 
-    void setPurpose(TWPurpose v) {
+    constexpr void setPurpose(TWPurpose v) {
         if (indices.size() == 0) { return; }
         indices[0] = DerivationPathIndex(v, /* hardened: */ true);
     }
 
-    uint32_t coin() const {
+    constexpr uint32_t coin() const {
         if (indices.size() <= 1) { return TWCoinTypeBitcoin; }
         return indices[1].value;
     }
 
-    void setCoin(uint32_t v) {
+    constexpr void setCoin(uint32_t v) {
         if (indices.size() <= 1) { return; }
         indices[1] = DerivationPathIndex(v, /* hardened: */ true);
     }
 
-    uint32_t account() const {
+    constexpr uint32_t account() const {
         if (indices.size() <= 2) { return 0; }
         return indices[2].value;
     }
 
-    void setAccount(uint32_t v) {
+    constexpr void setAccount(uint32_t v) {
         if (indices.size() <= 2) { return; }
         indices[2] = DerivationPathIndex(v, /* hardened: */ true);
     }
 
-    uint32_t change() const {
+    constexpr uint32_t change() const {
         if (indices.size() <= 3) { return 0; }
         return indices[3].value;
     }
 
-    void setChange(uint32_t v) {
+    constexpr void setChange(uint32_t v) {
         if (indices.size() <= 3) { return; }
         indices[3] = DerivationPathIndex(v, /* hardened: */ false);
     }
 
-    uint32_t address() const {
+    constexpr uint32_t address() const {
         if (indices.size() <= 4) { return 0; }
         return indices[4].value;
     }
 
-    void setAddress(uint32_t v) {
+    constexpr void setAddress(uint32_t v) {
         if (indices.size() <= 4) { return; }
         indices[4] = DerivationPathIndex(v, /* hardened: */ false);
     }
 
-    DerivationPath() = default;
-    explicit DerivationPath(std::initializer_list<DerivationPathIndex> l) : indices(l) {}
-    explicit DerivationPath(std::vector<DerivationPathIndex> indices) : indices(std::move(indices)) {}
+    /// Copy of a BIP44 path with another address index, or of a change level path extended with the address index.
+    constexpr DerivationPath withAddressIndex(uint32_t v) const {
+        auto path = *this;
+        if (path.indices.size() == 4) {
+            path.indices.emplace_back(v, /* hardened: */ false);
+        } else {
+            path.setAddress(v);
+        }
+        return path;
+    }
+
+    /// Path of the first `length` indices.
+    constexpr DerivationPath prefix(std::size_t length) const {
+        auto path = *this;
+        path.indices.resize(std::min(length, indices.size()));
+        return path;
+    }
+
+    /// Number of leading indices shared with `other`, the depth of their closest common ancestor.
+    constexpr std::size_t commonPrefixLength(const DerivationPath& other) const {
+        std::size_t length = 0;
+        while (length < indices.size() && length < other.indices.size() &&
+               indices[length].derivationIndex() == other.indices[length].derivationIndex()) {
+            ++length;
+        }
+        return length;
+    }
+
+    constexpr DerivationPath() = default;
+    constexpr explicit DerivationPath(std::initializer_list<DerivationPathIndex> l) : indices(l) {}
+    explicit DerivationPath(const std::vector<DerivationPathIndex>& indices) : indices(indices) {}
 
     /// Creates a `DerivationPath` by BIP44 components.
-    DerivationPath(TWPurpose purpose, uint32_t coin, uint32_t account, uint32_t change,
-                   uint32_t address) 
-    : indices(std::vector<DerivationPathIndex>(5)) {
+    constexpr DerivationPath(TWPurpose purpose, uint32_t coin, uint32_t account, uint32_t change,
+                             uint32_t address)
+    : indices(5) {
         setPurpose(purpose);
         setCoin(coin);
         setAccount(account);
@@ -110,11 +201,17 @@ struct DerivationPath {
         setAddress(address);
     }
 
+    /// Parses a string description like `m/10/0/2'/3`, usable in constant expressions.
+    ///
+    /// @throws std::invalid_argument if the string is not a valid derivation
+    /// path, std::length_error if it has too many indices.
+    static constexpr DerivationPath parse(const char* string, std::size_t size);
+
     /// Creates a derivation path with a string description like `m/10/0/2'/3`
     ///
     /// @throws std::invalid_argument if the string is not a valid derivation
     /// path.
-    explicit DerivationPath(const std::string& string);
+    explicit DerivationPath(const std::string& string) : DerivationPath(parse(string.data(), string.size())) {}
 
     /// String representation.
     std::string string() const noexcept;
@@ -129,4 +226,51 @@ inline bool operator==(const DerivationPath& lhs, const DerivationPath& rhs) {
                       rhs.indices.end());
 }
 
+constexpr DerivationPath DerivationPath::parse(const char* string, std::size_t size) {
+    auto it = string;
+    const auto end = string + size;
+
+    if (it != end && *it == 'm') {
+        ++it;
+    }
+    if (it != end && *it == '/') {
+        ++it;
+    }
+
+    DerivationPath path;
+    while (it != end) {
+        if (*it < '0' || *it > '9') {
+            throw std::invalid_argument("Invalid component");
+        }
+        uint64_t value = 0;
+        while (it != end && *it >= '0' && *it <= '9') {
+            value = value * 10 + static_cast<uint64_t>(*it - '0');
+            if (value > UINT32_MAX) {
+                throw std::invalid_argument("Invalid component");
+            }
+            ++it;
+        }
+
+        const auto hardened = (it != end && *it == '\'');
+        if (hardened) {
+            ++it;
+        }
+        path.indices.emplace_back(static_cast<uint32_t>(value), hardened);
+
+        if (it == end) {
+            break;
+        }
+        if (*it != '/') {
+            throw std::invalid_argument("Components should be separated by '/'");
+        }
+        ++it;
+    }
+    return path;
+}
+
+/// Derivation path literals, parsed at compile time: `"m/44'/60'/0'/0/0"_dp`.
+constexpr DerivationPath operator""_dp(const char* string, std::size_t size) {
+    return DerivationPath::parse(string, size);
+}
+
 } // namespace TW
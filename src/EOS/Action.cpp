@@ -47,8 +47,10 @@ TransferAction::TransferAction( const std::string& currency,
                                 const Asset& asset, 
                                 const std::string& memo) {
     account = Name(currency);
-    name = Name("transfer");
-    authorization.push_back(PermissionLevel(Name(from), Name("active")));
+    static constexpr Name transfer(Name::encode("transfer"));
+    static constexpr Name active(Name::encode("active"));
+    name = transfer;
+    authorization.push_back(PermissionLevel(Name(from), active));
 
     setData(from, to, asset, memo);
 }
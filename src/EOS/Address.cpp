@@ -122,7 +122,7 @@ Address::Address(const PublicKey& publicKey, Type type) : type(type) {
     assert(PublicKeyDataSize == TW::PublicKey::secp256k1Size);
 
     // copy the raw, compressed key data
-    keyData = publicKey.compressed().bytes;
+    keyData = publicKey.compressed().bytes.toData();
 
     // append the checksum
     uint32_t checksum = createChecksum(keyData, type);
@@ -18,24 +18,7 @@ Name::Name(const std::string& str) {
         throw std::invalid_argument(str + ": size too long!");
     }
 
-    int i = 0;
-    while (i < std::min(size_t(12), str.size())) {
-        value |= (toSymbol(str[i]) & 0x1f) << (64 - (5 * (i + 1)));
-        i++;
-    }
-
-    if (i == 12)
-        value |= (toSymbol(str[i]) & 0x0f);
-}
-
-uint64_t Name::toSymbol(char c) const noexcept {
-    if (c >= 'a' && c <= 'z')
-        return c - 'a' + 6;
-
-    if (c >= '1' && c <= '5')
-        return c - '1' + 1;
-
-    return 0;
+    value = encode(str.data(), str.size());
 }
 
 std::string Name::string() const noexcept {
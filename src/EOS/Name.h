@@ -15,8 +15,35 @@ public:
     uint64_t value = 0;
 
     Name() { }
+    constexpr explicit Name(uint64_t value) : value(value) { }
     Name(const std::string& str);
-    uint64_t toSymbol(char c) const noexcept;
+    static constexpr uint64_t toSymbol(char c) noexcept {
+        if (c >= 'a' && c <= 'z')
+            return c - 'a' + 6;
+
+        if (c >= '1' && c <= '5')
+            return c - '1' + 1;
+
+        return 0;
+    }
+    /// Encodes a name of at most 13 characters, allows compile-time constants such as Name(Name::encode("active")).
+    static constexpr uint64_t encode(const char* str, size_t size) noexcept {
+        uint64_t value = 0;
+        size_t i = 0;
+        while (i < (size < 12 ? size : 12)) {
+            value |= (toSymbol(str[i]) & 0x1f) << (64 - (5 * (i + 1)));
+            i++;
+        }
+
+        if (i == 12 && size > 12)
+            value |= (toSymbol(str[i]) & 0x0f);
+        return value;
+    }
+    template <size_t N>
+    static constexpr uint64_t encode(const char (&str)[N]) noexcept {
+        static_assert(N <= 14, "name too long");
+        return encode(str, N - 1);
+    }
     std::string string() const noexcept;
 
     void serialize(TW::Data& o) const noexcept;
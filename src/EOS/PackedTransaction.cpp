@@ -14,6 +14,15 @@ using json = nlohmann::json;
 
 PackedTransaction::PackedTransaction(const Transaction& transaction, CompressionType type) noexcept : compression(type) {
     transaction.serialize(packedTrx);
+    copyFromTransaction(transaction);
+}
+
+PackedTransaction::PackedTransaction(const Transaction& transaction, Data packedTrx, CompressionType type) noexcept
+    : compression(type), packedTrx(std::move(packedTrx)) {
+    copyFromTransaction(transaction);
+}
+
+void PackedTransaction::copyFromTransaction(const Transaction& transaction) noexcept {
     const Data& cfd = transaction.contextFreeData;
 
     if (cfd.size()) {
@@ -26,9 +26,14 @@ public:
     Data packedTrx;
 
     PackedTransaction(const Transaction& transaction, CompressionType type = CompressionType::None) noexcept;
+    /// Uses `packedTrx`, the already serialized transaction, instead of serializing it again.
+    PackedTransaction(const Transaction& transaction, Data packedTrx, CompressionType type = CompressionType::None) noexcept;
 
     void serialize(Data& os) const noexcept;
     nlohmann::json serialize() const noexcept;
+
+  private:
+    void copyFromTransaction(const Transaction& transaction) noexcept;
 };
 
 } // namespace TW::EOS
@@ -9,15 +9,94 @@
 #include "PackedTransaction.h"
 #include "../proto/Common.pb.h"
 #include "../HexCoding.h"
+#include "../ThreadPool.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/nist256p1.h>
 #include <TrezorCrypto/secp256k1.h>
 
+#include <algorithm>
+#include <atomic>
+#include <optional>
+
 using namespace TW;
 using namespace TW::EOS;
 
+static Type keyType(Proto::KeyType type) {
+    switch (type) {
+    case Proto::KeyType::MODERNK1:
+        return Type::ModernK1;
+    case Proto::KeyType::MODERNR1:
+        return Type::ModernR1;
+    case Proto::KeyType::LEGACY:
+    default:
+        return Type::Legacy;
+    }
+}
+
+static bool sameHeader(const Proto::SigningInput& lhs, const Proto::SigningInput& rhs) {
+    return lhs.chain_id() == rhs.chain_id() && lhs.reference_block_id() == rhs.reference_block_id() &&
+           lhs.reference_block_time() == rhs.reference_block_time();
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    try {
+        return sign(input, headerContext(input));
+    } catch (const std::exception& e) {
+        Proto::SigningOutput output;
+        output.set_error(Common::Proto::Error_internal);
+        return output;
+    }
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    // header context index of each input, an empty optional if the reference block is invalid
+    std::vector<std::optional<SHA256_CTX>> contexts;
+    std::vector<size_t> contextIndices(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (i == 0 || !sameHeader(inputs[i], inputs[i - 1])) {
+            try {
+                contexts.emplace_back(headerContext(inputs[i]));
+            } catch (const std::exception& e) {
+                contexts.emplace_back();
+            }
+        }
+        contextIndices[i] = contexts.size() - 1;
+    }
+
+    std::vector<Proto::SigningOutput> outputs(inputs.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto index = next++; index < inputs.size(); index = next++) {
+            const auto& context = contexts[contextIndices[index]];
+            if (context) {
+                outputs[index] = sign(inputs[index], *context);
+            } else {
+                outputs[index].set_error(Common::Proto::Error_internal);
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, inputs.size(), worker);
+    return outputs;
+}
+
+Transaction Signer::transaction(const Proto::SigningInput& input) {
+    return Transaction(Data(input.reference_block_id().begin(), input.reference_block_id().end()),
+                       input.reference_block_time());
+}
+
+SHA256_CTX Signer::headerContext(const Proto::SigningInput& input) {
+    Data header;
+    transaction(input).serializeHeader(header);
+    SHA256_CTX context;
+    sha256_Init(&context);
+    sha256_Update(&context, reinterpret_cast<const byte*>(input.chain_id().data()), input.chain_id().size());
+    sha256_Update(&context, header.data(), header.size());
+    return context;
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, const SHA256_CTX& headerContext) noexcept {
     Proto::SigningOutput output;
     try {
         // create an asset object
@@ -30,35 +109,32 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
                                      input.memo());
 
         // create a Transaction and add the transfer action
-        auto tx = Transaction(Data(input.reference_block_id().begin(), input.reference_block_id().end()),
-                        input.reference_block_time());
+        auto tx = transaction(input);
         tx.actions.push_back(action);
-
-        // get key type
-        EOS::Type type = Type::Legacy;
-        switch (input.private_key_type()) {
-        case Proto::KeyType::LEGACY:
-            type = Type::Legacy;
-            break;
-
-        case Proto::KeyType::MODERNK1:
-            type = Type::ModernK1;
-            break;
-
-        case Proto::KeyType::MODERNR1:
-            type = Type::ModernR1;
-            break;
-        default:
-            break;
+        if (!tx.isValid()) {
+            throw std::invalid_argument("Invalid transaction!");
         }
 
-        // sign the transaction with a Signer
+        // serialize once, for both the hash and the packed transaction
+        Data packed;
+        tx.serializeHeader(packed);
+        const auto headerSize = packed.size();
+        tx.serializeBody(packed);
+
+        // sha256(chain id, transaction, empty context free data hash), the prefix is already hashed
+        auto context = headerContext;
+        sha256_Update(&context, packed.data() + headerSize, packed.size() - headerSize);
+        const byte cfdHash[Hash::sha256Size] = {};
+        sha256_Update(&context, cfdHash, sizeof(cfdHash));
+        Data hash(Hash::sha256Size);
+        sha256_Final(&context, hash.data());
+
+        // sign the transaction
         auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-        auto chainId = Data(input.chain_id().begin(), input.chain_id().end());
-        Signer(chainId).sign(key, type, tx);
+        tx.signatures.push_back(sign(key, keyType(input.private_key_type()), hash));
 
         // Pack the transaction and add the json encoding to Signing outputput
-        PackedTransaction ptx{tx, CompressionType::None};
+        PackedTransaction ptx{tx, std::move(packed), CompressionType::None};
 
         output.set_json_encoded(ptx.serialize().dump());
         return output;
@@ -73,6 +149,10 @@ void Signer::sign(const PrivateKey& privateKey, Type type, Transaction& transact
         throw std::invalid_argument("Invalid transaction!");
     }
 
+    transaction.signatures.push_back(sign(privateKey, type, hash(transaction)));
+}
+
+Signature Signer::sign(const PrivateKey& privateKey, Type type, const Data& hash) {
     // values for Legacy and ModernK1
     TWCurve curve = TWCurveSECP256k1;
     auto canonicalChecker = isCanonical;
@@ -83,9 +163,9 @@ void Signer::sign(const PrivateKey& privateKey, Type type, Transaction& transact
         canonicalChecker = nullptr;
     }
 
-    const Data result = privateKey.sign(hash(transaction), curve, canonicalChecker);
+    const Data result = privateKey.sign(hash, curve, canonicalChecker);
 
-    transaction.signatures.push_back(Signature(result, type));
+    return Signature(result, type);
 }
 
 TW::Data Signer::hash(const Transaction& transaction) const noexcept {
@@ -13,7 +13,10 @@
 #include "../PrivateKey.h"
 #include "../proto/EOS.pb.h"
 
+#include <TrezorCrypto/sha2.h>
+
 #include <stdexcept>
+#include <vector>
 
 namespace TW::EOS {
 
@@ -23,6 +26,10 @@ class Signer {
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transfers, returned in the same order, on up to `threadCount` threads (0: one per hardware thread).
+    /// The chain id and transaction header are hashed once for consecutive inputs sharing the chain and reference block.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
   public:
     const Data chainID;
 
@@ -36,6 +43,13 @@ class Signer {
     Data hash(const Transaction& transaction) const noexcept;
 
     static int isCanonical(uint8_t by, uint8_t sig[64]);
+
+  private:
+    /// Signs a transfer, `headerContext` holds the hash state after the chain id and the transaction header.
+    static Proto::SigningOutput sign(const Proto::SigningInput& input, const SHA256_CTX& headerContext) noexcept;
+    static Transaction transaction(const Proto::SigningInput& input);
+    static SHA256_CTX headerContext(const Proto::SigningInput& input);
+    static Signature sign(const PrivateKey& privateKey, Type type, const Data& hash);
 };
 
 } // namespace TW::EOS
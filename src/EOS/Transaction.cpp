@@ -86,14 +86,20 @@ void Transaction::setReferenceBlock(const Data& refBlockId) {
 }
 
 void Transaction::serialize(Data& os) const noexcept{
+    serializeHeader(os);
+    serializeBody(os);
+}
 
+void Transaction::serializeHeader(Data& os) const noexcept {
     encode32LE(expiration, os);
     encode16LE(refBlockNumber, os);
     encode32LE(refBlockPrefix, os);
     encodeVarInt32(maxNetUsageWords, os);
     os.push_back(maxCPUUsageInMS);
     encodeVarInt32(delaySeconds, os);
+}
 
+void Transaction::serializeBody(Data& os) const noexcept {
     encodeCollection(contextFreeActions, os);
     encodeCollection(actions, os);
     encodeCollection(transactionExtensions, os);
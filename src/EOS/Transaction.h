@@ -48,6 +48,10 @@ public:
 
     void serialize(Data& os) const noexcept;
     nlohmann::json serialize() const;
+    /// Serializes the fields preceding the actions, which only depend on the reference block and limits.
+    void serializeHeader(Data& os) const noexcept;
+    /// Serializes the actions and extensions, following the header.
+    void serializeBody(Data& os) const noexcept;
 
     inline bool isValid() { return maxNetUsageWords < UINT32_MAX / 8UL; }
 
@@ -0,0 +1,75 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ed25519SigningKey.h"
+
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/ed25519.h>
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+
+bool Ed25519SigningKey::supports(TWCurve curve) {
+    switch (curve) {
+    case TWCurveED25519:
+    case TWCurveED25519Blake2bNano:
+    case TWCurveED25519Extended:
+    case TWCurveCurve25519:
+        return true;
+    default:
+        return false;
+    }
+}
+
+Ed25519SigningKey::Ed25519SigningKey(const PrivateKey& privateKey, TWCurve curve) : signingCurve(curve) {
+    switch (curve) {
+    case TWCurveED25519:
+    case TWCurveCurve25519:
+        ed25519_secret_expand(privateKey.bytes.data(), expandedSecret.data());
+        ed25519_publickey_expanded(expandedSecret.data(), publicKeyBytes.data());
+        break;
+    case TWCurveED25519Blake2bNano:
+        ed25519_secret_expand_blake2b(privateKey.bytes.data(), expandedSecret.data());
+        ed25519_publickey_expanded_blake2b(expandedSecret.data(), publicKeyBytes.data());
+        break;
+    case TWCurveED25519Extended:
+        if (privateKey.bytes.size() + privateKey.extensionBytes.size() + privateKey.chainCodeBytes.size() != PrivateKey::extendedSize) {
+            throw std::invalid_argument("Invalid extended key");
+        }
+        // the key and its extension are the expanded secret already
+        std::copy(privateKey.bytes.begin(), privateKey.bytes.end(), expandedSecret.begin());
+        std::copy(privateKey.extensionBytes.begin(), privateKey.extensionBytes.end(), expandedSecret.begin() + 32);
+        ed25519_publickey_expanded(expandedSecret.data(), publicKeyBytes.data());
+        break;
+    default:
+        throw std::invalid_argument("Not an EdDSA curve");
+    }
+}
+
+Ed25519SigningKey::~Ed25519SigningKey() {
+    memzero(expandedSecret.data(), expandedSecret.size());
+}
+
+void Ed25519SigningKey::sign(DataView message, byte* signature) const {
+    if (signingCurve == TWCurveED25519Blake2bNano) {
+        ed25519_sign_expanded_blake2b(message.data(), message.size(), expandedSecret.data(), publicKeyBytes.data(), signature);
+        return;
+    }
+    ed25519_sign_expanded(message.data(), message.size(), expandedSecret.data(), publicKeyBytes.data(), signature);
+    if (signingCurve == TWCurveCurve25519) {
+        // the sign bit of the Ed25519 public key, for the conversion of the Curve25519 public key
+        signature[63] = static_cast<byte>((signature[63] & 0x7f) | (publicKeyBytes[31] & 0x80));
+    }
+}
+
+Data Ed25519SigningKey::sign(DataView message) const {
+    Data signature(signatureSize);
+    sign(message, signature.data());
+    return signature;
+}
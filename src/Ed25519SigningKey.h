@@ -0,0 +1,60 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+
+#include <TrustWalletCore/TWCurve.h>
+
+#include <array>
+#include <cstddef>
+
+namespace TW {
+
+/// EdDSA signing state of a private key: the expanded secret (clamped scalar and nonce prefix) and the public key.
+///
+/// Signing with a PrivateKey derives both for every signature, a SHA-512 (or BLAKE2b) hash and a fixed-base
+/// scalar multiplication, about as much as the signature itself; a signing key derives them once for all the
+/// signatures of a key.  Supports the Ed25519, Ed25519 Blake2b (Nano), extended Ed25519 (Cardano) and Curve25519
+/// curves, with the same signatures as PrivateKey::sign().  The secret is zeroed on destruction.
+class Ed25519SigningKey {
+  public:
+    static constexpr std::size_t signatureSize = 64;
+
+    /// Whether `curve` is an EdDSA curve of this class.
+    static bool supports(TWCurve curve);
+
+    /// Signing key of `privateKey` on `curve`.
+    ///
+    /// @throws std::invalid_argument if the curve is not supported, or if the key is not extended for TWCurveED25519Extended.
+    Ed25519SigningKey(const PrivateKey& privateKey, TWCurve curve);
+
+    ~Ed25519SigningKey();
+    Ed25519SigningKey(const Ed25519SigningKey&) = delete;
+    Ed25519SigningKey& operator=(const Ed25519SigningKey&) = delete;
+
+    /// Curve of the signatures.
+    TWCurve curve() const { return signingCurve; }
+
+    /// Ed25519 public key checked by the signatures, the one of TWPublicKeyTypeED25519 (also for Curve25519),
+    /// TWPublicKeyTypeED25519Blake2b or TWPublicKeyTypeED25519Extended without its chain code.
+    const std::array<byte, 32>& publicKey() const { return publicKeyBytes; }
+
+    /// Signs a message (a digest for most coins) into `signature`, of signatureSize bytes.
+    void sign(DataView message, byte* signature) const;
+
+    /// Signs a message, the result being the same as PrivateKey::sign() with the curve of this key.
+    Data sign(DataView message) const;
+
+  private:
+    TWCurve signingCurve;
+    std::array<byte, 64> expandedSecret;
+    std::array<byte, 32> publicKeyBytes;
+};
+
+} // namespace TW
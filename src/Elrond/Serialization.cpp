@@ -9,60 +9,57 @@
 #include "../Elrond/Address.h"
 #include "../proto/Elrond.pb.h"
 #include "Base64.h"
+#include "JsonWriter.h"
 #include "PrivateKey.h"
 
 using namespace TW;
 
-std::map<string, int> fields_order {
-    {"nonce", 1},
-    {"value", 2},
-    {"receiver", 3},
-    {"sender", 4},
-    {"gasPrice", 5},
-    {"gasLimit", 6},
-    {"data", 7},
-    {"chainID", 8},
-    {"version", 9},
-    {"signature", 10}
-};
-
-struct FieldsSorter {
-    bool operator() (const string& lhs, const string& rhs) const {
-        return fields_order[lhs] < fields_order[rhs]; 
-    }
-};
-
-template<class Key, class T, class Compare, class Allocator>
-using sorted_map = std::map<Key, T, FieldsSorter, Allocator>;
-using sorted_json = nlohmann::basic_json<sorted_map>;
-
-sorted_json preparePayload(const Elrond::Proto::TransactionMessage& message) {
-    sorted_json payload {
-        {"nonce", json(message.nonce())},
-        {"value", json(message.value())},
-        {"receiver", json(message.receiver())},
-        {"sender", json(message.sender())},
-        {"gasPrice", json(message.gas_price())},
-        {"gasLimit", json(message.gas_limit())},
-    };
-
+/// Writes the transaction fields, in the order defined by the protocol.
+template <typename Writer>
+static void writePayload(Writer& writer, const Elrond::Proto::TransactionMessage& message) {
+    writer.field("nonce", message.nonce());
+    writer.field("value", message.value());
+    writer.field("receiver", message.receiver());
+    writer.field("sender", message.sender());
+    writer.field("gasPrice", message.gas_price());
+    writer.field("gasLimit", message.gas_limit());
     if (!message.data().empty()) {
-        payload["data"] = json(TW::Base64::encode(TW::data(message.data())));
+        writer.field("data", TW::Base64::encode(TW::data(message.data())));
     }
+    writer.field("chainID", message.chain_id());
+    writer.field("version", message.version());
+}
 
-    payload["chainID"] = json(message.chain_id());
-    payload["version"] = json(message.version());
-
-    return payload;
+static string serialize(const Elrond::Proto::TransactionMessage& message, const string* signature) {
+    string output;
+    // field names, numbers and addresses, plus the base64 data and the signature
+    output.reserve(320 + message.data().size() * 4 / 3 + (signature != nullptr ? signature->size() : 0));
+    JsonStringSink sink(output);
+    JsonWriter<JsonStringSink, JsonKeyOrder::asWritten> writer(sink);
+    writer.beginObject();
+    writePayload(writer, message);
+    if (signature != nullptr) {
+        writer.field("signature", *signature);
+    }
+    writer.endObject();
+    return output;
 }
 
 string Elrond::serializeTransaction(const Proto::TransactionMessage& message) {
-    sorted_json payload = preparePayload(message);
-    return payload.dump();
+    return serialize(message, nullptr);
 }
 
 string Elrond::serializeSignedTransaction(const Proto::TransactionMessage& message, string signature) {
-    sorted_json payload = preparePayload(message);
-    payload["signature"] = json(signature);
-    return payload.dump();
+    return serialize(message, &signature);
+}
+
+string Elrond::serializeSignedTransaction(const string& serializedTransaction, const string& encodedSignature) {
+    // the signature is the last field: replaces the closing brace of the unsigned transaction
+    string output;
+    output.reserve(serializedTransaction.size() + encodedSignature.size() + 16);
+    output.append(serializedTransaction, 0, serializedTransaction.size() - 1);
+    output.append(",\"signature\":\"");
+    output.append(encodedSignature);
+    output.append("\"}");
+    return output;
 }
@@ -17,5 +17,8 @@ namespace TW::Elrond {
 
 string serializeTransaction(const Proto::TransactionMessage& message);
 string serializeSignedTransaction(const Proto::TransactionMessage& message, string encodedSignature);
+/// Same as serializeSignedTransaction(message, encodedSignature), from the output of serializeTransaction(message).
+/// The hex signature needs no escaping.
+string serializeSignedTransaction(const string& serializedTransaction, const string& encodedSignature);
 
 } // namespace
@@ -9,19 +9,16 @@
 #include "Serialization.h"
 #include "../PublicKey.h"
 #include "HexCoding.h"
+#include "../BatchSigning.h"
 
 #include <google/protobuf/util/json_util.h>
 
 using namespace TW;
 using namespace TW::Elrond;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
-    auto privateKey = PrivateKey(input.private_key());
-    auto signableAsString = serializeTransaction(input.transaction());
-    auto signableAsData = TW::data(signableAsString);
-    auto signature = privateKey.sign(signableAsData, TWCurveED25519);
+static Proto::SigningOutput signingOutput(const std::string& signable, const Data& signature) {
     auto encodedSignature = hex(signature);
-    auto encoded = serializeSignedTransaction(input.transaction(), encodedSignature);
+    auto encoded = serializeSignedTransaction(signable, encodedSignature);
 
     auto protoOutput = Proto::SigningOutput();
     protoOutput.set_signature(encodedSignature);
@@ -29,6 +26,31 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
     return protoOutput;
 }
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
+    auto privateKey = PrivateKey(input.private_key());
+    auto signableAsString = serializeTransaction(input.transaction());
+    auto signableAsData = TW::data(signableAsString);
+    auto signature = privateKey.sign(signableAsData, TWCurveED25519);
+    return signingOutput(signableAsString, signature);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto privateKey = PrivateKey(inputs[begin].private_key());
+        std::vector<std::string> signables;
+        std::vector<Data> messages;
+        for (auto i = begin; i < end; ++i) {
+            signables.push_back(serializeTransaction(inputs[i].transaction()));
+            messages.push_back(TW::data(signables.back()));
+        }
+        std::vector<Data> signatures;
+        privateKey.signBatch(messages, TWCurveED25519, signatures);
+        for (auto i = begin; i < end; ++i) {
+            outputs[i] = signingOutput(signables[i - begin], signatures[i - begin]);
+        }
+    });
+}
+
 std::string Signer::signJSON(const std::string& json, const Data& key) {
     auto input = Proto::SigningInput();
     google::protobuf::util::JsonStringToMessage(json, &input);
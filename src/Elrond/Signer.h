@@ -10,6 +10,8 @@
 #include "../PrivateKey.h"
 #include "../proto/Elrond.pb.h"
 
+#include <vector>
+
 namespace TW::Elrond {
 
 /// Helper class that performs Elrond transaction signing.
@@ -20,6 +22,10 @@ public:
 
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys): consecutive inputs
+    /// with the same private key share the key state.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
     
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
@@ -7,7 +7,14 @@
 #include "Encrypt.h"
 #include "Data.h"
 #include <TrezorCrypto/aes.h>
+#include <TrezorCrypto/chacha20poly1305/rfc7539.h>
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <cstring>
+#include <stdexcept>
 
 namespace TW::Encrypt {
 
@@ -34,11 +41,10 @@ Data AESCBCEncrypt(const Data& key, const Data& data, Data& iv, TWAESPaddingMode
     const auto padding = paddingSize(data.size(), blockSize, paddingMode);
     const auto resultSize = data.size() + padding;
     Data result(resultSize);
-    size_t idx;
-    for (idx = 0; idx < resultSize - blockSize; idx += blockSize) {
-        aes_cbc_encrypt(data.data() + idx, result.data() + idx, blockSize, iv.data(), &ctx);
-    }
-    // last block
+    // whole blocks in one call, so that they are processed without per-call overhead
+    const size_t idx = data.size() - data.size() % blockSize;
+    aes_cbc_encrypt(data.data(), result.data(), static_cast<int>(idx), iv.data(), &ctx);
+    // last padded block
     if (idx < resultSize) {
         uint8_t padded[blockSize] = {0};
         if (paddingMode == TWAESPaddingModePKCS7) {
@@ -64,9 +70,7 @@ Data AESCBCDecrypt(const Data& key, const Data& data, Data& iv, TWAESPaddingMode
     }
 
     Data result(data.size());
-    for (std::size_t i = 0; i < data.size(); i += blockSize) {
-        aes_cbc_decrypt(data.data() + i, result.data() + i, blockSize, iv.data(), &ctx);
-    }
+    aes_cbc_decrypt(data.data(), result.data(), static_cast<int>(data.size()), iv.data(), &ctx);
 
     if (paddingMode == TWAESPaddingModePKCS7 && result.size() > 0) {
         // need to remove padding
@@ -104,4 +108,153 @@ Data AESCTRDecrypt(const Data& key, const Data& data, Data& iv) {
     return result;
 }
 
+struct ChaCha20Poly1305::Context {
+    static constexpr size_t blockSize = 64;
+
+    chacha20poly1305_ctx state;
+    /// Keystream of the last block, of which the first keystreamOffset bytes are used
+    std::array<byte, blockSize> keystream;
+    size_t keystreamOffset = blockSize;
+    uint64_t authenticatedSize = 0;
+    uint64_t messageSize = 0;
+};
+
+ChaCha20Poly1305::ChaCha20Poly1305(DataView key, DataView nonce) : context(std::make_unique<Context>()) {
+    if (key.size() != keySize) {
+        throw std::invalid_argument("Invalid key size");
+    }
+    if (nonce.size() != nonceSize) {
+        throw std::invalid_argument("Invalid nonce size");
+    }
+    rfc7539_init(&context->state, key.data(), nonce.data());
+}
+
+ChaCha20Poly1305::~ChaCha20Poly1305() {
+    memzero(context.get(), sizeof(Context));
+}
+
+void ChaCha20Poly1305::addAuthenticatedData(DataView data) {
+    if (stage != Stage::authenticatedData) {
+        throw std::logic_error("Authenticated data must precede the message");
+    }
+    poly1305_update(&context->state.poly1305, data.data(), data.size());
+    context->authenticatedSize += data.size();
+}
+
+void ChaCha20Poly1305::start(Stage next) {
+    if (stage == Stage::authenticatedData) {
+        // the authenticated data is padded to whole Poly1305 blocks
+        static const byte padding[tagSize] = {0};
+        const auto remainder = context->authenticatedSize % tagSize;
+        if (remainder != 0) {
+            poly1305_update(&context->state.poly1305, padding, tagSize - remainder);
+        }
+        stage = next;
+    } else if (stage == Stage::finished) {
+        throw std::logic_error("Message already ended");
+    } else if (stage != next) {
+        throw std::logic_error("Message is both encrypted and decrypted");
+    }
+}
+
+void ChaCha20Poly1305::crypt(const byte* input, byte* output, size_t size) {
+    auto& ctx = *context;
+    // the rest of the block started by the previous chunk
+    while (size > 0 && ctx.keystreamOffset < Context::blockSize) {
+        *output++ = *input++ ^ ctx.keystream[ctx.keystreamOffset++];
+        --size;
+    }
+    // whole blocks, in calls of at most 1 GiB as the ChaCha20 code counts bytes in 32 bits
+    constexpr size_t maxCall = 0x40000000;
+    auto whole = size - size % Context::blockSize;
+    while (whole > 0) {
+        const auto count = std::min(whole, maxCall);
+        ECRYPT_encrypt_bytes(&ctx.state.chacha20, input, output, static_cast<uint32_t>(count));
+        input += count;
+        output += count;
+        size -= count;
+        whole -= count;
+    }
+    // start of a block, the rest of its keystream is kept for the next chunk
+    if (size > 0) {
+        ECRYPT_keystream_bytes(&ctx.state.chacha20, ctx.keystream.data(), Context::blockSize);
+        for (size_t i = 0; i < size; ++i) {
+            output[i] = input[i] ^ ctx.keystream[i];
+        }
+        ctx.keystreamOffset = size;
+    }
+}
+
+void ChaCha20Poly1305::encrypt(DataView data, byte* output) {
+    start(Stage::encrypting);
+    crypt(data.data(), output, data.size());
+    poly1305_update(&context->state.poly1305, output, data.size());
+    context->messageSize += data.size();
+}
+
+Data ChaCha20Poly1305::encrypt(DataView data) {
+    Data result(data.size());
+    encrypt(data, result.data());
+    return result;
+}
+
+void ChaCha20Poly1305::decrypt(DataView data, byte* output) {
+    start(Stage::decrypting);
+    // authenticated first, as the output may overwrite the input
+    poly1305_update(&context->state.poly1305, data.data(), data.size());
+    crypt(data.data(), output, data.size());
+    context->messageSize += data.size();
+}
+
+Data ChaCha20Poly1305::decrypt(DataView data) {
+    Data result(data.size());
+    decrypt(data, result.data());
+    return result;
+}
+
+Data ChaCha20Poly1305::computeTag() {
+    Data tag(tagSize);
+    rfc7539_finish(&context->state, static_cast<int64_t>(context->authenticatedSize),
+                   static_cast<int64_t>(context->messageSize), tag.data());
+    stage = Stage::finished;
+    return tag;
+}
+
+Data ChaCha20Poly1305::finish() {
+    start(Stage::encrypting);
+    return computeTag();
+}
+
+bool ChaCha20Poly1305::verify(DataView tag) {
+    start(Stage::decrypting);
+    const auto expected = computeTag();
+    return tag.size() == tagSize && poly1305_verify(expected.data(), tag.data()) == 1;
+}
+
+Data ChaCha20Poly1305Encrypt(const Data& key, const Data& nonce, const Data& data, const Data& aad) {
+    auto cipher = ChaCha20Poly1305(key, nonce);
+    cipher.addAuthenticatedData(aad);
+    Data result(data.size() + ChaCha20Poly1305::tagSize);
+    cipher.encrypt(data, result.data());
+    const auto tag = cipher.finish();
+    std::copy(tag.begin(), tag.end(), result.begin() + data.size());
+    return result;
+}
+
+Data ChaCha20Poly1305Decrypt(const Data& key, const Data& nonce, const Data& data, const Data& aad) {
+    if (data.size() < ChaCha20Poly1305::tagSize) {
+        throw std::invalid_argument("Invalid data size");
+    }
+    const auto size = data.size() - ChaCha20Poly1305::tagSize;
+    auto cipher = ChaCha20Poly1305(key, nonce);
+    cipher.addAuthenticatedData(aad);
+    Data result(size);
+    cipher.decrypt(DataView(data.data(), size), result.data());
+    if (!cipher.verify(DataView(data.data() + size, ChaCha20Poly1305::tagSize))) {
+        memzero(result.data(), result.size());
+        throw std::invalid_argument("Invalid tag");
+    }
+    return result;
+}
+
 } // namespace TW::Encrypt
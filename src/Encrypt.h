@@ -9,6 +9,8 @@
 #include <TrustWalletCore/TWAESPaddingMode.h>
 #include "Data.h"
 
+#include <memory>
+
 namespace TW::Encrypt {
 
 /// Determind needed padding size (used internally)
@@ -46,4 +48,83 @@ Data AESCTREncrypt(const Data& key, const Data& data, Data& iv);
 /// \param iv initialization vector.
 Data AESCTRDecrypt(const Data& key, const Data& data, Data& iv);
 
+/// Incremental ChaCha20-Poly1305 authenticated encryption (RFC 8439), for messages encrypted or
+/// decrypted in chunks, such as large backups that are not loaded in memory at once.
+///
+/// One object processes one message: the additional authenticated data first, then the message
+/// in chunks of any size, and finally the tag is computed (encryption) or checked (decryption).
+class ChaCha20Poly1305 {
+  public:
+    static constexpr size_t keySize = 32;
+    static constexpr size_t nonceSize = 12;
+    static constexpr size_t tagSize = 16;
+
+    /// Initializes with a 32-byte key and a 12-byte nonce, which must not be reused with the same key.
+    ///
+    /// \throws std::invalid_argument if the key or the nonce has the wrong size.
+    ChaCha20Poly1305(DataView key, DataView nonce);
+    ~ChaCha20Poly1305();
+
+    ChaCha20Poly1305(const ChaCha20Poly1305&) = delete;
+    ChaCha20Poly1305& operator=(const ChaCha20Poly1305&) = delete;
+
+    /// Appends additional authenticated data, which is authenticated but not encrypted.
+    ///
+    /// \throws std::logic_error if called after encrypting or decrypting started.
+    void addAuthenticatedData(DataView data);
+
+    /// Encrypts the next chunk of the message into `output`, which has room for data.size() bytes
+    /// and may be data.data().
+    ///
+    /// \throws std::logic_error if called after decrypting, or after the tag.
+    void encrypt(DataView data, byte* output);
+    Data encrypt(DataView data);
+
+    /// Decrypts the next chunk of the message into `output`, which has room for data.size() bytes
+    /// and may be data.data(). The output must not be trusted before verify() succeeds.
+    ///
+    /// \throws std::logic_error if called after encrypting, or after the tag.
+    void decrypt(DataView data, byte* output);
+    Data decrypt(DataView data);
+
+    /// Returns the 16-byte tag of the encrypted message, ending the message.
+    ///
+    /// \throws std::logic_error if called after decrypting, or twice.
+    Data finish();
+
+    /// Returns whether `tag` authenticates the decrypted message, compared in constant time,
+    /// ending the message.
+    ///
+    /// \throws std::logic_error if called after encrypting, or twice.
+    bool verify(DataView tag);
+
+  private:
+    enum class Stage { authenticatedData, encrypting, decrypting, finished };
+    struct Context;
+
+    void start(Stage stage);
+    void crypt(const byte* input, byte* output, size_t size);
+    Data computeTag();
+
+    std::unique_ptr<Context> context;
+    Stage stage = Stage::authenticatedData;
+};
+
+/// Encrypts a message using ChaCha20-Poly1305 (RFC 8439), returning the ciphertext followed by the 16-byte tag.
+///
+/// \param key encryption key, must be 32 bytes long.
+/// \param nonce nonce, must be 12 bytes long and unique for the key.
+/// \param data data to encrypt.
+/// \param aad additional data to authenticate, not encrypted.
+Data ChaCha20Poly1305Encrypt(const Data& key, const Data& nonce, const Data& data, const Data& aad = {});
+
+/// Decrypts a message encrypted using ChaCha20-Poly1305 (RFC 8439), consisting of the ciphertext followed by the tag.
+///
+/// \param key decryption key, must be 32 bytes long.
+/// \param nonce nonce the message was encrypted with, must be 12 bytes long.
+/// \param data ciphertext followed by the 16-byte tag.
+/// \param aad additional authenticated data.
+/// \throws std::invalid_argument if the message is too short or does not authenticate.
+Data ChaCha20Poly1305Decrypt(const Data& key, const Data& nonce, const Data& data, const Data& aad = {});
+
 } // namespace TW::Encrypt
@@ -8,7 +8,9 @@
 #include "ParamFactory.h"
 #include "ValueEncoder.h"
 
+#include <algorithm>
 #include <cassert>
+#include <stdexcept>
 
 using namespace TW::Ethereum::ABI;
 
@@ -72,3 +74,51 @@ bool ParamArray::decode(const Data& encoded, size_t& offset_inout) {
     offset_inout = origOffset + ValueEncoder::paddedTo32(offset_inout - origOffset);
     return res;
 }
+
+size_t ParamPackedArray::elementSize(const std::string& elementType) {
+    if (elementType == "address") { return 20; }
+    if (elementType == "uint256" || elementType == "bytes32") { return 32; }
+    return 0;
+}
+
+ParamPackedArray::ParamPackedArray(const std::string& elementType, const Data& elements) : _elementType(elementType) {
+    const auto size = elementSize(elementType);
+    if (size == 0) {
+        throw std::invalid_argument("Unsupported packed array type " + elementType);
+    }
+    if (elements.size() % size != 0) {
+        throw std::invalid_argument("Invalid packed array size");
+    }
+    // addresses are padded on the left, like numbers
+    const auto count = elements.size() / size;
+    _words.resize(count * 32);
+    for (size_t i = 0; i < count; ++i) {
+        std::copy(elements.begin() + i * size, elements.begin() + (i + 1) * size, _words.begin() + i * 32 + (32 - size));
+    }
+}
+
+TW::Data ParamPackedArray::getElement(size_t index) const {
+    const auto size = elementSize(_elementType);
+    const auto end = _words.begin() + (index + 1) * 32;
+    return Data(end - size, end);
+}
+
+void ParamPackedArray::encode(Data& data) const {
+    ValueEncoder::encodeUInt256(uint256_t(getCount()), data);
+    append(data, _words);
+}
+
+bool ParamPackedArray::decode(const Data& encoded, size_t& offset_inout) {
+    uint256_t len256;
+    if (!ABI::decode(encoded, len256, offset_inout)) {
+        return false;
+    }
+    const auto available = (encoded.size() - std::min(encoded.size(), offset_inout)) / 32;
+    if (len256 > uint256_t(available)) {
+        return false;
+    }
+    const auto len = static_cast<size_t>(len256);
+    _words.assign(encoded.begin() + offset_inout, encoded.begin() + offset_inout + len * 32);
+    offset_inout += len * 32;
+    return true;
+}
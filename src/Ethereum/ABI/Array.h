@@ -36,4 +36,33 @@ public:
     virtual bool decode(const Data& encoded, size_t& offset_inout);
 };
 
+/// Dynamic array of a static 32-byte type, "address[]", "uint256[]" or "bytes32[]", built from a contiguous buffer
+/// of elements and kept in its encoded form; for calls with thousands of elements, such as airdrops, without a
+/// ParamBase per element.
+class ParamPackedArray: public ParamCollection
+{
+private:
+    std::string _elementType;
+    Data _words;
+
+public:
+    /// Size of an element of `elementType` in a buffer: 20 for "address", 32 for "uint256" (big endian) and
+    /// "bytes32"; 0 for other types.
+    static size_t elementSize(const std::string& elementType);
+
+    /// Array of the elements of `elements`, one after the other, elementSize(elementType) bytes each.
+    ///
+    /// @throws std::invalid_argument if the type is not supported or the buffer is not a whole number of elements.
+    ParamPackedArray(const std::string& elementType, const Data& elements = {});
+    const std::string& getElementType() const { return _elementType; }
+    /// Element at `index`, elementSize bytes.
+    Data getElement(size_t index) const;
+    virtual std::string getType() const { return _elementType + "[]"; }
+    virtual size_t getSize() const { return 32 + _words.size(); }
+    virtual bool isDynamic() const { return true; }
+    virtual size_t getCount() const { return _words.size() / 32; }
+    virtual void encode(Data& data) const;
+    virtual bool decode(const Data& encoded, size_t& offset_inout);
+};
+
 } // namespace TW::Ethereum::ABI
@@ -0,0 +1,153 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CompiledEvent.h"
+
+#include "../../Hash.h"
+
+#include <algorithm>
+#include <cctype>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+
+namespace {
+
+/// Splits `text` at the separators which are not nested in parentheses.
+std::vector<std::string> splitTopLevel(const std::string& text, char separator) {
+    std::vector<std::string> parts;
+    std::string current;
+    int depth = 0;
+    for (auto c : text) {
+        if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        }
+        if (c == separator && depth == 0) {
+            parts.push_back(current);
+            current.clear();
+        } else {
+            current += c;
+        }
+    }
+    parts.push_back(current);
+    return parts;
+}
+
+std::string trim(const std::string& text) {
+    const auto begin = text.find_first_not_of(" \t");
+    if (begin == std::string::npos) {
+        return "";
+    }
+    return text.substr(begin, text.find_last_not_of(" \t") - begin + 1);
+}
+
+/// Whether indexed parameters of the type are stored as the hash of their encoding.
+bool isHashed(const Type& type) {
+    switch (type.kind) {
+    case Type::Kind::Bytes:
+    case Type::Kind::String:
+    case Type::Kind::Array:
+    case Type::Kind::FixedArray:
+    case Type::Kind::Tuple:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace
+
+CompiledEvent::CompiledEvent(const std::string& signature) {
+    const auto open = signature.find('(');
+    if (open == std::string::npos || open == 0 || signature.back() != ')') {
+        throw std::invalid_argument("Invalid event signature " + signature);
+    }
+    eventName = trim(signature.substr(0, open));
+    std::vector<Type> inputs;
+    const auto list = signature.substr(open + 1, signature.size() - open - 2);
+    if (!trim(list).empty()) {
+        for (const auto& parameter : splitTopLevel(list, ',')) {
+            // type, then optionally "indexed" and a name
+            std::vector<std::string> words;
+            for (const auto& word : splitTopLevel(trim(parameter), ' ')) {
+                if (!word.empty()) {
+                    words.push_back(word);
+                }
+            }
+            const bool isIndexed = words.size() > 1 && words[1] == "indexed";
+            if (words.empty() || words.size() > (isIndexed ? 3 : 2)) {
+                throw std::invalid_argument("Invalid event signature " + signature);
+            }
+            inputs.push_back(Type::parse(words[0]));
+            indexedInputs.push_back(isIndexed);
+        }
+    }
+    parameters = Type::tuple(std::move(inputs));
+    compile();
+}
+
+CompiledEvent::CompiledEvent(const nlohmann::json& entry) {
+    if (!entry.is_object() || !entry.contains("name") || !entry["name"].is_string()) {
+        throw std::invalid_argument("Invalid ABI event entry");
+    }
+    eventName = entry["name"].get<std::string>();
+    anonymous = entry.value("anonymous", false);
+    std::vector<Type> inputs;
+    if (entry.contains("inputs")) {
+        for (const auto& input : entry["inputs"]) {
+            inputs.push_back(Type::fromJson(input));
+            indexedInputs.push_back(input.value("indexed", false));
+        }
+    }
+    parameters = Type::tuple(std::move(inputs));
+    compile();
+}
+
+void CompiledEvent::compile() {
+    canonical = eventName + parameters.canonical;
+    signatureTopic = Hash::keccak256Digest(DataView(reinterpret_cast<const byte*>(canonical.data()), canonical.size()));
+
+    std::vector<Type> dataInputs;
+    topicCount = anonymous ? 0 : 1;
+    for (std::size_t i = 0; i < parameters.components.size(); ++i) {
+        if (indexedInputs[i]) {
+            ++topicCount;
+        } else {
+            dataInputs.push_back(parameters.components[i]);
+        }
+    }
+    if (topicCount > maxTopics) {
+        throw std::invalid_argument("Too many indexed parameters for " + canonical);
+    }
+    dataParameters = Type::tuple(std::move(dataInputs));
+}
+
+bool CompiledEvent::decode(const DataView* topics, std::size_t count, DataView data, ValueView* values) const {
+    if (count != topicCount) {
+        return false;
+    }
+    if (!anonymous && (topics[0].size() != signatureTopic.size() ||
+                       !std::equal(signatureTopic.begin(), signatureTopic.end(), topics[0].data()))) {
+        return false;
+    }
+    const auto encoded = ValueView::decode(dataParameters, data);
+    std::size_t topic = anonymous ? 0 : 1;
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < parameters.components.size(); ++i) {
+        if (!indexedInputs[i]) {
+            values[i] = encoded[position++];
+            continue;
+        }
+        const auto& type = parameters.components[i];
+        if (topics[topic].size() != 32) {
+            throw std::invalid_argument("Invalid topic size");
+        }
+        values[i] = ValueView::decode(isHashed(type) ? hashType : type, topics[topic++]);
+    }
+    return true;
+}
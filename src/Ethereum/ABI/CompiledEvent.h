@@ -0,0 +1,161 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Type.h"
+#include "ValueView.h"
+
+#include "../../Data.h"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TW::Ethereum::ABI {
+
+/// Topics and data of a log, as returned by eth_getLogs.
+struct Log {
+    std::vector<Data> topics;
+    Data data;
+    /// Contract which emitted the log, empty if unknown.
+    Data address;
+};
+
+/// Event compiled once from its signature or its JSON ABI entry, to decode many logs.
+///
+/// Decoded values are views into the topics and data of the log; indexed parameters of dynamic
+/// types are only available as the bytes32 hash stored in their topic.
+/// Thread-safe, a compiled event is immutable.
+class CompiledEvent {
+  public:
+    /// Maximum number of topics of a log.
+    static constexpr std::size_t maxTopics = 4;
+
+    /// Compiles a signature with the indexed parameters marked, such as
+    /// "Transfer(address indexed from, address indexed to, uint256 value)"; names are optional.
+    ///
+    /// @throws std::invalid_argument if the signature is not valid.
+    explicit CompiledEvent(const std::string& signature);
+    explicit CompiledEvent(const char* signature) : CompiledEvent(std::string(signature)) {}
+
+    /// Compiles an event entry of a JSON ABI, with "name", "inputs" and optionally "anonymous".
+    ///
+    /// @throws std::invalid_argument if the entry is not valid.
+    explicit CompiledEvent(const nlohmann::json& entry);
+
+    const std::string& name() const { return eventName; }
+
+    /// Canonical signature, such as "Transfer(address,address,uint256)".
+    const std::string& signature() const { return canonical; }
+
+    /// Keccak256 hash of the signature, the first topic of non-anonymous events.
+    const std::array<byte, 32>& topic() const { return signatureTopic; }
+
+    /// Input parameters, as a tuple.
+    const Type& inputs() const { return parameters; }
+
+    /// Whether each input parameter is indexed.
+    const std::vector<bool>& indexed() const { return indexedInputs; }
+
+    /// Decodes a log into one value per input parameter, reusing the storage of `values`.
+    /// `topics` is a range of byte buffers, such as std::vector<Data>.
+    ///
+    /// Returns false if the log is not an instance of the event (other signature or topic count).
+    /// @throws std::invalid_argument if the log data is not a valid encoding.
+    template <typename Topics>
+    bool decode(const Topics& topics, DataView data, std::vector<ValueView>& values) const {
+        std::array<DataView, maxTopics> views;
+        std::size_t count = 0;
+        if (!collectTopics(topics, views, count)) {
+            return false;
+        }
+        values.resize(parameters.components.size());
+        return decode(views.data(), count, data, values.data());
+    }
+
+    /// Decodes a log directly into outputs, one per input parameter, such as the members of a
+    /// caller struct: `event.decode(log.topics, log.data, transfer.from, transfer.to, transfer.value)`.
+    /// See ValueView::get for the supported outputs.
+    ///
+    /// Returns false if the log is not an instance of the event.
+    /// @throws std::invalid_argument if the log is not a valid encoding or cannot be read into the outputs.
+    template <typename Topics, typename... Outputs>
+    bool decodeInto(const Topics& topics, DataView data, Outputs&... outputs) const {
+        if (sizeof...(Outputs) != parameters.components.size()) {
+            throw std::invalid_argument("Expected " + std::to_string(parameters.components.size()) + " outputs for " + canonical);
+        }
+        std::array<DataView, maxTopics> views;
+        std::size_t count = 0;
+        std::array<ValueView, sizeof...(Outputs)> values;
+        if (!collectTopics(topics, views, count) || !decode(views.data(), count, data, values.data())) {
+            return false;
+        }
+        std::size_t index = 0;
+        (values[index++].get(outputs), ...);
+        return true;
+    }
+
+    /// Decodes the instances of the event in many logs, objects with `topics` and `data` members (such as Log),
+    /// calling `callback(index, values)` for each with the index of the log and its decoded values.
+    /// Logs of other events and logs that are not valid encodings are skipped.
+    ///
+    /// Returns the number of decoded logs.
+    template <typename Logs, typename Callback>
+    std::size_t decodeAll(const Logs& logs, Callback&& callback) const {
+        std::vector<ValueView> values;
+        std::size_t decoded = 0;
+        std::size_t index = 0;
+        for (const auto& log : logs) {
+            bool valid = false;
+            try {
+                valid = decode(log.topics, DataView(log.data), values);
+            } catch (const std::invalid_argument&) {
+            }
+            if (valid) {
+                callback(index, static_cast<const std::vector<ValueView>&>(values));
+                ++decoded;
+            }
+            ++index;
+        }
+        return decoded;
+    }
+
+  private:
+    template <typename Topics>
+    static bool collectTopics(const Topics& topics, std::array<DataView, maxTopics>& views, std::size_t& count) {
+        for (const auto& topic : topics) {
+            if (count == maxTopics) {
+                return false;
+            }
+            views[count++] = DataView(topic);
+        }
+        return true;
+    }
+
+    bool decode(const DataView* topics, std::size_t topicCount, DataView data, ValueView* values) const;
+    void compile();
+
+    std::string eventName;
+    Type parameters;
+    std::vector<bool> indexedInputs;
+    bool anonymous = false;
+    std::string canonical;
+    std::array<byte, 32> signatureTopic;
+
+    /// Encoded parameters stored in the data, as a tuple.
+    Type dataParameters;
+    /// Type of indexed parameters which are stored as a hash.
+    Type hashType = Type::parse("bytes32");
+    std::size_t topicCount = 0;
+};
+
+} // namespace TW::Ethereum::ABI
@@ -0,0 +1,283 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "CompiledFunction.h"
+#include "ValueEncoder.h"
+
+#include "../../Hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+
+namespace {
+
+constexpr std::size_t wordSize = 32;
+
+std::size_t paddedSize(std::size_t size) {
+    return ValueEncoder::paddedTo32(size);
+}
+
+const UInt256& expectNumber(const Value& value, const Type& type) {
+    const auto number = value.number();
+    if (number == nullptr) {
+        throw std::invalid_argument("Expected a number for " + type.canonical);
+    }
+    return *number;
+}
+
+DataView expectBytes(const Value& value, const Type& type) {
+    const auto bytes = value.bytes();
+    if (bytes == nullptr) {
+        throw std::invalid_argument("Expected bytes for " + type.canonical);
+    }
+    return *bytes;
+}
+
+/// Elements of a list value, checked against the length of fixed arrays and tuples.
+const std::vector<Value>& expectElements(const Value& value, const Type& type, std::size_t count) {
+    const auto elements = value.elements();
+    if (elements == nullptr || (count != 0 && elements->size() != count)) {
+        throw std::invalid_argument("Expected " + std::to_string(count) + " elements for " + type.canonical);
+    }
+    return *elements;
+}
+
+/// Size of the tuple encoding of `values`, with the types given by `typeAt`.
+template <typename TypeAt>
+std::size_t tupleSize(const std::vector<Value>& values, TypeAt&& typeAt) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const auto& type = typeAt(i);
+        size += type.headSize();
+        if (type.dynamic) {
+            size += encodedSize(type, values[i]);
+        }
+    }
+    return size;
+}
+
+/// Writes the tuple encoding of `values`: static values and offsets first, then the dynamic values.
+template <typename TypeAt>
+std::size_t writeTuple(const std::vector<Value>& values, TypeAt&& typeAt, byte* out) {
+    std::size_t head = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        head += typeAt(i).headSize();
+    }
+    std::size_t tail = head;
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        const auto& type = typeAt(i);
+        if (type.dynamic) {
+            UInt256(tail).store(out + position);
+            const auto size = encodedSize(type, values[i]);
+            encodeValue(type, values[i], out + tail);
+            tail += size;
+            position += wordSize;
+        } else {
+            encodeValue(type, values[i], out + position);
+            position += type.staticSize;
+        }
+    }
+    return tail;
+}
+
+void checkNumber(const Type& type, const UInt256& number) {
+    switch (type.kind) {
+    case Type::Kind::UInt:
+    case Type::Kind::Address:
+        if (type.size < 256 && !(number >> static_cast<unsigned>(type.kind == Type::Kind::Address ? 160 : type.size)).isZero()) {
+            throw std::invalid_argument("Number out of range for " + type.canonical);
+        }
+        break;
+    case Type::Kind::Int: {
+        // the bits above the sign bit must all be copies of it
+        const auto high = number >> static_cast<unsigned>(type.size - 1);
+        if (!high.isZero() && high != (~UInt256() >> static_cast<unsigned>(type.size - 1))) {
+            throw std::invalid_argument("Number out of range for " + type.canonical);
+        }
+        break;
+    }
+    case Type::Kind::Bool:
+        if (number > UInt256(1)) {
+            throw std::invalid_argument("Invalid bool value");
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+Value::Value(const int256_t& number) : content(UInt256(ValueEncoder::uint256FromInt256(number))) {}
+
+std::size_t TW::Ethereum::ABI::encodedSize(const Type& type, const Value& value) {
+    switch (type.kind) {
+    case Type::Kind::Bytes:
+    case Type::Kind::String:
+        return wordSize + paddedSize(expectBytes(value, type).size());
+    case Type::Kind::Array: {
+        const auto& elements = expectElements(value, type, 0);
+        return wordSize + tupleSize(elements, [&](std::size_t) -> const Type& { return type.element(); });
+    }
+    case Type::Kind::FixedArray:
+        if (!type.dynamic) {
+            return type.staticSize;
+        }
+        return tupleSize(expectElements(value, type, type.size), [&](std::size_t) -> const Type& { return type.element(); });
+    case Type::Kind::Tuple:
+        if (!type.dynamic) {
+            return type.staticSize;
+        }
+        return tupleSize(expectElements(value, type, type.components.size()),
+                         [&](std::size_t i) -> const Type& { return type.components[i]; });
+    default:
+        return wordSize;
+    }
+}
+
+void TW::Ethereum::ABI::encodeValue(const Type& type, const Value& value, byte* out) {
+    switch (type.kind) {
+    case Type::Kind::UInt:
+    case Type::Kind::Int:
+    case Type::Kind::Bool: {
+        const auto& number = expectNumber(value, type);
+        checkNumber(type, number);
+        number.store(out);
+        return;
+    }
+    case Type::Kind::Address: {
+        if (const auto number = value.number()) {
+            checkNumber(type, *number);
+            number->store(out);
+            return;
+        }
+        const auto bytes = expectBytes(value, type);
+        if (bytes.size() != type.size) {
+            throw std::invalid_argument("Invalid address length");
+        }
+        std::memset(out, 0, wordSize - bytes.size());
+        std::memcpy(out + wordSize - bytes.size(), bytes.data(), bytes.size());
+        return;
+    }
+    case Type::Kind::FixedBytes: {
+        const auto bytes = expectBytes(value, type);
+        if (bytes.size() > type.size) {
+            throw std::invalid_argument("Too many bytes for " + type.canonical);
+        }
+        // padded on the right
+        std::memcpy(out, bytes.data(), bytes.size());
+        std::memset(out + bytes.size(), 0, wordSize - bytes.size());
+        return;
+    }
+    case Type::Kind::Bytes:
+    case Type::Kind::String: {
+        const auto bytes = expectBytes(value, type);
+        UInt256(bytes.size()).store(out);
+        if (!bytes.empty()) {
+            std::memcpy(out + wordSize, bytes.data(), bytes.size());
+        }
+        std::memset(out + wordSize + bytes.size(), 0, paddedSize(bytes.size()) - bytes.size());
+        return;
+    }
+    case Type::Kind::Array: {
+        const auto& elements = expectElements(value, type, 0);
+        UInt256(elements.size()).store(out);
+        writeTuple(elements, [&](std::size_t) -> const Type& { return type.element(); }, out + wordSize);
+        return;
+    }
+    case Type::Kind::FixedArray:
+        writeTuple(expectElements(value, type, type.size), [&](std::size_t) -> const Type& { return type.element(); }, out);
+        return;
+    case Type::Kind::Tuple:
+        writeTuple(expectElements(value, type, type.components.size()),
+                   [&](std::size_t i) -> const Type& { return type.components[i]; }, out);
+        return;
+    }
+}
+
+CompiledFunction::CompiledFunction(const std::string& signature) {
+    const auto open = signature.find('(');
+    if (open == std::string::npos || open == 0) {
+        throw std::invalid_argument("Invalid function signature " + signature);
+    }
+    functionName = signature.substr(0, open);
+    parameters = Type::parse(signature.substr(open));
+    if (parameters.kind != Type::Kind::Tuple) {
+        throw std::invalid_argument("Invalid function signature " + signature);
+    }
+    compile();
+}
+
+CompiledFunction::CompiledFunction(const nlohmann::json& entry) {
+    if (!entry.is_object() || !entry.contains("name") || !entry["name"].is_string()) {
+        throw std::invalid_argument("Invalid ABI function entry");
+    }
+    functionName = entry["name"].get<std::string>();
+    std::vector<Type> inputs;
+    if (entry.contains("inputs")) {
+        for (const auto& input : entry["inputs"]) {
+            inputs.push_back(Type::fromJson(input));
+        }
+    }
+    parameters = Type::tuple(std::move(inputs));
+    compile();
+}
+
+void CompiledFunction::compile() {
+    canonical = functionName + parameters.canonical;
+    const auto hash = Hash::keccak256Digest(DataView(reinterpret_cast<const byte*>(canonical.data()), canonical.size()));
+    std::copy(hash.begin(), hash.begin() + functionSelector.size(), functionSelector.begin());
+}
+
+std::size_t CompiledFunction::encodedSize(const std::vector<Value>& arguments) const {
+    if (arguments.size() != parameters.components.size()) {
+        throw std::invalid_argument("Expected " + std::to_string(parameters.components.size()) + " arguments for " + canonical);
+    }
+    const auto size = parameters.dynamic
+        ? tupleSize(arguments, [&](std::size_t i) -> const Type& { return parameters.components[i]; })
+        : parameters.staticSize;
+    return functionSelector.size() + size;
+}
+
+void CompiledFunction::encode(const std::vector<Value>& arguments, Data& data) const {
+    const auto offset = data.size();
+    data.resize(offset + encodedSize(arguments));
+    std::copy(functionSelector.begin(), functionSelector.end(), data.begin() + offset);
+    writeTuple(arguments, [&](std::size_t i) -> const Type& { return parameters.components[i]; },
+               data.data() + offset + functionSelector.size());
+}
+
+Data CompiledFunction::encode(const std::vector<Value>& arguments) const {
+    Data data;
+    encode(arguments, data);
+    return data;
+}
+
+bool CompiledFunction::decodeArguments(DataView calldata, ValueView& arguments) const {
+    if (calldata.size() < functionSelector.size() ||
+        !std::equal(functionSelector.begin(), functionSelector.end(), calldata.data())) {
+        return false;
+    }
+    arguments = ValueView::decode(parameters, calldata.subView(functionSelector.size(), calldata.size()));
+    return true;
+}
+
+bool CompiledFunction::decodeInput(DataView calldata, std::vector<ValueView>& arguments) const {
+    ValueView tuple;
+    if (!decodeArguments(calldata, tuple)) {
+        return false;
+    }
+    arguments.resize(parameters.components.size());
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+        arguments[i] = tuple[i];
+    }
+    return true;
+}
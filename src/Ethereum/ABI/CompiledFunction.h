@@ -0,0 +1,153 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Type.h"
+#include "ValueView.h"
+
+#include "../../Data.h"
+#include "../../uint256.h"
+
+#include <nlohmann/json.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace TW::Ethereum::ABI {
+
+/// Value to encode with a compiled ABI type: a number (also for bool and, optionally, address),
+/// a byte string (address, bytesN, bytes, string) or a list of values (arrays and tuples).
+///
+/// Byte strings are views: the referenced bytes must outlive the value.
+class Value {
+  public:
+    Value(const UInt256& number) : content(number) {}
+    Value(const uint256_t& number) : content(UInt256(number)) {}
+    /// Signed numbers are stored in two's complement.
+    Value(const int256_t& number);
+    template <typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+    Value(T number) : content(fromIntegral(number)) {}
+    Value(DataView bytes) : content(bytes) {}
+    Value(const Data& bytes) : content(DataView(bytes)) {}
+    Value(const std::string& string) : content(DataView(reinterpret_cast<const byte*>(string.data()), string.size())) {}
+    Value(std::vector<Value> elements) : content(std::move(elements)) {}
+
+    /// The number, nullptr if the value is not a number.
+    const UInt256* number() const { return std::get_if<UInt256>(&content); }
+    /// The bytes, nullptr if the value is not a byte string.
+    const DataView* bytes() const { return std::get_if<DataView>(&content); }
+    /// The elements, nullptr if the value is not a list.
+    const std::vector<Value>* elements() const { return std::get_if<std::vector<Value>>(&content); }
+
+  private:
+    template <typename T>
+    static UInt256 fromIntegral(T number) {
+        if constexpr (std::is_signed<T>::value) {
+            if (number < 0) {
+                return ~UInt256(static_cast<uint64_t>(-(number + 1)));
+            }
+        }
+        return UInt256(static_cast<uint64_t>(number));
+    }
+
+    std::variant<UInt256, DataView, std::vector<Value>> content;
+};
+
+/// Size of the ABI encoding of `value` as `type`.
+///
+/// @throws std::invalid_argument if the value does not match the type.
+std::size_t encodedSize(const Type& type, const Value& value);
+
+/// Writes the ABI encoding of `value` as `type`, encodedSize(type, value) bytes, to `out`.
+///
+/// @throws std::invalid_argument if the value does not match the type.
+void encodeValue(const Type& type, const Value& value, byte* out);
+
+/// Function compiled once from its signature or its JSON ABI entry.
+///
+/// The canonical signature, the selector and the parsed parameter types are kept, so encoding a
+/// call only writes the arguments, into a buffer allocated once with the exact size.
+/// Thread-safe, a compiled function is immutable.
+class CompiledFunction {
+  public:
+    /// Compiles a signature such as "transfer(address,uint256)".
+    ///
+    /// @throws std::invalid_argument if the signature is not valid.
+    explicit CompiledFunction(const std::string& signature);
+    explicit CompiledFunction(const char* signature) : CompiledFunction(std::string(signature)) {}
+
+    /// Compiles a function entry of a JSON ABI, with "name" and "inputs".
+    ///
+    /// @throws std::invalid_argument if the entry is not valid.
+    explicit CompiledFunction(const nlohmann::json& entry);
+
+    const std::string& name() const { return functionName; }
+
+    /// Canonical signature, such as "transfer(address,uint256)".
+    const std::string& signature() const { return canonical; }
+
+    /// First 4 bytes of the keccak256 hash of the signature.
+    const std::array<byte, 4>& selector() const { return functionSelector; }
+
+    /// Input parameters, as a tuple.
+    const Type& inputs() const { return parameters; }
+
+    /// Size of an encoded call.
+    ///
+    /// @throws std::invalid_argument if the arguments do not match the parameters.
+    std::size_t encodedSize(const std::vector<Value>& arguments) const;
+
+    /// Appends an encoded call (selector and arguments) to `data`.
+    ///
+    /// @throws std::invalid_argument if the arguments do not match the parameters.
+    void encode(const std::vector<Value>& arguments, Data& data) const;
+
+    /// Returns an encoded call (selector and arguments).
+    ///
+    /// @throws std::invalid_argument if the arguments do not match the parameters.
+    Data encode(const std::vector<Value>& arguments) const;
+
+    /// Decodes the arguments of an encoded call into views into `calldata`, reusing the storage of `arguments`.
+    ///
+    /// Returns false if the call is for another selector.
+    /// @throws std::invalid_argument if the arguments are not a valid encoding.
+    bool decodeInput(DataView calldata, std::vector<ValueView>& arguments) const;
+
+    /// Decodes the arguments of an encoded call directly into outputs, one per parameter.
+    /// See ValueView::get for the supported outputs.
+    ///
+    /// Returns false if the call is for another selector.
+    /// @throws std::invalid_argument if the arguments are not a valid encoding or cannot be read into the outputs.
+    template <typename... Outputs>
+    bool decodeInputInto(DataView calldata, Outputs&... outputs) const {
+        if (sizeof...(Outputs) != parameters.components.size()) {
+            throw std::invalid_argument("Expected " + std::to_string(parameters.components.size()) + " outputs for " + canonical);
+        }
+        ValueView arguments;
+        if (!decodeArguments(calldata, arguments)) {
+            return false;
+        }
+        std::size_t index = 0;
+        (arguments[index++].get(outputs), ...);
+        return true;
+    }
+
+  private:
+    void compile();
+    bool decodeArguments(DataView calldata, ValueView& arguments) const;
+
+    std::string functionName;
+    Type parameters;
+    std::string canonical;
+    std::array<byte, 4> functionSelector;
+};
+
+} // namespace TW::Ethereum::ABI
@@ -15,13 +15,18 @@ using namespace TW::Ethereum::ABI;
 
 Data Function::getSignature() const {
     auto typ = getType();
-    auto hash = Hash::keccak256(Data(typ.begin(), typ.end()));
-    auto signature = Data(hash.begin(), hash.begin() + 4);
+    if (typ != signatureType) {
+        // parameters changed since the last call
+        auto hash = Hash::keccak256(typ);
+        signature = Data(hash.begin(), hash.begin() + 4);
+        signatureType = std::move(typ);
+    }
     return signature;
 }
 
 void Function::encode(Data& data) const {
     Data signature = getSignature();
+    data.reserve(data.size() + signature.size() + _inParams.getSize());
     append(data, signature);
     _inParams.encode(data);
 }
@@ -67,6 +67,11 @@ public:
     bool decodeOutput(const Data& encoded, size_t& offset_inout);
     /// Decode binary, fill input parameters
     bool decodeInput(const Data& encoded, size_t& offset_inout);
+
+private:
+    /// Type signature the cached 4-byte signature was computed for
+    mutable std::string signatureType;
+    mutable Data signature;
 };
 
 inline void encode(const Function& func, Data& data) {
@@ -0,0 +1,197 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Type.h"
+
+#include <cctype>
+#include <stdexcept>
+
+using namespace TW::Ethereum::ABI;
+
+namespace {
+
+Type elementary(Type::Kind kind, std::size_t size, std::string canonical) {
+    Type type;
+    type.kind = kind;
+    type.size = size;
+    type.canonical = std::move(canonical);
+    type.dynamic = kind == Type::Kind::Bytes || kind == Type::Kind::String;
+    type.staticSize = type.dynamic ? 0 : 32;
+    return type;
+}
+
+bool parseNumber(const std::string& text, std::size_t& number) {
+    if (text.empty() || text.size() > 6 || text[0] == '0') {
+        return false;
+    }
+    number = 0;
+    for (auto c : text) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) {
+            return false;
+        }
+        number = number * 10 + static_cast<std::size_t>(c - '0');
+    }
+    return true;
+}
+
+Type parseElementary(const std::string& name) {
+    if (name == "address") {
+        return elementary(Type::Kind::Address, 20, name);
+    }
+    if (name == "bool") {
+        return elementary(Type::Kind::Bool, 0, name);
+    }
+    if (name == "string") {
+        return elementary(Type::Kind::String, 0, name);
+    }
+    if (name == "bytes") {
+        return elementary(Type::Kind::Bytes, 0, name);
+    }
+    if (name == "uint" || name == "int") {
+        const auto kind = name == "uint" ? Type::Kind::UInt : Type::Kind::Int;
+        return elementary(kind, 256, name + "256");
+    }
+
+    std::size_t size = 0;
+    for (const auto& prefix : {"uint", "int", "bytes"}) {
+        const auto length = std::char_traits<char>::length(prefix);
+        if (name.compare(0, length, prefix) != 0 || !parseNumber(name.substr(length), size)) {
+            continue;
+        }
+        if (name[0] == 'b') {
+            if (size > 32) {
+                break;
+            }
+            return elementary(Type::Kind::FixedBytes, size, name);
+        }
+        if (size % 8 != 0 || size > 256) {
+            break;
+        }
+        return elementary(name[0] == 'u' ? Type::Kind::UInt : Type::Kind::Int, size, name);
+    }
+    throw std::invalid_argument("Invalid ABI type " + name);
+}
+
+/// Applies array suffixes ("[]", "[2]"...) starting at `position`.
+Type parseSuffixes(Type type, const std::string& text, std::size_t& position) {
+    while (position < text.size() && text[position] == '[') {
+        const auto close = text.find(']', position);
+        if (close == std::string::npos) {
+            throw std::invalid_argument("Invalid ABI array type " + text);
+        }
+        const auto length = text.substr(position + 1, close - position - 1);
+        std::size_t count = 0;
+        if (!length.empty() && !parseNumber(length, count)) {
+            throw std::invalid_argument("Invalid ABI array length " + text);
+        }
+        type = Type::array(std::move(type), count);
+        position = close + 1;
+    }
+    return type;
+}
+
+Type parseType(const std::string& text, std::size_t& position) {
+    Type type;
+    if (position < text.size() && text[position] == '(') {
+        ++position;
+        std::vector<Type> components;
+        if (position < text.size() && text[position] == ')') {
+            ++position;
+        } else {
+            while (true) {
+                components.push_back(parseType(text, position));
+                if (position >= text.size()) {
+                    throw std::invalid_argument("Invalid ABI tuple type " + text);
+                }
+                const auto separator = text[position++];
+                if (separator == ')') {
+                    break;
+                }
+                if (separator != ',') {
+                    throw std::invalid_argument("Invalid ABI tuple type " + text);
+                }
+            }
+        }
+        type = Type::tuple(std::move(components));
+    } else {
+        const auto start = position;
+        while (position < text.size() && std::isalnum(static_cast<unsigned char>(text[position]))) {
+            ++position;
+        }
+        type = parseElementary(text.substr(start, position - start));
+    }
+    return parseSuffixes(std::move(type), text, position);
+}
+
+} // namespace
+
+Type Type::parse(const std::string& type) {
+    std::size_t position = 0;
+    auto result = parseType(type, position);
+    if (position != type.size()) {
+        throw std::invalid_argument("Invalid ABI type " + type);
+    }
+    return result;
+}
+
+Type Type::fromJson(const nlohmann::json& parameter) {
+    if (!parameter.is_object() || !parameter.contains("type") || !parameter["type"].is_string()) {
+        throw std::invalid_argument("Invalid ABI parameter");
+    }
+    const auto name = parameter["type"].get<std::string>();
+    if (name.compare(0, 5, "tuple") != 0) {
+        return parse(name);
+    }
+    std::vector<Type> components;
+    if (parameter.contains("components")) {
+        for (const auto& component : parameter["components"]) {
+            components.push_back(fromJson(component));
+        }
+    }
+    std::size_t position = 5;
+    auto result = parseSuffixes(tuple(std::move(components)), name, position);
+    if (position != name.size()) {
+        throw std::invalid_argument("Invalid ABI type " + name);
+    }
+    return result;
+}
+
+Type Type::tuple(std::vector<Type> components) {
+    Type type;
+    type.kind = Kind::Tuple;
+    type.canonical = "(";
+    for (const auto& component : components) {
+        if (type.canonical.size() > 1) {
+            type.canonical += ",";
+        }
+        type.canonical += component.canonical;
+        type.dynamic = type.dynamic || component.dynamic;
+        type.staticSize += component.staticSize;
+    }
+    type.canonical += ")";
+    if (type.dynamic) {
+        type.staticSize = 0;
+    }
+    type.components = std::move(components);
+    return type;
+}
+
+Type Type::array(Type element, std::size_t length) {
+    Type type;
+    type.size = length;
+    if (length == 0) {
+        type.kind = Kind::Array;
+        type.canonical = element.canonical + "[]";
+        type.dynamic = true;
+    } else {
+        type.kind = Kind::FixedArray;
+        type.canonical = element.canonical + "[" + std::to_string(length) + "]";
+        type.dynamic = element.dynamic;
+        type.staticSize = element.staticSize * length;
+    }
+    type.components.push_back(std::move(element));
+    return type;
+}
@@ -0,0 +1,64 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace TW::Ethereum::ABI {
+
+/// Parsed ABI type, such as "uint256", "bytes32[]" or "(address,uint256)[2]".
+///
+/// Parsing is done once; the canonical name, whether the encoding is dynamic and the size of
+/// static encodings are computed along.
+struct Type {
+    enum class Kind { UInt, Int, Address, Bool, FixedBytes, Bytes, String, Array, FixedArray, Tuple };
+
+    Kind kind = Kind::Tuple;
+
+    /// Bits of an integer, bytes of a fixed bytes type, length of a fixed array.
+    std::size_t size = 0;
+
+    /// Element type of an array, component types of a tuple.
+    std::vector<Type> components;
+
+    /// Canonical type name, as used in signatures ("uint" is "uint256").
+    std::string canonical;
+
+    /// Whether the encoding has a variable size.
+    bool dynamic = false;
+
+    /// Size of the encoding of a static type, 0 for dynamic types.
+    std::size_t staticSize = 0;
+
+    /// Size of the type in the head of an enclosing tuple: its static size, or an offset for dynamic types.
+    std::size_t headSize() const { return dynamic ? 32 : staticSize; }
+
+    /// Element type of an array.
+    const Type& element() const { return components.front(); }
+
+    /// Parses a type name.
+    ///
+    /// @throws std::invalid_argument if the type is not valid.
+    static Type parse(const std::string& type);
+
+    /// Parses a parameter of a JSON ABI, with "type" and for tuples "components".
+    ///
+    /// @throws std::invalid_argument if the type is not valid.
+    static Type fromJson(const nlohmann::json& parameter);
+
+    /// Tuple of the given components.
+    static Type tuple(std::vector<Type> components);
+
+    /// Array of `element`, dynamic if `length` is 0.
+    static Type array(Type element, std::size_t length = 0);
+};
+
+} // namespace TW::Ethereum::ABI
@@ -0,0 +1,326 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TypedData.h"
+
+#include "../../HexCoding.h"
+#include "../../uint256.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+using json = nlohmann::json;
+
+namespace {
+
+constexpr std::size_t wordSize = 32;
+
+/// Parses a "0x" prefixed (or not) hexadecimal string.
+Data parseHexValue(const json& value, const std::string& type) {
+    if (!value.is_string()) {
+        throw std::invalid_argument("Expected a hex string for " + type);
+    }
+    const auto& string = value.get_ref<const std::string&>();
+    const auto start = string.compare(0, 2, "0x") == 0 ? 2 : 0;
+    if ((string.size() - start) % 2 != 0 ||
+        !std::all_of(string.begin() + start, string.end(), [](char c) { return std::isxdigit(static_cast<unsigned char>(c)) != 0; })) {
+        throw std::invalid_argument("Invalid hex string for " + type);
+    }
+    return parse_hex(string);
+}
+
+/// Parses an integer given as a JSON number or a decimal or hexadecimal string, into two's complement.
+UInt256 parseInteger(const json& value, const Type& type) {
+    bool negative = false;
+    UInt256 magnitude;
+    if (value.is_number_unsigned()) {
+        magnitude = UInt256(value.get<uint64_t>());
+    } else if (value.is_number_integer()) {
+        const auto number = value.get<int64_t>();
+        negative = number < 0;
+        magnitude = negative ? UInt256(static_cast<uint64_t>(-(number + 1)) + 1) : UInt256(static_cast<uint64_t>(number));
+    } else if (value.is_string()) {
+        auto string = value.get<std::string>();
+        negative = !string.empty() && string[0] == '-';
+        if (negative) {
+            string.erase(0, 1);
+        }
+        const bool isHex = string.compare(0, 2, "0x") == 0;
+        const auto digits = string.substr(isHex ? 2 : 0);
+        if (digits.empty() || digits.size() > 78 ||
+            !std::all_of(digits.begin(), digits.end(), [isHex](char c) {
+                return isHex ? std::isxdigit(static_cast<unsigned char>(c)) != 0 : std::isdigit(static_cast<unsigned char>(c)) != 0;
+            })) {
+            throw std::invalid_argument("Invalid number for " + type.canonical);
+        }
+        const auto number = boost::multiprecision::cpp_int(string);
+        if (number != 0 && msb(number) >= 256) {
+            throw std::invalid_argument("Number out of range for " + type.canonical);
+        }
+        magnitude = UInt256(static_cast<uint256_t>(number));
+    } else {
+        throw std::invalid_argument("Expected a number for " + type.canonical);
+    }
+
+    if (type.kind == Type::Kind::UInt) {
+        if (negative || magnitude.bitLength() > type.size) {
+            throw std::invalid_argument("Number out of range for " + type.canonical);
+        }
+        return magnitude;
+    }
+    // at most 2^(size-1) - 1, or 2^(size-1) if negative
+    const auto limit = UInt256(1) << static_cast<unsigned>(type.size - 1);
+    if (magnitude > limit || (!negative && magnitude == limit)) {
+        throw std::invalid_argument("Number out of range for " + type.canonical);
+    }
+    return negative ? ~magnitude + UInt256(1) : magnitude;
+}
+
+/// Encodes an atomic value in a word.
+void encodeAtomic(const Type& type, const json& value, byte* word) {
+    switch (type.kind) {
+    case Type::Kind::UInt:
+    case Type::Kind::Int:
+        parseInteger(value, type).store(word);
+        return;
+    case Type::Kind::Bool:
+        if (!value.is_boolean()) {
+            throw std::invalid_argument("Expected a bool");
+        }
+        UInt256(value.get<bool>() ? 1 : 0).store(word);
+        return;
+    case Type::Kind::Address: {
+        const auto address = parseHexValue(value, type.canonical);
+        if (address.size() != type.size) {
+            throw std::invalid_argument("Invalid address length");
+        }
+        std::memset(word, 0, wordSize - address.size());
+        std::memcpy(word + wordSize - address.size(), address.data(), address.size());
+        return;
+    }
+    case Type::Kind::FixedBytes: {
+        const auto bytes = parseHexValue(value, type.canonical);
+        if (bytes.size() > type.size) {
+            throw std::invalid_argument("Too many bytes for " + type.canonical);
+        }
+        std::memcpy(word, bytes.data(), bytes.size());
+        std::memset(word + bytes.size(), 0, wordSize - bytes.size());
+        return;
+    }
+    default:
+        throw std::invalid_argument("Invalid atomic type " + type.canonical);
+    }
+}
+
+} // namespace
+
+TypedData::TypedData(const json& types) {
+    if (!types.is_object()) {
+        throw std::invalid_argument("Invalid EIP712 types");
+    }
+    // names first, members may refer to any struct
+    for (const auto& entry : types.items()) {
+        if (!entry.value().is_array() || entry.key().empty()) {
+            throw std::invalid_argument("Invalid EIP712 type " + entry.key());
+        }
+        index.emplace(entry.key(), structs.size());
+        StructType type;
+        type.name = entry.key();
+        structs.push_back(std::move(type));
+    }
+    for (const auto& entry : types.items()) {
+        auto& type = structs[index.at(entry.key())];
+        for (const auto& member : entry.value()) {
+            if (!member.is_object() || !member.contains("name") || !member["name"].is_string() ||
+                !member.contains("type") || !member["type"].is_string()) {
+                throw std::invalid_argument("Invalid EIP712 member of " + entry.key());
+            }
+            const auto typeName = member["type"].get<std::string>();
+            type.members.push_back(Member{member["name"].get<std::string>(), typeName, parseMemberType(typeName)});
+        }
+    }
+
+    for (std::size_t i = 0; i < structs.size(); ++i) {
+        auto found = std::vector<bool>(structs.size(), false);
+        collectDependencies(i, found);
+        found[i] = false;
+
+        auto& type = structs[i];
+        auto encode = [&](const StructType& dependency) {
+            type.encodedType += dependency.name + "(";
+            for (std::size_t m = 0; m < dependency.members.size(); ++m) {
+                if (m != 0) {
+                    type.encodedType += ",";
+                }
+                type.encodedType += dependency.members[m].typeName + " " + dependency.members[m].name;
+            }
+            type.encodedType += ")";
+        };
+        encode(type);
+        // the index is sorted by name
+        for (const auto& entry : index) {
+            if (found[entry.second]) {
+                encode(structs[entry.second]);
+            }
+        }
+        type.typeHash = Hash::keccak256Digest(DataView(reinterpret_cast<const byte*>(type.encodedType.data()), type.encodedType.size()));
+    }
+}
+
+TypedData::MemberType TypedData::parseMemberType(const std::string& typeName) const {
+    MemberType type;
+    if (!typeName.empty() && typeName.back() == ']') {
+        const auto open = typeName.rfind('[');
+        if (open == std::string::npos || open == 0) {
+            throw std::invalid_argument("Invalid EIP712 array type " + typeName);
+        }
+        const auto length = typeName.substr(open + 1, typeName.size() - open - 2);
+        if (!length.empty()) {
+            if (!std::all_of(length.begin(), length.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }) ||
+                length.size() > 6 || length[0] == '0') {
+                throw std::invalid_argument("Invalid EIP712 array type " + typeName);
+            }
+            type.length = std::stoul(length);
+        }
+        type.kind = MemberType::Kind::Array;
+        type.element.push_back(parseMemberType(typeName.substr(0, open)));
+        return type;
+    }
+    const auto found = index.find(typeName);
+    if (found != index.end()) {
+        type.kind = MemberType::Kind::Struct;
+        type.structIndex = found->second;
+        return type;
+    }
+    if (typeName == "bytes") {
+        type.kind = MemberType::Kind::Bytes;
+        return type;
+    }
+    if (typeName == "string") {
+        type.kind = MemberType::Kind::String;
+        return type;
+    }
+    if (typeName.find_first_of("(),") != std::string::npos) {
+        throw std::invalid_argument("Invalid EIP712 type " + typeName);
+    }
+    type.atomic = Type::parse(typeName);
+    return type;
+}
+
+void TypedData::collectDependencies(std::size_t structIndex, std::vector<bool>& found) const {
+    if (found[structIndex]) {
+        return;
+    }
+    found[structIndex] = true;
+    for (const auto& member : structs[structIndex].members) {
+        const auto* type = &member.type;
+        while (type->kind == MemberType::Kind::Array) {
+            type = &type->element.front();
+        }
+        if (type->kind == MemberType::Kind::Struct) {
+            collectDependencies(type->structIndex, found);
+        }
+    }
+}
+
+const TypedData::StructType& TypedData::find(const std::string& type) const {
+    const auto found = index.find(type);
+    if (found == index.end()) {
+        throw std::invalid_argument("Unknown EIP712 type " + type);
+    }
+    return structs[found->second];
+}
+
+TypedData::Digest TypedData::hashStruct(const std::string& type, const json& value) const {
+    return hashStruct(find(type), value);
+}
+
+TypedData::Digest TypedData::hashStruct(const StructType& type, const json& value) const {
+    if (!value.is_object()) {
+        throw std::invalid_argument("Expected an object for " + type.name);
+    }
+    auto hasher = Hash::Keccak256Hasher();
+    hasher.update(type.typeHash);
+    for (const auto& member : type.members) {
+        const auto found = value.find(member.name);
+        if (found == value.end()) {
+            throw std::invalid_argument("Missing member " + member.name + " of " + type.name);
+        }
+        encodeMember(member.type, *found, hasher);
+    }
+    return hasher.final();
+}
+
+void TypedData::encodeMember(const MemberType& type, const json& value, Hash::Keccak256Hasher& hasher) const {
+    switch (type.kind) {
+    case MemberType::Kind::Atomic: {
+        std::array<byte, wordSize> word;
+        encodeAtomic(type.atomic, value, word.data());
+        hasher.update(word);
+        return;
+    }
+    case MemberType::Kind::Bytes:
+        hasher.update(Hash::keccak256Digest(parseHexValue(value, "bytes")));
+        return;
+    case MemberType::Kind::String: {
+        if (!value.is_string()) {
+            throw std::invalid_argument("Expected a string");
+        }
+        const auto& string = value.get_ref<const std::string&>();
+        hasher.update(Hash::keccak256Digest(DataView(reinterpret_cast<const byte*>(string.data()), string.size())));
+        return;
+    }
+    case MemberType::Kind::Struct:
+        hasher.update(hashStruct(structs[type.structIndex], value));
+        return;
+    case MemberType::Kind::Array: {
+        if (!value.is_array() || (type.length != 0 && value.size() != type.length)) {
+            throw std::invalid_argument("Invalid EIP712 array length");
+        }
+        // keccak256 of the concatenated encodings of the elements
+        auto elements = Hash::Keccak256Hasher();
+        for (const auto& element : value) {
+            encodeMember(type.element.front(), element, elements);
+        }
+        hasher.update(elements.final());
+        return;
+    }
+    }
+}
+
+TypedData::Digest TypedData::hash(const Digest& domainSeparator, const std::string& primaryType, const json& message) const {
+    const auto structHash = hashStruct(primaryType, message);
+    return Hash::Keccak256Hasher().update(Data{0x19, 0x01}).update(domainSeparator).update(structHash).final();
+}
+
+std::vector<TypedData::Digest> TypedData::hashBatch(const Digest& domainSeparator, const std::string& primaryType,
+                                                    const std::vector<json>& messages) const {
+    const auto& type = find(primaryType);
+    auto preimages = std::vector<Data>(messages.size(), Data(2 + 2 * wordSize));
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        auto& preimage = preimages[i];
+        preimage[0] = 0x19;
+        preimage[1] = 0x01;
+        std::copy(domainSeparator.begin(), domainSeparator.end(), preimage.begin() + 2);
+        const auto structHash = hashStruct(type, messages[i]);
+        std::copy(structHash.begin(), structHash.end(), preimage.begin() + 2 + wordSize);
+    }
+    return Hash::keccak256Batch(preimages);
+}
+
+TypedData::Digest TypedData::hashTypedData(const json& typedData) {
+    if (!typedData.is_object() || !typedData.contains("types") || !typedData.contains("primaryType") ||
+        !typedData["primaryType"].is_string() || !typedData.contains("domain") || !typedData.contains("message")) {
+        throw std::invalid_argument("Invalid EIP712 typed data");
+    }
+    const auto types = TypedData(typedData["types"]);
+    const auto domainSeparator = types.domainSeparator(typedData["domain"]);
+    return types.hash(domainSeparator, typedData["primaryType"].get<std::string>(), typedData["message"]);
+}
@@ -0,0 +1,118 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Type.h"
+
+#include "../../Data.h"
+#include "../../Hash.h"
+#include "../../Hashers.h"
+
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TW::Ethereum::ABI {
+
+/// EIP-712 structured data hashing.
+///
+/// The struct type definitions are parsed once: the encodeType string (with the referenced structs
+/// sorted by name) and the typeHash of every struct are computed when constructed, and hashing a
+/// message only encodes its values, streamed into the keccak256 hasher.
+/// Thread-safe, the types are immutable.
+class TypedData {
+  public:
+    using Digest = Hash::Digest<Hash::sha256Size>;
+
+    /// Parses the "types" member of a typed data object, such as
+    /// `{"Mail": [{"name": "from", "type": "Person"}, {"name": "contents", "type": "string"}], "Person": [...]}`.
+    ///
+    /// @throws std::invalid_argument if a definition is not valid or refers to an unknown type.
+    explicit TypedData(const nlohmann::json& types);
+
+    /// Whether a struct type is defined.
+    bool contains(const std::string& type) const { return index.count(type) != 0; }
+
+    /// encodeType of a struct, such as "Mail(Person from,string contents)Person(string name,address wallet)".
+    ///
+    /// @throws std::invalid_argument if the struct is not defined.
+    const std::string& encodeType(const std::string& type) const { return find(type).encodedType; }
+
+    /// keccak256 of the encodeType of a struct.
+    ///
+    /// @throws std::invalid_argument if the struct is not defined.
+    const Digest& typeHash(const std::string& type) const { return find(type).typeHash; }
+
+    /// hashStruct of a value of a struct type: keccak256(typeHash ‖ encodeData(value)).
+    ///
+    /// @throws std::invalid_argument if the value does not match the type.
+    Digest hashStruct(const std::string& type, const nlohmann::json& value) const;
+
+    /// hashStruct of an EIP712Domain value.
+    ///
+    /// @throws std::invalid_argument if EIP712Domain is not defined or the value does not match.
+    Digest domainSeparator(const nlohmann::json& domain) const { return hashStruct("EIP712Domain", domain); }
+
+    /// Hash to sign: keccak256(0x1901 ‖ domainSeparator ‖ hashStruct(message)).
+    ///
+    /// @throws std::invalid_argument if the message does not match the type.
+    Digest hash(const Digest& domainSeparator, const std::string& primaryType, const nlohmann::json& message) const;
+
+    /// Hashes to sign of many messages of the same domain and type.
+    /// The final hashes are computed several at a time if the CPU supports it.
+    ///
+    /// @throws std::invalid_argument if a message does not match the type.
+    std::vector<Digest> hashBatch(const Digest& domainSeparator, const std::string& primaryType,
+                                  const std::vector<nlohmann::json>& messages) const;
+
+    /// Hash to sign of a complete typed data object, with "types", "primaryType", "domain" and "message".
+    ///
+    /// @throws std::invalid_argument if the object is not valid.
+    static Digest hashTypedData(const nlohmann::json& typedData);
+
+  private:
+    /// Type of a member: an atomic type, bytes, string, a struct or an array of these.
+    struct MemberType {
+        enum class Kind { Atomic, Bytes, String, Struct, Array };
+        Kind kind = Kind::Atomic;
+        /// Atomic type.
+        Type atomic;
+        /// Index of the struct.
+        std::size_t structIndex = 0;
+        /// Length of fixed arrays, 0 for dynamic arrays.
+        std::size_t length = 0;
+        /// Element type of arrays.
+        std::vector<MemberType> element;
+    };
+
+    struct Member {
+        std::string name;
+        std::string typeName;
+        MemberType type;
+    };
+
+    struct StructType {
+        std::string name;
+        std::vector<Member> members;
+        std::string encodedType;
+        Digest typeHash;
+    };
+
+    const StructType& find(const std::string& type) const;
+    MemberType parseMemberType(const std::string& type) const;
+    void collectDependencies(std::size_t structIndex, std::vector<bool>& found) const;
+    Digest hashStruct(const StructType& type, const nlohmann::json& value) const;
+    void encodeMember(const MemberType& type, const nlohmann::json& value, Hash::Keccak256Hasher& hasher) const;
+
+    std::vector<StructType> structs;
+    std::map<std::string, std::size_t> index;
+};
+
+} // namespace TW::Ethereum::ABI
@@ -11,10 +11,7 @@
 namespace TW::Ethereum::ABI {
 
 uint256_t ValueDecoder::decodeUInt256(const Data& data) {
-    if (data.size() > 32) {
-        return load(subData(data, 0, 32));
-    }
-    return load(data);
+    return static_cast<uint256_t>(UInt256::load(DataView(data).subView(0, 32)));
 }
 
 std::string ValueDecoder::decodeValue(const Data& data, const std::string& type) {
@@ -46,7 +46,9 @@ inline Data paddedOnLeft(const Data& inout) {
 }
 
 void ValueEncoder::encodeUInt256(const uint256_t& value, Data& inout) {
-    append(inout, paddedOnLeft(store(value)));
+    const auto offset = inout.size();
+    inout.resize(offset + encodedIntSize);
+    UInt256(value).store(inout.data() + offset);
 }
 
 /// Encoding primitive: encode a number of bytes by taking hash
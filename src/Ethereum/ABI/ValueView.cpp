@@ -0,0 +1,209 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ValueView.h"
+
+#include <algorithm>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+
+namespace {
+
+constexpr std::size_t wordSize = 32;
+
+/// Reads a length or an offset, which must be less than `limit`.
+std::size_t readSize(const byte* word, std::size_t limit) {
+    const auto value = UInt256::load(DataView(word, wordSize));
+    if (value.limbs[1] != 0 || value.limbs[2] != 0 || value.limbs[3] != 0 || value.limbs[0] > limit) {
+        throw std::invalid_argument("Invalid ABI offset or length");
+    }
+    return static_cast<std::size_t>(value.limbs[0]);
+}
+
+/// Checks that the unused bits of an elementary value word are clean.
+void validateWord(const Type& type, const byte* word) {
+    std::size_t zeros = 0;
+    switch (type.kind) {
+    case Type::Kind::UInt:
+        zeros = (256 - type.size) / 8;
+        break;
+    case Type::Kind::Address:
+        zeros = wordSize - type.size;
+        break;
+    case Type::Kind::Bool:
+        zeros = wordSize - 1;
+        if (word[wordSize - 1] > 1) {
+            throw std::invalid_argument("Invalid ABI bool");
+        }
+        break;
+    case Type::Kind::Int: {
+        // the bytes above the value must be copies of its sign bit
+        const auto high = wordSize - type.size / 8;
+        const byte sign = (word[high] & 0x80) != 0 ? 0xff : 0x00;
+        if (!std::all_of(word, word + high, [sign](byte b) { return b == sign; })) {
+            throw std::invalid_argument("Number out of range for " + type.canonical);
+        }
+        return;
+    }
+    case Type::Kind::FixedBytes:
+        // padded on the right
+        if (!std::all_of(word + type.size, word + wordSize, [](byte b) { return b == 0; })) {
+            throw std::invalid_argument("Invalid padding for " + type.canonical);
+        }
+        return;
+    default:
+        return;
+    }
+    if (!std::all_of(word, word + zeros, [](byte b) { return b == 0; })) {
+        throw std::invalid_argument("Number out of range for " + type.canonical);
+    }
+}
+
+void validate(const Type& type, DataView data);
+
+/// Validates the heads and tails of a tuple encoding, with the types given by `typeAt`.
+template <typename TypeAt>
+void validateTuple(DataView data, std::size_t count, TypeAt&& typeAt) {
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& type = typeAt(i);
+        if (type.dynamic) {
+            const auto offset = readSize(data.data() + position, data.size());
+            validate(type, data.subView(offset, data.size() - offset));
+        } else {
+            validate(type, data.subView(position, type.staticSize));
+        }
+        position += type.headSize();
+    }
+}
+
+/// Validates an encoding of `type` at the start of `data`, which is as long as the static size of static types.
+void validate(const Type& type, DataView data) {
+    if (data.size() < (type.dynamic ? wordSize : type.staticSize)) {
+        throw std::invalid_argument("ABI data too short for " + type.canonical);
+    }
+    switch (type.kind) {
+    case Type::Kind::Bytes:
+    case Type::Kind::String:
+        readSize(data.data(), data.size() - wordSize);
+        return;
+    case Type::Kind::Array: {
+        const auto& element = type.element();
+        const auto limit = data.size() - wordSize;
+        const auto count = readSize(data.data(), element.headSize() == 0 ? limit : limit / element.headSize());
+        validateTuple(data.subView(wordSize, data.size() - wordSize), count, [&](std::size_t) -> const Type& { return element; });
+        return;
+    }
+    case Type::Kind::FixedArray: {
+        const auto& element = type.element();
+        if (type.size * element.headSize() > data.size()) {
+            throw std::invalid_argument("ABI data too short for " + type.canonical);
+        }
+        validateTuple(data, type.size, [&](std::size_t) -> const Type& { return element; });
+        return;
+    }
+    case Type::Kind::Tuple: {
+        std::size_t head = 0;
+        for (const auto& component : type.components) {
+            head += component.headSize();
+        }
+        if (head > data.size()) {
+            throw std::invalid_argument("ABI data too short for " + type.canonical);
+        }
+        validateTuple(data, type.components.size(), [&](std::size_t i) -> const Type& { return type.components[i]; });
+        return;
+    }
+    default:
+        validateWord(type, data.data());
+        return;
+    }
+}
+
+} // namespace
+
+ValueView ValueView::decode(const Type& type, DataView data) {
+    validate(type, data);
+    return ValueView(type, type.dynamic ? data : data.subView(0, type.staticSize));
+}
+
+UInt256 ValueView::number() const {
+    switch (valueType->kind) {
+    case Type::Kind::UInt:
+    case Type::Kind::Int:
+    case Type::Kind::Bool:
+    case Type::Kind::Address:
+        return UInt256::load(encoding);
+    default:
+        throw std::invalid_argument("Not a number: " + valueType->canonical);
+    }
+}
+
+bool ValueView::boolean() const {
+    if (valueType->kind != Type::Kind::Bool) {
+        throw std::invalid_argument("Not a bool: " + valueType->canonical);
+    }
+    return encoding[wordSize - 1] != 0;
+}
+
+DataView ValueView::bytes() const {
+    switch (valueType->kind) {
+    case Type::Kind::Address:
+        return encoding.subView(wordSize - valueType->size, valueType->size);
+    case Type::Kind::FixedBytes:
+        return encoding.subView(0, valueType->size);
+    case Type::Kind::Bytes:
+    case Type::Kind::String:
+        // the length was checked when decoding
+        return encoding.subView(wordSize, readSize(encoding.data(), encoding.size() - wordSize));
+    default:
+        throw std::invalid_argument("Not bytes: " + valueType->canonical);
+    }
+}
+
+std::string ValueView::string() const {
+    const auto view = bytes();
+    return std::string(reinterpret_cast<const char*>(view.data()), view.size());
+}
+
+std::size_t ValueView::count() const {
+    switch (valueType->kind) {
+    case Type::Kind::Array:
+        return readSize(encoding.data(), encoding.size());
+    case Type::Kind::FixedArray:
+        return valueType->size;
+    case Type::Kind::Tuple:
+        return valueType->components.size();
+    default:
+        throw std::invalid_argument("Not an array or tuple: " + valueType->canonical);
+    }
+}
+
+ValueView ValueView::operator[](std::size_t index) const {
+    if (index >= count()) {
+        throw std::out_of_range("ABI element index out of range");
+    }
+    auto heads = encoding;
+    std::size_t position = 0;
+    const Type* element = nullptr;
+    if (valueType->kind == Type::Kind::Tuple) {
+        for (std::size_t i = 0; i < index; ++i) {
+            position += valueType->components[i].headSize();
+        }
+        element = &valueType->components[index];
+    } else {
+        if (valueType->kind == Type::Kind::Array) {
+            heads = encoding.subView(wordSize, encoding.size() - wordSize);
+        }
+        element = &valueType->element();
+        position = index * element->headSize();
+    }
+    if (element->dynamic) {
+        const auto offset = readSize(heads.data() + position, heads.size());
+        return ValueView(*element, heads.subView(offset, heads.size() - offset));
+    }
+    return ValueView(*element, heads.subView(position, element->staticSize));
+}
@@ -0,0 +1,101 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Type.h"
+
+#include "../../Data.h"
+#include "../../uint256.h"
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace TW::Ethereum::ABI {
+
+/// Decoded ABI value: a parsed type and a view into the encoded data, without copies.
+///
+/// Values are validated when decoded, accessors only read the referenced bytes.
+/// Both the type and the encoded data must outlive the view.
+class ValueView {
+  public:
+    ValueView() = default;
+
+    /// Decodes and validates a whole encoding of `type`, such as the arguments of a call as a tuple.
+    ///
+    /// @throws std::invalid_argument if the data is not a valid encoding of the type.
+    static ValueView decode(const Type& type, DataView data);
+
+    const Type& type() const { return *valueType; }
+
+    /// Encoded value: its 32-byte words for static types, data from its offset for dynamic types.
+    DataView encoded() const { return encoding; }
+
+    /// Number of an integer, bool or address.
+    ///
+    /// @throws std::invalid_argument for other types.
+    UInt256 number() const;
+
+    /// Whether a bool is true.
+    ///
+    /// @throws std::invalid_argument for other types.
+    bool boolean() const;
+
+    /// Bytes of an address (20), of a bytesN (N), or of a bytes or string value.
+    ///
+    /// @throws std::invalid_argument for other types.
+    DataView bytes() const;
+
+    /// Bytes as a string.
+    std::string string() const;
+
+    /// Number of elements of an array or tuple.
+    ///
+    /// @throws std::invalid_argument for other types.
+    std::size_t count() const;
+
+    /// Element of an array or tuple.
+    ///
+    /// @throws std::out_of_range if the index is not less than count().
+    ValueView operator[](std::size_t index) const;
+
+    /// Reads the value into an output, with the type of the output checked and integers range checked.
+    ///
+    /// @throws std::invalid_argument if the value cannot be read into the output.
+    void get(UInt256& out) const { out = number(); }
+    void get(uint256_t& out) const { out = static_cast<uint256_t>(number()); }
+    void get(bool& out) const { out = boolean(); }
+    void get(DataView& out) const { out = bytes(); }
+    void get(Data& out) const { out = bytes().toData(); }
+    void get(std::string& out) const { out = string(); }
+    void get(ValueView& out) const { out = *this; }
+    template <typename T, typename = std::enable_if_t<std::is_integral<T>::value && !std::is_same<T, bool>::value>>
+    void get(T& out) const;
+
+  private:
+    ValueView(const Type& type, DataView encoding) : valueType(&type), encoding(encoding) {}
+
+    const Type* valueType = nullptr;
+    DataView encoding;
+};
+
+template <typename T, typename>
+void ValueView::get(T& out) const {
+    const auto value = number();
+    const bool negative = std::is_signed<T>::value && (value.limbs[3] >> 63) != 0;
+    const auto magnitude = negative ? ~value : value;
+    if (magnitude.limbs[1] != 0 || magnitude.limbs[2] != 0 || magnitude.limbs[3] != 0 ||
+        magnitude.limbs[0] > static_cast<uint64_t>(std::numeric_limits<T>::max())) {
+        throw std::invalid_argument("Number out of range for output");
+    }
+    // for negative numbers, ~value is -value - 1
+    out = negative ? static_cast<T>(-static_cast<T>(magnitude.limbs[0]) - 1) : static_cast<T>(magnitude.limbs[0]);
+}
+
+} // namespace TW::Ethereum::ABI
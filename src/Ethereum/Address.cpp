@@ -11,19 +11,23 @@
 
 using namespace TW::Ethereum;
 
-bool Address::isValid(const std::string& string) {
+/// Address bytes of a 0x prefixed hex string, empty if it is not one
+static TW::Data decode(const std::string& string) {
     if (string.size() != 42 || string[0] != '0' || string[1] != 'x') {
-        return false;
+        return {};
     }
-    const auto data = parse_hex(string);
-    return Address::isValid(data);
+    return TW::parse_hex(string);
+}
+
+bool Address::isValid(const std::string& string) {
+    return Address::isValid(decode(string));
 }
 
 Address::Address(const std::string& string) {
-    if (!isValid(string)) {
+    const auto data = decode(string);
+    if (!isValid(data)) {
         throw std::invalid_argument("Invalid address data");
     }
-    const auto data = parse_hex(string);
     std::copy(data.begin(), data.end(), bytes.begin());
 }
 
@@ -43,5 +47,11 @@ Address::Address(const PublicKey& publicKey) {
 }
 
 std::string Address::string() const {
-    return checksumed(*this, ChecksumType::eip55);
+    // atomic, as string() may be called from several threads; recomputed if the bytes were changed since
+    auto cached = std::atomic_load(&cachedString);
+    if (!cached || cached->bytes != bytes) {
+        cached = std::make_shared<const CachedString>(CachedString{bytes, checksumed(*this, ChecksumType::eip55)});
+        std::atomic_store(&cachedString, cached);
+    }
+    return cached->string;
 }
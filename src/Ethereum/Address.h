@@ -10,6 +10,8 @@
 
 #include <array>
 #include <cstdint>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace TW::Ethereum {
@@ -38,8 +40,17 @@ class Address {
     /// Initializes an address with a public key.
     explicit Address(const PublicKey& publicKey);
 
-    /// Returns a string representation of the address.
+    /// Returns a string representation of the address, checksummed once and cached.
     std::string string() const;
+
+  private:
+    struct CachedString {
+        std::array<uint8_t, size> bytes;
+        std::string string;
+    };
+
+    /// String of the bytes it was computed from, shared by copies of the address.
+    mutable std::shared_ptr<const CachedString> cachedString;
 };
 
 inline bool operator==(const Address& lhs, const Address& rhs) {
@@ -6,29 +6,65 @@
 
 #include "AddressChecksum.h"
 
-#include "../Hash.h"
 #include "../HexCoding.h"
-#include <cctype>
+
+#include <TrezorCrypto/sha3.h>
+#include <TrezorCrypto/keccak_x4.h>
 
 using namespace TW;
 using namespace TW::Ethereum;
 
-std::string Ethereum::checksumed(const Address& address, enum ChecksumType type) {
-    const auto addressString = hex(address.bytes);
-    const auto hash = hex(Hash::keccak256(addressString));
-
-    std::string string = "0x";
-    for (auto i = 0; i < std::min(addressString.size(), hash.size()); i += 1) {
-        const auto a = addressString[i];
-        const auto h = hash[i];
-        if (a >= '0' && a <= '9') {
-            string.push_back(a);
-        } else if ((h >= '8' && h <= '9') || (h >= 'a' && h <= 'f')) {
-            string.push_back(static_cast<char>(toupper(a)));
-        } else {
-            string.push_back(static_cast<char>(tolower(a)));
+namespace {
+
+constexpr std::size_t hexSize = 2 * Address::size;
+
+/// Sets the case of the letters of the lowercase hex `string` from the nibbles of its hash, in place.
+void applyChecksum(char* string, const byte* hash, ChecksumType type) {
+    // letters are uppercase where their nibble of the hash is 8 or more, lowercase otherwise (EIP-55)
+    const bool upperOnHigh = type != ChecksumType::wanchain;
+    for (std::size_t i = 0; i < hexSize; ++i) {
+        const auto nibble = (i % 2 == 0) ? hash[i / 2] >> 4 : hash[i / 2] & 0x0f;
+        if (string[i] >= 'a' && (nibble >= 8) == upperOnHigh) {
+            string[i] -= 'a' - 'A';
         }
     }
+}
+
+} // namespace
+
+void Ethereum::checksumed(const Address& address, enum ChecksumType type, char* out) {
+    out[0] = '0';
+    out[1] = 'x';
+    hexEncode(address.bytes.data(), address.bytes.size(), out + 2);
+    byte hash[32];
+    keccak_256(reinterpret_cast<const byte*>(out + 2), hexSize, hash);
+    applyChecksum(out + 2, hash, type);
+}
 
+std::string Ethereum::checksumed(const Address& address, enum ChecksumType type) {
+    std::string string(checksumedSize, '\0');
+    checksumed(address, type, &string[0]);
     return string;
 }
+
+std::vector<std::string> Ethereum::checksumed(const std::vector<Address>& addresses, enum ChecksumType type) {
+    const auto count = addresses.size();
+    std::vector<char> strings(count * hexSize);
+    std::vector<const byte*> pointers(count);
+    std::vector<std::size_t> sizes(count, hexSize);
+    for (std::size_t i = 0; i < count; ++i) {
+        hexEncode(addresses[i].bytes.data(), Address::size, strings.data() + i * hexSize);
+        pointers[i] = reinterpret_cast<const byte*>(strings.data() + i * hexSize);
+    }
+    std::vector<byte> hashes(count * 32);
+    keccak_256_batch(pointers.data(), sizes.data(), count, hashes.data());
+
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& string = result.emplace_back("0x");
+        string.append(strings.data() + i * hexSize, hexSize);
+        applyChecksum(&string[2], hashes.data() + i * 32, type);
+    }
+    return result;
+}
@@ -7,16 +7,29 @@
 #pragma once
 
 #include "Address.h"
+
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace TW::Ethereum {
 
 /// Checksum types for Ethereum-based blockchains.
 enum ChecksumType {
     eip55 = 0,
+    /// EIP-55 with the case of the letters inverted.
     wanchain = 1,
 };
 
+/// Number of characters of a checksummed address, "0x" included.
+constexpr std::size_t checksumedSize = 2 + 2 * Address::size;
+
+/// Writes the checksummed address to `out`, checksumedSize characters without a terminator.
+void checksumed(const Address& address, enum ChecksumType type, char* out);
+
 std::string checksumed(const Address& address, enum ChecksumType type);
 
+/// Checksummed strings of many addresses, their hashes computed several at a time if the CPU supports it.
+std::vector<std::string> checksumed(const std::vector<Address>& addresses, enum ChecksumType type);
+
 } // namespace TW::Ethereum
@@ -0,0 +1,118 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BulkSigner.h"
+
+#include "Address.h"
+#include "RLP.h"
+#include "Signer.h"
+#include "Transaction.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Ethereum;
+
+BulkSigner::BulkSigner(const Proto::SigningInput& base, size_t threadCount, size_t capacity)
+    : key(Data(base.private_key().begin(), base.private_key().end()))
+    , chainID(load(base.chain_id()))
+    , gasPrice(load(base.gas_price()))
+    , gasLimit(load(base.gas_limit()))
+    , firstNonce(load(base.nonce()))
+    , slots(std::max<size_t>(capacity, 1)) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    threads.reserve(threadCount);
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([this]() { work(); });
+    }
+}
+
+BulkSigner::~BulkSigner() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    submittedCondition.notify_all();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+uint256_t BulkSigner::submit(const Call& call) {
+    // validated on the caller's thread, signing can't fail
+    const auto address = Address(call.toAddress);
+    if (call.value.size() > 32) {
+        throw std::invalid_argument("Value over 256 bits");
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    takenCondition.wait(lock, [this]() { return submitted - taken < slots.size(); });
+    const auto sequence = submitted++;
+    auto& slot = slots[sequence % slots.size()];
+    slot.to = Data(address.bytes.begin(), address.bytes.end());
+    slot.value = load(call.value);
+    slot.data = call.data;
+    slot.signed_ = false;
+    lock.unlock();
+    submittedCondition.notify_one();
+    return firstNonce + sequence;
+}
+
+Proto::SigningOutput BulkSigner::next() {
+    std::unique_lock<std::mutex> lock(mutex);
+    // a slot is signed only after its transaction is submitted
+    auto& slot = slots[taken % slots.size()];
+    signedCondition.wait(lock, [&slot]() { return slot.signed_; });
+    auto output = std::move(slot.output);
+    slot.signed_ = false;
+    ++taken;
+    lock.unlock();
+    takenCondition.notify_one();
+    return output;
+}
+
+void BulkSigner::work() {
+    const auto signer = Signer(chainID);
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        submittedCondition.wait(lock, [this]() { return stopping || claimed < submitted; });
+        if (stopping) {
+            return;
+        }
+        const auto sequence = claimed++;
+        auto& slot = slots[sequence % slots.size()];
+        // the slot can't be reused before it is taken, which needs it signed
+        auto transaction = Transaction(firstNonce + sequence, gasPrice, gasLimit, slot.to, slot.value, slot.data);
+        lock.unlock();
+
+        signer.sign(key, transaction);
+        auto output = Signer::output(transaction);
+
+        lock.lock();
+        slot.output = std::move(output);
+        slot.signed_ = true;
+        signedCondition.notify_all();
+    }
+}
+
+std::vector<Proto::SigningOutput> BulkSigner::signAll(const Proto::SigningInput& base, const std::vector<Call>& calls, size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+    auto bulkSigner = BulkSigner(base, std::min(threadCount, std::max<size_t>(calls.size(), 1)), calls.size());
+    for (const auto& call : calls) {
+        bulkSigner.submit(call);
+    }
+    std::vector<Proto::SigningOutput> outputs;
+    outputs.reserve(calls.size());
+    for (size_t i = 0; i < calls.size(); ++i) {
+        outputs.push_back(bulkSigner.next());
+    }
+    return outputs;
+}
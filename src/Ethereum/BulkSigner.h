@@ -0,0 +1,97 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+#include "../PrivateKey.h"
+#include "../proto/Ethereum.pb.h"
+#include "../uint256.h"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TW::Ethereum {
+
+/// Signer of many transactions from the same account, with consecutive nonces, on several threads.
+///
+/// Transactions are submitted one at a time and signed in the background; outputs are taken in
+/// nonce order.  At most `capacity` transactions are in flight (submitted but not yet taken):
+/// `submit` blocks beyond that, so a fast producer is held back by a slow consumer.
+/// `submit` and `next` may be called from different threads.
+class BulkSigner {
+  public:
+    /// A transaction to sign: recipient, amount in wei (uint256, big-endian) and optional payload.
+    struct Call {
+        std::string toAddress;
+        Data value;
+        Data data;
+    };
+
+    /// Prepares a signer from the chain ID, key, gas price, gas limit and first nonce of `base`.
+    /// threadCount 0 uses the available hardware concurrency.
+    ///
+    /// @throws std::invalid_argument if the private key is invalid.
+    explicit BulkSigner(const Proto::SigningInput& base, size_t threadCount = 0, size_t capacity = 1024);
+
+    /// Stops the threads, transactions not taken yet are dropped.
+    ~BulkSigner();
+
+    BulkSigner(const BulkSigner&) = delete;
+    BulkSigner& operator=(const BulkSigner&) = delete;
+
+    /// Queues a transaction with the next nonce, which is returned.  Blocks while `capacity` transactions are in flight.
+    ///
+    /// @throws std::invalid_argument if the address or the value is invalid, the nonce is then not used.
+    uint256_t submit(const Call& call);
+
+    /// Returns the output of the next transaction in nonce order, waiting for it to be submitted and signed.
+    Proto::SigningOutput next();
+
+    /// Signs all calls with consecutive nonces starting at the nonce of `base`, outputs in nonce order.
+    static std::vector<Proto::SigningOutput> signAll(const Proto::SigningInput& base, const std::vector<Call>& calls, size_t threadCount = 0);
+
+  private:
+    struct Slot {
+        Data to;
+        uint256_t value;
+        Data data;
+        Proto::SigningOutput output;
+        bool signed_ = false;
+    };
+
+    PrivateKey key;
+    uint256_t chainID;
+    uint256_t gasPrice;
+    uint256_t gasLimit;
+    uint256_t firstNonce;
+
+    /// Ring of `capacity` transactions, by sequence number modulo capacity.
+    std::vector<Slot> slots;
+    /// Sequence numbers of the next transaction to submit, to sign and to take.
+    uint64_t submitted = 0;
+    uint64_t claimed = 0;
+    uint64_t taken = 0;
+    bool stopping = false;
+
+    std::mutex mutex;
+    /// Notified when a transaction is submitted, or on stop.
+    std::condition_variable submittedCondition;
+    /// Notified when a transaction is signed.
+    std::condition_variable signedCondition;
+    /// Notified when a transaction is taken.
+    std::condition_variable takenCondition;
+
+    std::vector<std::thread> threads;
+
+    void work();
+};
+
+} // namespace TW::Ethereum
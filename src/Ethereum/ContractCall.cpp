@@ -7,8 +7,11 @@
 #include "ContractCall.h"
 #include "ABI.h"
 #include "HexCoding.h"
+#include "ThreadPool.h"
 #include "uint256.h"
 #include <boost/algorithm/string/predicate.hpp>
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 
 using namespace std;
@@ -45,59 +48,132 @@ static string getValue(Function& func, const string& type, int idx) {
     return ParamFactory::getValue(param, type);
 }
 
-static json buildInputs(Function& func, const json& registry) {
+static json buildInputs(Function& func, const CompiledAbi::Entry& entry) {
     auto inputs = json::array();
-    for (int i = 0; i < registry["inputs"].size(); i++) {
-        auto info = registry["inputs"][i];
-        auto type = info["type"];
+    for (int i = 0; i < static_cast<int>(entry.inputs.size()); i++) {
+        const auto& info = entry.inputs[i];
         auto input = json{
-            {"name", info["name"]},
-            {"type", type}
+            {"name", info.name},
+            {"type", info.type}
         };
-        if (boost::algorithm::ends_with(type.get<string>(), "[]")) {
-            input["value"] = json(getArrayValue(func, type, i));
-        } else if (type == "bool") {
-            input["value"] = getValue(func, type, i) == "true" ? json(true) : json(false);
+        if (!info.elementType.empty()) {
+            input["value"] = json(getArrayValue(func, info.type, i));
+        } else if (info.type == "bool") {
+            input["value"] = getValue(func, info.type, i) == "true" ? json(true) : json(false);
         } else {
-            input["value"] = getValue(func, type, i);
+            input["value"] = getValue(func, info.type, i);
         }
         inputs.push_back(input);
     }
     return inputs;
 }
 
-optional<string> decodeCall(const Data& call, const json& abi) {
-    // check bytes length
-    if (call.size() <= 4) {
-        return {};
-    }
+static uint32_t selectorOf(const byte* bytes) {
+    return (uint32_t(bytes[0]) << 24) | (uint32_t(bytes[1]) << 16) | (uint32_t(bytes[2]) << 8) | uint32_t(bytes[3]);
+}
 
-    auto methodId = hex(Data(call.begin(), call.begin() + 4));
+/// Whether an ABI key can be the hex selector of a call.
+static bool isSelectorKey(const string& key) {
+    return key.size() == 8 && all_of(key.begin(), key.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+}
 
-    if (abi.find(methodId) == abi.end()) {
-        return {};
+CompiledAbi::Entry CompiledAbi::compile(const json& entry) {
+    Entry compiled;
+    compiled.name = entry.at("name").get<string>();
+    auto func = Function(compiled.name);
+    for (const auto& info : entry.at("inputs")) {
+        auto input = Input{info.at("name"), info.at("type").get<string>(), {}};
+        if (boost::algorithm::ends_with(input.type, "[]")) {
+            input.elementType = string(input.type.begin(), input.type.end() - 2);
+        }
+        fill(func, input.type);
+        compiled.inputs.push_back(std::move(input));
     }
+    compiled.signature = func.getType();
+    compiled.selector = selectorOf(func.getSignature().data());
+    return compiled;
+}
 
-    // build Function with types
-    const auto registry = abi[methodId];
-    auto func = Function(registry["name"]);
-    for (auto& input : registry["inputs"]) {
-        fill(func, input["type"]);
+optional<string> CompiledAbi::decode(const Entry& entry, const Data& call) {
+    // the parameters are filled by the decoding, build them for each call
+    auto func = Function(entry.name);
+    for (const auto& input : entry.inputs) {
+        fill(func, input.type);
     }
 
-    // decode inputs
-    size_t offset = 0;
-    auto success = func.decodeInput(call, offset);
-    if (!success) {
+    // decode inputs, after the selector
+    size_t offset = 4;
+    if (!func._inParams.decode(call, offset)) {
         return {};
     }
 
     // build output json
     auto decoded = json{
-        {"function", func.getType()},
-        {"inputs", buildInputs(func, registry)},
+        {"function", entry.signature},
+        {"inputs", buildInputs(func, entry)},
     };
     return decoded.dump();
 }
 
+CompiledAbi::CompiledAbi(const json& abi) {
+    if (!abi.is_object()) {
+        return;
+    }
+    for (const auto& item : abi.items()) {
+        if (!isSelectorKey(item.key())) {
+            continue;
+        }
+        auto entry = compile(item.value());
+        if (entry.selector != selectorOf(parse_hex(item.key()).data())) {
+            continue;
+        }
+        entries.emplace(entry.selector, std::move(entry));
+    }
+}
+
+optional<string> CompiledAbi::decodeCall(const Data& call) const {
+    if (call.size() <= 4) {
+        return {};
+    }
+    const auto entry = entries.find(selectorOf(call.data()));
+    if (entry == entries.end()) {
+        return {};
+    }
+    return decode(entry->second, call);
+}
+
+vector<optional<string>> CompiledAbi::decodeCalls(const vector<Data>& calls, size_t threadCount) const {
+    const auto count = calls.size();
+    vector<optional<string>> results(count);
+    atomic<size_t> next(0);
+    const auto worker = [&]() {
+        for (auto index = next++; index < count; index = next++) {
+            results[index] = decodeCall(calls[index]);
+        }
+    };
+    ThreadPool::shared().run(threadCount, count, worker);
+    return results;
+}
+
+optional<string> decodeCall(const Data& call, const json& abi) {
+    // check bytes length
+    if (call.size() <= 4) {
+        return {};
+    }
+
+    auto methodId = hex(Data(call.begin(), call.begin() + 4));
+
+    const auto registry = abi.find(methodId);
+    if (registry == abi.end()) {
+        return {};
+    }
+
+    // the key must be the selector of the signature
+    const auto entry = CompiledAbi::compile(*registry);
+    if (entry.selector != selectorOf(call.data())) {
+        return {};
+    }
+    return CompiledAbi::decode(entry, call);
+}
+
 } // namespace TW::Ethereum::ABI
@@ -8,9 +8,63 @@
 
 #include "Data.h"
 #include <nlohmann/json.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace TW::Ethereum::ABI {
+    /// Decodes a contract call with a JSON ABI keyed by the hex selectors, into a JSON string of the function and
+    /// its inputs; none if the ABI has no matching function or the arguments are not a valid encoding.
     std::optional<std::string> decodeCall(const Data& call, const nlohmann::json& abi);
+
+    /// JSON ABI compiled once for decoding many contract calls, as decodeCall.
+    ///
+    /// The entries are indexed by their 4-byte selector; their parameter types and signatures are parsed, and the
+    /// selectors checked against the signatures, when compiling, so decoding a call only reads its arguments.
+    /// Entries whose key is not the selector of their signature are left out, as decodeCall never matches them.
+    /// Thread-safe, a compiled ABI is immutable.
+    class CompiledAbi {
+      public:
+        struct Input {
+            nlohmann::json name;
+            std::string type;
+            /// Element type of arrays, empty for other types.
+            std::string elementType;
+        };
+
+        struct Entry {
+            std::string name;
+            /// Signature, such as "approve(address,uint256)".
+            std::string signature;
+            uint32_t selector;
+            std::vector<Input> inputs;
+        };
+
+        /// Compiles an ABI keyed by the hex selectors, as taken by decodeCall.
+        ///
+        /// @throws nlohmann::json::exception if an entry has no name or inputs.
+        explicit CompiledAbi(const nlohmann::json& abi);
+
+        std::size_t size() const { return entries.size(); }
+
+        /// Decodes a call, with the same result as decodeCall.
+        std::optional<std::string> decodeCall(const Data& call) const;
+
+        /// Decodes many calls on several threads (threadCount 0 uses the available hardware concurrency).
+        std::vector<std::optional<std::string>> decodeCalls(const std::vector<Data>& calls, std::size_t threadCount = 0) const;
+
+        /// Compiles one ABI entry.
+        ///
+        /// @throws nlohmann::json::exception if the entry has no name or inputs.
+        static Entry compile(const nlohmann::json& entry);
+
+        /// Decodes the arguments of a call to the entry, after its selector.
+        static std::optional<std::string> decode(const Entry& entry, const Data& call);
+
+      private:
+        std::unordered_map<uint32_t, Entry> entries;
+    };
 } // namespace TW::Ethereum::ABI
@@ -8,6 +8,7 @@
 
 #include "Address.h"
 #include "Signer.h"
+#include "SigningTemplate.h"
 
 using namespace TW::Ethereum;
 using namespace std;
@@ -21,14 +22,41 @@ string Entry::normalizeAddress(TWCoinType coin, const string& address) const {
     return Address(address).string();
 }
 
+bool Entry::parseAddress(TWCoinType coin, const string& address, TW::byte, TW::byte, const char*, ParsedAddress& parsed) const {
+    try {
+        const Address decoded(address);
+        parsed.normalized = decoded.string();
+        parsed.data = Data(decoded.bytes.begin(), decoded.bytes.end());
+        parsed.hasData = true;
+        return true;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
 string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte, const char*) const {
     return Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
-    signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
+    Signer::sign(dataIn, dataOut);
+}
+
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
 }
 
 string Entry::signJSON(TWCoinType coin, const std::string& json, const Data& key) const { 
     return Signer::signJSON(json, key);
 }
+
+std::unique_ptr<TW::SigningTemplate> Entry::signingTemplate(TWCoinType coin, const TW::Data& dataIn) const {
+    auto input = Proto::SigningInput();
+    if (!input.ParseFromArray(dataIn.data(), static_cast<int>(dataIn.size()))) {
+        return nullptr;
+    }
+    if (!input.transaction().has_transfer() && !input.transaction().has_erc20_transfer()) {
+        return nullptr;
+    }
+    return std::make_unique<SigningTemplate>(input);
+}
@@ -0,0 +1,177 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "LogFilter.h"
+
+#include "../Hash.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#define TW_BLOOM_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define TW_BLOOM_NEON 1
+#include <arm_neon.h>
+#endif
+
+using namespace TW;
+using namespace TW::Ethereum;
+
+namespace {
+
+const ABI::CompiledEvent& transferEvent() {
+    static const auto event = ABI::CompiledEvent("Transfer(address indexed from, address indexed to, uint256 value)");
+    return event;
+}
+
+/// Log topic of an address, left padded to 32 bytes.
+std::array<byte, 32> addressTopic(const Address& address) {
+    std::array<byte, 32> topic = {};
+    std::copy(address.bytes.begin(), address.bytes.end(), topic.begin() + 12);
+    return topic;
+}
+
+bool contains(const std::vector<std::array<byte, Address::size>>& sorted, const byte* key) {
+    const auto it = std::lower_bound(sorted.begin(), sorted.end(), key, [](const auto& element, const byte* value) {
+        return std::memcmp(element.data(), value, Address::size) < 0;
+    });
+    return it != sorted.end() && std::memcmp(it->data(), key, Address::size) == 0;
+}
+
+/// Whether all the bits of `mask` are set in `bloom`, and one of `any` at least.
+bool covers(const LogsBloom& bloom, const LogsBloom& mask, const LogsBloom& any) {
+#if TW_BLOOM_SSE2
+    auto missing = _mm_setzero_si128();
+    auto common = _mm_setzero_si128();
+    for (std::size_t i = 0; i < bloom.size(); i += 16) {
+        const auto bits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bloom.data() + i));
+        missing = _mm_or_si128(missing, _mm_andnot_si128(bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(mask.data() + i))));
+        common = _mm_or_si128(common, _mm_and_si128(bits, _mm_loadu_si128(reinterpret_cast<const __m128i*>(any.data() + i))));
+    }
+    const auto zero = _mm_setzero_si128();
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(missing, zero)) == 0xffff && _mm_movemask_epi8(_mm_cmpeq_epi8(common, zero)) != 0xffff;
+#elif TW_BLOOM_NEON
+    auto missing = vdupq_n_u8(0);
+    auto common = vdupq_n_u8(0);
+    for (std::size_t i = 0; i < bloom.size(); i += 16) {
+        const auto bits = vld1q_u8(bloom.data() + i);
+        missing = vorrq_u8(missing, vbicq_u8(vld1q_u8(mask.data() + i), bits));
+        common = vorrq_u8(common, vandq_u8(bits, vld1q_u8(any.data() + i)));
+    }
+    return vmaxvq_u8(missing) == 0 && vmaxvq_u8(common) != 0;
+#else
+    byte missing = 0;
+    byte common = 0;
+    for (std::size_t i = 0; i < bloom.size(); ++i) {
+        missing |= mask[i] & ~bloom[i];
+        common |= bloom[i] & any[i];
+    }
+    return missing == 0 && common != 0;
+#endif
+}
+
+} // namespace
+
+BloomBits BloomBits::of(DataView value) {
+    const auto hash = Hash::keccak256Digest(value);
+    BloomBits bits;
+    for (std::size_t i = 0; i < bits.indices.size(); ++i) {
+        // the lower 11 bits of each of the first 3 pairs of bytes, numbered from the last byte of the bloom
+        const auto bit = ((hash[2 * i] << 8) | hash[2 * i + 1]) & 0x7ff;
+        bits.indices[i] = static_cast<uint8_t>(255 - bit / 8);
+        bits.masks[i] = static_cast<byte>(1 << (bit % 8));
+    }
+    return bits;
+}
+
+LogsBloom Ethereum::logsBloom(const std::vector<ABI::Log>& logs) {
+    LogsBloom bloom = {};
+    for (const auto& log : logs) {
+        if (!log.address.empty()) {
+            BloomBits::of(log.address).addTo(bloom);
+        }
+        for (const auto& topic : log.topics) {
+            BloomBits::of(topic).addTo(bloom);
+        }
+    }
+    return bloom;
+}
+
+TransferFilter::TransferFilter(const std::vector<Address>& wallets, const std::vector<Address>& tokens) {
+    BloomBits::of(transferEvent().topic()).addTo(required);
+    for (const auto& wallet : wallets) {
+        walletBits.push_back(BloomBits::of(addressTopic(wallet)));
+        walletBits.back().addTo(walletUnion);
+        walletAddresses.push_back(wallet.bytes);
+    }
+    for (const auto& token : tokens) {
+        tokenBits.push_back(BloomBits::of(DataView(token.bytes)));
+        tokenAddresses.push_back(token.bytes);
+    }
+    if (tokenBits.size() == 1) {
+        tokenBits.front().addTo(required);
+    }
+    std::sort(walletAddresses.begin(), walletAddresses.end());
+    walletAddresses.erase(std::unique(walletAddresses.begin(), walletAddresses.end()), walletAddresses.end());
+    std::sort(tokenAddresses.begin(), tokenAddresses.end());
+    tokenAddresses.erase(std::unique(tokenAddresses.begin(), tokenAddresses.end()), tokenAddresses.end());
+}
+
+bool TransferFilter::mayContain(const LogsBloom& bloom) const {
+    // most blooms are rejected by this single pass, before the bits of each wallet and token are tested
+    if (!covers(bloom, required, walletUnion)) {
+        return false;
+    }
+    if (tokenBits.size() > 1 && std::none_of(tokenBits.begin(), tokenBits.end(), [&bloom](const auto& bits) { return bits.in(bloom); })) {
+        return false;
+    }
+    return std::any_of(walletBits.begin(), walletBits.end(), [&bloom](const auto& bits) { return bits.in(bloom); });
+}
+
+bool TransferFilter::mayContain(DataView bloom) const {
+    LogsBloom copy;
+    if (bloom.size() != copy.size()) {
+        throw std::invalid_argument("Logs bloom must be 256 bytes");
+    }
+    std::copy(bloom.begin(), bloom.end(), copy.begin());
+    return mayContain(copy);
+}
+
+std::vector<Transfer> TransferFilter::transfers(const std::vector<ABI::Log>& logs) const {
+    static const std::array<byte, 12> padding = {};
+    const auto& event = transferEvent();
+    const auto& topic = event.topic();
+    std::vector<Transfer> result;
+    for (std::size_t i = 0; i < logs.size(); ++i) {
+        const auto& log = logs[i];
+        // cheap checks first, only transfers to a wallet are decoded
+        if (log.topics.size() != 3 || log.topics[0].size() != topic.size() || !std::equal(topic.begin(), topic.end(), log.topics[0].begin())) {
+            continue;
+        }
+        if (log.address.size() != Address::size || (!tokenAddresses.empty() && !contains(tokenAddresses, log.address.data()))) {
+            continue;
+        }
+        const auto& to = log.topics[2];
+        if (to.size() != 32 || std::memcmp(to.data(), padding.data(), padding.size()) != 0 || !contains(walletAddresses, to.data() + 12)) {
+            continue;
+        }
+        DataView fromView;
+        DataView toView;
+        uint256_t value;
+        try {
+            if (!event.decodeInto(log.topics, log.data, fromView, toView, value)) {
+                continue;
+            }
+        } catch (const std::invalid_argument&) {
+            continue;
+        }
+        result.push_back(Transfer{i, Address(log.address), Address(fromView.toData()), Address(toView.toData()), value});
+    }
+    return result;
+}
@@ -0,0 +1,95 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "ABI/CompiledEvent.h"
+#include "Address.h"
+
+#include "../Data.h"
+#include "../uint256.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace TW::Ethereum {
+
+/// 2048-bit bloom of the addresses and topics of logs, of a receipt or of a block header.
+using LogsBloom = std::array<byte, 256>;
+
+/// Bits set in a logs bloom by a value: 3 of the 2048 bits, selected by its keccak256 hash.
+struct BloomBits {
+    std::array<uint8_t, 3> indices;
+    std::array<byte, 3> masks;
+
+    static BloomBits of(DataView value);
+
+    bool in(const LogsBloom& bloom) const {
+        return (bloom[indices[0]] & masks[0]) != 0 && (bloom[indices[1]] & masks[1]) != 0 && (bloom[indices[2]] & masks[2]) != 0;
+    }
+
+    void addTo(LogsBloom& bloom) const {
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            bloom[indices[i]] |= masks[i];
+        }
+    }
+};
+
+/// Bloom of the addresses and topics of logs, as in their receipt.
+LogsBloom logsBloom(const std::vector<ABI::Log>& logs);
+
+/// A decoded ERC-20 Transfer log.
+struct Transfer {
+    /// Index of the log in the list given to TransferFilter::transfers.
+    std::size_t logIndex;
+    Address token;
+    Address from;
+    Address to;
+    uint256_t value;
+};
+
+/// Finds the ERC-20 transfers to a set of wallets, for any Ethereum-family chain.
+///
+/// The bloom bits of the Transfer topic, of the wallets and of the tokens are computed once, so that
+/// block and receipt blooms can be tested without hashing, and only logs of matching receipts decoded.
+/// Thread-safe, a filter is immutable.
+class TransferFilter {
+  public:
+    /// Transfers to any of `wallets`, of any token or only of `tokens` when not empty.
+    explicit TransferFilter(const std::vector<Address>& wallets, const std::vector<Address>& tokens = {});
+
+    /// Whether a block or receipt with this bloom may contain a transfer to a wallet; false positives are possible.
+    bool mayContain(const LogsBloom& bloom) const;
+
+    /// Same, for a bloom as returned by RPC once decoded.
+    ///
+    /// @throws std::invalid_argument if the bloom is not 256 bytes.
+    bool mayContain(DataView bloom) const;
+
+    /// Transfers to the wallets in logs, with the address of their token contract.
+    /// Logs of other events, including ERC-721 transfers, and invalid encodings are skipped.
+    std::vector<Transfer> transfers(const std::vector<ABI::Log>& logs) const;
+
+    std::size_t walletCount() const { return walletAddresses.size(); }
+    std::size_t tokenCount() const { return tokenAddresses.size(); }
+
+  private:
+    using Key = std::array<byte, Address::size>;
+
+    /// Bits which are all set in a bloom with a transfer of the filter.
+    LogsBloom required = {};
+    /// Union of the bits of the wallets, at least one of them is set in a bloom with a transfer.
+    LogsBloom walletUnion = {};
+    std::vector<BloomBits> walletBits;
+    std::vector<BloomBits> tokenBits;
+
+    /// Sorted, for binary search.
+    std::vector<Key> walletAddresses;
+    std::vector<Key> tokenAddresses;
+};
+
+} // namespace TW::Ethereum
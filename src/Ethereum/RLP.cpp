@@ -15,17 +15,21 @@
 using namespace TW;
 using namespace TW::Ethereum;
 
-Data RLP::encode(const uint256_t& value) noexcept {
-    using boost::multiprecision::cpp_int;
-
-    Data bytes;
-    export_bits(value, std::back_inserter(bytes), 8);
-
-    if (bytes.empty() || (bytes.size() == 1 && bytes[0] == 0)) {
+Data RLP::encode(const UInt256& value) noexcept {
+    if (value.isZero()) {
         return {0x80};
     }
+    if (value < 0x80) {
+        // Fits in single byte, no header
+        return {static_cast<byte>(value.limbs[0])};
+    }
 
-    return encode(bytes);
+    byte bytes[32];
+    value.store(bytes);
+    const auto length = value.byteLength();
+    auto encoded = Data{static_cast<byte>(0x80 + length)};
+    encoded.insert(encoded.end(), bytes + sizeof(bytes) - length, bytes + sizeof(bytes));
+    return encoded;
 }
 
 Data RLP::encodeList(const Data& encoded) noexcept {
@@ -36,17 +40,19 @@ Data RLP::encodeList(const Data& encoded) noexcept {
 }
 
 Data RLP::encode(const Transaction& transaction) noexcept {
-    auto encoded = Data();
-    append(encoded, encode(transaction.nonce));
-    append(encoded, encode(transaction.gasPrice));
-    append(encoded, encode(transaction.gasLimit));
-    append(encoded, encode(transaction.to));
-    append(encoded, encode(transaction.amount));
-    append(encoded, encode(transaction.payload));
-    append(encoded, encode(transaction.v));
-    append(encoded, encode(transaction.r));
-    append(encoded, encode(transaction.s));
-    return encodeList(encoded);
+    return rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(transaction.nonce)
+                .item(transaction.gasPrice)
+                .item(transaction.gasLimit)
+                .item(transaction.to)
+                .item(transaction.amount)
+                .item(transaction.payload)
+                .item(transaction.v)
+                .item(transaction.r)
+                .item(transaction.s);
+        });
+    });
 }
 
 Data RLP::encode(const Data& data) noexcept {
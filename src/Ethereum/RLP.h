@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "RLPWriter.h"
 #include "Transaction.h"
 #include "../Data.h"
 #include "../uint256.h"
@@ -25,9 +26,9 @@ struct RLP {
         return encode(Data(string.begin(), string.end()));
     }
 
-    static Data encode(uint8_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint8_t number) noexcept { return encode(UInt256(number)); }
 
-    static Data encode(uint16_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint16_t number) noexcept { return encode(UInt256(number)); }
 
     static Data encode(int32_t number) noexcept {
         if (number < 0) {
@@ -36,7 +37,7 @@ struct RLP {
         return encode(static_cast<uint32_t>(number));
     }
 
-    static Data encode(uint32_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint32_t number) noexcept { return encode(UInt256(number)); }
 
     static Data encode(int64_t number) noexcept {
         if (number < 0) {
@@ -45,9 +46,11 @@ struct RLP {
         return encode(static_cast<uint64_t>(number));
     }
 
-    static Data encode(uint64_t number) noexcept { return encode(uint256_t(number)); }
+    static Data encode(uint64_t number) noexcept { return encode(UInt256(number)); }
 
-    static Data encode(const uint256_t& number) noexcept;
+    static Data encode(const uint256_t& number) noexcept { return encode(UInt256(number)); }
+
+    static Data encode(const UInt256& number) noexcept;
 
     /// Encodes a transaction.
     static Data encode(const Transaction& transaction) noexcept;
@@ -73,19 +76,8 @@ struct RLP {
 
     /// Encodes a list of elements.
     template <typename T>
-    static Data encodeList(T elements) noexcept {
-        auto encodedData = Data();
-        for (const auto& el : elements) {
-            auto encoded = encode(el);
-            if (encoded.empty()) {
-                return {};
-            }
-            encodedData.insert(encodedData.end(), encoded.begin(), encoded.end());
-        }
-
-        auto encoded = encodeHeader(encodedData.size(), 0xc0, 0xf7);
-        encoded.insert(encoded.end(), encodedData.begin(), encodedData.end());
-        return encoded;
+    static Data encodeList(const T& elements) noexcept {
+        return rlpEncode([&](auto& rlp) { rlp.itemList(elements); });
     }
 
     /// Encodes a list header.
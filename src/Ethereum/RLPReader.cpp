@@ -0,0 +1,140 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "RLPReader.h"
+
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Ethereum;
+
+RLPItem RLPReader::parse(DataView source) {
+    auto reader = RLPReader(source);
+    const auto item = reader.next();
+    if (!reader.empty()) {
+        throw std::invalid_argument("Trailing bytes after rlp item");
+    }
+    item.validate();
+    return item;
+}
+
+RLPItem RLPReader::next() {
+    if (empty()) {
+        throw std::invalid_argument("No rlp item left");
+    }
+    const auto available = end - position;
+    const auto prefix = source[position];
+    if (prefix <= 0x7f) {
+        // a single byte is its own encoding
+        position += 1;
+        return RLPItem(source, position - 1, 0, 1, false);
+    }
+
+    const bool list = prefix >= 0xc0;
+    const auto shortPrefix = list ? 0xc0 : 0x80;
+    const auto longPrefix = list ? 0xf7 : 0xb7;
+    std::size_t headerSize = 1;
+    std::size_t payloadSize = 0;
+    if (prefix <= longPrefix) {
+        payloadSize = prefix - shortPrefix;
+    } else {
+        const std::size_t lengthSize = prefix - longPrefix;
+        if (lengthSize > sizeof(std::size_t) || available < 1 + lengthSize) {
+            throw std::invalid_argument("Invalid rlp length");
+        }
+        if (source[position + 1] == 0) {
+            throw std::invalid_argument("multi-byte length must have no leading zero");
+        }
+        for (std::size_t i = 0; i < lengthSize; ++i) {
+            payloadSize = (payloadSize << 8) | source[position + 1 + i];
+        }
+        if (payloadSize < 56) {
+            throw std::invalid_argument("length below 56 must be encoded in one byte");
+        }
+        headerSize += lengthSize;
+    }
+    if (payloadSize > available - headerSize) {
+        throw std::invalid_argument("Invalid rlp encoding length");
+    }
+    if (!list && payloadSize == 1 && source[position + 1] <= 0x7f) {
+        throw std::invalid_argument("single byte below 128 must be encoded as itself");
+    }
+
+    const auto start = position;
+    position += headerSize + payloadSize;
+    return RLPItem(source, start, headerSize, payloadSize, list);
+}
+
+void RLPReader::skip(std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i) {
+        next();
+    }
+}
+
+RLPReader RLPItem::items() const {
+    if (!list) {
+        throw std::invalid_argument("rlp item is not a list");
+    }
+    return RLPReader(source, start + headerSize, start + headerSize + payloadSize);
+}
+
+std::size_t RLPItem::count() const {
+    auto reader = items();
+    std::size_t result = 0;
+    for (; !reader.empty(); ++result) {
+        reader.next();
+    }
+    return result;
+}
+
+RLPItem RLPItem::operator[](std::size_t index) const {
+    auto reader = items();
+    for (std::size_t i = 0; i < index; ++i) {
+        if (reader.empty()) {
+            throw std::out_of_range("rlp list index out of range");
+        }
+        reader.next();
+    }
+    if (reader.empty()) {
+        throw std::out_of_range("rlp list index out of range");
+    }
+    return reader.next();
+}
+
+void RLPItem::validate() const {
+    if (!list) {
+        return;
+    }
+    for (auto reader = items(); !reader.empty();) {
+        reader.next().validate();
+    }
+}
+
+UInt256 RLPItem::toUInt256() const {
+    if (list) {
+        throw std::invalid_argument("rlp item is not a string");
+    }
+    const auto bytes = payload();
+    if (bytes.size() > 32) {
+        throw std::invalid_argument("rlp number is too large");
+    }
+    if (!bytes.empty() && bytes[0] == 0) {
+        throw std::invalid_argument("rlp number must have no leading zero");
+    }
+    return UInt256::load(bytes);
+}
+
+Data RLPItem::toData() const {
+    if (list) {
+        throw std::invalid_argument("rlp item is not a string");
+    }
+    return payload().toData();
+}
+
+std::string RLPItem::toString() const {
+    const auto bytes = toData();
+    return std::string(bytes.begin(), bytes.end());
+}
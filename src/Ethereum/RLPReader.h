@@ -0,0 +1,130 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+#include "../uint256.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace TW::Ethereum {
+
+class RLPReader;
+
+/// View of an RLP item inside a source buffer, nothing is copied.
+///
+/// The item is located by its offset and length in the buffer given to the reader,
+/// which must outlive the item.
+class RLPItem {
+  public:
+    /// Whether the item is a list, otherwise it is a string.
+    bool isList() const noexcept { return list; }
+
+    /// Offset of the item (header included) in the source buffer.
+    std::size_t offset() const noexcept { return start; }
+
+    /// Encoded length of the item, header included.
+    std::size_t length() const noexcept { return headerSize + payloadSize; }
+
+    /// Bytes of a string, or encoded items of a list.
+    DataView payload() const noexcept { return source.subView(start + headerSize, payloadSize); }
+
+    /// Whole encoding of the item, header included.
+    DataView encoded() const noexcept { return source.subView(start, length()); }
+
+    /// Reader over the items of a list.
+    ///
+    /// @throws std::invalid_argument if the item is not a list.
+    RLPReader items() const;
+
+    /// Number of items of a list, parses the headers of the items.
+    ///
+    /// @throws std::invalid_argument if the item is not a list or an item header is invalid.
+    std::size_t count() const;
+
+    /// Item of a list at `index`, skips the preceding items by their headers.
+    ///
+    /// @throws std::invalid_argument if the item is not a list or an item header is invalid.
+    /// @throws std::out_of_range if there are not enough items.
+    RLPItem operator[](std::size_t index) const;
+
+    /// Checks the items of a list (recursively), the header of this item was checked when it was read.
+    ///
+    /// @throws std::invalid_argument if a nested item is invalid.
+    void validate() const;
+
+    /// Value of a string as a canonical big-endian number (no leading zeros).
+    ///
+    /// @throws std::invalid_argument if the item is a list, is longer than 32 bytes or has leading zeros.
+    UInt256 toUInt256() const;
+
+    /// Copy of the bytes of a string.
+    ///
+    /// @throws std::invalid_argument if the item is a list.
+    Data toData() const;
+
+    /// Copy of the bytes of a string.
+    ///
+    /// @throws std::invalid_argument if the item is a list.
+    std::string toString() const;
+
+  private:
+    friend class RLPReader;
+
+    RLPItem(DataView source, std::size_t start, std::size_t headerSize, std::size_t payloadSize, bool list) noexcept
+        : source(source), start(start), headerSize(headerSize), payloadSize(payloadSize), list(list) {}
+
+    DataView source;
+    std::size_t start;
+    std::size_t headerSize;
+    std::size_t payloadSize;
+    bool list;
+};
+
+/// Lazy RLP reader, yields the consecutive items of a buffer one at a time.
+///
+/// Only item headers are parsed while reading; nested lists are read on demand.
+class RLPReader {
+  public:
+    /// Reads the items of `source`, the buffer must outlive the reader and the items.
+    explicit RLPReader(DataView source) noexcept : RLPReader(source, 0, source.size()) {}
+
+    /// Parses a buffer holding exactly one RLP item, and validates all nested items.
+    ///
+    /// @throws std::invalid_argument if the encoding is invalid.
+    static RLPItem parse(DataView source);
+
+    /// Whether all items have been read.
+    bool empty() const noexcept { return position == end; }
+
+    /// Offset of the next item in the source buffer.
+    std::size_t offset() const noexcept { return position; }
+
+    /// Reads the next item.
+    ///
+    /// @throws std::invalid_argument if there is no item left or the item header is invalid.
+    RLPItem next();
+
+    /// Skips the next `count` items.
+    ///
+    /// @throws std::invalid_argument if there are not enough items or an item header is invalid.
+    void skip(std::size_t count);
+
+  private:
+    friend class RLPItem;
+
+    RLPReader(DataView source, std::size_t begin, std::size_t end) noexcept
+        : source(source), position(begin), end(end) {}
+
+    DataView source;
+    std::size_t position;
+    std::size_t end;
+};
+
+} // namespace TW::Ethereum
@@ -0,0 +1,283 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+#include "../uint256.h"
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace TW::Ethereum {
+
+// Two-pass RLP encoding: the items are described once by a function called with an
+// RLP sink, first an RLPSizer to compute the exact encoded size, then an RLPWriter that
+// writes everything in one go, into a preallocated buffer or directly into a hasher.
+//
+//     rlpEncode([&](auto& rlp) {
+//         rlp.list([&](auto& list) {
+//             list.item(nonce).item(to).list([&](auto& inner) { inner.items(values); });
+//         });
+//     });
+
+/// Item helpers shared by RLPSizer and RLPWriter, which provide string(), number(), list(), encodedString(),
+/// encoded() and invalid().
+template <typename Derived>
+class RLPItems {
+  public:
+    Derived& item(const Data& data) { return self().string(data); }
+    Derived& item(const std::string& string) {
+        return self().string(DataView(reinterpret_cast<const byte*>(string.data()), string.size()));
+    }
+    template <std::size_t N>
+    Derived& item(const std::array<uint8_t, N>& data) { return self().string(data); }
+    Derived& item(const uint256_t& number) { return self().number(UInt256(number)); }
+    Derived& item(const UInt256& number) { return self().number(number); }
+    Derived& item(uint8_t number) { return self().number(UInt256(number)); }
+    Derived& item(uint16_t number) { return self().number(UInt256(number)); }
+    Derived& item(uint32_t number) { return self().number(UInt256(number)); }
+    Derived& item(uint64_t number) { return self().number(UInt256(number)); }
+    Derived& item(int32_t number) {
+        // RLP cannot encode negative numbers
+        return number < 0 ? self().invalid() : self().number(UInt256(static_cast<uint32_t>(number)));
+    }
+    Derived& item(int64_t number) {
+        return number < 0 ? self().invalid() : self().number(UInt256(static_cast<uint64_t>(number)));
+    }
+
+    /// Appends every element of a collection.
+    template <typename T>
+    Derived& items(const T& elements) {
+        for (const auto& element : elements) {
+            item(element);
+        }
+        return self();
+    }
+
+    /// Appends the elements of a collection as a list.
+    template <typename T>
+    Derived& itemList(const T& elements) {
+        return self().list([&](auto& list) { list.items(elements); });
+    }
+
+    /// Size of the header of a string or list with the given payload size.
+    static std::size_t headerSize(uint64_t size) noexcept {
+        std::size_t length = 1;
+        if (size >= 56) {
+            for (; size != 0; size >>= 8) {
+                ++length;
+            }
+        }
+        return length;
+    }
+
+  private:
+    Derived& self() { return static_cast<Derived&>(*this); }
+};
+
+/// First pass of the RLP encoding, sums the encoded size of the items.
+class RLPSizer : public RLPItems<RLPSizer> {
+  public:
+    using RLPItems<RLPSizer>::item;
+
+    /// Encoded size of the items so far.
+    std::size_t size = 0;
+
+    /// False if an item cannot be encoded.
+    bool valid = true;
+
+    RLPSizer& string(DataView data) {
+        size += (data.size() == 1 && data[0] <= 0x7f) ? 1 : headerSize(data.size()) + data.size();
+        return *this;
+    }
+
+    RLPSizer& number(const UInt256& number) {
+        size += number < 0x80 ? 1 : 1 + number.byteLength();
+        return *this;
+    }
+
+    template <typename F>
+    RLPSizer& list(F&& items) {
+        RLPSizer inner;
+        items(inner);
+        valid = valid && inner.valid;
+        size += headerSize(inner.size) + inner.size;
+        return *this;
+    }
+
+    template <typename F>
+    RLPSizer& encodedString(F&& items) {
+        RLPSizer inner;
+        items(inner);
+        valid = valid && inner.valid;
+        if (inner.size == 1) {
+            // may need no header, as a single byte string
+            return string(singleByte(items));
+        }
+        size += headerSize(inner.size) + inner.size;
+        return *this;
+    }
+
+    /// Items that are already RLP encoded, e.g. invariant fields encoded once.
+    RLPSizer& encoded(DataView items) {
+        size += items.size();
+        return *this;
+    }
+
+    RLPSizer& invalid() {
+        valid = false;
+        return *this;
+    }
+
+  private:
+    template <typename F>
+    static Data singleByte(F&& items);
+};
+
+/// Sink appending to a buffer, reserve the size computed by RLPSizer beforehand.
+struct RLPDataSink {
+    Data& data;
+
+    void update(DataView bytes) { data.insert(data.end(), bytes.begin(), bytes.end()); }
+};
+
+/// Second pass of the RLP encoding, writes the items to a sink providing `update(DataView)`,
+/// such as RLPDataSink or Hash::Keccak256Hasher.  Lists are sized with an RLPSizer before being written.
+template <typename Sink>
+class RLPWriter : public RLPItems<RLPWriter<Sink>> {
+  public:
+    using RLPItems<RLPWriter<Sink>>::item;
+
+    explicit RLPWriter(Sink& sink) : sink(sink) {}
+
+    RLPWriter& string(DataView data) {
+        if (data.size() == 1 && data[0] <= 0x7f) {
+            // Fits in single byte, no header
+            sink.update(data);
+            return *this;
+        }
+        header(data.size(), 0x80, 0xb7);
+        sink.update(data);
+        return *this;
+    }
+
+    RLPWriter& number(const UInt256& number) {
+        if (number.isZero()) {
+            const byte empty = 0x80;
+            sink.update(DataView(&empty, 1));
+            return *this;
+        }
+        byte bytes[33];
+        number.store(bytes + 1);
+        if (number < 0x80) {
+            sink.update(DataView(bytes + 32, 1));
+            return *this;
+        }
+        const auto length = number.byteLength();
+        bytes[32 - length] = static_cast<byte>(0x80 + length);
+        sink.update(DataView(bytes + 32 - length, length + 1));
+        return *this;
+    }
+
+    template <typename F>
+    RLPWriter& list(F&& items) {
+        RLPSizer inner;
+        items(inner);
+        header(inner.size, 0xc0, 0xf7);
+        items(*this);
+        return *this;
+    }
+
+    /// Items encoded as a string, for formats embedding an RLP encoding in a byte string.
+    template <typename F>
+    RLPWriter& encodedString(F&& items) {
+        RLPSizer inner;
+        items(inner);
+        if (inner.size == 1) {
+            // may need no header, as a single byte string
+            Data data;
+            RLPDataSink dataSink{data};
+            RLPWriter<RLPDataSink> writer(dataSink);
+            items(writer);
+            return string(data);
+        }
+        header(inner.size, 0x80, 0xb7);
+        items(*this);
+        return *this;
+    }
+
+    /// Items that are already RLP encoded, e.g. invariant fields encoded once.
+    RLPWriter& encoded(DataView items) {
+        sink.update(items);
+        return *this;
+    }
+
+    /// Invalid items are skipped, check RLPSizer::valid first.
+    RLPWriter& invalid() { return *this; }
+
+    /// Writes a string or list header.
+    void header(uint64_t size, uint8_t smallTag, uint8_t largeTag) {
+        byte bytes[9];
+        if (size < 56) {
+            bytes[0] = static_cast<byte>(smallTag + size);
+            sink.update(DataView(bytes, 1));
+            return;
+        }
+        const auto length = RLPSizer::headerSize(size) - 1;
+        bytes[0] = static_cast<byte>(largeTag + length);
+        for (std::size_t i = 0; i < length; ++i) {
+            bytes[length - i] = static_cast<byte>(size >> (8 * i));
+        }
+        sink.update(DataView(bytes, length + 1));
+    }
+
+  private:
+    Sink& sink;
+};
+
+template <typename F>
+Data RLPSizer::singleByte(F&& items) {
+    Data data;
+    RLPDataSink sink{data};
+    RLPWriter<RLPDataSink> writer(sink);
+    items(writer);
+    return data;
+}
+
+/// Encodes the items described by `items`, called with an RLPSizer then an RLPWriter, into an exactly sized buffer.
+/// Returns an empty buffer if an item cannot be encoded.
+template <typename F>
+Data rlpEncode(F&& items) {
+    RLPSizer sizer;
+    items(sizer);
+    if (!sizer.valid) {
+        return {};
+    }
+    Data result;
+    result.reserve(sizer.size);
+    RLPDataSink sink{result};
+    RLPWriter<RLPDataSink> writer(sink);
+    items(writer);
+    return result;
+}
+
+/// Streams the items described by `items` into `sink`; returns false, without writing anything,
+/// if an item cannot be encoded.
+template <typename Sink, typename F>
+bool rlpWrite(Sink& sink, F&& items) {
+    RLPSizer sizer;
+    items(sizer);
+    if (!sizer.valid) {
+        return false;
+    }
+    RLPWriter<Sink> writer(sink);
+    items(writer);
+    return true;
+}
+
+} // namespace TW::Ethereum
@@ -0,0 +1,115 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SignedTransaction.h"
+#include "RLPReader.h"
+#include "RLPWriter.h"
+
+#include "../Hash.h"
+#include "../Hashers.h"
+#include "../PublicKey.h"
+#include "../ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Ethereum;
+
+namespace {
+
+/// Half of the order of secp256k1, the largest s value accepted since Homestead.
+const uint256_t halfOrder("0x7fffffffffffffffffffffffffffffff5d576e7357a4501ddfe92f46681b20a0");
+
+uint256_t number(RLPReader& reader) {
+    return static_cast<uint256_t>(reader.next().toUInt256());
+}
+
+} // namespace
+
+SignedTransaction Ethereum::decodeSigned(DataView encoded) {
+    if (!encoded.empty() && encoded[0] < 0xc0) {
+        throw std::invalid_argument("Typed transactions are not supported");
+    }
+    const auto item = RLPReader::parse(encoded);
+    auto reader = item.items();
+
+    // the fields are signed as they are encoded
+    const auto fieldsStart = reader.offset();
+    auto nonce = number(reader);
+    auto gasPrice = number(reader);
+    auto gasLimit = number(reader);
+    auto to = reader.next().toData();
+    auto amount = number(reader);
+    auto payload = reader.next().toData();
+    const auto fields = encoded.subView(fieldsStart, reader.offset() - fieldsStart);
+    auto transaction = Transaction(nonce, gasPrice, gasLimit, std::move(to), amount, std::move(payload));
+    transaction.v = number(reader);
+    transaction.r = number(reader);
+    transaction.s = number(reader);
+    if (!reader.empty()) {
+        throw std::invalid_argument("Unexpected transaction fields");
+    }
+    if (!transaction.to.empty() && transaction.to.size() != Address::size) {
+        throw std::invalid_argument("Invalid recipient");
+    }
+
+    // v is 27 + recovery id without replay protection, 35 + 2 * chainID + recovery id with EIP-155
+    uint256_t chainID = 0;
+    byte recoveryID;
+    if (transaction.v == 27 || transaction.v == 28) {
+        recoveryID = static_cast<byte>(transaction.v - 27);
+    } else if (transaction.v >= 35) {
+        chainID = (transaction.v - 35) / 2;
+        recoveryID = static_cast<byte>((transaction.v - 35) % 2);
+    } else {
+        throw std::invalid_argument("Invalid signature v value");
+    }
+    if (transaction.r == 0 || transaction.s == 0 || transaction.s > halfOrder) {
+        throw std::invalid_argument("Invalid signature r or s value");
+    }
+
+    Hash::Keccak256Hasher hasher;
+    rlpWrite(hasher, [&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.encoded(fields);
+            if (chainID != 0) {
+                list.item(chainID).item(0).item(0);
+            }
+        });
+    });
+    const auto digest = hasher.final();
+    auto signingHash = Data(digest.begin(), digest.end());
+
+    Data signature(65);
+    const auto r = store(transaction.r);
+    const auto s = store(transaction.s);
+    std::copy(r.begin(), r.end(), signature.begin() + 32 - r.size());
+    std::copy(s.begin(), s.end(), signature.begin() + 64 - s.size());
+    signature[64] = recoveryID;
+    // r values above the order are rejected by the recovery
+    const auto sender = Address(PublicKey::recover(signature, signingHash));
+
+    const auto hash = Hash::keccak256Digest(encoded);
+    return SignedTransaction{std::move(transaction), chainID, std::move(signingHash), Data(hash.begin(), hash.end()), sender};
+}
+
+std::vector<std::optional<SignedTransaction>> Ethereum::decodeSignedMany(const std::vector<Data>& encoded, std::size_t threadCount) {
+    const auto count = encoded.size();
+    std::vector<std::optional<SignedTransaction>> results(count);
+    std::atomic<std::size_t> next(0);
+    const auto worker = [&]() {
+        for (auto index = next++; index < count; index = next++) {
+            try {
+                results[index] = decodeSigned(encoded[index]);
+            } catch (const std::invalid_argument&) {
+            }
+        }
+    };
+    ThreadPool::shared().run(threadCount, count, worker);
+    return results;
+}
@@ -0,0 +1,46 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Address.h"
+#include "Transaction.h"
+
+#include "../Data.h"
+#include "../uint256.h"
+
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace TW::Ethereum {
+
+/// A signed transaction decoded from its raw encoding, with its signer.
+struct SignedTransaction {
+    /// Fields and signature values.
+    Transaction transaction;
+    /// Chain identifier of an EIP-155 signature, 0 for a signature without replay protection.
+    uint256_t chainID;
+    /// Hash which was signed.
+    Data signingHash;
+    /// Keccak256 hash of the raw encoding, the transaction hash on chain.
+    Data hash;
+    /// Address recovered from the signature.
+    Address sender;
+};
+
+/// Decodes a raw signed transaction, as broadcast, and recovers its sender; for Ethereum and the other
+/// chains with Ethereum transactions.  Only legacy transactions are supported, as they are signed by Signer.
+///
+/// @throws std::invalid_argument if the encoding, the fields or the signature are not valid,
+/// with a high s value for instance (EIP-2).
+SignedTransaction decodeSigned(DataView encoded);
+
+/// Decodes many raw transactions on several threads (threadCount 0 uses the available hardware concurrency).
+/// An entry is empty where `decodeSigned` would throw.
+std::vector<std::optional<SignedTransaction>> decodeSignedMany(const std::vector<Data>& encoded, std::size_t threadCount = 0);
+
+} // namespace TW::Ethereum
@@ -5,25 +5,92 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "RLPWriter.h"
 #include "HexCoding.h"
+#include "../CoinEntry.h"
+#include "../Hashers.h"
+#include "../ProtobufReader.h"
+#include "../SigningOutputFields.h"
 #include <google/protobuf/util/json_util.h>
 
 using namespace TW;
 using namespace TW::Ethereum;
 
+namespace {
+
+/// Field paths of the payloads of transfers and contract calls in a serialized SigningInput.
+constexpr std::array<uint32_t, 3> transferDataPath = {7, 1, 2};
+constexpr std::array<uint32_t, 3> contractDataPath = {7, 6, 2};
+
+/// The `data` field of a transfer or contract call input, empty for the other transactions.
+DataView inputPayload(const Proto::SigningInput& input) {
+    const auto& transaction = input.transaction();
+    const auto& data = transaction.has_transfer() ? transaction.transfer().data() : transaction.contract_generic().data();
+    return DataView(reinterpret_cast<const byte*>(data.data()), data.size());
+}
+
+} // namespace
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    return sign(input, inputPayload(input));
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input, DataView payload) noexcept {
     try {
         auto signer = Signer(load(input.chain_id()));
-        auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-        auto transaction = Signer::build(input);
+        const auto keyData = Data(input.private_key().begin(), input.private_key().end());
+        auto transaction = Signer::build(input, payload);
+
+        // a public key references a key of the signer backend
+        auto* backend = SignerBackend::current();
+        if (backend != nullptr && (keyData.size() == PublicKey::secp256k1Size || keyData.size() == PublicKey::secp256k1ExtendedSize)) {
+            const auto type = keyData.size() == PublicKey::secp256k1Size ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeSECP256k1Extended;
+            if (!signer.sign(*backend, PublicKey(keyData, type), transaction)) {
+                return Proto::SigningOutput();
+            }
+        } else {
+            signer.sign(PrivateKey(keyData), transaction);
+        }
+
+        return Signer::output(transaction);
+    } catch (std::exception&) {
+        return Proto::SigningOutput();
+    }
+}
 
-        signer.sign(key, transaction);
+void Signer::sign(DataView dataIn, Data& dataOut) {
+    const auto serialize = [&dataOut](const Proto::SigningOutput& output) {
+        const auto offset = dataOut.size();
+        dataOut.resize(offset + output.ByteSizeLong());
+        output.SerializeWithCachedSizesToArray(dataOut.data() + offset);
+    };
+    for (const auto& path : {transferDataPath, contractDataPath}) {
+        DataView payload;
+        if (!ProtobufReader::find(dataIn, path, payload) || payload.size() < aliasedPayloadSize) {
+            continue;
+        }
+        // the payload stays in dataIn, the rest of the input is parsed without it
+        const auto stripped = ProtobufReader::without(dataIn, path);
+        withArenaInput<Proto::SigningInput>(stripped, [&](const Proto::SigningInput& input) {
+            // the payload belongs to a transaction replaced by a later one of the input otherwise
+            const auto& transaction = input.transaction();
+            const auto selected = path == transferDataPath ? transaction.has_transfer() : transaction.has_contract_generic();
+            serialize(selected ? Signer::sign(input, payload) : Signer::sign(input));
+        });
+        return;
+    }
+    withArenaInput<Proto::SigningInput>(dataIn, [&](const Proto::SigningInput& input) { serialize(Signer::sign(input)); });
+}
 
-        auto output = Proto::SigningOutput();
+Proto::SigningOutput Signer::output(const Transaction& transaction) noexcept {
+    auto output = Proto::SigningOutput();
 
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
         auto encoded = RLP::encode(transaction);
         output.set_encoded(encoded.data(), encoded.size());
+    }
 
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldSignature)) {
         auto v = store(transaction.v);
         output.set_v(v.data(), v.size());
 
@@ -32,13 +99,13 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
         auto s = store(transaction.s);
         output.set_s(s.data(), s.size());
+    }
 
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldTransaction)) {
         output.set_data(transaction.payload.data(), transaction.payload.size());
-
-        return output;
-    } catch (std::exception&) {
-        return Proto::SigningOutput();
     }
+
+    return output;
 }
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
@@ -86,6 +153,10 @@ Data addressStringToData(const std::string& asString) {
 }
 
 Transaction Signer::build(const Proto::SigningInput &input) {
+    return build(input, inputPayload(input));
+}
+
+Transaction Signer::build(const Proto::SigningInput& input, DataView payload) {
     Data toAddress = addressStringToData(input.to_address());
     uint256_t nonce = load(input.nonce());
     uint256_t gasPrice = load(input.gas_price());
@@ -99,7 +170,7 @@ Transaction Signer::build(const Proto::SigningInput &input) {
                     /* gasLimit: */ gasLimit,
                     /* to: */ toAddress,
                     /* amount: */ load(input.transaction().transfer().amount()),
-                    /* optionalTransaction: */ Data(input.transaction().transfer().data().begin(), input.transaction().transfer().data().end()));
+                    /* optionalTransaction: */ payload.toData());
                 return transaction;
             }
 
@@ -171,7 +242,7 @@ Transaction Signer::build(const Proto::SigningInput &input) {
                     /* gasLimit: */ gasLimit,
                     /* to: */ toAddress,
                     /* amount: */ load(input.transaction().contract_generic().amount()),
-                    /* transaction: */ Data(input.transaction().contract_generic().data().begin(), input.transaction().contract_generic().data().end()));
+                    /* transaction: */ payload.toData());
                 return transaction;
             }
     }
@@ -186,16 +257,37 @@ void Signer::sign(const PrivateKey &privateKey, Transaction &transaction) const
     transaction.v = std::get<2>(tuple);
 }
 
+bool Signer::sign(SignerBackend& backend, const PublicKey& publicKey, Transaction& transaction) const {
+    auto hash = this->hash(transaction);
+    const auto signatures = backend.signVerified({DigestSigningRequest{publicKey, hash, TWCurveSECP256k1}});
+    const auto signature = backendRecoverableSignature(publicKey, hash, signatures.front(), TWCurveSECP256k1);
+    if (signature.empty()) {
+        return false;
+    }
+    const auto tuple = values(chainID, signature);
+
+    transaction.r = std::get<0>(tuple);
+    transaction.s = std::get<1>(tuple);
+    transaction.v = std::get<2>(tuple);
+    return true;
+}
+
 Data Signer::hash(const Transaction &transaction) const noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(transaction.nonce));
-    append(encoded, RLP::encode(transaction.gasPrice));
-    append(encoded, RLP::encode(transaction.gasLimit));
-    append(encoded, RLP::encode(transaction.to));
-    append(encoded, RLP::encode(transaction.amount));
-    append(encoded, RLP::encode(transaction.payload));
-    append(encoded, RLP::encode(chainID));
-    append(encoded, RLP::encode(0));
-    append(encoded, RLP::encode(0));
-    return Hash::keccak256(RLP::encodeList(encoded));
+    // EIP-155 preimage, streamed into the hasher
+    Hash::Keccak256Hasher hasher;
+    rlpWrite(hasher, [&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(transaction.nonce)
+                .item(transaction.gasPrice)
+                .item(transaction.gasLimit)
+                .item(transaction.to)
+                .item(transaction.amount)
+                .item(transaction.payload)
+                .item(chainID)
+                .item(0)
+                .item(0);
+        });
+    });
+    const auto digest = hasher.final();
+    return Data(digest.begin(), digest.end());
 }
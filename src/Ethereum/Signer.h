@@ -11,10 +11,12 @@
 #include "../Data.h"
 #include "../Hash.h"
 #include "../PrivateKey.h"
+#include "../SignerBackend.h"
 #include "../proto/Ethereum.pb.h"
 #include "../uint256.h"
 
 #include <boost/multiprecision/cpp_int.hpp>
+#include <cstddef>
 #include <cstdint>
 #include <tuple>
 #include <vector>
@@ -26,9 +28,20 @@ class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+    /// Signs a Proto::SigningInput transaction whose transfer or contract call payload is `payload`, instead of
+    /// the `data` field of the input, for payloads read in place from the serialized input.
+    static Proto::SigningOutput sign(const Proto::SigningInput& input, DataView payload) noexcept;
+    /// Signs a serialized Proto::SigningInput and appends the serialized output to `dataOut`.  A transfer or
+    /// contract call payload of at least `aliasedPayloadSize` bytes is not parsed into the input, but read in
+    /// place from `dataIn`.
+    static void sign(DataView dataIn, Data& dataOut);
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
 
+    /// Payload size from which signing a serialized input leaves the payload out of the parsed input; smaller
+    /// payloads cost less to copy than the input to parse without them.
+    static constexpr std::size_t aliasedPayloadSize = 1024;
+
   public:
     uint256_t chainID;
 
@@ -38,10 +51,19 @@ class Signer {
     /// Signs the given transaction.
     void sign(const PrivateKey &privateKey, Transaction &transaction) const noexcept;
 
+    /// Signs the given transaction with a key of a signer backend; false if the backend failed.
+    bool sign(SignerBackend& backend, const PublicKey& publicKey, Transaction& transaction) const;
+
   public:
     /// build Transaction from signing input
     static Transaction build(const Proto::SigningInput &input);
 
+    /// build Transaction from signing input, with `payload` as the transfer or contract call payload
+    static Transaction build(const Proto::SigningInput& input, DataView payload);
+
+    /// Builds the signing output of a signed transaction.
+    static Proto::SigningOutput output(const Transaction& transaction) noexcept;
+
     /// Signs a hash with the given private key for the given chain identifier.
     ///
     /// @returns the r, s, and v values of the transaction signature
@@ -0,0 +1,112 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningTemplate.h"
+
+#include "Address.h"
+#include "RLPWriter.h"
+#include "Signer.h"
+#include "Transaction.h"
+#include "../Hashers.h"
+
+#include <stdexcept>
+#include <tuple>
+
+using namespace TW;
+using namespace TW::Ethereum;
+
+/// Layout of the ERC20 transfer call: function selector, then the recipient and amount as 32-byte words.
+static const size_t selectorSize = 4;
+static const size_t wordSize = 32;
+
+Ethereum::SigningTemplate::SigningTemplate(const Proto::SigningInput& input)
+    : key(Data(input.private_key().begin(), input.private_key().end()))
+    , chainID(load(input.chain_id())) {
+    const auto& transaction = input.transaction();
+    if (transaction.has_transfer()) {
+        isTokenTransfer = false;
+        payload = data(transaction.transfer().data());
+    } else if (transaction.has_erc20_transfer()) {
+        isTokenTransfer = true;
+        const auto address = Address(input.to_address());
+        contract = Data(address.bytes.begin(), address.bytes.end());
+        payload = Transaction::buildERC20TransferCall(Data(Address::size), 0);
+        if (payload.size() != selectorSize + 2 * wordSize) {
+            throw std::logic_error("Unexpected ERC20 transfer call size");
+        }
+    } else {
+        throw std::invalid_argument("Not a transfer or an ERC20 transfer");
+    }
+
+    const auto gasPrice = load(input.gas_price());
+    const auto gasLimit = load(input.gas_limit());
+    encodedGas = rlpEncode([&](auto& rlp) { rlp.item(gasPrice).item(gasLimit); });
+    encodedPayload = rlpEncode([&](auto& rlp) { rlp.item(payload); });
+    encodedChain = rlpEncode([&](auto& rlp) { rlp.item(chainID).item(0).item(0); });
+}
+
+Data Ethereum::SigningTemplate::sign(const SigningPatch& patch) const {
+    const auto recipient = Address(patch.toAddress);
+    if (patch.amount.size() > wordSize) {
+        throw std::invalid_argument("Amount over 256 bits");
+    }
+    const auto nonce = uint256_t(patch.nonce);
+
+    Data to;
+    uint256_t amount;
+    Data callPayload;
+    if (isTokenTransfer) {
+        to = contract;
+        callPayload = payload;
+        std::copy(recipient.bytes.begin(), recipient.bytes.end(), callPayload.begin() + selectorSize + wordSize - Address::size);
+        std::copy(patch.amount.begin(), patch.amount.end(), callPayload.end() - patch.amount.size());
+    } else {
+        to = Data(recipient.bytes.begin(), recipient.bytes.end());
+        amount = load(patch.amount);
+    }
+    // the payload item of transfers is invariant
+    const auto writePayload = [&](auto& list) {
+        if (isTokenTransfer) {
+            list.item(callPayload);
+        } else {
+            list.encoded(encodedPayload);
+        }
+    };
+
+    Hash::Keccak256Hasher hasher;
+    rlpWrite(hasher, [&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(nonce).encoded(encodedGas).item(to).item(amount);
+            writePayload(list);
+            list.encoded(encodedChain);
+        });
+    });
+    const auto digest = hasher.final();
+    uint256_t r, s, v;
+    std::tie(r, s, v) = Signer::sign(chainID, key, Data(digest.begin(), digest.end()));
+
+    const auto encoded = rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(nonce).encoded(encodedGas).item(to).item(amount);
+            writePayload(list);
+            list.item(v).item(r).item(s);
+        });
+    });
+
+    auto output = Proto::SigningOutput();
+    output.set_encoded(encoded.data(), encoded.size());
+    const auto vData = store(v);
+    output.set_v(vData.data(), vData.size());
+    const auto rData = store(r);
+    output.set_r(rData.data(), rData.size());
+    const auto sData = store(s);
+    output.set_s(sData.data(), sData.size());
+    const auto& outputPayload = isTokenTransfer ? callPayload : payload;
+    output.set_data(outputPayload.data(), outputPayload.size());
+
+    const auto serialized = output.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
@@ -0,0 +1,46 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+#include "../PrivateKey.h"
+#include "../SigningTemplate.h"
+#include "../proto/Ethereum.pb.h"
+#include "../uint256.h"
+
+namespace TW::Ethereum {
+
+/// Signing template for transfers and ERC20 transfers.
+///
+/// Gas fields, the payload and the EIP-155 suffix are RLP encoded once; for ERC20 transfers
+/// the recipient and amount words are patched into a prepared `transfer` call.
+class SigningTemplate : public TW::SigningTemplate {
+  public:
+    /// Prepares the template, the nonce, recipient and amount of the input are ignored.
+    ///
+    /// @throws std::invalid_argument if the input is not a transfer or an ERC20 transfer, or is invalid.
+    explicit SigningTemplate(const Proto::SigningInput& input);
+
+    Data sign(const SigningPatch& patch) const override;
+
+  private:
+    PrivateKey key;
+    uint256_t chainID;
+    bool isTokenTransfer;
+    /// Token contract, for ERC20 transfers.
+    Data contract;
+    /// Transfer data, or ERC20 transfer call with a zero recipient and amount.
+    Data payload;
+    /// RLP encoded gas price and gas limit.
+    Data encodedGas;
+    /// RLP encoded transfer data, for transfers.
+    Data encodedPayload;
+    /// RLP encoded chain ID, 0, 0 ending the EIP-155 pre-image.
+    Data encodedChain;
+};
+
+} // namespace TW::Ethereum
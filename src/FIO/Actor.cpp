@@ -11,7 +11,6 @@
 using namespace TW::FIO;
 using namespace std;
 
-static const auto pattern = regex(R"(\b([a-z1-5]{3,})[.@]?\b)");
 string Actor::actor(const Address& addr)
 {
     uint64_t shortenedKey = shortenKey(addr.bytes);
@@ -21,6 +20,8 @@ string Actor::actor(const Address& addr)
 }
 
 bool Actor::validate(const std::string& addr) {
+    // compiled on first use rather than when the library is loaded
+    static const auto pattern = regex(R"(\b([a-z1-5]{3,})[.@]?\b)");
     smatch match;
     return regex_search(addr, match, pattern);
 }
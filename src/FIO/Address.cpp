@@ -80,7 +80,7 @@ Address::Address(const std::string& string) {
 /// Initializes a FIO address from a public key.
 Address::Address(const PublicKey& publicKey) {
     // copy the raw, compressed key data
-    Data data = publicKey.compressed().bytes;
+    Data data = publicKey.compressed().bytes.toData();
 
     // append the checksum
     uint32_t checksum = createChecksum(data);
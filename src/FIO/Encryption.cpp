@@ -15,9 +15,11 @@
 
 #include <TrezorCrypto/rand.h>
 #include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/secp256k1.h>
 #include <TrustWalletCore/TWAESPaddingMode.h>
 
+#include <algorithm>
 #include <cassert>
 
 namespace TW::FIO {
@@ -27,71 +29,20 @@ using namespace std;
 const uint8_t IvSize = 16;
 
 Data Encryption::checkEncrypt(const Data& secret, const Data& message, Data& iv) {
-    const Data K = Hash::sha512(secret);
-    assert(K.size() == 64);
-    const Data Ke = subData(K, 0, 32); // Encryption key
-    const Data Km = subData(K, 32, 32); // MAC key
-    if (iv.size() == 0) {
-        // fill iv with strong random value
-        iv = Data(IvSize);
-        random_buffer(iv.data(), iv.size());
-    } else {
-        if (iv.size() != IvSize) {
-            throw std::invalid_argument("invalid IV size");
-        }
-    }
-    assert(iv.size() == IvSize);
-    Data ivOrig(0); // writeable copy
-    TW::append(ivOrig, iv);
-
-    // Encrypt. Padding is done (PKCS#7)
-    const Data C = Encrypt::AESCBCEncrypt(Ke, message, iv, TWAESPaddingModePKCS7);
-
-    // HMAC. Include in the HMAC input everything that impacts the decryption.
-    Data hmacIn(0);
-    TW::append(hmacIn, ivOrig);
-    TW::append(hmacIn, C);
-    Data M = Hash::hmac256(Km, hmacIn);
-
-    Data result(0); // iv + C + M
-    TW::append(result, hmacIn);
-    TW::append(result, M);
-    return result;
+    return EncryptionContext(secret).encryptWithIv(message, iv);
 }
 
 Data Encryption::checkDecrypt(const Data& secret, const Data& message) {
-    const Data K = Hash::sha512(secret);
-    assert(K.size() == 64);
-    const Data Ke = subData(K, 0, 32); // Encryption key
-    const Data Km = subData(K, 32, 32); // MAC key
-
-    if (message.size() < IvSize + 16 + 32) {
-        // minimum size: 16 for iv, 16 for message (padded), 32 for HMAC
-        throw std::invalid_argument("Message too short");
-    }
-    Data iv = subData(message, 0, IvSize);
-    const Data C = subData(message, IvSize, message.size() - IvSize - 32);
-    const Data M = subData(message, message.size() - 32, 32);
-
-    // Side-channel attack protection: First verify the HMAC, then and only then proceed to the decryption step
-    Data hmacInput(0);
-    TW::append(hmacInput, iv);
-    TW::append(hmacInput, C);
-    const Data Mc = Hash::hmac256(Km, hmacInput);
-    if (M != Mc) {
-        throw std::invalid_argument("Decrypt failed, HMAC mismatch");
-    }
-
-    // Decrypt, unpadding is done
-    const Data unencrypted = Encrypt::AESCBCDecrypt(Ke, C, iv, TWAESPaddingModePKCS7);
-    return unencrypted;
+    return EncryptionContext(secret).decrypt(message);
 }
 
 Data Encryption::getSharedSecret(const PrivateKey& privateKey1, const PublicKey& publicKey2) {
     // See https://github.com/fioprotocol/fiojs/blob/master/src/ecc/key_private.js
     
     curve_point KBP;
-	assert(ecdsa_read_pubkey(&secp256k1, publicKey2.bytes.data(), &KBP));
+    if (!ecdsa_read_pubkey(&secp256k1, publicKey2.bytes.data(), &KBP)) {
+        throw std::invalid_argument("Invalid public key");
+    }
 
     bignum256 privBN;
     bn_read_be(privateKey1.bytes.data(), &privBN);
@@ -101,20 +52,21 @@ Data Encryption::getSharedSecret(const PrivateKey& privateKey1, const PublicKey&
 
     Data S(32);
     bn_write_be(&P.x, S.data());
-    
+    memzero(&privBN, sizeof(privBN));
+    memzero(&P, sizeof(P));
+
     // SHA512 used in ECIES
-    return Hash::sha512(S);
+    const auto secret = Hash::sha512(S);
+    memzero(S.data(), S.size());
+    return secret;
 }
 
 Data Encryption::encrypt(const PrivateKey& privateKey1, const PublicKey& publicKey2, const Data& message, const Data& iv) {
-    const Data sharedSecret = getSharedSecret(privateKey1, publicKey2);
-    Data ivCopy(iv); // writeably copy
-    return checkEncrypt(sharedSecret, message, ivCopy);
+    return EncryptionContext(privateKey1, publicKey2).encrypt(message, iv);
 }
 
 Data Encryption::decrypt(const PrivateKey& privateKey1, const PublicKey& publicKey2, const Data& encrypted) {
-    const Data sharedSecret = getSharedSecret(privateKey1, publicKey2);
-    return checkDecrypt(sharedSecret, encrypted);
+    return EncryptionContext(privateKey1, publicKey2).decrypt(encrypted);
 }
 
 string Encryption::encode(const Data& encrypted) {
@@ -125,4 +77,93 @@ Data Encryption::decode(const std::string& encoded) {
     return TW::Base64::decode(encoded);
 }
 
+EncryptionContext::EncryptionContext(const PrivateKey& privateKey, const PublicKey& publicKey)
+    : EncryptionContext(Encryption::getSharedSecret(privateKey, publicKey)) {}
+
+EncryptionContext::EncryptionContext(const Data& sharedSecret) : secret(sharedSecret) {
+    Data K = Hash::sha512(secret);
+    assert(K.size() == 64);
+    encryptionKey = subData(K, 0, 32);
+    // MAC key, from K[32..64]
+    hmac_sha256_Init(&macContext, K.data() + 32, 32);
+    memzero(K.data(), K.size());
+}
+
+EncryptionContext::~EncryptionContext() {
+    memzero(secret.data(), secret.size());
+    memzero(encryptionKey.data(), encryptionKey.size());
+    memzero(&macContext, sizeof(macContext));
+}
+
+Data EncryptionContext::encryptWithIv(const Data& message, Data& iv) const {
+    if (iv.size() == 0) {
+        // fill iv with strong random value
+        iv = Data(IvSize);
+        random_buffer(iv.data(), iv.size());
+    } else {
+        if (iv.size() != IvSize) {
+            throw std::invalid_argument("invalid IV size");
+        }
+    }
+    assert(iv.size() == IvSize);
+    Data result(0); // iv + C + M
+    TW::append(result, iv);
+
+    // Encrypt. Padding is done (PKCS#7)
+    const Data C = Encrypt::AESCBCEncrypt(encryptionKey, message, iv, TWAESPaddingModePKCS7);
+    TW::append(result, C);
+
+    // HMAC. Include in the HMAC input everything that impacts the decryption: iv + C
+    auto hmac = macContext;
+    hmac_sha256_Update(&hmac, result.data(), static_cast<uint32_t>(result.size()));
+    result.resize(result.size() + SHA256_DIGEST_LENGTH);
+    hmac_sha256_Final(&hmac, result.data() + result.size() - SHA256_DIGEST_LENGTH);
+    return result;
+}
+
+Data EncryptionContext::encrypt(const Data& message, const Data& iv) const {
+    Data ivCopy(iv); // writeable copy
+    return encryptWithIv(message, ivCopy);
+}
+
+Data EncryptionContext::decrypt(const Data& message) const {
+    if (message.size() < IvSize + 16 + 32) {
+        // minimum size: 16 for iv, 16 for message (padded), 32 for HMAC
+        throw std::invalid_argument("Message too short");
+    }
+    const auto macStart = message.size() - SHA256_DIGEST_LENGTH;
+
+    // Side-channel attack protection: First verify the HMAC, then and only then proceed to the decryption step
+    auto hmac = macContext;
+    hmac_sha256_Update(&hmac, message.data(), static_cast<uint32_t>(macStart));
+    Data Mc(SHA256_DIGEST_LENGTH);
+    hmac_sha256_Final(&hmac, Mc.data());
+    if (!std::equal(Mc.begin(), Mc.end(), message.begin() + macStart)) {
+        throw std::invalid_argument("Decrypt failed, HMAC mismatch");
+    }
+
+    // Decrypt, unpadding is done
+    Data iv = subData(message, 0, IvSize);
+    const Data C = subData(message, IvSize, macStart - IvSize);
+    return Encrypt::AESCBCDecrypt(encryptionKey, C, iv, TWAESPaddingModePKCS7);
+}
+
+std::vector<Data> EncryptionContext::encryptBatch(const std::vector<Data>& messages) const {
+    std::vector<Data> result;
+    result.reserve(messages.size());
+    for (const auto& message : messages) {
+        result.push_back(encrypt(message));
+    }
+    return result;
+}
+
+std::vector<Data> EncryptionContext::decryptBatch(const std::vector<Data>& encrypted) const {
+    std::vector<Data> result;
+    result.reserve(encrypted.size());
+    for (const auto& message : encrypted) {
+        result.push_back(decrypt(message));
+    }
+    return result;
+}
+
 } // namespace TW::FIO
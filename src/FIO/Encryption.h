@@ -10,6 +10,10 @@
 #include "../PrivateKey.h"
 #include "../PublicKey.h"
 
+#include <TrezorCrypto/hmac.h>
+
+#include <vector>
+
 namespace TW::FIO {
 
 /// Payload message encryption/decryption.
@@ -54,4 +58,51 @@ public:
     static Data decode(const std::string& encoded);
 };
 
+/// Payload encryption/decryption between a fixed pair of keys, for the many messages exchanged with the same
+/// counterparty: the shared secret, and the keys derived from it, are computed once.
+/// Results are the same as with Encryption::encrypt and Encryption::decrypt.
+class EncryptionContext {
+public:
+    /// Derives the shared secret of the own private key and the counterparty's public key.
+    /// @throws std::invalid_argument if the public key is not a valid secp256k1 key.
+    EncryptionContext(const PrivateKey& privateKey, const PublicKey& publicKey);
+
+    /// Uses a shared secret (64 bytes), as returned by Encryption::getSharedSecret().
+    explicit EncryptionContext(const Data& sharedSecret);
+
+    EncryptionContext(const EncryptionContext& other) = default;
+    EncryptionContext& operator=(const EncryptionContext& other) = default;
+    ~EncryptionContext();
+
+    /// The 64-byte shared secret.
+    const Data& sharedSecret() const { return secret; }
+
+    /// Encrypts a message, with a random initial vector if `iv` is empty.
+    /// @throws std::invalid_argument if the IV size is invalid
+    Data encrypt(const Data& message, const Data& iv = {}) const;
+
+    /// Decrypts a message.
+    /// @throws std::invalid_argument if the message is too short or the HMAC does not match
+    Data decrypt(const Data& encrypted) const;
+
+    /// Encrypts messages, each one with a random initial vector.
+    std::vector<Data> encryptBatch(const std::vector<Data>& messages) const;
+
+    /// Decrypts messages.
+    /// @throws std::invalid_argument if any of them cannot be decrypted
+    std::vector<Data> decryptBatch(const std::vector<Data>& encrypted) const;
+
+private:
+    /// Encrypts with the given initial vector, filled with a random one if empty.
+    Data encryptWithIv(const Data& message, Data& iv) const;
+
+    friend class Encryption;
+
+    Data secret;
+    /// AES key, first half of the SHA512 of the secret
+    Data encryptionKey;
+    /// HMAC keyed with the second half
+    HMAC_SHA256_CTX macContext;
+};
+
 } // namespace TW::FIO
@@ -6,18 +6,17 @@
 
 #include "Signer.h"
 #include "HexCoding.h"
+#include "../BatchSigning.h"
 #include <google/protobuf/util/json_util.h>
 
+#include <optional>
+
 using namespace TW;
 using namespace TW::Filecoin;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    // Load private key and transaction from Protobuf input.
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto pubkey = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
-    Address from_address(pubkey);
+static Transaction transactionFrom(const Proto::SigningInput& input, const Address& from_address) {
     Address to_address(input.to());
-    Transaction transaction(
+    return Transaction(
         /* to */ to_address,
         /* from */ from_address,
         /* nonce */ input.nonce(),
@@ -26,9 +25,9 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         /* gasFeeCap */ load(input.gas_fee_cap()),
         /* gasPremium */ load(input.gas_premium())
     );
+}
 
-    // Sign transaction.
-    auto signature = sign(key, transaction);
+static Proto::SigningOutput signingOutput(const Transaction& transaction, Data& signature) {
     const auto json = transaction.serialize(signature);
 
     // Return Protobuf output.
@@ -37,6 +36,46 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     return output;
 }
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    // Load private key and transaction from Protobuf input.
+    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto pubkey = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+    Address from_address(pubkey);
+    auto transaction = transactionFrom(input, from_address);
+
+    // Sign transaction.
+    auto signature = sign(key, transaction);
+    return signingOutput(transaction, signature);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto& keyBytes = inputs[begin].private_key();
+        const auto key = PrivateKey(Data(keyBytes.begin(), keyBytes.end()));
+        const Address from_address(key.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+        std::vector<std::optional<Transaction>> transactions;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            try {
+                transactions.emplace_back(transactionFrom(inputs[i], from_address));
+                digests.push_back(Hash::blake2b(transactions.back()->cid(), 32));
+            } catch (const std::exception&) {
+                // invalid recipient
+                transactions.emplace_back();
+                digests.push_back(Data(32));
+                outputs[i].set_error(Common::Proto::Error_general);
+            }
+        }
+        std::vector<Data> signatures;
+        key.signBatch(digests, TWCurveSECP256k1, signatures);
+        for (auto i = begin; i < end; ++i) {
+            if (transactions[i - begin]) {
+                outputs[i] = signingOutput(*transactions[i - begin], signatures[i - begin]);
+            }
+        }
+    });
+}
+
 Data Signer::sign(const PrivateKey& privateKey, Transaction& transaction) noexcept {
     Data toSign = Hash::blake2b(transaction.cid(), 32);
     auto signature = privateKey.sign(toSign, TWCurveSECP256k1);
@@ -13,6 +13,8 @@
 #include "../PrivateKey.h"
 #include "../proto/Filecoin.pb.h"
 
+#include <vector>
+
 namespace TW::Filecoin {
 
 /// Helper class that performs Filecoin transaction signing.
@@ -23,6 +25,11 @@ class Signer {
     /// Signs a Proto::SigningInput transaction.
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys). The sender address
+    /// and the nonce generator key state are computed once per run of inputs with the same private key, as
+    /// in payouts from one account. An invalid recipient gives Error_general.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
 
@@ -7,6 +7,7 @@
 #include "Transaction.h"
 #include <nlohmann/json.hpp>
 #include "Base64.h"
+#include "Hashers.h"
 
 using json = nlohmann::json;
 using namespace TW;
@@ -35,31 +36,44 @@ const Data cidPrefix = {
     0x20,
 };
 
+Data Transaction::encodeMessage() const {
+    const auto valueBytes = encodeBigInt(value);
+    const auto gasFeeCapBytes = encodeBigInt(gasFeeCap);
+    const auto gasPremiumBytes = encodeBigInt(gasPremium);
+    Data encoded;
+    encoded.reserve(1 + 2 * (1 + to.bytes.size()) + 3 * 9 + 3 * (1 + 33) + 2);
+    Cbor::Writer writer(encoded);
+    writer.arrayHeader(10)
+        .uint(0)                  // version
+        .bytes(to.bytes)          // to address
+        .bytes(from.bytes)        // from address
+        .uint(nonce)              // nonce
+        .bytes(valueBytes);       // value
+    if (gasLimit >= 0) {          // gas limit
+        writer.uint((uint64_t)gasLimit);
+    } else {
+        writer.negInt((uint64_t)(-gasLimit - 1));
+    }
+    writer.bytes(gasFeeCapBytes)  // gas fee cap
+        .bytes(gasPremiumBytes)   // gas premium
+        .uint(0)                  // abi.MethodNum (0 => send)
+        .bytes(Data());           // data (empty)
+    return encoded;
+}
+
 Cbor::Encode Transaction::message() const {
-    Cbor::Encode cborGasLimit = gasLimit >= 0 ? Cbor::Encode::uint((uint64_t)gasLimit)
-                                              : Cbor::Encode::negInt((uint64_t)(-gasLimit - 1));
-    return Cbor::Encode::array({
-        Cbor::Encode::uint(0),                         // version
-        Cbor::Encode::bytes(to.bytes),                 // to address
-        Cbor::Encode::bytes(from.bytes),               // from address
-        Cbor::Encode::uint(nonce),                     // nonce
-        Cbor::Encode::bytes(encodeBigInt(value)),      // value
-        cborGasLimit,                                  // gas limit
-        Cbor::Encode::bytes(encodeBigInt(gasFeeCap)),  // gas fee cap
-        Cbor::Encode::bytes(encodeBigInt(gasPremium)), // gas premium
-        Cbor::Encode::uint(0),                         // abi.MethodNum (0 => send)
-        Cbor::Encode::bytes(Data())                    // data (empty)
-    });
+    return Cbor::Encode::fromRaw(encodeMessage());
 }
 
 Data Transaction::cid() const {
     Data cid;
     cid.reserve(cidPrefix.size() + 32);
     cid.insert(cid.end(), cidPrefix.begin(), cidPrefix.end());
-    Data hash = Hash::blake2b(message().encoded(), 32);
+    const auto hash = Hash::Blake2bHasher(32).update(encodeMessage()).final();
     cid.insert(cid.end(), hash.begin(), hash.end());
     return cid;
 }
+
 std::string Transaction::serialize(Data& signature) const {
     json tx = {
         {"Message", json{
@@ -50,6 +50,9 @@ class Transaction {
         , method(0) {}
 
   public:
+    // encodeMessage returns the CBOR encoding of the Filecoin Message to be signed, written directly.
+    Data encodeMessage() const;
+
     // message returns the CBOR encoding of the Filecoin Message to be signed.
     Cbor::Encode message() const;
 
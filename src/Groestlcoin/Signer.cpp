@@ -5,11 +5,13 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "Bitcoin/SignerTraits.h"
 #include "Bitcoin/TransactionBuilder.h"
 #include "Bitcoin/TransactionSigner.h"
 #include "Hash.h"
 #include "Data.h"
 #include "HexCoding.h"
+#include "SigningOutputFields.h"
 #include "Transaction.h"
 
 using namespace TW;
@@ -31,18 +33,27 @@ SigningOutput Signer::sign(const SigningInput& input) noexcept {
         return output;
     }
     const auto& tx = result.payload();
-    *output.mutable_transaction() = tx.proto();
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldTransaction)) {
+        *output.mutable_transaction() = tx.proto();
+    }
 
+    const auto withId = SigningOutputFields::requested(TWAnySignerOutputFieldTransactionId);
+    if (!withId && !SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
+        return output;
+    }
     Data encoded;
     signer.encodeTx(tx, encoded);
-    output.set_encoded(encoded.data(), encoded.size());
-
-    Data txHashData = encoded;
-    if (tx.hasWitness()) {
-        txHashData.clear();
-        tx.encode(txHashData, Transaction::SegwitFormatMode::NonSegwit);
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
+        output.set_encoded(encoded.data(), encoded.size());
     }
-    auto txHash = Hash::sha256(txHashData.data(), txHashData.size());
+    if (!withId) {
+        return output;
+    }
+
+    // the id hashes the encoding without the witnesses
+    const auto txHashData = tx.hasWitness() ? tx.stripWitness(encoded) : Data();
+    const auto& hashed = tx.hasWitness() ? txHashData : encoded;
+    auto txHash = Bitcoin::SignerTraits<Transaction>::txidHasher(hashed.data(), hashed.size());
     std::reverse(txHash.begin(), txHash.end());
     output.set_transaction_id(hex(txHash));
     return output;
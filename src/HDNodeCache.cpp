@@ -0,0 +1,140 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HDNodeCache.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+
+using namespace TW;
+
+HDNodeCache::Key::Key(TWCurve curve, const DerivationPath& path, size_t length) : curve(curve), path(path.prefix(length)) {}
+
+bool HDNodeCache::Key::operator<(const Key& other) const {
+    if (curve != other.curve) {
+        return curve < other.curve;
+    }
+    return std::lexicographical_compare(path.indices.begin(), path.indices.end(), other.path.indices.begin(), other.path.indices.end(),
+                                        [](const DerivationPathIndex& lhs, const DerivationPathIndex& rhs) {
+                                            return lhs.derivationIndex() < rhs.derivationIndex();
+                                        });
+}
+
+HDNodeCache& HDNodeCache::operator=(const HDNodeCache& other) {
+    if (this != &other) {
+        clear();
+        std::lock_guard<std::mutex> lock(mutex);
+        capacity = other.capacity;
+    }
+    return *this;
+}
+
+bool HDNodeCache::find(TWCurve curve, const DerivationPath& path, size_t length, HDNode& node) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0 || entries.empty()) {
+        return false;
+    }
+    const auto found = index.find(Key(curve, path, length));
+    if (found == index.end()) {
+        return false;
+    }
+    node = use(found);
+    return true;
+}
+
+bool HDNodeCache::findLongestPrefix(TWCurve curve, const DerivationPath& path, size_t maxLength, HDNode& node, size_t& length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0 || entries.empty()) {
+        return false;
+    }
+    // The closest key not above the prefix is the prefix itself if cached; otherwise the longest cached prefix
+    // is also a prefix of their common part, which is searched next.
+    auto key = Key(curve, path, maxLength);
+    while (true) {
+        auto found = index.upper_bound(key);
+        if (found == index.begin()) {
+            return false;
+        }
+        --found;
+        if (found->first.curve != curve) {
+            return false;
+        }
+        const auto common = found->first.path.commonPrefixLength(key.path);
+        if (common == found->first.path.indices.size()) {
+            length = common;
+            node = use(found);
+            return true;
+        }
+        key.path.indices.resize(common);
+    }
+}
+
+const HDNode& HDNodeCache::use(std::map<Key, std::list<Entry>::iterator>::iterator found) {
+    // move to front
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->second;
+}
+
+void HDNodeCache::insert(TWCurve curve, const DerivationPath& path, size_t length, const HDNode& node) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) {
+        return;
+    }
+    auto key = Key(curve, path, length);
+    const auto found = index.find(key);
+    if (found != index.end()) {
+        found->second->second = node;
+        entries.splice(entries.begin(), entries, found->second);
+        return;
+    }
+    while (entries.size() >= capacity) {
+        evict(std::prev(entries.end()));
+    }
+    entries.emplace_front(key, node);
+    index.emplace(std::move(key), entries.begin());
+}
+
+bool HDNodeCache::findExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version, std::string& extended) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = extendedPublicKeys.find(std::make_tuple(purpose, coin, version));
+    if (found == extendedPublicKeys.end()) {
+        return false;
+    }
+    extended.assign(found->second.begin(), found->second.end());
+    return true;
+}
+
+void HDNodeCache::insertExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version, const std::string& extended) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (capacity == 0) {
+        return;
+    }
+    extendedPublicKeys[std::make_tuple(purpose, coin, version)] = SecureString(extended.begin(), extended.end());
+}
+
+void HDNodeCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    while (!entries.empty()) {
+        evict(entries.begin());
+    }
+    for (auto& entry : extendedPublicKeys) {
+        // short strings are stored inline, not by the secure allocator
+        memzero(&entry.second[0], entry.second.size());
+    }
+    extendedPublicKeys.clear();
+}
+
+size_t HDNodeCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void HDNodeCache::evict(std::list<Entry>::iterator it) {
+    index.erase(it->first);
+    memzero(&it->second, sizeof(HDNode));
+    entries.erase(it);
+}
@@ -0,0 +1,93 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "DerivationPath.h"
+#include "SecureMemory.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWCurve.h>
+#include <TrustWalletCore/TWHDVersion.h>
+#include <TrustWalletCore/TWPurpose.h>
+#include <TrezorCrypto/bip32.h>
+
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace TW {
+
+/// Thread-safe LRU cache of intermediate BIP32 nodes, keyed by curve and derivation path prefix.
+///
+/// Used by HDWallet to skip the already computed (mostly hardened) derivation steps of a path, and to keep the
+/// extended public keys it exported.
+/// The cache holds private key material: evicted entries are wiped, and so is the whole cache on destruction.
+/// Copies start out empty, a cache is never shared between wallets.
+class HDNodeCache {
+  public:
+    static constexpr size_t defaultCapacity = 64;
+
+    explicit HDNodeCache(size_t capacity = defaultCapacity) : capacity(capacity) {}
+    HDNodeCache(const HDNodeCache& other) : capacity(other.capacity) {}
+    HDNodeCache(HDNodeCache&& other) : capacity(other.capacity) {}
+    HDNodeCache& operator=(const HDNodeCache& other);
+    HDNodeCache& operator=(HDNodeCache&& other) { return *this = other; }
+
+    ~HDNodeCache() { clear(); }
+
+    /// Looks up the node for the first `length` indices of `path`; returns false if not cached.
+    bool find(TWCurve curve, const DerivationPath& path, size_t length, HDNode& node);
+
+    /// Looks up the node of the longest cached prefix of `path`, of at most `maxLength` indices, with one lock.
+    /// Returns the length of the prefix found, or false if none is cached.
+    bool findLongestPrefix(TWCurve curve, const DerivationPath& path, size_t maxLength, HDNode& node, size_t& length);
+
+    /// Stores the node for the first `length` indices of `path`, evicting the least recently used entry if full.
+    void insert(TWCurve curve, const DerivationPath& path, size_t length, const HDNode& node);
+
+    /// Looks up an extended public key exported by the wallet; returns false if not cached.
+    bool findExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version, std::string& extended);
+
+    /// Stores an extended public key exported by the wallet; a handful per coin at most, not counted by `size`.
+    void insertExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version, const std::string& extended);
+
+    /// Removes and wipes all cached nodes and extended public keys.
+    void clear();
+
+    /// Number of cached nodes.
+    size_t size() const;
+
+    /// Maximum number of cached nodes, 0 disables the cache (extended public keys included).
+    size_t capacity;
+
+  private:
+    struct Key {
+        TWCurve curve;
+        /// Prefix of the path, inline so that lookups do not allocate
+        DerivationPath path;
+
+        Key(TWCurve curve, const DerivationPath& path, size_t length);
+        bool operator<(const Key& other) const;
+    };
+    using Entry = std::pair<Key, HDNode>;
+
+    mutable std::mutex mutex;
+    /// Cached entries, most recently used first.
+    std::list<Entry> entries;
+    std::map<Key, std::list<Entry>::iterator> index;
+    /// Extended public keys, by purpose, coin and version.
+    std::map<std::tuple<TWPurpose, TWCoinType, TWHDVersion>, SecureString> extendedPublicKeys;
+
+    void evict(std::list<Entry>::iterator it);
+    /// Moves a found entry to the front, and returns its node.
+    const HDNode& use(std::map<Key, std::list<Entry>::iterator>::iterator found);
+};
+
+} // namespace TW
@@ -11,51 +11,179 @@
 #include "Bitcoin/SegwitAddress.h"
 #include "Bitcoin/CashAddress.h"
 #include "Coin.h"
+#include "Instrumentation.h"
+#include "PublicKey.h"
+#include "Secp256k1Comb.h"
+#include "SeedCache.h"
+#include "ThreadPool.h"
 
 #include <TrustWalletCore/TWHRP.h>
 #include <TrezorCrypto/bip32.h>
 #include <TrezorCrypto/bip39.h>
 #include <TrezorCrypto/curves.h>
+#include <TrezorCrypto/ed25519.h>
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/hmac.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/pbkdf2.h>
+#include <TrezorCrypto/rand.h>
 
 #include <array>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <map>
 
 using namespace TW;
 
 namespace {
 
-uint32_t fingerprint(HDNode *node, Hash::Hasher hasher);
-std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version, bool use_public, Hash::Hasher hasher);
+void fillPublicKey(HDNode& node, TWCurve curve);
+uint32_t fingerprint(HDNode *node, TWCurve curve, const Hash::Hasher& hasher);
+std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version, bool use_public, const Hash::Hasher& hasher);
 bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher, HDNode *node);
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath);
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve);
+void deriveChild(HDNode& node, HDWallet::PrivateKeyType privateKeyType, uint32_t index);
+PrivateKey privateKeyFromNode(const HDNode& node, HDWallet::PrivateKeyType privateKeyType);
 
 const char* curveName(TWCurve curve);
+
+/// Draws the random entropy of a new mnemonic of `strength` bits, and writes the mnemonic into `mnemonic`; false if the
+/// strength is invalid.
+bool generateMnemonic(int strength, SecureData& entropy, std::array<char, BIP39_MNEMONIC_MAX>& mnemonic) {
+    if (strength % 32 != 0 || strength < 128 || strength > 256) {
+        return false;
+    }
+    const auto size = static_cast<size_t>(strength / 8);
+    // as parsed by updateEntropy, the whole bytes of the 11 bits of each word: with the checksum byte for 24 words
+    const auto wordBytes = static_cast<size_t>((strength + strength / 32) / 8);
+    entropy.reserve(wordBytes);
+    entropy.resize(size);
+    random_buffer(entropy.data(), size);
+    if (mnemonic_from_data_r(entropy.data(), static_cast<int>(size), mnemonic.data(), mnemonic.size()) == nullptr) {
+        return false;
+    }
+    if (wordBytes > size) {
+        auto checksum = Hash::sha256(entropy.data(), size);
+        entropy.push_back(checksum[0]);
+        memzero(checksum.data(), checksum.size());
+    }
+    return true;
+}
+
+void mnemonicToSeed(const char* mnemonic, const char* passphrase, std::array<byte, HDWallet::seedSize>& seed) {
+    auto& cache = SeedCache::shared();
+    if (cache.find(mnemonic, passphrase, seed)) {
+        return;
+    }
+    mnemonic_to_seed(mnemonic, passphrase, seed.data(), nullptr);
+    cache.insert(mnemonic, passphrase, seed);
+}
 } // namespace
 
 HDWallet::HDWallet(int strength, const std::string& passphrase)
-    : seed(), mnemonic(), passphrase(passphrase) {
-    const char* mnemonic_chars = mnemonic_generate(strength);
-    mnemonic_to_seed(mnemonic_chars, passphrase.c_str(), seed.data(), nullptr);
-    mnemonic = mnemonic_chars;
-    updateEntropy();
+    : seed(), mnemonic(), passphrase(passphrase.begin(), passphrase.end()) {
+    std::array<char, BIP39_MNEMONIC_MAX> buffer;
+    auto randomEntropy = SecureData();
+    if (!generateMnemonic(strength, randomEntropy, buffer)) {
+        return;
+    }
+    // new mnemonic, not worth caching
+    mnemonic_to_seed(buffer.data(), passphrase.c_str(), seed.data(), nullptr);
+    mnemonic = buffer.data();
+    memzero(buffer.data(), buffer.size());
+    // the entropy of the words is the random one, no need to parse them
+    entropy = std::move(randomEntropy);
 }
 
 HDWallet::HDWallet(const std::string& mnemonic, const std::string& passphrase)
-    : seed(), mnemonic(mnemonic), passphrase(passphrase) {
-    mnemonic_to_seed(mnemonic.c_str(), passphrase.c_str(), seed.data(), nullptr);
+    : seed(), mnemonic(mnemonic.begin(), mnemonic.end()), passphrase(passphrase.begin(), passphrase.end()) {
+    mnemonicToSeed(mnemonic.c_str(), passphrase.c_str(), seed);
+    updateEntropy();
+}
+
+HDWallet::HDWallet(const std::string& mnemonic, const std::string& passphrase, const std::array<byte, seedSize>& seed)
+    : seed(seed), mnemonic(mnemonic.begin(), mnemonic.end()), passphrase(passphrase.begin(), passphrase.end()) {
     updateEntropy();
 }
 
 HDWallet::HDWallet(const Data& data, const std::string& passphrase)
-    : seed(), mnemonic(), passphrase(passphrase) {
-    const char* mnemonic_chars = mnemonic_from_data(data.data(), static_cast<int>(data.size()));
+    : seed(), mnemonic(), passphrase(passphrase.begin(), passphrase.end()) {
+    std::array<char, BIP39_MNEMONIC_MAX> buffer;
+    const char* mnemonic_chars = mnemonic_from_data_r(data.data(), static_cast<int>(data.size()), buffer.data(), buffer.size());
     if (mnemonic_chars) {
-        mnemonic_to_seed(mnemonic_chars, passphrase.c_str(), seed.data(), nullptr);
+        mnemonicToSeed(mnemonic_chars, passphrase.c_str(), seed);
         mnemonic = mnemonic_chars;
+        memzero(buffer.data(), buffer.size());
         updateEntropy();
     }
 }
 
+std::vector<std::array<byte, HDWallet::seedSize>> HDWallet::seedsFromMnemonics(const std::vector<std::string>& mnemonics, const std::vector<std::string>& passphrases) {
+    if (passphrases.size() != mnemonics.size() && passphrases.size() != 1) {
+        throw std::invalid_argument("Invalid number of passphrases");
+    }
+    // same inputs as mnemonic_to_seed: the passphrase is truncated to 256 characters
+    std::vector<Data> salts;
+    salts.reserve(passphrases.size());
+    for (const auto& passphrase : passphrases) {
+        auto salt = TW::data("mnemonic");
+        const auto length = strnlen(passphrase.c_str(), 256);
+        salt.insert(salt.end(), passphrase.begin(), passphrase.begin() + length);
+        salts.push_back(std::move(salt));
+    }
+
+    const auto count = mnemonics.size();
+    std::vector<const uint8_t*> passwords(count);
+    std::vector<int> passwordLengths(count);
+    std::vector<const uint8_t*> saltPointers(count);
+    std::vector<int> saltLengths(count);
+    for (size_t i = 0; i < count; ++i) {
+        passwords[i] = reinterpret_cast<const uint8_t*>(mnemonics[i].c_str());
+        passwordLengths[i] = static_cast<int>(strlen(mnemonics[i].c_str()));
+        const auto& salt = salts[salts.size() == 1 ? 0 : i];
+        saltPointers[i] = salt.data();
+        saltLengths[i] = static_cast<int>(salt.size());
+    }
+
+    std::vector<std::array<byte, seedSize>> seeds(count);
+    static_assert(sizeof(std::array<byte, seedSize>) == seedSize, "seeds must be contiguous");
+    pbkdf2_hmac_sha512_batch(passwords.data(), passwordLengths.data(), saltPointers.data(), saltLengths.data(),
+                             BIP39_PBKDF2_ROUNDS, reinterpret_cast<uint8_t*>(seeds.data()), count);
+    for (auto& salt : salts) {
+        memzero(salt.data(), salt.size());
+    }
+    return seeds;
+}
+
+HDWallet::HDWallet(SecureData entropy, const std::string& mnemonic, const std::string& passphrase, const std::array<byte, seedSize>& seed)
+    : seed(seed), mnemonic(mnemonic.begin(), mnemonic.end()), passphrase(passphrase.begin(), passphrase.end()),
+      entropy(std::move(entropy)) {}
+
+std::vector<HDWallet> HDWallet::createRandom(size_t count, int strength, const std::string& passphrase) {
+    std::vector<SecureData> entropies(count);
+    std::vector<std::string> mnemonics(count);
+    std::array<char, BIP39_MNEMONIC_MAX> buffer;
+    for (size_t i = 0; i < count; ++i) {
+        if (!generateMnemonic(strength, entropies[i], buffer)) {
+            throw std::invalid_argument("Invalid strength");
+        }
+        mnemonics[i] = buffer.data();
+    }
+    memzero(buffer.data(), buffer.size());
+
+    auto seeds = seedsFromMnemonics(mnemonics, {passphrase});
+    std::vector<HDWallet> wallets;
+    wallets.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        wallets.push_back(HDWallet(std::move(entropies[i]), mnemonics[i], passphrase, seeds[i]));
+        memzero(&mnemonics[i][0], mnemonics[i].size());
+        memzero(seeds[i].data(), seeds[i].size());
+    }
+    return wallets;
+}
+
 HDWallet::~HDWallet() {
     std::fill(seed.begin(), seed.end(), 0);
     std::fill(mnemonic.begin(), mnemonic.end(), 0);
@@ -64,10 +192,11 @@ HDWallet::~HDWallet() {
 
 void HDWallet::updateEntropy() {
     // generate entropy (from mnemonic)
-    Data entropyRaw(32 + 1);
+    SecureData entropyRaw(32 + 1);
     auto entropyBits = mnemonic_to_bits(mnemonic.c_str(), entropyRaw.data());
     // copy to truncate
-    entropy = data(entropyRaw.data(), entropyBits / 8);
+    entropy.assign(entropyRaw.begin(), entropyRaw.begin() + entropyBits / 8);
+    nodeCache.clear();
 }
 
 PrivateKey HDWallet::getMasterKey(TWCurve curve) const {
@@ -83,24 +212,11 @@ PrivateKey HDWallet::getMasterKeyExtension(TWCurve curve) const {
 }
 
 PrivateKey HDWallet::getKey(TWCoinType coin, const DerivationPath& derivationPath) const {
+    TW_INSTRUMENT_SCOPE("HDWallet::getKey");
     const auto curve = TWCoinTypeCurve(coin);
     const auto privateKeyType = getPrivateKeyType(curve);
     auto node = getNode(*this, curve, derivationPath);
-    switch (privateKeyType) {
-        case PrivateKeyTypeExtended96:
-            {
-                auto pkData = Data(node.private_key, node.private_key + PrivateKey::size);
-                auto extData = Data(node.private_key_extension, node.private_key_extension + PrivateKey::size);
-                auto chainCode = Data(node.chain_code, node.chain_code + PrivateKey::size);
-                return PrivateKey(pkData, extData, chainCode);
-            }
-
-        case PrivateKeyTypeDefault32:
-        default:
-            // default path
-            auto data = Data(node.private_key, node.private_key + PrivateKey::size);
-            return PrivateKey(data);
-    }
+    return privateKeyFromNode(node, privateKeyType);
 }
 
 std::string HDWallet::deriveAddress(TWCoinType coin) const {
@@ -108,6 +224,181 @@ std::string HDWallet::deriveAddress(TWCoinType coin) const {
     return TW::deriveAddress(coin, getKey(coin, derivationPath));
 }
 
+std::vector<std::string> HDWallet::deriveAddresses(TWCoinType coin, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count) const {
+    // a non-hardened index beyond 31 bits would silently derive the hardened child
+    if (firstIndex >= 0x80000000 || count > 0x80000000 - firstIndex) {
+        throw std::invalid_argument("Invalid address index");
+    }
+    const auto curve = TWCoinTypeCurve(coin);
+    const auto privateKeyType = getPrivateKeyType(curve);
+    // parent path, without the address index: m/purpose'/coin'/account'/change
+    const auto parentPath = DerivationPath({
+        DerivationPathIndex(TW::purpose(coin), true),
+        DerivationPathIndex(TW::slip44Id(coin), true),
+        DerivationPathIndex(account, true),
+        DerivationPathIndex(change, false),
+    });
+    auto parent = getNode(*this, curve, parentPath);
+    // the public key of the parent is hashed by every non-hardened child derivation, compute it once
+    if (parent.curve->params != nullptr &&
+        (curve != TWCurveSECP256k1 || !Secp256k1Comb::publicKey(DataView(parent.private_key, PrivateKey::size), true, parent.public_key))) {
+        hdnode_fill_public_key(&parent);
+    }
+
+    std::vector<std::string> addresses;
+    addresses.reserve(count);
+    const auto keyType = TW::publicKeyType(coin);
+    if (curve == TWCurveSECP256k1 && (keyType == TWPublicKeyTypeSECP256k1 || keyType == TWPublicKeyTypeSECP256k1Extended)) {
+        // child private keys first, then their public keys together: a single field inversion per batch
+        Data privateKeys(count * PrivateKey::size);
+        for (uint32_t i = 0; i < count; ++i) {
+            auto node = parent;
+            deriveChild(node, privateKeyType, DerivationPathIndex(firstIndex + i, false).derivationIndex());
+            std::memcpy(privateKeys.data() + i * PrivateKey::size, node.private_key, PrivateKey::size);
+            memzero(&node, sizeof(node));
+        }
+        const auto publicKeySize = keyType == TWPublicKeyTypeSECP256k1 ? PublicKey::secp256k1Size : PublicKey::secp256k1ExtendedSize;
+        Data publicKeys(count * publicKeySize);
+        const auto batched = Secp256k1Comb::publicKeys(privateKeys.data(), count, keyType == TWPublicKeyTypeSECP256k1, publicKeys.data());
+        for (uint32_t i = 0; i < count; ++i) {
+            if (batched) {
+                const auto begin = publicKeys.begin() + i * publicKeySize;
+                addresses.push_back(TW::deriveAddress(coin, PublicKey(Data(begin, begin + publicKeySize), keyType)));
+            } else {
+                addresses.push_back(TW::deriveAddress(coin, PrivateKey(DataView(privateKeys.data() + i * PrivateKey::size, PrivateKey::size))));
+            }
+        }
+        memzero(privateKeys.data(), privateKeys.size());
+        memzero(&parent, sizeof(parent));
+        return addresses;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        auto node = parent;
+        deriveChild(node, privateKeyType, DerivationPathIndex(firstIndex + i, false).derivationIndex());
+        addresses.push_back(TW::deriveAddress(coin, privateKeyFromNode(node, privateKeyType)));
+        memzero(&node, sizeof(node));
+    }
+    memzero(&parent, sizeof(parent));
+    return addresses;
+}
+
+std::vector<std::string> HDWallet::deriveAddresses(const std::vector<TWCoinType>& coins, size_t threadCount) const {
+    // group coins by curve and derivation path, each group needs a single key derivation
+    std::map<std::pair<TWCurve, std::string>, std::vector<size_t>> groupsByPath;
+    for (size_t i = 0; i < coins.size(); ++i) {
+        groupsByPath[std::make_pair(TWCoinTypeCurve(coins[i]), TW::derivationPath(coins[i]).string())].push_back(i);
+    }
+    std::vector<std::vector<size_t>> groups;
+    groups.reserve(groupsByPath.size());
+    for (auto& entry : groupsByPath) {
+        groups.push_back(std::move(entry.second));
+    }
+
+    std::vector<std::string> addresses(coins.size());
+    std::atomic<size_t> next(0);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+        try {
+            for (auto group = next++; group < groups.size(); group = next++) {
+                const auto& indices = groups[group];
+                const auto key = getKey(coins[indices[0]], TW::derivationPath(coins[indices[0]]));
+                std::map<TWPublicKeyType, PublicKey> publicKeys;
+                for (auto index : indices) {
+                    const auto keyType = TW::publicKeyType(coins[index]);
+                    auto publicKey = publicKeys.find(keyType);
+                    if (publicKey == publicKeys.end()) {
+                        publicKey = publicKeys.emplace(keyType, key.getPublicKey(keyType)).first;
+                    }
+                    addresses[index] = TW::deriveAddress(coins[index], publicKey->second);
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = std::current_exception();
+            }
+            next = groups.size();
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, groups.size(), worker);
+    if (error) {
+        std::rethrow_exception(error);
+    }
+    return addresses;
+}
+
+std::vector<PublicKey> HDWallet::deriveHardenedPublicKeys(TWCoinType coin, const DerivationPath& parent, uint32_t firstIndex, uint32_t count) const {
+    const auto curve = TWCoinTypeCurve(coin);
+    if (curve != TWCurveED25519 && curve != TWCurveED25519Blake2bNano) {
+        throw std::invalid_argument("Hardened public keys are only derived for ed25519 coins");
+    }
+    if (firstIndex >= 0x80000000 || count > 0x80000000 - firstIndex) {
+        throw std::invalid_argument("Invalid hardened index");
+    }
+    auto node = getNode(*this, curve, parent);
+
+    // SLIP-10: the key and chain code of child i are HMAC-SHA512(chain code, 0x00 || key || i | 0x80000000),
+    // the pads of the key are the same for all siblings
+    uint64_t innerPad[8];
+    uint64_t outerPad[8];
+    hmac_sha512_prepare(node.chain_code, sizeof(node.chain_code), outerPad, innerPad);
+    std::array<byte, 37> message;
+    message[0] = 0;
+    std::copy(node.private_key, node.private_key + 32, message.begin() + 1);
+
+    std::vector<std::array<byte, 32>> secrets(count);
+    std::array<byte, 64> digest;
+    for (uint32_t i = 0; i < count; ++i) {
+        const auto index = (firstIndex + i) | 0x80000000;
+        message[33] = static_cast<byte>(index >> 24);
+        message[34] = static_cast<byte>(index >> 16);
+        message[35] = static_cast<byte>(index >> 8);
+        message[36] = static_cast<byte>(index);
+
+        SHA512_CTX context;
+        std::copy(innerPad, innerPad + 8, context.state);
+        context.bitcount[0] = SHA512_BLOCK_LENGTH * 8;
+        context.bitcount[1] = 0;
+        sha512_Update(&context, message.data(), message.size());
+        sha512_Final(&context, digest.data());
+        std::copy(outerPad, outerPad + 8, context.state);
+        context.bitcount[0] = SHA512_BLOCK_LENGTH * 8;
+        context.bitcount[1] = 0;
+        sha512_Update(&context, digest.data(), SHA512_DIGEST_LENGTH);
+        sha512_Final(&context, digest.data());
+        memzero(&context, sizeof(context));
+        std::copy(digest.begin(), digest.begin() + 32, secrets[i].begin());
+    }
+
+    std::vector<std::array<byte, 32>> publicKeys(count);
+    static_assert(sizeof(std::array<byte, 32>) == 32, "keys must be contiguous");
+    const auto secretKeys = reinterpret_cast<const ed25519_secret_key*>(secrets.data());
+    const auto publicKeyBytes = reinterpret_cast<ed25519_public_key*>(publicKeys.data());
+    if (curve == TWCurveED25519) {
+        ed25519_publickey_batch(secretKeys, count, publicKeyBytes);
+    } else {
+        ed25519_publickey_batch_blake2b(secretKeys, count, publicKeyBytes);
+    }
+
+    memzero(innerPad, sizeof(innerPad));
+    memzero(outerPad, sizeof(outerPad));
+    memzero(message.data(), message.size());
+    memzero(digest.data(), digest.size());
+    memzero(secrets.data(), secrets.size() * sizeof(secrets[0]));
+    memzero(&node, sizeof(node));
+
+    const auto type = curve == TWCurveED25519 ? TWPublicKeyTypeED25519 : TWPublicKeyTypeED25519Blake2b;
+    std::vector<PublicKey> result;
+    result.reserve(count);
+    for (const auto& bytes : publicKeys) {
+        result.emplace_back(Data(bytes.begin(), bytes.end()), type);
+    }
+    return result;
+}
+
 std::string HDWallet::getExtendedPrivateKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const {
     if (version == TWHDVersionNone) {
         return "";
@@ -116,9 +407,11 @@ std::string HDWallet::getExtendedPrivateKey(TWPurpose purpose, TWCoinType coin,
     const auto curve = TWCoinTypeCurve(coin);
     auto derivationPath = TW::DerivationPath({DerivationPathIndex(purpose, true), DerivationPathIndex(coin, true)});
     auto node = getNode(*this, curve, derivationPath);
-    auto fingerprintValue = fingerprint(&node, publicKeyHasher(coin));
+    auto fingerprintValue = fingerprint(&node, curve, publicKeyHasher(coin));
     hdnode_private_ckd(&node, 0x80000000);
-    return serialize(&node, fingerprintValue, version, false, base58Hasher(coin));
+    auto extended = serialize(&node, fingerprintValue, version, false, base58Hasher(coin));
+    memzero(&node, sizeof(node));
+    return extended;
 }
 
 std::string HDWallet::getExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const {
@@ -126,13 +419,36 @@ std::string HDWallet::getExtendedPublicKey(TWPurpose purpose, TWCoinType coin, T
         return "";
     }
     
+    std::string extended;
+    if (nodeCache.findExtendedPublicKey(purpose, coin, version, extended)) {
+        return extended;
+    }
     const auto curve = TWCoinTypeCurve(coin);
     auto derivationPath = TW::DerivationPath({DerivationPathIndex(purpose, true), DerivationPathIndex(coin, true)});
     auto node = getNode(*this, curve, derivationPath);
-    auto fingerprintValue = fingerprint(&node, publicKeyHasher(coin));
+    auto fingerprintValue = fingerprint(&node, curve, publicKeyHasher(coin));
     hdnode_private_ckd(&node, 0x80000000);
-    hdnode_fill_public_key(&node);
-    return serialize(&node, fingerprintValue, version, true, base58Hasher(coin));
+    fillPublicKey(node, curve);
+    extended = serialize(&node, fingerprintValue, version, true, base58Hasher(coin));
+    memzero(&node, sizeof(node));
+    nodeCache.insertExtendedPublicKey(purpose, coin, version, extended);
+    return extended;
+}
+
+std::vector<std::string> HDWallet::getExtendedPublicKeys(const std::vector<TWCoinType>& coins, size_t threadCount) const {
+    std::vector<std::string> extended(coins.size());
+    ThreadPool::shared().parallelFor(coins.size(), threadCount, [&](size_t i) {
+        extended[i] = getExtendedPublicKey(TW::purpose(coins[i]), coins[i], TW::xpubVersion(coins[i]));
+    });
+    return extended;
+}
+
+std::optional<HDNode> HDWallet::getNodeFromExtended(const std::string& extended, TWCoinType coin) {
+    auto node = HDNode{};
+    if (!deserialize(extended, TW::curve(coin), TW::base58Hasher(coin), &node)) {
+        return {};
+    }
+    return node;
 }
 
 std::optional<PublicKey> HDWallet::getPublicKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path) {
@@ -188,29 +504,36 @@ HDWallet::PrivateKeyType HDWallet::getPrivateKeyType(TWCurve curve) {
 
 namespace {
 
-uint32_t fingerprint(HDNode *node, Hash::Hasher hasher) {
-    hdnode_fill_public_key(node);
+void fillPublicKey(HDNode& node, TWCurve curve) {
+    // the comb tables are faster than the generic point multiplication
+    if (curve != TWCurveSECP256k1 || !Secp256k1Comb::publicKey(DataView(node.private_key, PrivateKey::size), true, node.public_key)) {
+        hdnode_fill_public_key(&node);
+    }
+}
+
+uint32_t fingerprint(HDNode *node, TWCurve curve, const Hash::Hasher& hasher) {
+    fillPublicKey(*node, curve);
     auto digest = hasher(node->public_key, 33);
     return ((uint32_t) digest[0] << 24) + (digest[1] << 16) + (digest[2] << 8) + digest[3];
 }
 
-std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version, bool use_public, Hash::Hasher hasher) {
-    Data node_data;
-    node_data.reserve(78);
-
-    encode32BE(version, node_data);
-    node_data.push_back(static_cast<uint8_t>(node->depth));
-    encode32BE(fingerprint, node_data);
-    encode32BE(node->child_num, node_data);
-    node_data.insert(node_data.end(), node->chain_code, node->chain_code + 32);
+std::string serialize(const HDNode *node, uint32_t fingerprint, uint32_t version, bool use_public, const Hash::Hasher& hasher) {
+    std::array<byte, 78> node_data;
+    encode32BE(version, node_data.data());
+    node_data[4] = static_cast<uint8_t>(node->depth);
+    encode32BE(fingerprint, node_data.data() + 5);
+    encode32BE(node->child_num, node_data.data() + 9);
+    std::copy(node->chain_code, node->chain_code + 32, node_data.begin() + 13);
     if (use_public) {
-        node_data.insert(node_data.end(), node->public_key, node->public_key + 33);
+        std::copy(node->public_key, node->public_key + 33, node_data.begin() + 45);
     } else {
-        node_data.push_back(0);
-        node_data.insert(node_data.end(), node->private_key, node->private_key + 32);
+        node_data[45] = 0;
+        std::copy(node->private_key, node->private_key + 32, node_data.begin() + 46);
     }
 
-    return Base58::bitcoin.encodeCheck(node_data, hasher);
+    auto extended = Base58::bitcoin.encodeCheck(node_data.data(), node_data.data() + node_data.size(), hasher);
+    memzero(node_data.data(), node_data.size());
+    return extended;
 }
 
 bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher, HDNode* node) {
@@ -246,22 +569,54 @@ bool deserialize(const std::string& extended, TWCurve curve, Hash::Hasher hasher
 
 HDNode getNode(const HDWallet& wallet, TWCurve curve, const DerivationPath& derivationPath) {
     const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
-    auto node = getMasterNode(wallet, curve);
-    for (auto& index : derivationPath.indices) {
-        switch (privateKeyType) {
-            case HDWallet::PrivateKeyTypeExtended96:
-                // special handling for extended
-                hdnode_private_ckd_cardano(&node, index.derivationIndex());
-                break;
-            case HDWallet::PrivateKeyTypeDefault32:
-            default:
-                hdnode_private_ckd(&node, index.derivationIndex());
-                break;
+    const auto depth = derivationPath.indices.size();
+    if (depth == 0) {
+        return getMasterNode(wallet, curve);
+    }
+
+    // Start from the longest cached prefix (leaf nodes are not cached, only their parents)
+    auto node = HDNode();
+    size_t start = 0;
+    if (!wallet.nodeCache.findLongestPrefix(curve, derivationPath, depth - 1, node, start)) {
+        node = getMasterNode(wallet, curve);
+        wallet.nodeCache.insert(curve, derivationPath, 0, node);
+    }
+    for (auto i = start; i < depth; ++i) {
+        deriveChild(node, privateKeyType, derivationPath.indices[i].derivationIndex());
+        if (i + 1 < depth) {
+            wallet.nodeCache.insert(curve, derivationPath, i + 1, node);
         }
     }
     return node;
 }
 
+void deriveChild(HDNode& node, HDWallet::PrivateKeyType privateKeyType, uint32_t index) {
+    switch (privateKeyType) {
+        case HDWallet::PrivateKeyTypeExtended96:
+            // special handling for extended
+            hdnode_private_ckd_cardano(&node, index);
+            break;
+        case HDWallet::PrivateKeyTypeDefault32:
+        default:
+            hdnode_private_ckd(&node, index);
+            break;
+    }
+}
+
+PrivateKey privateKeyFromNode(const HDNode& node, HDWallet::PrivateKeyType privateKeyType) {
+    switch (privateKeyType) {
+        case HDWallet::PrivateKeyTypeExtended96:
+            return PrivateKey(DataView(node.private_key, PrivateKey::size),
+                              DataView(node.private_key_extension, PrivateKey::size),
+                              DataView(node.chain_code, PrivateKey::size));
+
+        case HDWallet::PrivateKeyTypeDefault32:
+        default:
+            // default path
+            return PrivateKey(DataView(node.private_key, PrivateKey::size));
+    }
+}
+
 HDNode getMasterNode(const HDWallet& wallet, TWCurve curve) {
     const auto privateKeyType = HDWallet::getPrivateKeyType(curve);
     auto node = HDNode();
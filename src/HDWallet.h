@@ -8,9 +8,11 @@
 
 #include "Data.h"
 #include "DerivationPath.h"
+#include "HDNodeCache.h"
 #include "Hash.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
+#include "SecureMemory.h"
 
 #include <TrustWalletCore/TWCoinType.h>
 #include <TrustWalletCore/TWCurve.h>
@@ -20,6 +22,7 @@
 #include <array>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace TW {
 
@@ -34,13 +37,16 @@ class HDWallet {
     std::array<byte, seedSize> seed;
 
     /// Mnemonic word list.
-    std::string mnemonic;
+    SecureString mnemonic;
 
     /// Mnemonic passphrase.
-    std::string passphrase;
+    SecureString passphrase;
 
     /// Entropy bytes (11 bits from each word)
-    TW::Data entropy;
+    SecureData entropy;
+
+    /// Cache of intermediate derivation nodes; must be cleared if the seed or entropy is changed in place.
+    mutable HDNodeCache nodeCache;
 
   public:
     /// Initializes a new random HDWallet with the provided strength in bits.
@@ -49,6 +55,10 @@ class HDWallet {
     /// Initializes an HDWallet from a mnemonic seed.
     HDWallet(const std::string& mnemonic, const std::string& passphrase);
 
+    /// Initializes an HDWallet from a mnemonic and its seed, already derived with the passphrase (by
+    /// `seedsFromMnemonics` for instance), without a second seed derivation.  The seed is not checked.
+    HDWallet(const std::string& mnemonic, const std::string& passphrase, const std::array<byte, seedSize>& seed);
+
     /// Initializes an HDWallet from a seed.
     HDWallet(const Data& data, const std::string& passphrase);
 
@@ -73,18 +83,67 @@ class HDWallet {
     /// Derives the address for a coin.
     std::string deriveAddress(TWCoinType coin) const;
 
+    /// Derives `count` consecutive addresses for a coin, using the BIP44 path
+    /// m/purpose'/coin'/account'/change/index with index starting at `firstIndex`.
+    /// The parent node is derived only once, each address costs a single child derivation;
+    /// secp256k1 public keys are computed together, sharing their conversion to affine coordinates.
+    ///
+    /// @throws std::invalid_argument if an index does not fit in 31 bits.
+    std::vector<std::string> deriveAddresses(TWCoinType coin, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count) const;
+
+    /// Derives the default address of each coin, returned in the same order as `coins`.
+    /// Coins sharing a curve and derivation path share a single key (and public key) derivation,
+    /// the work is spread over `threadCount` threads (0: one per hardware thread).
+    std::vector<std::string> deriveAddresses(const std::vector<TWCoinType>& coins, size_t threadCount = 0) const;
+
+    /// Derives the public keys of `count` consecutive hardened children of `parent`, at
+    /// parent/(firstIndex + i)', for ed25519 coins whose SLIP-10 paths are hardened only (Solana,
+    /// Stellar, NEAR, Algorand, Elrond, Kin, Nano...).
+    /// The parent node is derived once and the HMAC key pads of its chain code hashed once, so that each
+    /// child costs two SHA-512 compressions; the public keys share their field inversions.
+    ///
+    /// @throws std::invalid_argument if the coin does not use ed25519 or an index does not fit in 31 bits.
+    std::vector<PublicKey> deriveHardenedPublicKeys(TWCoinType coin, const DerivationPath& parent, uint32_t firstIndex, uint32_t count) const;
+
     /// Returns the extended private key.
     std::string getExtendedPrivateKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const;
 
-    /// Returns the exteded public key.
+    /// Returns the exteded public key.  Cached by the wallet, as the account path is derived again otherwise.
     std::string getExtendedPublicKey(TWPurpose purpose, TWCoinType coin, TWHDVersion version) const;
 
+    /// Returns the extended public key of each coin, with its default purpose and xpub version, in the same order
+    /// as `coins`; empty for coins without extended keys.  Spread over `threadCount` threads (0: one per hardware
+    /// thread).
+    std::vector<std::string> getExtendedPublicKeys(const std::vector<TWCoinType>& coins, size_t threadCount = 0) const;
+
+    /// Parses an extended public or private key representation into a BIP32 node.
+    static std::optional<HDNode> getNodeFromExtended(const std::string& extended, TWCoinType coin);
+
     /// Computes the public key from an exteded public key representation.
     static std::optional<PublicKey> getPublicKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path);
 
     /// Computes the private key from an exteded private key representation.
     static std::optional<PrivateKey> getPrivateKeyFromExtended(const std::string& extended, TWCoinType coin, const DerivationPath& path);
 
+    /// Computes the BIP39 seeds of many mnemonics at once, computing several seeds together
+    /// with multi-buffer PBKDF2 where the CPU supports it. Mnemonics are not validated and
+    /// seeds are not cached.
+    /// `passphrases` holds either one passphrase per mnemonic, or a single one for all.
+    ///
+    /// @throws std::invalid_argument if the number of passphrases does not match.
+    static std::vector<std::array<byte, seedSize>> seedsFromMnemonics(const std::vector<std::string>& mnemonics, const std::vector<std::string>& passphrases);
+
+    /// Initializes `count` new random HDWallets with the provided strength in bits and a shared passphrase, for the
+    /// bulk creation of wallets: their seeds are computed together, as by `seedsFromMnemonics`, and their entropy
+    /// is not parsed again from the mnemonic.
+    ///
+    /// @throws std::invalid_argument if the strength is not a multiple of 32 bits from 128 to 256.
+    static std::vector<HDWallet> createRandom(size_t count, int strength, const std::string& passphrase);
+
+  private:
+    /// Initializes an HDWallet whose entropy, mnemonic and seed are known already.
+    HDWallet(SecureData entropy, const std::string& mnemonic, const std::string& passphrase, const std::array<byte, seedSize>& seed);
+
   public:
     // Private key type (later could be moved out of HDWallet)
     enum PrivateKeyType {
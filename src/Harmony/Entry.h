@@ -17,7 +17,9 @@ public:
     virtual const std::vector<TWCoinType> coinTypes() const { return {TWCoinTypeHarmony}; }
     virtual bool validateAddress(TWCoinType coin, const std::string& address, TW::byte p2pkh, TW::byte p2sh, const char* hrp) const;
     virtual std::string deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byte p2pkh, const char* hrp) const;
-    virtual void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
+    virtual void sign(TWCoinType coin, DataView dataIn, Data& dataOut) const;
+    virtual bool signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const;
+    virtual std::unique_ptr<SigningTemplate> signingTemplate(TWCoinType coin, const Data& dataIn) const;
 };
 
 } // namespace TW::Harmony
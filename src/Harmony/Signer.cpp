@@ -6,12 +6,236 @@
 
 #include "Signer.h"
 #include "../Ethereum/RLP.h"
+#include "../Ethereum/RLPWriter.h"
+#include "../Hashers.h"
 #include "../HexCoding.h"
+#include "../BatchSigning.h"
 
+#include <optional>
+#include <type_traits>
+#include <variant>
 
 using namespace TW;
 using namespace TW::Harmony;
 
+// RLP items of transactions and directives, written with an Ethereum RLPSizer or RLPWriter
+
+template <typename RLP>
+static void descriptionItems(RLP& rlp, const Description& description) {
+    rlp.list([&](auto& list) {
+        list.item(description.name)
+            .item(description.identity)
+            .item(description.website)
+            .item(description.securityContact)
+            .item(description.details);
+    });
+}
+
+template <typename RLP>
+static void directiveItems(RLP& rlp, const CreateValidator& msg) {
+    rlp.list([&](auto& list) {
+        list.item(msg.validatorAddress.getKeyHash());
+        descriptionItems(list, msg.description);
+        list.list([&](auto& commission) {
+            commission.list([&](auto& rate) { rate.item(msg.commissionRates.rate.value); })
+                .list([&](auto& rate) { rate.item(msg.commissionRates.maxRate.value); })
+                .list([&](auto& rate) { rate.item(msg.commissionRates.maxChangeRate.value); });
+        });
+        list.item(msg.minSelfDelegation)
+            .item(msg.maxTotalDelegation)
+            .itemList(msg.slotPubKeys)
+            .itemList(msg.slotKeySigs)
+            .item(msg.amount);
+    });
+}
+
+template <typename RLP>
+static void directiveItems(RLP& rlp, const EditValidator& msg) {
+    rlp.list([&](auto& list) {
+        list.item(msg.validatorAddress.getKeyHash());
+        descriptionItems(list, msg.description);
+        list.list([&](auto& rate) {
+            if (msg.commissionRate.has_value()) {
+                // Note: std::optional.value() is not available in XCode with target < iOS 12; using '*'
+                rate.item((*msg.commissionRate).value);
+            }
+        });
+        list.item(msg.minSelfDelegation)
+            .item(msg.maxTotalDelegation)
+            .item(msg.slotKeyToRemove)
+            .item(msg.slotKeyToAdd)
+            .item(msg.slotKeyToAddSig)
+            .item(msg.active);
+    });
+}
+
+template <typename RLP>
+static void directiveItems(RLP& rlp, const Delegate& msg) {
+    rlp.list([&](auto& list) {
+        list.item(msg.delegatorAddress.getKeyHash()).item(msg.validatorAddress.getKeyHash()).item(msg.amount);
+    });
+}
+
+template <typename RLP>
+static void directiveItems(RLP& rlp, const Undelegate& msg) {
+    rlp.list([&](auto& list) {
+        list.item(msg.delegatorAddress.getKeyHash()).item(msg.validatorAddress.getKeyHash()).item(msg.amount);
+    });
+}
+
+template <typename RLP>
+static void directiveItems(RLP& rlp, const CollectRewards& msg) {
+    rlp.list([&](auto& list) { list.item(msg.delegatorAddress.getKeyHash()); });
+}
+
+/// Signature values, or the chain identifier and zeros of the preimage
+template <typename RLP, typename T>
+static void signatureItems(RLP& rlp, const T& transaction, bool include_vrs, const uint256_t& chainID) {
+    if (include_vrs) {
+        rlp.item(transaction.v).item(transaction.r).item(transaction.s);
+    } else {
+        rlp.item(chainID).item(0).item(0);
+    }
+}
+
+template <typename RLP>
+static void transactionItems(RLP& rlp, const Transaction& transaction, bool include_vrs, const uint256_t& chainID) {
+    rlp.list([&](auto& list) {
+        list.item(transaction.nonce)
+            .item(transaction.gasPrice)
+            .item(transaction.gasLimit)
+            .item(transaction.fromShardID)
+            .item(transaction.toShardID)
+            .item(transaction.to.getKeyHash())
+            .item(transaction.amount)
+            .item(transaction.payload);
+        signatureItems(list, transaction, include_vrs, chainID);
+    });
+}
+
+template <typename RLP, typename Directive>
+static void stakingItems(RLP& rlp, const Staking<Directive>& transaction, bool include_vrs, const uint256_t& chainID) {
+    rlp.list([&](auto& list) {
+        list.item(transaction.directive);
+        directiveItems(list, transaction.stakeMsg);
+        list.item(transaction.nonce).item(transaction.gasPrice).item(transaction.gasLimit);
+        signatureItems(list, transaction, include_vrs, chainID);
+    });
+}
+
+/// Last decoded address, reused while the same address string repeats
+struct AddressCache {
+    std::string string;
+    Address address;
+    bool valid = false;
+
+    bool decode(const std::string& value, Address& out) {
+        if (!valid || value != string) {
+            valid = Address::decode(value, address);
+            string = value;
+        }
+        if (valid) {
+            out = address;
+        }
+        return valid;
+    }
+};
+
+static std::optional<Transaction> transactionFrom(const Proto::SigningInput& input, AddressCache& recipients) {
+    const auto& message = input.transaction_message();
+    Address toAddr;
+    if (!recipients.decode(message.to_address(), toAddr)) {
+        return std::nullopt;
+    }
+    return Transaction(
+        /* nonce: */ load(message.nonce()),
+        /* gasPrice: */ load(message.gas_price()),
+        /* gasLimit: */ load(message.gas_limit()),
+        /* fromShardID */ load(message.from_shard_id()),
+        /* toShardID */ load(message.to_shard_id()),
+        /* to: */ toAddr,
+        /* amount: */ load(message.amount()),
+        /* payload: */ Data(message.payload().begin(), message.payload().end()));
+}
+
+template <typename Directive>
+static Staking<Directive> stakingFrom(const Proto::SigningInput& input, uint8_t directive, Directive stakeMsg) {
+    return Staking<Directive>(directive, std::move(stakeMsg), load(input.staking_message().nonce()),
+                              load(input.staking_message().gas_price()),
+                              load(input.staking_message().gas_limit()), load(input.chain_id()), 0, 0);
+}
+
+static std::optional<Staking<Delegate>> delegateFrom(const Proto::SigningInput& input, AddressCache& delegators,
+                                                     AddressCache& validators) {
+    const auto& message = input.staking_message().delegate_message();
+    Address delegatorAddr;
+    Address validatorAddr;
+    if (!delegators.decode(message.delegator_address(), delegatorAddr) ||
+        !validators.decode(message.validator_address(), validatorAddr)) {
+        return std::nullopt;
+    }
+    return stakingFrom(input, DirectiveDelegate, Delegate(delegatorAddr, validatorAddr, load(message.amount())));
+}
+
+static std::optional<Staking<Undelegate>> undelegateFrom(const Proto::SigningInput& input, AddressCache& delegators,
+                                                         AddressCache& validators) {
+    const auto& message = input.staking_message().undelegate_message();
+    Address delegatorAddr;
+    Address validatorAddr;
+    if (!delegators.decode(message.delegator_address(), delegatorAddr) ||
+        !validators.decode(message.validator_address(), validatorAddr)) {
+        return std::nullopt;
+    }
+    return stakingFrom(input, DirectiveUndelegate, Undelegate(delegatorAddr, validatorAddr, load(message.amount())));
+}
+
+static std::optional<Staking<CollectRewards>> collectRewardsFrom(const Proto::SigningInput& input,
+                                                                 AddressCache& delegators) {
+    Address delegatorAddr;
+    if (!delegators.decode(input.staking_message().collect_rewards().delegator_address(), delegatorAddr)) {
+        return std::nullopt;
+    }
+    return stakingFrom(input, DirectiveCollectRewards, CollectRewards(delegatorAddr));
+}
+
+/// Inputs signed by signBatch() with the shared key state; validators are signed one by one
+static bool isBatched(const Proto::SigningInput& input) {
+    if (input.has_transaction_message()) {
+        return true;
+    }
+    const auto& staking = input.staking_message();
+    return input.has_staking_message() && !staking.has_create_validator_message() &&
+           !staking.has_edit_validator_message() &&
+           (staking.has_delegate_message() || staking.has_undelegate_message() || staking.has_collect_rewards());
+}
+
+/// Transaction of a batched input, empty if an address is invalid
+using BatchTransaction =
+    std::variant<std::monostate, Transaction, Staking<Delegate>, Staking<Undelegate>, Staking<CollectRewards>>;
+
+template <typename T>
+static BatchTransaction batchTransaction(std::optional<T>&& transaction) {
+    if (!transaction) {
+        return std::monostate();
+    }
+    return std::move(*transaction);
+}
+
+static BatchTransaction batchTransaction(const Proto::SigningInput& input, AddressCache& recipients,
+                                         AddressCache& delegators, AddressCache& validators) {
+    if (input.has_transaction_message()) {
+        return batchTransaction(transactionFrom(input, recipients));
+    }
+    const auto& staking = input.staking_message();
+    if (staking.has_delegate_message()) {
+        return batchTransaction(delegateFrom(input, delegators, validators));
+    }
+    if (staking.has_undelegate_message()) {
+        return batchTransaction(undelegateFrom(input, delegators, validators));
+    }
+    return batchTransaction(collectRewardsFrom(input, delegators));
+}
+
 std::tuple<uint256_t, uint256_t, uint256_t> Signer::values(const uint256_t &chainID,
                                                            const Data& signature) noexcept {
     auto r = load(Data(signature.begin(), signature.begin() + 32));
@@ -70,30 +294,15 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
 
 Proto::SigningOutput Signer::signTransaction(const Proto::SigningInput &input) noexcept {
     auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    Address toAddr;
-    if (!Address::decode(input.transaction_message().to_address(), toAddr)) {
+    AddressCache addresses;
+    auto transaction = transactionFrom(input, addresses);
+    if (!transaction) {
         // invalid to address
         return Proto::SigningOutput();
     }
-    auto transaction = Transaction(
-        /* nonce: */ load(input.transaction_message().nonce()),
-        /* gasPrice: */ load(input.transaction_message().gas_price()),
-        /* gasLimit: */ load(input.transaction_message().gas_limit()),
-        /* fromShardID */ load(input.transaction_message().from_shard_id()),
-        /* toShardID */ load(input.transaction_message().to_shard_id()),
-        /* to: */ toAddr,
-        /* amount: */ load(input.transaction_message().amount()),
-        /* payload: */
-        Data(input.transaction_message().payload().begin(),
-             input.transaction_message().payload().end()));
-
     auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash(transaction);
-    signer.sign(key, hash, transaction);
-    auto protoOutput = Proto::SigningOutput();
-    auto encoded = signer.rlpNoHash(transaction, true);
-
-    return prepareOutput<Transaction>(encoded, transaction);
+    signer.sign(key, signer.hash(*transaction), *transaction);
+    return prepareOutput<Transaction>(signer.rlpNoHash(*transaction, true), *transaction);
 }
 
 Proto::SigningOutput Signer::signCreateValidator(const Proto::SigningInput &input) noexcept {
@@ -238,86 +447,85 @@ Proto::SigningOutput Signer::signEditValidator(const Proto::SigningInput &input)
 }
 
 Proto::SigningOutput Signer::signDelegate(const Proto::SigningInput &input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-
-    Address delegatorAddr;
-    if (!Address::decode(input.staking_message().delegate_message().delegator_address(),
-                         delegatorAddr)) {
-        // invalid to address
-        return Proto::SigningOutput();
-    }
-    Address validatorAddr;
-    if (!Address::decode(input.staking_message().delegate_message().validator_address(),
-                         validatorAddr)) {
-        // invalid to address
-        return Proto::SigningOutput();
-    }
-    auto delegate = Delegate(delegatorAddr, validatorAddr,
-                             load(input.staking_message().delegate_message().amount()));
-    auto stakingTx =
-        Staking<Delegate>(DirectiveDelegate, delegate, load(input.staking_message().nonce()),
-                          load(input.staking_message().gas_price()),
-                          load(input.staking_message().gas_limit()), load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<Delegate>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<Delegate>(stakingTx, true);
-
-    return prepareOutput<Staking<Delegate>>(encoded, stakingTx);
+    AddressCache delegators, validators;
+    return signStaking(input, delegateFrom(input, delegators, validators));
 }
 
 Proto::SigningOutput Signer::signUndelegate(const Proto::SigningInput &input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-
-    Address delegatorAddr;
-    if (!Address::decode(input.staking_message().undelegate_message().delegator_address(),
-                         delegatorAddr)) {
-        // invalid to address
-        return Proto::SigningOutput();
-    }
-    Address validatorAddr;
-    if (!Address::decode(input.staking_message().undelegate_message().validator_address(),
-                         validatorAddr)) {
-        // invalid to address
-        return Proto::SigningOutput();
-    }
-    auto undelegate = Undelegate(delegatorAddr, validatorAddr,
-                                 load(input.staking_message().undelegate_message().amount()));
-    auto stakingTx = Staking<Undelegate>(
-        DirectiveUndelegate, undelegate, load(input.staking_message().nonce()),
-        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
-        load(input.chain_id()), 0, 0);
-
-    auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<Undelegate>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<Undelegate>(stakingTx, true);
-
-    return prepareOutput<Staking<Undelegate>>(encoded, stakingTx);
+    AddressCache delegators, validators;
+    return signStaking(input, undelegateFrom(input, delegators, validators));
 }
 
 Proto::SigningOutput Signer::signCollectRewards(const Proto::SigningInput &input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    AddressCache delegators;
+    return signStaking(input, collectRewardsFrom(input, delegators));
+}
 
-    Address delegatorAddr;
-    if (!Address::decode(input.staking_message().collect_rewards().delegator_address(),
-                         delegatorAddr)) {
-        // invalid to address
+template <typename Directive>
+Proto::SigningOutput Signer::signStaking(const Proto::SigningInput &input,
+                                         std::optional<Staking<Directive>> stakingTx) noexcept {
+    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    if (!stakingTx) {
+        // invalid address
         return Proto::SigningOutput();
     }
-    auto collectRewards = CollectRewards(delegatorAddr);
-    auto stakingTx = Staking<CollectRewards>(
-        DirectiveCollectRewards, collectRewards, load(input.staking_message().nonce()),
-        load(input.staking_message().gas_price()), load(input.staking_message().gas_limit()),
-        load(input.chain_id()), 0, 0);
-
     auto signer = Signer(uint256_t(load(input.chain_id())));
-    auto hash = signer.hash<CollectRewards>(stakingTx);
-    signer.sign(key, hash, stakingTx);
-    auto encoded = signer.rlpNoHash<CollectRewards>(stakingTx, true);
+    signer.sign(key, signer.hash(*stakingTx), *stakingTx);
+    return prepareOutput<Staking<Directive>>(signer.rlpNoHash(*stakingTx, true), *stakingTx);
+}
 
-    return prepareOutput<Staking<CollectRewards>>(encoded, stakingTx);
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    // validator creations and edits are runs of their own, signed by sign()
+    const auto sameRun = [](const auto& first, const auto& input) {
+        return isBatched(first) && isBatched(input) && input.private_key() == first.private_key();
+    };
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, sameRun, [&](size_t begin, size_t end, auto& outputs) {
+        if (!isBatched(inputs[begin])) {
+            outputs[begin] = sign(inputs[begin]);
+            return;
+        }
+        const auto& keyBytes = inputs[begin].private_key();
+        const auto key = PrivateKey(Data(keyBytes.begin(), keyBytes.end()));
+        // addresses repeated across inputs, e.g. the validator of successive delegations, are decoded once
+        AddressCache recipients, delegators, validators;
+        std::vector<BatchTransaction> transactions;
+        std::vector<Signer> signers;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            transactions.push_back(batchTransaction(inputs[i], recipients, delegators, validators));
+            signers.emplace_back(uint256_t(load(inputs[i].chain_id())));
+            digests.push_back(std::visit([&](const auto& transaction) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(transaction)>, std::monostate>) {
+                    // invalid address
+                    outputs[i].set_error(Common::Proto::Error_general);
+                    return Data(32);
+                } else {
+                    return signers.back().hash(transaction);
+                }
+            }, transactions.back()));
+        }
+        std::vector<Data> signatures;
+        key.signBatch(digests, TWCurveSECP256k1, signatures);
+        for (auto i = begin; i < end; ++i) {
+            const auto& signature = signatures[i - begin];
+            std::visit([&](auto& transaction) {
+                if constexpr (!std::is_same_v<std::decay_t<decltype(transaction)>, std::monostate>) {
+                    if (!signature.empty()) {
+                        outputs[i] = signers[i - begin].signedOutput(signature, transaction);
+                    }
+                }
+            }, transactions[i - begin]);
+        }
+    });
+}
+
+template <typename T>
+Proto::SigningOutput Signer::signedOutput(const Data& signature, T &transaction) const noexcept {
+    auto tuple = values(chainID, signature);
+    transaction.r = std::get<0>(tuple);
+    transaction.s = std::get<1>(tuple);
+    transaction.v = std::get<2>(tuple);
+    return prepareOutput<T>(rlpNoHash(transaction, true), transaction);
 }
 
 template <typename T>
@@ -329,158 +537,33 @@ void Signer::sign(const PrivateKey &privateKey, const Data& hash, T &transaction
 }
 
 Data Signer::rlpNoHash(const Transaction &transaction, const bool include_vrs) const noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-    append(encoded, RLP::encode(transaction.nonce));
-    append(encoded, RLP::encode(transaction.gasPrice));
-    append(encoded, RLP::encode(transaction.gasLimit));
-    append(encoded, RLP::encode(transaction.fromShardID));
-    append(encoded, RLP::encode(transaction.toShardID));
-    append(encoded, RLP::encode(transaction.to.getKeyHash()));
-    append(encoded, RLP::encode(transaction.amount));
-    append(encoded, RLP::encode(transaction.payload));
-    if (include_vrs) {
-        append(encoded, RLP::encode(transaction.v));
-        append(encoded, RLP::encode(transaction.r));
-        append(encoded, RLP::encode(transaction.s));
-    } else {
-        append(encoded, RLP::encode(chainID));
-        append(encoded, RLP::encode(0));
-        append(encoded, RLP::encode(0));
-    }
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { transactionItems(rlp, transaction, include_vrs, chainID); });
 }
 
 template <typename Directive>
 Data Signer::rlpNoHash(const Staking<Directive> &transaction, const bool include_vrs) const
     noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-    append(encoded, RLP::encode(transaction.directive));
-    append(encoded, rlpNoHashDirective(transaction));
-
-    append(encoded, RLP::encode(transaction.nonce));
-    append(encoded, RLP::encode(transaction.gasPrice));
-    append(encoded, RLP::encode(transaction.gasLimit));
-    if (include_vrs) {
-        append(encoded, RLP::encode(transaction.v));
-        append(encoded, RLP::encode(transaction.r));
-        append(encoded, RLP::encode(transaction.s));
-    } else {
-        append(encoded, RLP::encode(chainID));
-        append(encoded, RLP::encode(0));
-        append(encoded, RLP::encode(0));
-    }
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { stakingItems(rlp, transaction, include_vrs, chainID); });
 }
 
 Data Signer::rlpNoHashDirective(const Staking<CreateValidator> &transaction) const noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-
-    auto descriptionEncoded = Data();
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.name));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.identity));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.website));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.securityContact));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.details));
-    append(encoded, RLP::encodeList(descriptionEncoded));
-
-    auto commissionEncoded = Data();
-
-    auto rateEncoded = Data();
-    append(rateEncoded, RLP::encode(transaction.stakeMsg.commissionRates.rate.value));
-    append(commissionEncoded, RLP::encodeList(rateEncoded));
-
-    auto maxRateEncoded = Data();
-    append(maxRateEncoded, RLP::encode(transaction.stakeMsg.commissionRates.maxRate.value));
-    append(commissionEncoded, RLP::encodeList(maxRateEncoded));
-
-    auto maxChangeRateEncoded = Data();
-    append(maxChangeRateEncoded,
-           RLP::encode(transaction.stakeMsg.commissionRates.maxChangeRate.value));
-    append(commissionEncoded, RLP::encodeList(maxChangeRateEncoded));
-
-    append(encoded, RLP::encodeList(commissionEncoded));
-
-    append(encoded, RLP::encode(transaction.stakeMsg.minSelfDelegation));
-    append(encoded, RLP::encode(transaction.stakeMsg.maxTotalDelegation));
-
-    auto slotPubKeysEncoded = Data();
-    for (auto pk : transaction.stakeMsg.slotPubKeys) {
-        append(slotPubKeysEncoded, RLP::encode(pk));
-    }
-    append(encoded, RLP::encodeList(slotPubKeysEncoded));
-
-    auto slotBlsSigsEncoded = Data();
-    for (auto sig : transaction.stakeMsg.slotKeySigs) {
-        append(slotBlsSigsEncoded, RLP::encode(sig));
-    }
-    append(encoded, RLP::encodeList(slotBlsSigsEncoded));
-
-    append(encoded, RLP::encode(transaction.stakeMsg.amount));
-
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { directiveItems(rlp, transaction.stakeMsg); });
 }
 
 Data Signer::rlpNoHashDirective(const Staking<EditValidator> &transaction) const noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-
-    auto descriptionEncoded = Data();
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.name));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.identity));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.website));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.securityContact));
-    append(descriptionEncoded, RLP::encode(transaction.stakeMsg.description.details));
-    append(encoded, RLP::encodeList(descriptionEncoded));
-
-    auto decEncoded = Data();
-    if (transaction.stakeMsg.commissionRate.has_value()) {
-        // Note: std::optional.value() is not available in XCode with target < iOS 12; using '*'
-        append(decEncoded, RLP::encode((*transaction.stakeMsg.commissionRate).value));
-    }
-    append(encoded, RLP::encodeList(decEncoded));
-
-    append(encoded, RLP::encode(transaction.stakeMsg.minSelfDelegation));
-    append(encoded, RLP::encode(transaction.stakeMsg.maxTotalDelegation));
-
-    append(encoded, RLP::encode(transaction.stakeMsg.slotKeyToRemove));
-    append(encoded, RLP::encode(transaction.stakeMsg.slotKeyToAdd));
-    append(encoded, RLP::encode(transaction.stakeMsg.slotKeyToAddSig));
-
-    append(encoded, RLP::encode(transaction.stakeMsg.active));
-
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { directiveItems(rlp, transaction.stakeMsg); });
 }
 
 Data Signer::rlpNoHashDirective(const Staking<Delegate> &transaction) const noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-    append(encoded, RLP::encode(transaction.stakeMsg.delegatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.amount));
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { directiveItems(rlp, transaction.stakeMsg); });
 }
 
 Data Signer::rlpNoHashDirective(const Staking<Undelegate> &transaction) const noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-    append(encoded, RLP::encode(transaction.stakeMsg.delegatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.validatorAddress.getKeyHash()));
-    append(encoded, RLP::encode(transaction.stakeMsg.amount));
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { directiveItems(rlp, transaction.stakeMsg); });
 }
 
 Data Signer::rlpNoHashDirective(const Staking<CollectRewards> &transaction) const noexcept {
-    auto encoded = Data();
-    using namespace TW::Ethereum;
-    append(encoded, RLP::encode(transaction.stakeMsg.delegatorAddress.getKeyHash()));
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode([&](auto& rlp) { directiveItems(rlp, transaction.stakeMsg); });
 }
 
 std::string Signer::txnAsRLPHex(Transaction &transaction) const noexcept {
@@ -493,10 +576,17 @@ std::string Signer::txnAsRLPHex(Staking<Directive> &transaction) const noexcept
 }
 
 Data Signer::hash(const Transaction &transaction) const noexcept {
-    return Hash::keccak256(rlpNoHash(transaction, false));
+    // the preimage is streamed into the hasher
+    Hash::Keccak256Hasher hasher;
+    Ethereum::rlpWrite(hasher, [&](auto& rlp) { transactionItems(rlp, transaction, false, chainID); });
+    const auto digest = hasher.final();
+    return Data(digest.begin(), digest.end());
 }
 
 template <typename Directive>
 Data Signer::hash(const Staking<Directive> &transaction) const noexcept {
-    return Hash::keccak256(rlpNoHash<Directive>(transaction, false));
+    Hash::Keccak256Hasher hasher;
+    Ethereum::rlpWrite(hasher, [&](auto& rlp) { stakingItems(rlp, transaction, false, chainID); });
+    const auto digest = hasher.final();
+    return Data(digest.begin(), digest.end());
 }
@@ -15,6 +15,7 @@
 
 #include <boost/multiprecision/cpp_int.hpp>
 #include <cstdint>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -26,6 +27,13 @@ class Signer {
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many inputs, same as calling sign() on each of them. Transfers, delegations,
+    /// undelegations and reward collections of runs of inputs with the same key share the key
+    /// state, and addresses repeated across inputs (e.g. the validator of successive delegations)
+    /// are decoded once. Validator creations and edits are signed one by one. See signInRuns()
+    /// for the threads and invalid keys; an invalid address gives Error_general.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
   private:
     static Proto::SigningOutput
     signTransaction(const Proto::SigningInput &input) noexcept;
@@ -45,6 +53,14 @@ class Signer {
     static Proto::SigningOutput
     signCollectRewards(const Proto::SigningInput &input) noexcept;
 
+    template <typename Directive>
+    static Proto::SigningOutput
+    signStaking(const Proto::SigningInput &input, std::optional<Staking<Directive>> stakingTx) noexcept;
+
+    /// Sets the signature values of the transaction, and returns it encoded.
+    template <typename T>
+    Proto::SigningOutput signedOutput(const Data& signature, T &transaction) const noexcept;
+
   public:
     uint256_t chainID;
 
@@ -5,16 +5,21 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Hash.h"
+#include "Hashers.h"
 #include "XXHash64.h"
 #include "BinaryCoding.h"
+#include "Instrumentation.h"
 
 #include <TrezorCrypto/blake256.h>
 #include <TrezorCrypto/blake2b.h>
 #include <TrezorCrypto/groestl.h>
+#include <TrezorCrypto/hash160.h>
 #include <TrezorCrypto/ripemd160.h>
 #include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha2_hw.h>
 #include <TrezorCrypto/sha3.h>
 #include <TrezorCrypto/hmac.h>
+#include <TrezorCrypto/keccak_x4.h>
 
 #include <string>
 
@@ -27,12 +32,14 @@ Data Hash::sha1(const byte* data, size_t size) {
 }
 
 Data Hash::sha256(const byte* data, size_t size) {
+    TW_INSTRUMENT_COUNT("Hash::sha256", size);
     Data result(sha256Size);
     sha256_Raw(data, size, result.data());
     return result;
 }
 
 Data Hash::sha512(const byte* data, size_t size) {
+    TW_INSTRUMENT_COUNT("Hash::sha512", size);
     Data result(sha512Size);
     sha512_Raw(data, size, result.data());
     return result;
@@ -45,6 +52,7 @@ Data Hash::sha512_256(const byte* data, size_t size) {
 }
 
 Data Hash::keccak256(const byte* data, size_t size) {
+    TW_INSTRUMENT_COUNT("Hash::keccak256", size);
     Data result(sha256Size);
     keccak_256(data, size, result.data());
     return result;
@@ -69,6 +77,7 @@ Data Hash::sha3_512(const byte* data, size_t size) {
 }
 
 Data Hash::ripemd(const byte* data, size_t size) {
+    TW_INSTRUMENT_COUNT("Hash::ripemd", size);
     Data result(ripemdSize);
     ::ripemd160(data, static_cast<uint32_t>(size), result.data());
     return result;
@@ -81,12 +90,14 @@ Data Hash::blake256(const byte* data, size_t size) {
 }
 
 Data Hash::blake2b(const byte* data, size_t dataSize, size_t hashSize) {
+    TW_INSTRUMENT_COUNT("Hash::blake2b", dataSize);
     Data result(hashSize);
     ::blake2b(data, static_cast<uint32_t>(dataSize), result.data(), hashSize);
     return result;
 }
 
 Data Hash::blake2b(const byte* data, size_t dataSize, size_t hashSize, const Data& personal) {
+    TW_INSTRUMENT_COUNT("Hash::blake2b", dataSize);
     Data result(hashSize);
     ::blake2b_Personal(data, static_cast<uint32_t>(dataSize), personal.data(), personal.size(), result.data(), hashSize);
     return result;
@@ -116,10 +127,110 @@ Data Hash::xxhash64(const byte* data, size_t size, uint64_t seed)
 
 Data Hash::xxhash64concat(const byte* data, size_t size)
 {
-    auto key1 = xxhash64(data, size, 0);
-    const auto key2 = xxhash64(data, size, 1);
-    TW::append(key1, key2);
-    return key1;
+    uint64_t hashes[2];
+    XXHash64::hash2(data, size, 0, 1, hashes);
+    Data result;
+    result.reserve(16);
+    encode64LE(hashes[0], result);
+    encode64LE(hashes[1], result);
+    return result;
+}
+
+Hash::Digest<Hash::sha1Size> Hash::sha1Digest(DataView data) {
+    Digest<sha1Size> result;
+    sha1_Raw(data.data(), data.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::sha256Size> Hash::sha256Digest(DataView data) {
+    Digest<sha256Size> result;
+    sha256_Raw(data.data(), data.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::sha256Size> Hash::sha256dDigest(DataView data) {
+    auto result = sha256Digest(data);
+    sha256_Raw(result.data(), result.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::sha512Size> Hash::sha512Digest(DataView data) {
+    Digest<sha512Size> result;
+    sha512_Raw(data.data(), data.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::sha256Size> Hash::keccak256Digest(DataView data) {
+    Digest<sha256Size> result;
+    keccak_256(data.data(), data.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::sha256Size> Hash::sha3_256Digest(DataView data) {
+    Digest<sha256Size> result;
+    ::sha3_256(data.data(), data.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::ripemdSize> Hash::ripemdDigest(DataView data) {
+    Digest<ripemdSize> result;
+    ::ripemd160(data.data(), static_cast<uint32_t>(data.size()), result.data());
+    return result;
+}
+
+Data Hash::sha256ripemd(const byte* data, size_t size) {
+    TW_INSTRUMENT_COUNT("Hash::sha256ripemd", size);
+    Data result(ripemdSize);
+    ::hash160(data, size, result.data());
+    return result;
+}
+
+Hash::Digest<Hash::ripemdSize> Hash::sha256ripemdDigest(DataView data) {
+    Digest<ripemdSize> result;
+    ::hash160(data.data(), data.size(), result.data());
+    return result;
+}
+
+Hash::Digest<Hash::sha256Size> Hash::blake256Digest(DataView data) {
+    Digest<sha256Size> result;
+    ::blake256(data.data(), data.size(), result.data());
+    return result;
+}
+
+namespace {
+
+/// Hashes messages with a C batch function taking arrays of pointers and sizes.
+template <size_t N, typename Function>
+std::vector<Hash::Digest<N>> batch(const std::vector<Data>& messages, Function function) {
+    std::vector<const byte*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(messages.size());
+    sizes.reserve(messages.size());
+    for (const auto& message : messages) {
+        pointers.push_back(message.data());
+        sizes.push_back(message.size());
+    }
+    std::vector<Hash::Digest<N>> result(messages.size());
+    function(pointers.data(), sizes.data(), messages.size(), reinterpret_cast<byte*>(result.data()));
+    return result;
+}
+
+} // namespace
+
+std::vector<Hash::Digest<Hash::sha256Size>> Hash::sha256Batch(const std::vector<Data>& messages) {
+    return batch<sha256Size>(messages, sha256_Raw_batch);
+}
+
+std::vector<Hash::Digest<Hash::sha256Size>> Hash::keccak256Batch(const std::vector<Data>& messages) {
+    return batch<sha256Size>(messages, keccak_256_batch);
+}
+
+std::vector<Hash::Digest<Hash::ripemdSize>> Hash::sha256ripemdBatch(const std::vector<Data>& messages) {
+    return batch<ripemdSize>(messages, hash160_batch);
+}
+
+std::vector<Data> Hash::blake2bBatch(const std::vector<Data>& messages, size_t hashSize, const Data& personal) {
+    return Blake2bHasher(hashSize, personal).finalBatch(messages);
 }
 
 Data Hash::hmac256(const Data& key, const Data& message) {
@@ -8,7 +8,9 @@
 
 #include "Data.h"
 
+#include <array>
 #include <functional>
+#include <vector>
 
 namespace TW::Hash {
 
@@ -29,6 +31,10 @@ static const size_t sha512Size = 64;
 /// Number of bytes in a RIPEMD160 hash.
 static const size_t ripemdSize = 20;
 
+/// Fixed-size digest, returned without heap allocation.
+template <size_t N>
+using Digest = std::array<byte, N>;
+
 /// Computes the SHA1 hash.
 Data sha1(const byte* data, size_t size);
 
@@ -85,11 +91,11 @@ Data xxhash64(const byte* data, const byte* end, uint64_t seed);
 /// Computes the XXHash hash concatenated, xxhash64 with seed 0 and 1,
 Data xxhash64concat(const byte* data, const byte* end);
 
-// Templated versions for any type with data() and size()
+// Templated versions for any type with data() and size(), including DataView
 
 /// Computes requested hash for data.
 template <typename T>
-Data hash(Hasher hasher, const T& data) {
+Data hash(const Hasher& hasher, const T& data) {
     return hasher(reinterpret_cast<const byte*>(data.data()), data.size());
 }
 
@@ -175,10 +181,8 @@ inline Data sha256d(const byte* data, size_t size) {
     return sha256(sha256(data, size));
 }
 
-/// Computes the ripemd hash of the SHA256 hash.
-inline Data sha256ripemd(const byte* data, size_t size) {
-    return ripemd(sha256(data, size));
-}
+/// Computes the ripemd hash of the SHA256 hash, without an intermediate allocation.
+Data sha256ripemd(const byte* data, size_t size);
 
 /// Computes the ripemd hash of the SHA256 hash.
 inline Data sha3_256ripemd(const byte* data, size_t size) {
@@ -200,6 +204,51 @@ inline Data groestl512d(const byte* data, size_t size) {
     return groestl512(groestl512(data, size));
 }
 
+// Fixed-size digest versions
+
+/// Computes the SHA1 hash.
+Digest<sha1Size> sha1Digest(DataView data);
+
+/// Computes the SHA256 hash.
+Digest<sha256Size> sha256Digest(DataView data);
+
+/// Computes the SHA256 hash of the SHA256 hash.
+Digest<sha256Size> sha256dDigest(DataView data);
+
+/// Computes the SHA512 hash.
+Digest<sha512Size> sha512Digest(DataView data);
+
+/// Computes the Keccak SHA256 hash.
+Digest<sha256Size> keccak256Digest(DataView data);
+
+/// Computes the version 3 SHA256 hash.
+Digest<sha256Size> sha3_256Digest(DataView data);
+
+/// Computes the RIPEMD160 hash.
+Digest<ripemdSize> ripemdDigest(DataView data);
+
+/// Computes the ripemd hash of the SHA256 hash.
+Digest<ripemdSize> sha256ripemdDigest(DataView data);
+
+/// Computes the Blake256 hash.
+Digest<sha256Size> blake256Digest(DataView data);
+
+/// Computes the SHA256 hashes of many independent messages, using multi-buffer hashing if the CPU supports it.
+std::vector<Digest<sha256Size>> sha256Batch(const std::vector<Data>& messages);
+
+/// Computes the Keccak SHA256 hashes of many independent messages, several at a time if the CPU supports it.
+std::vector<Digest<sha256Size>> keccak256Batch(const std::vector<Data>& messages);
+
+/// Computes the ripemd hashes of the SHA256 hashes of many independent messages, several at a time if the CPU
+/// supports it.
+std::vector<Digest<ripemdSize>> sha256ripemdBatch(const std::vector<Data>& messages);
+
+/// Computes the Blake2b hashes of many independent messages, with optional personalization, several
+/// at a time if the CPU supports it.
+///
+/// @throws std::invalid_argument if the hash size is invalid or the personalization is not 16 bytes long.
+std::vector<Data> blake2bBatch(const std::vector<Data>& messages, size_t hashSize, const Data& personal = {});
+
 /// Compute the SHA256-based HMAC of a message
 Data hmac256(const Data& key, const Data& message);
 
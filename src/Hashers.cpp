@@ -0,0 +1,158 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Hashers.h"
+
+#include <TrezorCrypto/blake2b_hw.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Hash;
+
+Sha256Hasher::Sha256Hasher() {
+    sha256_Init(&context);
+}
+
+Sha256Hasher& Sha256Hasher::update(DataView data) {
+    sha256_Update(&context, data.data(), data.size());
+    return *this;
+}
+
+Digest<sha256Size> Sha256Hasher::final() const {
+    auto copy = context;
+    Digest<sha256Size> result;
+    sha256_Final(&copy, result.data());
+    return result;
+}
+
+Sha512Hasher::Sha512Hasher() {
+    sha512_Init(&context);
+}
+
+Sha512Hasher& Sha512Hasher::update(DataView data) {
+    sha512_Update(&context, data.data(), data.size());
+    return *this;
+}
+
+Digest<sha512Size> Sha512Hasher::final() const {
+    auto copy = context;
+    Digest<sha512Size> result;
+    sha512_Final(&copy, result.data());
+    return result;
+}
+
+Sha512_256Hasher::Sha512_256Hasher() {
+    sha512_256_Init(&context);
+}
+
+Sha512_256Hasher& Sha512_256Hasher::update(DataView data) {
+    sha512_Update(&context, data.data(), data.size());
+    return *this;
+}
+
+Digest<sha256Size> Sha512_256Hasher::final() const {
+    auto copy = context;
+    byte full[sha512Size];
+    sha512_Final(&copy, full);
+    Digest<sha256Size> result;
+    std::copy(full, full + result.size(), result.begin());
+    return result;
+}
+
+Keccak256Hasher::Keccak256Hasher() {
+    keccak_256_Init(&context);
+}
+
+Keccak256Hasher& Keccak256Hasher::update(DataView data) {
+    keccak_Update(&context, data.data(), data.size());
+    return *this;
+}
+
+Digest<sha256Size> Keccak256Hasher::final() const {
+    auto copy = context;
+    Digest<sha256Size> result;
+    keccak_Final(&copy, result.data());
+    return result;
+}
+
+Sha3_256Hasher::Sha3_256Hasher() {
+    sha3_256_Init(&context);
+}
+
+Sha3_256Hasher& Sha3_256Hasher::update(DataView data) {
+    sha3_Update(&context, data.data(), data.size());
+    return *this;
+}
+
+Digest<sha256Size> Sha3_256Hasher::final() const {
+    auto copy = context;
+    Digest<sha256Size> result;
+    sha3_Final(&copy, result.data());
+    return result;
+}
+
+Blake256Hasher::Blake256Hasher() {
+    blake256_Init(&context);
+}
+
+Blake256Hasher& Blake256Hasher::update(DataView data) {
+    // blake256_Update drops buffered bytes when called with no data
+    if (!data.empty()) {
+        blake256_Update(&context, data.data(), data.size());
+    }
+    return *this;
+}
+
+Digest<sha256Size> Blake256Hasher::final() const {
+    auto copy = context;
+    Digest<sha256Size> result;
+    blake256_Final(&copy, result.data());
+    return result;
+}
+
+Blake2bHasher::Blake2bHasher(size_t hashSize, DataView personal) {
+    const auto result = personal.empty()
+        ? blake2b_Init(&state, hashSize)
+        : blake2b_InitPersonal(&state, hashSize, personal.data(), personal.size());
+    if (result != 0) {
+        throw std::invalid_argument("Invalid Blake2b parameters");
+    }
+}
+
+Blake2bHasher& Blake2bHasher::update(DataView data) {
+    blake2b_Update(&state, data.data(), data.size());
+    return *this;
+}
+
+Data Blake2bHasher::final() const {
+    auto copy = state;
+    Data result(state.outlen);
+    blake2b_Final(&copy, result.data(), result.size());
+    return result;
+}
+
+std::vector<Data> Blake2bHasher::finalBatch(const std::vector<Data>& suffixes) const {
+    std::vector<const byte*> pointers;
+    std::vector<size_t> sizes;
+    pointers.reserve(suffixes.size());
+    sizes.reserve(suffixes.size());
+    for (const auto& suffix : suffixes) {
+        pointers.push_back(suffix.data());
+        sizes.push_back(suffix.size());
+    }
+    Data digests(suffixes.size() * state.outlen);
+    blake2b_batch(&state, pointers.data(), sizes.data(), suffixes.size(), digests.data());
+
+    std::vector<Data> result;
+    result.reserve(suffixes.size());
+    for (size_t i = 0; i < suffixes.size(); ++i) {
+        const auto digest = digests.begin() + i * state.outlen;
+        result.emplace_back(digest, digest + state.outlen);
+    }
+    return result;
+}
@@ -0,0 +1,136 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "Hash.h"
+
+#include <TrezorCrypto/blake256.h>
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha3.h>
+
+namespace TW::Hash {
+
+// Incremental hashers, for hashing data fed in parts without concatenating it first.
+// Hashers are copyable: a copy carries the midstate, so a common prefix can be hashed once
+// and then continued with different suffixes. `final()` does not alter the hasher.
+
+/// Incremental SHA256 hasher.
+class Sha256Hasher {
+  public:
+    Sha256Hasher();
+
+    /// Appends data to the hashed message.
+    Sha256Hasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Digest<sha256Size> final() const;
+
+  private:
+    SHA256_CTX context;
+};
+
+/// Incremental SHA512 hasher.
+class Sha512Hasher {
+  public:
+    Sha512Hasher();
+
+    /// Appends data to the hashed message.
+    Sha512Hasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Digest<sha512Size> final() const;
+
+  private:
+    SHA512_CTX context;
+};
+
+/// Incremental SHA512/256 hasher, SHA512 with its own initial state truncated to 32 bytes.
+class Sha512_256Hasher {
+  public:
+    Sha512_256Hasher();
+
+    /// Appends data to the hashed message.
+    Sha512_256Hasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Digest<sha256Size> final() const;
+
+  private:
+    SHA512_CTX context;
+};
+
+/// Incremental Keccak SHA256 hasher.
+class Keccak256Hasher {
+  public:
+    Keccak256Hasher();
+
+    /// Appends data to the hashed message.
+    Keccak256Hasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Digest<sha256Size> final() const;
+
+  private:
+    SHA3_CTX context;
+};
+
+/// Incremental version 3 SHA256 hasher.
+class Sha3_256Hasher {
+  public:
+    Sha3_256Hasher();
+
+    /// Appends data to the hashed message.
+    Sha3_256Hasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Digest<sha256Size> final() const;
+
+  private:
+    SHA3_CTX context;
+};
+
+/// Incremental Blake256 hasher.
+class Blake256Hasher {
+  public:
+    Blake256Hasher();
+
+    /// Appends data to the hashed message.
+    Blake256Hasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Digest<sha256Size> final() const;
+
+  private:
+    BLAKE256_CTX context;
+};
+
+/// Incremental Blake2b hasher, with optional personalization.
+class Blake2bHasher {
+  public:
+    /// Initializes a hasher for `hashSize` byte hashes (1 to 64).
+    ///
+    /// @throws std::invalid_argument if the hash size is invalid or the personalization is not 16 bytes long.
+    explicit Blake2bHasher(size_t hashSize, DataView personal = DataView());
+
+    /// Appends data to the hashed message.
+    Blake2bHasher& update(DataView data);
+
+    /// Returns the hash of the message appended so far.
+    Data final() const;
+
+    /// Returns the hashes of the message appended so far followed by each of `suffixes`, several
+    /// at a time if the CPU supports it. The hasher is unchanged, so that an initialized or
+    /// prefixed state can be reused for many messages.
+    std::vector<Data> finalBatch(const std::vector<Data>& suffixes) const;
+
+  private:
+    blake2b_state state;
+};
+
+} // namespace TW::Hash
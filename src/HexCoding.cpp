@@ -0,0 +1,162 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+
+#if defined(__SSE2__)
+#define TW_HEX_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define TW_HEX_NEON 1
+#include <arm_neon.h>
+#endif
+
+using namespace TW;
+
+namespace {
+
+constexpr char hexDigits[] = "0123456789abcdef";
+
+/// Value of each hexadecimal character, 0xff for others.
+constexpr std::array<byte, 256> makeHexValues() {
+    std::array<byte, 256> values = {};
+    for (auto& value : values) {
+        value = 0xff;
+    }
+    for (byte i = 0; i < 10; ++i) {
+        values['0' + i] = i;
+    }
+    for (byte i = 0; i < 6; ++i) {
+        values['a' + i] = 10 + i;
+        values['A' + i] = 10 + i;
+    }
+    return values;
+}
+
+constexpr auto hexValues = makeHexValues();
+
+#if TW_HEX_SSE2
+
+/// Characters of 16 nibbles: '0' + n, plus 39 more for the letters.
+inline __m128i nibblesToChars(__m128i nibbles) {
+    const auto letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+    return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+}
+
+/// Values of 16 characters; clears the bits of `valid` of characters which aren't hexadecimal.
+inline __m128i charsToNibbles(__m128i chars, __m128i& valid) {
+    // characters are compared as signed, so that those from 0x80 are never hexadecimal
+    const auto digits = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const auto isDigit = _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('9' + 1)));
+    // only 'A'-'F' and 'a'-'f' are in 'a'-'f' once lowercased
+    const auto lower = _mm_or_si128(chars, _mm_set1_epi8(0x20));
+    const auto letters = _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10));
+    const auto isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+    valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(_mm_and_si128(isDigit, digits), _mm_and_si128(isLetter, letters));
+}
+
+/// Encodes 16 bytes into 32 characters.
+inline void encode16(const byte* data, char* out) {
+    const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+    const auto mask = _mm_set1_epi8(0x0f);
+    const auto high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+    const auto low = _mm_and_si128(bytes, mask);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), nibblesToChars(_mm_unpacklo_epi8(high, low)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), nibblesToChars(_mm_unpackhi_epi8(high, low)));
+}
+
+/// Decodes 32 characters into 16 bytes; returns false if a character isn't hexadecimal.
+inline bool decode16(const char* hex, byte* out) {
+    auto valid = _mm_set1_epi8(-1);
+    const auto first = charsToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex)), valid);
+    const auto second = charsToNibbles(_mm_loadu_si128(reinterpret_cast<const __m128i*>(hex + 16)), valid);
+    if (_mm_movemask_epi8(valid) != 0xffff) {
+        return false;
+    }
+    // each 16-bit lane holds the high nibble then the low nibble of a byte
+    const auto lowByte = _mm_set1_epi16(0x00ff);
+    const auto combine = [&lowByte](__m128i nibbles) {
+        return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, lowByte), 4), _mm_srli_epi16(nibbles, 8));
+    };
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(combine(first), combine(second)));
+    return true;
+}
+
+#elif TW_HEX_NEON
+
+/// Encodes 16 bytes into 32 characters.
+inline void encode16(const byte* data, char* out) {
+    const auto digits = vld1q_u8(reinterpret_cast<const uint8_t*>(hexDigits));
+    const auto bytes = vld1q_u8(data);
+    uint8x16x2_t chars;
+    chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+    chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0f)));
+    // interleaved, high nibble first
+    vst2q_u8(reinterpret_cast<uint8_t*>(out), chars);
+}
+
+/// Values of 16 characters; clears the bits of `valid` of characters which aren't hexadecimal.
+inline uint8x16_t charsToNibbles(uint8x16_t chars, uint8x16_t& valid) {
+    const auto digits = vsubq_u8(chars, vdupq_n_u8('0'));
+    const auto isDigit = vcleq_u8(digits, vdupq_n_u8(9));
+    // only 'A'-'F' and 'a'-'f' are in 'a'-'f' once lowercased
+    const auto letters = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    const auto isLetter = vcleq_u8(letters, vdupq_n_u8(5));
+    valid = vandq_u8(valid, vorrq_u8(isDigit, isLetter));
+    return vbslq_u8(isDigit, digits, vaddq_u8(letters, vdupq_n_u8(10)));
+}
+
+/// Decodes 32 characters into 16 bytes; returns false if a character isn't hexadecimal.
+inline bool decode16(const char* hex, byte* out) {
+    // deinterleaved, high nibbles first
+    const auto chars = vld2q_u8(reinterpret_cast<const uint8_t*>(hex));
+    auto valid = vdupq_n_u8(0xff);
+    const auto high = charsToNibbles(chars.val[0], valid);
+    const auto low = charsToNibbles(chars.val[1], valid);
+    if (vminvq_u8(valid) != 0xff) {
+        return false;
+    }
+    vst1q_u8(out, vorrq_u8(vshlq_n_u8(high, 4), low));
+    return true;
+}
+
+#endif
+
+} // namespace
+
+void TW::hexEncode(const byte* data, std::size_t size, char* out) {
+    std::size_t i = 0;
+#if TW_HEX_SSE2 || TW_HEX_NEON
+    for (; i + 16 <= size; i += 16) {
+        encode16(data + i, out + 2 * i);
+    }
+#endif
+    for (; i < size; ++i) {
+        out[2 * i] = hexDigits[data[i] >> 4];
+        out[2 * i + 1] = hexDigits[data[i] & 0x0f];
+    }
+}
+
+bool TW::hexDecode(const char* hex, std::size_t size, byte* out) {
+    std::size_t i = 0;
+#if TW_HEX_SSE2 || TW_HEX_NEON
+    for (; i + 16 <= size; i += 16) {
+        if (!decode16(hex + 2 * i, out + i)) {
+            return false;
+        }
+    }
+#endif
+    for (; i < size; ++i) {
+        const auto high = hexValues[static_cast<unsigned char>(hex[2 * i])];
+        const auto low = hexValues[static_cast<unsigned char>(hex[2 * i + 1])];
+        if (high > 0x0f || low > 0x0f) {
+            return false;
+        }
+        out[i] = static_cast<byte>((high << 4) | low);
+    }
+    return true;
+}
@@ -11,31 +11,62 @@
 #include <boost/algorithm/hex.hpp>
 
 #include <array>
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <tuple>
+#include <type_traits>
 
 namespace TW {
 
 std::tuple<uint8_t, bool> value(uint8_t c);
 
+/// Writes the lowercase hexadecimal representation of `size` bytes to `out`, `2 * size` characters without a
+/// terminator. Vectorized with SSE2 or NEON where available.
+void hexEncode(const byte* data, std::size_t size, char* out);
+
+/// Parses `2 * size` hexadecimal characters, of any case, into `size` bytes; returns false if a character isn't
+/// hexadecimal, leaving `out` partially written. Vectorized with SSE2 or NEON where available.
+bool hexDecode(const char* hex, std::size_t size, byte* out);
+
+namespace internal {
+
+/// Iterators over contiguous bytes or characters, which hexEncode and hexDecode can access directly.
+template <typename Iter>
+constexpr bool isContiguousByteIterator =
+    sizeof(typename std::iterator_traits<Iter>::value_type) == 1 &&
+    (std::is_pointer_v<Iter> || std::is_same_v<Iter, Data::iterator> || std::is_same_v<Iter, Data::const_iterator> ||
+     std::is_same_v<Iter, std::string::iterator> || std::is_same_v<Iter, std::string::const_iterator>);
+
+} // namespace internal
+
 /// Converts a range of bytes to a hexadecimal string representation.
 template <typename Iter>
 inline std::string hex(const Iter begin, const Iter end) {
-    static constexpr std::array<char, 16> hexmap = {
-        '0', '1', '2', '3', '4', '5', '6', '7',
-        '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
-    };
-
-    std::string result;
-    result.reserve((end - begin) * 2);
-
-    for (auto it = begin; it < end; ++it) {
-        auto val = static_cast<uint8_t>(*it);
-        result.push_back(hexmap[val >> 4]);
-        result.push_back(hexmap[val & 0x0f]);
+    if constexpr (internal::isContiguousByteIterator<Iter>) {
+        const auto size = static_cast<std::size_t>(end - begin);
+        std::string result(size * 2, '\0');
+        if (size > 0) {
+            hexEncode(reinterpret_cast<const byte*>(&*begin), size, result.data());
+        }
+        return result;
+    } else {
+        static constexpr std::array<char, 16> hexmap = {
+            '0', '1', '2', '3', '4', '5', '6', '7',
+            '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
+        };
+
+        std::string result;
+        result.reserve((end - begin) * 2);
+
+        for (auto it = begin; it < end; ++it) {
+            auto val = static_cast<uint8_t>(*it);
+            result.push_back(hexmap[val >> 4]);
+            result.push_back(hexmap[val & 0x0f]);
+        }
+
+        return result;
     }
-
-    return result;
 }
 
 /// Converts a collection of bytes to a hexadecimal string representation.
@@ -69,12 +100,24 @@ inline Data parse_hex(const Iter begin, const Iter end) {
     if (end - begin >= 2 && *begin == '0' && *(begin + 1) == 'x') {
         it += 2;
     }
-    try {
-        std::string temp;
-        boost::algorithm::unhex(it, end, std::back_inserter(temp));
-        return Data(temp.begin(), temp.end());
-    } catch (...) {
-        return {};
+    if constexpr (internal::isContiguousByteIterator<Iter>) {
+        const auto size = static_cast<std::size_t>(end - it);
+        if (size % 2 != 0) {
+            return {};
+        }
+        Data result(size / 2);
+        if (size > 0 && !hexDecode(reinterpret_cast<const char*>(&*it), result.size(), result.data())) {
+            return {};
+        }
+        return result;
+    } else {
+        try {
+            std::string temp;
+            boost::algorithm::unhex(it, end, std::back_inserter(temp));
+            return Data(temp.begin(), temp.end());
+        } catch (...) {
+            return {};
+        }
     }
 }
 
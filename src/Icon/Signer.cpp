@@ -7,16 +7,14 @@
 #include "Signer.h"
 
 #include "../Base64.h"
-#include "../Hash.h"
+#include "../Hashers.h"
 #include "../HexCoding.h"
+#include "../JsonWriter.h"
 #include "../PrivateKey.h"
 #include "../uint256.h"
 
-#include <boost/multiprecision/cpp_int.hpp>
-#include <nlohmann/json.hpp>
-
 #include <algorithm>
-#include <iostream>
+#include <cstring>
 #include <sstream>
 
 using namespace TW;
@@ -37,40 +35,46 @@ std::string to_hex(const std::string& n) {
     return "0x" + std::string(start, s.end());
 }
 
-std::map<std::string, std::string> Signer::parameters() const noexcept {
-    auto params = std::map<std::string, std::string>();
-    params["from"] = input.from_address();
-    params["to"] = input.to_address();
-    params["timestamp"] = to_hex(input.timestamp());
-    params["nonce"] = to_hex(input.nonce());
-    params["stepLimit"] = to_hex(input.step_limit());
-    params["value"] = to_hex(input.value());
-    params["nid"] = to_hex(input.network_id());
-    params["version"] = "0x3";
-    return params;
+Signer::Parameters Signer::parameters() const noexcept {
+    return {{
+        {"from", input.from_address()},
+        {"nid", to_hex(input.network_id())},
+        {"nonce", to_hex(input.nonce())},
+        {"stepLimit", to_hex(input.step_limit())},
+        {"timestamp", to_hex(input.timestamp())},
+        {"to", input.to_address()},
+        {"value", to_hex(input.value())},
+        {"version", "0x3"},
+    }};
 }
 
+static const char* const preImagePrefix = "icx_sendTransaction";
+
 std::string Signer::preImage() const noexcept {
-    std::string txHash = "icx_sendTransaction";
-    const auto params = parameters();
-    for (auto [key, value] : params) {
-        txHash += "." + key + "." + value;
+    std::string txHash = preImagePrefix;
+    for (const auto& [key, value] : parameters()) {
+        txHash += '.';
+        txHash += key;
+        txHash += '.';
+        txHash += value;
     }
     return txHash;
 }
 
 std::string Signer::encode(const Data& signature) const noexcept {
-    auto json = nlohmann::json();
-    json["from"] = input.from_address();
-    json["to"] = input.to_address();
-    json["timestamp"] = to_hex(input.timestamp());
-    json["nonce"] = to_hex(input.nonce());
-    json["stepLimit"] = to_hex(input.step_limit());
-    json["value"] = to_hex(input.value());
-    json["nid"] = to_hex(input.network_id());
-    json["version"] = "0x3";
-    json["signature"] = Base64::encode(signature);
-    return json.dump();
+    std::string output;
+    JsonStringSink sink(output);
+    JsonWriter<JsonStringSink> writer(sink);
+    writer.beginObject();
+    for (const auto& [key, value] : parameters()) {
+        // signature sorts between nonce and stepLimit
+        if (std::strcmp(key, "stepLimit") == 0) {
+            writer.field("signature", Base64::encode(signature));
+        }
+        writer.field(key, value);
+    }
+    writer.endObject();
+    return output;
 }
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
@@ -79,10 +83,20 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 }
 
 Proto::SigningOutput Signer::sign() const noexcept {
-    const auto hash = Hash::sha3_256(Signer::preImage());
+    // hash the pre-image as it is formed, without building the string
+    auto hasher = Hash::Sha3_256Hasher();
+    hasher.update(DataView(reinterpret_cast<const byte*>(preImagePrefix), std::strlen(preImagePrefix)));
+    for (const auto& [key, value] : parameters()) {
+        const byte dot = '.';
+        hasher.update(DataView(&dot, 1));
+        hasher.update(DataView(reinterpret_cast<const byte*>(key), std::strlen(key)));
+        hasher.update(DataView(&dot, 1));
+        hasher.update(DataView(reinterpret_cast<const byte*>(value.data()), value.size()));
+    }
+    const auto digest = hasher.final();
 
     const auto key = PrivateKey(input.private_key());
-    const auto signature = key.sign(hash, TWCurveSECP256k1);
+    const auto signature = key.sign(Data(digest.begin(), digest.end()), TWCurveSECP256k1);
 
     auto output = Proto::SigningOutput();
     output.set_signature(signature.data(), signature.size());
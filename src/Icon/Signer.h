@@ -9,8 +9,9 @@
 #include "../Data.h"
 #include "../proto/Icon.pb.h"
 
-#include <map>
+#include <array>
 #include <string>
+#include <utility>
 
 namespace TW::Icon {
 
@@ -33,7 +34,10 @@ class Signer {
     std::string encode(const Data& signature) const noexcept;
 
   private:
-    std::map<std::string, std::string> parameters() const noexcept;
+    /// Transaction parameters, sorted by name.
+    using Parameters = std::array<std::pair<const char*, std::string>, 8>;
+
+    Parameters parameters() const noexcept;
 };
 
 } // namespace TW::Icon
@@ -0,0 +1,118 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Allocations.h"
+
+#include <TrustWalletCore/TWInstrumentation.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace TW::Instrumentation {
+
+/// Sink set with TWInstrumentationSetSink, or null.
+extern std::atomic<TWInstrumentationSink> sink;
+extern std::atomic<void*> sinkContext;
+
+/// Reports a measurement to the sink, if any.
+inline void report(const char* operation, uint64_t durationNanoseconds, uint64_t count) {
+    const auto current = sink.load(std::memory_order_acquire);
+    if (current != nullptr) {
+        current(sinkContext.load(std::memory_order_relaxed), operation, durationNanoseconds, count);
+    }
+}
+
+/// Reports the duration of its scope, for `count` items; the clock is not read when there is no sink.
+class ScopedTimer {
+  public:
+    explicit ScopedTimer(const char* operation, uint64_t count = 1)
+        : operation(operation), count(count), enabled(sink.load(std::memory_order_relaxed) != nullptr) {
+        if (enabled) {
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (enabled) {
+            const auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+            report(operation, static_cast<uint64_t>(duration.count()), count);
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+  private:
+    const char* operation;
+    uint64_t count;
+    bool enabled;
+    std::chrono::steady_clock::time_point start;
+};
+
+/// Reports the allocations of its scope on the calling thread, as three counters: their number, their bytes and the
+/// peak of the memory it held; nothing when there is no sink.
+class ScopedAllocations {
+  public:
+    ScopedAllocations(const char* countOperation, const char* bytesOperation, const char* peakOperation)
+        : countOperation(countOperation), bytesOperation(bytesOperation), peakOperation(peakOperation),
+          enabled(sink.load(std::memory_order_relaxed) != nullptr) {}
+
+    ~ScopedAllocations() {
+        if (enabled) {
+            report(countOperation, 0, scope.count());
+            report(bytesOperation, 0, scope.bytes());
+            report(peakOperation, 0, scope.peak());
+        }
+    }
+
+    ScopedAllocations(const ScopedAllocations&) = delete;
+    ScopedAllocations& operator=(const ScopedAllocations&) = delete;
+
+  private:
+    const char* countOperation;
+    const char* bytesOperation;
+    const char* peakOperation;
+    bool enabled;
+    Allocations::Scope scope;
+};
+
+} // namespace TW::Instrumentation
+
+#define TW_INSTRUMENT_CONCAT_(a, b) a##b
+#define TW_INSTRUMENT_CONCAT(a, b) TW_INSTRUMENT_CONCAT_(a, b)
+
+/// Hot-path hooks, compiled out unless TW_INSTRUMENTATION is defined (CMake option of the same name).
+/// TW_INSTRUMENT_SCOPE(operation) times the enclosing scope, TW_INSTRUMENT_COUNT(operation, count) reports a count.
+/// TW_INSTRUMENT_SCOPE_COUNT(operation, count) times the enclosing scope for `count` items, and
+/// TW_INSTRUMENT_DURATION(operation, durationNanoseconds, count) reports a duration measured by the caller;
+/// their arguments are not evaluated when compiled out.
+/// With TW_ALLOCATION_TRACKING (which implies TW_INSTRUMENTATION), TW_INSTRUMENT_SCOPE also reports the allocations of
+/// the scope as the counters `operation.allocations`, `operation.bytes` and `operation.peak`; `operation` must then be
+/// a string literal.
+#ifdef TW_INSTRUMENTATION
+#ifdef TW_ALLOCATION_TRACKING
+#define TW_INSTRUMENT_SCOPE(operation)                                                                         \
+    const TW::Instrumentation::ScopedAllocations TW_INSTRUMENT_CONCAT(instrumentationAllocations, __LINE__)( \
+        operation ".allocations", operation ".bytes", operation ".peak");                                      \
+    const TW::Instrumentation::ScopedTimer TW_INSTRUMENT_CONCAT(instrumentationTimer, __LINE__)(operation)
+#else
+#define TW_INSTRUMENT_SCOPE(operation) \
+    const TW::Instrumentation::ScopedTimer TW_INSTRUMENT_CONCAT(instrumentationTimer, __LINE__)(operation)
+#endif
+#define TW_INSTRUMENT_SCOPE_COUNT(operation, count) \
+    const TW::Instrumentation::ScopedTimer TW_INSTRUMENT_CONCAT(instrumentationTimer, __LINE__)(operation, static_cast<uint64_t>(count))
+#define TW_INSTRUMENT_COUNT(operation, count) TW::Instrumentation::report(operation, 0, static_cast<uint64_t>(count))
+#define TW_INSTRUMENT_DURATION(operation, durationNanoseconds, count) \
+    TW::Instrumentation::report(operation, static_cast<uint64_t>(durationNanoseconds), static_cast<uint64_t>(count))
+#else
+#define TW_INSTRUMENT_SCOPE(operation) ((void)0)
+#define TW_INSTRUMENT_SCOPE_COUNT(operation, count) ((void)0)
+#define TW_INSTRUMENT_COUNT(operation, count) ((void)0)
+#define TW_INSTRUMENT_DURATION(operation, durationNanoseconds, count) ((void)0)
+#endif
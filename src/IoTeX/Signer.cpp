@@ -9,35 +9,62 @@
 #include "HexCoding.h"
 #include "IoTeX/Staking.h"
 #include "PrivateKey.h"
+#include "ProtobufWriter.h"
+#include "../BatchSigning.h"
 
 using namespace TW;
 using namespace TW::IoTeX;
 
+/// Output of the signed action, Proto::Action written directly from the serialized core
+static Proto::SigningOutput signingOutput(const std::string& core, const Data& publicKey, const Data& signature) {
+    Data encoded;
+    encoded.reserve(ProtobufWriter::fieldSize(1, core.size()) + ProtobufWriter::fieldSize(2, publicKey.size()) +
+                    ProtobufWriter::fieldSize(3, signature.size()));
+    ProtobufWriter(encoded).message(1, core).bytes(2, publicKey).bytes(3, signature);
+
+    auto output = Proto::SigningOutput();
+    output.set_encoded(encoded.data(), encoded.size());
+    auto h = Hash::keccak256(encoded);
+    output.set_hash(h.data(), h.size());
+    return output;
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto signer = Signer(input);
     return signer.build();
 }
 
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    const auto sameKey = [](const auto& first, const auto& input) { return input.privatekey() == first.privatekey(); };
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, sameKey, [&](size_t begin, size_t end, auto& outputs) {
+        const auto key = PrivateKey(inputs[begin].privatekey());
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes.toData();
+        std::vector<std::string> cores;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            cores.push_back(Signer(inputs[i]).action.SerializeAsString());
+            digests.push_back(Hash::keccak256(cores.back()));
+        }
+        std::vector<Data> signatures;
+        key.signBatch(digests, TWCurveSECP256k1, signatures);
+        for (auto i = begin; i < end; ++i) {
+            outputs[i] = signingOutput(cores[i - begin], publicKey, signatures[i - begin]);
+        }
+    });
+}
+
 Data Signer::sign() const {
     auto key = PrivateKey(input.privatekey());
     return key.sign(hash(), TWCurveSECP256k1);
 }
 
 Proto::SigningOutput Signer::build() const {
-    auto signedAction = Proto::Action();
-    signedAction.mutable_core()->MergeFrom(action);
     auto key = PrivateKey(input.privatekey());
-    auto pk = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes;
-    signedAction.set_senderpubkey(pk.data(), pk.size());
-    auto sig = key.sign(hash(), TWCurveSECP256k1);
-    signedAction.set_signature(sig.data(), sig.size());
-
-    auto output = Proto::SigningOutput();
-    auto serialized = signedAction.SerializeAsString();
-    output.set_encoded(serialized);
-    auto h = Hash::keccak256(serialized);
-    output.set_hash(h.data(), h.size());
-    return output;
+    auto pk = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes.toData();
+    // the core is serialized once, for its hash and the signed action
+    const auto core = action.SerializeAsString();
+    auto sig = key.sign(Hash::keccak256(core), TWCurveSECP256k1);
+    return signingOutput(core, pk, sig);
 }
 
 Data Signer::hash() const {
@@ -10,6 +10,8 @@
 
 #include "proto/IoTeX.pb.h"
 
+#include <vector>
+
 namespace TW::IoTeX {
 
 /// Helper class that performs IoTeX transaction signing
@@ -17,6 +19,11 @@ class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs many inputs, same as calling sign() on each of them. Runs of inputs with the same key
+    /// derive the public key once and share the key state, and each action core is serialized
+    /// once. See signInRuns() for the threads and invalid keys.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
   public:
     Proto::SigningInput input;
     Proto::ActionCore action;
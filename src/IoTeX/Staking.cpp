@@ -6,104 +6,114 @@
 
 #include "Staking.h"
 #include "Data.h"
-#include "HexCoding.h"
+#include "ProtobufWriter.h"
+
+#include <algorithm>
+
 using namespace TW;
 
 namespace TW::IoTeX {
 
-std::string FromData(const Data& data) {
-    auto s = std::string(data.begin(), data.end());
-    s.append(data.size(), '\0');
-    return s;
+// Messages are written directly in the wire format of their IoTeX::Proto::Staking message.
+
+/// The bytes before the first NUL; fields were set from C strings, and are truncated there
+static DataView untilNul(const Data& data) {
+    const auto end = std::find(data.begin(), data.end(), 0);
+    return DataView(data.data(), static_cast<size_t>(end - data.begin()));
 }
 
-Data dataFromString(const std::string& d) {
+/// Reserves room for the given string fields, and for the few bytes of each other field
+static Data buffer(std::initializer_list<size_t> sizes) {
+    size_t size = 0;
+    for (auto fieldSize : sizes) {
+        size += fieldSize + 11;
+    }
     Data data;
-    std::copy(d.c_str(), d.c_str() + d.length(), back_inserter(data));
+    data.reserve(size);
     return data;
 }
 
 Data stakingCreate(const Data& candidate, const Data& amount, uint32_t duration, bool autoStake,
                    const Data& payload) {
-    auto action = IoTeX::Proto::Staking_Create();
-    action.set_candidatename(FromData(candidate).c_str());
-    action.set_stakedamount(FromData(amount).c_str());
-    action.set_stakedduration(duration);
-    action.set_autostake(autoStake);
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.Create
+    auto data = buffer({candidate.size(), amount.size(), 0, 0, payload.size()});
+    ProtobufWriter(data)
+        .bytes(1, untilNul(candidate))
+        .bytes(2, untilNul(amount))
+        .varint(3, duration)
+        .varint(4, autoStake)
+        .bytes(5, untilNul(payload));
+    return data;
 }
 
 Data stakingAddDeposit(uint64_t index, const Data& amount, const Data& payload) {
-    auto action = IoTeX::Proto::Staking_AddDeposit();
-    action.set_bucketindex(index);
-    action.set_amount(FromData(amount).c_str());
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.AddDeposit
+    auto data = buffer({0, amount.size(), payload.size()});
+    ProtobufWriter(data).varint(1, index).bytes(2, untilNul(amount)).bytes(3, untilNul(payload));
+    return data;
 }
 
 Data stakingUnstake(uint64_t index, const Data& payload) {
-    auto action = IoTeX::Proto::Staking_Reclaim();
-    action.set_bucketindex(index);
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.Reclaim
+    auto data = buffer({0, payload.size()});
+    ProtobufWriter(data).varint(1, index).bytes(2, untilNul(payload));
+    return data;
 }
 
 Data stakingWithdraw(uint64_t index, const Data& payload) {
-    auto action = IoTeX::Proto::Staking_Reclaim();
-    action.set_bucketindex(index);
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.Reclaim
+    return stakingUnstake(index, payload);
 }
 
 Data stakingRestake(uint64_t index, uint32_t duration, bool autoStake, const Data& payload) {
-    auto action = IoTeX::Proto::Staking_Restake();
-    action.set_bucketindex(index);
-    action.set_stakedduration(duration);
-    action.set_autostake(autoStake);
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.Restake
+    auto data = buffer({0, 0, 0, payload.size()});
+    ProtobufWriter(data)
+        .varint(1, index)
+        .varint(2, duration)
+        .varint(3, autoStake)
+        .bytes(4, untilNul(payload));
+    return data;
 }
 
 Data stakingChangeCandidate(uint64_t index, const Data& candidate, const Data& payload) {
-    auto action = IoTeX::Proto::Staking_ChangeCandidate();
-    action.set_bucketindex(index);
-    action.set_candidatename(FromData(candidate).c_str());
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.ChangeCandidate
+    auto data = buffer({0, candidate.size(), payload.size()});
+    ProtobufWriter(data).varint(1, index).bytes(2, untilNul(candidate)).bytes(3, untilNul(payload));
+    return data;
 }
 
 Data stakingTransfer(uint64_t index, const Data& voterAddress, const Data& payload) {
-    auto action = IoTeX::Proto::Staking_TransferOwnership();
-    action.set_bucketindex(index);
-    action.set_voteraddress(FromData(voterAddress).c_str());
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.TransferOwnership
+    auto data = buffer({0, voterAddress.size(), payload.size()});
+    ProtobufWriter(data).varint(1, index).bytes(2, untilNul(voterAddress)).bytes(3, untilNul(payload));
+    return data;
 }
 
 Data candidateRegister(const Data& name, const Data& operatorAddress, const Data& rewardAddress,
                        const Data& amount, uint32_t duration, bool autoStake,
                        const Data& ownerAddress, const Data& payload) {
-    auto cbi = new IoTeX::Proto::Staking_CandidateBasicInfo();
-    cbi->set_name(FromData(name).c_str());
-    cbi->set_operatoraddress(FromData(operatorAddress).c_str());
-    cbi->set_rewardaddress(FromData(rewardAddress).c_str());
-
-    auto action = IoTeX::Proto::Staking_CandidateRegister();
-    action.set_allocated_candidate(cbi);
-    action.set_stakedamount(FromData(amount).c_str());
-    action.set_stakedduration(duration);
-    action.set_autostake(autoStake);
-    action.set_owneraddress(FromData(ownerAddress).c_str());
-    action.set_payload(FromData(payload).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.CandidateRegister, the candidate is always set
+    const auto candidate = candidateUpdate(name, operatorAddress, rewardAddress);
+    auto data = buffer({candidate.size(), amount.size(), 0, 0, ownerAddress.size(), payload.size()});
+    ProtobufWriter(data)
+        .message(1, candidate)
+        .bytes(2, untilNul(amount))
+        .varint(3, duration)
+        .varint(4, autoStake)
+        .bytes(5, untilNul(ownerAddress))
+        .bytes(6, untilNul(payload));
+    return data;
 }
 
 Data candidateUpdate(const Data& name, const Data& operatorAddress, const Data& rewardAddress) {
-    auto action = IoTeX::Proto::Staking_CandidateBasicInfo();
-    action.set_name(FromData(name).c_str());
-    action.set_operatoraddress(FromData(operatorAddress).c_str());
-    action.set_rewardaddress(FromData(rewardAddress).c_str());
-    return dataFromString(action.SerializeAsString());
+    // Staking.CandidateBasicInfo
+    auto data = buffer({name.size(), operatorAddress.size(), rewardAddress.size()});
+    ProtobufWriter(data)
+        .bytes(1, untilNul(name))
+        .bytes(2, untilNul(operatorAddress))
+        .bytes(3, untilNul(rewardAddress));
+    return data;
 }
+
 } // namespace TW::IoTeX
@@ -0,0 +1,196 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <TrezorCrypto/sha2.h>
+
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace TW {
+
+/// JSON output appended to a string.
+class JsonStringSink {
+  public:
+    explicit JsonStringSink(std::string& output) : output(output) {}
+    void write(const char* data, size_t size) { output.append(data, size); }
+
+  private:
+    std::string& output;
+};
+
+/// JSON output hashed with SHA-256 as it is written.
+class JsonSha256Sink {
+  public:
+    JsonSha256Sink() { sha256_Init(&context); }
+    void write(const char* data, size_t size) { sha256_Update(&context, reinterpret_cast<const byte*>(data), size); }
+
+    /// Digest of the output, the sink can't be written to afterwards.
+    Data digest() {
+        Data result(SHA256_DIGEST_LENGTH);
+        sha256_Final(&context, result.data());
+        return result;
+    }
+
+  private:
+    SHA256_CTX context;
+};
+
+/// Order of the keys within the objects written by a JsonWriter.
+enum class JsonKeyOrder {
+    /// Keys sorted, as nlohmann::json::dump() does (checked in debug builds).
+    sorted,
+    /// Keys in a fixed order defined by the format, as written.
+    asWritten,
+};
+
+/// Streaming writer of compact JSON, by default canonical: with object keys in sorted order,
+/// the same output as nlohmann::json::dump() without building a DOM.
+///
+/// Keys are written in the order they are given; with JsonKeyOrder::sorted they must be
+/// increasing within an object, so callers write fields in sorted order.
+template <typename Sink, JsonKeyOrder keyOrder = JsonKeyOrder::sorted>
+class JsonWriter {
+  public:
+    static constexpr size_t maxDepth = 16;
+
+    explicit JsonWriter(Sink& sink) : sink(sink) {}
+
+    void beginObject() { open('{'); }
+    void endObject() { close('}'); }
+    void beginArray() { open('['); }
+    void endArray() { close(']'); }
+
+    /// Writes the key of the next value of the current object.
+    void key(const char* name) {
+        assert(depth > 0);
+        assert(keyOrder != JsonKeyOrder::sorted || levels[depth - 1].lastKey == nullptr ||
+               std::strcmp(levels[depth - 1].lastKey, name) < 0);
+        separator();
+        levels[depth - 1].lastKey = name;
+        writeString(name, std::strlen(name));
+        put(':');
+        afterKey = true;
+    }
+
+    void value(const std::string& string) {
+        separator();
+        writeString(string.data(), string.size());
+    }
+
+    void value(const char* string) {
+        separator();
+        writeString(string, std::strlen(string));
+    }
+
+    /// Writes an integer, in decimal.
+    template <typename T, std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, int> = 0>
+    void value(T number) {
+        separator();
+        char digits[24];
+        auto end = digits + sizeof(digits);
+        auto begin = end;
+        const bool negative = number < 0;
+        auto magnitude = negative ? static_cast<uint64_t>(0) - static_cast<uint64_t>(number) : static_cast<uint64_t>(number);
+        do {
+            *--begin = static_cast<char>('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude != 0);
+        if (negative) {
+            *--begin = '-';
+        }
+        sink.write(begin, end - begin);
+    }
+
+    /// Writes a value that is already serialized JSON.
+    void rawValue(const std::string& json) {
+        separator();
+        sink.write(json.data(), json.size());
+    }
+
+    /// Shorthands for a key followed by a value.
+    template <typename T>
+    void field(const char* name, const T& fieldValue) {
+        key(name);
+        value(fieldValue);
+    }
+
+  private:
+    struct Level {
+        bool first = true;
+        const char* lastKey = nullptr;
+    };
+
+    Sink& sink;
+    std::array<Level, maxDepth> levels;
+    size_t depth = 0;
+    bool afterKey = false;
+
+    void put(char c) { sink.write(&c, 1); }
+
+    void separator() {
+        if (afterKey) {
+            afterKey = false;
+            return;
+        }
+        if (depth > 0) {
+            if (!levels[depth - 1].first) {
+                put(',');
+            }
+            levels[depth - 1].first = false;
+        }
+    }
+
+    void open(char c) {
+        assert(depth < maxDepth);
+        separator();
+        put(c);
+        levels[depth++] = Level();
+    }
+
+    void close(char c) {
+        assert(depth > 0);
+        --depth;
+        put(c);
+    }
+
+    void writeString(const char* data, size_t size) {
+        static const char* hexDigits = "0123456789abcdef";
+        put('"');
+        size_t start = 0;
+        for (size_t i = 0; i < size; ++i) {
+            const auto c = static_cast<unsigned char>(data[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            sink.write(data + start, i - start);
+            start = i + 1;
+            switch (c) {
+            case '"': sink.write("\\\"", 2); break;
+            case '\\': sink.write("\\\\", 2); break;
+            case '\b': sink.write("\\b", 2); break;
+            case '\f': sink.write("\\f", 2); break;
+            case '\n': sink.write("\\n", 2); break;
+            case '\r': sink.write("\\r", 2); break;
+            case '\t': sink.write("\\t", 2); break;
+            default: {
+                const char escaped[6] = {'\\', 'u', '0', '0', hexDigits[c >> 4], hexDigits[c & 0x0f]};
+                sink.write(escaped, sizeof(escaped));
+            }
+            }
+        }
+        sink.write(data + start, size - start);
+        put('"');
+    }
+};
+
+} // namespace TW
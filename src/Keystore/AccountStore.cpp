@@ -0,0 +1,338 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AccountStore.h"
+
+#include "../Base58.h"
+#include "../Bech32.h"
+
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+namespace {
+
+constexpr uint32_t hardenedFlag = 0x80000000;
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/// Bytes of the hex digits of `string` after `prefix`, followed with a bit per digit set for upper case ones if
+/// `mixedCase`.  False if they are not an even number of hex digits.
+bool decodeHex(const std::string& string, std::size_t prefix, Data& bytes, bool& mixedCase) {
+    const auto digits = string.size() - prefix;
+    if (digits == 0 || digits % 2 != 0) {
+        return false;
+    }
+    bytes.clear();
+    Data upperCase((digits + 7) / 8);
+    mixedCase = false;
+    for (std::size_t i = 0; i < digits; i += 2) {
+        const auto high = hexValue(string[prefix + i]);
+        const auto low = hexValue(string[prefix + i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        bytes.push_back(static_cast<byte>(high << 4 | low));
+        for (std::size_t j = i; j < i + 2; ++j) {
+            if (std::isupper(static_cast<unsigned char>(string[prefix + j]))) {
+                upperCase[j / 8] |= static_cast<byte>(1 << (j % 8));
+                mixedCase = true;
+            }
+        }
+    }
+    if (mixedCase) {
+        TW::append(bytes, upperCase);
+    }
+    return true;
+}
+
+} // namespace
+
+DataView AccountStore::Strings::at(std::size_t position) const {
+    const auto begin = position == 0 ? 0 : ends[position - 1];
+    return DataView(bytes.data() + begin, ends[position] - begin);
+}
+
+uint32_t AccountStore::intern(const Format& format) {
+    const auto found = formatsByValue.find(format);
+    if (found != formatsByValue.end()) {
+        return found->second;
+    }
+    const auto id = static_cast<uint32_t>(formats.size());
+    formats.push_back(format);
+    formatsByValue.emplace(format, id);
+    return id;
+}
+
+AccountStore::Format AccountStore::encode(const std::string& string, Data& bytes) {
+    const auto prefix = string.compare(0, 2, "0x") == 0 ? std::string("0x") : std::string();
+    auto mixedCase = false;
+    if (decodeHex(string, prefix.size(), bytes, mixedCase)) {
+        return Format(mixedCase ? Encoding::hexMixedCase : Encoding::hex, prefix);
+    }
+
+    if (string.find('1') != std::string::npos) {
+        const auto [hrp, values, variant] = Bech32::decode(string);
+        if (variant != Bech32::None && Bech32::encode(hrp, values, variant) == string) {
+            // the number of 5-bit values modulo 8 tells whether the last byte holds one more
+            bytes = {static_cast<byte>(values.size() % 8)};
+            Data packed;
+            Bech32::convertBits<5, 8, true>(packed, values);
+            TW::append(bytes, packed);
+            return Format(variant == Bech32::Bech32M ? Encoding::bech32m : Encoding::bech32, hrp);
+        }
+    }
+
+    if (!string.empty()) {
+        bytes = Base58::bitcoin.decode(string);
+        if (!bytes.empty() && Base58::bitcoin.encode(bytes) == string) {
+            return Format(Encoding::base58, "");
+        }
+    }
+
+    bytes.assign(string.begin(), string.end());
+    return Format(Encoding::text, "");
+}
+
+void AccountStore::Strings::push(const Data& string, uint32_t format) {
+    TW::append(bytes, string);
+    ends.push_back(static_cast<uint32_t>(bytes.size()));
+    formats.push_back(format);
+}
+
+std::string AccountStore::string(const Strings& strings, std::size_t position) const {
+    const auto bytes = strings.at(position);
+    const auto& [encoding, prefix] = formats[strings.formats[position]];
+    switch (encoding) {
+    case Encoding::hex:
+    case Encoding::hexMixedCase: {
+        static const char digits[] = "0123456789abcdef";
+        // a mixed case string of n bytes has n / 4 more bytes, rounded up, for the case of its 2n digits
+        auto count = bytes.size();
+        if (encoding == Encoding::hexMixedCase) {
+            count = bytes.size() * 4 / 5;
+            while (count + (count + 3) / 4 < bytes.size()) {
+                ++count;
+            }
+        }
+        auto result = prefix;
+        for (std::size_t i = 0; i < count; ++i) {
+            result.push_back(digits[bytes[i] >> 4]);
+            result.push_back(digits[bytes[i] & 0x0f]);
+        }
+        if (encoding == Encoding::hexMixedCase) {
+            for (std::size_t j = 0; j < 2 * count; ++j) {
+                if ((bytes[count + j / 8] >> (j % 8)) & 1) {
+                    auto& c = result[prefix.size() + j];
+                    c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                }
+            }
+        }
+        return result;
+    }
+    case Encoding::bech32:
+    case Encoding::bech32m: {
+        Data values;
+        Bech32::convertBits<8, 5, true>(values, bytes.subView(1, bytes.size() - 1));
+        while (values.size() % 8 != bytes[0]) {
+            values.pop_back();
+        }
+        return Bech32::encode(prefix, values, encoding == Encoding::bech32m ? Bech32::Bech32M : Bech32::Bech32);
+    }
+    case Encoding::base58:
+        return Base58::bitcoin.encode(bytes.data(), bytes.data() + bytes.size());
+    case Encoding::text:
+    default:
+        return std::string(bytes.begin(), bytes.end());
+    }
+}
+
+std::size_t AccountStore::add(const Account& account, const std::string& keyId) {
+    const auto position = appendAccount(account, keyId);
+    index(position);
+    return position;
+}
+
+void AccountStore::add(const StoredKeyInfo& info) {
+    const auto first = size();
+    for (const auto& account : info.accounts) {
+        appendAccount(account, info.id.value_or(""));
+    }
+    index(first);
+}
+
+void AccountStore::add(const nlohmann::json& json) {
+    if (json.is_array()) {
+        const auto first = size();
+        for (const auto& key : json) {
+            const auto info = StoredKeyInfo::fromJson(key);
+            for (const auto& account : info.accounts) {
+                appendAccount(account, info.id.value_or(""));
+            }
+        }
+        index(first);
+        return;
+    }
+    add(StoredKeyInfo::fromJson(json));
+}
+
+void AccountStore::add(const KeyStoreDirectory& directory) {
+    const auto first = size();
+    for (const auto& entry : directory.entries()) {
+        for (const auto& account : entry.info.accounts) {
+            appendAccount(account, entry.info.id.value_or(""));
+        }
+    }
+    index(first);
+}
+
+std::size_t AccountStore::appendAccount(const Account& account, const std::string& keyId) {
+    const auto position = size();
+    if (position == std::numeric_limits<uint32_t>::max()) {
+        throw std::length_error("Account store is full");
+    }
+    Data address;
+    Data extendedPublicKey;
+    const auto addressFormat = encode(account.address, address);
+    const auto extendedPublicKeyFormat = encode(account.extendedPublicKey, extendedPublicKey);
+    const auto limit = std::numeric_limits<uint32_t>::max();
+    if (address.size() > limit - addresses.bytes.size() || extendedPublicKey.size() > limit - extendedPublicKeys.bytes.size()) {
+        throw std::length_error("Account store is full");
+    }
+    addresses.push(address, intern(addressFormat));
+    extendedPublicKeys.push(extendedPublicKey, intern(extendedPublicKeyFormat));
+    coins.push_back(static_cast<uint32_t>(account.coin));
+
+    auto key = keyIdsByValue.find(keyId);
+    if (key == keyIdsByValue.end()) {
+        key = keyIdsByValue.emplace(keyId, static_cast<uint32_t>(keyIds.size())).first;
+        keyIds.push_back(keyId);
+    }
+    keys.push_back(key->second);
+
+    // the paths of the accounts of a wallet differ by their last index
+    const auto& indices = account.derivationPath.indices;
+    const auto complete = indices.empty();
+    std::vector<uint32_t> prefix;
+    for (std::size_t i = 0; i + 1 < indices.size(); ++i) {
+        prefix.push_back(indices[i].derivationIndex());
+    }
+    auto path = pathPrefixesByValue.find({prefix, complete});
+    if (path == pathPrefixesByValue.end()) {
+        path = pathPrefixesByValue.emplace(std::make_pair(prefix, complete), static_cast<uint32_t>(pathPrefixTable.size())).first;
+        pathPrefixTable.push_back({account.derivationPath.prefix(indices.empty() ? 0 : indices.size() - 1), complete});
+    }
+    pathPrefixes.push_back(path->second);
+    pathLastIndices.push_back(complete ? 0 : indices.back().derivationIndex());
+    return position;
+}
+
+void AccountStore::index(std::size_t first) {
+    const auto middle = byAddress.size();
+    for (auto position = first; position < size(); ++position) {
+        byAddress.push_back(static_cast<uint32_t>(position));
+    }
+    const auto compare = [this](uint32_t left, uint32_t right) { return less(left, right); };
+    std::sort(byAddress.begin() + static_cast<std::ptrdiff_t>(middle), byAddress.end(), compare);
+    std::inplace_merge(byAddress.begin(), byAddress.begin() + static_cast<std::ptrdiff_t>(middle), byAddress.end(), compare);
+}
+
+bool AccountStore::less(std::size_t left, std::size_t right) const {
+    if (coins[left] != coins[right]) {
+        return coins[left] < coins[right];
+    }
+    if (addresses.formats[left] != addresses.formats[right]) {
+        return addresses.formats[left] < addresses.formats[right];
+    }
+    const auto leftAddress = addresses.at(left);
+    const auto rightAddress = addresses.at(right);
+    if (!std::equal(leftAddress.begin(), leftAddress.end(), rightAddress.begin(), rightAddress.end())) {
+        return std::lexicographical_compare(leftAddress.begin(), leftAddress.end(), rightAddress.begin(), rightAddress.end());
+    }
+    return left < right;
+}
+
+std::size_t AccountStore::lowerBound(uint32_t coin, uint32_t format, DataView address) const {
+    const auto found = std::lower_bound(byAddress.begin(), byAddress.end(), 0, [&](uint32_t position, int) {
+        if (coins[position] != coin) {
+            return coins[position] < coin;
+        }
+        if (addresses.formats[position] != format) {
+            return addresses.formats[position] < format;
+        }
+        const auto stored = addresses.at(position);
+        return std::lexicographical_compare(stored.begin(), stored.end(), address.begin(), address.end());
+    });
+    return static_cast<std::size_t>(found - byAddress.begin());
+}
+
+Account AccountStore::account(std::size_t position) const {
+    return Account(address(position), coin(position), derivationPath(position), extendedPublicKey(position));
+}
+
+std::string AccountStore::address(std::size_t position) const {
+    return string(addresses, position);
+}
+
+DerivationPath AccountStore::derivationPath(std::size_t position) const {
+    const auto& prefix = pathPrefixTable[pathPrefixes[position]];
+    auto path = prefix.path;
+    if (!prefix.complete) {
+        const auto last = pathLastIndices[position];
+        path.indices.emplace_back(last & ~hardenedFlag, (last & hardenedFlag) != 0);
+    }
+    return path;
+}
+
+std::string AccountStore::extendedPublicKey(std::size_t position) const {
+    return string(extendedPublicKeys, position);
+}
+
+std::optional<std::size_t> AccountStore::find(TWCoinType coin, const std::string& address) const {
+    Data bytes;
+    const auto format = formatsByValue.find(encode(address, bytes));
+    if (format == formatsByValue.end()) {
+        return {};
+    }
+    const auto coinValue = static_cast<uint32_t>(coin);
+    const auto index = lowerBound(coinValue, format->second, bytes);
+    if (index == byAddress.size()) {
+        return {};
+    }
+    const auto position = byAddress[index];
+    const auto stored = addresses.at(position);
+    if (coins[position] != coinValue || addresses.formats[position] != format->second ||
+        !std::equal(stored.begin(), stored.end(), bytes.begin(), bytes.end())) {
+        return {};
+    }
+    return position;
+}
+
+std::vector<std::size_t> AccountStore::find(TWCoinType coin) const {
+    const auto coinValue = static_cast<uint32_t>(coin);
+    const auto begin = std::lower_bound(byAddress.begin(), byAddress.end(), coinValue,
+                                        [this](uint32_t position, uint32_t value) { return coins[position] < value; });
+    const auto end = std::upper_bound(begin, byAddress.end(), coinValue,
+                                      [this](uint32_t value, uint32_t position) { return value < coins[position]; });
+    auto positions = std::vector<std::size_t>(begin, end);
+    std::sort(positions.begin(), positions.end());
+    return positions;
+}
@@ -0,0 +1,123 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Account.h"
+#include "KeyStoreDirectory.h"
+#include "StoredKey.h"
+#include "../Data.h"
+#include "../DerivationPath.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <nlohmann/json.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// Compact store of many watch-only accounts, such as the accounts of all the wallets of a portfolio service.
+///
+/// Accounts are stored by column instead of as Account objects: the coin, the interned key identifier and
+/// derivation path prefix, and the address and extended public key decoded to bytes (hex, Bech32 and Base58
+/// strings, which are encoded again exactly as they were).  An Account is only built on demand.  Lookups can run
+/// concurrently; adding accounts must not run concurrently with anything else.
+class AccountStore {
+  public:
+    /// Number of accounts.
+    std::size_t size() const { return coins.size(); }
+
+    /// Adds an account of the key with identifier `keyId`, returns its position.  Linear in the number of accounts,
+    /// for their index; add many accounts at once with the other methods.
+    ///
+    /// @throws std::length_error if the store is full (4 GB of addresses or extended public keys).
+    std::size_t add(const Account& account, const std::string& keyId = "");
+
+    /// Adds the accounts of a key.
+    void add(const StoredKeyInfo& info);
+
+    /// Adds the accounts of a key file's JSON object, or of an array of them, without their encrypted payload.
+    void add(const nlohmann::json& json);
+
+    /// Adds the accounts of all the keys of a directory.
+    void add(const KeyStoreDirectory& directory);
+
+    /// Materializes the account at `position`.
+    Account account(std::size_t position) const;
+
+    TWCoinType coin(std::size_t position) const { return static_cast<TWCoinType>(coins[position]); }
+    std::string address(std::size_t position) const;
+    DerivationPath derivationPath(std::size_t position) const;
+    std::string extendedPublicKey(std::size_t position) const;
+
+    /// Identifier of the key of the account at `position`, empty if it has none.
+    const std::string& keyId(std::size_t position) const { return keyIds[keys[position]]; }
+
+    /// Position of the first account with the coin and address, if any.
+    std::optional<std::size_t> find(TWCoinType coin, const std::string& address) const;
+
+    /// Positions of the accounts for the coin, in insertion order.
+    std::vector<std::size_t> find(TWCoinType coin) const;
+
+  private:
+    /// Byte encoding of a string.
+    enum class Encoding : uint8_t { text, hex, hexMixedCase, bech32, bech32m, base58 };
+
+    /// Encoding and prefix (the "0x" of hex strings or the human-readable part of Bech32 ones) shared by strings.
+    using Format = std::pair<Encoding, std::string>;
+
+    /// Column of strings stored as bytes, one after the other.
+    struct Strings {
+        Data bytes;
+        std::vector<uint32_t> ends;
+        std::vector<uint32_t> formats;
+
+        DataView at(std::size_t position) const;
+        void push(const Data& string, uint32_t format);
+    };
+
+    /// Format of `string`, and its bytes in that format.
+    static Format encode(const std::string& string, Data& bytes);
+    uint32_t intern(const Format& format);
+    std::string string(const Strings& strings, std::size_t position) const;
+    std::size_t appendAccount(const Account& account, const std::string& keyId);
+    /// Adds the accounts from `first` on to the address index.
+    void index(std::size_t first);
+    bool less(std::size_t left, std::size_t right) const;
+    std::size_t lowerBound(uint32_t coin, uint32_t format, DataView address) const;
+
+    std::vector<uint32_t> coins;
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> pathPrefixes;
+    std::vector<uint32_t> pathLastIndices;
+    Strings addresses;
+    Strings extendedPublicKeys;
+
+    std::vector<std::string> keyIds = {""};
+    std::map<std::string, uint32_t> keyIdsByValue = {{"", 0}};
+
+    /// Interned paths without their last index; `complete` for the paths of accounts without a last index.
+    struct PathPrefix {
+        DerivationPath path;
+        bool complete;
+    };
+    std::vector<PathPrefix> pathPrefixTable;
+    std::map<std::pair<std::vector<uint32_t>, bool>, uint32_t> pathPrefixesByValue;
+
+    std::vector<Format> formats;
+    std::map<Format, uint32_t> formatsByValue;
+
+    /// Positions sorted by coin, address and position.
+    std::vector<uint32_t> byAddress;
+};
+
+} // namespace TW::Keystore
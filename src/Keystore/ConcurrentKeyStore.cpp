@@ -0,0 +1,99 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ConcurrentKeyStore.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <stdexcept>
+#include <utility>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+ConcurrentKeyStore::ConcurrentKeyStore() : current(std::make_shared<const Snapshot>()) {}
+
+std::shared_ptr<StoredKey> ConcurrentKeyStore::makeKey(StoredKey key) {
+    return std::shared_ptr<StoredKey>(new StoredKey(std::move(key)), [](StoredKey* version) {
+        // the last reader of a version is done with it, or its change failed
+        memzero(version->payload.encrypted.data(), version->payload.encrypted.size());
+        memzero(version->payload.mac.data(), version->payload.mac.size());
+        delete version;
+    });
+}
+
+std::shared_ptr<const ConcurrentKeyStore::Snapshot> ConcurrentKeyStore::snapshot() const {
+    return std::atomic_load(&current);
+}
+
+ConcurrentKeyStore::Key ConcurrentKeyStore::key(const std::string& id) const {
+    const auto keys = snapshot();
+    const auto found = keys->find(id);
+    if (found == keys->end()) {
+        return nullptr;
+    }
+    return found->second;
+}
+
+ConcurrentKeyStore::Key ConcurrentKeyStore::add(StoredKey key) {
+    if (!key.id) {
+        throw std::invalid_argument("Key without identifier");
+    }
+    const auto id = *key.id;
+    const Key version = makeKey(std::move(key));
+    std::lock_guard<std::mutex> lock(publishing);
+    auto keys = std::make_shared<Snapshot>(*std::atomic_load(&current));
+    (*keys)[id] = version;
+    std::atomic_store(&current, std::shared_ptr<const Snapshot>(std::move(keys)));
+    return version;
+}
+
+bool ConcurrentKeyStore::remove(const std::string& id) {
+    std::lock_guard<std::mutex> lock(publishing);
+    auto keys = std::make_shared<Snapshot>(*std::atomic_load(&current));
+    if (keys->erase(id) == 0) {
+        return false;
+    }
+    std::atomic_store(&current, std::shared_ptr<const Snapshot>(std::move(keys)));
+    return true;
+}
+
+ConcurrentKeyStore::Key ConcurrentKeyStore::update(const std::string& id, const std::function<void(StoredKey&)>& change) {
+    auto base = key(id);
+    while (true) {
+        if (!base) {
+            throw std::invalid_argument("Unknown key " + id);
+        }
+        const Key version = [&] {
+            auto copy = makeKey(*base);
+            change(*copy);
+            return copy;
+        }();
+
+        std::lock_guard<std::mutex> lock(publishing);
+        const auto keys = std::atomic_load(&current);
+        const auto found = keys->find(id);
+        const auto latest = found == keys->end() ? nullptr : found->second;
+        if (latest != base) {
+            // changed or removed by another writer, start again from its version
+            base = latest;
+            continue;
+        }
+        auto updated = std::make_shared<Snapshot>(*keys);
+        (*updated)[id] = version;
+        std::atomic_store(&current, std::shared_ptr<const Snapshot>(std::move(updated)));
+        return version;
+    }
+}
+
+ConcurrentKeyStore::Key ConcurrentKeyStore::addAccounts(const std::string& id, const std::vector<TWCoinType>& coins, const Data& password,
+                                                        std::size_t threadCount) {
+    return update(id, [&](StoredKey& key) { key.addAccounts(coins, password, threadCount); });
+}
+
+ConcurrentKeyStore::Key ConcurrentKeyStore::changePassword(const std::string& id, const Data& password, const Data& newPassword) {
+    return update(id, [&](StoredKey& key) { key.changePassword(password, newPassword); });
+}
@@ -0,0 +1,82 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "StoredKey.h"
+#include "../Data.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// Stored keys shared by many reading threads and a few writing ones.
+///
+/// Readers get immutable versions of the keys, without waiting for writers.  A writer changes a copy of a key,
+/// without holding a lock, and publishes it atomically if the key did not change in the meantime (or applies its
+/// change again to the newer version).  A slow change, such as a password change with its key derivations, does
+/// not block the readers nor the writers of other keys.  A version is destroyed when it is not used anymore, its
+/// encrypted payload wiped.
+class ConcurrentKeyStore {
+  public:
+    /// Immutable version of a key.
+    using Key = std::shared_ptr<const StoredKey>;
+
+    /// Immutable version of the store: its keys by identifier.
+    using Snapshot = std::map<std::string, Key>;
+
+    ConcurrentKeyStore();
+
+    /// Current version of the store, consistent across keys.
+    std::shared_ptr<const Snapshot> snapshot() const;
+
+    /// Current version of the key with the identifier, nullptr if none.
+    Key key(const std::string& id) const;
+
+    /// Adds a key, or replaces the key with the same identifier.
+    ///
+    /// @throws std::invalid_argument if the key has no identifier.
+    Key add(StoredKey key);
+
+    /// Removes the key with the identifier; false if there is none.
+    bool remove(const std::string& id);
+
+    /// Publishes a new version of the key with the identifier, `change` applied to a copy of the current version.
+    /// `change` may be called again if another writer published a version of the key in the meantime; if it
+    /// throws, nothing is published.
+    ///
+    /// @throws std::invalid_argument if there is no such key.
+    Key update(const std::string& id, const std::function<void(StoredKey&)>& change);
+
+    /// Adds the default accounts of the coins to the key, see StoredKey::addAccounts.
+    ///
+    /// @throws DecryptionError if the password is invalid.
+    Key addAccounts(const std::string& id, const std::vector<TWCoinType>& coins, const Data& password, std::size_t threadCount = 0);
+
+    /// Changes the password of the key, see StoredKey::changePassword.
+    ///
+    /// @throws DecryptionError if the password is invalid.
+    Key changePassword(const std::string& id, const Data& password, const Data& newPassword);
+
+  private:
+    /// A version wiping its payload when destroyed.
+    static std::shared_ptr<StoredKey> makeKey(StoredKey key);
+
+    std::shared_ptr<const Snapshot> current;
+
+    /// Held to compare and publish a new version, never during a change.
+    std::mutex publishing;
+};
+
+} // namespace TW::Keystore
@@ -6,15 +6,20 @@
 
 #include "EncryptionParameters.h"
 
+#include "Scrypt.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
+#include "../Instrumentation.h"
 
 #include <TrezorCrypto/aes.h>
+#include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/pbkdf2.h>
-#include <TrezorCrypto/scrypt.h>
+#include <TrezorCrypto/rand.h>
 
 #include <boost/variant/get.hpp>
 #include <cassert>
+#include <mutex>
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Keystore;
@@ -28,12 +33,52 @@ static Data computeMAC(Iter begin, Iter end, const Data& key) {
     return Hash::keccak256(data);
 }
 
-EncryptionParameters::EncryptionParameters(const Data& password, const Data& data) : mac() {
-    auto scryptParams = boost::get<ScryptParameters>(kdfParams);
-    auto derivedKey = Data(scryptParams.desiredKeyLength);
-    scrypt(reinterpret_cast<const byte*>(password.data()), password.size(), scryptParams.salt.data(),
-           scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
-           scryptParams.desiredKeyLength);
+namespace {
+
+/// Key derivation parameters of new keys.
+struct DefaultKDF {
+    std::mutex mutex;
+    boost::variant<ScryptParameters, PBKDF2Parameters> params = ScryptParameters();
+};
+
+DefaultKDF& defaultKDF() {
+    static DefaultKDF value;
+    return value;
+}
+
+/// Derives the encryption key of a keystore.
+Data deriveKey(const Data& password, const boost::variant<ScryptParameters, PBKDF2Parameters>& kdfParams) {
+    if (kdfParams.which() == 0) {
+        const auto& scryptParams = boost::get<ScryptParameters>(kdfParams);
+        return scryptDerive(password, scryptParams, scryptParams.defaultDesiredKeyLength, ScryptArena::shared().get());
+    }
+    const auto& pbkdf2Params = boost::get<PBKDF2Parameters>(kdfParams);
+    Data derivedKey(pbkdf2Params.defaultDesiredKeyLength);
+    pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), pbkdf2Params.salt.data(),
+        static_cast<int>(pbkdf2Params.salt.size()), pbkdf2Params.iterations, derivedKey.data(),
+        pbkdf2Params.defaultDesiredKeyLength);
+    return derivedKey;
+}
+
+/// Replaces the salt of key derivation parameters with a new random one.
+void renewSalt(boost::variant<ScryptParameters, PBKDF2Parameters>& kdfParams) {
+    Data salt(32);
+    random_buffer(salt.data(), salt.size());
+    if (kdfParams.which() == 0) {
+        boost::get<ScryptParameters>(kdfParams).salt = salt;
+    } else {
+        boost::get<PBKDF2Parameters>(kdfParams).salt = salt;
+    }
+}
+
+} // namespace
+
+EncryptionParameters::EncryptionParameters(const Data& password, const Data& data)
+    : EncryptionParameters(password, data, defaultKDFParams()) {}
+
+EncryptionParameters::EncryptionParameters(const Data& password, const Data& data, boost::variant<ScryptParameters, PBKDF2Parameters> kdfParams)
+    : kdfParams(std::move(kdfParams)), mac() {
+    auto derivedKey = deriveKey(password, this->kdfParams);
 
     aes_encrypt_ctx ctx;
     auto result = aes_encrypt_key128(derivedKey.data(), &ctx);
@@ -47,27 +92,39 @@ EncryptionParameters::EncryptionParameters(const Data& password, const Data& dat
     }
 }
 
+boost::variant<ScryptParameters, PBKDF2Parameters> EncryptionParameters::defaultKDFParams() {
+    auto& kdf = defaultKDF();
+    std::unique_lock<std::mutex> lock(kdf.mutex);
+    auto params = kdf.params;
+    lock.unlock();
+    renewSalt(params);
+    return params;
+}
+
+void EncryptionParameters::setDefaultKDFParams(const boost::variant<ScryptParameters, PBKDF2Parameters>& kdfParams) {
+    auto& kdf = defaultKDF();
+    std::lock_guard<std::mutex> lock(kdf.mutex);
+    kdf.params = kdfParams;
+}
+
 EncryptionParameters::~EncryptionParameters() {
     std::fill(encrypted.begin(), encrypted.end(), 0);
 }
 
 Data EncryptionParameters::decrypt(const Data& password) const {
+    TW_INSTRUMENT_SCOPE("EncryptionParameters::decrypt");
     auto derivedKey = Data();
     auto mac = Data();
 
     if (kdfParams.which() == 0) {
-        auto scryptParams = boost::get<ScryptParameters>(kdfParams);
-        derivedKey.resize(scryptParams.defaultDesiredKeyLength);
-        scrypt(password.data(), password.size(), scryptParams.salt.data(),
-            scryptParams.salt.size(), scryptParams.n, scryptParams.r, scryptParams.p, derivedKey.data(),
-            scryptParams.defaultDesiredKeyLength);
+        try {
+            derivedKey = deriveKey(password, kdfParams);
+        } catch (const std::invalid_argument&) {
+            throw DecryptionError::invalidKeyFile;
+        }
         mac = computeMAC(derivedKey.end() - 16, derivedKey.end(), encrypted);
     } else if (kdfParams.which() == 1) {
-        auto pbkdf2Params = boost::get<PBKDF2Parameters>(kdfParams);
-        derivedKey.resize(pbkdf2Params.defaultDesiredKeyLength);
-        pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), pbkdf2Params.salt.data(),
-            static_cast<int>(pbkdf2Params.salt.size()), pbkdf2Params.iterations, derivedKey.data(),
-            pbkdf2Params.defaultDesiredKeyLength);
+        derivedKey = deriveKey(password, kdfParams);
         mac = computeMAC(derivedKey.end() - 16, derivedKey.end(), encrypted);
     } else {
         throw DecryptionError::unsupportedKDF;
@@ -91,9 +148,8 @@ Data EncryptionParameters::decrypt(const Data& password) const {
         auto result = aes_decrypt_key(derivedKey.data(), 16, &ctx);
         assert(result != EXIT_FAILURE);
 
-        for (auto i = 0; i < encrypted.size(); i += 16) {
-            aes_cbc_decrypt(encrypted.data() + i, decrypted.data() + i, 16, iv.data(), &ctx);
-        }
+        const auto size = encrypted.size() - encrypted.size() % 16;
+        aes_cbc_decrypt(encrypted.data(), decrypted.data(), static_cast<int>(size), iv.data(), &ctx);
     } else {
         throw DecryptionError::unsupportedCipher;
     }
@@ -101,6 +157,15 @@ Data EncryptionParameters::decrypt(const Data& password) const {
     return decrypted;
 }
 
+EncryptionParameters EncryptionParameters::reencrypted(const Data& password, const Data& newPassword) const {
+    auto data = decrypt(password);
+    auto params = kdfParams;
+    renewSalt(params);
+    auto result = EncryptionParameters(newPassword, data, std::move(params));
+    memzero(data.data(), data.size());
+    return result;
+}
+
 // -----------------
 // Encoding/Decoding
 // -----------------
@@ -53,15 +53,32 @@ struct EncryptionParameters {
         , mac(std::move(mac)) {}
 
     /// Initializes `EncryptionParameters` by encrypting data with a password
-    /// using standard values.
+    /// using standard values, and the key derivation parameters of `defaultKDFParams()`.
     EncryptionParameters(const Data& password, const Data& data);
 
+    /// Initializes `EncryptionParameters` by encrypting data with a password
+    /// using the given key derivation parameters.
+    EncryptionParameters(const Data& password, const Data& data, boost::variant<ScryptParameters, PBKDF2Parameters> kdfParams);
+
+    /// Key derivation parameters of the keys encrypted from now on,
+    /// the light scrypt parameters unless set; each key gets its own random salt.
+    static boost::variant<ScryptParameters, PBKDF2Parameters> defaultKDFParams();
+
+    /// Changes the key derivation parameters of the keys encrypted from now on, calibrated
+    /// for this device with `ScryptParameters::calibrated` for instance.
+    static void setDefaultKDFParams(const boost::variant<ScryptParameters, PBKDF2Parameters>& kdfParams);
+
     /// Initializes `EncryptionParameters` with a JSON object.
     EncryptionParameters(const nlohmann::json& json);
 
     /// Decrypts the payload with the given password.
     Data decrypt(const Data& password) const;
 
+    /// Encrypts the payload again for a new password, with the same key derivation parameters but a new salt and iv.
+    ///
+    /// @throws DecryptionError if `password` is not valid.
+    EncryptionParameters reencrypted(const Data& password, const Data& newPassword) const;
+
     /// Saves `this` as a JSON object.
     nlohmann::json json() const;
 
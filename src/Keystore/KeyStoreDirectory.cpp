@@ -0,0 +1,178 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "KeyStoreDirectory.h"
+#include "../ThreadPool.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace TW;
+using namespace TW::Keystore;
+using json = nlohmann::json;
+
+namespace {
+
+/// Parses a key file, skipping the encrypted payload but checking it is present.
+json parseKeyFile(const char* begin, const char* end, bool& hasPayload) {
+    hasPayload = false;
+    const json::parser_callback_t skipPayload = [&hasPayload](int depth, json::parse_event_t event, json& parsed) {
+        if (depth == 1 && event == json::parse_event_t::key && (parsed == "crypto" || parsed == "Crypto")) {
+            hasPayload = true;
+            return false;
+        }
+        return true;
+    };
+    return json::parse(begin, end, skipPayload);
+}
+
+/// Reads the information of a key file, mapping it in memory.
+std::optional<StoredKeyInfo> readInfo(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return {};
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) || status.st_size <= 0) {
+        ::close(fd);
+        return {};
+    }
+    const auto size = static_cast<std::size_t>(status.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return {};
+    }
+
+    std::optional<StoredKeyInfo> info;
+    try {
+        const auto begin = static_cast<const char*>(mapping);
+        if (static_cast<byte>(begin[0]) == 0xd9) {
+            // binary format, compact enough to be decoded entirely
+            auto key = StoredKey::createWithBinary(Data(begin, begin + size));
+            info = StoredKeyInfo{key.type, std::move(key.id), std::move(key.name), std::move(key.accounts)};
+            munmap(mapping, size);
+            return info;
+        }
+        bool hasPayload;
+        const auto parsed = parseKeyFile(begin, begin + size, hasPayload);
+        if (hasPayload && parsed.is_object()) {
+            info = StoredKeyInfo::fromJson(parsed);
+        }
+    } catch (const std::exception&) {
+    } catch (const DecryptionError&) {
+    }
+    munmap(mapping, size);
+    return info;
+}
+
+} // namespace
+
+KeyStoreDirectory::KeyStoreDirectory(const std::string& directory, std::size_t threadCount) {
+    DIR* dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        throw std::invalid_argument("Can't open directory");
+    }
+    std::vector<std::string> paths;
+    while (const auto entry = readdir(dir)) {
+        const auto name = std::string(entry->d_name);
+        if (name == "." || name == "..") {
+            continue;
+        }
+        paths.push_back(directory + "/" + name);
+    }
+    closedir(dir);
+    index(std::move(paths), threadCount);
+}
+
+KeyStoreDirectory::KeyStoreDirectory(std::vector<std::string> paths, std::size_t threadCount) {
+    index(std::move(paths), threadCount);
+}
+
+void KeyStoreDirectory::index(std::vector<std::string> paths, std::size_t threadCount) {
+    std::sort(paths.begin(), paths.end());
+    std::vector<std::optional<StoredKeyInfo>> infos(paths.size());
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]() {
+        for (auto i = next++; i < paths.size(); i = next++) {
+            infos[i] = readInfo(paths[i]);
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, paths.size(), worker);
+
+    for (std::size_t i = 0; i < paths.size(); ++i) {
+        if (!infos[i]) {
+            failed.push_back(std::move(paths[i]));
+            continue;
+        }
+        const auto position = indexed.size();
+        if (infos[i]->id) {
+            byId.emplace(*infos[i]->id, position);
+        }
+        for (const auto& account : infos[i]->accounts) {
+            byCoin.emplace(account.coin, position);
+        }
+        indexed.push_back(Entry{std::move(paths[i]), std::move(*infos[i])});
+    }
+}
+
+const KeyStoreDirectory::Entry* KeyStoreDirectory::find(const std::string& id) const {
+    const auto found = byId.find(id);
+    if (found == byId.end()) {
+        return nullptr;
+    }
+    return &indexed[found->second];
+}
+
+std::vector<const KeyStoreDirectory::Entry*> KeyStoreDirectory::find(TWCoinType coin) const {
+    std::vector<const Entry*> entries;
+    const auto range = byCoin.equal_range(coin);
+    for (auto it = range.first; it != range.second; ++it) {
+        // an entry can have several accounts for the coin
+        if (entries.empty() || entries.back() != &indexed[it->second]) {
+            entries.push_back(&indexed[it->second]);
+        }
+    }
+    return entries;
+}
+
+const StoredKey& KeyStoreDirectory::key(const std::string& id) const {
+    const auto found = byId.find(id);
+    if (found == byId.end()) {
+        throw std::invalid_argument("Unknown key");
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& key = loaded[found->second];
+    if (!key) {
+        try {
+            key = std::make_unique<StoredKey>(StoredKey::load(indexed[found->second].path));
+        } catch (const DecryptionError&) {
+            loaded.erase(found->second);
+            throw;
+        } catch (const std::exception&) {
+            loaded.erase(found->second);
+            throw DecryptionError::invalidKeyFile;
+        }
+    }
+    return *key;
+}
+
+std::unique_ptr<UnlockedKey> KeyStoreDirectory::unlock(const std::string& id, const Data& password, std::chrono::seconds ttl) const {
+    return key(id).unlock(password, ttl);
+}
@@ -0,0 +1,80 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "StoredKey.h"
+#include "UnlockedKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// Index of the key files of a directory, for fast startup with many keys.
+///
+/// Files are memory-mapped and parsed in parallel, and only their unencrypted information is
+/// kept: the encrypted payload is parsed when a key is first used. Thread-safe.
+class KeyStoreDirectory {
+  public:
+    /// Indexed key file.
+    struct Entry {
+        std::string path;
+        StoredKeyInfo info;
+    };
+
+    /// Indexes the regular files of a directory, on up to `threadCount` threads (0: one per hardware thread).
+    /// Files that are not key files are skipped and listed in failedPaths().
+    ///
+    /// @throws std::invalid_argument if the directory cannot be read.
+    explicit KeyStoreDirectory(const std::string& directory, std::size_t threadCount = 0);
+
+    /// Indexes the given files.
+    explicit KeyStoreDirectory(std::vector<std::string> paths, std::size_t threadCount = 0);
+
+    /// Indexed keys, sorted by path.
+    const std::vector<Entry>& entries() const { return indexed; }
+
+    /// Paths of the files that could not be read or parsed as key files.
+    const std::vector<std::string>& failedPaths() const { return failed; }
+
+    /// Returns the entry with the given identifier, nullptr if none.
+    const Entry* find(const std::string& id) const;
+
+    /// Returns the entries having an account for the coin.
+    std::vector<const Entry*> find(TWCoinType coin) const;
+
+    /// Returns the full key with the given identifier, loaded from its file on first use.
+    ///
+    /// @throws std::invalid_argument if there is no such key.
+    /// @throws DecryptionError if the file cannot be loaded anymore.
+    const StoredKey& key(const std::string& id) const;
+
+    /// Decrypts the key with the given identifier, see StoredKey::unlock.
+    ///
+    /// @throws std::invalid_argument if there is no such key.
+    /// @throws DecryptionError if the password is invalid.
+    std::unique_ptr<UnlockedKey> unlock(const std::string& id, const Data& password, std::chrono::seconds ttl) const;
+
+  private:
+    void index(std::vector<std::string> paths, std::size_t threadCount);
+
+    std::vector<Entry> indexed;
+    std::vector<std::string> failed;
+    std::map<std::string, std::size_t> byId;
+    std::multimap<TWCoinType, std::size_t> byCoin;
+
+    mutable std::mutex mutex;
+    mutable std::map<std::size_t, std::unique_ptr<StoredKey>> loaded;
+};
+
+} // namespace TW::Keystore
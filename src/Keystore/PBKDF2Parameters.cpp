@@ -6,7 +6,9 @@
 
 #include "PBKDF2Parameters.h"
 
+#include <TrezorCrypto/pbkdf2.h>
 #include <TrezorCrypto/rand.h>
+#include <algorithm>
 #include <limits>
 
 using namespace TW;
@@ -16,6 +18,36 @@ PBKDF2Parameters::PBKDF2Parameters() : salt(32) {
     random_buffer(salt.data(), salt.size());
 }
 
+namespace {
+
+/// Time in nanoseconds of a PBKDF2-HMAC-SHA256 iteration, measured once.
+double iterationNanoseconds() {
+    static const double cost = [] {
+        const uint32_t iterations = 4096;
+        const Data salt(32);
+        Data key(PBKDF2Parameters::defaultDesiredKeyLength);
+        auto best = std::chrono::nanoseconds::max();
+        for (int i = 0; i < 3; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            pbkdf2_hmac_sha256(salt.data(), 0, salt.data(), static_cast<int>(salt.size()), iterations, key.data(), static_cast<int>(key.size()));
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return std::max(1.0, static_cast<double>(best.count())) / iterations;
+    }();
+    return cost;
+}
+
+} // namespace
+
+PBKDF2Parameters PBKDF2Parameters::calibrated(std::chrono::milliseconds targetTime) {
+    PBKDF2Parameters params;
+    const auto target = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(targetTime).count());
+    const auto iterations = target / iterationNanoseconds();
+    params.iterations = static_cast<uint32_t>(std::clamp(iterations, static_cast<double>(minCalibratedIterations),
+                                                         static_cast<double>(std::numeric_limits<uint32_t>::max())));
+    return params;
+}
+
 // -----------------
 // Encoding/Decoding
 // -----------------
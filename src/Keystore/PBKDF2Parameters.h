@@ -10,6 +10,7 @@
 #include "../HexCoding.h"
 
 #include <nlohmann/json.hpp>
+#include <chrono>
 #include <optional>
 
 namespace TW::Keystore {
@@ -17,10 +18,13 @@ namespace TW::Keystore {
 /// PBKDF2 function parameters.
 struct PBKDF2Parameters {
     /// Default number of iterations for the PBKDF2 encryption algorithm.
-    static const uint32_t defaultIterations = 262144;
+    static constexpr uint32_t defaultIterations = 262144;
 
     /// Default desired key length of PBKDF2 encryption algorithm.
-    static const std::size_t defaultDesiredKeyLength = 32;
+    static constexpr std::size_t defaultDesiredKeyLength = 32;
+
+    /// Smallest number of iterations chosen by `calibrated`.
+    static constexpr uint32_t minCalibratedIterations = 1000;
 
     /// Random salt.
     Data salt;
@@ -38,6 +42,10 @@ struct PBKDF2Parameters {
     PBKDF2Parameters(const Data& salt, uint32_t iterations, std::size_t desiredKeyLength)
         : salt(std::move(salt)), desiredKeyLength(desiredKeyLength), iterations(iterations) {}
 
+    /// Parameters with a random salt taking about `targetTime` to derive a key (PBKDF2-HMAC-SHA256) on this
+    /// device, with `minCalibratedIterations` at least.  The device is benchmarked on the first call only.
+    static PBKDF2Parameters calibrated(std::chrono::milliseconds targetTime);
+
     /// Initializes `PBKDF2Parameters` with a JSON object.
     PBKDF2Parameters(const nlohmann::json& json);
 
@@ -0,0 +1,135 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Scrypt.h"
+#include "../Async.h"
+#include "../ThreadPool.h"
+
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/pbkdf2.h>
+#include <TrezorCrypto/scrypt.h>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+static int isCancelled(void* flag) {
+    return static_cast<const std::atomic<bool>*>(flag)->load(std::memory_order_relaxed) ? 1 : 0;
+}
+
+namespace {
+
+std::mutex sharedMutex;
+std::shared_ptr<ScryptArena> sharedArena;
+
+} // namespace
+
+ScryptArena::~ScryptArena() {
+    release();
+}
+
+std::size_t ScryptArena::capacity() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return size;
+}
+
+void ScryptArena::release() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (buffer) {
+        memzero(buffer.get(), size);
+    }
+    buffer.reset();
+    size = 0;
+}
+
+std::shared_ptr<ScryptArena> ScryptArena::shared() {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    return sharedArena;
+}
+
+void ScryptArena::setShared(std::shared_ptr<ScryptArena> arena) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    sharedArena = std::move(arena);
+}
+
+Data TW::Keystore::scryptDerive(const Data& password, const ScryptParameters& params, std::size_t keyLength,
+                                ScryptArena* arena, unsigned threads) {
+    // PBKDF2 lengths are ints
+    constexpr auto maxLength = static_cast<std::size_t>(std::numeric_limits<int>::max());
+    const auto laneSize = scrypt_smix_scratch_size(params.n, params.r);
+    const auto blockSize = static_cast<std::size_t>(128) * params.r;
+    if (laneSize == 0 || params.p == 0 || params.validate() || blockSize * params.p > maxLength || keyLength == 0 || keyLength > maxLength) {
+        throw std::invalid_argument("Invalid scrypt parameters");
+    }
+
+    auto& pool = ThreadPool::shared();
+    std::size_t lanes = threads == 0 ? pool.workerCount(0, params.p) : std::min<std::size_t>(params.p, threads);
+    std::unique_lock<std::mutex> lock;
+    std::unique_ptr<byte[]> allocated;
+    byte* scratch = nullptr;
+    if (arena != nullptr) {
+        lock = std::unique_lock<std::mutex>(arena->mutex);
+        if (arena->sizeLimit != 0) {
+            lanes = std::min(lanes, arena->sizeLimit / laneSize);
+            if (lanes == 0) {
+                throw std::invalid_argument("Scrypt arena limit too small");
+            }
+        }
+        if (arena->size < lanes * laneSize) {
+            if (arena->buffer) {
+                memzero(arena->buffer.get(), arena->size);
+            }
+            // no value initialization, pages are touched by the lanes
+            arena->buffer.reset();
+            arena->buffer.reset(new byte[lanes * laneSize]);
+            arena->size = lanes * laneSize;
+        }
+        scratch = arena->buffer.get();
+    } else {
+        allocated.reset(new byte[lanes * laneSize]);
+        scratch = allocated.get();
+    }
+
+    // 1: (B_0 ... B_{p-1}) <-- PBKDF2(P, S, 1, p * MFLen)
+    auto blocks = Data(blockSize * params.p);
+    pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), params.salt.data(),
+                       static_cast<int>(params.salt.size()), 1, blocks.data(), static_cast<int>(blocks.size()));
+
+    // 2: B_i <-- MF(B_i, N), lane t computes the blocks t, t + lanes...
+    // the lanes poll the cancellation flag of the calling thread
+    auto* cancelled = const_cast<std::atomic<bool>*>(ScopedCancellation::current());
+    std::atomic<bool> laneCancelled{false};
+    const auto computeLanes = [&](std::size_t first) {
+        for (std::size_t i = first; i < params.p && !laneCancelled; i += lanes) {
+            if (cancelled == nullptr) {
+                scrypt_smix(blocks.data() + i * blockSize, params.r, params.n, scratch + first * laneSize);
+            } else if (scrypt_smix_cancellable(blocks.data() + i * blockSize, params.r, params.n, scratch + first * laneSize, isCancelled, cancelled) != 0) {
+                laneCancelled = true;
+            }
+        }
+    };
+    try {
+        pool.parallelFor(lanes, lanes, computeLanes);
+    } catch (...) {
+        memzero(blocks.data(), blocks.size());
+        throw;
+    }
+    if (laneCancelled) {
+        memzero(blocks.data(), blocks.size());
+        throw Cancelled();
+    }
+
+    // 5: DK <-- PBKDF2(P, B, 1, dkLen)
+    auto key = Data(keyLength);
+    pbkdf2_hmac_sha256(password.data(), static_cast<int>(password.size()), blocks.data(),
+                       static_cast<int>(blocks.size()), 1, key.data(), static_cast<int>(key.size()));
+    memzero(blocks.data(), blocks.size());
+    return key;
+}
@@ -0,0 +1,67 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "ScryptParameters.h"
+#include "../Data.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+namespace TW::Keystore {
+
+/// Scratch memory for scrypt, kept from one derivation to the next, with an optional size limit.
+///
+/// A derivation holds the arena until it completes; concurrent derivations sharing an arena run one
+/// after another. The memory is wiped when released.
+class ScryptArena {
+  public:
+    /// Arena of at most `limit` bytes, 0 for no limit.
+    explicit ScryptArena(std::size_t limit = 0) : sizeLimit(limit) {}
+    ~ScryptArena();
+
+    ScryptArena(const ScryptArena&) = delete;
+    ScryptArena& operator=(const ScryptArena&) = delete;
+
+    /// Size limit in bytes, 0 for no limit.
+    std::size_t limit() const { return sizeLimit; }
+
+    /// Size of the memory currently held.
+    std::size_t capacity() const;
+
+    /// Wipes and frees the memory.
+    void release();
+
+    /// Arena used for keystore decryption, none (memory allocated for each derivation) by default.
+    static std::shared_ptr<ScryptArena> shared();
+    static void setShared(std::shared_ptr<ScryptArena> arena);
+
+  private:
+    friend Data scryptDerive(const Data& password, const ScryptParameters& params, std::size_t keyLength,
+                             ScryptArena* arena, unsigned threads);
+
+    std::size_t sizeLimit;
+    mutable std::mutex mutex;
+    std::unique_ptr<byte[]> buffer;
+    std::size_t size = 0;
+};
+
+/// Derives a key of `keyLength` bytes with scrypt.
+///
+/// The `p` lanes are computed on up to `threads` threads of the shared ThreadPool (0 for all), each needing
+/// 128 * r * N bytes of scratch memory. With an arena, the memory is taken from it, and the
+/// number of lanes computed at once is reduced to fit in its limit.
+///
+/// The derivation is cancellable with a ScopedCancellation on the calling thread.
+///
+/// @throws std::invalid_argument if the parameters are invalid, or if the arena limit is smaller than one lane.
+/// @throws Cancelled if the flag of the enclosing ScopedCancellation gets set.
+Data scryptDerive(const Data& password, const ScryptParameters& params, std::size_t keyLength,
+                  ScryptArena* arena = nullptr, unsigned threads = 0);
+
+} // namespace TW::Keystore
@@ -5,9 +5,13 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "ScryptParameters.h"
+#include "Scrypt.h"
 
 #include <TrezorCrypto/rand.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Keystore;
@@ -35,6 +39,45 @@ std::optional<ScryptValidationError> ScryptParameters::validate() const {
     return {};
 }
 
+namespace {
+
+/// Time in nanoseconds of scrypt per unit of N * r in a lane, measured once.
+double blockNanoseconds() {
+    static const double cost = [] {
+        const auto params = ScryptParameters(Data(32), 1 << 12, ScryptParameters::defaultR, 1, ScryptParameters::defaultDesiredKeyLength);
+        auto best = std::chrono::nanoseconds::max();
+        // the fastest of a few runs, the first one also faults the memory in
+        for (int i = 0; i < 3; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            scryptDerive(Data(), params, params.desiredKeyLength, nullptr, 1);
+            best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+        }
+        return std::max(1.0, static_cast<double>(best.count())) / (static_cast<double>(params.n) * params.r);
+    }();
+    return cost;
+}
+
+} // namespace
+
+ScryptParameters ScryptParameters::calibrated(std::chrono::milliseconds targetTime, std::size_t maxMemory) {
+    ScryptParameters params;
+    params.r = defaultR;
+    const auto laneMemory = [&params](uint64_t n) { return 128 * static_cast<uint64_t>(params.r) * n; };
+    if (laneMemory(minCalibratedN) > maxMemory) {
+        throw std::invalid_argument("Memory budget too small for scrypt");
+    }
+    const auto target = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(targetTime).count());
+    const auto laneTime = [&params](uint64_t n) { return blockNanoseconds() * params.r * static_cast<double>(n); };
+
+    params.n = minCalibratedN;
+    while (params.n < maxCalibratedN && laneMemory(2 * uint64_t(params.n)) <= maxMemory && laneTime(2 * uint64_t(params.n)) <= target) {
+        params.n *= 2;
+    }
+    const auto lanes = std::floor(target / laneTime(params.n));
+    params.p = static_cast<uint32_t>(std::clamp(lanes, 1.0, static_cast<double>(maxCalibratedP)));
+    return params;
+}
+
 // -----------------
 // Encoding/Decoding
 // -----------------
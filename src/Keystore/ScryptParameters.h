@@ -10,6 +10,7 @@
 #include "../HexCoding.h"
 
 #include <nlohmann/json.hpp>
+#include <chrono>
 #include <optional>
 
 namespace TW::Keystore {
@@ -25,25 +26,34 @@ enum class ScryptValidationError {
 struct ScryptParameters {
     /// The N parameter of Scrypt encryption algorithm, using 256MB memory and
     /// taking approximately 1s CPU time on a modern processor.
-    static const uint32_t standardN = 1 << 18;
+    static constexpr uint32_t standardN = 1 << 18;
 
     /// The P parameter of Scrypt encryption algorithm, using 256MB memory and
     /// taking approximately 1s CPU time on a modern processor.
-    static const uint32_t standardP = 1;
+    static constexpr uint32_t standardP = 1;
 
     /// The N parameter of Scrypt encryption algorithm, using 4MB memory and
     /// taking approximately 100ms CPU time on a modern processor.
-    static const uint32_t lightN = 1 << 12;
+    static constexpr uint32_t lightN = 1 << 12;
 
     /// The P parameter of Scrypt encryption algorithm, using 4MB memory and
     /// taking approximately 100ms CPU time on a modern processor.
-    static const uint32_t lightP = 6;
+    static constexpr uint32_t lightP = 6;
 
     /// Default `R` parameter of Scrypt encryption algorithm.
-    static const uint32_t defaultR = 8;
+    static constexpr uint32_t defaultR = 8;
 
     /// Default desired key length of Scrypt encryption algorithm.
-    static const std::size_t defaultDesiredKeyLength = 32;
+    static constexpr std::size_t defaultDesiredKeyLength = 32;
+
+    /// Smallest `N` chosen by `calibrated`, using 1MB memory.
+    static constexpr uint32_t minCalibratedN = 1 << 10;
+
+    /// Largest `N` chosen by `calibrated`, using 1GB memory.
+    static constexpr uint32_t maxCalibratedN = 1 << 20;
+
+    /// Largest `P` chosen by `calibrated`.
+    static constexpr uint32_t maxCalibratedP = 1 << 10;
 
     /// Random salt.
     Data salt;
@@ -79,6 +89,17 @@ struct ScryptParameters {
     /// - Returns: a `ValidationError` or `nil` if the parameters are valid.
     std::optional<ScryptValidationError> validate() const;
 
+    /// Parameters with a random salt taking about `targetTime` to derive a key on this device, using at most
+    /// `maxMemory` bytes of scratch memory (128 * r * N).
+    ///
+    /// As scrypt's own parameter selection, the largest `N` within the memory budget and the time is chosen,
+    /// then `P` lanes fill the remaining time.  The time is estimated for lanes derived one after another:
+    /// a device deriving lanes in parallel unlocks faster, never slower.  The device is benchmarked on the
+    /// first call only, for a few milliseconds.
+    ///
+    /// @throws std::invalid_argument if `maxMemory` is less than the memory needed for `minCalibratedN`.
+    static ScryptParameters calibrated(std::chrono::milliseconds targetTime, std::size_t maxMemory);
+
     /// Initializes `ScryptParameters` with a JSON object.
     ScryptParameters(const nlohmann::json& json);
 
@@ -5,7 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "StoredKey.h"
+#include "UnlockedKey.h"
 
+#include "Cbor.h"
 #include "Coin.h"
 #include "Mnemonic.h"
 #include "PrivateKey.h"
@@ -16,14 +18,21 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <TrezorCrypto/memzero.h>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
 #include <cassert>
 
+#include <fcntl.h>
+#include <unistd.h>
+
 using namespace TW;
 using namespace TW::Keystore;
 
@@ -40,7 +49,7 @@ StoredKey StoredKey::createWithMnemonic(const std::string& name, const Data& pas
 StoredKey StoredKey::createWithMnemonicRandom(const std::string& name, const Data& password) {
     const auto wallet = TW::HDWallet(128, "");
     const auto& mnemonic = wallet.mnemonic;
-    assert(Mnemonic::isValid(mnemonic));
+    assert(Mnemonic::isValid(mnemonic.c_str()));
     Data mnemonicData = TW::Data(mnemonic.begin(), mnemonic.end());
     StoredKey key = StoredKey(StoredKeyType::mnemonicPhrase, name, password, mnemonicData);
     return key;
@@ -53,7 +62,7 @@ StoredKey StoredKey::createWithMnemonicAddDefaultAddress(const std::string& name
     const auto derivationPath = TW::derivationPath(coin);
     const auto address = TW::deriveAddress(coin, wallet.getKey(coin, derivationPath));
     const auto extendedKey = wallet.getExtendedPublicKey(TW::purpose(coin), coin, TW::xpubVersion(coin));
-    key.accounts.emplace_back(address, coin, derivationPath, extendedKey);
+    key.addAccount(address, coin, derivationPath, extendedKey);
 
     return key;
 }
@@ -73,7 +82,7 @@ StoredKey StoredKey::createWithPrivateKeyAddDefaultAddress(const std::string& na
 
     const auto derivationPath = TW::derivationPath(coin);
     const auto address = TW::deriveAddress(coin, PrivateKey(privateKeyData));
-    key.accounts.emplace_back(address, coin, derivationPath);
+    key.addAccount(address, coin, derivationPath, "");
 
     return key;
 }
@@ -84,37 +93,132 @@ StoredKey::StoredKey(StoredKeyType type, std::string name, const Data& password,
     id = boost::lexical_cast<std::string>(gen());
 }
 
-const HDWallet StoredKey::wallet(const Data& password) const {
+template <typename Make>
+auto StoredKey::makeWallet(const Data& password, Make make) const {
     if (type != StoredKeyType::mnemonicPhrase) {
         throw std::invalid_argument("Invalid account requested.");
     }
-    const auto data = payload.decrypt(password);
-    const auto mnemonic = std::string(reinterpret_cast<const char*>(data.data()), data.size());
-    return HDWallet(mnemonic, "");
+    auto data = payload.decrypt(password);
+    auto mnemonic = std::string(reinterpret_cast<const char*>(data.data()), data.size());
+    memzero(data.data(), data.size());
+    auto wallet = make(mnemonic);
+    memzero(&mnemonic[0], mnemonic.size());
+    return wallet;
 }
 
-std::optional<const Account> StoredKey::account(TWCoinType coin) const {
-    for (auto& account : accounts) {
-        if (account.coin == coin) {
-            return account;
+const HDWallet StoredKey::wallet(const Data& password) const {
+    return makeWallet(password, [](const std::string& mnemonic) { return HDWallet(mnemonic, ""); });
+}
+
+std::shared_ptr<const HDWallet> StoredKey::sharedWallet(const Data& password) const {
+    return makeWallet(password, [](const std::string& mnemonic) { return std::make_shared<const HDWallet>(mnemonic, ""); });
+}
+
+StoredKey::AccountKey StoredKey::accountKey(TWCoinType coin, const DerivationPath& derivationPath) {
+    auto key = AccountKey(coin, {});
+    key.second.reserve(derivationPath.indices.size());
+    for (const auto& index : derivationPath.indices) {
+        key.second.push_back(index.derivationIndex());
+    }
+    return key;
+}
+
+void StoredKey::indexAccount(std::size_t position) {
+    const auto& account = accounts[position];
+    accountsByCoin.emplace(account.coin, position);
+    accountsByPath.emplace(accountKey(account.coin, account.derivationPath), position);
+    indexedAccounts = position + 1;
+}
+
+void StoredKey::reindexAccounts() {
+    accountsByCoin.clear();
+    accountsByPath.clear();
+    indexedAccounts = 0;
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        indexAccount(i);
+    }
+}
+
+std::optional<std::size_t> StoredKey::findAccount(TWCoinType coin) const {
+    if (indexedAccounts == accounts.size()) {
+        const auto found = accountsByCoin.find(coin);
+        if (found == accountsByCoin.end()) {
+            return std::nullopt;
+        }
+        if (accounts[found->second].coin == coin) {
+            return found->second;
+        }
+    }
+    // `accounts` was modified directly
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        if (accounts[i].coin == coin) {
+            return i;
         }
     }
     return std::nullopt;
 }
 
+std::optional<std::size_t> StoredKey::findAccount(TWCoinType coin, const DerivationPath& derivationPath) const {
+    if (indexedAccounts == accounts.size()) {
+        const auto found = accountsByPath.find(accountKey(coin, derivationPath));
+        if (found == accountsByPath.end()) {
+            return std::nullopt;
+        }
+        const auto& account = accounts[found->second];
+        if (account.coin == coin && account.derivationPath == derivationPath) {
+            return found->second;
+        }
+    }
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        if (accounts[i].coin == coin && accounts[i].derivationPath == derivationPath) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<const Account> StoredKey::account(TWCoinType coin) const {
+    const auto position = findAccount(coin);
+    if (!position) {
+        return std::nullopt;
+    }
+    return accounts[*position];
+}
+
+std::optional<const Account> StoredKey::account(TWCoinType coin, const DerivationPath& derivationPath) const {
+    const auto position = findAccount(coin, derivationPath);
+    if (!position) {
+        return std::nullopt;
+    }
+    return accounts[*position];
+}
+
+std::vector<Account> StoredKey::accountsForCoin(TWCoinType coin) const {
+    std::vector<Account> result;
+    const auto first = findAccount(coin);
+    if (!first) {
+        return result;
+    }
+    for (auto i = *first; i < accounts.size(); ++i) {
+        if (accounts[i].coin == coin) {
+            result.push_back(accounts[i]);
+        }
+    }
+    return result;
+}
+
 std::optional<const Account> StoredKey::account(TWCoinType coin, const HDWallet* wallet) {
     if (wallet == nullptr) {
         return account(coin);
     }
     assert(wallet != nullptr);
 
-    for (auto& account : accounts) {
-        if (account.coin == coin) {
-            if (account.address.empty()) {
-                account.address = wallet->deriveAddress(coin);
-            }
-            return account;
+    if (const auto position = findAccount(coin)) {
+        auto& account = accounts[*position];
+        if (account.address.empty()) {
+            account.address = wallet->deriveAddress(coin);
         }
+        return account;
     }
 
     const auto derivationPath = TW::derivationPath(coin);
@@ -123,42 +227,111 @@ std::optional<const Account> StoredKey::account(TWCoinType coin, const HDWallet*
     const auto version = TW::xpubVersion(coin);
     const auto extendedPublicKey = wallet->getExtendedPublicKey(derivationPath.purpose(), coin, version);
 
-    accounts.emplace_back(address, coin, derivationPath, extendedPublicKey);
+    addAccount(address, coin, derivationPath, extendedPublicKey);
     return accounts.back();
 }
 
 void StoredKey::addAccount(const std::string& address, TWCoinType coin, const DerivationPath& derivationPath, const std::string& extetndedPublicKey) {
+    if (indexedAccounts != accounts.size()) {
+        reindexAccounts();
+    }
     accounts.emplace_back(address, coin, derivationPath, extetndedPublicKey);
+    indexAccount(accounts.size() - 1);
+}
+
+void StoredKey::addAccounts(std::vector<Account> newAccounts) {
+    if (indexedAccounts != accounts.size()) {
+        reindexAccounts();
+    }
+    accounts.reserve(accounts.size() + newAccounts.size());
+    for (auto& account : newAccounts) {
+        accounts.push_back(std::move(account));
+        indexAccount(accounts.size() - 1);
+    }
+}
+
+std::vector<Account> StoredKey::addAccounts(const std::vector<TWCoinType>& coins, const HDWallet& wallet, std::size_t threadCount) {
+    if (indexedAccounts != accounts.size()) {
+        reindexAccounts();
+    }
+    // coins without an account or with an empty address, once each
+    std::vector<TWCoinType> missing;
+    for (auto coin : coins) {
+        const auto position = findAccount(coin);
+        if ((!position || accounts[*position].address.empty()) && std::find(missing.begin(), missing.end(), coin) == missing.end()) {
+            missing.push_back(coin);
+        }
+    }
+    const auto addresses = wallet.deriveAddresses(missing, threadCount);
+    for (std::size_t i = 0; i < missing.size(); ++i) {
+        const auto coin = missing[i];
+        if (const auto position = findAccount(coin)) {
+            accounts[*position].address = addresses[i];
+            continue;
+        }
+        const auto derivationPath = TW::derivationPath(coin);
+        const auto extendedPublicKey = wallet.getExtendedPublicKey(derivationPath.purpose(), coin, TW::xpubVersion(coin));
+        addAccount(addresses[i], coin, derivationPath, extendedPublicKey);
+    }
+
+    std::vector<Account> result;
+    result.reserve(coins.size());
+    for (auto coin : coins) {
+        result.push_back(accounts[*findAccount(coin)]);
+    }
+    return result;
+}
+
+std::vector<Account> StoredKey::addAccounts(const std::vector<TWCoinType>& coins, const Data& password, std::size_t threadCount) {
+    const auto wallet = sharedWallet(password);
+    return addAccounts(coins, *wallet, threadCount);
 }
 
 void StoredKey::removeAccount(TWCoinType coin) {
     accounts.erase(std::remove_if(accounts.begin(), accounts.end(), [coin](Account& account) -> bool {
         return account.coin == coin;
     }), accounts.end());
+    reindexAccounts();
+}
+
+void StoredKey::removeAccount(TWCoinType coin, const DerivationPath& derivationPath) {
+    accounts.erase(std::remove_if(accounts.begin(), accounts.end(), [&](Account& account) -> bool {
+        return account.coin == coin && account.derivationPath == derivationPath;
+    }), accounts.end());
+    reindexAccounts();
 }
 
 const PrivateKey StoredKey::privateKey(TWCoinType coin, const Data& password) {
     switch (type) {
     case StoredKeyType::mnemonicPhrase: {
-        const auto wallet = this->wallet(password);
-        const auto account = this->account(coin, &wallet);
-        return wallet.getKey(coin, account->derivationPath);
+        const auto wallet = sharedWallet(password);
+        return privateKey(coin, *wallet);
     }
     case StoredKeyType::privateKey:
         return PrivateKey(payload.decrypt(password));
     }
 }
 
+const PrivateKey StoredKey::privateKey(TWCoinType coin, const HDWallet& wallet) {
+    const auto account = this->account(coin, &wallet);
+    return wallet.getKey(coin, account->derivationPath);
+}
+
+std::unique_ptr<UnlockedKey> StoredKey::unlock(const Data& password, std::chrono::seconds ttl) const {
+    auto decrypted = payload.decrypt(password);
+    return std::make_unique<UnlockedKey>(type, std::move(decrypted), accounts, UnlockedKey::Clock::now() + ttl);
+}
+
 void StoredKey::fixAddresses(const Data& password) {
     switch (type) {
         case StoredKeyType::mnemonicPhrase: {
-                const auto wallet = this->wallet(password);
+                const auto wallet = sharedWallet(password);
                 for (auto& account : accounts) {
                     if (!account.address.empty() && TW::validateAddress(account.coin, account.address)) {
                         continue;
                     }
                     const auto& derivationPath = account.derivationPath;
-                    const auto key = wallet.getKey(account.coin, derivationPath);
+                    const auto key = wallet->getKey(account.coin, derivationPath);
                     account.address = TW::deriveAddress(account.coin, key);
                 }
             }
@@ -208,46 +381,61 @@ namespace TypeString {
     static const auto mnemonic = "mnemonic";
 } // namespace TypeString
 
-void StoredKey::loadJson(const nlohmann::json& json) {
+StoredKeyInfo StoredKeyInfo::fromJson(const nlohmann::json& json) {
+    StoredKeyInfo info;
     if (json.count(CodingKeys::type) != 0 &&
         json[CodingKeys::type].get<std::string>() == TypeString::mnemonic) {
-        type = StoredKeyType::mnemonicPhrase;
+        info.type = StoredKeyType::mnemonicPhrase;
     } else {
-        type = StoredKeyType::privateKey;
+        info.type = StoredKeyType::privateKey;
     }
 
     if (json.count(CodingKeys::name) != 0) {
-        name = json[CodingKeys::name].get<std::string>();
+        info.name = json[CodingKeys::name].get<std::string>();
     }
 
     if (json.count(CodingKeys::id) != 0) {
-        id = json[CodingKeys::id].get<std::string>();
-    }
-
-    if (json.count(CodingKeys::crypto) != 0) {
-        payload = EncryptionParameters(json[CodingKeys::crypto]);
-    } else if (json.count(UppercaseCodingKeys::crypto) != 0) {
-        // Workaround for myEtherWallet files
-        payload = EncryptionParameters(json[UppercaseCodingKeys::crypto]);
-    } else {
-        throw DecryptionError::invalidKeyFile;
+        info.id = json[CodingKeys::id].get<std::string>();
     }
 
     if (json.count(CodingKeys::activeAccounts) != 0 &&
         json[CodingKeys::activeAccounts].is_array()) {
         for (auto& accountJSON : json[CodingKeys::activeAccounts]) {
-            accounts.emplace_back(accountJSON);
+            info.accounts.emplace_back(accountJSON);
         }
     }
 
-    if (accounts.empty() && json.count(CodingKeys::address) != 0 && json[CodingKeys::address].is_string()) {
+    if (info.accounts.empty() && json.count(CodingKeys::address) != 0 && json[CodingKeys::address].is_string()) {
         TWCoinType coin = TWCoinTypeEthereum;
         if (json.count(CodingKeys::coin) != 0) {
             coin = json[CodingKeys::coin].get<TWCoinType>();
         }
         auto address = json[CodingKeys::address].get<std::string>();
-        accounts.emplace_back(address, coin, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(coin), 0, 0, 0));
+        info.accounts.emplace_back(address, coin, DerivationPath(TWPurposeBIP44, TWCoinTypeSlip44Id(coin), 0, 0, 0));
+    }
+    return info;
+}
+
+void StoredKey::loadJson(const nlohmann::json& json) {
+    auto info = StoredKeyInfo::fromJson(json);
+    type = info.type;
+    if (json.count(CodingKeys::name) != 0) {
+        name = std::move(info.name);
+    }
+    if (info.id) {
+        id = std::move(info.id);
     }
+
+    if (json.count(CodingKeys::crypto) != 0) {
+        payload = EncryptionParameters(json[CodingKeys::crypto]);
+    } else if (json.count(UppercaseCodingKeys::crypto) != 0) {
+        // Workaround for myEtherWallet files
+        payload = EncryptionParameters(json[UppercaseCodingKeys::crypto]);
+    } else {
+        throw DecryptionError::invalidKeyFile;
+    }
+
+    addAccounts(std::move(info.accounts));
 }
 
 nlohmann::json StoredKey::json() const {
@@ -279,18 +467,268 @@ nlohmann::json StoredKey::json() const {
     return j;
 }
 
+// Binary format
+
+namespace BinaryKeys {
+    // self-described CBOR tag, as a file magic
+    static const uint64_t magic = 55799;
+    static const uint64_t formatVersion = 1;
+
+    enum : uint64_t { version, type, id, name, crypto, activeAccounts };
+    enum : uint64_t { encrypted, cipher, iv, kdfParams, mac };
+    enum : uint64_t { scrypt, pbkdf2 };
+} // namespace BinaryKeys
+
+namespace {
+
+Cbor::Encode encodeDerivationPath(const DerivationPath& path) {
+    std::vector<Cbor::Encode> indices;
+    for (const auto& index : path.indices) {
+        indices.push_back(Cbor::Encode::uint(index.derivationIndex()));
+    }
+    return Cbor::Encode::array(indices);
+}
+
+DerivationPath decodeDerivationPath(const Cbor::Decode& decode) {
+    DerivationPath path;
+    for (const auto& index : decode.getArrayElements()) {
+        const auto value = index.getValue();
+        if (value > UINT32_MAX) {
+            throw std::invalid_argument("Invalid derivation index");
+        }
+        path.indices.emplace_back(static_cast<uint32_t>(value) & 0x7fffffff, (value & 0x80000000) != 0);
+    }
+    return path;
+}
+
+Cbor::Encode encodePayload(const EncryptionParameters& payload) {
+    using namespace BinaryKeys;
+    Cbor::Encode kdf = Cbor::Encode::array({});
+    if (payload.kdfParams.which() == 0) {
+        const auto& params = boost::get<ScryptParameters>(payload.kdfParams);
+        kdf = Cbor::Encode::array({
+            Cbor::Encode::uint(scrypt),
+            Cbor::Encode::bytes(params.salt),
+            Cbor::Encode::uint(params.desiredKeyLength),
+            Cbor::Encode::uint(params.n),
+            Cbor::Encode::uint(params.p),
+            Cbor::Encode::uint(params.r),
+        });
+    } else {
+        const auto& params = boost::get<PBKDF2Parameters>(payload.kdfParams);
+        kdf = Cbor::Encode::array({
+            Cbor::Encode::uint(pbkdf2),
+            Cbor::Encode::bytes(params.salt),
+            Cbor::Encode::uint(params.desiredKeyLength),
+            Cbor::Encode::uint(params.iterations),
+        });
+    }
+    return Cbor::Encode::map({
+        {Cbor::Encode::uint(encrypted), Cbor::Encode::bytes(payload.encrypted)},
+        {Cbor::Encode::uint(cipher), Cbor::Encode::string(payload.cipher)},
+        {Cbor::Encode::uint(iv), Cbor::Encode::bytes(payload.cipherParams.iv)},
+        {Cbor::Encode::uint(kdfParams), kdf},
+        {Cbor::Encode::uint(mac), Cbor::Encode::bytes(payload.mac)},
+    });
+}
+
+uint32_t decodeUInt32(const Cbor::Decode& decode) {
+    const auto value = decode.getValue();
+    if (value > UINT32_MAX) {
+        throw std::invalid_argument("Invalid value");
+    }
+    return static_cast<uint32_t>(value);
+}
+
+EncryptionParameters decodePayload(const Cbor::Decode& decode) {
+    using namespace BinaryKeys;
+    EncryptionParameters payload;
+    for (const auto& entry : decode.getMapElements()) {
+        switch (entry.first.getValue()) {
+        case encrypted:
+            payload.encrypted = entry.second.getBytes();
+            break;
+        case cipher:
+            payload.cipher = entry.second.getString();
+            break;
+        case iv:
+            payload.cipherParams.iv = entry.second.getBytes();
+            break;
+        case mac:
+            payload.mac = entry.second.getBytes();
+            break;
+        case kdfParams: {
+            const auto elements = entry.second.getArrayElements();
+            if (elements.size() == 6 && elements[0].getValue() == scrypt) {
+                ScryptParameters params;
+                params.salt = elements[1].getBytes();
+                params.desiredKeyLength = elements[2].getValue();
+                params.n = decodeUInt32(elements[3]);
+                params.p = decodeUInt32(elements[4]);
+                params.r = decodeUInt32(elements[5]);
+                payload.kdfParams = params;
+            } else if (elements.size() == 4 && elements[0].getValue() == pbkdf2) {
+                PBKDF2Parameters params;
+                params.salt = elements[1].getBytes();
+                params.desiredKeyLength = elements[2].getValue();
+                params.iterations = decodeUInt32(elements[3]);
+                payload.kdfParams = params;
+            } else {
+                throw DecryptionError::unsupportedKDF;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    return payload;
+}
+
+} // namespace
+
+Data StoredKey::binary() const {
+    using namespace BinaryKeys;
+    std::vector<Cbor::Encode> accountsEncoded;
+    accountsEncoded.reserve(accounts.size());
+    for (const auto& account : accounts) {
+        accountsEncoded.push_back(Cbor::Encode::array({
+            Cbor::Encode::uint(account.coin),
+            Cbor::Encode::string(account.address),
+            encodeDerivationPath(account.derivationPath),
+            Cbor::Encode::string(account.extendedPublicKey),
+        }));
+    }
+
+    std::vector<std::pair<Cbor::Encode, Cbor::Encode>> fields = {
+        {Cbor::Encode::uint(version), Cbor::Encode::uint(formatVersion)},
+        {Cbor::Encode::uint(BinaryKeys::type), Cbor::Encode::uint(type == StoredKeyType::mnemonicPhrase ? 1 : 0)},
+    };
+    if (id) {
+        fields.emplace_back(Cbor::Encode::uint(BinaryKeys::id), Cbor::Encode::string(*id));
+    }
+    fields.emplace_back(Cbor::Encode::uint(BinaryKeys::name), Cbor::Encode::string(name));
+    fields.emplace_back(Cbor::Encode::uint(crypto), encodePayload(payload));
+    fields.emplace_back(Cbor::Encode::uint(activeAccounts), Cbor::Encode::array(accountsEncoded));
+    return Cbor::Encode::tag(magic, Cbor::Encode::map(fields)).encoded();
+}
+
+StoredKey StoredKey::createWithBinary(const Data& data) {
+    StoredKey storedKey;
+    storedKey.loadBinary(data);
+    return storedKey;
+}
+
+void StoredKey::loadBinary(const Data& data) {
+    using namespace BinaryKeys;
+    try {
+        const auto decode = Cbor::Decode(data);
+        if (!decode.isValid() || decode.getTagValue() != magic) {
+            throw DecryptionError::invalidKeyFile;
+        }
+        const auto fields = decode.getTagElement().getMapElements();
+        if (fields.empty() || fields[0].first.getValue() != version || fields[0].second.getValue() != formatVersion) {
+            throw DecryptionError::invalidKeyFile;
+        }
+
+        bool hasPayload = false;
+        std::vector<Account> decodedAccounts;
+        for (const auto& field : fields) {
+            switch (field.first.getValue()) {
+            case BinaryKeys::type:
+                type = field.second.getValue() == 1 ? StoredKeyType::mnemonicPhrase : StoredKeyType::privateKey;
+                break;
+            case BinaryKeys::id:
+                id = field.second.getString();
+                break;
+            case BinaryKeys::name:
+                name = field.second.getString();
+                break;
+            case crypto:
+                payload = decodePayload(field.second);
+                hasPayload = true;
+                break;
+            case activeAccounts:
+                for (const auto& element : field.second.getArrayElements()) {
+                    const auto values = element.getArrayElements();
+                    if (values.size() != 4) {
+                        throw DecryptionError::invalidKeyFile;
+                    }
+                    decodedAccounts.emplace_back(values[1].getString(), TWCoinType(decodeUInt32(values[0])),
+                                                 decodeDerivationPath(values[2]), values[3].getString());
+                }
+                break;
+            default:
+                break;
+            }
+        }
+        if (!hasPayload) {
+            throw DecryptionError::invalidKeyFile;
+        }
+        addAccounts(std::move(decodedAccounts));
+    } catch (const std::invalid_argument&) {
+        throw DecryptionError::invalidKeyFile;
+    }
+}
+
 // File operations
 
-void StoredKey::store(const std::string& path) {
-    auto stream = std::ofstream(path);
-    stream << json();
+namespace {
+
+/// Replaces a file with `size` bytes: written to a temporary file next to it, flushed to disk, renamed over it.
+void writeAtomically(const std::string& path, const char* data, std::size_t size) {
+    const auto temporary = path + ".tmp";
+    const int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (fd < 0) {
+        throw std::invalid_argument("Can't open file");
+    }
+    bool written = true;
+    while (size > 0) {
+        const auto count = ::write(fd, data, size);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            written = false;
+            break;
+        }
+        data += count;
+        size -= static_cast<std::size_t>(count);
+    }
+    written = ::fsync(fd) == 0 && written;
+    written = ::close(fd) == 0 && written;
+    if (!written || std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::invalid_argument("Can't write file");
+    }
+}
+
+} // namespace
+
+void StoredKey::changePassword(const Data& password, const Data& newPassword) {
+    payload = payload.reencrypted(password, newPassword);
+}
+
+void StoredKey::store(const std::string& path) const {
+    const auto encoded = json().dump();
+    writeAtomically(path, encoded.data(), encoded.size());
+}
+
+void StoredKey::storeBinary(const std::string& path) const {
+    const auto data = binary();
+    writeAtomically(path, reinterpret_cast<const char*>(data.data()), data.size());
 }
 
 StoredKey StoredKey::load(const std::string& path) {
-    std::ifstream stream(path);
+    std::ifstream stream(path, std::ios::binary);
     if (!stream.is_open()) {
         throw std::invalid_argument("Can't open file");
     }
+    // binary files start with the self-described CBOR tag (0xd9d9f7)
+    if (stream.peek() == 0xd9) {
+        const auto data = Data(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return createWithBinary(data);
+    }
     nlohmann::json j;
     stream >> j;
 
@@ -14,15 +14,40 @@
 #include <TrustWalletCore/TWCoinType.h>
 #include <nlohmann/json.hpp>
 
+#include <chrono>
+#include <map>
+#include <memory>
 #include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace TW::Keystore {
 
+class UnlockedKey;
+
 /// An stored key can be either a private key or a mnemonic phrase for a HD
 /// wallet.
 enum class StoredKeyType { privateKey, mnemonicPhrase };
 
+/// Unencrypted information of a stored key.
+struct StoredKeyInfo {
+    /// Type of key stored.
+    StoredKeyType type = StoredKeyType::privateKey;
+
+    /// Unique identifier.
+    std::optional<std::string> id;
+
+    /// Name.
+    std::string name;
+
+    /// Active accounts.
+    std::vector<Account> accounts;
+
+    /// Reads the information from the JSON object of a key file, without its encrypted payload.
+    static StoredKeyInfo fromJson(const nlohmann::json& json);
+};
+
 /// Represents a key stored as an encrypted file.
 class StoredKey {
 public:
@@ -39,6 +64,9 @@ public:
     EncryptionParameters payload;
 
     /// Active accounts.
+    ///
+    /// Lookups go through an index maintained by the account methods; after modifying this
+    /// vector directly, call `reindexAccounts` to keep the lookups fast.
     std::vector<Account> accounts;
 
     /// Create a new StoredKey, with the given name, mnemonic and password.
@@ -69,18 +97,51 @@ public:
     /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
     const HDWallet wallet(const Data& password) const;
 
+    /// Returns the HDWallet for this key, for many derivations and signatures with a single decryption.
+    /// The wallet can be shared between threads; its seed is wiped when the last handle is released.
+    ///
+    /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
+    /// @throws DecryptionError if `password` is invalid.
+    std::shared_ptr<const HDWallet> sharedWallet(const Data& password) const;
+
     /// Returns the account for a specific coin, creating it if necessary and
     /// the provided wallet is not `nullptr`.
     std::optional<const Account> account(TWCoinType coin, const HDWallet* wallet);
 
     /// Returns the account for a specific coin if it exists.
     std::optional<const Account> account(TWCoinType coin) const;
-    
+
+    /// Returns the account for a specific coin and derivation path if it exists.
+    std::optional<const Account> account(TWCoinType coin, const DerivationPath& derivationPath) const;
+
+    /// Returns all the accounts for a specific coin, in insertion order.
+    std::vector<Account> accountsForCoin(TWCoinType coin) const;
+
     /// Add an account
     void addAccount(const std::string& address, TWCoinType coin, const DerivationPath& derivationPath, const std::string& extetndedPublicKey);
 
+    /// Adds several accounts at once.
+    void addAccounts(std::vector<Account> newAccounts);
+
+    /// Returns the default account of each coin, in the same order as `coins`, creating the missing ones
+    /// as `account(coin, &wallet)` does.  The addresses of all the new accounts are derived together,
+    /// on `threadCount` threads (see HDWallet::deriveAddresses).
+    std::vector<Account> addAccounts(const std::vector<TWCoinType>& coins, const HDWallet& wallet, std::size_t threadCount = 0);
+
+    /// Same as above, decrypting the wallet once for all the coins.
+    ///
+    /// @throws DecryptionError if the password is invalid.
+    /// @throws std::invalid_argument if this key is of a type other than `mnemonicPhrase`.
+    std::vector<Account> addAccounts(const std::vector<TWCoinType>& coins, const Data& password, std::size_t threadCount = 0);
+
     /// Remove the account for a specific coin
     void removeAccount(TWCoinType coin);
+
+    /// Removes the account for a specific coin and derivation path.
+    void removeAccount(TWCoinType coin, const DerivationPath& derivationPath);
+
+    /// Rebuilds the account index, after `accounts` has been modified directly.
+    void reindexAccounts();
     
     /// Returns the private key for a specific coin, creating an account if necessary.
     ///
@@ -88,7 +149,22 @@ public:
     /// `mnemonicPhrase` and a coin other than the default is requested.
     const PrivateKey privateKey(TWCoinType coin, const Data& password);
 
-    /// Loads and decrypts a stored key from a file.
+    /// Returns the private key for a specific coin from the wallet of this key, creating an account if
+    /// necessary; use with `sharedWallet` to get the keys of many coins with a single decryption.
+    const PrivateKey privateKey(TWCoinType coin, const HDWallet& wallet);
+
+    /// Changes the encryption password, keeping the key derivation parameters of this key.
+    /// The accounts are unchanged, the payload is decrypted and encrypted once.
+    ///
+    /// @throws DecryptionError if `password` is invalid.
+    void changePassword(const Data& password, const Data& newPassword);
+
+    /// Decrypts the key once, for signing and derivations during `ttl` without further key derivations.
+    ///
+    /// @throws DecryptionError
+    std::unique_ptr<UnlockedKey> unlock(const Data& password, std::chrono::seconds ttl) const;
+
+    /// Loads and decrypts a stored key from a file, in JSON or binary format.
     ///
     /// @param path file path to load from.
     /// @returns descrypted key.
@@ -97,8 +173,32 @@ public:
 
     /// Stores the key into an encrypted file.
     ///
+    /// The file is replaced atomically: written to a temporary file in the same directory, flushed to disk
+    /// and renamed over `path`, so that a crash leaves either the previous or the new key file.
+    ///
     /// @param path file path to store in.
-    void store(const std::string& path);
+    /// @throws std::invalid_argument if the file cannot be written.
+    void store(const std::string& path) const;
+
+    /// Stores the key into an encrypted file, in binary format, replacing it atomically as `store` does.
+    ///
+    /// @param path file path to store in.
+    /// @throws std::invalid_argument if the file cannot be written.
+    void storeBinary(const std::string& path) const;
+
+    /// Create a StoredKey from its binary format.
+    ///
+    /// @throws DecryptionError if the data is not a valid binary key.
+    static StoredKey createWithBinary(const Data& data);
+
+    /// Initializes `StoredKey` with its binary format.
+    ///
+    /// @throws DecryptionError if the data is not a valid binary key.
+    void loadBinary(const Data& data);
+
+    /// Saves `this` in the binary format: a versioned CBOR structure holding the same
+    /// information as `json()`, with binary fields as CBOR byte strings.
+    Data binary() const;
 
     /// Initializes `StoredKey` with a JSON object.
     void loadJson(const nlohmann::json& json);
@@ -113,6 +213,10 @@ public:
     void fixAddresses(const Data& password);
 
 private:
+    /// Decrypts the mnemonic phrase and makes a wallet of it, wiping the decrypted copies.
+    template <typename Make>
+    auto makeWallet(const Data& password, Make make) const;
+
     /// Default constructor, private
     StoredKey() : type(StoredKeyType::mnemonicPhrase) {}
 
@@ -120,6 +224,22 @@ private:
     /// This contstructor will encrypt the provided data with default encryption
     /// parameters.
     StoredKey(StoredKeyType type, std::string name, const Data& password, const Data& data);
+
+    using AccountKey = std::pair<TWCoinType, std::vector<uint32_t>>;
+
+    /// Position in `accounts` of the first account for each coin and derivation path.
+    std::map<AccountKey, std::size_t> accountsByPath;
+
+    /// Position in `accounts` of the first account for each coin.
+    std::map<TWCoinType, std::size_t> accountsByCoin;
+
+    /// Number of accounts in the index, to detect direct modifications of `accounts`.
+    std::size_t indexedAccounts = 0;
+
+    static AccountKey accountKey(TWCoinType coin, const DerivationPath& derivationPath);
+    void indexAccount(std::size_t position);
+    std::optional<std::size_t> findAccount(TWCoinType coin) const;
+    std::optional<std::size_t> findAccount(TWCoinType coin, const DerivationPath& derivationPath) const;
 };
 
 } // namespace TW::Keystore
@@ -0,0 +1,115 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "UnlockedKey.h"
+
+#include "../Coin.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <algorithm>
+#include <new>
+
+using namespace TW;
+using namespace TW::Keystore;
+
+UnlockedKey::UnlockedKey(StoredKeyType type, Data&& decrypted, std::vector<Account> accounts, Clock::time_point expiry)
+    : keyType(type), accounts(std::move(accounts)), expiresAt(expiry),
+      memory(std::max(sizeof(HDWallet), decrypted.size())) {
+    switch (type) {
+    case StoredKeyType::mnemonicPhrase: {
+        auto mnemonic = std::string(reinterpret_cast<const char*>(decrypted.data()), decrypted.size());
+        wallet = new (memory.data()) HDWallet(mnemonic, "");
+        memzero(&mnemonic[0], mnemonic.size());
+        // only the seed and entropy are needed to derive keys
+        memzero(&wallet->mnemonic[0], wallet->mnemonic.size());
+        wallet->mnemonic = SecureString();
+        wallet->nodeCache.capacity = 0;
+        break;
+    }
+    case StoredKeyType::privateKey:
+        std::copy(decrypted.begin(), decrypted.end(), memory.data());
+        privateKeySize = decrypted.size();
+        break;
+    }
+    memzero(decrypted.data(), decrypted.size());
+}
+
+UnlockedKey::~UnlockedKey() {
+    close();
+}
+
+bool UnlockedKey::isUnlocked() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    if ((wallet != nullptr || privateKeySize != 0) && Clock::now() >= expiresAt) {
+        wipe();
+    }
+    return wallet != nullptr || privateKeySize != 0;
+}
+
+void UnlockedKey::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    wipe();
+}
+
+void UnlockedKey::wipe() const {
+    if (wallet != nullptr) {
+        wallet->~HDWallet();
+        wallet = nullptr;
+    }
+    privateKeySize = 0;
+    memzero(memory.data(), memory.size());
+}
+
+bool UnlockedKey::isMemoryLocked() const {
+    const auto& arena = SecureArena::shared();
+    return arena.isLocked() && arena.owns(memory.data());
+}
+
+void UnlockedKey::checkUnlocked() const {
+    if (wallet == nullptr && privateKeySize == 0) {
+        throw KeyLockedError();
+    }
+    if (Clock::now() >= expiresAt) {
+        wipe();
+        throw KeyLockedError();
+    }
+}
+
+DerivationPath UnlockedKey::accountPath(TWCoinType coin) const {
+    for (const auto& account : accounts) {
+        if (account.coin == coin) {
+            return account.derivationPath;
+        }
+    }
+    return TW::derivationPath(coin);
+}
+
+PrivateKey UnlockedKey::privateKey(TWCoinType coin) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkUnlocked();
+    if (wallet == nullptr) {
+        return PrivateKey(Data(memory.data(), memory.data() + privateKeySize));
+    }
+    return wallet->getKey(coin, accountPath(coin));
+}
+
+PrivateKey UnlockedKey::privateKey(TWCoinType coin, const DerivationPath& derivationPath) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    checkUnlocked();
+    if (wallet == nullptr) {
+        throw std::invalid_argument("Invalid account requested.");
+    }
+    return wallet->getKey(coin, derivationPath);
+}
+
+std::string UnlockedKey::deriveAddress(TWCoinType coin) const {
+    return TW::deriveAddress(coin, privateKey(coin));
+}
+
+Data UnlockedKey::sign(TWCoinType coin, const Data& digest) const {
+    return privateKey(coin).sign(digest, TW::curve(coin));
+}
@@ -0,0 +1,101 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Account.h"
+#include "StoredKey.h"
+#include "../Data.h"
+#include "../DerivationPath.h"
+#include "../HDWallet.h"
+#include "../PrivateKey.h"
+#include "../SecureMemory.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace TW::Keystore {
+
+/// Thrown when using an unlocked key after it expired or was closed.
+class KeyLockedError : public std::runtime_error {
+  public:
+    KeyLockedError() : std::runtime_error("Key is locked") {}
+};
+
+/// Decrypted key of a StoredKey, to sign and derive many times with a single key derivation.
+///
+/// The decrypted wallet (seed and entropy) or private key is kept in the SecureArena, and wiped when
+/// the session is closed, destroyed, or used after it expired. The mnemonic phrase is not kept, nor
+/// are intermediate derivation nodes. Thread-safe.
+class UnlockedKey {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Takes ownership of decrypted payload data (wiped after use), valid until `expiry`.
+    UnlockedKey(StoredKeyType type, Data&& decrypted, std::vector<Account> accounts, Clock::time_point expiry);
+    ~UnlockedKey();
+
+    UnlockedKey(const UnlockedKey&) = delete;
+    UnlockedKey& operator=(const UnlockedKey&) = delete;
+
+    StoredKeyType type() const { return keyType; }
+
+    /// Whether the key can still be used: not closed and not expired.
+    bool isUnlocked() const;
+
+    /// End of validity.
+    Clock::time_point expiry() const { return expiresAt; }
+
+    /// Whether the key material is locked in RAM.
+    bool isMemoryLocked() const;
+
+    /// Wipes the key material; further uses throw KeyLockedError.
+    void close();
+
+    /// Returns the private key for a coin, at the path of its account or the default path.
+    ///
+    /// @throws KeyLockedError if expired or closed.
+    PrivateKey privateKey(TWCoinType coin) const;
+
+    /// Returns the private key at a derivation path.
+    ///
+    /// @throws KeyLockedError if expired or closed.
+    /// @throws std::invalid_argument if the key is not a mnemonic phrase.
+    PrivateKey privateKey(TWCoinType coin, const DerivationPath& derivationPath) const;
+
+    /// Derives the address for a coin, at the path of its account or the default path.
+    ///
+    /// @throws KeyLockedError if expired or closed.
+    std::string deriveAddress(TWCoinType coin) const;
+
+    /// Signs a digest with the private key for a coin, on the curve of the coin.
+    ///
+    /// @throws KeyLockedError if expired or closed.
+    Data sign(TWCoinType coin, const Data& digest) const;
+
+  private:
+    /// Checks the validity, wiping expired keys; to be called with the mutex held.
+    void checkUnlocked() const;
+    void wipe() const;
+    DerivationPath accountPath(TWCoinType coin) const;
+
+    StoredKeyType keyType;
+    std::vector<Account> accounts;
+    Clock::time_point expiresAt;
+    mutable std::mutex mutex;
+    mutable SecureData memory;
+    /// Wallet constructed in `memory`, for mnemonic phrases.
+    mutable HDWallet* wallet = nullptr;
+    /// Size of the private key in `memory`, for private keys.
+    mutable std::size_t privateKeySize = 0;
+};
+
+} // namespace TW::Keystore
@@ -0,0 +1,87 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "LockedMemory.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <new>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace TW;
+
+LockedMemory::LockedMemory(std::size_t size) {
+#ifndef _WIN32
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    length = (size + page - 1) / page * page;
+    if (length == 0) {
+        length = page;
+    }
+    // anonymous mappings are zero-filled
+    void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (mapping == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    memory = static_cast<byte*>(mapping);
+    locked = mlock(memory, length) == 0;
+#ifdef MADV_DONTDUMP
+    madvise(memory, length, MADV_DONTDUMP);
+#endif
+#else
+    length = size == 0 ? 1 : size;
+    memory = new byte[length]();
+#endif
+}
+
+LockedMemory::~LockedMemory() {
+    wipe();
+#ifndef _WIN32
+    if (locked) {
+        munlock(memory, length);
+    }
+    munmap(memory, length);
+#else
+    delete[] memory;
+#endif
+}
+
+void LockedMemory::wipe() {
+    memzero(memory, length);
+}
+
+bool TW::prefaultMemory(const void* memory, std::size_t size, bool lock) {
+    if (size == 0) {
+        return false;
+    }
+#ifndef _WIN32
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#else
+    const std::size_t page = 4096;
+#endif
+    const auto* bytes = static_cast<const volatile byte*>(memory);
+    for (std::size_t offset = 0; offset < size; offset += page) {
+        (void)bytes[offset];
+    }
+    (void)bytes[size - 1];
+#ifndef _WIN32
+    return lock && mlock(memory, size) == 0;
+#else
+    return false;
+#endif
+}
+
+void TW::unlockMemory(const void* memory, std::size_t size) {
+#ifndef _WIN32
+    munlock(memory, size);
+#else
+    (void)memory;
+    (void)size;
+#endif
+}
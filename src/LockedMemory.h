@@ -0,0 +1,50 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+
+namespace TW {
+
+/// Page-aligned memory for secrets, locked in RAM (kept out of swap) where the platform allows it,
+/// and wiped when freed.
+class LockedMemory {
+  public:
+    /// Allocates at least `size` bytes, zero-initialized.
+    ///
+    /// @throws std::bad_alloc if the memory cannot be allocated.
+    explicit LockedMemory(std::size_t size);
+    ~LockedMemory();
+
+    LockedMemory(const LockedMemory&) = delete;
+    LockedMemory& operator=(const LockedMemory&) = delete;
+
+    byte* data() const { return memory; }
+    std::size_t size() const { return length; }
+
+    /// Whether the memory could be locked; locking is best effort (limited by RLIMIT_MEMLOCK for instance).
+    bool isLocked() const { return locked; }
+
+    /// Overwrites the memory with zeros.
+    void wipe();
+
+  private:
+    byte* memory = nullptr;
+    std::size_t length = 0;
+    bool locked = false;
+};
+
+/// Reads a byte of each page of `memory`, so that read-only data (tables) is mapped before it is first needed, and
+/// locks the pages in RAM if `lock`.  Returns whether the pages are locked; locking is best effort.
+bool prefaultMemory(const void* memory, std::size_t size, bool lock);
+
+/// Unlocks pages locked by prefaultMemory.
+void unlockMemory(const void* memory, std::size_t size);
+
+} // namespace TW
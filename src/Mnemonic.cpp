@@ -8,35 +8,157 @@
 
 #include <TrezorCrypto/bip39_english.h>
 #include <TrezorCrypto/bip39.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/sha2.h>
 
-#include <string.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
-#include <cassert>
 
 namespace TW {
 
 const int Mnemonic::SuggestMaxCount = 10;
 
-bool Mnemonic::isValid(const std::string& mnemonic) {
-    return mnemonic_check(mnemonic.c_str()) != 0;
+namespace {
+
+/// Maximum length of a BIP39 English word.
+const std::size_t maxWordLength = 8;
+
+/// Packs a lowercase word of up to 8 letters into an integer, 5 bits per letter starting with the
+/// most significant ones, so that the order of packed words is the alphabetical order and a
+/// prefix is a range of packed words. Returns 0 for other strings.
+constexpr uint64_t pack(const char* word, std::size_t length) {
+    if (length == 0 || length > maxWordLength) {
+        return 0;
+    }
+    uint64_t packed = 0;
+    for (std::size_t i = 0; i < maxWordLength; ++i) {
+        uint64_t letter = 0;
+        if (i < length) {
+            if (word[i] < 'a' || word[i] > 'z') {
+                return 0;
+            }
+            letter = uint64_t(word[i] - 'a' + 1);
+        }
+        packed = (packed << 5) | letter;
+    }
+    return packed;
 }
 
-inline const char* const* mnemonicWordlist() { return wordlist; }
+static_assert(pack("abandon", 7) < pack("ability", 7), "packing must keep the alphabetical order");
+static_assert(pack("air", 3) < pack("airport", 7), "packing must keep the alphabetical order");
 
-bool Mnemonic::isValidWord(const std::string& word) {
-    const char* wordC = word.c_str();
-    for (const char* const* w = mnemonicWordlist(); *w != nullptr; ++w) {
-        if (strncmp(*w, wordC, word.length()) == 0) {
-            return true;
+/// Bits of the packed words holding the first two letters.
+const unsigned bucketShift = 5 * (maxWordLength - 2);
+const std::size_t bucketCount = std::size_t(1) << 10;
+
+/// Index of the English wordlist: packed words, in the wordlist order, plus the start of
+/// each range of words sharing their first two letters.
+struct WordIndex {
+    std::array<uint64_t, BIP39_WORDS> words;
+    std::array<uint16_t, bucketCount + 1> buckets;
+
+    WordIndex() {
+        for (std::size_t i = 0; i < BIP39_WORDS; ++i) {
+            words[i] = pack(wordlist[i], strlen(wordlist[i]));
+            assert(words[i] != 0 && (i == 0 || words[i - 1] < words[i]));
+        }
+        std::size_t word = 0;
+        for (std::size_t bucket = 0; bucket <= bucketCount; ++bucket) {
+            while (word < BIP39_WORDS && (words[word] >> bucketShift) < bucket) {
+                ++word;
+            }
+            buckets[bucket] = static_cast<uint16_t>(word);
+        }
+    }
+
+    int find(const char* word, std::size_t length) const {
+        const auto packed = pack(word, length);
+        if (packed == 0) {
+            return -1;
+        }
+        const auto bucket = packed >> bucketShift;
+        const auto begin = words.begin() + buckets[bucket];
+        const auto end = words.begin() + buckets[bucket + 1];
+        const auto found = std::lower_bound(begin, end, packed);
+        if (found == end || *found != packed) {
+            return -1;
+        }
+        return static_cast<int>(found - words.begin());
+    }
+
+    static const WordIndex& shared() {
+        static const WordIndex index;
+        return index;
+    }
+};
+
+} // namespace
+
+bool Mnemonic::isValid(const std::string& mnemonic) {
+    const auto& index = WordIndex::shared();
+    const auto wordCount = std::count(mnemonic.begin(), mnemonic.end(), ' ') + 1;
+    if (wordCount != 12 && wordCount != 15 && wordCount != 18 && wordCount != 21 && wordCount != 24) {
+        return false;
+    }
+
+    // entropy and checksum, 11 bits per word
+    uint8_t bits[33] = {0};
+    std::size_t bitCount = 0;
+    std::size_t start = 0;
+    while (start <= mnemonic.size()) {
+        auto end = mnemonic.find(' ', start);
+        if (end == std::string::npos) {
+            end = mnemonic.size();
         }
+        const auto word = index.find(mnemonic.data() + start, end - start);
+        if (word < 0) {
+            memzero(bits, sizeof(bits));
+            return false;
+        }
+        for (int bit = 10; bit >= 0; --bit, ++bitCount) {
+            if (word & (1 << bit)) {
+                bits[bitCount / 8] |= 1 << (7 - bitCount % 8);
+            }
+        }
+        start = end + 1;
     }
-    // not found
-    return false;
+
+    const auto entropySize = static_cast<std::size_t>(wordCount) * 4 / 3;
+    const auto checksumBits = static_cast<unsigned>(wordCount) / 3;
+    const uint8_t checksum = bits[entropySize];
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    sha256_Raw(bits, entropySize, hash);
+    const uint8_t mask = static_cast<uint8_t>(0xff << (8 - checksumBits));
+    const bool valid = (hash[0] & mask) == (checksum & mask);
+    memzero(bits, sizeof(bits));
+    memzero(hash, sizeof(hash));
+    return valid;
+}
+
+std::vector<bool> Mnemonic::validateMany(const std::vector<std::string>& mnemonics) {
+    std::vector<bool> result;
+    result.reserve(mnemonics.size());
+    for (const auto& mnemonic : mnemonics) {
+        result.push_back(isValid(mnemonic));
+    }
+    return result;
+}
+
+bool Mnemonic::isValidWord(const std::string& word) {
+    return wordIndex(word) >= 0;
+}
+
+int Mnemonic::wordIndex(const std::string& word) {
+    return WordIndex::shared().find(word.data(), word.size());
 }
 
 std::string Mnemonic::suggest(const std::string& prefix) {
-    if (prefix.size() == 0) {
+    if (prefix.size() == 0 || prefix.size() > maxWordLength) {
         return "";
     }
     assert(prefix.size() >= 1);
@@ -44,29 +166,22 @@ std::string Mnemonic::suggest(const std::string& prefix) {
     std::string prefixLo = prefix;
     std::transform(prefixLo.begin(), prefixLo.end(), prefixLo.begin(),
         [](unsigned char c){ return std::tolower(c); });
-    const char* prefixLoC = prefixLo.c_str();
-
-    std::vector<std::string> result;
-    for (const char* const* word = mnemonicWordlist(); *word != nullptr; ++word) {
-        // check first letter match (optimization)
-        if ((*word)[0] == prefixLo[0]) {
-            if (strncmp(*word, prefixLoC, prefixLo.length()) == 0) {
-                // we have a match
-                result.push_back(*word);
-                if (result.size() >= SuggestMaxCount) {
-                    break; // enough results
-                }
-            }
-        }
+    const auto packed = pack(prefixLo.data(), prefixLo.size());
+    if (packed == 0) {
+        return "";
     }
 
-    // convert results to one string
+    // matching words are the range of packed words sharing the prefix bits
+    const auto& words = WordIndex::shared().words;
+    const auto shift = 5 * (maxWordLength - prefixLo.size());
     std::string resultString;
-    for (auto& word: result) {
+    int count = 0;
+    for (auto it = std::lower_bound(words.begin(), words.end(), packed);
+         it != words.end() && (*it >> shift) == (packed >> shift) && count < SuggestMaxCount; ++it, ++count) {
         if (resultString.length() > 0) {
             resultString += " ";
         }
-        resultString += word;
+        resultString += wordlist[it - words.begin()];
     }
     return resultString;
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 namespace TW {
 
@@ -17,9 +18,15 @@ public:
     // E.g. for a valid mnemonic: "credit expect life fade cover suit response wash pear what skull force"
     static bool isValid(const std::string& mnemonic);
 
+    /// Determines whether many mnemonic phrases are valid, see isValid.
+    static std::vector<bool> validateMany(const std::vector<std::string>& mnemonics);
+
     /// Determines whether word is a valid menemonic word.
     static bool isValidWord(const std::string& word);
 
+    /// Returns the index of a BIP39 English word, or -1 if it is not one.
+    static int wordIndex(const std::string& word);
+
     /// Return BIP39 English words that match the given prefix.
     // - A single string is returned, with space-separated list of words (or single word or empty string)
     //   (Why not array?  To simplify the cross-language interfaces)
@@ -11,12 +11,13 @@
 using namespace TW;
 using namespace TW::NEAR;
 
-static auto pattern = std::regex(R"(^(([a-z\d]+[\-_])*[a-z\d]+\.)*([a-z\d]+[\-_])*[a-z\d]+$)");
 bool Account::isValid(const std::string& string) {
     // https://docs.near.org/docs/concepts/account#account-id-rules
     if (string.size() < 2 || string.size() > 64) {
         return false;
     }
+    // compiled on first use rather than when the library is loaded
+    static const auto pattern = std::regex(R"(^(([a-z\d]+[\-_])*[a-z\d]+\.)*([a-z\d]+[\-_])*[a-z\d]+$)");
     std::smatch match;
     return regex_search(string, match, pattern);
 }
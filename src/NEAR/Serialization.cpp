@@ -6,83 +6,107 @@
 
 #include "Serialization.h"
 
-#include "../BinaryCoding.h"
-#include "../PrivateKey.h"
+#include "../Borsh.h"
+#include "../SignerBackend.h"
 
 using namespace TW;
 using namespace TW::NEAR;
 using namespace TW::NEAR::Proto;
 
 
-static void writeU8(Data& data, uint8_t number) {
-    data.push_back(number);
+template <typename Writer>
+static void writePublicKey(Writer& writer, uint32_t keyType, DataView keyData) {
+    writer.writeU8(static_cast<uint8_t>(keyType));
+    writer.writeRaw(keyData);
 }
 
-static void writeU32(Data& data, uint32_t number) {
-    encode32LE(number, data);
+template <typename Writer>
+static void writePublicKey(Writer& writer, const Proto::PublicKey& publicKey) {
+    writer.writeU8(static_cast<uint8_t>(publicKey.key_type()));
+    writer.writeRaw(publicKey.data());
 }
 
-static void writeU64(Data& data, uint64_t number) {
-    encode64LE(number, data);
-}
-
-static void writeU128(Data& data, const std::string& numberData) {
-    data.insert(std::end(data), std::begin(numberData), std::end(numberData));
-}
-
-template <class T> static void writeRawBuffer(Data& data, const T& buf) {
-    data.insert(std::end(data), std::begin(buf), std::end(buf));
-}
-
-static void writeString(Data& data, const std::string& str) {
-    writeU32(data, static_cast<uint32_t>(str.length()));
-    writeRawBuffer(data, str);
-}
-
-static void writePublicKey(Data& data, const Proto::PublicKey& publicKey) {
-    writeU8(data, static_cast<uint8_t>(publicKey.key_type()));
-    const auto& keyData = publicKey.data();
-    writeRawBuffer(data, keyData);
-}
-
-static void writeTransfer(Data& data, const Proto::Transfer& transfer) {
-    writeU128(data, transfer.deposit());
+template <typename Writer>
+static void writeAccessKey(Writer& writer, const Proto::AccessKey& accessKey) {
+    writer.writeU64(accessKey.nonce());
+    if (accessKey.has_function_call()) {
+        const auto& permission = accessKey.function_call();
+        writer.writeU8(0);
+        // Option<u128>
+        if (permission.allowance().empty()) {
+            writer.writeU8(0);
+        } else {
+            writer.writeU8(1);
+            writer.writeRaw(permission.allowance());
+        }
+        writer.writeBytes(permission.receiver_id());
+        writer.writeU32(0); // method names
+    } else {
+        writer.writeU8(1); // full access
+    }
 }
 
-static void writeAction(Data& data, const Proto::Action& action) {
-    writeU8(data, action.payload_case() - Proto::Action::kCreateAccount);
+template <typename Writer>
+static void writeAction(Writer& writer, const Proto::Action& action) {
+    writer.writeU8(action.payload_case() - Proto::Action::kCreateAccount);
     switch (action.payload_case()) {
+        case Proto::Action::kDeployContract:
+            writer.writeBytes(action.deploy_contract().code());
+            return;
+        case Proto::Action::kFunctionCall:
+            writer.writeBytes(action.function_call().method_name());
+            writer.writeBytes(action.function_call().args());
+            writer.writeU64(action.function_call().gas());
+            writer.writeRaw(action.function_call().deposit());
+            return;
         case Proto::Action::kTransfer:
-            writeTransfer(data, action.transfer());
+            writer.writeRaw(action.transfer().deposit());
+            return;
+        case Proto::Action::kAddKey:
+            writePublicKey(writer, action.add_key().public_key());
+            writeAccessKey(writer, action.add_key().access_key());
+            return;
+        case Proto::Action::kDeleteKey:
+            writePublicKey(writer, action.delete_key().public_key());
+            return;
+        case Proto::Action::kDeleteAccount:
+            writer.writeBytes(action.delete_account().beneficiary_id());
             return;
         default:
             return;
     }
 }
 
-Data TW::NEAR::transactionData(const Proto::SigningInput& input) {
-    Data data;
-    writeString(data, input.signer_id());
-    auto key = PrivateKey(input.private_key());
-    auto public_key = key.getPublicKey(TWPublicKeyTypeED25519);
-    auto public_key_proto = Proto::PublicKey();
-    public_key_proto.set_data(public_key.bytes.data(), public_key.bytes.size());
-    writePublicKey(data, public_key_proto);
-    writeU64(data, input.nonce());
-    writeString(data, input.receiver_id());
-    const auto& block_hash = input.block_hash();
-    writeRawBuffer(data, block_hash);
-    writeU32(data, input.actions_size());
+template <typename Writer>
+static void writeTransaction(Writer& writer, const Proto::SigningInput& input, const TW::PublicKey& publicKey) {
+    writer.writeBytes(input.signer_id());
+    writePublicKey(writer, 0, publicKey.bytes);
+    writer.writeU64(input.nonce());
+    writer.writeBytes(input.receiver_id());
+    writer.writeRaw(input.block_hash());
+    writer.writeU32(input.actions_size());
     for (const auto& action : input.actions()) {
-        writeAction(data, action);
+        writeAction(writer, action);
     }
+}
+
+Data TW::NEAR::transactionData(const Proto::SigningInput& input, size_t reservedSuffix) {
+    auto key = SigningKey(input.private_key(), TWPublicKeyTypeED25519);
+    auto publicKey = key.getPublicKey(TWPublicKeyTypeED25519);
+
+    Borsh::SizeCounter counter;
+    writeTransaction(counter, input, publicKey);
+    Data data;
+    Borsh::Writer writer(data, counter.size + reservedSuffix);
+    writeTransaction(writer, input, publicKey);
     return data;
 }
 
 Data TW::NEAR::signedTransactionData(const Data& transactionData, const Data& signatureData) {
     Data data;
-    writeRawBuffer(data, transactionData);
-    writeU8(data, 0);
-    writeRawBuffer(data, signatureData);
+    Borsh::Writer writer(data, transactionData.size() + signatureSuffixSize);
+    writer.writeRaw(transactionData);
+    writer.writeU8(0);
+    writer.writeRaw(signatureData);
     return data;
 }
@@ -11,7 +11,12 @@
 
 namespace TW::NEAR {
 
-Data transactionData(const Proto::SigningInput& input);
+/// Key type and ed25519 signature, following the transaction in the signed form
+static const size_t signatureSuffixSize = 1 + 64;
+
+/// Borsh-serialized transaction, with `reservedSuffix` extra bytes of capacity,
+/// so that the signature can be appended in place.
+Data transactionData(const Proto::SigningInput& input, size_t reservedSuffix = 0);
 Data signedTransactionData(const Data& transactionData, const Data& signatureData);
 
 } // namespace
@@ -8,18 +8,27 @@
 #include "Serialization.h"
 
 #include "../Hash.h"
-#include "../PrivateKey.h"
+#include "../SignerBackend.h"
 
 using namespace TW;
 using namespace TW::NEAR;
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto transaction = transactionData(input);
-    auto key = PrivateKey(input.private_key());
-    auto hash = Hash::sha256(transaction);
-    auto signature = key.sign(hash, TWCurveED25519);
     auto output = Proto::SigningOutput();
-    auto signedTransaction = signedTransactionData(transaction, signature);
-    output.set_signed_transaction(signedTransaction.data(), signedTransaction.size());
+    try {
+        // the signature is appended in place
+        auto transaction = transactionData(input, signatureSuffixSize);
+        auto key = SigningKey(input.private_key(), TWPublicKeyTypeED25519);
+        auto hash = Hash::sha256(transaction);
+        auto signature = key.sign(hash, TWCurveED25519);
+        if (signature.empty()) {
+            return output;
+        }
+        transaction.push_back(0);
+        append(transaction, signature);
+        output.set_signed_transaction(transaction.data(), transaction.size());
+    } catch (const std::exception&) {
+        // invalid key
+    }
     return output;
 }
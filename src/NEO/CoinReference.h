@@ -29,9 +29,11 @@ class CoinReference : public Serializable {
         return Hash::sha256Size + prevIndexSize;
     }
 
-    void deserialize(const Data& data, int initial_pos = 0) override {
-        prevHash = load(readBytes(data, Hash::sha256Size, initial_pos));
-        prevIndex = decode16LE(data.data() + initial_pos + Hash::sha256Size);
+    using Serializable::deserialize;
+
+    void deserialize(BinaryReader& reader) override {
+        prevHash = load(reader.readBytes(Hash::sha256Size));
+        prevIndex = reader.read16LE();
     }
 
     Data serialize() const override {
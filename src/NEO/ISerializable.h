@@ -8,6 +8,7 @@
 
 #include "../Data.h"
 #include "../BinaryCoding.h"
+#include "../BinaryReader.h"
 #include "ReadData.h"
 
 namespace TW::NEO {
@@ -17,7 +18,17 @@ class ISerializable {
     virtual ~ISerializable() {}
     virtual int64_t size() const = 0;
     virtual Data serialize() const = 0;
-    virtual void deserialize(const Data& data, int initial_pos = 0) = 0;
+    /// Reads the object at the position of the reader, advancing it past the object.
+    virtual void deserialize(BinaryReader& reader) = 0;
+
+    /// Reads the object at `initial_pos` in `data`.
+    void deserialize(const Data& data, int initial_pos = 0) {
+        if (initial_pos < 0) {
+            throw std::invalid_argument("Invalid data for deserialization");
+        }
+        BinaryReader reader(data, static_cast<size_t>(initial_pos));
+        deserialize(reader);
+    }
 };
 
 } // namespace TW::NEO
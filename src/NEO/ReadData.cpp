@@ -6,41 +6,37 @@
 
 #include "../Data.h"
 #include "ReadData.h"
+#include "../BinaryReader.h"
 
 
+// Copying wrappers over BinaryReader, which deserializers use directly.
+
 TW::Data TW::readBytes(const TW::Data& from, int max, int initial_pos) {
-    if (from.size() - initial_pos < max) {
+    if (max < 0 || initial_pos < 0 || size_t(initial_pos) > from.size()) {
         throw std::invalid_argument("Data::Cannot read enough bytes!");
     }
-    return TW::Data(from.begin() + initial_pos, from.begin() + initial_pos + max);
+    BinaryReader reader(from, size_t(initial_pos));
+    return reader.readBytes(size_t(max)).toData();
 }
 
 TW::Data TW::readVarBytes(const Data& from, int initial_pos, uint32_t* dataRead) {
-    uint64_t size = readVar<uint64_t>(from, initial_pos);
-    auto shift = varIntSize(size);
+    if (initial_pos < 0) {
+        throw std::invalid_argument("Data::Cannot read enough bytes!");
+    }
+    BinaryReader reader(from, size_t(initial_pos));
+    auto bytes = reader.readVarBytes(INT_MAX).toData();
     if (dataRead) {
-        *dataRead = uint32_t(shift + size);
+        *dataRead = uint32_t(reader.position() - size_t(initial_pos));
     }
-    return readBytes(from, int(size), initial_pos + int(shift));
+    return bytes;
 }
 
 template<> uint64_t TW::readVar(const TW::Data& from, int initial_pos, const uint64_t &max) {
-    byte fb = from[initial_pos];
-    uint64_t value;
-    if (fb == 0xFD) {
-        value = decode16LE(from.data() + initial_pos + 1);
-    } else if (fb == 0xFE) {
-        value = decode32LE(from.data() + initial_pos + 1);
-    } else if (fb == 0xFF) {
-        value = decode64LE(from.data() + initial_pos + 1);
-    } else {
-        value = fb;
-    }
-    if (value > max) {
-        // std::cout << "TOO HUGE VALUE: " << value << " max=" << max << std::endl;
-        throw std::invalid_argument("ReadData::ReadVarInt error: Too huge value! FormatException");
+    if (initial_pos < 0) {
+        throw std::invalid_argument("ReadData::ReadVarInt error: FormatException");
     }
-    return value;
+    BinaryReader reader(from, size_t(initial_pos));
+    return reader.readVarInt(max);
 }
 
 template<> int64_t TW::readVar(const TW::Data& from, int initial_pos, const int64_t &max) {
@@ -8,6 +8,8 @@
 
 #include "ISerializable.h"
 
+#include <algorithm>
+
 namespace TW::NEO {
 
 class Serializable : public ISerializable {
@@ -43,19 +45,25 @@ class Serializable : public ISerializable {
         return resp;
     }
 
+    using ISerializable::deserialize;
+
+    /// Reads an array of objects prefixed by its variable-length size, appending them to `resp`.
     template<class T>
-    static inline int deserialize(std::vector <T> &resp, const Data& data, int initial_pos = 0) {
-        uint64_t size = readVar<uint64_t>(data, initial_pos, INT_MAX);
-        // assert(size >= 0);
-        initial_pos += varIntSize(size);
+    static inline void deserialize(std::vector <T> &resp, BinaryReader& reader) {
+        uint64_t size = reader.readVarInt(INT_MAX);
+        // each element takes at least one byte
+        resp.reserve(resp.size() + static_cast<size_t>(std::min<uint64_t>(size, reader.remaining())));
         for (uint64_t i = 0; i < size; ++i) {
-            T value;
-            value.deserialize(data, initial_pos);
-            resp.push_back(value);
-            initial_pos += value.size();
+            resp.emplace_back();
+            resp.back().deserialize(reader);
         }
+    }
 
-        return initial_pos;
+    template<class T>
+    static inline int deserialize(std::vector <T> &resp, const Data& data, int initial_pos = 0) {
+        BinaryReader reader(data, initial_pos);
+        deserialize(resp, reader);
+        return int(reader.position());
     }
 
 };
@@ -20,7 +20,7 @@ using namespace std;
 
 Signer::Signer(const PrivateKey& priKey) : privateKey(std::move(priKey)) {
     auto pub = privateKey.getPublicKey(TWPublicKeyTypeNIST256p1);
-    publicKey = pub.bytes;
+    publicKey = pub.bytes.toData();
     address = Address(pub);
 }
 
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include <ctype.h>
+#include <memory>
 
 #include "../uint256.h"
 #include "../Data.h"
@@ -21,30 +22,33 @@ int64_t Transaction::size() const {
     return serialize().size();
 }
 
-void Transaction::deserialize(const Data& data, int initial_pos) {
-    type = (TransactionType) data[initial_pos++];
-    version = data[initial_pos++];
-    initial_pos = deserializeExclusiveData(data, initial_pos);
+void Transaction::deserialize(BinaryReader& reader) {
+    type = (TransactionType) reader.readByte();
+    version = reader.readByte();
+    deserializeExclusiveData(reader);
     attributes.clear();
-    initial_pos = Serializable::deserialize<TransactionAttribute>(attributes, data, initial_pos);
+    Serializable::deserialize<TransactionAttribute>(attributes, reader);
     inInputs.clear();
-    initial_pos = Serializable::deserialize<CoinReference>(inInputs, data, initial_pos);
+    Serializable::deserialize<CoinReference>(inInputs, reader);
     outputs.clear();
-    Serializable::deserialize<TransactionOutput>(outputs, data, initial_pos);
+    Serializable::deserialize<TransactionOutput>(outputs, reader);
 }
 
 Transaction * Transaction::deserializeFrom(const Data& data, int initial_pos) {
-    Transaction * resp = nullptr;
+    std::unique_ptr<Transaction> resp;
+    if (initial_pos < 0 || size_t(initial_pos) >= data.size()) {
+        throw std::invalid_argument("Transaction::deserializeFrom Invalid data");
+    }
     switch ((TransactionType) data[initial_pos]) {
         case TransactionType::TT_MinerTransaction:
-            resp = new MinerTransaction();
+            resp = std::make_unique<MinerTransaction>();
             break;
         default:
             throw std::invalid_argument("Transaction::deserializeFrom Invalid transaction type");
             break;
     }
     resp->deserialize(data, initial_pos);
-    return resp;
+    return resp.release();
 }
 
 Data Transaction::serialize() const {
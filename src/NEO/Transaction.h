@@ -28,12 +28,13 @@ public:
 
     virtual ~Transaction() {}
     int64_t size() const override;
-    void deserialize(const Data& data, int initial_pos = 0) override;
+    using Serializable::deserialize;
+    void deserialize(BinaryReader& reader) override;
     Data serialize() const override;
 
     bool operator==(const Transaction &other) const;
 
-    virtual int deserializeExclusiveData(const Data& data, int initial_pos = 0) { return initial_pos; }
+    virtual void deserializeExclusiveData(BinaryReader& reader) {}
     virtual Data serializeExclusiveData() const { return Data(); }
 
     Data getHash() const;
@@ -24,24 +24,26 @@ class TransactionAttribute : public Serializable {
         return 1 + data.size();
     }
 
-    void deserialize(const Data& data, int initial_pos = 0) override {
-        if (data.size() < initial_pos + 1) {
+    using Serializable::deserialize;
+
+    void deserialize(BinaryReader& reader) override {
+        if (reader.remaining() < 1) {
             throw std::invalid_argument("Invalid data for deserialization");
         }
-        usage = (TransactionAttributeUsage) data[initial_pos];
+        usage = (TransactionAttributeUsage) reader.readByte();
         if (usage == TransactionAttributeUsage::TAU_ContractHash || usage == TransactionAttributeUsage::TAU_Vote ||
             (usage >= TransactionAttributeUsage::TAU_Hash1 && usage <= TransactionAttributeUsage::TAU_Hash15)) {
-            this->data = readBytes(data, 32, initial_pos + 1);
+            this->data = reader.readBytes(32).toData();
         } else if (usage == TransactionAttributeUsage::TAU_ECDH02 ||
                     usage == TransactionAttributeUsage::TAU_ECDH03) {
-            this->data = readBytes(data, 32, initial_pos + 1);
+            this->data = reader.readBytes(32).toData();
         } else if (usage == TransactionAttributeUsage::TAU_Script) {
-            this->data = readBytes(data, 20, initial_pos + 1);
+            this->data = reader.readBytes(20).toData();
         } else if (usage == TransactionAttributeUsage::TAU_DescriptionUrl) {
-            this->data = readBytes(data, 1, initial_pos + 1);
+            this->data = reader.readBytes(1).toData();
         } else if (usage == TransactionAttributeUsage::TAU_Description ||
                     usage >= TransactionAttributeUsage::TAU_Remark) {
-            this->data = readBytes(data, int(data.size()) - 1 - initial_pos, initial_pos + 1);
+            this->data = reader.readRemaining().toData();
         } else {
             throw std::invalid_argument("TransactionAttribute Deserialize FormatException");
         }
@@ -31,10 +31,12 @@ class TransactionOutput : public Serializable {
         return store(assetId).size() + valueSize + store(scriptHash).size();
     }
 
-    void deserialize(const Data& data, int initial_pos = 0) override {
-        assetId = load(readBytes(data, assetIdSize, initial_pos));
-        value = decode64LE(data.data() + initial_pos + assetIdSize);
-        scriptHash = load(readBytes(data, scriptHashSize, initial_pos + assetIdSize + valueSize));
+    using Serializable::deserialize;
+
+    void deserialize(BinaryReader& reader) override {
+        assetId = load(reader.readBytes(assetIdSize));
+        value = reader.read64LE();
+        scriptHash = load(reader.readBytes(scriptHashSize));
     }
 
     Data serialize() const override {
@@ -23,10 +23,11 @@ class Witness : public Serializable {
         return invocationScript.size() + verificationScript.size();
     }
 
-    void deserialize(const Data& data, int initial_pos = 0) override {
-        uint32_t size;
-        invocationScript = readVarBytes(data, initial_pos, &size);
-        verificationScript = readVarBytes(data, initial_pos + size);
+    using Serializable::deserialize;
+
+    void deserialize(BinaryReader& reader) override {
+        invocationScript = reader.readVarBytes().toData();
+        verificationScript = reader.readVarBytes().toData();
     }
 
     Data serialize() const override {
@@ -17,17 +17,14 @@ using namespace TW::NULS;
 const std::string Address::prefix("NULSd");
 const std::array<byte, 2> Address::mainnetId = {0x01, 0x00};
 
-bool Address::isValid(const std::string& string) {
-    if (string.empty()) {
-        return false;
-    }
-    if (string.length() <=  prefix.length()) {
+namespace {
+
+/// Decodes the Base58 part of an address in place, checking its size and checksum.
+bool decode(const std::string& string, const std::string& prefix, std::array<byte, Address::size>& decoded) {
+    if (string.length() <= prefix.length()) {
         return false;
     }
-
-    std::string address = string.substr(prefix.length(), string.length() - prefix.length());
-    Data decoded = Base58::bitcoin.decode(address);
-    if (decoded.size() != size) {
+    if (!Base58::bitcoin.decode(string.data() + prefix.length(), string.data() + string.length(), decoded.data(), decoded.size())) {
         return false;
     }
 
@@ -40,6 +37,13 @@ bool Address::isValid(const std::string& string) {
     return decoded[23] == checkSum;
 }
 
+} // namespace
+
+bool Address::isValid(const std::string& string) {
+    std::array<byte, size> decoded;
+    return decode(string, prefix, decoded);
+}
+
 Address::Address(const TW::PublicKey& publicKey) {
     // Main-Net chainID
     bytes[0] = mainnetId[0];
@@ -51,12 +55,9 @@ Address::Address(const TW::PublicKey& publicKey) {
 }
 
 Address::Address(const std::string& string) {
-    if (false == isValid(string)){
+    if (!decode(string, prefix, bytes)) {
         throw std::invalid_argument("Invalid address string");
     }
-    std::string address = string.substr(prefix.length(), string.length() - prefix.length()); 
-    const auto decoded = Base58::bitcoin.decode(address);
-    std::copy(decoded.begin(), decoded.end(), bytes.begin());
 }
 
 uint16_t Address::chainID() const {
@@ -15,23 +15,32 @@
 using namespace TW;
 using namespace TW::NULS;
 
-static inline void serializerRemark(std::string& remark, Data& data) {
+static inline void serializerRemark(const std::string& remark, Data& data) {
     encodeVarInt(remark.length(), data);
-    std::copy(remark.begin(), remark.end(), std::back_inserter(data));
+    data.insert(data.end(), remark.begin(), remark.end());
 }
 
-static inline void serializerInput(const Proto::TransactionCoinFrom& input, Data& data) {
-    encodeVarInt(1, data);  //there is one coinFrom
-    const auto& fromAddress = input.from_address();
-    if (!NULS::Address::isValid(fromAddress)) {
+/// Parses an address, decoding it once.
+static inline NULS::Address parseAddress(const std::string& string) {
+    try {
+        return NULS::Address(string);
+    } catch (const std::invalid_argument&) {
         throw std::invalid_argument("Invalid address");
     }
-    const auto& addr = NULS::Address(fromAddress);
+}
+
+/// Appends an address without its checksum byte, prefixed by its size.
+static inline void serializerAddress(const NULS::Address& addr, Data& data) {
     encodeVarInt(addr.bytes.size() - 1, data);
-    std::copy(addr.bytes.begin(), addr.bytes.end() - 1, std::back_inserter(data));
+    data.insert(data.end(), addr.bytes.begin(), addr.bytes.end() - 1);
+}
+
+static inline void serializerInput(const Proto::TransactionCoinFrom& input, Data& data) {
+    encodeVarInt(1, data);  //there is one coinFrom
+    serializerAddress(parseAddress(input.from_address()), data);
     encode16LE(static_cast<uint16_t>(input.assets_chainid()), data);
     encode16LE(static_cast<uint16_t>(input.assets_id()), data);
-    std::copy(input.id_amount().begin(), input.id_amount().end(), std::back_inserter(data));
+    data.insert(data.end(), input.id_amount().begin(), input.id_amount().end());
     Data nonce = parse_hex(input.nonce());
     encodeVarInt(nonce.size(), data);
     append(data, nonce);
@@ -40,35 +49,34 @@ static inline void serializerInput(const Proto::TransactionCoinFrom& input, Data
 
 static inline void serializerOutput(const Proto::TransactionCoinTo& output, Data& data) {
     encodeVarInt(1, data); //there is one coinTo
-
-    const auto& toAddress = output.to_address();
-    if (!NULS::Address::isValid(toAddress)) {
-        throw std::invalid_argument("Invalid address");
-    }
-    const auto& addr = NULS::Address(toAddress);
-    encodeVarInt(addr.bytes.size() - 1, data);
-    std::copy(addr.bytes.begin(), addr.bytes.end() - 1, std::back_inserter(data));
+    serializerAddress(parseAddress(output.to_address()), data);
     encode16LE(static_cast<uint16_t>(output.assets_chainid()), data);
     encode16LE(static_cast<uint16_t>(output.assets_id()), data);
-    std::copy(output.id_amount().begin(), output.id_amount().end(), std::back_inserter(data));
+    data.insert(data.end(), output.id_amount().begin(), output.id_amount().end());
     encode64LE(output.lock_time(), data);
 }
 
 static inline Data calcTransactionDigest(Data& data) {
-    Data hash1 = Hash::sha256(data);
-    Data hash2 = Hash::sha256(hash1);
-    return hash2;
+    const auto hash = Hash::sha256dDigest(data);
+    return Data(hash.begin(), hash.end());
 }
 
-static inline Data makeTransactionSignature(PrivateKey& privateKey, Data& txHash) {
+/// Appends the transaction signature, the public key and DER signature, prefixed by its size.
+static inline void serializerTransactionSignature(PrivateKey& privateKey, Data& txHash, Data& data) {
     PublicKey pubKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
-    Data transactionSignature = Data();
-    encodeVarInt(pubKey.bytes.size(), transactionSignature);
-    std::copy(pubKey.bytes.begin(), pubKey.bytes.end(), std::back_inserter(transactionSignature));
     auto signature = privateKey.signAsDER(txHash, TWCurve::TWCurveSECP256k1);
-    encodeVarInt(signature.size(), transactionSignature);
-    std::copy(signature.begin(), signature.end(), std::back_inserter(transactionSignature));
-    return transactionSignature;
+    const auto size = varIntSize(pubKey.bytes.size()) + pubKey.bytes.size() + varIntSize(signature.size()) + signature.size();
+    encodeVarInt(size, data);
+    encodeVarInt(pubKey.bytes.size(), data);
+    append(data, pubKey.bytes);
+    encodeVarInt(signature.size(), data);
+    append(data, signature);
 }
 
-
+/// A 256-bit amount, in little endian
+static inline std::string serializerAmount(const uint256_t& amount) {
+    const auto bigEndian = store(amount);
+    std::string result(32, '\0');
+    std::reverse_copy(bigEndian.begin(), bigEndian.end(), result.begin());
+    return result;
+}
@@ -66,31 +66,20 @@ Data Signer::sign() const {
     }
 
     Proto::TransactionCoinFrom& coinFrom = (Proto::TransactionCoinFrom&)tx.input();
-    Data amount;
-    amount = store(fromAmount);
-    std::reverse(amount.begin(), amount.end());
-    std::string amountStr;
-    amountStr.insert(amountStr.begin(), amount.begin(), amount.end());
-    amountStr.append(static_cast<unsigned long>(amount.capacity() - amount.size()), '\0');
-    coinFrom.set_id_amount(amountStr);
+    coinFrom.set_id_amount(serializerAmount(fromAmount));
 
     Proto::TransactionCoinTo& coinTo = (Proto::TransactionCoinTo&)tx.output();
-    Data amountTo;
-    amountTo = store(txAmount);
-    std::reverse(amountTo.begin(), amountTo.end());
-    std::string amountToStr;
-    amountToStr.insert(amountToStr.begin(), amountTo.begin(), amountTo.end());
-    amountToStr.append(static_cast<unsigned long>(amountTo.capacity() - amountTo.size()), '\0');
-    coinTo.set_id_amount(amountToStr);
+    coinTo.set_id_amount(serializerAmount(txAmount));
 
     auto dataRet = Data();
+    // the estimated size is an upper bound, but for an unusually long nonce
+    dataRet.reserve(txSize + tx.input().nonce().size());
     // Transaction Type
     encode16LE(static_cast<uint16_t>(tx.type()), dataRet);
     // Timestamp
     encode32LE(tx.timestamp(), dataRet);
      // Remark
-    std::string remark = tx.remark();
-    serializerRemark(remark, dataRet);
+    serializerRemark(tx.remark(), dataRet);
     // txData
     encodeVarInt(0, dataRet);
 
@@ -106,11 +95,8 @@ Data Signer::sign() const {
     // Calc transaction hash
     Data txHash = calcTransactionDigest(dataRet);
    
-    Data privKey = data(input.private_key());
-    auto priv = PrivateKey(privKey);
-    auto transactionSignature = makeTransactionSignature(priv, txHash);
-    encodeVarInt(transactionSignature.size(), dataRet);
-    std::copy(transactionSignature.begin(), transactionSignature.end(), std::back_inserter(dataRet));
+    auto priv = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    serializerTransactionSignature(priv, txHash, dataRet);
 
     return dataRet;
 }
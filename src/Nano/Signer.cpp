@@ -8,6 +8,7 @@
 #include "Signer.h"
 #include "../BinaryCoding.h"
 #include "../Hash.h"
+#include "../Hashers.h"
 #include "../HexCoding.h"
 #include <nlohmann/json.hpp>
 
@@ -104,16 +105,15 @@ std::array<byte, 32> hashBlockData(const PublicKey& publicKey, const Proto::Sign
         throw std::invalid_argument("Missing link block hash");
     }
 
-    auto msg = Data();
-    msg.insert(msg.end(), kBlockHashPreamble.begin(), kBlockHashPreamble.end());
-    msg.insert(msg.end(), publicKey.bytes.begin(), publicKey.bytes.end());
-    msg.insert(msg.end(), parentHash.begin(), parentHash.end());
-    msg.insert(msg.end(), repPublicKey.begin(), repPublicKey.end());
-    msg.insert(msg.end(), balance.begin(), balance.end());
-    msg.insert(msg.end(), link.begin(), link.end());
-
     std::array<byte, 32> blockHash = {0};
-    auto digest = Hash::blake2b(msg, blockHash.size());
+    auto hasher = Hash::Blake2bHasher(blockHash.size());
+    hasher.update(kBlockHashPreamble)
+        .update(publicKey.bytes)
+        .update(parentHash)
+        .update(repPublicKey)
+        .update(balance)
+        .update(link);
+    const auto digest = hasher.final();
     std::copy_n(digest.begin(), blockHash.size(), blockHash.begin());
 
     return blockHash;
@@ -155,6 +155,16 @@ std::array<byte, 64> Signer::sign() const noexcept {
     return signature;
 }
 
+Work::Root Signer::workRoot() const {
+    const bool emptyPrevious = std::all_of(previous.begin(), previous.end(), [](auto b) { return b == 0; });
+    if (!emptyPrevious) {
+        return previous;
+    }
+    Work::Root root;
+    std::copy_n(publicKey.bytes.begin(), root.size(), root.begin());
+    return root;
+}
+
 Proto::SigningOutput Signer::build() const {
     auto output = Proto::SigningOutput();
     const auto signature = sign();
@@ -7,6 +7,7 @@
 #pragma once
 
 #include "Address.h"
+#include "Work.h"
 #include "../Data.h"
 #include "../PrivateKey.h"
 #include <proto/Nano.pb.h>
@@ -32,6 +33,11 @@ class Signer {
     /// Signs the blockHash, returns signature bytes
     std::array<byte, 64> sign() const noexcept;
 
+    /// Returns the root of the block proof of work: the previous block hash, or the
+    /// public key for the first block of the account.  Once the block is built, its hash is
+    /// the root of the next block, whose work can be precomputed with a WorkGenerator.
+    Work::Root workRoot() const;
+
     /// Builds signed transaction, incl. signature, and json format
     Proto::SigningOutput build() const;
 };
@@ -0,0 +1,173 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Work.h"
+#include "../HexCoding.h"
+#include "../ThreadPool.h"
+
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/blake2b_hw.h>
+
+#include <algorithm>
+#include <limits>
+#include <mutex>
+#include <random>
+#include <vector>
+
+using namespace TW;
+using namespace TW::Nano;
+
+static const size_t workSize = 8;
+/// Number of attempts between checks for cancellation or a result from another thread.
+static const uint64_t attemptsPerCheck = 256;
+
+/// Number of nonces hashed at once by the search, with the multi-message Blake2b.
+static const size_t batchSize = 4;
+
+/// Difficulty computation with the hasher state initialized once.
+class DifficultyHasher {
+  public:
+    explicit DifficultyHasher(const Work::Root& root) {
+        blake2b_Init(&initial, workSize);
+        for (size_t i = 0; i < batchSize; ++i) {
+            std::copy(root.begin(), root.end(), messages[i].begin() + workSize);
+            pointers[i] = messages[i].data();
+            sizes[i] = messages[i].size();
+        }
+    }
+
+    uint64_t difficulty(uint64_t work) {
+        setNonce(messages[0], work);
+        auto state = initial;
+        blake2b_Update(&state, messages[0].data(), messages[0].size());
+        std::array<byte, workSize> digest;
+        blake2b_Final(&state, digest.data(), digest.size());
+        return decode(digest.data());
+    }
+
+    /// Returns the difficulties of the nonces `work + i * step`, for i < batchSize.
+    std::array<uint64_t, batchSize> difficulties(uint64_t work, uint64_t step) {
+        for (size_t i = 0; i < batchSize; ++i, work += step) {
+            setNonce(messages[i], work);
+        }
+        std::array<byte, batchSize * workSize> digests;
+        blake2b_batch(&initial, pointers.data(), sizes.data(), batchSize, digests.data());
+        std::array<uint64_t, batchSize> result;
+        for (size_t i = 0; i < batchSize; ++i) {
+            result[i] = decode(digests.data() + i * workSize);
+        }
+        return result;
+    }
+
+  private:
+    using Message = std::array<byte, workSize + 32>;
+
+    static void setNonce(Message& message, uint64_t work) {
+        for (size_t i = 0; i < workSize; ++i) {
+            message[i] = static_cast<byte>(work >> (8 * i));
+        }
+    }
+
+    static uint64_t decode(const byte* digest) {
+        uint64_t result = 0;
+        for (size_t i = 0; i < workSize; ++i) {
+            result |= static_cast<uint64_t>(digest[i]) << (8 * i);
+        }
+        return result;
+    }
+
+    blake2b_state initial;
+    // little endian nonce, followed by the root
+    std::array<Message, batchSize> messages{};
+    std::array<const byte*, batchSize> pointers;
+    std::array<size_t, batchSize> sizes;
+};
+
+uint64_t Work::difficulty(const Root& root, uint64_t work) {
+    return DifficultyHasher(root).difficulty(work);
+}
+
+std::string Work::string(uint64_t work) {
+    Data data;
+    data.reserve(workSize);
+    for (auto shift = 8 * int(workSize - 1); shift >= 0; shift -= 8) {
+        data.push_back(static_cast<byte>(work >> shift));
+    }
+    return hex(data);
+}
+
+std::optional<uint64_t> Work::generate(const Root& root, uint64_t threshold, const std::atomic<bool>& cancelled, size_t threadCount) {
+    // one stride per concurrent search, so that all nonces get scanned
+    auto& pool = ThreadPool::shared();
+    threadCount = pool.workerCount(threadCount, std::numeric_limits<size_t>::max());
+    // threads scan interleaved nonces from a random start, so concurrent searches do not overlap
+    const uint64_t start = (uint64_t(std::random_device()()) << 32) | std::random_device()();
+
+    std::atomic<bool> found(false);
+    uint64_t result = 0;
+    std::mutex resultMutex;
+    auto worker = [&](size_t offset) {
+        auto hasher = DifficultyHasher(root);
+        auto work = start + offset;
+        while (!found && !cancelled) {
+            for (uint64_t i = 0; i < attemptsPerCheck; i += batchSize, work += batchSize * threadCount) {
+                const auto difficulties = hasher.difficulties(work, threadCount);
+                for (size_t j = 0; j < batchSize; ++j) {
+                    if (difficulties[j] >= threshold) {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        if (!found) {
+                            result = work + j * threadCount;
+                            found = true;
+                        }
+                        return;
+                    }
+                }
+            }
+        }
+    };
+
+    pool.parallelFor(threadCount, threadCount, worker);
+    if (!found) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+WorkGenerator::WorkGenerator(uint64_t threshold, size_t threadCount)
+    : threshold(threshold), backend([threadCount](const Work::Root& root, uint64_t target, const std::atomic<bool>& cancelled) {
+          return Work::generate(root, target, cancelled, threadCount);
+      }) {}
+
+WorkGenerator::WorkGenerator(uint64_t threshold, Work::Backend backend)
+    : threshold(threshold), backend(std::move(backend)) {}
+
+WorkGenerator::~WorkGenerator() {
+    discardPending();
+}
+
+void WorkGenerator::precompute(const Work::Root& root) {
+    discardPending();
+    cancelled = false;
+    pendingRoot = root;
+    pending = std::async(std::launch::async, backend, root, threshold, std::cref(cancelled));
+}
+
+std::optional<uint64_t> WorkGenerator::work(const Work::Root& root) {
+    if (pending.valid() && pendingRoot == root) {
+        return pending.get();
+    }
+    discardPending();
+    cancelled = false;
+    return backend(root, threshold, cancelled);
+}
+
+void WorkGenerator::discardPending() {
+    if (pending.valid()) {
+        cancelled = true;
+        pending.wait();
+        pending = {};
+    }
+}
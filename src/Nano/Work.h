@@ -0,0 +1,91 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <optional>
+#include <string>
+
+namespace TW::Nano {
+
+/// Proof of work of a block: an 8-byte nonce, whose blake2b hash together with the block root
+/// reaches a difficulty threshold.  The root is the previous block hash, or the account
+/// public key for the first block of an account.
+class Work {
+  public:
+    using Root = std::array<byte, 32>;
+
+    /// Difficulty threshold of send and change blocks.
+    static const uint64_t sendThreshold = 0xfffffff800000000;
+    /// Difficulty threshold of receive blocks.
+    static const uint64_t receiveThreshold = 0xfffffe0000000000;
+
+    /// Work generation backend, returning a valid nonce, or nothing if `cancelled` gets set.
+    /// The default backend is `generate`; a GPU implementation can be plugged in instead.
+    using Backend = std::function<std::optional<uint64_t>(const Root& root, uint64_t threshold, const std::atomic<bool>& cancelled)>;
+
+    /// Returns the difficulty of a nonce for the given root.
+    static uint64_t difficulty(const Root& root, uint64_t work);
+
+    /// Returns true if the nonce reaches the threshold for the given root.
+    static bool isValid(const Root& root, uint64_t work, uint64_t threshold) {
+        return difficulty(root, work) >= threshold;
+    }
+
+    /// Formats a nonce the way blocks carry it, as 16 hex digits.
+    static std::string string(uint64_t work);
+
+    /// Searches a nonce reaching the threshold on the CPU, on `threadCount` threads of the shared ThreadPool
+    /// (0 for all), until one is found or `cancelled` gets set.
+    static std::optional<uint64_t> generate(const Root& root, uint64_t threshold, const std::atomic<bool>& cancelled, size_t threadCount = 0);
+};
+
+/// Generates the work of the next block of an account in the background,
+/// starting as soon as its root, the hash of the previous block, is known.
+/// Not thread-safe, except for `cancel`.
+class WorkGenerator {
+  public:
+    /// Creates a generator using the CPU backend.
+    explicit WorkGenerator(uint64_t threshold, size_t threadCount = 0);
+
+    /// Creates a generator using a custom backend.
+    WorkGenerator(uint64_t threshold, Work::Backend backend);
+
+    /// Cancels and waits for background generation.
+    ~WorkGenerator();
+
+    WorkGenerator(const WorkGenerator&) = delete;
+    WorkGenerator& operator=(const WorkGenerator&) = delete;
+
+    /// Starts generating the work for `root` in the background, replacing any work in progress.
+    void precompute(const Work::Root& root);
+
+    /// Returns the work for `root`: precomputed if `precompute` was called with it, generated
+    /// on the spot otherwise.  Returns nothing if cancelled.
+    std::optional<uint64_t> work(const Work::Root& root);
+
+    /// Cancels the generation in progress, from any thread.
+    void cancel() { cancelled = true; }
+
+  private:
+    uint64_t threshold;
+    Work::Backend backend;
+    std::atomic<bool> cancelled{false};
+    Work::Root pendingRoot{};
+    std::future<std::optional<uint64_t>> pending;
+
+    /// Cancels and drops the background generation.
+    void discardPending();
+};
+
+} // namespace TW::Nano
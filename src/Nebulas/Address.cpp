@@ -51,7 +51,7 @@ Address::Address(const PublicKey &publicKey) {
         throw std::invalid_argument("Nebulas::Address needs an extended SECP256k1 public key.");
     }
     const auto data = publicKey.hash(
-        {Address::AddressPrefix, Address::NormalType},
+        Data{Address::AddressPrefix, Address::NormalType},
         static_cast<Hash::HasherSimpleType>(Hash::sha3_256ripemd), false);
         
     std::copy(data.begin(), data.end(), bytes.begin());
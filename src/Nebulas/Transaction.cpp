@@ -9,6 +9,7 @@
 #include <nlohmann/json.hpp>
 #include "Transaction.h"
 #include "../HexCoding.h"
+#include "../JsonWriter.h"
 
 using namespace TW;
 using namespace TW::Nebulas;
@@ -48,18 +49,28 @@ Proto::Data* Transaction::newPayloadData(const std::string& payload){
     auto data = new Proto::Data();
     data->set_type(Transaction::TxPayloadBinaryType);
 
-    nlohmann::json payloadData;
     if(!payload.empty()) {
         auto json = nlohmann::json::parse(payload);
         if(json.find("binary")!=json.end()) {
-            std::string binary_data = json["binary"];
-            auto buff = Data(binary_data.begin(),binary_data.end());
-            payloadData["Data"]["type"] = "Buffer";
-            payloadData["Data"]["data"] = nlohmann::json(buff);
+            const std::string binary_data = json["binary"];
+            std::string payloadData;
+            JsonStringSink sink(payloadData);
+            JsonWriter<JsonStringSink> writer(sink);
+            writer.beginObject();
+            writer.key("Data");
+            writer.beginObject();
+            writer.key("data");
+            writer.beginArray();
+            for (const auto c : binary_data) {
+                writer.value(static_cast<uint8_t>(c));
+            }
+            writer.endArray();
+            writer.field("type", "Buffer");
+            writer.endObject();
+            writer.endObject();
+            data->set_payload(htmlescape(payloadData));
         }
     }
-    if(!payloadData.empty())
-        data->set_payload(htmlescape(payloadData.dump()));
     return data;
 }
 
@@ -98,6 +98,12 @@ Address::Address(const PublicKey& publicKey) {
     std::copy(hash.begin(), hash.begin() + Address::size, bytes.begin());
 }
 
+Address::Address(const std::array<uint8_t, 32>& publicKey) {
+    auto hash = std::array<uint8_t, 32>();
+    blake2b(publicKey.data(), publicKey.size(), hash.data(), hash.size());
+    std::copy(hash.begin(), hash.begin() + Address::size, bytes.begin());
+}
+
 std::string Address::string() const {
     // Identifier code + blank checksum
     std::string string = "NQ00";
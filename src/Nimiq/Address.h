@@ -39,6 +39,9 @@ class Address {
     /// Initializes an address with a public key.
     explicit Address(const PublicKey& publicKey);
 
+    /// Initializes an address with the bytes of an Ed25519 public key.
+    explicit Address(const std::array<uint8_t, 32>& publicKey);
+
     /// Returns a string representation of the address.
     std::string string() const;
 
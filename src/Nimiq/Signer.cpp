@@ -14,9 +14,8 @@ using namespace TW::Nimiq;
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto pubkey = key.getPublicKey(TWPublicKeyTypeED25519);
     std::array<uint8_t, 32> pubkeyBytes;
-    std::copy(pubkey.bytes.begin(), pubkey.bytes.end(), pubkeyBytes.data());
+    ed25519_publickey(key.bytes.data(), pubkeyBytes.data());
     auto transaction = Transaction(
         /* sender_pub_key */pubkeyBytes,
         /* destination */Address(input.destination()),
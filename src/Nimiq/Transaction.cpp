@@ -6,10 +6,7 @@
 
 #include "Transaction.h"
 
-#include "Signer.h"
 #include "../BinaryCoding.h"
-#include "../HexCoding.h"
-#include "../PublicKey.h"
 
 using namespace TW;
 using namespace TW::Nimiq;
@@ -19,6 +16,7 @@ const uint8_t EMPTY_FLAGS = 0;
 
 std::vector<uint8_t> Transaction::serialize() const {
     std::vector<uint8_t> data;
+    data.reserve(1 + sender_pub_key.size() + Address::size + 8 + 8 + 4 + 1 + signature.size());
 
     data.push_back(0x00); // Basic TX type
     data.insert(data.end(), sender_pub_key.begin(), sender_pub_key.end());
@@ -34,9 +32,10 @@ std::vector<uint8_t> Transaction::serialize() const {
 
 std::vector<uint8_t> Transaction::getPreImage() const {
     std::vector<uint8_t> data;
+    data.reserve(2 + Address::size + 1 + Address::size + 1 + 8 + 8 + 4 + 1 + 1);
 
     // Build pre-image
-    Address sender(Signer::publicKeyFromBytes(sender_pub_key));
+    Address sender(sender_pub_key);
     encode16BE(0x00, data); // Data size (+ 0 bytes of data)
     data.insert(data.end(), sender.bytes.begin(), sender.bytes.end());
     data.push_back(0); // Sender is basic account type
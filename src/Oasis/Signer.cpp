@@ -8,22 +8,19 @@
 
 #include "Signer.h"
 #include "Address.h"
+#include "../BatchSigning.h"
+
+#include <optional>
+#include <sstream>
 
 #define TRANSFER_METHOD "staking.Transfer"
 
 using namespace TW;
 using namespace TW::Oasis;
 
+namespace {
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto output = Proto::SigningOutput();
-    auto signer = Signer(input);
-    auto encoded = signer.build();
-    output.set_encoded(encoded.data(), encoded.size());
-    return output;
-}
-
-Data Signer::build() const {
+Transaction transactionFrom(const Proto::SigningInput& input) {
     // Create empty address var and check if value we want to load is valid
     Address address(input.transfer().to());
 
@@ -39,7 +36,7 @@ Data Signer::build() const {
     uint256_t gasAmount;
     gasAmountStream >> gasAmount;
 
-    Transaction transaction(
+    return Transaction(
         /* to */     address,
         /* method */ TRANSFER_METHOD,
         /* gasPrice */ input.transfer().gas_price(),
@@ -47,25 +44,79 @@ Data Signer::build() const {
         /* amount */ amount,
         /* nonce */ input.transfer().nonce(),
         /* context */ input.transfer().context());
+}
+
+Proto::SigningOutput signingOutput(const Data& encoded) {
+    auto output = Proto::SigningOutput();
+    output.set_encoded(encoded.data(), encoded.size());
+    return output;
+}
+
+} // namespace
+
+SigningContext::SigningContext(std::string context) : name(std::move(context)) {
+    hasher.update(TW::data(name));
+}
+
+Data SigningContext::hash(const Data& message) const {
+    auto copy = hasher;
+    const auto digest = copy.update(message).final();
+    return Data(digest.begin(), digest.end());
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto signer = Signer(input);
+    return signingOutput(signer.build());
+}
 
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto key = PrivateKey(inputs[begin].private_key());
+        const auto publicKey = key.getPublicKey(TWPublicKeyTypeED25519);
+        std::optional<SigningContext> context;
+        std::vector<Data> messages;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            const auto& transfer = inputs[i].transfer();
+            if (!context || context->context() != transfer.context()) {
+                context.emplace(transfer.context());
+            }
+            try {
+                messages.push_back(transactionFrom(inputs[i]).encodeMessage());
+            } catch (const std::exception&) {
+                // invalid recipient
+                messages.emplace_back();
+                outputs[i].set_error(Common::Proto::Error_general);
+            }
+            digests.push_back(context->hash(messages.back()));
+        }
+        std::vector<Data> signatures;
+        key.signBatch(digests, TWCurveED25519, signatures);
+        for (auto i = begin; i < end; ++i) {
+            if (outputs[i].error() == Common::Proto::OK) {
+                outputs[i] = signingOutput(Transaction::serialize(messages[i - begin], signatures[i - begin], publicKey));
+            }
+        }
+    });
+}
+
+Data Signer::build() const {
+    auto transaction = transactionFrom(input);
 
     auto privateKey = PrivateKey(input.private_key());
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
 
-    auto signature = sign(transaction);
-    auto encoded = transaction.serialize(signature, publicKey);
-
-    return encoded;
+    // the message is both signed and sent
+    const auto message = transaction.encodeMessage();
+    const auto signature = privateKey.sign(SigningContext(transaction.context).hash(message), TWCurveED25519);
+    return Transaction::serialize(message, signature, publicKey);
 }
 
 Data Signer::sign(Transaction& tx) const {
     auto privateKey = PrivateKey(input.private_key());
 
     // The use of this context thing is explained here --> https://docs.oasis.dev/oasis-core/common-functionality/crypto#domain-separation
-    auto encodedMessage = tx.encodeMessage().encoded();
-    Data dataToHash(tx.context.begin(), tx.context.end());
-    dataToHash.insert(dataToHash.end(), encodedMessage.begin(), encodedMessage.end());
-    auto hash = Hash::sha512_256(dataToHash);
+    auto hash = SigningContext(tx.context).hash(tx.encodeMessage());
 
     auto signature = privateKey.sign(hash, TWCurveED25519);
     return Data(signature.begin(), signature.end());
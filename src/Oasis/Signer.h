@@ -6,16 +6,37 @@
 
 #pragma once
 
+#include <string>
 #include <utility>
-
+#include <vector>
 
 #include "../Data.h"
+#include "../Hashers.h"
 #include "../PrivateKey.h"
 #include "../proto/Oasis.pb.h"
 #include "Transaction.h"
 
 namespace TW::Oasis {
 
+/// Domain separated hashing of signed messages: SHA512/256 of the chain context followed by the
+/// message, see https://docs.oasis.dev/oasis-core/common-functionality/crypto#domain-separation
+///
+/// The context is absorbed once, messages are hashed from a copy of the resulting state; a
+/// context can be kept for all the transactions of a chain.
+class SigningContext {
+public:
+    explicit SigningContext(std::string context);
+
+    const std::string& context() const { return name; }
+
+    /// Hashes a message signed under this context.
+    Data hash(const Data& message) const;
+
+private:
+    std::string name;
+    Hash::Sha512_256Hasher hasher;
+};
+
 /// Helper class that performs Oasis transaction signing.
 class Signer {
 public:
@@ -30,6 +51,11 @@ public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys). The public key is
+    /// derived once per run of inputs with the same private key, and the signing context set up once for
+    /// consecutive inputs with the same context. An invalid recipient gives Error_general.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
     /// Signs the transaction.
     ///
     /// \returns the transaction signature or an empty vector if there is an
@@ -27,32 +27,34 @@ static Data encodeVaruint(const uint256_t& value) {
     return small;
 }
 
-Cbor::Encode Transaction::encodeMessage() const {
-
-    return Cbor::Encode::map({
-        { Cbor::Encode::string("nonce"), Cbor::Encode::uint(nonce) },
-        { Cbor::Encode::string("method"), Cbor::Encode::string(method) },
-        { Cbor::Encode::string("fee"), Cbor::Encode::map({
-                 { Cbor::Encode::string("gas"), Cbor::Encode::uint(gasPrice) },
-                 { Cbor::Encode::string("amount"), Cbor::Encode::bytes(encodeVaruint(gasAmount)) }
-             })
-        },
-        { Cbor::Encode::string("body"), Cbor::Encode::map({
-                  { Cbor::Encode::string("to"), Cbor::Encode::bytes(to.getKeyHash()) },
-                  { Cbor::Encode::string("amount"), Cbor::Encode::bytes(encodeVaruint(amount)) }
-              })
-        }
-    });
+Data Transaction::encodeMessage() const {
+    Data encoded;
+    encoded.reserve(160);
+    Cbor::Writer(encoded)
+        .mapHeader(4)
+        .string("nonce").uint(nonce)
+        .string("method").string(method)
+        .string("fee").mapHeader(2)
+            .string("gas").uint(gasPrice)
+            .string("amount").bytes(encodeVaruint(gasAmount))
+        .string("body").mapHeader(2)
+            .string("to").bytes(to.getKeyHash())
+            .string("amount").bytes(encodeVaruint(amount));
+    return encoded;
 }
 
 Data Transaction::serialize(Data& signature, PublicKey& publicKey) const {
-    auto signedMessage = Cbor::Encode::map({
-            { Cbor::Encode::string("untrusted_raw_value"), Cbor::Encode::bytes(encodeMessage().encoded()) },
-            { Cbor::Encode::string("signature"), Cbor::Encode::map({
-                   { Cbor::Encode::string("public_key"), Cbor::Encode::bytes(publicKey.bytes) },
-                   { Cbor::Encode::string("signature"), Cbor::Encode::bytes(signature) }
-                })
-            }
-        });
-    return signedMessage.encoded();
+    return serialize(encodeMessage(), signature, publicKey);
+}
+
+Data Transaction::serialize(const Data& message, const Data& signature, const PublicKey& publicKey) {
+    Data encoded;
+    encoded.reserve(message.size() + 64 + publicKey.bytes.size() + signature.size());
+    Cbor::Writer(encoded)
+        .mapHeader(2)
+        .string("untrusted_raw_value").bytes(message)
+        .string("signature").mapHeader(2)
+            .string("public_key").bytes(publicKey.bytes)
+            .string("signature").bytes(signature);
+    return encoded;
 }
@@ -43,10 +43,13 @@ class Transaction {
 
   public:
     // message returns the CBOR encoding of the Message to be signed.
-    Cbor::Encode encodeMessage() const;
+    Data encodeMessage() const;
 
     // serialize returns the CBOR encoding of the SignedMessage.
     Data serialize(Data& signature, PublicKey& publicKey) const;
+
+    // serialize returns the CBOR encoding of the SignedMessage of an already encoded message.
+    static Data serialize(const Data& message, const Data& signature, const PublicKey& publicKey);
 };
 
 } // namespace TW::Oasis
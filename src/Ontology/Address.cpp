@@ -19,7 +19,7 @@ using namespace TW;
 using namespace TW::Ontology;
 
 Address::Address(const PublicKey& publicKey) {
-    std::vector<uint8_t> builder(publicKey.bytes);
+    std::vector<uint8_t> builder = publicKey.bytes.toData();
     builder.insert(builder.begin(), PUSH_BYTE_33);
     builder.push_back(CHECK_SIG);
     auto builderData = toScriptHash(builder);
@@ -6,6 +6,7 @@
 
 #include "Ong.h"
 #include "Data.h"
+#include "Ont.h"
 #include "ParamsBuilder.h"
 
 #include <list>
@@ -13,6 +14,29 @@
 using namespace TW;
 using namespace TW::Ontology;
 
+namespace {
+
+/// Invocation scripts following the params, the same for all transfers and withdrawals
+const Data& transferSuffix() {
+    static const Data suffix =
+        ParamsBuilder::buildNativeInvokeSuffix(Ong().contractAddress(), 0x00, "transfer");
+    return suffix;
+}
+
+const Data& transferFromSuffix() {
+    static const Data suffix =
+        ParamsBuilder::buildNativeInvokeSuffix(Ong().contractAddress(), 0x00, "transferFrom");
+    return suffix;
+}
+
+/// ONG is withdrawn from the ONT contract
+const Address& ontContract() {
+    static const Address address(Ont().contractAddress());
+    return address;
+}
+
+} // namespace
+
 Transaction Ong::decimals(uint32_t nonce) {
     auto builder = ParamsBuilder();
     auto invokeCode =
@@ -34,12 +58,8 @@ Transaction Ong::balanceOf(const Address &address, uint32_t nonce) {
 Transaction Ong::transfer(const Signer &from, const Address &to, uint64_t amount,
                           const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
                           uint32_t nonce) {
-    std::list<boost::any> transferParam{from.getAddress().data, to.data, amount};
-    std::vector<boost::any> args{transferParam};
-    auto invokeCode =
-        ParamsBuilder::buildNativeInvokeCode(contractAddress(), 0x00, "transfer", args);
-    auto tx = Transaction(version, txType, nonce, gasPrice, gasLimit, payer.getAddress().string(),
-                          invokeCode);
+    auto tx = unsignedTransfer(from.getAddress(), to, amount, payer.getAddress(), gasPrice,
+                               gasLimit, nonce);
     from.sign(tx);
     payer.addSign(tx);
     return tx;
@@ -48,13 +68,25 @@ Transaction Ong::transfer(const Signer &from, const Address &to, uint64_t amount
 Transaction Ong::withdraw(const Signer &claimer, const Address &receiver, uint64_t amount,
                           const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
                           uint32_t nonce) {
-    auto ontContract = Address("AFmseVrdL9f9oyCzZefL9tG6UbvhUMqNMV");
-    std::list<boost::any> args{claimer.getAddress().data, ontContract.data, receiver.data, amount};
-    auto invokeCode =
-        ParamsBuilder::buildNativeInvokeCode(contractAddress(), 0x00, "transferFrom", args);
-    auto tx = Transaction(version, txType, nonce, gasPrice, gasLimit, payer.getAddress().string(),
-                          invokeCode);
+    auto tx = unsignedWithdraw(claimer.getAddress(), receiver, amount, payer.getAddress(),
+                               gasPrice, gasLimit, nonce);
     claimer.sign(tx);
     payer.addSign(tx);
     return tx;
+}
+
+Transaction Ong::unsignedTransfer(const Address &from, const Address &to, uint64_t amount,
+                                  const Address &payer, uint64_t gasPrice, uint64_t gasLimit,
+                                  uint32_t nonce) {
+    auto invokeCode =
+        ParamsBuilder::buildTransferInvokeCode(transferSuffix(), from.data, to.data, amount);
+    return Transaction(version, txType, nonce, gasPrice, gasLimit, payer, std::move(invokeCode));
+}
+
+Transaction Ong::unsignedWithdraw(const Address &claimer, const Address &receiver, uint64_t amount,
+                                  const Address &payer, uint64_t gasPrice, uint64_t gasLimit,
+                                  uint32_t nonce) {
+    auto invokeCode = ParamsBuilder::buildTransferFromInvokeCode(
+        transferFromSuffix(), claimer.data, ontContract().data, receiver.data, amount);
+    return Transaction(version, txType, nonce, gasPrice, gasLimit, payer, std::move(invokeCode));
 }
\ No newline at end of file
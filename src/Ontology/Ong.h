@@ -31,6 +31,16 @@ class Ong : public Asset {
 
     Transaction withdraw(const Signer &claimer, const Address &receiver, uint64_t amount,
                          const Signer &payer, uint64_t gasPrice, uint64_t gasLimit, uint32_t nonce);
+
+    /// Returns the transfer transaction, not signed yet.
+    Transaction unsignedTransfer(const Address &from, const Address &to, uint64_t amount,
+                                 const Address &payer, uint64_t gasPrice, uint64_t gasLimit,
+                                 uint32_t nonce);
+
+    /// Returns the withdraw transaction, not signed yet.
+    Transaction unsignedWithdraw(const Address &claimer, const Address &receiver, uint64_t amount,
+                                 const Address &payer, uint64_t gasPrice, uint64_t gasLimit,
+                                 uint32_t nonce);
 };
 
 } // namespace TW::Ontology
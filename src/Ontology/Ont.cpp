@@ -13,6 +13,17 @@
 using namespace TW;
 using namespace TW::Ontology;
 
+namespace {
+
+/// Invocation script of `transfer` following its params, the same for all transfers
+const Data& transferSuffix() {
+    static const Data suffix =
+        ParamsBuilder::buildNativeInvokeSuffix(Ont().contractAddress(), 0x00, "transfer");
+    return suffix;
+}
+
+} // namespace
+
 Transaction Ont::decimals(uint32_t nonce) {
     auto builder = ParamsBuilder();
     auto invokeCode =
@@ -34,13 +45,17 @@ Transaction Ont::balanceOf(const Address &address, uint32_t nonce) {
 Transaction Ont::transfer(const Signer &from, const Address &to, uint64_t amount,
                           const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
                           uint32_t nonce) {
-    std::list<boost::any> transferParam{from.getAddress().data, to.data, amount};
-    std::vector<boost::any> args{transferParam};
-    auto invokeCode =
-        ParamsBuilder::buildNativeInvokeCode(contractAddress(), 0x00, "transfer", args);
-    auto tx = Transaction(version, txType, nonce, gasPrice, gasLimit,
-                          payer.getAddress().string(), invokeCode);
+    auto tx = unsignedTransfer(from.getAddress(), to, amount, payer.getAddress(), gasPrice,
+                               gasLimit, nonce);
     from.sign(tx);
     payer.addSign(tx);
     return tx;
 }
+
+Transaction Ont::unsignedTransfer(const Address &from, const Address &to, uint64_t amount,
+                                  const Address &payer, uint64_t gasPrice, uint64_t gasLimit,
+                                  uint32_t nonce) {
+    auto invokeCode =
+        ParamsBuilder::buildTransferInvokeCode(transferSuffix(), from.data, to.data, amount);
+    return Transaction(version, txType, nonce, gasPrice, gasLimit, payer, std::move(invokeCode));
+}
@@ -28,6 +28,11 @@ class Ont : public Asset {
     Transaction transfer(const Signer &from, const Address &to, uint64_t amount,
                          const Signer &payer, uint64_t gasPrice, uint64_t gasLimit,
                          uint32_t nonce) override;
+
+    /// Returns the transfer transaction, not signed yet.
+    Transaction unsignedTransfer(const Address &from, const Address &to, uint64_t amount,
+                                 const Address &payer, uint64_t gasPrice, uint64_t gasLimit,
+                                 uint32_t nonce);
 };
 
 } // namespace TW::Ontology
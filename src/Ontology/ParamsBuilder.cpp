@@ -12,6 +12,7 @@
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/nist256p1.h>
 
+#include <algorithm>
 #include <list>
 
 using namespace TW;
@@ -82,15 +83,18 @@ void ParamsBuilder::pushVar(std::size_t value) {
 }
 
 void ParamsBuilder::push(const std::string& data) {
-    push(Data(data.begin(), data.end()));
+    pushData(reinterpret_cast<const uint8_t*>(data.data()), data.size());
 }
 
 void ParamsBuilder::push(const std::array<uint8_t, 20>& data) {
-    push(Data(data.begin(), data.end()));
+    pushData(data.data(), data.size());
 }
 
 void ParamsBuilder::push(const Data& data) {
-    auto dataSize = data.size();
+    pushData(data.data(), data.size());
+}
+
+void ParamsBuilder::pushData(const uint8_t* data, std::size_t dataSize) {
     if (dataSize < 75) {
         bytes.push_back(static_cast<uint8_t>(dataSize));
     } else if (dataSize < 256) {
@@ -103,19 +107,20 @@ void ParamsBuilder::push(const Data& data) {
         bytes.push_back(PUSH_DATA4);
         encode32LE(static_cast<uint16_t>(dataSize), bytes);
     }
-    bytes.insert(bytes.end(), data.begin(), data.end());
+    bytes.insert(bytes.end(), data, data + dataSize);
 }
 
 void ParamsBuilder::push(uint64_t num, uint8_t len) {
-    Data data;
+    std::array<uint8_t, 9> data;
+    std::size_t size = 0;
     for (auto i = 0; i < len; i++) {
-        data.push_back(static_cast<uint8_t>(num));
+        data[size++] = static_cast<uint8_t>(num);
         num >>= 8;
     }
-    if (data.back() >> 7 == 1) {
-        data.push_back(0x00);
+    if (data[size - 1] >> 7 == 1) {
+        data[size++] = 0x00;
     }
-    push(data);
+    pushData(data.data(), size);
 }
 
 void ParamsBuilder::push(uint64_t num) {
@@ -125,7 +130,8 @@ void ParamsBuilder::push(uint64_t num) {
         num += 80;
         bytes.push_back(static_cast<uint8_t>(num));
     } else if (num < 128) {
-        push(Data{static_cast<uint8_t>(num)});
+        const auto byte = static_cast<uint8_t>(num);
+        pushData(&byte, 1);
     } else if (num <= 0xFFFF) {
         push(num, 2);
     } else if (num <= 0xFFFFFF) {
@@ -170,25 +176,36 @@ void ParamsBuilder::push(uint8_t num) {
         num += 80;
         bytes.push_back(static_cast<uint8_t>(num));
     } else if (num < 128) {
-        push(Data{num});
+        pushData(&num, 1);
     } else {
-        push(Data{num, PUSH0});
+        const uint8_t data[] = {num, PUSH0};
+        pushData(data, sizeof(data));
     }
 }
 
+void ParamsBuilder::pushStructField() {
+    bytes.push_back(DUP_FROM_ALT_STACK);
+    bytes.push_back(SWAP);
+    bytes.push_back(HAS_KEY);
+}
+
 Data ParamsBuilder::fromSigs(const std::vector<Data>& sigs) {
-    ParamsBuilder builder;
+    std::size_t size = 0;
+    for (auto const& sig : sigs) {
+        size += sig.size() + 5;
+    }
+    ParamsBuilder builder(size);
     for (auto const& sig : sigs) {
         builder.push(sig);
     }
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 Data ParamsBuilder::fromPubkey(const Data& publicKey) {
-    ParamsBuilder builder;
+    ParamsBuilder builder(publicKey.size() + 6);
     builder.push(publicKey);
     builder.pushBack(CHECK_SIG);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 Data ParamsBuilder::fromMultiPubkey(uint8_t m, const std::vector<Data>& pubKeys) {
@@ -198,25 +215,32 @@ Data ParamsBuilder::fromMultiPubkey(uint8_t m, const std::vector<Data>& pubKeys)
     if (pubKeys.size() > MAX_PK_SIZE) {
         throw std::runtime_error("Too many public key found.");
     }
-    ParamsBuilder builder;
-    builder.push(m);
-    auto sortedPubKeys = pubKeys;
-    std::sort(sortedPubKeys.begin(), sortedPubKeys.end(), [](Data& o1, Data& o2) -> int {
-        curve_point p1, p2;
-        ecdsa_read_pubkey(&nist256p1, o1.data(), &p1);
-        ecdsa_read_pubkey(&nist256p1, o2.data(), &p2);
-        auto result = bn_is_less(&p1.x, &p2.x);
-        if (result != 0) {
-            return result;
+    // Keys are sorted by point, x then y; each key is decoded once, not on every comparison
+    std::vector<std::pair<std::array<uint8_t, 64>, const Data*>> sortedPubKeys;
+    sortedPubKeys.reserve(pubKeys.size());
+    std::size_t size = 3;
+    for (auto const& pk : pubKeys) {
+        curve_point point;
+        if ((pk.size() != 33 && pk.size() != 65) ||
+            ecdsa_read_pubkey(&nist256p1, pk.data(), &point) == 0) {
+            throw std::runtime_error("Invalid public key.");
         }
-        return bn_is_less(&p1.y, &p2.y);
-    });
+        std::array<uint8_t, 64> coordinates;
+        bn_write_be(&point.x, coordinates.data());
+        bn_write_be(&point.y, coordinates.data() + 32);
+        sortedPubKeys.emplace_back(coordinates, &pk);
+        size += pk.size() + 1;
+    }
+    std::sort(sortedPubKeys.begin(), sortedPubKeys.end(),
+              [](const auto& o1, const auto& o2) { return o1.first < o2.first; });
+    ParamsBuilder builder(size);
+    builder.push(m);
     for (auto const& pk : sortedPubKeys) {
-        builder.push(pk);
+        builder.push(*pk.second);
     }
     builder.push((uint8_t)sortedPubKeys.size());
     builder.pushBack(CHECK_MULTI_SIG);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 Data ParamsBuilder::buildNativeInvokeCode(const Data& contractAddress, uint8_t version,
@@ -229,5 +253,57 @@ Data ParamsBuilder::buildNativeInvokeCode(const Data& contractAddress, uint8_t v
     builder.pushBack(SYS_CALL);
     std::string nativeInvoke = "Ontology.Native.Invoke";
     builder.push(Data(nativeInvoke.begin(), nativeInvoke.end()));
-    return builder.getBytes();
+    return builder.takeBytes();
+}
+
+Data ParamsBuilder::buildNativeInvokeSuffix(const Data& contractAddress, uint8_t version,
+                                            const std::string& method) {
+    ParamsBuilder builder;
+    builder.push(method);
+    builder.push(contractAddress);
+    builder.push(version);
+    builder.pushBack(SYS_CALL);
+    builder.push(std::string("Ontology.Native.Invoke"));
+    return builder.takeBytes();
+}
+
+Data ParamsBuilder::buildTransferInvokeCode(const Data& suffix, const std::array<uint8_t, 20>& from,
+                                            const std::array<uint8_t, 20>& to, uint64_t amount) {
+    // struct header and footer, two addresses, an amount of up to 9 bytes, the array
+    ParamsBuilder builder(4 + 2 * 24 + 13 + 2 + suffix.size());
+    builder.pushBack(PUSH0);
+    builder.pushBack(NEW_STRUCT);
+    builder.pushBack(TO_ALT_STACK);
+    builder.push(from);
+    builder.pushStructField();
+    builder.push(to);
+    builder.pushStructField();
+    builder.push(amount);
+    builder.pushStructField();
+    builder.pushBack(FROM_ALT_STACK);
+    builder.push(static_cast<uint8_t>(1));
+    builder.pushBack(PACK);
+    builder.pushBack(suffix);
+    return builder.takeBytes();
+}
+
+Data ParamsBuilder::buildTransferFromInvokeCode(const Data& suffix,
+                                                const std::array<uint8_t, 20>& sender,
+                                                const std::array<uint8_t, 20>& from,
+                                                const std::array<uint8_t, 20>& to, uint64_t amount) {
+    ParamsBuilder builder(4 + 3 * 24 + 13 + suffix.size());
+    builder.pushBack(PUSH0);
+    builder.pushBack(NEW_STRUCT);
+    builder.pushBack(TO_ALT_STACK);
+    builder.push(sender);
+    builder.pushStructField();
+    builder.push(from);
+    builder.pushStructField();
+    builder.push(to);
+    builder.pushStructField();
+    builder.push(amount);
+    builder.pushStructField();
+    builder.pushBack(FROM_ALT_STACK);
+    builder.pushBack(suffix);
+    return builder.takeBytes();
 }
\ No newline at end of file
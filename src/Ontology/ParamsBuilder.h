@@ -23,10 +23,29 @@ class ParamsBuilder {
   private:
     std::vector<uint8_t> bytes;
 
+    void pushData(const uint8_t* data, std::size_t size);
+
+    /// Appends a struct field: the value pushed by the caller, then the opcodes adding it to the struct
+    void pushStructField();
+
   public:
     static const size_t MAX_PK_SIZE = 16;
 
-    std::vector<uint8_t> getBytes() { return bytes; }
+    ParamsBuilder() = default;
+
+    /// Reserves `capacity` bytes for the script.
+    explicit ParamsBuilder(std::size_t capacity) { bytes.reserve(capacity); }
+
+    std::vector<uint8_t> getBytes() const { return bytes; }
+
+    /// Moves the script out of the builder, leaving it empty.
+    std::vector<uint8_t> takeBytes() {
+        std::vector<uint8_t> result;
+        result.swap(bytes);
+        return result;
+    }
+
+    void reserve(std::size_t capacity) { bytes.reserve(bytes.size() + capacity); }
 
     void cleanUp() { bytes.clear(); }
 
@@ -78,6 +97,22 @@ class ParamsBuilder {
     static std::vector<uint8_t> buildNativeInvokeCode(const std::vector<uint8_t>& contractAddress,
                                                       uint8_t version, const std::string& method,
                                                       const boost::any& params);
+
+    /// Returns the part of buildNativeInvokeCode following the params: method, contract, version and
+    /// syscall. It only depends on the invoked method, and is computed once per method by callers.
+    static Data buildNativeInvokeSuffix(const Data& contractAddress, uint8_t version,
+                                        const std::string& method);
+
+    /// Same as buildNativeInvokeCode with params `[{from, to, amount}]` (native `transfer`), given
+    /// the suffix of the method.
+    static Data buildTransferInvokeCode(const Data& suffix, const std::array<uint8_t, 20>& from,
+                                        const std::array<uint8_t, 20>& to, uint64_t amount);
+
+    /// Same as buildNativeInvokeCode with params `{sender, from, to, amount}` (native
+    /// `transferFrom`), given the suffix of the method.
+    static Data buildTransferFromInvokeCode(const Data& suffix, const std::array<uint8_t, 20>& sender,
+                                            const std::array<uint8_t, 20>& from,
+                                            const std::array<uint8_t, 20>& to, uint64_t amount);
 };
 
 } // namespace TW::Ontology
\ No newline at end of file
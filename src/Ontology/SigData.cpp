@@ -23,8 +23,8 @@ Data SigData::serialize() {
     } else {
         verifyInfo = ParamsBuilder::fromMultiPubkey(m, pubKeys);
     }
-    ParamsBuilder builder;
+    ParamsBuilder builder(sigInfo.size() + verifyInfo.size() + 2 * 9);
     builder.pushVar(sigInfo);
     builder.pushVar(verifyInfo);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
@@ -1,70 +1,148 @@
-// Copyright © 2017-2020 Trust Wallet.
-//
-// This file is part of Trust. The full Trust copyright notice, including
-// terms governing use, modification, and redistribution, is contained in the
-// file LICENSE at the root of the source code distribution tree.
-
-#include "Signer.h"
-#include "HexCoding.h"
-#include "SigData.h"
-#include "../Ontology/OngTxBuilder.h"
-#include "../Ontology/OntTxBuilder.h"
-
-#include "../Hash.h"
-
-#include <stdexcept>
-
-using namespace TW;
-using namespace TW::Ontology;
-
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto contract = std::string(input.contract().begin(), input.contract().end());
-    auto output = Proto::SigningOutput();
-    try {
-        if (contract == "ONT") {
-            auto encoded = OntTxBuilder::build(input);
-            output.set_encoded(encoded.data(), encoded.size());
-        } else if (contract == "ONG") {
-            auto encoded = OngTxBuilder::build(input);
-            output.set_encoded(encoded.data(), encoded.size());
-        }
-    } catch (...) {
-    }
-    return output;
-}
-
-Signer::Signer(TW::PrivateKey priKey) : privateKey(std::move(priKey)) {
-    auto pubKey = privateKey.getPublicKey(TWPublicKeyTypeNIST256p1);
-    publicKey = pubKey.bytes;
-    address = Address(pubKey).string();
-}
-
-PrivateKey Signer::getPrivateKey() const {
-    return privateKey;
-}
-
-PublicKey Signer::getPublicKey() const {
-    return PublicKey(publicKey, TWPublicKeyTypeNIST256p1);
-}
-
-Address Signer::getAddress() const {
-    return Address(address);
-}
-
-void Signer::sign(Transaction& tx) const {
-    if (tx.sigVec.size() >= Transaction::sigVecLimit) {
-        throw std::runtime_error("the number of transaction signatures should not be over 16.");
-    }
-    auto signature = getPrivateKey().sign(Hash::sha256(tx.txHash()), TWCurveNIST256p1);
-    signature.pop_back();
-    tx.sigVec.emplace_back(publicKey, signature, 1);
-}
-
-void Signer::addSign(Transaction& tx) const {
-    if (tx.sigVec.size() >= Transaction::sigVecLimit) {
-        throw std::runtime_error("the number of transaction signatures should not be over 16.");
-    }
-    auto signature = getPrivateKey().sign(Hash::sha256(tx.txHash()), TWCurveNIST256p1);
-    signature.pop_back();
-    tx.sigVec.emplace_back(publicKey, signature, 1);
-}
+// Copyright © 2017-2020 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Signer.h"
+#include "HexCoding.h"
+#include "SigData.h"
+#include "Ong.h"
+#include "Ont.h"
+#include "../Ontology/OngTxBuilder.h"
+#include "../Ontology/OntTxBuilder.h"
+
+#include "../Hash.h"
+#include "../BatchSigning.h"
+
+#include <optional>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::Ontology;
+
+/// Whether the input is a transfer or withdrawal, signed by signBatch() with the shared key state
+static bool isBatchTransfer(const Proto::SigningInput& input) {
+    if (input.contract() == "ONT") {
+        return input.method() == "transfer";
+    }
+    return input.contract() == "ONG" && (input.method() == "transfer" || input.method() == "withdraw");
+}
+
+/// Same transaction as built by OntTxBuilder and OngTxBuilder, not signed yet
+static Transaction unsignedTransfer(const Proto::SigningInput& input, const Address& owner, const Address& payer) {
+    auto toAddress = Address(input.to_address());
+    if (input.contract() == "ONT") {
+        return Ont().unsignedTransfer(owner, toAddress, input.amount(), payer, input.gas_price(), input.gas_limit(), input.nonce());
+    }
+    if (input.method() == "transfer") {
+        return Ong().unsignedTransfer(owner, toAddress, input.amount(), payer, input.gas_price(), input.gas_limit(), input.nonce());
+    }
+    return Ong().unsignedWithdraw(owner, toAddress, input.amount(), payer, input.gas_price(), input.gas_limit(), input.nonce());
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto contract = std::string(input.contract().begin(), input.contract().end());
+    auto output = Proto::SigningOutput();
+    try {
+        if (contract == "ONT") {
+            auto encoded = OntTxBuilder::build(input);
+            output.set_encoded(encoded.data(), encoded.size());
+        } else if (contract == "ONG") {
+            auto encoded = OngTxBuilder::build(input);
+            output.set_encoded(encoded.data(), encoded.size());
+        }
+    } catch (...) {
+    }
+    return output;
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    // other operations are runs of their own, signed by sign()
+    const auto sameRun = [](const auto& first, const auto& input) {
+        return isBatchTransfer(first) && isBatchTransfer(input) && input.owner_private_key() == first.owner_private_key() &&
+               input.payer_private_key() == first.payer_private_key();
+    };
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, sameRun, [&](size_t begin, size_t end, auto& outputs) {
+        if (!isBatchTransfer(inputs[begin])) {
+            outputs[begin] = sign(inputs[begin]);
+            return;
+        }
+        const auto& ownerKey = inputs[begin].owner_private_key();
+        const auto& payerKey = inputs[begin].payer_private_key();
+        const auto payer = Signer(PrivateKey(Data(payerKey.begin(), payerKey.end())));
+        const auto owner = Signer(PrivateKey(Data(ownerKey.begin(), ownerKey.end())));
+        std::vector<std::optional<Transaction>> transactions;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            try {
+                transactions.emplace_back(unsignedTransfer(inputs[i], owner.address, payer.address));
+                digests.push_back(Hash::sha256(transactions.back()->txHash()));
+            } catch (const std::exception&) {
+                // invalid recipient
+                transactions.emplace_back();
+                digests.push_back(Data(32));
+                outputs[i].set_error(Common::Proto::Error_general);
+            }
+        }
+        std::vector<Data> ownerSignatures;
+        std::vector<Data> payerSignatures;
+        owner.privateKey.signBatch(digests, TWCurveNIST256p1, ownerSignatures);
+        // signatures are deterministic: a payer with the owner key signs the same
+        const auto samePayer = ownerKey == payerKey;
+        if (!samePayer) {
+            payer.privateKey.signBatch(digests, TWCurveNIST256p1, payerSignatures);
+        }
+        const auto& payerSigned = samePayer ? ownerSignatures : payerSignatures;
+        for (auto i = begin; i < end; ++i) {
+            auto& transaction = transactions[i - begin];
+            if (!transaction) {
+                continue;
+            }
+            try {
+                owner.addSignature(*transaction, ownerSignatures[i - begin]);
+                payer.addSignature(*transaction, payerSigned[i - begin]);
+                const auto encoded = transaction->serialize();
+                outputs[i].set_encoded(encoded.data(), encoded.size());
+            } catch (const std::exception&) {
+                outputs[i].set_error(Common::Proto::Error_signing);
+            }
+        }
+    });
+}
+
+Signer::Signer(TW::PrivateKey priKey)
+    : privateKey(std::move(priKey))
+    , publicKey(privateKey.getPublicKey(TWPublicKeyTypeNIST256p1).bytes.toData())
+    , address(getPublicKey()) {}
+
+PrivateKey Signer::getPrivateKey() const {
+    return privateKey;
+}
+
+PublicKey Signer::getPublicKey() const {
+    return PublicKey(publicKey, TWPublicKeyTypeNIST256p1);
+}
+
+Address Signer::getAddress() const {
+    return address;
+}
+
+void Signer::sign(Transaction& tx) const {
+    addSignature(tx, privateKey.sign(Hash::sha256(tx.txHash()), TWCurveNIST256p1));
+}
+
+void Signer::addSign(Transaction& tx) const {
+    addSignature(tx, privateKey.sign(Hash::sha256(tx.txHash()), TWCurveNIST256p1));
+}
+
+void Signer::addSignature(Transaction& tx, const Data& signature) const {
+    if (tx.sigVec.size() >= Transaction::sigVecLimit) {
+        throw std::runtime_error("the number of transaction signatures should not be over 16.");
+    }
+    if (signature.empty()) {
+        throw std::runtime_error("Failed to sign transaction.");
+    }
+    // without the recovery id
+    tx.sigVec.emplace_back(publicKey, Data(signature.begin(), signature.end() - 1), 1);
+}
@@ -22,10 +22,20 @@ class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs many transactions, same as calling sign() on each of them. ONT and ONG transfers and
+    /// ONG withdrawals of runs of inputs with the same owner and payer keys share the key state:
+    /// owner and payer are derived once, and signatures are computed together. See signInRuns()
+    /// for the threads and invalid keys; an invalid recipient gives Error_general.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
   private:
-    Data publicKey;
     TW::PrivateKey privateKey;
-    std::string address;
+    Data publicKey;
+    Address address;
+
+    /// Appends a signature of the transaction hash, as computed by sign()
+    void addSignature(Transaction& tx, const Data& signature) const;
 
   public:
     explicit Signer(TW::PrivateKey priKey);
@@ -19,32 +19,29 @@ using namespace TW::Ontology;
 const std::string Transaction::ZERO_PAYER = "AFmseVrdL9f9oyCzZefL9tG6UbvhPbdYzM";
 
 std::vector<uint8_t> Transaction::serializeUnsigned() {
-    ParamsBuilder builder;
+    // fixed fields, payer, payload with its length, attributes
+    ParamsBuilder builder(2 + 4 + 8 + 8 + Address::size + 9 + payload.size() + 1);
     builder.pushBack(version);
     builder.pushBack(txType);
     builder.pushBack(nonce);
     builder.pushBack(gasPrice);
     builder.pushBack(gasLimit);
-    builder.pushBack(Address(payer).data);
+    builder.pushBack(payer.data);
     if (!payload.empty()) {
         builder.pushVar(payload);
     }
     builder.pushBack((uint8_t)0x00);
-    return builder.getBytes();
+    return builder.takeBytes();
 }
 
 std::vector<uint8_t> Transaction::serialize() {
-    std::vector<uint8_t> txData;
-    auto unsignedData = serializeUnsigned();
-    txData.insert(txData.end(), unsignedData.begin(), unsignedData.end());
     ParamsBuilder builder;
+    builder.pushBack(serializeUnsigned());
     builder.pushVar(sigVec.size());
-    for (auto sig : sigVec) {
+    for (auto& sig : sigVec) {
         builder.pushBack(sig.serialize());
     }
-    auto sigData = builder.getBytes();
-    txData.insert(txData.end(), sigData.begin(), sigData.end());
-    return txData;
+    return builder.takeBytes();
 }
 
 std::vector<uint8_t> Transaction::txHash() {
@@ -54,7 +51,7 @@ std::vector<uint8_t> Transaction::txHash() {
 
 std::vector<uint8_t> Transaction::serialize(const PublicKey& pk) {
     ParamsBuilder builder;
-    builder.push(pk.bytes);
+    builder.push(pk.bytes.toData());
     builder.pushBack((uint8_t)0xAC);
     return builder.getBytes();
 }
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "Address.h"
 #include "PublicKey.h"
 #include "SigData.h"
 #include "../PublicKey.h"
@@ -27,7 +28,7 @@ class Transaction {
 
     uint64_t gasLimit;
 
-    std::string payer;
+    Address payer;
 
     std::vector<uint8_t> payload;
 
@@ -47,12 +48,18 @@ class Transaction {
         , nonce(nonce)
         , gasPrice(gasPrice)
         , gasLimit(gasLimit)
-        , payload(std::move(payload)) {
-        if (payer.empty()) {
-            payer = ZERO_PAYER;
-        }
-        this->payer = payer;
-    }
+        , payer(payer.empty() ? ZERO_PAYER : payer)
+        , payload(std::move(payload)) {}
+
+    Transaction(uint8_t ver, uint8_t type, uint32_t nonce, uint64_t gasPrice, uint64_t gasLimit,
+                const Address& payer, std::vector<uint8_t> payload)
+        : version(ver)
+        , txType(type)
+        , nonce(nonce)
+        , gasPrice(gasPrice)
+        , gasLimit(gasLimit)
+        , payer(payer)
+        , payload(std::move(payload)) {}
 
     std::vector<uint8_t> serializeUnsigned();
 
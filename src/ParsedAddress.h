@@ -0,0 +1,25 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <string>
+
+namespace TW {
+
+/// An address validated, normalized and decoded at once, for callers using the same address several times.
+struct ParsedAddress {
+    /// String form, as returned by normalizeAddress.
+    std::string normalized;
+    /// Decoded address, as returned by TWAnyAddressData; only set by coins that decode it while validating.
+    Data data;
+    /// Whether `data` is set, it may be empty for addresses without data.
+    bool hasData = false;
+};
+
+} // namespace TW
@@ -5,7 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Extrinsic.h"
+#include "../Hash.h"
 #include <TrustWalletCore/TWSS58AddressType.h>
+#include <TrezorCrypto/blake2b.h>
 #include <map>
 
 using namespace TW;
@@ -26,35 +28,41 @@ static const std::string stakingWithdrawUnbond = "Staking.withdraw_unbonded";
 static const std::string stakingNominate = "Staking.nominate";
 static const std::string stakingChill = "Staking.chill";
 
-// Readable decoded call index can be found from https://polkascan.io
-static std::map<const std::string, Data> polkadotCallIndices = {
-    {balanceTransfer,       Data{0x05, 0x00}},
-    {stakingBond,           Data{0x07, 0x00}},
-    {stakingBondExtra,      Data{0x07, 0x01}},
-    {stakingUnbond,         Data{0x07, 0x02}},
-    {stakingWithdrawUnbond, Data{0x07, 0x03}},
-    {stakingNominate,       Data{0x07, 0x05}},
-    {stakingChill,          Data{0x07, 0x06}},
-    {utilityBatch,          Data{0x1a, 0x02}},
-};
-
-static std::map<const std::string, Data> kusamaCallIndices = {
-    {balanceTransfer,       Data{0x04, 0x00}},
-    {stakingBond,           Data{0x06, 0x00}},
-    {stakingBondExtra,      Data{0x06, 0x01}},
-    {stakingUnbond,         Data{0x06, 0x02}},
-    {stakingWithdrawUnbond, Data{0x06, 0x03}},
-    {stakingNominate,       Data{0x06, 0x05}},
-    {stakingChill,          Data{0x06, 0x06}},
-    {utilityBatch,          Data{0x18, 0x02}},
-};
-
 static Data getCallIndex(TWSS58AddressType network, const std::string& key) {
+    // Readable decoded call index can be found from https://polkascan.io
+    // (built on first use rather than when the library is loaded)
+    static const std::map<const std::string, Data> polkadotCallIndices = {
+        {balanceTransfer,       Data{0x05, 0x00}},
+        {stakingBond,           Data{0x07, 0x00}},
+        {stakingBondExtra,      Data{0x07, 0x01}},
+        {stakingUnbond,         Data{0x07, 0x02}},
+        {stakingWithdrawUnbond, Data{0x07, 0x03}},
+        {stakingNominate,       Data{0x07, 0x05}},
+        {stakingChill,          Data{0x07, 0x06}},
+        {utilityBatch,          Data{0x1a, 0x02}},
+    };
+    static const std::map<const std::string, Data> kusamaCallIndices = {
+        {balanceTransfer,       Data{0x04, 0x00}},
+        {stakingBond,           Data{0x06, 0x00}},
+        {stakingBondExtra,      Data{0x06, 0x01}},
+        {stakingUnbond,         Data{0x06, 0x02}},
+        {stakingWithdrawUnbond, Data{0x06, 0x03}},
+        {stakingNominate,       Data{0x06, 0x05}},
+        {stakingChill,          Data{0x06, 0x06}},
+        {utilityBatch,          Data{0x18, 0x02}},
+    };
+
+    // lookups don't insert, signing may run on several threads
+    const auto find = [&key](const std::map<const std::string, Data>& indices) {
+        const auto it = indices.find(key);
+        return it != indices.end() ? it->second : Data();
+    };
+
     switch (network) {
     case TWSS58AddressTypePolkadot:
-        return polkadotCallIndices[key];
+        return find(polkadotCallIndices);
     case TWSS58AddressTypeKusama:
-        return kusamaCallIndices[key];
+        return find(kusamaCallIndices);
     }
 }
 
@@ -66,15 +74,17 @@ bool Extrinsic::encodeRawAccount(TWSS58AddressType network, uint32_t specVersion
     return true;
 }
 
-Data Extrinsic::encodeEraNonceTip() const {
-    Data data;
+size_t Extrinsic::eraNonceTipSize() const {
+    return era.size() + compactSize(nonce) + compactSize(tip);
+}
+
+void Extrinsic::writeEraNonceTip(ScaleWriter& writer) const {
     // era
-    append(data, era);
+    writer.writeBytes(era);
     // nonce
-    append(data, encodeCompact(nonce));
+    writer.writeCompact(nonce);
     // tip
-    append(data, encodeCompact(tip));
-    return data;
+    writer.writeCompact(tip);
 }
 
 Data Extrinsic::encodeCall(const Proto::SigningInput& input) {
@@ -105,8 +115,13 @@ Data Extrinsic::encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressTy
 
 Data Extrinsic::encodeBatchCall(const std::vector<Data>& calls, TWSS58AddressType network) {
     Data data;
-    append(data, getCallIndex(network, utilityBatch));
-    append(data, encodeVector(calls));
+    const auto callIndex = getCallIndex(network, utilityBatch);
+    auto writer = ScaleWriter(data, callIndex.size() + vectorSize(calls));
+    writer.writeBytes(callIndex);
+    writer.writeCompact(calls.size());
+    for (const auto& call : calls) {
+        writer.writeBytes(call);
+    }
     return data;
 }
 
@@ -216,36 +231,110 @@ Data Extrinsic::encodeStakingCall(const Proto::Staking& staking, TWSS58AddressTy
 
 Data Extrinsic::encodePayload() const {
     Data data;
+    auto writer = ScaleWriter(data, call.size() + eraNonceTipSize() + 8 + genesisHash.size() + blockHash.size());
     // call
-    append(data, call);
+    writer.writeBytes(call);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    writeEraNonceTip(writer);
+    // specVersion
+    writer.write32LE(specVersion);
+    // transactionVersion
+    writer.write32LE(version);
+    // genesis hash
+    writer.writeBytes(genesisHash);
+    // block hash
+    writer.writeBytes(blockHash);
+    return data;
+}
+
+Data Extrinsic::encodePayloadSuffix() const {
+    Data data;
+    auto writer = ScaleWriter(data, 8 + genesisHash.size() + blockHash.size());
     // specVersion
-    encode32LE(specVersion, data);
+    writer.write32LE(specVersion);
     // transactionVersion
-    encode32LE(version, data);
+    writer.write32LE(version);
     // genesis hash
-    append(data, genesisHash);
+    writer.writeBytes(genesisHash);
     // block hash
-    append(data, blockHash);
+    writer.writeBytes(blockHash);
     return data;
 }
 
+Data Extrinsic::encodePayload(const Data& suffix, size_t hashThreshold) const {
+    const auto size = call.size() + eraNonceTipSize() + suffix.size();
+    Data eraNonceTip;
+    auto eraNonceTipWriter = ScaleWriter(eraNonceTip, eraNonceTipSize());
+    writeEraNonceTip(eraNonceTipWriter);
+    if (size <= hashThreshold) {
+        Data data;
+        auto writer = ScaleWriter(data, size);
+        writer.writeBytes(call);
+        writer.writeBytes(eraNonceTip);
+        writer.writeBytes(suffix);
+        return data;
+    }
+    blake2b_state state;
+    blake2b_Init(&state, Hash::sha256Size);
+    blake2b_Update(&state, call.data(), call.size());
+    blake2b_Update(&state, eraNonceTip.data(), eraNonceTip.size());
+    blake2b_Update(&state, suffix.data(), suffix.size());
+    Data hash(Hash::sha256Size);
+    blake2b_Final(&state, hash.data(), hash.size());
+    return hash;
+}
+
 Data Extrinsic::encodeSignature(const PublicKey& signer, const Data& signature) const {
+    const auto raw = encodeRawAccount(network, specVersion);
+    const size_t length = 1 + accountIdSize(signer.bytes.size(), raw) + 1 + signature.size() + eraNonceTipSize() + call.size();
     Data data;
+    auto writer = ScaleWriter(data, compactSize(length) + length);
+    // length prefix
+    writer.writeCompact(length);
     // version header
-    append(data, Data{extrinsicFormat | signedBit});
+    writer.writeByte(extrinsicFormat | signedBit);
     // signer public key
-    append(data, encodeAccountId(signer.bytes, encodeRawAccount(network, specVersion)));
+    writer.writeAccountId(signer.bytes, raw);
     // signature type
-    append(data, sigTypeEd25519);
+    writer.writeByte(sigTypeEd25519);
     // signature
-    append(data, signature);
+    writer.writeBytes(signature);
     // era / nonce / tip
-    append(data, encodeEraNonceTip());
+    writeEraNonceTip(writer);
     // call
-    append(data, call);
-    // append length
-    encodeLengthPrefix(data);
+    writer.writeBytes(call);
     return data;
 }
+
+bool Extrinsic::decodeSigned(DataView encoded, bool rawAccount, SignedExtrinsicView& view) {
+    auto reader = ScaleReader(encoded);
+    uint64_t length;
+    byte header;
+    byte eraFirst;
+    if (!reader.readCompact(length) || length != reader.remaining() ||
+        !reader.readByte(header) || header != (extrinsicFormat | signedBit)) {
+        return false;
+    }
+    if (!rawAccount) {
+        byte addressType;
+        if (!reader.readByte(addressType) || addressType != 0x00) {
+            return false;
+        }
+    }
+    if (!reader.readBytes(PublicKey::ed25519Size, view.signer) ||
+        !reader.readByte(view.signatureType) ||
+        !reader.readBytes(64, view.signature) ||
+        !reader.readByte(eraFirst)) {
+        return false;
+    }
+    // immortal era is a single 0 byte, mortal ones 2 bytes
+    const auto eraStart = encoded.size() - reader.remaining() - 1;
+    if (eraFirst != 0 && !reader.readByte(eraFirst)) {
+        return false;
+    }
+    view.era = encoded.subView(eraStart, encoded.size() - reader.remaining() - eraStart);
+    if (!reader.readCompact(view.nonce) || !reader.readCompact(view.tip)) {
+        return false;
+    }
+    return reader.readBytes(reader.remaining(), view.call);
+}
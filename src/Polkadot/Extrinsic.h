@@ -14,6 +14,19 @@
 
 namespace TW::Polkadot {
 
+/// Parts of a signed extrinsic, referring to the encoded bytes.
+struct SignedExtrinsicView {
+    DataView signer;
+    byte signatureType = 0;
+    DataView signature;
+    // encoded Era data
+    DataView era;
+    uint64_t nonce = 0;
+    CompactInteger tip;
+    // encoded Call data
+    DataView call;
+};
+
 // ExtrinsicV4
 class Extrinsic {
   public:
@@ -53,15 +66,25 @@ class Extrinsic {
     static Data encodeCall(const Proto::SigningInput& input);
     // Payload to sign.
     Data encodePayload() const;
+    // End of the payload, after era / nonce / tip: spec and transaction versions, genesis and block hashes.
+    // It is the same for transactions on the same block, see encodePayload(suffix, hashThreshold).
+    Data encodePayloadSuffix() const;
+    // Payload to sign ending with `suffix` (from encodePayloadSuffix), or its blake2b-256 hash if it is longer than
+    // `hashThreshold`, computed incrementally without building the payload.
+    Data encodePayload(const Data& suffix, size_t hashThreshold) const;
     // Encode final data with signer public key and signature.
     Data encodeSignature(const PublicKey& signer, const Data& signature) const;
+    // Decodes a signed extrinsic (as from encodeSignature) without copies, `rawAccount` is whether
+    // the signer is encoded without MultiAddress type.  Returns false if it is invalid.
+    static bool decodeSigned(DataView encoded, bool rawAccount, SignedExtrinsicView& view);
 
   protected:
     static bool encodeRawAccount(TWSS58AddressType network, uint32_t specVersion);
     static Data encodeBalanceCall(const Proto::Balance& balance, TWSS58AddressType network, uint32_t specVersion);
     static Data encodeStakingCall(const Proto::Staking& staking, TWSS58AddressType network, uint32_t specVersion);
     static Data encodeBatchCall(const std::vector<Data>& calls, TWSS58AddressType network);
-    Data encodeEraNonceTip() const;
+    size_t eraNonceTipSize() const;
+    void writeEraNonceTip(ScaleWriter& writer) const;
 };
 
 } // namespace TW::Polkadot
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <algorithm>
 #include <bitset>
+#include <limits>
 
 
 /// Reference https://github.com/soramitsu/kagome/blob/master/core/scale/scale_encoder_stream.cpp
@@ -39,82 +40,253 @@ inline size_t countBytes(CompactInteger value) {
     return size;
 }
 
-inline Data encodeCompact(CompactInteger value) {
-    auto data = Data{};
-
+/// Number of bytes of the compact encoding of `value`.
+inline size_t compactSize(uint64_t value) {
     if (value < kMinUint16) {
-        auto v = value.convert_to<uint8_t>() << 2u;
-        data.push_back(static_cast<uint8_t>(v));
-        return data;
+        return 1;
     } else if (value < kMinUint32) {
-        auto v = (value.convert_to<uint16_t>() << 2u);
-        v += 0x01; // set 0b01 flag
-        auto minor_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(minor_byte);
-        v >>= 8u;
-        auto major_byte = static_cast<uint8_t>(v & 0xffu);
-        data.push_back(major_byte);
-        return data;
+        return 2;
     } else if (value < kMinBigInteger) {
-        uint32_t v = (value.convert_to<uint32_t>() << 2u);
-        v += 0x02; // set 0b10 flag
-        encode32LE(v, data);
-        return data;
+        return 4;
     }
+    size_t length = 0;
+    for (; value > 0; value >>= 8) {
+        ++length;
+    }
+    return 1 + length;
+}
 
+/// Number of bytes of the compact encoding of `value`, 0 if it is too big to be encoded.
+inline size_t compactSize(const CompactInteger& value) {
+    if (value < kMinBigInteger) {
+        return compactSize(value.convert_to<uint64_t>());
+    }
     auto length = countBytes(value);
-    if (length > 67) {
-        // too big
-        return data;
+    return length > 67 ? 0 : 1 + length;
+}
+
+/// Number of bytes of an encoded account id.
+inline size_t accountIdSize(size_t keySize, bool raw) {
+    return raw ? keySize : 1 + keySize;
+}
+
+/// Appends SCALE-encoded values to a buffer.
+///
+/// The final size can be reserved upfront (see the *Size functions), so that values are written
+/// in place without temporary buffers.
+class ScaleWriter {
+  public:
+    explicit ScaleWriter(Data& data, size_t reservedSize = 0) : data(data) {
+        data.reserve(data.size() + reservedSize);
+    }
+
+    void writeByte(byte value) { data.push_back(value); }
+
+    void writeBytes(DataView bytes) { append(data, bytes); }
+
+    void write32LE(uint32_t value) { encode32LE(value, data); }
+
+    void writeCompact(uint64_t value) {
+        if (value < kMinUint16) {
+            writeByte(static_cast<byte>(value << 2u));
+        } else if (value < kMinUint32) {
+            // 0b01 flag
+            const auto v = static_cast<uint16_t>((value << 2u) + 0x01);
+            writeByte(static_cast<byte>(v & 0xffu));
+            writeByte(static_cast<byte>(v >> 8u));
+        } else if (value < kMinBigInteger) {
+            // 0b10 flag
+            write32LE(static_cast<uint32_t>((value << 2u) + 0x02));
+        } else {
+            const auto length = compactSize(value) - 1;
+            // 0b11 flag
+            writeByte(static_cast<byte>((length - 4) * 4 + 0x03));
+            for (size_t i = 0; i < length; ++i, value >>= 8) {
+                writeByte(static_cast<byte>(value & 0xff));
+            }
+        }
+    }
+
+    /// Writes nothing if `value` is too big to be encoded.
+    void writeCompact(const CompactInteger& value) {
+        if (value <= std::numeric_limits<uint64_t>::max()) {
+            writeCompact(value.convert_to<uint64_t>());
+            return;
+        }
+        const auto length = countBytes(value);
+        if (length > 67) {
+            return;
+        }
+        writeByte(static_cast<byte>((length - 4) * 4 + 0x03));
+        auto v = value;
+        for (size_t i = 0; i < length; ++i, v >>= 8) {
+            writeByte(static_cast<byte>(v & 0xff)); // least significant byte first
+        }
+    }
+
+    void writeAccountId(DataView bytes, bool raw) {
+        if (!raw) {
+            // MultiAddress::AccountId
+            // https://github.com/paritytech/substrate/blob/master/primitives/runtime/src/multiaddress.rs#L28
+            writeByte(0x00);
+        }
+        writeBytes(bytes);
+    }
+
+  private:
+    Data& data;
+};
+
+/// Reads SCALE-encoded values from a range of bytes, without copies.
+///
+/// Reads return false, leaving the position unchanged, if the data is too short or invalid.
+class ScaleReader {
+  public:
+    explicit ScaleReader(DataView data) : data(data) {}
+
+    /// Number of bytes left to read.
+    size_t remaining() const { return data.size() - position; }
+
+    bool readByte(byte& value) {
+        if (remaining() < 1) {
+            return false;
+        }
+        value = data[position++];
+        return true;
+    }
+
+    bool read32LE(uint32_t& value) {
+        if (remaining() < 4) {
+            return false;
+        }
+        value = decode32LE(data.data() + position);
+        position += 4;
+        return true;
     }
-    uint8_t header = (static_cast<uint8_t>(length) - 4) * 4;
-    header += 0x03; // set 0b11 flag;
-    data.push_back(header);
 
-    auto v = CompactInteger{value};
-    for (size_t i = 0; i < length; ++i) {
-        data.push_back(static_cast<uint8_t>(v & 0xff)); // push back least significant byte
-        v >>= 8;
+    /// Returns a view of the next `count` bytes.
+    bool readBytes(size_t count, DataView& bytes) {
+        if (remaining() < count) {
+            return false;
+        }
+        bytes = data.subView(position, count);
+        position += count;
+        return true;
+    }
+
+    bool readCompact(CompactInteger& value) {
+        if (remaining() < 1) {
+            return false;
+        }
+        const auto header = data[position];
+        size_t length;
+        switch (header & 0x03) {
+        case 0x00:
+            value = header >> 2u;
+            position += 1;
+            return true;
+        case 0x01:
+            length = 2;
+            break;
+        case 0x02:
+            length = 4;
+            break;
+        default:
+            length = 1 + (header >> 2u) + 4;
+            break;
+        }
+        if (remaining() < length) {
+            return false;
+        }
+        if (length <= 4) {
+            uint32_t v = 0;
+            for (size_t i = 0; i < length; ++i) {
+                v |= uint32_t(data[position + i]) << (8 * i);
+            }
+            value = v >> 2u;
+        } else {
+            value = 0;
+            for (size_t i = length - 1; i > 0; --i) {
+                value <<= 8;
+                value |= data[position + i];
+            }
+        }
+        position += length;
+        return true;
     }
+
+    /// Fails as well if the value doesn't fit in 64 bits.
+    bool readCompact(uint64_t& value) {
+        const auto start = position;
+        CompactInteger v;
+        if (!readCompact(v)) {
+            return false;
+        }
+        if (v > std::numeric_limits<uint64_t>::max()) {
+            position = start;
+            return false;
+        }
+        value = v.convert_to<uint64_t>();
+        return true;
+    }
+
+  private:
+    DataView data;
+    size_t position = 0;
+};
+
+inline Data encodeCompact(CompactInteger value) {
+    auto data = Data{};
+    ScaleWriter(data, compactSize(value)).writeCompact(value);
     return data;
 }
 
 // append length prefix
 inline void encodeLengthPrefix(Data& data) {
     size_t len = data.size();
-    auto prefix = encodeCompact(len);
-    data.insert(data.begin(), prefix.begin(), prefix.end());
+    auto prefix = Data{};
+    ScaleWriter(prefix, compactSize(len) + len).writeCompact(len);
+    append(prefix, data);
+    data = std::move(prefix);
 }
 
 inline Data encodeBool(bool value) {
     return Data{uint8_t(value ? 0x01 : 0x00)};
 }
 
+/// Number of bytes of an encoded vector.
+inline size_t vectorSize(const std::vector<Data>& vec) {
+    auto size = compactSize(vec.size());
+    for (const auto& v : vec) {
+        size += v.size();
+    }
+    return size;
+}
+
 inline Data encodeVector(const std::vector<Data>& vec) {
-    auto data = encodeCompact(vec.size());
-    for (auto v : vec) {
-        append(data, v);
+    auto data = Data{};
+    auto writer = ScaleWriter(data, vectorSize(vec));
+    writer.writeCompact(vec.size());
+    for (const auto& v : vec) {
+        writer.writeBytes(v);
     }
     return data;
 }
 
 inline Data encodeAccountId(const Data& bytes, bool raw) {
     auto data = Data{};
-    if (!raw) {
-        // MultiAddress::AccountId
-        // https://github.com/paritytech/substrate/blob/master/primitives/runtime/src/multiaddress.rs#L28
-        append(data, 0x00);
-    }
-    append(data, bytes);
+    ScaleWriter(data, accountIdSize(bytes.size(), raw)).writeAccountId(bytes, raw);
     return data;
 }
 
 inline Data encodeAccountIds(const std::vector<SS58Address>& addresses, bool raw) {
-    std::vector<Data> vec;
-    for (auto addr : addresses) {
-        vec.push_back(encodeAccountId(addr.keyBytes(), raw));
+    auto data = Data{};
+    auto writer = ScaleWriter(data, compactSize(addresses.size()) + addresses.size() * accountIdSize(PublicKey::ed25519Size, raw));
+    writer.writeCompact(addresses.size());
+    for (const auto& addr : addresses) {
+        writer.writeAccountId(addr.keyBytes(), raw);
     }
-    return encodeVector(vec);
+    return data;
 }
 
 inline Data encodeEra(const uint64_t block, const uint64_t period) {
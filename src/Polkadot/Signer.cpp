@@ -8,6 +8,10 @@
 #include "Extrinsic.h"
 #include "../Hash.h"
 #include "../PrivateKey.h"
+#include "../ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
 
 using namespace TW;
 using namespace TW::Polkadot;
@@ -15,14 +19,15 @@ using namespace TW::Polkadot;
 static constexpr size_t hashTreshold = 256;
 
 Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
+    return sign(input, Extrinsic(input).encodePayloadSuffix());
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput &input, const Data& payloadSuffix) noexcept {
     auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
     auto extrinsic = Extrinsic(input);
-    auto payload = extrinsic.encodePayload();
-    // check if need to hash
-    if (payload.size() > hashTreshold) {
-        payload = Hash::blake2b(payload, 32);
-    }
+    // hashed if needed
+    auto payload = extrinsic.encodePayload(payloadSuffix, hashTreshold);
     auto signature = privateKey.sign(payload, TWCurveED25519);
     auto encoded = extrinsic.encodeSignature(publicKey, signature);
 
@@ -30,3 +35,31 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput &input) noexcept {
     protoOutput.set_encoded(encoded.data(), encoded.size());
     return protoOutput;
 }
+
+static bool samePayloadSuffix(const Proto::SigningInput& lhs, const Proto::SigningInput& rhs) {
+    return lhs.spec_version() == rhs.spec_version() && lhs.transaction_version() == rhs.transaction_version() &&
+        lhs.genesis_hash() == rhs.genesis_hash() && lhs.block_hash() == rhs.block_hash();
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    // suffix index of each input
+    std::vector<Data> suffixes;
+    std::vector<size_t> suffixIndices(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (i == 0 || !samePayloadSuffix(inputs[i], inputs[i - 1])) {
+            suffixes.push_back(Extrinsic(inputs[i]).encodePayloadSuffix());
+        }
+        suffixIndices[i] = suffixes.size() - 1;
+    }
+
+    std::vector<Proto::SigningOutput> outputs(inputs.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto index = next++; index < inputs.size(); index = next++) {
+            outputs[index] = sign(inputs[index], suffixes[suffixIndices[index]]);
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, inputs.size(), worker);
+    return outputs;
+}
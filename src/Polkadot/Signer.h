@@ -10,6 +10,8 @@
 #include "../PrivateKey.h"
 #include "../proto/Polkadot.pb.h"
 
+#include <vector>
+
 namespace TW::Polkadot {
 
 /// Helper class that performs Polkadot transaction signing.
@@ -20,6 +22,14 @@ public:
 
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs many transactions, returned in the same order, on up to `threadCount` threads (0: one per hardware thread).
+    /// The payload suffix (versions, genesis and block hashes) is encoded once for consecutive transactions sharing it,
+    /// and long payloads are hashed as they are encoded.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
+  private:
+    static Proto::SigningOutput sign(const Proto::SigningInput& input, const Data& payloadSuffix) noexcept;
 };
 
 } // namespace TW::Polkadot
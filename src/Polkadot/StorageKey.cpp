@@ -0,0 +1,42 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "StorageKey.h"
+#include "../Hash.h"
+
+using namespace TW;
+using namespace TW::Polkadot;
+
+Data StorageKey::twox128(const std::string& string) {
+    return Hash::xxhash64concat(reinterpret_cast<const byte*>(string.data()), string.size());
+}
+
+StorageKey::StorageKey(const std::string& module, const std::string& item) : prefixKey(twox128(module)) {
+    append(prefixKey, twox128(item));
+}
+
+Data StorageKey::key(const Data& mapKey) const {
+    return key(mapKey, Hash::blake2b(mapKey, hashSize));
+}
+
+std::vector<Data> StorageKey::keys(const std::vector<Data>& mapKeys) const {
+    const auto hashes = Hash::blake2bBatch(mapKeys, hashSize);
+    std::vector<Data> result;
+    result.reserve(mapKeys.size());
+    for (size_t i = 0; i < mapKeys.size(); ++i) {
+        result.push_back(key(mapKeys[i], hashes[i]));
+    }
+    return result;
+}
+
+Data StorageKey::key(const Data& mapKey, const Data& hash) const {
+    Data result;
+    result.reserve(prefixKey.size() + hash.size() + mapKey.size());
+    append(result, prefixKey);
+    append(result, hash);
+    append(result, mapKey);
+    return result;
+}
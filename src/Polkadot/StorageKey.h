@@ -0,0 +1,44 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../Data.h"
+#include "../SS58Address.h"
+
+#include <string>
+#include <vector>
+
+namespace TW::Polkadot {
+
+/// Builds the storage keys of a map of a Substrate pallet hashed with Blake2_128Concat, such as System.Account:
+/// TwoX128(module) ++ TwoX128(item) ++ Blake2_128(key) ++ key. The prefix is computed once per builder.
+class StorageKey {
+  public:
+    static constexpr size_t hashSize = 16;
+
+    /// TwoX128 of a string: xxhash64 with the seeds 0 and 1, little endian.
+    static Data twox128(const std::string& string);
+
+    StorageKey(const std::string& module, const std::string& item);
+
+    /// TwoX128(module) ++ TwoX128(item), the key of a plain storage value, or the prefix of a map.
+    const Data& prefix() const { return prefixKey; }
+
+    /// Key of one map entry.
+    Data key(const Data& mapKey) const;
+    Data key(const SS58Address& account) const { return key(account.keyBytes()); }
+
+    /// Keys of many map entries in order, their Blake2b hashes computed as a batch.
+    std::vector<Data> keys(const std::vector<Data>& mapKeys) const;
+
+  private:
+    Data prefixKey;
+
+    Data key(const Data& mapKey, const Data& hash) const;
+};
+
+} // namespace TW::Polkadot
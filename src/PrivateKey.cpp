@@ -6,7 +6,10 @@
 
 #include "PrivateKey.h"
 
+#include "Ed25519SigningKey.h"
 #include "PublicKey.h"
+#include "Secp256k1Comb.h"
+#include "ThreadPool.h"
 
 #include <TrezorCrypto/bignum.h>
 #include <TrezorCrypto/curves.h>
@@ -19,9 +22,12 @@
 #include <TrezorCrypto/secp256k1.h>
 #include <TrezorCrypto/sodium/keypair.h>
 
+#include <atomic>
+#include <optional>
+
 using namespace TW;
 
-bool PrivateKey::isValid(const Data& data) {
+bool PrivateKey::isValid(DataView data) {
     // Check length.  Extended key needs 3*32 bytes.
     if (data.size() != size && data.size() != extendedSize) {
         return false;
@@ -37,7 +43,7 @@ bool PrivateKey::isValid(const Data& data) {
     return false;
 }
 
-bool PrivateKey::isValid(const Data& data, TWCurve curve)
+bool PrivateKey::isValid(DataView data, TWCurve curve)
 {
     // check size
     bool valid = isValid(data);
@@ -75,41 +81,42 @@ bool PrivateKey::isValid(const Data& data, TWCurve curve)
     return true;
 }
 
-PrivateKey::PrivateKey(const Data& data) {
+PrivateKey::PrivateKey(DataView data) {
     if (!isValid(data)) {
         throw std::invalid_argument("Invalid private key data");
     }
     if (data.size() == extendedSize) {
         // special extended case
-        *this = PrivateKey(
-            TW::data(data.data(), 32),
-            TW::data(data.data() + 32, 32),
-            TW::data(data.data() + 64, 32));
+        *this = PrivateKey(data.subView(0, size), data.subView(size, size), data.subView(2 * size, size));
     } else {
         // default case
-        bytes = data;
+        bytes.assign(data.begin(), data.end());
     }
 }
 
-PrivateKey::PrivateKey(const Data& data, const Data& ext, const Data& chainCode) {
+PrivateKey::PrivateKey(DataView data, DataView ext, DataView chainCode) {
     if (!isValid(data) || !isValid(ext) || !isValid(chainCode)) {
         throw std::invalid_argument("Invalid private key or extended key data");
     }
-    bytes = data;
-    extensionBytes = ext;
-    chainCodeBytes = chainCode;
+    bytes.assign(data.begin(), data.end());
+    extensionBytes.assign(ext.begin(), ext.end());
+    chainCodeBytes.assign(chainCode.begin(), chainCode.end());
 }
 
 PublicKey PrivateKey::getPublicKey(TWPublicKeyType type) const {
-    Data result;
+    FixedData<PublicKey::maxSize> result;
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
         result.resize(PublicKey::secp256k1Size);
-        ecdsa_get_public_key33(&secp256k1, bytes.data(), result.data());
+        if (!Secp256k1Comb::publicKey(bytes, true, result.data())) {
+            ecdsa_get_public_key33(&secp256k1, bytes.data(), result.data());
+        }
         break;
     case TWPublicKeyTypeSECP256k1Extended:
         result.resize(PublicKey::secp256k1ExtendedSize);
-        ecdsa_get_public_key65(&secp256k1, bytes.data(), result.data());
+        if (!Secp256k1Comb::publicKey(bytes, false, result.data())) {
+            ecdsa_get_public_key65(&secp256k1, bytes.data(), result.data());
+        }
         break;
     case TWPublicKeyTypeNIST256p1:
         result.resize(PublicKey::secp256k1Size);
@@ -164,56 +171,57 @@ Data PrivateKey::getSharedKey(const PublicKey& pubKey, TWCurve curve) const {
     return {};
 }
 
-int ecdsa_sign_digest_checked(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *digest, size_t digest_size, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
+int ecdsa_sign_digest_checked(const ecdsa_curve *curve, const uint8_t *priv_key, const uint8_t *digest, size_t digest_size, uint8_t *sig, uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]), const rfc6979_key_state *key_state = nullptr) {
     if (digest_size < 32) {
         return -1;
     }
     assert(digest_size >= 32);
-    return ecdsa_sign_digest(curve, priv_key, digest, sig, pby, is_canonical);
+    return ecdsa_sign_digest_with_key_state(curve, priv_key, key_state, digest, sig, pby, is_canonical);
 }
 
-Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
-    Data result;
+namespace {
+
+/// Nonce generator state of the key for ECDSA signing, shared by all the digests of a batch.
+struct NonceKeyState {
+    rfc6979_key_state state;
+    bool valid = false;
+
+    NonceKeyState(const PrivateKey& privateKey, TWCurve curve) {
+        if (curve == TWCurveSECP256k1 || curve == TWCurveNIST256p1) {
+            init_rfc6979_key(privateKey.bytes.data(), &state);
+            valid = true;
+        }
+    }
+    ~NonceKeyState() { memzero(&state, sizeof(state)); }
+    NonceKeyState(const NonceKeyState&) = delete;
+    NonceKeyState& operator=(const NonceKeyState&) = delete;
+
+    const rfc6979_key_state* get() const { return valid ? &state : nullptr; }
+};
+
+/// Signs a digest into `result`, reusing its storage; `signingKey` is the signing key of the EdDSA curves.
+bool signDigest(const PrivateKey& privateKey, const Ed25519SigningKey* signingKey, const Data& digest, TWCurve curve, Data& result,
+                const rfc6979_key_state* keyState = nullptr) {
+    const auto& bytes = privateKey.bytes;
     bool success = false;
     switch (curve) {
     case TWCurveSECP256k1: {
         result.resize(65);
         success = ecdsa_sign_digest_checked(&secp256k1, bytes.data(), digest.data(), digest.size(), result.data(),
-                                    result.data() + 64, nullptr) == 0;
-    } break;
-    case TWCurveED25519: {
-        result.resize(64);
-        const auto publicKey = getPublicKey(TWPublicKeyTypeED25519);
-        ed25519_sign(digest.data(), digest.size(), bytes.data(), publicKey.bytes.data(), result.data());
-        success = true;
-    } break;
-    case TWCurveED25519Blake2bNano: {
-        result.resize(64);
-        const auto publicKey = getPublicKey(TWPublicKeyTypeED25519Blake2b);
-        ed25519_sign_blake2b(digest.data(), digest.size(), bytes.data(),
-                             publicKey.bytes.data(), result.data());
-        success = true;
-    } break;
-    case TWCurveED25519Extended: {
-        result.resize(64);
-        const auto publicKey = getPublicKey(TWPublicKeyTypeED25519Extended);
-        ed25519_sign_ext(digest.data(), digest.size(), bytes.data(), extensionBytes.data(), publicKey.bytes.data(), result.data());
-        success = true;
+                                    result.data() + 64, nullptr, keyState) == 0;
     } break;
+    case TWCurveED25519:
+    case TWCurveED25519Blake2bNano:
+    case TWCurveED25519Extended:
     case TWCurveCurve25519: {
-        result.resize(64);
-        const auto publicKey = getPublicKey(TWPublicKeyTypeED25519);
-        ed25519_sign(digest.data(), digest.size(), bytes.data(), publicKey.bytes.data(),
-                     result.data());
-        const auto sign_bit = publicKey.bytes[31] & 0x80;
-        result[63] = result[63] & 127;
-        result[63] |= sign_bit;
+        result.resize(Ed25519SigningKey::signatureSize);
+        signingKey->sign(digest, result.data());
         success = true;
     } break;
     case TWCurveNIST256p1: {
         result.resize(65);
         success = ecdsa_sign_digest_checked(&nist256p1, bytes.data(), digest.data(), digest.size(), result.data(),
-                                    result.data() + 64, nullptr) == 0;
+                                    result.data() + 64, nullptr, keyState) == 0;
     } break;
     case TWCurveNone:
     default: 
@@ -221,11 +229,47 @@ Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
     }
 
     if (!success) {
-        return {};
+        result.clear();
     }
+    return success;
+}
+
+} // namespace
+
+Data PrivateKey::sign(const Data& digest, TWCurve curve) const {
+    if (Ed25519SigningKey::supports(curve)) {
+        return Ed25519SigningKey(*this, curve).sign(digest);
+    }
+    Data result;
+    signDigest(*this, nullptr, digest, curve, result);
     return result;
 }
 
+bool PrivateKey::signBatch(const std::vector<Data>& digests, TWCurve curve, std::vector<Data>& signatures, size_t threadCount) const {
+    signatures.resize(digests.size());
+    std::optional<Ed25519SigningKey> signingKey;
+    if (Ed25519SigningKey::supports(curve)) {
+        signingKey.emplace(*this, curve);
+    }
+    const NonceKeyState keyState(*this, curve);
+
+    std::atomic<bool> success(true);
+    auto signRange = [&](size_t begin, size_t end) {
+        for (auto i = begin; i < end; ++i) {
+            if (!signDigest(*this, signingKey ? &*signingKey : nullptr, digests[i], curve, signatures[i], keyState.get())) {
+                success = false;
+            }
+        }
+    };
+
+    threadCount = std::max<size_t>(std::min(threadCount, digests.size()), 1);
+    const auto chunk = (digests.size() + threadCount - 1) / threadCount;
+    ThreadPool::shared().parallelFor(threadCount, threadCount, [&](size_t t) {
+        signRange(std::min(t * chunk, digests.size()), std::min((t + 1) * chunk, digests.size()));
+    });
+    return success;
+}
+
 Data PrivateKey::sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(uint8_t by, uint8_t sig[64])) const {
     Data result;
     bool success = false;
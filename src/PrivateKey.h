@@ -16,31 +16,31 @@ namespace TW {
 class PrivateKey {
   public:
     /// The number of bytes in a private key.
-    static const size_t size = 32;
+    static constexpr size_t size = 32;
     /// The number of bytes in an extended private key.
-    static const size_t extendedSize = 3 * 32;
+    static constexpr size_t extendedSize = 3 * 32;
 
-    /// The private key bytes.
-    Data bytes;
+    /// The private key bytes, stored inline.
+    FixedData<size> bytes;
     /// Optional extended part of the key (additional 32 bytes)
-    Data extensionBytes;
+    FixedData<size> extensionBytes;
     /// Optional chain code (additional 32 bytes)
-    Data chainCodeBytes;
+    FixedData<size> chainCodeBytes;
 
     /// Determines if a collection of bytes makes a valid private key.
-    static bool isValid(const Data& data);
+    static bool isValid(DataView data);
 
     /// Determines if a collection of bytes and curve make a valid private key.
-    static bool isValid(const Data& data, TWCurve curve);
+    static bool isValid(DataView data, TWCurve curve);
 
     /// Initializes a private key with an array of bytes.  Size must be exact (normally 32, or 96 for extended)
-    explicit PrivateKey(const Data& data);
+    explicit PrivateKey(DataView data);
 
     /// Initializes a private key from a string of bytes (convenience method).
     explicit PrivateKey(const std::string& data) : PrivateKey(TW::data(data)) {}
 
     /// Initializes an extended private key with key, extended key, and chain code.
-    explicit PrivateKey(const Data& data, const Data& ext, const Data& chainCode);
+    explicit PrivateKey(DataView data, DataView ext, DataView chainCode);
 
     PrivateKey(const PrivateKey& other) = default;
     PrivateKey& operator=(const PrivateKey& other) = default;
@@ -60,6 +60,12 @@ class PrivateKey {
     /// Signs a digest using the given ECDSA curve.
     Data sign(const Data& digest, TWCurve curve) const;
 
+    /// Signs many digests with this key, the result being the same as calling sign() on each.
+    /// Signatures are written into `signatures` (resized to the number of digests, existing buffers are reused),
+    /// per-key state is computed only once, and the work is split over `threadCount` threads.
+    /// Returns false if any of the signatures failed; failed entries are left empty.
+    bool signBatch(const std::vector<Data>& digests, TWCurve curve, std::vector<Data>& signatures, size_t threadCount = 1) const;
+
     /// Signs a digest using the given ECDSA curve and prepends the recovery id (a la graphene)
     /// Only a sig that passes canonicalChecker is returned
     Data sign(const Data& digest, TWCurve curve, int(*canonicalChecker)(uint8_t by, uint8_t sig[64])) const;
@@ -0,0 +1,146 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+/// Helpers for hand-written parsers of the proto3 JSON mapping, filling messages without reflection.
+///
+/// Parsers are strict: they return false on anything they don't handle (unknown fields, unexpected types),
+/// so callers can fall back to google::protobuf::util::JsonStringToMessage.
+namespace TW::ProtoJSON {
+
+using json = nlohmann::json;
+
+/// Parser of one message field.
+template <typename Message>
+struct Field {
+    /// lowerCamelCase name.
+    const char* jsonName;
+    /// Original name, also accepted by the proto3 JSON mapping.
+    const char* protoName;
+    bool (*parse)(const json& value, Message& message);
+};
+
+/// Parses a JSON object with the given fields, null values are skipped.
+template <typename Message, size_t N>
+bool parseObject(const json& object, Message& message, const Field<Message> (&fields)[N]) {
+    if (!object.is_object()) {
+        return false;
+    }
+    for (const auto& item : object.items()) {
+        const auto& key = item.key();
+        const Field<Message>* found = nullptr;
+        for (const auto& field : fields) {
+            if (key == field.jsonName || key == field.protoName) {
+                found = &field;
+                break;
+            }
+        }
+        if (found == nullptr) {
+            return false;
+        }
+        if (item.value().is_null()) {
+            continue;
+        }
+        if (!found->parse(item.value(), message)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+inline bool readString(const json& value, std::string& result) {
+    if (!value.is_string()) {
+        return false;
+    }
+    result = value.get_ref<const std::string&>();
+    return true;
+}
+
+/// 64-bit integers are strings in the proto3 JSON mapping, but numbers are accepted too.
+inline bool readUInt64(const json& value, uint64_t& result) {
+    if (value.is_number_unsigned()) {
+        result = value.get<uint64_t>();
+        return true;
+    }
+    if (!value.is_string()) {
+        return false;
+    }
+    const auto& string = value.get_ref<const std::string&>();
+    if (string.empty() || string.size() > 20) {
+        return false;
+    }
+    uint64_t parsed = 0;
+    for (auto c : string) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        const uint64_t digit = c - '0';
+        if (parsed > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+            return false;
+        }
+        parsed = parsed * 10 + digit;
+    }
+    result = parsed;
+    return true;
+}
+
+inline bool readInt64(const json& value, int64_t& result) {
+    if (value.is_number_integer()) {
+        if (value.is_number_unsigned() && value.get<uint64_t>() > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            return false;
+        }
+        result = value.get<int64_t>();
+        return true;
+    }
+    if (!value.is_string()) {
+        return false;
+    }
+    const auto& string = value.get_ref<const std::string&>();
+    const bool negative = !string.empty() && string[0] == '-';
+    uint64_t magnitude = 0;
+    if (!readUInt64(negative ? json(string.substr(1)) : value, magnitude)) {
+        return false;
+    }
+    const auto limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (negative ? 1 : 0);
+    if (magnitude > limit) {
+        return false;
+    }
+    result = negative ? static_cast<int64_t>(0 - magnitude) : static_cast<int64_t>(magnitude);
+    return true;
+}
+
+/// Enums are accepted by name or by number, `names` lists the names in value order.
+template <size_t N>
+bool readEnum(const json& value, const char* const (&names)[N], int& result) {
+    if (value.is_number_integer()) {
+        const auto number = value.get<int64_t>();
+        if (number < 0 || number >= static_cast<int64_t>(N)) {
+            return false;
+        }
+        result = static_cast<int>(number);
+        return true;
+    }
+    if (!value.is_string()) {
+        return false;
+    }
+    for (size_t i = 0; i < N; ++i) {
+        if (value.get_ref<const std::string&>() == names[i]) {
+            result = static_cast<int>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace TW::ProtoJSON
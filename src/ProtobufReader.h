@@ -0,0 +1,176 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "ProtobufWriter.h"
+
+#include <array>
+#include <cstdint>
+
+namespace TW {
+
+/// Reads proto3 wire format field by field, without building a generated message; string and bytes
+/// fields are views into the input, which must outlive them.
+///
+/// Generated messages copy every bytes field on parse; this reader lets a signer keep a large field,
+/// such as a contract payload, in the caller's buffer and parse the rest of the message without it.
+class ProtobufReader {
+  public:
+    static constexpr uint32_t lengthDelimited = 2;
+
+    explicit ProtobufReader(DataView data) : data(data) {}
+
+    /// Reads the next field; false at the end of the input or if it is malformed, see `failed()`.
+    bool next() {
+        fieldStart = position;
+        if (position == data.size()) {
+            return false;
+        }
+        uint64_t tag = 0;
+        if (!readVarint(tag) || (tag >> 3) == 0 || (tag >> 3) > UINT32_MAX) {
+            return fail();
+        }
+        currentField = static_cast<uint32_t>(tag >> 3);
+        currentWireType = static_cast<uint32_t>(tag & 7);
+        valueStart = position;
+        switch (currentWireType) {
+        case 0:
+            if (!readVarint(currentVarint)) {
+                return fail();
+            }
+            break;
+        case 1:
+            return skip(8);
+        case lengthDelimited: {
+            uint64_t length = 0;
+            if (!readVarint(length)) {
+                return fail();
+            }
+            valueStart = position;
+            return skip(length);
+        }
+        case 5:
+            return skip(4);
+        default:
+            // groups are not used by proto3
+            return fail();
+        }
+        return true;
+    }
+
+    /// Number of the current field.
+    uint32_t field() const { return currentField; }
+
+    /// Wire type of the current field.
+    uint32_t wireType() const { return currentWireType; }
+
+    /// Value of the current varint field.
+    uint64_t varint() const { return currentVarint; }
+
+    /// Payload of the current length-delimited field, a view into the input.
+    DataView bytes() const { return data.subView(valueStart, position - valueStart); }
+
+    /// Current field with its tag, as it is encoded in the input.
+    DataView raw() const { return data.subView(fieldStart, position - fieldStart); }
+
+    /// Whether reading stopped on malformed input.
+    bool failed() const { return malformed; }
+
+    /// Finds the length-delimited field at `path`, a field number per nesting level, and sets `value` to a view
+    /// of its payload.  False if the field is absent, malformed, or if a field of the path occurs more than once,
+    /// as the parser would then merge or replace the occurrences.
+    template <std::size_t N>
+    static bool find(DataView message, const std::array<uint32_t, N>& path, DataView& value) {
+        return find(message, path.data(), N, value);
+    }
+
+    /// Copy of `message` without the length-delimited field at `path`; the messages of the path enclosing it are
+    /// encoded again with their new sizes, the other fields are copied as they are.
+    template <std::size_t N>
+    static Data without(DataView message, const std::array<uint32_t, N>& path) {
+        Data result;
+        result.reserve(message.size());
+        without(message, path.data(), N, result);
+        return result;
+    }
+
+  private:
+    bool readVarint(uint64_t& value) {
+        value = 0;
+        for (unsigned shift = 0; shift < 64 && position < data.size(); shift += 7) {
+            const auto b = data[position++];
+            value |= static_cast<uint64_t>(b & 0x7f) << shift;
+            if ((b & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool skip(uint64_t count) {
+        if (count > data.size() - position) {
+            return fail();
+        }
+        position += static_cast<std::size_t>(count);
+        return true;
+    }
+
+    bool fail() {
+        malformed = true;
+        position = data.size();
+        return false;
+    }
+
+    static bool find(DataView message, const uint32_t* path, std::size_t depth, DataView& value) {
+        auto reader = ProtobufReader(message);
+        auto found = false;
+        DataView field;
+        while (reader.next()) {
+            if (reader.field() != path[0]) {
+                continue;
+            }
+            if (found || reader.wireType() != lengthDelimited) {
+                return false;
+            }
+            found = true;
+            field = reader.bytes();
+        }
+        if (!found || reader.failed()) {
+            return false;
+        }
+        if (depth == 1) {
+            value = field;
+            return true;
+        }
+        return find(field, path + 1, depth - 1, value);
+    }
+
+    static void without(DataView message, const uint32_t* path, std::size_t depth, Data& result) {
+        auto reader = ProtobufReader(message);
+        while (reader.next()) {
+            if (reader.field() != path[0] || reader.wireType() != lengthDelimited) {
+                append(result, reader.raw());
+            } else if (depth > 1) {
+                Data nested;
+                without(reader.bytes(), path + 1, depth - 1, nested);
+                ProtobufWriter(result).message(path[0], nested);
+            }
+        }
+    }
+
+    DataView data;
+    std::size_t position = 0;
+    std::size_t fieldStart = 0;
+    std::size_t valueStart = 0;
+    uint32_t currentField = 0;
+    uint32_t currentWireType = 0;
+    uint64_t currentVarint = 0;
+    bool malformed = false;
+};
+
+} // namespace TW
@@ -0,0 +1,82 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstdint>
+#include <string>
+
+namespace TW {
+
+/// Writes proto3 wire format directly into a buffer, for small messages encoded often, without
+/// building a generated message first.
+///
+/// Fields must be written in field number order; scalar and string fields holding their default
+/// value are skipped, as proto3 does, so that the output matches SerializeAsString().
+class ProtobufWriter {
+  public:
+    explicit ProtobufWriter(Data& data) : data(data) {}
+
+    static std::size_t varintSize(uint64_t value) {
+        std::size_t size = 1;
+        for (; value >= 0x80; value >>= 7) {
+            ++size;
+        }
+        return size;
+    }
+
+    /// Encoded size of a length-delimited field with a payload of `size` bytes.
+    static std::size_t fieldSize(uint32_t field, std::size_t size) {
+        return varintSize(field << 3) + varintSize(size) + size;
+    }
+
+    /// Integer or bool field, skipped if 0.
+    ProtobufWriter& varint(uint32_t field, uint64_t value) {
+        if (value != 0) {
+            writeVarint(field << 3);
+            writeVarint(value);
+        }
+        return *this;
+    }
+
+    /// String or bytes field, skipped if empty.
+    ProtobufWriter& bytes(uint32_t field, DataView value) {
+        if (value.size() != 0) {
+            message(field, value);
+        }
+        return *this;
+    }
+
+    ProtobufWriter& bytes(uint32_t field, const std::string& value) {
+        return bytes(field, DataView(reinterpret_cast<const byte*>(value.data()), value.size()));
+    }
+
+    /// Embedded message field, already encoded; written even if empty, as a set message is.
+    ProtobufWriter& message(uint32_t field, DataView encoded) {
+        writeVarint((field << 3) | 2);
+        writeVarint(encoded.size());
+        append(data, encoded);
+        return *this;
+    }
+
+    ProtobufWriter& message(uint32_t field, const std::string& encoded) {
+        return message(field, DataView(reinterpret_cast<const byte*>(encoded.data()), encoded.size()));
+    }
+
+  private:
+    void writeVarint(uint64_t value) {
+        for (; value >= 0x80; value >>= 7) {
+            data.push_back(static_cast<byte>(value | 0x80));
+        }
+        data.push_back(static_cast<byte>(value));
+    }
+
+    Data& data;
+};
+
+} // namespace TW
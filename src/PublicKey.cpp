@@ -6,6 +6,8 @@
 
 #include "PublicKey.h"
 #include "Data.h"
+#include "SignatureCache.h"
+#include "ThreadPool.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
@@ -14,11 +16,14 @@
 #include <TrezorCrypto/sodium/keypair.h>
 #include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
 
+#include <algorithm>
+#include <atomic>
+
 namespace TW {
 
 /// Determines if a collection of bytes makes a valid public key of the
 /// given type.
-bool PublicKey::isValid(const Data& data, enum TWPublicKeyType type) {
+bool PublicKey::isValid(DataView data, enum TWPublicKeyType type) {
     const auto size = data.size();
     if (size == 0) {
         return false;
@@ -45,36 +50,15 @@ bool PublicKey::isValid(const Data& data, enum TWPublicKeyType type) {
 /// Initializes a public key with a collection of bytes.
 ///
 /// @throws std::invalid_argument if the data is not a valid public key.
-PublicKey::PublicKey(const Data& data, enum TWPublicKeyType type) : type(type) {
+PublicKey::PublicKey(DataView data, enum TWPublicKeyType type) : type(type) {
     if (!isValid(data, type)) {
         throw std::invalid_argument("Invalid public key data");
     }
-    switch (type) {
-    case TWPublicKeyTypeSECP256k1:
-    case TWPublicKeyTypeNIST256p1:
-    case TWPublicKeyTypeSECP256k1Extended:
-    case TWPublicKeyTypeNIST256p1Extended:
-        bytes.reserve(data.size());
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        break;
-
-    case TWPublicKeyTypeED25519:
-    case TWPublicKeyTypeCURVE25519:
-        bytes.reserve(ed25519Size);
-        if (data.size() == ed25519Size + 1) {
-            std::copy(std::begin(data) + 1, std::end(data), std::back_inserter(bytes));
-        } else {
-            std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        }
-        break;
-    case TWPublicKeyTypeED25519Blake2b:
-        bytes.reserve(ed25519Size);
-        assert(data.size() == ed25519Size); // ensured by isValid() above
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
-        break;
-    case TWPublicKeyTypeED25519Extended:
-        bytes.reserve(ed25519ExtendedSize);
-        std::copy(std::begin(data), std::end(data), std::back_inserter(bytes));
+    if (type == TWPublicKeyTypeED25519 && data.size() == ed25519Size + 1) {
+        // skip the 0x01 prefix
+        bytes.assign(data.begin() + 1, data.end());
+    } else {
+        bytes.assign(data.begin(), data.end());
     }
 }
 
@@ -83,7 +67,7 @@ PublicKey PublicKey::compressed() const {
         return *this;
     }
 
-    Data newBytes(secp256k1Size);
+    std::array<byte, secp256k1Size> newBytes;
     assert(bytes.size() >= 65);
     newBytes[0] = 0x02 | (bytes[64] & 0x01);
 
@@ -101,7 +85,7 @@ PublicKey PublicKey::compressed() const {
 }
 
 PublicKey PublicKey::extended() const {
-    Data newBytes(secp256k1ExtendedSize);
+    std::array<byte, secp256k1ExtendedSize> newBytes;
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
         ecdsa_uncompress_pubkey(&secp256k1, bytes.data(), newBytes.data());
@@ -121,7 +105,33 @@ PublicKey PublicKey::extended() const {
     }
 }
 
+namespace {
+
+/// Runs `verify` unless the check is in the signature cache, caching it if it succeeds.
+template <typename Verify>
+bool cachedVerify(SignatureCache::Scheme scheme, const PublicKey& publicKey, const Data& signature, const Data& message, Verify verify) {
+    auto& cache = SignatureCache::shared();
+    if (!cache.enabled()) {
+        return verify();
+    }
+    const auto key = cache.key(scheme, static_cast<byte>(publicKey.type), publicKey.bytes, signature, message);
+    if (cache.find(key)) {
+        return true;
+    }
+    const bool valid = verify();
+    if (valid) {
+        cache.insert(key);
+    }
+    return valid;
+}
+
+} // namespace
+
 bool PublicKey::verify(const Data& signature, const Data& message) const {
+    return cachedVerify(SignatureCache::SchemeVerify, *this, signature, message, [&]() { return verifyUncached(signature, message); });
+}
+
+bool PublicKey::verifyUncached(const Data& signature, const Data& message) const {
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
     case TWPublicKeyTypeSECP256k1Extended:
@@ -157,7 +167,9 @@ bool PublicKey::verifySchnorr(const Data& signature, const Data& message) const
     switch (type) {
     case TWPublicKeyTypeSECP256k1:
     case TWPublicKeyTypeSECP256k1Extended:
-        return zil_schnorr_verify(&secp256k1, bytes.data(), signature.data(), message.data(), static_cast<uint32_t>(message.size())) == 0;
+        return cachedVerify(SignatureCache::SchemeVerifySchnorr, *this, signature, message, [&]() {
+            return zil_schnorr_verify(&secp256k1, bytes.data(), signature.data(), message.data(), static_cast<uint32_t>(message.size())) == 0;
+        });
     case TWPublicKeyTypeNIST256p1:
     case TWPublicKeyTypeNIST256p1Extended:
     case TWPublicKeyTypeED25519:
@@ -169,7 +181,71 @@ bool PublicKey::verifySchnorr(const Data& signature, const Data& message) const
     }
 }
 
-Data PublicKey::hash(const Data& prefix, Hash::Hasher hasher, bool skipTypeByte) const {
+namespace {
+
+/// Inputs of a call to ed25519_sign_open_batch*
+struct Ed25519Batch {
+    std::vector<size_t> indices;
+    std::vector<const unsigned char*> messages;
+    std::vector<size_t> messageSizes;
+    std::vector<const unsigned char*> publicKeys;
+    std::vector<const unsigned char*> signatures;
+
+    void add(size_t index, const PublicKey& publicKey, const Data& message, const Data& signature) {
+        indices.push_back(index);
+        messages.push_back(message.data());
+        messageSizes.push_back(message.size());
+        publicKeys.push_back(publicKey.bytes.data());
+        signatures.push_back(signature.data());
+    }
+
+    template <typename Open>
+    void verify(Open open, std::vector<bool>& valid) {
+        if (indices.empty()) {
+            return;
+        }
+        std::vector<int> results(indices.size(), 0);
+        open(messages.data(), messageSizes.data(), publicKeys.data(), signatures.data(), indices.size(), results.data());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            valid[indices[i]] = results[i] != 0;
+        }
+    }
+};
+
+} // namespace
+
+bool PublicKey::verifyBatch(const std::vector<PublicKey>& publicKeys, const std::vector<Data>& messages, const std::vector<Data>& signatures, std::vector<bool>& valid) {
+    if (messages.size() != publicKeys.size() || signatures.size() != publicKeys.size()) {
+        throw std::invalid_argument("Batch inputs have different sizes");
+    }
+    valid.assign(publicKeys.size(), false);
+
+    auto ed25519 = Ed25519Batch();
+    auto blake2b = Ed25519Batch();
+    for (size_t i = 0; i < publicKeys.size(); ++i) {
+        const auto& publicKey = publicKeys[i];
+        if (publicKey.type != TWPublicKeyTypeED25519 && publicKey.type != TWPublicKeyTypeED25519Blake2b) {
+            valid[i] = publicKey.verify(signatures[i], messages[i]);
+            continue;
+        }
+        if (signatures[i].size() != sizeof(ed25519_signature)) {
+            continue;
+        }
+        auto& batch = publicKey.type == TWPublicKeyTypeED25519 ? ed25519 : blake2b;
+        batch.add(i, publicKey, messages[i], signatures[i]);
+    }
+    ed25519.verify(ed25519_sign_open_batch, valid);
+    blake2b.verify(ed25519_sign_open_batch_blake2b, valid);
+
+    return std::find(valid.begin(), valid.end(), false) == valid.end();
+}
+
+bool PublicKey::verifyBatch(const std::vector<PublicKey>& publicKeys, const std::vector<Data>& messages, const std::vector<Data>& signatures) {
+    auto valid = std::vector<bool>();
+    return verifyBatch(publicKeys, messages, signatures, valid);
+}
+
+Data PublicKey::hash(DataView prefix, Hash::Hasher hasher, bool skipTypeByte) const {
     const auto offset = std::size_t(skipTypeByte ? 1 : 0);
     const auto hash = hasher(bytes.data() + offset, bytes.size() - offset);
 
@@ -180,21 +256,62 @@ Data PublicKey::hash(const Data& prefix, Hash::Hasher hasher, bool skipTypeByte)
     return result;
 }
 
-PublicKey PublicKey::recover(const Data& signature, const Data& message) {
-    if (signature.size() < 65) {
-        throw std::invalid_argument("signature too short");
+/// Recovers the uncompressed public key into `result` (65 bytes), returns false on failure.
+static bool recoverBytes(const Data& signature, const Data& message, Data& result) {
+    auto& cache = SignatureCache::shared();
+    SignatureCache::Key key;
+    if (cache.enabled()) {
+        key = cache.key(SignatureCache::SchemeRecover, 0, {}, signature, message);
+        if (cache.find(key, &result)) {
+            return true;
+        }
     }
     auto v = signature[64];
     if (v >= 27) {
         v -= 27;
     }
-    TW::Data result(65);
+    result.resize(65);
     if (ecdsa_recover_pub_from_sig(&secp256k1, result.data(), signature.data(), message.data(), v) != 0) {
+        return false;
+    }
+    if (cache.enabled()) {
+        cache.insert(key, result);
+    }
+    return true;
+}
+
+PublicKey PublicKey::recover(const Data& signature, const Data& message) {
+    if (signature.size() < 65) {
+        throw std::invalid_argument("signature too short");
+    }
+    TW::Data result;
+    if (!recoverBytes(signature, message, result)) {
         throw std::invalid_argument("recover failed");
     }
     return PublicKey(result, TWPublicKeyTypeSECP256k1Extended);
 }
 
+std::vector<std::optional<PublicKey>> PublicKey::recoverMany(const std::vector<Data>& signatures, const std::vector<Data>& messages, size_t threadCount) {
+    if (messages.size() != signatures.size()) {
+        throw std::invalid_argument("Batch inputs have different sizes");
+    }
+    const auto count = signatures.size();
+    std::vector<std::optional<PublicKey>> results(count);
+    std::atomic<size_t> next(0);
+    const auto worker = [&]() {
+        Data bytes;
+        for (auto index = next++; index < count; index = next++) {
+            const auto& signature = signatures[index];
+            const auto& message = messages[index];
+            if (signature.size() >= 65 && message.size() >= 32 && recoverBytes(signature, message, bytes)) {
+                results[index] = PublicKey(bytes, TWPublicKeyTypeSECP256k1Extended);
+            }
+        }
+    };
+    ThreadPool::shared().run(threadCount, count, worker);
+    return results;
+}
+
 bool PublicKey::isValidED25519() const {
     if (type != TWPublicKeyTypeED25519) {
         return false;
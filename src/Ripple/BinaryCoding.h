@@ -42,7 +42,7 @@ inline void encodeVariableLength(size_t length, std::vector<uint8_t>& data) {
 }
 
 /// Encodes a variable length bytes.
-inline void encodeBytes(std::vector<uint8_t> bytes, std::vector<uint8_t>& data) {
+inline void encodeBytes(const std::vector<uint8_t>& bytes, std::vector<uint8_t>& data) {
     encodeVariableLength(bytes.size(), data);
     data.insert(data.end(), bytes.begin(), bytes.end());
 }
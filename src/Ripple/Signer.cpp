@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "BinaryCoding.h"
 #include "../BinaryCoding.h"
 #include "../Hash.h"
 
@@ -26,11 +27,26 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         /* destination_tag*/input.destination_tag()
     );
 
-    auto signer = Signer();
-    signer.sign(key, transaction);
+    transaction.flags |= fullyCanonical;
+    transaction.pub_key = key.getPublicKey(TWPublicKeyTypeSECP256k1).bytes.toData();
+
+    // Serialize the unsigned fields once, hash them behind the prefix,
+    // then splice the signature field in before the account fields.
+    auto encoded = Data();
+    encoded.reserve(256);
+    transaction.serializeHead(encoded);
+    const auto signatureOffset = encoded.size();
+    transaction.serializeTail(encoded);
+
+    const auto hash = Transaction::sha512Half(Transaction::signingPrefix, encoded);
+    const auto signature = key.signAsDER(hash, TWCurveSECP256k1);
+
+    auto signatureField = Data();
+    encodeType(FieldType::vl, 4, signatureField);
+    encodeBytes(signature, signatureField);
+    encoded.insert(encoded.begin() + signatureOffset, signatureField.begin(), signatureField.end());
 
     auto output = Proto::SigningOutput();
-    auto encoded = transaction.serialize();
     output.set_encoded(encoded.data(), encoded.size());
     return output;
 }
@@ -38,11 +54,7 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 void Signer::sign(const PrivateKey& privateKey, Transaction& transaction) const noexcept {
     /// See https://github.com/trezor/trezor-core/blob/master/src/apps/ripple/sign_tx.py#L59
     transaction.flags |= fullyCanonical;
-    transaction.pub_key = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
-
-    auto unsignedTx = transaction.getPreImage();
-    auto hash = Hash::sha512(unsignedTx);
-    auto half = Data(hash.begin(), hash.begin() + 32);
+    transaction.pub_key = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes.toData();
 
-    transaction.signature = privateKey.signAsDER(half, TWCurveSECP256k1);
+    transaction.signature = privateKey.signAsDER(transaction.signingHash(), TWCurveSECP256k1);
 }
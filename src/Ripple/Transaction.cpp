@@ -7,16 +7,34 @@
 #include "BinaryCoding.h"
 #include "Transaction.h"
 #include "../BinaryCoding.h"
+#include "../Hashers.h"
 #include "../HexCoding.h"
 
 using namespace TW;
 using namespace TW::Ripple;
 
-const int NETWORK_PREFIX = 0x53545800;
+/// Upper bound of a serialized payment with a DER signature, to allocate the buffer once.
+static const size_t maxSerializedSize = 256;
 
 Data Transaction::serialize() const {
     auto data = Data();
+    data.reserve(maxSerializedSize);
+    serialize(data);
+    return data;
+}
+
+void Transaction::serialize(Data& data) const {
     /// field must be sorted by field type then by field name
+    serializeHead(data);
+    /// "txnSignature"
+    if (!signature.empty()) {
+        encodeType(FieldType::vl, 4, data);
+        encodeBytes(signature, data);
+    }
+    serializeTail(data);
+}
+
+void Transaction::serializeHead(Data& data) const {
     /// "type"
     encodeType(FieldType::int16, 2, data);
     encode16BE(uint16_t(TransactionType::payment), data);
@@ -38,50 +56,75 @@ Data Transaction::serialize() const {
     }
     /// "amount"
     encodeType(FieldType::amount, 1, data);
-    append(data, serializeAmount(amount));
+    encodeAmount(amount, data);
     /// "fee"
     encodeType(FieldType::amount, 8, data);
-    append(data, serializeAmount(fee));
+    encodeAmount(fee, data);
     /// "signingPubKey"
     if (!pub_key.empty()) {
         encodeType(FieldType::vl, 3, data);
         encodeBytes(pub_key, data);
     }
-    /// "txnSignature"
-    if (!signature.empty()) {
-        encodeType(FieldType::vl, 4, data);
-        encodeBytes(signature, data);
-    }
+}
+
+void Transaction::serializeTail(Data& data) const {
     /// "account"
     encodeType(FieldType::account, 1, data);
-    encodeBytes(serializeAddress(account), data);
+    encodeAddress(account, data);
     /// "destination"
     encodeType(FieldType::account, 3, data);
     encodeBytes(destination, data);
-    return data;
 }
 
 Data Transaction::getPreImage() const {
     auto preImage = Data();
-    encode32BE(NETWORK_PREFIX, preImage);
-    append(preImage, serialize());
+    preImage.reserve(4 + maxSerializedSize);
+    encode32BE(signingPrefix, preImage);
+    serialize(preImage);
     return preImage;
 }
 
+Data Transaction::signingHash() const {
+    auto data = Data();
+    data.reserve(maxSerializedSize);
+    serialize(data);
+    return sha512Half(signingPrefix, data);
+}
+
+Data Transaction::sha512Half(uint32_t prefix, const Data& data) {
+    const byte prefixBytes[] = {
+        static_cast<byte>(prefix >> 24), static_cast<byte>(prefix >> 16),
+        static_cast<byte>(prefix >> 8), static_cast<byte>(prefix)};
+    const auto hash = Hash::Sha512Hasher()
+        .update(DataView(prefixBytes, sizeof(prefixBytes)))
+        .update(data)
+        .final();
+    return Data(hash.begin(), hash.begin() + 32);
+}
+
 Data Transaction::serializeAmount(int64_t amount) {
+    auto data = Data();
+    encodeAmount(amount, data);
+    return data;
+}
+
+void Transaction::encodeAmount(int64_t amount, Data& data) {
     if (amount < 0) {
-        return Data();
+        return;
     }
-    auto data = Data();
+    const auto start = data.size();
     encode64BE(uint64_t(amount), data);
     /// clear first bit to indicate XRP
-    data[0] &= 0x7F;
+    data[start] &= 0x7F;
     /// set second bit to indicate positive number
-    data[0] |= 0x40;
-    return data;
+    data[start] |= 0x40;
 }
 
-Data Transaction::serializeAddress(Address address) {
-    auto data = Data(&address.bytes[0] + 1, &address.bytes[21]);
-    return data;
+Data Transaction::serializeAddress(const Address& address) {
+    return Data(address.bytes.begin() + 1, address.bytes.end());
+}
+
+void Transaction::encodeAddress(const Address& address, Data& data) {
+    encodeVariableLength(Address::size - 1, data);
+    data.insert(data.end(), address.bytes.begin() + 1, address.bytes.end());
 }
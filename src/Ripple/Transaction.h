@@ -63,13 +63,37 @@ class Transaction {
         }
 
   public:
+    /// Hash prefix of the signing preimage ("STX\0").
+    static const uint32_t signingPrefix = 0x53545800;
+
     /// simplified serialization format tailored for Payment transaction type
     /// exclusively.
     Data serialize() const;
     Data getPreImage() const;
 
+    /// Appends the serialized transaction to `data`.
+    void serialize(Data& data) const;
+
+    /// Appends the fields preceding the signature field.
+    void serializeHead(Data& data) const;
+
+    /// Appends the fields following the signature field.
+    void serializeTail(Data& data) const;
+
+    /// Returns the hash to sign, the SHA-512 half of the preimage, without building the preimage.
+    Data signingHash() const;
+
+    /// Returns the first 32 bytes of the SHA-512 hash of `prefix` (big endian) followed by `data`.
+    static Data sha512Half(uint32_t prefix, const Data& data);
+
     static Data serializeAmount(int64_t amount);
-    static Data serializeAddress(Address address);
+    static Data serializeAddress(const Address& address);
+
+    /// Appends the amount encoding, nothing for negative amounts.
+    static void encodeAmount(int64_t amount, Data& data);
+
+    /// Appends the length-prefixed account ID of the address.
+    static void encodeAddress(const Address& address, Data& data);
 };
 
 } // namespace TW::Ripple
@@ -0,0 +1,96 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SS58Address.h"
+
+#include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/blake2b_hw.h>
+
+#include <algorithm>
+
+using namespace TW;
+
+/// Blake2b-512 state having absorbed the "SS58PRE" prefix.
+static const blake2b_state& checksumState() {
+    static const auto state = [] {
+        blake2b_state state;
+        blake2b_Init(&state, 64);
+        blake2b_Update(&state, SS58Prefix.data(), SS58Prefix.size());
+        return state;
+    }();
+    return state;
+}
+
+/// Decodes an address with its checksum, without allocations; false if it is not of the network.
+static bool decode(const std::string& string, byte network, std::array<byte, SS58Address::encodedSize>& decoded) {
+    return Base58::bitcoin.decode(string, decoded) && decoded[0] == network;
+}
+
+std::array<byte, SS58Address::checksumSize> SS58Address::computeChecksum(const byte* data, size_t size) {
+    auto state = checksumState();
+    blake2b_Update(&state, data, size);
+    std::array<byte, 64> hash;
+    blake2b_Final(&state, hash.data(), hash.size());
+    std::array<byte, checksumSize> checksum;
+    std::copy(hash.begin(), hash.begin() + checksumSize, checksum.begin());
+    return checksum;
+}
+
+bool SS58Address::isValid(const std::string& string, byte network) {
+    std::array<byte, encodedSize> decoded;
+    if (!decode(string, network, decoded)) {
+        return false;
+    }
+    const auto checksum = computeChecksum(decoded.data(), size);
+    return std::equal(checksum.begin(), checksum.end(), decoded.begin() + size);
+}
+
+std::vector<bool> SS58Address::isValid(const std::vector<std::string>& strings, byte network) {
+    // Addresses decoded, then hashed, at a time
+    const size_t chunkSize = 64;
+
+    std::vector<bool> valid(strings.size(), false);
+    std::array<std::array<byte, encodedSize>, chunkSize> decoded;
+    std::array<const byte*, chunkSize> pointers;
+    std::array<size_t, chunkSize> sizes;
+    std::array<size_t, chunkSize> indices;
+    std::array<byte, chunkSize * 64> hashes;
+    for (size_t first = 0; first < strings.size(); first += chunkSize) {
+        const auto last = std::min(first + chunkSize, strings.size());
+        size_t count = 0;
+        for (auto i = first; i < last; ++i) {
+            if (decode(strings[i], network, decoded[count])) {
+                pointers[count] = decoded[count].data();
+                sizes[count] = size;
+                indices[count] = i;
+                ++count;
+            }
+        }
+        blake2b_batch(&checksumState(), pointers.data(), sizes.data(), count, hashes.data());
+        for (size_t j = 0; j < count; ++j) {
+            const auto hash = hashes.begin() + j * 64;
+            valid[indices[j]] = std::equal(hash, hash + checksumSize, decoded[j].begin() + size);
+        }
+    }
+    return valid;
+}
+
+SS58Address::SS58Address(const std::string& string, byte network) {
+    std::array<byte, encodedSize> decoded;
+    if (!decode(string, network, decoded) ||
+        computeChecksum(decoded.data(), size) != std::array<byte, checksumSize>{decoded[size], decoded[size + 1]}) {
+        throw std::invalid_argument("Invalid address string");
+    }
+    std::copy(decoded.begin(), decoded.begin() + size, bytes.begin());
+}
+
+std::string SS58Address::string() const {
+    std::array<byte, encodedSize> encoded;
+    std::copy(bytes.begin(), bytes.end(), encoded.begin());
+    const auto checksum = computeChecksum(bytes.data(), size);
+    std::copy(checksum.begin(), checksum.end(), encoded.begin() + size);
+    return Base58::bitcoin.encode(encoded);
+}
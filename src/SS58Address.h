@@ -13,6 +13,7 @@
 #include <array>
 #include <string>
 #include <iostream>
+#include <vector>
 
 const std::string SS58Prefix = "SS58PRE";
 
@@ -25,47 +26,32 @@ class SS58Address {
 
     static const size_t checksumSize = 2;
 
+    /// Size of an address with its checksum, as encoded in Base58.
+    static const size_t encodedSize = size + checksumSize;
+
     /// Address data consisting of a network byte followed by the public key.
     std::array<byte, size> bytes;
 
     /// Determines whether a string makes a valid address
-    static bool isValid(const std::string& string, byte network) {
-        const auto decoded = Base58::bitcoin.decode(string);
-        if (decoded.size() != SS58Address::size + checksumSize) {
-            return false;
-        }
-        // check network
-        if (decoded[0] != network) {
-            return false;
-        }
-        auto checksum = computeChecksum(Data(decoded.begin(), decoded.end() - checksumSize));
-        // compare checksum
-        if (!std::equal(decoded.end() - checksumSize, decoded.end(), checksum.begin())) {
-            return false;
-        }
-        return true;
-    }
+    static bool isValid(const std::string& string, byte network);
+
+    /// Determines whether each string makes a valid address, in the same order as `strings`.
+    /// The checksums are hashed several at a time if the CPU supports it.
+    static std::vector<bool> isValid(const std::vector<std::string>& strings, byte network);
+
+    /// Computes the checksum of address data, with the Blake2b state of the "SS58PRE" prefix computed once.
+    static std::array<byte, checksumSize> computeChecksum(const byte* data, size_t size);
 
     template <typename T>
     static Data computeChecksum(const T& data) {
-        auto prefix = Data(SS58Prefix.begin(), SS58Prefix.end());
-        append(prefix, Data(data.begin(), data.end()));
-        auto hash = Hash::blake2b(prefix, 64);
-        auto checksum = Data(checksumSize);
-        std::copy(hash.begin(), hash.begin() + checksumSize, checksum.data());
-        return checksum;
+        const auto checksum = computeChecksum(data.data(), data.size());
+        return Data(checksum.begin(), checksum.end());
     }
 
     SS58Address() = default;
 
     /// Initializes an address with a string representation.
-    SS58Address(const std::string& string, byte network) {
-        if (!isValid(string, network)) {
-            throw std::invalid_argument("Invalid address string");
-        }
-        const auto decoded = Base58::bitcoin.decode(string);
-        std::copy(decoded.begin(), decoded.end() - checksumSize, bytes.begin());
-    }
+    SS58Address(const std::string& string, byte network);
 
     /// Initializes an address with a public key and network.
     SS58Address(const PublicKey& publicKey, byte network) {
@@ -77,12 +63,7 @@ class SS58Address {
     }
 
     /// Returns a string representation of the address.
-    std::string string() const {
-        auto result = Data(bytes.begin(), bytes.end());
-        auto checksum = computeChecksum(bytes);
-        append(result, checksum);
-        return Base58::bitcoin.encode(result);
-    }
+    std::string string() const;
 
     /// Returns public key bytes
     Data keyBytes() const { 
@@ -0,0 +1,283 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Secp256k1Comb.h"
+#include "Hash.h"
+#include "LockedMemory.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/secp256k1.h>
+#include <TrezorCrypto/secp256k1_comb.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace TW;
+
+namespace {
+
+/// Table built in memory, or mapped from a file written by writeTable.
+struct Table {
+    std::vector<uint64_t> built;
+    void* mapping = nullptr;
+    std::size_t mappingSize = 0;
+    const uint64_t* words = nullptr;
+    std::size_t size = 0;
+
+    Table() = default;
+    Table(const Table&) = delete;
+    Table& operator=(const Table&) = delete;
+    ~Table() {
+        if (mapping != nullptr) {
+            munmap(mapping, mappingSize);
+        }
+    }
+};
+
+/// Header of a table file, followed by the table.  64 bytes, so that the table is aligned in the mapping.
+struct FileHeader {
+    std::array<char, 8> magic;
+    /// Layout of the table, changed with the table format of secp256k1_comb.
+    uint32_t version;
+    uint32_t window;
+    uint64_t tableSize;
+    /// Tables are arrays of native 64-bit words.
+    uint64_t byteOrder;
+    /// SHA-256 of the table.
+    std::array<byte, 32> checksum;
+};
+static_assert(sizeof(FileHeader) == 64, "Unexpected table file header size");
+
+constexpr std::array<char, 8> fileMagic = {'T', 'W', 'S', 'C', 'O', 'M', 'B', '\0'};
+constexpr uint32_t fileVersion = 1;
+constexpr uint64_t fileByteOrder = 0x0102030405060708;
+
+std::mutex mutex;
+int windowWidth = Secp256k1Comb::defaultWindow;
+std::shared_ptr<const Table> table;
+/// Whether the pages of `table` were locked by `prefault`.
+bool tableLocked = false;
+
+std::shared_ptr<const Table> buildTable(int width) {
+    auto built = std::make_shared<Table>();
+    built->built.resize(secp256k1_comb_table_size(width) / sizeof(uint64_t));
+    secp256k1_comb_build(built->built.data(), width);
+    built->words = built->built.data();
+    built->size = built->built.size() * sizeof(uint64_t);
+    return built;
+}
+
+/// Whether `current` gives the public key of a fixed key that trezor-crypto gives, a check of a mapped table.
+bool computesPublicKeys(const Table& current, int width) {
+    const auto key = Hash::sha256(TW::data("Secp256k1Comb table check"));
+    byte expected[33];
+    byte computed[33];
+    ecdsa_get_public_key33(&secp256k1, key.data(), expected);
+    return secp256k1_comb_get_public_key33(current.words, width, key.data(), computed) == 0 &&
+           std::memcmp(expected, computed, sizeof(expected)) == 0;
+}
+
+/// Maps a table file written by writeTable, nullptr if it cannot be read or is not a valid table file.
+std::shared_ptr<const Table> mapFile(const std::string& path, int& width) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat status;
+    if (fstat(fd, &status) != 0 || !S_ISREG(status.st_mode) || static_cast<std::size_t>(status.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        return nullptr;
+    }
+    auto mapped = std::make_shared<Table>();
+    mapped->mappingSize = static_cast<std::size_t>(status.st_size);
+    // shared with the other processes mapping the file, read-only
+    void* mapping = mmap(nullptr, mapped->mappingSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    mapped->mapping = mapping;
+
+    FileHeader header;
+    std::memcpy(&header, mapping, sizeof(header));
+    const auto tableSize = secp256k1_comb_table_size(static_cast<int>(header.window));
+    if (header.magic != fileMagic || header.version != fileVersion || header.byteOrder != fileByteOrder ||
+        tableSize == 0 || header.tableSize != tableSize || mapped->mappingSize != sizeof(FileHeader) + tableSize) {
+        return nullptr;
+    }
+    mapped->words = reinterpret_cast<const uint64_t*>(static_cast<const byte*>(mapping) + sizeof(FileHeader));
+    mapped->size = tableSize;
+    const auto checksum = Hash::sha256Digest(DataView(reinterpret_cast<const byte*>(mapped->words), tableSize));
+    if (!std::equal(checksum.begin(), checksum.end(), header.checksum.begin()) ||
+        !computesPublicKeys(*mapped, static_cast<int>(header.window))) {
+        return nullptr;
+    }
+    width = static_cast<int>(header.window);
+    return mapped;
+}
+
+/// Returns the table for the current window width, building it if needed; nullptr if disabled.
+std::shared_ptr<const Table> currentTable(int& width) {
+    std::lock_guard<std::mutex> lock(mutex);
+    width = windowWidth;
+    if (width == 0 || !secp256k1_comb_supported()) {
+        return nullptr;
+    }
+    if (!table) {
+        table = buildTable(width);
+    }
+    return table;
+}
+
+} // namespace
+
+void Secp256k1Comb::setWindow(int window) {
+    if (window != 0 && (window < SECP256K1_COMB_MIN_WINDOW || window > SECP256K1_COMB_MAX_WINDOW)) {
+        throw std::invalid_argument("Unsupported window width");
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (window != windowWidth) {
+        windowWidth = window;
+        // keys being computed keep their reference to the old table
+        if (tableLocked) {
+            unlockMemory(table->words, table->size);
+            tableLocked = false;
+        }
+        table.reset();
+    }
+}
+
+int Secp256k1Comb::window() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return windowWidth;
+}
+
+std::size_t Secp256k1Comb::tableSize() {
+    const auto width = window();
+    return width == 0 ? 0 : secp256k1_comb_table_size(width);
+}
+
+bool Secp256k1Comb::prefault(bool lock) {
+    int width = 0;
+    const auto current = currentTable(width);
+    if (!current) {
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(mutex);
+    if (current != table) {
+        // replaced meanwhile
+        return false;
+    }
+    const auto locked = prefaultMemory(current->words, current->size, lock && !tableLocked);
+    tableLocked = tableLocked || locked;
+    return tableLocked;
+}
+
+void Secp256k1Comb::writeTable(const std::string& path, int window) {
+    if (window < SECP256K1_COMB_MIN_WINDOW || window > SECP256K1_COMB_MAX_WINDOW) {
+        throw std::invalid_argument("Unsupported window width");
+    }
+    if (!secp256k1_comb_supported()) {
+        throw std::invalid_argument("Comb tables are not supported on this platform");
+    }
+    const auto built = buildTable(window);
+    FileHeader header;
+    header.magic = fileMagic;
+    header.version = fileVersion;
+    header.window = static_cast<uint32_t>(window);
+    header.tableSize = built->size;
+    header.byteOrder = fileByteOrder;
+    header.checksum = Hash::sha256Digest(DataView(reinterpret_cast<const byte*>(built->words), built->size));
+
+    // written next to the file and renamed, so that processes never map a partial table
+    const auto temporary = path + ".tmp";
+    {
+        std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(reinterpret_cast<const char*>(built->words), static_cast<std::streamsize>(built->size));
+        if (!stream.flush()) {
+            std::remove(temporary.c_str());
+            throw std::invalid_argument("Can't write table file");
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::invalid_argument("Can't write table file");
+    }
+}
+
+bool Secp256k1Comb::mapTable(const std::string& path) {
+    if (!secp256k1_comb_supported()) {
+        return false;
+    }
+    int width = 0;
+    auto mapped = mapFile(path, width);
+    if (!mapped) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    // keys being computed keep their reference to the old table
+    if (tableLocked) {
+        unlockMemory(table->words, table->size);
+        tableLocked = false;
+    }
+    windowWidth = width;
+    table = std::move(mapped);
+    return true;
+}
+
+bool Secp256k1Comb::isMapped() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return table && table->mapping != nullptr;
+}
+
+std::optional<Data> Secp256k1Comb::publicKey(DataView privateKey, bool compressed) {
+    Data result(compressed ? 33 : 65);
+    if (!publicKey(privateKey, compressed, result.data())) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+bool Secp256k1Comb::publicKey(DataView privateKey, bool compressed, byte* output) {
+    if (privateKey.size() != 32) {
+        return false;
+    }
+    int width = 0;
+    const auto current = currentTable(width);
+    if (!current) {
+        return false;
+    }
+    const auto status = compressed
+        ? secp256k1_comb_get_public_key33(current->words, width, privateKey.data(), output)
+        : secp256k1_comb_get_public_key65(current->words, width, privateKey.data(), output);
+    return status == 0;
+}
+
+bool Secp256k1Comb::publicKeys(const byte* privateKeys, std::size_t count, bool compressed, byte* output) {
+    int width = 0;
+    const auto current = currentTable(width);
+    if (!current) {
+        return false;
+    }
+    const auto status = compressed
+        ? secp256k1_comb_get_public_keys33(current->words, width, privateKeys, count, output)
+        : secp256k1_comb_get_public_keys65(current->words, width, privateKeys, count, output);
+    return status == 0;
+}
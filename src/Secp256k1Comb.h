@@ -0,0 +1,77 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstddef>
+#include <optional>
+#include <string>
+
+/// Fast secp256k1 public key computation, with a precomputed table of generator multiples.
+///
+/// The table is shared, built on first use and thread-safe; it can also be written to a file once and mapped by
+/// every process, which then share its pages instead of building their own (see mapTable).
+/// Its memory footprint is set by the window width: 16 KB for 2 bits, 88 KB for 6 bits, 256 KB for 8 bits;
+/// wider windows need less point additions per key.
+namespace TW::Secp256k1Comb {
+
+static constexpr int defaultWindow = 6;
+
+/// Sets the window width of the table, 0 disables the fast path.  The table is rebuilt on next use.
+///
+/// @throws std::invalid_argument if the width is not supported.
+void setWindow(int window);
+
+/// Current window width, 0 if disabled.
+int window();
+
+/// Size in bytes of the table once built, 0 if disabled or not available.
+std::size_t tableSize();
+
+/// Writes the table of a window width to a file for mapTable: a versioned header with the SHA-256 of the table,
+/// followed by the table.  The file is written to a temporary file and renamed.
+///
+/// Tables are computed for the platform writing them (byte order); write them where they are used, for instance
+/// at installation.
+///
+/// @throws std::invalid_argument if the width is not supported, the platform has no comb tables, or the file
+/// cannot be written.
+void writeTable(const std::string& path, int window);
+
+/// Uses the table of a file written by writeTable, mapped read-only: the processes mapping the same file share its
+/// pages, so that wider windows cost neither binary size nor memory per process.  The window width becomes the one
+/// of the file, until setWindow changes it and builds a table in memory.
+///
+/// Returns false, keeping the current table, if the file cannot be read, was written for another version or
+/// platform, or fails its checksum or a known answer test.
+bool mapTable(const std::string& path);
+
+/// Whether the current table is mapped from a file.
+bool isMapped();
+
+/// Builds the table if needed and maps its pages, locking them in RAM if `lock` (best effort) until the table is
+/// rebuilt.  Returns whether the table is locked.
+bool prefault(bool lock);
+
+/// Computes the compressed (33 bytes) or uncompressed (65 bytes) public key of a 32-byte private key.
+///
+/// Returns nullopt if the fast path is disabled or not available on the platform, or if the key is invalid.
+std::optional<Data> publicKey(DataView privateKey, bool compressed);
+
+/// Same as above, writing the public key into `output` (33 or 65 bytes); returns false where the above returns nullopt.
+bool publicKey(DataView privateKey, bool compressed, byte* output);
+
+/// Computes the public keys of `count` private keys of 32 bytes stored one after the other, into `output`
+/// (33 or 65 bytes per key).  The keys share a single field inversion (per batch of 32) for the conversion
+/// to affine coordinates, the most expensive step of a single key after the point additions.
+///
+/// Returns false if the fast path is disabled or not available, or if a key is invalid; the output of the
+/// invalid keys is zeroed.
+bool publicKeys(const byte* privateKeys, std::size_t count, bool compressed, byte* output);
+
+} // namespace TW::Secp256k1Comb
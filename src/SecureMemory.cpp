@@ -0,0 +1,147 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SecureMemory.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <new>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace TW;
+
+namespace {
+
+constexpr std::size_t slotAlignment = 32;
+
+} // namespace
+
+SecureArena& SecureArena::shared() {
+    // leaked: containers in static objects may be freed after static destructors ran
+    static auto* arena = new SecureArena(sharedSlotCount);
+    return *arena;
+}
+
+SecureArena::SecureArena(std::size_t slotCount) : slotCount(slotCount) {
+    std::size_t slotsSize = 0;
+    for (const auto size : slotSizes) {
+        slotsSize += size * slotCount;
+    }
+#ifndef _WIN32
+    const auto page = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    regionSize = (slotsSize + page - 1) / page * page;
+    mappingSize = regionSize + 2 * page;
+    void* memory = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (memory == MAP_FAILED) {
+        throw std::bad_alloc();
+    }
+    mapping = static_cast<byte*>(memory);
+    region = mapping + page;
+    // overflows and underflows of the slots fault instead of reaching other memory
+    mprotect(mapping, page, PROT_NONE);
+    mprotect(region + regionSize, page, PROT_NONE);
+    locked = regionSize == 0 || mlock(region, regionSize) == 0;
+#ifdef MADV_DONTDUMP
+    madvise(mapping, mappingSize, MADV_DONTDUMP);
+#endif
+#else
+    regionSize = slotsSize;
+    region = static_cast<byte*>(::operator new(regionSize == 0 ? 1 : regionSize, std::align_val_t(slotAlignment)));
+    memzero(region, regionSize);
+#endif
+
+    auto* begin = region;
+    for (std::size_t i = 0; i < slotSizes.size(); ++i) {
+        auto& slots = classes[i];
+        slots.begin = begin;
+        slots.size = slotSizes[i];
+        slots.free.reserve(slotCount);
+        // lowest addresses first
+        for (std::size_t index = slotCount; index > 0; --index) {
+            slots.free.push_back(index - 1);
+        }
+        begin += slots.size * slotCount;
+    }
+}
+
+SecureArena::~SecureArena() {
+    memzero(region, regionSize);
+#ifndef _WIN32
+    if (locked && regionSize != 0) {
+        munlock(region, regionSize);
+    }
+    munmap(mapping, mappingSize);
+#else
+    ::operator delete(region, std::align_val_t(slotAlignment));
+#endif
+}
+
+void* SecureArena::allocate(std::size_t size) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& slots : classes) {
+            if (size <= slots.size && !slots.free.empty()) {
+                const auto index = slots.free.back();
+                slots.free.pop_back();
+                return slots.begin + index * slots.size;
+            }
+        }
+        ++heapCount;
+    }
+    try {
+        return ::operator new(size, std::align_val_t(slotAlignment));
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        --heapCount;
+        throw;
+    }
+}
+
+void SecureArena::deallocate(void* pointer, std::size_t size) noexcept {
+    if (pointer == nullptr) {
+        return;
+    }
+    auto* bytes = static_cast<byte*>(pointer);
+    if (!owns(bytes)) {
+        memzero(bytes, size);
+        ::operator delete(bytes, std::align_val_t(slotAlignment));
+        std::lock_guard<std::mutex> lock(mutex);
+        --heapCount;
+        return;
+    }
+    for (auto& slots : classes) {
+        if (bytes < slots.begin + slots.size * slotCount) {
+            // the whole slot: a container may have written past `size` in its capacity
+            memzero(bytes, slots.size);
+            std::lock_guard<std::mutex> lock(mutex);
+            slots.free.push_back(static_cast<std::size_t>(bytes - slots.begin) / slots.size);
+            return;
+        }
+    }
+}
+
+bool SecureArena::owns(const void* pointer) const {
+    const auto* bytes = static_cast<const byte*>(pointer);
+    return bytes >= region && bytes < region + regionSize;
+}
+
+std::size_t SecureArena::slotsInUse() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::size_t count = 0;
+    for (const auto& slots : classes) {
+        count += slotCount - slots.free.size();
+    }
+    return count;
+}
+
+std::size_t SecureArena::heapInUse() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return heapCount;
+}
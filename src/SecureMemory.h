@@ -0,0 +1,109 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <array>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Arena for small secrets (keys, seeds, mnemonics): fixed-size slots in a region locked in RAM
+/// where the platform allows it, excluded from core dumps, between two inaccessible guard
+/// pages. Slots are wiped when freed.
+///
+/// Requests larger than the largest slot, or made when all the fitting slots are in use, are
+/// served from the heap and wiped when freed as well. Thread-safe.
+class SecureArena {
+  public:
+    /// Slot sizes, each a multiple of the alignment of the slots.
+    static constexpr std::array<std::size_t, 5> slotSizes = {32, 64, 128, 256, 512};
+
+    /// Number of slots of each size in the shared arena.
+    static constexpr std::size_t sharedSlotCount = 64;
+
+    /// Arena used by SecureAllocator, never destroyed so that static objects can free into it.
+    static SecureArena& shared();
+
+    /// Maps an arena with `slotCount` slots of each size.
+    ///
+    /// @throws std::bad_alloc if the memory cannot be mapped.
+    explicit SecureArena(std::size_t slotCount);
+    ~SecureArena();
+
+    SecureArena(const SecureArena&) = delete;
+    SecureArena& operator=(const SecureArena&) = delete;
+
+    /// Returns at least `size` bytes, aligned for any type of at most 32 bytes alignment.
+    ///
+    /// @throws std::bad_alloc if a heap fallback fails.
+    void* allocate(std::size_t size);
+
+    /// Wipes and releases memory returned by allocate() with the same `size`.
+    void deallocate(void* pointer, std::size_t size) noexcept;
+
+    /// Whether `pointer` is in a slot of this arena (as opposed to a heap fallback).
+    bool owns(const void* pointer) const;
+
+    /// Whether the slots could be locked in RAM; locking is best effort (limited by RLIMIT_MEMLOCK for instance).
+    bool isLocked() const { return locked; }
+
+    /// Number of slots in use.
+    std::size_t slotsInUse() const;
+
+    /// Number of live heap fallbacks.
+    std::size_t heapInUse() const;
+
+  private:
+    struct SlotClass {
+        byte* begin = nullptr;
+        std::size_t size = 0;
+        /// Indices of the free slots.
+        std::vector<std::size_t> free;
+    };
+
+    byte* mapping = nullptr;
+    std::size_t mappingSize = 0;
+    /// Slots, between the guard pages.
+    byte* region = nullptr;
+    std::size_t regionSize = 0;
+    std::size_t slotCount = 0;
+    bool locked = false;
+    std::array<SlotClass, slotSizes.size()> classes;
+    std::size_t heapCount = 0;
+    mutable std::mutex mutex;
+};
+
+/// Standard allocator on the shared SecureArena, for containers of secrets.
+template <typename T>
+struct SecureAllocator {
+    using value_type = T;
+
+    SecureAllocator() noexcept = default;
+    template <typename U>
+    SecureAllocator(const SecureAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(SecureArena::shared().allocate(n * sizeof(T))); }
+    void deallocate(T* pointer, std::size_t n) noexcept { SecureArena::shared().deallocate(pointer, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const SecureAllocator<U>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const SecureAllocator<U>&) const noexcept { return false; }
+};
+
+/// Byte array in the secure arena.
+using SecureData = std::vector<byte, SecureAllocator<byte>>;
+
+/// String in the secure arena; short strings are stored inline and must still be wiped by the owner.
+using SecureString = std::basic_string<char, std::char_traits<char>, SecureAllocator<char>>;
+
+} // namespace TW
@@ -0,0 +1,107 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SeedCache.h"
+
+#include <TrezorCrypto/hmac.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/rand.h>
+
+using namespace TW;
+
+SeedCache::SeedCache(std::size_t capacity) : maxSize(capacity) {
+    random_buffer(secret.data(), secret.size());
+}
+
+SeedCache& SeedCache::shared() {
+    static SeedCache cache;
+    return cache;
+}
+
+SeedCache::Key SeedCache::key(const std::string& mnemonic, const std::string& passphrase) const {
+    HMAC_SHA256_CTX ctx;
+    hmac_sha256_Init(&ctx, secret.data(), static_cast<uint32_t>(secret.size()));
+    hmac_sha256_Update(&ctx, reinterpret_cast<const uint8_t*>(mnemonic.data()), static_cast<uint32_t>(mnemonic.size()));
+    // separator, a mnemonic has no NUL character
+    const uint8_t separator = 0;
+    hmac_sha256_Update(&ctx, &separator, 1);
+    hmac_sha256_Update(&ctx, reinterpret_cast<const uint8_t*>(passphrase.data()), static_cast<uint32_t>(passphrase.size()));
+    Key key;
+    hmac_sha256_Final(&ctx, key.data());
+    return key;
+}
+
+bool SeedCache::find(const std::string& mnemonic, const std::string& passphrase, Seed& seed) {
+#ifdef TW_NO_SEED_CACHE
+    return false;
+#else
+    if (maxSize == 0) {
+        return false;
+    }
+    const auto entryKey = key(mnemonic, passphrase);
+    auto& shard = this->shard(entryKey);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.index.find(entryKey);
+    if (found == shard.index.end()) {
+        return false;
+    }
+    // move to front
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    seed = found->second->second;
+    return true;
+#endif
+}
+
+void SeedCache::insert(const std::string& mnemonic, const std::string& passphrase, const Seed& seed) {
+#ifndef TW_NO_SEED_CACHE
+    if (maxSize == 0) {
+        return;
+    }
+    const auto entryKey = key(mnemonic, passphrase);
+    auto& shard = this->shard(entryKey);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.index.find(entryKey);
+    if (found != shard.index.end()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+    const auto capacity = shardCapacity();
+    while (!shard.entries.empty() && shard.entries.size() >= capacity) {
+        shard.evict(std::prev(shard.entries.end()));
+    }
+    shard.entries.emplace_front(entryKey, seed);
+    shard.index.emplace(entryKey, shard.entries.begin());
+#endif
+}
+
+void SeedCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        while (!shard.entries.empty()) {
+            shard.evict(shard.entries.begin());
+        }
+    }
+}
+
+std::size_t SeedCache::size() const {
+    std::size_t size = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += shard.entries.size();
+    }
+    return size;
+}
+
+void SeedCache::setCapacity(std::size_t capacity) {
+    maxSize = capacity;
+    clear();
+}
+
+void SeedCache::Shard::evict(std::list<Entry>::iterator it) {
+    index.erase(it->first);
+    memzero(it->second.data(), it->second.size());
+    entries.erase(it);
+}
@@ -0,0 +1,88 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace TW {
+
+/// Thread-safe LRU cache of BIP39 seeds, keyed by mnemonic and passphrase.
+///
+/// Used by HDWallet to skip the 2048 rounds of PBKDF2-HMAC-SHA512 for recently used mnemonics.
+/// Entries are keyed by a keyed hash of the mnemonic and passphrase, so neither is retained;
+/// evicted seeds are wiped. Entries are spread over independently locked shards.
+/// Compiled out when TW_NO_SEED_CACHE is defined.
+class SeedCache {
+  public:
+    static constexpr std::size_t seedSize = 64;
+    static constexpr std::size_t defaultCapacity = 4;
+    static constexpr std::size_t shardCount = 8;
+
+    using Seed = std::array<byte, seedSize>;
+
+    explicit SeedCache(std::size_t capacity = defaultCapacity);
+    ~SeedCache() { clear(); }
+
+    SeedCache(const SeedCache&) = delete;
+    SeedCache& operator=(const SeedCache&) = delete;
+
+    /// Cache used by HDWallet.
+    static SeedCache& shared();
+
+    /// Looks up the seed of a mnemonic and passphrase; returns false if not cached.
+    bool find(const std::string& mnemonic, const std::string& passphrase, Seed& seed);
+
+    /// Stores the seed of a mnemonic and passphrase, evicting the least recently used entry of its shard if full.
+    void insert(const std::string& mnemonic, const std::string& passphrase, const Seed& seed);
+
+    /// Removes and wipes all cached seeds.
+    void clear();
+
+    /// Number of cached seeds.
+    std::size_t size() const;
+
+    /// Maximum number of cached seeds.
+    std::size_t capacity() const { return maxSize; }
+
+    /// Changes the maximum number of cached seeds, 0 disables the cache. Clears the cache.
+    void setCapacity(std::size_t capacity);
+
+  private:
+    using Key = std::array<byte, 32>;
+    using Entry = std::pair<Key, Seed>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        /// Cached entries, most recently used first.
+        std::list<Entry> entries;
+        std::map<Key, std::list<Entry>::iterator> index;
+
+        void evict(std::list<Entry>::iterator it);
+    };
+
+    std::atomic<std::size_t> maxSize;
+    std::array<Shard, shardCount> shards;
+    /// Random key of the entry hashes.
+    std::array<byte, 32> secret;
+
+    Key key(const std::string& mnemonic, const std::string& passphrase) const;
+    /// Number of shards in use, small caches use fewer shards to keep the exact capacity.
+    std::size_t activeShards() const { return std::max<std::size_t>(std::min(maxSize.load(), shardCount), 1); }
+    Shard& shard(const Key& key) { return shards[key[0] % activeShards()]; }
+    std::size_t shardCapacity() const { return maxSize / activeShards(); }
+};
+
+} // namespace TW
@@ -0,0 +1,106 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SignatureCache.h"
+
+#include <TrezorCrypto/hmac.h>
+#include <TrezorCrypto/rand.h>
+
+using namespace TW;
+
+namespace {
+
+void updateWithSize(HMAC_SHA256_CTX& ctx, DataView data) {
+    // sizes keep the boundaries of the inputs unambiguous
+    const auto size = static_cast<uint32_t>(data.size());
+    const uint8_t encoded[4] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
+    hmac_sha256_Update(&ctx, encoded, sizeof(encoded));
+    hmac_sha256_Update(&ctx, data.data(), size);
+}
+
+} // namespace
+
+SignatureCache::SignatureCache(std::size_t capacity) : maxSize(capacity) {
+    random_buffer(secret.data(), secret.size());
+}
+
+SignatureCache& SignatureCache::shared() {
+    static SignatureCache cache;
+    return cache;
+}
+
+SignatureCache::Key SignatureCache::key(Scheme scheme, byte keyType, DataView publicKey, DataView signature, DataView message) const {
+    HMAC_SHA256_CTX ctx;
+    hmac_sha256_Init(&ctx, secret.data(), static_cast<uint32_t>(secret.size()));
+    const uint8_t header[2] = {scheme, keyType};
+    hmac_sha256_Update(&ctx, header, sizeof(header));
+    updateWithSize(ctx, publicKey);
+    updateWithSize(ctx, signature);
+    updateWithSize(ctx, message);
+    Key key;
+    hmac_sha256_Final(&ctx, key.data());
+    return key;
+}
+
+bool SignatureCache::find(const Key& key, Data* result) {
+    if (maxSize == 0) {
+        return false;
+    }
+    auto& shard = this->shard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        return false;
+    }
+    // move to front
+    shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+    if (result != nullptr) {
+        *result = found->second->second;
+    }
+    return true;
+}
+
+void SignatureCache::insert(const Key& key, const Data& result) {
+    if (maxSize == 0) {
+        return;
+    }
+    auto& shard = this->shard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        shard.entries.splice(shard.entries.begin(), shard.entries, found->second);
+        return;
+    }
+    const auto capacity = shardCapacity();
+    while (!shard.entries.empty() && shard.entries.size() >= capacity) {
+        shard.index.erase(shard.entries.back().first);
+        shard.entries.pop_back();
+    }
+    shard.entries.emplace_front(key, result);
+    shard.index.emplace(key, shard.entries.begin());
+}
+
+void SignatureCache::clear() {
+    for (auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.index.clear();
+        shard.entries.clear();
+    }
+}
+
+std::size_t SignatureCache::size() const {
+    std::size_t size = 0;
+    for (const auto& shard : shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        size += shard.entries.size();
+    }
+    return size;
+}
+
+void SignatureCache::setCapacity(std::size_t capacity) {
+    maxSize = capacity;
+    clear();
+}
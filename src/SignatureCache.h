@@ -0,0 +1,95 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace TW {
+
+/// Thread-safe LRU cache of successful signature verifications and public key recoveries.
+///
+/// Used by PublicKey so that a (public key, message, signature) triple seen again, on a retry or in a later
+/// stage of a pipeline, is accepted without a second verification.  Failed verifications are never cached.
+/// Entries are keyed by a hash salted with a random secret, so that inputs colliding in the cache cannot be
+/// crafted; only a recovered public key is retained with its key.  Entries are spread over independently
+/// locked shards.  Disabled (capacity 0) until a capacity is set.
+class SignatureCache {
+  public:
+    static constexpr std::size_t shardCount = 16;
+
+    /// Kind of check, part of the key.
+    enum Scheme : byte {
+        SchemeVerify = 1,
+        SchemeVerifySchnorr = 2,
+        SchemeRecover = 3,
+    };
+
+    using Key = std::array<byte, 32>;
+
+    explicit SignatureCache(std::size_t capacity = 0);
+
+    SignatureCache(const SignatureCache&) = delete;
+    SignatureCache& operator=(const SignatureCache&) = delete;
+
+    /// Cache used by PublicKey.
+    static SignatureCache& shared();
+
+    /// Salted hash of a check and its inputs; `keyType` and `publicKey` identify the signer, empty for a recovery.
+    Key key(Scheme scheme, byte keyType, DataView publicKey, DataView signature, DataView message) const;
+
+    /// Looks up a successful check, copying its result (the recovered public key) into `result` if not null;
+    /// returns false if not cached.
+    bool find(const Key& key, Data* result = nullptr);
+
+    /// Stores a successful check, evicting the least recently used entry of its shard if full.
+    void insert(const Key& key, const Data& result = {});
+
+    /// Removes all entries.
+    void clear();
+
+    /// Number of cached checks.
+    std::size_t size() const;
+
+    /// Maximum number of cached checks.
+    std::size_t capacity() const { return maxSize; }
+
+    /// Whether the cache is in use, callers skip the key computation otherwise.
+    bool enabled() const { return maxSize != 0; }
+
+    /// Changes the maximum number of cached checks, 0 disables the cache. Clears the cache.
+    void setCapacity(std::size_t capacity);
+
+  private:
+    using Entry = std::pair<Key, Data>;
+
+    struct Shard {
+        mutable std::mutex mutex;
+        /// Cached entries, most recently used first.
+        std::list<Entry> entries;
+        std::map<Key, std::list<Entry>::iterator> index;
+    };
+
+    std::atomic<std::size_t> maxSize;
+    std::array<Shard, shardCount> shards;
+    /// Random key of the entry hashes.
+    std::array<byte, 32> secret;
+
+    /// Number of shards in use, small caches use fewer shards to keep the exact capacity.
+    std::size_t activeShards() const { return std::max<std::size_t>(std::min(maxSize.load(), shardCount), 1); }
+    Shard& shard(const Key& key) { return shards[key[0] % activeShards()]; }
+    std::size_t shardCapacity() const { return maxSize / activeShards(); }
+};
+
+} // namespace TW
@@ -0,0 +1,199 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SignerBackend.h"
+
+#include <TrezorCrypto/bignum.h>
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+using namespace TW;
+
+namespace {
+
+const ecdsa_curve* ecdsaCurve(TWCurve curve) {
+    switch (curve) {
+    case TWCurveSECP256k1: return &secp256k1;
+    case TWCurveNIST256p1: return &nist256p1;
+    default: return nullptr;
+    }
+}
+
+/// r || s with s in the lower half of the order; false if the signature is malformed.
+bool lowS(const ecdsa_curve& curve, const Data& signature, std::array<uint8_t, 64>& normalized) {
+    if (signature.size() != 64) {
+        return false;
+    }
+    std::copy(signature.begin(), signature.end(), normalized.begin());
+    bignum256 s;
+    bn_read_be(normalized.data() + 32, &s);
+    if (bn_is_zero(&s) || !bn_is_less(&s, &curve.order)) {
+        return false;
+    }
+    if (bn_is_less(&curve.order_half, &s)) {
+        bn_subtract(&curve.order, &s, &s);
+        bn_write_be(&s, normalized.data() + 32);
+    }
+    return true;
+}
+
+/// Type of a public key of `size` bytes referencing a backend key, for the keys of `type`.
+TWPublicKeyType referenceType(TWPublicKeyType type, std::size_t size) {
+    switch (type) {
+    case TWPublicKeyTypeSECP256k1:
+    case TWPublicKeyTypeSECP256k1Extended:
+        return size == PublicKey::secp256k1Size ? TWPublicKeyTypeSECP256k1 : TWPublicKeyTypeSECP256k1Extended;
+    case TWPublicKeyTypeNIST256p1:
+    case TWPublicKeyTypeNIST256p1Extended:
+        return size == PublicKey::secp256k1Size ? TWPublicKeyTypeNIST256p1 : TWPublicKeyTypeNIST256p1Extended;
+    case TWPublicKeyTypeED25519:
+        return TWPublicKeyTypeED25519;
+    default:
+        throw std::invalid_argument("Key type not supported by signer backends");
+    }
+}
+
+} // namespace
+
+std::vector<Data> SignerBackend::signVerified(std::vector<DigestSigningRequest> requests) {
+    const auto count = requests.size();
+    // the requests are moved to the backend, keep what the verification needs
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> digests;
+    std::vector<TWCurve> curves;
+    publicKeys.reserve(count);
+    digests.reserve(count);
+    curves.reserve(count);
+    for (const auto& request : requests) {
+        publicKeys.push_back(request.publicKey);
+        digests.push_back(request.digest);
+        curves.push_back(request.curve);
+    }
+    auto signatures = sign(std::move(requests)).get();
+    signatures.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        auto& signature = signatures[i];
+        const auto curve = ecdsaCurve(curves[i]);
+        bool valid = false;
+        if (curve != nullptr) {
+            std::array<uint8_t, 64> normalized;
+            valid = digests[i].size() == 32 && lowS(*curve, signature, normalized) &&
+                    ecdsa_verify_digest(curve, publicKeys[i].bytes.data(), normalized.data(), digests[i].data()) == 0;
+        } else if (curves[i] == TWCurveED25519 && publicKeys[i].type == TWPublicKeyTypeED25519) {
+            valid = signature.size() == 64 && publicKeys[i].verify(signature, digests[i]);
+        }
+        if (!valid) {
+            signature.clear();
+        }
+    }
+    return signatures;
+}
+
+PublicKey LocalSignerBackend::addKey(const PrivateKey& key, TWPublicKeyType type) {
+    auto publicKey = key.getPublicKey(type);
+    std::lock_guard<std::mutex> lock(mutex);
+    // a key is found by either form of its public key
+    keys.insert_or_assign(publicKey.compressed().bytes.toData(), key);
+    return publicKey;
+}
+
+std::future<std::vector<Data>> LocalSignerBackend::sign(std::vector<DigestSigningRequest> requests) {
+    std::vector<Data> signatures(requests.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++this->requests;
+        for (std::size_t i = 0; i < requests.size(); ++i) {
+            const auto found = keys.find(requests[i].publicKey.compressed().bytes.toData());
+            if (found == keys.end()) {
+                continue;
+            }
+            auto signature = found->second.sign(requests[i].digest, requests[i].curve);
+            if (ecdsaCurve(requests[i].curve) != nullptr && signature.size() == 65) {
+                // without the recovery id, as a PKCS#11 token returns it
+                signature.pop_back();
+            }
+            signatures[i] = std::move(signature);
+        }
+    }
+    std::promise<std::vector<Data>> result;
+    result.set_value(std::move(signatures));
+    return result.get_future();
+}
+
+std::size_t LocalSignerBackend::requestCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requests;
+}
+
+Data TW::backendRecoverableSignature(const PublicKey& publicKey, const Data& digest, const Data& signature, TWCurve curve) {
+    const auto ecdsa = ecdsaCurve(curve);
+    std::array<uint8_t, 64> normalized;
+    if (ecdsa == nullptr || digest.size() != 32 || !lowS(*ecdsa, signature, normalized)) {
+        return {};
+    }
+    const auto expected = publicKey.extended().bytes;
+    for (int recoveryId = 0; recoveryId < 4; ++recoveryId) {
+        std::array<uint8_t, 65> recovered;
+        if (ecdsa_recover_pub_from_sig(ecdsa, recovered.data(), normalized.data(), digest.data(), recoveryId) == 0 &&
+            std::equal(recovered.begin(), recovered.end(), expected.begin(), expected.end())) {
+            Data result(normalized.begin(), normalized.end());
+            result.push_back(static_cast<byte>(recoveryId));
+            return result;
+        }
+    }
+    return {};
+}
+
+Data TW::backendDERSignature(const Data& signature, TWCurve curve) {
+    const auto ecdsa = ecdsaCurve(curve);
+    std::array<uint8_t, 64> normalized;
+    if (ecdsa == nullptr || !lowS(*ecdsa, signature, normalized)) {
+        return {};
+    }
+    Data der(72);
+    const auto size = ecdsa_sig_to_der(normalized.data(), der.data());
+    der.resize(static_cast<std::size_t>(size));
+    return der;
+}
+
+SigningKey::SigningKey(DataView data, TWPublicKeyType type) {
+    auto* current = SignerBackend::current();
+    if (current == nullptr || data.size() == PrivateKey::size || data.size() == PrivateKey::extendedSize) {
+        privateKey.emplace(data);
+        return;
+    }
+    // a public key references a key of the signer backend
+    publicKey.emplace(data, referenceType(type, data.size()));
+    backend = current;
+}
+
+PublicKey SigningKey::getPublicKey(TWPublicKeyType type) const {
+    if (backend == nullptr) {
+        return privateKey->getPublicKey(type);
+    }
+    for (const auto& form : {*publicKey, publicKey->compressed(), publicKey->extended()}) {
+        if (form.type == type) {
+            return form;
+        }
+    }
+    throw std::invalid_argument("Public key type not available for a signer backend key");
+}
+
+Data SigningKey::sign(const Data& digest, TWCurve curve) const {
+    if (backend == nullptr) {
+        return privateKey->sign(digest, curve);
+    }
+    const auto signatures = backend->signVerified({DigestSigningRequest{*publicKey, digest, curve}});
+    if (curve == TWCurveED25519) {
+        return signatures.front();
+    }
+    return backendRecoverableSignature(*publicKey, digest, signatures.front(), curve);
+}
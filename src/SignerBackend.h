@@ -0,0 +1,128 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <TrustWalletCore/TWCurve.h>
+#include <TrustWalletCore/TWPublicKeyType.h>
+
+#include <cstddef>
+#include <future>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Digest to sign with a key of a SignerBackend.
+struct DigestSigningRequest {
+    /// Public key of the key to sign with.
+    PublicKey publicKey;
+    Data digest;
+    TWCurve curve;
+};
+
+/// Signs digests with keys kept out of the signing inputs: in an HSM, a KMS or a remote signer.
+///
+/// A signing input references a key of the backend by its public key, in place of the private key (33 or 65 bytes
+/// instead of 32, for the Bitcoin, Ethereum and SigningKey signers).  The signers submit all the digests of a
+/// transaction in a single request, so that a transaction costs one round trip to the backend whatever its number of
+/// inputs; a SigningKey submits its digests one at a time.
+///
+/// Signatures are 64 bytes: r || s for ECDSA, with s in either half of the order (the signers normalize it, and
+/// compute the recovery id from the public key), and the plain signature for ed25519.  The signers verify them.
+class SignerBackend {
+  public:
+    virtual ~SignerBackend() = default;
+
+    /// Signs the digests, answering in the same order; an empty signature fails its transaction.  The future may be
+    /// completed on any thread, it is waited for by the signing thread.
+    virtual std::future<std::vector<Data>> sign(std::vector<DigestSigningRequest> requests) = 0;
+
+    /// Signs the digests with the backend and verifies the signatures, which are returned as the backend made them;
+    /// an invalid signature is returned empty.
+    std::vector<Data> signVerified(std::vector<DigestSigningRequest> requests);
+
+    /// Backend of the innermost ScopedSignerBackend on the current thread, or null.
+    static SignerBackend* current() { return currentBackend; }
+
+  private:
+    friend class ScopedSignerBackend;
+    static inline thread_local SignerBackend* currentBackend = nullptr;
+};
+
+/// Makes the signers on the current thread sign with `backend`, for the keys referenced by public key, while in scope.
+class ScopedSignerBackend {
+  public:
+    explicit ScopedSignerBackend(SignerBackend& backend) : previous(SignerBackend::currentBackend) {
+        SignerBackend::currentBackend = &backend;
+    }
+    ~ScopedSignerBackend() { SignerBackend::currentBackend = previous; }
+    ScopedSignerBackend(const ScopedSignerBackend&) = delete;
+    ScopedSignerBackend& operator=(const ScopedSignerBackend&) = delete;
+
+  private:
+    SignerBackend* previous;
+};
+
+/// Key of a signing input for a signer that signs its digests one at a time: the private key, or, while a
+/// ScopedSignerBackend is in scope, the public key of a key of the backend (33 or 65 bytes for ECDSA, 0x01 || key
+/// for ed25519).  The backend is the one current when the key is made.
+class SigningKey {
+  public:
+    /// Initializes the key of an input whose keys are of `type`; throws std::invalid_argument if `data` is neither.
+    SigningKey(DataView data, TWPublicKeyType type);
+
+    /// Initializes a key from a string of bytes (convenience method).
+    SigningKey(const std::string& data, TWPublicKeyType type)
+        : SigningKey(DataView(reinterpret_cast<const byte*>(data.data()), data.size()), type) {}
+
+    /// Whether the key is a key of a signer backend.
+    bool isBackendKey() const { return backend != nullptr; }
+
+    /// Returns the public key; a backend key has only the forms of its referenced public key.
+    PublicKey getPublicKey(TWPublicKeyType type) const;
+
+    /// Signs a digest, the result being the one of PrivateKey::sign; empty if the backend doesn't sign it validly.
+    Data sign(const Data& digest, TWCurve curve) const;
+
+  private:
+    std::optional<PrivateKey> privateKey;
+    std::optional<PublicKey> publicKey;
+    SignerBackend* backend = nullptr;
+};
+
+/// Backend with in-process keys, the reference implementation.  Thread-safe.
+class LocalSignerBackend : public SignerBackend {
+  public:
+    /// Adds a key, referenced by its public key of `type`; returns that public key.
+    PublicKey addKey(const PrivateKey& key, TWPublicKeyType type);
+
+    std::future<std::vector<Data>> sign(std::vector<DigestSigningRequest> requests) override;
+
+    /// Number of `sign` calls so far.
+    std::size_t requestCount() const;
+
+  private:
+    mutable std::mutex mutex;
+    std::map<Data, PrivateKey> keys;
+    std::size_t requests = 0;
+};
+
+/// Converts an ECDSA signature of a backend to the 65 bytes r || s || recovery id with low s, as PrivateKey::sign
+/// returns; empty if it is not a valid signature of `digest` by `publicKey`.
+Data backendRecoverableSignature(const PublicKey& publicKey, const Data& digest, const Data& signature, TWCurve curve);
+
+/// Converts an ECDSA signature of a backend to DER with low s, as PrivateKey::signAsDER returns; empty if invalid.
+Data backendDERSignature(const Data& signature, TWCurve curve);
+
+} // namespace TW
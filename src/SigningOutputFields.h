@@ -0,0 +1,42 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWAnySigner.h>
+
+#include <cstdint>
+
+namespace TW {
+
+/// Fields of the signing outputs requested on the current thread, a mask of TWAnySignerOutputField values.
+/// Signers skip the fields that are not requested; all are, unless a ScopedSigningOutputFields is in scope.
+class SigningOutputFields {
+  public:
+    static uint32_t current() { return currentFields; }
+
+    static bool requested(enum TWAnySignerOutputField field) { return (currentFields & field) != 0; }
+
+  private:
+    friend class ScopedSigningOutputFields;
+    static inline thread_local uint32_t currentFields = TWAnySignerOutputFieldAll;
+};
+
+/// Makes the signers on the current thread produce only the given output fields, while in scope.
+class ScopedSigningOutputFields {
+  public:
+    explicit ScopedSigningOutputFields(uint32_t fields) : previous(SigningOutputFields::currentFields) {
+        SigningOutputFields::currentFields = fields;
+    }
+    ~ScopedSigningOutputFields() { SigningOutputFields::currentFields = previous; }
+    ScopedSigningOutputFields(const ScopedSigningOutputFields&) = delete;
+    ScopedSigningOutputFields& operator=(const ScopedSigningOutputFields&) = delete;
+
+  private:
+    uint32_t previous;
+};
+
+} // namespace TW
@@ -0,0 +1,30 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SigningTemplate.h"
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+
+using namespace TW;
+
+std::vector<Data> SigningTemplate::signBatch(const std::vector<SigningPatch>& patches, size_t threadCount) const {
+    std::vector<Data> outputs(patches.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto index = next++; index < patches.size(); index = next++) {
+            try {
+                outputs[index] = sign(patches[index]);
+            } catch (...) {
+                outputs[index].clear();
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, patches.size(), worker);
+    return outputs;
+}
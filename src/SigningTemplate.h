@@ -0,0 +1,69 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Data.h"
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace TW {
+
+/// Fields that differ between transactions signed from the same template.
+struct SigningPatch {
+    /// Account nonce (sequence number), ignored by coins without one, e.g. Tron.
+    uint64_t nonce = 0;
+    /// Recipient address.
+    std::string toAddress;
+    /// Amount, uint256 big-endian, in the unit of the template transaction.
+    Data amount;
+};
+
+/// Signer of transactions that differ only in nonce, recipient and amount, for account-based coins.
+///
+/// The base signing input is parsed once, and the invariant parts of the encoding are prepared
+/// by the coin when it can; each patch then costs little more than hashing and signing.
+/// Signing is thread-safe.
+class SigningTemplate {
+  public:
+    virtual ~SigningTemplate() = default;
+
+    /// Signs the base transaction with the patch applied, returns the serialized signing output.
+    ///
+    /// @throws std::invalid_argument if the patch is not valid for the coin.
+    virtual Data sign(const SigningPatch& patch) const = 0;
+
+    /// Signs one transaction per patch, on up to `threadCount` threads (0: one per hardware thread).
+    /// Outputs are in the order of the patches, empty for those that fail.
+    std::vector<Data> signBatch(const std::vector<SigningPatch>& patches, size_t threadCount = 0) const;
+};
+
+/// Template keeping the parsed base input of a coin, the patch is applied to a copy for each transaction.
+/// For coins whose encoding holds no expensive invariant part to precompute.
+template <typename Signer, typename Input>
+class InputSigningTemplate : public SigningTemplate {
+  public:
+    /// Applies a patch to a copy of the base input; may throw std::invalid_argument.
+    using Patcher = void (*)(Input& input, const SigningPatch& patch);
+
+    InputSigningTemplate(Input input, Patcher patcher) : input(std::move(input)), patcher(patcher) {}
+
+    Data sign(const SigningPatch& patch) const override {
+        auto patched = input;
+        patcher(patched, patch);
+        const auto serialized = Signer::sign(patched).SerializeAsString();
+        return Data(serialized.begin(), serialized.end());
+    }
+
+  private:
+    Input input;
+    Patcher patcher;
+};
+
+} // namespace TW
@@ -19,16 +19,14 @@ using namespace TW;
 using namespace TW::Solana;
 
 bool Address::isValid(const std::string& string) {
-    const auto data = Base58::bitcoin.decode(string);
-    return Address::isValid(data);
+    std::array<byte, size> data;
+    return Base58::bitcoin.decode(string, data);
 }
 
 Address::Address(const std::string& string) {
-    const auto data = Base58::bitcoin.decode(string);
-    if (!isValid(data)) {
+    if (!Base58::bitcoin.decode(string, bytes)) {
         throw std::invalid_argument("Invalid address string");
     }
-    std::copy(data.begin(), data.end(), bytes.begin());
 }
 
 Address::Address(const PublicKey& publicKey) {
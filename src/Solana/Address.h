@@ -9,6 +9,7 @@
 #include "../Base58Address.h"
 #include "../PublicKey.h"
 
+#include <cstring>
 #include <vector>
 #include <string>
 
@@ -41,6 +42,16 @@ class Address : public Base58Address<32> {
     Address defaultTokenAddress(const Address& tokenMintAddress);
 };
 
+/// Hash of an address for unordered containers, mixing its four 64-bit words: keys and program
+/// addresses are mostly random, but some program addresses are padded with zeros.
+struct AddressHash {
+    std::size_t operator()(const Address& address) const noexcept {
+        uint64_t words[4];
+        std::memcpy(words, address.bytes.data(), sizeof(words));
+        return static_cast<std::size_t>(words[0] ^ (words[1] * 0x9e3779b97f4a7c15ull) ^ words[2] ^ (words[3] * 0xc2b2ae3d27d4eb4full));
+    }
+};
+
 } // namespace TW::Solana
 
 /// Wrapper for C interface
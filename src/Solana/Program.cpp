@@ -9,10 +9,18 @@
 #include "Transaction.h"
 #include "../Base58.h"
 #include "../Hash.h"
+#include "../ThreadPool.h"
 
 #include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
+#include <TrezorCrypto/sha2.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <list>
+#include <map>
+#include <mutex>
 
 using namespace TW;
 using namespace TW::Solana;
@@ -30,19 +38,96 @@ Address StakeProgram::addressFromValidatorSeed(const Address& fromAddress, const
     return Address(hash);
 }
 
+namespace {
+
+/// Thread-safe LRU cache of default token addresses, keyed by main and token mint addresses.
+class TokenAddressCache {
+  public:
+    using Key = std::array<byte, 64>;
+
+    static Key key(const Address& mainAddress, const Address& tokenMintAddress) {
+        Key key;
+        std::copy(mainAddress.bytes.begin(), mainAddress.bytes.end(), key.begin());
+        std::copy(tokenMintAddress.bytes.begin(), tokenMintAddress.bytes.end(), key.begin() + Address::size);
+        return key;
+    }
+
+    bool find(const Key& key, Address& address) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        const auto found = index.find(key);
+        if (found == index.end()) {
+            return false;
+        }
+        entries.splice(entries.begin(), entries, found->second);
+        address = found->second->second;
+        return true;
+    }
+
+    void insert(const Key& key, const Address& address) {
+        const std::lock_guard<std::mutex> lock(mutex);
+        if (index.count(key) > 0) {
+            return;
+        }
+        entries.emplace_front(key, address);
+        index.emplace(key, entries.begin());
+        if (entries.size() > TokenProgram::defaultTokenAddressCacheCapacity) {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+    }
+
+  private:
+    std::mutex mutex;
+    /// Cached entries, most recently used first.
+    std::list<std::pair<Key, Address>> entries;
+    std::map<Key, std::list<std::pair<Key, Address>>::iterator> index;
+};
+
+TokenAddressCache& tokenAddressCache() {
+    static TokenAddressCache cache;
+    return cache;
+}
+
+Address computeDefaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress) {
+    static const Address programId = Address(TOKEN_PROGRAM_ID_ADDRESS);
+    static const Address associatedProgramId = Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS);
+    std::vector<Data> seeds = {
+        TW::data(mainAddress.bytes.data(), mainAddress.bytes.size()),
+        TW::data(programId.bytes.data(), programId.bytes.size()),
+        TW::data(tokenMintAddress.bytes.data(), tokenMintAddress.bytes.size())
+    };
+    return TokenProgram::findProgramAddress(seeds, associatedProgramId);
+}
+
+} // namespace
+
 /*
  * Based on solana-program-library code, get_associated_token_address()
  * https://github.com/solana-labs/solana-program-library/blob/master/associated-token-account/program/src/lib.rs#L35
  * https://github.com/solana-labs/solana-program-library/blob/master/associated-token-account/program/src/lib.rs#L19
  */
 Address TokenProgram::defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress) {
-    Address programId = Address(TOKEN_PROGRAM_ID_ADDRESS);
-    std::vector<Data> seeds = {
-        TW::data(mainAddress.bytes.data(), mainAddress.bytes.size()),
-        TW::data(programId.bytes.data(), programId.bytes.size()),
-        TW::data(tokenMintAddress.bytes.data(), tokenMintAddress.bytes.size())
+    const auto key = TokenAddressCache::key(mainAddress, tokenMintAddress);
+    auto address = Address(Data(Address::size));
+    if (tokenAddressCache().find(key, address)) {
+        return address;
+    }
+    address = computeDefaultTokenAddress(mainAddress, tokenMintAddress);
+    tokenAddressCache().insert(key, address);
+    return address;
+}
+
+std::vector<Address> TokenProgram::defaultTokenAddresses(const std::vector<Address>& mainAddresses, const Address& tokenMintAddress, size_t threadCount) {
+    std::vector<Address> addresses(mainAddresses.size(), Address(Data(Address::size)));
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto index = next++; index < mainAddresses.size(); index = next++) {
+            addresses[index] = computeDefaultTokenAddress(mainAddresses[index], tokenMintAddress);
+        }
     };
-    return findProgramAddress(seeds, Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS));
+
+    ThreadPool::shared().run(threadCount, mainAddresses.size(), worker);
+    return addresses;
 }
 
 /*
@@ -50,24 +135,30 @@ Address TokenProgram::defaultTokenAddress(const Address& mainAddress, const Addr
  * https://github.com/solana-labs/solana/blob/master/sdk/program/src/pubkey.rs#L193
  */
 Address TokenProgram::findProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId) {
-    Address result(Data(32));
+    static const std::string marker = "ProgramDerivedAddress";
+    // the given seeds are hashed once, each bump seed continues from a copy of this state
+    SHA256_CTX seedsContext;
+    sha256_Init(&seedsContext);
+    for (const auto& s: seeds) {
+        sha256_Update(&seedsContext, s.data(), s.size());
+    }
+    Data hash(SHA256_DIGEST_LENGTH);
     // cycle through seeds for the rare case when result is not valid
-    for (uint8_t seed = 255; seed >= 0; --seed) {
-        std::vector<Data> seedsCopy;
-        for (auto& s: seeds) {
-            seedsCopy.push_back(s);
-        }
-        // add extra seed
-        seedsCopy.push_back({seed});
-        Address address = createProgramAddress(seedsCopy, Address(ASSOCIATED_TOKEN_PROGRAM_ID_ADDRESS));
-        PublicKey publicKey = PublicKey(TW::data(address.bytes.data(), address.bytes.size()), TWPublicKeyTypeED25519);
-        if (!publicKey.isValidED25519()) {
-            result = address;
-            break;
+    for (int seed = 255; seed >= 0; --seed) {
+        auto context = seedsContext;
+        const auto extraSeed = static_cast<byte>(seed);
+        sha256_Update(&context, &extraSeed, 1);
+        sha256_Update(&context, programId.bytes.data(), programId.bytes.size());
+        sha256_Update(&context, reinterpret_cast<const byte*>(marker.data()), marker.size());
+        sha256_Final(&context, hash.data());
+        // valid if not on the ed25519 curve
+        ge25519 point;
+        if (ge25519_unpack_negative_vartime(&point, hash.data()) == 0) {
+            return Address(hash);
         }
         // try next seed
     }
-    return result;
+    return Address(Data(32));
 }
 
 /*
@@ -23,9 +23,17 @@ public:
 class TokenProgram {
 public:
     /// Derive default token address for main address and token
+    /// Recent results are kept in a small cache (see defaultTokenAddressCacheCapacity).
     static Address defaultTokenAddress(const Address& mainAddress, const Address& tokenMintAddress);
 
-    /// Create a new valid address, if neeed, trying several
+    /// Derive the default token addresses of many main addresses for a token, in the same order,
+    /// on up to `threadCount` threads (0: one per hardware thread).  The results are not cached.
+    static std::vector<Address> defaultTokenAddresses(const std::vector<Address>& mainAddresses, const Address& tokenMintAddress, size_t threadCount = 0);
+
+    /// Maximum number of default token addresses cached by defaultTokenAddress.
+    static constexpr size_t defaultTokenAddressCacheCapacity = 1024;
+
+    /// Create a new valid address, if neeed, trying several bump seeds after the given ones
     static Address findProgramAddress(const std::vector<TW::Data>& seeds, const Address& programId);
 
     /// Create a new address for program, with given seeds
@@ -8,6 +8,7 @@
 #include "Address.h"
 #include "Program.h"
 #include "../Base58.h"
+#include "../Ed25519SigningKey.h"
 #include <TrezorCrypto/ed25519.h>
 
 #include <algorithm>
@@ -16,11 +17,13 @@ using namespace TW;
 using namespace TW::Solana;
 
 void Signer::sign(const std::vector<PrivateKey>& privateKeys, Transaction& transaction) {
-    for (auto privateKey : privateKeys) {
-        auto address = Address(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+    const auto message = transaction.messageData();
+    for (const auto& privateKey : privateKeys) {
+        // the public key of the signature is the address
+        const auto key = Ed25519SigningKey(privateKey, TWCurveED25519);
+        auto address = Address(Data(key.publicKey().begin(), key.publicKey().end()));
         auto index = transaction.getAccountIndex(address);
-        auto message = transaction.messageData();
-        auto signature = Signature(privateKey.sign(message, TWCurveED25519));
+        auto signature = Signature(key.sign(message));
         transaction.signatures[index] = signature;
     }
 }
@@ -28,21 +28,43 @@ uint8_t CompiledInstruction::findAccount(const Address& address) {
     return (uint8_t)dist;
 }
 
+uint8_t CompiledInstruction::findAccount(const Address& address, const AccountIndex& index) {
+    const auto it = index.find(address);
+    if (it == index.end()) {
+        throw std::invalid_argument("address not found");
+    }
+    return it->second;
+}
+
+namespace {
+
+enum Bucket : uint8_t {
+    SignedBucket = 1,
+    UnsignedBucket = 2,
+    ReadOnlyBucket = 4,
+};
+
+} // namespace
+
 void Message::addAccount(const AccountMeta& account) {
-    bool inSigned = (std::find(signedAccounts.begin(), signedAccounts.end(), account.account) != signedAccounts.end());
-    bool inUnsigned = (std::find(unsignedAccounts.begin(), unsignedAccounts.end(), account.account) != unsignedAccounts.end());
-    bool inReadOnly = (std::find(readOnlyAccounts.begin(), readOnlyAccounts.end(), account.account) != readOnlyAccounts.end());
+    auto& buckets = accountBuckets[account.account];
+    bool inSigned = (buckets & SignedBucket) != 0;
+    bool inUnsigned = (buckets & UnsignedBucket) != 0;
+    bool inReadOnly = (buckets & ReadOnlyBucket) != 0;
     if (account.isSigner) {
         if (!inSigned) {
             signedAccounts.push_back(account.account);
+            buckets |= SignedBucket;
         }
     } else if (!account.isReadOnly) {
         if (!inSigned && !inUnsigned) {
             unsignedAccounts.push_back(account.account);
+            buckets |= UnsignedBucket;
         }
     } else {
         if (!inSigned && !inUnsigned && !inReadOnly) {
             readOnlyAccounts.push_back(account.account);
+            buckets |= ReadOnlyBucket;
         }
     }
 }
@@ -66,61 +88,74 @@ void Message::compileAccounts() {
 
     // merge the three buckets
     accountKeys.clear();
-    for(auto& a: signedAccounts) {
-        accountKeys.push_back(a);
-    }
-    for(auto& a: unsignedAccounts) {
-        accountKeys.push_back(a);
-    }
-    for(auto& a: readOnlyAccounts) {
-        accountKeys.push_back(a);
-    }
+    accountKeys.reserve(signedAccounts.size() + unsignedAccounts.size() + readOnlyAccounts.size());
+    accountKeys.insert(accountKeys.end(), signedAccounts.begin(), signedAccounts.end());
+    accountKeys.insert(accountKeys.end(), unsignedAccounts.begin(), unsignedAccounts.end());
+    accountKeys.insert(accountKeys.end(), readOnlyAccounts.begin(), readOnlyAccounts.end());
 
     compileInstructions();
 }
 
 void Message::compileInstructions() {
+    // an address listed twice is found at its first index, as with a linear search
+    AccountIndex index;
+    index.reserve(accountKeys.size());
+    for (size_t i = 0; i < accountKeys.size(); ++i) {
+        assert(i < 256);
+        index.emplace(accountKeys[i], static_cast<uint8_t>(i));
+    }
+
     compiledInstructions.clear();
-    for (auto instruction: instructions) {
-        compiledInstructions.push_back(CompiledInstruction(instruction, accountKeys));
+    compiledInstructions.reserve(instructions.size());
+    for (const auto& instruction: instructions) {
+        compiledInstructions.push_back(CompiledInstruction(instruction, accountKeys, index));
     }
 }
 
 std::string Transaction::serialize() const {
-    Data buffer;
+    const auto message = messageData();
 
-    append(buffer, shortVecLength<Signature>(this->signatures));
-    for (auto signature : this->signatures) {
-        Data signature_vec(signature.bytes.begin(), signature.bytes.end());
-        append(buffer, signature_vec);
+    Data buffer;
+    buffer.reserve(shortVecSize(signatures.size()) + signatures.size() * Signature::size + message.size());
+    encodeShortVecLength(signatures.size(), buffer);
+    for (const auto& signature : this->signatures) {
+        buffer.insert(buffer.end(), signature.bytes.begin(), signature.bytes.end());
     }
-    append(buffer, this->messageData());
+    append(buffer, message);
 
     return Base58::bitcoin.encode(buffer);
 }
 
 Data Transaction::messageData() const {
+    const auto& accountKeys = message.accountKeys;
+    const auto& instructions = message.compiledInstructions;
+
+    auto size = 3 + shortVecSize(accountKeys.size()) + accountKeys.size() * Address::size + Hash::size +
+                shortVecSize(instructions.size());
+    for (const auto& instruction : instructions) {
+        size += 1 + shortVecSize(instruction.accounts.size()) + instruction.accounts.size() +
+                shortVecSize(instruction.data.size()) + instruction.data.size();
+    }
+
     Data buffer;
+    buffer.reserve(size);
 
     buffer.push_back(this->message.header.numRequiredSignatures);
     buffer.push_back(this->message.header.numCreditOnlySignedAccounts);
     buffer.push_back(this->message.header.numCreditOnlyUnsignedAccounts);
-    append(buffer, shortVecLength<Address>(this->message.accountKeys));
-    for (auto account_key : this->message.accountKeys) {
-        Data account_key_vec(account_key.bytes.begin(), account_key.bytes.end());
-        append(buffer, account_key_vec);
+    encodeShortVecLength(accountKeys.size(), buffer);
+    for (const auto& account_key : accountKeys) {
+        buffer.insert(buffer.end(), account_key.bytes.begin(), account_key.bytes.end());
     }
-    Data recentBlockhash(this->message.recentBlockhash.bytes.begin(),
-                         this->message.recentBlockhash.bytes.end());
-    append(buffer, recentBlockhash);
+    buffer.insert(buffer.end(), message.recentBlockhash.bytes.begin(), message.recentBlockhash.bytes.end());
 
     // apppend compiled instructions
-    append(buffer, shortVecLength<CompiledInstruction>(message.compiledInstructions));
-    for (auto instruction : message.compiledInstructions) {
+    encodeShortVecLength(instructions.size(), buffer);
+    for (const auto& instruction : instructions) {
         buffer.push_back(instruction.programIdIndex);
-        append(buffer, shortVecLength<uint8_t>(instruction.accounts));
+        encodeShortVecLength(instruction.accounts.size(), buffer);
         append(buffer, instruction.accounts);
-        append(buffer, shortVecLength<uint8_t>(instruction.data));
+        encodeShortVecLength(instruction.data.size(), buffer);
         append(buffer, instruction.data);
     }
 
@@ -14,6 +14,7 @@
 #include <vector>
 #include <string>
 #include <cassert>
+#include <unordered_map>
 
 namespace TW::Solana {
 
@@ -47,6 +48,23 @@ Data shortVecLength(std::vector<T> vec) {
     return bytes;
 }
 
+/// Size of a compact-u16 length, see shortVecLength().
+inline std::size_t shortVecSize(std::size_t length) {
+    std::size_t size = 1;
+    for (; length >= 0x80; length >>= 7) {
+        ++size;
+    }
+    return size;
+}
+
+/// Appends a compact-u16 length, as shortVecLength() returns it.
+inline void encodeShortVecLength(std::size_t length, Data& data) {
+    for (; length >= 0x80; length >>= 7) {
+        data.push_back(static_cast<uint8_t>(length | 0x80));
+    }
+    data.push_back(static_cast<uint8_t>(length));
+}
+
 // System instruction types
 enum SystemInstruction {
     CreateAccount,
@@ -187,6 +205,9 @@ struct Instruction {
     }
 };
 
+/// Index of each address in the transaction keys array
+using AccountIndex = std::unordered_map<Address, uint8_t, AddressHash>;
+
 // A compiled instruction
 struct CompiledInstruction {
     // Index into the transaction keys array indicating the program account that executes this instruction
@@ -209,7 +230,19 @@ struct CompiledInstruction {
         data = instruction.data;
     }
 
+    /// Same, with the index of every address in the address vector, for constant time lookups.
+    CompiledInstruction(const Instruction& instruction, const std::vector<Address>& addresses, const AccountIndex& index)
+        : data(instruction.data), addresses(addresses) {
+        programIdIndex = findAccount(instruction.programId, index);
+        accounts.reserve(instruction.accounts.size());
+        for (auto& account: instruction.accounts) {
+            accounts.push_back(findAccount(account.account, index));
+        }
+    }
+
     uint8_t findAccount(const Address& address);
+
+    static uint8_t findAccount(const Address& address, const AccountIndex& index);
 };
 
 class Hash {
@@ -289,6 +322,12 @@ class Message {
     // compile the instructions; replace instruction accounts with indices
     void compileInstructions();
 
+  private:
+    /// Buckets each added account is in, a bit per bucket, so that adding is done in constant time
+    std::unordered_map<Address, uint8_t, AddressHash> accountBuckets;
+
+  public:
+
     // This constructor creates a default single-signer Transfer message
     Message(const Address& from, const Address& to, uint64_t value, Hash recentBlockhash)
         : recentBlockhash(recentBlockhash) {
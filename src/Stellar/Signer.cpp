@@ -10,12 +10,20 @@
 #include "../Hash.h"
 #include "../HexCoding.h"
 #include "../proto/Stellar.pb.h"
+#include "../ThreadPool.h"
 
+#include <TrezorCrypto/sha2.h>
 #include <TrustWalletCore/TWStellarMemoType.h>
 
+#include <algorithm>
+#include <atomic>
+
 using namespace TW;
 using namespace TW::Stellar;
 
+static const size_t addressSize = 4 + 32;
+static const size_t signatureSize = 64;
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto signer = Signer(input);
     auto output = Proto::SigningOutput();
@@ -23,99 +31,169 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     return output;
 }
 
-std::string Signer::sign() const noexcept {
-
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto account = Address(input.account());
-    auto encoded = encode(input);
-
-    auto encodedWithHeaders = Data();
-    auto publicNetwork = input.passphrase(); // Header
-    auto passphrase = Hash::sha256(publicNetwork);
-    encodedWithHeaders.insert(encodedWithHeaders.end(), passphrase.begin(), passphrase.end());
-    auto transactionType = Data{0, 0, 0, 2}; // Header
-    encodedWithHeaders.insert(encodedWithHeaders.end(), transactionType.begin(),
-                              transactionType.end());
-    encodedWithHeaders.insert(encodedWithHeaders.end(), encoded.begin(), encoded.end());
+std::vector<Proto::SigningOutput> Signer::signPayments(const Proto::SigningInput& input, const std::vector<Proto::OperationPayment>& payments, size_t threadCount) {
+    // shared by all payments
+    const auto key = Ed25519SigningKey(PrivateKey(Data(input.private_key().begin(), input.private_key().end())), TWCurveED25519);
+    const auto account = Address(input.account());
+    const auto network = networkId(input.passphrase());
+
+    std::vector<Proto::SigningOutput> outputs(payments.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        auto paymentInput = input;
+        for (auto index = next++; index < payments.size(); index = next++) {
+            paymentInput.set_sequence(input.sequence() + static_cast<int64_t>(index));
+            *paymentInput.mutable_op_payment() = payments[index];
+            outputs[index].set_signature(sign(paymentInput, key, account, network));
+        }
+    };
 
-    auto hash = Hash::sha256(encodedWithHeaders);
-    auto data = Data(hash.begin(), hash.end());
+    ThreadPool::shared().run(threadCount, payments.size(), worker);
+    return outputs;
+}
 
-    auto sign = key.sign(data, TWCurveED25519);
+std::string Signer::sign() const noexcept {
+    const auto key = Ed25519SigningKey(PrivateKey(Data(input.private_key().begin(), input.private_key().end())), TWCurveED25519);
+    auto account = Address(input.account());
+    return sign(input, key, account, networkId(input.passphrase()));
+}
 
+std::string Signer::sign(const Proto::SigningInput& input, const Ed25519SigningKey& key, const Address& account, const Data& networkId) {
+    const auto size = encodedSize(input);
     auto signature = Data();
-    signature.insert(signature.end(), encoded.begin(), encoded.end());
-    encode32BE(1, signature);
-    signature.insert(signature.end(), account.bytes.end() - 4, account.bytes.end());
-    encode32BE(static_cast<uint32_t>(sign.size()), signature);
-    signature.insert(signature.end(), sign.begin(), sign.end());
+    auto writer = XdrWriter(signature, size + 4 + 4 + 4 + signatureSize);
+    encode(input, account, writer);
+
+    // hash of network id, envelope type and transaction
+    SHA256_CTX context;
+    sha256_Init(&context);
+    sha256_Update(&context, networkId.data(), networkId.size());
+    const byte transactionType[] = {0, 0, 0, 2}; // Header
+    sha256_Update(&context, transactionType, sizeof(transactionType));
+    sha256_Update(&context, signature.data(), signature.size());
+    auto hash = Data(SHA256_DIGEST_LENGTH);
+    sha256_Final(&context, hash.data());
+
+    auto sign = key.sign(hash);
+
+    // decorated signature
+    writer.write32(1);
+    writer.writeBytes(DataView(account.bytes.data() + account.bytes.size() - 4, 4));
+    writer.writeVariable(sign);
     return Base64::encode(signature);
 }
 
+const Data& Signer::networkId(const std::string& passphrase) {
+    thread_local std::string cachedPassphrase;
+    thread_local Data cachedId;
+    if (cachedId.empty() || cachedPassphrase != passphrase) {
+        cachedId = Hash::sha256(passphrase);
+        cachedPassphrase = passphrase;
+    }
+    return cachedId;
+}
+
 Data Signer::encode(const Proto::SigningInput& input) const {
-    //    Address account, uint32_t fee, uint64_t sequence, uint32_t memoType,
-    //    Data memoData, Address destination, uint64_t amount;
     auto data = Data();
+    auto writer = XdrWriter(data, encodedSize(input));
+    encode(input, Address(input.account()), writer);
+    return data;
+}
 
-    encodeAddress(Address(input.account()), data);
-    encode32BE(input.fee(), data);
-    encode64BE(input.sequence(), data);
+size_t Signer::encodedSize(const Proto::SigningInput& input) {
+    // account, fee, sequence, time bounds flag
+    size_t size = addressSize + 4 + 8 + 4;
+    if (input.has_op_change_trust() && input.op_change_trust().valid_before() != 0) {
+        size += 8 + 8;
+    }
+    size += 4; // memo type
+    if (input.has_memo_id()) {
+        size += 8;
+    } else if (input.has_memo_text()) {
+        size += xdrVariableSize(input.memo_text().text().size());
+    } else if (input.has_memo_hash()) {
+        size += input.memo_hash().hash().size();
+    } else if (input.has_memo_return_hash()) {
+        size += input.memo_return_hash().hash().size();
+    }
+    // operation count, source, type
+    size += 4 + 4 + 4;
+    switch (input.operation_oneof_case()) {
+        case Proto::SigningInput::kOpCreateAccount:
+        default:
+            size += addressSize + 8;
+            break;
+        case Proto::SigningInput::kOpPayment:
+            size += addressSize + 4 + (isAlphanum4(input.op_payment().asset()) ? 4 + addressSize : 0) + 8;
+            break;
+        case Proto::SigningInput::kOpChangeTrust:
+            size += 4 + (isAlphanum4(input.op_change_trust().asset()) ? 4 + addressSize : 0) + 8;
+            break;
+    }
+    return size + 4; // ext
+}
+
+void Signer::encode(const Proto::SigningInput& input, const Address& account, XdrWriter& writer) {
+    //    Address account, uint32_t fee, uint64_t sequence, uint32_t memoType,
+    //    Data memoData, Address destination, uint64_t amount;
+    encodeAddress(account, writer);
+    writer.write32(input.fee());
+    writer.write64(input.sequence());
 
     // Time bounds
     if (input.has_op_change_trust() && input.op_change_trust().valid_before() != 0) {
-        encode32BE(1, data);
-        encode64BE(0, data); // from
-        encode64BE(input.op_change_trust().valid_before(), data); // to
+        writer.write32(1);
+        writer.write64(0); // from
+        writer.write64(input.op_change_trust().valid_before()); // to
     } else {
-        encode32BE(0, data); // missing
+        writer.write32(0); // missing
     }
 
     // Memo
     if (input.has_memo_id()) {
-        encode32BE(TWStellarMemoTypeId, data);
-        encode64BE(input.memo_id().id(), data);
+        writer.write32(TWStellarMemoTypeId);
+        writer.write64(input.memo_id().id());
     } else if (input.has_memo_text()) {
-        encode32BE(TWStellarMemoTypeText, data);
-        encode32BE(static_cast<uint32_t>(input.memo_text().text().size()), data);
-        data.insert(data.end(), input.memo_text().text().begin(), input.memo_text().text().end());
-        pad(data);
+        writer.write32(TWStellarMemoTypeText);
+        const auto& text = input.memo_text().text();
+        writer.writeVariable(DataView(reinterpret_cast<const byte*>(text.data()), text.size()));
     } else if (input.has_memo_hash()) {
-        encode32BE(TWStellarMemoTypeHash, data);
-        data.insert(data.end(), input.memo_hash().hash().begin(), input.memo_hash().hash().end());
+        writer.write32(TWStellarMemoTypeHash);
+        const auto& hash = input.memo_hash().hash();
+        writer.writeBytes(DataView(reinterpret_cast<const byte*>(hash.data()), hash.size()));
     } else if (input.has_memo_return_hash()) {
-        encode32BE(TWStellarMemoTypeReturn, data);
-        data.insert(data.end(), input.memo_return_hash().hash().begin(),
-                    input.memo_return_hash().hash().end());
+        writer.write32(TWStellarMemoTypeReturn);
+        const auto& hash = input.memo_return_hash().hash();
+        writer.writeBytes(DataView(reinterpret_cast<const byte*>(hash.data()), hash.size()));
     } else {
-        encode32BE(TWStellarMemoTypeNone, data);
+        writer.write32(TWStellarMemoTypeNone);
     }
 
     // Operations
-    encode32BE(1, data);                      // Operation list size. Only 1 operation.
-    encode32BE(0, data);                      // Source equals account
-    encode32BE(operationType(input), data); // Operation type
+    writer.write32(1);                      // Operation list size. Only 1 operation.
+    writer.write32(0);                      // Source equals account
+    writer.write32(operationType(input)); // Operation type
 
     switch (input.operation_oneof_case()) {
         case Proto::SigningInput::kOpCreateAccount:
         default:
-            encodeAddress(Address(input.op_create_account().destination()), data);
-            encode64BE(input.op_create_account().amount(), data);
+            encodeAddress(Address(input.op_create_account().destination()), writer);
+            writer.write64(input.op_create_account().amount());
             break;
 
         case Proto::SigningInput::kOpPayment:
-            encodeAddress(Address(input.op_payment().destination()), data);
-            encodeAsset(input.op_payment().asset(), data);
-            encode64BE(input.op_payment().amount(), data);
+            encodeAddress(Address(input.op_payment().destination()), writer);
+            encodeAsset(input.op_payment().asset(), writer);
+            writer.write64(input.op_payment().amount());
             break;
 
         case Proto::SigningInput::kOpChangeTrust:
-            encodeAsset(input.op_change_trust().asset(), data);
-            encode64BE(0x7fffffffffffffff, data); // limit MAX
+            encodeAsset(input.op_change_trust().asset(), writer);
+            writer.write64(0x7fffffffffffffff); // limit MAX
             break;
     }
 
-    encode32BE(0, data); // Ext
-    return data;
+    writer.write32(0); // Ext
 }
 
 uint32_t Signer::operationType(const Proto::SigningInput& input) {
@@ -130,38 +208,24 @@ uint32_t Signer::operationType(const Proto::SigningInput& input) {
     }
 }
 
-void Signer::encodeAddress(const Address& address, Data& data) {
-    encode32BE(0, data);
-    data.insert(data.end(), address.bytes.begin(), address.bytes.end());
+void Signer::encodeAddress(const Address& address, XdrWriter& writer) {
+    writer.write32(0);
+    writer.writeBytes(address.bytes);
 }
 
-void Signer::encodeAsset(const Proto::Asset& asset, Data& data) {
-    uint32_t assetType = 0; // native
-    std::string alphaUse;
-    if (asset.issuer().length() > 0 && Address::isValid(asset.issuer()) && asset.alphanum4().length() > 0) {
-        assetType = 1; // alphanum4
-        alphaUse = asset.alphanum4();
-    }
-    encode32BE(assetType, data);
-    if (assetType > 0) {
-        for (auto i = 0; i < 4; ++i) {
-            if (alphaUse.length() > i) {
-                data.push_back(alphaUse[i]);
-            } else {
-                data.push_back(0); // pad with 0s
-            }
-        }
-        encodeAddress(Address(asset.issuer()), data);
-    }
+bool Signer::isAlphanum4(const Proto::Asset& asset) {
+    return asset.issuer().length() > 0 && Address::isValid(asset.issuer()) && asset.alphanum4().length() > 0;
 }
 
-void Signer::pad(Data& data) const {
-    int pad = 0;
-    int mod = static_cast<int>(data.size() % 4);
-    if (mod > 0) {
-        pad = 4 - mod;
-    }
-    while (pad-- > 0) {
-        data.insert(data.end(), 0);
+void Signer::encodeAsset(const Proto::Asset& asset, XdrWriter& writer) {
+    if (!isAlphanum4(asset)) {
+        writer.write32(0); // native
+        return;
     }
+    writer.write32(1); // alphanum4
+    const auto& alphaUse = asset.alphanum4();
+    byte code[4] = {0, 0, 0, 0}; // pad with 0s
+    std::copy_n(alphaUse.begin(), std::min<size_t>(alphaUse.length(), 4), code);
+    writer.writeBytes(DataView(code, sizeof(code)));
+    encodeAddress(Address(asset.issuer()), writer);
 }
@@ -6,12 +6,15 @@
 #pragma once
 
 #include "Address.h"
+#include "Xdr.h"
 #include "../Data.h"
+#include "../Ed25519SigningKey.h"
 #include "../Hash.h"
 #include "../PrivateKey.h"
 #include "../proto/Stellar.pb.h"
 
 #include <string>
+#include <vector>
 
 namespace TW::Stellar {
 /// Helper class that performs Ripple transaction signing.
@@ -19,6 +22,15 @@ class Signer {
   public:
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
+
+    /// Signs one transaction per payment, from the account of `input` (its operation is ignored).
+    /// Sequence numbers are consecutive, starting at the sequence of `input`.
+    /// threadCount 0 uses the available hardware concurrency.
+    static std::vector<Proto::SigningOutput> signPayments(const Proto::SigningInput& input, const std::vector<Proto::OperationPayment>& payments, size_t threadCount = 0);
+
+    /// Size of the encoded transaction.
+    static size_t encodedSize(const Proto::SigningInput& input);
+
   public:
     const Proto::SigningInput& input;
 
@@ -30,10 +42,14 @@ class Signer {
     Data encode(const Proto::SigningInput& input) const;
 
   private:
+    static std::string sign(const Proto::SigningInput& input, const Ed25519SigningKey& key, const Address& account, const Data& networkId);
+    static void encode(const Proto::SigningInput& input, const Address& account, XdrWriter& writer);
+    /// sha256 of the network passphrase, the last one is cached per thread
+    static const Data& networkId(const std::string& passphrase);
     static uint32_t operationType(const Proto::SigningInput& input);
-    static void encodeAddress(const Address& address, Data& data);
-    static void encodeAsset(const Proto::Asset& asset, Data& data);
-    void pad(Data& data) const;
+    static void encodeAddress(const Address& address, XdrWriter& writer);
+    static void encodeAsset(const Proto::Asset& asset, XdrWriter& writer);
+    static bool isAlphanum4(const Proto::Asset& asset);
 };
 
 } // namespace TW::Stellar
@@ -0,0 +1,46 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "../BinaryCoding.h"
+#include "../Data.h"
+
+#include <cstdint>
+
+namespace TW::Stellar {
+
+/// Size of variable-length opaque data or a string, with its length and padding.
+inline size_t xdrVariableSize(size_t size) {
+    return 4 + (size + 3) / 4 * 4;
+}
+
+/// Appends XDR (RFC 4506) values to a buffer, reserving the expected size upfront.
+class XdrWriter {
+  public:
+    explicit XdrWriter(Data& data, size_t reservedSize = 0) : data(data) {
+        data.reserve(data.size() + reservedSize);
+    }
+
+    void write32(uint32_t value) { encode32BE(value, data); }
+
+    void write64(uint64_t value) { encode64BE(value, data); }
+
+    /// Writes bytes as they are, without padding.
+    void writeBytes(DataView bytes) { append(data, bytes); }
+
+    /// Writes variable-length opaque data or a string: length, bytes, and zero padding to 4 bytes.
+    void writeVariable(DataView bytes) {
+        write32(static_cast<uint32_t>(bytes.size()));
+        writeBytes(bytes);
+        data.insert(data.end(), (4 - bytes.size() % 4) % 4, 0);
+    }
+
+  private:
+    Data& data;
+};
+
+} // namespace TW::Stellar
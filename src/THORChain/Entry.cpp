@@ -14,11 +14,19 @@ using namespace std;
 
 // Note: avoid business logic from here, rather just call into classes like Address, Signer, etc.
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
-    auto input = Cosmos::Proto::SigningInput();
-    input.ParseFromArray(dataIn.data(), (int)dataIn.size());
-    auto serializedOut = Signer::sign(input).SerializeAsString();
-    dataOut.insert(dataOut.end(), serializedOut.begin(), serializedOut.end());
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
+    signTemplate<Signer, Cosmos::Proto::SigningInput>(dataIn, dataOut);
+}
+
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    if (input.GetDescriptor() != Cosmos::Proto::SigningInput::descriptor() ||
+        output.GetDescriptor() != Cosmos::Proto::SigningOutput::descriptor()) {
+        return false;
+    }
+    // the signer sets the THORChain message type prefixes on its input
+    auto copy = static_cast<const Cosmos::Proto::SigningInput&>(input);
+    static_cast<Cosmos::Proto::SigningOutput&>(output) = Signer::sign(copy);
+    return true;
 }
 
 string Entry::signJSON(TWCoinType coin, const std::string& json, const Data& key) const { 
@@ -18,7 +18,8 @@ public:
     virtual const std::vector<TWCoinType> coinTypes() const {
         return { TWCoinTypeTHORChain };
     }
-    virtual void sign(TWCoinType coin, const Data& dataIn, Data& dataOut) const;
+    virtual void sign(TWCoinType coin, DataView dataIn, Data& dataOut) const;
+    virtual bool signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const;
     virtual std::string signJSON(TWCoinType coin, const std::string& json, const Data& key) const;
 };
 
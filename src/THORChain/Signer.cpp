@@ -5,11 +5,11 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "../Cosmos/Address.h"
+#include "../Cosmos/JsonInput.h"
 #include "../Cosmos/Signer.h"
 #include "../proto/Cosmos.pb.h"
 
-#include <google/protobuf/util/json_util.h>
-
 using namespace TW;
 using namespace TW::THORChain;
 
@@ -17,16 +17,32 @@ const std::string TYPE_PREFIX_MSG_SEND = "thorchain/MsgSend";
 
 Cosmos::Proto::SigningOutput Signer::sign(Cosmos::Proto::SigningInput& input) noexcept {
     for (auto i = 0; i < input.messages_size(); ++i) {
-        if (input.messages(i).has_send_coins_message()) {
+        if (!input.messages(i).has_send_coins_message()) {
+            continue;
+        }
+        if (input.signing_mode() != Cosmos::Proto::Protobuf) {
             input.mutable_messages(i)->mutable_send_coins_message()->set_type_prefix(TYPE_PREFIX_MSG_SEND);
+            continue;
+        }
+        // thorchain's own MsgSend, with addresses as bytes
+        const auto send = input.messages(i).send_coins_message();
+        Cosmos::Address from;
+        Cosmos::Address to;
+        if (!Cosmos::Address::decode(send.from_address(), from) || !Cosmos::Address::decode(send.to_address(), to)) {
+            auto output = Cosmos::Proto::SigningOutput();
+            output.set_error(Common::Proto::Error_general);
+            return output;
         }
+        auto& thorchainSend = *input.mutable_messages(i)->mutable_thorchain_send_message();
+        thorchainSend.set_from_address(from.getKeyHash().data(), from.getKeyHash().size());
+        thorchainSend.set_to_address(to.getKeyHash().data(), to.getKeyHash().size());
+        *thorchainSend.mutable_amounts() = send.amounts();
     }
     return Cosmos::Signer::sign(input);
 }
 
 std::string Signer::signJSON(const std::string& json, const Data& key) {
-    auto input = Cosmos::Proto::SigningInput();
-    google::protobuf::util::JsonStringToMessage(json, &input);
+    auto input = Cosmos::signingInputFromJSON(json);
     input.set_private_key(key.data(), key.size());
     auto output = Signer::sign(input);
     return output.json();
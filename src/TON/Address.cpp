@@ -42,18 +42,22 @@ Address::Address(const PublicKey& publicKey, WorkchainId_t workchain) {
         throw std::invalid_argument("Invalid public key type");
     }
 
-    Cell stateInit = Contract::createStateInit(publicKey);
-
-    // compute hash of stateInit
-    auto hash = stateInit.hash();
-
     // fill members
     workchainId = workchain;
-    addrBytes = hash;
+    addrBytes = Contract::stateInitHash(publicKey);
     isBounceable = true;
     isTestOnly = false;
 }
 
+std::vector<std::string> Address::deriveAddresses(const std::vector<PublicKey>& publicKeys, WorkchainId_t workchain) {
+    std::vector<std::string> addresses;
+    addresses.reserve(publicKeys.size());
+    for (const auto& publicKey : publicKeys) {
+        addresses.push_back(Address(publicKey, workchain).string());
+    }
+    return addresses;
+}
+
 bool Address::isValid(const std::string& address, WorkchainId_t workchain) {
     Address addr;
     bool isValid = parseAddress(address, addr);
@@ -9,6 +9,7 @@
 #include "../PublicKey.h"
 
 #include <string>
+#include <vector>
 
 namespace TW::TON {
 
@@ -45,6 +46,11 @@ class Address {
     /// Initializes a TON address with a public key.  WorkchainId is optional, Basic chain by default.
     explicit Address(const PublicKey& publicKey, WorkchainId_t workchain = Workchain::defaultChain());
 
+    /// Returns the user friendly addresses of many public keys, in their order.  The wallet code cell is
+    /// shared, each address costs the hashes of its data cell and StateInit root.
+    static std::vector<std::string> deriveAddresses(const std::vector<PublicKey>& publicKeys,
+                                                    WorkchainId_t workchain = Workchain::defaultChain());
+
     /// Determines whether a string makes a valid address, in any format
     static bool isValid(const std::string& address, WorkchainId_t workchain = Workchain::defaultChain());
 
@@ -0,0 +1,270 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BagOfCells.h"
+
+#include <TrezorCrypto/sha2.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace TW;
+using namespace TW::TON;
+
+static const uint32_t magicGeneric = 0xb5ee9c72;
+static const uint32_t magicIndexed = 0x68ff65f3;
+static const uint32_t magicIndexedCrc32c = 0xacc3a728;
+
+/// Bounds-checked big-endian reader.
+class Reader {
+  public:
+    explicit Reader(DataView data) : data(data) {}
+
+    size_t position() const { return offset; }
+
+    uint64_t read(size_t bytes) {
+        require(bytes);
+        uint64_t value = 0;
+        for (size_t i = 0; i < bytes; ++i) {
+            value = (value << 8) | data[offset++];
+        }
+        return value;
+    }
+
+    DataView readView(size_t bytes) {
+        require(bytes);
+        const auto view = data.subView(offset, bytes);
+        offset += bytes;
+        return view;
+    }
+
+  private:
+    DataView data;
+    size_t offset = 0;
+
+    void require(size_t bytes) const {
+        if (bytes > data.size() - offset) {
+            throw std::invalid_argument("BagOfCells: truncated data");
+        }
+    }
+};
+
+BagOfCells::BagOfCells(DataView data) {
+    Reader reader(data);
+    const auto magic = static_cast<uint32_t>(reader.read(4));
+    const auto flags = static_cast<byte>(reader.read(1));
+    bool hasIndex = false;
+    bool hasCrc32c = false;
+    switch (magic) {
+    case magicGeneric:
+        hasIndex = (flags & 0x80) != 0;
+        hasCrc32c = (flags & 0x40) != 0;
+        break;
+    case magicIndexed:
+        hasIndex = true;
+        break;
+    case magicIndexedCrc32c:
+        hasIndex = true;
+        hasCrc32c = true;
+        break;
+    default:
+        throw std::invalid_argument("BagOfCells: invalid magic");
+    }
+    const int refSize = flags & 0x07;
+    const auto offsetSize = static_cast<int>(reader.read(1));
+    if (refSize < 1 || refSize > 4 || offsetSize < 1 || offsetSize > 8) {
+        throw std::invalid_argument("BagOfCells: invalid sizes");
+    }
+    const auto cellCount = reader.read(refSize);
+    const auto rootCount = reader.read(refSize);
+    const auto absentCount = reader.read(refSize);
+    const auto dataSize = reader.read(offsetSize);
+    if (cellCount == 0 || rootCount == 0 || rootCount > cellCount || absentCount != 0) {
+        throw std::invalid_argument("BagOfCells: invalid counts");
+    }
+    // each cell takes at least 2 bytes, reject counts the data can't hold before allocating
+    if (cellCount > data.size() / 2 || rootCount > data.size() / refSize) {
+        throw std::invalid_argument("BagOfCells: truncated data");
+    }
+
+    roots.reserve(rootCount);
+    for (uint64_t i = 0; i < rootCount; ++i) {
+        const auto index = reader.read(refSize);
+        if (index >= cellCount) {
+            throw std::invalid_argument("BagOfCells: invalid root index");
+        }
+        roots.push_back(static_cast<uint32_t>(index));
+    }
+    if (hasIndex) {
+        reader.readView(static_cast<size_t>(cellCount) * offsetSize);
+    }
+    if (dataSize > data.size()) {
+        throw std::invalid_argument("BagOfCells: truncated data");
+    }
+    const auto cellData = reader.readView(static_cast<size_t>(dataSize));
+    if (hasCrc32c) {
+        const auto crcOffset = reader.position();
+        const auto crc = reader.read(4);
+        const auto expected = Cell::computeCrc(data.data(), crcOffset);
+        // little endian
+        const auto actual = ((crc & 0xff) << 24) | ((crc & 0xff00) << 8) | ((crc >> 8) & 0xff00) | (crc >> 24);
+        if (actual != expected) {
+            throw std::invalid_argument("BagOfCells: CRC32-C mismatch");
+        }
+    }
+    if (reader.position() != data.size()) {
+        throw std::invalid_argument("BagOfCells: trailing data");
+    }
+
+    cells.resize(static_cast<size_t>(cellCount));
+    parseCells(cellData, refSize);
+    hashes.resize(cells.size());
+    depths.resize(cells.size());
+    hashed.resize(cells.size());
+}
+
+void BagOfCells::parseCells(DataView data, int refSize) {
+    Reader reader(data);
+    for (size_t index = 0; index < cells.size(); ++index) {
+        auto& cell = cells[index];
+        cell.d1 = static_cast<byte>(reader.read(1));
+        cell.d2 = static_cast<byte>(reader.read(1));
+        cell.refCount = cell.d1 & 0x07;
+        const bool exotic = (cell.d1 & 0x08) != 0;
+        const bool withHashes = (cell.d1 & 0x10) != 0;
+        const int level = cell.d1 >> 5;
+        if (cell.refCount > Cell::max_cells) {
+            throw std::invalid_argument("BagOfCells: invalid reference count");
+        }
+        if (exotic || level != 0) {
+            throw std::invalid_argument("BagOfCells: exotic cells not supported");
+        }
+        if (withHashes) {
+            // stored hash and depth of level 0, recomputed on demand
+            reader.readView(32 + 2);
+        }
+        const size_t size = (cell.d2 >> 1) + (cell.d2 & 1);
+        cell.data = reader.readView(size);
+        cell.sizeBits = size * 8;
+        if ((cell.d2 & 1) != 0) {
+            // completion tag: highest unused bit is set
+            const auto last = cell.data[size - 1];
+            if (last == 0) {
+                throw std::invalid_argument("BagOfCells: invalid completion tag");
+            }
+            size_t unused = 1;
+            while ((last & (1u << (unused - 1))) == 0) {
+                ++unused;
+            }
+            if (unused == 8) {
+                // a whole unused byte, not canonical
+                throw std::invalid_argument("BagOfCells: invalid completion tag");
+            }
+            cell.sizeBits -= unused;
+        }
+        for (uint8_t i = 0; i < cell.refCount; ++i) {
+            const auto ref = reader.read(refSize);
+            if (ref <= index || ref >= cells.size()) {
+                throw std::invalid_argument("BagOfCells: invalid reference");
+            }
+            cell.refs[i] = static_cast<uint32_t>(ref);
+        }
+    }
+    if (reader.position() != data.size()) {
+        throw std::invalid_argument("BagOfCells: invalid data size");
+    }
+}
+
+Data BagOfCells::hash(size_t index) const {
+    computeHash(index);
+    return Data(hashes[index].begin(), hashes[index].end());
+}
+
+uint16_t BagOfCells::depth(size_t index) const {
+    computeHash(index);
+    return depths[index];
+}
+
+void BagOfCells::computeHash(size_t index) const {
+    if (hashed.at(index)) {
+        return;
+    }
+    // Iterative post-order, references always point forward so there are no cycles
+    std::vector<uint32_t> stack = {static_cast<uint32_t>(index)};
+    while (!stack.empty()) {
+        const auto current = stack.back();
+        const auto& cell = cells[current];
+        bool ready = true;
+        for (uint8_t i = 0; i < cell.refCount; ++i) {
+            if (!hashed[cell.refs[i]]) {
+                stack.push_back(cell.refs[i]);
+                ready = false;
+            }
+        }
+        if (!ready) {
+            continue;
+        }
+        stack.pop_back();
+        if (hashed[current]) {
+            continue;
+        }
+        SHA256_CTX context;
+        sha256_Init(&context);
+        const byte descriptors[2] = {cell.refCount, Cell::d2(cell.sizeBits)};
+        sha256_Update(&context, descriptors, sizeof(descriptors));
+        sha256_Update(&context, cell.data.data(), cell.data.size());
+        uint16_t depth = 0;
+        for (uint8_t i = 0; i < cell.refCount; ++i) {
+            const auto childDepth = depths[cell.refs[i]];
+            const byte bytes[2] = {static_cast<byte>(childDepth >> 8), static_cast<byte>(childDepth)};
+            sha256_Update(&context, bytes, sizeof(bytes));
+            depth = std::max(depth, static_cast<uint16_t>(childDepth + 1));
+        }
+        for (uint8_t i = 0; i < cell.refCount; ++i) {
+            sha256_Update(&context, hashes[cell.refs[i]].data(), hashes[cell.refs[i]].size());
+        }
+        sha256_Final(&context, hashes[current].data());
+        depths[current] = depth;
+        hashed[current] = true;
+    }
+}
+
+Slice BagOfCells::slice(size_t index) const {
+    const auto& cell = cells.at(index);
+    Slice slice;
+    if (cell.sizeBits > 0) {
+        // the completion tag is rebuilt by appendBits
+        slice.appendBits(cell.data.toData(), cell.sizeBits);
+    }
+    return slice;
+}
+
+std::shared_ptr<Cell> BagOfCells::toCell(size_t index) const {
+    std::vector<std::shared_ptr<Cell>> built(cells.size());
+    // children have greater indices, build from the end
+    std::vector<bool> needed(cells.size());
+    needed.at(index) = true;
+    for (size_t i = index; i < cells.size(); ++i) {
+        if (!needed[i]) {
+            continue;
+        }
+        for (uint8_t r = 0; r < cells[i].refCount; ++r) {
+            needed[cells[i].refs[r]] = true;
+        }
+    }
+    for (size_t i = cells.size(); i-- > index;) {
+        if (!needed[i]) {
+            continue;
+        }
+        auto cell = std::make_shared<Cell>();
+        cell->setSlice(slice(i));
+        for (uint8_t r = 0; r < cells[i].refCount; ++r) {
+            cell->addCell(built[cells[i].refs[r]]);
+        }
+        built[i] = cell;
+    }
+    return built[index];
+}
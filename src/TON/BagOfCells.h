@@ -0,0 +1,71 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Cell.h"
+#include "../Data.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace TW::TON {
+
+/// Cell of a parsed bag of cells, referring to the bytes of the source buffer.
+struct CellView {
+    /// Cell data, including the completion tag if the size is not a multiple of 8 bits
+    DataView data;
+    size_t sizeBits = 0;
+    /// Descriptor bytes, as serialized
+    byte d1 = 0;
+    byte d2 = 0;
+    uint8_t refCount = 0;
+    /// Indices of the referenced cells, always greater than the index of this cell
+    std::array<uint32_t, Cell::max_cells> refs = {};
+};
+
+/// Read-only, zero-copy parser of serialized bags of cells (BoC).
+///
+/// Cells refer to the source buffer, which must outlive the parser; parsing allocates once for all cells.
+/// Hashes are computed on demand and cached.  Only ordinary cells are supported (no exotic cells, level 0).
+/// Not thread-safe, use one instance per thread.
+class BagOfCells {
+  public:
+    /// Parses a bag of cells, the CRC32-C is verified if present.
+    ///
+    /// @throws std::invalid_argument if the data is not a valid bag of cells.
+    explicit BagOfCells(DataView data);
+
+    size_t cellCount() const { return cells.size(); }
+    size_t rootCount() const { return roots.size(); }
+    /// Index of the root cell at `index`.
+    uint32_t root(size_t index = 0) const { return roots.at(index); }
+    const CellView& cell(size_t index) const { return cells.at(index); }
+
+    /// Representation hash of the cell at `index`.
+    Data hash(size_t index) const;
+    /// Depth of the tree under the cell at `index`.
+    uint16_t depth(size_t index) const;
+
+    /// Copies the data of the cell at `index` into a Slice.
+    Slice slice(size_t index) const;
+    /// Copies the tree under the cell at `index` into Cells, shared cells are copied once.
+    std::shared_ptr<Cell> toCell(size_t index) const;
+
+  private:
+    std::vector<CellView> cells;
+    std::vector<uint32_t> roots;
+    mutable std::vector<std::array<byte, 32>> hashes;
+    mutable std::vector<uint16_t> depths;
+    mutable std::vector<bool> hashed;
+
+    void parseCells(DataView data, int refSize);
+    void computeHash(size_t index) const;
+};
+
+} // namespace TW::TON
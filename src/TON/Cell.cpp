@@ -5,11 +5,11 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Cell.h"
+#include "../Crc.h"
 #include "../Hash.h"
 #include "../HexCoding.h"
 
-#include <boost/crc.hpp>  // for boost::crc_32_type
-
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <memory>
@@ -166,10 +166,11 @@ Data Slice::hash() const {
 }
 
 
-Cell::Cell(const Cell& from) : _cells(from._cells), _slice(from._slice) {}
+Cell::Cell(const Cell& from) : _cells(from._cells), _slice(from._slice), _hash(from._hash), _depth(from._depth), _hashValid(from._hashValid) {}
 
 void Cell::setSlice(Slice const& slice) {
     _slice = slice;
+    invalidateHash();
 }
 
 void Cell::setSliceBytes(const Data& data) {
@@ -192,6 +193,7 @@ void Cell::addCell(std::shared_ptr<Cell> const& cell) {
         throw std::runtime_error("too many cells");
     }
     _cells.push_back(cell);
+    invalidateHash();
 }
 
 std::string Cell::toString() const {
@@ -215,8 +217,22 @@ std::string Cell::toString() const {
 }
 
 Data Cell::hash() const {
+    computeHash();
+    return _hash;
+}
+
+uint16_t Cell::depth() const {
+    computeHash();
+    return _depth;
+}
+
+void Cell::computeHash() const {
+    if (_hashValid) {
+        return;
+    }
     // Need to copy data together into a contiguous area
     Data hashData;
+    hashData.reserve(2 + _slice.size() + cellCount() * (2 + 32));
     // number of children
     hashData.push_back(static_cast<byte>(cellCount()));
     // number of hex digits
@@ -226,55 +242,81 @@ Data Cell::hash() const {
     if (_slice.size() > 0) {
         append(hashData, _slice.data());
     }
-    // children
-    if (cellCount() > 0) {
-        for (auto i = _cells.begin(), n = _cells.end(); i != n; ++i) {
-            hashData.push_back(0);
-            hashData.push_back(0);
-        }
-        for (auto i = _cells.begin(), n = _cells.end(); i != n; ++i) {
-            auto childHash = i->get()->hash();
-            append(hashData, childHash);
-        }
+    // children, depths then hashes; cached in the children, so each cell of the tree is hashed once
+    uint16_t depth = 0;
+    for (const auto& c: _cells) {
+        const auto childDepth = c->depth();
+        hashData.push_back(static_cast<byte>(childDepth >> 8));
+        hashData.push_back(static_cast<byte>(childDepth));
+        depth = std::max(depth, static_cast<uint16_t>(childDepth + 1));
+    }
+    for (const auto& c: _cells) {
+        append(hashData, c->hash());
     }
     // compute hash
-    return Hash::sha256(hashData);
+    _hash = Hash::sha256(hashData);
+    _depth = depth;
+    _hashValid = true;
 }
 
-Cell::SerializationInfo Cell::getSerializationInfo(SerializationMode mode) const {
-    SerializationInfo info = SerializationInfo();
-    size_t rawDataSize = serializedOwnSize();
-    for (auto c: _cells) {
-        rawDataSize += c->serializedOwnSize();
+Cell::BagOfCells Cell::collectCells() const {
+    BagOfCells bag;
+    std::vector<const Cell*> postOrder;
+    collectCells(bag, postOrder);
+    // reverse post-order is topological: every cell comes before the cells it references
+    bag.cells.assign(postOrder.rbegin(), postOrder.rend());
+    for (size_t i = 0; i < bag.cells.size(); ++i) {
+        bag.indices[bag.cells[i]->hash()] = i;
     }
-    int intRefs = (int)cellCount();
-    uint8_t refSize = 1;
-    while (cellCount() >= ((size_t)1 << (refSize * 8))) { ++refSize; }
-    assert(refSize >= 1 && refSize <= 8);
-    size_t hashes = 0;
-    size_t dataBytesAdj = rawDataSize + (size_t)intRefs * refSize + hashes;
-    size_t maxOffset = (mode & SerializationMode::WithCacheBits) ? dataBytesAdj * 2 : dataBytesAdj;
-    int offsetSize = 0;
-    while (maxOffset >= (1ULL << (offsetSize * 8))) { ++offsetSize; }
-    if (refSize > 4 || offsetSize > 8) { return info; }
-
-    info.refByteSize = refSize;
-    info.offsetByteSize = 1;
+    return bag;
+}
+
+void Cell::collectCells(BagOfCells& bag, std::vector<const Cell*>& postOrder) const {
+    // mark as visited, the index is assigned once the order is known
+    if (!bag.indices.emplace(hash(), 0).second) {
+        return;
+    }
+    // children in reverse order, so that they end up in order after reversal
+    for (auto i = _cells.rbegin(); i != _cells.rend(); ++i) {
+        (*i)->collectCells(bag, postOrder);
+    }
+    postOrder.push_back(this);
+}
+
+/// Number of bytes needed for values up to `value`, at least 1
+static int byteSize(size_t value) {
+    int size = 1;
+    while (size < 8 && value >= (1ULL << (size * 8))) { ++size; }
+    return size;
+}
+
+static void appendBigEndian(Data& data, uint64_t value, int size) {
+    for (int i = size - 1; i >= 0; --i) {
+        data.push_back(static_cast<byte>(value >> (i * 8)));
+    }
+}
+
+Cell::SerializationInfo Cell::getSerializationInfo(const BagOfCells& bag, SerializationMode mode) const {
+    SerializationInfo info = SerializationInfo();
     info.rootCount = 1;
-    info.cellCount = info.rootCount + (int)cellCount();  // including self/roots
+    info.cellCount = (int)bag.cells.size();  // including self/roots
+    info.refByteSize = byteSize(bag.cells.size());
+    if (info.refByteSize > 4) {
+        throw std::invalid_argument("Cell::serialize: too many cells");
+    }
+    size_t dataSize = 0;
+    for (auto c: bag.cells) {
+        dataSize += c->serializedOwnSize() + c->cellCount() * info.refByteSize;
+    }
+    info.offsetByteSize = byteSize(dataSize);
     info.hasCrc32c = mode & SerializationMode::WithCRC32C;
     int crcSize = info.hasCrc32c ? 4 : 0;
-    int rootCount = 0;
-    unsigned long rootsOffset = 4 + 1 + 1 + 3 * info.refByteSize + info.offsetByteSize;
-    unsigned long indexOffset = rootsOffset + rootCount * info.refByteSize;
-    unsigned long dataOffset = indexOffset;
-    //if (info.has_index) {
-        //info.data_offset += (long long)cell_count * info.offset_byte_size;
-    //}
+    // magic, flags, offset size, cell count, root count, absent count, data size, root index
+    unsigned long dataOffset = 4 + 1 + 1 + 3 * info.refByteSize + info.offsetByteSize + info.rootCount * info.refByteSize;
     // Magic num idx 68ff65f3  idxCrc32c acc3a728  generic b5ee9c72
     info.magic = parse_hex("b5ee9c72");
-    info.dataSize = dataBytesAdj;
-    info.totalSize = dataOffset + dataBytesAdj + crcSize;
+    info.dataSize = dataSize;
+    info.totalSize = dataOffset + dataSize + crcSize;
     return info;
 }
 
@@ -284,30 +326,11 @@ size_t Cell::serializedOwnSize(bool withHashes) const {
 }
 
 size_t Cell::serializedSize(SerializationMode mode) const {
-    auto info = getSerializationInfo(mode);
-    size_t ss = 0;
-    ss += 4; // magic
-    ss += 5; // byte1, offsetByteSize, cellCount, rootCount, 
-    ss += info.offsetByteSize; // dataSize
-    ss += info.rootCount; // roots
-
-    ss += serializedOwnSize(false);
-    ss += cellCount(); // cell refs
-
-    // child cells
-    for(auto c: _cells) {
-        ss += c->serializedOwnSize(false);
-    }
-
-    if (mode & SerializationMode::WithCRC32C) {
-        ss += 4;
-    }
-    return ss;
+    return getSerializationInfo(collectCells(), mode).totalSize;
 }
 
 void Cell::serializeOwn(TW::Data& data_inout, bool withHashes) {
     if (withHashes) { throw std::invalid_argument("Cell::serializedOwnSize: WithHashes not supported"); }
-    //auto info = getSerializationInfo(mode);
     // slice
     data_inout.push_back((byte)cellCount());
     data_inout.push_back(d2(_slice.sizeBits()));
@@ -318,9 +341,11 @@ void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
     if (mode != SerializationMode::None && mode != SerializationMode::WithCRC32C) {
         throw std::invalid_argument("Cell::serialize: Mode " + std::to_string((int)mode) + " not supported");
     }
+    const auto bag = collectCells();
+    const auto info = getSerializationInfo(bag, mode);
     // save current start position
     size_t startIdx = data_inout.size();
-    auto info = getSerializationInfo(mode);
+    data_inout.reserve(startIdx + info.totalSize);
 
     // magic
     append(data_inout, info.magic);
@@ -330,31 +355,23 @@ void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
     if (info.hasCrc32c) { byte1 |= 1 << 6; }
     //if (info.has_cache_bits) { byte |= 1 << 5; }
     // 3, 4 - flags
-    if (info.refByteSize < 1 || info.refByteSize > 7) {
-        //cerr << info.refByteSize << endl;
-        return;
-    }
     byte1 |= static_cast<byte>(info.refByteSize);
     data_inout.push_back(byte1);
     data_inout.push_back((byte)info.offsetByteSize);
-    data_inout.push_back((byte)info.cellCount);
-    data_inout.push_back((byte)info.rootCount);
-    data_inout.push_back(0);
-    data_inout.push_back((byte)info.dataSize); // offset
-    data_inout.push_back(0); // roots
-
-    // own cell (slice)
-    serializeOwn(data_inout, false);
-    // cell refs?
-    uint8_t cidx = 0;
-    for(auto c: _cells) {
-        ++cidx;
-        data_inout.push_back(cidx);
-    }
-
-    // child cells
-    for(auto c: _cells) {
-        c->serializeOwn(data_inout, false);
+    appendBigEndian(data_inout, info.cellCount, info.refByteSize);
+    appendBigEndian(data_inout, info.rootCount, info.refByteSize);
+    appendBigEndian(data_inout, 0, info.refByteSize); // absent
+    appendBigEndian(data_inout, info.dataSize, info.offsetByteSize);
+    appendBigEndian(data_inout, 0, info.refByteSize); // root
+
+    // cells, with references by index
+    for (auto c: bag.cells) {
+        data_inout.push_back((byte)c->cellCount());
+        data_inout.push_back(d2(c->_slice.sizeBits()));
+        append(data_inout, c->_slice.data());
+        for (const auto& child: c->_cells) {
+            appendBigEndian(data_inout, bag.indices.at(child->hash()), info.refByteSize);
+        }
     }
 
     if (mode & SerializationMode::WithCRC32C) {
@@ -368,11 +385,7 @@ void Cell::serialize(TW::Data& data_inout, SerializationMode mode) {
 }
 
 uint32_t Cell::computeCrc(const byte* data, size_t len) {
-    // CRC32-C
-    using crc_32c_type = boost::crc_optimal<32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true>;
-    crc_32c_type result;
-    result.process_bytes((const void*)data, len);
-    return result.checksum();
+    return Crc::crc32C(DataView(data, len));
 }
 
 byte Cell::d2(size_t bits) {
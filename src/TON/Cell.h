@@ -8,7 +8,9 @@
 
 #include "../Data.h"
 
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace TW::TON {
 
@@ -48,6 +50,9 @@ private:
 };
 
 /// Represents a Cell, with references to other cells.
+///
+/// The hash and depth are computed once and cached, until the cell is modified.
+/// Child cells must not be modified after they are added, as the parent's cache would not notice.
 class Cell {
 public:
     enum SerializationMode: uint8_t {
@@ -93,26 +98,44 @@ public:
     const std::vector<std::shared_ptr<Cell>>& getCells() const { return _cells; }
     std::string toString() const;
     Data hash() const;
+    /// Depth of the tree under this cell, 0 for a cell without children
+    uint16_t depth() const;
     /// Serialized size of this cell only, without children
     size_t serializedOwnSize(bool withHashes = false) const;
     /// Serialized size, including children
     size_t serializedSize(SerializationMode mode = SerializationMode::None) const;
     /// Serialize this cell only, without children
     void serializeOwn(TW::Data& data_inout, bool withHashes = false);
-    /// Serialize this cell, including children
+    /// Serialize this cell, including children, as a bag of cells.  Identical subtrees are stored once.
     void serialize(TW::Data& data_inout, SerializationMode mode = SerializationMode::None);
     static const size_t max_cells = 4;
     /// second byte in length
     static byte d2(size_t bits);
-private:
     /// Compute 4-byte CRC32-C checksum, used in serialization
     static uint32_t computeCrc(const byte* data, size_t len);
+private:
+    /// Distinct cells of the tree, ordered so that references point forward (root first)
+    struct BagOfCells {
+        std::vector<const Cell*> cells;
+        /// Index of each cell, by hash
+        std::map<Data, size_t> indices;
+    };
+
+    /// Collect the distinct cells of the tree, in linear time
+    BagOfCells collectCells() const;
+    void collectCells(BagOfCells& bag, std::vector<const Cell*>& postOrder) const;
     // Prepare serialization properties
-    SerializationInfo getSerializationInfo(SerializationMode mode = SerializationMode::None) const;
+    SerializationInfo getSerializationInfo(const BagOfCells& bag, SerializationMode mode) const;
+    /// Compute the hash and depth, if not cached
+    void computeHash() const;
+    void invalidateHash() { _hashValid = false; }
 
 private:
     std::vector<std::shared_ptr<Cell>> _cells;
     Slice _slice;
+    mutable Data _hash;
+    mutable uint16_t _depth = 0;
+    mutable bool _hashValid = false;
 };
 
 } // namespace TW::TON
@@ -6,9 +6,13 @@
 
 #include "Contract.h"
 #include "../Data.h"
+#include "../Hash.h"
 #include "../HexCoding.h"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
+#include <stdexcept>
 
 namespace TW::TON {
 
@@ -24,10 +28,20 @@ Data Contract::walletContractDefault() {
     return parse_hex(walletContract3);
 }
 
+const std::shared_ptr<Cell>& Contract::walletCodeCell() {
+    static const auto code = [] {
+        auto cell = std::make_shared<Cell>();
+        cell->setSliceBytes(walletContractDefault());
+        // fill the hash cache now, the cell is read-only once shared
+        cell->hash();
+        return cell;
+    }();
+    return code;
+}
+
 Cell Contract::createStateInit(const PublicKey& pubkey) {
     // smart contract code -- constant
-    auto ccode = std::make_shared<Cell>();
-    ccode->setSliceBytes(walletContractDefault());
+    const auto& ccode = walletCodeCell();
 
     // data: 4 byte serial num (0), 32 byte public key
     Data data;
@@ -45,4 +59,34 @@ Cell Contract::createStateInit(const PublicKey& pubkey) {
     return stateInit;
 }
 
+Data Contract::stateInitHash(const PublicKey& pubkey) {
+    if (pubkey.bytes.size() != 32) {
+        throw std::invalid_argument("Invalid public key size");
+    }
+    // data cell: no children, 36 bytes (4 byte serial num (0), 32 byte public key)
+    std::array<byte, 2 + 4 + 32> data = {0, Cell::d2(36 * 8)};
+    std::copy(pubkey.bytes.begin(), pubkey.bytes.end(), data.begin() + 2 + 4);
+    const auto dataHash = Hash::sha256(data.data(), data.size());
+
+    // root: two children, b{00110}, the depths then the hashes of the code and data cells
+    static const auto prefix = [] {
+        const auto& code = walletCodeCell();
+        const auto slice = Slice::createFromBitsStr("30", 5);
+        Data prefix = {2, Cell::d2(slice.sizeBits())};
+        append(prefix, slice.data());
+        prefix.push_back(static_cast<byte>(code->depth() >> 8));
+        prefix.push_back(static_cast<byte>(code->depth()));
+        // data cell depth
+        prefix.push_back(0);
+        prefix.push_back(0);
+        append(prefix, code->hash());
+        return prefix;
+    }();
+    std::array<byte, 2 + 1 + 2 * 2 + 2 * 32> root;
+    assert(prefix.size() + dataHash.size() == root.size());
+    std::copy(prefix.begin(), prefix.end(), root.begin());
+    std::copy(dataHash.begin(), dataHash.end(), root.begin() + prefix.size());
+    return Hash::sha256(root.data(), root.size());
+}
+
 } // namespace TW::TON
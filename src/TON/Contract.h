@@ -10,6 +10,8 @@
 #include "../Data.h"
 #include "../PublicKey.h"
 
+#include <memory>
+
 namespace TW::TON {
 
 using namespace TW;
@@ -20,8 +22,16 @@ public:
     /// Return the (compiled) smart contract of a wallet account
     static Data walletContractDefault();
 
+    /// Code cell of the wallet contract, parsed and hashed once for the process.  Shared by all the
+    /// StateInit cells, must not be modified.
+    static const std::shared_ptr<Cell>& walletCodeCell();
+
     /// Create a StateInit structure for account initialization
     static Cell createStateInit(const PublicKey& pubkey);
+
+    /// Hash of the StateInit of a wallet, as createStateInit(pubkey).hash(): only the data cell and the root
+    /// are hashed, without building the cells.
+    static Data stateInitHash(const PublicKey& pubkey);
 };
 
 } // namespace TW::TON
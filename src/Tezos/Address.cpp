@@ -64,6 +64,11 @@ std::string Address::deriveOriginatedAddress(const std::string& operationHash, i
 }
 
 Data Address::forge() const {
-    std::string s = string();
-    return forgePublicKeyHash(s);
+    auto forged = Data();
+    forge(forged);
+    return forged;
+}
+
+void Address::forge(Data& forged) const {
+    forgePublicKeyHash(bytes, forged);
 }
@@ -33,6 +33,9 @@ class Address : public TW::Base58Address<23> {
 
     /// Forge an address to hex bytes.
     Data forge() const;
+
+    /// Appends the forged address to `forged`.
+    void forge(Data& forged) const;
 };
 
 } // namespace TW::Tezos
@@ -6,6 +6,7 @@
 
 #include "Address.h"
 #include "BinaryCoding.h"
+#include "Forging.h"
 #include "../Base58.h"
 #include "../Data.h"
 #include "../HexCoding.h"
@@ -27,109 +28,109 @@ Data forgeBool(bool input) {
 // Note: This function supports tz1, tz2 and tz3 addresses.
 Data forgePublicKeyHash(const std::string& publicKeyHash) {
     Data forged = Data();
-    // Adjust prefix based on tz1, tz2 or tz3.
-    switch ((char)publicKeyHash[2]) {
-    case '1':
+    forgePublicKeyHash(publicKeyHash, forged);
+    return forged;
+}
+
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& forged) {
+    std::array<byte, Address::size> decoded;
+    if (publicKeyHash.size() < 3 || !Base58::bitcoin.decodeCheck(publicKeyHash, decoded)) {
+        throw std::invalid_argument("Invalid public key hash");
+    }
+    forgePublicKeyHash(decoded, forged);
+}
+
+void forgePublicKeyHash(const std::array<byte, Address::size>& decoded, Data& forged) {
+    // Adjust prefix based on tz1 (6, 161, 159), tz2 (6, 161, 161) or tz3 (6, 161, 164).
+    // KT1 (2, 90, 121) shares the third character of tz1, and has always been forged like it.
+    switch (decoded[2]) {
+    case 159:
+    case 121:
         forged.push_back(0x00);
         break;
-    case '2':
+    case 161:
         forged.push_back(0x01);
         break;
-    case '3':
+    case 164:
         forged.push_back(0x02);
         break;
     default:
         throw std::invalid_argument("Invalid Prefix");
     }
-    const auto decoded = Base58::bitcoin.decodeCheck(publicKeyHash);
     const auto prefixSize = 3;
     forged.insert(forged.end(), decoded.begin() + prefixSize, decoded.end());
-    return forged;
 }
 
 // Forge the given public key into a hex encoded string.
 Data forgePublicKey(PublicKey publicKey) {
-    std::array<uint8_t, 4> prefix = {13, 15, 37, 217};
-    auto data = Data(prefix.begin(), prefix.end());
-    auto bytes = Data(publicKey.bytes.begin(), publicKey.bytes.end());
-    append(data, bytes);
-
-    auto pk = Base58::bitcoin.encodeCheck(data);
-    auto decoded = "00" + base58ToHex(pk, 4, prefix.data());
-    return parse_hex(decoded);
+    auto forged = Data();
+    forgePublicKey(publicKey, forged);
+    return forged;
+}
+
+void forgePublicKey(const PublicKey& publicKey, Data& forged) {
+    // ed25519 public key tag followed by the raw key
+    forged.push_back(0x00);
+    forged.insert(forged.end(), publicKey.bytes.begin(), publicKey.bytes.end());
 }
 
 // Forge the given zarith hash into a hex encoded string.
 Data forgeZarith(uint64_t input) {
     Data forged = Data();
+    forgeZarith(input, forged);
+    return forged;
+}
+
+void forgeZarith(uint64_t input, Data& forged) {
     while (input >= 0x80) {
         forged.push_back(static_cast<byte>((input & 0xff) | 0x80));
         input >>= 7;
     }
     forged.push_back(static_cast<byte>(input));
-    return forged;
 }
 
 // Forge the given operation.
 Data forgeOperation(const Operation& operation) {
+    auto forgedSource = Address(operation.source()).forge();
     auto forged = Data();
-    auto source = Address(operation.source());
-    auto forgedSource = source.forge();
-    auto forgedFee = forgeZarith(operation.fee());
-    auto forgedCounter = forgeZarith(operation.counter());
-    auto forgedGasLimit = forgeZarith(operation.gas_limit());
-    auto forgedStorageLimit = forgeZarith(operation.storage_limit());
-
-    if (operation.kind() == Operation_OperationKind_REVEAL) {
-        auto publicKey = PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519);
-        auto forgedPublicKey = forgePublicKey(publicKey);
-        
-        forged.push_back(Operation_OperationKind_REVEAL);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedPublicKey);
-        return forged;
+    forgeOperation(operation, forgedSource, forged);
+    return forged;
+}
+
+void forgeOperation(const Operation& operation, const Data& forgedSource, Data& forged) {
+    const auto kind = operation.kind();
+    if (kind != Operation_OperationKind_REVEAL && kind != Operation_OperationKind_DELEGATION &&
+        kind != Operation_OperationKind_TRANSACTION) {
+        throw std::invalid_argument("Invalid operation kind");
     }
 
-    if (operation.kind() == Operation_OperationKind_DELEGATION) {
-        auto delegate = operation.delegation_operation_data().delegate();
+    forged.push_back(static_cast<byte>(kind));
+    append(forged, forgedSource);
+    forgeZarith(operation.fee(), forged);
+    forgeZarith(operation.counter(), forged);
+    forgeZarith(operation.gas_limit(), forged);
+    forgeZarith(operation.storage_limit(), forged);
 
-        forged.push_back(Operation_OperationKind_DELEGATION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        if (!delegate.empty()) {
-            auto forgedPublicKeyHash = forgePublicKeyHash(delegate);
+    if (kind == Operation_OperationKind_REVEAL) {
+        auto publicKey = PublicKey(data(operation.reveal_operation_data().public_key()), TWPublicKeyTypeED25519);
+        forgePublicKey(publicKey, forged);
+        return;
+    }
 
-            append(forged, forgeBool(true));
-            append(forged, forgedPublicKeyHash);
+    if (kind == Operation_OperationKind_DELEGATION) {
+        const auto& delegate = operation.delegation_operation_data().delegate();
+        if (!delegate.empty()) {
+            forged.push_back(0xff);
+            forgePublicKeyHash(delegate, forged);
         } else {
-            append(forged, forgeBool(false));
+            forged.push_back(0x00);
         }
-        return forged;
-    }
-
-    if (operation.kind() == Operation_OperationKind_TRANSACTION) {
-        auto forgedAmount = forgeZarith(operation.transaction_operation_data().amount());
-        auto forgedDestination = Address(operation.transaction_operation_data().destination()).forge();
-
-        forged.push_back(Operation_OperationKind_TRANSACTION);
-        append(forged, forgedSource);
-        append(forged, forgedFee);
-        append(forged, forgedCounter);
-        append(forged, forgedGasLimit);
-        append(forged, forgedStorageLimit);
-        append(forged, forgedAmount);
-        append(forged, forgeBool(false));
-        append(forged, forgedDestination);
-        append(forged, forgeBool(false));
-        return forged;
+        return;
     }
 
-    throw std::invalid_argument("Invalid operation kind");
+    // transaction
+    forgeZarith(operation.transaction_operation_data().amount(), forged);
+    forged.push_back(0x00);
+    Address(operation.transaction_operation_data().destination()).forge(forged);
+    forged.push_back(0x00);
 }
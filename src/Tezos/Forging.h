@@ -4,9 +4,14 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#pragma once
+
+#include "Address.h"
+#include "../PrivateKey.h"
 #include "../PublicKey.h"
 #include "../proto/Tezos.pb.h"
 
+#include <array>
 #include <string>
 
 using namespace TW;
@@ -17,3 +22,39 @@ Data forgeOperation(const Operation& operation);
 Data forgePublicKeyHash(const std::string& publicKeyHash);
 Data forgePublicKey(PublicKey publicKey);
 Data forgeZarith(uint64_t input);
+
+/// Typical size of a forged operation, to reserve buffers.
+static const size_t forgedOperationSizeHint = 128;
+
+// In-place variants, appending to `forged`.
+void forgeOperation(const Operation& operation, const Data& forgedSource, Data& forged);
+void forgePublicKeyHash(const std::string& publicKeyHash, Data& forged);
+void forgePublicKeyHash(const std::array<byte, TW::Tezos::Address::size>& decoded, Data& forged);
+void forgePublicKey(const PublicKey& publicKey, Data& forged);
+void forgeZarith(uint64_t input, Data& forged);
+
+/// Appends the forged operations to `forged`, injecting the public key of `privateKey`
+/// in reveal operations without one. The forged source is reused across consecutive
+/// operations with the same source.
+template <typename Operations>
+void forgeOperations(const Operations& operations, const PrivateKey& privateKey, Data& forged) {
+    const std::string* source = nullptr;
+    Data forgedSource;
+    for (const Operation& operation : operations) {
+        if (source == nullptr || *source != operation.source()) {
+            source = &operation.source();
+            forgedSource.clear();
+            TW::Tezos::Address(*source).forge(forgedSource);
+        }
+        // If it's REVEAL operation, inject the public key if not specified
+        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data() &&
+            operation.reveal_operation_data().public_key().empty()) {
+            auto withPublicKey = operation;
+            const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+            withPublicKey.mutable_reveal_operation_data()->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
+            forgeOperation(withPublicKey, forgedSource, forged);
+        } else {
+            forgeOperation(operation, forgedSource, forged);
+        }
+    }
+}
@@ -17,39 +17,34 @@ using namespace TW::Tezos::Proto;
 
 Tezos::OperationList::OperationList(const std::string& str) {
     branch = str;
+    branchHash = decodeBranch(str);
 }
 
 void Tezos::OperationList::addOperation(const Operation& operation) {
     operation_list.push_back(operation);
 }
 
-// Forge the given branch to a hex encoded string.
-Data Tezos::OperationList::forgeBranch() const {
+Data Tezos::OperationList::decodeBranch(const std::string& branch) {
     std::array<byte, 2> prefix = {1, 52};
-    const auto decoded = Base58::bitcoin.decodeCheck(branch);
-    if (decoded.size() != 34 || !std::equal(prefix.begin(), prefix.end(), decoded.begin())) {
-        throw std::invalid_argument("Invalid branch for forge");
+    std::array<byte, 34> decoded;
+    if (!Base58::bitcoin.decodeCheck(branch, decoded) || !std::equal(prefix.begin(), prefix.end(), decoded.begin())) {
+        return Data();
     }
-    auto forged = Data();
-    forged.insert(forged.end(), decoded.begin() + prefix.size(), decoded.end());
-    return forged;
+    return Data(decoded.begin() + prefix.size(), decoded.end());
 }
 
-Data Tezos::OperationList::forge(const PrivateKey& privateKey) const {
-    auto forged = forgeBranch();
-
-    for (auto operation : operation_list) {
-        // If it's REVEAL operation, inject the public key if not specified
-        if (operation.kind() == Operation::REVEAL && operation.has_reveal_operation_data()) {
-            auto revealOperationData = operation.mutable_reveal_operation_data();
-            if (revealOperationData->public_key().empty()) {
-                auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
-                revealOperationData->set_public_key(publicKey.bytes.data(), publicKey.bytes.size());
-            }
-        }
-
-        append(forged, forgeOperation(operation));
+// Forge the given branch to a hex encoded string.
+Data Tezos::OperationList::forgeBranch() const {
+    if (branchHash.empty()) {
+        throw std::invalid_argument("Invalid branch for forge");
     }
+    return branchHash;
+}
 
+Data Tezos::OperationList::forge(const PrivateKey& privateKey, size_t reservedSuffix) const {
+    auto forged = Data();
+    forged.reserve(branchHash.size() + operation_list.size() * forgedOperationSizeHint + reservedSuffix);
+    append(forged, forgeBranch());
+    forgeOperations(operation_list, privateKey, forged);
     return forged;
 }
@@ -17,8 +17,15 @@ class OperationList {
     OperationList(const std::string& string);
     void addOperation(const Operation& transaction);
     /// Returns a data representation of the operations.
-    Data forge(const PrivateKey& privateKey) const;
+    Data forge(const PrivateKey& privateKey, size_t reservedSuffix = 0) const;
     Data forgeBranch() const;
+
+    /// Decodes a branch block hash, returns an empty Data if invalid.
+    static Data decodeBranch(const std::string& branch);
+
+  private:
+    /// Branch block hash, decoded once.
+    Data branchHash;
 };
 
 } // namespace TW::Tezos
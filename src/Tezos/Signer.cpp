@@ -4,29 +4,27 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Forging.h"
 #include "OperationList.h"
 #include "Signer.h"
-#include "../Hash.h"
+#include "../Hashers.h"
 #include "../HexCoding.h"
+#include "../ThreadPool.h"
 
 #include <TrustWalletCore/TWCurve.h>
 #include <google/protobuf/util/json_util.h>
 
+#include <algorithm>
+#include <atomic>
 #include <string>
 
 using namespace TW;
 using namespace TW::Tezos;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto operationList = Tezos::OperationList(input.operation_list().branch());
-    for (Proto::Operation operation : input.operation_list().operations()) {
-      operationList.addOperation(operation);
-    }
-
-    auto signer = Signer();
-    PrivateKey key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    Data encoded = signer.signOperationList(key, operationList);
+static const size_t signatureSize = 64;
 
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    const auto encoded = sign(input, OperationList::decodeBranch(input.operation_list().branch()));
     auto output = Proto::SigningOutput();
     output.set_encoded(encoded.data(), encoded.size());
     return output;
@@ -40,21 +38,70 @@ std::string Signer::signJSON(const std::string& json, const Data& key) {
     return hex(output.encoded());
 }
 
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    // branch hash index of each input
+    std::vector<Data> branchHashes;
+    std::vector<size_t> branchIndices(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto& branch = inputs[i].operation_list().branch();
+        if (i == 0 || branch != inputs[i - 1].operation_list().branch()) {
+            branchHashes.push_back(OperationList::decodeBranch(branch));
+        }
+        branchIndices[i] = branchHashes.size() - 1;
+    }
+
+    std::vector<Proto::SigningOutput> outputs(inputs.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto index = next++; index < inputs.size(); index = next++) {
+            try {
+                const auto encoded = sign(inputs[index], branchHashes[branchIndices[index]]);
+                outputs[index].set_encoded(encoded.data(), encoded.size());
+            } catch (const std::exception& e) {
+                // leave the output empty
+            }
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, inputs.size(), worker);
+    return outputs;
+}
+
 Data Signer::signOperationList(const PrivateKey& privateKey, const OperationList& operationList) {
-    auto forged = operationList.forge(privateKey);
-    return signData(privateKey, forged);
+    auto forged = operationList.forge(privateKey, signatureSize);
+    appendSignature(privateKey, forged);
+    return forged;
 }
 
 Data Signer::signData(const PrivateKey& privateKey, const Data& data) {
-    Data watermarkedData = Data();
-    watermarkedData.push_back(0x03);
-    append(watermarkedData, data);
-
-    Data hash = Hash::blake2b(watermarkedData, 32);
-    Data signature = privateKey.sign(hash, TWCurve::TWCurveED25519);
-
     Data signedData = Data();
+    signedData.reserve(data.size() + signatureSize);
     append(signedData, data);
-    append(signedData, signature);
+    appendSignature(privateKey, signedData);
     return signedData;
 }
+
+Data Signer::sign(const Proto::SigningInput& input, const Data& branchHash) {
+    if (branchHash.empty()) {
+        throw std::invalid_argument("Invalid branch for forge");
+    }
+    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    const auto& operations = input.operation_list().operations();
+    auto forged = Data();
+    forged.reserve(branchHash.size() + operations.size() * forgedOperationSizeHint + signatureSize);
+    append(forged, branchHash);
+    forgeOperations(operations, key, forged);
+    appendSignature(key, forged);
+    return forged;
+}
+
+void Signer::appendSignature(const PrivateKey& privateKey, Data& forged) {
+    // generic operation watermark
+    const byte watermark = 0x03;
+    const auto hash = Hash::Blake2bHasher(32)
+        .update(DataView(&watermark, 1))
+        .update(forged)
+        .final();
+    const auto signature = privateKey.sign(hash, TWCurve::TWCurveED25519);
+    append(forged, signature);
+}
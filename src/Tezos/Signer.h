@@ -12,6 +12,7 @@
 #include "../proto/Tezos.pb.h"
 
 #include <string>
+#include <vector>
 
 namespace TW::Tezos {
 
@@ -22,10 +23,23 @@ class Signer {
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
     /// Signs a json Proto::SigningInput with private key
     static std::string signJSON(const std::string& json, const Data& key);
+
+    /// Signs many inputs, typically payouts against the same branch, using up to `threadCount`
+    /// threads (0 for the hardware concurrency). The branch is decoded once for consecutive
+    /// inputs with the same branch. Inputs that fail to forge get an empty encoded output.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
   public:
     /// Signs the given transaction.
     Data signOperationList(const PrivateKey& privateKey, const OperationList& operationList);
     Data signData(const PrivateKey& privateKey, const Data& data);
+
+  private:
+    /// Forges the input operations after the decoded branch hash, and appends the signature.
+    static Data sign(const Proto::SigningInput& input, const Data& branchHash);
+
+    /// Appends the signature of the watermarked `forged` operations to them.
+    static void appendSignature(const PrivateKey& privateKey, Data& forged);
 };
 
 } // namespace TW::Tezos
@@ -25,6 +25,23 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Ethereum::Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
+
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
+std::unique_ptr<TW::SigningTemplate> Entry::signingTemplate(TWCoinType coin, const TW::Data& dataIn) const {
+    auto input = Proto::SigningInput();
+    if (!input.ParseFromArray(dataIn.data(), static_cast<int>(dataIn.size()))) {
+        return nullptr;
+    }
+    // the amount is in TFUEL, the THETA amount of the input is kept
+    return std::make_unique<InputSigningTemplate<Signer, Proto::SigningInput>>(std::move(input), [](Proto::SigningInput& input, const SigningPatch& patch) {
+        input.set_sequence(patch.nonce);
+        input.set_to_address(patch.toAddress);
+        input.set_tfuel_amount(patch.amount.data(), patch.amount.size());
+    });
+}
@@ -6,28 +6,51 @@
 
 #include "Signer.h"
 
-#include "../Ethereum/RLP.h"
+#include "../Ethereum/RLPWriter.h"
 #include "../Hash.h"
+#include "../Hashers.h"
+#include "../BatchSigning.h"
+
+#include <optional>
 
 using namespace TW;
 using namespace TW::Theta;
-using RLP = Ethereum::RLP;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto pkFrom = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    auto from = Ethereum::Address(pkFrom.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+namespace {
 
-    auto transaction = Transaction(
+/// Empty nonce, gas price, gas limit, recipient and amount prefixing the sign bytes, to be
+/// compatible with the Ethereum transaction format; the same for every transaction.
+const Data& ethereumPrefix() {
+    static const auto prefix = Ethereum::rlpEncode([](auto& rlp) {
+        const auto to = Ethereum::Address("0x0000000000000000000000000000000000000000");
+        rlp.item(uint64_t(0)).item(uint256_t(0)).item(uint64_t(0)).item(to.bytes).item(uint256_t(0));
+    });
+    return prefix;
+}
+
+/// Describes the sign bytes of a transaction
+auto signBytes(const std::string& chainID, const Transaction& transaction) {
+    return [&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.encoded(ethereumPrefix()).encodedString([&](auto& payload) {
+                payload.item(chainID);
+                transaction.write(payload);
+            });
+        });
+    };
+}
+
+Transaction transactionFrom(const Proto::SigningInput& input, const Ethereum::Address& from) {
+    return Transaction(
         /* from: */ from,
         /* to: */ Ethereum::Address(input.to_address()),
         /* thetaAmount: */ load(input.theta_amount()),
         /* tfuelAmount: */ load(input.tfuel_amount()),
         /* sequence: */ input.sequence(),
         /* feeAmount: */ load(input.fee()));
+}
 
-    auto signer = Signer(input.chain_id());
-    auto signature = signer.sign(pkFrom, transaction);
-
+Proto::SigningOutput signingOutput(Transaction& transaction, const Ethereum::Address& from, const Data& signature) {
     auto output = Proto::SigningOutput();
 
     transaction.setSignature(from, signature);
@@ -37,32 +60,56 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     return output;
 }
 
-Data Signer::encode(const Transaction& transaction) noexcept {
-    const uint64_t nonce = 0;
-    const uint256_t gasPrice = 0;
-    const uint64_t gasLimit = 0;
-    const Ethereum::Address to = Ethereum::Address("0x0000000000000000000000000000000000000000");
-    const uint256_t amount = 0;
-
-    auto encoded = Data();
-    /// Need to add the following prefix to the tx signbytes to be compatible with
-    /// the Ethereum tx format
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encode(gasPrice));
-    append(encoded, RLP::encode(gasLimit));
-    append(encoded, RLP::encode(to.bytes));
-    append(encoded, RLP::encode(amount));
-    /// Chain ID
-    auto payload = Data();
-    append(payload, RLP::encode(chainID));
-    append(payload, transaction.encode());
-    append(encoded, RLP::encode(payload));
-    return RLP::encodeList(encoded);
+} // namespace
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto pkFrom = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto from = Ethereum::Address(pkFrom.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+
+    auto transaction = transactionFrom(input, from);
+
+    auto signer = Signer(input.chain_id());
+    auto signature = signer.sign(pkFrom, transaction);
+
+    return signingOutput(transaction, from, signature);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto& keyBytes = inputs[begin].private_key();
+        const auto key = PrivateKey(Data(keyBytes.begin(), keyBytes.end()));
+        const auto from = Ethereum::Address(key.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+        std::vector<std::optional<Transaction>> transactions;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            try {
+                transactions.emplace_back(transactionFrom(inputs[i], from));
+                digests.push_back(hash(inputs[i].chain_id(), *transactions.back()));
+            } catch (const std::exception&) {
+                // invalid recipient
+                transactions.emplace_back();
+                digests.push_back(Data(32));
+                outputs[i].set_error(Common::Proto::Error_general);
+            }
+        }
+        std::vector<Data> signatures;
+        key.signBatch(digests, TWCurveSECP256k1, signatures);
+        for (auto i = begin; i < end; ++i) {
+            if (transactions[i - begin]) {
+                outputs[i] = signingOutput(*transactions[i - begin], from, signatures[i - begin]);
+            }
+        }
+    });
+}
+
+Data Signer::hash(const std::string& chainID, const Transaction& transaction) {
+    auto hasher = Hash::Keccak256Hasher();
+    Ethereum::rlpWrite(hasher, signBytes(chainID, transaction));
+    const auto digest = hasher.final();
+    return Data(digest.begin(), digest.end());
 }
 
 Data Signer::sign(const PrivateKey& privateKey, const Transaction& transaction) noexcept {
-    auto encoded = encode(transaction);
-    auto hash = Hash::keccak256(encoded);
-    auto signature = privateKey.sign(hash, TWCurveSECP256k1);
+    auto signature = privateKey.sign(hash(chainID, transaction), TWCurveSECP256k1);
     return signature;
 }
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "Transaction.h"
 #include "../Data.h"
@@ -21,6 +22,11 @@ class Signer {
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys). The sender address
+    /// and the key state are computed once per run of inputs with the same private key. An invalid recipient
+    /// gives Error_general.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
   public:
     std::string chainID;
 
@@ -33,7 +39,8 @@ class Signer {
     Data sign(const PrivateKey& privateKey, const Transaction& transaction) noexcept;
 
   private:
-    Data encode(const Transaction& transaction) noexcept;
+    /// Keccak256 of the sign bytes, streamed into the hasher
+    static Data hash(const std::string& chainID, const Transaction& transaction);
 };
 
 } // namespace TW::Theta
@@ -6,50 +6,20 @@
 
 #include "Transaction.h"
 
-#include "../Ethereum/RLP.h"
+#include "../Ethereum/RLPWriter.h"
+#include "../Hashers.h"
 
 using namespace TW;
 using namespace TW::Theta;
-using RLP = Ethereum::RLP;
 
-Data encode(const Coins& coins) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(coins.thetaWei));
-    append(encoded, RLP::encode(coins.tfuelWei));
-    return RLP::encodeList(encoded);
-}
-
-Data encode(const TxInput& input) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(input.address.bytes));
-    append(encoded, encode(input.coins));
-    append(encoded, RLP::encode(input.sequence));
-    append(encoded, RLP::encode(input.signature));
-    return RLP::encodeList(encoded);
-}
+namespace {
 
-Data encode(const std::vector<TxInput>& inputs) noexcept {
-    auto encoded = Data();
-    for (const auto& input : inputs) {
-        append(encoded, encode(input));
-    }
-    return RLP::encodeList(encoded);
+template <typename RLP>
+void writeCoins(RLP& rlp, const Coins& coins) {
+    rlp.list([&](auto& list) { list.item(coins.thetaWei).item(coins.tfuelWei); });
 }
 
-Data encode(const TxOutput& output) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(output.address.bytes));
-    append(encoded, encode(output.coins));
-    return RLP::encodeList(encoded);
-}
-
-Data encode(const std::vector<TxOutput>& outputs) noexcept {
-    auto encoded = Data();
-    for (const auto& output : outputs) {
-        append(encoded, encode(output));
-    }
-    return RLP::encodeList(encoded);
-}
+} // namespace
 
 Transaction::Transaction(Ethereum::Address from, Ethereum::Address to,
                          uint256_t thetaAmount, uint256_t tfuelAmount,
@@ -65,16 +35,37 @@ Transaction::Transaction(Ethereum::Address from, Ethereum::Address to,
     this->outputs.push_back(output);
 }
 
+template <typename RLP>
+void Transaction::write(RLP& rlp) const {
+    const uint16_t txType = 2; // TxSend
+    rlp.item(txType).list([&](auto& list) {
+        writeCoins(list, fee);
+        list.list([&](auto& inputList) {
+            for (const auto& input : inputs) {
+                inputList.list([&](auto& item) {
+                    item.item(input.address.bytes);
+                    writeCoins(item, input.coins);
+                    item.item(input.sequence).item(input.signature);
+                });
+            }
+        });
+        list.list([&](auto& outputList) {
+            for (const auto& output : outputs) {
+                outputList.list([&](auto& item) {
+                    item.item(output.address.bytes);
+                    writeCoins(item, output.coins);
+                });
+            }
+        });
+    });
+}
+
+template void Transaction::write(Ethereum::RLPSizer& rlp) const;
+template void Transaction::write(Ethereum::RLPWriter<Ethereum::RLPDataSink>& rlp) const;
+template void Transaction::write(Ethereum::RLPWriter<Hash::Keccak256Hasher>& rlp) const;
+
 Data Transaction::encode() const noexcept {
-    auto encoded = Data();
-    uint16_t txType = 2; // TxSend
-    append(encoded, RLP::encode(txType));
-    auto encodedData = Data();
-    append(encodedData, ::encode(fee));
-    append(encodedData, ::encode(inputs));
-    append(encodedData, ::encode(outputs));
-    append(encoded, RLP::encodeList(encodedData));
-    return encoded;
+    return Ethereum::rlpEncode([&](auto& rlp) { write(rlp); });
 }
 
 bool Transaction::setSignature(const Ethereum::Address& address, const Data& signature) noexcept {
@@ -54,6 +54,10 @@ class Transaction {
     /// Encodes the transaction
     Data encode() const noexcept;
 
+    /// Writes the encoding to an Ethereum::RLPSizer or RLPWriter, to embed it without an intermediate buffer.
+    template <typename RLP>
+    void write(RLP& rlp) const;
+
     /// Sets signature
     bool setSignature(const Ethereum::Address& address, const Data& signature) noexcept;
 };
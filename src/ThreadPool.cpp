@@ -0,0 +1,367 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+using namespace TW;
+
+namespace {
+
+std::size_t hardwareThreads() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/// Parses a Linux CPU list, such as "0-23,48-71".
+std::vector<unsigned> parseCpuList(const std::string& list) {
+    std::vector<unsigned> cpus;
+    std::stringstream stream(list);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+        try {
+            const auto dash = range.find('-');
+            const auto first = std::stoul(range.substr(0, dash));
+            const auto last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+            for (auto cpu = first; cpu <= last; ++cpu) {
+                cpus.push_back(static_cast<unsigned>(cpu));
+            }
+        } catch (const std::exception&) {
+            return {};
+        }
+    }
+    return cpus;
+}
+
+/// Shared state of a `run` call.
+struct Job {
+    std::mutex mutex;
+    std::condition_variable done;
+    std::size_t running = 0;
+    /// Set when the run on the calling thread returned, later runs are skipped.
+    bool closed = false;
+    std::exception_ptr error;
+};
+
+} // namespace
+
+struct ThreadPool::Workers {
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<Queue> queues;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    /// Notified when a task is queued, or on stop.
+    std::condition_variable available;
+    /// Tasks queued and not taken yet.
+    std::size_t queued = 0;
+    bool stopping = false;
+    std::atomic<std::size_t> nextQueue{0};
+
+    /// Workers and queue of the current thread, if a pool thread.
+    static inline thread_local const Workers* currentWorkers = nullptr;
+    static inline thread_local std::size_t currentIndex = 0;
+
+    explicit Workers(std::size_t threadCount) : queues(threadCount) {}
+
+    /// Starts the threads, which keep the workers alive.
+    static void start(const std::shared_ptr<Workers>& self, const std::vector<unsigned>& cpus) {
+        const auto threadCount = self->queues.size();
+        self->threads.reserve(threadCount);
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            const auto cpu = cpus.empty() ? -1 : static_cast<long>(cpus[i % cpus.size()]);
+            self->threads.emplace_back([self, i, cpu] { self->work(i, cpu); });
+        }
+    }
+
+    /// Queues a task; returns false, leaving the task, if the workers are stopping.
+    bool push(std::function<void()>& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) {
+                return false;
+            }
+            ++queued;
+        }
+        // a pool thread keeps its tasks, the others are stolen from its queue
+        const auto index = currentWorkers == this ? currentIndex : nextQueue++ % queues.size();
+        {
+            std::lock_guard<std::mutex> lock(queues[index].mutex);
+            queues[index].tasks.push_back(std::move(task));
+        }
+        available.notify_one();
+        return true;
+    }
+
+    /// Takes the newest task of queue `index`, or steals the oldest of another queue.
+    bool pop(std::size_t index, std::function<void()>& task) {
+        for (std::size_t i = 0; i < queues.size(); ++i) {
+            auto& queue = queues[(index + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
+
+    void work(std::size_t index, long cpu) {
+#if defined(__linux__)
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(static_cast<int>(cpu), &set);
+            pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        }
+#else
+        (void)cpu;
+#endif
+        currentWorkers = this;
+        currentIndex = index;
+        for (;;) {
+            std::function<void()> task;
+            if (pop(index, task)) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    --queued;
+                }
+                try {
+                    task();
+                } catch (...) {
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(mutex);
+            if (queued != 0) {
+                // a task is being queued
+                lock.unlock();
+                std::this_thread::yield();
+                continue;
+            }
+            if (stopping) {
+                break;
+            }
+            available.wait(lock, [this] { return queued != 0 || stopping; });
+        }
+        currentWorkers = nullptr;
+    }
+
+    /// Lets the threads finish the queued tasks, and joins them.
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        available.notify_all();
+        for (auto& thread : threads) {
+            if (thread.get_id() == std::this_thread::get_id()) {
+                // reconfigured from one of its own tasks
+                thread.detach();
+            } else {
+                thread.join();
+            }
+        }
+    }
+};
+
+ThreadPool::ThreadPool(std::size_t threadCount) : threadCount(threadCount) {}
+
+ThreadPool::~ThreadPool() {
+    std::unique_lock<std::mutex> lock(mutex);
+    restart(lock);
+}
+
+ThreadPool& ThreadPool::shared() {
+    // never destroyed, tasks may still be running during static destruction
+    static auto* pool = new ThreadPool();
+    return *pool;
+}
+
+std::size_t ThreadPool::sizeLocked() const {
+    if (executor) {
+        return executorConcurrency;
+    }
+    if (threadCount != 0) {
+        return threadCount;
+    }
+    return cpus.empty() ? hardwareThreads() : cpus.size();
+}
+
+std::size_t ThreadPool::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return sizeLocked();
+}
+
+std::size_t ThreadPool::workerCount(std::size_t threadCount, std::size_t itemCount) const {
+    const auto poolSize = size();
+    const auto requested = threadCount == 0 ? poolSize : std::min(threadCount, poolSize);
+    return std::max<std::size_t>(std::min(requested, itemCount), 1);
+}
+
+std::shared_ptr<ThreadPool::Workers> ThreadPool::current(Executor* executor) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (this->executor) {
+        *executor = this->executor;
+        return nullptr;
+    }
+    if (workers == nullptr) {
+        workers = std::make_shared<Workers>(sizeLocked());
+        Workers::start(workers, cpus);
+    }
+    return workers;
+}
+
+void ThreadPool::restart(std::unique_lock<std::mutex>& lock) {
+    auto retired = std::move(workers);
+    workers = nullptr;
+    // the retired threads may queue tasks, which go to the new workers
+    lock.unlock();
+    if (retired != nullptr) {
+        retired->stop();
+    }
+    lock.lock();
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    for (;;) {
+        Executor executor;
+        const auto workers = current(&executor);
+        if (workers == nullptr) {
+            executor([task = std::move(task)] {
+                try {
+                    task();
+                } catch (...) {
+                }
+            });
+            return;
+        }
+        if (workers->push(task)) {
+            return;
+        }
+        // retired meanwhile, hand the task to the new workers
+    }
+}
+
+void ThreadPool::run(std::size_t threadCount, std::size_t itemCount, const std::function<void()>& worker) {
+    const auto count = workerCount(threadCount, itemCount);
+    if (count == 1) {
+        worker();
+        return;
+    }
+
+    auto job = std::make_shared<Job>();
+    for (std::size_t i = 1; i < count; ++i) {
+        submit([job, &worker] {
+            {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                if (job->closed) {
+                    // `worker` may be gone
+                    return;
+                }
+                ++job->running;
+            }
+            try {
+                worker();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                if (!job->error) {
+                    job->error = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> lock(job->mutex);
+            if (--job->running == 0) {
+                job->done.notify_all();
+            }
+        });
+    }
+
+    std::exception_ptr error;
+    try {
+        worker();
+    } catch (...) {
+        error = std::current_exception();
+    }
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->closed = true;
+    // only the runs which started are waited for, the calling thread never waits for a queued task
+    job->done.wait(lock, [&job] { return job->running == 0; });
+    if (!error) {
+        error = job->error;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::parallelFor(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t index)>& body) {
+    std::atomic<std::size_t> next(0);
+    run(threadCount, count, [&] {
+        for (auto index = next++; index < count; index = next++) {
+            body(index);
+        }
+    });
+}
+
+void ThreadPool::setThreadCount(std::size_t threadCount) {
+    std::unique_lock<std::mutex> lock(mutex);
+    this->threadCount = threadCount;
+    restart(lock);
+}
+
+bool ThreadPool::setAffinity(std::vector<unsigned> cpus) {
+#if defined(__linux__)
+    std::unique_lock<std::mutex> lock(mutex);
+    this->cpus = std::move(cpus);
+    restart(lock);
+    return true;
+#else
+    return cpus.empty();
+#endif
+}
+
+bool ThreadPool::setNumaNode(unsigned node) {
+    auto cpus = numaNodeCpus(node);
+    if (cpus.empty()) {
+        return false;
+    }
+    return setAffinity(std::move(cpus));
+}
+
+void ThreadPool::setExecutor(Executor executor, std::size_t concurrency) {
+    std::unique_lock<std::mutex> lock(mutex);
+    this->executor = std::move(executor);
+    executorConcurrency = concurrency != 0 ? concurrency : hardwareThreads();
+    restart(lock);
+}
+
+std::vector<unsigned> ThreadPool::numaNodeCpus(unsigned node) {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    std::string list;
+    if (!std::getline(file, list)) {
+        return {};
+    }
+    return parseCpuList(list);
+}
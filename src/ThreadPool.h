@@ -0,0 +1,101 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+/// Work-stealing thread pool shared by the parallel paths of the library (batch signing, multi-coin derivation,
+/// scrypt lanes, keystore loading...), so that they don't start threads of their own, nor oversubscribe the
+/// machine when they are nested or used from several threads at once.
+///
+/// Each pool thread has its own task queue: tasks queued from a pool thread go to its queue, the others are
+/// spread over the queues, and idle threads steal from the other queues.  Threads can be pinned to CPUs, one CPU
+/// each, for instance the CPUs of a NUMA node; or the tasks can be handed to an external executor instead.
+/// Threads are started with the first task, and restarted by a configuration change.  Thread-safe.
+class ThreadPool {
+  public:
+    /// Runs a task on a thread of the caller, exactly once.
+    using Executor = std::function<void(std::function<void()> task)>;
+
+    /// Pool of `threadCount` threads, 0 for one per hardware thread (or per CPU of the affinity).
+    explicit ThreadPool(std::size_t threadCount = 0);
+
+    /// Runs the tasks still queued, and joins the threads.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Pool of the library, living until the process exits.
+    static ThreadPool& shared();
+
+    /// Number of threads, or concurrency of the executor.
+    std::size_t size() const;
+
+    /// Number of concurrent runs of a worker for a request of `threadCount` threads (0: the size of the pool),
+    /// at most the size of the pool and `itemCount`, at least 1.
+    std::size_t workerCount(std::size_t threadCount, std::size_t itemCount) const;
+
+    /// Runs `worker` on the calling thread and on pool threads, `workerCount(threadCount, itemCount)` runs in all,
+    /// and returns once all of them returned.  `worker` must take its items from a shared counter until there is
+    /// none left: pool runs which have not started when the run on the calling thread returns are skipped.
+    /// The first exception thrown by a run is rethrown.
+    void run(std::size_t threadCount, std::size_t itemCount, const std::function<void()>& worker);
+
+    /// Calls `body` once for each index in [0, count), on up to `threadCount` threads as `run` does.
+    void parallelFor(std::size_t count, std::size_t threadCount, const std::function<void(std::size_t index)>& body);
+
+    /// Queues a task, exceptions thrown by tasks are discarded.
+    void submit(std::function<void()> task);
+
+    /// Changes the number of threads, 0 for one per hardware thread (or per CPU of the affinity).
+    void setThreadCount(std::size_t threadCount);
+
+    /// Pins thread i to CPU `cpus[i % cpus.size()]`, an empty list removes the pinning.  Returns false if CPU
+    /// affinity is not supported on the platform.
+    bool setAffinity(std::vector<unsigned> cpus);
+
+    /// Pins the threads to the CPUs of a NUMA node, one thread per CPU by default.  Returns false if the node is
+    /// not known, or NUMA topology not available on the platform (Linux only).
+    bool setNumaNode(unsigned node);
+
+    /// Hands the tasks to `executor` instead of pool threads, with `concurrency` tasks run at once (0: one per
+    /// hardware thread); a null executor restores the pool threads.
+    void setExecutor(Executor executor, std::size_t concurrency);
+
+    /// CPUs of a NUMA node, empty if not known.
+    static std::vector<unsigned> numaNodeCpus(unsigned node);
+
+  private:
+    /// Threads and queues of a configuration, retired as a whole when the configuration changes.
+    struct Workers;
+
+    mutable std::mutex mutex;
+    std::size_t threadCount;
+    std::vector<unsigned> cpus;
+    Executor executor;
+    std::size_t executorConcurrency = 0;
+    std::shared_ptr<Workers> workers;
+
+    std::size_t sizeLocked() const;
+    /// Workers of the current configuration, started if needed; null with an executor.
+    std::shared_ptr<Workers> current(Executor* executor);
+    /// Replaces the workers after a configuration change; the old ones finish their tasks.
+    void restart(std::unique_lock<std::mutex>& lock);
+};
+
+} // namespace TW
@@ -15,8 +15,8 @@
 using namespace TW::Tron;
 
 bool Address::isValid(const std::string& string) {
-    const auto decoded = Base58::bitcoin.decodeCheck(string);
-    if (decoded.size() != Address::size) {
+    std::array<byte, size> decoded;
+    if (!Base58::bitcoin.decodeCheck(string, decoded)) {
         return false;
     }
 
@@ -9,6 +9,9 @@
 #include "Address.h"
 #include "Signer.h"
 
+#include <limits>
+#include <stdexcept>
+
 using namespace TW::Tron;
 using namespace std;
 
@@ -22,6 +25,39 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
+
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
+std::unique_ptr<TW::SigningTemplate> Entry::signingTemplate(TWCoinType coin, const TW::Data& dataIn) const {
+    auto input = Proto::SigningInput();
+    if (!input.ParseFromArray(dataIn.data(), static_cast<int>(dataIn.size()))) {
+        return nullptr;
+    }
+    if (input.transaction().has_transfer_trc20_contract()) {
+        return std::make_unique<TRC20TransferTemplate>(input);
+    }
+    if (!input.transaction().has_transfer()) {
+        return nullptr;
+    }
+    // Tron has no account nonce, the nonce of the patch is ignored
+    return std::make_unique<InputSigningTemplate<Signer, Proto::SigningInput>>(std::move(input), [](Proto::SigningInput& input, const SigningPatch& patch) {
+        if (patch.amount.size() > sizeof(int64_t)) {
+            throw std::invalid_argument("Amount over 64 bits");
+        }
+        uint64_t amount = 0;
+        for (const auto value : patch.amount) {
+            amount = amount << 8 | value;
+        }
+        if (amount > static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+            throw std::invalid_argument("Amount over 64 bits");
+        }
+        auto& transfer = *input.mutable_transaction()->mutable_transfer();
+        transfer.set_to_address(patch.toAddress);
+        transfer.set_amount(static_cast<int64_t>(amount));
+    });
+}
@@ -13,9 +13,15 @@
 #include "../Hash.h"
 #include "../HexCoding.h"
 #include "Serialization.h"
+#include "../ThreadPool.h"
 
+#include <google/protobuf/io/coded_stream.h>
+
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cassert>
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::Tron;
@@ -23,7 +29,7 @@ using namespace std::chrono;
 
 const std::string TRANSFER_TOKEN_FUNCTION = "0xa9059cbb";
 
-size_t base58Capacity = 128;
+const size_t base58Capacity = 128;
 
 /// Converts an external TransferContract to an internal one used for signing.
 protocol::TransferContract to_internal(const Proto::TransferContract& transfer) {
@@ -206,6 +212,25 @@ void setBlockReference(const Proto::Transaction& transaction, protocol::Transact
     internal.mutable_raw_data()->set_ref_block_bytes(heightData.data() + heightData.size() - 2, 2);
 }
 
+/// Sets the timing, fee limit and block reference of a transaction.
+void setRawData(const Proto::Transaction& transaction, protocol::Transaction& internal) {
+    // Get default timestamp and expiration
+    const uint64_t now = duration_cast< milliseconds >(
+            system_clock::now().time_since_epoch()
+    ).count();
+    const uint64_t timestamp = transaction.timestamp() == 0
+            ? now
+            : transaction.timestamp();
+    const uint64_t expiration = transaction.expiration() == 0
+            ? timestamp + 10 * 60 * 60 * 1000 // 10 hours
+            : transaction.expiration();
+
+    internal.mutable_raw_data()->set_timestamp(timestamp);
+    internal.mutable_raw_data()->set_expiration(expiration);
+    internal.mutable_raw_data()->set_fee_limit(transaction.fee_limit());
+    setBlockReference(transaction, internal);
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto internal = protocol::Transaction();
     auto output = Proto::SigningOutput();
@@ -292,27 +317,13 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
         *contract->mutable_parameter() = any;
     }
 
-    // Get default timestamp and expiration
-    const uint64_t now = duration_cast< milliseconds >(
-            system_clock::now().time_since_epoch()
-    ).count();
-    const uint64_t timestamp = input.transaction().timestamp() == 0
-            ? now
-            : input.transaction().timestamp();
-    const uint64_t expiration = input.transaction().expiration() == 0
-            ? timestamp + 10 * 60 * 60 * 1000 // 10 hours
-            : input.transaction().expiration();
-
-    internal.mutable_raw_data()->set_timestamp(timestamp);
-    internal.mutable_raw_data()->set_expiration(expiration);
-    internal.mutable_raw_data()->set_fee_limit(input.transaction().fee_limit());
-    setBlockReference(input.transaction(), internal);
+    setRawData(input.transaction(), internal);
 
     output.set_ref_block_bytes(internal.raw_data().ref_block_bytes());
     output.set_ref_block_hash(internal.raw_data().ref_block_hash());
 
     const auto serialized = internal.raw_data().SerializeAsString();
-    const auto hash = Hash::sha256(Data(serialized.begin(), serialized.end()));
+    const auto hash = Hash::sha256(serialized);
 
     const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     const auto signature = key.sign(hash, TWCurveSECP256k1);
@@ -325,3 +336,122 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
     return output;
 }
+
+/// Layout of the transfer call data: function selector, then the recipient and amount as 32-byte words.
+static const size_t selectorSize = 4;
+static const size_t callWordSize = 32;
+static const size_t callAddressSize = 21;
+
+TRC20TransferTemplate::TRC20TransferTemplate(const Proto::SigningInput& input)
+    : key(Data(input.private_key().begin(), input.private_key().end())) {
+    const auto& transaction = input.transaction();
+    if (!transaction.has_transfer_trc20_contract()) {
+        throw std::invalid_argument("Not a TRC20 transfer");
+    }
+
+    // zero recipient and amount, the call data has its final size
+    auto transfer = transaction.transfer_trc20_contract();
+    transfer.clear_to_address();
+    transfer.clear_amount();
+
+    auto internal = protocol::Transaction();
+    auto contract = internal.mutable_raw_data()->add_contract();
+    contract->set_type(protocol::Transaction_Contract_ContractType_TriggerSmartContract);
+    google::protobuf::Any any;
+    any.PackFrom(to_internal(transfer));
+    *contract->mutable_parameter() = any;
+    setRawData(transaction, internal);
+
+    refBlockBytes = internal.raw_data().ref_block_bytes();
+    refBlockHash = internal.raw_data().ref_block_hash();
+    const auto serialized = internal.raw_data().SerializeAsString();
+    raw = Data(serialized.begin(), serialized.end());
+
+    // The call data is the last field of the contract, which precedes the timestamp and fee limit.
+    auto prefix = internal.raw_data();
+    prefix.clear_contract();
+    prefix.clear_timestamp();
+    prefix.clear_fee_limit();
+    const auto contractSize = contract->ByteSizeLong();
+    const auto callEnd = prefix.ByteSizeLong() + 1 +
+        google::protobuf::io::CodedOutputStream::VarintSize64(contractSize) + contractSize;
+    const auto callStart = callEnd - selectorSize - 2 * callWordSize;
+    assert(callEnd <= raw.size() && std::equal(raw.begin() + callStart, raw.begin() + callStart + selectorSize,
+                                               parse_hex(TRANSFER_TOKEN_FUNCTION).begin()));
+    recipientOffset = callStart + selectorSize + callWordSize - callAddressSize;
+    amountOffset = callStart + selectorSize + callWordSize;
+
+    json = transactionJSON(internal, Data(32), Data(65)).dump();
+    const auto callHex = json.find("\"data\":\"") + 8;
+    jsonRecipientOffset = callHex + 2 * (recipientOffset - callStart);
+    jsonAmountOffset = callHex + 2 * (amountOffset - callStart);
+    jsonSignatureOffset = json.rfind("\"signature\":[\"") + 14;
+    jsonIdOffset = json.rfind("\"txID\":\"") + 8;
+}
+
+TRC20TransferTemplate::Patch TRC20TransferTemplate::decode(const Transfer& transfer) {
+    auto patch = Patch{Base58::bitcoin.decodeCheck(transfer.toAddress), transfer.amount};
+    if (patch.recipient.size() != callAddressSize) {
+        throw std::invalid_argument("Invalid recipient address");
+    }
+    if (patch.amount.size() > callWordSize) {
+        throw std::invalid_argument("Amount over 256 bits");
+    }
+    pad_left(patch.amount, callWordSize);
+    return patch;
+}
+
+Proto::SigningOutput TRC20TransferTemplate::sign(const Transfer& transfer) const {
+    return sign(decode(transfer));
+}
+
+Data TRC20TransferTemplate::sign(const SigningPatch& patch) const {
+    const auto serialized = sign(decode(Transfer{patch.toAddress, patch.amount})).SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+std::vector<Proto::SigningOutput> TRC20TransferTemplate::signBatch(const std::vector<Transfer>& transfers, size_t threadCount) const {
+    std::vector<Patch> patches;
+    patches.reserve(transfers.size());
+    for (const auto& transfer : transfers) {
+        patches.push_back(decode(transfer));
+    }
+
+    std::vector<Proto::SigningOutput> outputs(patches.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto index = next++; index < patches.size(); index = next++) {
+            outputs[index] = sign(patches[index]);
+        }
+    };
+
+    ThreadPool::shared().run(threadCount, patches.size(), worker);
+    return outputs;
+}
+
+Proto::SigningOutput TRC20TransferTemplate::sign(const Patch& patch) const {
+    auto transaction = raw;
+    std::copy(patch.recipient.begin(), patch.recipient.end(), transaction.begin() + recipientOffset);
+    std::copy(patch.amount.begin(), patch.amount.end(), transaction.begin() + amountOffset);
+
+    const auto hash = Hash::sha256(transaction);
+    const auto signature = key.sign(hash, TWCurveSECP256k1);
+
+    auto transactionJSON = json;
+    const auto replaceHex = [&transactionJSON](size_t offset, const Data& data) {
+        const auto string = hex(data);
+        transactionJSON.replace(offset, string.size(), string);
+    };
+    replaceHex(jsonRecipientOffset, patch.recipient);
+    replaceHex(jsonAmountOffset, patch.amount);
+    replaceHex(jsonSignatureOffset, signature);
+    replaceHex(jsonIdOffset, hash);
+
+    auto output = Proto::SigningOutput();
+    output.set_ref_block_bytes(refBlockBytes);
+    output.set_ref_block_hash(refBlockHash);
+    output.set_id(hash.data(), hash.size());
+    output.set_signature(signature.data(), signature.size());
+    output.set_json(transactionJSON);
+    return output;
+}
@@ -8,8 +8,12 @@
 
 #include "../Data.h"
 #include "../PrivateKey.h"
+#include "../SigningTemplate.h"
 #include "../proto/Tron.pb.h"
 
+#include <string>
+#include <vector>
+
 namespace TW::Tron {
 
 /// Helper class that performs Tron transaction signing.
@@ -21,4 +25,59 @@ class Signer {
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 };
 
+/// Signer of TRC20 transfers that share the sender, token contract, block reference and timing.
+///
+/// The raw transaction data is serialized once, and only the recipient and amount are
+/// patched into it for each transfer, which then produces the same output as Signer::sign.
+/// As a SigningTemplate, the nonce of the patches is ignored.
+class TRC20TransferTemplate : public SigningTemplate {
+  public:
+    /// A recipient and its amount (uint256, big-endian).
+    struct Transfer {
+        std::string toAddress;
+        Data amount;
+    };
+
+    /// Prepares the template from a TRC20 transfer input, its recipient and amount are ignored.
+    ///
+    /// @throws std::invalid_argument if the input is not a TRC20 transfer.
+    explicit TRC20TransferTemplate(const Proto::SigningInput& input);
+
+    /// Signs a transfer.
+    ///
+    /// @throws std::invalid_argument if the address or amount is invalid.
+    Proto::SigningOutput sign(const Transfer& transfer) const;
+
+    /// Signs one transaction per transfer. All transfers are validated before signing.
+    /// threadCount 0 uses the available hardware concurrency.
+    ///
+    /// @throws std::invalid_argument if any address or amount is invalid.
+    std::vector<Proto::SigningOutput> signBatch(const std::vector<Transfer>& transfers, size_t threadCount = 0) const;
+
+    Data sign(const SigningPatch& patch) const override;
+    using SigningTemplate::signBatch;
+
+  private:
+    /// Decoded transfer, with the recipient and amount as they appear in the contract call.
+    struct Patch {
+        Data recipient;
+        Data amount;
+    };
+
+    PrivateKey key;
+    Data raw;
+    size_t recipientOffset;
+    size_t amountOffset;
+    std::string json;
+    size_t jsonRecipientOffset;
+    size_t jsonAmountOffset;
+    size_t jsonSignatureOffset;
+    size_t jsonIdOffset;
+    std::string refBlockBytes;
+    std::string refBlockHash;
+
+    static Patch decode(const Transfer& transfer);
+    Proto::SigningOutput sign(const Patch& patch) const;
+};
+
 } // namespace TW::Tron
@@ -25,6 +25,27 @@ string Entry::deriveAddress(TWCoinType coin, const PublicKey& publicKey, TW::byt
     return Ethereum::Address(publicKey).string();
 }
 
-void Entry::sign(TWCoinType coin, const TW::Data& dataIn, TW::Data& dataOut) const {
+void Entry::sign(TWCoinType coin, TW::DataView dataIn, TW::Data& dataOut) const {
     signTemplate<Signer, Proto::SigningInput>(dataIn, dataOut);
 }
+
+bool Entry::signMessage(TWCoinType coin, const google::protobuf::Message& input, google::protobuf::Message& output) const {
+    return signMessageTemplate<Signer, Proto::SigningInput>(input, output);
+}
+
+std::unique_ptr<TW::SigningTemplate> Entry::signingTemplate(TWCoinType coin, const TW::Data& dataIn) const {
+    auto input = Proto::SigningInput();
+    if (!input.ParseFromArray(dataIn.data(), static_cast<int>(dataIn.size()))) {
+        return nullptr;
+    }
+    // the patch applies to a single clause
+    if (input.clauses_size() != 1) {
+        return nullptr;
+    }
+    return std::make_unique<InputSigningTemplate<Signer, Proto::SigningInput>>(std::move(input), [](Proto::SigningInput& input, const SigningPatch& patch) {
+        input.set_nonce(patch.nonce);
+        auto& clause = *input.mutable_clauses(0);
+        clause.set_to(patch.toAddress);
+        clause.set_value(patch.amount.data(), patch.amount.size());
+    });
+}
@@ -7,16 +7,19 @@
 #include "Signer.h"
 
 #include "../Hash.h"
+#include "../BatchSigning.h"
 
 using namespace TW;
 using namespace TW::VeChain;
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
-    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+namespace {
+
+Transaction transactionFrom(const Proto::SigningInput& input) {
     auto transaction = Transaction();
     transaction.chainTag = static_cast<uint8_t>(input.chain_tag());
     transaction.blockRef = input.block_ref();
     transaction.expiration = input.expiration();
+    transaction.clauses.reserve(input.clauses_size());
     for (auto& clause : input.clauses()) {
         transaction.clauses.emplace_back(clause);
     }
@@ -24,7 +27,11 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     transaction.gas = input.gas();
     transaction.dependsOn = Data(input.depends_on().begin(), input.depends_on().end());
     transaction.nonce = input.nonce();
-    transaction.signature = sign(key, transaction);
+    return transaction;
+}
+
+Proto::SigningOutput signingOutput(Transaction& transaction, Data signature) {
+    transaction.signature = std::move(signature);
 
     auto protoOutput = Proto::SigningOutput();
 
@@ -35,9 +42,57 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     return protoOutput;
 }
 
+} // namespace
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto transaction = transactionFrom(input);
+    auto signature = sign(key, transaction);
+    return signingOutput(transaction, std::move(signature));
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto& keyBytes = inputs[begin].private_key();
+        const auto key = PrivateKey(Data(keyBytes.begin(), keyBytes.end()));
+        std::vector<Transaction> transactions;
+        std::vector<Data> digests;
+        for (auto i = begin; i < end; ++i) {
+            transactions.push_back(transactionFrom(inputs[i]));
+            digests.push_back(transactions.back().signingHash());
+        }
+        std::vector<Data> signatures;
+        key.signBatch(digests, TWCurveSECP256k1, signatures);
+        for (auto i = begin; i < end; ++i) {
+            outputs[i] = signingOutput(transactions[i - begin], std::move(signatures[i - begin]));
+        }
+    });
+}
+
+std::vector<Proto::SigningOutput> Signer::signSplit(const Proto::SigningInput& input, size_t maxSize, size_t threadCount) {
+    // Transactions handed to a thread at a time
+    const size_t chunkSize = 4;
+
+    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+    auto transactions = transactionFrom(input).split(maxSize);
+
+    std::vector<Proto::SigningOutput> outputs(transactions.size());
+    forEachChunk(transactions.size(), chunkSize, threadCount, [&](size_t first, size_t last) {
+        std::vector<Data> digests;
+        std::vector<Data> signatures;
+        for (auto i = first; i < last; ++i) {
+            digests.push_back(transactions[i].signingHash());
+        }
+        key.signBatch(digests, TWCurveSECP256k1, signatures);
+        for (auto i = first; i < last; ++i) {
+            outputs[i] = signingOutput(transactions[i], std::move(signatures[i - first]));
+        }
+    });
+    return outputs;
+}
+
 Data Signer::sign(const PrivateKey& privateKey, Transaction& transaction) noexcept {
-    auto encoded = transaction.encode();
-    auto hash = Hash::blake2b(encoded, 32);
+    auto hash = transaction.signingHash();
     auto signature = privateKey.sign(hash, TWCurveSECP256k1);
     return Data(signature.begin(), signature.end());
 }
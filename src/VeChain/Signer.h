@@ -27,6 +27,17 @@ class Signer {
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys): the key state is
+    /// computed once per run of inputs with the same private key.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
+    /// Signs a transaction with more clauses than fit in one, e.g. a token distribution: the clauses are
+    /// split into transactions of at most `maxSize` encoded bytes (see Transaction::split), signed on up to
+    /// `threadCount` threads (0 for the hardware concurrency).
+    ///
+    /// @throws std::invalid_argument if the private key is invalid or a clause alone does not fit.
+    static std::vector<Proto::SigningOutput> signSplit(const Proto::SigningInput& input, size_t maxSize = Transaction::maxEncodedSize, size_t threadCount = 0);
+
     /// Signs the given transaction.
     static Data sign(const PrivateKey& privateKey, Transaction& transaction) noexcept;
 };
@@ -6,42 +6,109 @@
 
 #include "Transaction.h"
 
-#include "../Ethereum/RLP.h"
+#include "../Ethereum/RLPWriter.h"
+#include "../Hashers.h"
+
+#include <stdexcept>
 
 using namespace TW;
 using namespace TW::VeChain;
-using RLP = Ethereum::RLP;
-
-Data encode(const Clause& clause) noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(clause.to.bytes));
-    append(encoded, RLP::encode(clause.value));
-    append(encoded, RLP::encode(clause.data));
-    return RLP::encodeList(encoded);
+using Ethereum::RLPSizer;
+
+namespace {
+
+/// Encoded size of a 65-byte signature
+const std::size_t signatureSize = 67;
+
+template <typename RLP>
+void writeClause(RLP& rlp, const Clause& clause) {
+    rlp.list([&](auto& list) { list.item(clause.to.bytes).item(clause.value).item(clause.data); });
+}
+
+/// Fields before the clauses
+template <typename RLP>
+void writeHead(RLP& rlp, const Transaction& transaction) {
+    rlp.item(transaction.chainTag).item(transaction.blockRef).item(transaction.expiration);
+}
+
+/// Fields after the clauses, but the signature
+template <typename RLP>
+void writeTail(RLP& rlp, const Transaction& transaction) {
+    rlp.item(transaction.gasPriceCoef)
+        .item(transaction.gas)
+        .item(transaction.dependsOn)
+        .item(transaction.nonce)
+        .itemList(transaction.reserved);
 }
 
-Data encodeClauses(std::vector<Clause> clauses) noexcept {
-    auto encoded = Data();
-    for (const auto& clause : clauses) {
-        auto encodedClause = encode(clause);
-        append(encoded, encodedClause);
-    }
-    return RLP::encodeList(encoded);
+/// Describes the transaction, with its signature if set and `withSignature` is true.
+auto items(const Transaction& transaction, bool withSignature) {
+    return [&transaction, withSignature](auto& rlp) {
+        rlp.list([&](auto& list) {
+            writeHead(list, transaction);
+            list.list([&](auto& clauses) {
+                for (const auto& clause : transaction.clauses) {
+                    writeClause(clauses, clause);
+                }
+            });
+            writeTail(list, transaction);
+            if (withSignature && !transaction.signature.empty()) {
+                list.item(transaction.signature);
+            }
+        });
+    };
 }
 
+} // namespace
+
 Data Transaction::encode() const noexcept {
-    auto encoded = Data();
-    append(encoded, RLP::encode(chainTag));
-    append(encoded, RLP::encode(blockRef));
-    append(encoded, RLP::encode(expiration));
-    append(encoded, encodeClauses(clauses));
-    append(encoded, RLP::encode(gasPriceCoef));
-    append(encoded, RLP::encode(gas));
-    append(encoded, RLP::encode(dependsOn));
-    append(encoded, RLP::encode(nonce));
-    append(encoded, RLP::encodeList(reserved));
-    if (!signature.empty()) {
-        append(encoded, RLP::encode(signature));
-    }
-    return RLP::encodeList(encoded);
+    return Ethereum::rlpEncode(items(*this, true));
+}
+
+Data Transaction::signingHash() const noexcept {
+    auto hasher = Hash::Blake2bHasher(32);
+    Ethereum::rlpWrite(hasher, items(*this, false));
+    return hasher.final();
+}
+
+std::vector<Transaction> Transaction::split(std::size_t maxSize) const {
+    std::vector<Transaction> parts;
+    std::size_t begin = 0;
+    do {
+        auto part = Transaction();
+        part.chainTag = chainTag;
+        part.blockRef = blockRef;
+        part.expiration = expiration;
+        part.gasPriceCoef = gasPriceCoef;
+        part.gas = gas;
+        part.dependsOn = dependsOn;
+        part.nonce = nonce + parts.size();
+        part.reserved = reserved;
+
+        RLPSizer fixed;
+        writeHead(fixed, part);
+        writeTail(fixed, part);
+        const auto fixedSize = fixed.size + signatureSize;
+
+        // adds clauses while the signed transaction fits
+        std::size_t clausesSize = 0;
+        auto end = begin;
+        for (; end < clauses.size(); ++end) {
+            RLPSizer clause;
+            writeClause(clause, clauses[end]);
+            const auto size = clausesSize + clause.size;
+            const auto payloadSize = fixedSize + RLPSizer::headerSize(size) + size;
+            if (RLPSizer::headerSize(payloadSize) + payloadSize > maxSize) {
+                break;
+            }
+            clausesSize = size;
+        }
+        if (end == begin && begin < clauses.size()) {
+            throw std::invalid_argument("Clause too large for a transaction");
+        }
+        part.clauses.assign(clauses.begin() + begin, clauses.begin() + end);
+        parts.push_back(std::move(part));
+        begin = end;
+    } while (begin < clauses.size());
+    return parts;
 }
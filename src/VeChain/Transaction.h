@@ -9,6 +9,7 @@
 #include "Clause.h"
 #include "../Data.h"
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -52,11 +53,24 @@ class Transaction {
     /// Transaction signature.
     Data signature;
 
+    /// Largest encoded transaction VeChainThor nodes accept.
+    static const std::size_t maxEncodedSize = 64 * 1024;
+
     Transaction() = default;
 
   public:
     /// Encodes the transaction.
     Data encode() const noexcept;
+
+    /// Blake2b-256 hash of the transaction without its signature, the encoding being streamed into the hasher.
+    Data signingHash() const noexcept;
+
+    /// Splits the clauses, in order, into as many unsigned transactions as needed for each to be at most
+    /// `maxSize` bytes once signed and encoded. Part `i` has `nonce + i` as nonce, so that the parts have
+    /// distinct IDs, and the other fields of this transaction, gas included.
+    ///
+    /// @throws std::invalid_argument if a clause alone does not fit.
+    std::vector<Transaction> split(std::size_t maxSize = maxEncodedSize) const;
 };
 
 } // namespace TW::VeChain
@@ -0,0 +1,90 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Warmup.h"
+#include "Coin.h"
+#include "HexCoding.h"
+#include "Instrumentation.h"
+#include "LockedMemory.h"
+#include "Mnemonic.h"
+#include "PrivateKey.h"
+#include "Secp256k1Comb.h"
+#include "ThreadPool.h"
+
+#include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/descriptor_database.h>
+
+#include <string>
+
+using namespace TW;
+
+namespace {
+
+bool warmupCurveTables(bool lock) {
+    TW_INSTRUMENT_SCOPE("warmup::curveTables");
+    auto locked = true;
+#if USE_PRECOMPUTED_CP
+    locked = prefaultMemory(secp256k1.cp, sizeof(secp256k1.cp), lock) && locked;
+    locked = prefaultMemory(nist256p1.cp, sizeof(nist256p1.cp), lock) && locked;
+#endif
+    locked = prefaultMemory(ge25519_niels_base_multiples, sizeof(ge25519_niels_base_multiples), lock) && locked;
+    // no comb table when the fast path is disabled
+    const auto combLocked = Secp256k1Comb::prefault(lock);
+    return locked && (combLocked || Secp256k1Comb::tableSize() == 0);
+}
+
+void warmupCoins(const std::vector<TWCoinType>& coins) {
+    TW_INSTRUMENT_SCOPE_COUNT("warmup::coins", coins.size());
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    ThreadPool::shared().parallelFor(coins.size(), 0, [&](std::size_t index) {
+        const auto coin = coins[index];
+        try {
+            // constructs the dispatcher, and runs the key derivation, hashing and encoding of the coin once
+            const auto address = deriveAddress(coin, privateKey);
+            validateAddress(coin, address);
+        } catch (const std::exception&) {
+            // coins needing other kinds of keys, e.g. extended ed25519 keys
+        }
+    });
+}
+
+void warmupProtobuf() {
+    TW_INSTRUMENT_SCOPE("warmup::protobuf");
+    std::vector<std::string> files;
+    if (!google::protobuf::DescriptorPool::internal_generated_database()->FindAllFileNames(&files)) {
+        return;
+    }
+    const auto pool = google::protobuf::DescriptorPool::generated_pool();
+    for (const auto& file : files) {
+        pool->FindFileByName(file);
+    }
+}
+
+} // namespace
+
+WarmupResult TW::warmup(const std::vector<TWCoinType>& coins, uint32_t flags) {
+    TW_INSTRUMENT_SCOPE("warmup");
+    const auto start = std::chrono::steady_clock::now();
+    WarmupResult result;
+    if ((flags & TWWarmupFlagsCurveTables) != 0) {
+        result.tablesLocked = warmupCurveTables((flags & TWWarmupFlagsLockTables) != 0);
+    }
+    if ((flags & TWWarmupFlagsWordlist) != 0) {
+        Mnemonic::isValidWord("abandon");
+    }
+    if ((flags & TWWarmupFlagsCoins) != 0) {
+        warmupCoins(coins.empty() ? getCoinTypes() : coins);
+    }
+    if ((flags & TWWarmupFlagsProtobuf) != 0) {
+        warmupProtobuf();
+    }
+    result.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    return result;
+}
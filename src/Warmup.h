@@ -0,0 +1,29 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrustWalletCore/TWWarmup.h>
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace TW {
+
+/// Outcome of a warm-up.
+struct WarmupResult {
+    std::chrono::nanoseconds duration{0};
+    /// Whether all the curve tables could be locked in RAM, when requested.
+    bool tablesLocked = false;
+};
+
+/// Initializes the lazily built state selected by `flags` (TWWarmupFlags) for `coins`, all coins if empty.
+/// Failures of single steps are ignored: they only leave some state to initialize on first use.
+WarmupResult warmup(const std::vector<TWCoinType>& coins, uint32_t flags);
+
+} // namespace TW
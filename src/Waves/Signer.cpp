@@ -7,21 +7,55 @@
 #include "Signer.h"
 
 #include "../Hash.h"
+#include "../SigningOutputFields.h"
+#include "../BatchSigning.h"
 
 using namespace TW;
 using namespace TW::Waves;
 
+static Proto::SigningOutput signingOutput(const Transaction& transaction, const Data& signature) {
+    Proto::SigningOutput output = Proto::SigningOutput();
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldSignature)) {
+        output.set_signature(reinterpret_cast<const char *>(signature.data()), signature.size());
+    }
+    if (SigningOutputFields::requested(TWAnySignerOutputFieldJSON)) {
+        output.set_json(transaction.buildJsonString(signature));
+    }
+    return output;
+}
+
 Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
     auto privateKey = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
     auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeCURVE25519);
-    auto transaction = Transaction(input, publicKey.bytes);
+    auto transaction = Transaction(input, publicKey.bytes.toData());
 
     Data signature = Signer::sign(privateKey, transaction);
+    return signingOutput(transaction, signature);
+}
 
-    Proto::SigningOutput output = Proto::SigningOutput();
-    output.set_signature(reinterpret_cast<const char *>(signature.data()), signature.size());
-    output.set_json(transaction.buildJson(signature).dump());
-    return output;
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto& key = inputs[begin].private_key();
+        const auto privateKey = PrivateKey(Data(key.begin(), key.end()));
+        const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeCURVE25519);
+        std::vector<Transaction> transactions;
+        std::vector<Data> messages;
+        for (auto i = begin; i < end; ++i) {
+            transactions.emplace_back(inputs[i], publicKey.bytes.toData());
+            try {
+                messages.push_back(transactions.back().serializeToSign());
+            } catch (const std::exception&) {
+                // as in sign(): an empty signature
+                messages.emplace_back();
+            }
+        }
+        std::vector<Data> signatures;
+        privateKey.signBatch(messages, TWCurveCurve25519, signatures);
+        for (auto i = begin; i < end; ++i) {
+            const auto& message = messages[i - begin];
+            outputs[i] = signingOutput(transactions[i - begin], message.empty() ? Data() : signatures[i - begin]);
+        }
+    });
 }
 
 Data Signer::sign(const PrivateKey &privateKey, Transaction &transaction) noexcept {
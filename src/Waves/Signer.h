@@ -26,6 +26,11 @@ class Signer {
     /// Signs a Proto::SigningInput transaction
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys). The Curve25519
+    /// public key and the signing key state are computed once per run of inputs with the same private key,
+    /// as in transfers from one sender.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
     /// Signs the given transaction.
     static Data sign(const PrivateKey &privateKey, Transaction &transaction) noexcept;
 };
@@ -9,6 +9,7 @@
 #include "../Base58.h"
 #include "../BinaryCoding.h"
 #include "../HexCoding.h"
+#include "../JsonWriter.h"
 
 using namespace TW;
 using namespace TW::Waves;
@@ -19,6 +20,7 @@ const std::string Transaction::WAVES = "WAVES";
 
 Data serializeTransfer(int64_t amount, std::string asset, int64_t fee, std::string fee_asset, Address to, const Data& attachment, int64_t timestamp, const Data& pub_key) {
     auto data = Data();
+    data.reserve(2 + pub_key.size() + 2 * (1 + 32) + 3 * 8 + Address::size + 2 + attachment.size());
     if (asset.empty()) {
       asset = Transaction::WAVES;
     }
@@ -52,6 +54,7 @@ Data serializeTransfer(int64_t amount, std::string asset, int64_t fee, std::stri
 
 Data serializeLease(int64_t amount, int64_t fee, Address to, int64_t timestamp, const Data& pub_key) {
     auto data = Data();
+    data.reserve(3 + pub_key.size() + Address::size + 3 * 8);
     data.resize(2);
     data[0] = static_cast<byte>(TransactionType::lease);
     data[1] = static_cast<byte>(TransactionVersion::V2);
@@ -67,6 +70,7 @@ Data serializeLease(int64_t amount, int64_t fee, Address to, int64_t timestamp,
 
 Data serializeCancelLease(const Data& leaseId, int64_t fee, int64_t timestamp, const Data& pub_key) {
     auto data = Data();
+    data.reserve(3 + pub_key.size() + 2 * 8 + leaseId.size());
     data.resize(2);
     data[0] = static_cast<byte>(TransactionType::cancelLease);
     data[1] = static_cast<byte>(TransactionVersion::V2);
@@ -198,5 +202,67 @@ json Transaction::buildJson(const Data& signature) const {
     return nullptr;
 }
 
-
-
+std::string Transaction::buildJsonString(const Data& signature) const {
+    std::string output;
+    output.reserve(512);
+    JsonStringSink sink(output);
+    // fields in sorted order, as buildJson().dump() writes them
+    JsonWriter<JsonStringSink> writer(sink);
+    auto writeProofs = [&]() {
+        writer.key("proofs");
+        writer.beginArray();
+        writer.value(Base58::bitcoin.encode(signature));
+        writer.endArray();
+    };
+    if (input.has_transfer_message()) {
+        const auto& message = input.transfer_message();
+        const auto attachment = Data(message.attachment().begin(), message.attachment().end());
+        const auto to = Address(message.to());
+        writer.beginObject();
+        writer.field("amount", message.amount());
+        if (message.asset() != Transaction::WAVES) {
+            writer.field("assetId", message.asset());
+        }
+        writer.field("attachment", Base58::bitcoin.encode(attachment));
+        writer.field("fee", message.fee());
+        if (message.fee_asset() != Transaction::WAVES) {
+            writer.field("feeAssetId", message.fee_asset());
+        }
+        writeProofs();
+        writer.field("recipient", to.string());
+        writer.field("senderPublicKey", Base58::bitcoin.encode(pub_key));
+        writer.field("timestamp", input.timestamp());
+        writer.field("type", static_cast<int>(TransactionType::transfer));
+        writer.field("version", static_cast<int>(TransactionVersion::V2));
+        writer.endObject();
+    } else if (input.has_lease_message()) {
+        const auto& message = input.lease_message();
+        const auto to = Address(message.to());
+        writer.beginObject();
+        writer.field("amount", message.amount());
+        writer.field("fee", message.fee());
+        writeProofs();
+        writer.field("recipient", to.string());
+        writer.field("senderPublicKey", Base58::bitcoin.encode(pub_key));
+        writer.field("timestamp", input.timestamp());
+        writer.field("type", static_cast<int>(TransactionType::lease));
+        writer.field("version", static_cast<int>(TransactionVersion::V2));
+        writer.endObject();
+    } else if (input.has_cancel_lease_message()) {
+        const auto& message = input.cancel_lease_message();
+        const auto leaseId = Base58::bitcoin.decode(message.lease_id());
+        writer.beginObject();
+        writer.field("chainId", 87); // mainnet
+        writer.field("fee", message.fee());
+        writer.field("leaseId", Base58::bitcoin.encode(leaseId));
+        writeProofs();
+        writer.field("senderPublicKey", Base58::bitcoin.encode(pub_key));
+        writer.field("timestamp", input.timestamp());
+        writer.field("type", static_cast<int>(TransactionType::cancelLease));
+        writer.field("version", static_cast<int>(TransactionVersion::V2));
+        writer.endObject();
+    } else {
+        output = "null";
+    }
+    return output;
+}
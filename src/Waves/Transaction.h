@@ -30,6 +30,8 @@ class Transaction {
   public:
     Data serializeToSign() const;
     nlohmann::json buildJson(const Data& signature) const;
+    /// Same as buildJson(signature).dump(), written directly.
+    std::string buildJsonString(const Data& signature) const;
 };
 
 } // namespace TW::Waves
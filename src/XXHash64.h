@@ -164,6 +164,43 @@ public:
       return hasher.hash();
   }
 
+  /// hash the same data with two seeds in a single pass, e.g. TwoX128 (seeds 0 and 1)
+  /** both sets of 4 accumulators are independent, so their multiplications overlap
+      @param  input  pointer to a continuous block of data
+      @param  length number of bytes
+      @param  seed0  seed of the first hash
+      @param  seed1  seed of the second hash
+      @param  result both 64 bit XXHashes **/
+  static void hash2(const void* input, uint64_t length, uint64_t seed0, uint64_t seed1, uint64_t result[2])
+  {
+    XXHash64 first(seed0), second(seed1);
+    const unsigned char* data = (const unsigned char*)input;
+    const unsigned char* stop = data + length;
+    if (length >= MaxBufferSize)
+    {
+      const unsigned char* stopBlock = stop - MaxBufferSize;
+      uint64_t a0 = first.state[0],  a1 = first.state[1],  a2 = first.state[2],  a3 = first.state[3];
+      uint64_t b0 = second.state[0], b1 = second.state[1], b2 = second.state[2], b3 = second.state[3];
+      while (data <= stopBlock)
+      {
+        process(data, a0, a1, a2, a3);
+        process(data, b0, b1, b2, b3);
+        data += 32;
+      }
+      first.state[0]  = a0; first.state[1]  = a1; first.state[2]  = a2; first.state[3]  = a3;
+      second.state[0] = b0; second.state[1] = b1; second.state[2] = b2; second.state[3] = b3;
+    }
+
+    // remainder, as add() leaves it
+    first.bufferSize = second.bufferSize = uint32_t(stop - data);
+    for (unsigned int i = 0; i < first.bufferSize; i++)
+      first.buffer[i] = second.buffer[i] = data[i];
+    first.totalLength = second.totalLength = length;
+
+    result[0] = first.hash();
+    result[1] = second.hash();
+  }
+
 private:
   /// magic constants :-)
   static const uint64_t Prime1 = 11400714785074694791ULL;
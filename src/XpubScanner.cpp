@@ -0,0 +1,80 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "XpubScanner.h"
+
+#include "Coin.h"
+#include "HDWallet.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <stdexcept>
+
+using namespace TW;
+
+XpubScanner::XpubScanner(const std::string& extended, TWCoinType coin) : coin(coin), publicKeyType(TW::publicKeyType(coin)) {
+    const auto node = HDWallet::getNodeFromExtended(extended, coin);
+    if (!node || node->curve->params == nullptr) {
+        throw std::invalid_argument("Invalid extended key");
+    }
+    // Only secp256k1 and nist256p1 support public derivation
+    const auto curve = TW::curve(coin);
+    if (!(curve == TWCurveSECP256k1 && publicKeyType == TWPublicKeyTypeSECP256k1) &&
+        !(curve == TWCurveNIST256p1 && publicKeyType == TWPublicKeyTypeNIST256p1)) {
+        throw std::invalid_argument("Public derivation not supported for coin");
+    }
+    accountNode = *node;
+    if (accountNode.public_key[0] == 0) {
+        // extended private key
+        hdnode_fill_public_key(&accountNode);
+    }
+}
+
+XpubScanner::~XpubScanner() {
+    memzero(&accountNode, sizeof(accountNode));
+    for (auto& entry : changeNodes) {
+        memzero(&entry.second, sizeof(entry.second));
+    }
+}
+
+PublicKey XpubScanner::publicKey(uint32_t change, uint32_t index) {
+    auto node = changeNode(change);
+    hdnode_public_ckd(&node, index);
+    return PublicKey(Data(node.public_key, node.public_key + PublicKey::secp256k1Size), publicKeyType);
+}
+
+std::string XpubScanner::address(uint32_t change, uint32_t index) {
+    return TW::deriveAddress(coin, publicKey(change, index));
+}
+
+std::vector<std::string> XpubScanner::addresses(uint32_t change, uint32_t firstIndex, uint32_t count) {
+    std::vector<std::string> result;
+    result.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        result.push_back(address(change, firstIndex + i));
+    }
+    return result;
+}
+
+uint32_t XpubScanner::scan(uint32_t change, uint32_t gapLimit, const std::function<bool(const std::string& address)>& isUsed) {
+    uint32_t next = 0;
+    for (uint32_t index = 0; index - next < gapLimit; ++index) {
+        if (isUsed(address(change, index))) {
+            next = index + 1;
+        }
+    }
+    return next;
+}
+
+const HDNode& XpubScanner::changeNode(uint32_t change) {
+    auto found = changeNodes.find(change);
+    if (found == changeNodes.end()) {
+        auto node = accountNode;
+        hdnode_public_ckd(&node, change);
+        found = changeNodes.emplace(change, node).first;
+    }
+    return found->second;
+}
@@ -0,0 +1,61 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "PublicKey.h"
+
+#include <TrustWalletCore/TWCoinType.h>
+#include <TrezorCrypto/bip32.h>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace TW {
+
+/// Watch-only address generator for an account-level extended public key (bip44 standard).
+///
+/// The extended key is parsed once, and the change-level nodes are kept,
+/// so each address costs a single public child derivation.
+/// Not thread-safe, use one instance per thread.
+class XpubScanner {
+  public:
+    /// Coin of the addresses.
+    TWCoinType coin;
+
+    /// Parses an extended public key for the given coin.
+    ///
+    /// @throws std::invalid_argument if the extended key is invalid or not applicable to the coin.
+    XpubScanner(const std::string& extended, TWCoinType coin);
+
+    ~XpubScanner();
+
+    /// Returns the public key at m/.../change/index.
+    PublicKey publicKey(uint32_t change, uint32_t index);
+
+    /// Returns the address at m/.../change/index.
+    std::string address(uint32_t change, uint32_t index);
+
+    /// Returns `count` consecutive addresses, starting at `firstIndex`.
+    std::vector<std::string> addresses(uint32_t change, uint32_t firstIndex, uint32_t count);
+
+    /// Generates addresses for the change level as long as there are less than `gapLimit`
+    /// consecutive unused ones, according to `isUsed`.
+    /// Returns the index following the last used address (0 if none is used).
+    uint32_t scan(uint32_t change, uint32_t gapLimit, const std::function<bool(const std::string& address)>& isUsed);
+
+  private:
+    HDNode accountNode;
+    TWPublicKeyType publicKeyType;
+    std::map<uint32_t, HDNode> changeNodes;
+
+    const HDNode& changeNode(uint32_t change);
+};
+
+} // namespace TW
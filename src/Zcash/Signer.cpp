@@ -5,9 +5,11 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Signer.h"
+#include "Bitcoin/SignerTraits.h"
 #include "Bitcoin/TransactionSigner.h"
 #include "Hash.h"
 #include "HexCoding.h"
+#include "SigningOutputFields.h"
 #include "Transaction.h"
 #include "TransactionBuilder.h"
 
@@ -27,15 +29,21 @@ SigningOutput Signer::sign(const SigningInput& input) noexcept {
         output.set_error(result.error());
     } else {
         const auto& tx = result.payload();
-        *output.mutable_transaction() = tx.proto();
+        if (SigningOutputFields::requested(TWAnySignerOutputFieldTransaction)) {
+            *output.mutable_transaction() = tx.proto();
+        }
 
         Data encoded;
         tx.encode(encoded);
-        output.set_encoded(encoded.data(), encoded.size());
+        if (SigningOutputFields::requested(TWAnySignerOutputFieldEncoded)) {
+            output.set_encoded(encoded.data(), encoded.size());
+        }
 
-        auto txHash = Hash::sha256d(encoded.data(), encoded.size());
-        std::reverse(txHash.begin(), txHash.end());
-        output.set_transaction_id(hex(txHash));
+        if (SigningOutputFields::requested(TWAnySignerOutputFieldTransactionId)) {
+            auto txHash = Bitcoin::SignerTraits<Transaction>::txidHasher(encoded.data(), encoded.size());
+            std::reverse(txHash.begin(), txHash.end());
+            output.set_transaction_id(hex(txHash));
+        }
     }
     return output;
 }
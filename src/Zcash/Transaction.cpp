@@ -9,6 +9,7 @@
 #include "../Bitcoin/SigHashType.h"
 #include "../BinaryCoding.h"
 #include "../Hash.h"
+#include "../Hashers.h"
 #include  "../HexCoding.h"
 
 #include <cassert>
@@ -29,6 +30,45 @@ const std::array<byte, 4> Zcash::SaplingBranchID = {0xbb, 0x09, 0xb8, 0x76};
 /// See https://github.com/zcash/zips/blob/master/zip-0206.rst#blossom-deployment BRANCH_ID section
 const std::array<byte, 4> Zcash::BlossomBranchID = {0x60, 0x0e, 0xb4, 0x2b};
 
+/// Initial hasher states for the personalizations, copied for each hash instead of re-initialized.
+/// Computed on first use rather than when the library is loaded.
+static const Hash::Blake2bHasher& prevoutsHasher() {
+    static const auto hasher = Hash::Blake2bHasher(32, prevoutsHashPersonalization);
+    return hasher;
+}
+
+static const Hash::Blake2bHasher& sequenceHasher() {
+    static const auto hasher = Hash::Blake2bHasher(32, sequenceHashPersonalization);
+    return hasher;
+}
+
+static const Hash::Blake2bHasher& outputsHasher() {
+    static const auto hasher = Hash::Blake2bHasher(32, outputsHashPersonalization);
+    return hasher;
+}
+
+/// Hash of the absent JoinSplits, shielded spends and shielded outputs.
+const auto emptyHash = Data(32, 0);
+
+static Hash::Blake2bHasher makeSigHashHasher(const std::array<byte, 4>& branchId) {
+    auto personalization = sigHashPersonalization;
+    personalization.insert(personalization.end(), branchId.begin(), branchId.end());
+    return Hash::Blake2bHasher(32, personalization);
+}
+
+/// Returns the initial signature hasher state of a consensus branch, precomputed for the known branches.
+static Hash::Blake2bHasher sigHashHasher(const std::array<byte, 4>& branchId) {
+    static const auto sapling = makeSigHashHasher(SaplingBranchID);
+    static const auto blossom = makeSigHashHasher(BlossomBranchID);
+    if (branchId == SaplingBranchID) {
+        return sapling;
+    }
+    if (branchId == BlossomBranchID) {
+        return blossom;
+    }
+    return makeSigHashHasher(branchId);
+}
+
 Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, enum TWBitcoinSigHashType hashType,
                               uint64_t amount) const {
     assert(index < inputs.size());
@@ -65,8 +105,7 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
     } else if (Bitcoin::hashTypeIsSingle(hashType) && index < outputs.size()) {
         auto outputData = Data{};
         outputs[index].encode(outputData);
-        auto hashOutputs =
-            TW::Hash::blake2b(outputData, outputData.size(), outputsHashPersonalization);
+        auto hashOutputs = Hash::Blake2bHasher(outputsHasher()).update(outputData).final();
         copy(begin(hashOutputs), end(hashOutputs), back_inserter(data));
     } else {
         fill_n(back_inserter(data), 32, 0);
@@ -109,46 +148,62 @@ Data Transaction::getPreImage(const Bitcoin::Script& scriptCode, size_t index, e
 }
 
 Data Transaction::getPrevoutHash() const {
+    if (signatureHashCache) {
+        return signatureHashCache->prevoutHash;
+    }
+    auto hasher = prevoutsHasher();
     auto data = Data{};
     for (auto& input : inputs) {
-        auto& outpoint = input.previousOutput;
-        outpoint.encode(data);
+        data.clear();
+        input.previousOutput.encode(data);
+        hasher.update(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, prevoutsHashPersonalization);
-    return hash;
+    return hasher.final();
 }
 
 Data Transaction::getSequenceHash() const {
+    if (signatureHashCache) {
+        return signatureHashCache->sequenceHash;
+    }
+    auto hasher = sequenceHasher();
     auto data = Data{};
     for (auto& input : inputs) {
+        data.clear();
         encode32LE(input.sequence, data);
+        hasher.update(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, sequenceHashPersonalization);
-    return hash;
+    return hasher.final();
 }
 
 Data Transaction::getOutputsHash() const {
+    if (signatureHashCache) {
+        return signatureHashCache->outputsHash;
+    }
+    auto hasher = outputsHasher();
     auto data = Data{};
     for (auto& output : outputs) {
+        data.clear();
         output.encode(data);
+        hasher.update(data);
     }
-    auto hash = TW::Hash::blake2b(data, 32, outputsHashPersonalization);
-    return hash;
+    return hasher.final();
+}
+
+void Transaction::cacheSignatureHashes() {
+    signatureHashCache.reset();
+    signatureHashCache = Bitcoin::SignatureHashCache{getPrevoutHash(), getSequenceHash(), getOutputsHash()};
 }
 
 Data Transaction::getJoinSplitsHash() const {
-    Data vec(32, 0);
-    return vec;
+    return emptyHash;
 }
 
 Data Transaction::getShieldedSpendsHash() const {
-    Data vec(32, 0);
-    return vec;
+    return emptyHash;
 }
 
 Data Transaction::getShieldedOutputsHash() const {
-    Data vec(32, 0);
-    return vec;
+    return emptyHash;
 }
 
 void Transaction::encode(Data& data) const {
@@ -182,14 +237,9 @@ void Transaction::encode(Data& data) const {
 Data Transaction::getSignatureHash(const Bitcoin::Script& scriptCode, size_t index,
                                    enum TWBitcoinSigHashType hashType, uint64_t amount,
                                    Bitcoin::SignatureVersion version) const {
-    Data personalization;
-    personalization.reserve(16);
-    std::copy(sigHashPersonalization.begin(), sigHashPersonalization.begin() + 12,
-              std::back_inserter(personalization));
-    std::copy(branchId.begin(), branchId.end(), std::back_inserter(personalization));
-    auto preimage = getPreImage(scriptCode, index, hashType, amount);
-    auto hash = Hash::blake2b(preimage, 32, personalization);
-    return hash;
+    auto hasher = sigHashHasher(branchId);
+    hasher.update(getPreImage(scriptCode, index, hashType, amount));
+    return hasher.final();
 }
 
 Bitcoin::Proto::Transaction Transaction::proto() const {
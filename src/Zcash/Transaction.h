@@ -13,6 +13,7 @@
 #include "../proto/Bitcoin.pb.h"
 
 #include <array>
+#include <optional>
 #include <vector>
 
 namespace TW::Zcash {
@@ -57,6 +58,11 @@ struct Transaction {
     Data getSequenceHash() const;
     Data getOutputsHash() const;
 
+    /// Computes the prevout, sequence and outputs hashes once, to be reused by the signature hash of every input.
+    /// The cache has to be cleared when the inputs' outpoints or sequences, or the outputs, are changed.
+    void cacheSignatureHashes();
+    void clearSignatureHashCache() { signatureHashCache.reset(); }
+
     Data getJoinSplitsHash() const;
     Data getShieldedSpendsHash() const;
     Data getShieldedOutputsHash() const;
@@ -70,6 +76,10 @@ struct Transaction {
 
     /// Converts to Protobuf model
     Bitcoin::Proto::Transaction proto() const;
+
+  private:
+    /// Precomputed hashes, see cacheSignatureHashes().
+    std::optional<Bitcoin::SignatureHashCache> signatureHashCache;
 };
 
 } // namespace TW::Zcash
@@ -6,12 +6,19 @@
 
 #include "Signer.h"
 #include "Address.h"
-#include "Protobuf/ZilliqaMessage.pb.h"
 
 #include "Data.h"
 #include "Hash.h"
 #include "HexCoding.h"
+#include "Secp256k1Comb.h"
 #include "uint256.h"
+#include "../BatchSigning.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/schnorr.h>
+#include <TrezorCrypto/secp256k1.h>
+#include <TrezorCrypto/sha2.h>
 
 #include <cassert>
 
@@ -19,81 +26,152 @@
 
 using namespace TW;
 using namespace TW::Zilliqa;
-using ByteArray = ZilliqaMessage::ByteArray;
 
-static inline Data prependZero(Data& data) {
-    if (data.size() < 16) {
-        Data zero = Data(16 - data.size(), 0);
-        zero.insert(zero.end(), data.begin(), data.end());
-        return zero;
+// The preimage is a ZilliqaMessage::ProtoTransactionCoreInfo in protobuf encoding (see
+// Protobuf/ZilliqaMessage.proto), written directly: fields in field number order, each a key
+// (field number and wire type) followed by a varint or a length-prefixed value.
+
+static inline size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
     }
-    return Data(data);
+    return size;
 }
 
-static inline ByteArray* byteArray(Data& amount) {
-    auto array = new ByteArray();
-    amount = prependZero(amount);
-    array->set_data(amount.data(), amount.size());
-    return array;
+static inline void appendVarint(Data& data, uint64_t value) {
+    while (value >= 0x80) {
+        data.push_back(static_cast<byte>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<byte>(value));
 }
 
-static inline ByteArray* byteArray(const void* data, size_t size) {
-    auto array = new ByteArray();
-    array->set_data(data, size);
-    return array;
+static inline void appendVarintField(Data& data, uint32_t field, uint64_t value) {
+    appendVarint(data, field << 3);
+    appendVarint(data, value);
 }
 
-Data Signer::getPreImage(const Proto::SigningInput& input, Address& address) noexcept {
-    auto internal = ZilliqaMessage::ProtoTransactionCoreInfo();
-    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
+static inline void appendBytesField(Data& data, uint32_t field, const void* bytes, size_t size) {
+    appendVarint(data, (field << 3) | 2);
+    appendVarint(data, size);
+    const auto begin = static_cast<const byte*>(bytes);
+    data.insert(data.end(), begin, begin + size);
+}
+
+/// ByteArray message field, with its data padded to 16 bytes
+static inline void appendByteArrayField(Data& data, uint32_t field, const std::string& bytes, bool padded) {
+    const size_t padding = padded && bytes.size() < 16 ? 16 - bytes.size() : 0;
+    const size_t size = padding + bytes.size();
+    appendVarint(data, (field << 3) | 2);
+    appendVarint(data, 1 + varintSize(size) + size);
+    appendVarint(data, (1 << 3) | 2);
+    appendVarint(data, size);
+    data.insert(data.end(), padding, 0);
+    data.insert(data.end(), bytes.begin(), bytes.end());
+}
+
+SigningContext::SigningContext(DataView privateKey)
+    : key(privateKey), pubKey(key.getPublicKey(TWPublicKeyTypeSECP256k1)) {
+    init_rfc6979_key(key.bytes.data(), &keyState);
+    appendByteArrayField(senderField, 4, std::string(pubKey.bytes.begin(), pubKey.bytes.end()), false);
+}
+
+SigningContext::~SigningContext() {
+    memzero(&keyState, sizeof(keyState));
+}
+
+Data SigningContext::preImage(const Proto::SigningInput& input, Address& address) const {
     if (!Address::decode(input.to(), address)) {
         // invalid input address
         return Data(0);
     }
-    const auto pubKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
-    auto gasPrice = Data(input.gas_price().begin(), input.gas_price().end());
-
-    internal.set_version(input.version());
-    internal.set_nonce(input.nonce());
-    internal.set_toaddr(address.getKeyHash().data(), address.getKeyHash().size());
-    internal.set_gaslimit(input.gas_limit());
-    internal.set_allocated_senderpubkey(byteArray(pubKey.bytes.data(), pubKey.bytes.size()));
-    internal.set_allocated_gasprice(byteArray(gasPrice));
 
-    Data amount;
+    const std::string* amount = &input.transaction().transfer().amount();
+    const std::string* code = nullptr;
+    const std::string* data = nullptr;
     switch (input.transaction().message_oneof_case()) {
-    case Proto::Transaction::kTransfer: {
-        const auto transfer = input.transaction().transfer();
-        amount = Data(transfer.amount().begin(), transfer.amount().end());
+    case Proto::Transaction::kTransfer:
         break;
-    }
     case Proto::Transaction::kRawTransaction: {
-        const auto raw = input.transaction().raw_transaction();
-        amount = Data(raw.amount().begin(), raw.amount().end());
+        const auto& raw = input.transaction().raw_transaction();
+        amount = &raw.amount();
         if (!raw.code().empty()) {
-            internal.set_code(raw.code());
+            code = &raw.code();
         }
         if (!raw.data().empty()) {
-            internal.set_data(raw.data());
+            data = &raw.data();
         }
         break;
     }
-    default: break;
+    default:
+        amount = nullptr;
+        break;
     }
 
-    internal.set_allocated_amount(byteArray(amount));
+    const auto& keyHash = address.getKeyHash();
+    Data result;
+    result.reserve(64 + senderField.size() + 2 * 20 + (code ? code->size() : 0) + (data ? data->size() : 0) +
+                   input.gas_price().size() + (amount ? amount->size() : 0));
+    appendVarintField(result, 1, input.version());
+    appendVarintField(result, 2, input.nonce());
+    appendBytesField(result, 3, keyHash.data(), keyHash.size());
+    append(result, senderField);
+    appendByteArrayField(result, 5, amount ? *amount : std::string(), true);
+    appendByteArrayField(result, 6, input.gas_price(), true);
+    appendVarintField(result, 7, input.gas_limit());
+    if (code != nullptr) {
+        appendBytesField(result, 8, code->data(), code->size());
+    }
+    if (data != nullptr) {
+        appendBytesField(result, 9, data->data(), data->size());
+    }
+    return result;
+}
 
-    const auto serialized = internal.SerializeAsString();
-    return Data(serialized.begin(), serialized.end());
+Data SigningContext::signSchnorr(const Data& message) const {
+    // as zil_schnorr_sign, with the key state, and the commitment k*G computed with the comb tables
+    uint8_t hash[SHA256_DIGEST_LENGTH];
+    sha256_Raw(message.data(), message.size(), hash);
+    rfc6979_state rng;
+    init_rfc6979_with_key(&keyState, key.bytes.data(), hash, &rng);
+
+    Data result;
+    bignum256 k;
+    uint8_t kBytes[32];
+    uint8_t commitment[33];
+    schnorr_sign_pair sign;
+    for (int i = 0; i < 10000; ++i) {
+        generate_k_rfc6979(&k, &rng);
+        if (bn_is_zero(&k) || !bn_is_less(&k, &secp256k1.order)) {
+            continue;
+        }
+        bn_write_be(&k, kBytes);
+        if (!Secp256k1Comb::publicKey(DataView(kBytes, sizeof(kBytes)), true, commitment)) {
+            ecdsa_get_public_key33(&secp256k1, kBytes, commitment);
+        }
+        if (schnorr_sign_with_commitment(&secp256k1, key.bytes.data(), pubKey.bytes.data(), &k, commitment,
+                                         message.data(), static_cast<uint32_t>(message.size()), &sign) != 0) {
+            continue;
+        }
+        result.assign(sign.r, sign.r + sizeof(sign.r));
+        result.insert(result.end(), sign.s, sign.s + sizeof(sign.s));
+        break;
+    }
+    memzero(&k, sizeof(k));
+    memzero(kBytes, sizeof(kBytes));
+    memzero(commitment, sizeof(commitment));
+    memzero(&rng, sizeof(rng));
+    memzero(&sign, sizeof(sign));
+    return result;
 }
 
-Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+Proto::SigningOutput SigningContext::sign(const Proto::SigningInput& input) const {
     auto output = Proto::SigningOutput();
     Address address;
-    const auto preImage = Signer::getPreImage(input, address);
-    const auto key = PrivateKey(Data(input.private_key().begin(), input.private_key().end()));
-    const auto pubKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
-    const auto signature = key.signSchnorr(preImage, TWCurveSECP256k1);
+    const auto preImage = this->preImage(input, address);
+    const auto signature = signSchnorr(preImage);
     const auto transaction = input.transaction();
 
     // build json
@@ -128,3 +206,23 @@ Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
 
     return output;
 }
+
+Data Signer::getPreImage(const Proto::SigningInput& input, Address& address) noexcept {
+    const auto context = SigningContext(DataView(reinterpret_cast<const byte*>(input.private_key().data()), input.private_key().size()));
+    return context.preImage(input, address);
+}
+
+Proto::SigningOutput Signer::sign(const Proto::SigningInput& input) noexcept {
+    const auto context = SigningContext(DataView(reinterpret_cast<const byte*>(input.private_key().data()), input.private_key().size()));
+    return context.sign(input);
+}
+
+std::vector<Proto::SigningOutput> Signer::signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount) {
+    return signInRuns<Proto::SigningOutput>(inputs, threadCount, SamePrivateKey(), [&](size_t begin, size_t end, auto& outputs) {
+        const auto& key = inputs[begin].private_key();
+        const SigningContext context(DataView(reinterpret_cast<const byte*>(key.data()), key.size()));
+        for (auto i = begin; i < end; ++i) {
+            outputs[i] = context.sign(inputs[i]);
+        }
+    });
+}
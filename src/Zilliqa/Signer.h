@@ -9,10 +9,44 @@
 #include "Address.h"
 #include "../Data.h"
 #include "../PrivateKey.h"
+#include "../PublicKey.h"
 #include "../proto/Zilliqa.pb.h"
 
+#include <TrezorCrypto/rfc6979.h>
+
+#include <vector>
+
 namespace TW::Zilliqa {
 
+/// Signing state of one sender key, computed once to sign many transactions: the public key, the
+/// key-dependent part of the nonce generator, and the sender field of the preimage.
+class SigningContext {
+  public:
+    /// @throws std::invalid_argument if the private key is invalid.
+    explicit SigningContext(DataView privateKey);
+    ~SigningContext();
+    SigningContext(const SigningContext&) = delete;
+    SigningContext& operator=(const SigningContext&) = delete;
+
+    const PublicKey& publicKey() const { return pubKey; }
+
+    /// Same as Signer::getPreImage(), for an input signed with this key.
+    Data preImage(const Proto::SigningInput& input, Address& address) const;
+
+    /// Same as PrivateKey::signSchnorr(message, TWCurveSECP256k1).
+    Data signSchnorr(const Data& message) const;
+
+    /// Same as Signer::sign(), for an input signed with this key.
+    Proto::SigningOutput sign(const Proto::SigningInput& input) const;
+
+  private:
+    PrivateKey key;
+    PublicKey pubKey;
+    rfc6979_key_state keyState;
+    /// Encoded senderpubkey field of the preimage
+    Data senderField;
+};
+
 /// Helper class that performs Zilliqa transaction signing.
 class Signer {
   public:
@@ -21,6 +55,10 @@ class Signer {
     /// Signs the given signing input
     static Proto::SigningOutput sign(const Proto::SigningInput& input) noexcept;
 
+    /// Signs many transactions as sign() does, with signInRuns() (threads, invalid keys). A SigningContext
+    /// is shared by each run of inputs with the same private key, as in withdrawals from one account.
+    static std::vector<Proto::SigningOutput> signBatch(const std::vector<Proto::SigningInput>& inputs, size_t threadCount = 0);
+
     /// compute preImage and decode address from signing input.
     static Data getPreImage(const Proto::SigningInput& input, Address& address) noexcept;
 };
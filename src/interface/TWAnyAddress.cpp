@@ -6,7 +6,6 @@
 
 #include <TrustWalletCore/TWAnyAddress.h>
 #include <TrustWalletCore/TWPublicKey.h>
-#include <TrezorCrypto/cash_addr.h>
 
 #include "../Bitcoin/Address.h"
 #include "../Bitcoin/CashAddress.h"
@@ -31,8 +30,14 @@ using namespace TW;
 struct TWAnyAddress {
     TWString* address;
     enum TWCoinType coin;
+    /// Decoded when the address was parsed, for coins that support it, see TW::parseAddress
+    Data data;
+    bool hasData = false;
 };
 
+/// Decodes the data of an address, for coins that don't provide it when parsing.
+static Data addressData(enum TWCoinType coin, const std::string& string);
+
 bool TWAnyAddressEqual(struct TWAnyAddress* _Nonnull lhs, struct TWAnyAddress* _Nonnull rhs) {
     return TWStringEqual(lhs->address, rhs->address) && lhs->coin == rhs->coin;
 }
@@ -42,12 +47,28 @@ bool TWAnyAddressIsValid(TWString* _Nonnull string, enum TWCoinType coin) {
     return TW::validateAddress(coin, address);
 }
 
+TWData* _Nonnull TWAnyAddressValidateAddresses(TWString* _Nonnull addresses, enum TWCoinType coin) {
+    const auto& string = *reinterpret_cast<const std::string*>(addresses);
+    std::vector<std::string> list;
+    for (size_t begin = 0; !string.empty() && begin <= string.size();) {
+        auto end = string.find('\n', begin);
+        if (end == std::string::npos) {
+            end = string.size();
+        }
+        list.emplace_back(string, begin, end - begin);
+        begin = end + 1;
+    }
+    const auto valid = TW::validateAddresses(coin, list);
+    const auto result = Data(valid.begin(), valid.end());
+    return TWDataCreateWithBytes(result.data(), result.size());
+}
+
 struct TWAnyAddress* _Nullable TWAnyAddressCreateWithString(TWString* _Nonnull string,
                                                             enum TWCoinType coin) {
     const auto& address = *reinterpret_cast<const std::string*>(string);
-    auto normalized = TW::normalizeAddress(coin, address);
-    if (normalized.empty()) { return nullptr; }
-    return new TWAnyAddress{TWStringCreateWithUTF8Bytes(normalized.c_str()), coin};
+    auto parsed = TW::parseAddress(coin, address);
+    if (!parsed || parsed->normalized.empty()) { return nullptr; }
+    return new TWAnyAddress{TWStringCreateWithUTF8Bytes(parsed->normalized.c_str()), coin, std::move(parsed->data), parsed->hasData};
 }
 
 struct TWAnyAddress* _Nonnull TWAnyAddressCreateWithPublicKey(
@@ -70,9 +91,18 @@ enum TWCoinType TWAnyAddressCoin(struct TWAnyAddress* _Nonnull address) {
 }
 
 TWData* _Nonnull TWAnyAddressData(struct TWAnyAddress* _Nonnull address) {
-    auto& string = *reinterpret_cast<const std::string*>(address->address);
+    if (address->hasData) {
+        return TWDataCreateWithBytes(address->data.data(), address->data.size());
+    }
+    const auto data = addressData(address->coin, *reinterpret_cast<const std::string*>(address->address));
+    return TWDataCreateWithBytes(data.data(), data.size());
+}
+
+static Data addressData(enum TWCoinType coin, const std::string& string) {
     Data data;
-    switch (address->coin) {
+    // blockchains left out of the build (TW_COINS option) have no address data
+    switch (coin) {
+#ifndef TW_EXCLUDE_COSMOS
     case TWCoinTypeBinance:
     case TWCoinTypeCosmos:
     case TWCoinTypeKava:
@@ -88,6 +118,7 @@ TWData* _Nonnull TWAnyAddressData(struct TWAnyAddress* _Nonnull address) {
         data = addr.getKeyHash();
         break;
     }
+#endif
 
     case TWCoinTypeBitcoin:
     case TWCoinTypeDigiByte:
@@ -103,11 +134,8 @@ TWData* _Nonnull TWAnyAddressData(struct TWAnyAddress* _Nonnull address) {
     }
 
     case TWCoinTypeBitcoinCash: {
-        auto addr = Bitcoin::CashAddress(string);
-        data.resize(Bitcoin::Address::size);
-        size_t outlen = 0;
-        cash_data_to_addr(data.data(), &outlen, addr.bytes.data(), 34);
-        data = Data(data.begin() + 1, data.end());
+        const auto payload = Bitcoin::CashAddress(string).payload();
+        data = Data(payload.begin() + 1, payload.end());
         break;
     }
 
@@ -152,12 +180,15 @@ TWData* _Nonnull TWAnyAddressData(struct TWAnyAddress* _Nonnull address) {
         data = parse_hex(string);
         break;
 
+#ifndef TW_EXCLUDE_NANO
     case TWCoinTypeNano: {
         auto addr = Nano::Address(string);
         data = Data(addr.bytes.begin(), addr.bytes.end());
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_ZILLIQA
     case TWCoinTypeZilliqa: {
         Zilliqa::Address addr;
         if (!Zilliqa::Address::decode(string, addr)) {
@@ -168,31 +199,41 @@ TWData* _Nonnull TWAnyAddressData(struct TWAnyAddress* _Nonnull address) {
         data = Data(str.begin(), str.end());
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_KUSAMA
     case TWCoinTypeKusama: {
         auto addr = Kusama::Address(string);
         data = Data(addr.bytes.begin() + 1, addr.bytes.end());
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_POLKADOT
     case TWCoinTypePolkadot: {
         auto addr = Polkadot::Address(string);
         data = Data(addr.bytes.begin() + 1, addr.bytes.end());
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_CARDANO
     case TWCoinTypeCardano: {
         auto addr = Cardano::AddressV3(string);
         data = addr.data();
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_NEO
     case TWCoinTypeNEO: {
         auto addr = NEO::Address(string);
         data = Data(addr.bytes.begin(), addr.bytes.end());
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_ELROND
     case TWCoinTypeElrond: {
         Elrond::Address addr;
         if (Elrond::Address::decode(string, addr)) {
@@ -201,14 +242,17 @@ TWData* _Nonnull TWAnyAddressData(struct TWAnyAddress* _Nonnull address) {
         
         break;
     }
+#endif
 
+#ifndef TW_EXCLUDE_NEAR
     case TWCoinTypeNEAR: {
         auto addr = NEAR::Address(string);
         data = Data(addr.bytes.begin(), addr.bytes.end());
         break;
     }
+#endif
 
     default: break;
     }
-    return TWDataCreateWithBytes(data.data(), data.size());
+    return data;
 }
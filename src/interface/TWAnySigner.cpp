@@ -7,9 +7,18 @@
 #include <TrustWalletCore/TWAnySigner.h>
 
 #include "Coin.h"
+#include "SigningOutputFields.h"
+
+#include <algorithm>
+#include <vector>
 
 using namespace TW;
 
+struct TWAnySignerBatch {
+    std::vector<std::pair<TWCoinType, Data>> inputs;
+    std::vector<BatchSigningResult> results;
+};
+
 TWData* _Nonnull TWAnySignerSign(TWData* _Nonnull data, enum TWCoinType coin) {
     const Data& dataIn = *(reinterpret_cast<const Data*>(data));
     Data dataOut;
@@ -17,6 +26,16 @@ TWData* _Nonnull TWAnySignerSign(TWData* _Nonnull data, enum TWCoinType coin) {
     return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
 }
 
+TWData* _Nonnull TWAnySignerSignWithFields(TWData* _Nonnull data, enum TWCoinType coin, uint32_t fields) {
+    const Data& dataIn = *(reinterpret_cast<const Data*>(data));
+    Data dataOut;
+    {
+        ScopedSigningOutputFields scope(fields);
+        TW::anyCoinSign(coin, dataIn, dataOut);
+    }
+    return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+}
+
 TWString *_Nonnull TWAnySignerSignJSON(TWString *_Nonnull json, TWData *_Nonnull key, enum TWCoinType coin) {
     const Data& keyData = *(reinterpret_cast<const Data*>(key));
     const std::string& jsonString = *(reinterpret_cast<const std::string*>(json));
@@ -33,3 +52,93 @@ TWData* _Nonnull TWAnySignerPlan(TWData* _Nonnull data, enum TWCoinType coin) {
     TW::anyCoinPlan(coin, dataIn, dataOut);
     return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
 }
+
+TWData* _Nonnull TWAnySignerPreImageHashes(TWData* _Nonnull data, enum TWCoinType coin) {
+    const Data& dataIn = *(reinterpret_cast<const Data*>(data));
+    Data dataOut;
+    TW::anyCoinPreImageHashes(coin, dataIn, dataOut);
+    return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+}
+
+TWData* _Nonnull TWAnySignerCompileWithSignatures(TWData* _Nonnull data, TWData* _Nonnull signatures, enum TWCoinType coin) {
+    const Data& dataIn = *(reinterpret_cast<const Data*>(data));
+    const Data& signaturesIn = *(reinterpret_cast<const Data*>(signatures));
+    Data dataOut;
+    if (signaturesIn.size() % 64 != 0) {
+        return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+    }
+    std::vector<Data> split;
+    for (auto it = signaturesIn.begin(); it != signaturesIn.end(); it += 64) {
+        split.emplace_back(it, it + 64);
+    }
+    TW::anyCoinCompileWithSignatures(coin, dataIn, split, dataOut);
+    return TWDataCreateWithBytes(dataOut.data(), dataOut.size());
+}
+
+static size_t copyOutput(const Data& dataOut, uint8_t* _Nullable output, size_t outputCapacity) {
+    if (output != nullptr && dataOut.size() <= outputCapacity) {
+        std::copy(dataOut.begin(), dataOut.end(), output);
+    }
+    return dataOut.size();
+}
+
+size_t TWAnySignerSignBytes(const uint8_t* _Nonnull input, size_t inputSize, enum TWCoinType coin, uint8_t* _Nullable output, size_t outputCapacity) {
+    Data dataOut;
+    TW::anyCoinSign(coin, DataView(input, inputSize), dataOut);
+    return copyOutput(dataOut, output, outputCapacity);
+}
+
+size_t TWAnySignerPlanBytes(const uint8_t* _Nonnull input, size_t inputSize, enum TWCoinType coin, uint8_t* _Nullable output, size_t outputCapacity) {
+    Data dataOut;
+    TW::anyCoinPlan(coin, DataView(input, inputSize), dataOut);
+    return copyOutput(dataOut, output, outputCapacity);
+}
+
+struct TWAnySignerBatch* _Nonnull TWAnySignerBatchCreate() {
+    return new TWAnySignerBatch{};
+}
+
+void TWAnySignerBatchDelete(struct TWAnySignerBatch* _Nonnull batch) {
+    delete batch;
+}
+
+int TWAnySignerBatchAdd(struct TWAnySignerBatch* _Nonnull batch, TWData* _Nonnull input, enum TWCoinType coin) {
+    const Data& dataIn = *(reinterpret_cast<const Data*>(input));
+    batch->inputs.emplace_back(coin, dataIn);
+    return static_cast<int>(batch->inputs.size() - 1);
+}
+
+int TWAnySignerBatchAddBytes(struct TWAnySignerBatch* _Nonnull batch, const uint8_t* _Nonnull input, size_t inputSize, enum TWCoinType coin) {
+    batch->inputs.emplace_back(coin, Data(input, input + inputSize));
+    return static_cast<int>(batch->inputs.size() - 1);
+}
+
+int TWAnySignerBatchSize(struct TWAnySignerBatch* _Nonnull batch) {
+    return static_cast<int>(batch->inputs.size());
+}
+
+void TWAnySignerSignBatch(struct TWAnySignerBatch* _Nonnull batch, uint32_t threadCount) {
+    batch->results = TW::anyCoinSignBatch(batch->inputs, threadCount);
+}
+
+TWData* _Nonnull TWAnySignerBatchOutput(struct TWAnySignerBatch* _Nonnull batch, int index) {
+    if (index < 0 || static_cast<size_t>(index) >= batch->results.size()) {
+        return TWDataCreateWithSize(0);
+    }
+    const auto& output = batch->results[index].output;
+    return TWDataCreateWithBytes(output.data(), output.size());
+}
+
+size_t TWAnySignerBatchOutputBytes(struct TWAnySignerBatch* _Nonnull batch, int index, uint8_t* _Nullable output, size_t outputCapacity) {
+    if (index < 0 || static_cast<size_t>(index) >= batch->results.size()) {
+        return 0;
+    }
+    return copyOutput(batch->results[index].output, output, outputCapacity);
+}
+
+enum TWAnySignerBatchError TWAnySignerBatchGetError(struct TWAnySignerBatch* _Nonnull batch, int index) {
+    if (index < 0 || static_cast<size_t>(index) >= batch->results.size()) {
+        return TWAnySignerBatchErrorSigningFailed;
+    }
+    return batch->results[index].error;
+}
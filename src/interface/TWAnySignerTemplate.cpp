@@ -0,0 +1,45 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWAnySignerTemplate.h>
+
+#include "Coin.h"
+#include "SigningTemplate.h"
+
+#include <memory>
+
+using namespace TW;
+
+struct TWAnySignerTemplate {
+    std::unique_ptr<SigningTemplate> impl;
+};
+
+struct TWAnySignerTemplate* _Nullable TWAnySignerTemplateCreate(TWData* _Nonnull input, enum TWCoinType coin) {
+    const Data& dataIn = *(reinterpret_cast<const Data*>(input));
+    auto impl = anyCoinSigningTemplate(coin, dataIn);
+    if (impl == nullptr) {
+        return nullptr;
+    }
+    return new TWAnySignerTemplate{std::move(impl)};
+}
+
+void TWAnySignerTemplateDelete(struct TWAnySignerTemplate* _Nonnull signerTemplate) {
+    delete signerTemplate;
+}
+
+TWData* _Nonnull TWAnySignerTemplateSign(struct TWAnySignerTemplate* _Nonnull signerTemplate, uint64_t nonce, TWString* _Nonnull toAddress, TWData* _Nonnull amount) {
+    const auto patch = SigningPatch{
+        nonce,
+        *reinterpret_cast<const std::string*>(toAddress),
+        *reinterpret_cast<const Data*>(amount),
+    };
+    try {
+        const auto output = signerTemplate->impl->sign(patch);
+        return TWDataCreateWithBytes(output.data(), output.size());
+    } catch (const std::exception&) {
+        return TWDataCreateWithSize(0);
+    }
+}
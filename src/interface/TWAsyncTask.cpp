@@ -0,0 +1,158 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWAsyncTask.h>
+
+#include "../Async.h"
+#include "../Coin.h"
+#include "../Keystore/StoredKey.h"
+
+#include <TrezorCrypto/memzero.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+using namespace TW;
+
+struct TWAsyncTask {
+    std::mutex mutex;
+    std::condition_variable changed;
+    TWAsyncTaskStatus status = TWAsyncTaskStatusPending;
+    Data result;
+    std::atomic<bool> cancelled{false};
+    TWAsyncTaskCallback callback = nullptr;
+    void* context = nullptr;
+    bool deleted = false;
+    bool inCallback = false;
+    std::thread::id callbackThread;
+    // reference held for the caller, released by TWAsyncTaskDelete; the queued job holds another one
+    std::shared_ptr<TWAsyncTask> self;
+
+    ~TWAsyncTask() { memzero(result.data(), result.size()); }
+};
+
+static void run(TWAsyncTask& task, const std::function<Data()>& work) {
+    auto status = TWAsyncTaskStatusCompleted;
+    Data result;
+    if (task.cancelled) {
+        status = TWAsyncTaskStatusCancelled;
+    } else {
+        try {
+            ScopedCancellation scope(task.cancelled);
+            result = work();
+        } catch (const Cancelled&) {
+            status = TWAsyncTaskStatusCancelled;
+        } catch (...) {
+            status = TWAsyncTaskStatusFailed;
+        }
+    }
+
+    TWAsyncTaskCallback callback = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(task.mutex);
+        task.result = std::move(result);
+        task.status = status;
+        if (!task.deleted && task.callback != nullptr) {
+            callback = task.callback;
+            task.inCallback = true;
+            task.callbackThread = std::this_thread::get_id();
+        }
+    }
+    task.changed.notify_all();
+    if (callback != nullptr) {
+        callback(task.context, &task);
+        {
+            std::lock_guard<std::mutex> lock(task.mutex);
+            task.inCallback = false;
+        }
+        task.changed.notify_all();
+    }
+}
+
+static TWAsyncTask* _Nonnull submit(std::function<Data()> work, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto task = std::make_shared<TWAsyncTask>();
+    task->callback = callback;
+    task->context = context;
+    task->self = task;
+    WorkerPool::shared().submit([task, work = std::move(work)]() { run(*task, work); });
+    return task.get();
+}
+
+struct TWAsyncTask* _Nonnull TWAnySignerSignAsync(TWData* _Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto dataIn = *reinterpret_cast<const Data*>(input);
+    return submit([dataIn = std::move(dataIn), coin]() {
+        Data dataOut;
+        anyCoinSign(coin, dataIn, dataOut);
+        return dataOut;
+    }, callback, context);
+}
+
+struct TWAsyncTask* _Nonnull TWAnySignerPlanAsync(TWData* _Nonnull input, enum TWCoinType coin, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto dataIn = *reinterpret_cast<const Data*>(input);
+    return submit([dataIn = std::move(dataIn), coin]() {
+        Data dataOut;
+        anyCoinPlan(coin, dataIn, dataOut);
+        return dataOut;
+    }, callback, context);
+}
+
+static TWAsyncTask* _Nonnull decryptAsync(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    auto payload = std::make_shared<Keystore::EncryptionParameters>(key->impl.payload);
+    auto passwordData = std::make_shared<Data>(*reinterpret_cast<const Data*>(password));
+    return submit([payload, passwordData]() {
+        auto data = payload->decrypt(*passwordData);
+        memzero(passwordData->data(), passwordData->size());
+        return data;
+    }, callback, context);
+}
+
+struct TWAsyncTask* _Nonnull TWStoredKeyDecryptPrivateKeyAsync(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    return decryptAsync(key, password, callback, context);
+}
+
+struct TWAsyncTask* _Nonnull TWStoredKeyDecryptMnemonicAsync(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWAsyncTaskCallback _Nullable callback, void* _Nullable context) {
+    return decryptAsync(key, password, callback, context);
+}
+
+enum TWAsyncTaskStatus TWAsyncTaskGetStatus(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    return task->status;
+}
+
+enum TWAsyncTaskStatus TWAsyncTaskWait(struct TWAsyncTask* _Nonnull task) {
+    std::unique_lock<std::mutex> lock(task->mutex);
+    task->changed.wait(lock, [task] { return task->status != TWAsyncTaskStatusPending; });
+    return task->status;
+}
+
+void TWAsyncTaskCancel(struct TWAsyncTask* _Nonnull task) {
+    task->cancelled = true;
+}
+
+TWData* _Nullable TWAsyncTaskResult(struct TWAsyncTask* _Nonnull task) {
+    std::lock_guard<std::mutex> lock(task->mutex);
+    if (task->status != TWAsyncTaskStatusCompleted) {
+        return nullptr;
+    }
+    return TWDataCreateWithBytes(task->result.data(), task->result.size());
+}
+
+void TWAsyncTaskDelete(struct TWAsyncTask* _Nonnull task) {
+    std::shared_ptr<TWAsyncTask> self;
+    {
+        std::unique_lock<std::mutex> lock(task->mutex);
+        // before cancelling, so that the cancellation can't invoke the callback
+        task->deleted = true;
+        task->cancelled = true;
+        // a callback running on another thread may still be using its context
+        task->changed.wait(lock, [task] { return !task->inCallback || task->callbackThread == std::this_thread::get_id(); });
+        self = std::move(task->self);
+    }
+}
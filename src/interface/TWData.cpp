@@ -35,8 +35,8 @@ TWData* TWDataCreateWithHexString(const TWString* hex) {
     if (hex == nullptr) {
         return nullptr;
     }
-    Data data = parse_hex(std::string(TWStringUTF8Bytes(hex)));
-    return TWDataCreateWithBytes(data.data(), data.size());
+    const auto& string = *reinterpret_cast<const std::string*>(hex);
+    return new Data(parse_hex(string));
 }
 
 size_t TWDataSize(TWData *_Nonnull data) {
@@ -211,6 +211,21 @@ int TWEthereumAbiFunctionAddParamArray(struct TWEthereumAbiFunction *_Nonnull fu
     return idx;    
 }
 
+int TWEthereumAbiFunctionAddParamArrayFromBuffer(struct TWEthereumAbiFunction *_Nonnull func_in, TWString *_Nonnull elementType, TWData *_Nonnull elements, bool isOutput) {
+    assert(func_in != nullptr);
+    Function& function = func_in->impl;
+
+    const auto type = std::string(TWStringUTF8Bytes(elementType));
+    const auto& data = *static_cast<const Data*>(elements);
+    const auto size = ParamPackedArray::elementSize(type);
+    if (size == 0 || data.size() % size != 0) {
+        return -1;
+    }
+    auto param = std::make_shared<ParamPackedArray>(type, data);
+    auto idx = function.addParam(param, isOutput);
+    return idx;
+}
+
 ///// GetParam
 
 uint8_t TWEthereumAbiFunctionGetParamUInt8(struct TWEthereumAbiFunction *_Nonnull func_in, int idx, bool isOutput) {
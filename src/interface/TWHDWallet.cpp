@@ -9,6 +9,7 @@
 #include "../Coin.h"
 #include "../HDWallet.h"
 #include "../Mnemonic.h"
+#include "../SeedCache.h"
 
 using namespace TW;
 
@@ -29,6 +30,10 @@ struct TWHDWallet *_Nonnull TWHDWalletCreateWithData(TWData *_Nonnull data, TWSt
     return new TWHDWallet{ HDWallet(*d, TWStringUTF8Bytes(passphrase)) };
 }
 
+void TWHDWalletSetSeedCacheCapacity(uint32_t capacity) {
+    SeedCache::shared().setCapacity(capacity);
+}
+
 void TWHDWalletDelete(struct TWHDWallet *wallet) {
     delete wallet;
 }
@@ -68,6 +73,23 @@ struct TWPrivateKey *_Nonnull TWHDWalletGetDerivedKey(struct TWHDWallet *_Nonnul
     return new TWPrivateKey{ wallet->impl.getKey(coin, derivationPath) };
 }
 
+TWString *_Nonnull TWHDWalletDeriveAddresses(struct TWHDWallet *_Nonnull wallet, enum TWCoinType coin, uint32_t account, uint32_t change, uint32_t firstIndex, uint32_t count) {
+    std::vector<std::string> addresses;
+    try {
+        addresses = wallet->impl.deriveAddresses(coin, account, change, firstIndex, count);
+    } catch (const std::invalid_argument&) {
+        // indices out of the non-hardened range
+    }
+    std::string joined;
+    for (const auto& address : addresses) {
+        if (!joined.empty()) {
+            joined += '\n';
+        }
+        joined += address;
+    }
+    return TWStringCreateWithUTF8Bytes(joined.c_str());
+}
+
 TWString *_Nonnull TWHDWalletGetExtendedPrivateKey(struct TWHDWallet *wallet, TWPurpose purpose, TWCoinType coin, TWHDVersion version) {
     return new std::string(wallet->impl.getExtendedPrivateKey(purpose, coin, version));
 }
@@ -76,6 +98,18 @@ TWString *_Nonnull TWHDWalletGetExtendedPublicKey(struct TWHDWallet *wallet, TWP
     return new std::string(wallet->impl.getExtendedPublicKey(purpose, coin, version));
 }
 
+TWString *_Nonnull TWHDWalletGetExtendedPublicKeys(struct TWHDWallet *_Nonnull wallet, const enum TWCoinType *_Nonnull coins, size_t count) {
+    const auto extended = wallet->impl.getExtendedPublicKeys(std::vector<TWCoinType>(coins, coins + count));
+    std::string joined;
+    for (size_t i = 0; i < extended.size(); ++i) {
+        if (i > 0) {
+            joined += '\n';
+        }
+        joined += extended[i];
+    }
+    return new std::string(joined);
+}
+
 TWPublicKey *TWHDWalletGetPublicKeyFromExtended(TWString *_Nonnull extended, enum TWCoinType coin, TWString *_Nonnull derivationPath) {
     const auto derivationPathObject = DerivationPath(*reinterpret_cast<const std::string*>(derivationPath));
     auto publicKey = HDWallet::getPublicKeyFromExtended(*reinterpret_cast<const std::string*>(extended), coin, derivationPathObject);
@@ -0,0 +1,18 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWInstrumentation.h>
+
+#include "../Instrumentation.h"
+
+std::atomic<TWInstrumentationSink> TW::Instrumentation::sink(nullptr);
+std::atomic<void*> TW::Instrumentation::sinkContext(nullptr);
+
+void TWInstrumentationSetSink(TWInstrumentationSink _Nullable sink, void* _Nullable context) {
+    // the context is published before the sink, so that a reader seeing the new sink sees its context
+    TW::Instrumentation::sinkContext.store(context, std::memory_order_relaxed);
+    TW::Instrumentation::sink.store(sink, std::memory_order_release);
+}
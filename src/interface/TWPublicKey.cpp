@@ -8,11 +8,13 @@
 
 #include "../HexCoding.h"
 #include "../PublicKey.h"
+#include "../SignatureCache.h"
 
 #include <TrezorCrypto/ecdsa.h>
 #include <TrezorCrypto/secp256k1.h>
 
 using TW::PublicKey;
+using TW::SignatureCache;
 
 struct TWPublicKey *_Nullable TWPublicKeyCreateWithData(TWData *_Nonnull data, enum TWPublicKeyType type) {
     auto& d = *reinterpret_cast<const TW::Data *>(data);
@@ -77,3 +79,7 @@ struct TWPublicKey *_Nullable TWPublicKeyRecover(TWData *_Nonnull signature, TWD
         return nullptr;
     }
 }
+
+void TWPublicKeySetSignatureCacheCapacity(uint32_t capacity) {
+    SignatureCache::shared().setCapacity(capacity);
+}
@@ -0,0 +1,56 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWSignatureBatchVerifier.h>
+
+#include "../PublicKey.h"
+
+#include <cassert>
+#include <vector>
+
+using namespace TW;
+
+struct TWSignatureBatchVerifier {
+    std::vector<PublicKey> publicKeys;
+    std::vector<Data> messages;
+    std::vector<Data> signatures;
+    std::vector<bool> valid;
+};
+
+struct TWSignatureBatchVerifier *_Nonnull TWSignatureBatchVerifierCreate(void) {
+    return new TWSignatureBatchVerifier{};
+}
+
+void TWSignatureBatchVerifierDelete(struct TWSignatureBatchVerifier *_Nonnull verifier) {
+    assert(verifier != nullptr);
+    delete verifier;
+}
+
+int TWSignatureBatchVerifierAdd(struct TWSignatureBatchVerifier *_Nonnull verifier, struct TWPublicKey *_Nonnull publicKey, TWData *_Nonnull signature, TWData *_Nonnull message) {
+    assert(verifier != nullptr);
+    verifier->publicKeys.push_back(publicKey->impl);
+    verifier->signatures.emplace_back(TWDataBytes(signature), TWDataBytes(signature) + TWDataSize(signature));
+    verifier->messages.emplace_back(TWDataBytes(message), TWDataBytes(message) + TWDataSize(message));
+    return static_cast<int>(verifier->publicKeys.size() - 1);
+}
+
+int TWSignatureBatchVerifierSize(struct TWSignatureBatchVerifier *_Nonnull verifier) {
+    assert(verifier != nullptr);
+    return static_cast<int>(verifier->publicKeys.size());
+}
+
+bool TWSignatureBatchVerifierVerify(struct TWSignatureBatchVerifier *_Nonnull verifier) {
+    assert(verifier != nullptr);
+    return PublicKey::verifyBatch(verifier->publicKeys, verifier->messages, verifier->signatures, verifier->valid);
+}
+
+bool TWSignatureBatchVerifierIsValid(struct TWSignatureBatchVerifier *_Nonnull verifier, int index) {
+    assert(verifier != nullptr);
+    if (index < 0 || static_cast<size_t>(index) >= verifier->valid.size()) {
+        return false;
+    }
+    return verifier->valid[index];
+}
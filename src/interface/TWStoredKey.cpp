@@ -115,6 +115,17 @@ void TWStoredKeyAddAccount(struct TWStoredKey* _Nonnull key, TWString* _Nonnull
     key->impl.addAccount(addressString, coin, dp, extetndedPublicKeyString);
 }
 
+bool TWStoredKeyChangePassword(struct TWStoredKey* _Nonnull key, TWData* _Nonnull password, TWData* _Nonnull newPassword) {
+    const auto passwordData = TW::data(TWDataBytes(password), TWDataSize(password));
+    const auto newPasswordData = TW::data(TWDataBytes(newPassword), TWDataSize(newPassword));
+    try {
+        key->impl.changePassword(passwordData, newPasswordData);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 bool TWStoredKeyStore(struct TWStoredKey* _Nonnull key, TWString* _Nonnull path) {
     try {
         const auto& pathString = *reinterpret_cast<const std::string*>(path);
@@ -178,3 +189,21 @@ bool TWStoredKeyFixAddresses(struct TWStoredKey* _Nonnull key, TWData* _Nonnull
         return false;
     }
 }
+
+bool TWStoredKeyCalibrateScrypt(uint32_t targetMilliseconds, uint32_t maxMemoryKilobytes) {
+    try {
+        const auto params = ScryptParameters::calibrated(std::chrono::milliseconds(targetMilliseconds), std::size_t(maxMemoryKilobytes) * 1024);
+        EncryptionParameters::setDefaultKDFParams(params);
+        return true;
+    } catch (const std::invalid_argument&) {
+        return false;
+    }
+}
+
+void TWStoredKeyCalibratePBKDF2(uint32_t targetMilliseconds) {
+    EncryptionParameters::setDefaultKDFParams(PBKDF2Parameters::calibrated(std::chrono::milliseconds(targetMilliseconds)));
+}
+
+void TWStoredKeyResetKDFParameters() {
+    EncryptionParameters::setDefaultKDFParams(ScryptParameters());
+}
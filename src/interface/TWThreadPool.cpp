@@ -0,0 +1,49 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWThreadPool.h>
+
+#include "../ThreadPool.h"
+
+#include <functional>
+#include <vector>
+
+using namespace TW;
+
+void TWThreadPoolSetThreadCount(uint32_t threadCount) {
+    ThreadPool::shared().setThreadCount(threadCount);
+}
+
+uint32_t TWThreadPoolThreadCount(void) {
+    return static_cast<uint32_t>(ThreadPool::shared().size());
+}
+
+bool TWThreadPoolSetAffinity(const uint32_t* _Nullable cpus, size_t count) {
+    if (cpus == nullptr) {
+        count = 0;
+    }
+    return ThreadPool::shared().setAffinity(std::vector<unsigned>(cpus, cpus + count));
+}
+
+bool TWThreadPoolSetNumaNode(uint32_t node) {
+    return ThreadPool::shared().setNumaNode(node);
+}
+
+static void runTask(void* _Nonnull task) {
+    const auto function = static_cast<std::function<void()>*>(task);
+    (*function)();
+    delete function;
+}
+
+void TWThreadPoolSetExecutor(TWThreadPoolExecutor _Nullable executor, void* _Nullable context, uint32_t concurrency) {
+    if (executor == nullptr) {
+        ThreadPool::shared().setExecutor(nullptr, 0);
+        return;
+    }
+    ThreadPool::shared().setExecutor([executor, context](std::function<void()> task) {
+        executor(context, runTask, new std::function<void()>(std::move(task)));
+    }, concurrency);
+}
@@ -0,0 +1,19 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWWarmup.h>
+
+#include "../Warmup.h"
+
+using namespace TW;
+
+uint64_t TWWarmup(const enum TWCoinType* _Nullable coins, size_t count, uint32_t flags) {
+    if (coins == nullptr) {
+        count = 0;
+    }
+    const auto result = warmup(std::vector<TWCoinType>(coins, coins + count), flags);
+    return static_cast<uint64_t>(result.duration.count());
+}
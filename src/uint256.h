@@ -11,77 +11,342 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
 namespace TW {
 
 using int256_t = boost::multiprecision::int256_t;
 using uint256_t = boost::multiprecision::uint256_t;
 
+/// 256-bit unsigned integer stored in 4 64-bit limbs, least significant first.
+///
+/// Trivially copyable and usable in constant expressions; arithmetic wraps around modulo 2^256,
+/// like `uint256_t`.  Meant for hot paths (parsing, serialization, simple arithmetic), convert to
+/// `uint256_t` for anything else.
+class UInt256 {
+  public:
+    std::array<uint64_t, 4> limbs{};
+
+    constexpr UInt256() noexcept = default;
+    constexpr UInt256(uint64_t value) noexcept : limbs{value, 0, 0, 0} {}
+    constexpr explicit UInt256(const std::array<uint64_t, 4>& value) noexcept : limbs(value) {}
+
+    explicit UInt256(const uint256_t& value) noexcept {
+        using limb_type = boost::multiprecision::limb_type;
+        constexpr auto limbBits = sizeof(limb_type) * 8;
+        const auto& backend = value.backend();
+        const limb_type* source = backend.limbs();
+        for (size_t i = 0; i < backend.size(); ++i) {
+            const auto bit = i * limbBits;
+            limbs[bit / 64] |= static_cast<uint64_t>(source[i]) << (bit % 64);
+        }
+    }
+
+    explicit operator uint256_t() const noexcept {
+        using limb_type = boost::multiprecision::limb_type;
+        constexpr auto limbBits = sizeof(limb_type) * 8;
+        constexpr auto count = 256 / limbBits;
+        uint256_t result;
+        auto& backend = result.backend();
+        backend.resize(count, count);
+        limb_type* target = backend.limbs();
+        for (size_t i = 0; i < count; ++i) {
+            const auto bit = i * limbBits;
+            target[i] = static_cast<limb_type>(limbs[bit / 64] >> (bit % 64));
+        }
+        backend.normalize();
+        return result;
+    }
+
+    /// Loads a big-endian number, the rightmost 32 bytes are taken.
+    static UInt256 load(DataView data) noexcept {
+        if (data.size() > 32) {
+            data = data.subView(data.size() - 32, 32);
+        }
+        UInt256 result;
+        for (size_t i = 0; i < data.size(); ++i) {
+            const auto position = data.size() - 1 - i;
+            result.limbs[i / 8] |= static_cast<uint64_t>(data[position]) << (8 * (i % 8));
+        }
+        return result;
+    }
+
+    /// Writes the number as 32 big-endian bytes.
+    void store(byte* out) const noexcept {
+        for (size_t i = 0; i < 32; ++i) {
+            out[31 - i] = static_cast<byte>(limbs[i / 8] >> (8 * (i % 8)));
+        }
+    }
+
+    /// Returns the big-endian bytes without leading zeros, a single zero byte for 0.
+    Data store() const {
+        byte buffer[32];
+        store(buffer);
+        const auto length = byteLength();
+        return length == 0 ? Data{0} : Data(buffer + 32 - length, buffer + 32);
+    }
+
+    constexpr bool isZero() const noexcept { return (limbs[0] | limbs[1] | limbs[2] | limbs[3]) == 0; }
+
+    /// Number of significant bits, 0 for 0.
+    constexpr size_t bitLength() const noexcept {
+        for (size_t i = 4; i > 0; --i) {
+            auto limb = limbs[i - 1];
+            if (limb != 0) {
+                size_t bits = 0;
+                for (; limb != 0; limb >>= 1) {
+                    ++bits;
+                }
+                return (i - 1) * 64 + bits;
+            }
+        }
+        return 0;
+    }
+
+    /// Number of significant bytes, 0 for 0.
+    constexpr size_t byteLength() const noexcept { return (bitLength() + 7) / 8; }
+
+    /// Divides by `divisor` in place and returns the remainder.
+    constexpr uint32_t divmod(uint32_t divisor) noexcept {
+        uint64_t remainder = 0;
+        for (size_t i = 8; i > 0; --i) {
+            const auto shift = 32 * ((i - 1) % 2);
+            const auto current = (remainder << 32) | ((limbs[(i - 1) / 2] >> shift) & 0xffffffff);
+            const auto quotient = current / divisor;
+            remainder = current % divisor;
+            limbs[(i - 1) / 2] = (limbs[(i - 1) / 2] & ~(0xffffffffULL << shift)) | (quotient << shift);
+        }
+        return static_cast<uint32_t>(remainder);
+    }
+
+    /// Decimal representation.
+    std::string toString() const {
+        if (isZero()) {
+            return "0";
+        }
+        // 78 decimal digits at most, produced 9 at a time
+        char buffer[81];
+        size_t position = sizeof(buffer);
+        auto value = *this;
+        while (!value.isZero()) {
+            auto chunk = value.divmod(1000000000);
+            for (int i = 0; i < 9; ++i) {
+                buffer[--position] = static_cast<char>('0' + chunk % 10);
+                chunk /= 10;
+            }
+        }
+        while (buffer[position] == '0') {
+            ++position;
+        }
+        return std::string(buffer + position, buffer + sizeof(buffer));
+    }
+
+    constexpr UInt256& operator+=(const UInt256& other) noexcept {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const auto sum = limbs[i] + other.limbs[i];
+            const auto result = sum + carry;
+            carry = (sum < limbs[i]) | (result < sum);
+            limbs[i] = result;
+        }
+        return *this;
+    }
+
+    constexpr UInt256& operator-=(const UInt256& other) noexcept {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < 4; ++i) {
+            const auto difference = limbs[i] - other.limbs[i];
+            const auto result = difference - borrow;
+            borrow = (limbs[i] < other.limbs[i]) | (difference < borrow);
+            limbs[i] = result;
+        }
+        return *this;
+    }
+
+    constexpr UInt256& operator*=(const UInt256& other) noexcept {
+        UInt256 result;
+        for (size_t i = 0; i < 4; ++i) {
+            uint64_t carry = 0;
+            for (size_t j = 0; i + j < 4; ++j) {
+                uint64_t high = 0;
+                const auto low = multiply(limbs[i], other.limbs[j], high);
+                auto sum = result.limbs[i + j] + low;
+                high += sum < low;
+                sum += carry;
+                high += sum < carry;
+                result.limbs[i + j] = sum;
+                carry = high;
+            }
+        }
+        return *this = result;
+    }
+
+    constexpr UInt256& operator<<=(unsigned shift) noexcept {
+        if (shift >= 256) {
+            return *this = UInt256();
+        }
+        const auto words = shift / 64;
+        const auto bits = shift % 64;
+        for (size_t i = 4; i > 0; --i) {
+            const auto index = i - 1;
+            uint64_t value = 0;
+            if (index >= words) {
+                value = limbs[index - words] << bits;
+                if (bits != 0 && index > words) {
+                    value |= limbs[index - words - 1] >> (64 - bits);
+                }
+            }
+            limbs[index] = value;
+        }
+        return *this;
+    }
+
+    constexpr UInt256& operator>>=(unsigned shift) noexcept {
+        if (shift >= 256) {
+            return *this = UInt256();
+        }
+        const auto words = shift / 64;
+        const auto bits = shift % 64;
+        for (size_t index = 0; index < 4; ++index) {
+            uint64_t value = 0;
+            if (index + words < 4) {
+                value = limbs[index + words] >> bits;
+                if (bits != 0 && index + words + 1 < 4) {
+                    value |= limbs[index + words + 1] << (64 - bits);
+                }
+            }
+            limbs[index] = value;
+        }
+        return *this;
+    }
+
+    constexpr UInt256& operator&=(const UInt256& other) noexcept {
+        for (size_t i = 0; i < 4; ++i) {
+            limbs[i] &= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr UInt256& operator|=(const UInt256& other) noexcept {
+        for (size_t i = 0; i < 4; ++i) {
+            limbs[i] |= other.limbs[i];
+        }
+        return *this;
+    }
+
+    constexpr UInt256& operator^=(const UInt256& other) noexcept {
+        for (size_t i = 0; i < 4; ++i) {
+            limbs[i] ^= other.limbs[i];
+        }
+        return *this;
+    }
+
+    friend constexpr UInt256 operator+(UInt256 lhs, const UInt256& rhs) noexcept { return lhs += rhs; }
+    friend constexpr UInt256 operator-(UInt256 lhs, const UInt256& rhs) noexcept { return lhs -= rhs; }
+    friend constexpr UInt256 operator*(UInt256 lhs, const UInt256& rhs) noexcept { return lhs *= rhs; }
+    friend constexpr UInt256 operator<<(UInt256 lhs, unsigned shift) noexcept { return lhs <<= shift; }
+    friend constexpr UInt256 operator>>(UInt256 lhs, unsigned shift) noexcept { return lhs >>= shift; }
+    friend constexpr UInt256 operator&(UInt256 lhs, const UInt256& rhs) noexcept { return lhs &= rhs; }
+    friend constexpr UInt256 operator|(UInt256 lhs, const UInt256& rhs) noexcept { return lhs |= rhs; }
+    friend constexpr UInt256 operator^(UInt256 lhs, const UInt256& rhs) noexcept { return lhs ^= rhs; }
+    friend constexpr UInt256 operator~(UInt256 value) noexcept {
+        for (auto& limb : value.limbs) {
+            limb = ~limb;
+        }
+        return value;
+    }
+
+    friend constexpr bool operator==(const UInt256& lhs, const UInt256& rhs) noexcept {
+        return lhs.limbs[0] == rhs.limbs[0] && lhs.limbs[1] == rhs.limbs[1] &&
+               lhs.limbs[2] == rhs.limbs[2] && lhs.limbs[3] == rhs.limbs[3];
+    }
+    friend constexpr bool operator!=(const UInt256& lhs, const UInt256& rhs) noexcept { return !(lhs == rhs); }
+    friend constexpr bool operator<(const UInt256& lhs, const UInt256& rhs) noexcept {
+        for (size_t i = 4; i > 0; --i) {
+            if (lhs.limbs[i - 1] != rhs.limbs[i - 1]) {
+                return lhs.limbs[i - 1] < rhs.limbs[i - 1];
+            }
+        }
+        return false;
+    }
+    friend constexpr bool operator>(const UInt256& lhs, const UInt256& rhs) noexcept { return rhs < lhs; }
+    friend constexpr bool operator<=(const UInt256& lhs, const UInt256& rhs) noexcept { return !(rhs < lhs); }
+    friend constexpr bool operator>=(const UInt256& lhs, const UInt256& rhs) noexcept { return !(lhs < rhs); }
+
+  private:
+    /// Full 64x64-bit product, returns the low half.
+    static constexpr uint64_t multiply(uint64_t a, uint64_t b, uint64_t& high) noexcept {
+#if defined(__SIZEOF_INT128__)
+        const auto product = static_cast<unsigned __int128>(a) * b;
+        high = static_cast<uint64_t>(product >> 64);
+        return static_cast<uint64_t>(product);
+#else
+        const uint64_t a0 = a & 0xffffffff, a1 = a >> 32;
+        const uint64_t b0 = b & 0xffffffff, b1 = b >> 32;
+        const uint64_t p00 = a0 * b0, p01 = a0 * b1, p10 = a1 * b0, p11 = a1 * b1;
+        const uint64_t middle = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+        high = p11 + (p01 >> 32) + (p10 >> 32) + (middle >> 32);
+        return (middle << 32) | (p00 & 0xffffffff);
+#endif
+    }
+};
+
+static_assert(std::is_trivially_copyable<UInt256>::value, "UInt256 must be trivially copyable");
+static_assert(sizeof(UInt256) == 32, "UInt256 must be 4 limbs");
+
 /// Loads a `uint256_t` from a collection of bytes.
 /// The rightmost bytes are taken from data
 inline uint256_t load(const Data& data) {
-    using boost::multiprecision::cpp_int;
-    if (data.empty()) {
-        return uint256_t(0);
-    }
-    uint256_t result;
-    import_bits(result, data.begin(), data.end());
-    return result;
+    return static_cast<uint256_t>(UInt256::load(data));
+}
+
+/// Loads a `uint256_t` from a view of bytes, as above.
+inline uint256_t load(DataView data) {
+    return static_cast<uint256_t>(UInt256::load(data));
 }
 
 /// Loads a `uint256_t` from a collection of bytes.
 /// The leftmost offset bytes are skipped, and the next 32 bytes are taken.  At least 32 (+offset)
 /// bytes are needed.
 inline uint256_t loadWithOffset(const Data& data, size_t offset) {
-    using boost::multiprecision::cpp_int;
     if (data.empty() || (data.size() < (256 / 8 + offset))) {
         // not enough bytes in data
         return uint256_t(0);
     }
-    uint256_t result;
-    import_bits(result, data.begin() + offset, data.begin() + offset + 256 / 8);
-    return result;
+    return static_cast<uint256_t>(UInt256::load(DataView(data).subView(offset, 256 / 8)));
 }
 
 /// Loads a `uint256_t` from Protobuf bytes (which are wrongly represented as
 /// std::string).
 inline uint256_t load(const std::string& data) {
-    using boost::multiprecision::cpp_int;
-    if (data.empty()) {
-        return uint256_t(0);
-    }
-    uint256_t result;
-    import_bits(result, reinterpret_cast<const byte*>(data.data()),
-                reinterpret_cast<const byte*>(data.data() + data.size()));
-    return result;
+    return static_cast<uint256_t>(UInt256::load(DataView(reinterpret_cast<const byte*>(data.data()), data.size())));
 }
 
 /// Stores a `uint256_t` as a collection of bytes.
 inline Data store(const uint256_t& v) {
-    using boost::multiprecision::cpp_int;
-    Data bytes;
-    bytes.reserve(32);
-    export_bits(v, std::back_inserter(bytes), 8);
-    return bytes;
+    return UInt256(v).store();
 }
 
 // Append a uint256_t value as a big-endian byte array into the provided buffer, and limit
 // the array size by digit/8.
 inline void encode256BE(Data& data, const uint256_t& value, uint32_t digit) {
-    Data bytes = store(value);
-    Data buff(digit / 8);
-
-    for (int i = 0; i < (int)bytes.size(); ++i) {
-        int start = (int)buff.size() - (int)bytes.size() + i;
-        if (start >= 0) {
-            buff[start] = bytes[i];
-        }
+    byte bytes[32];
+    UInt256(value).store(bytes);
+    const size_t size = digit / 8;
+    if (size > sizeof(bytes)) {
+        data.insert(data.end(), size - sizeof(bytes), 0);
     }
-    data.insert(data.end(), buff.begin(), buff.end());
+    const auto taken = std::min(size, sizeof(bytes));
+    data.insert(data.end(), bytes + sizeof(bytes) - taken, bytes + sizeof(bytes));
 }
 
 /// Return string representation of uint256_t
 inline std::string toString(uint256_t value) {
-    return boost::lexical_cast<std::string>(value);
+    return UInt256(value).toString();
 }
 
 } // namespace TW
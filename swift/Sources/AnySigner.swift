@@ -20,12 +20,9 @@ public final class AnySigner {
         }
     }
 
+    /// Signs serialized input, borrowed instead of copied, into a preallocated output.
     public static func nativeSign(data: Data, coin: CoinType) -> Data {
-        let inputData = TWDataCreateWithNSData(data)
-        defer {
-            TWDataDelete(inputData)
-        }
-        return TWDataNSData(TWAnySignerSign(inputData, TWCoinType(rawValue: coin.rawValue)))
+        return callBytes(TWAnySignerSignBytes, data: data, coin: coin)
     }
 
     public static func supportsJSON(coin: CoinType) -> Bool {
@@ -50,11 +47,34 @@ public final class AnySigner {
         }
     }
 
+    /// Plans serialized input, borrowed instead of copied, into a preallocated output.
     public static func nativePlan(data: Data, coin: CoinType) -> Data {
-        let inputData = TWDataCreateWithNSData(data)
-        defer {
-            TWDataDelete(inputData)
+        return callBytes(TWAnySignerPlanBytes, data: data, coin: coin)
+    }
+
+    /// Initial size of outputs, larger than most of them so that they are signed once.
+    static let outputCapacity = 4096
+
+    private typealias BytesFunction = (UnsafePointer<UInt8>, Int, TWCoinType, UnsafeMutablePointer<UInt8>?, Int) -> Int
+
+    /// Calls a function of the `TWAnySigner...Bytes` kind, again with a large enough output if the first one is too small.
+    private static func callBytes(_ function: BytesFunction, data: Data, coin: CoinType) -> Data {
+        let coinType = TWCoinType(rawValue: coin.rawValue)
+        return withUnsafeBytePointer(data) { input in
+            var capacity = outputCapacity
+            var output = Data(count: capacity)
+            var size = output.withUnsafeMutableBytes { bytes in
+                function(input, data.count, coinType, bytes.bindMemory(to: UInt8.self).baseAddress, capacity)
+            }
+            if size > capacity {
+                capacity = size
+                output = Data(count: capacity)
+                size = output.withUnsafeMutableBytes { bytes in
+                    function(input, data.count, coinType, bytes.bindMemory(to: UInt8.self).baseAddress, capacity)
+                }
+            }
+            output.count = min(size, capacity)
+            return output
         }
-        return TWDataNSData(TWAnySignerPlan(inputData, TWCoinType(rawValue: coin.rawValue)))
     }
 }
@@ -0,0 +1,124 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+import Foundation
+
+/// Awaits a `TWAsyncTask`, running on the library's worker threads, without blocking the caller's thread.
+/// Cancelling the awaiting Swift task cancels the library task.
+@available(iOS 13.0, macOS 10.15, *)
+final class AsyncTask {
+    enum Error: Swift.Error {
+        case failed
+    }
+
+    typealias Start = (TWAsyncTaskCallback, UnsafeMutableRawPointer) -> OpaquePointer
+
+    private let lock = NSLock()
+    private var continuation: CheckedContinuation<Data, Swift.Error>?
+    /// The library task, until it completes and is deleted.
+    private var task: OpaquePointer?
+    private var finished = false
+    private var cancelled = false
+
+    /// Starts a library task with a completion callback and its context, and returns its result.
+    ///
+    /// - Throws: `AsyncTask.Error.failed` if the task failed, `CancellationError` if it was cancelled.
+    static func run(_ start: Start) async throws -> Data {
+        let awaited = AsyncTask()
+        return try await withTaskCancellationHandler {
+            try await withCheckedThrowingContinuation { continuation in
+                awaited.continuation = continuation
+                // released by the callback, which is always called since the task is only deleted from it
+                let context = Unmanaged.passRetained(awaited).toOpaque()
+                awaited.started(start({ context, task in
+                    Unmanaged<AsyncTask>.fromOpaque(context!).takeRetainedValue().completed(task)
+                }, context))
+            }
+        } onCancel: {
+            awaited.cancel()
+        }
+    }
+
+    private func started(_ task: OpaquePointer) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !finished else {
+            // already completed and deleted
+            return
+        }
+        self.task = task
+        if cancelled {
+            TWAsyncTaskCancel(task)
+        }
+    }
+
+    private func cancel() {
+        lock.lock()
+        defer { lock.unlock() }
+        cancelled = true
+        if let task = task {
+            TWAsyncTaskCancel(task)
+        }
+    }
+
+    private func completed(_ task: OpaquePointer) {
+        let result: Result<Data, Swift.Error>
+        switch TWAsyncTaskGetStatus(task) {
+        case TWAsyncTaskStatusCompleted:
+            result = .success(TWAsyncTaskResult(task).map(TWDataNSData) ?? Data())
+        case TWAsyncTaskStatusCancelled:
+            result = .failure(CancellationError())
+        default:
+            result = .failure(Error.failed)
+        }
+        lock.lock()
+        finished = true
+        self.task = nil
+        TWAsyncTaskDelete(task)
+        let continuation = self.continuation
+        self.continuation = nil
+        lock.unlock()
+        continuation?.resume(with: result)
+    }
+}
+
+@available(iOS 13.0, macOS 10.15, *)
+extension StoredKey {
+    /// Decrypts the private key on the library's worker threads, off the calling actor; see `decryptPrivateKey`.
+    /// The key derivation stops early when the awaiting task is cancelled.
+    ///
+    /// - Returns: decrypted private key, nil on a wrong password.
+    public func decryptPrivateKey(password: Data) async throws -> Data? {
+        return try await decrypt(TWStoredKeyDecryptPrivateKeyAsync, password: password)
+    }
+
+    /// Decrypts the mnemonic on the library's worker threads, off the calling actor; see `decryptMnemonic`.
+    ///
+    /// - Returns: decrypted mnemonic, nil on a wrong password.
+    public func decryptMnemonic(password: Data) async throws -> String? {
+        guard let data = try await decrypt(TWStoredKeyDecryptMnemonicAsync, password: password) else {
+            return nil
+        }
+        return String(data: data, encoding: .utf8)
+    }
+
+    private typealias DecryptFunction = (OpaquePointer, UnsafeRawPointer, TWAsyncTaskCallback?, UnsafeMutableRawPointer?) -> OpaquePointer
+
+    private func decrypt(_ function: DecryptFunction, password: Data) async throws -> Data? {
+        let passwordData = TWDataCreateWithNSData(password)
+        defer {
+            TWDataDelete(passwordData)
+        }
+        do {
+            // the password is copied when the task starts
+            return try await AsyncTask.run { callback, context in
+                function(rawValue, passwordData, callback, context)
+            }
+        } catch AsyncTask.Error.failed {
+            return nil
+        }
+    }
+}
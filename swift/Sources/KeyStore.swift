@@ -253,6 +253,24 @@ public final class KeyStore {
         return mnemonic
     }
 
+    /// Exports a wallet as private key data like `exportPrivateKey(wallet:password:)`, decrypting it off the calling actor.
+    @available(iOS 13.0, macOS 10.15, *)
+    public func exportPrivateKey(wallet: Wallet, password: String) async throws -> Data {
+        guard let key = try await wallet.key.decryptPrivateKey(password: Data(password.utf8)) else {
+            throw Error.invalidPassword
+        }
+        return key
+    }
+
+    /// Exports a wallet as a mnemonic phrase like `exportMnemonic(wallet:password:)`, decrypting it off the calling actor.
+    @available(iOS 13.0, macOS 10.15, *)
+    public func exportMnemonic(wallet: Wallet, password: String) async throws -> String {
+        guard let mnemonic = try await wallet.key.decryptMnemonic(password: Data(password.utf8)) else {
+            throw Error.invalidPassword
+        }
+        return mnemonic
+    }
+
     /// Updates the password of an existing account.
     ///
     /// - Parameters:
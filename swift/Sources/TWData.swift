@@ -8,7 +8,9 @@ import Foundation
 
 /// Converts a Data struct to TWData/UnsafeRawPointer caller must delete it after use.
 public func TWDataCreateWithNSData(_ data: Data) -> UnsafeRawPointer {
-    return TWDataCreateWithBytes([UInt8](data), data.count)
+    return withUnsafeBytePointer(data) { bytes in
+        TWDataCreateWithBytes(bytes, data.count)
+    }
 }
 
 /// Converts a TWData/UnsafeRawPointer (will be deleted within this call) to a Data struct.
@@ -18,3 +20,14 @@ public func TWDataNSData(_ data: UnsafeRawPointer) -> Data {
     }
     return Data(bytes: TWDataBytes(data), count: TWDataSize(data))
 }
+
+/// Calls `body` with a pointer to the bytes of a Data struct, borrowed instead of copied; the pointer is valid (and
+/// must not be read) when the data is empty.
+func withUnsafeBytePointer<Result>(_ data: Data, _ body: (UnsafePointer<UInt8>) throws -> Result) rethrows -> Result {
+    return try data.withUnsafeBytes { (bytes: UnsafeRawBufferPointer) in
+        guard let base = bytes.bindMemory(to: UInt8.self).baseAddress else {
+            return try withUnsafePointer(to: UInt8(0)) { try body($0) }
+        }
+        return try body(base)
+    }
+}
@@ -296,6 +296,23 @@ class KeyStoreTests: XCTestCase {
         XCTAssertEqual(mnemonic, exported)
     }
 
+    @available(iOS 13.0, macOS 10.15, *)
+    func testExportAsync() async throws {
+        let keyStore = try KeyStore(keyDirectory: keyDirectory)
+        let wallet = try keyStore.import(mnemonic: mnemonic, name: "name", encryptPassword: "newPassword", coins: [.ethereum])
+        let exported = try await keyStore.exportMnemonic(wallet: wallet, password: "newPassword")
+        XCTAssertEqual(mnemonic, exported)
+
+        let privateKey = try await keyStore.exportPrivateKey(wallet: wallet, password: "newPassword")
+        XCTAssertEqual(privateKey, Data(mnemonic.utf8))
+
+        do {
+            _ = try await keyStore.exportMnemonic(wallet: wallet, password: "password")
+            XCTFail("Expected an invalid password")
+        } catch KeyStore.Error.invalidPassword {
+        }
+    }
+
     func testFileName() {
         let keyStore = try! KeyStore(keyDirectory: keyDirectory)
 
@@ -0,0 +1,97 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AddressFilter.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+
+namespace {
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+Data key(uint32_t i) {
+    Data result(20);
+    for (size_t j = 0; j < result.size(); ++j) {
+        result[j] = static_cast<byte>(i >> (8 * (j % 4))) ^ static_cast<byte>(j * 37);
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(AddressFilter, Keys) {
+    auto filter = AddressFilter(1000);
+    for (uint32_t i = 0; i < 1000; ++i) {
+        filter.insert(key(i));
+    }
+    EXPECT_EQ(filter.size(), 1000);
+    EXPECT_FALSE(filter.isFull());
+
+    // no false negatives, few false positives
+    size_t positives = 0;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        ASSERT_TRUE(filter.mayContain(key(i))) << i;
+    }
+    for (uint32_t i = 1000; i < 101000; ++i) {
+        positives += filter.mayContain(key(i));
+    }
+    EXPECT_LT(positives, 500);
+
+    filter.insert(key(0));
+    EXPECT_TRUE(filter.isFull());
+}
+
+TEST(AddressFilter, Addresses) {
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    auto filter = AddressFilter(64);
+    const auto bitcoin = wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0, 20);
+    const auto ethereum = wallet.deriveAddresses(TWCoinTypeEthereum, 0, 0, 0, 20);
+    filter.insert(TWCoinTypeBitcoin, bitcoin);
+    filter.insert(TWCoinTypeEthereum, ethereum);
+    EXPECT_FALSE(filter.insert(TWCoinTypeBitcoin, "invalid"));
+    EXPECT_TRUE(filter.insert(TWCoinTypeBitcoin, "1Cu32FVupVCgHkMMRJdYJugxwo2Aprgk7H"));
+    EXPECT_EQ(filter.size(), 41);
+
+    // outputs paying to the wallet
+    for (const auto& address : bitcoin) {
+        EXPECT_TRUE(filter.mayContain(Bitcoin::Script::lockScriptForAddress(address, TWCoinTypeBitcoin))) << address;
+    }
+    for (const auto& address : ethereum) {
+        EXPECT_TRUE(filter.mayContain(Ethereum::Address(address))) << address;
+    }
+    // a legacy address is keyed by its hash, as its script
+    const auto legacy = Bitcoin::Script::lockScriptForAddress("1Cu32FVupVCgHkMMRJdYJugxwo2Aprgk7H", TWCoinTypeBitcoin);
+    EXPECT_TRUE(filter.mayContain(legacy));
+    EXPECT_TRUE(filter.mayContain(parse_hex("8280b37df378db99f66f85c95a783a76ac7a6d59")));
+
+    EXPECT_FALSE(filter.mayContain(Bitcoin::Script(parse_hex("6a0568656c6c6f"))));
+    EXPECT_FALSE(filter.mayContain(Bitcoin::Script()));
+}
+
+TEST(AddressFilter, Serialize) {
+    auto filter = AddressFilter(100, 10);
+    for (uint32_t i = 0; i < 50; ++i) {
+        filter.insert(key(i));
+    }
+    const auto serialized = filter.serialize();
+    const auto restored = AddressFilter(serialized);
+    EXPECT_EQ(restored.size(), 50);
+    EXPECT_EQ(restored.capacity(), 100);
+    EXPECT_EQ(hex(restored.serialize()), hex(serialized));
+    for (uint32_t i = 0; i < 50; ++i) {
+        EXPECT_TRUE(restored.mayContain(key(i)));
+    }
+
+    EXPECT_THROW(AddressFilter(Data{}), std::invalid_argument);
+    EXPECT_THROW(AddressFilter(Data(serialized.begin(), serialized.end() - 1)), std::invalid_argument);
+    auto invalid = serialized;
+    invalid[0] ^= 1;
+    EXPECT_THROW(AddressFilter{invalid}, std::invalid_argument);
+}
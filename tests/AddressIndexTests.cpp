@@ -0,0 +1,123 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "AddressIndex.h"
+#include "HDWallet.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+using namespace TW;
+
+namespace {
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+} // namespace
+
+TEST(AddressIndex, Find) {
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    auto index = AddressIndex(wallet, 5);
+    index.track(TWCoinTypeBitcoin);
+    index.track(TWCoinTypeEthereum, 0, 0);
+    index.track(TWCoinTypeBitcoin, 0, 1);
+    EXPECT_EQ(index.size(), 15);
+    // tracked once
+    index.track(TWCoinTypeBitcoin);
+    EXPECT_EQ(index.size(), 15);
+
+    const auto location = index.find(TWCoinTypeBitcoin, "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85");
+    ASSERT_TRUE(location.has_value());
+    EXPECT_EQ(location->coin, TWCoinTypeBitcoin);
+    EXPECT_EQ(location->account, 0);
+    EXPECT_EQ(location->change, 0);
+    EXPECT_EQ(location->index, 0);
+
+    // normalized before lookup
+    const auto ethereum = index.find(TWCoinTypeEthereum, "0x27ef5cdbe01777d62438affeb695e33fc2335979");
+    ASSERT_TRUE(ethereum.has_value());
+    EXPECT_EQ(ethereum->coin, TWCoinTypeEthereum);
+    EXPECT_EQ(ethereum->index, 0);
+
+    for (const auto change : {0u, 1u}) {
+        const auto addresses = wallet.deriveAddresses(TWCoinTypeBitcoin, 0, change, 0, 6);
+        const auto locations = index.find(TWCoinTypeBitcoin, addresses);
+        ASSERT_EQ(locations.size(), addresses.size());
+        for (uint32_t i = 0; i < 5; ++i) {
+            ASSERT_TRUE(locations[i].has_value()) << i;
+            EXPECT_EQ(locations[i]->change, change);
+            EXPECT_EQ(locations[i]->index, i);
+        }
+        // beyond the gap limit
+        EXPECT_FALSE(locations[5].has_value());
+    }
+
+    EXPECT_FALSE(index.find(TWCoinTypeBitcoin, "invalid").has_value());
+    EXPECT_FALSE(index.find(TWCoinTypeLitecoin, "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85").has_value());
+    EXPECT_FALSE(index.find(TWCoinTypeBitcoin, "1Cu32FVupVCgHkMMRJdYJugxwo2Aprgk7H").has_value());
+}
+
+TEST(AddressIndex, GapLimit) {
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    auto index = AddressIndex(wallet, 20);
+    EXPECT_EQ(index.gapLimit(), 20);
+    index.track(TWCoinTypeBitcoin);
+    const auto addresses = wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0, 300);
+    EXPECT_FALSE(index.find(TWCoinTypeBitcoin, addresses[20]).has_value());
+
+    // past the initial capacity
+    for (uint32_t used = 0; used < 280; used += 10) {
+        index.markUsed({TWCoinTypeBitcoin, 0, 0, used});
+    }
+    EXPECT_EQ(index.size(), 291);
+    for (uint32_t i = 0; i < 291; ++i) {
+        const auto location = index.find(TWCoinTypeBitcoin, addresses[i]);
+        ASSERT_TRUE(location.has_value()) << i;
+        EXPECT_EQ(location->index, i);
+    }
+    EXPECT_FALSE(index.find(TWCoinTypeBitcoin, addresses[291]).has_value());
+
+    // earlier addresses don't shrink the window
+    index.markUsed({TWCoinTypeBitcoin, 0, 0, 3});
+    EXPECT_EQ(index.size(), 291);
+}
+
+TEST(AddressIndex, File) {
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    char path[] = "/tmp/AddressIndexTestsXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    const auto addresses = wallet.deriveAddresses(TWCoinTypeEthereum, 1, 0, 0, 16);
+    {
+        auto index = AddressIndex(wallet, 8, path);
+        index.track(TWCoinTypeEthereum, 1);
+        index.markUsed({TWCoinTypeEthereum, 1, 0, 7});
+        EXPECT_EQ(index.size(), 16);
+    }
+    {
+        // reused without deriving
+        auto index = AddressIndex(wallet, 8, path);
+        EXPECT_EQ(index.size(), 16);
+        const auto location = index.find(TWCoinTypeEthereum, addresses[15]);
+        ASSERT_TRUE(location.has_value());
+        EXPECT_EQ(location->account, 1);
+        EXPECT_EQ(location->index, 15);
+        index.track(TWCoinTypeEthereum, 1);
+        EXPECT_EQ(index.size(), 16);
+        index.markUsed({TWCoinTypeEthereum, 1, 0, 8});
+        EXPECT_EQ(index.size(), 17);
+    }
+    {
+        std::ofstream file(path, std::ios::trunc);
+        file << "not an index, but long enough to have a header, which is 64 bytes long..............";
+    }
+    EXPECT_THROW(AddressIndex(wallet, 8, path), std::runtime_error);
+    std::remove(path);
+}
@@ -24,3 +24,12 @@ TEST(AionRLP, EncodeLong) {
     EXPECT_EQ(hex(RLP::encodeLong(uint128_t(4295000060L))), "880000000100007ffc");
     EXPECT_EQ(hex(RLP::encodeLong(uint128_t(72057594037927935L))), "8800ffffffffffffff");
 }
+
+TEST(AionRLP, DecodeLong) {
+    for (const auto value : {uint128_t(1), uint128_t(21000), uint128_t(20000000000), uint128_t(72057594037927935L)}) {
+        const auto encoded = RLP::encodeLong(value);
+        EXPECT_EQ(RLP::decodeLong(Ethereum::RLPReader::parse(encoded)), value);
+    }
+    EXPECT_THROW(RLP::decodeLong(Ethereum::RLPReader::parse(parse_hex("c0"))), std::invalid_argument);
+    EXPECT_THROW(RLP::decodeLong(Ethereum::RLPReader::parse(parse_hex("89010000000000000000"))), std::invalid_argument);
+}
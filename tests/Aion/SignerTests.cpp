@@ -7,11 +7,14 @@
 #include "Aion/Signer.h"
 #include "Aion/Transaction.h"
 #include "HexCoding.h"
+#include "uint256.h"
+#include "BatchSigningHelper.h"
 
 #include <gtest/gtest.h>
 
 using namespace TW;
 using namespace TW::Aion;
+using boost::multiprecision::uint256_t;
 
 TEST(AionSigner, Sign) {
     auto address = Aion::Address("0xa082c3de528b7807dc27ad66debb16d4cfe4054209398cee619dd95955063d1e");
@@ -38,3 +41,27 @@ TEST(AionSigner, SignWithData) {
     // Raw transaction
     EXPECT_EQ(hex(transaction.encode()), "f8a109a0a082c3de528b7807dc27ad66debb16d4cfe4054209398cee619dd95955063d1e8227108641494f4e000085242019b04d8252088800000004a817c80001b860a775daa30b33fda3091768f0561c8042ee23cb48a6a3e5d7e8248b13d04a48a736fc2642c2d62900204779aa274dba3b8712eff7a8464aa78ea52b09ece20679fe3f5edf94c84a7e0c5f93213be891bc279af927086f455167f5bc73d3046c0d");
 }
+
+TEST(AionSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = Proto::SigningInput();
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "db33ffdf82c7ba903daf68d961d3c23c20471a8ce6b408e52d579fd8add80cc9"
+                                                                   : "4f3edf983ac636a65a842ce7c78d9aa706d3b113bce9c46f30d7d21715b23b1d");
+        input.set_private_key(privateKey.data(), privateKey.size());
+        input.set_to_address(i == 30 ? "0xa082" : "0xa082c3de528b7807dc27ad66debb16d4cfe4054209398cee619dd95955063d1e");
+        const auto nonce = store(uint256_t(i));
+        input.set_nonce(nonce.data(), nonce.size());
+        const auto gasPrice = store(uint256_t(20000000000));
+        input.set_gas_price(gasPrice.data(), gasPrice.size());
+        const auto gasLimit = store(uint256_t(21000));
+        input.set_gas_limit(gasLimit.data(), gasLimit.size());
+        const auto amount = store(uint256_t(10000 + i));
+        input.set_amount(amount.data(), amount.size());
+        input.set_timestamp(155157377101);
+        if (i % 7 == 0) {
+            input.set_payload("AION");
+        }
+        return input;
+    }, {30});
+}
@@ -9,6 +9,7 @@
 #include "Algorand/BinaryCoding.h"
 #include "HexCoding.h"
 #include "Base64.h"
+#include "Hash.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
 #include <gtest/gtest.h>
@@ -86,3 +87,88 @@ TEST(AlgorandSigner, Sign) {
     ASSERT_EQ(hex(signature), "de73363dbdeda0682adca06f6268a16a6ec47253c94d5692dc1c49a84a05847812cf66d7c4cf07c7e2f50f143ec365d405e30b35117b264a994626054d2af604");
     ASSERT_EQ(hex(result), "82a3736967c440de73363dbdeda0682adca06f6268a16a6ec47253c94d5692dc1c49a84a05847812cf66d7c4cf07c7e2f50f143ec365d405e30b35117b264a994626054d2af604a374786e89a3616d74cd034fa3666565ce000775e3a2667633a367656eac6d61696e6e65742d76312e30a26768c420c061c4d8fc1dbdded2d7604be4568e3f6d041987ac37bde4b620b5ab39248adfa26c763da3726376c420a089aa6922e3b998fadff6cd4808ddf9e021e4944e389ea3d5c638786689197ea3736e64c42074b000b6368551a6066d713e2866002e8dab34b69ede09a72e85a39bbb1f7928a474797065a3706179");
 }
+
+TEST(AlgorandSigner, Writer) {
+    constexpr auto key = Key("note");
+    static_assert(sizeof(key.encoded) == 5);
+    static_assert(isCanonical(Key("fv"), Key("gen"), Key("gh"), Key("grp")));
+    static_assert(!isCanonical(Key("rcv"), Key("note")));
+    static_assert(countNonEmpty(uint64_t(0), uint64_t(1), DataView()) == 1);
+
+    Data data;
+    Writer writer(data);
+    writer.mapHeader(3);
+    writer.field(key, DataView(parse_hex("0102")));
+    writer.field(Key("amt"), uint64_t(0));
+    writer.field(Key("fee"), uint64_t(1000));
+    writer.field(Key("gen"), std::string());
+    writer.arrayHeader(16);
+    EXPECT_EQ(hex(data), "83a46e6f7465c4020102a3666565cd03e8dc0010");
+
+    SizeCounter counter;
+    counter.mapHeader(3);
+    counter.field(key, DataView(parse_hex("0102")));
+    counter.field(Key("amt"), uint64_t(0));
+    counter.field(Key("fee"), uint64_t(1000));
+    counter.field(Key("gen"), std::string());
+    counter.arrayHeader(16);
+    EXPECT_EQ(counter.size, data.size());
+}
+
+TEST(AlgorandSigner, OmitEmpty) {
+    auto key = PrivateKey(parse_hex("c9d3cc16fecabe2747eab86b81528c6ed8b65efc1d6906d86aabc27187a1fe7c"));
+    auto from = Address(key.getPublicKey(TWPublicKeyTypeED25519));
+    auto to = Address("UCE2U2JC4O4ZR6W763GUQCG57HQCDZEUJY4J5I6VYY4HQZUJDF7AKZO5GM");
+    Data note;
+    std::string genesisId = "mainnet-v1.0";
+    auto genesisHash = Base64::decode("wGHE2Pwdvd7S12BL5FaOP20EGYesN73ktiC1qzkkit8=");
+    auto transaction = Transaction(from, to, 1000, 0, 51, 61, note, "pay", genesisId, genesisHash);
+
+    // zero amount is not encoded
+    const auto serialized = transaction.serialize();
+    EXPECT_EQ(hex(serialized), "88a3666565cd03e8a2667633a367656eac6d61696e6e65742d76312e30a26768c420c061c4d8fc1dbdded2d7604be4568e3f6d041987ac37bde4b620b5ab39248adfa26c763da3726376c420a089aa6922e3b998fadff6cd4808ddf9e021e4944e389ea3d5c638786689197ea3736e64c42074b000b6368551a6066d713e2866002e8dab34b69ede09a72e85a39bbb1f7928a474797065a3706179");
+    EXPECT_EQ(transaction.encodedSize(), serialized.size());
+}
+
+TEST(AlgorandSigner, SignGroup) {
+    auto key = PrivateKey(parse_hex("c9d3cc16fecabe2747eab86b81528c6ed8b65efc1d6906d86aabc27187a1fe7c"));
+    auto from = Address(key.getPublicKey(TWPublicKeyTypeED25519));
+    auto to = Address("UCE2U2JC4O4ZR6W763GUQCG57HQCDZEUJY4J5I6VYY4HQZUJDF7AKZO5GM");
+    Data note;
+    auto airdropNote = parse_hex("61697264726f70");
+    std::string genesisId = "mainnet-v1.0";
+    auto genesisHash = Base64::decode("wGHE2Pwdvd7S12BL5FaOP20EGYesN73ktiC1qzkkit8=");
+    auto transactions = std::vector<Transaction>{
+        Transaction(from, to, 1000, 847, 51, 61, note, "pay", genesisId, genesisHash),
+        Transaction(from, to, 1000, 1500, 51, 61, airdropNote, "pay", genesisId, genesisHash),
+    };
+
+    // group id hashes the transaction ids, computed without group
+    Data expectedList = parse_hex("544781a674786c69737492");
+    for (const auto& transaction : transactions) {
+        append(expectedList, parse_hex("c420"));
+        Data message = {'T', 'X'};
+        append(message, transaction.serialize());
+        EXPECT_EQ(hex(transaction.id()), hex(Hash::sha512_256(message)));
+        append(expectedList, transaction.id());
+    }
+    const auto group = Transaction::groupId(transactions);
+    EXPECT_EQ(hex(group), hex(Hash::sha512_256(expectedList)));
+
+    auto copies = transactions;
+    const auto result = Signer::signGroup(key, transactions);
+
+    Data expected;
+    for (auto& transaction : copies) {
+        transaction.group = group;
+        auto signature = Signer::sign(key, transaction);
+        append(expected, transaction.serialize(signature));
+    }
+    EXPECT_EQ(hex(result), hex(expected));
+    EXPECT_EQ(hex(transactions[1].group), hex(group));
+
+    // group field sits between genesis hash and last round
+    const auto serialized = hex(transactions[0].serialize());
+    EXPECT_EQ(serialized.substr(0, 2), "8a");
+    EXPECT_NE(serialized.find("39248adfa3677270c420" + hex(group) + "a26c763d"), std::string::npos);
+}
@@ -0,0 +1,157 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Allocations.h"
+#include "Base58.h"
+#include "Coin.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "uint256.h"
+#include "proto/Ethereum.pb.h"
+
+#include <TrustWalletCore/TWInstrumentation.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace TW {
+
+namespace {
+
+// Budgets of the allocations of hot calls, with some margin over their current counts: a change going over one
+// adds allocations to every call, and should either be reworked or raise the budget knowingly.
+// Run with a library built with TW_ALLOCATION_TRACKING, skipped otherwise.
+
+Data ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+/// Allocations of the second call of `function`, the first one initializing what it needs once.
+template <typename Function>
+uint64_t allocations(Function&& function) {
+    function();
+    const auto scope = Allocations::Scope();
+    function();
+    return scope.count();
+}
+
+} // namespace
+
+TEST(AllocationBudget, AnyCoinSign) {
+    if (!Allocations::enabled()) {
+        GTEST_SKIP() << "built without TW_ALLOCATION_TRACKING";
+    }
+    const auto input = ethereumInput();
+    EXPECT_LE(allocations([&] {
+                  Data output;
+                  anyCoinSign(TWCoinTypeEthereum, input, output);
+              }),
+              40ul);
+}
+
+TEST(AllocationBudget, DeriveAddress) {
+    if (!Allocations::enabled()) {
+        GTEST_SKIP() << "built without TW_ALLOCATION_TRACKING";
+    }
+    const auto key = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    EXPECT_LE(allocations([&] { return deriveAddress(TWCoinTypeBitcoin, publicKey); }), 24ul);
+    const auto extended = key.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+    EXPECT_LE(allocations([&] { return deriveAddress(TWCoinTypeEthereum, extended); }), 8ul);
+}
+
+TEST(AllocationBudget, HDWalletGetKey) {
+    if (!Allocations::enabled()) {
+        GTEST_SKIP() << "built without TW_ALLOCATION_TRACKING";
+    }
+    const auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "");
+    const auto path = DerivationPath("m/84'/0'/0'/0/0");
+    EXPECT_LE(allocations([&] { return wallet.getKey(TWCoinTypeBitcoin, path); }), 4ul);
+}
+
+TEST(AllocationBudget, Encoders) {
+    if (!Allocations::enabled()) {
+        GTEST_SKIP() << "built without TW_ALLOCATION_TRACKING";
+    }
+    const auto data = parse_hex("00769bdff96a02f9135a1d19b749db6a78fe07dc90a1b2c3d4");
+    EXPECT_LE(allocations([&] { return Base58::bitcoin.encode(data); }), 1ul);
+    const auto encoded = Base58::bitcoin.encode(data);
+    EXPECT_LE(allocations([&] { return Base58::bitcoin.decode(encoded); }), 2ul);
+    EXPECT_LE(allocations([&] { return hex(data); }), 1ul);
+}
+
+TEST(AllocationBudget, Scope) {
+    if (!Allocations::enabled()) {
+        GTEST_SKIP() << "built without TW_ALLOCATION_TRACKING";
+    }
+    // the counts are read before the expectations, which allocate
+    uint64_t innerCount, innerBytes, innerPeak, outerCount, outerPeak;
+    {
+        const auto outer = Allocations::Scope();
+        {
+            const auto inner = Allocations::Scope();
+            auto* first = ::operator new(1000);
+            ::operator delete(first);
+            auto* second = ::operator new(600);
+            innerCount = inner.count();
+            innerBytes = inner.bytes();
+            innerPeak = inner.peak();
+            ::operator delete(second);
+        }
+        outerCount = outer.count();
+        outerPeak = outer.peak();
+    }
+    EXPECT_EQ(innerCount, 2ul);
+    EXPECT_EQ(innerBytes, 1600ul);
+    // the first block was freed before the second one
+    EXPECT_EQ(innerPeak, 1000ul);
+    EXPECT_EQ(outerCount, 2ul);
+    EXPECT_EQ(outerPeak, 1000ul);
+}
+
+TEST(AllocationBudget, Sink) {
+    if (!Allocations::enabled()) {
+        GTEST_SKIP() << "built without TW_ALLOCATION_TRACKING";
+    }
+    static std::mutex mutex;
+    static std::map<std::string, uint64_t> counters;
+    TWInstrumentationSetSink(
+        [](void*, const char* operation, uint64_t, uint64_t count) {
+            const auto lock = std::lock_guard<std::mutex>(mutex);
+            counters[operation] += count;
+        },
+        nullptr);
+    const auto input = ethereumInput();
+    Data output;
+    anyCoinSign(TWCoinTypeEthereum, input, output);
+    TWInstrumentationSetSink(nullptr, nullptr);
+
+    const auto lock = std::lock_guard<std::mutex>(mutex);
+    EXPECT_EQ(counters.count("anyCoinSign"), 1ul);
+    EXPECT_GT(counters["anyCoinSign.allocations"], 0ul);
+    EXPECT_GE(counters["anyCoinSign.bytes"], counters["anyCoinSign.peak"]);
+}
+
+} // namespace TW
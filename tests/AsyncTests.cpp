@@ -0,0 +1,64 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Async.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <stdexcept>
+
+using namespace TW;
+
+TEST(WorkerPool, RunsAllJobs) {
+    std::atomic<int> count{0};
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    {
+        WorkerPool pool(3);
+        EXPECT_EQ(pool.size(), 3ul);
+        for (auto i = 0; i < 100; ++i) {
+            pool.submit([&] {
+                ++count;
+                std::lock_guard<std::mutex> lock(mutex);
+                threads.insert(std::this_thread::get_id());
+            });
+        }
+        // exceptions don't stop the workers
+        pool.submit([] { throw std::runtime_error("job"); });
+        pool.submit([&] { ++count; });
+    }
+    EXPECT_EQ(count, 101);
+    EXPECT_LE(threads.size(), 3ul);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0ul);
+}
+
+TEST(WorkerPool, DefaultSize) {
+    EXPECT_GE(WorkerPool().size(), 1ul);
+    EXPECT_GE(WorkerPool::shared().size(), 1ul);
+}
+
+TEST(ScopedCancellation, Nesting) {
+    EXPECT_EQ(ScopedCancellation::current(), nullptr);
+    EXPECT_NO_THROW(ScopedCancellation::check());
+    std::atomic<bool> outer{false};
+    std::atomic<bool> inner{true};
+    {
+        ScopedCancellation outerScope(outer);
+        EXPECT_EQ(ScopedCancellation::current(), &outer);
+        EXPECT_NO_THROW(ScopedCancellation::check());
+        {
+            ScopedCancellation innerScope(inner);
+            EXPECT_EQ(ScopedCancellation::current(), &inner);
+            EXPECT_THROW(ScopedCancellation::check(), Cancelled);
+        }
+        EXPECT_EQ(ScopedCancellation::current(), &outer);
+        // other threads are not affected
+        std::thread([] { EXPECT_EQ(ScopedCancellation::current(), nullptr); }).join();
+    }
+    EXPECT_EQ(ScopedCancellation::current(), nullptr);
+}
@@ -0,0 +1,116 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Base58.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+
+namespace TW {
+
+/// Byte-by-byte reference encoder.
+static std::string referenceEncode(const Data& data) {
+    size_t zeroes = 0;
+    while (zeroes < data.size() && data[zeroes] == 0) {
+        ++zeroes;
+    }
+    Data b58;
+    for (size_t i = zeroes; i < data.size(); ++i) {
+        int carry = data[i];
+        for (auto it = b58.rbegin(); it != b58.rend(); ++it) {
+            carry += 256 * (*it);
+            *it = carry % 58;
+            carry /= 58;
+        }
+        while (carry != 0) {
+            b58.insert(b58.begin(), carry % 58);
+            carry /= 58;
+        }
+    }
+    std::string str(zeroes, '1');
+    for (auto digit : b58) {
+        str += Base58::bitcoin.digits[digit];
+    }
+    return str;
+}
+
+TEST(Base58, EncodeDecode) {
+    EXPECT_EQ(Base58::bitcoin.encode(Data()), "");
+    EXPECT_EQ(Base58::bitcoin.encode(Data{0, 0, 0}), "111");
+    EXPECT_EQ(Base58::bitcoin.encode(parse_hex("61")), "2g");
+    EXPECT_EQ(Base58::bitcoin.encode(parse_hex("00769bdff96a02f9135a1d19b749db6a78fe07dc90c3507da5")), "1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    EXPECT_EQ(Base58::ripple.encode(parse_hex("00769bdff96a02f9135a1d19b749db6a78fe07dc90c3507da5")), "rBF97rogVswrhEMvKbRJm1fcty1ohZhTcx");
+
+    EXPECT_EQ(hex(Base58::bitcoin.decode("")), "");
+    EXPECT_EQ(hex(Base58::bitcoin.decode("111")), "000000");
+    EXPECT_EQ(hex(Base58::bitcoin.decode(" 2g ")), "61");
+    EXPECT_EQ(hex(Base58::bitcoin.decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx")), "00769bdff96a02f9135a1d19b749db6a78fe07dc90c3507da5");
+    EXPECT_EQ(hex(Base58::bitcoin.decode("2g 2g")), "");
+    EXPECT_EQ(hex(Base58::bitcoin.decode("0OIl")), "");
+    EXPECT_EQ(hex(Base58::bitcoin.decode("2\xc3\xa9")), "");
+}
+
+TEST(Base58, RoundTrip) {
+    std::mt19937 random(58);
+    for (size_t size = 0; size <= 140; ++size) {
+        for (size_t zeroes = 0; zeroes <= std::min<size_t>(size, 2); ++zeroes) {
+            Data data(size);
+            for (size_t i = zeroes; i < size; ++i) {
+                data[i] = static_cast<byte>(random());
+            }
+            if (zeroes < size && data[zeroes] == 0) {
+                data[zeroes] = 1;
+            }
+            const auto encoded = Base58::bitcoin.encode(data);
+            ASSERT_EQ(encoded, referenceEncode(data)) << size;
+            ASSERT_EQ(hex(Base58::bitcoin.decode(encoded)), hex(data)) << size;
+
+            Data decoded(size);
+            ASSERT_TRUE(Base58::bitcoin.decode(encoded.data(), encoded.data() + encoded.size(), decoded.data(), size)) << size;
+            ASSERT_EQ(hex(decoded), hex(data)) << size;
+
+            const auto checked = Base58::bitcoin.encodeCheck(data);
+            ASSERT_EQ(hex(Base58::bitcoin.decodeCheck(checked)), hex(data)) << size;
+            ASSERT_TRUE(Base58::bitcoin.decodeCheck(checked.data(), checked.data() + checked.size(), decoded.data(), size)) << size;
+            ASSERT_EQ(hex(decoded), hex(data)) << size;
+        }
+    }
+}
+
+TEST(Base58, DecodeFixedSize) {
+    std::array<byte, 25> address;
+    EXPECT_TRUE(Base58::bitcoin.decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", address));
+    EXPECT_EQ(hex(address), "00769bdff96a02f9135a1d19b749db6a78fe07dc90c3507da5");
+
+    std::array<byte, 21> payload;
+    EXPECT_TRUE(Base58::bitcoin.decodeCheck("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", payload));
+    EXPECT_EQ(hex(payload), "00769bdff96a02f9135a1d19b749db6a78fe07dc90");
+    // wrong checksum
+    EXPECT_FALSE(Base58::bitcoin.decodeCheck("1Bp9U1ogV3A14FMvKbRJms7ctyso5FdSz2", payload));
+    // invalid character
+    EXPECT_FALSE(Base58::bitcoin.decodeCheck("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tc0", payload));
+
+    // size mismatch
+    std::array<byte, 24> shorter;
+    std::array<byte, 26> longer;
+    std::array<byte, 32> solana;
+    EXPECT_FALSE(Base58::bitcoin.decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", shorter));
+    EXPECT_FALSE(Base58::bitcoin.decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", longer));
+    EXPECT_FALSE(Base58::bitcoin.decode("11Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", address));
+    EXPECT_FALSE(Base58::bitcoin.decode("Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", address));
+    EXPECT_FALSE(Base58::bitcoin.decode("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", solana));
+
+    EXPECT_TRUE(Base58::bitcoin.decode("2gPihUTjt3FJqf1VpidgrY5cZ6PuyMccGVwQHRfjMPZG", solana));
+    EXPECT_EQ(hex(solana), "18f306dfe699d2085c897b43a4c54fc47d2bb755675be8a7498368830065d6e7");
+    std::array<byte, 0> empty;
+    EXPECT_TRUE(Base58::bitcoin.decode("", empty));
+    EXPECT_FALSE(Base58::bitcoin.decode("1", empty));
+}
+
+} // namespace TW
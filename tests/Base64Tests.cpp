@@ -61,3 +61,90 @@ TEST(Base64, UrlFormat) {
     decoded = decodeBase64Url("EQA_qoVWKJl17JkayZlN-2E6vsTqAA1QlOY3kID1lOVZszC4");
     EXPECT_EQ(const1, hex(decoded));
 }
+
+namespace {
+
+/// Encodes 6 bits at a time, for comparison.
+std::string referenceEncode(const Data& data, const char* characters) {
+    std::string result;
+    for (size_t bit = 0; bit < data.size() * 8; bit += 6) {
+        uint32_t value = 0;
+        for (size_t i = bit; i < bit + 6; ++i) {
+            const auto set = i < data.size() * 8 && (data[i / 8] >> (7 - i % 8)) & 1;
+            value = (value << 1) | set;
+        }
+        result.push_back(characters[value]);
+    }
+    while (result.size() % 4 != 0) {
+        result.push_back('=');
+    }
+    return result;
+}
+
+} // namespace
+
+TEST(Base64, Lengths) {
+    const auto standard = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    const auto url = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+    // past the vector blocks, with every 6-bit value
+    for (size_t size = 0; size <= 100; ++size) {
+        Data data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<byte>(i * 71 + size);
+        }
+        const auto encoded = encode(data);
+        ASSERT_EQ(encoded, referenceEncode(data, standard)) << size;
+        ASSERT_EQ(hex(decode(encoded)), hex(data)) << size;
+        const auto encodedUrl = encodeBase64Url(data);
+        ASSERT_EQ(encodedUrl, referenceEncode(data, url)) << size;
+        ASSERT_EQ(hex(decodeBase64Url(encodedUrl)), hex(data)) << size;
+        ASSERT_EQ(hex(decodeBase64Url(encoded)), hex(data)) << size;
+    }
+}
+
+TEST(Base64, Padding) {
+    // optional
+    EXPECT_EQ(hex(decode("QQ")), "41");
+    EXPECT_EQ(hex(decode("QQ=")), "41");
+    EXPECT_EQ(hex(decode("QUI")), "4142");
+    EXPECT_EQ(hex(decode("QUJDRA")), "41424344");
+    // zero bytes are kept
+    EXPECT_EQ(hex(decode("AA==")), "00");
+    EXPECT_EQ(hex(decode("QUJDAA==")), "41424300");
+    EXPECT_EQ(hex(decode("AAAAAAAAAAAAAAAAAAAAAA==")), "00000000000000000000000000000000");
+
+    EXPECT_THROW(decode("Q"), std::invalid_argument);
+    EXPECT_THROW(decode("QQ==="), std::invalid_argument);
+    EXPECT_THROW(decode("Q=Q="), std::invalid_argument);
+}
+
+TEST(Base64, InvalidCharacters) {
+    const std::string valid = "SGVsbG8sIHdvcmxkIQSGVsbG8sIHdvcmxkIQSGVsbG8sIHdvcmxkIQSGVsbG8sIHdvcmxkIQSGVsbG8sIHdvcmxkIQ==";
+    ASSERT_NO_THROW(decode(valid));
+    // in a vector block, then in the tail
+    for (const auto position : {size_t(3), size_t(40), size_t(85)}) {
+        for (const auto c : {' ', '\n', '-', '_', '.', '\0', '\x80', '\xff'}) {
+            auto invalid = valid;
+            invalid[position] = c;
+            EXPECT_THROW(decode(invalid), std::invalid_argument) << position << " " << int(c);
+        }
+        auto url = valid;
+        url[position] = '-';
+        EXPECT_NO_THROW(decodeBase64Url(url));
+        url[position] = '.';
+        EXPECT_THROW(decodeBase64Url(url), std::invalid_argument);
+    }
+}
+
+TEST(Base64, IntoBuffer) {
+    const auto data = parse_hex("11003faa8556289975ec991ac9994dfb613abec4ea000d5094e6379080f594e559b330b8");
+    std::string encoded(encodedSize(data.size()), '\0');
+    encode(data.data(), data.size(), encoded.data(), Alphabet::Url);
+    EXPECT_EQ(encoded, "EQA_qoVWKJl17JkayZlN-2E6vsTqAA1QlOY3kID1lOVZszC4");
+
+    Data decoded(decodedSize(encoded.size()));
+    EXPECT_EQ(decode(encoded.data(), encoded.size(), decoded.data(), Alphabet::Url), std::ptrdiff_t(data.size()));
+    EXPECT_EQ(hex(decoded), hex(data));
+    EXPECT_EQ(decode(encoded.data(), encoded.size(), decoded.data(), Alphabet::Standard), -1);
+    EXPECT_EQ(decode(encoded.data(), encoded.size(), decoded.data(), Alphabet::Any), std::ptrdiff_t(data.size()));
+}
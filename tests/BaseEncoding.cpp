@@ -70,3 +70,34 @@ TEST(Base32, DecodeInvalid) {
     ASSERT_FALSE(decode("A", decoded)); // invalid odd length
     ASSERT_FALSE(decode("ABC", decoded)); // invalid odd length
 }
+
+TEST(Base32, Lengths) {
+    // checked against the 5 bits at a time of trezor-crypto
+    for (size_t size = 0; size <= 100; ++size) {
+        Data data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<byte>(i * 71 + size);
+        }
+        char expected[200];
+        ASSERT_NE(base32_encode(data.data(), data.size(), expected, sizeof(expected), BASE32_ALPHABET_RFC4648), nullptr);
+        const auto encoded = encode(data);
+        ASSERT_EQ(encoded, std::string(expected)) << size;
+
+        Data decoded;
+        ASSERT_TRUE(decode(encoded, decoded)) << size;
+        ASSERT_EQ(hex(decoded), hex(data)) << size;
+    }
+}
+
+TEST(Base32, DecodeCase) {
+    Data decoded;
+    ASSERT_TRUE(decode("aebag", decoded));
+    EXPECT_EQ(hex(decoded), "010203");
+
+    // custom alphabets are case sensitive
+    const char* BASE32_ALPHABET_NIMIQ = "0123456789ABCDEFGHJKLMNPQRSTUVXY";
+    ASSERT_TRUE(decode("04106", decoded, BASE32_ALPHABET_NIMIQ));
+    EXPECT_EQ(hex(decoded), "010203");
+    EXPECT_FALSE(decode("0410g", decoded, BASE32_ALPHABET_NIMIQ));
+    EXPECT_FALSE(decode("0410Z", decoded, BASE32_ALPHABET_NIMIQ));
+}
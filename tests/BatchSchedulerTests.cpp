@@ -0,0 +1,165 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BatchScheduler.h"
+#include "Coin.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+#include "uint256.h"
+#include "proto/Ethereum.pb.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+Data ethereumInput(uint64_t nonce) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonceData = store(uint256_t(nonce));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonceData.data(), nonceData.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+PrivateKey testKey(int i) {
+    auto bytes = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+    bytes[31] = byte(i);
+    return PrivateKey(bytes);
+}
+
+BatchScheduler::Options options(std::size_t maxBatchSize, std::chrono::microseconds maxDelay) {
+    BatchScheduler::Options options;
+    options.maxBatchSize = maxBatchSize;
+    options.maxDelay = maxDelay;
+    return options;
+}
+
+} // namespace
+
+TEST(BatchScheduler, Sign) {
+    auto scheduler = BatchScheduler(options(8, std::chrono::milliseconds(2)));
+    std::vector<std::future<BatchSigningResult>> results(20);
+    std::vector<std::thread> threads;
+    for (auto t = 0; t < 4; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto i = t; i < 20; i += 4) {
+                results[i] = scheduler.sign(TWCoinTypeEthereum, ethereumInput(i));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto unsupported = scheduler.sign(static_cast<TWCoinType>(1), parse_hex("0a0b0c"));
+
+    for (auto i = 0; i < 20; ++i) {
+        Data expected;
+        anyCoinSign(TWCoinTypeEthereum, ethereumInput(i), expected);
+        const auto result = results[i].get();
+        EXPECT_EQ(result.error, TWAnySignerBatchErrorNone);
+        EXPECT_EQ(hex(result.output), hex(expected)) << i;
+    }
+    EXPECT_EQ(unsupported.get().error, TWAnySignerBatchErrorUnsupportedCoin);
+}
+
+TEST(BatchScheduler, Verify) {
+    auto scheduler = BatchScheduler(options(16, std::chrono::milliseconds(2)));
+    const auto digest = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+    std::vector<std::future<bool>> results;
+    std::vector<bool> expected;
+    for (auto i = 0; i < 24; ++i) {
+        const auto key = testKey(i);
+        const auto curve = i % 2 == 0 ? TWCurveED25519 : TWCurveSECP256k1;
+        const auto publicKey = key.getPublicKey(i % 2 == 0 ? TWPublicKeyTypeED25519 : TWPublicKeyTypeSECP256k1);
+        auto signature = key.sign(digest, curve);
+        if (i % 5 == 3) {
+            signature[10] ^= 1;
+        }
+        expected.push_back(i % 5 != 3);
+        results.push_back(scheduler.verify(publicKey, signature, digest));
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].get(), expected[i]) << i;
+    }
+}
+
+TEST(BatchScheduler, DeriveAddress) {
+    auto scheduler = BatchScheduler(options(32, std::chrono::milliseconds(2)));
+    std::vector<std::future<std::string>> results;
+    std::vector<std::string> expected;
+    for (auto i = 0; i < 40; ++i) {
+        const auto coin = i % 3 == 0 ? TWCoinTypeEthereum : (i % 3 == 1 ? TWCoinTypeBitcoin : TWCoinTypeSolana);
+        results.push_back(scheduler.deriveAddress(coin, testKey(i)));
+        expected.push_back(TW::deriveAddress(coin, testKey(i)));
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        EXPECT_EQ(results[i].get(), expected[i]) << i;
+    }
+}
+
+TEST(BatchScheduler, FlushBySize) {
+    auto scheduler = BatchScheduler(options(4, std::chrono::hours(1)));
+    std::vector<std::future<std::string>> results;
+    for (auto i = 0; i < 5; ++i) {
+        results.push_back(scheduler.deriveAddress(TWCoinTypeEthereum, testKey(i)));
+    }
+    // the first four make a full batch, the last one waits for its deadline
+    for (auto i = 0; i < 4; ++i) {
+        EXPECT_EQ(results[i].get(), TW::deriveAddress(TWCoinTypeEthereum, testKey(i)));
+    }
+    EXPECT_EQ(scheduler.pending(), 1ul);
+    EXPECT_EQ(results[4].wait_for(std::chrono::milliseconds(20)), std::future_status::timeout);
+
+    scheduler.flush();
+    EXPECT_EQ(scheduler.pending(), 0ul);
+    EXPECT_EQ(results[4].get(), TW::deriveAddress(TWCoinTypeEthereum, testKey(4)));
+}
+
+TEST(BatchScheduler, FlushByDeadline) {
+    auto scheduler = BatchScheduler(options(1000, std::chrono::milliseconds(5)));
+    const auto start = BatchScheduler::Clock::now();
+    auto result = scheduler.deriveAddress(TWCoinTypeEthereum, testKey(1));
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_GE(BatchScheduler::Clock::now() - start, std::chrono::milliseconds(5));
+    EXPECT_EQ(result.get(), TW::deriveAddress(TWCoinTypeEthereum, testKey(1)));
+
+    // the timer waits again once the groups are empty
+    auto later = scheduler.deriveAddress(TWCoinTypeBitcoin, testKey(2));
+    EXPECT_EQ(later.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+}
+
+TEST(BatchScheduler, DestructorFlushes) {
+    std::future<bool> result;
+    {
+        auto scheduler = BatchScheduler(options(1000, std::chrono::hours(1)));
+        const auto key = testKey(3);
+        const auto digest = Data(32, 7);
+        result = scheduler.verify(key.getPublicKey(TWPublicKeyTypeED25519), key.sign(digest, TWCurveED25519), digest);
+    }
+    ASSERT_EQ(result.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+    EXPECT_TRUE(result.get());
+
+    EXPECT_THROW(BatchScheduler(options(0, std::chrono::milliseconds(1))), std::invalid_argument);
+}
+
+} // namespace TW
@@ -0,0 +1,54 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "HexCoding.h"
+#include "proto/Common.pb.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace TW {
+
+/// Private key of an input made for expectBatchSigning().
+enum class BatchKey { First, Second, Invalid };
+
+/// Checks that the signBatch() of a signer gives the outputs of its sign(), on 150 inputs made by
+/// `makeInput(index, key)`: a run of 100 inputs with the first key, across chunks, then inputs with the second
+/// key, except input 120 which has an invalid key and must get Error_missing_private_key.  The inputs that
+/// `makeInput` makes invalid otherwise are in `invalidInputs`, and must get Error_general.
+template <typename Signer, typename MakeInput>
+void expectBatchSigning(MakeInput makeInput, const std::set<std::size_t>& invalidInputs = {}) {
+    using Input = decltype(makeInput(std::size_t(0), BatchKey::First));
+    using Output = decltype(Signer::sign(Input()));
+
+    std::vector<Input> inputs;
+    for (std::size_t i = 0; i < 150; ++i) {
+        inputs.push_back(makeInput(i, i == 120 ? BatchKey::Invalid : (i < 100 ? BatchKey::First : BatchKey::Second)));
+    }
+
+    const auto outputs = Signer::signBatch(inputs, 3);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        auto expected = Output();
+        if (i == 120) {
+            expected.set_error(Common::Proto::Error_missing_private_key);
+        } else if (invalidInputs.count(i) != 0) {
+            expected.set_error(Common::Proto::Error_general);
+        } else {
+            expected = Signer::sign(inputs[i]);
+            ASSERT_NE(expected.ByteSizeLong(), 0ul) << i;
+        }
+        EXPECT_EQ(hex(outputs[i].SerializeAsString()), hex(expected.SerializeAsString())) << i;
+    }
+    EXPECT_TRUE(Signer::signBatch({}).empty());
+}
+
+} // namespace TW
@@ -61,6 +61,18 @@ TEST(Bech32Address, Invalid) {
     ASSERT_FALSE(Bech32Address::isValid("xerd19nu5t7hszckwah5nlcadmk5rlchtugzplznskffpwecygcu0520s9tnyy0", "erd"));
 }
 
+TEST(Bech32Address, ValidMany) {
+    const auto valid = Bech32Address::isValid({
+        "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02",
+        "COSMOS1HSK6JRYYQJFHP5DHC55TC9JTCKYGX0EPH6DD02",
+        "cosmosvaloper1sxx9mszve0gaedz5ld7qdkjkfv8z992ax69k08", // other HRP
+        "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd03", // wrong checksum
+        "bnb1grpf0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2",
+        "cosmos1pqfpkkqd", // too short
+    }, "cosmos");
+    EXPECT_EQ(valid, std::vector<bool>({true, true, false, false, false, false}));
+}
+
 TEST(Bech32Address, InvalidWrongPrefix) {
     ASSERT_TRUE(Bech32Address::isValid("one1a50tun737ulcvwy0yvve0pvu5skq0kjargvhwe", "one"));
     ASSERT_FALSE(Bech32Address::isValid("one1a50tun737ulcvwy0yvve0pvu5skq0kjargvhwe", "two"));
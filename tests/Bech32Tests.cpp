@@ -118,3 +118,39 @@ TEST(Bech32, encodeM) {
         EXPECT_EQ(res, encodedLow);
     }
 }
+
+TEST(Bech32, encodeIntoBuffer) {
+    const auto values = parse_hex("080301090f051414170f04160200111d0314131b1c1b1e041a080d091f1a1f06");
+    ASSERT_EQ(Bech32::encodedSize("bnb", values), 42);
+
+    std::array<char, 42> buffer;
+    EXPECT_EQ(Bech32::encode("bnb", values, Bech32::ChecksumVariant::Bech32, buffer.data(), buffer.size() - 1), 0);
+    ASSERT_EQ(Bech32::encode("bnb", values, Bech32::ChecksumVariant::Bech32, buffer.data(), buffer.size()), 42);
+    EXPECT_EQ(std::string(buffer.begin(), buffer.end()), "bnb1grpf0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2");
+}
+
+TEST(Bech32, verifier) {
+    for (auto& td: testData) {
+        auto expectedVariant = td.isValid ? Bech32::ChecksumVariant::Bech32 : (td.isValidM ? Bech32::ChecksumVariant::Bech32M : Bech32::ChecksumVariant::None);
+        if (expectedVariant == Bech32::ChecksumVariant::None) {
+            continue;
+        }
+        const auto verifier = Bech32::Verifier(td.hrp);
+        Data values;
+        EXPECT_EQ(verifier.verify(td.encoded, &values), expectedVariant) << td.encoded;
+        EXPECT_EQ(hex(values), td.dataHex) << td.encoded;
+    }
+
+    const auto verifier = Bech32::Verifier("BNB");
+    EXPECT_EQ(verifier.hrp, "bnb");
+    const auto variants = verifier.verify({
+        "bnb1grpf0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2",
+        "BNB1GRPF0955H0YKZQ3AR5NMUM7Y6GDFL6LXFN46H2",
+        "bnb1grpf0955h0ykzq3ar6nmum7y6gdfl6lxfn46h2", // 1-char diff
+        "bnb1grPF0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2", // mixed case
+        "tbnb1grpf0955h0ykzq3ar5nmum7y6gdfl6lxfn46h2", // other HRP
+        "bnb1",
+        "",
+    });
+    EXPECT_EQ(variants, std::vector<Bech32::ChecksumVariant>({Bech32::Bech32, Bech32::Bech32, Bech32::None, Bech32::None, Bech32::None, Bech32::None, Bech32::None}));
+}
@@ -702,4 +702,50 @@ TEST(BinanceSigner, BuildTimeUnlockOrder) {
               "898f1b59137b3d8f1e00f842e409e18033b347180f2001");
 }
 
+TEST(BinanceSigner, SignBatch) {
+    auto input = Proto::SigningInput();
+    input.set_chain_id("chain-bnb");
+    input.set_account_number(19);
+    input.set_sequence(23);
+    input.set_memo("test");
+    input.set_source(1);
+    const auto key = parse_hex("95949f757db1f57ca94a5dff23314accbe7abee89597bf6a3c7382c84d7eb832");
+    input.set_private_key(key.data(), key.size());
+
+    auto& order = *input.mutable_send_order();
+    const auto fromKeyhash = parse_hex("40c2979694bbc961023d1d27be6fc4d21a9febe6");
+    const auto toKeyhash = parse_hex("88b37d5e05f3699e2a1406468e5d87cb9dcceb95");
+    auto orderInput = order.add_inputs();
+    orderInput->set_address(fromKeyhash.data(), fromKeyhash.size());
+    auto inputCoin = orderInput->add_coins();
+    inputCoin->set_denom("BNB");
+    auto orderOutput = order.add_outputs();
+    orderOutput->set_address(toKeyhash.data(), toKeyhash.size());
+    auto outputCoin = orderOutput->add_coins();
+    outputCoin->set_denom("BNB");
+
+    std::vector<Proto::SigningInput> inputs;
+    for (int i = 0; i < 6; ++i) {
+        input.set_sequence(23 + i);
+        inputCoin->set_amount(1'001'000'000 + i);
+        outputCoin->set_amount(1'001'000'000 + i);
+        inputs.push_back(input);
+    }
+    inputs[2].set_memo("");
+    inputs[2].set_source(0);
+    inputs[3].set_account_number(0);
+    inputs[3].set_sequence(0);
+    const auto otherKey = parse_hex("eeba3f6f2db26ced519a3d4c43afff101db957a21d54d25dc7fd235c404d7a5d");
+    inputs[4].set_private_key(otherKey.data(), otherKey.size());
+    inputs[5].set_private_key("");
+
+    const auto outputs = Signer::signBatch(inputs, 2);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (size_t i = 0; i < 5; ++i) {
+        EXPECT_EQ(hex(outputs[i].encoded()), hex(Signer(inputs[i]).build())) << i;
+    }
+    EXPECT_EQ(hex(outputs[0].encoded()).substr(0, 12), "cc01f0625dee");
+    EXPECT_TRUE(outputs[5].encoded().empty());
+}
+
 } // namespace TW::Binance
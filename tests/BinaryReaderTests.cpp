@@ -0,0 +1,75 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BinaryReader.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+TEST(BinaryReader, Read) {
+    const auto data = parse_hex("070403020105000000000000000102" "fd0001" "03abcdef" "ff");
+    BinaryReader reader(data);
+    EXPECT_EQ(reader.readByte(), 7);
+    EXPECT_EQ(reader.read32LE(), 0x01020304u);
+    EXPECT_EQ(reader.read64LE(), 5u);
+    EXPECT_EQ(reader.read16LE(), 0x0201);
+    EXPECT_EQ(reader.readVarInt(), 0x100u);
+
+    const auto bytes = reader.readVarBytes();
+    EXPECT_EQ(hex(bytes.toData()), "abcdef");
+    // a view into the source
+    EXPECT_EQ(bytes.data(), data.data() + 19);
+
+    EXPECT_EQ(reader.remaining(), 1ul);
+    EXPECT_EQ(hex(reader.readRemaining().toData()), "ff");
+    EXPECT_EQ(reader.position(), data.size());
+    EXPECT_EQ(reader.readRemaining().size(), 0ul);
+}
+
+TEST(BinaryReader, StartPosition) {
+    const auto data = parse_hex("0102");
+    EXPECT_EQ(BinaryReader(data, 1).readByte(), 2);
+    EXPECT_EQ(BinaryReader(data, 2).remaining(), 0ul);
+    EXPECT_THROW(BinaryReader(data, 3), std::invalid_argument);
+}
+
+TEST(BinaryReader, PastEnd) {
+    const auto data = parse_hex("010203");
+    BinaryReader reader(data);
+    EXPECT_THROW(reader.read32LE(), std::invalid_argument);
+    EXPECT_EQ(reader.position(), 0ul);
+    EXPECT_THROW(reader.readBytes(4), std::invalid_argument);
+    EXPECT_EQ(reader.read16LE(), 0x0201);
+    EXPECT_THROW(reader.read16LE(), std::invalid_argument);
+    EXPECT_EQ(reader.readByte(), 3);
+    EXPECT_THROW(reader.readByte(), std::invalid_argument);
+}
+
+TEST(BinaryReader, VarInt) {
+    EXPECT_EQ(BinaryReader(parse_hex("fc")).readVarInt(), 0xfcu);
+    EXPECT_EQ(BinaryReader(parse_hex("fe04030201")).readVarInt(), 0x01020304u);
+    EXPECT_EQ(BinaryReader(parse_hex("ff0807060504030201")).readVarInt(), 0x0102030405060708u);
+
+    // truncated, too large: the position is unchanged
+    const auto truncatedInt = parse_hex("fe0403");
+    BinaryReader reader(truncatedInt);
+    EXPECT_THROW(reader.readVarInt(), std::invalid_argument);
+    EXPECT_EQ(reader.position(), 0ul);
+    const auto data = parse_hex("fd0001");
+    BinaryReader large(data);
+    EXPECT_THROW(large.readVarInt(0xff), std::invalid_argument);
+    EXPECT_EQ(large.position(), 0ul);
+
+    // size larger than the data
+    const auto bytes = parse_hex("05abcd");
+    BinaryReader truncated(bytes);
+    EXPECT_THROW(truncated.readVarBytes(), std::invalid_argument);
+    EXPECT_EQ(truncated.position(), 0ul);
+}
+
+} // namespace TW
@@ -0,0 +1,115 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bip340.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bip340 {
+
+TEST(Bip340, TaggedHash) {
+    auto expected = Hash::sha256(std::string("BIP0340/challenge"));
+    expected.insert(expected.end(), expected.begin(), expected.end());
+    append(expected, parse_hex("abcd"));
+    const auto hash = taggedHasher(Tag::challenge).update(parse_hex("abcd")).final();
+    EXPECT_EQ(hex(hash), hex(Hash::sha256(expected)));
+    EXPECT_EQ(hex(taggedHasher("TapTweak").update(parse_hex("abcd")).final()),
+              hex(taggedHasher(Tag::tapTweak).update(parse_hex("abcd")).final()));
+}
+
+TEST(Bip340, Sign) {
+    // BIP340 test vectors 0 and 1
+    const auto key0 = PrivateKey(parse_hex("0000000000000000000000000000000000000000000000000000000000000003"));
+    EXPECT_EQ(hex(xOnlyPublicKey(key0)), "f9308a019258c31049344f85f89d5229b531c845836f99b08601f113bce036f9");
+    EXPECT_EQ(hex(sign(key0, Data(32), Data(32))),
+              "e907831f80848d1069a5371b402410364bdf1c5f8307b0084c55f1ce2dca821525f66a4a85ea8b71e482a74f382d2ce5ebeee8fdb2172f477df4900d310536c0");
+
+    const auto key1 = PrivateKey(parse_hex("b7e151628aed2a6abf7158809cf4f3c762e7160f38b4da56a784d9045190cfef"));
+    const auto message = parse_hex("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89");
+    auto aux = Data(32);
+    aux.back() = 1;
+    const auto signature = sign(key1, message, aux);
+    EXPECT_EQ(hex(xOnlyPublicKey(key1)), "dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659");
+    EXPECT_EQ(hex(signature),
+              "6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de33418906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a");
+    EXPECT_TRUE(verify(xOnlyPublicKey(key1), message, signature));
+
+    EXPECT_TRUE(sign(key1, message, Data(31)).empty());
+}
+
+TEST(Bip340, VerifyInvalid) {
+    const auto publicKey = parse_hex("dff1d77f2a671c5f36183726db2341be58feae1da2deced843240f7b502ba659");
+    const auto message = parse_hex("243f6a8885a308d313198a2e03707344a4093822299f31d0082efa98ec4e6c89");
+    const auto signature = parse_hex("6896bd60eeae296db48a229ff71dfe071bde413e6d43f917dc8dcf8c78de33418906d11ac976abccb20b091292bff4ea897efcb639ea871cfa95f6de339e4b0a");
+
+    auto wrongMessage = message;
+    wrongMessage[0] ^= 1;
+    EXPECT_FALSE(verify(publicKey, wrongMessage, signature));
+    auto wrongS = signature;
+    wrongS.back() ^= 1;
+    EXPECT_FALSE(verify(publicKey, message, wrongS));
+    auto wrongR = signature;
+    wrongR[0] ^= 1;
+    EXPECT_FALSE(verify(publicKey, message, wrongR));
+    // BIP340 test vector 5, public key not on the curve
+    EXPECT_FALSE(verify(parse_hex("eefdea4cdb677750a420fee807eacf21eb9898ae79b9768766e4faa04a2d4a34"), message, signature));
+    // s equal to the curve order
+    auto overflow = signature;
+    std::copy_n(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141").begin(), 32, overflow.begin() + 32);
+    EXPECT_FALSE(verify(publicKey, message, overflow));
+    EXPECT_FALSE(verify(publicKey, message, Data(signature.begin(), signature.end() - 1)));
+    EXPECT_FALSE(verify(Data(publicKey.begin(), publicKey.end() - 1), message, signature));
+}
+
+TEST(Bip340, VerifyBatch) {
+    std::vector<Data> publicKeys;
+    std::vector<Data> messages;
+    std::vector<Data> signatures;
+    for (byte i = 1; i <= 20; ++i) {
+        const auto key = PrivateKey(Data(32, i));
+        publicKeys.push_back(xOnlyPublicKey(key));
+        messages.push_back(Hash::sha256(Data{i}));
+        signatures.push_back(sign(key, messages.back(), Data(32, 0xaa)));
+    }
+    std::vector<bool> valid;
+    EXPECT_TRUE(verifyBatch(publicKeys, messages, signatures, valid, 3));
+    EXPECT_EQ(valid, std::vector<bool>(20, true));
+
+    signatures[7][40] ^= 1;
+    std::swap(messages[12], messages[13]);
+    EXPECT_FALSE(verifyBatch(publicKeys, messages, signatures, valid));
+    for (size_t i = 0; i < valid.size(); ++i) {
+        EXPECT_EQ(valid[i], i != 7 && i != 12 && i != 13) << i;
+    }
+
+    EXPECT_TRUE(verifyBatch({}, {}, {}, valid));
+    EXPECT_TRUE(valid.empty());
+    messages.pop_back();
+    EXPECT_THROW(verifyBatch(publicKeys, messages, signatures, valid), std::invalid_argument);
+}
+
+TEST(Bip340, TaprootTweak) {
+    const auto key = PrivateKey(parse_hex("0000000000000000000000000000000000000000000000000000000000000007"));
+    const auto internalKey = xOnlyPublicKey(key);
+    EXPECT_EQ(hex(internalKey), "5cbdf0646e5db4eaa398f365f2ea7a0e3d419b7e0330e39ce92bddedcac4f9bc");
+    EXPECT_EQ(hex(taprootTweak(internalKey, DataView())), "73405f6715d73c76ed480d370e965e55bc8fb0bf3029d6a68fc4b30ca59f3aef");
+    EXPECT_EQ(hex(taprootOutputKey(internalKey, DataView())), "19cba5b63bdcbf46629edf17cda13bce567b90442bb421eae8a32e35843967c3");
+
+    // the public key has an odd y, the key is negated before adding the tweak
+    const auto tweaked = taprootPrivateKey(key, DataView());
+    EXPECT_EQ(hex(tweaked), "73405f6715d73c76ed480d370e965e55bc8fb0bf3029d6a68fc4b30ca59f3af6");
+    EXPECT_EQ(hex(xOnlyPublicKey(PrivateKey(tweaked))), hex(taprootOutputKey(internalKey, DataView())));
+
+    bool oddY;
+    EXPECT_TRUE(tweakPublicKey(internalKey, Data(31), oddY).empty());
+    EXPECT_TRUE(tweakPublicKey(Data(32), Data(32), oddY).empty());
+    EXPECT_EQ(hex(tweakPublicKey(internalKey, Data(32), oddY)), hex(internalKey));
+    EXPECT_FALSE(oddY);
+}
+
+} // namespace TW::Bip340
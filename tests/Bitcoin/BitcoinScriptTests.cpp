@@ -201,6 +201,51 @@ TEST(BitcoinScript, GetScriptOp) {
     }
 }
 
+TEST(BitcoinScript, MatchViews) {
+    DataView view;
+    EXPECT_TRUE(PayToPublicKeyHash.matchPayToPublicKeyHash(view));
+    EXPECT_EQ(view.data(), PayToPublicKeyHash.bytes.data() + 3);
+    EXPECT_EQ(hex(view), "79091972186c449eb1ded22b78e40d009bdf0089");
+    EXPECT_TRUE(PayToPublicKeySecp256k1.matchPayToPublicKey(view));
+    EXPECT_EQ(hex(view), "03c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432");
+    EXPECT_TRUE(PayToScriptHash.matchPayToScriptHash(view));
+    EXPECT_EQ(hex(view), "4733f37cf4db86fbc2efed2500b4f4e49f312023");
+    EXPECT_TRUE(PayToWitnessPublicKeyHash.matchPayToWitnessPublicKeyHash(view));
+    EXPECT_EQ(hex(view), "79091972186c449eb1ded22b78e40d009bdf0089");
+    EXPECT_TRUE(PayToWitnessScriptHash.matchPayToWitnessScriptHash(view));
+    EXPECT_EQ(hex(view), "ff25429251b5a84f452230a3c75fd886b7fc5a7865ce4a7bb7a9d7c5be6da3db");
+    EXPECT_FALSE(PayToWitnessScriptHash.matchPayToPublicKeyHash(view));
+
+    size_t index = 0; uint8_t opcode;
+    const auto script = Script(parse_hex("4c" "05" "0102030405" "ac"));
+    EXPECT_TRUE(script.getScriptOp(index, opcode, view));
+    EXPECT_EQ(index, 7);
+    EXPECT_EQ(hex(view), "0102030405");
+    EXPECT_TRUE(script.getScriptOp(index, opcode, view));
+    EXPECT_EQ(opcode, OP_CHECKSIG);
+    EXPECT_TRUE(view.empty());
+
+    EXPECT_EQ(Script::buildPayToPublicKeyHash(parse_hex("79091972186c449eb1ded22b78e40d009bdf0089")).bytes.size(), Script::payToPublicKeyHashSize);
+}
+
+TEST(BitcoinScript, MatchDestination) {
+    DataView view;
+    EXPECT_TRUE(PayToPublicKeyHash.matchDestination(view));
+    EXPECT_EQ(hex(view), "79091972186c449eb1ded22b78e40d009bdf0089");
+    EXPECT_TRUE(PayToScriptHash.matchDestination(view));
+    EXPECT_EQ(hex(view), "4733f37cf4db86fbc2efed2500b4f4e49f312023");
+    EXPECT_TRUE(PayToWitnessPublicKeyHash.matchDestination(view));
+    EXPECT_EQ(hex(view), "79091972186c449eb1ded22b78e40d009bdf0089");
+    EXPECT_TRUE(PayToWitnessScriptHash.matchDestination(view));
+    EXPECT_EQ(hex(view), "ff25429251b5a84f452230a3c75fd886b7fc5a7865ce4a7bb7a9d7c5be6da3db");
+    const auto taproot = Script(parse_hex("5120" "a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c"));
+    EXPECT_TRUE(taproot.matchDestination(view));
+    EXPECT_EQ(hex(view), "a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c");
+
+    EXPECT_FALSE(PayToPublicKeySecp256k1.matchDestination(view));
+    EXPECT_FALSE(Script(parse_hex("6a0568656c6c6f")).matchDestination(view));
+}
+
 TEST(BitcoinScript, MatchMultiSig) {
     std::vector<Data> keys;
     int required;
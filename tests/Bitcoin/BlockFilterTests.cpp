@@ -0,0 +1,101 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/BlockFilter.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+/// Hash of the testnet genesis block, in serialized order.
+Data genesisHash() {
+    auto hash = parse_hex("000000000933ea01ad0ee984209779baaec3ced90fa3f408719526f8d77f4943");
+    std::reverse(hash.begin(), hash.end());
+    return hash;
+}
+
+const auto genesisCoinbase = parse_hex(
+    "01000000010000000000000000000000000000000000000000000000000000000000000000ffffffff4d04ffff001d0104455468652054696d"
+    "65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365636f6e64206261696c6f757420666f722062"
+    "616e6b73ffffffff0100f2052a01000000434104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef"
+    "38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac00000000");
+
+const auto genesisScript = parse_hex("4104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef"
+                                     "38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac");
+
+} // namespace
+
+TEST(BitcoinBlockFilter, Genesis) {
+    // BIP158 test vector, testnet block 0
+    const auto hash = genesisHash();
+    const auto filter = BlockFilter::basic(hash, {TransactionView::decode(genesisCoinbase)}, {});
+    EXPECT_EQ(hex(filter.encoded()), "019dfca8");
+    EXPECT_EQ(filter.size(), 1);
+    auto header = filter.header(Data(32));
+    std::reverse(header.begin(), header.end());
+    EXPECT_EQ(hex(header), "21584579b7eb08997773e5aeff3a7f932700042d0ed2a6129012b7d7ae81b750");
+
+    EXPECT_TRUE(filter.match(genesisScript));
+    EXPECT_FALSE(filter.match(parse_hex("0014751e76e8199196d454941c45d1b3a323f1433bd6")));
+    const auto decoded = BlockFilter(hash, parse_hex("019dfca8"));
+    EXPECT_EQ(decoded.size(), 1);
+    EXPECT_TRUE(decoded.match(genesisScript));
+}
+
+TEST(BitcoinBlockFilter, Matches) {
+    const auto wallet = HDWallet("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal", "TREZOR");
+    const auto scripts = BlockFilter::scripts(wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0, 200), TWCoinTypeBitcoin);
+    ASSERT_EQ(scripts.size(), 200);
+
+    // a block paying to a few of the addresses, among many others
+    std::vector<DataView> elements;
+    std::vector<Data> others;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        others.push_back(parse_hex("0014" + hex(Data(20, static_cast<byte>(i)))));
+        others.back()[2] = static_cast<byte>(i >> 8);
+    }
+    for (const auto& other : others) {
+        elements.emplace_back(other);
+    }
+    for (const auto i : {3, 50, 51, 199}) {
+        elements.emplace_back(scripts[i].bytes);
+    }
+    elements.emplace_back(scripts[50].bytes);
+    const auto hash = genesisHash();
+    const auto filter = BlockFilter(hash, elements);
+    EXPECT_EQ(filter.size(), 1004);
+
+    const auto matches = filter.matches(scripts);
+    // false positives are rare, 1 in 784931
+    EXPECT_EQ(matches, (std::vector<std::size_t>{3, 50, 51, 199}));
+    EXPECT_TRUE(filter.matchAny(scripts));
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        EXPECT_EQ(filter.match(scripts[i].bytes), std::find(matches.begin(), matches.end(), i) != matches.end());
+    }
+
+    // the same from the serialized form
+    const auto decoded = BlockFilter(hash, filter.encoded());
+    EXPECT_EQ(decoded.matches(scripts), matches);
+    const auto unrelated = std::vector<Script>(scripts.begin() + 100, scripts.begin() + 150);
+    EXPECT_FALSE(decoded.matchAny(unrelated));
+    EXPECT_TRUE(decoded.matches(std::vector<DataView>{}).empty());
+}
+
+TEST(BitcoinBlockFilter, Empty) {
+    const auto filter = BlockFilter(genesisHash(), std::vector<DataView>{});
+    EXPECT_EQ(hex(filter.encoded()), "00");
+    EXPECT_FALSE(filter.match(genesisScript));
+    EXPECT_THROW(BlockFilter(genesisHash(), Data{}), std::invalid_argument);
+    EXPECT_THROW(BlockFilter(Data(8), std::vector<DataView>{}), std::invalid_argument);
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,137 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TxComparisonHelper.h"
+#include "Bitcoin/PayoutPlanner.h"
+#include "Bitcoin/Transaction.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin {
+
+/// Test UTXOs which spend different outpoints.
+static std::vector<Proto::UnspentTransaction> buildPayoutTestUTXOs(const std::vector<int64_t>& amounts) {
+    auto utxos = buildTestUTXOs(amounts);
+    for (size_t i = 0; i < utxos.size(); ++i) {
+        utxos[i].mutable_out_point()->set_index(static_cast<uint32_t>(i));
+    }
+    return utxos;
+}
+
+static std::vector<Payout> buildPayouts(size_t count, Amount amount) {
+    std::vector<Payout> payouts;
+    for (size_t i = 0; i < count; ++i) {
+        payouts.push_back({i % 2 == 0 ? "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4" : "1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx", amount});
+    }
+    return payouts;
+}
+
+TEST(BitcoinPayoutPlanner, OneBatch) {
+    const auto input = buildSigningInput(0, 2, buildPayoutTestUTXOs({10'000, 80'000, 30'000, 50'000}));
+    const auto payouts = buildPayouts(5, 20'000);
+    const auto result = PayoutPlanner::plan(input, payouts);
+
+    EXPECT_EQ(result.error, Common::Proto::OK);
+    EXPECT_EQ(result.planned, 5);
+    ASSERT_EQ(result.batches.size(), 1);
+    const auto& batch = result.batches[0];
+    EXPECT_EQ(batch.first, 0);
+    EXPECT_EQ(batch.count, 5);
+    // 2 P2WPKH inputs, 3 P2WPKH and 2 P2PKH outputs, P2PKH change
+    const auto virtualSize = 10 + 2 * 68 + 3 * 31 + 3 * 34 + 1;
+    EXPECT_TRUE(verifyPlan(batch.plan, {80'000, 50'000}, 100'000, virtualSize * 2));
+    EXPECT_EQ(batch.plan.change, 130'000 - 100'000 - virtualSize * 2);
+
+    // signs with the estimated size
+    const auto transaction = PayoutPlanner::build<Transaction>(batch, payouts, input.change_address(), TWCoinTypeBitcoin);
+    ASSERT_EQ(transaction.outputs.size(), 6);
+    EXPECT_EQ(transaction.outputs[1].value, 20'000);
+    EXPECT_EQ(transaction.outputs[5].value, batch.plan.change);
+    auto signer = TransactionSigner<Transaction, TransactionBuilder>(input, batch.plan, transaction);
+    const auto signedTx = signer.sign();
+    ASSERT_TRUE(signedTx) << std::to_string(signedTx.error());
+    EXPECT_EQ(signedTx.payload().inputs[1].scriptWitness.size(), 2);
+    EXPECT_TRUE(validateEstimatedSize(signedTx.payload(), -1, 1));
+}
+
+TEST(BitcoinPayoutPlanner, Limits) {
+    const auto input = buildSigningInput(0, 1, buildPayoutTestUTXOs({100'000, 100'000, 100'000, 100'000}));
+    const auto payouts = buildPayouts(5, 10'000);
+
+    auto limits = PayoutPlanner::Limits();
+    limits.maxOutputs = 3;
+    auto result = PayoutPlanner::plan(input, payouts, limits);
+    EXPECT_EQ(result.error, Common::Proto::OK);
+    ASSERT_EQ(result.batches.size(), 3);
+    EXPECT_EQ(result.batches[1].first, 2);
+    EXPECT_EQ(result.batches[1].count, 2);
+    EXPECT_EQ(result.batches[2].count, 1);
+    // a UTXO per batch
+    for (size_t i = 0; i < result.batches.size(); ++i) {
+        ASSERT_EQ(result.batches[i].plan.utxos.size(), 1);
+        EXPECT_EQ(result.batches[i].plan.utxos[0].out_point().index(), i);
+    }
+
+    limits.maxOutputs = 0;
+    limits.maxVirtualSize = 210;
+    result = PayoutPlanner::plan(input, payouts, limits);
+    EXPECT_EQ(result.error, Common::Proto::OK);
+    ASSERT_EQ(result.batches.size(), 2);
+    EXPECT_EQ(result.batches[0].count, 3);
+    EXPECT_EQ(result.batches[0].plan.fee, 209);
+
+    limits.maxVirtualSize = 100;
+    result = PayoutPlanner::plan(input, payouts, limits);
+    EXPECT_EQ(result.error, Common::Proto::Error_tx_too_big);
+    EXPECT_TRUE(result.batches.empty());
+}
+
+TEST(BitcoinPayoutPlanner, Errors) {
+    const auto input = buildSigningInput(0, 1, buildPayoutTestUTXOs({50'000, 25'000}));
+    auto payouts = buildPayouts(4, 20'000);
+    auto result = PayoutPlanner::plan(input, payouts);
+    EXPECT_EQ(result.error, Common::Proto::Error_not_enough_utxos);
+    EXPECT_EQ(result.planned, 3);
+    ASSERT_EQ(result.batches.size(), 1);
+    EXPECT_EQ(result.batches[0].plan.utxos.size(), 2);
+
+    payouts[1].address = "bc1qinvalid";
+    result = PayoutPlanner::plan(input, payouts);
+    EXPECT_EQ(result.error, Common::Proto::Error_script_output);
+    EXPECT_EQ(result.planned, 1);
+
+    payouts[1].amount = 0;
+    payouts[0].amount = 0;
+    result = PayoutPlanner::plan(input, payouts);
+    EXPECT_EQ(result.error, Common::Proto::Error_zero_amount_requested);
+    EXPECT_EQ(result.planned, 0);
+}
+
+TEST(BitcoinPayoutPlanner, Thousands) {
+    std::vector<int64_t> amounts;
+    for (int64_t i = 1; i <= 2'000; ++i) {
+        amounts.push_back(i * 1'000);
+    }
+    const auto input = buildSigningInput(0, 5, buildPayoutTestUTXOs(amounts));
+    const auto payouts = buildPayouts(5'000, 100'000);
+    const auto result = PayoutPlanner::plan(input, payouts);
+
+    EXPECT_EQ(result.error, Common::Proto::OK);
+    EXPECT_EQ(result.planned, 5'000);
+    ASSERT_GT(result.batches.size(), 1);
+    size_t next = 0;
+    for (const auto& batch : result.batches) {
+        EXPECT_EQ(batch.first, next);
+        next += batch.count;
+        const auto& plan = batch.plan;
+        EXPECT_EQ(plan.amount + plan.fee + plan.change, plan.availableAmount);
+        EXPECT_LE(plan.fee / 5, PayoutPlanner::maxStandardVirtualSize + 1'500);
+    }
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,172 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/Psbt.h"
+#include "Bitcoin/SigHashType.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin {
+
+const auto key0 = PrivateKey(parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866"));
+const auto key1 = PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9"));
+
+static Data keyHash(const PrivateKey& key) {
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    return Hash::sha256ripemd(publicKey.bytes.data(), publicKey.bytes.size());
+}
+
+/// Signing input spending two outputs, with the given scripts, each with a key of the test.
+static Proto::SigningInput signingInput(const Script& script0, const Script& script1) {
+    auto input = Proto::SigningInput();
+    input.set_hash_type(hashTypeForCoin(TWCoinTypeBitcoin));
+    input.set_amount(1'000'000'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.add_private_key(key0.bytes.data(), key0.bytes.size());
+    input.add_private_key(key1.bytes.data(), key1.bytes.size());
+    const auto hashes = {parse_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f"), parse_hex("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a")};
+    auto index = 0;
+    for (const auto& script : {script0, script1}) {
+        auto utxo = input.add_utxo();
+        utxo->set_script(script.bytes.data(), script.bytes.size());
+        utxo->set_amount(625'000'000);
+        const auto& hash = *(hashes.begin() + index);
+        utxo->mutable_out_point()->set_hash(hash.data(), hash.size());
+        utxo->mutable_out_point()->set_index(index++);
+        utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+    }
+    return input;
+}
+
+/// Signs through a PSBT the transaction built by the transaction signer, and compares with its result.
+static void expectSameAsSigner(const Proto::SigningInput& input) {
+    auto signer = TransactionSigner<Transaction, TransactionBuilder>(input);
+    auto psbt = Psbt(signer.transaction);
+    for (size_t i = 0; i < psbt.inputs.size(); ++i) {
+        const auto& utxo = signer.plan.utxos[i];
+        psbt.inputs[i].witnessUtxo = TransactionOutput(utxo.amount(), Script(utxo.script().begin(), utxo.script().end()));
+    }
+    EXPECT_EQ(psbt.sign({key0, key1}, 2), psbt.inputs.size());
+    EXPECT_TRUE(psbt.finalize());
+
+    const auto result = signer.sign();
+    ASSERT_TRUE(result);
+    Data expected;
+    result.payload().encode(expected);
+    Data signedTransaction;
+    psbt.extract().encode(signedTransaction);
+    EXPECT_EQ(hex(signedTransaction), hex(expected));
+}
+
+TEST(BitcoinPsbt, SignLikeSigner) {
+    expectSameAsSigner(signingInput(Script::buildPayToPublicKeyHash(keyHash(key0)), Script::buildPayToWitnessPublicKeyHash(keyHash(key1))));
+    expectSameAsSigner(signingInput(Script::buildPayToWitnessPublicKeyHash(keyHash(key1)), Script::buildPayToPublicKeyHash(keyHash(key0))));
+}
+
+TEST(BitcoinPsbt, MultisigCombine) {
+    const auto publicKey0 = key0.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+    const auto publicKey1 = key1.getPublicKey(TWPublicKeyTypeSECP256k1).bytes;
+    auto multisig = Data{OP_2, 0x21};
+    append(multisig, publicKey0);
+    append(multisig, 0x21);
+    append(multisig, publicKey1);
+    append(multisig, Data{OP_2, OP_CHECKMULTISIG});
+    const auto witnessScript = Script(multisig);
+
+    auto transaction = Transaction(2, 0);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f"), 1), Script(), UINT32_MAX);
+    transaction.outputs.emplace_back(90'000, Script::buildPayToWitnessPublicKeyHash(keyHash(key0)));
+
+    auto creator = Psbt(transaction);
+    creator.inputs[0].witnessUtxo = TransactionOutput(100'000, Script::buildPayToWitnessScriptHash(Hash::sha256(multisig)));
+    creator.inputs[0].witnessScript = witnessScript;
+    creator.inputs[0].unknown[{0x06, 0x01}] = parse_hex("00000000");
+    creator.outputs[0][{0x02, 0x01}] = parse_hex("abcd");
+    const auto encoded = creator.encode();
+    EXPECT_EQ(hex(Psbt::decode(encoded).encode()), hex(encoded));
+
+    auto party0 = Psbt::decode(encoded);
+    EXPECT_EQ(party0.sign({key0}), 1);
+    EXPECT_EQ(party0.sign({key0}), 0);
+    EXPECT_FALSE(party0.finalize());
+    auto party1 = Psbt::decode(encoded);
+    EXPECT_EQ(party1.sign({key1}), 1);
+
+    auto combined = Psbt::decode(party0.encode());
+    combined.combine(Psbt::decode(party1.encode()));
+    ASSERT_EQ(combined.inputs[0].partialSignatures.size(), 2);
+    EXPECT_TRUE(combined.finalize());
+    EXPECT_TRUE(combined.inputs[0].partialSignatures.empty());
+    EXPECT_TRUE(combined.inputs[0].unknown.empty());
+    EXPECT_EQ(hex(combined.outputs[0].begin()->second), "abcd");
+
+    const auto signedTransaction = Psbt::decode(combined.encode()).extract();
+    const auto& witness = signedTransaction.inputs[0].scriptWitness;
+    ASSERT_EQ(witness.size(), 4);
+    EXPECT_TRUE(witness[0].empty());
+    EXPECT_EQ(hex(witness[1]), hex(party0.inputs[0].partialSignatures.at(publicKey0.toData())));
+    EXPECT_EQ(hex(witness[2]), hex(party1.inputs[0].partialSignatures.at(publicKey1.toData())));
+    EXPECT_EQ(hex(witness[3]), hex(multisig));
+    EXPECT_TRUE(signedTransaction.inputs[0].script.empty());
+}
+
+TEST(BitcoinPsbt, NonWitnessUtxo) {
+    auto previous = Transaction(1, 0);
+    previous.inputs.emplace_back(OutPoint(Data(32, 1), 0), Script(parse_hex("51")), UINT32_MAX);
+    previous.outputs.emplace_back(50'000, Script::buildPayToPublicKeyHash(keyHash(key0)));
+    Data previousEncoded;
+    previous.encode(previousEncoded);
+    const auto txid = Hash::sha256d(previousEncoded.data(), previousEncoded.size());
+
+    auto transaction = Transaction(1, 0);
+    transaction.inputs.emplace_back(OutPoint(txid, 0), Script(), UINT32_MAX);
+    transaction.outputs.emplace_back(40'000, Script::buildPayToPublicKeyHash(keyHash(key1)));
+    auto psbt = Psbt(transaction);
+    psbt.inputs[0].nonWitnessUtxo = previousEncoded;
+    EXPECT_EQ(psbt.sign({key1}), 0);
+    EXPECT_EQ(psbt.sign({key0}), 1);
+    EXPECT_TRUE(psbt.finalize());
+
+    // the UTXO must match the outpoint
+    auto wrong = Psbt(transaction);
+    previousEncoded.back() ^= 1;
+    wrong.inputs[0].nonWitnessUtxo = previousEncoded;
+    EXPECT_EQ(wrong.sign({key0}), 0);
+    EXPECT_THROW(wrong.extract(), std::invalid_argument);
+}
+
+TEST(BitcoinPsbt, Invalid) {
+    auto transaction = Transaction(1, 0);
+    transaction.inputs.emplace_back(OutPoint(Data(32, 1), 0), Script(), UINT32_MAX);
+    const auto encoded = Psbt(transaction).encode();
+
+    EXPECT_THROW(Psbt::decode(Data(encoded.begin(), encoded.end() - 1)), std::invalid_argument);
+    auto badMagic = encoded;
+    badMagic[0] = 'x';
+    EXPECT_THROW(Psbt::decode(badMagic), std::invalid_argument);
+    EXPECT_THROW(Psbt::decode(parse_hex("70736274ff00")), std::invalid_argument);
+    // duplicate key in the input map
+    auto duplicate = encoded;
+    duplicate.pop_back();
+    append(duplicate, parse_hex("0107" "0151" "0107" "0151" "00"));
+    EXPECT_THROW(Psbt::decode(duplicate), std::invalid_argument);
+
+    transaction.inputs[0].script = Script(parse_hex("51"));
+    EXPECT_THROW(Psbt{transaction}, std::invalid_argument);
+
+    auto other = Transaction(1, 1);
+    other.inputs.emplace_back(OutPoint(Data(32, 1), 0), Script(), UINT32_MAX);
+    auto psbt = Psbt::decode(encoded);
+    EXPECT_THROW(psbt.combine(Psbt(other)), std::invalid_argument);
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,115 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/ScriptCache.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace TW::Bitcoin {
+
+namespace {
+
+const auto segwitAddress = "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4";
+const auto legacyAddress = "1Cu32FVupVCgHkMMRJdYJugxwo2Aprgk7H";
+const auto p2shAddress = "37rHiL4DN2wkt8pgCAUfYJRxhir98ZGN1y";
+
+} // namespace
+
+TEST(ScriptCache, LockScript) {
+    auto cache = ScriptCache(16);
+    const auto script = cache.lockScript(segwitAddress, TWCoinTypeBitcoin);
+    EXPECT_EQ(hex(script.bytes), hex(Script::lockScriptForAddress(segwitAddress, TWCoinTypeBitcoin).bytes));
+    EXPECT_EQ(cache.size(), 1);
+
+    Script cached;
+    ASSERT_TRUE(cache.find(segwitAddress, TWCoinTypeBitcoin, cached));
+    EXPECT_EQ(hex(cached.bytes), hex(script.bytes));
+    // keyed by coin too
+    EXPECT_FALSE(cache.find(segwitAddress, TWCoinTypeLitecoin, cached));
+
+    // invalid addresses are not cached
+    EXPECT_TRUE(cache.lockScript("invalid", TWCoinTypeBitcoin).empty());
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST(ScriptCache, Eviction) {
+    auto cache = ScriptCache(2);
+    cache.lockScript(segwitAddress, TWCoinTypeBitcoin);
+    cache.lockScript(legacyAddress, TWCoinTypeBitcoin);
+    // most recently used
+    Script script;
+    EXPECT_TRUE(cache.find(segwitAddress, TWCoinTypeBitcoin, script));
+
+    cache.lockScript(p2shAddress, TWCoinTypeBitcoin);
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.find(segwitAddress, TWCoinTypeBitcoin, script));
+    EXPECT_TRUE(cache.find(p2shAddress, TWCoinTypeBitcoin, script));
+    EXPECT_FALSE(cache.find(legacyAddress, TWCoinTypeBitcoin, script));
+}
+
+TEST(ScriptCache, Disabled) {
+    auto cache = ScriptCache(16);
+    cache.lockScript(segwitAddress, TWCoinTypeBitcoin);
+    cache.setCapacity(0);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.capacity(), 0);
+
+    EXPECT_FALSE(cache.lockScript(segwitAddress, TWCoinTypeBitcoin).empty());
+    EXPECT_EQ(cache.lockScripts({legacyAddress, legacyAddress}, TWCoinTypeBitcoin).size(), 2);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(ScriptCache, LockScripts) {
+    auto cache = ScriptCache(16);
+    cache.lockScript(segwitAddress, TWCoinTypeBitcoin);
+    const auto addresses = std::vector<std::string>{legacyAddress, segwitAddress, "invalid", p2shAddress, legacyAddress};
+    const auto scripts = cache.lockScripts(addresses, TWCoinTypeBitcoin);
+    ASSERT_EQ(scripts.size(), addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        EXPECT_EQ(hex(scripts[i].bytes), hex(Script::lockScriptForAddress(addresses[i], TWCoinTypeBitcoin).bytes));
+    }
+    EXPECT_TRUE(scripts[2].empty());
+    EXPECT_EQ(cache.size(), 3);
+
+    EXPECT_TRUE(cache.lockScripts({}, TWCoinTypeBitcoin).empty());
+}
+
+TEST(ScriptCache, Concurrent) {
+    auto cache = ScriptCache(2);
+    const auto addresses = std::vector<std::string>{segwitAddress, legacyAddress, p2shAddress};
+    std::vector<std::string> expected;
+    for (const auto& address : addresses) {
+        expected.push_back(hex(Script::lockScriptForAddress(address, TWCoinTypeBitcoin).bytes));
+    }
+
+    const size_t threadCount = 8;
+    std::vector<std::vector<std::string>> results(threadCount);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&, t]() {
+            for (size_t i = 0; i < 64; ++i) {
+                // evicting each other's entries
+                const auto& address = addresses[(t + i) % addresses.size()];
+                results[t].push_back(hex(cache.lockScript(address, TWCoinTypeBitcoin).bytes));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (size_t t = 0; t < threadCount; ++t) {
+        for (size_t i = 0; i < results[t].size(); ++i) {
+            EXPECT_EQ(results[t][i], expected[(t + i) % addresses.size()]);
+        }
+    }
+    EXPECT_LE(cache.size(), 2);
+}
+
+} // namespace TW::Bitcoin
@@ -0,0 +1,105 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TxComparisonHelper.h"
+#include "Bitcoin/SizeEstimator.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Bitcoin;
+
+namespace {
+
+const auto keyHash = "1d0f172a0ecb48aee1be1f2687d2963ae33f71a1";
+const auto multisigScript = parse_hex(
+    "5221" "03c8953d4d38b8a6ea93eab39b07d2ba857a8cd77cd513fa4c0ba1bf3d1c2b4704"
+    "21" "02e1f682b9fac3bc1d2c5bf40d5c79649ea3ef0a6d94ce45ec562e4c2dda10a2ee"
+    "21" "0249e6ae928b4e7e6bfb7b1b071e2c647ce1e6ab0fedb7a11a9161df9b8cbcc0b9" "53ae");
+
+Proto::UnspentTransaction buildUTXO(const Data& script, int64_t amount) {
+    auto utxo = buildTestUTXO(amount);
+    utxo.set_script(script.data(), script.size());
+    return utxo;
+}
+
+/// Virtual size of the transaction signed in estimation mode, as TransactionBuilder used to compute it.
+int64_t signedVirtualSize(const TransactionPlan& plan, Proto::SigningInput input) {
+    *input.mutable_plan() = plan.proto();
+    auto signer = TransactionSigner<Transaction, TransactionBuilder>(std::move(input), true);
+    auto result = signer.sign();
+    EXPECT_TRUE(result);
+    const auto& transaction = result.payload();
+    Data dataNonSegwit;
+    transaction.encode(dataNonSegwit, Transaction::SegwitFormatMode::NonSegwit);
+    const auto sizeNonSegwit = static_cast<int64_t>(dataNonSegwit.size());
+    if (!transaction.hasWitness()) {
+        return sizeNonSegwit;
+    }
+    Data dataWitness;
+    transaction.encodeWitness(dataWitness);
+    const auto witnessSize = static_cast<int64_t>(2 + dataWitness.size());
+    return sizeNonSegwit + witnessSize / 4 + (witnessSize % 4 != 0);
+}
+
+} // namespace
+
+TEST(BitcoinSizeEstimator, MatchesSignedSize) {
+    const auto p2sh = parse_hex(std::string("0014") + keyHash);
+    const auto p2shHash = Hash::sha256ripemd(p2sh.data(), p2sh.size());
+    const auto p2wshHash = Hash::sha256(multisigScript);
+
+    const auto utxos = std::vector<Proto::UnspentTransaction>{
+        buildUTXO(parse_hex(std::string("76a914") + keyHash + "88ac"), 10'000),
+        buildUTXO(parse_hex(std::string("0014") + keyHash), 20'000),
+        buildUTXO(Script::buildPayToScriptHash(p2shHash).bytes, 30'000),
+        buildUTXO(Script::buildPayToWitnessScriptHash(p2wshHash).bytes, 40'000),
+    };
+    auto input = buildSigningInput(50'000, 1, utxos);
+    (*input.mutable_scripts())[hex(p2shHash)] = std::string(p2sh.begin(), p2sh.end());
+    (*input.mutable_scripts())[hex(Hash::ripemd(p2wshHash))] = std::string(multisigScript.begin(), multisigScript.end());
+
+    // each input type alone, then all of them, with and without change
+    for (size_t i = 0; i <= utxos.size(); ++i) {
+        auto plan = TransactionPlan();
+        if (i < utxos.size()) {
+            plan.utxos = {utxos[i]};
+        } else {
+            plan.utxos = utxos;
+        }
+        plan.amount = 5'000;
+        plan.availableAmount = UnspentSelector::sum(plan.utxos);
+        for (auto change : {Amount(0), Amount(1'000)}) {
+            plan.change = change;
+            const auto vSize = SizeEstimator::virtualSize(plan, input);
+            ASSERT_TRUE(vSize.has_value()) << i;
+            EXPECT_EQ(*vSize, signedVirtualSize(plan, input)) << i << " change " << change;
+        }
+    }
+}
+
+TEST(BitcoinSizeEstimator, InputSizes) {
+    const auto input = buildSigningInput(50'000, 1, {});
+
+    const auto p2pkh = SizeEstimator::inputSize(Script(parse_hex(std::string("76a914") + keyHash + "88ac")), input);
+    ASSERT_TRUE(p2pkh.has_value());
+    EXPECT_EQ(p2pkh->base, 148);
+
+    const auto p2wpkh = SizeEstimator::inputSize(Script(parse_hex(std::string("0014") + keyHash)), input);
+    ASSERT_TRUE(p2wpkh.has_value());
+    EXPECT_EQ(p2wpkh->base, 41);
+    EXPECT_EQ(p2wpkh->witness, 108);
+
+    EXPECT_EQ(SizeEstimator::outputSize(Script(parse_hex(std::string("0014") + keyHash))), 31);
+
+    // missing redeem script, unsupported script
+    EXPECT_FALSE(SizeEstimator::inputSize(Script::buildPayToScriptHash(Data(20, 1)), input).has_value());
+    EXPECT_FALSE(SizeEstimator::inputSize(Script(parse_hex("6a0401020304")), input).has_value());
+}
@@ -15,6 +15,7 @@
 #include "Hash.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
+#include "ThreadPool.h"
 #include "proto/Bitcoin.pb.h"
 #include "TxComparisonHelper.h"
 #include "../interface/TWTestUtilities.h"
@@ -131,6 +132,94 @@ TEST(BitcoinSigning, SignP2PKH_NegativeMissingKey) {
     EXPECT_EQ(result.error(), Common::Proto::Error_missing_private_key);
 }
 
+TEST(BitcoinSigning, SignP2PKH_ManyKeys) {
+    auto expected = Data();
+    {
+        auto signer = TransactionSigner<Transaction, TransactionBuilder>(buildInputP2PKH());
+        auto result = signer.sign();
+        ASSERT_TRUE(result);
+        signer.encodeTx(result.payload(), expected);
+    }
+
+    // the signing keys among unrelated ones, indexed on several threads
+    auto input = buildInputP2PKH(true);
+    const auto signingKeys = buildInputP2PKH().private_key();
+    for (auto i = 1; i <= 50; ++i) {
+        auto key = Data(32, 0);
+        key[31] = static_cast<byte>(i);
+        input.add_private_key(key.data(), key.size());
+        if (i == 25) {
+            input.add_private_key(signingKeys[0]);
+            input.add_private_key(signingKeys[1]);
+        }
+    }
+    auto signer = TransactionSigner<Transaction, TransactionBuilder>(input);
+    auto result = signer.sign();
+    ASSERT_TRUE(result) << std::to_string(result.error());
+    Data serialized;
+    signer.encodeTx(result.payload(), serialized);
+    EXPECT_EQ(hex(serialized), hex(expected));
+}
+
+/// Sweep of `count` UTXOs of the two keys of buildInputP2PKH, P2PKH and P2WPKH in turn.
+Proto::SigningInput buildInputSweep(int count) {
+    auto input = buildInputP2PKH();
+    const auto script0 = Data(input.utxo(0).script().begin(), input.utxo(0).script().end());
+    const auto script1 = Data(input.utxo(1).script().begin(), input.utxo(1).script().end());
+    input.clear_utxo();
+    input.set_use_max_amount(true);
+    for (auto i = 0; i < count; ++i) {
+        auto hash = Hash::sha256(TW::data(std::to_string(i)));
+        auto utxo = input.add_utxo();
+        const auto& script = i % 2 == 0 ? script0 : script1;
+        utxo->set_script(script.data(), script.size());
+        utxo->set_amount(100'000 + i);
+        utxo->mutable_out_point()->set_hash(hash.data(), hash.size());
+        utxo->mutable_out_point()->set_index(i % 3);
+        utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+    }
+    return input;
+}
+
+TEST(BitcoinSigning, SignManyInputs) {
+    auto& pool = ThreadPool::shared();
+    const auto input = buildInputSweep(200);
+    pool.setThreadCount(1);
+    auto single = Data();
+    {
+        auto signer = TransactionSigner<Transaction, TransactionBuilder>(input);
+        auto result = signer.sign();
+        ASSERT_TRUE(result) << std::to_string(result.error());
+        EXPECT_EQ(result.payload().inputs.size(), 200ul);
+        signer.encodeTx(result.payload(), single);
+    }
+    // the inputs are signed on several threads, in the same order
+    pool.setThreadCount(8);
+    {
+        auto signer = TransactionSigner<Transaction, TransactionBuilder>(input);
+        auto result = signer.sign();
+        ASSERT_TRUE(result) << std::to_string(result.error());
+        Data serialized;
+        signer.encodeTx(result.payload(), serialized);
+        EXPECT_EQ(hex(serialized), hex(single));
+    }
+
+    // the error of the first input which can't be signed
+    auto failing = input;
+    const auto witnessScriptHash = Script::buildPayToWitnessScriptHash(Data(32, 1));
+    failing.mutable_utxo(150)->set_script(witnessScriptHash.bytes.data(), witnessScriptHash.bytes.size());
+    const auto unknownKeyHash = Script::buildPayToPublicKeyHash(Data(20, 1));
+    failing.mutable_utxo(170)->set_script(unknownKeyHash.bytes.data(), unknownKeyHash.bytes.size());
+    for (auto threadCount : {1, 8}) {
+        pool.setThreadCount(threadCount);
+        auto signer = TransactionSigner<Transaction, TransactionBuilder>(failing);
+        auto result = signer.sign();
+        ASSERT_FALSE(result);
+        EXPECT_EQ(result.error(), Common::Proto::Error_script_redeem);
+    }
+    pool.setThreadCount(0);
+}
+
 TEST(BitcoinSigning, EncodeP2WPKH) {
     auto unsignedTx = Transaction(1, 0x11);
 
@@ -341,6 +430,39 @@ TEST(BitcoinSigning, SignP2WPKH_HashAnyoneCanPay_TwoInput) {
     );
 }
 
+TEST(BitcoinSigning, SignFeeBumpReusingSignatures) {
+    using Signer = TransactionSigner<Transaction, TransactionBuilder>;
+    const auto hashType = static_cast<TWBitcoinSigHashType>(TWBitcoinSigHashTypeSingle | TWBitcoinSigHashTypeAnyoneCanPay);
+    auto input = buildInputP2WPKH(335'790'000, hashType, 210'000'000, 210'000'000);
+    auto signer = Signer(input);
+    auto result = signer.sign();
+    ASSERT_TRUE(result) << std::to_string(result.error());
+    auto previous = result.payload();
+    // marks the signature, to check that it is reused
+    previous.inputs[0].script.bytes[10] ^= 1;
+
+    // the change output, at the index of the second input, changes
+    auto bumpedInput = input;
+    *bumpedInput.mutable_plan() = TransactionBuilder::bumpFee(signer.plan, input, 10).proto();
+    ASSERT_EQ(bumpedInput.plan().error(), Common::Proto::OK);
+    ASSERT_EQ(bumpedInput.plan().utxos_size(), 2);
+    auto bumpedSigner = Signer(bumpedInput);
+    EXPECT_TRUE(Signer::canReuseSignature(previous, bumpedSigner.transaction, 0, hashType));
+    EXPECT_FALSE(Signer::canReuseSignature(previous, bumpedSigner.transaction, 1, hashType));
+    EXPECT_FALSE(Signer::canReuseSignature(previous, bumpedSigner.transaction, 0, TWBitcoinSigHashTypeSingle));
+    EXPECT_FALSE(Signer::canReuseSignature(previous, bumpedSigner.transaction, 0,
+        static_cast<TWBitcoinSigHashType>(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)));
+
+    auto bumped = bumpedSigner.sign(previous);
+    ASSERT_TRUE(bumped) << std::to_string(bumped.error());
+    const auto fresh = Signer(bumpedInput).sign();
+    ASSERT_TRUE(fresh);
+    EXPECT_EQ(hex(bumped.payload().inputs[0].script.bytes), hex(previous.inputs[0].script.bytes));
+    EXPECT_NE(hex(fresh.payload().inputs[0].script.bytes), hex(previous.inputs[0].script.bytes));
+    EXPECT_EQ(hex(bumped.payload().inputs[1].scriptWitness[0]), hex(fresh.payload().inputs[1].scriptWitness[0]));
+    EXPECT_NE(hex(bumped.payload().inputs[1].scriptWitness[0]), hex(previous.inputs[1].scriptWitness[0]));
+}
+
 TEST(BitcoinSigning, SignP2WPKH_MaxAmount) {
     auto input = buildInputP2WPKH(1'000, TWBitcoinSigHashTypeAll, 625'000'000, 600'000'000, true);
 
@@ -925,6 +1047,83 @@ TEST(BitcoinSigning, SignP2SH_P2WSH) {
     ASSERT_EQ(hex(serialized), expected);
 }
 
+/// Signing input of the P2SH-P2WSH 6-of-6 multisig input above, with some of its keys.
+static Proto::SigningInput buildInputP2SH_P2WSH(const std::vector<std::string>& keys) {
+    auto input = Proto::SigningInput();
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_amount(900000000);
+    for (const auto& key : keys) {
+        const auto keyData = parse_hex(key);
+        input.add_private_key(keyData.data(), keyData.size());
+    }
+
+    const auto redeemScript = Script::buildPayToWitnessScriptHash(parse_hex("a16b5755f7f6f96dbd65f5f0d6ab9418b89af4b1f14a1bb8a09062c35f0dcb54"));
+    (*input.mutable_scripts())[hex(Hash::sha256ripemd(redeemScript.bytes.data(), redeemScript.bytes.size()))] = std::string(redeemScript.bytes.begin(), redeemScript.bytes.end());
+    const auto witnessScript = parse_hex(""
+        "56"
+            "210307b8ae49ac90a048e9b53357a2354b3334e9c8bee813ecb98e99a7e07e8c3ba3"
+            "2103b28f0c28bfab54554ae8c658ac5c3e0ce6e79ad336331f78c428dd43eea8449b"
+            "21034b8113d703413d57761b8b9781957b8c0ac1dfe69f492580ca4195f50376ba4a"
+            "21033400f6afecb833092a9a21cfdf1ed1376e58c5d1f47de74683123987e967a8f4"
+            "2103a6d48b1131e94ba04d9737d61acdaa1322008af9602b3b14862c07a1789aac16"
+            "2102d8b661b0b3302ee2f162b09e07a55ad5dfbe673a9f01d9f0c19617681024306b"
+        "56ae"
+    );
+    (*input.mutable_scripts())[hex(Hash::sha256ripemd(witnessScript.data(), witnessScript.size()))] = std::string(witnessScript.begin(), witnessScript.end());
+
+    const auto utxoScript = parse_hex("a9149993a429037b5d912407a71c252019287b8d27a587");
+    for (uint32_t index = 0; index < 2; ++index) {
+        const auto hash = parse_hex("36641869ca081e70f394c6948e8af409e18b619df2ed74aa106c1ca29787b96e");
+        auto utxo = input.add_utxo();
+        utxo->mutable_out_point()->set_hash(hash.data(), hash.size());
+        utxo->mutable_out_point()->set_index(index);
+        utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+        utxo->set_script(utxoScript.data(), utxoScript.size());
+        utxo->set_amount(600'000'000);
+    }
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.set_byte_fee(1);
+    input.set_coin_type(TWCoinTypeBitcoin);
+    return input;
+}
+
+TEST(BitcoinSigning, SignP2SH_P2WSH_Cosigners) {
+    using Signer = TransactionSigner<Transaction, TransactionBuilder>;
+    const auto keys = std::vector<std::string>{
+        "730fff80e1413068a05b57d6a58261f07551163369787f349438ea38ca80fac6",
+        "11fa3d25a17cbc22b29c44a484ba552b5a53149d106d3d853e22fdd05a2d8bb3",
+        "77bf4141a87d55bdd7f3cd0bdccf6e9e642935fec45f2f30047be7b799120661",
+        "14af36970f5025ea3e8b5542c0f8ebe7763e674838d08808896b63c3351ffe49",
+        "fe9a95c19eef81dde2b95c1284ef39be497d128e2aa46916fb02d552485e0323",
+        "428a7aee9f0c2af0cd19af3cf1c78149951ea528726989b2e83e4778d2c3f890",
+    };
+    const auto result = Signer(buildInputP2SH_P2WSH(keys)).sign();
+    ASSERT_TRUE(result) << std::to_string(result.error());
+    Data expected;
+    result.payload().encode(expected);
+
+    // Each cosigner has half the keys
+    auto cosigner0 = Signer(buildInputP2SH_P2WSH({keys.begin(), keys.begin() + 3}));
+    auto cosigner1 = Signer(buildInputP2SH_P2WSH({keys.begin() + 3, keys.end()}));
+    const auto missing = cosigner1.sign();
+    ASSERT_FALSE(missing);
+    EXPECT_EQ(missing.error(), Common::Proto::Error_missing_private_key);
+
+    const auto partial = cosigner0.signPartial();
+    ASSERT_TRUE(partial) << std::to_string(partial.error());
+    ASSERT_EQ(partial.payload().size(), 2);
+    EXPECT_EQ(partial.payload()[0].size(), 3);
+    EXPECT_EQ(partial.payload()[1].size(), 3);
+    cosigner1.partialSignatures = partial.payload();
+    const auto cosigned = cosigner1.sign();
+    ASSERT_TRUE(cosigned) << std::to_string(cosigned.error());
+    Data serialized;
+    cosigned.payload().encode(serialized);
+    EXPECT_EQ(hex(serialized), hex(expected));
+    EXPECT_EQ(cosigned.payload().inputs[0].scriptWitness.size(), 8);
+}
+
 TEST(BitcoinSigning, Sign_NegativeNoUtxos) {
     auto hash0 = parse_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f");
     auto hash1 = parse_hex("ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a");
@@ -1288,7 +1487,7 @@ TEST(BitcoinSigning, EncodeThreeOutput) {
     
     // add witness stack
     unsignedTx.inputs[0].scriptWitness.push_back(sig);
-    unsignedTx.inputs[0].scriptWitness.push_back(pubkey.bytes);
+    unsignedTx.inputs[0].scriptWitness.push_back(pubkey.bytes.toData());
 
     unsignedData.clear();
     unsignedTx.encode(unsignedData, Transaction::SegwitFormatMode::Segwit);
@@ -4,7 +4,10 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Bitcoin/SignerTraits.h"
 #include "Bitcoin/Transaction.h"
+#include "Groestlcoin/Transaction.h"
+#include "Zcash/Transaction.h"
 #include "HexCoding.h"
 #include "../interface/TWTestUtilities.h"
 
@@ -39,3 +42,113 @@ TEST(BitcoinTransaction, Encode) {
     ASSERT_EQ(hex(unsignedData),
         "02000000035897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f0000000000ffffffffbf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c1200000000ffffffff22a6f904655d53ae2ff70e701a0bbd90aa3975c0f40bfc6cc996a9049e31cdfc0100000000ffffffff0280a81201000000001976a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac0084d717000000001976a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac00000000");
 }
+
+TEST(BitcoinTransaction, SerializedSize) {
+    auto transaction = Transaction(2, 0);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), 0), Script(), 4294967295);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("bf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c"), 18),
+                                    Script(Data(300, 0x51)), 4294967295);
+    transaction.outputs.emplace_back(18000000, Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac")));
+
+    const auto checkSizes = [&transaction]() {
+        for (const auto mode : {Transaction::NonSegwit, Transaction::IfHasWitness, Transaction::Segwit}) {
+            Data encoded;
+            transaction.encode(encoded, mode);
+            EXPECT_EQ(transaction.serializedSize(mode), encoded.size()) << mode;
+        }
+        Data witness;
+        transaction.encodeWitness(witness);
+        EXPECT_EQ(transaction.witnessSize(), witness.size());
+    };
+    checkSizes();
+    EXPECT_EQ(transaction.vsize(), transaction.serializedSize(Transaction::NonSegwit));
+
+    transaction.inputs[0].scriptWitness = {Data(72, 1), Data(33, 2)};
+    transaction.inputs[1].scriptWitness = {Data(), Data(600, 3)};
+    checkSizes();
+    const auto base = transaction.serializedSize(Transaction::NonSegwit);
+    const auto total = transaction.serializedSize(Transaction::Segwit);
+    // weight is 3 times the base size plus the total size
+    EXPECT_EQ(transaction.vsize(), (base * 3 + total + 3) / 4);
+
+    Data encoded;
+    transaction.encode(encoded);
+    Data nonSegwit;
+    transaction.encode(nonSegwit, Transaction::NonSegwit);
+    EXPECT_EQ(hex(transaction.stripWitness(encoded)), hex(nonSegwit));
+}
+
+TEST(BitcoinTransaction, SignerTraits) {
+    static_assert(SignerTraits<Transaction>::taproot && !SignerTraits<Transaction>::expiry);
+    static_assert(!SignerTraits<Groestlcoin::Transaction>::taproot && !SignerTraits<Zcash::Transaction>::taproot);
+    static_assert(SignerTraits<Zcash::Transaction>::expiry);
+
+    const auto data = parse_hex("0100000000");
+    EXPECT_EQ(hex(SignerTraits<Transaction>::txidHasher(data.data(), data.size())), hex(Hash::sha256d(data.data(), data.size())));
+    EXPECT_EQ(hex(SignerTraits<Groestlcoin::Transaction>::txidHasher(data.data(), data.size())), hex(Hash::sha256(data)));
+}
+
+TEST(BitcoinTransaction, SignatureHashCache) {
+    auto transaction = Transaction(2, 0);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), 0), Script(), 4294967295);
+    transaction.inputs.emplace_back(OutPoint(parse_hex("bf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c"), 18), Script(), 4294967294);
+    transaction.outputs.emplace_back(18000000, Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac")));
+    transaction.outputs.emplace_back(400000000, Script(parse_hex("76a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac")));
+    const auto scriptCode = Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac"));
+
+    const auto hashTypes = {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeSingle, TWBitcoinSigHashTypeNone,
+        static_cast<TWBitcoinSigHashType>(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)};
+    std::vector<Data> expected;
+    for (auto hashType : hashTypes) {
+        for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+            expected.push_back(transaction.getSignatureHash(scriptCode, index, hashType, 1000, WITNESS_V0));
+        }
+    }
+
+    transaction.cacheSignatureHashes();
+    EXPECT_EQ(hex(transaction.getPrevoutHash()), "bc6d57040d3fabb6f1740f10f7bbdb67cec958d8242d291ddc61aac03b3eac98");
+    size_t i = 0;
+    for (auto hashType : hashTypes) {
+        for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+            EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, index, hashType, 1000, WITNESS_V0)), hex(expected[i++]));
+        }
+    }
+
+    // the cache is stale until cleared
+    const auto outputsHash = transaction.getOutputsHash();
+    transaction.outputs.pop_back();
+    EXPECT_EQ(hex(transaction.getOutputsHash()), hex(outputsHash));
+    transaction.clearSignatureHashCache();
+    EXPECT_NE(hex(transaction.getOutputsHash()), hex(outputsHash));
+}
+
+TEST(BitcoinTransaction, LegacySignatureHashCache) {
+    const auto hashTypes = {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeSingle, TWBitcoinSigHashTypeNone,
+        static_cast<TWBitcoinSigHashType>(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay)};
+    const auto scriptCode = Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac"));
+    for (const auto& hasher : {Hash::Hasher(Hash::sha256d), Hash::Hasher(Hash::groestl512d)}) {
+        auto transaction = Transaction(1, 10, hasher);
+        transaction.inputs.emplace_back(OutPoint(parse_hex("5897de6bd6027a475eadd57019d4e6872c396d0716c4875a5f1a6fcfdf385c1f"), 0), Script(), 4294967295);
+        transaction.inputs.emplace_back(OutPoint(parse_hex("bf829c6bcf84579331337659d31f89dfd138f7f7785802d5501c92333145ca7c"), 18), Script(), 4294967294);
+        transaction.inputs.emplace_back(OutPoint(parse_hex("22a6f904655d53ae2ff70e701a0bbd90aa3975c0f40bfc6cc996a9049e31cdfc"), 1), Script(), 0);
+        // one output per input, for SIGHASH_SINGLE
+        transaction.outputs.emplace_back(18000000, Script(parse_hex("76a9141fc11f39be1729bf973a7ab6a615ca4729d6457488ac")));
+        transaction.outputs.emplace_back(400000000, Script(parse_hex("76a914f2d4db28cad6502226ee484ae24505c2885cb12d88ac")));
+        transaction.outputs.emplace_back(1000, Script(parse_hex("0014f2d4db28cad6502226ee484ae24505c2885cb12d")));
+
+        std::vector<Data> expected;
+        for (auto hashType : hashTypes) {
+            for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+                expected.push_back(transaction.getSignatureHash(scriptCode, index, hashType, 0, BASE));
+            }
+        }
+
+        transaction.cacheSignatureHashes();
+        size_t i = 0;
+        for (auto hashType : hashTypes) {
+            for (size_t index = 0; index < transaction.inputs.size(); ++index) {
+                EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, index, hashType, 0, BASE)), hex(expected[i++]));
+            }
+        }
+    }
+}
@@ -0,0 +1,133 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/SegwitAddress.h"
+#include "Bitcoin/SigHashType.h"
+#include "Bitcoin/Transaction.h"
+#include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Bip340.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Bitcoin {
+
+TEST(BitcoinTaproot, Bip86Address) {
+    const auto wallet = HDWallet("abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about", "");
+    const auto key = wallet.getKey(TWCoinTypeBitcoin, DerivationPath("m/86'/0'/0'/0/0"));
+    const auto publicKey = key.getPublicKey(TWPublicKeyTypeSECP256k1);
+    EXPECT_EQ(hex(Bip340::xOnlyPublicKey(key)), "cc8a4bc64d897bddc5fbc2f670f7a8ba0b386779106cf1223c6fc5d7cd6fc115");
+
+    const auto address = SegwitAddress::taproot(publicKey, "bc");
+    EXPECT_EQ(hex(address.witnessProgram), "a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c");
+    EXPECT_EQ(address.string(), "bc1p5cyxnuxmeuwuvkwfem96lqzszd02n6xdcjrs20cac6yqjjwudpxqkedrcr");
+    EXPECT_EQ(hex(SegwitAddress::taproot(key.getPublicKey(TWPublicKeyTypeSECP256k1Extended), "bc").witnessProgram),
+              hex(address.witnessProgram));
+    EXPECT_THROW(SegwitAddress::taproot(key.getPublicKey(TWPublicKeyTypeED25519), "bc"), std::invalid_argument);
+
+    const auto script = Script::lockScriptForAddress(address.string(), TWCoinTypeBitcoin);
+    EXPECT_EQ(hex(script.bytes), "5120a60869f0dbcf1dc659c9cecbaf8050135ea9e8cdc487053f1dc6880949dc684c");
+    EXPECT_TRUE(script.isPayToTaproot());
+    DataView outputKey;
+    EXPECT_TRUE(script.matchPayToTaproot(outputKey));
+    EXPECT_EQ(hex(outputKey), hex(address.witnessProgram));
+    EXPECT_EQ(hex(Script::buildPayToTaproot(outputKey).bytes), hex(script.bytes));
+    EXPECT_FALSE(Script::buildPayToWitnessScriptHash(outputKey).isPayToTaproot());
+
+    // other witness versions are not supported
+    EXPECT_TRUE(Script::lockScriptForAddress("bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", TWCoinTypeBitcoin).empty());
+}
+
+TEST(BitcoinTaproot, SignatureHash) {
+    const auto internalKey = parse_hex("5cbdf0646e5db4eaa398f365f2ea7a0e3d419b7e0330e39ce92bddedcac4f9bc");
+    Data hash0;
+    Data hash1;
+    for (byte i = 0; i < 32; ++i) {
+        hash0.push_back(i);
+        hash1.push_back(i + 32);
+    }
+    auto transaction = Transaction(2, 500);
+    transaction.inputs.emplace_back(OutPoint(hash0, 1), Script(), 0xfffffffd);
+    transaction.inputs.emplace_back(OutPoint(hash1, 7), Script(), UINT32_MAX);
+    transaction.outputs.emplace_back(300'000, Script::buildPayToWitnessPublicKeyHash(Data(20, 1)));
+    transaction.outputs.emplace_back(40'000, Script::buildPayToTaproot(Data(32, 2)));
+    const auto spentOutputs = std::vector<TransactionOutput>{
+        TransactionOutput(100'000, Script::buildPayToTaproot(internalKey)),
+        TransactionOutput(250'000, Script::buildPayToWitnessPublicKeyHash(Data(20, 0))),
+    };
+
+    const auto expected = std::vector<std::tuple<size_t, uint8_t, std::string>>{
+        {0, 0x00, "9fe7fd4ee8696b380fdc8e5e50006997403740ad842855fd8f824fc09441b434"},
+        {0, 0x01, "e5ef7f5d63feb47b2c88c0f08760d5ee364eccdda165c28c3fa398eb51743701"},
+        {1, 0x02, "82454b9aebf23f2b52809866e07285a1815388faa1c3da349eddcac75d718c96"},
+        {1, 0x03, "4a0c8174e3f41c8194795202994d23b76fc56d99f1f84020c4d9cadd7343d5ce"},
+        {0, 0x81, "8cd38ef9f23f14f2888583e2ddfec3b120f67241df40b0b7c4499cbb1485086f"},
+        {1, 0x83, "3d9f9c9ea35c3e544ec3bd28e6b6f429db51d12532d136d6d9216486f3a09dd5"},
+    };
+    for (const auto& [index, hashType, hash] : expected) {
+        EXPECT_EQ(hex(transaction.getSignatureHashTaproot(index, hashType, spentOutputs)), hash) << int(hashType);
+    }
+    transaction.cacheTaprootSignatureHashes(spentOutputs);
+    for (const auto& [index, hashType, hash] : expected) {
+        EXPECT_EQ(hex(transaction.getSignatureHashTaproot(index, hashType, spentOutputs)), hash) << int(hashType);
+    }
+    transaction.clearSignatureHashCache();
+
+    EXPECT_TRUE(transaction.getSignatureHashTaproot(0, 0x04, spentOutputs).empty());
+    EXPECT_TRUE(transaction.getSignatureHashTaproot(0, 0x80, spentOutputs).empty());
+    EXPECT_TRUE(transaction.getSignatureHashTaproot(2, 0x00, spentOutputs).empty());
+    EXPECT_TRUE(transaction.getSignatureHashTaproot(0, 0x00, {spentOutputs[0]}).empty());
+    transaction.outputs.pop_back();
+    EXPECT_TRUE(transaction.getSignatureHashTaproot(1, 0x03, spentOutputs).empty());
+}
+
+TEST(BitcoinTaproot, SignKeyPath) {
+    const auto key = PrivateKey(parse_hex("0000000000000000000000000000000000000000000000000000000000000007"));
+    const auto address = SegwitAddress::taproot(key.getPublicKey(TWPublicKeyTypeSECP256k1), "bc");
+    const auto script = Script::lockScriptForAddress(address.string(), TWCoinTypeBitcoin);
+
+    auto input = Proto::SigningInput();
+    input.set_hash_type(TWBitcoinSigHashTypeAll);
+    input.set_amount(60'000);
+    input.set_byte_fee(1);
+    input.set_to_address("bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4");
+    input.set_change_address(address.string());
+    const auto otherKey = PrivateKey(Data(32, 1));
+    input.add_private_key(otherKey.bytes.data(), otherKey.bytes.size());
+    input.add_private_key(key.bytes.data(), key.bytes.size());
+    const auto hash = parse_hex("fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f");
+    auto utxo = input.add_utxo();
+    utxo->set_script(script.bytes.data(), script.bytes.size());
+    utxo->set_amount(100'000);
+    utxo->mutable_out_point()->set_hash(hash.data(), hash.size());
+    utxo->mutable_out_point()->set_index(0);
+    utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+
+    auto signer = TransactionSigner<Transaction, TransactionBuilder>(input);
+    const auto result = signer.sign();
+    ASSERT_TRUE(result) << std::to_string(result.error());
+    const auto& signedTransaction = result.payload();
+    ASSERT_EQ(signedTransaction.inputs.size(), 1);
+    EXPECT_TRUE(signedTransaction.inputs[0].script.empty());
+    ASSERT_EQ(signedTransaction.inputs[0].scriptWitness.size(), 1);
+    const auto& signature = signedTransaction.inputs[0].scriptWitness[0];
+    EXPECT_EQ(signature.size(), 64);
+
+    const auto spentOutputs = std::vector<TransactionOutput>{TransactionOutput(100'000, script)};
+    const auto sighash = signer.transaction.getSignatureHashTaproot(0, 0, spentOutputs);
+    EXPECT_TRUE(Bip340::verify(address.witnessProgram, sighash, signature));
+
+    // without the key
+    input.clear_private_key();
+    input.add_private_key(otherKey.bytes.data(), otherKey.bytes.size());
+    const auto missing = TransactionSigner<Transaction, TransactionBuilder>(input).sign();
+    ASSERT_FALSE(missing);
+    EXPECT_EQ(missing.error(), Common::Proto::Error_missing_private_key);
+}
+
+} // namespace TW::Bitcoin
@@ -9,7 +9,10 @@
 #include "Bitcoin/Script.h"
 #include "Bitcoin/TransactionPlan.h"
 #include "Bitcoin/TransactionBuilder.h"
+#include "Bitcoin/TransactionSigner.h"
+#include "Bitcoin/UtxoSource.h"
 #include "Bitcoin/FeeCalculator.h"
+#include "HexCoding.h"
 #include "proto/Bitcoin.pb.h"
 #include <TrustWalletCore/TWCoinType.h>
 
@@ -569,3 +572,198 @@ TEST(TransactionPlan, LotsofUtxosMax) {
     EXPECT_EQ(filteredValueSum, 50'039'500);
     EXPECT_TRUE(verifyPlan(txPlan, filteredValues, 48'579'780, 1'459'720));
 }
+
+TEST(TransactionPlan, BranchAndBoundNoChange) {
+    auto utxos = buildTestUTXOs({4000, 2102, 3143, 10000});
+    auto sigingInput = buildSigningInput(5000, 1, utxos);
+    sigingInput.set_utxo_selection(Proto::BRANCH_AND_BOUND);
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    // the excess goes to the fee
+    EXPECT_TRUE(verifyPlan(txPlan, {3143, 2102}, 5000, 245));
+    EXPECT_EQ(txPlan.change, 0);
+}
+
+TEST(TransactionPlan, BranchAndBoundFallback) {
+    auto utxos = buildTestUTXOs({3000, 3000, 7000, 50000});
+    auto sigingInput = buildSigningInput(5000, 1, utxos);
+    sigingInput.set_utxo_selection(Proto::BRANCH_AND_BOUND);
+
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+
+    EXPECT_EQ(txPlan.error, Common::Proto::OK);
+    EXPECT_TRUE(verifySelectedUTXOs(txPlan.utxos, {3000, 3000}));
+    EXPECT_EQ(txPlan.amount, 5000);
+    EXPECT_GT(txPlan.change, 0);
+}
+
+/// Test UTXOs which spend different outpoints.
+static std::vector<Proto::UnspentTransaction> buildDistinctTestUTXOs(const std::vector<int64_t>& amounts) {
+    auto utxos = buildTestUTXOs(amounts);
+    for (size_t i = 0; i < utxos.size(); ++i) {
+        utxos[i].mutable_out_point()->set_index(static_cast<uint32_t>(i));
+    }
+    return utxos;
+}
+
+TEST(TransactionPlan, BumpFeeFromChange) {
+    auto utxos = buildDistinctTestUTXOs({10'000, 100'000, 60'000});
+    auto sigingInput = buildSigningInput(50'000, 1, utxos);
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+    EXPECT_TRUE(verifyPlan(txPlan, {100'000}, 50'000, 147));
+
+    auto bumped = TransactionBuilder::bumpFee(txPlan, sigingInput, 10);
+    EXPECT_TRUE(verifyPlan(bumped, {100'000}, 50'000, 1'470));
+    EXPECT_EQ(bumped.utxos[0].out_point().index(), txPlan.utxos[0].out_point().index());
+    EXPECT_EQ(bumped.change, 100'000 - 50'000 - 1'470);
+
+    // the replacement pays at least its relay over the replaced fee
+    auto same = TransactionBuilder::bumpFee(txPlan, sigingInput, 1);
+    EXPECT_TRUE(verifyPlan(same, {100'000}, 50'000, 147 + 147));
+}
+
+TEST(TransactionPlan, BumpFeeAddsInputs) {
+    auto utxos = buildDistinctTestUTXOs({20'000, 50'500, 10'000, 30'000});
+    auto sigingInput = buildSigningInput(50'000, 1, utxos);
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+    ASSERT_TRUE(verifySelectedUTXOs(txPlan.utxos, {50'500}));
+
+    // the largest remaining UTXO is added, after the previous one
+    auto bumped = TransactionBuilder::bumpFee(txPlan, sigingInput, 20);
+    EXPECT_EQ(bumped.error, Common::Proto::OK);
+    EXPECT_TRUE(verifySelectedUTXOs(bumped.utxos, {50'500, 30'000}));
+    EXPECT_EQ(bumped.amount, 50'000);
+    EXPECT_EQ(bumped.amount + bumped.change + bumped.fee, bumped.availableAmount);
+    EXPECT_GE(bumped.fee, 20 * 200);
+
+    auto insufficient = TransactionBuilder::bumpFee(txPlan, sigingInput, 1'000);
+    EXPECT_EQ(insufficient.error, Common::Proto::Error_not_enough_utxos);
+
+    auto failed = txPlan;
+    failed.error = Common::Proto::Error_not_enough_utxos;
+    EXPECT_EQ(TransactionBuilder::bumpFee(failed, sigingInput, 10).error, Common::Proto::Error_not_enough_utxos);
+}
+
+TEST(TransactionPlan, BumpFeeMaxAmount) {
+    auto utxos = buildDistinctTestUTXOs({10'000, 20'000});
+    auto sigingInput = buildSigningInput(0, 1, utxos, true);
+    auto txPlan = TransactionBuilder::plan(sigingInput);
+    ASSERT_EQ(txPlan.error, Common::Proto::OK);
+
+    auto bumped = TransactionBuilder::bumpFee(txPlan, sigingInput, 5);
+    EXPECT_EQ(bumped.error, Common::Proto::OK);
+    EXPECT_EQ(bumped.utxos.size(), txPlan.utxos.size());
+    EXPECT_EQ(bumped.change, 0);
+    EXPECT_EQ(bumped.fee, 5 * txPlan.fee);
+    EXPECT_EQ(bumped.amount, txPlan.availableAmount - bumped.fee);
+}
+
+TEST(TransactionPlan, ChildPaysForParent) {
+    auto utxos = buildDistinctTestUTXOs({100'000});
+    auto sigingInput = buildSigningInput(50'000, 10, utxos);
+    auto child = TransactionBuilder::plan(sigingInput);
+    ASSERT_EQ(child.error, Common::Proto::OK);
+
+    // parent of 200 vbytes paid 1 satoshi per vbyte
+    auto cpfp = TransactionBuilder::planChildPaysForParent(sigingInput, 200, 200);
+    EXPECT_TRUE(verifyPlan(cpfp, {100'000}, 50'000, child.fee + 200 * 10 - 200));
+    // the parent pays enough already
+    cpfp = TransactionBuilder::planChildPaysForParent(sigingInput, 200, 5'000);
+    EXPECT_TRUE(verifyPlan(cpfp, {100'000}, 50'000, child.fee));
+}
+
+namespace {
+
+/// Source counting the materialized UTXOs.
+class CountingUtxoSource : public UtxoSource {
+  public:
+    explicit CountingUtxoSource(const UtxoSource& source) : source(source) {}
+
+    std::size_t size() const override { return source.size(); }
+    Amount amount(std::size_t index) const override { return source.amount(index); }
+    Proto::UnspentTransaction utxo(std::size_t index) const override {
+        ++materialized;
+        return source.utxo(index);
+    }
+
+    mutable std::size_t materialized = 0;
+
+  private:
+    const UtxoSource& source;
+};
+
+CompactUtxoSource compactSource(const std::vector<Proto::UnspentTransaction>& utxos) {
+    CompactUtxoSource source;
+    for (const auto& utxo : utxos) {
+        std::array<byte, 32> hash;
+        std::copy(utxo.out_point().hash().begin(), utxo.out_point().hash().end(), hash.begin());
+        source.add(hash, utxo.out_point().index(), utxo.out_point().sequence(), utxo.amount(),
+                   Data(utxo.script().begin(), utxo.script().end()));
+    }
+    return source;
+}
+
+} // namespace
+
+TEST(TransactionPlan, UtxoSource) {
+    auto amounts = std::vector<int64_t>();
+    for (auto i = 0; i < 200; ++i) {
+        amounts.push_back(10'000 + 997 * i);
+    }
+    const auto utxos = buildTestUTXOs(amounts);
+    const auto source = compactSource(utxos);
+    // the UTXOs of the same address share their script
+    EXPECT_EQ(source.scripts().size(), 1ul);
+    EXPECT_EQ(source.size(), utxos.size());
+
+    for (const auto selection : {Proto::FEWEST_INPUTS, Proto::KNAPSACK, Proto::BRANCH_AND_BOUND}) {
+        for (const auto amount : {Amount(50'000), Amount(1'000'000), Amount(100'000'000)}) {
+            auto input = buildSigningInput(amount, 1, utxos);
+            input.set_utxo_selection(selection);
+            const auto expected = TransactionBuilder::plan(input);
+            input.clear_utxo();
+            const auto counting = CountingUtxoSource(source);
+            const auto plan = TransactionBuilder::plan(input, counting);
+            EXPECT_EQ(plan.proto().SerializeAsString(), expected.proto().SerializeAsString()) << selection << " " << amount;
+            EXPECT_EQ(counting.materialized, plan.utxos.size());
+        }
+    }
+
+    // signed with the plan, the input needs no UTXO list
+    auto input = buildSigningInput(1'000'000, 1, utxos);
+    const auto expected = TransactionSigner<Transaction, TransactionBuilder>(input).sign();
+    input.clear_utxo();
+    *input.mutable_plan() = TransactionBuilder::plan(input, source).proto();
+    const auto signedTransaction = TransactionSigner<Transaction, TransactionBuilder>(input).sign();
+    ASSERT_TRUE(expected);
+    ASSERT_TRUE(signedTransaction);
+    Data encoded;
+    Data expectedEncoded;
+    signedTransaction.payload().encode(encoded);
+    expected.payload().encode(expectedEncoded);
+    EXPECT_EQ(hex(encoded), hex(expectedEncoded));
+}
+
+TEST(TransactionPlan, CompactUtxoSourceRecords) {
+    const auto script = parse_hex("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1");
+    auto records = std::vector<UtxoRecord>(3);
+    for (uint32_t i = 0; i < records.size(); ++i) {
+        records[i] = UtxoRecord{Amount(1000 * (i + 1)), {}, i, UINT32_MAX, 0};
+        records[i].hash[0] = static_cast<byte>(i);
+    }
+    const auto source = CompactUtxoSource(records.data(), records.size(), {script});
+    EXPECT_EQ(source.size(), 3ul);
+    EXPECT_EQ(source.amount(2), 3000);
+    const auto utxo = source.utxo(1);
+    EXPECT_EQ(utxo.amount(), 2000);
+    EXPECT_EQ(utxo.out_point().index(), 1u);
+    EXPECT_EQ(utxo.out_point().sequence(), UINT32_MAX);
+    EXPECT_EQ(hex(utxo.out_point().hash()), "01" + std::string(62, '0'));
+    EXPECT_EQ(hex(utxo.script()), hex(script));
+
+    records[0].script = 1;
+    EXPECT_THROW(CompactUtxoSource(records.data(), records.size(), {script}), std::invalid_argument);
+    auto external = CompactUtxoSource(records.data() + 1, 2, {script});
+    EXPECT_THROW(external.add({}, 0, 0, 1, script), std::logic_error);
+}
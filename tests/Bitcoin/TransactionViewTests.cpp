@@ -0,0 +1,165 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Bitcoin/OpCodes.h"
+#include "Bitcoin/TransactionView.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "Zcash/Transaction.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace TW::Bitcoin {
+
+static Data concat(Data prefix, const Data& suffix) {
+    append(prefix, suffix);
+    return prefix;
+}
+
+static std::string reversedHex(Data hash) {
+    std::reverse(hash.begin(), hash.end());
+    return hex(hash);
+}
+
+TEST(BitcoinTransactionView, Genesis) {
+    const auto raw = parse_hex("01000000010000000000000000000000000000000000000000000000000000000000000000ffffffff4d04ffff001d0104455468652054696d65732030332f4a616e2f32303039204368616e63656c6c6f72206f6e206272696e6b206f66207365636f6e64206261696c6f757420666f722062616e6b73ffffffff0100f2052a01000000434104678afdb0fe5548271967f1a67130b7105cd6a828e03909a67962e0ea1f61deb649f6bc3f4cef38c4f35504e51ec112de5c384df7ba0b8d578a4c702b6bf11d5fac00000000");
+    const auto view = TransactionView::decode(raw);
+    EXPECT_FALSE(view.hasWitness());
+    EXPECT_EQ(view.version, 1);
+    ASSERT_EQ(view.inputs.size(), 1);
+    EXPECT_EQ(view.inputs[0].previousIndex, UINT32_MAX);
+    EXPECT_EQ(view.inputs[0].script.size(), 77);
+    EXPECT_EQ(view.inputs[0].script.data(), raw.data() + 42);
+    ASSERT_EQ(view.outputs.size(), 1);
+    EXPECT_EQ(view.outputs[0].value, 5'000'000'000);
+    EXPECT_EQ(view.outputs[0].type(), ScriptType::payToPublicKey);
+    EXPECT_EQ(reversedHex(view.txid()), "4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b");
+    EXPECT_EQ(hex(view.wtxid()), hex(view.txid()));
+
+    Data encoded;
+    view.toTransaction().encode(encoded);
+    EXPECT_EQ(hex(encoded), hex(raw));
+}
+
+TEST(BitcoinTransactionView, Witness) {
+    auto transaction = Transaction(2, 700'000);
+    transaction.inputs.emplace_back(OutPoint(Data(32, 1), 3), Script(), 0xfffffffd);
+    transaction.inputs.emplace_back(OutPoint(Data(32, 2), 0), Script(concat(parse_hex("160014"), Data(20, 7))), UINT32_MAX);
+    transaction.inputs[0].scriptWitness = {Data(71, 0x30), Data(33, 0x02)};
+    transaction.inputs[1].scriptWitness = {Data(), Data(300, 0xab)};
+    transaction.outputs.emplace_back(1'000, Script::buildPayToTaproot(Data(32, 3)));
+    transaction.outputs.emplace_back(2'000, Script::buildPayToWitnessScriptHash(Data(32, 4)));
+    transaction.outputs.emplace_back(0, Script(Data{OP_RETURN, 0x02, 0xab, 0xcd}));
+    Data raw;
+    transaction.encode(raw, Transaction::Segwit);
+    Data nonWitness;
+    transaction.encode(nonWitness, Transaction::NonSegwit);
+
+    const auto view = TransactionView::decode(raw);
+    EXPECT_TRUE(view.hasWitness());
+    EXPECT_EQ(view.lockTime, 700'000);
+    ASSERT_EQ(view.inputs.size(), 2);
+    EXPECT_EQ(hex(view.inputs[1].script), hex(transaction.inputs[1].script.bytes));
+    ASSERT_EQ(view.inputs[1].witness.size(), 2);
+    EXPECT_TRUE(view.inputs[1].witness[0].empty());
+    EXPECT_EQ(view.inputs[1].witness[1].size(), 300);
+    ASSERT_EQ(view.outputs.size(), 3);
+    EXPECT_EQ(view.outputs[0].type(), ScriptType::payToTaproot);
+    EXPECT_EQ(view.outputs[1].type(), ScriptType::payToWitnessScriptHash);
+    EXPECT_EQ(view.outputs[2].type(), ScriptType::nullData);
+
+    EXPECT_EQ(hex(view.txid()), hex(Hash::sha256d(nonWitness.data(), nonWitness.size())));
+    EXPECT_EQ(hex(view.wtxid()), hex(Hash::sha256d(raw.data(), raw.size())));
+    EXPECT_EQ(hex(TransactionView::decode(nonWitness).txid()), hex(view.txid()));
+
+    Data encoded;
+    view.toTransaction().encode(encoded);
+    EXPECT_EQ(hex(encoded), hex(raw));
+
+    // Groestlcoin ids are a single SHA256
+    const auto groestl = TransactionView::decode(raw, TransactionView::Format::groestlcoin);
+    EXPECT_EQ(hex(groestl.txid()), hex(Hash::sha256(nonWitness)));
+    EXPECT_EQ(hex(groestl.wtxid()), hex(Hash::sha256(raw)));
+}
+
+TEST(BitcoinTransactionView, ComputeIds) {
+    Data storage[8];
+    std::vector<TransactionView> views;
+    for (uint32_t i = 0; i < 8; ++i) {
+        auto transaction = Transaction(1, i);
+        transaction.inputs.emplace_back(OutPoint(Data(32, static_cast<byte>(i)), i), Script(), UINT32_MAX);
+        if (i % 2 == 0) {
+            transaction.inputs[0].scriptWitness = {Data(64, static_cast<byte>(i))};
+        }
+        transaction.outputs.emplace_back(i * 1'000, Script::buildPayToWitnessPublicKeyHash(Data(20, 1)));
+        transaction.encode(storage[i]);
+        views.push_back(TransactionView::decode(storage[i]));
+    }
+    std::vector<Data> txids;
+    std::vector<Data> wtxids;
+    TransactionView::computeIds(views, txids, wtxids, 3);
+    ASSERT_EQ(txids.size(), 8);
+    ASSERT_EQ(wtxids.size(), 8);
+    for (size_t i = 0; i < 8; ++i) {
+        EXPECT_EQ(hex(txids[i]), hex(views[i].txid()));
+        EXPECT_EQ(hex(wtxids[i]), hex(views[i].wtxid()));
+        EXPECT_EQ(txids[i] == wtxids[i], i % 2 == 1);
+    }
+}
+
+TEST(BitcoinTransactionView, Zcash) {
+    auto transaction = Zcash::Transaction();
+    transaction.lockTime = 0x0004b029;
+    transaction.expiryHeight = 0x0004b048;
+    transaction.inputs.emplace_back(OutPoint(parse_hex("a8c685478265f4c14dada651969c45a65e1aeb8cd6791f2f5bb6a1d9952104d9"), 1), Script(parse_hex("51")), 0xfffffffe);
+    transaction.outputs.emplace_back(0x02625a00, Script(parse_hex("76a9148132712c3ff19f3a151234616777420a6d7ef22688ac")));
+    Data raw;
+    transaction.encode(raw);
+
+    const auto view = TransactionView::decode(raw, TransactionView::Format::zcash);
+    EXPECT_EQ(view.versionGroupId, 0x892F2085);
+    EXPECT_EQ(view.expiryHeight, 0x0004b048);
+    EXPECT_EQ(view.outputs[0].type(), ScriptType::payToPublicKeyHash);
+    EXPECT_EQ(hex(view.shieldedData), "000000");
+    EXPECT_EQ(hex(view.txid()), hex(Hash::sha256d(raw.data(), raw.size())));
+    EXPECT_THROW(view.toTransaction(), std::invalid_argument);
+
+    // one shielded spend, with the binding signature
+    auto shielded = Data(raw.begin(), raw.end() - 3);
+    append(shielded, 0x01);
+    append(shielded, Data(384, 0x11));
+    append(shielded, Data{0x00, 0x00});
+    append(shielded, Data(64, 0x22));
+    EXPECT_EQ(TransactionView::decode(shielded, TransactionView::Format::zcash).shieldedData.size(), 1 + 384 + 2 + 64);
+    EXPECT_THROW(TransactionView::decode(Data(shielded.begin(), shielded.end() - 1), TransactionView::Format::zcash), std::invalid_argument);
+
+    // not a Sapling transaction
+    EXPECT_THROW(TransactionView::decode(raw), std::invalid_argument);
+}
+
+TEST(BitcoinTransactionView, Invalid) {
+    auto transaction = Transaction(1, 0);
+    transaction.inputs.emplace_back(OutPoint(Data(32, 1), 0), Script(), UINT32_MAX);
+    transaction.outputs.emplace_back(1'000, Script::buildPayToScriptHash(Data(20, 1)));
+    Data raw;
+    transaction.encode(raw);
+    EXPECT_EQ(TransactionView::decode(raw).outputs[0].type(), ScriptType::payToScriptHash);
+
+    for (size_t size = 0; size < raw.size(); ++size) {
+        EXPECT_THROW(TransactionView::decode(DataView(raw.data(), size)), std::invalid_argument) << size;
+    }
+    append(raw, 0x00);
+    EXPECT_THROW(TransactionView::decode(raw), std::invalid_argument);
+    // huge input count
+    EXPECT_THROW(TransactionView::decode(parse_hex("01000000ffffffffffffffffff")), std::invalid_argument);
+
+    EXPECT_EQ(classifyScript(concat(parse_hex("5121"), Data(33, 2))), ScriptType::nonStandard);
+    EXPECT_EQ(classifyScript(Data()), ScriptType::nonStandard);
+}
+
+} // namespace TW::Bitcoin
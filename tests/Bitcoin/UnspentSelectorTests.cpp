@@ -383,3 +383,45 @@ TEST(BitcoinUnspentSelector, SelectZcashMaxUnspents2) {
 
     EXPECT_TRUE(verifySelectedUTXOs(selected, {}));
 }
+
+TEST(BitcoinUnspentSelector, SelectBranchAndBound) {
+    // effective values (less 102 input fee): 3898, 2000, 3041, 9898; 2000 + 3041 = 5000 + 41 single output fee
+    auto utxos = buildTestUTXOs({4000, 2102, 3143, 10000});
+
+    auto selector = UnspentSelector();
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(utxos, 5000, 1), {3143, 2102}));
+    // within the cost of change (133)
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(utxos, 4900, 1), {3143, 2102}));
+    // no combination without change
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(utxos, 4800, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(utxos, 50000, 1), {}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectBranchAndBound(utxos, 0, 1), {}));
+}
+
+TEST(BitcoinUnspentSelector, SelectKnapsack) {
+    auto selector = UnspentSelector();
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(buildTestUTXOs({1000, 2000, 6000, 50000}), 5000, 1), {6000}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(buildTestUTXOs({3000, 3000, 7000, 50000}), 5000, 1), {3000, 3000}));
+    EXPECT_TRUE(verifySelectedUTXOs(selector.selectKnapsack(buildTestUTXOs({3000, 3000}), 10000, 1), {}));
+}
+
+TEST(BitcoinUnspentSelector, SelectManyUnspents) {
+    std::vector<int64_t> amounts;
+    for (auto i = 0; i < 30000; ++i) {
+        amounts.push_back(1000 + (i * 7919) % 100000);
+    }
+    const auto utxos = buildTestUTXOs(amounts);
+    auto selector = UnspentSelector();
+
+    const auto selected = selector.select(utxos, 1'000'000, 1);
+    EXPECT_GE(sumUTXOs(selected), 1'000'000);
+    EXPECT_LE(selected.size(), 15);
+
+    const auto exact = selector.selectBranchAndBound(utxos, 1'000'000, 1);
+    ASSERT_FALSE(exact.empty());
+    const auto inputFees = int64_t(102) * exact.size();
+    EXPECT_GE(sumUTXOs(exact) - inputFees, 1'000'000 + 41);
+    EXPECT_LE(sumUTXOs(exact) - inputFees, 1'000'000 + 41 + 133);
+
+    EXPECT_GE(sumUTXOs(selector.selectKnapsack(utxos, 1'000'000, 1)), 1'000'000);
+}
@@ -5,7 +5,9 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Bitcoin/Address.h"
+#include "Bitcoin/CashAddress.h"
 #include "Bitcoin/SigHashType.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include "proto/Bitcoin.pb.h"
 #include "../interface/TWTestUtilities.h"
@@ -19,6 +21,7 @@
 #include <TrustWalletCore/TWHDWallet.h>
 #include <TrustWalletCore/TWHash.h>
 #include <TrustWalletCore/TWPrivateKey.h>
+#include <TrezorCrypto/cash_addr.h>
 
 #include <gtest/gtest.h>
 
@@ -71,6 +74,49 @@ TEST(BitcoinCash, LockScript) {
     assertHexEqual(scriptData2, "a914b9604b7820876bc510009b8247316c4b801aff8a87");
 }
 
+TEST(BitcoinCash, CashAddressEncoding) {
+    // same as trezor-crypto
+    for (int i = 0; i < 64; ++i) {
+        auto payload = Hash::sha256(Data{static_cast<byte>(i)});
+        payload.resize(CashAddress::payloadSize);
+        payload[0] = i % 2 == 0 ? 0x00 : 0x08;
+        std::array<char, 129> expected;
+        ASSERT_EQ(cash_addr_encode(expected.data(), "bitcoincash", payload.data(), payload.size()), 1);
+
+        const auto address = CashAddress(expected.data());
+        EXPECT_EQ(address.string(), expected.data());
+        EXPECT_EQ(hex(address.payload()), hex(payload));
+    }
+
+    const auto string = std::string("bitcoincash:qpk05r5kcd8uuzwqunn8rlx5xvuvzjqju5rch3tc0u");
+    EXPECT_TRUE(CashAddress::isValid(string));
+    EXPECT_TRUE(CashAddress::isValid(string.substr(12)));
+    EXPECT_FALSE(CashAddress::isValid(std::string("bitcoincash:qpk05r5kcd8uuzwqunn8rlx5xvuvzjqju5rch3tc0v")));
+    EXPECT_FALSE(CashAddress::isValid(std::string("bitcoincash:qpk05r5kcd8uuzwqunn8rlx5xvuvzjqju5rch3tc0")));
+    EXPECT_FALSE(CashAddress::isValid(std::string("bchtest:qpk05r5kcd8uuzwqunn8rlx5xvuvzjqju5rch3tc0u")));
+    EXPECT_FALSE(CashAddress::isValid(std::string("bitcoincash:QPK05R5KCD8UUZWQUNN8RLX5XVUVZJQJU5RCH3TC0U")));
+    EXPECT_FALSE(CashAddress::isValid(std::string("")));
+}
+
+TEST(BitcoinCash, CashAddressBatch) {
+    const auto cash = std::vector<std::string>{
+        "bitcoincash:qpk05r5kcd8uuzwqunn8rlx5xvuvzjqju5rch3tc0u",
+        "pzukqjmcyzrkh3gsqzdcy3e3d39cqxhl3g0f405k5l",
+        "bitcoincash:qpk05r5kcd8uuzwqunn8rlx5xvuvzjqju5rch3tc0v",
+    };
+    EXPECT_EQ(CashAddress::validate(cash), std::vector<bool>({true, true, false}));
+    EXPECT_TRUE(CashAddress::validate({}).empty());
+
+    const auto legacy = CashAddress::toLegacy(cash);
+    ASSERT_EQ(legacy.size(), 3);
+    EXPECT_EQ(legacy[0], "1AwDXywmyhASpCCFWkqhySgZf8KiswFoGh");
+    EXPECT_EQ(legacy[1], Address(parse_hex("05b9604b7820876bc510009b8247316c4b801aff8a")).string());
+    EXPECT_EQ(legacy[2], "");
+
+    const auto converted = CashAddress::fromLegacy({legacy[0], legacy[1], "invalid", "LV7LV7Z4bWDEjYkfx9dQo6k6RjGbXsg6hS"});
+    EXPECT_EQ(converted, std::vector<std::string>({cash[0], "bitcoincash:" + cash[1], "", ""}));
+}
+
 TEST(BitcoinCash, ExtendedKeys) {
     auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(
         STRING("ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal").get(),
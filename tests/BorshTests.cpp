@@ -0,0 +1,56 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Borsh.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Borsh {
+
+template <typename Output>
+static void writeSample(Output& output) {
+    output.writeU8(7);
+    output.writeU32(0x01020304);
+    output.writeU64(5);
+    output.writeBytes(std::string("near"));
+    output.writeBytes(parse_hex("abcd"));
+    output.writeRaw(parse_hex("ff"));
+}
+
+TEST(Borsh, WriteRead) {
+    SizeCounter counter;
+    writeSample(counter);
+    Data data;
+    Writer writer(data);
+    writeSample(writer);
+    EXPECT_EQ(hex(data), "07040302010500000000000000040000006e65617202000000abcdff");
+    EXPECT_EQ(counter.size, data.size());
+
+    Reader reader(data);
+    uint8_t u8 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    DataView bytes;
+    ASSERT_TRUE(reader.readU8(u8));
+    ASSERT_TRUE(reader.readU32(u32));
+    ASSERT_TRUE(reader.readU64(u64));
+    EXPECT_EQ(u8, 7);
+    EXPECT_EQ(u32, 0x01020304u);
+    EXPECT_EQ(u64, 5u);
+    ASSERT_TRUE(reader.readBytes(bytes));
+    EXPECT_EQ(hex(bytes), "6e656172");
+    EXPECT_EQ(bytes.data(), data.data() + 17);
+    ASSERT_TRUE(reader.readBytes(bytes));
+    EXPECT_EQ(hex(bytes), "abcd");
+    EXPECT_EQ(reader.remaining(), 1u);
+    EXPECT_FALSE(reader.readU32(u32));
+    EXPECT_FALSE(reader.readBytes(bytes));
+    ASSERT_TRUE(reader.readRaw(1, bytes));
+    EXPECT_FALSE(reader.readU8(u8));
+}
+
+} // namespace TW::Borsh
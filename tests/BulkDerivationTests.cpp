@@ -0,0 +1,103 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "BulkDerivation.h"
+#include "Coin.h"
+#include "HDWallet.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+namespace TW {
+
+namespace {
+
+const std::vector<std::string> mnemonics = {
+    "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal",
+    // checksum mismatch
+    "scissors ripple kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal",
+    "credit expect life fade cover suit response wash pear what skull force",
+    "not a mnemonic",
+    "shoot island position soft burden budget tooth cruel issue economy destroy above",
+};
+
+const std::vector<DerivationPath> paths = {
+    DerivationPath("m/44'/60'/0'/0/0"),
+    DerivationPath("m/44'/60'/0'/0/1"),
+    DerivationPath("m/44'/60'/1'/0/0"),
+};
+
+std::vector<std::string> expectedAddresses(TWCoinType coin, const std::string& mnemonic, const std::string& passphrase,
+                                           const std::vector<DerivationPath>& paths) {
+    const auto wallet = HDWallet(mnemonic, passphrase);
+    std::vector<std::string> addresses;
+    for (const auto& path : paths) {
+        addresses.push_back(TW::deriveAddress(coin, wallet.getKey(coin, path)));
+    }
+    return addresses;
+}
+
+/// CPU backend counting its calls, with small batches.
+class CountingBackend : public BulkDerivationBackend {
+  public:
+    std::atomic<std::size_t> seedCount{0};
+    std::atomic<std::size_t> publicKeyCalls{0};
+
+    std::vector<std::array<byte, HDWallet::seedSize>> seeds(const std::vector<std::string>& mnemonics,
+                                                            const std::vector<std::string>& passphrases) override {
+        EXPECT_LE(mnemonics.size(), seedBatchSize());
+        seedCount += mnemonics.size();
+        return BulkDerivationBackend::seeds(mnemonics, passphrases);
+    }
+
+    bool publicKeys(const byte* privateKeys, std::size_t count, bool compressed, byte* publicKeys) override {
+        ++publicKeyCalls;
+        return BulkDerivationBackend::publicKeys(privateKeys, count, compressed, publicKeys);
+    }
+
+    std::size_t seedBatchSize() const override { return 2; }
+};
+
+} // namespace
+
+TEST(BulkDerivation, Ethereum) {
+    const auto deriver = BulkDeriver(TWCoinTypeEthereum, paths);
+    const auto addresses = deriver.derive(mnemonics, {"TREZOR"});
+    ASSERT_EQ(addresses.size(), mnemonics.size());
+    for (std::size_t i = 0; i < mnemonics.size(); ++i) {
+        if (i == 1 || i == 3) {
+            EXPECT_TRUE(addresses[i].empty()) << i;
+            continue;
+        }
+        EXPECT_EQ(addresses[i], expectedAddresses(TWCoinTypeEthereum, mnemonics[i], "TREZOR", paths)) << i;
+    }
+    EXPECT_EQ(addresses[0][0], HDWallet(mnemonics[0], "TREZOR").deriveAddresses(TWCoinTypeEthereum, 0, 0, 0, 1)[0]);
+}
+
+TEST(BulkDerivation, Bitcoin) {
+    const auto bitcoinPaths = std::vector<DerivationPath>{DerivationPath("m/84'/0'/0'/0/0"), DerivationPath("m/84'/0'/0'/1/3")};
+    const auto passphrases = std::vector<std::string>{"", "a", "b", "c", "d"};
+    CountingBackend backend;
+    const auto deriver = BulkDeriver(TWCoinTypeBitcoin, bitcoinPaths, &backend);
+    const auto addresses = deriver.derive(mnemonics, passphrases);
+    for (const auto i : {0, 2, 4}) {
+        EXPECT_EQ(addresses[i], expectedAddresses(TWCoinTypeBitcoin, mnemonics[i], passphrases[i], bitcoinPaths)) << i;
+    }
+    // only the valid mnemonics get a seed, in batches of 2
+    EXPECT_EQ(backend.seedCount.load(), 3ul);
+    EXPECT_EQ(backend.publicKeyCalls.load(), 2ul);
+}
+
+TEST(BulkDerivation, Errors) {
+    EXPECT_THROW(BulkDeriver(TWCoinTypeEthereum, {}), std::invalid_argument);
+    const auto deriver = BulkDeriver(TWCoinTypeEthereum, paths);
+    EXPECT_THROW(deriver.derive(mnemonics, {"a", "b"}), std::invalid_argument);
+    EXPECT_TRUE(deriver.derive({}, {""}).empty());
+}
+
+} // namespace TW
@@ -6,6 +6,7 @@
 
 #include "Cardano/AddressV3.h"
 
+#include "Base58.h"
 #include "HDWallet.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
@@ -183,6 +184,41 @@ TEST(CardanoAddress, KeyHashV2) {
     ASSERT_EQ("a1eda96a9952a56c983d9f49117f935af325e8a6c9d38496e945faa8", hex(hash));
 }
 
+TEST(CardanoAddress, DecodeIcarus) {
+    std::array<TW::byte, AddressV2::RootSize> root;
+    ASSERT_TRUE(AddressV2::decodeIcarus("Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvx", root));
+    const auto address = AddressV2("Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvx");
+    EXPECT_EQ(hex(root), hex(address.root));
+    EXPECT_EQ(hex(address.attrs), "a0");
+    EXPECT_EQ(AddressV2::icarusString(root), "Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvx");
+    EXPECT_EQ(hex(address.getCborData()), hex(Base58::bitcoin.decode("Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvx")));
+
+    // invalid checksum
+    EXPECT_FALSE(AddressV2::decodeIcarus("Ae2tdPwUPEZ18ZjTLnLVr9CEvUEUX4eW1LBHbxxxJgxdAYHrDeSCSbCxrvm", root));
+    // V1 address, with attributes
+    EXPECT_FALSE(AddressV2::decodeIcarus("DdzFFzCqrhssmYoG5Eca1bKZFdGS8d6iag1mU4wbLeYcSPVvBNF2wRG8yhjzQqErbg63N6KJA4DHqha113tjKDpGEwS5x1dT2KfLSbSJ", root));
+    EXPECT_TRUE(AddressV2::isValid("DdzFFzCqrhssmYoG5Eca1bKZFdGS8d6iag1mU4wbLeYcSPVvBNF2wRG8yhjzQqErbg63N6KJA4DHqha113tjKDpGEwS5x1dT2KfLSbSJ"));
+    EXPECT_FALSE(AddressV2::decodeIcarus("", root));
+}
+
+TEST(CardanoAddress, DeriveAddressesV2) {
+    auto wallet = HDWallet("cost dash dress stove morning robust group affair stomach vacant route volume yellow salute laugh", "");
+    const auto changeKey = wallet.getKey(TWCoinTypeCardano, DerivationPath("m/44'/1815'/0'/0"));
+    const auto addresses = AddressV2::deriveAddresses(changeKey, 0, 3);
+    ASSERT_EQ(addresses.size(), 3);
+    EXPECT_EQ(addresses[0], "Ae2tdPwUPEZ6RUCnjGHFqi59k5WZLiv3HoCCNGCW8SYc5H9srdTzn1bec4W");
+    EXPECT_EQ(addresses[1], "Ae2tdPwUPEZ7dnds6ZyhQdmgkrDFFPSDh8jG9RAhswcXt1bRauNw5jczjpV");
+    EXPECT_EQ(addresses[2], "Ae2tdPwUPEZ8LAVy21zj4BF97iWxKCmPv12W6a18zLX3V7rZDFFVgqUBkKw");
+
+    const auto more = AddressV2::deriveAddresses(changeKey, 20, 5);
+    for (uint32_t i = 0; i < 5; ++i) {
+        const auto key = wallet.getKey(TWCoinTypeCardano, DerivationPath(TWPurposeBIP44, TWCoinTypeCardano, DerivationPathIndex(0, true).derivationIndex(), 0, 20 + i));
+        EXPECT_EQ(more[i], AddressV2(key.getPublicKey(TWPublicKeyTypeED25519Extended)).string()) << i;
+    }
+
+    EXPECT_THROW(AddressV2::deriveAddresses(PrivateKey(parse_hex("a018cd746e128a0be0782b228c275473205445c33b9000a33dd5668b430b5744")), 0, 1), std::invalid_argument);
+}
+
 TEST(CardanoAddress, FromPublicKeyInternalV3) {
     // tests from chain-lib
     {
@@ -511,3 +511,82 @@ TEST(Cbor, GetTagElementNotTag) {
     }
     FAIL() << "Expected exception";
 }
+
+TEST(Cbor, Writer) {
+    Data data;
+    Writer(data)
+        .arrayHeader(5)
+        .uint(1)
+        .negInt(500)
+        .string("abc")
+        .bytes(parse_hex("0102"))
+        .mapHeader(1)
+            .uint(1000000).tag(24).bytes(Data())
+        ;
+    EXPECT_EQ(hex(data), "85013901f363616263420102a11a000f4240d81840");
+    EXPECT_EQ(hex(data), hex(Encode::array({
+        Encode::uint(1),
+        Encode::negInt(500),
+        Encode::string("abc"),
+        Encode::bytes(parse_hex("0102")),
+        Encode::map({{Encode::uint(1000000), Encode::tag(24, Encode::bytes(Data()))}}),
+    }).encoded()));
+
+    data.clear();
+    Writer(data).uint(0x100000000).raw(parse_hex("f6"));
+    EXPECT_EQ(hex(data), "1b0000000100000000f6");
+    EXPECT_EQ(Writer::headerSize(23), 1);
+    EXPECT_EQ(Writer::headerSize(24), 2);
+    EXPECT_EQ(Writer::headerSize(0x10000), 5);
+}
+
+TEST(Cbor, Reader) {
+    const auto data = parse_hex("85013901f363616263420102a11a000f4240d81840");
+    auto reader = Reader(data);
+    EXPECT_EQ(reader.readArrayHeader(), 5);
+    EXPECT_EQ(reader.readValue(), 1);
+    EXPECT_EQ(reader.peekHeader().majorType, Decode::MT_negint);
+    EXPECT_EQ(reader.readValue(), 499);
+    const auto str = reader.readBytes();
+    EXPECT_EQ(std::string(str.begin(), str.end()), "abc");
+    EXPECT_EQ(hex(reader.readItem()), "420102");
+    const auto mapStart = reader.position();
+    EXPECT_EQ(reader.readMapHeader(), 1);
+    EXPECT_EQ(reader.readValue(), 1000000);
+    EXPECT_EQ(reader.readTag(), 24);
+    EXPECT_EQ(reader.readBytes().size(), 0);
+    EXPECT_TRUE(reader.atEnd());
+
+    // skipping a whole element
+    auto skipping = Reader(DataView(data.data() + mapStart, data.size() - mapStart));
+    skipping.skip();
+    EXPECT_TRUE(skipping.atEnd());
+
+    // indefinite-length array
+    const auto indefiniteData = parse_hex("9f0182020300ff");
+    auto indefinite = Reader(indefiniteData);
+    indefinite.skip();
+    EXPECT_TRUE(indefinite.atEnd());
+    EXPECT_THROW(Reader(parse_hex("9f0102")).skip(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("9f0102ff")).readArrayHeader(), std::invalid_argument);
+}
+
+TEST(Cbor, ReaderInvalid) {
+    EXPECT_THROW(Reader(Data()).readValue(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("1c")).readHeader(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("1a0102")).readValue(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("65616263")).readBytes(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("83010203")).readValue(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("05")).readBytes(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("05")).readTag(), std::invalid_argument);
+    EXPECT_THROW(Reader(parse_hex("a301020304")).skip(), std::invalid_argument);
+
+    // deep nesting
+    Data nested(Reader::maxDepth + 2, 0x81);
+    nested.push_back(0x00);
+    EXPECT_THROW(Reader(nested).skip(), std::invalid_argument);
+    nested.erase(nested.begin(), nested.begin() + 2);
+    auto reader = Reader(nested);
+    reader.skip();
+    EXPECT_TRUE(reader.atEnd());
+}
@@ -111,6 +111,24 @@ TEST(Coin, InitMultithread) {
     ASSERT_EQ(countThreadReady, numThread);
 }
 
+TEST(Coin, Ordinals) {
+    const auto coinTypes = TW::getCoinTypes();
+    ASSERT_EQ(coinTypes.size(), coinCount);
+    std::vector<bool> used(coinCount);
+    for (auto coin : coinTypes) {
+        const auto ordinal = coinOrdinal(coin);
+        ASSERT_LT(ordinal, coinCount);
+        EXPECT_FALSE(used[ordinal]);
+        used[ordinal] = true;
+    }
+    EXPECT_EQ(coinOrdinal(static_cast<TWCoinType>(1)), coinCount);
+
+    EXPECT_EQ(derivationPath(TWCoinTypeBitcoin).string(), "m/84'/0'/0'/0/0");
+    EXPECT_EQ(derivationPath(TWCoinTypeEthereum).string(), "m/44'/60'/0'/0/0");
+    EXPECT_EQ(hex(publicKeyHasher(TWCoinTypeBitcoin)(parse_hex("00").data(), 1)), hex(Hash::sha256ripemd(parse_hex("00").data(), 1)));
+    EXPECT_EQ(hex(base58Hasher(TWCoinTypeGroestlcoin)(parse_hex("00").data(), 1)), hex(Hash::groestl512d(parse_hex("00").data(), 1)));
+}
+
 TEST(Coin, SupportedCoins) {
     const auto coinTypes = TW::getCoinTypes();
     for (auto c: coinTypes) {
@@ -408,4 +408,73 @@ TEST(Coin, ValidateAddresTHORChain) {
     EXPECT_FALSE(validateAddress(TWCoinTypeTHORChain, "thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2s"));
 }
 
+TEST(Coin, ValidateAddresses) {
+    const auto valid = std::vector<std::string>{
+        "bc1q2ddhp55sq2l4xnqhpdv0xazg02v9dr7uu8c2p2",
+        "1BvBMSEYstWetqTFn5Au4m4GFg7xJaNVN2",
+        "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy",
+    };
+    const auto invalid = std::vector<std::string>{
+        "bc1q2ddhp55sq2l4xnqhpdv9xazg02v9dr7uu8c2p2",
+        "MPmoY6RX3Y3HFjGEnFxyuLPCQdjvHwMEny",
+        "",
+    };
+    std::vector<std::string> addresses;
+    for (size_t i = 0; i < 1000; ++i) {
+        addresses.push_back(i % 2 == 0 ? valid[i % 3] : invalid[i % 3]);
+    }
+
+    for (size_t threadCount : {0, 1, 3}) {
+        const auto result = validateAddresses(TWCoinTypeBitcoin, addresses, threadCount);
+        ASSERT_EQ(result.size(), addresses.size());
+        for (size_t i = 0; i < addresses.size(); ++i) {
+            EXPECT_EQ(result[i], i % 2 == 0) << i;
+        }
+    }
+    EXPECT_TRUE(validateAddresses(TWCoinTypeBitcoin, {}).empty());
+    EXPECT_EQ(validateAddresses(TWCoinTypeEthereum, {"0xeDe8F58dADa22c3A49dB60D4f82BAD428ab65F89", valid[0]}), std::vector<bool>({true, false}));
+}
+
+TEST(Coin, ParseAddress) {
+    const std::vector<std::pair<TWCoinType, std::string>> addresses = {
+        {TWCoinTypeEthereum, "0x7d8bf18c7ce84b3e175b339c4ca93aed1dd166f1"},
+        {TWCoinTypeWanchain, "0xb08f432a3346e90e2ab61830ec227043131f70ff"},
+        {TWCoinTypeBitcoin, "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4"},
+        {TWCoinTypeBitcoin, "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy"},
+        {TWCoinTypeBitcoin, "MPmoY6RX3Y3HFjGEnFxyuLPCQdjvHwMEny"},
+        {TWCoinTypeBitcoin, "ltc1qhd8fxxp2dx3vsmpac43z6ev0kllm4n53t5sk0u"},
+        {TWCoinTypeBitcoinCash, "qqslmu0jxk4st3ldjyuazfpf5thd6vlgfuggqd3re4"},
+        {TWCoinTypeDogecoin, "DQkiL71KkuGEgS9QFCKJkBeHmzM5YFYGkG"},
+        {TWCoinTypeDogecoin, "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy"},
+        {TWCoinTypeEthereum, "0x7d8bf18c7ce84b3e175b339c4ca93aed1dd166f"},
+    };
+    for (const auto& [coin, address] : addresses) {
+        const auto parsed = parseAddress(coin, address);
+        EXPECT_EQ(parsed.has_value(), validateAddress(coin, address)) << address;
+        EXPECT_EQ(parsed ? parsed->normalized : "", normalizeAddress(coin, address)) << address;
+    }
+
+    const auto ethereum = parseAddress(TWCoinTypeEthereum, "0x7d8bf18c7ce84b3e175b339c4ca93aed1dd166f1");
+    ASSERT_TRUE(ethereum && ethereum->hasData);
+    EXPECT_EQ(hex(ethereum->data), "7d8bf18c7ce84b3e175b339c4ca93aed1dd166f1");
+    const auto segwit = parseAddress(TWCoinTypeBitcoin, "bc1qw508d6qejxtdg4y5r3zarvary0c5xw7kv8f3t4");
+    ASSERT_TRUE(segwit && segwit->hasData);
+    EXPECT_EQ(hex(segwit->data), "751e76e8199196d454941c45d1b3a323f1433bd6");
+    const auto legacy = parseAddress(TWCoinTypeBitcoin, "3J98t1WpEZ73CNmQviecrnyiWrnqRhWNLy");
+    ASSERT_TRUE(legacy && legacy->hasData);
+    EXPECT_TRUE(legacy->data.empty());
+    const auto dogecoin = parseAddress(TWCoinTypeDogecoin, "DQkiL71KkuGEgS9QFCKJkBeHmzM5YFYGkG");
+    ASSERT_TRUE(dogecoin && dogecoin->hasData);
+    EXPECT_EQ(hex(dogecoin->data), "d726d32d9ff0560e7df35764987fcf01a6a343cf");
+    const auto cash = parseAddress(TWCoinTypeBitcoinCash, "qqslmu0jxk4st3ldjyuazfpf5thd6vlgfuggqd3re4");
+    ASSERT_TRUE(cash);
+    ASSERT_TRUE(cash->hasData);
+    EXPECT_EQ(cash->normalized, "bitcoincash:qqslmu0jxk4st3ldjyuazfpf5thd6vlgfuggqd3re4");
+    EXPECT_EQ(hex(cash->data), "21fdf1f235ab05c7ed9139d12429a2eedd33e84f");
+    // decoded by TWAnyAddressData
+    const auto decred = parseAddress(TWCoinTypeDecred, "Dsb4fb7SfdLPhKVQFapGRGnokncgNiYmkAe");
+    ASSERT_TRUE(decred);
+    EXPECT_FALSE(decred->hasData);
+}
+
 } // namespace TW
@@ -0,0 +1,50 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Coin.h"
+#include "CoinEntry.h"
+#include "HexCoding.h"
+#include "proto/Ethereum.pb.h"
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+TEST(CoinEntry, ScopedSigningArena) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = parse_hex("01");
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(chainId.data(), chainId.size());
+    const auto serialized = input.SerializeAsString();
+    const auto dataIn = Data(serialized.begin(), serialized.end());
+
+    Data expected;
+    anyCoinSign(TWCoinTypeEthereum, dataIn, expected);
+    ASSERT_FALSE(expected.empty());
+
+    google::protobuf::Arena arena;
+    EXPECT_EQ(ScopedSigningArena::current(), nullptr);
+    {
+        ScopedSigningArena scope(arena);
+        EXPECT_EQ(ScopedSigningArena::current(), &arena);
+        Data dataOut;
+        anyCoinSign(TWCoinTypeEthereum, dataIn, dataOut);
+        EXPECT_EQ(hex(dataOut), hex(expected));
+        {
+            google::protobuf::Arena inner;
+            ScopedSigningArena innerScope(inner);
+            EXPECT_EQ(ScopedSigningArena::current(), &inner);
+        }
+        EXPECT_EQ(ScopedSigningArena::current(), &arena);
+    }
+    EXPECT_EQ(ScopedSigningArena::current(), nullptr);
+    EXPECT_GT(arena.SpaceUsed(), 0ul);
+}
+
+} // namespace TW
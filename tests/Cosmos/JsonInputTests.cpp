@@ -0,0 +1,46 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Cosmos/JsonInput.h"
+
+#include <google/protobuf/util/json_util.h>
+#include <gtest/gtest.h>
+
+namespace TW::Cosmos {
+
+static void assertParsesLikeProtobuf(const std::string& json) {
+    auto expected = Proto::SigningInput();
+    ASSERT_TRUE(google::protobuf::util::JsonStringToMessage(json, &expected).ok()) << json;
+    auto input = Proto::SigningInput();
+    ASSERT_TRUE(parseSigningInputJSON(json, input)) << json;
+    EXPECT_EQ(input.SerializeAsString(), expected.SerializeAsString()) << json;
+}
+
+TEST(CosmosJsonInput, MatchesProtobuf) {
+    assertParsesLikeProtobuf(R"({"accountNumber":"8733","chainId":"cosmoshub-2","fee":{"amounts":[{"denom":"uatom","amount":"5000"}],"gas":"200000"}, "memo":"Testing", "messages":[{"sendCoinsMessage":{"fromAddress":"cosmos1ufwv9ymhqaal6xz47n0jhzm2wf4empfqvjy575","toAddress":"cosmos135qla4294zxarqhhgxsx0sw56yssa3z0f78pm0","amounts":[{"denom":"uatom","amount":"995000"}]}}]})");
+    assertParsesLikeProtobuf(R"({"account_number":1037,"sequence":"18446744073709551615","mode":"ASYNC","messages":[{"stake_message":{"delegatorAddress":"a","validator_address":"b","amount":{"denom":"muon","amount":"-10"},"typePrefix":"x"}},{"restakeMessage":{"validatorSrcAddress":"c","validatorDstAddress":"d"}},{"withdrawStakeRewardMessage":{"delegatorAddress":"e"}},{"unstakeMessage":{"amount":{"amount":7}}},{"rawJsonMessage":{"type":"t","value":"{\"k\":1}"}}],"memo":null})");
+    assertParsesLikeProtobuf(R"({"mode":1})");
+    assertParsesLikeProtobuf(R"({})");
+}
+
+TEST(CosmosJsonInput, FallsBack) {
+    auto input = Proto::SigningInput();
+    // handled only by protobuf's parser
+    EXPECT_FALSE(parseSigningInputJSON(R"({"privateKey":"AQI="})", input));
+    // invalid for both
+    EXPECT_FALSE(parseSigningInputJSON(R"({"unknown":1})", input));
+    EXPECT_FALSE(parseSigningInputJSON(R"({"sequence":"1x"})", input));
+    EXPECT_FALSE(parseSigningInputJSON(R"({"sequence":"18446744073709551616"})", input));
+    EXPECT_FALSE(parseSigningInputJSON(R"({"mode":"FAST"})", input));
+    EXPECT_FALSE(parseSigningInputJSON(R"({"messages":[{"stakeMessage":{},"unstakeMessage":{}}]})", input));
+    EXPECT_FALSE(parseSigningInputJSON(R"({"memo":)", input));
+
+    const auto fallback = signingInputFromJSON(R"({"memo":"m","privateKey":"AQI="})");
+    EXPECT_EQ(fallback.memo(), "m");
+    EXPECT_EQ(fallback.private_key(), std::string("\x01\x02"));
+}
+
+} // namespace TW::Cosmos
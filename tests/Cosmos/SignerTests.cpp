@@ -10,6 +10,7 @@
 #include "proto/Cosmos.pb.h"
 #include "Cosmos/Address.h"
 #include "Cosmos/Signer.h"
+#include "PrivateKey.h"
 
 #include <gtest/gtest.h>
 #include <google/protobuf/util/json_util.h>
@@ -98,3 +99,65 @@ TEST(CosmosSigner, SignTxWithMode) {
         ASSERT_EQ(R"({"mode":"sync","tx":{"fee":{"amount":[{"amount":"200","denom":"muon"}],"gas":"200000"},"memo":"","msg":[{"type":"cosmos-sdk/MsgSend","value":{"amount":[{"amount":"1","denom":"muon"}],"from_address":"cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02","to_address":"cosmos1zt50azupanqlfam5afhv3hexwyutnukeh4c573"}}],"signatures":[{"pub_key":{"type":"tendermint/PubKeySecp256k1","value":"AlcobsPzfTNVe7uqAAsndErJAjqplnyudaGB0f+R+p3F"},"signature":"/D74mdIGyIB3/sQvIboLTfS9P9EV/fYGrgHZE2/vNj9X6eM6e57G3atljNB+PABnRw3pTk51uXmhCFop8O/ZJg=="}]}})", output.json());
     }
 }
+
+TEST(CosmosSigner, SignTxProtobuf) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::Protobuf);
+    input.set_account_number(546179);
+    input.set_chain_id("cosmoshub-4");
+    input.set_memo("");
+    input.set_sequence(0);
+
+    auto fromAddress = Address("cosmos", parse_hex("BC2DA90C84049370D1B7C528BC164BC588833F21"));
+    auto toAddress = Address("cosmos", parse_hex("12E8FE8B81ECC1F4F774EA6EC8DF267138B9F2D9"));
+
+    auto msg = input.add_messages();
+    auto& message = *msg->mutable_send_coins_message();
+    message.set_from_address(fromAddress.string());
+    message.set_to_address(toAddress.string());
+    auto amountOfTx = message.add_amounts();
+    amountOfTx->set_denom("muon");
+    amountOfTx->set_amount(1);
+
+    auto &fee = *input.mutable_fee();
+    fee.set_gas(200000);
+    auto amountOfFee = fee.add_amounts();
+    amountOfFee->set_denom("muon");
+    amountOfFee->set_amount(200);
+
+    auto privateKey = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(privateKey.data(), privateKey.size());
+
+    auto output = Signer::sign(input);
+
+    EXPECT_EQ(output.serialized(), R"({"mode":"BROADCAST_MODE_BLOCK","tx_bytes":"CowBCokBChwvY29zbW9zLmJhbmsudjFiZXRhMS5Nc2dTZW5kEmkKLWNvc21vczFoc2s2anJ5eXFqZmhwNWRoYzU1dGM5anRja3lneDBlcGg2ZGQwMhItY29zbW9zMXp0NTBhenVwYW5xbGZhbTVhZmh2M2hleHd5dXRudWtlaDRjNTczGgkKBG11b24SATESYwpOCkYKHy9jb3Ntb3MuY3J5cHRvLnNlY3AyNTZrMS5QdWJLZXkSIwohAlcobsPzfTNVe7uqAAsndErJAjqplnyudaGB0f+R+p3FEgQKAggBEhEKCwoEbXVvbhIDMjAwEMCaDBpAIm6btqpGVZ2TEa/nlyaiQ47lSv8CHH2F5TTM5HF1p0wQ+uGpZk5/soq2ztl3FmC+SBWbIIYOoelk6gfaaV45ig=="})");
+    EXPECT_EQ(hex(output.signature()), "226e9bb6aa46559d9311afe79726a2438ee54aff021c7d85e534cce47175a74c10fae1a9664e7fb28ab6ced9771660be48159b20860ea1e964ea07da695e398a");
+    EXPECT_EQ(output.json(), "");
+    EXPECT_EQ(output.error(), Common::Proto::OK);
+
+    // signed: sha256 of the SignDoc
+    const auto publicKey = PrivateKey(privateKey).getPublicKey(TWPublicKeyTypeSECP256k1);
+    EXPECT_TRUE(publicKey.verify(data(output.signature()), parse_hex("87846143862f955546498b2d245eab78340e4fa79e43b54b0971f672867cb49a")));
+
+    input.set_mode(Proto::BroadcastMode::SYNC);
+    EXPECT_EQ(Signer::sign(input).serialized().substr(0, 33), R"({"mode":"BROADCAST_MODE_SYNC","tx)");
+}
+
+TEST(CosmosSigner, SignTxProtobufUnsupportedMessage) {
+    auto input = Proto::SigningInput();
+    input.set_signing_mode(Proto::Protobuf);
+    auto& message = *input.add_messages()->mutable_raw_json_message();
+    message.set_type("test");
+    message.set_value("{}");
+    auto privateKey = parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005");
+    input.set_private_key(privateKey.data(), privateKey.size());
+
+    auto output = Signer::sign(input);
+    EXPECT_EQ(output.error(), Common::Proto::Error_general);
+    EXPECT_TRUE(output.serialized().empty());
+    EXPECT_TRUE(output.signature().empty());
+
+    // amino JSON only
+    input.set_signing_mode(Proto::JSON);
+    EXPECT_EQ(Signer::sign(input).error(), Common::Proto::OK);
+}
@@ -9,6 +9,7 @@
 #include "Base64.h"
 #include "proto/Cosmos.pb.h"
 #include "Cosmos/Address.h"
+#include "Cosmos/ProtobufSerialization.h"
 #include "Cosmos/Signer.h"
 
 #include <gtest/gtest.h>
@@ -160,3 +161,30 @@ TEST(CosmosStaking, WithdrawAllRaw) {
     ASSERT_EQ(output.json(), "{\"mode\":\"block\",\"tx\":{\"fee\":{\"amount\":[{\"amount\":\"1018\",\"denom\":\"muon\"}],\"gas\":\"101721\"},\"memo\":\"\",\"msg\":[{\"type\":\"cosmos-sdk/MsgWithdrawDelegationRewardsAll\",\"value\":{\"delegator_address\":\"cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02\"}}],\"signatures\":[{\"pub_key\":{\"type\":\"tendermint/PubKeySecp256k1\",\"value\":\"AlcobsPzfTNVe7uqAAsndErJAjqplnyudaGB0f+R+p3F\"},\"signature\":\"ImvsgnfbjebxzeBCUPeOcMoOJWMV3IhWM1apV20WiS4K11iA50fe0uXr4Xf/RTxUDXTm56cne/OjOr77BG99Aw==\"}]}}");
     ASSERT_EQ(hex(output.signature()), "226bec8277db8de6f1cde04250f78e70ca0e256315dc88563356a9576d16892e0ad75880e747ded2e5ebe177ff453c540d74e6e7a7277bf3a33abefb046f7d03");
 }
+
+TEST(CosmosStaking, ProtobufTxBody) {
+    auto input = Proto::SigningInput();
+    input.set_memo("staking");
+    const auto delegator = "cosmos1hsk6jryyqjfhp5dhc55tc9jtckygx0eph6dd02";
+    const auto validator = "cosmosvaloper1zkupr83hrzkn3up5elktzcq3tuft8nxsmwdqgp";
+
+    auto& stake = *input.add_messages()->mutable_stake_message();
+    stake.set_delegator_address(delegator);
+    stake.set_validator_address(validator);
+    stake.mutable_amount()->set_denom("muon");
+    stake.mutable_amount()->set_amount(10);
+    auto& unstake = *input.add_messages()->mutable_unstake_message();
+    unstake.set_delegator_address(delegator);
+    unstake.set_validator_address(validator);
+    *unstake.mutable_amount() = stake.amount();
+    auto& restake = *input.add_messages()->mutable_restake_message();
+    restake.set_delegator_address(delegator);
+    restake.set_validator_src_address(validator);
+    restake.set_validator_dst_address("cosmosvaloper1gjtvly9lel6zskvwtvlg5vhwpu9c9waw7sxzwx");
+    *restake.mutable_amount() = stake.amount();
+    auto& withdraw = *input.add_messages()->mutable_withdraw_stake_reward_message();
+    withdraw.set_delegator_address(delegator);
+    withdraw.set_validator_address(validator);
+
+    EXPECT_EQ(hex(protobufTxBody(input)), "0a98010a232f636f736d6f732e7374616b696e672e763162657461312e4d736744656c656761746512710a2d636f736d6f733168736b366a727979716a6668703564686335357463396a74636b7967783065706836646430321234636f736d6f7376616c6f706572317a6b757072383368727a6b6e33757035656c6b747a63713374756674386e78736d77647167701a0a0a046d756f6e120231300a9a010a252f636f736d6f732e7374616b696e672e763162657461312e4d7367556e64656c656761746512710a2d636f736d6f733168736b366a727979716a6668703564686335357463396a74636b7967783065706836646430321234636f736d6f7376616c6f706572317a6b757072383368727a6b6e33757035656c6b747a63713374756674386e78736d77647167701a0a0a046d756f6e120231300ad6010a2a2f636f736d6f732e7374616b696e672e763162657461312e4d7367426567696e526564656c656761746512a7010a2d636f736d6f733168736b366a727979716a6668703564686335357463396a74636b7967783065706836646430321234636f736d6f7376616c6f706572317a6b757072383368727a6b6e33757035656c6b747a63713374756674386e78736d77647167701a34636f736d6f7376616c6f70657231676a74766c79396c656c367a736b767774766c673576687770753963397761773773787a7778220a0a046d756f6e120231300aa0010a372f636f736d6f732e646973747269627574696f6e2e763162657461312e4d7367576974686472617744656c656761746f7252657761726412650a2d636f736d6f733168736b366a727979716a6668703564686335357463396a74636b7967783065706836646430321234636f736d6f7376616c6f706572317a6b757072383368727a6b6e33757035656c6b747a63713374756674386e78736d776471677012077374616b696e67");
+}
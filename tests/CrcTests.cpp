@@ -0,0 +1,59 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Crc.h"
+#include "Data.h"
+
+#include <boost/crc.hpp>
+#include <gtest/gtest.h>
+
+using namespace TW;
+
+namespace {
+
+Data message(size_t size) {
+    Data data(size);
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<byte>(i * 131 + size);
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(Crc, Crc16) {
+    EXPECT_EQ(Crc::crc16(reinterpret_cast<const uint8_t*>("123456789"), 9), 0x31c3);
+    EXPECT_EQ(Crc::crc16(nullptr, 0), 0);
+    for (size_t size = 0; size < 80; ++size) {
+        const auto data = message(size);
+        boost::crc_optimal<16, 0x1021, 0, 0, false, false> expected;
+        expected.process_bytes(data.data(), data.size());
+        EXPECT_EQ(Crc::crc16(data.data(), static_cast<uint32_t>(data.size())), expected.checksum()) << size;
+    }
+}
+
+TEST(Crc, Crc32) {
+    EXPECT_EQ(Crc::crc32(TW::data("123456789")), 0xcbf43926);
+    EXPECT_EQ(Crc::crc32(Data()), 0);
+    // around the 64 and 16-byte blocks of the folding
+    for (size_t size = 0; size < 300; ++size) {
+        const auto data = message(size);
+        boost::crc_32_type expected;
+        expected.process_bytes(data.data(), data.size());
+        EXPECT_EQ(Crc::crc32(data), expected.checksum()) << size;
+    }
+}
+
+TEST(Crc, Crc32C) {
+    EXPECT_EQ(Crc::crc32C(TW::data("123456789")), 0xe3069283);
+    EXPECT_EQ(Crc::crc32C(Data()), 0);
+    for (size_t size = 0; size < 100; ++size) {
+        const auto data = message(size);
+        boost::crc_optimal<32, 0x1EDC6F41, 0xFFFFFFFF, 0xFFFFFFFF, true, true> expected;
+        expected.process_bytes(data.data(), data.size());
+        EXPECT_EQ(Crc::crc32C(data), expected.checksum()) << size;
+    }
+}
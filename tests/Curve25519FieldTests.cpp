@@ -0,0 +1,257 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Curve25519Reference32.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
+#include <TrezorCrypto/rand.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+// The radix 2^51 field arithmetic of 64-bit builds, checked against the 32 bit one
+#if defined(ED25519_64BIT)
+
+extern "C" {
+// constants of ed25519-donna-impl-base.c, converted from the 32 bit ones
+extern const bignum25519 fe_sqrtm1;
+extern const bignum25519 fe_ma2;
+extern const bignum25519 fe_ma;
+extern const bignum25519 fe_fffb1;
+extern const bignum25519 fe_fffb2;
+extern const bignum25519 fe_fffb3;
+extern const bignum25519 fe_fffb4;
+}
+
+namespace TW {
+
+namespace {
+
+using Bytes = std::array<unsigned char, 32>;
+
+/// A field element in the representations of both backends.
+struct Element {
+    bignum25519 wide;
+    ref32_bignum25519 narrow;
+};
+
+Bytes fromHex(const std::string& bigEndian) {
+    const auto data = parse_hex(bigEndian);
+    Bytes bytes{};
+    std::reverse_copy(data.begin(), data.end(), bytes.begin());
+    return bytes;
+}
+
+Element expand(const Bytes& bytes) {
+    Element element;
+    curve25519_expand(element.wide, bytes.data());
+    ref32_curve25519_expand(element.narrow, bytes.data());
+    return element;
+}
+
+std::string contracted(const bignum25519 x) {
+    Bytes bytes;
+    curve25519_contract(bytes.data(), x);
+    return hex(bytes);
+}
+
+std::string contracted(const ref32_bignum25519 x) {
+    Bytes bytes;
+    ref32_curve25519_contract(bytes.data(), x);
+    return hex(bytes);
+}
+
+#define EXPECT_SAME(element) EXPECT_EQ(contracted((element).wide), contracted((element).narrow))
+
+/// Encodings around p = 2^255 - 19 and the limb boundaries of both backends, then random ones.
+std::vector<Bytes> testValues() {
+    std::vector<Bytes> values;
+    for (const auto* value : {
+             "0000000000000000000000000000000000000000000000000000000000000000",
+             "0000000000000000000000000000000000000000000000000000000000000001",
+             "0000000000000000000000000000000000000000000000000000000000000013",
+             "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffeb", // p - 2
+             "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffec", // p - 1
+             "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffed", // p
+             "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffee", // p + 1
+             "7fffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff", // p + 18
+             "8000000000000000000000000000000000000000000000000000000000000000", // the ignored top bit
+             "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff",
+             "0000000000000000000000000000000000000000000000000007ffffffffffff", // 2^51 - 1
+             "0000000000000000000000000000000000000000000000000008000000000000", // 2^51
+             "000000000000000000000000000000000000003fffffffffffffffffffffffff", // 2^102 - 1
+             "0000000000000000000000000000000000000000000000000000000003ffffff", // 2^26 - 1
+             "7ffffffffffff000000000000000000000000000000000000000000000000000", // the top limb
+         }) {
+        values.push_back(fromHex(value));
+    }
+    for (int i = 0; i < 24; ++i) {
+        Bytes bytes;
+        random_buffer(bytes.data(), bytes.size());
+        values.push_back(bytes);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(Curve25519Field, ExpandContract) {
+    for (const auto& value : testValues()) {
+        const auto element = expand(value);
+        EXPECT_SAME(element) << hex(value);
+
+        Element reduced;
+        curve25519_expand_reduce(reduced.wide, value.data());
+        ref32_curve25519_expand_reduce(reduced.narrow, value.data());
+        EXPECT_SAME(reduced) << hex(value);
+
+        curve25519_reduce(reduced.wide, element.wide);
+        ref32_curve25519_reduce(reduced.narrow, element.narrow);
+        EXPECT_SAME(reduced) << hex(value);
+
+        EXPECT_EQ(curve25519_isnegative(element.wide), ref32_curve25519_isnegative(element.narrow)) << hex(value);
+        EXPECT_EQ(curve25519_isnonzero(element.wide) != 0, ref32_curve25519_isnonzero(element.narrow) != 0) << hex(value);
+    }
+}
+
+TEST(Curve25519Field, Arithmetic) {
+    const auto values = testValues();
+    for (const auto& x : values) {
+        const auto a = expand(x);
+        Element result;
+
+        curve25519_square(result.wide, a.wide);
+        ref32_curve25519_square(result.narrow, a.narrow);
+        EXPECT_SAME(result) << hex(x);
+
+        curve25519_square_times(result.wide, a.wide, 5);
+        ref32_curve25519_square_times(result.narrow, a.narrow, 5);
+        EXPECT_SAME(result) << hex(x);
+
+        curve25519_neg(result.wide, a.wide);
+        ref32_curve25519_neg(result.narrow, a.narrow);
+        EXPECT_SAME(result) << hex(x);
+
+        curve25519_scalar_product(result.wide, a.wide, 121666);
+        ref32_curve25519_scalar_product(result.narrow, a.narrow, 121666);
+        EXPECT_SAME(result) << hex(x);
+
+        for (const auto& y : values) {
+            const auto b = expand(y);
+            curve25519_mul(result.wide, a.wide, b.wide);
+            ref32_curve25519_mul(result.narrow, a.narrow, b.narrow);
+            EXPECT_SAME(result) << hex(x) << " " << hex(y);
+
+            curve25519_add_reduce(result.wide, a.wide, b.wide);
+            ref32_curve25519_add_reduce(result.narrow, a.narrow, b.narrow);
+            EXPECT_SAME(result) << hex(x) << " " << hex(y);
+
+            curve25519_sub_reduce(result.wide, a.wide, b.wide);
+            ref32_curve25519_sub_reduce(result.narrow, a.narrow, b.narrow);
+            EXPECT_SAME(result) << hex(x) << " " << hex(y);
+
+            // products of unreduced sums and differences, as in the point formulas
+            Element sum, difference;
+            curve25519_add(sum.wide, a.wide, b.wide);
+            ref32_curve25519_add(sum.narrow, a.narrow, b.narrow);
+            curve25519_sub(difference.wide, a.wide, b.wide);
+            ref32_curve25519_sub(difference.narrow, a.narrow, b.narrow);
+            curve25519_mul(result.wide, sum.wide, difference.wide);
+            ref32_curve25519_mul(result.narrow, sum.narrow, difference.narrow);
+            EXPECT_SAME(result) << hex(x) << " " << hex(y);
+            curve25519_square(result.wide, sum.wide);
+            ref32_curve25519_square(result.narrow, sum.narrow);
+            EXPECT_SAME(result) << hex(x) << " " << hex(y);
+        }
+    }
+}
+
+TEST(Curve25519Field, Invert) {
+    const auto values = testValues();
+    bignum25519 one;
+    curve25519_set(one, 1);
+    for (const auto& x : values) {
+        const auto a = expand(x);
+        Element result;
+        curve25519_recip(result.wide, a.wide);
+        ref32_curve25519_recip(result.narrow, a.narrow);
+        EXPECT_SAME(result) << hex(x);
+        if (curve25519_isnonzero(a.wide)) {
+            bignum25519 product;
+            curve25519_mul(product, a.wide, result.wide);
+            EXPECT_EQ(contracted(product), contracted(one)) << hex(x);
+        }
+
+        curve25519_pow_two252m3(result.wide, a.wide);
+        ref32_curve25519_pow_two252m3(result.narrow, a.narrow);
+        EXPECT_SAME(result) << hex(x);
+
+        const auto b = expand(values[values.size() - 1]);
+        curve25519_divpowm1(result.wide, a.wide, b.wide);
+        ref32_curve25519_divpowm1(result.narrow, a.narrow, b.narrow);
+        EXPECT_SAME(result) << hex(x);
+    }
+}
+
+TEST(Curve25519Field, TablesMatch32Bit) {
+    const auto expectPoint = [](const bignum25519* wide, const ref32_bignum25519* narrow, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(contracted(wide[i]), contracted(narrow[i])) << i;
+        }
+    };
+    expectPoint(&ge25519_basepoint.x, ref32_ge25519_basepoint, 4);
+    expectPoint(&ge25519_ecd, &ref32_ge25519_ecd, 1);
+    expectPoint(&ge25519_ec2d, &ref32_ge25519_ec2d, 1);
+    expectPoint(&ge25519_sqrtneg1, &ref32_ge25519_sqrtneg1, 1);
+    for (size_t i = 0; i < 32; ++i) {
+        expectPoint(&ge25519_niels_sliding_multiples[i].ysubx, ref32_ge25519_niels_sliding_multiples[i], 3);
+    }
+}
+
+TEST(Curve25519Field, Constants) {
+    const auto square = [](const bignum25519 x) {
+        bignum25519 result;
+        curve25519_square(result, x);
+        return contracted(result);
+    };
+    const auto product = [](const bignum25519 a, const bignum25519 b) {
+        bignum25519 result;
+        curve25519_mul(result, a, b);
+        return contracted(result);
+    };
+
+    bignum25519 minusOne, two, minusTwo;
+    curve25519_set(minusOne, 1);
+    curve25519_neg(minusOne, minusOne);
+    curve25519_set(two, 2);
+    curve25519_neg(minusTwo, two);
+    EXPECT_EQ(contracted(fe_sqrtm1), contracted(ge25519_sqrtneg1));
+    EXPECT_EQ(square(fe_sqrtm1), contracted(minusOne));
+
+    // A = 486662
+    bignum25519 a, minusA;
+    curve25519_set(a, 486662);
+    curve25519_neg(minusA, a);
+    EXPECT_EQ(contracted(fe_ma), contracted(minusA));
+    EXPECT_EQ(product(fe_ma2, minusOne), square(a));
+
+    // A * (A + 2)
+    bignum25519 aa2, minusSqrtm1;
+    curve25519_scalar_product(aa2, a, 486664);
+    curve25519_neg(minusSqrtm1, fe_sqrtm1);
+    EXPECT_EQ(square(fe_fffb1), product(aa2, minusTwo));
+    EXPECT_EQ(square(fe_fffb2), product(aa2, two));
+    EXPECT_EQ(square(fe_fffb3), product(aa2, minusSqrtm1));
+    EXPECT_EQ(square(fe_fffb4), product(aa2, fe_sqrtm1));
+}
+
+} // namespace TW
+
+#endif // ED25519_64BIT
@@ -0,0 +1,53 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// The 32 bit field backend of ed25519-donna and its tables, compiled here under ref32_ names whatever
+// backend the library uses, for Curve25519FieldTests.  Every external symbol of the included files is
+// renamed, so that none clashes with the library.  The headers are not shared with
+// Curve25519Reference32.h, whose declarations mirror the renamed ones.
+
+#ifndef ED25519_FORCE_32BIT
+#define ED25519_FORCE_32BIT
+#endif
+
+#define reduce_mask_25 ref32_reduce_mask_25
+#define reduce_mask_26 ref32_reduce_mask_26
+#define curve25519_copy ref32_curve25519_copy
+#define curve25519_add ref32_curve25519_add
+#define curve25519_add_after_basic ref32_curve25519_add_after_basic
+#define curve25519_add_reduce ref32_curve25519_add_reduce
+#define curve25519_sub ref32_curve25519_sub
+#define curve25519_scalar_product ref32_curve25519_scalar_product
+#define curve25519_sub_after_basic ref32_curve25519_sub_after_basic
+#define curve25519_sub_reduce ref32_curve25519_sub_reduce
+#define curve25519_neg ref32_curve25519_neg
+#define curve25519_mul ref32_curve25519_mul
+#define curve25519_square ref32_curve25519_square
+#define curve25519_square_times ref32_curve25519_square_times
+#define curve25519_expand ref32_curve25519_expand
+#define curve25519_contract ref32_curve25519_contract
+#define curve25519_swap_conditional ref32_curve25519_swap_conditional
+#define curve25519_set ref32_curve25519_set
+#define curve25519_set_d ref32_curve25519_set_d
+#define curve25519_set_2d ref32_curve25519_set_2d
+#define curve25519_set_sqrtneg1 ref32_curve25519_set_sqrtneg1
+#define curve25519_isnegative ref32_curve25519_isnegative
+#define curve25519_isnonzero ref32_curve25519_isnonzero
+#define curve25519_reduce ref32_curve25519_reduce
+#define curve25519_divpowm1 ref32_curve25519_divpowm1
+#define curve25519_expand_reduce ref32_curve25519_expand_reduce
+#define curve25519_pow_two5mtwo0_two250mtwo0 ref32_curve25519_pow_two5mtwo0_two250mtwo0
+#define curve25519_recip ref32_curve25519_recip
+#define curve25519_pow_two252m3 ref32_curve25519_pow_two252m3
+#define ge25519_basepoint ref32_ge25519_basepoint
+#define ge25519_ecd ref32_ge25519_ecd
+#define ge25519_ec2d ref32_ge25519_ec2d
+#define ge25519_sqrtneg1 ref32_ge25519_sqrtneg1
+#define ge25519_niels_sliding_multiples ref32_ge25519_niels_sliding_multiples
+
+#include "../trezor-crypto/crypto/ed25519-donna/curve25519-donna-32bit.c"
+#include "../trezor-crypto/crypto/ed25519-donna/curve25519-donna-helpers.c"
+#include "../trezor-crypto/crypto/ed25519-donna/ed25519-donna-32bit-tables.c"
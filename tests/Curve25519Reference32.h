@@ -0,0 +1,43 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include <cstdint>
+
+/// The 32 bit curve25519 field arithmetic of ed25519-donna, built into the tests under ref32_ names as the
+/// reference of the radix 2^51 arithmetic of 64-bit builds.  See Curve25519Reference32.cpp.
+extern "C" {
+
+typedef uint32_t ref32_bignum25519[10];
+
+void ref32_curve25519_add(ref32_bignum25519 out, const ref32_bignum25519 a, const ref32_bignum25519 b);
+void ref32_curve25519_add_reduce(ref32_bignum25519 out, const ref32_bignum25519 a, const ref32_bignum25519 b);
+void ref32_curve25519_sub(ref32_bignum25519 out, const ref32_bignum25519 a, const ref32_bignum25519 b);
+void ref32_curve25519_sub_reduce(ref32_bignum25519 out, const ref32_bignum25519 a, const ref32_bignum25519 b);
+void ref32_curve25519_neg(ref32_bignum25519 out, const ref32_bignum25519 a);
+void ref32_curve25519_scalar_product(ref32_bignum25519 out, const ref32_bignum25519 in, const uint32_t scalar);
+void ref32_curve25519_mul(ref32_bignum25519 out, const ref32_bignum25519 a, const ref32_bignum25519 b);
+void ref32_curve25519_square(ref32_bignum25519 out, const ref32_bignum25519 in);
+void ref32_curve25519_square_times(ref32_bignum25519 out, const ref32_bignum25519 in, int count);
+void ref32_curve25519_expand(ref32_bignum25519 out, const unsigned char in[32]);
+void ref32_curve25519_expand_reduce(ref32_bignum25519 out, const unsigned char in[32]);
+void ref32_curve25519_contract(unsigned char out[32], const ref32_bignum25519 in);
+void ref32_curve25519_reduce(ref32_bignum25519 r, const ref32_bignum25519 in);
+int ref32_curve25519_isnegative(const ref32_bignum25519 f);
+int ref32_curve25519_isnonzero(const ref32_bignum25519 f);
+void ref32_curve25519_recip(ref32_bignum25519 out, const ref32_bignum25519 z);
+void ref32_curve25519_pow_two252m3(ref32_bignum25519 two252m3, const ref32_bignum25519 z);
+void ref32_curve25519_divpowm1(ref32_bignum25519 r, const ref32_bignum25519 u, const ref32_bignum25519 v);
+
+/// The constant tables of ed25519-donna-32bit-tables.c; points are {x, y, z, t}, niels points {ysubx, xaddy, t2d}.
+extern const ref32_bignum25519 ref32_ge25519_basepoint[4];
+extern const ref32_bignum25519 ref32_ge25519_ecd;
+extern const ref32_bignum25519 ref32_ge25519_ec2d;
+extern const ref32_bignum25519 ref32_ge25519_sqrtneg1;
+extern const ref32_bignum25519 ref32_ge25519_niels_sliding_multiples[32][3];
+
+} // extern "C"
@@ -0,0 +1,76 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Data.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+using namespace TW;
+
+TEST(DataView, Construct) {
+    const auto data = parse_hex("0102030405");
+    const auto view = DataView(data);
+    EXPECT_EQ(view.data(), data.data());
+    EXPECT_EQ(view.size(), 5);
+    EXPECT_EQ(view[1], 0x02);
+    EXPECT_EQ(hex(view), "0102030405");
+    EXPECT_EQ(view.toData(), data);
+
+    const auto array = std::array<byte, 3>{0x0a, 0x0b, 0x0c};
+    EXPECT_EQ(hex(DataView(array)), "0a0b0c");
+
+    EXPECT_TRUE(DataView().empty());
+    EXPECT_EQ(hex(DataView()), "");
+}
+
+TEST(DataView, SubView) {
+    const auto data = parse_hex("0102030405");
+    const auto view = DataView(data);
+    EXPECT_EQ(hex(view.subView(1, 3)), "020304");
+    EXPECT_EQ(hex(view.subView(3, 10)), "0405");
+    EXPECT_EQ(hex(view.subView(5, 1)), "");
+    EXPECT_EQ(hex(view.subView(7, 1)), "");
+    EXPECT_EQ(view.subView(2, 2).data(), data.data() + 2);
+}
+
+TEST(DataView, Append) {
+    auto data = parse_hex("01");
+    append(data, DataView(parse_hex("0203")));
+    append(data, std::array<byte, 1>{0x04});
+    EXPECT_EQ(hex(data), "01020304");
+}
+
+TEST(FixedData, Construct) {
+    const auto data = parse_hex("0102030405");
+    FixedData<8> fixed(data);
+    EXPECT_EQ(fixed.size(), 5);
+    EXPECT_EQ(fixed.capacity(), 8);
+    EXPECT_EQ(fixed[4], 0x05);
+    EXPECT_EQ(hex(fixed), "0102030405");
+    EXPECT_EQ(fixed, data);
+    EXPECT_EQ(fixed.toData(), data);
+    static_assert(!std::is_convertible<FixedData<8>, Data>::value, "key bytes are copied to Data explicitly");
+    EXPECT_EQ(hex(DataView(fixed)), "0102030405");
+
+    fixed.resize(7);
+    EXPECT_EQ(hex(fixed), "01020304050000");
+    fixed.resize(2);
+    EXPECT_EQ(hex(fixed), "0102");
+    EXPECT_NE(fixed, data);
+
+    EXPECT_TRUE(FixedData<4>().empty());
+    EXPECT_THROW(FixedData<4>(data.data(), data.size()), std::length_error);
+    EXPECT_THROW(fixed.resize(9), std::length_error);
+}
+
+TEST(FixedData, Append) {
+    auto data = parse_hex("01");
+    append(data, FixedData<4>(parse_hex("0203")));
+    EXPECT_EQ(hex(data), "010203");
+}
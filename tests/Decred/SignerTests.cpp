@@ -427,3 +427,42 @@ TEST(DecredSigning, SignP2WPKH_NegativeAddressWrongType) {
 
     ASSERT_FALSE(result) << std::to_string(result.error());
 }
+
+TEST(DecredSigner, CachedSignatureHash) {
+    const auto keyhash = parse_hex("f5eba6730a4052ba3a5c7e2e4c6b8f4eb1e5a0c2");
+    auto transaction = Transaction();
+    for (uint32_t i = 0; i < 150; ++i) {
+        auto txIn = TransactionInput();
+        auto hash = std::array<byte, 32>{};
+        hash[0] = static_cast<byte>(i);
+        txIn.previousOutput = OutPoint(std::move(hash), i, 0);
+        txIn.sequence = UINT32_MAX - i;
+        transaction.inputs.push_back(txIn);
+    }
+    for (int64_t i = 0; i < 3; ++i) {
+        transaction.outputs.push_back(TransactionOutput(1000 + i, 0, Bitcoin::Script::buildPayToPublicKeyHash(keyhash)));
+    }
+    const auto script = Bitcoin::Script::buildPayToPublicKeyHash(keyhash);
+
+    auto cached = transaction;
+    cached.cacheSignatureHashes();
+    const auto hashTypes = {
+        TWBitcoinSigHashTypeAll,
+        TWBitcoinSigHashType(TWBitcoinSigHashTypeAll | TWBitcoinSigHashTypeAnyoneCanPay),
+        TWBitcoinSigHashTypeNone,
+        TWBitcoinSigHashTypeSingle,
+    };
+    for (auto hashType : hashTypes) {
+        for (size_t index : {0, 2, 63, 64, 65, 128, 149}) {
+            if (hashType == TWBitcoinSigHashTypeSingle && index >= transaction.outputs.size()) {
+                EXPECT_THROW(cached.computeSignatureHash(script, index, hashType), std::invalid_argument);
+                continue;
+            }
+            EXPECT_EQ(hex(cached.computeSignatureHash(script, index, hashType)),
+                      hex(transaction.computeSignatureHash(script, index, hashType)))
+                << hashType << " " << index;
+        }
+    }
+    EXPECT_NE(hex(cached.computeSignatureHash(script, 0, TWBitcoinSigHashTypeAll)),
+              hex(cached.computeSignatureHash(script, 1, TWBitcoinSigHashTypeAll)));
+}
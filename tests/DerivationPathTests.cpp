@@ -70,4 +70,42 @@ TEST(DerivationPath, Equal) {
     ASSERT_EQ(path1, path2);
 }
 
+TEST(DerivationPath, Literal) {
+    constexpr auto path = "m/44'/60'/0'/0/0"_dp;
+    static_assert(path.indices.size() == 5);
+    static_assert(path.coin() == 60);
+    static_assert(path.indices[3].derivationIndex() == 0 && path.indices[2].derivationIndex() == 0x80000000);
+    EXPECT_EQ(path, DerivationPath("m/44'/60'/0'/0/0"));
+    EXPECT_EQ(DerivationPath("m/4294967295"), DerivationPath({DerivationPathIndex(0xffffffff, false)}));
+    EXPECT_THROW(DerivationPath("m/4294967296"), std::invalid_argument);
+    EXPECT_THROW(DerivationPath("m/+1"), std::invalid_argument);
+}
+
+TEST(DerivationPath, Capacity) {
+    auto path = DerivationPath("m/0/1/2/3/4/5/6/7");
+    EXPECT_EQ(path.indices.size(), DerivationPathIndices::capacity);
+    EXPECT_THROW(path.indices.push_back(DerivationPathIndex(8)), std::length_error);
+    EXPECT_THROW(DerivationPath("m/0/1/2/3/4/5/6/7/8"), std::length_error);
+}
+
+TEST(DerivationPath, WithAddressIndex) {
+    constexpr auto path = "m/44'/60'/0'/0/0"_dp;
+    static_assert(path.withAddressIndex(7).address() == 7);
+    EXPECT_EQ(path.withAddressIndex(7).string(), "m/44'/60'/0'/0/7");
+    EXPECT_EQ(path.string(), "m/44'/60'/0'/0/0");
+    EXPECT_EQ(path.prefix(4).withAddressIndex(3).string(), "m/44'/60'/0'/0/3");
+    EXPECT_EQ("m/44'/501'"_dp.withAddressIndex(3).string(), "m/44'/501'");
+}
+
+TEST(DerivationPath, CommonPrefix) {
+    constexpr auto path = "m/44'/60'/0'/0/0"_dp;
+    static_assert(path.commonPrefixLength("m/44'/60'/1'/0/0"_dp) == 2);
+    EXPECT_EQ(path.commonPrefixLength(path), 5ul);
+    EXPECT_EQ(path.commonPrefixLength("m/44'/60'/0"_dp), 2ul);
+    EXPECT_EQ(path.commonPrefixLength("m/44'/60'"_dp), 2ul);
+    EXPECT_EQ(path.commonPrefixLength(DerivationPath()), 0ul);
+    EXPECT_EQ(path.prefix(3), "m/44'/60'/0'"_dp);
+    EXPECT_EQ(path.prefix(9), path);
+}
+
 } // namespace
@@ -30,4 +30,12 @@ TEST(EOSName, Valid) {
     Data buf;
     Name(validName).serialize(buf);
     ASSERT_EQ(hex(buf), "458608d8354cb3c1");
-}
\ No newline at end of file
+}
+
+TEST(EOSName, CompileTime) {
+    static constexpr Name active(Name::encode("active"));
+    static_assert(active.value == 0x3232eda800000000, "compile-time encoding");
+    ASSERT_EQ(active.value, Name(std::string("active")).value);
+    ASSERT_EQ(Name::encode("satoshis12345"), Name(std::string("satoshis12345")).value);
+    ASSERT_EQ(Name::encode(""), 0);
+}
@@ -104,4 +104,50 @@ TEST(EOSTransaction, Serialization) {
             r1Sigs[i]
         );
     }
-}
\ No newline at end of file
+}
+
+TEST(EOSSigner, SignBatch) {
+    const auto chainId = parse_hex("cf057bbfb72640471fd910bcb67639c22df9f92470936cddc1ade0e2f2e7dc4f");
+    const auto refBlock = parse_hex("000067d6f6a7e7799a1f3d487439a679f8cf95f1c986f35c0d2fa320f51a7144");
+    const auto key = parse_hex("559aead08264d5795d3909718cdd05abd49572e84fe55590eef31a88a08fdffd");
+
+    Proto::SigningInput input;
+    input.mutable_asset()->set_amount(300000);
+    input.mutable_asset()->set_decimals(4);
+    input.mutable_asset()->set_symbol("TKN");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_reference_block_id(refBlock.data(), refBlock.size());
+    input.set_reference_block_time(1554209118);
+    input.set_currency("token");
+    input.set_sender("token");
+    input.set_recipient("eosio");
+    input.set_memo("my second transfer");
+    input.set_private_key(key.data(), key.size());
+    input.set_private_key_type(Proto::KeyType::MODERNK1);
+
+    std::vector<Proto::SigningInput> inputs;
+    for (int i = 0; i < 6; ++i) {
+        auto transfer = input;
+        transfer.mutable_asset()->set_amount(300000 + i);
+        if (i >= 3) {
+            // another header
+            transfer.set_reference_block_time(1554209118 + 60);
+        }
+        inputs.push_back(transfer);
+    }
+    inputs[1].set_private_key_type(Proto::KeyType::MODERNR1);
+    inputs[4].set_private_key_type(Proto::KeyType::LEGACY);
+    inputs[5].set_reference_block_id("short");
+
+    const auto outputs = Signer::signBatch(inputs, 2);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto expected = Signer::sign(inputs[i]);
+        EXPECT_EQ(outputs[i].error(), expected.error()) << i;
+        EXPECT_EQ(outputs[i].json_encoded(), expected.json_encoded()) << i;
+    }
+    EXPECT_EQ(outputs[0].error(), Common::Proto::OK);
+    EXPECT_EQ(outputs[4].error(), Common::Proto::Error_internal);
+    EXPECT_EQ(outputs[5].error(), Common::Proto::Error_internal);
+    EXPECT_TRUE(Signer::signBatch({}).empty());
+}
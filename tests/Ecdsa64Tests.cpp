@@ -0,0 +1,175 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/ecdsa64.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/rand.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+namespace {
+
+/// Double-and-add with the affine bignum256 point operations.
+curve_point referenceMultiply(const ecdsa_curve* curve, const bignum256& k, const curve_point& p) {
+    curve_point result;
+    point_set_infinity(&result);
+    for (int i = 255; i >= 0; --i) {
+        point_double(curve, &result);
+        if (bn_testbit(&k, i)) {
+            point_add(curve, &p, &result);
+        }
+    }
+    return result;
+}
+
+std::string hexPoint(const curve_point& p) {
+    Data bytes(64);
+    bn_write_be(&p.x, bytes.data());
+    bn_write_be(&p.y, bytes.data() + 32);
+    return hex(bytes);
+}
+
+std::vector<bignum256> testScalars(const ecdsa_curve* curve) {
+    std::vector<bignum256> scalars(5);
+    bn_one(&scalars[0]);
+    bn_read_uint32(2, &scalars[1]);
+    bn_subtract(&curve->order, &scalars[0], &scalars[2]);
+    bn_subtract(&curve->order, &scalars[1], &scalars[3]);
+    bn_zero(&scalars[4]);
+    bn_setbit(&scalars[4], 255);
+    bn_mod(&scalars[4], &curve->order);
+    for (int i = 0; i < 10; ++i) {
+        Data bytes(32);
+        random_buffer(bytes.data(), bytes.size());
+        bignum256 k;
+        bn_read_be(bytes.data(), &k);
+        bn_mod(&k, &curve->order);
+        scalars.push_back(k);
+    }
+    return scalars;
+}
+
+} // namespace
+
+TEST(Ecdsa64, MultiplyMatchesBignum) {
+    if (!ecdsa64_supported()) {
+        GTEST_SKIP();
+    }
+    for (const auto* curve : {&secp256k1, &nist256p1}) {
+        ASSERT_TRUE(ecdsa64_curve_supported(curve));
+        const auto scalars = testScalars(curve);
+        const auto point = referenceMultiply(curve, scalars.back(), curve->G);
+        for (const auto& k : scalars) {
+            curve_point result;
+            ASSERT_EQ(ecdsa64_scalar_multiply(curve, &k, &result), 0);
+            EXPECT_EQ(hexPoint(result), hexPoint(referenceMultiply(curve, k, curve->G)));
+
+            ASSERT_EQ(ecdsa64_point_multiply(curve, &k, &point, &result), 0);
+            EXPECT_EQ(hexPoint(result), hexPoint(referenceMultiply(curve, k, point)));
+        }
+
+        bignum256 zero;
+        bn_zero(&zero);
+        curve_point result;
+        ASSERT_EQ(ecdsa64_point_multiply(curve, &zero, &point, &result), 0);
+        EXPECT_TRUE(point_is_infinity(&result));
+        ASSERT_EQ(ecdsa64_scalar_multiply(curve, &zero, &result), 0);
+        EXPECT_TRUE(point_is_infinity(&result));
+    }
+}
+
+TEST(Ecdsa64, VerifyScalarsMatchBignum) {
+    if (!ecdsa64_supported()) {
+        GTEST_SKIP();
+    }
+    for (const auto* curve : {&secp256k1, &nist256p1}) {
+        const auto scalars = testScalars(curve);
+        for (size_t i = 0; i + 2 < scalars.size(); ++i) {
+            const auto& r = scalars[i];
+            const auto& s = scalars[i + 1];
+            // a digest is not reduced modulo the order
+            Data digest(32, 0xff);
+            if (i % 2 == 0) {
+                bn_write_be(&scalars[i + 2], digest.data());
+            }
+            bignum256 z;
+            bn_read_be(digest.data(), &z);
+
+            bignum256 inverse = s, u1 = z, u2 = r;
+            bn_inverse(&inverse, &curve->order);
+            bn_multiply(&inverse, &u1, &curve->order);
+            bn_mod(&u1, &curve->order);
+            bn_multiply(&inverse, &u2, &curve->order);
+            bn_mod(&u2, &curve->order);
+
+            bignum256 v1, v2;
+            ASSERT_EQ(ecdsa64_verify_scalars(curve, &r, &s, &z, &v1, &v2), 0);
+            EXPECT_TRUE(bn_is_equal(&u1, &v1));
+            EXPECT_TRUE(bn_is_equal(&u2, &v2));
+        }
+    }
+}
+
+TEST(Ecdsa64, UncompressMatchesPoint) {
+    if (!ecdsa64_supported()) {
+        GTEST_SKIP();
+    }
+    for (const auto* curve : {&secp256k1, &nist256p1}) {
+        for (const auto& k : testScalars(curve)) {
+            const auto point = referenceMultiply(curve, k, curve->G);
+            bignum256 y;
+            ASSERT_EQ(ecdsa64_uncompress_coords(curve, bn_is_odd(&point.y), &point.x, &y), 0);
+            EXPECT_TRUE(bn_is_equal(&y, &point.y));
+            ASSERT_EQ(ecdsa64_uncompress_coords(curve, !bn_is_odd(&point.y), &point.x, &y), 0);
+            bignum256 negated;
+            bn_subtract(&curve->prime, &point.y, &negated);
+            EXPECT_TRUE(bn_is_equal(&y, &negated));
+        }
+    }
+}
+
+TEST(Ecdsa64, DoubleMultiplyMatchesBignum) {
+    if (!ecdsa64_supported()) {
+        GTEST_SKIP();
+    }
+    for (const auto* curve : {&secp256k1, &nist256p1}) {
+        const auto scalars = testScalars(curve);
+        const auto point = referenceMultiply(curve, scalars.back(), curve->G);
+        bignum256 zero;
+        bn_zero(&zero);
+        for (size_t i = 0; i + 1 < scalars.size(); ++i) {
+            const auto& u1 = scalars[i];
+            const auto& u2 = scalars[i + 1];
+            auto expected = referenceMultiply(curve, u2, point);
+            const auto product = referenceMultiply(curve, u1, curve->G);
+            point_add(curve, &product, &expected);
+            curve_point result;
+            ASSERT_EQ(ecdsa64_double_multiply(curve, &u1, &u2, &point, &result), 0);
+            EXPECT_EQ(hexPoint(result), hexPoint(expected));
+
+            ASSERT_EQ(ecdsa64_double_multiply(curve, &u1, &zero, &point, &result), 0);
+            EXPECT_EQ(hexPoint(result), hexPoint(product));
+
+            // the doubling and the opposite point in the sum
+            ASSERT_EQ(ecdsa64_double_multiply(curve, &u1, &u1, &curve->G, &result), 0);
+            auto doubled = product;
+            point_double(curve, &doubled);
+            EXPECT_EQ(hexPoint(result), hexPoint(doubled));
+            bignum256 negated;
+            bn_subtract(&curve->order, &u1, &negated);
+            ASSERT_EQ(ecdsa64_double_multiply(curve, &u1, &negated, &curve->G, &result), 0);
+            EXPECT_TRUE(point_is_infinity(&result));
+        }
+    }
+}
+
+} // namespace TW
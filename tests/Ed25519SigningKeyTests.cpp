@@ -0,0 +1,97 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ed25519SigningKey.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <TrezorCrypto/ed25519-donna/ed25519-blake2b.h>
+#include <TrezorCrypto/ed25519.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+namespace TW {
+
+namespace {
+
+const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+const auto message = parse_hex("9fbb3c2d1ca7a3e9c9d1b266e2b6f0b53a3da31b1e760f1bbc960ee75f5405e1aa7b1d4e3b");
+
+} // namespace
+
+TEST(Ed25519SigningKey, Ed25519) {
+    const auto key = Ed25519SigningKey(privateKey, TWCurveED25519);
+    const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    EXPECT_EQ(hex(key.publicKey()), hex(publicKey.bytes));
+
+    Data expected(64);
+    ed25519_sign(message.data(), message.size(), privateKey.bytes.data(), publicKey.bytes.data(), expected.data());
+    EXPECT_EQ(hex(key.sign(message)), hex(expected));
+    EXPECT_EQ(hex(privateKey.sign(message, TWCurveED25519)), hex(expected));
+    EXPECT_TRUE(publicKey.verify(expected, message));
+}
+
+TEST(Ed25519SigningKey, Blake2bNano) {
+    const auto key = Ed25519SigningKey(privateKey, TWCurveED25519Blake2bNano);
+    const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519Blake2b);
+    EXPECT_EQ(hex(key.publicKey()), hex(publicKey.bytes));
+
+    Data expected(64);
+    ed25519_sign_blake2b(message.data(), message.size(), privateKey.bytes.data(), publicKey.bytes.data(), expected.data());
+    EXPECT_EQ(hex(key.sign(message)), hex(expected));
+    EXPECT_TRUE(publicKey.verify(expected, message));
+}
+
+TEST(Ed25519SigningKey, Extended) {
+    const auto extended = PrivateKey(
+        parse_hex("b0884d248cb301edd1b34cf626ba6d880bb3ae8fd91b4696446999dc4f0b5744"),
+        parse_hex("309941d56938e943980d11643c535e046653ca6f498c014b88f2ad9fd6e71eff"),
+        parse_hex("bf36a8fa9f5e11eb7a852c41e185e3969d518e66e6893c81d3fc7227009952d4"));
+    const auto key = Ed25519SigningKey(extended, TWCurveED25519Extended);
+    const auto publicKey = extended.getPublicKey(TWPublicKeyTypeED25519Extended);
+    EXPECT_EQ(hex(key.publicKey()), hex(Data(publicKey.bytes.begin(), publicKey.bytes.begin() + 32)));
+
+    Data expected(64);
+    ed25519_sign_ext(message.data(), message.size(), extended.bytes.data(), extended.extensionBytes.data(),
+                     key.publicKey().data(), expected.data());
+    EXPECT_EQ(hex(key.sign(message)), hex(expected));
+    EXPECT_EQ(hex(extended.sign(message, TWCurveED25519Extended)), hex(expected));
+}
+
+TEST(Ed25519SigningKey, Curve25519) {
+    const auto key = Ed25519SigningKey(privateKey, TWCurveCurve25519);
+    const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeED25519);
+    EXPECT_EQ(hex(key.publicKey()), hex(publicKey.bytes));
+
+    // an Ed25519 signature with the sign bit of the public key
+    auto expected = Ed25519SigningKey(privateKey, TWCurveED25519).sign(message);
+    expected[63] = static_cast<byte>((expected[63] & 0x7f) | (publicKey.bytes[31] & 0x80));
+    EXPECT_EQ(hex(key.sign(message)), hex(expected));
+    EXPECT_TRUE(privateKey.getPublicKey(TWPublicKeyTypeCURVE25519).verify(key.sign(message), message));
+}
+
+TEST(Ed25519SigningKey, Batch) {
+    std::vector<Data> digests;
+    for (byte i = 0; i < 20; ++i) {
+        digests.push_back(Data(32, i));
+    }
+    std::vector<Data> signatures;
+    ASSERT_TRUE(privateKey.signBatch(digests, TWCurveED25519, signatures, 4));
+    const auto key = Ed25519SigningKey(privateKey, TWCurveED25519);
+    for (std::size_t i = 0; i < digests.size(); ++i) {
+        EXPECT_EQ(hex(signatures[i]), hex(key.sign(digests[i]))) << i;
+    }
+}
+
+TEST(Ed25519SigningKey, Unsupported) {
+    EXPECT_FALSE(Ed25519SigningKey::supports(TWCurveSECP256k1));
+    EXPECT_THROW(Ed25519SigningKey(privateKey, TWCurveSECP256k1), std::invalid_argument);
+    EXPECT_THROW(Ed25519SigningKey(privateKey, TWCurveNIST256p1), std::invalid_argument);
+}
+
+} // namespace TW
@@ -58,3 +58,17 @@ TEST(ElrondSerialization, SignableStringWithoutData) {
     string jsonString = serializeTransaction(message);
     ASSERT_EQ(R"({"nonce":42,"value":"43","receiver":"abba","sender":"feed","gasPrice":0,"gasLimit":0,"chainID":"1","version":1})", jsonString);
 }
+
+TEST(ElrondSerialization, SignedStringFromSignableString) {
+    Proto::TransactionMessage message;
+    message.set_nonce(7);
+    message.set_value("10");
+    message.set_sender(ALICE_BECH32);
+    message.set_receiver(BOB_BECH32);
+    message.set_data("memo \"quoted\"");
+    message.set_chain_id("T");
+    message.set_version(1);
+
+    const auto signature = "b5fddb8c16fa7f6123cb32edc854f1e760a3eb62c6dc420b5a4c0473c58befd45b621b31a448c5b59e21428f2bc128c80d0ee1caa4f2bf05a12be857ad451b00";
+    ASSERT_EQ(serializeSignedTransaction(message, signature), serializeSignedTransaction(serializeTransaction(message), signature));
+}
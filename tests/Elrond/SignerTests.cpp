@@ -13,6 +13,7 @@
 #include "Elrond/Signer.h"
 #include "Elrond/Address.h"
 #include "TestAccounts.h"
+#include "BatchSigningHelper.h"
 
 using namespace TW;
 using namespace TW::Elrond;
@@ -48,7 +49,7 @@ TEST(ElrondSigner, SignJSON) {
     auto input = (boost::format(R"({"transaction" : {"data":"foo","value":"0","nonce":0,"receiver":"%1%","sender":"%2%","gasPrice":1000000000,"gasLimit":50000,"chainId":"1","version":1}})") % BOB_BECH32 % ALICE_BECH32).str();
     auto privateKey = PrivateKey(parse_hex(ALICE_SEED_HEX));
     
-    auto encoded = Signer::signJSON(input, privateKey.bytes);
+    auto encoded = Signer::signJSON(input, privateKey.bytes.toData());
     auto expectedSignature = "b5fddb8c16fa7f6123cb32edc854f1e760a3eb62c6dc420b5a4c0473c58befd45b621b31a448c5b59e21428f2bc128c80d0ee1caa4f2bf05a12be857ad451b00";
     auto expectedEncoded = (boost::format(R"({"nonce":0,"value":"0","receiver":"%1%","sender":"%2%","gasPrice":1000000000,"gasLimit":50000,"data":"Zm9v","chainID":"1","version":1,"signature":"%3%"})") % BOB_BECH32 % ALICE_BECH32 % expectedSignature).str();
 
@@ -85,9 +86,28 @@ TEST(ElrondSigner, SignJSONWithoutData) {
     auto input = (boost::format(R"({"transaction" : {"value":"0","nonce":0,"receiver":"%1%","sender":"%2%","gasPrice":1000000000,"gasLimit":50000,"chainId":"1","version":1}})") % BOB_BECH32 % ALICE_BECH32).str();
     auto privateKey = PrivateKey(parse_hex(ALICE_SEED_HEX));
     
-    auto encoded = Signer::signJSON(input, privateKey.bytes);
+    auto encoded = Signer::signJSON(input, privateKey.bytes.toData());
     auto expectedSignature = "3079d37bfbdbe66fbb4c4b186144f9d9ad5b4b08fbcd6083be0688cf1171123109dfdefdbabf91425c757ca109b6db6d674cb9aeebb19a1a51333565abb53109";
     auto expectedEncoded = (boost::format(R"({"nonce":0,"value":"0","receiver":"%1%","sender":"%2%","gasPrice":1000000000,"gasLimit":50000,"chainID":"1","version":1,"signature":"%3%"})") % BOB_BECH32 % ALICE_BECH32 % expectedSignature).str();
 
     ASSERT_EQ(expectedEncoded, encoded);
 }
+
+TEST(ElrondSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = Proto::SigningInput();
+        const auto first = key == BatchKey::First;
+        const auto seed = key == BatchKey::Invalid ? Data(32) : parse_hex(first ? ALICE_SEED_HEX : BOB_SEED_HEX);
+        input.set_private_key(seed.data(), seed.size());
+        input.mutable_transaction()->set_nonce(i);
+        input.mutable_transaction()->set_value(std::to_string(1000 + i));
+        input.mutable_transaction()->set_sender(first ? ALICE_BECH32 : BOB_BECH32);
+        input.mutable_transaction()->set_receiver(first ? BOB_BECH32 : ALICE_BECH32);
+        input.mutable_transaction()->set_gas_price(1000000000);
+        input.mutable_transaction()->set_gas_limit(50000);
+        input.mutable_transaction()->set_data(i % 2 == 0 ? "payout" : "");
+        input.mutable_transaction()->set_chain_id("1");
+        input.mutable_transaction()->set_version(1);
+        return input;
+    });
+}
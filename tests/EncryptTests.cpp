@@ -9,6 +9,9 @@
 #include "HexCoding.h"
 
 #include <TrustWalletCore/TWAESPaddingMode.h>
+#include <TrezorCrypto/aes.h>
+#include <TrezorCrypto/aes_hw.h>
+#include <TrezorCrypto/chacha20poly1305/chacha_hw.h>
 
 #include <gtest/gtest.h>
 
@@ -146,6 +149,58 @@ TEST(Encrypt, AESCTREncryptMultipleBlocks) {
     assertHexEqual(result, "76b0a3ae037e7d6a50236c4c3ba7560edde4a8a951bf97bc10709e74d8e926c0431866b0ba9852d95bb0bbf41d109f1f3cf2f0af818f96d4f4109a1e3e5b224e3efd57288906a48d47b0006ccedcf96fde7362dedca952dda7cbdd359d");
 }
 
+TEST(Encrypt, HardwareMatchesPortable) {
+    auto messages = std::vector<Data>();
+    for (size_t size = 0; size < 400; size += 13) {
+        auto message = Data(size);
+        for (size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<TW::byte>(i * 31 + size);
+        }
+        messages.push_back(message);
+    }
+    // the counter carries into the upper 64 bits
+    const auto iv = parse_hex("00112233445566778899aabbfffffffd");
+
+    const auto supported = aes_hw_supported();
+    std::vector<std::vector<std::string>> expected;
+    for (const auto backend : {0u, supported}) {
+        EXPECT_EQ(aes_hw_select(backend), backend);
+        size_t index = 0;
+        for (const auto keySize : {16, 24, 32}) {
+            const auto aesKey = Data(key.begin(), key.begin() + keySize);
+            for (const auto& message : messages) {
+                auto ivCopy = iv;
+                const auto cbc = AESCBCEncrypt(aesKey, message, ivCopy, TWAESPaddingModePKCS7);
+                ivCopy = iv;
+                EXPECT_EQ(hex(AESCBCDecrypt(aesKey, cbc, ivCopy, TWAESPaddingModePKCS7)), hex(message));
+                ivCopy = iv;
+                const auto ctr = AESCTREncrypt(aesKey, message, ivCopy);
+                ivCopy = iv;
+                EXPECT_EQ(hex(AESCTRDecrypt(aesKey, ctr, ivCopy)), hex(message));
+
+                // CTR in pieces, continuing inside a block
+                aes_encrypt_ctx ctx;
+                ASSERT_EQ(aes_encrypt_key(aesKey.data(), keySize, &ctx), EXIT_SUCCESS);
+                ivCopy = iv;
+                auto pieces = Data(message.size());
+                const auto split = std::min<size_t>(message.size(), 7);
+                aes_ctr_encrypt(message.data(), pieces.data(), static_cast<int>(split), ivCopy.data(), aes_ctr_cbuf_inc, &ctx);
+                aes_ctr_encrypt(message.data() + split, pieces.data() + split, static_cast<int>(message.size() - split), ivCopy.data(), aes_ctr_cbuf_inc, &ctx);
+                EXPECT_EQ(hex(pieces), hex(ctr));
+
+                const auto results = std::vector<std::string>{hex(cbc), hex(ctr), hex(ivCopy)};
+                if (backend == 0) {
+                    expected.push_back(results);
+                } else {
+                    EXPECT_EQ(results, expected[index]) << "key " << keySize << " size " << message.size();
+                }
+                ++index;
+            }
+        }
+    }
+    aes_hw_select(supported);
+}
+
 TEST(Encrypt, AESCBCEncryptInvalidKeySize) {
     Data iv = Data(16);
     try {
@@ -200,3 +255,87 @@ TEST(Encrypt, AESCTRDecryptInvalidKeySize) {
     }
     ADD_FAILURE() << "Missed expected exeption";
 }
+
+// RFC 8439, section 2.8.2
+const auto chachaKey = parse_hex("808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f");
+const auto chachaNonce = parse_hex("070000004041424344454647");
+const auto chachaAad = parse_hex("50515253c0c1c2c3c4c5c6c7");
+const auto chachaPlaintext = TW::data("Ladies and Gentlemen of the class of '99: If I could offer you only one tip for the future, sunscreen would be it.");
+const auto chachaCiphertext = "d31a8d34648e60db7b86afbc53ef7ec2a4aded51296e08fea9e2b5a736ee62d63dbea45e8ca9671282fafb69da92728b1a71de0a9e060b2905d6a5b67ecd3b3692ddbd7f2d778b8c9803aee328091b58fab324e4fad675945585808b4831d7bc3ff4def08e4b7a9de576d26586cec64b6116";
+const auto chachaTag = "1ae10b594f09e26a7e902ecbd0600691";
+
+TEST(Encrypt, ChaCha20Poly1305) {
+    const auto encrypted = ChaCha20Poly1305Encrypt(chachaKey, chachaNonce, chachaPlaintext, chachaAad);
+    EXPECT_EQ(hex(encrypted), std::string(chachaCiphertext) + chachaTag);
+    EXPECT_EQ(hex(ChaCha20Poly1305Decrypt(chachaKey, chachaNonce, encrypted, chachaAad)), hex(chachaPlaintext));
+
+    auto tampered = encrypted;
+    tampered[5] ^= 0x01;
+    EXPECT_THROW(ChaCha20Poly1305Decrypt(chachaKey, chachaNonce, tampered, chachaAad), std::invalid_argument);
+    EXPECT_THROW(ChaCha20Poly1305Decrypt(chachaKey, chachaNonce, encrypted, Data()), std::invalid_argument);
+    EXPECT_THROW(ChaCha20Poly1305Decrypt(chachaKey, chachaNonce, Data(15), chachaAad), std::invalid_argument);
+    EXPECT_THROW(ChaCha20Poly1305Encrypt(Data(31), chachaNonce, chachaPlaintext), std::invalid_argument);
+    EXPECT_THROW(ChaCha20Poly1305Encrypt(chachaKey, Data(8), chachaPlaintext), std::invalid_argument);
+
+    // empty message
+    const auto empty = ChaCha20Poly1305Encrypt(chachaKey, chachaNonce, Data());
+    EXPECT_EQ(empty.size(), ChaCha20Poly1305::tagSize);
+    EXPECT_TRUE(ChaCha20Poly1305Decrypt(chachaKey, chachaNonce, empty).empty());
+}
+
+TEST(Encrypt, ChaCha20Poly1305Streaming) {
+    auto message = Data(2000);
+    for (size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<TW::byte>(i * 13 + 7);
+    }
+    const auto aad = parse_hex("000102030405060708090a0b0c0d0e0f1011");
+    const auto expected = hex(ChaCha20Poly1305Encrypt(chachaKey, chachaNonce, message, aad));
+
+    for (const size_t chunk : {1, 13, 64, 100, 257, 1999}) {
+        auto encryption = ChaCha20Poly1305(chachaKey, chachaNonce);
+        // authenticated data in parts
+        encryption.addAuthenticatedData(DataView(aad).subView(0, 5));
+        encryption.addAuthenticatedData(DataView(aad).subView(5, aad.size()));
+        auto encrypted = Data();
+        for (size_t offset = 0; offset < message.size(); offset += chunk) {
+            append(encrypted, encryption.encrypt(DataView(message).subView(offset, chunk)));
+        }
+        append(encrypted, encryption.finish());
+        EXPECT_EQ(hex(encrypted), expected) << "chunk " << chunk;
+
+        // in place
+        auto decryption = ChaCha20Poly1305(chachaKey, chachaNonce);
+        decryption.addAuthenticatedData(aad);
+        auto decrypted = Data(encrypted.begin(), encrypted.end() - ChaCha20Poly1305::tagSize);
+        for (size_t offset = 0; offset < decrypted.size(); offset += chunk) {
+            const auto part = DataView(decrypted).subView(offset, chunk);
+            decryption.decrypt(part, decrypted.data() + offset);
+        }
+        EXPECT_TRUE(decryption.verify(DataView(encrypted).subView(message.size(), ChaCha20Poly1305::tagSize)));
+        EXPECT_EQ(hex(decrypted), hex(message));
+    }
+
+    auto decryption = ChaCha20Poly1305(chachaKey, chachaNonce);
+    decryption.decrypt(message);
+    EXPECT_FALSE(decryption.verify(Data(ChaCha20Poly1305::tagSize)));
+
+    auto encryption = ChaCha20Poly1305(chachaKey, chachaNonce);
+    encryption.encrypt(message);
+    EXPECT_THROW(encryption.addAuthenticatedData(aad), std::logic_error);
+    EXPECT_THROW(encryption.decrypt(message), std::logic_error);
+    encryption.finish();
+    EXPECT_THROW(encryption.encrypt(message), std::logic_error);
+    EXPECT_THROW(encryption.finish(), std::logic_error);
+}
+
+TEST(Encrypt, ChaCha20VectorizedMatchesPortable) {
+    auto message = Data(64 * 41 + 5);
+    for (size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<TW::byte>(i * 31 + 5);
+    }
+    const auto supported = chacha_hw_supported();
+    EXPECT_EQ(chacha_hw_select(0), 0u);
+    const auto expected = ChaCha20Poly1305Encrypt(chachaKey, chachaNonce, message);
+    EXPECT_EQ(chacha_hw_select(supported), supported);
+    EXPECT_EQ(hex(ChaCha20Poly1305Encrypt(chachaKey, chachaNonce, message)), hex(expected));
+}
@@ -533,6 +533,60 @@ TEST(EthereumAbi, ParamArrayAddress) {
     }
 }
 
+TEST(EthereumAbi, ParamPackedArray) {
+    const auto addresses = parse_hex("f784682c82526e245f50975190ef0fff4e4fc0772e00cd222cb42b616d86d037cc494e8ab7f5c9a3");
+    auto param = ParamPackedArray("address", addresses);
+    EXPECT_EQ("address[]", param.getType());
+    EXPECT_TRUE(param.isDynamic());
+    EXPECT_EQ(2, param.getCount());
+    EXPECT_EQ(3 * 32, param.getSize());
+    EXPECT_EQ("2e00cd222cb42b616d86d037cc494e8ab7f5c9a3", hex(param.getElement(1)));
+
+    // same encoding as an array of parameters
+    auto expected = ParamArray();
+    expected.addParam(std::make_shared<ParamAddress>(parse_hex("f784682c82526e245f50975190ef0fff4e4fc077")));
+    expected.addParam(std::make_shared<ParamAddress>(parse_hex("2e00cd222cb42b616d86d037cc494e8ab7f5c9a3")));
+    Data encoded;
+    param.encode(encoded);
+    Data expectedEncoded;
+    expected.encode(expectedEncoded);
+    EXPECT_EQ(hex(encoded), hex(expectedEncoded));
+
+    auto decoded = ParamPackedArray("address");
+    size_t offset = 0;
+    EXPECT_TRUE(decoded.decode(encoded, offset));
+    EXPECT_EQ(encoded.size(), offset);
+    EXPECT_EQ(2, decoded.getCount());
+    EXPECT_EQ("f784682c82526e245f50975190ef0fff4e4fc077", hex(decoded.getElement(0)));
+    encoded.resize(encoded.size() - 1);
+    offset = 0;
+    EXPECT_FALSE(decoded.decode(encoded, offset));
+
+    const auto numbers = parse_hex("00000000000000000000000000000000000000000000000000000000000000010000000000000000000000000000000000000000000000000000000000000002");
+    auto amounts = Function("multisend", std::vector<std::shared_ptr<ParamBase>>{
+        std::make_shared<ParamPackedArray>("address", addresses),
+        std::make_shared<ParamPackedArray>("uint256", numbers),
+    });
+    auto expectedAmounts = Function("multisend", std::vector<std::shared_ptr<ParamBase>>{
+        std::make_shared<ParamArray>(std::vector<std::shared_ptr<ParamBase>>{
+            std::make_shared<ParamAddress>(parse_hex("f784682c82526e245f50975190ef0fff4e4fc077")),
+            std::make_shared<ParamAddress>(parse_hex("2e00cd222cb42b616d86d037cc494e8ab7f5c9a3"))}),
+        std::make_shared<ParamArray>(std::vector<std::shared_ptr<ParamBase>>{
+            std::make_shared<ParamUInt256>(1), std::make_shared<ParamUInt256>(2)}),
+    });
+    EXPECT_EQ(amounts.getType(), "multisend(address[],uint256[])");
+    Data call;
+    amounts.encode(call);
+    Data expectedCall;
+    expectedAmounts.encode(expectedCall);
+    EXPECT_EQ(hex(call), hex(expectedCall));
+
+    EXPECT_EQ(32, ParamPackedArray::elementSize("bytes32"));
+    EXPECT_EQ(0, ParamPackedArray::elementSize("uint8"));
+    EXPECT_THROW(ParamPackedArray("string", {}), std::invalid_argument);
+    EXPECT_THROW(ParamPackedArray("address", Data(21)), std::invalid_argument);
+}
+
 TEST(EthereumAbi, ParamArrayOfByteArray) {
     auto param = ParamArray();
     param.addParam(std::make_shared<ParamByteArray>(parse_hex("1011")));
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Ethereum/Address.h"
+#include "Ethereum/AddressChecksum.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 
@@ -47,6 +48,42 @@ TEST(EthereumAddress, String) {
     ASSERT_EQ(address.string(), "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
 }
 
+TEST(EthereumAddress, CachedString) {
+    auto address = Address(parse_hex("5aaeb6053f3e94c9b9a09f33669435e7ef1beaed"));
+    ASSERT_EQ(address.string(), "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
+    const auto copy = address;
+    ASSERT_EQ(copy.string(), "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
+    // the string follows changes of the bytes
+    address.bytes = Address(parse_hex("fb6916095ca1df60bb79ce92ce3ea74c37c5d359")).bytes;
+    ASSERT_EQ(address.string(), "0xfB6916095ca1df60bB79Ce92cE3Ea74c37c5d359");
+    ASSERT_EQ(copy.string(), "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
+}
+
+TEST(EthereumAddress, Checksums) {
+    const auto strings = std::vector<std::string>{
+        "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed",
+        "0xfB6916095ca1df60bB79Ce92cE3Ea74c37c5d359",
+        "0xdbF03B407c01E7cD3CBea99509d93f8DDDC8C6FB",
+        "0xD1220A0cf47c7B9Be7A2E6BA89F429762e7b9aDb",
+        "0x52908400098527886E0F7030069857D2E4169EE7",
+        "0xde709f2102306220921060314715629080e2fb77",
+    };
+    std::vector<Address> addresses;
+    for (const auto& string : strings) {
+        addresses.emplace_back(string);
+    }
+    ASSERT_EQ(checksumed(addresses, ChecksumType::eip55), strings);
+    ASSERT_TRUE(checksumed(std::vector<Address>{}, ChecksumType::eip55).empty());
+
+    char buffer[checksumedSize];
+    checksumed(addresses[0], ChecksumType::eip55, buffer);
+    ASSERT_EQ(std::string(buffer, sizeof(buffer)), strings[0]);
+
+    // letters of the opposite case
+    ASSERT_EQ(checksumed(addresses[0], ChecksumType::wanchain), "0x5AaEB6053f3e94c9B9a09F33669435e7eF1bEaED");
+    ASSERT_EQ(checksumed(addresses, ChecksumType::wanchain)[1], "0xFb6916095CA1DF60Bb79cE92Ce3eA74C37C5D359");
+}
+
 TEST(EthereumAddress, FromPrivateKey) {
     const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
     const auto publicKey = PublicKey(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
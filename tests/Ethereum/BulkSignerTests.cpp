@@ -0,0 +1,98 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/BulkSigner.h"
+#include "Ethereum/Signer.h"
+#include "HexCoding.h"
+#include "uint256.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace TW::Ethereum {
+
+static Proto::SigningInput baseInput(uint64_t chainID) {
+    auto input = Proto::SigningInput();
+    const auto chain = store(uint256_t(chainID));
+    input.set_chain_id(chain.data(), chain.size());
+    const auto nonce = store(uint256_t(9));
+    input.set_nonce(nonce.data(), nonce.size());
+    const auto gasPrice = store(uint256_t(20000000000));
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    const auto gasLimit = store(uint256_t(60000));
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    const auto key = parse_hex("0x4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_private_key(key.data(), key.size());
+    return input;
+}
+
+static std::vector<BulkSigner::Call> calls(size_t count) {
+    std::vector<BulkSigner::Call> calls;
+    for (size_t i = 0; i < count; ++i) {
+        calls.push_back({"0x3535353535353535353535353535353535353535", store(uint256_t(1000000000000000000) + i), i % 2 == 0 ? Data() : parse_hex("a9059cbb")});
+    }
+    return calls;
+}
+
+static Proto::SigningOutput expected(Proto::SigningInput input, const BulkSigner::Call& call, uint64_t nonce) {
+    const auto encodedNonce = store(uint256_t(nonce));
+    input.set_nonce(encodedNonce.data(), encodedNonce.size());
+    input.set_to_address(call.toAddress);
+    auto& transfer = *input.mutable_transaction()->mutable_transfer();
+    transfer.set_amount(call.value.data(), call.value.size());
+    transfer.set_data(call.data.data(), call.data.size());
+    return Signer::sign(input);
+}
+
+TEST(EthereumBulkSigner, SignAll) {
+    for (const auto chainID : {1, 56}) {
+        const auto input = baseInput(chainID);
+        const auto transactions = calls(25);
+        const auto outputs = BulkSigner::signAll(input, transactions, 4);
+        ASSERT_EQ(outputs.size(), transactions.size());
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            const auto reference = expected(input, transactions[i], 9 + i);
+            ASSERT_FALSE(reference.encoded().empty());
+            EXPECT_EQ(hex(outputs[i].encoded()), hex(reference.encoded())) << chainID << " " << i;
+            EXPECT_EQ(hex(outputs[i].v()), hex(reference.v()));
+            EXPECT_EQ(hex(outputs[i].data()), hex(reference.data()));
+        }
+    }
+    EXPECT_TRUE(BulkSigner::signAll(baseInput(1), {}).empty());
+}
+
+TEST(EthereumBulkSigner, Stream) {
+    const auto input = baseInput(56);
+    const auto transactions = calls(40);
+    // capacity below the number of transactions, the producer waits for the consumer
+    auto bulkSigner = BulkSigner(input, 3, 4);
+    auto producer = std::thread([&]() {
+        for (size_t i = 0; i < transactions.size(); ++i) {
+            EXPECT_EQ(bulkSigner.submit(transactions[i]), 9 + i);
+        }
+    });
+    for (size_t i = 0; i < transactions.size(); ++i) {
+        const auto output = bulkSigner.next();
+        EXPECT_EQ(hex(output.encoded()), hex(expected(input, transactions[i], 9 + i).encoded())) << i;
+    }
+    producer.join();
+}
+
+TEST(EthereumBulkSigner, Invalid) {
+    auto bulkSigner = BulkSigner(baseInput(1), 1, 2);
+    EXPECT_THROW(bulkSigner.submit({"0x35", store(uint256_t(1))}), std::invalid_argument);
+    EXPECT_THROW(bulkSigner.submit({"0x3535353535353535353535353535353535353535", Data(33, 1)}), std::invalid_argument);
+    // rejected transactions don't use a nonce
+    EXPECT_EQ(bulkSigner.submit(calls(1)[0]), 9);
+    EXPECT_EQ(hex(bulkSigner.next().encoded()), hex(expected(baseInput(1), calls(1)[0], 9).encoded()));
+
+    auto invalidKey = baseInput(1);
+    invalidKey.set_private_key(Data(32, 0).data(), 32);
+    EXPECT_THROW(BulkSigner{invalidKey}, std::invalid_argument);
+}
+
+} // namespace TW::Ethereum
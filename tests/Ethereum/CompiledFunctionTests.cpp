@@ -0,0 +1,139 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/ABI.h"
+#include "Ethereum/ABI/CompiledFunction.h"
+#include "Ethereum/Transaction.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+
+TEST(EthereumAbiType, Parse) {
+    auto type = Type::parse("uint");
+    EXPECT_EQ(type.kind, Type::Kind::UInt);
+    EXPECT_EQ(type.canonical, "uint256");
+    EXPECT_EQ(type.staticSize, 32);
+    EXPECT_FALSE(type.dynamic);
+
+    type = Type::parse("bytes32[2][]");
+    EXPECT_EQ(type.kind, Type::Kind::Array);
+    EXPECT_EQ(type.canonical, "bytes32[2][]");
+    EXPECT_TRUE(type.dynamic);
+    EXPECT_EQ(type.element().kind, Type::Kind::FixedArray);
+    EXPECT_EQ(type.element().staticSize, 64);
+
+    type = Type::parse("(address,int,string)[3]");
+    EXPECT_EQ(type.canonical, "(address,int256,string)[3]");
+    EXPECT_TRUE(type.dynamic);
+    EXPECT_EQ(type.headSize(), 32);
+
+    type = Type::parse("(bool,uint8)[2]");
+    EXPECT_FALSE(type.dynamic);
+    EXPECT_EQ(type.staticSize, 128);
+
+    for (const auto& invalid : {"", "uint7", "uint264", "bytes0", "bytes33", "int8[", "(uint256", "foo", "uint256[0]"}) {
+        EXPECT_THROW(Type::parse(invalid), std::invalid_argument) << invalid;
+    }
+}
+
+TEST(EthereumAbiCompiledFunction, MatchesFunction) {
+    auto legacy = Function("sam", std::vector<std::shared_ptr<ParamBase>>{
+        std::make_shared<ParamByteArray>(Data{0x64, 0x61, 0x76, 0x65}),
+        std::make_shared<ParamBool>(true),
+        std::make_shared<ParamArray>(std::vector<std::shared_ptr<ParamBase>>{
+            std::make_shared<ParamUInt256>(1),
+            std::make_shared<ParamUInt256>(2),
+            std::make_shared<ParamUInt256>(3)
+        })
+    });
+    Data expected;
+    legacy.encode(expected);
+
+    const auto func = CompiledFunction("sam(bytes,bool,uint256[])");
+    EXPECT_EQ(func.name(), "sam");
+    EXPECT_EQ(hex(func.selector()), "a5643bf2");
+    const auto dave = std::string("dave");
+    const auto args = std::vector<Value>{dave, true, std::vector<Value>{1, 2, 3}};
+    EXPECT_EQ(func.encodedSize(args), 4 + 9 * 32);
+    EXPECT_EQ(hex(func.encode(args)), hex(expected));
+
+    EXPECT_EQ(hex(CompiledFunction("baz(uint,bool)").selector()), "72ed38b6");
+    EXPECT_EQ(CompiledFunction("baz(uint,bool)").signature(), "baz(uint256,bool)");
+}
+
+TEST(EthereumAbiCompiledFunction, EncodeTransfer) {
+    const auto to = parse_hex("5322b34c88ed0691971bf52a7047448f0f4efc84");
+    const auto amount = uint256_t(2000000000000000000);
+    const auto func = CompiledFunction("transfer(address,uint256)");
+
+    Data data = {0xff};
+    func.encode({to, amount}, data);
+    EXPECT_EQ(hex(data), "ff" + hex(Ethereum::Transaction::buildERC20TransferCall(to, amount)));
+}
+
+TEST(EthereumAbiCompiledFunction, EncodeDynamic) {
+    const auto func = CompiledFunction("f(uint256,uint32[],bytes10,string)");
+    const auto bytes10 = parse_hex("31323334353637383930");
+    const auto encoded = func.encode({0x123, std::vector<Value>{0x456, 0x789}, bytes10, std::string("Hello, world!")});
+    EXPECT_EQ(hex(encoded),
+        "47b941bf"
+        "0000000000000000000000000000000000000000000000000000000000000123"
+        "0000000000000000000000000000000000000000000000000000000000000080"
+        "3132333435363738393000000000000000000000000000000000000000000000"
+        "00000000000000000000000000000000000000000000000000000000000000e0"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000456"
+        "0000000000000000000000000000000000000000000000000000000000000789"
+        "000000000000000000000000000000000000000000000000000000000000000d"
+        "48656c6c6f2c20776f726c642100000000000000000000000000000000000000");
+}
+
+TEST(EthereumAbiCompiledFunction, EncodeTuple) {
+    const auto func = CompiledFunction("g((uint256,bytes),bool)");
+    EXPECT_EQ(func.inputs().components.size(), 2);
+    EXPECT_TRUE(func.inputs().dynamic);
+    const auto encoded = func.encode({std::vector<Value>{1, std::string("ab")}, true});
+    EXPECT_EQ(hex(Data(encoded.begin() + 4, encoded.end())),
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "6162000000000000000000000000000000000000000000000000000000000000");
+}
+
+TEST(EthereumAbiCompiledFunction, FromJson) {
+    const auto entry = nlohmann::json::parse(R"({
+        "name": "g",
+        "type": "function",
+        "inputs": [
+            {"name": "s", "type": "tuple", "components": [{"name": "a", "type": "uint"}, {"name": "b", "type": "bytes"}]},
+            {"name": "c", "type": "bool"}
+        ]
+    })");
+    const auto func = CompiledFunction(entry);
+    EXPECT_EQ(func.signature(), "g((uint256,bytes),bool)");
+    EXPECT_EQ(hex(func.selector()), hex(CompiledFunction("g((uint256,bytes),bool)").selector()));
+
+    EXPECT_THROW(CompiledFunction(nlohmann::json::parse(R"({"inputs": []})")), std::invalid_argument);
+}
+
+TEST(EthereumAbiCompiledFunction, Invalid) {
+    EXPECT_THROW(CompiledFunction("f(uint256"), std::invalid_argument);
+    EXPECT_THROW(CompiledFunction("(uint256)"), std::invalid_argument);
+
+    const auto func = CompiledFunction("f(uint8,address,int8)");
+    const auto address = parse_hex("5322b34c88ed0691971bf52a7047448f0f4efc84");
+    EXPECT_NO_THROW(func.encode({255, address, -128}));
+    EXPECT_THROW(func.encode({256, address, 0}), std::invalid_argument);
+    EXPECT_THROW(func.encode({1, parse_hex("5322"), 0}), std::invalid_argument);
+    EXPECT_THROW(func.encode({1, address, 128}), std::invalid_argument);
+    EXPECT_THROW(func.encode({1, address}), std::invalid_argument);
+    EXPECT_THROW(func.encode({std::string("x"), address, 0}), std::invalid_argument);
+}
@@ -185,3 +185,31 @@ TEST(ContractCall, GetAmountsOut) {
 
     EXPECT_EQ(decoded.value(), expected);
 }
+
+TEST(ContractCall, CompiledAbi) {
+    const auto erc20 = CompiledAbi(load_json(TESTS_ROOT + "/Ethereum/Data/erc20.json"));
+    EXPECT_EQ(erc20.size(), 3ul);
+    const auto uniswap = CompiledAbi(load_json(TESTS_ROOT + "/Ethereum/Data/uniswap_router_v2.json"));
+    const auto approval = parse_hex("095ea7b30000000000000000000000005aaeb6053f3e94c9b9a09f33669435e7ef1beaed"
+                                    "0000000000000000000000000000000000000000000000000000000000000001");
+    const auto transfer = parse_hex("a9059cbb0000000000000000000000005aaeb6053f3e94c9b9a09f33669435e7ef1beaed"
+                                    "00000000000000000000000000000000000000000000000000000000000003e8");
+    const auto calls = std::vector<Data>{approval, transfer, Data(), parse_hex("0xa22cb46500"), Data(approval.begin(), approval.end() - 1)};
+    const auto decoded = erc20.decodeCalls(calls);
+    ASSERT_EQ(decoded.size(), calls.size());
+    for (size_t i = 0; i < calls.size(); ++i) {
+        EXPECT_EQ(decoded[i], decodeCall(calls[i], load_json(TESTS_ROOT + "/Ethereum/Data/erc20.json"))) << i;
+    }
+    EXPECT_TRUE(decoded[0].has_value());
+    EXPECT_TRUE(decoded[1].has_value());
+    EXPECT_FALSE(decoded[4].has_value());
+    EXPECT_FALSE(uniswap.decodeCall(approval).has_value());
+
+    // keys that are not the selector of their signature never match
+    const auto abi = nlohmann::json::parse(R"|({"095ea7b4":{"name":"approve","inputs":[{"name":"a","type":"address"},{"name":"v","type":"uint256"}]},"note":1})|");
+    EXPECT_EQ(CompiledAbi(abi).size(), 0ul);
+    auto call = approval;
+    call[3] = 0xb4;
+    EXPECT_FALSE(decodeCall(call, abi).has_value());
+    EXPECT_EQ(CompiledAbi(nlohmann::json("{}")).size(), 0ul);
+}
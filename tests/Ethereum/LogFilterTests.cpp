@@ -0,0 +1,117 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/LogFilter.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Ethereum;
+
+namespace {
+
+const auto transferTopic = parse_hex("ddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef");
+const auto approvalTopic = parse_hex("8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925");
+const auto usdt = Address("0xdAC17F958D2ee523a2206206994597C13D831ec7");
+const auto dai = Address("0x6B175474E89094C44Da98b954EedeAC495271d0F");
+const auto wallet = Address("0xC36edF48e21cf395B206352A1819DE658fD7f988");
+const auto other = Address("0x5322b34c88ed0691971Bf52A7047448f0f4efc84");
+
+Data topic(const Address& address) {
+    Data result(12);
+    append(result, Data(address.bytes.begin(), address.bytes.end()));
+    return result;
+}
+
+Data amount(uint64_t value) {
+    Data result(24);
+    for (int i = 7; i >= 0; --i) {
+        result.push_back(static_cast<byte>(value >> (8 * i)));
+    }
+    return result;
+}
+
+ABI::Log transfer(const Address& token, const Address& from, const Address& to, uint64_t value) {
+    return {{transferTopic, topic(from), topic(to)}, amount(value), Data(token.bytes.begin(), token.bytes.end())};
+}
+
+} // namespace
+
+TEST(EthereumLogFilter, BloomBits) {
+    // keccak256 of the topic starts with ada3 89e1 fc24: bits 1443, 481, 1060
+    const auto bits = BloomBits::of(transferTopic);
+    EXPECT_EQ(bits.indices, (std::array<uint8_t, 3>{75, 195, 123}));
+    EXPECT_EQ(bits.masks, (std::array<byte, 3>{0x08, 0x02, 0x10}));
+
+    LogsBloom bloom = {};
+    EXPECT_FALSE(bits.in(bloom));
+    bits.addTo(bloom);
+    EXPECT_TRUE(bits.in(bloom));
+    bloom[123] = 0;
+    EXPECT_FALSE(bits.in(bloom));
+}
+
+TEST(EthereumLogFilter, MayContain) {
+    const auto filter = TransferFilter({wallet});
+    EXPECT_EQ(filter.walletCount(), 1);
+    EXPECT_EQ(filter.tokenCount(), 0);
+
+    EXPECT_TRUE(filter.mayContain(logsBloom({transfer(usdt, other, wallet, 1)})));
+    // the wallet is a recipient topic of an approval, not of a transfer
+    EXPECT_FALSE(filter.mayContain(logsBloom({{{approvalTopic, topic(other), topic(wallet)}, amount(1), Data(usdt.bytes.begin(), usdt.bytes.end())}})));
+    EXPECT_FALSE(filter.mayContain(logsBloom({transfer(usdt, other, other, 1)})));
+    EXPECT_FALSE(filter.mayContain(LogsBloom{}));
+
+    LogsBloom full;
+    full.fill(0xff);
+    EXPECT_TRUE(filter.mayContain(full));
+    EXPECT_TRUE(filter.mayContain(DataView(full)));
+    EXPECT_THROW(filter.mayContain(DataView(full.data(), 255)), std::invalid_argument);
+
+    // only transfers of the tokens
+    const auto tokenFilter = TransferFilter({wallet}, {dai});
+    EXPECT_FALSE(tokenFilter.mayContain(logsBloom({transfer(usdt, other, wallet, 1)})));
+    EXPECT_TRUE(tokenFilter.mayContain(logsBloom({transfer(usdt, other, other, 1), transfer(dai, other, wallet, 1)})));
+    const auto tokensFilter = TransferFilter({wallet, wallet}, {dai, usdt});
+    EXPECT_EQ(tokensFilter.walletCount(), 1);
+    EXPECT_EQ(tokensFilter.tokenCount(), 2);
+    EXPECT_TRUE(tokensFilter.mayContain(logsBloom({transfer(usdt, other, wallet, 1)})));
+}
+
+TEST(EthereumLogFilter, Transfers) {
+    const auto first = Address("0x0000000000000000000000000000000000000001");
+    const auto logs = std::vector<ABI::Log>{
+        transfer(usdt, other, wallet, 2000000),
+        transfer(usdt, wallet, other, 5),
+        {{approvalTopic, topic(other), topic(wallet)}, amount(1), Data(usdt.bytes.begin(), usdt.bytes.end())},
+        // ERC-721, the token id is indexed
+        {{transferTopic, topic(other), topic(wallet), amount(7)}, {}, Data(dai.bytes.begin(), dai.bytes.end())},
+        // not a valid encoding
+        {{transferTopic, topic(other), topic(wallet)}, Data(3), Data(usdt.bytes.begin(), usdt.bytes.end())},
+        transfer(dai, first, wallet, 1),
+    };
+
+    const auto all = TransferFilter({other, wallet}).transfers(logs);
+    ASSERT_EQ(all.size(), 3);
+    EXPECT_EQ(all[0].logIndex, 0);
+    EXPECT_EQ(all[0].token, usdt);
+    EXPECT_EQ(all[0].from, other);
+    EXPECT_EQ(all[0].to, wallet);
+    EXPECT_EQ(all[0].value, 2000000);
+    EXPECT_EQ(all[1].logIndex, 1);
+    EXPECT_EQ(all[1].to, other);
+    EXPECT_EQ(all[1].value, 5);
+    EXPECT_EQ(all[2].logIndex, 5);
+    EXPECT_EQ(all[2].from, first);
+    EXPECT_EQ(all[2].token, dai);
+
+    const auto dais = TransferFilter({wallet}, {dai}).transfers(logs);
+    ASSERT_EQ(dais.size(), 1);
+    EXPECT_EQ(dais[0].logIndex, 5);
+
+    EXPECT_TRUE(TransferFilter({first}).transfers(logs).empty());
+}
@@ -5,6 +5,8 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "Ethereum/RLP.h"
+#include "Ethereum/RLPReader.h"
+#include "Hashers.h"
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
@@ -81,6 +83,72 @@ TEST(RLP, Invalid) {
     ASSERT_TRUE(RLP::encodeList(std::vector<int>{0, -1}).empty());
 }
 
+TEST(RLP, Writer) {
+    const auto longString = std::string(60, 'a');
+    const auto payload = Data(1100, 0x42);
+    const auto nested = [&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(uint256_t(1024))
+                .item(longString)
+                .list([&](auto& inner) { inner.item(0).item(Data{0x7f}).item(payload); })
+                .itemList(std::vector<std::string>{"cat", "dog"});
+        });
+    };
+
+    auto inner = Data();
+    append(inner, RLP::encode(0));
+    append(inner, RLP::encode(Data{0x7f}));
+    append(inner, RLP::encode(payload));
+    auto outer = Data();
+    append(outer, RLP::encode(uint256_t(1024)));
+    append(outer, RLP::encode(longString));
+    append(outer, RLP::encodeList(inner));
+    append(outer, RLP::encodeList(std::vector<std::string>{"cat", "dog"}));
+    const auto expected = RLP::encodeList(outer);
+
+    RLPSizer sizer;
+    nested(sizer);
+    EXPECT_EQ(sizer.size, expected.size());
+
+    const auto encoded = rlpEncode(nested);
+    EXPECT_EQ(hex(encoded), hex(expected));
+    EXPECT_EQ(encoded.capacity(), expected.size());
+
+    Hash::Keccak256Hasher hasher;
+    EXPECT_TRUE(rlpWrite(hasher, nested));
+    EXPECT_EQ(hex(hasher.final()), hex(Hash::keccak256(expected)));
+
+    Hash::Keccak256Hasher unused;
+    EXPECT_FALSE(rlpWrite(unused, [](auto& rlp) { rlp.item(1).item(-1); }));
+    EXPECT_EQ(hex(unused.final()), hex(Hash::keccak256(Data())));
+}
+
+TEST(RLP, WriterEncodedString) {
+    const auto longString = std::string(60, 'a');
+    const auto embedded = [&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.encodedString([&](auto& payload) { payload.item(longString).item(uint256_t(1024)); })
+                .encodedString([](auto& payload) { payload.item(Data{0x7f}); })
+                .encodedString([](auto& payload) { payload.item(Data{0x81}); });
+        });
+    };
+
+    auto payload = Data();
+    append(payload, RLP::encode(longString));
+    append(payload, RLP::encode(uint256_t(1024)));
+    auto outer = Data();
+    append(outer, RLP::encode(payload));
+    // single byte payloads below 0x80 have no header
+    append(outer, RLP::encode(RLP::encode(Data{0x7f})));
+    append(outer, RLP::encode(RLP::encode(Data{0x81})));
+    const auto expected = RLP::encodeList(outer);
+
+    RLPSizer sizer;
+    embedded(sizer);
+    EXPECT_EQ(sizer.size, expected.size());
+    EXPECT_EQ(hex(rlpEncode(embedded)), hex(expected));
+}
+
 TEST(RLP, Decode) {
     {
         // empty string
@@ -196,3 +264,72 @@ TEST(RLP, DecodeInvalid) {
     EXPECT_THROW(RLP::decode(parse_hex("fb00000040000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f")), std::invalid_argument);
     EXPECT_THROW(RLP::decode(parse_hex("f800")), std::invalid_argument);
 }
+
+TEST(RLP, Reader) {
+    const auto longString = std::string(60, 'a');
+    const auto encoded = rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(uint256_t(1024))
+                .item(longString)
+                .list([&](auto& inner) { inner.item(0).item(Data{0x7f}).item(Data(1100, 0x42)); })
+                .itemList(std::vector<int>());
+        });
+    });
+
+    const auto root = RLPReader::parse(encoded);
+    ASSERT_TRUE(root.isList());
+    EXPECT_EQ(root.offset(), 0);
+    EXPECT_EQ(root.length(), encoded.size());
+    EXPECT_EQ(root.count(), 4);
+
+    EXPECT_EQ(root[0].toUInt256(), UInt256(1024));
+    EXPECT_EQ(root[1].toString(), longString);
+    EXPECT_EQ(root[1].offset(), 6);
+    EXPECT_EQ(root[1].length(), 62);
+    // views point into the source buffer
+    EXPECT_EQ(root[1].payload().data(), encoded.data() + 8);
+
+    const auto inner = root[2];
+    ASSERT_TRUE(inner.isList());
+    EXPECT_EQ(inner.count(), 3);
+    EXPECT_TRUE(inner[0].toUInt256().isZero());
+    EXPECT_EQ(hex(inner[1].toData()), "7f");
+    EXPECT_EQ(inner[2].payload().size(), 1100);
+    EXPECT_EQ(inner.encoded().data(), encoded.data() + inner.offset());
+    EXPECT_EQ(inner.length(), 1108);
+
+    EXPECT_TRUE(root[3].isList());
+    EXPECT_EQ(root[3].count(), 0);
+    EXPECT_THROW(root[4], std::out_of_range);
+    EXPECT_THROW(root[1].items(), std::invalid_argument);
+    EXPECT_THROW(root.toData(), std::invalid_argument);
+
+    // sequential reading
+    auto reader = root.items();
+    reader.skip(2);
+    EXPECT_EQ(reader.offset(), inner.offset());
+    EXPECT_EQ(reader.next().offset(), inner.offset());
+    reader.next();
+    EXPECT_TRUE(reader.empty());
+    EXPECT_THROW(reader.next(), std::invalid_argument);
+}
+
+TEST(RLP, ReaderInvalid) {
+    // trailing bytes
+    EXPECT_THROW(RLPReader::parse(parse_hex("0102")), std::invalid_argument);
+    // truncated
+    EXPECT_THROW(RLPReader::parse(parse_hex("836361")), std::invalid_argument);
+    EXPECT_THROW(RLPReader::parse(parse_hex("b90400")), std::invalid_argument);
+    // non canonical
+    EXPECT_THROW(RLPReader::parse(parse_hex("8101")), std::invalid_argument);
+    EXPECT_THROW(RLPReader::parse(parse_hex("b80100")), std::invalid_argument);
+    EXPECT_THROW(RLPReader::parse(parse_hex("b9000100")), std::invalid_argument);
+    // invalid nested item, only found on validation
+    const auto nested = parse_hex("c3c28101");
+    EXPECT_THROW(RLPReader::parse(nested), std::invalid_argument);
+    EXPECT_NO_THROW(RLPReader(nested).next());
+    // numbers
+    EXPECT_THROW(RLPReader::parse(parse_hex("820001")).toUInt256(), std::invalid_argument);
+    EXPECT_THROW(RLPReader::parse(parse_hex("a1010000000000000000000000000000000000000000000000000000000000000000")).toUInt256(), std::invalid_argument);
+    EXPECT_THROW(RLPReader(Data()).next(), std::invalid_argument);
+}
@@ -0,0 +1,119 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/RLP.h"
+#include "Ethereum/RLPWriter.h"
+#include "Ethereum/SignedTransaction.h"
+#include "Ethereum/Signer.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Ethereum {
+
+static const auto privateKey = PrivateKey(parse_hex("0x4646464646464646464646464646464646464646464646464646464646464646"));
+static const auto recipient = parse_hex("0x3535353535353535353535353535353535353535");
+
+static Data signedTransaction(uint64_t chainID, uint64_t nonce, const Data& payload = {}) {
+    auto transaction = Transaction(nonce, 20000000000, 21000, recipient, 1000000000000000000, payload);
+    Signer(chainID).sign(privateKey, transaction);
+    return RLP::encode(transaction);
+}
+
+TEST(EthereumSignedTransaction, EIP155) {
+    // example of EIP-155
+    const auto encoded = parse_hex("f86c098504a817c800825208943535353535353535353535353535353535353535880de0b6b3a76400008025a028ef61340bd939bc2195fe537567866003e1a15d3c71ff63e1590620aa636276a067cbe9d8997f761aecb703304b3800ccf555c9f3dc64214b297fb1966a3b6d83");
+    const auto decoded = decodeSigned(encoded);
+    EXPECT_EQ(decoded.transaction.nonce, 9);
+    EXPECT_EQ(decoded.transaction.gasPrice, 20000000000);
+    EXPECT_EQ(decoded.transaction.gasLimit, 21000);
+    EXPECT_EQ(hex(decoded.transaction.to), hex(recipient));
+    EXPECT_EQ(decoded.transaction.amount, 1000000000000000000);
+    EXPECT_TRUE(decoded.transaction.payload.empty());
+    EXPECT_EQ(decoded.transaction.v, 37);
+    EXPECT_EQ(decoded.chainID, 1);
+    EXPECT_EQ(hex(decoded.signingHash), "daf5a779ae972f972197303d7b574746c7ef83eadac0f2791ad23db92e4c8e53");
+    EXPECT_EQ(hex(decoded.hash), hex(Hash::keccak256(encoded)));
+    EXPECT_EQ(decoded.sender.string(), "0x9d8A62f656a8d1615C1294fd71e9CFb3E4855A4F");
+    EXPECT_EQ(hex(RLP::encode(decoded.transaction)), hex(encoded));
+}
+
+TEST(EthereumSignedTransaction, Chains) {
+    const auto sender = Address(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended));
+    // Ethereum, Ethereum Classic, Smart Chain, Polygon
+    for (const auto chainID : {1, 61, 56, 137}) {
+        const auto encoded = signedTransaction(chainID, 3, parse_hex("a9059cbb"));
+        const auto decoded = decodeSigned(encoded);
+        EXPECT_EQ(decoded.chainID, chainID);
+        EXPECT_EQ(decoded.sender, sender) << chainID;
+        EXPECT_EQ(hex(decoded.transaction.payload), "a9059cbb");
+        EXPECT_EQ(hex(RLP::encode(decoded.transaction)), hex(encoded));
+    }
+}
+
+TEST(EthereumSignedTransaction, WithoutReplayProtection) {
+    auto transaction = Transaction(0, 20000000000, 21000, {}, 0, parse_hex("6000"));
+    const auto hash = Hash::keccak256(rlpEncode([&](auto& rlp) {
+        rlp.list([&](auto& list) {
+            list.item(transaction.nonce).item(transaction.gasPrice).item(transaction.gasLimit).item(transaction.to).item(transaction.amount).item(transaction.payload);
+        });
+    }));
+    std::tie(transaction.r, transaction.s, transaction.v) = Signer::sign(0, privateKey, hash);
+    const auto decoded = decodeSigned(RLP::encode(transaction));
+    EXPECT_EQ(decoded.chainID, 0);
+    EXPECT_TRUE(decoded.transaction.v == 27 || decoded.transaction.v == 28);
+    EXPECT_TRUE(decoded.transaction.to.empty());
+    EXPECT_EQ(hex(decoded.signingHash), hex(hash));
+    EXPECT_EQ(decoded.sender, Address(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended)));
+}
+
+TEST(EthereumSignedTransaction, Invalid) {
+    const auto encoded = signedTransaction(1, 9);
+    EXPECT_THROW(decodeSigned(Data()), std::invalid_argument);
+    EXPECT_THROW(decodeSigned(Data(encoded.begin(), encoded.end() - 1)), std::invalid_argument);
+    EXPECT_THROW(decodeSigned(parse_hex("02f86c")), std::invalid_argument);
+
+    auto transaction = Transaction(9, 20000000000, 21000, recipient, 1000000000000000000);
+    Signer(1).sign(privateKey, transaction);
+    auto invalid = transaction;
+    invalid.v = 30;
+    EXPECT_THROW(decodeSigned(RLP::encode(invalid)), std::invalid_argument);
+    // the same signature with a high s value
+    invalid = transaction;
+    invalid.s = uint256_t("0xfffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141") - transaction.s;
+    invalid.v = transaction.v == 37 ? 38 : 37;
+    EXPECT_THROW(decodeSigned(RLP::encode(invalid)), std::invalid_argument);
+    invalid = transaction;
+    invalid.to = Data(19);
+    EXPECT_THROW(decodeSigned(RLP::encode(invalid)), std::invalid_argument);
+    invalid = transaction;
+    invalid.r = 0;
+    EXPECT_THROW(decodeSigned(RLP::encode(invalid)), std::invalid_argument);
+}
+
+TEST(EthereumSignedTransaction, Many) {
+    std::vector<Data> encoded;
+    for (uint64_t i = 0; i < 40; ++i) {
+        encoded.push_back(i % 10 == 7 ? parse_hex("c0") : signedTransaction(56, i));
+    }
+    const auto decoded = decodeSignedMany(encoded, 3);
+    ASSERT_EQ(decoded.size(), encoded.size());
+    for (size_t i = 0; i < decoded.size(); ++i) {
+        if (i % 10 == 7) {
+            EXPECT_FALSE(decoded[i].has_value());
+            continue;
+        }
+        ASSERT_TRUE(decoded[i].has_value()) << i;
+        EXPECT_EQ(decoded[i]->transaction.nonce, i);
+        EXPECT_EQ(hex(decoded[i]->signingHash), hex(decodeSigned(encoded[i]).signingHash));
+        EXPECT_EQ(decoded[i]->sender.string(), "0x9d8A62f656a8d1615C1294fd71e9CFb3E4855A4F");
+    }
+    EXPECT_TRUE(decodeSignedMany({}).empty());
+}
+
+} // namespace TW::Ethereum
@@ -6,9 +6,12 @@
 
 #include "../interface/TWTestUtilities.h"
 #include <TrustWalletCore/TWAnySigner.h>
+#include "Coin.h"
 #include "HexCoding.h"
+#include "ProtobufWriter.h"
 #include "uint256.h"
 #include "proto/Ethereum.pb.h"
+#include "Ethereum/Signer.h"
 #include "Ethereum/ABI/Function.h"
 #include "Ethereum/ABI/ParamBase.h"
 #include "Ethereum/ABI/ParamAddress.h"
@@ -106,6 +109,15 @@ TEST(TWAnySignerEthereum, SignERC20TransferAsERC20) {
 
     ASSERT_EQ(hex(output.encoded()), expected);
 
+    // typed signing, without serialization
+    const auto typedOutput = anyCoinSign<Proto::SigningInput, Proto::SigningOutput>(TWCoinTypeEthereum, input);
+    EXPECT_EQ(hex(typedOutput.encoded()), expected);
+    EXPECT_EQ(typedOutput.SerializeAsString(), output.SerializeAsString());
+
+    // message types not matching the coin
+    EXPECT_THROW((anyCoinSign<Proto::SigningInput, Proto::SigningOutput>(TWCoinTypeBitcoin, input)), std::invalid_argument);
+    EXPECT_THROW((anyCoinSign<Proto::SigningInput, Proto::Transaction>(TWCoinTypeEthereum, input)), std::invalid_argument);
+
     // expected payload
     Data payload;
     {
@@ -292,6 +304,55 @@ TEST(TWAnySignerEthereum, SignERC1155Transfer) {
     ASSERT_EQ(hex(output.data()), "f242432a000000000000000000000000718046867b5b1782379a14ea4fc0c9b724da94fc0000000000000000000000005322b34c88ed0691971bf52a7047448f0f4efc840000000000000000000000000000000000000000000000000000000023c47ee50000000000000000000000000000000000000000000000001bc16d674ec8000000000000000000000000000000000000000000000000000000000000000000a000000000000000000000000000000000000000000000000000000000000000040102030400000000000000000000000000000000000000000000000000000000");
 }
 
+TEST(TWAnySignerEthereum, SignLargePayload) {
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(3));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(3000000));
+    const auto key = parse_hex("0x608dcb1742bb3fb7aec002074e3420e4fab7d00cced79ccdac53ed5b27138151");
+    Data payload(20000);
+    for (std::size_t i = 0; i < payload.size(); ++i) {
+        payload[i] = static_cast<byte>(i * 7);
+    }
+
+    // a contract deployment
+    Proto::SigningInput input;
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_contract_generic()->set_data(payload.data(), payload.size());
+    const auto expected = Signer::sign(input);
+    ASSERT_EQ(hex(expected.data()), hex(payload));
+
+    Proto::SigningOutput output;
+    ANY_SIGN(input, TWCoinTypeEthereum);
+    EXPECT_EQ(output.SerializeAsString(), expected.SerializeAsString());
+
+    input.set_to_address("0x6b175474e89094c44da98b954eedeac495271d0f");
+    input.mutable_transaction()->mutable_transfer()->set_data(payload.data(), payload.size());
+    ANY_SIGN(input, TWCoinTypeEthereum);
+    EXPECT_EQ(output.SerializeAsString(), Signer::sign(input).SerializeAsString());
+    EXPECT_EQ(hex(output.data()), hex(payload));
+
+    // a later transaction of the input replaces the one of the payload
+    Proto::Transaction replacement;
+    const auto amount = store(uint256_t(1000));
+    replacement.mutable_contract_generic()->set_amount(amount.data(), amount.size());
+    const auto transactions = input.transaction().SerializeAsString() + replacement.SerializeAsString();
+    input.clear_transaction();
+    auto serialized = data(input.SerializeAsString());
+    ProtobufWriter(serialized).message(7, transactions);
+    Proto::SigningInput merged;
+    ASSERT_TRUE(merged.ParseFromArray(serialized.data(), static_cast<int>(serialized.size())));
+    ASSERT_TRUE(merged.transaction().has_contract_generic());
+    Data signedData;
+    Signer::sign(serialized, signedData);
+    EXPECT_EQ(hex(signedData), hex(Signer::sign(merged).SerializeAsString()));
+    EXPECT_TRUE(Signer::sign(merged).data().empty());
+}
+
 TEST(TWAnySignerEthereum, SignJSON) {
     auto json = STRING(R"({"chainId":"AQ==","gasPrice":"1pOkAA==","gasLimit":"Ugg=","toAddress":"0x7d8bf18C7cE84b3E175b339c4Ca93aEd1dD166F1","transaction":{"transfer":{"amount":"A0i8paFgAA=="}}})");
     auto key = DATA("17209af590a86462395d5881e60d11c7fa7d482cfb02b5a01b93c2eeef243543");
@@ -109,6 +109,45 @@ TEST(TWEthereumAbi, EncodeFuncCase1) {
     TWEthereumAbiFunctionDelete(func);
 }
 
+TEST(TWEthereumAbi, EncodeFuncArrayFromBuffer) {
+    TWEthereumAbiFunction* func = TWEthereumAbiFunctionCreateWithString(WRAPS(TWStringCreateWithUTF8Bytes("sam")).get());
+    EXPECT_TRUE(func != nullptr);
+
+    EXPECT_EQ(0, TWEthereumAbiFunctionAddParamBytes(func, WRAPD(TWDataCreateWithHexString(WRAPS(TWStringCreateWithUTF8Bytes("64617665")).get())).get(), false));
+    EXPECT_EQ(1, TWEthereumAbiFunctionAddParamBool(func, true, false));
+    const auto numbers = WRAPD(TWDataCreateWithHexString(WRAPS(TWStringCreateWithUTF8Bytes(
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000003")).get()));
+    EXPECT_EQ(2, TWEthereumAbiFunctionAddParamArrayFromBuffer(func, WRAPS(TWStringCreateWithUTF8Bytes("uint256")).get(), numbers.get(), false));
+    // the elements are all given at once
+    EXPECT_EQ(-1, TWEthereumAbiFunctionAddInArrayParamUInt256(func, 2, numbers.get()));
+    // unsupported type, partial element
+    EXPECT_EQ(-1, TWEthereumAbiFunctionAddParamArrayFromBuffer(func, WRAPS(TWStringCreateWithUTF8Bytes("string")).get(), numbers.get(), false));
+    const auto partial = WRAPD(TWDataCreateWithHexString(WRAPS(TWStringCreateWithUTF8Bytes("0102")).get()));
+    EXPECT_EQ(-1, TWEthereumAbiFunctionAddParamArrayFromBuffer(func, WRAPS(TWStringCreateWithUTF8Bytes("address")).get(), partial.get(), false));
+
+    auto type = WRAPS(TWEthereumAbiFunctionGetType(func));
+    EXPECT_EQ("sam(bytes,bool,uint256[])", std::string(TWStringUTF8Bytes(type.get())));
+
+    // as EncodeFuncCase1
+    auto encoded = WRAPD(TWEthereumAbiEncode(func));
+    Data enc2 = data(TWDataBytes(encoded.get()), TWDataSize(encoded.get()));
+    EXPECT_EQ("a5643bf2"
+        "0000000000000000000000000000000000000000000000000000000000000060"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "00000000000000000000000000000000000000000000000000000000000000a0"
+        "0000000000000000000000000000000000000000000000000000000000000004"
+        "6461766500000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000003"
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000003",
+        hex(enc2));
+
+    TWEthereumAbiFunctionDelete(func);
+}
+
 TEST(TWEthereumAbi, EncodeFuncCase2) {
     TWEthereumAbiFunction* func = TWEthereumAbiFunctionCreateWithString(WRAPS(TWStringCreateWithUTF8Bytes("f")).get());
     EXPECT_TRUE(func != nullptr);
@@ -0,0 +1,122 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/ABI/TypedData.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+using json = nlohmann::json;
+
+namespace {
+
+const auto mailTypedData = json::parse(R"({
+    "types": {
+        "EIP712Domain": [
+            {"name": "name", "type": "string"},
+            {"name": "version", "type": "string"},
+            {"name": "chainId", "type": "uint256"},
+            {"name": "verifyingContract", "type": "address"}
+        ],
+        "Person": [
+            {"name": "name", "type": "string"},
+            {"name": "wallet", "type": "address"}
+        ],
+        "Mail": [
+            {"name": "from", "type": "Person"},
+            {"name": "to", "type": "Person"},
+            {"name": "contents", "type": "string"}
+        ]
+    },
+    "primaryType": "Mail",
+    "domain": {
+        "name": "Ether Mail",
+        "version": "1",
+        "chainId": 1,
+        "verifyingContract": "0xCcCCccccCCCCcCCCCCCcCcCccCcCCCcCcccccccC"
+    },
+    "message": {
+        "from": {"name": "Cow", "wallet": "0xCD2a3d9F938E13CD947Ec05AbC7FE734Df8DD826"},
+        "to": {"name": "Bob", "wallet": "0xbBbBBBBbbBBBbbbBbbBbbbbBBbBbbbbBbBbbBBbB"},
+        "contents": "Hello, Bob!"
+    }
+})");
+
+} // namespace
+
+TEST(EthereumTypedData, Mail) {
+    const auto types = TypedData(mailTypedData["types"]);
+    EXPECT_EQ(types.encodeType("Mail"), "Mail(Person from,Person to,string contents)Person(string name,address wallet)");
+    EXPECT_EQ(hex(types.typeHash("Mail")), "a0cedeb2dc280ba39b857546d74f5549c3a1d7bdc2dd96bf881f76108e23dac2");
+
+    const auto domainSeparator = types.domainSeparator(mailTypedData["domain"]);
+    EXPECT_EQ(hex(domainSeparator), "f2cee375fa42b42143804025fc449deafd50cc031ca257e0b194a650a912090f");
+    EXPECT_EQ(hex(types.hashStruct("Mail", mailTypedData["message"])), "c52c0ee5d84264471806290a3f2c4cecfc5490626bf912d01f240d7a274b371e");
+    EXPECT_EQ(hex(types.hash(domainSeparator, "Mail", mailTypedData["message"])), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+    EXPECT_EQ(hex(TypedData::hashTypedData(mailTypedData)), "be609aee343fb3c4b28e1df9e632fca64fcfaede20f02e86244efddf30957bd2");
+}
+
+TEST(EthereumTypedData, Batch) {
+    const auto types = TypedData(mailTypedData["types"]);
+    const auto domainSeparator = types.domainSeparator(mailTypedData["domain"]);
+    std::vector<json> messages;
+    for (int i = 0; i < 7; ++i) {
+        auto message = mailTypedData["message"];
+        message["contents"] = "Hello #" + std::to_string(i);
+        messages.push_back(message);
+    }
+    const auto hashes = types.hashBatch(domainSeparator, "Mail", messages);
+    ASSERT_EQ(hashes.size(), messages.size());
+    for (std::size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(hex(hashes[i]), hex(types.hash(domainSeparator, "Mail", messages[i])));
+    }
+    EXPECT_TRUE(types.hashBatch(domainSeparator, "Mail", {}).empty());
+}
+
+TEST(EthereumTypedData, ArraysAndNumbers) {
+    const auto types = TypedData(json::parse(R"({
+        "Order": [
+            {"name": "amounts", "type": "uint256[]"},
+            {"name": "delta", "type": "int8"},
+            {"name": "salt", "type": "bytes4"},
+            {"name": "data", "type": "bytes"}
+        ]
+    })"));
+    EXPECT_EQ(types.encodeType("Order"), "Order(uint256[] amounts,int8 delta,bytes4 salt,bytes data)");
+
+    const auto hash = types.hashStruct("Order", json::parse(R"({"amounts": [1, "0x02", "3"], "delta": -1, "salt": "0x01020304", "data": "0xabcd"})"));
+    Data expected;
+    append(expected, types.typeHash("Order"));
+    append(expected, Hash::keccak256(parse_hex(
+        "0000000000000000000000000000000000000000000000000000000000000001"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000003")));
+    append(expected, parse_hex("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"));
+    append(expected, parse_hex("0102030400000000000000000000000000000000000000000000000000000000"));
+    append(expected, Hash::keccak256(parse_hex("abcd")));
+    EXPECT_EQ(hex(hash), hex(Hash::keccak256(expected)));
+
+    EXPECT_EQ(hex(types.hashStruct("Order", json::parse(R"({"amounts": [], "delta": "-128", "salt": "0x", "data": "0x"})"))),
+              hex(types.hashStruct("Order", json::parse(R"({"amounts": [], "delta": -128, "salt": "0x00", "data": ""})"))));
+}
+
+TEST(EthereumTypedData, Invalid) {
+    EXPECT_THROW(TypedData(json::parse(R"({"A": [{"name": "b", "type": "B"}]})")), std::invalid_argument);
+    EXPECT_THROW(TypedData(json::parse(R"({"A": [{"name": "b"}]})")), std::invalid_argument);
+    EXPECT_THROW(TypedData(json::parse(R"([])")), std::invalid_argument);
+
+    const auto types = TypedData(json::parse(R"({"A": [{"name": "n", "type": "uint8"}, {"name": "b", "type": "bool[2]"}]})"));
+    EXPECT_THROW(types.typeHash("B"), std::invalid_argument);
+    EXPECT_NO_THROW(types.hashStruct("A", json::parse(R"({"n": 255, "b": [true, false]})")));
+    EXPECT_THROW(types.hashStruct("A", json::parse(R"({"n": 256, "b": [true, false]})")), std::invalid_argument);
+    EXPECT_THROW(types.hashStruct("A", json::parse(R"({"n": -1, "b": [true, false]})")), std::invalid_argument);
+    EXPECT_THROW(types.hashStruct("A", json::parse(R"({"n": "1x", "b": [true, false]})")), std::invalid_argument);
+    EXPECT_THROW(types.hashStruct("A", json::parse(R"({"n": 1, "b": [true]})")), std::invalid_argument);
+    EXPECT_THROW(types.hashStruct("A", json::parse(R"({"n": 1})")), std::invalid_argument);
+    EXPECT_THROW(TypedData::hashTypedData(json::parse(R"({"types": {}})")), std::invalid_argument);
+}
@@ -0,0 +1,177 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Ethereum/ABI/CompiledEvent.h"
+#include "Ethereum/ABI/CompiledFunction.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Ethereum::ABI;
+
+namespace {
+
+const auto transferTopic = parse_hex("ddf252ad1be2c89b69c2b068fc378daa952ba7f163c4a11628f55a4df523b3ef");
+const auto from = parse_hex("0000000000000000000000005322b34c88ed0691971bf52a7047448f0f4efc84");
+const auto to = parse_hex("000000000000000000000000c36edf48e21cf395b206352a1819de658fd7f988");
+const auto amount = parse_hex("0000000000000000000000000000000000000000000000001bc16d674ec80000");
+
+struct Transfer {
+    DataView from;
+    DataView to;
+    uint256_t value;
+};
+
+} // namespace
+
+TEST(EthereumAbiCompiledEvent, Transfer) {
+    const auto event = CompiledEvent("Transfer(address indexed from, address indexed to, uint256 value)");
+    EXPECT_EQ(event.signature(), "Transfer(address,address,uint256)");
+    EXPECT_EQ(hex(event.topic()), hex(transferTopic));
+    EXPECT_EQ(event.indexed(), (std::vector<bool>{true, true, false}));
+
+    const auto topics = std::vector<Data>{transferTopic, from, to};
+    std::vector<ValueView> values;
+    ASSERT_TRUE(event.decode(topics, amount, values));
+    ASSERT_EQ(values.size(), 3);
+    EXPECT_EQ(hex(values[0].bytes()), "5322b34c88ed0691971bf52a7047448f0f4efc84");
+    EXPECT_EQ(values[0].bytes().data(), topics[1].data() + 12);
+    EXPECT_EQ(hex(values[1].bytes()), "c36edf48e21cf395b206352a1819de658fd7f988");
+    EXPECT_EQ(values[2].number().toString(), "2000000000000000000");
+
+    Transfer transfer;
+    ASSERT_TRUE(event.decodeInto(topics, amount, transfer.from, transfer.to, transfer.value));
+    EXPECT_EQ(hex(transfer.from), "5322b34c88ed0691971bf52a7047448f0f4efc84");
+    EXPECT_EQ(hex(transfer.to), "c36edf48e21cf395b206352a1819de658fd7f988");
+    EXPECT_EQ(transfer.value, uint256_t(2000000000000000000));
+
+    // other event, missing topic
+    const auto approval = CompiledEvent("Approval(address indexed,address indexed,uint256)");
+    EXPECT_FALSE(approval.decode(topics, amount, values));
+    EXPECT_FALSE(event.decode(std::vector<Data>{transferTopic, from}, amount, values));
+    EXPECT_THROW(event.decode(topics, Data(31), values), std::invalid_argument);
+}
+
+TEST(EthereumAbiCompiledEvent, DecodeAll) {
+    const auto event = CompiledEvent(nlohmann::json::parse(R"({
+        "anonymous": false,
+        "inputs": [
+            {"indexed": true, "name": "from", "type": "address"},
+            {"indexed": true, "name": "to", "type": "address"},
+            {"indexed": false, "name": "value", "type": "uint256"}
+        ],
+        "name": "Transfer",
+        "type": "event"
+    })"));
+    EXPECT_EQ(hex(event.topic()), hex(transferTopic));
+
+    auto logs = std::vector<Log>{
+        {{transferTopic, from, to}, amount},
+        {{parse_hex("8c5be1e5ebec7d5bd14f71427d1e84f3dd0314c0f7b2291e5b200ac8c7c3b925"), from, to}, amount},
+        {{transferTopic, from, to}, Data(3)},
+        {{transferTopic, to, from}, parse_hex("0000000000000000000000000000000000000000000000000000000000000001")},
+    };
+    std::vector<std::size_t> indices;
+    std::vector<std::string> values;
+    const auto count = event.decodeAll(logs, [&](std::size_t index, const std::vector<ValueView>& decoded) {
+        indices.push_back(index);
+        values.push_back(decoded[2].number().toString());
+    });
+    EXPECT_EQ(count, 2);
+    EXPECT_EQ(indices, (std::vector<std::size_t>{0, 3}));
+    EXPECT_EQ(values, (std::vector<std::string>{"2000000000000000000", "1"}));
+}
+
+TEST(EthereumAbiCompiledEvent, Dynamic) {
+    const auto event = CompiledEvent("Message(string indexed topic, string text, uint8[] codes)");
+    const auto topicHash = Hash::keccak256(std::string("news"));
+    const auto data = parse_hex(
+        "0000000000000000000000000000000000000000000000000000000000000040"
+        "0000000000000000000000000000000000000000000000000000000000000080"
+        "0000000000000000000000000000000000000000000000000000000000000005"
+        "68656c6c6f000000000000000000000000000000000000000000000000000000"
+        "0000000000000000000000000000000000000000000000000000000000000002"
+        "0000000000000000000000000000000000000000000000000000000000000007"
+        "00000000000000000000000000000000000000000000000000000000000000ff");
+    std::vector<ValueView> values;
+    ASSERT_TRUE(event.decode(std::vector<DataView>{event.topic(), topicHash}, data, values));
+    EXPECT_EQ(values[0].type().canonical, "bytes32");
+    EXPECT_EQ(hex(values[0].bytes()), hex(topicHash));
+    EXPECT_EQ(values[1].string(), "hello");
+    ASSERT_EQ(values[2].count(), 2);
+    uint8_t code = 0;
+    values[2][1].get(code);
+    EXPECT_EQ(code, 255);
+    EXPECT_THROW(values[2][2], std::out_of_range);
+}
+
+TEST(EthereumAbiValueView, DecodeCall) {
+    const auto func = CompiledFunction("f(uint256,uint32[],bytes10,string,(int8,bool)[2])");
+    const auto bytes10 = parse_hex("31323334353637383930");
+    const auto text = std::string("Hello, world!");
+    const auto encoded = func.encode({0x123, std::vector<Value>{0x456, 0x789}, bytes10, text,
+                                      std::vector<Value>{std::vector<Value>{-5, true}, std::vector<Value>{7, false}}});
+
+    std::vector<ValueView> arguments;
+    ASSERT_TRUE(func.decodeInput(encoded, arguments));
+    ASSERT_EQ(arguments.size(), 5);
+    EXPECT_EQ(arguments[0].number(), UInt256(0x123));
+    EXPECT_EQ(arguments[1].count(), 2);
+    EXPECT_EQ(arguments[1][1].number(), UInt256(0x789));
+    EXPECT_EQ(hex(arguments[2].bytes()), hex(bytes10));
+    EXPECT_EQ(arguments[3].string(), text);
+    int64_t negative = 0;
+    arguments[4][0][0].get(negative);
+    EXPECT_EQ(negative, -5);
+    EXPECT_TRUE(arguments[4][0][1].boolean());
+    EXPECT_FALSE(arguments[4][1][1].boolean());
+
+    uint64_t number = 0;
+    std::string string;
+    Data bytes;
+    ValueView list;
+    ValueView tuples;
+    ASSERT_TRUE(func.decodeInputInto(encoded, number, list, bytes, string, tuples));
+    EXPECT_EQ(number, 0x123);
+    EXPECT_EQ(list.count(), 2);
+    EXPECT_EQ(hex(bytes), hex(bytes10));
+    EXPECT_EQ(string, text);
+
+    EXPECT_FALSE(CompiledFunction("g()").decodeInput(encoded, arguments));
+    EXPECT_FALSE(func.decodeInput(Data{0x47}, arguments));
+}
+
+TEST(EthereumAbiValueView, Invalid) {
+    const auto uint8 = Type::parse("uint8");
+    EXPECT_EQ(ValueView::decode(uint8, parse_hex("00000000000000000000000000000000000000000000000000000000000000ff")).number(), UInt256(255));
+    EXPECT_THROW(ValueView::decode(uint8, parse_hex("0000000000000000000000000000000000000000000000000000000000000100")), std::invalid_argument);
+    EXPECT_THROW(ValueView::decode(Type::parse("bool"), parse_hex("0000000000000000000000000000000000000000000000000000000000000002")), std::invalid_argument);
+    EXPECT_THROW(ValueView::decode(Type::parse("address"), parse_hex("0100000000000000000000005322b34c88ed0691971bf52a7047448f0f4efc84")), std::invalid_argument);
+    EXPECT_THROW(ValueView::decode(Type::parse("bytes2"), parse_hex("3132330000000000000000000000000000000000000000000000000000000000")), std::invalid_argument);
+    EXPECT_NO_THROW(ValueView::decode(Type::parse("int8"), parse_hex("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff80")));
+    EXPECT_THROW(ValueView::decode(Type::parse("int8"), parse_hex("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff7f")), std::invalid_argument);
+
+    const auto string = Type::parse("(string)");
+    // offset out of range
+    EXPECT_THROW(ValueView::decode(string, parse_hex("0000000000000000000000000000000000000000000000000000000000000040")), std::invalid_argument);
+    // length past the end
+    EXPECT_THROW(ValueView::decode(string, parse_hex(
+        "0000000000000000000000000000000000000000000000000000000000000020"
+        "0000000000000000000000000000000000000000000000000000000000000021"
+        "3132330000000000000000000000000000000000000000000000000000000000")), std::invalid_argument);
+    // huge array length
+    EXPECT_THROW(ValueView::decode(Type::parse("(uint256[])"), parse_hex(
+        "0000000000000000000000000000000000000000000000000000000000000020"
+        "ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff")), std::invalid_argument);
+
+    const auto value = ValueView::decode(Type::parse("uint16"), parse_hex("000000000000000000000000000000000000000000000000000000000000012c"));
+    uint8_t small = 0;
+    EXPECT_THROW(value.get(small), std::invalid_argument);
+    EXPECT_THROW(value.bytes(), std::invalid_argument);
+    EXPECT_THROW(value.count(), std::invalid_argument);
+}
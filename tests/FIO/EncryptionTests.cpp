@@ -182,3 +182,64 @@ TEST(FIOEncryption, encryptEncodeDecodeDecrypt) {
     // verify that decrypted is the same as the original
     EXPECT_EQ(hex(decrypted), hex(message));
 }
+
+TEST(FIOEncryption, context) {
+    const PrivateKey privateKeyAlice(parse_hex("2bd806c97f0e00af1a1fc3328fa763a9269723c8db8fac4f93af71db186d6e90"));
+    const PrivateKey privateKeyBob(parse_hex("81b637d8fcd2c6da6359e6963113a1170de795e4b725b84d1e0b4cfd9ec58ce9"));
+    const auto alice = EncryptionContext(privateKeyAlice, privateKeyBob.getPublicKey(TWPublicKeyTypeSECP256k1));
+    const auto bob = EncryptionContext(privateKeyBob, privateKeyAlice.getPublicKey(TWPublicKeyTypeSECP256k1));
+    EXPECT_EQ(hex(alice.sharedSecret()), "a71b4ec5a9577926a1d2aa1d9d99327fd3b68f6a1ea597200a0d890bd3331df300a2d49fec0b2b3e6969ce9263c5d6cf47c191c1ef149373ecc9f0d98116b598");
+    EXPECT_EQ(hex(bob.sharedSecret()), hex(alice.sharedSecret()));
+
+    const Data message = parse_hex("0b70757273652e616c69636501310a66696f2e7265716f6274000000");
+    const Data iv = parse_hex("f300888ca4f512cebdc0020ff0f7224c");
+    const auto encrypted = alice.encrypt(message, iv);
+    EXPECT_EQ(hex(encrypted), "f300888ca4f512cebdc0020ff0f7224c0db2984c4ad9afb12629f01a8c6a76328bbde17405655dc4e3cb30dad272996fb1dea8e662e640be193e25d41147a904c571b664a7381ab41ef062448ac1e205");
+    EXPECT_EQ(hex(bob.decrypt(encrypted)), hex(message));
+    // the context is reusable
+    EXPECT_EQ(hex(alice.encrypt(message, iv)), hex(encrypted));
+
+    // same as the secret-based functions
+    const Data secret = parse_hex("02332627b9325cb70510a70f0f6be4bcb008fbbc7893ca51dedf5bf46aa740c0fc9d3fbd737d09a3c4046d221f4f1a323f515332c3fef46e7f075db561b1a2c9");
+    EXPECT_EQ(hex(EncryptionContext(secret).encrypt(TW::data("secret message"), parse_hex("f300888ca4f512cebdc0020ff0f7224c"))),
+        "f300888ca4f512cebdc0020ff0f7224c7f896315e90e172bed65d005138f224da7301d5563614e3955750e4480aabf7753f44b4975308aeb8e23c31e114962ab");
+
+    EXPECT_THROW(alice.encrypt(message, Data(5)), std::invalid_argument);
+    auto tampered = encrypted;
+    tampered[20] ^= 0x01;
+    EXPECT_THROW(bob.decrypt(tampered), std::invalid_argument);
+    EXPECT_THROW(bob.decrypt(Data(60)), std::invalid_argument);
+}
+
+TEST(FIOEncryption, contextBatch) {
+    const PrivateKey privateKeyAlice(parse_hex("2bd806c97f0e00af1a1fc3328fa763a9269723c8db8fac4f93af71db186d6e90"));
+    const PrivateKey privateKeyBob(parse_hex("81b637d8fcd2c6da6359e6963113a1170de795e4b725b84d1e0b4cfd9ec58ce9"));
+    const auto alice = EncryptionContext(privateKeyAlice, privateKeyBob.getPublicKey(TWPublicKeyTypeSECP256k1));
+    const auto bob = EncryptionContext(privateKeyBob, privateKeyAlice.getPublicKey(TWPublicKeyTypeSECP256k1));
+
+    std::vector<Data> messages;
+    for (size_t size = 0; size < 100; size += 7) {
+        messages.push_back(Data(size, static_cast<TW::byte>(size)));
+    }
+    const auto encrypted = alice.encryptBatch(messages);
+    ASSERT_EQ(encrypted.size(), messages.size());
+    // random initial vectors
+    EXPECT_NE(hex(subData(encrypted[0], 0, 16)), hex(subData(encrypted[1], 0, 16)));
+    const auto decrypted = bob.decryptBatch(encrypted);
+    ASSERT_EQ(decrypted.size(), messages.size());
+    for (size_t i = 0; i < messages.size(); ++i) {
+        EXPECT_EQ(hex(decrypted[i]), hex(messages[i]));
+        EXPECT_EQ(hex(Encryption::decrypt(privateKeyBob, privateKeyAlice.getPublicKey(TWPublicKeyTypeSECP256k1), encrypted[i])), hex(messages[i]));
+    }
+
+    auto invalid = encrypted;
+    invalid.back().back() ^= 0x01;
+    EXPECT_THROW(bob.decryptBatch(invalid), std::invalid_argument);
+}
+
+TEST(FIOEncryption, contextInvalidPublicKey) {
+    const PrivateKey privateKey(parse_hex("2bd806c97f0e00af1a1fc3328fa763a9269723c8db8fac4f93af71db186d6e90"));
+    // valid prefix and size, but not on the curve
+    const PublicKey publicKey(parse_hex("020000000000000000000000000000000000000000000000000000000000000005"), TWPublicKeyTypeSECP256k1);
+    EXPECT_THROW(EncryptionContext(privateKey, publicKey), std::invalid_argument);
+}
@@ -8,6 +8,8 @@
 #include "Filecoin/Signer.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
+#include "uint256.h"
+#include "BatchSigningHelper.h"
 
 #include <gtest/gtest.h>
 
@@ -40,4 +42,28 @@ TEST(FilecoinSigner, Sign) {
     ASSERT_EQ(tx.serialize(signature), R"({"Message":{"From":"f1z4a36sc7mfbv4z3qwutblp2flycdui3baffytbq","GasFeeCap":"456456456456445645","GasLimit":23423423423423,"GasPremium":"5675674564734345","Nonce":1,"To":"f1rletqqhinhagw6nxjcr4kbfws25thgt7owzuruy","Value":"6000"},"Signature":{"Data":"3GOUpn2Wiwe20QXLC8ixx23WiKDwrVkfxYi3CgzZ5jBVKZT4WUOZNuZhpUFky0PqGaM7vErEOi//yqBGSIQQUAA=","Type":1}})");
 }
 
+TEST(FilecoinSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        Proto::SigningInput input;
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "1d969865e189957b9824bd34f26d5cbf357fda1a6d844cbf0c9ab1ed93fa7dbe"
+                                                                   : "2f0f1d2c8de955c7c3fb4d9cae02539fadcb13fa998ccd9a1e871bed95f1941e");
+        input.set_private_key(privateKey.data(), privateKey.size());
+        if (i == 30) {
+            input.set_to("f1invalid");
+        } else {
+            input.set_to(i % 2 == 0 ? "f1rletqqhinhagw6nxjcr4kbfws25thgt7owzuruy" : "f1hvadvq4rd2pyayrigjx2nbqz2nvemqouslw4wxi");
+        }
+        input.set_nonce(i);
+        const auto value = store(uint256_t(6000 + i));
+        input.set_value(value.data(), value.size());
+        input.set_gas_limit(23423423423423);
+        const auto gasFeeCap = store(uint256_t(456456456456445645));
+        input.set_gas_fee_cap(gasFeeCap.data(), gasFeeCap.size());
+        const auto gasPremium = store(uint256_t(5675674564734345));
+        input.set_gas_premium(gasPremium.data(), gasPremium.size());
+        return input;
+    }, {30});
+}
+
 } // namespace TW::Filecoin
@@ -14,9 +14,15 @@
 #include "Hash.h"
 #include "Base58.h"
 #include "Coin.h"
+#include "Secp256k1Comb.h"
+
+#include <TrezorCrypto/bip39.h>
+#include <TrezorCrypto/sha2_hw.h>
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
 namespace TW {
 
 TEST(HDWallet, privateKeyFromXPRV) {
@@ -124,4 +130,274 @@ TEST(HDWallet, DeriveWithLeadingZerosEth) {
     EXPECT_EQ(addr.string(), "0x0ba17e928471c64AaEaf3ABfB3900EF4c27b380D");
 }
 
+TEST(HDWallet, DeriveAddresses) {
+    const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    auto wallet = HDWallet(mnemonic, "TREZOR");
+    for (auto coin : {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeCosmos, TWCoinTypeNEO}) {
+        const auto addresses = wallet.deriveAddresses(coin, 0, 0, 5, 4);
+        ASSERT_EQ(addresses.size(), 4);
+        for (uint32_t i = 0; i < addresses.size(); ++i) {
+            const auto path = DerivationPath(TW::purpose(coin), TW::slip44Id(coin), 0, 0, 5 + i);
+            EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, path)));
+        }
+    }
+
+    // public keys computed in several batches, and one by one without the comb table
+    for (auto window : {Secp256k1Comb::defaultWindow, 0}) {
+        Secp256k1Comb::setWindow(window);
+        for (auto coin : {TWCoinTypeBitcoin, TWCoinTypeEthereum}) {
+            const auto addresses = wallet.deriveAddresses(coin, 0, 1, 0, 70);
+            ASSERT_EQ(addresses.size(), 70);
+            for (uint32_t i = 0; i < addresses.size(); i += 23) {
+                const auto path = DerivationPath(TW::purpose(coin), TW::slip44Id(coin), 0, 1, i);
+                EXPECT_EQ(addresses[i], TW::deriveAddress(coin, wallet.getKey(coin, path))) << window << " " << i;
+            }
+        }
+    }
+    Secp256k1Comb::setWindow(Secp256k1Comb::defaultWindow);
+
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0, 1)[0], "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85");
+    EXPECT_EQ(wallet.deriveAddresses(TWCoinTypeBitcoin, 0, 0, 0, 0).size(), 0);
+
+    // last non-hardened index
+    const auto last = wallet.deriveAddresses(TWCoinTypeEthereum, 0, 0, 0x7fffffff, 1);
+    ASSERT_EQ(last.size(), 1);
+    EXPECT_EQ(last[0], TW::deriveAddress(TWCoinTypeEthereum, wallet.getKey(TWCoinTypeEthereum, DerivationPath(TWPurposeBIP44, 60, 0, 0, 0x7fffffff))));
+    EXPECT_THROW(wallet.deriveAddresses(TWCoinTypeEthereum, 0, 0, 0x7fffffff, 2), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveAddresses(TWCoinTypeEthereum, 0, 0, 0x80000000, 1), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveAddresses(TWCoinTypeEthereum, 0, 0, 0xffffffff, 2), std::invalid_argument);
+}
+
+TEST(HDWallet, DeriveHardenedPublicKeys) {
+    const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    const auto check = [&](TWCoinType coin, const DerivationPath& parent, uint32_t firstIndex, uint32_t count) {
+        const auto publicKeys = wallet.deriveHardenedPublicKeys(coin, parent, firstIndex, count);
+        ASSERT_EQ(publicKeys.size(), count);
+        for (uint32_t i = 0; i < count; ++i) {
+            auto path = parent;
+            path.indices.push_back(DerivationPathIndex(firstIndex + i, true));
+            const auto expected = wallet.getKey(coin, path).getPublicKey(TW::publicKeyType(coin));
+            EXPECT_EQ(hex(publicKeys[i].bytes), hex(expected.bytes)) << coin << " " << path.string();
+            EXPECT_EQ(publicKeys[i].type, expected.type);
+        }
+    };
+    // more keys than a batch of the shared inversion
+    check(TWCoinTypeSolana, DerivationPath("m/44'/501'"), 0, 37);
+    check(TWCoinTypeStellar, DerivationPath("m/44'/148'"), 5, 3);
+    check(TWCoinTypeAlgorand, DerivationPath("m/44'/283'/0'/0'"), 0x7ffffffe, 2);
+    check(TWCoinTypeNano, DerivationPath("m/44'/165'"), 0, 17);
+    check(TWCoinTypeSolana, DerivationPath("m/44'/501'"), 0, 0);
+
+    EXPECT_THROW(wallet.deriveHardenedPublicKeys(TWCoinTypeBitcoin, DerivationPath("m/84'/0'"), 0, 1), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveHardenedPublicKeys(TWCoinTypeCardano, DerivationPath("m/1852'/1815'"), 0, 1), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveHardenedPublicKeys(TWCoinTypeSolana, DerivationPath("m/44'/501'"), 0x7fffffff, 2), std::invalid_argument);
+    EXPECT_THROW(wallet.deriveHardenedPublicKeys(TWCoinTypeSolana, DerivationPath("m/44'/501'"), 0x80000000, 0), std::invalid_argument);
+}
+
+TEST(HDWallet, DeriveAddressesMultiCoin) {
+    const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    const auto coins = getCoinTypes();
+
+    std::vector<std::string> expected;
+    for (auto coin : coins) {
+        expected.push_back(HDWallet(mnemonic, "TREZOR").deriveAddress(coin));
+    }
+    EXPECT_EQ(wallet.deriveAddresses(coins, 1), expected);
+    EXPECT_EQ(wallet.deriveAddresses(coins, 4), expected);
+    EXPECT_EQ(wallet.deriveAddresses(coins), expected);
+
+    const auto addresses = wallet.deriveAddresses({TWCoinTypeEthereum, TWCoinTypeBitcoin, TWCoinTypeEthereum});
+    ASSERT_EQ(addresses.size(), 3);
+    EXPECT_EQ(addresses[0], "0x27Ef5cDBe01777D62438AfFeb695e33fC2335979");
+    EXPECT_EQ(addresses[1], "bc1qumwjg8danv2vm29lp5swdux4r60ezptzz7ce85");
+    EXPECT_EQ(addresses[2], addresses[0]);
+    EXPECT_EQ(wallet.deriveAddresses(std::vector<TWCoinType>{}).size(), 0);
+}
+
+TEST(HDWallet, NodeCache) {
+    const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    const auto coin = TWCoinTypeBitcoin;
+    const auto path = DerivationPath("m/84'/0'/0'/0/0");
+    auto wallet = HDWallet(mnemonic, "TREZOR");
+    EXPECT_EQ(wallet.nodeCache.size(), 0);
+
+    const auto key = wallet.getKey(coin, path);
+    // master node and the 4 parent levels are cached, the leaf is not
+    EXPECT_EQ(wallet.nodeCache.size(), 5);
+    EXPECT_EQ(hex(wallet.getKey(coin, path).bytes), hex(key.bytes));
+    EXPECT_EQ(hex(wallet.getKey(coin, DerivationPath("m/84'/0'/0'/0/1")).bytes), hex(HDWallet(mnemonic, "TREZOR").getKey(coin, DerivationPath("m/84'/0'/0'/0/1")).bytes));
+    EXPECT_EQ(wallet.nodeCache.size(), 5);
+
+    // copies do not share the cache
+    const auto copy = wallet;
+    EXPECT_EQ(copy.nodeCache.size(), 0);
+    EXPECT_EQ(hex(copy.getKey(coin, path).bytes), hex(key.bytes));
+
+    // different curve, separate entries
+    wallet.getKey(TWCoinTypeSolana, DerivationPath("m/44'/501'/0'"));
+    EXPECT_EQ(wallet.nodeCache.size(), 8);
+
+    wallet.nodeCache.clear();
+    EXPECT_EQ(wallet.nodeCache.size(), 0);
+    EXPECT_EQ(hex(wallet.getKey(coin, path).bytes), hex(key.bytes));
+}
+
+TEST(HDWallet, NodeCacheLongestPrefix) {
+    auto cache = HDNodeCache();
+    auto node = HDNode();
+    size_t length = 0;
+    EXPECT_FALSE(cache.findLongestPrefix(TWCurveSECP256k1, "m/84'/0'/0'/0/0"_dp, 4, node, length));
+    const auto store = [&cache](const DerivationPath& path, uint32_t depth) {
+        auto node = HDNode();
+        node.depth = depth;
+        cache.insert(TWCurveSECP256k1, path, path.indices.size(), node);
+    };
+    store("m"_dp, 0);
+    store("m/84'/0'"_dp, 2);
+    store("m/84'/0'/0'/0"_dp, 4);
+    store("m/84'/0'/0'/1"_dp, 4);
+    store("m/84'/0'/0'/1/2"_dp, 5);
+
+    // the closest key is m/84'/0'/0'/1/2, then m/84'/0'/0'/1 is not a prefix either
+    ASSERT_TRUE(cache.findLongestPrefix(TWCurveSECP256k1, "m/84'/0'/1'/0/0"_dp, 4, node, length));
+    EXPECT_EQ(length, 2ul);
+    EXPECT_EQ(node.depth, 2ul);
+    ASSERT_TRUE(cache.findLongestPrefix(TWCurveSECP256k1, "m/84'/0'/0'/1/3"_dp, 4, node, length));
+    EXPECT_EQ(length, 4ul);
+    ASSERT_TRUE(cache.findLongestPrefix(TWCurveSECP256k1, "m/84'/0'/0'/1/2"_dp, 5, node, length));
+    EXPECT_EQ(length, 5ul);
+    // not above the given length
+    ASSERT_TRUE(cache.findLongestPrefix(TWCurveSECP256k1, "m/84'/0'/0'/1/2"_dp, 3, node, length));
+    EXPECT_EQ(length, 2ul);
+    ASSERT_TRUE(cache.findLongestPrefix(TWCurveSECP256k1, "m/44'/60'/0'"_dp, 2, node, length));
+    EXPECT_EQ(length, 0ul);
+    EXPECT_FALSE(cache.findLongestPrefix(TWCurveED25519, "m/84'/0'/0'/1/2"_dp, 4, node, length));
+}
+
+TEST(HDWallet, ExtendedPublicKeyCache) {
+    const auto mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+    auto wallet = HDWallet(mnemonic, "");
+    const auto xpub = "xpub6BosfCnifzxcFwrSzQiqu2DBVTshkCXacvNsWGYJVVhhawA7d4R5WSWGFNbi8Aw6ZRc1brxMyWMzG3DSSSSoekkudhUd9yLb6qx39T9nMdj";
+    EXPECT_EQ(wallet.getExtendedPublicKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionXPUB), xpub);
+    const auto nodes = wallet.nodeCache.size();
+
+    // served from the cache, without a derivation
+    std::string cached;
+    EXPECT_TRUE(wallet.nodeCache.findExtendedPublicKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionXPUB, cached));
+    EXPECT_EQ(cached, xpub);
+    wallet.nodeCache.insertExtendedPublicKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionXPUB, "cached");
+    EXPECT_EQ(wallet.getExtendedPublicKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionXPUB), "cached");
+    EXPECT_EQ(wallet.nodeCache.size(), nodes);
+    // other versions are separate entries
+    EXPECT_NE(wallet.getExtendedPublicKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionYPUB), "cached");
+
+    wallet.nodeCache.clear();
+    EXPECT_FALSE(wallet.nodeCache.findExtendedPublicKey(TWPurposeBIP44, TWCoinTypeBitcoin, TWHDVersionXPUB, cached));
+    const auto keys = wallet.getExtendedPublicKeys({TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeDogecoin}, 2);
+    ASSERT_EQ(keys.size(), 3ul);
+    EXPECT_EQ(keys[0], wallet.getExtendedPublicKey(TWPurposeBIP84, TWCoinTypeBitcoin, TWHDVersionZPUB));
+    EXPECT_EQ(keys[1], "");
+    EXPECT_EQ(keys[2], HDWallet(mnemonic, "").getExtendedPublicKey(TWPurposeBIP44, TWCoinTypeDogecoin, TWHDVersionDGUB));
+}
+
+TEST(HDWallet, NodeCacheCapacity) {
+    const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    const auto coin = TWCoinTypeEthereum;
+    auto wallet = HDWallet(mnemonic, "TREZOR");
+    const auto expected = hex(wallet.getKey(coin, DerivationPath("m/44'/60'/1'/0/0")).bytes);
+
+    wallet.nodeCache.capacity = 2;
+    wallet.nodeCache.clear();
+    for (auto account = 0; account < 4; ++account) {
+        wallet.getKey(coin, DerivationPath(TWPurposeBIP44, 60, account, 0, 0));
+        EXPECT_LE(wallet.nodeCache.size(), 2);
+    }
+    EXPECT_EQ(hex(wallet.getKey(coin, DerivationPath("m/44'/60'/1'/0/0")).bytes), expected);
+
+    wallet.nodeCache.capacity = 0;
+    wallet.nodeCache.clear();
+    EXPECT_EQ(hex(wallet.getKey(coin, DerivationPath("m/44'/60'/1'/0/0")).bytes), expected);
+    EXPECT_EQ(wallet.nodeCache.size(), 0);
+}
+
+TEST(HDWallet, SeedsFromMnemonics) {
+    const auto mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+    // BIP39 test vector
+    EXPECT_EQ(hex(HDWallet::seedsFromMnemonics({mnemonic}, {"TREZOR"})[0]),
+        "c55257c360c07c72029aebc1b53c05ed0362ada38ead3e3e9efa3708e53495531f09a6987599d18264c1e1c92f2cf141630c7a3c4ab7c81b2f001698e7463b04");
+
+    auto mnemonics = std::vector<std::string>();
+    auto passphrases = std::vector<std::string>();
+    for (auto i = 0; i < 11; ++i) {
+        mnemonics.push_back(HDWallet(128, "").mnemonic.c_str());
+        passphrases.push_back(std::string(i * 3, 'x'));
+    }
+    auto expected = std::vector<std::string>();
+    auto expectedShared = std::vector<std::string>();
+    for (size_t i = 0; i < mnemonics.size(); ++i) {
+        byte seed[HDWallet::seedSize];
+        mnemonic_to_seed(mnemonics[i].c_str(), passphrases[i].c_str(), seed, nullptr);
+        expected.push_back(hex(seed, seed + sizeof(seed)));
+        mnemonic_to_seed(mnemonics[i].c_str(), "TREZOR", seed, nullptr);
+        expectedShared.push_back(hex(seed, seed + sizeof(seed)));
+    }
+
+    const auto supported = sha256_hw_supported();
+    const unsigned backends[] = {0, SHA512_HW_AVX2, SHA512_HW_AVX512, supported};
+    for (const auto backend : backends) {
+        sha256_hw_select(backend);
+        const auto seeds = HDWallet::seedsFromMnemonics(mnemonics, passphrases);
+        const auto sharedSeeds = HDWallet::seedsFromMnemonics(mnemonics, {"TREZOR"});
+        ASSERT_EQ(seeds.size(), mnemonics.size());
+        for (size_t i = 0; i < mnemonics.size(); ++i) {
+            EXPECT_EQ(hex(seeds[i]), expected[i]) << "backend " << backend << " index " << i;
+            EXPECT_EQ(hex(sharedSeeds[i]), expectedShared[i]) << "backend " << backend << " index " << i;
+        }
+    }
+    sha256_hw_select(supported);
+
+    EXPECT_TRUE(HDWallet::seedsFromMnemonics({}, {""}).empty());
+    EXPECT_THROW(HDWallet::seedsFromMnemonics(mnemonics, {"a", "b"}), std::invalid_argument);
+}
+
+TEST(HDWallet, CreateRandom) {
+    const auto wallet = HDWallet(128, "TREZOR");
+    const auto parsed = HDWallet(std::string(wallet.mnemonic.c_str()), "TREZOR");
+    EXPECT_EQ(hex(wallet.entropy), hex(parsed.entropy));
+    EXPECT_EQ(hex(wallet.seed), hex(parsed.seed));
+
+    for (const auto strength : {128, 256}) {
+        const auto wallets = HDWallet::createRandom(9, strength, "TREZOR");
+        ASSERT_EQ(wallets.size(), 9ul);
+        for (size_t i = 0; i < wallets.size(); ++i) {
+            const auto mnemonic = std::string(wallets[i].mnemonic.c_str());
+            EXPECT_TRUE(mnemonic_check(mnemonic.c_str()));
+            EXPECT_EQ(std::count(mnemonic.begin(), mnemonic.end(), ' '), strength / 32 * 3 - 1);
+            EXPECT_NE(mnemonic, wallets[(i + 1) % wallets.size()].mnemonic.c_str());
+            const auto reference = HDWallet(mnemonic, "TREZOR");
+            EXPECT_EQ(hex(wallets[i].entropy), hex(reference.entropy));
+            EXPECT_EQ(hex(wallets[i].seed), hex(reference.seed));
+            EXPECT_EQ(wallets[i].passphrase, reference.passphrase);
+        }
+    }
+
+    EXPECT_TRUE(HDWallet::createRandom(0, 128, "").empty());
+    EXPECT_THROW(HDWallet::createRandom(2, 100, ""), std::invalid_argument);
+}
+
+TEST(HDWallet, FromSeed) {
+    const auto mnemonic = "abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about";
+    const auto reference = HDWallet(mnemonic, "TREZOR");
+    const auto seed = HDWallet::seedsFromMnemonics({mnemonic}, {"TREZOR"})[0];
+    const auto wallet = HDWallet(mnemonic, "TREZOR", seed);
+    EXPECT_EQ(hex(wallet.seed), hex(reference.seed));
+    EXPECT_EQ(hex(wallet.entropy), hex(reference.entropy));
+    EXPECT_EQ(wallet.mnemonic, reference.mnemonic);
+    EXPECT_EQ(wallet.passphrase, reference.passphrase);
+    EXPECT_EQ(hex(wallet.getKey(TWCoinTypeEthereum, DerivationPath("m/44'/60'/0'/0/0")).bytes),
+              hex(reference.getKey(TWCoinTypeEthereum, DerivationPath("m/44'/60'/0'/0/0")).bytes));
+}
+
 } // namespace
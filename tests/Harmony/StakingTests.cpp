@@ -11,6 +11,7 @@
 #include "Harmony/Signer.h"
 #include "HexCoding.h"
 #include "proto/Harmony.pb.h"
+#include "BatchSigningHelper.h"
 
 #include <TrustWalletCore/TWHRP.h>
 #include <gtest/gtest.h>
@@ -301,4 +302,50 @@ TEST(HarmonyStaking, SignCollectRewards) {
     ASSERT_EQ(hex(proto_output.s()), s);
 }
 
+TEST(HarmonyStaking, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        const auto validator = "one1d2rngmem4x2c6zxsjjz29dlah0jzkr0k2n88wc";
+        auto input = Proto::SigningInput();
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : key == BatchKey::First ? Data(PRIVATE_KEY.bytes.begin(), PRIVATE_KEY.bytes.end())
+                                                         : parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+        input.set_private_key(privateKey.data(), privateKey.size());
+        auto value = store(uint256_t(2));
+        input.set_chain_id(value.data(), value.size());
+        const auto amount = store(uint256_t(1000 + i));
+        if (i % 10 == 9) {
+            auto transfer = input.mutable_transaction_message();
+            transfer->set_to_address(validator);
+            transfer->set_amount(amount.data(), amount.size());
+            value = store(uint256_t(i));
+            transfer->set_nonce(value.data(), value.size());
+        } else {
+            auto stakingMessage = input.mutable_staking_message();
+            value = store(uint256_t(i));
+            stakingMessage->set_nonce(value.data(), value.size());
+            value = store(uint256_t(0x64));
+            stakingMessage->set_gas_limit(value.data(), value.size());
+            switch (i % 3) {
+            case 0: {
+                auto delegateMsg = stakingMessage->mutable_delegate_message();
+                delegateMsg->set_delegator_address(TEST_ACCOUNT.string());
+                delegateMsg->set_validator_address(i == 30 ? "one1invalid" : validator);
+                delegateMsg->set_amount(amount.data(), amount.size());
+                break;
+            }
+            case 1: {
+                auto undelegateMsg = stakingMessage->mutable_undelegate_message();
+                undelegateMsg->set_delegator_address(TEST_ACCOUNT.string());
+                undelegateMsg->set_validator_address(validator);
+                undelegateMsg->set_amount(amount.data(), amount.size());
+                break;
+            }
+            default:
+                stakingMessage->mutable_collect_rewards()->set_delegator_address(TEST_ACCOUNT.string());
+            }
+        }
+        return input;
+    }, {30});
+}
+
 } // namespace TW::Harmony
@@ -7,6 +7,9 @@
 #include "Hash.h"
 #include "HexCoding.h"
 
+#include <TrezorCrypto/blake2b_hw.h>
+#include <TrezorCrypto/groestl_hw.h>
+#include <TrezorCrypto/sha2_hw.h>
 #include <gtest/gtest.h>
 
 using namespace std;
@@ -65,4 +68,196 @@ TEST(HashTests, hmac256) {
     EXPECT_EQ(hex(hmac), expectedHmac);
 }
 
+TEST(HashTests, Digests) {
+    const auto data = TW::data(brownFox);
+    EXPECT_EQ(hex(Hash::sha1Digest(data)), hex(Hash::sha1(data)));
+    EXPECT_EQ(hex(Hash::sha256Digest(data)), hex(Hash::sha256(data)));
+    EXPECT_EQ(hex(Hash::sha256dDigest(data)), hex(Hash::sha256d(data.data(), data.size())));
+    EXPECT_EQ(hex(Hash::sha512Digest(data)), hex(Hash::sha512(data)));
+    EXPECT_EQ(hex(Hash::keccak256Digest(data)), hex(Hash::keccak256(data)));
+    EXPECT_EQ(hex(Hash::sha3_256Digest(data)), hex(Hash::sha3_256(data)));
+    EXPECT_EQ(hex(Hash::ripemdDigest(data)), hex(Hash::ripemd(data)));
+    EXPECT_EQ(hex(Hash::sha256ripemdDigest(data)), hex(Hash::sha256ripemd(data.data(), data.size())));
+    EXPECT_EQ(hex(Hash::blake256Digest(data)), hex(Hash::blake256(data)));
+
+    EXPECT_EQ(hex(Hash::sha256Digest(DataView())), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+}
+
+TEST(HashTests, DataView) {
+    const auto data = TW::data(brownFoxDot);
+    const auto view = DataView(data).subView(0, brownFox.size());
+    EXPECT_EQ(hex(Hash::sha1(view)), "2fd4e1c67a2d28fced849ee1bb76e7391b93eb12");
+    EXPECT_EQ(hex(Hash::sha512_256(view)), "dd9d67b371519c339ed8dbd25af90e976a1eeefd4ad3d889005e532fc5bef04d");
+}
+
+TEST(HashTests, Sha256Backends) {
+    auto messages = std::vector<Data>();
+    for (size_t size = 0; size < 300; ++size) {
+        auto message = Data(size);
+        for (size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<TW::byte>(i * 31 + size);
+        }
+        messages.push_back(message);
+    }
+
+    const auto supported = sha256_hw_supported();
+    ASSERT_EQ(sha256_hw_select(0), 0);
+    auto expected = std::vector<std::string>();
+    for (const auto& message : messages) {
+        expected.push_back(hex(Hash::sha256(message)));
+    }
+    const auto expectedHmac = hex(Hash::hmac256(messages[40], messages[100]));
+
+    const unsigned backends[] = {0, SHA256_HW_SHANI, SHA256_HW_ARMV8, SHA256_HW_AVX2, supported};
+    for (const auto backend : backends) {
+        EXPECT_EQ(sha256_hw_select(backend), backend & supported);
+        EXPECT_EQ(hex(Hash::sha256(TW::data("abc"))), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+        const auto batch = Hash::sha256Batch(messages);
+        ASSERT_EQ(batch.size(), messages.size());
+        for (size_t i = 0; i < messages.size(); ++i) {
+            EXPECT_EQ(hex(Hash::sha256(messages[i])), expected[i]) << "backend " << backend << " size " << i;
+            EXPECT_EQ(hex(batch[i]), expected[i]) << "backend " << backend << " size " << i;
+        }
+        // HMAC calls the compression function directly
+        EXPECT_EQ(hex(Hash::hmac256(messages[40], messages[100])), expectedHmac);
+    }
+    sha256_hw_select(supported);
+    EXPECT_TRUE(Hash::sha256Batch({}).empty());
+}
+
+TEST(HashTests, Blake2bBatch) {
+    auto messages = std::vector<Data>();
+    for (size_t size = 0; size < 700; size += 11) {
+        auto message = Data(size);
+        for (size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<TW::byte>(i * 17 + size);
+        }
+        messages.push_back(message);
+    }
+    const auto personal = TW::data("ZcashSigHash\x19\x1b\xa8\x5b");
+    const auto supported = blake2b_hw_supported();
+    for (const auto backend : {0u, supported}) {
+        EXPECT_EQ(blake2b_hw_select(backend), backend);
+        for (const auto count : {size_t(0), size_t(1), size_t(3), size_t(5), messages.size()}) {
+            const auto subset = std::vector<Data>(messages.begin(), messages.begin() + count);
+            const auto batch = Hash::blake2bBatch(subset, 32);
+            const auto personalized = Hash::blake2bBatch(subset, 64, personal);
+            ASSERT_EQ(batch.size(), count);
+            ASSERT_EQ(personalized.size(), count);
+            for (size_t i = 0; i < count; ++i) {
+                EXPECT_EQ(hex(batch[i]), hex(Hash::blake2b(subset[i], 32))) << "backend " << backend << " size " << subset[i].size();
+                EXPECT_EQ(hex(personalized[i]), hex(Hash::blake2b(subset[i], 64, personal)));
+            }
+        }
+        EXPECT_EQ(hex(Hash::blake2b(TW::data("abc"), 64)), "ba80a53f981c4d0d6a2797b69f12f6e94c212f14685ac4b74b12bb6fdbffa2d17d87c5392aab792dc252d5de4533cc9518d38aa8dbf1925ab92386edd4009923");
+
+        // keyed state with the key block buffered, and a state with a prefix
+        blake2b_state keyed;
+        ASSERT_EQ(blake2b_InitKey(&keyed, 32, "secret", 6), 0);
+        const TW::byte* pointers[] = {messages[0].data(), messages[3].data(), messages[20].data()};
+        const size_t sizes[] = {messages[0].size(), messages[3].size(), messages[20].size()};
+        Data digests(3 * 32);
+        ASSERT_EQ(blake2b_batch(&keyed, pointers, sizes, 3, digests.data()), 0);
+        for (size_t i = 0; i < 3; ++i) {
+            Data expected(32);
+            blake2b_Key(pointers[i], static_cast<uint32_t>(sizes[i]), "secret", 6, expected.data(), expected.size());
+            EXPECT_EQ(hex(Data(digests.begin() + 32 * i, digests.begin() + 32 * (i + 1))), hex(expected));
+        }
+    }
+    blake2b_hw_select(supported);
+}
+
+TEST(HashTests, Keccak256Batch) {
+    auto messages = std::vector<Data>();
+    for (size_t size = 0; size < 700; size += 7) {
+        auto message = Data(size);
+        for (size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<TW::byte>(i * 17 + size);
+        }
+        messages.push_back(message);
+    }
+    for (const auto count : {size_t(0), size_t(1), size_t(3), size_t(4), size_t(5), messages.size()}) {
+        const auto subset = std::vector<Data>(messages.begin(), messages.begin() + count);
+        const auto batch = Hash::keccak256Batch(subset);
+        ASSERT_EQ(batch.size(), count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(hex(batch[i]), hex(Hash::keccak256(subset[i]))) << "size " << subset[i].size();
+        }
+    }
+
+    const auto x4 = Hash::keccak256Batch({TW::data(""), TW::data(brownFox), TW::data(brownFoxDot), Data(136, 0xab)});
+    EXPECT_EQ(hex(x4[0]), "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+    EXPECT_EQ(hex(x4[1]), "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15");
+    EXPECT_EQ(hex(x4[3]), hex(Hash::keccak256(Data(136, 0xab))));
+}
+
+TEST(HashTests, Sha256ripemdBatch) {
+    auto messages = std::vector<Data>();
+    for (size_t i = 0; i < 70; ++i) {
+        const auto size = std::vector<size_t>{33, 65, 0, 100}[i % 4];
+        auto message = Data(size);
+        for (size_t j = 0; j < size; ++j) {
+            message[j] = static_cast<TW::byte>(j * 13 + i);
+        }
+        messages.push_back(message);
+    }
+    for (const auto count : {size_t(0), size_t(1), size_t(8), size_t(13), messages.size()}) {
+        const auto subset = std::vector<Data>(messages.begin(), messages.begin() + count);
+        const auto batch = Hash::sha256ripemdBatch(subset);
+        ASSERT_EQ(batch.size(), count);
+        for (size_t i = 0; i < count; ++i) {
+            const auto expected = hex(Hash::ripemd(Hash::sha256(subset[i])));
+            EXPECT_EQ(hex(batch[i]), expected) << i;
+            EXPECT_EQ(hex(Hash::sha256ripemd(subset[i].data(), subset[i].size())), expected) << i;
+            EXPECT_EQ(hex(Hash::sha256ripemdDigest(subset[i])), expected) << i;
+        }
+    }
+
+    const auto publicKey = parse_hex("0279be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798");
+    EXPECT_EQ(hex(Hash::sha256ripemd(publicKey.data(), publicKey.size())), "751e76e8199196d454941c45d1b3a323f1433bd6");
+    EXPECT_EQ(hex(Hash::sha256ripemdBatch({Data()})[0]), "b472a266d0bd89c13706a4132ccfb16f7c3b9fcb");
+}
+
+TEST(HashTests, Groestl512Backends) {
+    auto messages = std::vector<Data>();
+    for (size_t size = 0; size < 400; size += 7) {
+        auto message = Data(size);
+        for (size_t i = 0; i < size; ++i) {
+            message[i] = static_cast<TW::byte>(i * 29 + size);
+        }
+        messages.push_back(message);
+    }
+
+    const auto supported = groestl_hw_supported();
+    ASSERT_EQ(groestl_hw_select(0), 0);
+    auto expected = std::vector<std::string>();
+    for (const auto& message : messages) {
+        expected.push_back(hex(Hash::groestl512(message)));
+    }
+
+    const unsigned backends[] = {0, GROESTL_HW_AESNI, supported};
+    for (const auto backend : backends) {
+        EXPECT_EQ(groestl_hw_select(backend), backend & supported);
+        EXPECT_EQ(hex(Hash::groestl512(TW::data("The quick brown fox jumps over the lazy dog"))),
+                  "badc1f70ccd69e0cf3760c3f93884289da84ec13c70b3d12a53a7a8a4a513f99715d46288f55e1dbf926e6d084a0538e4eebfc91cf2b21452921ccde9131718d");
+        for (size_t i = 0; i < messages.size(); ++i) {
+            EXPECT_EQ(hex(Hash::groestl512(messages[i])), expected[i]) << "backend " << backend << " size " << messages[i].size();
+        }
+    }
+    groestl_hw_select(supported);
+}
+
 // More tests in TWHashTests
+
+TEST(HashTests, XXHash64Concat) {
+    // single pass over both seeds, past the 32-byte blocks
+    for (size_t size = 0; size <= 100; ++size) {
+        Data data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<TW::byte>(i * 31 + size);
+        }
+        auto expected = Hash::xxhash64(data.data(), data.size(), 0);
+        append(expected, Hash::xxhash64(data.data(), data.size(), 1));
+        EXPECT_EQ(hex(Hash::xxhash64concat(data.data(), data.size())), hex(expected)) << size;
+    }
+}
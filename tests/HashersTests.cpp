@@ -0,0 +1,93 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Hashers.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+
+namespace {
+
+const auto message = data("The quick brown fox jumps over the lazy dog");
+
+/// Feeds the message in uneven parts, copying the hasher midway.
+template <typename Hasher>
+std::string hashInParts(Hasher hasher) {
+    const auto view = DataView(message);
+    hasher.update(view.subView(0, 3)).update(view.subView(3, 0));
+    auto copy = hasher;
+    copy.update(view.subView(3, 100));
+    hasher.update(data("unused"));
+    return hex(copy.final());
+}
+
+} // namespace
+
+TEST(Hashers, Sha256) {
+    EXPECT_EQ(hex(Hash::Sha256Hasher().final()), hex(Hash::sha256(Data())));
+    EXPECT_EQ(hashInParts(Hash::Sha256Hasher()), hex(Hash::sha256(message)));
+}
+
+TEST(Hashers, Sha512) {
+    EXPECT_EQ(hashInParts(Hash::Sha512Hasher()), hex(Hash::sha512(message)));
+}
+
+TEST(Hashers, Sha512_256) {
+    EXPECT_EQ(hex(Hash::Sha512_256Hasher().final()), hex(Hash::sha512_256(Data())));
+    EXPECT_EQ(hashInParts(Hash::Sha512_256Hasher()), hex(Hash::sha512_256(message)));
+}
+
+TEST(Hashers, Keccak256) {
+    EXPECT_EQ(hashInParts(Hash::Keccak256Hasher()), "4d741b6f1eb29cb2a9b9911c82f56fa8d73b04959d3d9d222895df6c0b28aa15");
+}
+
+TEST(Hashers, Sha3_256) {
+    EXPECT_EQ(hashInParts(Hash::Sha3_256Hasher()), hex(Hash::sha3_256(message)));
+}
+
+TEST(Hashers, Blake256) {
+    EXPECT_EQ(hex(Hash::Blake256Hasher().final()), hex(Hash::blake256(Data())));
+    EXPECT_EQ(hashInParts(Hash::Blake256Hasher()), hex(Hash::blake256(message)));
+}
+
+TEST(Hashers, Blake2b) {
+    EXPECT_EQ(hashInParts(Hash::Blake2bHasher(32)), hex(Hash::blake2b(message, 32)));
+    EXPECT_EQ(hashInParts(Hash::Blake2bHasher(64)), hex(Hash::blake2b(message, 64)));
+
+    const auto personal = data("ZcashPrevoutHash");
+    EXPECT_EQ(hashInParts(Hash::Blake2bHasher(32, personal)), hex(Hash::blake2b(message, 32, personal)));
+}
+
+TEST(Hashers, Blake2bFinalBatch) {
+    const auto personal = data("ZcashPrevoutHash");
+    auto hasher = Hash::Blake2bHasher(32, personal);
+    hasher.update(message);
+    const auto suffixes = std::vector<Data>{data(""), data("."), Data(200, 1), Data(127, 2), Data(128, 3)};
+    const auto hashes = hasher.finalBatch(suffixes);
+    ASSERT_EQ(hashes.size(), suffixes.size());
+    for (size_t i = 0; i < suffixes.size(); ++i) {
+        auto copy = hasher;
+        EXPECT_EQ(hex(hashes[i]), hex(copy.update(suffixes[i]).final()));
+    }
+    EXPECT_EQ(hex(hasher.final()), hex(Hash::blake2b(message, 32, personal)));
+    EXPECT_TRUE(hasher.finalBatch({}).empty());
+}
+
+TEST(Hashers, FinalKeepsState) {
+    auto hasher = Hash::Sha256Hasher();
+    hasher.update(message);
+    EXPECT_EQ(hex(hasher.final()), hex(hasher.final()));
+    hasher.update(data("."));
+    EXPECT_EQ(hex(hasher.final()), "ef537f25c895bfa782526529a9b63d97aa631564d5d789c2b765448c8635fb6c");
+}
+
+TEST(Hashers, InvalidBlake2b) {
+    EXPECT_THROW(Hash::Blake2bHasher(0), std::invalid_argument);
+    EXPECT_THROW(Hash::Blake2bHasher(65), std::invalid_argument);
+    EXPECT_THROW(Hash::Blake2bHasher(32, data("short")), std::invalid_argument);
+}
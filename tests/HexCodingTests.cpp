@@ -8,6 +8,9 @@
 #include "Data.h"
 #include <gtest/gtest.h>
 
+#include <cctype>
+#include <vector>
+
 namespace TW {
 
 TEST(HexCoding, validation) {
@@ -27,4 +30,56 @@ TEST(HexCoding, OddLength) {
     ASSERT_TRUE(bytes.empty());
 }
 
+TEST(HexCoding, Lengths) {
+    // vectorized blocks, and the remaining bytes
+    for (size_t size = 0; size <= 100; ++size) {
+        Data data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<byte>(i * 37 + size);
+        }
+        std::string expected;
+        for (const auto b : data) {
+            expected.push_back("0123456789abcdef"[b >> 4]);
+            expected.push_back("0123456789abcdef"[b & 0x0f]);
+        }
+        EXPECT_EQ(hex(data), expected);
+        EXPECT_EQ(hex(data.begin(), data.end()), expected);
+        EXPECT_EQ(parse_hex(expected), data);
+        EXPECT_EQ(parse_hex("0x" + expected), data);
+
+        std::string upper = expected;
+        for (auto& c : upper) {
+            c = static_cast<char>(std::toupper(c));
+        }
+        EXPECT_EQ(parse_hex(upper), data);
+    }
+}
+
+TEST(HexCoding, InvalidCharacters) {
+    const std::string valid = "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f2021";
+    ASSERT_EQ(parse_hex(valid).size(), valid.size() / 2);
+    // neighbours of the ranges, and characters lowercased into them
+    const std::vector<char> invalid = {'/', ':', '@', 'G', '`', 'g', ' ', 'Z', '\0', '\x10', '\x19', '\x80', '\xb0', '\xe1', '\xff'};
+    for (size_t i = 0; i < valid.size(); ++i) {
+        for (const auto c : invalid) {
+            auto string = valid;
+            string[i] = c;
+            EXPECT_TRUE(parse_hex(string).empty()) << i << " " << static_cast<int>(static_cast<unsigned char>(c));
+        }
+    }
+}
+
+TEST(HexCoding, EncodeIntoBuffer) {
+    const auto data = parse_hex("00ff10ab7f80c3d4e5f6a7b8c9daebfc0d1e2f30415263748596a7b8c9dae0f1");
+    std::string out(data.size() * 2, '-');
+    hexEncode(data.data(), data.size(), out.data());
+    EXPECT_EQ(out, hex(data));
+
+    Data decoded(data.size());
+    EXPECT_TRUE(hexDecode(out.data(), decoded.size(), decoded.data()));
+    EXPECT_EQ(decoded, data);
+    out[3] = 'x';
+    EXPECT_FALSE(hexDecode(out.data(), decoded.size(), decoded.data()));
+}
+
 }
@@ -0,0 +1,77 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// the hooks are compiled in for this file only
+#define TW_INSTRUMENTATION
+#include "Instrumentation.h"
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace TW {
+
+struct Measurement {
+    std::string operation;
+    uint64_t duration;
+    uint64_t count;
+};
+
+static void recordMeasurement(void* context, const char* operation, uint64_t durationNanoseconds, uint64_t count) {
+    static_cast<std::vector<Measurement>*>(context)->push_back({operation, durationNanoseconds, count});
+}
+
+TEST(Instrumentation, Sink) {
+    std::vector<Measurement> measurements;
+    TWInstrumentationSetSink(recordMeasurement, &measurements);
+    {
+        TW_INSTRUMENT_SCOPE("scope");
+        TW_INSTRUMENT_COUNT("counter", 42);
+        EXPECT_EQ(measurements.size(), 1ul);
+    }
+    TWInstrumentationSetSink(nullptr, nullptr);
+    {
+        TW_INSTRUMENT_SCOPE("ignored");
+        TW_INSTRUMENT_COUNT("ignored", 1);
+    }
+
+    ASSERT_EQ(measurements.size(), 2ul);
+    EXPECT_EQ(measurements[0].operation, "counter");
+    EXPECT_EQ(measurements[0].duration, 0ul);
+    EXPECT_EQ(measurements[0].count, 42ul);
+    EXPECT_EQ(measurements[1].operation, "scope");
+    EXPECT_EQ(measurements[1].count, 1ul);
+}
+
+TEST(Instrumentation, Batch) {
+    std::vector<Measurement> measurements;
+    TWInstrumentationSetSink(recordMeasurement, &measurements);
+    {
+        TW_INSTRUMENT_SCOPE_COUNT("batch", 16);
+        TW_INSTRUMENT_DURATION("queue", 1234, 16);
+    }
+    TWInstrumentationSetSink(nullptr, nullptr);
+
+    ASSERT_EQ(measurements.size(), 2ul);
+    EXPECT_EQ(measurements[0].operation, "queue");
+    EXPECT_EQ(measurements[0].duration, 1234ul);
+    EXPECT_EQ(measurements[0].count, 16ul);
+    EXPECT_EQ(measurements[1].operation, "batch");
+    EXPECT_EQ(measurements[1].count, 16ul);
+}
+
+TEST(Instrumentation, TimerStartedWithoutSink) {
+    std::vector<Measurement> measurements;
+    {
+        Instrumentation::ScopedTimer timer("scope");
+        TWInstrumentationSetSink(recordMeasurement, &measurements);
+    }
+    TWInstrumentationSetSink(nullptr, nullptr);
+    EXPECT_TRUE(measurements.empty());
+}
+
+} // namespace TW
@@ -11,6 +11,7 @@
 #include "IoTeX/Address.h"
 #include "IoTeX/Signer.h"
 #include "proto/IoTeX.pb.h"
+#include "BatchSigningHelper.h"
 
 namespace TW::IoTeX {
 
@@ -57,4 +58,28 @@ TEST(IoTeXSigner, Build) {
     ASSERT_EQ(hex(h.begin(), h.end()), "6c84ac119058e859a015221f87a4e187c393d0c6ee283959342eac95fad08c33");
 }
 
+TEST(IoTeXSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = Proto::SigningInput();
+        input.set_version(1);
+        input.set_nonce(i);
+        input.set_gaslimit(1000000);
+        input.set_gasprice("10");
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "0806c458b262edd333a191e92f561aff338211ee3e18ab315a074a2d82aa343f"
+                                                                   : "cfa6ef757dee2e50351620dca002d32b9c090cfda55fb81f37f1d26b273743f1");
+        input.set_privatekey(privateKey.data(), privateKey.size());
+        if (i % 2 == 0) {
+            auto tsf = input.mutable_transfer();
+            tsf->set_amount(std::to_string(1000 + i));
+            tsf->set_recipient("io187wzp08vnhjjpkydnr97qlh8kh0dpkkytfam8j");
+        } else {
+            auto stake = input.mutable_stakeadddeposit();
+            stake->set_bucketindex(i);
+            stake->set_amount(std::to_string(1000 + i));
+        }
+        return input;
+    });
+}
+
 } // namespace TW::IoTeX
@@ -0,0 +1,86 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "JsonWriter.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <nlohmann/json.hpp>
+
+namespace TW {
+
+using json = nlohmann::json;
+
+TEST(JsonWriter, MatchesDump) {
+    const auto text = std::string("quote\" backslash\\ \b\f\n\r\t \x01\x1f \x7f caf\xc3\xa9 /");
+    std::string output;
+    JsonStringSink sink(output);
+    JsonWriter<JsonStringSink> writer(sink);
+    writer.beginObject();
+    writer.key("a");
+    writer.beginArray();
+    writer.value(text);
+    writer.beginObject();
+    writer.endObject();
+    writer.beginArray();
+    writer.endArray();
+    writer.rawValue("{\"x\":1}");
+    writer.endArray();
+    writer.field("b", "");
+    writer.key("c");
+    writer.beginObject();
+    writer.field("d", "e");
+    writer.endObject();
+    writer.endObject();
+
+    const json expected = {
+        {"c", {{"d", "e"}}},
+        {"a", {text, json::object(), json::array(), {{"x", 1}}}},
+        {"b", ""},
+    };
+    EXPECT_EQ(output, expected.dump());
+}
+
+TEST(JsonWriter, Numbers) {
+    std::string output;
+    JsonStringSink sink(output);
+    JsonWriter<JsonStringSink> writer(sink);
+    writer.beginArray();
+    writer.value(0);
+    writer.value(uint8_t(255));
+    writer.value(int64_t(-42));
+    writer.value(std::numeric_limits<int64_t>::min());
+    writer.value(std::numeric_limits<uint64_t>::max());
+    writer.endArray();
+
+    const json expected = {0, 255, -42, std::numeric_limits<int64_t>::min(), std::numeric_limits<uint64_t>::max()};
+    EXPECT_EQ(output, expected.dump());
+}
+
+TEST(JsonWriter, KeysAsWritten) {
+    std::string output;
+    JsonStringSink sink(output);
+    JsonWriter<JsonStringSink, JsonKeyOrder::asWritten> writer(sink);
+    writer.beginObject();
+    writer.field("nonce", 7);
+    writer.field("value", "1");
+    writer.field("data", "");
+    writer.endObject();
+    EXPECT_EQ(output, R"({"nonce":7,"value":"1","data":""})");
+}
+
+TEST(JsonWriter, Sha256Sink) {
+    JsonSha256Sink sink;
+    JsonWriter<JsonSha256Sink> writer(sink);
+    writer.beginObject();
+    writer.field("key", "value");
+    writer.endObject();
+    EXPECT_EQ(hex(sink.digest()), hex(Hash::sha256(std::string("{\"key\":\"value\"}"))));
+}
+
+} // namespace TW
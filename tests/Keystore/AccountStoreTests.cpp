@@ -0,0 +1,117 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/AccountStore.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+extern std::string TESTS_ROOT;
+
+namespace TW::Keystore {
+
+namespace {
+
+std::string testFile(const char* name) {
+    return TESTS_ROOT + "/Keystore/Data/" + name;
+}
+
+nlohmann::json readJson(const char* name) {
+    std::ifstream stream(testFile(name));
+    return nlohmann::json::parse(stream);
+}
+
+void expectEqual(const Account& account, const Account& expected) {
+    EXPECT_EQ(account.address, expected.address);
+    EXPECT_EQ(account.coin, expected.coin);
+    EXPECT_EQ(account.derivationPath.string(), expected.derivationPath.string());
+    EXPECT_EQ(account.extendedPublicKey, expected.extendedPublicKey);
+}
+
+} // namespace
+
+TEST(AccountStore, Formats) {
+    const auto accounts = std::vector<Account>{
+        // checksummed hex, lower case hex, Bech32, Bech32m, Base58 with a leading zero
+        Account("0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b", TWCoinTypeEthereum, DerivationPath("m/44'/60'/0'/0/0")),
+        Account("0x9d8a62f656a8d1615c1294fd71e9cfb3e4855a4f", TWCoinTypeEthereum, DerivationPath("m/44'/60'/0'/0/1")),
+        Account("bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny", TWCoinTypeBitcoin, DerivationPath("m/84'/0'/0'/0/0"),
+                "zpub6qbsWdbcKW9sC6shTKK4VEhfWvDCoWpfLnnVfYKHLHt31wKYUwH3aFDz4WLjZvjHZ5W4qVEyk37cRwzTbfrrT1Gnu8SgXawASnkdQ994atn"),
+        Account("bc1pw508d6qejxtdg4y5r3zarvary0c5xw7kw508d6qejxtdg4y5r3zarvary0c5xw7kt5nd6y", TWCoinTypeBitcoin, DerivationPath("m/86'/0'/0'/0/0")),
+        Account("1BvBMSEYstWetqTFn5Au4m4GFg7xJaNVN2", TWCoinTypeBitcoin, DerivationPath("m/44'/0'/0'/0/0")),
+        // not in a binary format, upper case Bech32, odd hex
+        Account("rDsbeomae4FXwgQTJp9Rs64Qg9vDiTCdBv", TWCoinTypeXRP, DerivationPath("m/44'/144'/0'/0/0")),
+        Account("BC1QTURC268V0F2SRJH4R2ZU4T6ZK4GDUTQD5A6ZNY", TWCoinTypeBitcoin, DerivationPath("m/84'/0'/0'/0/1")),
+        Account("0x123", TWCoinTypeEthereum, DerivationPath()),
+        Account("", TWCoinTypeEthereum, DerivationPath("m/44'")),
+    };
+    AccountStore store;
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        EXPECT_EQ(store.add(accounts[i], "key"), i);
+    }
+    ASSERT_EQ(store.size(), accounts.size());
+    for (std::size_t i = 0; i < accounts.size(); ++i) {
+        expectEqual(store.account(i), accounts[i]);
+        EXPECT_EQ(store.keyId(i), "key");
+        EXPECT_EQ(store.find(accounts[i].coin, accounts[i].address), i) << accounts[i].address;
+    }
+
+    EXPECT_FALSE(store.find(TWCoinTypeBitcoin, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b"));
+    EXPECT_FALSE(store.find(TWCoinTypeEthereum, "0x008aeeda4d805471df9b2a5b0f38a0c3bcba786b"));
+    EXPECT_FALSE(store.find(TWCoinTypeEthereum, "ltc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny"));
+    EXPECT_EQ(store.find(TWCoinTypeEthereum), (std::vector<std::size_t>{0, 1, 7, 8}));
+    EXPECT_EQ(store.find(TWCoinTypeBitcoin), (std::vector<std::size_t>{2, 3, 4, 6}));
+    EXPECT_TRUE(store.find(TWCoinTypeCosmos).empty());
+}
+
+TEST(AccountStore, Bulk) {
+    AccountStore store;
+    store.add(readJson("watch.json"));
+    store.add(nlohmann::json::array({readJson("key_bitcoin.json"), readJson("wallet.json")}));
+    const auto bitcoin = StoredKeyInfo::fromJson(readJson("key_bitcoin.json"));
+    const auto wallet = StoredKeyInfo::fromJson(readJson("wallet.json"));
+    ASSERT_EQ(store.size(), 1 + bitcoin.accounts.size() + wallet.accounts.size());
+
+    EXPECT_EQ(store.keyId(0), "3051ca7d-3d36-4a4a-acc2-09e9083732b0");
+    EXPECT_EQ(store.address(0), "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b");
+    EXPECT_EQ(store.derivationPath(0).string(), "m/44'/60'/0'/0/0");
+    for (std::size_t i = 0; i < bitcoin.accounts.size(); ++i) {
+        expectEqual(store.account(1 + i), bitcoin.accounts[i]);
+        EXPECT_EQ(store.find(bitcoin.accounts[i].coin, bitcoin.accounts[i].address), 1 + i);
+    }
+    const auto last = store.size() - 1;
+    expectEqual(store.account(last), wallet.accounts.back());
+    EXPECT_EQ(store.keyId(last), *wallet.id);
+
+    // the first of duplicate accounts is found
+    store.add(readJson("watch.json"));
+    EXPECT_EQ(store.find(TWCoinTypeEthereum, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b"), 0ul);
+    EXPECT_EQ(store.find(TWCoinTypeEthereum).back(), store.size() - 1);
+}
+
+TEST(AccountStore, Many) {
+    AccountStore store;
+    auto info = StoredKeyInfo();
+    info.id = "many";
+    for (uint32_t i = 0; i < 1000; ++i) {
+        auto address = std::string("0x");
+        for (auto j = 0; j < 5; ++j) {
+            char word[9];
+            snprintf(word, sizeof(word), "%08x", (i * 2654435761u) ^ (j * 40503u));
+            address += word;
+        }
+        info.accounts.emplace_back(address, TWCoinTypeEthereum, DerivationPath(TWPurposeBIP44, 60, 0, 0, i));
+    }
+    store.add(info);
+    ASSERT_EQ(store.size(), 1000ul);
+    for (uint32_t i = 0; i < 1000; i += 37) {
+        EXPECT_EQ(store.find(TWCoinTypeEthereum, info.accounts[i].address), i);
+        EXPECT_EQ(store.derivationPath(i).string(), "m/44'/60'/0'/0/" + std::to_string(i));
+    }
+}
+
+} // namespace TW::Keystore
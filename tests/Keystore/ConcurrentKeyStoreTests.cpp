@@ -0,0 +1,110 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/ConcurrentKeyStore.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace TW::Keystore {
+
+namespace {
+
+const auto password = TW::data("password");
+const auto mnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+
+StoredKey fastKey() {
+    auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", password, mnemonic, TWCoinTypeBitcoin);
+    key.payload = EncryptionParameters(password, TW::data(mnemonic), ScryptParameters(Data(32, 1), 1 << 10, 8, 1, 32));
+    return key;
+}
+
+} // namespace
+
+TEST(ConcurrentKeyStore, Versions) {
+    ConcurrentKeyStore store;
+    const auto id = *store.add(fastKey())->id;
+    const auto before = store.snapshot();
+    const auto first = store.key(id);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->accounts.size(), 1ul);
+
+    const auto added = store.addAccounts(id, {TWCoinTypeEthereum, TWCoinTypeBinance}, password);
+    EXPECT_EQ(added->accounts.size(), 3ul);
+    EXPECT_EQ(store.key(id), added);
+    // earlier versions are unchanged
+    EXPECT_EQ(first->accounts.size(), 1ul);
+    EXPECT_EQ(before->at(id), first);
+
+    const auto newPassword = TW::data("new password");
+    EXPECT_THROW(store.changePassword(id, newPassword, newPassword), DecryptionError);
+    EXPECT_EQ(store.key(id), added);
+    const auto changed = store.changePassword(id, password, newPassword);
+    EXPECT_EQ(hex(changed->payload.decrypt(newPassword)), hex(TW::data(mnemonic)));
+    EXPECT_EQ(hex(added->payload.decrypt(password)), hex(TW::data(mnemonic)));
+    EXPECT_EQ(changed->accounts.size(), 3ul);
+
+    EXPECT_TRUE(store.remove(id));
+    EXPECT_FALSE(store.remove(id));
+    EXPECT_EQ(store.key(id), nullptr);
+    EXPECT_EQ(changed->accounts.size(), 3ul);
+    EXPECT_THROW(store.update(id, [](StoredKey&) {}), std::invalid_argument);
+    auto anonymous = fastKey();
+    anonymous.id.reset();
+    EXPECT_THROW(store.add(anonymous), std::invalid_argument);
+}
+
+TEST(ConcurrentKeyStore, Threads) {
+    ConcurrentKeyStore store;
+    const auto id = *store.add(fastKey())->id;
+    const auto address = store.key(id)->accounts[0].address;
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> consistent{true};
+    std::vector<std::thread> readers;
+    for (auto r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            std::size_t count = 0;
+            while (!done) {
+                const auto key = store.key(id);
+                // a version never changes, and versions only grow
+                const auto size = key->accounts.size();
+                if (size < count || key->accounts[0].address != address || key->accounts.size() != size) {
+                    consistent = false;
+                }
+                count = size;
+            }
+        });
+    }
+    constexpr uint32_t writerCount = 4;
+    constexpr uint32_t updateCount = 25;
+    std::vector<std::thread> writers;
+    for (uint32_t w = 0; w < writerCount; ++w) {
+        writers.emplace_back([&, w] {
+            for (uint32_t i = 0; i < updateCount; ++i) {
+                store.update(id, [&](StoredKey& key) {
+                    key.addAccount(address, TWCoinTypeBitcoin, DerivationPath(TWPurposeBIP44, 0, w, 0, i), "");
+                });
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_TRUE(consistent);
+    // no update is lost
+    EXPECT_EQ(store.key(id)->accounts.size(), 1 + writerCount * updateCount);
+}
+
+} // namespace TW::Keystore
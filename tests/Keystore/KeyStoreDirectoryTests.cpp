@@ -0,0 +1,94 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/KeyStoreDirectory.h"
+#include "HexCoding.h"
+#include "../interface/TWTestUtilities.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+extern std::string TESTS_ROOT;
+
+namespace TW::Keystore {
+
+namespace {
+
+std::string testFile(const char* name) {
+    return TESTS_ROOT + "/Keystore/Data/" + name;
+}
+
+} // namespace
+
+TEST(KeyStoreDirectory, Index) {
+    const auto keyFile = testFile("key.json");
+    const auto walletFile = testFile("wallet.json");
+    const auto privateKeyFile = testFile("legacy-private-key.json");
+    const auto myEtherWalletFile = testFile("myetherwallet.uu");
+    const auto directory = KeyStoreDirectory(std::vector<std::string>{walletFile, keyFile, privateKeyFile, myEtherWalletFile, keyFile + ".missing"}, 2);
+    ASSERT_EQ(directory.entries().size(), 4);
+    EXPECT_EQ(directory.entries()[0].path, keyFile);
+    EXPECT_EQ(directory.failedPaths(), std::vector<std::string>{keyFile + ".missing"});
+
+    const auto key = directory.find("e13b209c-3b2f-4327-bab0-3bef2e51630d");
+    ASSERT_NE(key, nullptr);
+    EXPECT_EQ(key->path, keyFile);
+    EXPECT_EQ(key->info.name, "Test Account");
+    ASSERT_EQ(key->info.accounts.size(), 1);
+    EXPECT_EQ(key->info.accounts[0].address, "0x008AeEda4D805471dF9b2A5B0f38A0C3bCBA786b");
+
+    const auto wallet = directory.find("e0fe53d0-7a3d-4f65-88b1-9bb4e245a169");
+    ASSERT_NE(wallet, nullptr);
+    EXPECT_EQ(wallet->info.type, StoredKeyType::mnemonicPhrase);
+
+    EXPECT_EQ(directory.find("00000000-0000-0000-0000-000000000000"), nullptr);
+    EXPECT_EQ(directory.find(TWCoinTypeEthereum).size(), 4);
+    EXPECT_TRUE(directory.find(TWCoinTypeBitcoin).empty());
+}
+
+TEST(KeyStoreDirectory, LazyLoad) {
+    const auto directory = KeyStoreDirectory(std::vector<std::string>{testFile("legacy-private-key.json")});
+    const auto& key = directory.key("3051ca7d-3d36-4a4a-acc2-09e9083732b0");
+    EXPECT_EQ(&key, &directory.key("3051ca7d-3d36-4a4a-acc2-09e9083732b0"));
+    EXPECT_EQ(hex(key.payload.decrypt(TW::data("testpassword"))), "7a28b5ba57c53603b0b07b56bba752f7784bf506fa95edc395f5cf6c7514fe9d");
+    EXPECT_THROW(directory.key("unknown"), std::invalid_argument);
+
+    const auto unlocked = directory.unlock("3051ca7d-3d36-4a4a-acc2-09e9083732b0", TW::data("testpassword"), std::chrono::seconds(60));
+    EXPECT_EQ(hex(unlocked->privateKey(TWCoinTypeEthereum).bytes), "7a28b5ba57c53603b0b07b56bba752f7784bf506fa95edc395f5cf6c7514fe9d");
+    EXPECT_THROW(directory.unlock("3051ca7d-3d36-4a4a-acc2-09e9083732b0", TW::data("wrong"), std::chrono::seconds(60)), DecryptionError);
+}
+
+TEST(KeyStoreDirectory, Directory) {
+    const auto path = getTestTempDir() + "/keystore_directory_" + std::to_string(getpid());
+    ASSERT_EQ(mkdir(path.c_str(), 0700), 0);
+    {
+        std::ofstream(path + "/key.json") << std::ifstream(testFile("key.json")).rdbuf();
+        std::ofstream(path + "/wallet.json") << std::ifstream(testFile("wallet.json")).rdbuf();
+        std::ofstream(path + "/notes.txt") << "not a key";
+        StoredKey::load(testFile("legacy-private-key.json")).storeBinary(path + "/binary.bin");
+        std::ofstream(path + "/metadata.json") << R"({"id": "e13b209c-3b2f-4327-bab0-3bef2e51630d"})";
+    }
+
+    const auto directory = KeyStoreDirectory(path);
+    EXPECT_EQ(directory.entries().size(), 3);
+    EXPECT_EQ(directory.failedPaths(), (std::vector<std::string>{path + "/metadata.json", path + "/notes.txt"}));
+    EXPECT_NE(directory.find("e13b209c-3b2f-4327-bab0-3bef2e51630d"), nullptr);
+    ASSERT_NE(directory.find("3051ca7d-3d36-4a4a-acc2-09e9083732b0"), nullptr);
+    EXPECT_EQ(directory.find("3051ca7d-3d36-4a4a-acc2-09e9083732b0")->info.accounts.size(), 1);
+
+    for (const auto name : {"/key.json", "/wallet.json", "/notes.txt", "/metadata.json", "/binary.bin"}) {
+        unlink((path + name).c_str());
+    }
+    rmdir(path.c_str());
+
+    EXPECT_THROW(KeyStoreDirectory{path}, std::invalid_argument);
+}
+
+} // namespace TW::Keystore
@@ -0,0 +1,140 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/PBKDF2Parameters.h"
+#include "Keystore/Scrypt.h"
+#include "Async.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/scrypt.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace TW::Keystore {
+
+namespace {
+
+const auto password = Data{'p', 'a', 's', 's', 'w', 'o', 'r', 'd'};
+const auto rfcKey = "fdbabe1c9d3472007856e7190d01e9fe7c6ad7cbc8237830e77376634b3731622eaf30d92e22a3886ff109279d9830dac727afb94a83ee6d8360cbdfa2cc0640";
+
+} // namespace
+
+TEST(Scrypt, Rfc7914) {
+    const auto params = ScryptParameters(Data{'N', 'a', 'C', 'l'}, 1024, 8, 16, 64);
+    EXPECT_EQ(hex(scryptDerive(password, params, 64)), rfcKey);
+    EXPECT_EQ(hex(scryptDerive(password, params, 64, nullptr, 1)), rfcKey);
+    EXPECT_EQ(hex(scryptDerive(password, params, 64, nullptr, 5)), rfcKey);
+
+    const auto empty = ScryptParameters(Data(), 16, 1, 1, 64);
+    EXPECT_EQ(hex(scryptDerive(Data(), empty, 64)),
+              "77d6576238657b203b19ca42c18a0497f16b4844e3074ae8dfdffa3fede21442fcd0069ded0948f8326a753a0fc81f17e8d3e0fb2e0d3628cf35e20c38d18906");
+
+    // same as the single-threaded C implementation
+    const auto light = ScryptParameters(Data(32, 7), ScryptParameters::lightN, 8, ScryptParameters::lightP, 32);
+    auto expected = Data(32);
+    ASSERT_EQ(scrypt(password.data(), password.size(), light.salt.data(), light.salt.size(), light.n, light.r, light.p, expected.data(), expected.size()), 0);
+    EXPECT_EQ(hex(scryptDerive(password, light, 32)), hex(expected));
+}
+
+TEST(Scrypt, Arena) {
+    const auto params = ScryptParameters(Data{'N', 'a', 'C', 'l'}, 1024, 8, 16, 64);
+    const auto lane = scrypt_smix_scratch_size(1024, 8);
+
+    auto arena = ScryptArena(3 * lane + 100);
+    EXPECT_EQ(arena.capacity(), 0);
+    EXPECT_EQ(hex(scryptDerive(password, params, 64, &arena, 16)), rfcKey);
+    EXPECT_EQ(arena.capacity(), 3 * lane);
+    EXPECT_EQ(hex(scryptDerive(password, params, 64, &arena, 2)), rfcKey);
+    EXPECT_EQ(arena.capacity(), 3 * lane);
+    arena.release();
+    EXPECT_EQ(arena.capacity(), 0);
+
+    auto small = ScryptArena(lane - 1);
+    EXPECT_THROW(scryptDerive(password, params, 64, &small), std::invalid_argument);
+
+    // concurrent derivations share the arena
+    auto unbounded = ScryptArena();
+    std::vector<std::thread> threads;
+    std::vector<std::string> keys(4);
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        threads.emplace_back([&, i] { keys[i] = hex(scryptDerive(password, params, 64, &unbounded, 2)); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (const auto& key : keys) {
+        EXPECT_EQ(key, rfcKey);
+    }
+}
+
+TEST(Scrypt, Cancel) {
+    const auto params = ScryptParameters(Data{'N', 'a', 'C', 'l'}, 1024, 8, 16, 64);
+    std::atomic<bool> cancelled{false};
+    {
+        ScopedCancellation scope(cancelled);
+        EXPECT_EQ(hex(scryptDerive(password, params, 64, nullptr, 4)), rfcKey);
+        cancelled = true;
+        EXPECT_THROW(scryptDerive(password, params, 64, nullptr, 4), Cancelled);
+        EXPECT_THROW(scryptDerive(password, params, 64, nullptr, 1), Cancelled);
+    }
+    // out of scope
+    EXPECT_EQ(hex(scryptDerive(password, params, 64)), rfcKey);
+}
+
+TEST(Scrypt, Invalid) {
+    auto params = ScryptParameters(Data{'N', 'a', 'C', 'l'}, 1024, 8, 16, 64);
+    EXPECT_THROW(scryptDerive(password, params, 0), std::invalid_argument);
+    params.n = 1000;
+    EXPECT_THROW(scryptDerive(password, params, 64), std::invalid_argument);
+    params.n = 1024;
+    params.r = 0;
+    EXPECT_THROW(scryptDerive(password, params, 64), std::invalid_argument);
+    params.r = 8;
+    params.p = 0;
+    EXPECT_THROW(scryptDerive(password, params, 64), std::invalid_argument);
+}
+
+TEST(Scrypt, Calibrated) {
+    const auto light = ScryptParameters::calibrated(std::chrono::milliseconds(20), 16 << 20);
+    EXPECT_FALSE(light.validate());
+    EXPECT_EQ(light.r, ScryptParameters::defaultR);
+    EXPECT_EQ(light.salt.size(), 32);
+    EXPECT_LE(128 * light.r * light.n, 16 << 20);
+    EXPECT_GE(light.n, ScryptParameters::minCalibratedN);
+    EXPECT_GE(light.p, 1);
+
+    // more time, more work
+    const auto heavy = ScryptParameters::calibrated(std::chrono::milliseconds(200), 16 << 20);
+    EXPECT_GE(uint64_t(heavy.n) * heavy.p, uint64_t(light.n) * light.p);
+    EXPECT_LE(128 * heavy.r * heavy.n, 16 << 20);
+    EXPECT_NE(hex(heavy.salt), hex(light.salt));
+
+    // the memory budget bounds N, the lanes take the time
+    const auto small = ScryptParameters::calibrated(std::chrono::milliseconds(200), 1 << 20);
+    EXPECT_EQ(small.n, ScryptParameters::minCalibratedN);
+    EXPECT_GE(small.p, heavy.p);
+    EXPECT_LE(small.p, ScryptParameters::maxCalibratedP);
+
+    // no time, the smallest parameters
+    const auto fastest = ScryptParameters::calibrated(std::chrono::milliseconds(0), 16 << 20);
+    EXPECT_EQ(fastest.n, ScryptParameters::minCalibratedN);
+    EXPECT_EQ(fastest.p, 1);
+
+    EXPECT_THROW(ScryptParameters::calibrated(std::chrono::milliseconds(20), (1 << 20) - 1), std::invalid_argument);
+}
+
+TEST(Scrypt, CalibratedPBKDF2) {
+    const auto light = PBKDF2Parameters::calibrated(std::chrono::milliseconds(20));
+    const auto heavy = PBKDF2Parameters::calibrated(std::chrono::milliseconds(200));
+    EXPECT_GE(light.iterations, PBKDF2Parameters::minCalibratedIterations);
+    EXPECT_GE(heavy.iterations, light.iterations);
+    EXPECT_EQ(PBKDF2Parameters::calibrated(std::chrono::milliseconds(0)).iterations, PBKDF2Parameters::minCalibratedIterations);
+    EXPECT_EQ(light.salt.size(), 32);
+}
+
+} // namespace TW::Keystore
@@ -11,7 +11,10 @@
 #include "Data.h"
 #include "PrivateKey.h"
 #include "Mnemonic.h"
+#include "../interface/TWTestUtilities.h"
 
+#include <boost/variant/get.hpp>
+#include <fstream>
 #include <stdexcept>
 #include <gtest/gtest.h>
 
@@ -36,7 +39,7 @@ TEST(StoredKey, CreateWithMnemonic) {
     const Data& mnemo2Data = key.payload.decrypt(password);
     EXPECT_EQ(string(mnemo2Data.begin(), mnemo2Data.end()), string(mnemonic));
     EXPECT_EQ(key.accounts.size(), 0);
-    EXPECT_EQ(key.wallet(password).mnemonic, string(mnemonic));
+    EXPECT_EQ(key.wallet(password).mnemonic.c_str(), string(mnemonic));
 
     const auto json = key.json();
     EXPECT_EQ(json["name"], "name");
@@ -193,6 +196,43 @@ TEST(StoredKey, AddRemoveAccount) {
     EXPECT_EQ(key.accounts.size(), 0);
 }
 
+TEST(StoredKey, AccountIndex) {
+    auto key = StoredKey::createWithMnemonic("name", password, mnemonic);
+    const auto path0 = DerivationPath("m/44'/60'/0'/0/0");
+    const auto path1 = DerivationPath("m/44'/60'/0'/0/1");
+    key.addAccounts({
+        Account("0x0", coinTypeEth, path0),
+        Account("bnb1", coinTypeBnb, DerivationPath("m/44'/714'/0'/0/0")),
+        Account("0x1", coinTypeEth, path1),
+    });
+    ASSERT_EQ(key.accounts.size(), 3);
+
+    EXPECT_EQ(key.account(coinTypeEth)->address, "0x0");
+    EXPECT_EQ(key.account(coinTypeEth, path1)->address, "0x1");
+    EXPECT_FALSE(key.account(coinTypeEth, DerivationPath("m/44'/60'/0'/0/2")).has_value());
+    EXPECT_FALSE(key.account(coinTypeBc).has_value());
+
+    const auto ethereum = key.accountsForCoin(coinTypeEth);
+    ASSERT_EQ(ethereum.size(), 2);
+    EXPECT_EQ(ethereum[1].address, "0x1");
+
+    key.removeAccount(coinTypeEth, path0);
+    EXPECT_EQ(key.account(coinTypeEth)->address, "0x1");
+    EXPECT_EQ(key.account(coinTypeBnb)->address, "bnb1");
+
+    // direct modifications are still found
+    key.accounts.emplace_back("bc1", coinTypeBc, DerivationPath("m/84'/0'/0'/0/0"));
+    EXPECT_EQ(key.account(coinTypeBc)->address, "bc1");
+    key.accounts.erase(key.accounts.begin() + 1);
+    EXPECT_FALSE(key.account(coinTypeEth).has_value());
+    key.reindexAccounts();
+    EXPECT_EQ(key.account(coinTypeBc)->address, "bc1");
+
+    const auto loaded = StoredKey::createWithJson(key.json());
+    EXPECT_EQ(loaded.account(coinTypeBc)->address, "bc1");
+    EXPECT_EQ(loaded.accountsForCoin(coinTypeBnb).size(), 1);
+}
+
 TEST(StoredKey, FixAddress) {
     {
         auto key = StoredKey::createWithMnemonic("name", password, mnemonic);
@@ -371,4 +411,149 @@ TEST(StoredKey, EtherWalletAddressNo0x) {
     EXPECT_EQ(key.account(TWCoinTypeEthereum, nullptr)->address, "0xAc1ec44E4f0ca7D172B7803f6836De87Fb72b309");
 }
 
+TEST(StoredKey, BinaryFormat) {
+    for (const auto name : {"legacy-mnemonic.json", "pbkdf2.json", "key_bitcoin.json", "wallet.json"}) {
+        const auto key = StoredKey::load(TESTS_ROOT + "/Keystore/Data/" + name);
+        const auto binary = key.binary();
+        EXPECT_LT(binary.size(), key.json().dump().size()) << name;
+
+        const auto decoded = StoredKey::createWithBinary(binary);
+        EXPECT_EQ(decoded.json(), key.json()) << name;
+        EXPECT_EQ(decoded.binary(), binary) << name;
+    }
+
+    auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", password, mnemonic, coinTypeBc);
+    const auto path = getTestTempDir() + "/storedkey_binary.bin";
+    key.storeBinary(path);
+    const auto loaded = StoredKey::load(path);
+    EXPECT_EQ(loaded.json(), key.json());
+    EXPECT_EQ(loaded.account(coinTypeBc)->address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(hex(loaded.payload.decrypt(password)), hex(TW::data(mnemonic)));
+
+    EXPECT_THROW(StoredKey::createWithBinary(parse_hex("d9d9f7a0")), DecryptionError);
+    EXPECT_THROW(StoredKey::createWithBinary(parse_hex("d9d9f7a1000280")), DecryptionError);
+    EXPECT_THROW(StoredKey::createWithBinary(Data()), DecryptionError);
+    auto truncated = key.binary();
+    truncated.resize(truncated.size() / 2);
+    EXPECT_THROW(StoredKey::createWithBinary(truncated), DecryptionError);
+}
+
+TEST(StoredKey, CalibratedKDF) {
+    const auto pbkdf2 = PBKDF2Parameters::calibrated(std::chrono::milliseconds(10));
+    EncryptionParameters::setDefaultKDFParams(pbkdf2);
+    const auto key = StoredKey::createWithMnemonic("name", password, mnemonic);
+    const auto json = key.json();
+    EXPECT_EQ(json["crypto"]["kdf"], "pbkdf2");
+    EXPECT_EQ(json["crypto"]["kdfparams"]["c"], pbkdf2.iterations);
+    // each key has its own salt
+    EXPECT_NE(json["crypto"]["kdfparams"]["salt"], hex(pbkdf2.salt));
+    EXPECT_NE(json["crypto"]["kdfparams"]["salt"], StoredKey::createWithMnemonic("name", password, mnemonic).json()["crypto"]["kdfparams"]["salt"]);
+    EXPECT_EQ(hex(StoredKey::createWithJson(json).payload.decrypt(password)), hex(TW::data(mnemonic)));
+    EXPECT_THROW(key.payload.decrypt(TW::data("wrong")), DecryptionError);
+
+    const auto scrypt = ScryptParameters::calibrated(std::chrono::milliseconds(10), 4 << 20);
+    EncryptionParameters::setDefaultKDFParams(scrypt);
+    const auto scryptKey = StoredKey::createWithMnemonic("name", password, mnemonic);
+    EXPECT_EQ(scryptKey.json()["crypto"]["kdf"], "scrypt");
+    EXPECT_EQ(scryptKey.json()["crypto"]["kdfparams"]["n"], scrypt.n);
+    EXPECT_EQ(scryptKey.json()["crypto"]["kdfparams"]["p"], scrypt.p);
+    EXPECT_EQ(hex(StoredKey::createWithBinary(scryptKey.binary()).payload.decrypt(password)), hex(TW::data(mnemonic)));
+
+    EncryptionParameters::setDefaultKDFParams(ScryptParameters());
+    const auto defaultKey = StoredKey::createWithMnemonic("name", password, mnemonic);
+    EXPECT_EQ(defaultKey.json()["crypto"]["kdfparams"]["n"], ScryptParameters::lightN);
+    EXPECT_EQ(defaultKey.json()["crypto"]["kdfparams"]["p"], ScryptParameters::lightP);
+}
+
+TEST(StoredKey, ChangePassword) {
+    auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", password, mnemonic, coinTypeBc);
+    const auto scrypt = ScryptParameters(Data(32, 1), 1 << 10, 8, 2, 32);
+    key.payload = EncryptionParameters(password, TW::data(mnemonic), scrypt);
+    const auto newPassword = TW::data("new password");
+
+    EXPECT_THROW(key.changePassword(newPassword, newPassword), DecryptionError);
+    key.changePassword(password, newPassword);
+    EXPECT_EQ(hex(key.payload.decrypt(newPassword)), hex(TW::data(mnemonic)));
+    EXPECT_THROW(key.payload.decrypt(password), DecryptionError);
+    // same parameters, new salt
+    const auto& params = boost::get<ScryptParameters>(key.payload.kdfParams);
+    EXPECT_EQ(params.n, scrypt.n);
+    EXPECT_EQ(params.p, scrypt.p);
+    EXPECT_NE(hex(params.salt), hex(scrypt.salt));
+    EXPECT_EQ(key.accounts.size(), 1);
+    EXPECT_EQ(key.account(coinTypeBc)->address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+
+    auto pbkdf2Key = StoredKey::load(TESTS_ROOT + "/Keystore/Data/pbkdf2.json");
+    const auto decrypted = pbkdf2Key.payload.decrypt(TW::data("testpassword"));
+    pbkdf2Key.changePassword(TW::data("testpassword"), newPassword);
+    EXPECT_EQ(pbkdf2Key.payload.kdfParams.which(), 1);
+    EXPECT_EQ(hex(pbkdf2Key.payload.decrypt(newPassword)), hex(decrypted));
+}
+
+TEST(StoredKey, AddAccountsBatch) {
+    auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", password, mnemonic, coinTypeBc);
+    const auto coins = std::vector<TWCoinType>{coinTypeBnb, coinTypeBc, coinTypeBsc, TWCoinTypeEthereum, coinTypeBnb};
+    const auto added = key.addAccounts(coins, password);
+    ASSERT_EQ(added.size(), coins.size());
+    EXPECT_EQ(key.accounts.size(), 4);
+
+    const auto wallet = key.wallet(password);
+    auto reference = StoredKey::createWithMnemonic("name", password, mnemonic);
+    for (std::size_t i = 0; i < coins.size(); ++i) {
+        const auto expected = reference.account(coins[i], &wallet);
+        EXPECT_EQ(added[i].coin, coins[i]);
+        EXPECT_EQ(added[i].address, expected->address);
+        EXPECT_EQ(added[i].derivationPath.string(), expected->derivationPath.string());
+        EXPECT_EQ(added[i].extendedPublicKey, expected->extendedPublicKey);
+    }
+    EXPECT_EQ(added[1].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+
+    // empty addresses are filled in
+    key.accounts[0].address = "";
+    EXPECT_EQ(key.addAccounts({coinTypeBc}, wallet)[0].address, "bc1qturc268v0f2srjh4r2zu4t6zk4gdutqd5a6zny");
+    EXPECT_EQ(key.accounts.size(), 4);
+    EXPECT_TRUE(key.addAccounts({}, wallet).empty());
+
+    EXPECT_THROW(key.addAccounts(coins, TW::data("wrong")), DecryptionError);
+    auto privateKey = StoredKey::createWithPrivateKey("name", password, parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266"));
+    EXPECT_THROW(privateKey.addAccounts(coins, password), std::invalid_argument);
+}
+
+TEST(StoredKey, StoreReplaces) {
+    const auto path = getTestTempDir() + "/storedkey_replace.json";
+    auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", password, mnemonic, coinTypeBc);
+    key.store(path);
+    key.addAccounts({coinTypeBnb, coinTypeBsc}, password);
+    key.store(path);
+    const auto loaded = StoredKey::load(path);
+    EXPECT_EQ(loaded.json(), key.json());
+    EXPECT_EQ(loaded.accounts.size(), 3);
+    // no temporary file left
+    EXPECT_FALSE(std::ifstream(path + ".tmp").is_open());
+
+    key.storeBinary(path);
+    EXPECT_EQ(StoredKey::load(path).json(), key.json());
+
+    EXPECT_THROW(key.store(getTestTempDir() + "/missing/directory/key.json"), std::invalid_argument);
+    EXPECT_THROW(key.storeBinary(getTestTempDir() + "/missing/directory/key.bin"), std::invalid_argument);
+}
+
+TEST(StoredKey, SharedWallet) {
+    auto key = StoredKey::createWithMnemonic("name", password, mnemonic);
+    const auto wallet = key.sharedWallet(password);
+    ASSERT_NE(wallet, nullptr);
+    EXPECT_EQ(wallet->mnemonic.c_str(), string(mnemonic));
+    EXPECT_EQ(hex(wallet->seed), hex(key.wallet(password).seed));
+
+    auto reference = StoredKey::createWithMnemonic("name", password, mnemonic);
+    for (const auto coin : {coinTypeBc, coinTypeBnb, coinTypeEth}) {
+        EXPECT_EQ(hex(key.privateKey(coin, *wallet).bytes), hex(reference.privateKey(coin, password).bytes));
+    }
+    EXPECT_EQ(key.accounts.size(), 3);
+
+    EXPECT_THROW(key.sharedWallet(Data{1, 2, 3}), DecryptionError);
+    const auto privateKey = StoredKey::createWithPrivateKey("name", password, parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266"));
+    EXPECT_THROW(privateKey.sharedWallet(password), std::invalid_argument);
+}
+
 } // namespace TW::Keystore
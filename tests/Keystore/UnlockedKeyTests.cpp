@@ -0,0 +1,68 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Keystore/StoredKey.h"
+#include "Keystore/UnlockedKey.h"
+#include "Coin.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::Keystore {
+
+namespace {
+
+const auto password = TW::data(std::string("password"));
+const auto mnemonic = "team engine square letter hero song dizzy scrub tornado fabric divert saddle";
+
+} // namespace
+
+TEST(UnlockedKey, Mnemonic) {
+    auto key = StoredKey::createWithMnemonicAddDefaultAddress("name", password, mnemonic, TWCoinTypeBitcoin);
+    const auto unlocked = key.unlock(password, std::chrono::seconds(60));
+    ASSERT_TRUE(unlocked->isUnlocked());
+    EXPECT_EQ(unlocked->type(), StoredKeyType::mnemonicPhrase);
+    EXPECT_GT(unlocked->expiry(), UnlockedKey::Clock::now());
+
+    const auto wallet = key.wallet(password);
+    for (const auto coin : {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeCardano}) {
+        EXPECT_EQ(hex(unlocked->privateKey(coin).bytes), hex(wallet.getKey(coin, TW::derivationPath(coin)).bytes));
+        EXPECT_EQ(unlocked->deriveAddress(coin), wallet.deriveAddress(coin));
+    }
+    EXPECT_EQ(unlocked->deriveAddress(TWCoinTypeBitcoin), key.account(TWCoinTypeBitcoin)->address);
+
+    const auto path = DerivationPath("m/44'/60'/0'/0/7");
+    EXPECT_EQ(hex(unlocked->privateKey(TWCoinTypeEthereum, path).bytes), hex(wallet.getKey(TWCoinTypeEthereum, path).bytes));
+
+    const auto digest = parse_hex("2ec1d4b5f4b1f4a3a87b6d9b8ce5fb3ce87a1b6e8ad1dc0e3d15cc2e28ae5ba7");
+    EXPECT_EQ(hex(unlocked->sign(TWCoinTypeEthereum, digest)),
+              hex(key.privateKey(TWCoinTypeEthereum, password).sign(digest, TWCurveSECP256k1)));
+
+    unlocked->close();
+    EXPECT_FALSE(unlocked->isUnlocked());
+    EXPECT_THROW(unlocked->privateKey(TWCoinTypeEthereum), KeyLockedError);
+}
+
+TEST(UnlockedKey, PrivateKey) {
+    const auto privateKey = parse_hex("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+    const auto key = StoredKey::createWithPrivateKey("name", password, privateKey);
+    const auto unlocked = key.unlock(password, std::chrono::seconds(60));
+    EXPECT_EQ(unlocked->type(), StoredKeyType::privateKey);
+    EXPECT_EQ(hex(unlocked->privateKey(TWCoinTypeEthereum).bytes), hex(privateKey));
+    EXPECT_EQ(unlocked->deriveAddress(TWCoinTypeEthereum), TW::deriveAddress(TWCoinTypeEthereum, PrivateKey(privateKey)));
+    EXPECT_THROW(unlocked->privateKey(TWCoinTypeEthereum, DerivationPath("m/44'/60'/0'/0/0")), std::invalid_argument);
+}
+
+TEST(UnlockedKey, Expiry) {
+    const auto key = StoredKey::createWithMnemonic("name", password, mnemonic);
+    const auto expired = key.unlock(password, std::chrono::seconds(0));
+    EXPECT_FALSE(expired->isUnlocked());
+    EXPECT_THROW(expired->deriveAddress(TWCoinTypeBitcoin), KeyLockedError);
+
+    EXPECT_THROW(key.unlock(TW::data(std::string("wrong")), std::chrono::seconds(60)), DecryptionError);
+}
+
+} // namespace TW::Keystore
@@ -59,6 +59,29 @@ TEST(Mnemonic, isValidWord) {
     EXPECT_FALSE(Mnemonic::isValidWord("hybridous"));
     EXPECT_FALSE(Mnemonic::isValidWord("CREDIT"));
     EXPECT_FALSE(Mnemonic::isValidWord("credit  "));
+    EXPECT_FALSE(Mnemonic::isValidWord("cred"));
+    EXPECT_FALSE(Mnemonic::isValidWord(""));
+    EXPECT_FALSE(Mnemonic::isValidWord("abandonment"));
+}
+
+TEST(Mnemonic, wordIndex) {
+    EXPECT_EQ(Mnemonic::wordIndex("abandon"), 0);
+    EXPECT_EQ(Mnemonic::wordIndex("ability"), 1);
+    EXPECT_EQ(Mnemonic::wordIndex("credit"), 408);
+    EXPECT_EQ(Mnemonic::wordIndex("zoo"), 2047);
+    EXPECT_EQ(Mnemonic::wordIndex("zoom"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("Zoo"), -1);
+    EXPECT_EQ(Mnemonic::wordIndex("a"), -1);
+}
+
+TEST(Mnemonic, validateMany) {
+    auto mnemonics = ValidInput;
+    mnemonics.insert(mnemonics.end(), InvalidInput.begin(), InvalidInput.end());
+    const auto result = Mnemonic::validateMany(mnemonics);
+    ASSERT_EQ(result.size(), mnemonics.size());
+    for (size_t i = 0; i < result.size(); ++i) {
+        EXPECT_EQ(result[i], i < ValidInput.size()) << mnemonics[i];
+    }
 }
 
 TEST(Mnemonic, suggest) {
@@ -40,4 +40,35 @@ TEST(NEARSerialization, SerializeTransferTransaction) {
     ASSERT_EQ(serializedHex, "09000000746573742e6e65617200917b3d268d4b58f7fec1b150bd68d69be3ee5d4cc39855e341538465bb77860d01000000000000000d00000077686174657665722e6e6561720fa473fd26901df296be6adc4cc4df34d040efa2435224b6986910e630c2fef6010000000301000000000000000000000000000000");
 }
 
+TEST(NEARSerialization, SerializeFunctionCallTransaction) {
+    auto input = Proto::SigningInput();
+    input.set_signer_id("test.near");
+    input.set_nonce(1);
+    input.set_receiver_id("whatever.near");
+    auto blockHash = Base58::bitcoin.decode("244ZQ9cgj3CQ6bWBdytfrJMuMQ1jdXLFGnr4HhvtCTnM");
+    input.set_block_hash(blockHash.data(), blockHash.size());
+    auto privateKey = Base58::bitcoin.decode("3hoMW1HvnRLSFCLZnvPzWeoGwtdHzke34B2cTHM8rhcbG3TbuLKtShTv3DvyejnXKXKBiV7YPkLeqUHN1ghnqpFv");
+    input.set_private_key(privateKey.data(), 32);
+
+    Data deposit(16, 0);
+    deposit[0] = 1;
+    for (int i = 0; i < 2; ++i) {
+        auto& call = *input.add_actions()->mutable_function_call();
+        call.set_method_name("ft_transfer");
+        call.set_args("{}");
+        call.set_gas(1000 + i);
+        call.set_deposit(deposit.data(), deposit.size());
+    }
+    input.add_actions()->mutable_delete_account()->set_beneficiary_id("a.near");
+
+    const auto serialized = transactionData(input, signatureSuffixSize);
+    EXPECT_GE(serialized.capacity(), serialized.size() + signatureSuffixSize);
+    EXPECT_EQ(hex(serialized),
+        "09000000746573742e6e65617200917b3d268d4b58f7fec1b150bd68d69be3ee5d4cc39855e341538465bb77860d01000000000000000d00000077686174657665722e6e6561720fa473fd26901df296be6adc4cc4df34d040efa2435224b6986910e630c2fef6"
+        "03000000"
+        "02" "0b00000066745f7472616e73666572" "020000007b7d" "e803000000000000" "01000000000000000000000000000000"
+        "02" "0b00000066745f7472616e73666572" "020000007b7d" "e903000000000000" "01000000000000000000000000000000"
+        "07" "06000000612e6e656172");
+}
+
 }
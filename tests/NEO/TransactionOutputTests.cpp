@@ -42,3 +42,20 @@ TEST(NEOTransactionOutput, Deserialize) {
     EXPECT_EQ(assetId, hex(store(transactionOutput.assetId)));
     EXPECT_EQ(scriptHash, hex(store(transactionOutput.scriptHash)));
 }
+
+TEST(NEOTransactionOutput, DeserializeTruncated) {
+    string assetId = "bdecbb623eee6f9ade28d5a8ff5fb3ea9c9d73af039e0286201b3b0291fb4d4a";
+    string scriptHash = "cbb23e6f9ade28d5a8ff3eac9d73af039e821b1b";
+    auto transactionOutput = TransactionOutput();
+    EXPECT_THROW(transactionOutput.deserialize(parse_hex(assetId + "01000000")), std::invalid_argument);
+    EXPECT_THROW(transactionOutput.deserialize(parse_hex(assetId + "0100000000000000" + scriptHash.substr(2))), std::invalid_argument);
+
+    // consecutive outputs, read from one reader
+    const auto data = parse_hex("02" + assetId + "0100000000000000" + scriptHash + assetId + "0200000000000000" + scriptHash);
+    vector<TransactionOutput> outputs;
+    BinaryReader reader(data);
+    Serializable::deserialize(outputs, reader);
+    ASSERT_EQ(outputs.size(), 2ul);
+    EXPECT_EQ(outputs[1].value, 2);
+    EXPECT_EQ(reader.remaining(), 0ul);
+}
@@ -0,0 +1,92 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Nano/Signer.h"
+#include "Nano/Work.h"
+#include "Hash.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Nano;
+
+static Work::Root root(const std::string& string) {
+    const auto data = parse_hex(string);
+    Work::Root result;
+    std::copy(data.begin(), data.end(), result.begin());
+    return result;
+}
+
+// low threshold, found after 256 attempts on average
+static const uint64_t testThreshold = 0xff00000000000000;
+
+TEST(NanoWork, Difficulty) {
+    // work_validate example of the node RPC documentation
+    const auto blockRoot = root("718cc2121c3e641059bc1c2cfc45666c99e8ae922f7a807b7d07b62c995d79e2");
+    EXPECT_EQ(Work::difficulty(blockRoot, 0x2bf29ef00786a6bc), 0xffffffd21c3933f4);
+    EXPECT_TRUE(Work::isValid(blockRoot, 0x2bf29ef00786a6bc, Work::receiveThreshold));
+    EXPECT_FALSE(Work::isValid(blockRoot, 0x2bf29ef00786a6bc, Work::sendThreshold));
+    EXPECT_EQ(Work::string(0x2bf29ef00786a6bc), "2bf29ef00786a6bc");
+    EXPECT_EQ(Work::string(1), "0000000000000001");
+}
+
+TEST(NanoWork, Generate) {
+    const auto blockRoot = root("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+    std::atomic<bool> cancelled(false);
+    for (size_t threadCount : {1, 3}) {
+        const auto work = Work::generate(blockRoot, testThreshold, cancelled, threadCount);
+        ASSERT_TRUE(work.has_value());
+        EXPECT_TRUE(Work::isValid(blockRoot, *work, testThreshold));
+    }
+
+    cancelled = true;
+    EXPECT_FALSE(Work::generate(blockRoot, UINT64_MAX, cancelled, 2).has_value());
+}
+
+TEST(NanoWork, GeneratorPrecompute) {
+    const auto privateKey = parse_hex("173c40e97fe2afcd24187e74f6b603cb949a5365e72fbdd065a6b165e2189e34");
+    const auto linkBlock = parse_hex("491fca2c69a84607d374aaf1f6acd3ce70744c5be0721b5ed394653e85233507");
+    auto input = Proto::SigningInput();
+    input.set_private_key(privateKey.data(), privateKey.size());
+    input.set_link_block(linkBlock.data(), linkBlock.size());
+    input.set_representative("xrb_3arg3asgtigae3xckabaaewkx3bzsh7nwz7jkmjos79ihyaxwphhm6qgjps4");
+    input.set_balance("96242336390000000000000000000");
+
+    const auto signer = Signer(input);
+    // first block, rooted at the account
+    EXPECT_EQ(hex(signer.workRoot()), hex(signer.publicKey.bytes));
+
+    size_t calls = 0;
+    auto generator = WorkGenerator(testThreshold, [&](const Work::Root& root, uint64_t threshold, const std::atomic<bool>& cancelled) {
+        ++calls;
+        return Work::generate(root, threshold, cancelled, 2);
+    });
+    const auto work = generator.work(signer.workRoot());
+    ASSERT_TRUE(work.has_value());
+    EXPECT_TRUE(Work::isValid(signer.workRoot(), *work, testThreshold));
+
+    // next block is rooted at this one
+    generator.precompute(signer.blockHash);
+    const auto next = generator.work(signer.blockHash);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_TRUE(Work::isValid(signer.blockHash, *next, testThreshold));
+    EXPECT_EQ(calls, 2);
+
+    input.set_parent_block(signer.blockHash.data(), signer.blockHash.size());
+    input.set_work(Work::string(*next));
+    const auto nextSigner = Signer(input);
+    EXPECT_EQ(hex(nextSigner.workRoot()), hex(signer.blockHash));
+    EXPECT_NE(nextSigner.build().json().find("\"work\":\"" + Work::string(*next) + "\""), std::string::npos);
+}
+
+TEST(NanoWork, GeneratorCancel) {
+    const auto blockRoot = root("f9a323153daefe041efb94d69b9669c882c935530ed953bbe8a665dfedda9696");
+    auto generator = WorkGenerator(UINT64_MAX, 2);
+    generator.precompute(blockRoot);
+    generator.cancel();
+    EXPECT_FALSE(generator.work(blockRoot).has_value());
+}
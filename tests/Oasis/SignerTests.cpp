@@ -6,9 +6,11 @@
 
 #include "Oasis/Signer.h"
 #include "Oasis/Address.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
+#include "BatchSigningHelper.h"
 
 #include <gtest/gtest.h>
 
@@ -35,3 +37,33 @@ TEST(OasisSigner, Sign) {
 
     ASSERT_EQ(hex(output.encoded()),"a273756e747275737465645f7261775f76616c7565585ea4656e6f6e636500666d6574686f64707374616b696e672e5472616e7366657263666565a2636761730066616d6f756e74410064626f6479a262746f5500c73cc001463434915ba3f39751beb7c0905b45eb66616d6f756e744400989680697369676e6174757265a26a7075626c69635f6b6579582093d8f8a455f50527976a8aa87ebde38d5606efa86cb985d3fb466aff37000e3b697369676e61747572655840e331ce731ed819106586152b13cd98ecf3248a880bdc71174ee3d83f6d5f3f8ee8fc34c19b22032f2f1e3e06d382720125d7a517fba9295c813228cc2b63170b");
 }
+
+TEST(OasisSigner, SigningContext) {
+    const auto context = std::string("oasis-core/consensus: tx for chain a245619497e580dd3bc1aa3256c07f68b8dcc13f92da115eadc3b231b083d3c4");
+    const auto signingContext = SigningContext(context);
+    EXPECT_EQ(signingContext.context(), context);
+    for (const auto& message : {Data(), parse_hex("a4656e6f6e6365"), Data(300, 0x5a)}) {
+        auto expected = data(context);
+        append(expected, message);
+        EXPECT_EQ(hex(signingContext.hash(message)), hex(Hash::sha512_256(expected)));
+    }
+}
+
+TEST(OasisSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = Proto::SigningInput();
+        auto& transfer = *input.mutable_transfer();
+        transfer.set_gas_price(i % 3);
+        transfer.set_gas_amount(std::to_string(2000 + i));
+        transfer.set_nonce(i);
+        // invalid checksum
+        transfer.set_to(i == 130 ? "oasis1qrrnesqpgc6rfy2m50eew5d7klqfqk69avhv4ak4" : "oasis1qrrnesqpgc6rfy2m50eew5d7klqfqk69avhv4ak5");
+        transfer.set_amount(std::to_string(10000000 + i));
+        transfer.set_context(i < 70 ? "oasis-core/consensus: tx for chain a" : "oasis-core/consensus: tx for chain b");
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "4f8b5676990b00e23d9904a92deb8d8f428ff289c8939926358f1d20537c21a0"
+                                                                   : "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+        input.set_private_key(privateKey.data(), privateKey.size());
+        return input;
+    }, {130});
+}
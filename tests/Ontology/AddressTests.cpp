@@ -40,7 +40,7 @@ TEST(OntologyAddress, fromMultiPubKeys) {
     auto signer1 = Signer(PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646")));
     auto signer2 = Signer(PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464652")));
     auto signer3 = Signer(PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464658")));
-    std::vector<Data> pubKeys{signer1.getPublicKey().bytes, signer2.getPublicKey().bytes, signer3.getPublicKey().bytes};
+    std::vector<Data> pubKeys{signer1.getPublicKey().bytes.toData(), signer2.getPublicKey().bytes.toData(), signer3.getPublicKey().bytes.toData()};
     uint8_t m = 2;
     auto multiAddress = Address(m, pubKeys);
     EXPECT_EQ("AYGWgijVZnrUa2tRoCcydsHUXR1111DgdW", multiAddress.string());
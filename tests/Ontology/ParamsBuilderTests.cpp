@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "HexCoding.h"
+#include "PrivateKey.h"
 #include "PublicKey.h"
 
 #include "Ontology/Address.h"
@@ -81,4 +82,59 @@ TEST(ParamsBuilder, transferInvokeCode) {
         "ad76586a7cc8516a7cc86c51c1087472616e736665721400000000000000000000000000000000000000010068"
         "164f6e746f6c6f67792e4e61746976652e496e766f6b65";
     EXPECT_EQ(hexInvokeCode, hex(invokeCode));
-}
\ No newline at end of file
+}
+TEST(ParamsBuilder, transferInvokeCodeTemplate) {
+    auto fromAddress = Address("ANDfjwrUroaVtvBguDtrWKRMyxFwvVwnZD").data;
+    auto toAddress = Address("Af1n2cZHhMZumNqKgw9sfCNoTWu9de4NDn").data;
+    auto suffix = ParamsBuilder::buildNativeInvokeSuffix(Ont().contractAddress(), 0x00, "transfer");
+    for (uint64_t amount : {0ull, 1ull, 15ull, 16ull, 127ull, 128ull, 0x8000ull, 0xFFFFFFFFFFFFFFFFull}) {
+        std::list<boost::any> transferParam{fromAddress, toAddress, amount};
+        std::vector<boost::any> args{transferParam};
+        auto invokeCode =
+            ParamsBuilder::buildNativeInvokeCode(Ont().contractAddress(), 0x00, "transfer", args);
+        EXPECT_EQ(hex(invokeCode), hex(ParamsBuilder::buildTransferInvokeCode(
+                                       suffix, fromAddress, toAddress, amount)));
+    }
+}
+
+TEST(ParamsBuilder, transferFromInvokeCodeTemplate) {
+    auto ongContract = Data(19, 0x00);
+    ongContract.push_back(0x02);
+    auto sender = Address("ANDfjwrUroaVtvBguDtrWKRMyxFwvVwnZD").data;
+    auto from = Address(Ont().contractAddress()).data;
+    auto to = Address("Af1n2cZHhMZumNqKgw9sfCNoTWu9de4NDn").data;
+    auto suffix = ParamsBuilder::buildNativeInvokeSuffix(ongContract, 0x00, "transferFrom");
+    for (uint64_t amount : {0ull, 1ull, 200ull, 0xFFFFFFFFFFull}) {
+        std::list<boost::any> args{sender, from, to, amount};
+        auto invokeCode =
+            ParamsBuilder::buildNativeInvokeCode(ongContract, 0x00, "transferFrom", args);
+        EXPECT_EQ(hex(invokeCode), hex(ParamsBuilder::buildTransferFromInvokeCode(
+                                       suffix, sender, from, to, amount)));
+    }
+}
+
+TEST(ParamsBuilder, takeBytes) {
+    ParamsBuilder builder(64);
+    builder.push(std::string("transfer"));
+    EXPECT_EQ("087472616e73666572", hex(builder.getBytes()));
+    EXPECT_EQ("087472616e73666572", hex(builder.takeBytes()));
+    EXPECT_TRUE(builder.getBytes().empty());
+}
+
+TEST(ParamsBuilder, fromMultiPubkeySorted) {
+    std::vector<Data> pubKeys;
+    for (auto key : {"4646464646464646464646464646464646464646464646464646464646464646",
+                     "4646464646464646464646464646464646464646464646464646464646464652",
+                     "4646464646464646464646464646464646464646464646464646464646464658"}) {
+        pubKeys.push_back(PrivateKey(parse_hex(key)).getPublicKey(TWPublicKeyTypeNIST256p1).bytes.toData());
+    }
+    auto script = ParamsBuilder::fromMultiPubkey(2, pubKeys);
+    // keys in any order give the same script
+    std::swap(pubKeys[0], pubKeys[2]);
+    EXPECT_EQ(hex(script), hex(ParamsBuilder::fromMultiPubkey(2, pubKeys)));
+    std::swap(pubKeys[1], pubKeys[2]);
+    EXPECT_EQ(hex(script), hex(ParamsBuilder::fromMultiPubkey(2, pubKeys)));
+
+    pubKeys.push_back(parse_hex("0211"));
+    EXPECT_THROW(ParamsBuilder::fromMultiPubkey(2, pubKeys), std::runtime_error);
+}
@@ -0,0 +1,41 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+
+#include "Ontology/Signer.h"
+#include "BatchSigningHelper.h"
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+using namespace TW::Ontology;
+
+TEST(OntologySigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        const auto ownerKey = key == BatchKey::Invalid ? Data(32)
+                              : parse_hex(key == BatchKey::First ? "4646464646464646464646464646464646464646464646464646464646464646"
+                                                                 : "4646464646464646464646464646464646464646464646464646464646464658");
+        const auto payerKey = parse_hex("4646464646464646464646464646464646464646464646464646464646464652");
+        const char* methods[][2] = {{"ONT", "transfer"}, {"ONG", "transfer"}, {"ONG", "withdraw"}, {"ONT", "balanceOf"}};
+        Proto::SigningInput input;
+        // runs of 4 inputs with the same method, some paid by the owner
+        const auto& method = methods[(i / 4) % 4];
+        input.set_contract(method[0]);
+        input.set_method(method[1]);
+        const auto& payer = i % 8 < 4 ? payerKey : ownerKey;
+        input.set_owner_private_key(ownerKey.data(), ownerKey.size());
+        input.set_payer_private_key(payer.data(), payer.size());
+        // invalid checksum
+        input.set_to_address(i == 21 ? "Af1n2cZHhMZumNqKgw9sfCNoTWu9de4NDm" : "Af1n2cZHhMZumNqKgw9sfCNoTWu9de4NDn");
+        input.set_query_address("ANDfjwrUroaVtvBguDtrWKRMyxFwvVwnZD");
+        input.set_amount(i * 1000);
+        input.set_gas_price(500);
+        input.set_gas_limit(20000);
+        input.set_nonce(static_cast<uint32_t>(i));
+        return input;
+    }, {21});
+}
@@ -49,3 +49,32 @@ TEST(PolkadotAddress, FromString) {
     auto address = Address("15KRsCq9LLNmCxNFhGk55s5bEyazKefunDxUH24GFZwsTxyu");
     ASSERT_EQ(address.string(), "15KRsCq9LLNmCxNFhGk55s5bEyazKefunDxUH24GFZwsTxyu");
 }
+
+TEST(PolkadotAddress, ValidateBatch) {
+    // more than one chunk of checksums, some corrupted, some of another network
+    std::vector<std::string> addresses;
+    for (byte i = 0; i < 130; ++i) {
+        auto address = Address(PublicKey(Data(32, i), TWPublicKeyTypeED25519)).string();
+        if (i % 3 == 1) {
+            address[10] = address[10] == 'a' ? 'b' : 'a';
+        }
+        addresses.push_back(address);
+    }
+    addresses.push_back("FHKAe66mnbk8ke8zVWE9hFVFrJN1mprFPVmD5rrevotkcDZ");
+    addresses.push_back("");
+    const auto valid = SS58Address::isValid(addresses, TWSS58AddressTypePolkadot);
+    ASSERT_EQ(valid.size(), addresses.size());
+    for (size_t i = 0; i < addresses.size(); ++i) {
+        EXPECT_EQ(valid[i], Address::isValid(addresses[i])) << addresses[i];
+        EXPECT_EQ(valid[i], i < 130 && i % 3 != 1) << addresses[i];
+    }
+    EXPECT_TRUE(SS58Address::isValid(std::vector<std::string>(), TWSS58AddressTypePolkadot).empty());
+}
+
+TEST(PolkadotAddress, Checksum) {
+    const auto address = Address("15KRsCq9LLNmCxNFhGk55s5bEyazKefunDxUH24GFZwsTxyu");
+    auto prefixed = Data(SS58Prefix.begin(), SS58Prefix.end());
+    append(prefixed, Data(address.bytes.begin(), address.bytes.end()));
+    const auto hash = Hash::blake2b(prefixed, 64);
+    EXPECT_EQ(hex(SS58Address::computeChecksum(address.bytes)), hex(Data(hash.begin(), hash.begin() + 2)));
+}
@@ -76,3 +76,63 @@ TEST(PolkadotCodec, EncodeEra) {
     ASSERT_EQ(hex(era1), "7200");
     ASSERT_EQ(hex(era2), "1100");
 }
+
+TEST(PolkadotCodec, CompactSize) {
+    for (const auto value : {0ull, 63ull, 64ull, 16383ull, 16384ull, 1073741823ull, 1073741824ull, 4294967296ull, 18446744073709551615ull}) {
+        EXPECT_EQ(compactSize(value), encodeCompact(value).size()) << value;
+        EXPECT_EQ(compactSize(CompactInteger(value)), encodeCompact(value).size()) << value;
+    }
+    const auto big = CompactInteger(1) << 100;
+    EXPECT_EQ(hex(encodeCompact(big)), "27" "00000000000000000000000010");
+    EXPECT_EQ(compactSize(big), 14ul);
+    EXPECT_EQ(compactSize(CompactInteger(1) << 536), 0ul);
+    EXPECT_EQ(hex(encodeCompact(CompactInteger(1) << 536)), "");
+}
+
+TEST(PolkadotCodec, ScaleWriter) {
+    Data data;
+    auto writer = ScaleWriter(data, 16);
+    writer.writeCompact(12345);
+    writer.writeByte(0x01);
+    writer.write32LE(5);
+    writer.writeAccountId(parse_hex("8eaf"), false);
+    writer.writeBytes(parse_hex("abcd"));
+    EXPECT_EQ(hex(data), "e5c0" "01" "05000000" "008eaf" "abcd");
+    EXPECT_GE(data.capacity(), 16ul);
+}
+
+TEST(PolkadotCodec, ScaleReader) {
+    const auto data = parse_hex("e5c0" "0300000040" "130000000000000001" "27" "00000000000000000000000010" "05000000" "abcd");
+    auto reader = ScaleReader(data);
+    uint64_t value;
+    CompactInteger big;
+    uint32_t v32;
+    DataView bytes;
+    ASSERT_TRUE(reader.readCompact(value));
+    EXPECT_EQ(value, 12345ul);
+    ASSERT_TRUE(reader.readCompact(value));
+    EXPECT_EQ(value, 1073741824ul);
+    ASSERT_TRUE(reader.readCompact(value));
+    EXPECT_EQ(value, 72057594037927936ul);
+    // doesn't fit in 64 bits
+    EXPECT_FALSE(reader.readCompact(value));
+    ASSERT_TRUE(reader.readCompact(big));
+    EXPECT_EQ(big, CompactInteger(1) << 100);
+    ASSERT_TRUE(reader.read32LE(v32));
+    EXPECT_EQ(v32, 5u);
+    EXPECT_FALSE(reader.readBytes(3, bytes));
+    ASSERT_TRUE(reader.readBytes(2, bytes));
+    EXPECT_EQ(hex(bytes.toData()), "abcd");
+    EXPECT_EQ(bytes.data(), data.data() + data.size() - 2);
+    EXPECT_EQ(reader.remaining(), 0ul);
+    byte b;
+    EXPECT_FALSE(reader.readByte(b));
+    EXPECT_FALSE(reader.readCompact(big));
+
+    for (const auto value : {0ull, 63ull, 64ull, 16383ull, 16384ull, 1073741823ull, 1073741824ull, 18446744073709551615ull}) {
+        const auto encoded = encodeCompact(value);
+        uint64_t decoded;
+        ASSERT_TRUE(ScaleReader(encoded).readCompact(decoded)) << value;
+        EXPECT_EQ(decoded, value);
+    }
+}
@@ -8,6 +8,7 @@
 #include "Polkadot/Extrinsic.h"
 #include "Polkadot/Address.h"
 #include "SS58Address.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
@@ -65,6 +66,24 @@ TEST(PolkadotSigner, SignTransfer_9fd062) {
     EXPECT_EQ(hex(output.encoded()), "3502849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f7830073e59cef381aedf56d7af076bafff9857ffc1e3bd7d1d7484176ff5b58b73f1211a518e1ed1fd2ea201bd31869c0798bba4ffe753998c409d098b65d25dff801a5030c0005007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
 }
 
+TEST(PolkadotSigner, DecodeSigned) {
+    const auto encoded = parse_hex("3502849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f7830073e59cef381aedf56d7af076bafff9857ffc1e3bd7d1d7484176ff5b58b73f1211a518e1ed1fd2ea201bd31869c0798bba4ffe753998c409d098b65d25dff801a5030c0005007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
+    auto view = SignedExtrinsicView();
+    ASSERT_TRUE(Extrinsic::decodeSigned(encoded, true, view));
+    EXPECT_EQ(hex(view.signer.toData()), hex(privateKeyThrow2.getPublicKey(TWPublicKeyTypeED25519).bytes));
+    EXPECT_EQ(view.signatureType, 0);
+    EXPECT_EQ(hex(view.signature.toData()), "73e59cef381aedf56d7af076bafff9857ffc1e3bd7d1d7484176ff5b58b73f1211a518e1ed1fd2ea201bd31869c0798bba4ffe753998c409d098b65d25dff801");
+    EXPECT_EQ(hex(view.era.toData()), "a503");
+    EXPECT_EQ(view.nonce, 3ul);
+    EXPECT_EQ(view.tip, 0);
+    EXPECT_EQ(hex(view.call.toData()), "05007120f76076bcb0efdf94c7219e116899d0163ea61cb428183d71324eb33b2bce0300943577");
+
+    // MultiAddress signer expected
+    EXPECT_FALSE(Extrinsic::decodeSigned(encoded, false, view));
+    // truncated
+    EXPECT_FALSE(Extrinsic::decodeSigned(DataView(encoded.data(), encoded.size() - 1), true, view));
+}
+
 TEST(PolkadotSigner, SignTransferDOT) {
 
     auto blockHash = parse_hex("0x343a3f4258fd92f5ca6ca5abdf473d86a78b0bcd0dc09c568ca594245cc8c642");
@@ -309,4 +328,49 @@ TEST(PolkadotSigner, SignUnbond_070957) {
     ASSERT_EQ(hex(output.encoded()), "b501849dca538b7a925b8ea979cc546464a3c5f81d2398a3a272f6f93bdf4803f2f783003a762d9dc3f2aba8922c4babf7e6622ca1d74da17ab3f152d8f29b0ffee53c7e5e150915912a9dfd98ef115d272e096543eef9f513207dd606eea97d023a64087503080007020300286bee");
 }
 
+TEST(PolkadotSigner, SignBatch) {
+    auto blockHash = parse_hex("0x211787d016e39007ac054547737a10542620013e73648b3134541d536cb44e2c");
+    std::vector<Proto::SigningInput> inputs;
+    for (auto i = 0; i < 12; ++i) {
+        auto input = Proto::SigningInput();
+        input.set_genesis_hash(genesisHash.data(), genesisHash.size());
+        input.set_block_hash(blockHash.data(), blockHash.size());
+        input.set_nonce(i);
+        // the suffix changes in the middle
+        input.set_spec_version(i < 8 ? 26 : 28);
+        input.set_private_key(privateKeyThrow2.bytes.data(), privateKeyThrow2.bytes.size());
+        input.set_network(Proto::Network::POLKADOT);
+        input.set_transaction_version(5);
+        input.mutable_era()->set_block_number(3540945);
+        input.mutable_era()->set_period(64);
+        if (i % 2 == 0) {
+            auto& transfer = *input.mutable_balance_call()->mutable_transfer();
+            auto value = store(uint256_t(2000000000 + i));
+            transfer.set_to_address("13ZLCqJNPsRZYEbwjtZZFpWt9GyFzg5WahXCVWKpWdUJqrQ5");
+            transfer.set_value(value.data(), value.size());
+        } else {
+            // long enough to be hashed
+            auto& nominate = *input.mutable_staking_call()->mutable_nominate();
+            for (auto j = 0; j < i; ++j) {
+                nominate.add_nominators(controller1);
+            }
+        }
+        inputs.push_back(input);
+    }
+
+    const auto outputs = Signer::signBatch(inputs, 3);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        EXPECT_EQ(hex(outputs[i].encoded()), hex(Signer::sign(inputs[i]).encoded())) << i;
+    }
+    EXPECT_TRUE(Signer::signBatch({}).empty());
+
+    // incremental hashing
+    const auto extrinsic = Extrinsic(inputs[11]);
+    const auto payload = extrinsic.encodePayload();
+    ASSERT_GT(payload.size(), 256ul);
+    EXPECT_EQ(hex(extrinsic.encodePayload(extrinsic.encodePayloadSuffix(), 256)), hex(Hash::blake2b(payload, 32)));
+    EXPECT_EQ(hex(extrinsic.encodePayload(extrinsic.encodePayloadSuffix(), payload.size())), hex(payload));
+}
+
 } // namespace
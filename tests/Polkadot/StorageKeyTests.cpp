@@ -0,0 +1,54 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "HexCoding.h"
+#include "Polkadot/Address.h"
+#include "Polkadot/StorageKey.h"
+#include "PublicKey.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace TW;
+using namespace TW::Polkadot;
+
+namespace {
+
+const auto alice = parse_hex("d43593c715fdd31c61141abd04a99fd6822c8558854ccde39a5684e7a56da27d");
+const auto bob = parse_hex("8eaf04151687736326c9fea17e25fc5287613693c912909cb226aa4794f26a48");
+
+} // namespace
+
+TEST(PolkadotStorageKey, Prefix) {
+    EXPECT_EQ(hex(StorageKey::twox128("System")), "26aa394eea5630e07c48ae0c9558cef7");
+    EXPECT_EQ(hex(StorageKey("System", "Account").prefix()),
+              "26aa394eea5630e07c48ae0c9558cef7b99d880ec681799c0cf30e8886371da9");
+    EXPECT_EQ(hex(StorageKey("Timestamp", "Now").prefix()),
+              "f0c365c3cf59d671eb72da0e7a4113c49f1f0515f462cdcf84e0f1d6045dfcbb");
+}
+
+TEST(PolkadotStorageKey, Key) {
+    const auto account = StorageKey("System", "Account");
+    EXPECT_EQ(hex(account.key(alice)),
+              "26aa394eea5630e07c48ae0c9558cef7b99d880ec681799c0cf30e8886371da9"
+              "de1e86a9a8c739864cf3cc5ec2bea59f"
+              "d43593c715fdd31c61141abd04a99fd6822c8558854ccde39a5684e7a56da27d");
+    const auto address = Address(PublicKey(alice, TWPublicKeyTypeED25519));
+    EXPECT_EQ(hex(account.key(address)), hex(account.key(alice)));
+}
+
+TEST(PolkadotStorageKey, Keys) {
+    const auto account = StorageKey("System", "Account");
+    auto mapKeys = std::vector<Data>{alice, bob, {}, alice};
+    for (size_t i = 0; i < 20; ++i) {
+        mapKeys.push_back(Data(i * 7, static_cast<byte>(i)));
+    }
+    const auto keys = account.keys(mapKeys);
+    ASSERT_EQ(keys.size(), mapKeys.size());
+    for (size_t i = 0; i < mapKeys.size(); ++i) {
+        EXPECT_EQ(hex(keys[i]), hex(account.key(mapKeys[i])));
+    }
+    EXPECT_TRUE(account.keys({}).empty());
+}
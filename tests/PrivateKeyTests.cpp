@@ -9,6 +9,10 @@
 #include "HexCoding.h"
 #include "Hash.h"
 
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/secp256k1.h>
+
 #include <gtest/gtest.h>
 
 using namespace TW;
@@ -354,3 +358,71 @@ TEST(PrivateKey, SignShortDigest) {
         EXPECT_EQ(actual.size(), 0);
     }
 }
+
+TEST(PrivateKey, SignBatch) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    std::vector<Data> digests;
+    for (auto i = 0; i < 20; ++i) {
+        digests.push_back(Hash::sha256(TW::data("message " + std::to_string(i))));
+    }
+
+    for (auto curve : {TWCurveSECP256k1, TWCurveNIST256p1, TWCurveED25519, TWCurveED25519Blake2bNano, TWCurveCurve25519}) {
+        for (auto threads : {1, 3, 32}) {
+            std::vector<Data> signatures;
+            EXPECT_TRUE(privateKey.signBatch(digests, curve, signatures, threads));
+            ASSERT_EQ(signatures.size(), digests.size());
+            for (size_t i = 0; i < digests.size(); ++i) {
+                EXPECT_EQ(hex(signatures[i]), hex(privateKey.sign(digests[i], curve)));
+            }
+        }
+    }
+
+    // single digest matches the known signature, output buffers are reused
+    std::vector<Data> signatures(1, Data(100));
+    EXPECT_TRUE(privateKey.signBatch({Hash::keccak256(TW::data("hello"))}, TWCurveSECP256k1, signatures));
+    EXPECT_EQ(hex(signatures[0]), "8720a46b5b3963790d94bcc61ad57ca02fd153584315bfa161ed3455e336ba624d68df010ed934b8792c5b6a57ba86c3da31d039f9612b44d1bf054132254de901");
+
+    std::vector<Data> empty;
+    EXPECT_TRUE(privateKey.signBatch({}, TWCurveSECP256k1, empty, 4));
+    EXPECT_EQ(empty.size(), 0);
+}
+
+TEST(PrivateKey, SignWithNonceKeyState) {
+    for (const auto* curve : {&secp256k1, &nist256p1}) {
+        for (int i = 0; i < 8; ++i) {
+            const auto key = Hash::sha256(TW::data("key" + std::to_string(i)));
+            const auto digest = Hash::sha256(TW::data("digest" + std::to_string(i)));
+            rfc6979_key_state keyState;
+            init_rfc6979_key(key.data(), &keyState);
+
+            rfc6979_state expected, actual;
+            init_rfc6979(key.data(), digest.data(), &expected);
+            init_rfc6979_with_key(&keyState, key.data(), digest.data(), &actual);
+            for (int j = 0; j < 3; ++j) {
+                bignum256 k1, k2;
+                generate_k_rfc6979(&k1, &expected);
+                generate_k_rfc6979(&k2, &actual);
+                EXPECT_TRUE(bn_is_equal(&k1, &k2));
+            }
+
+            // retries of the canonical signatures continue the same nonce sequence
+            Data sig1(64), sig2(64);
+            uint8_t by1 = 0, by2 = 0;
+            ASSERT_EQ(ecdsa_sign_digest(curve, key.data(), digest.data(), sig1.data(), &by1, isCanonical), 0);
+            ASSERT_EQ(ecdsa_sign_digest_with_key_state(curve, key.data(), &keyState, digest.data(), sig2.data(), &by2, isCanonical), 0);
+            EXPECT_EQ(hex(sig1), hex(sig2));
+            EXPECT_EQ(by1, by2);
+        }
+    }
+}
+
+TEST(PrivateKey, SignBatchFailure) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const auto digests = std::vector<Data>{Hash::sha256(TW::data("a")), TW::data("12345"), Hash::sha256(TW::data("b"))};
+    std::vector<Data> signatures;
+    EXPECT_FALSE(privateKey.signBatch(digests, TWCurveSECP256k1, signatures, 2));
+    ASSERT_EQ(signatures.size(), 3);
+    EXPECT_EQ(signatures[0].size(), 65);
+    EXPECT_EQ(signatures[1].size(), 0);
+    EXPECT_EQ(signatures[2].size(), 65);
+}
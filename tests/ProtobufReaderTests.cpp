@@ -0,0 +1,73 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ProtobufReader.h"
+#include "HexCoding.h"
+#include "proto/Ethereum.pb.h"
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+TEST(ProtobufReader, Fields) {
+    Ethereum::Proto::SigningInput input;
+    input.set_to_address("0x6b175474e89094c44da98b954eedeac495271d0f");
+    input.mutable_transaction()->mutable_contract_generic()->set_data("\x01\x02\x03");
+    const auto serialized = data(input.SerializeAsString());
+
+    auto reader = ProtobufReader(serialized);
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.field(), 5u);
+    EXPECT_EQ(reader.wireType(), ProtobufReader::lengthDelimited);
+    EXPECT_EQ(std::string(reader.bytes().begin(), reader.bytes().end()), input.to_address());
+    EXPECT_EQ(reader.bytes().data(), serialized.data() + 2);
+    ASSERT_TRUE(reader.next());
+    EXPECT_EQ(reader.field(), 7u);
+    EXPECT_EQ(reader.raw().size(), 2 + input.transaction().ByteSizeLong());
+    EXPECT_FALSE(reader.next());
+    EXPECT_FALSE(reader.failed());
+
+    const auto varintField = parse_hex("08ac02");
+    auto varint = ProtobufReader(varintField);
+    ASSERT_TRUE(varint.next());
+    EXPECT_EQ(varint.varint(), 300u);
+
+    // a length beyond the input
+    const auto truncated = Data(serialized.begin(), serialized.end() - 1);
+    auto failing = ProtobufReader(truncated);
+    EXPECT_TRUE(failing.next());
+    EXPECT_FALSE(failing.next());
+    EXPECT_TRUE(failing.failed());
+}
+
+TEST(ProtobufReader, FindAndWithout) {
+    Ethereum::Proto::SigningInput input;
+    input.set_nonce("\x05");
+    input.set_to_address("0x6b175474e89094c44da98b954eedeac495271d0f");
+    auto& call = *input.mutable_transaction()->mutable_contract_generic();
+    call.set_amount("\x10");
+    call.set_data(std::string(300, '\x2a'));
+    const auto serialized = data(input.SerializeAsString());
+    const auto path = std::array<uint32_t, 3>{7, 6, 2};
+
+    DataView payload;
+    ASSERT_TRUE(ProtobufReader::find(serialized, path, payload));
+    EXPECT_EQ(std::string(payload.begin(), payload.end()), call.data());
+    EXPECT_GE(payload.data(), serialized.data());
+    EXPECT_FALSE(ProtobufReader::find(serialized, std::array<uint32_t, 3>{7, 1, 2}, payload));
+    EXPECT_FALSE(ProtobufReader::find(serialized, std::array<uint32_t, 2>{7, 9}, payload));
+
+    auto expected = input;
+    expected.mutable_transaction()->mutable_contract_generic()->clear_data();
+    EXPECT_EQ(hex(ProtobufReader::without(serialized, path)), hex(expected.SerializeAsString()));
+
+    // a repeated field of the path is merged by the parser
+    auto repeated = serialized;
+    append(repeated, data(input.SerializeAsString()));
+    EXPECT_FALSE(ProtobufReader::find(repeated, path, payload));
+}
+
+} // namespace TW
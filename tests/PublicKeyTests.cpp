@@ -190,6 +190,50 @@ TEST(PublicKeyTests, Verify) {
     }
 }
 
+TEST(PublicKeyTests, VerifyBatch) {
+    auto publicKeys = std::vector<PublicKey>();
+    auto messages = std::vector<Data>();
+    auto signatures = std::vector<Data>();
+    for (auto i = 0; i < 21; ++i) {
+        auto privateKey = PrivateKey(Hash::sha256(TW::data("batch key " + std::to_string(i))));
+        auto message = TW::data(std::string(i * 7, 'a') + std::to_string(i));
+        if (i % 5 == 3) {
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeED25519Blake2b));
+            signatures.push_back(privateKey.sign(message, TWCurveED25519Blake2bNano));
+        } else if (i % 5 == 4) {
+            message = Hash::sha256(message);
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1));
+            signatures.push_back(privateKey.sign(message, TWCurveSECP256k1));
+        } else {
+            publicKeys.push_back(privateKey.getPublicKey(TWPublicKeyTypeED25519));
+            signatures.push_back(privateKey.sign(message, TWCurveED25519));
+        }
+        messages.push_back(message);
+    }
+
+    auto valid = std::vector<bool>();
+    EXPECT_TRUE(PublicKey::verifyBatch(publicKeys, messages, signatures, valid));
+    EXPECT_EQ(valid, std::vector<bool>(publicKeys.size(), true));
+
+    // forged signatures, wrong message, truncated signature
+    signatures[2][40] ^= 1;
+    signatures[8][0] ^= 0x80;
+    messages[16].push_back(0);
+    signatures[10].pop_back();
+    EXPECT_FALSE(PublicKey::verifyBatch(publicKeys, messages, signatures, valid));
+    ASSERT_EQ(valid.size(), publicKeys.size());
+    for (size_t i = 0; i < publicKeys.size(); ++i) {
+        const auto expected = i != 2 && i != 8 && i != 10 && i != 16;
+        EXPECT_EQ(valid[i], expected) << i;
+        if (i != 10) {
+            EXPECT_EQ(valid[i], publicKeys[i].verify(signatures[i], messages[i])) << i;
+        }
+    }
+
+    EXPECT_TRUE(PublicKey::verifyBatch({}, {}, {}));
+    EXPECT_THROW(PublicKey::verifyBatch(publicKeys, messages, {}), std::invalid_argument);
+}
+
 TEST(PublicKeyTests, VerifyEd25519Extended) {
     const auto key = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
     const auto privateKey = PrivateKey(key);
@@ -239,6 +283,39 @@ TEST(PublicKeyTests, Recover) {
         "0456d8089137b1fd0d890f8c7d4a04d0fd4520a30b19518ee87bd168ea12ed8090329274c4c6c0d9df04515776f2741eeffc30235d596065d718c3973e19711ad0");
 }
 
+TEST(PublicKeyTests, RecoverMany) {
+    std::vector<Data> signatures;
+    std::vector<Data> messages;
+    std::vector<Data> expected;
+    for (int i = 0; i < 20; ++i) {
+        const auto privateKey = PrivateKey(Hash::sha256(Data(1, static_cast<byte>(i))));
+        const auto message = Hash::keccak256(Data(2, static_cast<byte>(i)));
+        signatures.push_back(privateKey.sign(message, TWCurveSECP256k1));
+        messages.push_back(message);
+        expected.push_back(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes.toData());
+    }
+    signatures[3][64] += 27;
+    // r = 0
+    std::fill(signatures[5].begin(), signatures[5].begin() + 32, 0);
+    signatures[7].resize(64);
+
+    for (size_t threadCount : {1, 4}) {
+        const auto recovered = PublicKey::recoverMany(signatures, messages, threadCount);
+        ASSERT_EQ(recovered.size(), signatures.size());
+        for (size_t i = 0; i < recovered.size(); ++i) {
+            if (i == 5 || i == 7) {
+                EXPECT_FALSE(recovered[i].has_value()) << i;
+                continue;
+            }
+            ASSERT_TRUE(recovered[i].has_value()) << i;
+            EXPECT_EQ(hex(recovered[i]->bytes), hex(expected[i])) << i;
+            EXPECT_EQ(hex(PublicKey::recover(signatures[i], messages[i]).bytes), hex(expected[i])) << i;
+        }
+    }
+    EXPECT_TRUE(PublicKey::recoverMany({}, {}).empty());
+    EXPECT_THROW(PublicKey::recoverMany(signatures, {}), std::invalid_argument);
+}
+
 TEST(PublicKeyTests, isValidED25519) {
     EXPECT_TRUE(PublicKey::isValid(parse_hex("beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519));
     EXPECT_TRUE(PublicKey(parse_hex("beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519).isValidED25519());
@@ -258,3 +335,16 @@ TEST(PublicKeyTests, isValidED25519) {
     EXPECT_FALSE(PublicKey::isValid(parse_hex("0101beff0e5d6f6e6e6d573d3044f3e2bfb353400375dc281da3337468d4aa527908"), TWPublicKeyTypeED25519));
     EXPECT_FALSE(PublicKey(parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1"), TWPublicKeyTypeSECP256k1).isValidED25519());
 }
+
+TEST(PublicKeyTests, SizePerType) {
+    static_assert(PublicKey::size(TWPublicKeyTypeSECP256k1) == 33);
+    static_assert(PublicKey::size(TWPublicKeyTypeNIST256p1Extended) == 65);
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    for (const auto type : {TWPublicKeyTypeSECP256k1, TWPublicKeyTypeSECP256k1Extended, TWPublicKeyTypeNIST256p1,
+                            TWPublicKeyTypeNIST256p1Extended, TWPublicKeyTypeED25519, TWPublicKeyTypeED25519Blake2b,
+                            TWPublicKeyTypeCURVE25519}) {
+        const auto publicKey = privateKey.getPublicKey(type);
+        EXPECT_EQ(publicKey.bytes.size(), PublicKey::size(type));
+        EXPECT_LE(publicKey.bytes.size(), PublicKey::maxSize);
+    }
+}
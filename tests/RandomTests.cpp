@@ -0,0 +1,138 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Data.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/rand.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace TW {
+
+namespace {
+
+Data randomData(size_t size) {
+    Data result(size);
+    random_buffer(result.data(), result.size());
+    return result;
+}
+
+/// Counts calls, fills with a constant byte
+struct TestSource {
+    std::atomic<int> calls{0};
+    byte value = 0x42;
+
+    static int fill(void* context, uint8_t* buf, size_t len) {
+        auto* source = static_cast<TestSource*>(context);
+        ++source->calls;
+        std::memset(buf, source->value, len);
+        return 0;
+    }
+};
+
+/// Sets a test source for the duration of a test
+struct ScopedSource {
+    explicit ScopedSource(TestSource& source) { random_set_source(&TestSource::fill, &source); }
+    ~ScopedSource() { random_set_source(nullptr, nullptr); }
+};
+
+} // namespace
+
+TEST(Random, Distinct) {
+    std::set<Data> values;
+    for (int i = 0; i < 1000; ++i) {
+        values.insert(randomData(16));
+    }
+    EXPECT_EQ(values.size(), 1000ul);
+
+    // across refills of the generator
+    const auto large = randomData(100000);
+    EXPECT_NE(Data(large.begin(), large.begin() + 32), Data(large.end() - 32, large.end()));
+}
+
+TEST(Random, SourceSeedsGenerators) {
+    TestSource source;
+    ScopedSource scoped(source);
+
+    // same seed, same output: the source is what generators are seeded with
+    const auto first = randomData(64);
+    Data second;
+    std::thread([&]() { second = randomData(64); }).join();
+    EXPECT_EQ(hex(first), hex(second));
+    EXPECT_EQ(source.calls, 2);
+
+    // seeded once per thread
+    randomData(1000);
+    EXPECT_EQ(source.calls, 2);
+
+    random_reseed();
+    const auto reseeded = randomData(64);
+    EXPECT_EQ(source.calls, 3);
+    EXPECT_EQ(hex(reseeded), hex(first));
+
+    source.value = 0x43;
+    random_reseed();
+    EXPECT_NE(hex(randomData(64)), hex(first));
+}
+
+TEST(Random, ReseedInterval) {
+    TestSource source;
+    ScopedSource scoped(source);
+    randomData(1);
+    EXPECT_EQ(source.calls, 1);
+    for (int i = 0; i < 64; ++i) {
+        randomData(32 * 1024);
+    }
+    // 2 MiB: reseeded every MiB
+    EXPECT_GE(source.calls, 2);
+    EXPECT_LE(source.calls, 3);
+}
+
+TEST(Random, ThreadsDiffer) {
+    const size_t threadCount = 8;
+    std::vector<Data> values(threadCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < threadCount; ++i) {
+        threads.emplace_back([&values, i]() { values[i] = randomData(32); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(std::set<Data>(values.begin(), values.end()).size(), threadCount);
+}
+
+TEST(Random, ForkReseeds) {
+    // seeded before the fork
+    randomData(32);
+
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    const auto pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        const auto child = randomData(32);
+        _exit(write(fds[1], child.data(), child.size()) == static_cast<ssize_t>(child.size()) ? 0 : 1);
+    }
+    const auto parent = randomData(32);
+    Data child(32);
+    EXPECT_EQ(read(fds[0], child.data(), child.size()), static_cast<ssize_t>(child.size()));
+    int status = 0;
+    waitpid(pid, &status, 0);
+    close(fds[0]);
+    close(fds[1]);
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_NE(hex(parent), hex(child));
+}
+
+} // namespace TW
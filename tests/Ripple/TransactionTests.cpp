@@ -7,6 +7,7 @@
 #include "Ripple/Address.h"
 #include "Ripple/Transaction.h"
 #include "Ripple/BinaryCoding.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 #include "PublicKey.h"
@@ -124,3 +125,24 @@ TEST(RippleTransaction, preImage) {
     );
     ASSERT_EQ(unsignedTx.size(), 114);
 }
+
+TEST(RippleTransaction, signingHash) {
+    auto tx = Transaction(
+        /* amount */1000,
+        /* fee */10,
+        /* flags */2147483648,
+        /* sequence */1,
+        /* last_ledger_sequence */0,
+        /* account */Address("r9LqNeG6qHxjeUocjvVki2XR35weJ9mZgQ"),
+        /* destination */"rHb9CJAWyB4rj91VRWn96DkukG4bwdtyTh",
+        /* destination_tag*/0
+    );
+    tx.pub_key = parse_hex("ed5f5ac8b98974a3ca843326d9b88cebd0560177b973ee0b149f782cfaa06dc66a");
+
+    const auto hash = Hash::sha512(tx.getPreImage());
+    ASSERT_EQ(hex(tx.signingHash()), hex(Data(hash.begin(), hash.begin() + 32)));
+
+    auto serialized = Data{0xff};
+    tx.serialize(serialized);
+    ASSERT_EQ(hex(serialized), "ff" + hex(tx.serialize()));
+}
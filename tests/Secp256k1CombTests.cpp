@@ -0,0 +1,190 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Secp256k1Comb.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+
+#include <TrezorCrypto/ecdsa.h>
+#include <TrezorCrypto/rand.h>
+#include <TrezorCrypto/secp256k1.h>
+#include <TrezorCrypto/secp256k1_comb.h>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include <unistd.h>
+
+namespace TW {
+
+namespace {
+
+Data referencePublicKey(const Data& privateKey, bool compressed) {
+    Data result(compressed ? 33 : 65);
+    if (compressed) {
+        ecdsa_get_public_key33(&secp256k1, privateKey.data(), result.data());
+    } else {
+        ecdsa_get_public_key65(&secp256k1, privateKey.data(), result.data());
+    }
+    return result;
+}
+
+std::vector<Data> testKeys() {
+    std::vector<Data> keys = {
+        parse_hex("0000000000000000000000000000000000000000000000000000000000000001"),
+        parse_hex("0000000000000000000000000000000000000000000000000000000000000002"),
+        parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364140"),
+        parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd036413f"),
+        parse_hex("8000000000000000000000000000000000000000000000000000000000000000"),
+        parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"),
+    };
+    for (int i = 0; i < 20; ++i) {
+        Data key(32);
+        random_buffer(key.data(), key.size());
+        keys.push_back(key);
+    }
+    return keys;
+}
+
+} // namespace
+
+TEST(Secp256k1Comb, MatchesTrezor) {
+    if (!secp256k1_comb_supported()) {
+        GTEST_SKIP();
+    }
+    const auto keys = testKeys();
+    for (int window = SECP256K1_COMB_MIN_WINDOW; window <= SECP256K1_COMB_MAX_WINDOW; ++window) {
+        Secp256k1Comb::setWindow(window);
+        EXPECT_EQ(Secp256k1Comb::window(), window);
+        for (const auto& key : keys) {
+            if (!PrivateKey::isValid(key, TWCurveSECP256k1)) {
+                continue;
+            }
+            const auto compressed = Secp256k1Comb::publicKey(key, true);
+            const auto extended = Secp256k1Comb::publicKey(key, false);
+            ASSERT_TRUE(compressed);
+            ASSERT_TRUE(extended);
+            EXPECT_EQ(hex(*compressed), hex(referencePublicKey(key, true))) << "window " << window << " key " << hex(key);
+            EXPECT_EQ(hex(*extended), hex(referencePublicKey(key, false))) << "window " << window << " key " << hex(key);
+        }
+    }
+    Secp256k1Comb::setWindow(Secp256k1Comb::defaultWindow);
+}
+
+TEST(Secp256k1Comb, Batch) {
+    if (!secp256k1_comb_supported()) {
+        GTEST_SKIP();
+    }
+    // more than a batch of 32 keys
+    auto keys = testKeys();
+    const auto more = testKeys();
+    keys.insert(keys.end(), more.begin(), more.end());
+    Data privateKeys;
+    for (const auto& key : keys) {
+        append(privateKeys, key);
+    }
+    for (auto compressed : {true, false}) {
+        const auto size = compressed ? 33 : 65;
+        Data output(keys.size() * size);
+        ASSERT_TRUE(Secp256k1Comb::publicKeys(privateKeys.data(), keys.size(), compressed, output.data()));
+        for (size_t i = 0; i < keys.size(); ++i) {
+            EXPECT_EQ(hex(output.begin() + i * size, output.begin() + (i + 1) * size), hex(referencePublicKey(keys[i], compressed))) << i;
+        }
+    }
+
+    // an invalid key in the middle of a batch
+    std::fill(privateKeys.begin() + 3 * 32, privateKeys.begin() + 4 * 32, 0);
+    Data output(keys.size() * 33);
+    EXPECT_FALSE(Secp256k1Comb::publicKeys(privateKeys.data(), keys.size(), true, output.data()));
+    EXPECT_EQ(hex(output.begin() + 3 * 33, output.begin() + 4 * 33), hex(Data(33)));
+    EXPECT_EQ(hex(output.begin() + 4 * 33, output.begin() + 5 * 33), hex(referencePublicKey(keys[4], true)));
+    EXPECT_EQ(hex(output.begin() + 40 * 33, output.begin() + 41 * 33), hex(referencePublicKey(keys[40], true)));
+
+    EXPECT_TRUE(Secp256k1Comb::publicKeys(nullptr, 0, true, nullptr));
+}
+
+TEST(Secp256k1Comb, TableSize) {
+    if (!secp256k1_comb_supported()) {
+        GTEST_SKIP();
+    }
+    EXPECT_EQ(secp256k1_comb_table_size(2), 16384);
+    EXPECT_EQ(secp256k1_comb_table_size(4), 32768);
+    EXPECT_EQ(secp256k1_comb_table_size(6), 88064);
+    EXPECT_EQ(secp256k1_comb_table_size(8), 262144);
+    EXPECT_EQ(secp256k1_comb_table_size(1), 0);
+    EXPECT_EQ(secp256k1_comb_table_size(9), 0);
+    EXPECT_EQ(Secp256k1Comb::tableSize(), secp256k1_comb_table_size(Secp256k1Comb::defaultWindow));
+}
+
+TEST(Secp256k1Comb, InvalidKeys) {
+    EXPECT_FALSE(Secp256k1Comb::publicKey(parse_hex("0000000000000000000000000000000000000000000000000000000000000000"), true));
+    EXPECT_FALSE(Secp256k1Comb::publicKey(parse_hex("fffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141"), true));
+    EXPECT_FALSE(Secp256k1Comb::publicKey(parse_hex("ffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffffff"), false));
+    EXPECT_FALSE(Secp256k1Comb::publicKey(parse_hex("deadbeef"), true));
+}
+
+TEST(Secp256k1Comb, Disabled) {
+    const auto key = parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+    const auto expected = PrivateKey(key).getPublicKey(TWPublicKeyTypeSECP256k1);
+
+    Secp256k1Comb::setWindow(0);
+    EXPECT_EQ(Secp256k1Comb::window(), 0);
+    EXPECT_EQ(Secp256k1Comb::tableSize(), 0);
+    EXPECT_FALSE(Secp256k1Comb::publicKey(key, true));
+    EXPECT_EQ(hex(PrivateKey(key).getPublicKey(TWPublicKeyTypeSECP256k1).bytes), hex(expected.bytes));
+    EXPECT_EQ(hex(expected.bytes), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
+
+    Secp256k1Comb::setWindow(Secp256k1Comb::defaultWindow);
+    EXPECT_EQ(Secp256k1Comb::window(), Secp256k1Comb::defaultWindow);
+}
+
+TEST(Secp256k1Comb, MappedTable) {
+    if (!secp256k1_comb_supported()) {
+        GTEST_SKIP();
+    }
+    char path[] = "/tmp/Secp256k1CombTestsXXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    Secp256k1Comb::writeTable(path, 8);
+    EXPECT_EQ(std::ifstream(path, std::ios::binary | std::ios::ate).tellg(), 64 + secp256k1_comb_table_size(8));
+
+    ASSERT_TRUE(Secp256k1Comb::mapTable(path));
+    EXPECT_TRUE(Secp256k1Comb::isMapped());
+    EXPECT_EQ(Secp256k1Comb::window(), 8);
+    Secp256k1Comb::prefault(false);
+    for (const auto& key : testKeys()) {
+        EXPECT_EQ(hex(*Secp256k1Comb::publicKey(key, true)), hex(referencePublicKey(key, true)));
+        EXPECT_EQ(hex(*Secp256k1Comb::publicKey(key, false)), hex(referencePublicKey(key, false)));
+    }
+
+    // a corrupted table is not used
+    Secp256k1Comb::setWindow(Secp256k1Comb::defaultWindow);
+    EXPECT_FALSE(Secp256k1Comb::isMapped());
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(64 + 1000);
+        file.put('\x5a');
+    }
+    EXPECT_FALSE(Secp256k1Comb::mapTable(path));
+    EXPECT_FALSE(Secp256k1Comb::mapTable(std::string(path) + ".missing"));
+    EXPECT_EQ(Secp256k1Comb::window(), Secp256k1Comb::defaultWindow);
+    EXPECT_FALSE(Secp256k1Comb::isMapped());
+    std::remove(path);
+
+    EXPECT_THROW(Secp256k1Comb::writeTable(path, 9), std::invalid_argument);
+}
+
+TEST(Secp256k1Comb, InvalidWindow) {
+    EXPECT_THROW(Secp256k1Comb::setWindow(1), std::invalid_argument);
+    EXPECT_THROW(Secp256k1Comb::setWindow(9), std::invalid_argument);
+    EXPECT_THROW(Secp256k1Comb::setWindow(-1), std::invalid_argument);
+    EXPECT_EQ(Secp256k1Comb::window(), Secp256k1Comb::defaultWindow);
+}
+
+} // namespace TW
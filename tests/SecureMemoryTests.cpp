@@ -0,0 +1,87 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SecureMemory.h"
+#include "HDWallet.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+
+using namespace TW;
+
+TEST(SecureArena, SlotsAreReusedAndWiped) {
+    SecureArena arena(2);
+    EXPECT_EQ(arena.slotsInUse(), 0);
+
+    auto* first = static_cast<byte*>(arena.allocate(20));
+    EXPECT_TRUE(arena.owns(first));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(first) % 32, 0);
+    std::fill(first, first + 32, 0xab);
+    EXPECT_EQ(arena.slotsInUse(), 1);
+
+    arena.deallocate(first, 20);
+    EXPECT_EQ(arena.slotsInUse(), 0);
+    // the whole slot is wiped, the memory stays mapped
+    EXPECT_TRUE(std::all_of(first, first + 32, [](byte b) { return b == 0; }));
+
+    auto* second = static_cast<byte*>(arena.allocate(32));
+    EXPECT_EQ(second, first);
+    arena.deallocate(second, 32);
+}
+
+TEST(SecureArena, FallsBackToLargerSlotsAndHeap) {
+    SecureArena arena(1);
+    auto* small = arena.allocate(16);
+    auto* next = arena.allocate(16);
+    EXPECT_TRUE(arena.owns(small));
+    EXPECT_TRUE(arena.owns(next));
+    EXPECT_NE(small, next);
+
+    auto* large = arena.allocate(SecureArena::slotSizes.back() + 1);
+    EXPECT_FALSE(arena.owns(large));
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large) % 32, 0);
+    EXPECT_EQ(arena.heapInUse(), 1);
+    EXPECT_EQ(arena.slotsInUse(), 2);
+
+    arena.deallocate(large, SecureArena::slotSizes.back() + 1);
+    arena.deallocate(next, 16);
+    arena.deallocate(small, 16);
+    EXPECT_EQ(arena.heapInUse(), 0);
+    EXPECT_EQ(arena.slotsInUse(), 0);
+
+    for (std::size_t i = 0; i < SecureArena::slotSizes.size(); ++i) {
+        arena.allocate(1);
+    }
+    auto* heap = arena.allocate(1);
+    EXPECT_FALSE(arena.owns(heap));
+    arena.deallocate(heap, 1);
+}
+
+TEST(SecureArena, Containers) {
+    auto& arena = SecureArena::shared();
+    const auto slots = arena.slotsInUse();
+    {
+        SecureData data(32, 1);
+        EXPECT_TRUE(arena.owns(data.data()));
+        SecureString string(100, 'x');
+        EXPECT_TRUE(arena.owns(string.data()));
+        EXPECT_EQ(arena.slotsInUse(), slots + 2);
+    }
+    EXPECT_EQ(arena.slotsInUse(), slots);
+}
+
+TEST(SecureArena, HDWallet) {
+    const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    EXPECT_EQ(wallet.mnemonic, mnemonic);
+    EXPECT_EQ(wallet.passphrase, "TREZOR");
+
+    const auto& arena = SecureArena::shared();
+    EXPECT_TRUE(arena.owns(wallet.mnemonic.data()));
+    EXPECT_TRUE(arena.owns(wallet.entropy.data()));
+}
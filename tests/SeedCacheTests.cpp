@@ -0,0 +1,106 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SeedCache.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+SeedCache::Seed makeSeed(byte value) {
+    SeedCache::Seed seed;
+    seed.fill(value);
+    return seed;
+}
+
+} // namespace
+
+TEST(SeedCache, FindInsert) {
+    auto cache = SeedCache(16);
+    SeedCache::Seed seed;
+    EXPECT_FALSE(cache.find(mnemonic, "", seed));
+
+    cache.insert(mnemonic, "", makeSeed(1));
+    cache.insert(mnemonic, "TREZOR", makeSeed(2));
+    EXPECT_EQ(cache.size(), 2);
+    ASSERT_TRUE(cache.find(mnemonic, "", seed));
+    EXPECT_EQ(seed, makeSeed(1));
+    ASSERT_TRUE(cache.find(mnemonic, "TREZOR", seed));
+    EXPECT_EQ(seed, makeSeed(2));
+    EXPECT_FALSE(cache.find(mnemonic, "other", seed));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(mnemonic, "", seed));
+}
+
+TEST(SeedCache, Capacity) {
+    auto cache = SeedCache(3);
+    for (int i = 0; i < 20; ++i) {
+        cache.insert(mnemonic, std::to_string(i), makeSeed(byte(i)));
+        EXPECT_LE(cache.size(), 3);
+    }
+    // the most recent entry is always kept
+    SeedCache::Seed seed;
+    ASSERT_TRUE(cache.find(mnemonic, "19", seed));
+    EXPECT_EQ(seed, makeSeed(19));
+
+    cache.setCapacity(0);
+    EXPECT_EQ(cache.size(), 0);
+    cache.insert(mnemonic, "", makeSeed(1));
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(mnemonic, "", seed));
+}
+
+TEST(SeedCache, Concurrent) {
+    auto cache = SeedCache(64);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache]() {
+            SeedCache::Seed seed;
+            for (int i = 0; i < 100; ++i) {
+                const auto passphrase = std::to_string(i % 32);
+                if (cache.find(mnemonic, passphrase, seed)) {
+                    EXPECT_EQ(seed, makeSeed(byte(i % 32)));
+                } else {
+                    cache.insert(mnemonic, passphrase, makeSeed(byte(i % 32)));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(cache.size(), 64);
+}
+
+TEST(SeedCache, HDWallet) {
+    auto& cache = SeedCache::shared();
+    cache.setCapacity(SeedCache::defaultCapacity);
+    const auto wallet = HDWallet(mnemonic, "TREZOR");
+    SeedCache::Seed seed;
+    ASSERT_TRUE(cache.find(mnemonic, "TREZOR", seed));
+    EXPECT_EQ(hex(seed), hex(wallet.seed));
+
+    // cached seed is used
+    EXPECT_EQ(hex(HDWallet(mnemonic, "TREZOR").seed), hex(wallet.seed));
+
+    cache.setCapacity(0);
+    EXPECT_EQ(hex(HDWallet(mnemonic, "TREZOR").seed), hex(wallet.seed));
+    EXPECT_FALSE(cache.find(mnemonic, "TREZOR", seed));
+    cache.setCapacity(SeedCache::defaultCapacity);
+}
+
+} // namespace TW
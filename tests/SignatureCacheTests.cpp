@@ -0,0 +1,140 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SignatureCache.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+const auto digest = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+
+SignatureCache::Key makeKey(const SignatureCache& cache, int i) {
+    return cache.key(SignatureCache::SchemeVerify, TWPublicKeyTypeSECP256k1, parse_hex("02"), Data(64, byte(i)), Data(32, byte(i >> 8)));
+}
+
+} // namespace
+
+TEST(SignatureCache, Key) {
+    const auto cache = SignatureCache(16);
+    const auto key = cache.key(SignatureCache::SchemeVerify, 1, parse_hex("0102"), parse_hex("03"), parse_hex("04"));
+    EXPECT_EQ(hex(key), hex(cache.key(SignatureCache::SchemeVerify, 1, parse_hex("0102"), parse_hex("03"), parse_hex("04"))));
+    // the boundaries of the inputs and the scheme are part of the key
+    EXPECT_NE(hex(key), hex(cache.key(SignatureCache::SchemeVerify, 1, parse_hex("01"), parse_hex("0203"), parse_hex("04"))));
+    EXPECT_NE(hex(key), hex(cache.key(SignatureCache::SchemeVerifySchnorr, 1, parse_hex("0102"), parse_hex("03"), parse_hex("04"))));
+    EXPECT_NE(hex(key), hex(cache.key(SignatureCache::SchemeVerify, 2, parse_hex("0102"), parse_hex("03"), parse_hex("04"))));
+    // salted
+    EXPECT_NE(hex(key), hex(SignatureCache(16).key(SignatureCache::SchemeVerify, 1, parse_hex("0102"), parse_hex("03"), parse_hex("04"))));
+}
+
+TEST(SignatureCache, FindInsert) {
+    auto cache = SignatureCache(16);
+    EXPECT_TRUE(cache.enabled());
+    const auto key = makeKey(cache, 1);
+    EXPECT_FALSE(cache.find(key));
+
+    cache.insert(key);
+    cache.insert(makeKey(cache, 2), parse_hex("04abcd"));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_TRUE(cache.find(key));
+    Data result;
+    ASSERT_TRUE(cache.find(makeKey(cache, 2), &result));
+    EXPECT_EQ(hex(result), "04abcd");
+    EXPECT_FALSE(cache.find(makeKey(cache, 3)));
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(key));
+}
+
+TEST(SignatureCache, Capacity) {
+    auto cache = SignatureCache(100);
+    for (int i = 0; i < 1000; ++i) {
+        cache.insert(makeKey(cache, i));
+        EXPECT_LE(cache.size(), 100);
+    }
+    // the most recent entry is always kept
+    EXPECT_TRUE(cache.find(makeKey(cache, 999)));
+
+    cache.setCapacity(0);
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQ(cache.size(), 0);
+    cache.insert(makeKey(cache, 1));
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_FALSE(cache.find(makeKey(cache, 1)));
+    EXPECT_FALSE(SignatureCache().enabled());
+}
+
+TEST(SignatureCache, Concurrent) {
+    auto cache = SignatureCache(256);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&cache]() {
+            for (int i = 0; i < 500; ++i) {
+                const auto key = makeKey(cache, i % 300);
+                Data result;
+                if (cache.find(key, &result)) {
+                    EXPECT_EQ(result, Data(1, byte(i % 300)));
+                } else {
+                    cache.insert(key, Data(1, byte(i % 300)));
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LE(cache.size(), 256);
+}
+
+TEST(SignatureCache, PublicKey) {
+    auto& cache = SignatureCache::shared();
+    cache.setCapacity(1000);
+    const auto publicKey = privateKey.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto signature = privateKey.sign(digest, TWCurveSECP256k1);
+
+    EXPECT_TRUE(publicKey.verify(signature, digest));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_TRUE(publicKey.verify(signature, digest));
+    EXPECT_EQ(cache.size(), 1);
+    // failures are not cached
+    auto invalid = signature;
+    invalid[10] ^= 1;
+    EXPECT_FALSE(publicKey.verify(invalid, digest));
+    EXPECT_EQ(cache.size(), 1);
+
+    // a cached entry is accepted without verification
+    cache.insert(cache.key(SignatureCache::SchemeVerify, TWPublicKeyTypeSECP256k1, publicKey.bytes, invalid, digest));
+    EXPECT_TRUE(publicKey.verify(invalid, digest));
+    EXPECT_FALSE(publicKey.compressed().extended().verify(invalid, digest));
+
+    const auto recovered = PublicKey::recover(signature, digest);
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_EQ(hex(PublicKey::recover(signature, digest).bytes), hex(recovered.bytes));
+    EXPECT_EQ(hex(recovered.bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes));
+    EXPECT_EQ(cache.size(), 3);
+
+    const auto schnorr = privateKey.signSchnorr(digest, TWCurveSECP256k1);
+    EXPECT_TRUE(publicKey.verifySchnorr(schnorr, digest));
+    EXPECT_TRUE(publicKey.verifySchnorr(schnorr, digest));
+    EXPECT_EQ(cache.size(), 4);
+
+    cache.setCapacity(0);
+    EXPECT_FALSE(publicKey.verify(invalid, digest));
+    EXPECT_TRUE(publicKey.verify(signature, digest));
+    EXPECT_EQ(cache.size(), 0);
+}
+
+} // namespace TW
@@ -0,0 +1,245 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "SignerBackend.h"
+#include "Coin.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "PublicKey.h"
+#include "uint256.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Ethereum.pb.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+const auto bitcoinKey0 = PrivateKey(parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866"));
+const auto bitcoinKey1 = PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9"));
+const auto ethereumKey = PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646"));
+
+void addUtxo(Bitcoin::Proto::SigningInput& input, const std::string& script, const std::string& hash, uint32_t index) {
+    const auto scriptData = parse_hex(script);
+    const auto hashData = parse_hex(hash);
+    auto utxo = input.add_utxo();
+    utxo->set_script(scriptData.data(), scriptData.size());
+    utxo->set_amount(210'000'000);
+    utxo->mutable_out_point()->set_hash(hashData.data(), hashData.size());
+    utxo->mutable_out_point()->set_index(index);
+    utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+}
+
+/// P2PK and P2PKH inputs of the first key, and a P2WPKH input of the second one.
+Bitcoin::Proto::SigningInput bitcoinInput(DataView key0, DataView key1) {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(1);
+    input.set_amount(500'000'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.add_private_key(key0.data(), key0.size());
+    input.add_private_key(key1.data(), key1.size());
+    addUtxo(input, "2103c9f4836b9a4f77fc0d81f7bcb01b7f1b35916864b9476c241ce9fc198bd25432ac",
+            "fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f", 0);
+    addUtxo(input, "76a914b7cd046b6d522a3d61dbcb5235c0e9cc9726545788ac",
+            "fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f", 1);
+    addUtxo(input, "00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1",
+            "ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a", 1);
+    const auto redeemScript = parse_hex("76a9141d0f172a0ecb48aee1be1f2687d2963ae33f71a188ac");
+    (*input.mutable_scripts())["1d0f172a0ecb48aee1be1f2687d2963ae33f71a1"] = std::string(redeemScript.begin(), redeemScript.end());
+    return input;
+}
+
+Data ethereumInput(DataView key) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+Data serialize(const Bitcoin::Proto::SigningInput& input) {
+    const auto serialized = input.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+/// Signature with s in the upper half of the order, as some HSMs return.
+Data highS(const Data& signature) {
+    const auto order = uint256_t("0xfffffffffffffffffffffffffffffffebaaedce6af48a03bbfd25e8cd0364141");
+    auto highS = Data(signature.begin(), signature.begin() + 32);
+    append(highS, store(order - load(Data(signature.begin() + 32, signature.begin() + 64))));
+    return highS;
+}
+
+/// Backend of the local keys, corrupting or denormalizing the signatures.
+class TamperingBackend : public LocalSignerBackend {
+  public:
+    explicit TamperingBackend(bool corrupt) : corrupt(corrupt) {}
+
+    std::future<std::vector<Data>> sign(std::vector<DigestSigningRequest> requests) override {
+        auto signatures = LocalSignerBackend::sign(std::move(requests)).get();
+        for (auto& signature : signatures) {
+            if (corrupt) {
+                signature[10] ^= 1;
+            } else {
+                signature = highS(signature);
+            }
+        }
+        std::promise<std::vector<Data>> result;
+        result.set_value(std::move(signatures));
+        return result.get_future();
+    }
+
+  private:
+    bool corrupt;
+};
+
+} // namespace
+
+TEST(SignerBackend, Bitcoin) {
+    Data expected;
+    anyCoinSign(TWCoinTypeBitcoin, serialize(bitcoinInput(bitcoinKey0.bytes, bitcoinKey1.bytes)), expected);
+    Bitcoin::Proto::SigningOutput expectedOutput;
+    ASSERT_TRUE(expectedOutput.ParseFromArray(expected.data(), static_cast<int>(expected.size())));
+    ASSERT_EQ(expectedOutput.error(), Common::Proto::OK);
+    ASSERT_EQ(expectedOutput.transaction().inputs_size(), 3);
+
+    LocalSignerBackend backend;
+    const auto publicKey0 = backend.addKey(bitcoinKey0, TWPublicKeyTypeSECP256k1);
+    const auto publicKey1 = backend.addKey(bitcoinKey1, TWPublicKeyTypeSECP256k1Extended);
+    const auto input = serialize(bitcoinInput(publicKey0.bytes, publicKey1.compressed().bytes));
+    Data output;
+    {
+        ScopedSignerBackend scope(backend);
+        anyCoinSign(TWCoinTypeBitcoin, input, output);
+    }
+    EXPECT_EQ(hex(output), hex(expected));
+    // the three inputs are signed with one backend request
+    EXPECT_EQ(backend.requestCount(), 1ul);
+
+    // without a backend, the public keys are no keys
+    output.clear();
+    anyCoinSign(TWCoinTypeBitcoin, input, output);
+    Bitcoin::Proto::SigningOutput unsigned_;
+    ASSERT_TRUE(unsigned_.ParseFromArray(output.data(), static_cast<int>(output.size())));
+    EXPECT_NE(unsigned_.error(), Common::Proto::OK);
+}
+
+TEST(SignerBackend, Ethereum) {
+    Data expected;
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(ethereumKey.bytes), expected);
+
+    LocalSignerBackend backend;
+    const auto publicKey = backend.addKey(ethereumKey, TWPublicKeyTypeSECP256k1Extended);
+    Data output;
+    ScopedSignerBackend scope(backend);
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(publicKey.bytes), output);
+    EXPECT_EQ(hex(output), hex(expected));
+    output.clear();
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(publicKey.compressed().bytes), output);
+    EXPECT_EQ(hex(output), hex(expected));
+    EXPECT_EQ(backend.requestCount(), 2ul);
+}
+
+TEST(SignerBackend, HighS) {
+    TamperingBackend backend(false);
+    const auto publicKey = backend.addKey(ethereumKey, TWPublicKeyTypeSECP256k1Extended);
+    Data expected;
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(ethereumKey.bytes), expected);
+    Data output;
+    ScopedSignerBackend scope(backend);
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(publicKey.bytes), output);
+    EXPECT_EQ(hex(output), hex(expected));
+
+    const auto digest = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+    const auto recoverable = ethereumKey.sign(digest, TWCurveSECP256k1);
+    const auto signature = highS(recoverable);
+    EXPECT_EQ(hex(backendRecoverableSignature(publicKey, digest, signature, TWCurveSECP256k1)), hex(recoverable));
+    EXPECT_EQ(hex(backendDERSignature(signature, TWCurveSECP256k1)), hex(ethereumKey.signAsDER(digest, TWCurveSECP256k1)));
+}
+
+TEST(SignerBackend, InvalidSignatures) {
+    TamperingBackend backend(true);
+    const auto publicKey0 = backend.addKey(bitcoinKey0, TWPublicKeyTypeSECP256k1);
+    const auto publicKey1 = backend.addKey(bitcoinKey1, TWPublicKeyTypeSECP256k1);
+    const auto ethereumPublicKey = backend.addKey(ethereumKey, TWPublicKeyTypeSECP256k1Extended);
+    ScopedSignerBackend scope(backend);
+
+    Data output;
+    anyCoinSign(TWCoinTypeBitcoin, serialize(bitcoinInput(publicKey0.bytes, publicKey1.bytes)), output);
+    Bitcoin::Proto::SigningOutput bitcoinOutput;
+    ASSERT_TRUE(bitcoinOutput.ParseFromArray(output.data(), static_cast<int>(output.size())));
+    EXPECT_NE(bitcoinOutput.error(), Common::Proto::OK);
+    EXPECT_EQ(bitcoinOutput.encoded().size(), 0ul);
+
+    output.clear();
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(ethereumPublicKey.bytes), output);
+    Ethereum::Proto::SigningOutput ethereumOutput;
+    ASSERT_TRUE(ethereumOutput.ParseFromArray(output.data(), static_cast<int>(output.size())));
+    EXPECT_EQ(ethereumOutput.encoded().size(), 0ul);
+
+    // keys unknown to the backend
+    LocalSignerBackend empty;
+    ScopedSignerBackend emptyScope(empty);
+    output.clear();
+    anyCoinSign(TWCoinTypeEthereum, ethereumInput(ethereumPublicKey.bytes), output);
+    ASSERT_TRUE(ethereumOutput.ParseFromArray(output.data(), static_cast<int>(output.size())));
+    EXPECT_EQ(ethereumOutput.encoded().size(), 0ul);
+}
+
+TEST(SignerBackend, SigningKey) {
+    LocalSignerBackend backend;
+    const auto secp256k1Key = backend.addKey(ethereumKey, TWPublicKeyTypeSECP256k1);
+    const auto ed25519Key = backend.addKey(bitcoinKey0, TWPublicKeyTypeED25519);
+    const auto digest = parse_hex("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+    auto ed25519Reference = Data{0x01};
+    append(ed25519Reference, ed25519Key.bytes.toData());
+
+    // without a backend, only private keys
+    EXPECT_THROW(SigningKey(secp256k1Key.bytes, TWPublicKeyTypeSECP256k1), std::invalid_argument);
+    EXPECT_FALSE(SigningKey(ethereumKey.bytes, TWPublicKeyTypeSECP256k1).isBackendKey());
+
+    ScopedSignerBackend scope(backend);
+    const auto local = SigningKey(ethereumKey.bytes, TWPublicKeyTypeSECP256k1);
+    EXPECT_FALSE(local.isBackendKey());
+    EXPECT_EQ(hex(local.sign(digest, TWCurveSECP256k1)), hex(ethereumKey.sign(digest, TWCurveSECP256k1)));
+    EXPECT_EQ(backend.requestCount(), 0ul);
+
+    const auto secp256k1 = SigningKey(secp256k1Key.extended().bytes, TWPublicKeyTypeSECP256k1);
+    EXPECT_TRUE(secp256k1.isBackendKey());
+    EXPECT_EQ(hex(secp256k1.getPublicKey(TWPublicKeyTypeSECP256k1).bytes), hex(secp256k1Key.bytes));
+    EXPECT_EQ(hex(secp256k1.getPublicKey(TWPublicKeyTypeSECP256k1Extended).bytes), hex(secp256k1Key.extended().bytes));
+    EXPECT_THROW(secp256k1.getPublicKey(TWPublicKeyTypeNIST256p1), std::invalid_argument);
+    EXPECT_EQ(hex(secp256k1.sign(digest, TWCurveSECP256k1)), hex(ethereumKey.sign(digest, TWCurveSECP256k1)));
+
+    const auto ed25519 = SigningKey(ed25519Reference, TWPublicKeyTypeED25519);
+    EXPECT_TRUE(ed25519.isBackendKey());
+    EXPECT_EQ(hex(ed25519.getPublicKey(TWPublicKeyTypeED25519).bytes), hex(ed25519Key.bytes));
+    EXPECT_EQ(hex(ed25519.sign(digest, TWCurveED25519)), hex(bitcoinKey0.sign(digest, TWCurveED25519)));
+    EXPECT_EQ(backend.requestCount(), 2ul);
+
+    // keys unknown to the backend, and keys of the curves backends don't sign with
+    EXPECT_TRUE(SigningKey(bitcoinKey1.getPublicKey(TWPublicKeyTypeSECP256k1).bytes, TWPublicKeyTypeSECP256k1).sign(digest, TWCurveSECP256k1).empty());
+    EXPECT_THROW(SigningKey(ed25519Reference, TWPublicKeyTypeCURVE25519), std::invalid_argument);
+    EXPECT_THROW(SigningKey(ed25519Reference, TWPublicKeyTypeSECP256k1), std::invalid_argument);
+}
+
+} // namespace TW
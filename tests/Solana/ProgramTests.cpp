@@ -29,6 +29,28 @@ TEST(SolanaTokenProgram, defaultTokenAddress) {
         "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
 }
 
+TEST(SolanaTokenProgram, defaultTokenAddresses) {
+    const Address serumToken = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    const auto mainAddresses = std::vector<Address>{
+        Address("HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp"),
+        Address("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V"),
+        Address("Eg5jqooyG6ySaXKbQUu4Lpvu2SqUPZrNkM4zXs9iUDLJ"),
+        Address("HBYC51YrGFAZ8rM7Sj8e9uqKggpSrDYrinQDZzvMtqQp"),
+    };
+    const auto addresses = TokenProgram::defaultTokenAddresses(mainAddresses, serumToken, 2);
+    ASSERT_EQ(addresses.size(), 4ul);
+    EXPECT_EQ(addresses[0].string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+    EXPECT_EQ(addresses[1].string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    EXPECT_EQ(addresses[2].string(), "ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf");
+    EXPECT_EQ(addresses[3].string(), "6X4X1Ae24mkoWeCEpktevySVG9jzeCufut5vtUW3wFrD");
+    EXPECT_TRUE(TokenProgram::defaultTokenAddresses({}, serumToken).empty());
+
+    // cached
+    for (auto i = 0; i < 2; ++i) {
+        EXPECT_EQ(TokenProgram::defaultTokenAddress(mainAddresses[2], serumToken).string(), "ANVCrmRw7Ww7rTFfMbrjApSPXEEcZpBa6YEiBdf98pAf");
+    }
+}
+
 TEST(SolanaTokenProgram, findProgramAddress) {
     std::vector<Data> seeds = {
         Base58::bitcoin.decode("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V"),
@@ -39,6 +61,22 @@ TEST(SolanaTokenProgram, findProgramAddress) {
     EXPECT_EQ(address.string(), "EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
 }
 
+TEST(SolanaTokenProgram, findProgramAddressOtherProgram) {
+    const auto programId = Address("BPFLoader1111111111111111111111111111111111");
+    std::vector<Data> seeds = {TW::data("Talking"), TW::data("Squirrels")};
+    const auto address = TokenProgram::findProgramAddress(seeds, programId);
+    // first bump seed giving an address off the curve
+    for (int bump = 255; bump >= 0; --bump) {
+        auto bumpSeeds = seeds;
+        bumpSeeds.push_back({static_cast<TW::byte>(bump)});
+        const auto candidate = TokenProgram::createProgramAddress(bumpSeeds, programId);
+        if (!PublicKey(candidate.vector(), TWPublicKeyTypeED25519).isValidED25519()) {
+            EXPECT_EQ(address.string(), candidate.string());
+            break;
+        }
+    }
+}
+
 TEST(SolanaTokenProgram, createProgramAddress) {
     {
         std::vector<Data> seeds = {
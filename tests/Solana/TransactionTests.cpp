@@ -159,3 +159,69 @@ TEST(SolanaTransaction, TransferTokenTransaction) {
         "PGfKqEaH2zZXDMZLcU6LUKdBSzU1GJWJ1CJXtRYCxaCH7k8uok38WSadZfrZw3TGejiau7nSpan2GvbK26hQim24jRe2AupmcYJFrgsdaCt1Aqs5kpGjPqzgj9krgxTZwwob3xgC1NdHK5BcNwhxwRtrCphGEH7zUFpGFrFrHzgpf2KY8FvPiPELQyxzTBuyNtjLjMMreehSKShEjD9Xzp1QeC1pEF8JL6vUKzxMXuveoEYem8q8JiWszYzmTMfDk13JPgv7pXFGMqDV3yNGCLsWccBeSFKN4UKECre6x2QbUEiKGkHkMc4zQwwyD8tGmEMBAGm339qdANssEMNpDeJp2LxLDStSoWShHnotcrH7pUa94xCVvCPPaomF";
     EXPECT_EQ(transaction.serialize(), expectedString);
 }
+
+TEST(SolanaTransaction, CompileManyInstructions) {
+    // an airdrop: token transfers from one account to many
+    const auto signer = Address("B1iGmDJdvmxyUiYM8UEo2Uw2D58EmUrw4KyLYMmrhf8V");
+    const auto token = Address("SRMuApVNdxXokk5GT7XD5cUUgXMBCoAz2LHeuAoKWRt");
+    const auto senderTokenAddress = Address("EDNd1ycsydWYwVmrYZvqYazFqwk1QjBgAUKFjBoz1jKP");
+    auto message = Message();
+    message.recentBlockhash = Solana::Hash("CNaHfvqePgGYMvtYi9RuUdVxDYttr1zs4TWrTXYabxZi");
+    std::vector<Address> recipients;
+    for (int i = 0; i < 20; ++i) {
+        recipients.push_back(Address(PublicKey(TW::Hash::sha256(TW::Data{static_cast<byte>(i)}), TWPublicKeyTypeED25519)));
+        message.instructions.push_back(Instruction(TokenInstruction::TokenTransfer, std::vector<AccountMeta>{
+            AccountMeta(senderTokenAddress, false, false),
+            AccountMeta(token, false, true),
+            AccountMeta(recipients.back(), false, false),
+            AccountMeta(signer, true, false),
+        }, 1000 + i, 6));
+    }
+    // listed as writable first, then as signer: in both buckets
+    message.instructions.push_back(Instruction(std::vector<AccountMeta>{
+        AccountMeta(recipients[0], true, false),
+        AccountMeta(signer, false, false),
+    }, 1));
+    message.compileAccounts();
+
+    EXPECT_EQ(message.header.numRequiredSignatures, 2);
+    EXPECT_EQ(message.header.numCreditOnlyUnsignedAccounts, 3);
+    ASSERT_EQ(message.accountKeys.size(), 2 + 21 + 3ul);
+    EXPECT_EQ(message.accountKeys[0], signer);
+    EXPECT_EQ(message.accountKeys[1], recipients[0]);
+    EXPECT_EQ(message.accountKeys[2], senderTokenAddress);
+    EXPECT_EQ(message.accountKeys[3], recipients[0]);
+    EXPECT_EQ(message.accountKeys[22], recipients[19]);
+    EXPECT_EQ(message.accountKeys[23], token);
+    EXPECT_EQ(message.accountKeys[24].string(), TOKEN_PROGRAM_ID_ADDRESS);
+    EXPECT_EQ(message.accountKeys[25].string(), SYSTEM_PROGRAM_ID_ADDRESS);
+
+    // indices are those of the first occurrence
+    ASSERT_EQ(message.compiledInstructions.size(), message.instructions.size());
+    for (size_t i = 0; i < message.instructions.size(); ++i) {
+        const auto& instruction = message.instructions[i];
+        const auto& compiled = message.compiledInstructions[i];
+        auto first = [&](const Address& address) {
+            return std::find(message.accountKeys.begin(), message.accountKeys.end(), address) - message.accountKeys.begin();
+        };
+        EXPECT_EQ(compiled.programIdIndex, first(instruction.programId));
+        ASSERT_EQ(compiled.accounts.size(), instruction.accounts.size());
+        for (size_t j = 0; j < compiled.accounts.size(); ++j) {
+            EXPECT_EQ(compiled.accounts[j], first(instruction.accounts[j].account));
+        }
+    }
+
+    // the message size is exact
+    const auto data = Transaction(message).messageData();
+    EXPECT_EQ(data.size(), data.capacity());
+    EXPECT_EQ(hex(Data(data.begin(), data.begin() + 4)), "0200031a");
+}
+
+TEST(SolanaTransaction, ShortVecLength) {
+    for (const size_t length : {0ul, 1ul, 0x7ful, 0x80ul, 0x3ffful, 0x4000ul}) {
+        Data encoded;
+        encodeShortVecLength(length, encoded);
+        EXPECT_EQ(hex(encoded), hex(shortVecLength(std::vector<byte>(length))));
+        EXPECT_EQ(shortVecSize(length), encoded.size());
+    }
+}
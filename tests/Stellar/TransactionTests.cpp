@@ -143,3 +143,33 @@ TEST(StellarTransaction, signAcreateAccount) {
     const auto signature = signer.sign();
     ASSERT_EQ(signature, "AAAAAAmpZryqzBA+OIlrquP4wvBsIf1H3U+GT/DTP5gZ31yiAAAD6AAAAAAAAAACAAAAAAAAAAIAAAAASZYC0gAAAAEAAAAAAAAAAAAAAADFgLYxeg6zm/f81Po8Gf2rS4m7q79hCV7kUFr27O16rgAAAAAAmJaAAAAAAAAAAAEZ31yiAAAAQNgqNDqbe0X60gyH+1xf2Tv2RndFiJmyfbrvVjsTfjZAVRrS2zE9hHlqPQKpZkGKEFka7+1ElOS+/m/1JDnauQg=");
 }
+
+TEST(StellarTransaction, signPayments) {
+    auto privateKey = PrivateKey(parse_hex("59a313f46ef1c23a9e4f71cea10fc0c56a2a6bb8a4b9ea3d5348823e5a478722"));
+    auto input = Proto::SigningInput();
+    input.set_passphrase(TWStellarPassphrase_Stellar);
+    input.set_account("GAE2SZV4VLGBAPRYRFV2VY7YYLYGYIP5I7OU7BSP6DJT7GAZ35OKFDYI");
+    input.set_fee(1000);
+    input.set_sequence(2);
+    input.mutable_memo_text()->set_text("Hello, world!");
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+
+    std::vector<Proto::OperationPayment> payments(7);
+    for (size_t i = 0; i < payments.size(); ++i) {
+        payments[i].set_destination("GDCYBNRRPIHLHG7X7TKPUPAZ7WVUXCN3VO7WCCK64RIFV5XM5V5K4A52");
+        payments[i].set_amount(10000000 + i);
+    }
+    payments[3].mutable_asset()->set_issuer("GA6HCMBLTZS5VYYBCATRBRZ3BZJMAFUDKYYF6AH6MVCMGWMRDNSWJPIH");
+    payments[3].mutable_asset()->set_alphanum4("MOBI");
+
+    const auto outputs = Signer::signPayments(input, payments, 3);
+    ASSERT_EQ(outputs.size(), payments.size());
+    for (size_t i = 0; i < payments.size(); ++i) {
+        auto single = input;
+        single.set_sequence(2 + i);
+        *single.mutable_op_payment() = payments[i];
+        EXPECT_EQ(outputs[i].signature(), Signer::sign(single).signature()) << i;
+        EXPECT_EQ(Signer::encodedSize(single), Signer(single).encode(single).size()) << i;
+    }
+    EXPECT_TRUE(Signer::signPayments(input, {}).empty());
+}
@@ -53,3 +53,36 @@ TEST(THORChainSigner, SignJson) {
 
     EXPECT_EQ(R"({"mode":"block","tx":{"fee":{"amount":[{"amount":"200","denom":"rune"}],"gas":"2000000"},"memo":"memo1234","msg":[{"type":"thorchain/MsgSend","value":{"amount":[{"amount":"50000000","denom":"rune"}],"from_address":"thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2r","to_address":"thor1e2ryt8asq4gu0h6z2sx9u7rfrykgxwkmr9upxn"}}],"signatures":[{"pub_key":{"type":"tendermint/PubKeySecp256k1","value":"A+2Zfjls9CkvX85aQrukFZnM1dluMTFUp8nqcEneMXx3"},"signature":"12AaNC0v51Rhz8rBf7V7rpI6oksREWrjzba3RK1v1NNlqZq62sG0aXWvStp9zZXe07Pp2FviFBAx+uqWsO30NQ=="}]}})", outputJson);
 }
+
+TEST(THORChainSigner, SignTxProtobuf) {
+    auto input = Cosmos::Proto::SigningInput();
+    input.set_signing_mode(Cosmos::Proto::Protobuf);
+    input.set_chain_id("thorchain");
+    input.set_account_number(593);
+    input.set_sequence(21);
+    input.set_memo("");
+
+    auto msg = input.add_messages();
+    auto& message = *msg->mutable_send_coins_message();
+    message.set_from_address("thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2r");
+    message.set_to_address("thor1e2ryt8asq4gu0h6z2sx9u7rfrykgxwkmr9upxn");
+    auto amountOfTx = message.add_amounts();
+    amountOfTx->set_denom("rune");
+    amountOfTx->set_amount(38000000);
+
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(2500000);
+
+    auto privateKey = parse_hex("7105512f0c020a1dd759e14b865ec0125f59ac31e34d7a2807a228ed50cb343e");
+    input.set_private_key(privateKey.data(), privateKey.size());
+
+    auto output = THORChain::Signer::sign(input);
+
+    EXPECT_EQ(output.serialized(), R"({"mode":"BROADCAST_MODE_BLOCK","tx_bytes":"ClIKUAoOL3R5cGVzLk1zZ1NlbmQSPgoUFSLnZ9tusZcIsAOAKb+9YHvJvQ4SFMqGRZ+wBVHH30JUDF54aRksgzrbGhAKBHJ1bmUSCDM4MDAwMDAwElkKUApGCh8vY29zbW9zLmNyeXB0by5zZWNwMjU2azEuUHViS2V5EiMKIQPtmX45bPQpL1/OWkK7pBWZzNXZbjExVKfJ6nBJ3jF8dxIECgIIARgVEgUQoMuYARpA+NJ2QLhL4/lp9w4wy3PA8RbE3cD946iNpO/j1cF0vndq4u+zErcUuWlTixP1yv33Wn6ZNESzdEH4S4kchWVSTA=="})");
+    EXPECT_EQ(hex(output.signature()), "f8d27640b84be3f969f70e30cb73c0f116c4ddc0fde3a88da4efe3d5c174be776ae2efb312b714b969538b13f5cafdf75a7e993444b37441f84b891c8565524c");
+    EXPECT_EQ(output.error(), Common::Proto::OK);
+
+    auto invalid = input;
+    invalid.mutable_messages(0)->mutable_send_coins_message()->set_to_address("thor1e2ryt8asq4gu0h6z2sx9u7rfrykgxwkmr9upxm");
+    EXPECT_EQ(THORChain::Signer::sign(invalid).error(), Common::Proto::Error_general);
+}
@@ -6,6 +6,7 @@
 
 #include <TrustWalletCore/TWAnySigner.h>
 #include <TrustWalletCore/TWAnyAddress.h>
+#include "Coin.h"
 #include "Cosmos/Address.h"
 #include "proto/Cosmos.pb.h"
 #include "HexCoding.h"
@@ -46,4 +47,8 @@ TEST(THORChainTWAnySigner, SignTx) {
 
     // https://viewblock.io/thorchain/tx/FD0445AFFC4ED9ACCB7B5D3ADE361DAE4596EA096340F1360F1020381EA454AF
     ASSERT_EQ(output.json(), R"({"mode":"block","tx":{"fee":{"amount":[{"amount":"2000000","denom":"rune"}],"gas":"200000"},"memo":"","msg":[{"type":"thorchain/MsgSend","value":{"amount":[{"amount":"10000000","denom":"rune"}],"from_address":"thor1z53wwe7md6cewz9sqwqzn0aavpaun0gw0exn2r","to_address":"thor1e2ryt8asq4gu0h6z2sx9u7rfrykgxwkmr9upxn"}}],"signatures":[{"pub_key":{"type":"tendermint/PubKeySecp256k1","value":"A+2Zfjls9CkvX85aQrukFZnM1dluMTFUp8nqcEneMXx3"},"signature":"qgpMX3WNq4DsNBnYtdmBD4ejiailK4uI/m3/YVqCSNF8AtkUOTmP48ztqCbpkWTFvw1/9S8/ivsFxOcK6AI0jA=="}]}})");
+
+    // typed signing uses the THORChain signer, not the Cosmos one
+    const auto typedOutput = anyCoinSign<Cosmos::Proto::SigningInput, Cosmos::Proto::SigningOutput>(TWCoinTypeTHORChain, input);
+    EXPECT_EQ(typedOutput.json(), output.json());
 }
@@ -7,6 +7,7 @@
 #include "TON/Address.h"
 #include "TON/Contract.h"
 #include "HexCoding.h"
+#include "PrivateKey.h"
 
 #include <gtest/gtest.h>
 
@@ -117,6 +118,28 @@ TEST(TONAddress, createStateInit) {
     EXPECT_EQ("240090ab66459bf6e61e3dfd43f7b9c1f1e7d4bd81d3b2a4ac7323cc1a970753", hex(hash));
 }
 
+TEST(TONAddress, stateInitHash) {
+    const auto publicKey = PublicKey(parse_hex("F61CF0BC8E891AD7636E0CD35229D579323AA2DA827EB85D8071407464DC2FA3"), TWPublicKeyTypeED25519);
+    EXPECT_EQ("240090ab66459bf6e61e3dfd43f7b9c1f1e7d4bd81d3b2a4ac7323cc1a970753", hex(Contract::stateInitHash(publicKey)));
+    const auto other = PrivateKey(parse_hex("b471884e691a9f5bb641b14f33bb9e555f759c24e368c4c0d997db3a60704220")).getPublicKey(TWPublicKeyTypeED25519);
+    EXPECT_EQ(hex(Contract::stateInitHash(other)), hex(Contract::createStateInit(other).hash()));
+    // the code cell is shared
+    EXPECT_EQ(Contract::createStateInit(publicKey).getCells()[0], Contract::walletCodeCell());
+    const auto secp256k1 = PublicKey(parse_hex("0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1"), TWPublicKeyTypeSECP256k1);
+    EXPECT_THROW(Contract::stateInitHash(secp256k1), std::invalid_argument);
+}
+
+TEST(TONAddress, deriveAddresses) {
+    const auto publicKey0 = PublicKey(parse_hex("F61CF0BC8E891AD7636E0CD35229D579323AA2DA827EB85D8071407464DC2FA3"), TWPublicKeyTypeED25519);
+    const auto publicKey1 = PrivateKey(parse_hex("b471884e691a9f5bb641b14f33bb9e555f759c24e368c4c0d997db3a60704220")).getPublicKey(TWPublicKeyTypeED25519);
+    const auto addresses = Address::deriveAddresses({publicKey0, publicKey1});
+    ASSERT_EQ(addresses.size(), 2ul);
+    EXPECT_EQ("EQAkAJCrZkWb9uYePf1D97nB8efUvYHTsqSscyPMGpcHUx3Y", addresses[0]);
+    EXPECT_EQ(Address(publicKey1).string(), addresses[1]);
+    EXPECT_EQ(Address(publicKey0, Workchain::MasterChainId).string(), Address::deriveAddresses({publicKey0}, Workchain::MasterChainId)[0]);
+    EXPECT_TRUE(Address::deriveAddresses({}).empty());
+}
+
 TEST(TONAddress, AddressFromPublicKey)
 {
     // Sample taken from TON HOWTO
@@ -0,0 +1,81 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TON/BagOfCells.h"
+#include "TON/Contract.h"
+#include "HexCoding.h"
+#include "PublicKey.h"
+
+#include <gtest/gtest.h>
+
+namespace TW::TON {
+
+TEST(TONBagOfCells, ParseStateInit) {
+    const auto publicKey = PublicKey(parse_hex("F42C134E7E2B3E4D6E3D2B60F2ACF33F8E8A2A2A1F4101E1B6470F4D3AF3BA7E"), TWPublicKeyTypeED25519);
+    auto stateInit = Contract::createStateInit(publicKey);
+    Data serialized;
+    stateInit.serialize(serialized, Cell::SerializationMode::WithCRC32C);
+
+    const auto boc = BagOfCells(serialized);
+    ASSERT_EQ(boc.cellCount(), 3);
+    ASSERT_EQ(boc.rootCount(), 1);
+    const auto root = boc.root();
+    EXPECT_EQ(root, 0);
+    EXPECT_EQ(boc.cell(root).sizeBits, 5);
+    EXPECT_EQ(boc.cell(root).refCount, 2);
+    // zero-copy
+    EXPECT_GE(boc.cell(1).data.data(), serialized.data());
+    EXPECT_LT(boc.cell(1).data.data(), serialized.data() + serialized.size());
+    EXPECT_EQ(hex(boc.cell(2).data), "00000000" + hex(publicKey.bytes));
+
+    EXPECT_EQ(hex(boc.hash(root)), hex(stateInit.hash()));
+    EXPECT_EQ(boc.depth(root), 1);
+    EXPECT_EQ(hex(boc.toCell(root)->hash()), hex(stateInit.hash()));
+    EXPECT_EQ(boc.slice(root).sizeBits(), 5);
+}
+
+TEST(TONBagOfCells, ParseShared) {
+    auto leaf = std::make_shared<Cell>();
+    leaf->setSliceBitsStr("a8", 5);
+    auto a = std::make_shared<Cell>();
+    a->addCell(leaf);
+    a->addCell(leaf);
+    Cell root;
+    root.setSliceBytesStr("0102");
+    root.addCell(a);
+    root.addCell(leaf);
+    Data serialized;
+    root.serialize(serialized);
+
+    const auto boc = BagOfCells(serialized);
+    EXPECT_EQ(boc.cellCount(), 3);
+    EXPECT_EQ(boc.depth(0), 2);
+    EXPECT_EQ(hex(boc.hash(0)), hex(root.hash()));
+    const auto copy = boc.toCell(0);
+    EXPECT_EQ(hex(copy->hash()), hex(root.hash()));
+    Data reserialized;
+    copy->serialize(reserialized);
+    EXPECT_EQ(hex(reserialized), hex(serialized));
+}
+
+TEST(TONBagOfCells, Invalid) {
+    const auto valid = parse_hex("b5ee9c724101020100080001000100061234567ac0b173");
+    EXPECT_NO_THROW(BagOfCells{valid});
+
+    auto badCrc = valid;
+    badCrc.back() ^= 1;
+    EXPECT_THROW(BagOfCells{badCrc}, std::invalid_argument);
+    EXPECT_THROW(BagOfCells{Data(valid.begin(), valid.end() - 1)}, std::invalid_argument);
+    EXPECT_THROW(BagOfCells{parse_hex("b5ee9c73")}, std::invalid_argument);
+    EXPECT_THROW(BagOfCells{Data()}, std::invalid_argument);
+    // backward reference
+    EXPECT_THROW(BagOfCells{parse_hex("b5ee9c72010102010005010000010000")}, std::invalid_argument);
+    // trailing data
+    EXPECT_THROW(BagOfCells{parse_hex("b5ee9c7201010101000200000000")}, std::invalid_argument);
+    EXPECT_NO_THROW(BagOfCells{parse_hex("b5ee9c72010101010002000000")});
+}
+
+} // namespace TW::TON
@@ -5,6 +5,7 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "TON/Cell.h"
+#include "Hash.h"
 #include "HexCoding.h"
 
 #include <gtest/gtest.h>
@@ -256,4 +257,43 @@ TEST(TONCell, CellStateInit2)
         EXPECT_EQ("b5ee9c7241010301007e00020134010200a2ff0020dd2082014c97ba9730ed44d0d70b1fe0a4f260810200d71820d70b1fed44d0d31fd3ffd15112baf2a122f901541044f910f2a2f80001d31f3120d74a96d307d402fb00ded1a4c8cb1fcbffc9ed5400480000000037f14c50f6435b11b9326e1218524f7f072d0a5ea8221cca71682e7d6ed6421381c553bd",
             hex(ser));
     }
-}
\ No newline at end of file
+}
+TEST(TONCell, CellSharedSubtree)
+{
+    // root -> a, b; a -> leaf; b -> identical leaf
+    auto leaf1 = std::make_shared<Cell>();
+    leaf1->setSliceBytesStr("01");
+    auto leaf2 = std::make_shared<Cell>();
+    leaf2->setSliceBytesStr("01");
+    auto a = std::make_shared<Cell>();
+    a->setSliceBytesStr("aa");
+    a->addCell(leaf1);
+    auto b = std::make_shared<Cell>();
+    b->setSliceBytesStr("bb");
+    b->addCell(leaf2);
+    Cell root;
+    root.addCell(a);
+    root.addCell(b);
+
+    EXPECT_EQ(0, leaf1->depth());
+    EXPECT_EQ(1, a->depth());
+    EXPECT_EQ(2, root.depth());
+
+    // child depths are part of the hash
+    const auto leafHash = Hash::sha256(parse_hex("000201"));
+    const auto aHash = Hash::sha256(parse_hex("0102aa0000" + hex(leafHash)));
+    const auto bHash = Hash::sha256(parse_hex("0102bb0000" + hex(leafHash)));
+    EXPECT_EQ(hex(a->hash()), hex(aHash));
+    EXPECT_EQ(hex(root.hash()), hex(Hash::sha256(parse_hex("020000010001" + hex(aHash) + hex(bHash)))));
+
+    // the leaf is stored once
+    EXPECT_EQ(26, root.serializedSize());
+    Data ser;
+    root.serialize(ser);
+    EXPECT_EQ("b5ee9c7201010401000f00" "02000102" "0102aa03" "0102bb03" "000201", hex(ser));
+
+    // cached hash is recomputed after modification
+    const auto before = hex(root.hash());
+    root.setSliceBytesStr("ff");
+    EXPECT_NE(before, hex(root.hash()));
+}
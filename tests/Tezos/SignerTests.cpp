@@ -89,3 +89,47 @@ TEST(TezosSigner, SignOperationList) {
 
     ASSERT_EQ(hex(signedBytes.begin(), signedBytes.end()), expectedSignedBytes);
 }
+
+TEST(TezosSigner, SignBatch) {
+    auto key = parse_hex("2e8905819b8723fe2c1d161860e5ee1830318dbf49a83bd451cfb8440c28bd6f");
+    std::vector<Proto::SigningInput> inputs;
+    for (auto i = 0; i < 12; ++i) {
+        Proto::SigningInput input;
+        input.set_private_key(key.data(), key.size());
+        auto& operations = *input.mutable_operation_list();
+        operations.set_branch(i < 8 ? "BL8euoCWqNCny9AR3AKjnpi38haYMxjei1ZqNHuXMn19JSQnoWp" : "BLDnkhhVgwdBAtmDNQc5HtEMsrxq8L3t7NQbjUbbdTdw5Ug1Mpe");
+        if (i % 4 == 0) {
+            auto& reveal = *operations.add_operations();
+            reveal.mutable_reveal_operation_data();
+            reveal.set_source("tz1XVJ8bZUXs7r5NV8dHvuiBhzECvLRLR3jW");
+            reveal.set_fee(1272);
+            reveal.set_counter(30738);
+            reveal.set_gas_limit(10100);
+            reveal.set_storage_limit(257);
+            reveal.set_kind(Proto::Operation::REVEAL);
+        }
+        auto& transaction = *operations.add_operations();
+        auto& txData = *transaction.mutable_transaction_operation_data();
+        txData.set_amount(1000 + i);
+        txData.set_destination("tz1gSM6yiwr85jEASZ1q3UekgHEoxYt7wg2M");
+        transaction.set_source("tz1XVJ8bZUXs7r5NV8dHvuiBhzECvLRLR3jW");
+        transaction.set_fee(1272);
+        transaction.set_counter(30739 + i);
+        transaction.set_gas_limit(10100);
+        transaction.set_storage_limit(257);
+        transaction.set_kind(Proto::Operation::TRANSACTION);
+        inputs.push_back(input);
+    }
+    inputs[5].mutable_operation_list()->set_branch("BL8euoCWqNCny9AR3AKjnpi38haYMxjei1ZqNHuXMn19JSQnoWq");
+
+    const auto outputs = Signer::signBatch(inputs, 3);
+    ASSERT_EQ(outputs.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (i == 5) {
+            EXPECT_TRUE(outputs[i].encoded().empty());
+            continue;
+        }
+        EXPECT_EQ(hex(outputs[i].encoded()), hex(Signer::sign(inputs[i]).encoded())) << i;
+    }
+    EXPECT_EQ(Signer::signBatch({}).size(), 0);
+}
@@ -6,6 +6,7 @@
 
 #include "HexCoding.h"
 #include "Theta/Signer.h"
+#include "BatchSigningHelper.h"
 
 #include <gtest/gtest.h>
 
@@ -33,4 +34,24 @@ TEST(Signer, Sign) {
               "1255140b4a8abd3ec6c20a14");
 }
 
+TEST(Signer, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = Proto::SigningInput();
+        input.set_chain_id(i % 2 == 0 ? "mainnet" : "privatenet");
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "0x93a90ea508331dfdf27fb79757d4250b4e84954927ba0073cd67454ac432c737"
+                                                                   : "0x4f3edf983ac636a65a842ce7c78d9aa706d3b113bce9c46f30d7d21715b23b1d");
+        input.set_private_key(privateKey.data(), privateKey.size());
+        input.set_to_address(i == 30 ? "0x9F1233798E905E173560071255140b4A8aBd3E" : "0x9F1233798E905E173560071255140b4A8aBd3Ec6");
+        const auto theta = store(uint256_t(10 + i));
+        input.set_theta_amount(theta.data(), theta.size());
+        const auto tfuel = store(uint256_t(20));
+        input.set_tfuel_amount(tfuel.data(), tfuel.size());
+        const auto fee = store(uint256_t(1000000000000));
+        input.set_fee(fee.data(), fee.size());
+        input.set_sequence(i + 1);
+        return input;
+    }, {30});
+}
+
 } // namespace TW::Theta
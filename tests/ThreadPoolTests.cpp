@@ -0,0 +1,163 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "ThreadPool.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace TW {
+
+TEST(ThreadPool, WorkerCount) {
+    ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3ul);
+    EXPECT_EQ(pool.workerCount(0, 100), 3ul);
+    EXPECT_EQ(pool.workerCount(2, 100), 2ul);
+    EXPECT_EQ(pool.workerCount(8, 100), 3ul);
+    EXPECT_EQ(pool.workerCount(0, 2), 2ul);
+    EXPECT_EQ(pool.workerCount(0, 0), 1ul);
+
+    pool.setThreadCount(5);
+    EXPECT_EQ(pool.size(), 5ul);
+    pool.setThreadCount(0);
+    EXPECT_EQ(pool.size(), static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency())));
+}
+
+TEST(ThreadPool, ParallelFor) {
+    ThreadPool pool(4);
+    for (const auto count : {0ul, 1ul, 7ul, 1000ul}) {
+        std::vector<std::atomic<int>> calls(count);
+        pool.parallelFor(count, 0, [&](size_t index) { ++calls[index]; });
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(calls[i], 1) << i;
+        }
+    }
+}
+
+TEST(ThreadPool, Run) {
+    ThreadPool pool(4);
+    std::atomic<size_t> next(0);
+    std::atomic<size_t> done(0);
+    std::mutex mutex;
+    std::set<std::thread::id> threads;
+    pool.run(0, 400, [&] {
+        for (auto i = next++; i < 400; i = next++) {
+            ++done;
+            std::lock_guard<std::mutex> lock(mutex);
+            threads.insert(std::this_thread::get_id());
+        }
+    });
+    EXPECT_EQ(done, 400ul);
+    EXPECT_LE(threads.size(), 4ul);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 1ul);
+}
+
+TEST(ThreadPool, Nested) {
+    // nested runs queue tasks from pool threads, and never wait for a queued task
+    ThreadPool pool(2);
+    std::atomic<size_t> total(0);
+    pool.parallelFor(16, 0, [&](size_t) {
+        pool.parallelFor(16, 0, [&](size_t) {
+            pool.parallelFor(4, 0, [&](size_t) { ++total; });
+        });
+    });
+    EXPECT_EQ(total, 16ul * 16 * 4);
+}
+
+TEST(ThreadPool, Exception) {
+    ThreadPool pool(4);
+    std::atomic<size_t> calls(0);
+    EXPECT_THROW(pool.parallelFor(100, 0, [&](size_t index) {
+        ++calls;
+        if (index == 50) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+    EXPECT_GT(calls, 0ul);
+
+    // still usable
+    std::atomic<size_t> total(0);
+    pool.parallelFor(100, 0, [&](size_t) { ++total; });
+    EXPECT_EQ(total, 100ul);
+}
+
+TEST(ThreadPool, Submit) {
+    std::atomic<size_t> done(0);
+    {
+        ThreadPool pool(3);
+        for (auto i = 0; i < 50; ++i) {
+            pool.submit([&] { ++done; });
+        }
+        pool.submit([] { throw std::runtime_error("discarded"); });
+    }
+    // the queued tasks run before the pool is destroyed
+    EXPECT_EQ(done, 50ul);
+}
+
+TEST(ThreadPool, Executor) {
+    ThreadPool pool(4);
+    std::atomic<size_t> executed(0);
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    pool.setExecutor([&](std::function<void()> task) {
+        ++executed;
+        std::lock_guard<std::mutex> lock(mutex);
+        threads.emplace_back(std::move(task));
+    }, 3);
+    EXPECT_EQ(pool.size(), 3ul);
+
+    std::atomic<size_t> total(0);
+    pool.parallelFor(300, 0, [&](size_t) { ++total; });
+    EXPECT_EQ(total, 300ul);
+    EXPECT_EQ(executed, 2ul);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    pool.setExecutor(nullptr, 0);
+    EXPECT_EQ(pool.size(), 4ul);
+    pool.parallelFor(300, 0, [&](size_t) { ++total; });
+    EXPECT_EQ(total, 600ul);
+}
+
+TEST(ThreadPool, Affinity) {
+    ThreadPool pool(2);
+#if defined(__linux__)
+    ASSERT_TRUE(pool.setAffinity({0}));
+    const auto mainThread = std::this_thread::get_id();
+    std::atomic<size_t> elsewhere(0);
+    std::atomic<size_t> next(0);
+    pool.run(0, 1000, [&] {
+        for (auto i = next++; i < 1000; i = next++) {
+            // the calling thread is not pinned
+            if (std::this_thread::get_id() != mainThread && sched_getcpu() != 0) {
+                ++elsewhere;
+            }
+        }
+    });
+    EXPECT_EQ(elsewhere, 0ul);
+    EXPECT_TRUE(pool.setAffinity({}));
+
+    const auto cpus = ThreadPool::numaNodeCpus(0);
+    if (!cpus.empty()) {
+        EXPECT_TRUE(pool.setNumaNode(0));
+    }
+#endif
+    EXPECT_TRUE(ThreadPool::numaNodeCpus(100000).empty());
+    EXPECT_FALSE(pool.setNumaNode(100000));
+}
+
+} // namespace TW
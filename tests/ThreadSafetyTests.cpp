@@ -0,0 +1,197 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+// Stress tests calling shared code from many threads at once, comparing with results computed on one thread.
+// Run under CLANG_TSAN (see thread_safety_test in CMakeLists.txt) to report data races.
+
+#include "Base32.h"
+#include "Coin.h"
+#include "HDWallet.h"
+#include "Hash.h"
+#include "HexCoding.h"
+#include "Mnemonic.h"
+#include "PrivateKey.h"
+#include "Secp256k1Comb.h"
+
+#include <TrezorCrypto/bip39.h>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+const size_t threadCount = 8;
+const size_t iterations = 16;
+
+const auto mnemonic = "ripple scissors kick mammal hire column oak again sun offer wealth tomorrow wagon turn fatal";
+
+/// Runs `body(thread, iteration)` on `threadCount` threads at once
+void runConcurrently(const std::function<void(size_t, size_t)>& body) {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&body, t]() {
+            for (size_t i = 0; i < iterations; ++i) {
+                body(t, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace
+
+TEST(ThreadSafety, MnemonicFromData) {
+    std::vector<Data> entropies;
+    std::vector<SecureString> expected;
+    for (size_t t = 0; t < threadCount; ++t) {
+        entropies.push_back(Hash::sha256(Data{static_cast<byte>(t)}));
+        expected.push_back(HDWallet(entropies.back(), "").mnemonic);
+    }
+
+    std::vector<std::vector<SecureString>> results(threadCount);
+    runConcurrently([&](size_t t, size_t) {
+        // the legacy API returns a buffer of the calling thread
+        const auto* legacy = mnemonic_from_data(entropies[t].data(), static_cast<int>(entropies[t].size()));
+        results[t].push_back(legacy);
+        results[t].push_back(HDWallet(entropies[t], "").mnemonic);
+    });
+
+    for (size_t t = 0; t < threadCount; ++t) {
+        for (const auto& result : results[t]) {
+            EXPECT_EQ(result, expected[t]);
+        }
+    }
+}
+
+TEST(ThreadSafety, MnemonicGenerate) {
+    std::vector<std::vector<SecureString>> results(threadCount);
+    runConcurrently([&](size_t t, size_t) {
+        results[t].push_back(HDWallet(128, "").mnemonic);
+    });
+
+    std::set<SecureString> distinct;
+    for (const auto& mnemonics : results) {
+        for (const auto& generated : mnemonics) {
+            EXPECT_TRUE(Mnemonic::isValid(generated.c_str()));
+            distinct.insert(generated);
+        }
+    }
+    EXPECT_EQ(distinct.size(), threadCount * iterations);
+}
+
+TEST(ThreadSafety, DeriveAddresses) {
+    // one coin per curve
+    const std::vector<TWCoinType> coins = {
+        TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeSolana, TWCoinTypeNano,
+        TWCoinTypeNEO, TWCoinTypeCardano, TWCoinTypeZilliqa, TWCoinTypeStellar,
+    };
+    std::vector<std::string> expected;
+    {
+        const HDWallet wallet(mnemonic, "");
+        for (auto coin : coins) {
+            expected.push_back(wallet.deriveAddress(coin));
+        }
+    }
+
+    std::vector<std::vector<std::string>> results(threadCount);
+    runConcurrently([&](size_t t, size_t i) {
+        // a wallet per call, so that seeds are computed (and cached) concurrently too
+        const HDWallet wallet(mnemonic, "");
+        const auto coin = coins[(t + i) % coins.size()];
+        results[t].push_back(wallet.deriveAddress(coin));
+    });
+
+    for (size_t t = 0; t < threadCount; ++t) {
+        for (size_t i = 0; i < iterations; ++i) {
+            EXPECT_EQ(results[t][i], expected[(t + i) % coins.size()]);
+        }
+    }
+}
+
+TEST(ThreadSafety, Sign) {
+    const std::vector<TWCurve> curves = {TWCurveSECP256k1, TWCurveED25519, TWCurveNIST256p1, TWCurveCurve25519};
+    const auto key = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    std::vector<Data> digests;
+    std::vector<std::vector<Data>> expected(curves.size());
+    for (size_t i = 0; i < iterations; ++i) {
+        digests.push_back(Hash::sha256(Data{static_cast<byte>(i)}));
+        for (size_t c = 0; c < curves.size(); ++c) {
+            expected[c].push_back(key.sign(digests.back(), curves[c]));
+        }
+    }
+
+    std::vector<std::vector<Data>> results(threadCount);
+    runConcurrently([&](size_t t, size_t i) {
+        results[t].push_back(key.sign(digests[i], curves[t % curves.size()]));
+    });
+
+    for (size_t t = 0; t < threadCount; ++t) {
+        for (size_t i = 0; i < iterations; ++i) {
+            EXPECT_EQ(hex(results[t][i]), hex(expected[t % curves.size()][i]));
+        }
+    }
+}
+
+TEST(ThreadSafety, PublicKeyWhileChangingCombWindow) {
+    const auto privateKey = PrivateKey(parse_hex("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5"));
+    const auto expected = hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes);
+    const auto window = Secp256k1Comb::window();
+
+    std::vector<std::vector<std::string>> results(threadCount);
+    runConcurrently([&](size_t t, size_t i) {
+        if (t == 0) {
+            // tables are replaced while other threads use them
+            Secp256k1Comb::setWindow(i % 2 == 0 ? 0 : Secp256k1Comb::defaultWindow);
+            return;
+        }
+        results[t].push_back(hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes));
+    });
+    Secp256k1Comb::setWindow(window);
+
+    for (size_t t = 1; t < threadCount; ++t) {
+        for (const auto& result : results[t]) {
+            EXPECT_EQ(result, expected);
+        }
+    }
+}
+
+TEST(ThreadSafety, Hashes) {
+    const auto input = Data(1000, 0x5a);
+    const std::vector<std::function<Data()>> hashes = {
+        [&]() { return Hash::sha256(input); },
+        [&]() { return Hash::keccak256(input); },
+        [&]() { return Hash::blake2b(input, 32); },
+        [&]() { return Hash::groestl512(input); },
+        [&]() { return Hash::sha512(input); },
+        [&]() { return TW::data(Base32::encode(input)); },
+    };
+    std::vector<Data> expected;
+    for (const auto& hash : hashes) {
+        expected.push_back(hash());
+    }
+
+    std::vector<std::vector<Data>> results(threadCount);
+    runConcurrently([&](size_t t, size_t i) {
+        results[t].push_back(hashes[(t + i) % hashes.size()]());
+    });
+
+    for (size_t t = 0; t < threadCount; ++t) {
+        for (size_t i = 0; i < iterations; ++i) {
+            EXPECT_EQ(hex(results[t][i]), hex(expected[(t + i) % hashes.size()]));
+        }
+    }
+}
+
+} // namespace TW
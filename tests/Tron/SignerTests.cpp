@@ -340,4 +340,54 @@ TEST(TronSigner, SignTransferTrc20Contract) {
     ASSERT_EQ(hex(output.id()), "0d644290e3cf554f6219c7747f5287589b6e7e30e1b02793b48ba362da6a5058");
     ASSERT_EQ(hex(output.signature()), "bec790877b3a008640781e3948b070740b1f6023c29ecb3f7b5835433c13fc5835e5cad3bd44360ff2ddad5ed7dc9d7dee6878f90e86a40355b7697f5954b88c01");
 }
+
+TEST(TronSigner, TRC20TransferTemplate) {
+    auto input = Proto::SigningInput();
+    auto& transaction = *input.mutable_transaction();
+    auto& transfer_contract = *transaction.mutable_transfer_trc20_contract();
+    transfer_contract.set_owner_address("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC");
+    transfer_contract.set_contract_address("THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV");
+    transaction.set_timestamp(1539295479000);
+    transaction.set_fee_limit(10000000);
+
+    auto& blockHeader = *transaction.mutable_block_header();
+    blockHeader.set_timestamp(1539295479000);
+    const auto txTrieRoot = parse_hex("64288c2db0641316762a99dbb02ef7c90f968b60f9f2e410835980614332f86d");
+    blockHeader.set_tx_trie_root(txTrieRoot.data(), txTrieRoot.size());
+    const auto parentHash = parse_hex("00000000002f7b3af4f5f8b9e23a30c530f719f165b742e7358536b280eead2d");
+    blockHeader.set_parent_hash(parentHash.data(), parentHash.size());
+    blockHeader.set_number(3111739);
+    const auto witnessAddress = parse_hex("415863f6091b8e71766da808b1dd3159790f61de7d");
+    blockHeader.set_witness_address(witnessAddress.data(), witnessAddress.size());
+    blockHeader.set_version(3);
+
+    const auto privateKey = PrivateKey(parse_hex("2d8f68944bdbfbc0769542fba8fc2d2a3de67393334471624364c7006da2aa54"));
+    input.set_private_key(privateKey.bytes.data(), privateKey.bytes.size());
+
+    const auto signingTemplate = TRC20TransferTemplate(input);
+    const auto transfers = std::vector<TRC20TransferTemplate::Transfer>{
+        {"TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9Z", store(uint256_t(1000))},
+        {"THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV", store(uint256_t("10000000000000000000000"))},
+        {"TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC", Data()},
+    };
+    const auto outputs = signingTemplate.signBatch(transfers, 2);
+    ASSERT_EQ(outputs.size(), transfers.size());
+    for (size_t i = 0; i < transfers.size(); ++i) {
+        transfer_contract.set_to_address(transfers[i].toAddress);
+        transfer_contract.set_amount(std::string(transfers[i].amount.begin(), transfers[i].amount.end()));
+        const auto expected = Signer::sign(input);
+        EXPECT_EQ(hex(outputs[i].id()), hex(expected.id())) << i;
+        EXPECT_EQ(hex(outputs[i].signature()), hex(expected.signature())) << i;
+        EXPECT_EQ(hex(outputs[i].ref_block_bytes()), hex(expected.ref_block_bytes())) << i;
+        EXPECT_EQ(hex(outputs[i].ref_block_hash()), hex(expected.ref_block_hash())) << i;
+        EXPECT_EQ(outputs[i].json(), expected.json()) << i;
+    }
+    EXPECT_EQ(signingTemplate.sign(transfers[1]).json(), outputs[1].json());
+
+    EXPECT_THROW(signingTemplate.sign({"TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9", Data()}), std::invalid_argument);
+    EXPECT_THROW(signingTemplate.sign({"TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9Z", Data(33, 1)}), std::invalid_argument);
+    transaction.mutable_transfer();
+    EXPECT_THROW(TRC20TransferTemplate{input}, std::invalid_argument);
+}
+
 } // namespace TW::Tron
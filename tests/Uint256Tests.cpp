@@ -0,0 +1,112 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "uint256.h"
+#include "HexCoding.h"
+
+#include <TrezorCrypto/rand.h>
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+static_assert(UInt256(5) + UInt256(7) == UInt256(12));
+static_assert(UInt256(0) - UInt256(1) == ~UInt256(0));
+static_assert((UInt256(1) << 255) >> 255 == UInt256(1));
+static_assert(UInt256(0xffffffffffffffffULL) * UInt256(0xffffffffffffffffULL) == UInt256({1, 0xfffffffffffffffeULL, 0, 0}));
+static_assert(UInt256(1) << 64 > UInt256(0xffffffffffffffffULL));
+static_assert((UInt256(1) << 200).bitLength() == 201);
+
+namespace {
+
+uint256_t randomValue() {
+    Data bytes(32);
+    random_buffer(bytes.data(), bytes.size());
+    // vary the magnitude
+    const auto zeros = random32() % 33;
+    std::fill(bytes.begin(), bytes.begin() + zeros, 0);
+    return load(bytes);
+}
+
+} // namespace
+
+TEST(UInt256, BoostConversion) {
+    const uint256_t value("0x123456789abcdef0112233445566778899aabbccddeeff00aabbccddeeff0011");
+    const auto limbs = UInt256(value);
+    EXPECT_EQ(limbs.limbs[0], 0xaabbccddeeff0011ULL);
+    EXPECT_EQ(limbs.limbs[3], 0x123456789abcdef0ULL);
+    EXPECT_EQ(static_cast<uint256_t>(limbs), value);
+    EXPECT_EQ(static_cast<uint256_t>(UInt256()), uint256_t(0));
+    EXPECT_EQ(UInt256(uint256_t(42)), UInt256(42));
+}
+
+TEST(UInt256, Arithmetic) {
+    for (int i = 0; i < 200; ++i) {
+        const auto a = randomValue();
+        const auto b = randomValue();
+        const auto shift = random32() % 260;
+        const auto x = UInt256(a);
+        const auto y = UInt256(b);
+        EXPECT_EQ(static_cast<uint256_t>(x + y), a + b);
+        EXPECT_EQ(static_cast<uint256_t>(x - y), a - b);
+        EXPECT_EQ(static_cast<uint256_t>(x * y), a * b);
+        EXPECT_EQ(static_cast<uint256_t>(x << shift), shift >= 256 ? uint256_t(0) : uint256_t(a << shift));
+        EXPECT_EQ(static_cast<uint256_t>(x >> shift), shift >= 256 ? uint256_t(0) : uint256_t(a >> shift));
+        EXPECT_EQ(static_cast<uint256_t>(x & y), a & b);
+        EXPECT_EQ(static_cast<uint256_t>(x | y), a | b);
+        EXPECT_EQ(static_cast<uint256_t>(x ^ y), a ^ b);
+        EXPECT_EQ(x < y, a < b);
+        EXPECT_EQ(x == y, a == b);
+        EXPECT_EQ(x.bitLength(), a == 0 ? 0 : msb(a) + 1);
+        EXPECT_EQ(x.toString(), a.str());
+
+        auto quotient = x;
+        const auto remainder = quotient.divmod(1000003);
+        EXPECT_EQ(static_cast<uint256_t>(quotient), a / 1000003);
+        EXPECT_EQ(remainder, static_cast<uint32_t>(a % 1000003));
+    }
+}
+
+TEST(UInt256, LoadStore) {
+    const auto bytes = parse_hex("0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20");
+    const auto value = UInt256::load(bytes);
+    EXPECT_EQ(value.limbs[0], 0x191a1b1c1d1e1f20ULL);
+    EXPECT_EQ(hex(value.store()), hex(bytes));
+
+    Data out(32);
+    UInt256(0x1234).store(out.data());
+    EXPECT_EQ(hex(out), "0000000000000000000000000000000000000000000000000000000000001234");
+    EXPECT_EQ(hex(UInt256(0x1234).store()), "1234");
+    EXPECT_EQ(hex(UInt256().store()), "00");
+
+    // rightmost bytes are taken
+    EXPECT_EQ(UInt256::load(parse_hex("ff0102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f20")), value);
+    EXPECT_EQ(UInt256::load(Data()), UInt256());
+}
+
+TEST(UInt256, Shims) {
+    EXPECT_EQ(load(parse_hex("0de0b6b3a7640000")), uint256_t(1000000000000000000ULL));
+    EXPECT_EQ(load(std::string("\x01\x00", 2)), uint256_t(256));
+    EXPECT_EQ(hex(store(uint256_t(0))), "00");
+    EXPECT_EQ(hex(store(uint256_t(1000000000000000000ULL))), "0de0b6b3a7640000");
+    EXPECT_EQ(loadWithOffset(parse_hex("ff000000000000000000000000000000000000000000000000000000000000002a"), 1), uint256_t(42));
+    EXPECT_EQ(loadWithOffset(parse_hex("2a"), 0), uint256_t(0));
+    EXPECT_EQ(toString(uint256_t(0)), "0");
+    EXPECT_EQ(toString(uint256_t("115792089237316195423570985008687907853269984665640564039457584007913129639935")),
+              "115792089237316195423570985008687907853269984665640564039457584007913129639935");
+
+    Data encoded;
+    encode256BE(encoded, uint256_t(0x1234), 32);
+    EXPECT_EQ(hex(encoded), "00001234");
+    encoded.clear();
+    encode256BE(encoded, uint256_t(0x123456), 16);
+    EXPECT_EQ(hex(encoded), "3456");
+    encoded.clear();
+    encode256BE(encoded, uint256_t(1), 264);
+    EXPECT_EQ(hex(encoded), "00" "0000000000000000000000000000000000000000000000000000000000000001");
+}
+
+} // namespace TW
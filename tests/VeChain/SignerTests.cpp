@@ -6,9 +6,12 @@
 
 #include "HexCoding.h"
 #include "VeChain/Signer.h"
+#include "BatchSigningHelper.h"
 
 #include <gtest/gtest.h>
 
+#include <stdexcept>
+
 namespace TW::VeChain {
 
 using boost::multiprecision::uint256_t;
@@ -31,4 +34,94 @@ TEST(Signer, Sign) {
     ASSERT_EQ(hex(signature), "3181b1094150f8e4f51f370b805cc9c5b107504145b9e316e846d5e5dbeedb5c1c2b5d217f197a105983dfaad6a198414d5731c7447493cb6b5169907d73dbe101");
 }
 
+namespace {
+
+Proto::SigningInput distributionInput(size_t clauseCount) {
+    auto input = Proto::SigningInput();
+    input.set_chain_tag(1);
+    input.set_block_ref(1);
+    input.set_expiration(1);
+    input.set_gas(21000);
+    input.set_nonce(1);
+    const auto key = parse_hex("0x4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_private_key(key.data(), key.size());
+    for (size_t i = 0; i < clauseCount; ++i) {
+        auto& clause = *input.add_clauses();
+        clause.set_to("0x3535353535353535353535353535353535353535");
+        const auto value = store(uint256_t(1000 + i));
+        clause.set_value(value.data(), value.size());
+        // VIP-180 transfer payload
+        const auto data = parse_hex("a9059cbb0000000000000000000000003535353535353535353535353535353535353535"
+                                    "00000000000000000000000000000000000000000000000000000000000003e8");
+        clause.set_data(data.data(), data.size());
+    }
+    return input;
+}
+
+} // namespace
+
+TEST(Signer, SigningHash) {
+    auto transaction = Transaction();
+    transaction.chainTag = 1;
+    transaction.blockRef = 1;
+    transaction.expiration = 1;
+    transaction.clauses.push_back(
+        Clause(Ethereum::Address("0x3535353535353535353535353535353535353535"), 1000, {})
+    );
+    transaction.gas = 21000;
+    transaction.nonce = 1;
+    EXPECT_EQ(hex(transaction.signingHash()), hex(Hash::blake2b(transaction.encode(), 32)));
+
+    // the signature is not hashed
+    transaction.signature = Data(65, 1);
+    EXPECT_NE(hex(transaction.signingHash()), hex(Hash::blake2b(transaction.encode(), 32)));
+}
+
+TEST(Signer, SignSplit) {
+    const auto input = distributionInput(500);
+    const size_t maxSize = 16 * 1024;
+    const auto outputs = Signer::signSplit(input, maxSize, 3);
+    ASSERT_GT(outputs.size(), 1ul);
+
+    // same as signing each part alone
+    int clauses = 0;
+    for (size_t i = 0; i < outputs.size(); ++i) {
+        EXPECT_LE(outputs[i].encoded().size(), maxSize);
+        auto part = input;
+        part.set_nonce(input.nonce() + i);
+        part.clear_clauses();
+        for (; clauses < input.clauses_size(); ++clauses) {
+            auto next = part;
+            *next.add_clauses() = input.clauses(clauses);
+            if (Signer::sign(next).encoded().size() > maxSize) {
+                break;
+            }
+            part = next;
+        }
+        const auto expected = Signer::sign(part);
+        EXPECT_EQ(hex(outputs[i].encoded()), hex(expected.encoded()));
+        EXPECT_EQ(hex(outputs[i].signature()), hex(expected.signature()));
+    }
+    EXPECT_EQ(clauses, input.clauses_size());
+
+    // no split needed
+    const auto single = Signer::signSplit(distributionInput(3));
+    ASSERT_EQ(single.size(), 1ul);
+    EXPECT_EQ(hex(single[0].encoded()), hex(Signer::sign(distributionInput(3)).encoded()));
+
+    EXPECT_THROW(Signer::signSplit(input, 100), std::invalid_argument);
+}
+
+TEST(Signer, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = distributionInput(1 + i % 3);
+        input.set_nonce(i);
+        if (key != BatchKey::First) {
+            const auto privateKey = key == BatchKey::Invalid ? Data(32) : parse_hex("0x4f3edf983ac636a65a842ce7c78d9aa706d3b113bce9c46f30d7d21715b23b1d");
+            input.set_private_key(privateKey.data(), privateKey.size());
+        }
+        return input;
+    });
+}
+
 } // namespace TW::VeChain
@@ -7,6 +7,7 @@
 #include "../walletconsole/lib/CommandExecutor.h"
 #include "../walletconsole/lib/WalletConsole.h"
 #include "../walletconsole/lib/Util.h"
+#include "../walletconsole/lib/Batch.h"
 
 #include <sstream>
 #include <cstdio>
@@ -485,3 +486,60 @@ TEST(WalletConsole, harmonyAddressDerivation) {
     EXPECT_TRUE(res1.find("Result") != string::npos);
     EXPECT_TRUE(res1.find("rror") == string::npos);
 }
+
+static vector<nlohmann::json> runBatch(const string& input, size_t threadCount) {
+    stringstream ins(input);
+    stringstream outs;
+    Batch(ins, outs, threadCount).run();
+    vector<nlohmann::json> results;
+    string line;
+    while (getline(outs, line)) {
+        results.push_back(nlohmann::json::parse(line));
+    }
+    return results;
+}
+
+TEST(WalletConsoleBatch, deriveInOrder) {
+    const auto input =
+        "setMnemonic " + mnemonic1 + "\n"
+        "addrDP m/84'/0'/0'/0/0\n"
+        "{\"id\": \"x\", \"cmd\": \"addrDP\", \"args\": [\"m/84'/0'/0'/0/1\"]}\n"
+        "priDP m/84'/0'/0'/0/1\n"
+        "addr bc1q5mv7jf4uzyf0524sxzrpucdf6tnrd0maq9k8zv\n"
+        "addrDP _Invalid_\n"
+        "coin eth\n"
+        "addrDefault\n";
+    for (size_t threadCount : {1, 4}) {
+        const auto results = runBatch(input, threadCount);
+        ASSERT_EQ(results.size(), 8ul);
+        EXPECT_EQ(results[0]["result"], 24);
+        EXPECT_EQ(results[1]["id"], 2);
+        EXPECT_EQ(results[1]["result"], "bc1q5mv7jf4uzyf0524sxzrpucdf6tnrd0maq9k8zv");
+        EXPECT_EQ(results[2]["id"], "x");
+        EXPECT_EQ(results[2]["result"], "bc1qejkm69ert6jqrp2u4n0m6g9ds4ravas2dw3af0");
+        EXPECT_EQ(results[3]["result"], "5133262c125d7019da000e6639be23c1726083980862cfb7199f849109875d5b");
+        EXPECT_EQ(results[4]["result"], true);
+        EXPECT_TRUE(results[5].contains("error"));
+        EXPECT_EQ(results[6]["result"], "ethereum");
+        EXPECT_EQ(results[7]["cmd"], "addrDefault");
+        EXPECT_EQ(results[7]["result"].get<string>().substr(0, 2), "0x");
+    }
+}
+
+TEST(WalletConsoleBatch, addrRange) {
+    const auto results = runBatch("setMnemonic " + mnemonic1 + "\naddrRange 0 40\naddrRange 1 1 m/84'/0'/0'/0/0\n", 3);
+    ASSERT_EQ(results.size(), 3ul);
+    ASSERT_EQ(results[1]["result"].size(), 40ul);
+    EXPECT_EQ(results[1]["result"][0], "bc1q5mv7jf4uzyf0524sxzrpucdf6tnrd0maq9k8zv");
+    EXPECT_EQ(results[1]["result"][1], "bc1qejkm69ert6jqrp2u4n0m6g9ds4ravas2dw3af0");
+    EXPECT_EQ(results[2]["result"][0], results[1]["result"][1]);
+}
+
+TEST(WalletConsoleBatch, errors) {
+    const auto results = runBatch("addrDP m/84'/0'/0'/0/0\ncoin nosuchcoin\nfileW x y\n{\"cmd\": \n\nexit\naddrDefault\n", 0);
+    ASSERT_EQ(results.size(), 4ul);
+    EXPECT_EQ(results[0]["error"], "No mnemonic set");
+    EXPECT_EQ(results[1]["error"], "No such coin: nosuchcoin");
+    EXPECT_TRUE(results[2].contains("error"));
+    EXPECT_TRUE(results[3].contains("error"));
+}
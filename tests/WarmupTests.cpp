@@ -0,0 +1,44 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Warmup.h"
+#include "Coin.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "Secp256k1Comb.h"
+
+#include <TrustWalletCore/TWWarmup.h>
+
+#include <gtest/gtest.h>
+
+namespace TW {
+
+TEST(Warmup, Coins) {
+    const auto result = warmup({TWCoinTypeEthereum, TWCoinTypeBitcoin}, TWWarmupFlagsDefault);
+    EXPECT_GT(result.duration.count(), 0);
+    EXPECT_FALSE(result.tablesLocked);
+    const auto privateKey = PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646"));
+    EXPECT_EQ(deriveAddress(TWCoinTypeEthereum, privateKey), "0x9d8A62f656a8d1615C1294fd71e9CFb3E4855A4F");
+
+    // unknown coins are skipped
+    EXPECT_GT(warmup({static_cast<TWCoinType>(1)}, TWWarmupFlagsCoins).duration.count(), 0);
+}
+
+TEST(Warmup, LockTables) {
+    // locking is best effort, the tables are mapped either way
+    warmup({}, TWWarmupFlagsCurveTables | TWWarmupFlagsLockTables);
+    Secp256k1Comb::setWindow(Secp256k1Comb::defaultWindow + 1);
+    Secp256k1Comb::setWindow(Secp256k1Comb::defaultWindow);
+    EXPECT_TRUE(Secp256k1Comb::publicKey(Data(32, 1), true).has_value());
+}
+
+TEST(TWWarmup, All) {
+    EXPECT_GT(TWWarmup(nullptr, 0, TWWarmupFlagsDefault), 0u);
+    const enum TWCoinType coins[] = {TWCoinTypeEthereum};
+    EXPECT_GT(TWWarmup(coins, 1, TWWarmupFlagsCoins), 0u);
+}
+
+} // namespace TW
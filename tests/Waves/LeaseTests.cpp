@@ -99,6 +99,7 @@ TEST(WavesLease, jsonSerialize) {
             "\"3P9DEDP5VbyXQyKtXDUt2crRPn5B7gs6ujc\",\"senderPublicKey\":"
             "\"6mA8eQjie53kd4jbZrwL3ZhMBqCX6nzit1k55tR2X7zU\",\"timestamp\":"
             "1568973547102,\"type\":8,\"version\":2}");
+  ASSERT_EQ(tx1.buildJsonString(signature), json.dump());
 }
 
 TEST(WavesLease, jsonCancelSerialize) {
@@ -136,6 +137,7 @@ TEST(WavesLease, jsonCancelSerialize) {
               "bRowgpDVBxvG1rTrv82LnFdByQY\"],\"senderPublicKey\":"
               "\"6mA8eQjie53kd4jbZrwL3ZhMBqCX6nzit1k55tR2X7zU\",\"timestamp\":"
               "1568973547102,\"type\":9,\"version\":2}");
+    ASSERT_EQ(tx1.buildJsonString(signature), json.dump());
 }
 
 
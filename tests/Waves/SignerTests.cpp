@@ -8,6 +8,7 @@
 #include "PublicKey.h"
 #include "Waves/Signer.h"
 #include "Waves/Transaction.h"
+#include "BatchSigningHelper.h"
 
 #include <TrezorCrypto/sodium/keypair.h>
 #include <gtest/gtest.h>
@@ -59,3 +60,29 @@ TEST(WavesSigner, curve25519_pk_to_ed25519) {
     curve25519_pk_to_ed25519(r.data(), publicKeyCurve25519.data());
     EXPECT_EQ(hex(r), "ff84c4bfc095df25b01e48807715856d95af93d88c5b57f30cb0ce567ca4ce56");
 }
+
+TEST(WavesSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        auto input = Proto::SigningInput();
+        input.set_timestamp(int64_t(1526641218066) + i);
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "9864a747e1b97f131fabb6b447296c9b6f0201e79fb3c5356e6c77e89b6a806a"
+                                                                   : "afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5");
+        input.set_private_key(privateKey.data(), privateKey.size());
+        if (i % 10 == 9) {
+            auto& message = *input.mutable_lease_message();
+            message.set_amount(int64_t(100000) + i);
+            message.set_fee(int64_t(100000));
+            message.set_to("3P9DEDP5VbyXQyKtXDUt2crRPn5B7gs6ujc");
+        } else {
+            auto& message = *input.mutable_transfer_message();
+            message.set_amount(int64_t(100000000) + i);
+            message.set_asset(i % 2 == 0 ? Transaction::WAVES : "DacnEpaUVFRCYk8Fcd1F3cqUZuT4XG7qW9mRyoZD81zq");
+            message.set_fee(int64_t(100000));
+            message.set_fee_asset(Transaction::WAVES);
+            message.set_to("3P2uzAzX9XTu1t32GkWw68YFFLwtapWvDds");
+            message.set_attachment("payout");
+        }
+        return input;
+    });
+}
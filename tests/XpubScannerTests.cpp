@@ -0,0 +1,74 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "XpubScanner.h"
+#include "HDWallet.h"
+#include "HexCoding.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+namespace TW {
+
+const auto zpub = "zpub6rFR7y4Q2AijBEqTUquhVz398htDFrtymD9xYYfG1m4wAcvPhXNfE3EfH1r1ADqtfSdVCToUG868RvUUkgDKf31mGDtKsAYz2oz2AGutZYs";
+
+TEST(XpubScanner, PublicKeys) {
+    auto scanner = XpubScanner(zpub, TWCoinTypeBitcoin);
+    EXPECT_EQ(hex(scanner.publicKey(0, 4).bytes), "03995137c8eb3b223c904259e9b571a8939a0ec99b0717684c3936407ca8538c1b");
+    EXPECT_EQ(hex(scanner.publicKey(0, 11).bytes), "0226a07edd0227fa6bc36239c0bd4db83d5e488f8fb1eeb68f89a5be916aad2d60");
+    EXPECT_EQ(scanner.address(0, 4), "bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n");
+
+    for (uint32_t change = 0; change < 2; ++change) {
+        for (uint32_t index = 0; index < 5; ++index) {
+            const auto expected = HDWallet::getPublicKeyFromExtended(zpub, TWCoinTypeBitcoin, DerivationPath(TWPurposeBIP84, 0, 0, change, index));
+            ASSERT_TRUE(expected);
+            EXPECT_EQ(hex(scanner.publicKey(change, index).bytes), hex(expected->bytes));
+        }
+    }
+}
+
+TEST(XpubScanner, Addresses) {
+    auto scanner = XpubScanner(zpub, TWCoinTypeBitcoin);
+    const auto addresses = scanner.addresses(0, 3, 3);
+    ASSERT_EQ(addresses.size(), 3);
+    EXPECT_EQ(addresses[0], scanner.address(0, 3));
+    EXPECT_EQ(addresses[1], "bc1qm97vqzgj934vnaq9s53ynkyf9dgr05rargr04n");
+    EXPECT_EQ(addresses[2], scanner.address(0, 5));
+}
+
+TEST(XpubScanner, Scan) {
+    auto scanner = XpubScanner(zpub, TWCoinTypeBitcoin);
+    const auto used = std::set<std::string>{scanner.address(0, 1), scanner.address(0, 4)};
+
+    uint32_t generated = 0;
+    const auto next = scanner.scan(0, 5, [&](const std::string& address) {
+        ++generated;
+        return used.count(address) > 0;
+    });
+    EXPECT_EQ(next, 5);
+    EXPECT_EQ(generated, 10);
+
+    EXPECT_EQ(scanner.scan(1, 3, [](const std::string&) { return false; }), 0);
+    EXPECT_EQ(scanner.scan(1, 0, [](const std::string&) { return true; }), 0);
+}
+
+TEST(XpubScanner, FromPrivate) {
+    const auto xprv = "xprv9xpXFhFpqdQK3TmytPBqXtGSwS3DLjojFhTGht8gwAAii8py5X6pxeBnQ6ehJiyJ6nDjWGJfZ95WxByFXVkDxHXrqu53WCRGypk2ttuqncb";
+    const auto xpub = "xpub6BosfCnifzxcFwrSzQiqu2DBVTshkCXacvNsWGYJVVhhawA7d4R5WSWGFNbi8Aw6ZRc1brxMyWMzG3DSSSSoekkudhUd9yLb6qx39T9nMdj";
+    auto fromPrivate = XpubScanner(xprv, TWCoinTypeBitcoinCash);
+    auto fromPublic = XpubScanner(xpub, TWCoinTypeBitcoinCash);
+    EXPECT_EQ(hex(fromPublic.publicKey(0, 2).bytes), "0338994349b3a804c44bbec55c2824443ebb9e475dfdad14f4b1a01a97d42751b3");
+    EXPECT_EQ(fromPrivate.address(0, 2), fromPublic.address(0, 2));
+}
+
+TEST(XpubScanner, Invalid) {
+    EXPECT_THROW(XpubScanner("xpub0000", TWCoinTypeBitcoin), std::invalid_argument);
+    EXPECT_THROW(XpubScanner(zpub, TWCoinTypeSolana), std::invalid_argument);
+    EXPECT_THROW(XpubScanner(zpub, TWCoinTypeCardano), std::invalid_argument);
+}
+
+} // namespace TW
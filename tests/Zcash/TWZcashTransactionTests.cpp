@@ -11,6 +11,7 @@
 #include "Bitcoin/Script.h"
 #include "Zcash/TransactionBuilder.h"
 #include "Bitcoin/TransactionSigner.h"
+#include "Hash.h"
 #include "HexCoding.h"
 #include "PublicKey.h"
 #include "Data.h"
@@ -186,3 +187,41 @@ TEST(TWZcashTransaction, BlossomSigning) {
     signedTx.encode(serialized);
     ASSERT_EQ(hex(serialized), "0400008085202f8901de8c02c79c01018bd91dbc6b293eba03945be25762994409209a06d95c828123000000006b483045022100e6e5071811c08d0c2e81cb8682ee36a8c6b645f5c08747acd3e828de2a4d8a9602200b13b36a838c7e8af81f2d6e7e694ede28833a480cfbaaa68a47187655298a7f0121024bc2a31265153f07e70e0bab08724e6b85e217f8cd628ceb62974247bb493382ffffffff01cf440000000000001976a914c3bacb129d85288a3deb5890ca9b711f7f71392688ac00000000000000000000000000000000000000");
 }
+
+TEST(TWZcashTransaction, SignatureHashCache) {
+    auto transaction = Zcash::Transaction();
+    transaction.branchId = Zcash::SaplingBranchID;
+    transaction.inputs.emplace_back(Bitcoin::OutPoint(parse_hex("a8c685478265f4c14dada651969c45a65e1aeb8cd6791f2f5bb6a1d9952104d9"), 1), Bitcoin::Script(), 0xfffffffe);
+    transaction.inputs.emplace_back(Bitcoin::OutPoint(parse_hex("a8c685478265f4c14dada651969c45a65e1aeb8cd6791f2f5bb6a1d9952104d9"), 2), Bitcoin::Script(), 0xfffffffe);
+    transaction.outputs.emplace_back(0x02625a00, Bitcoin::Script(parse_hex("76a9148132712c3ff19f3a151234616777420a6d7ef22688ac")));
+    const auto scriptCode = Bitcoin::Script(parse_hex("76a914507173527b4c3318a2aecd793bf1cfed705950cf88ac"));
+
+    const auto sighash0 = transaction.getSignatureHash(scriptCode, 0, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE);
+    const auto sighash1 = transaction.getSignatureHash(scriptCode, 1, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE);
+
+    transaction.cacheSignatureHashes();
+    EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, 0, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE)), hex(sighash0));
+    EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, 1, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE)), hex(sighash1));
+
+    transaction.inputs[1].sequence = 0xffffffff;
+    transaction.clearSignatureHashCache();
+    EXPECT_NE(hex(transaction.getSignatureHash(scriptCode, 1, TWBitcoinSigHashTypeAll, 0x02faf080, Bitcoin::BASE)), hex(sighash1));
+}
+
+TEST(TWZcashTransaction, SignatureHashBranches) {
+    auto transaction = Zcash::Transaction();
+    transaction.inputs.emplace_back(Bitcoin::OutPoint(parse_hex("a8c685478265f4c14dada651969c45a65e1aeb8cd6791f2f5bb6a1d9952104d9"), 1), Bitcoin::Script(), 0xfffffffe);
+    transaction.outputs.emplace_back(0x02625a00, Bitcoin::Script(parse_hex("76a9148132712c3ff19f3a151234616777420a6d7ef22688ac")));
+    const auto scriptCode = Bitcoin::Script(parse_hex("76a914507173527b4c3318a2aecd793bf1cfed705950cf88ac"));
+
+    // precomputed hasher states of the known branches, and a fresh one for others, give the plain personalized hash
+    for (const auto& branchId : {Zcash::SaplingBranchID, Zcash::BlossomBranchID, std::array<byte, 4>{0x19, 0x1b, 0xa8, 0x5b}}) {
+        transaction.branchId = branchId;
+        for (const auto hashType : {TWBitcoinSigHashTypeAll, TWBitcoinSigHashTypeSingle, TWBitcoinSigHashTypeNone}) {
+            auto personalization = Data{'Z','c','a','s','h','S','i','g','H','a','s','h'};
+            append(personalization, Data(branchId.begin(), branchId.end()));
+            const auto preimage = transaction.getPreImage(scriptCode, 0, hashType, 0x02faf080);
+            EXPECT_EQ(hex(transaction.getSignatureHash(scriptCode, 0, hashType, 0x02faf080, Bitcoin::BASE)), hex(Hash::blake2b(preimage, 32, personalization)));
+        }
+    }
+}
@@ -4,12 +4,15 @@
 // terms governing use, modification, and redistribution, is contained in the
 // file LICENSE at the root of the source code distribution tree.
 
+#include "Hash.h"
 #include "HexCoding.h"
 #include "PrivateKey.h"
 #include "Zilliqa/Address.h"
 #include "Zilliqa/Signer.h"
+#include "Zilliqa/Protobuf/ZilliqaMessage.pb.h"
 #include "proto/Zilliqa.pb.h"
 #include "uint256.h"
+#include "BatchSigningHelper.h"
 
 #include <gtest/gtest.h>
 
@@ -108,3 +111,98 @@ TEST(ZilliqaSigner, SigningData) {
     ASSERT_EQ(output.json(), R"({"amount":"10000000000000","code":"","data":"{\"_tag\":\"DelegateStake\",\"params\":[{\"type\":\"ByStr20\",\"value\":\"0x122219cCeAb410901e96c3A0e55E46231480341b\",\"vname\":\"ssnaddr\"}]}","gasLimit":"5000","gasPrice":"2000000000","nonce":56,"pubKey":"03fb30b196ce3e976593ecc2da220dca9cdea8c84d2373770042a930b892ac0f5c","signature":"437fb5c3ce2c6b01f9d490f670539fae4533c82a21fa7edfe6b23df70d732937e8c578c8d6ed24be9150f5126f7b7c977a467af8947ef92a720908a761a6eb0d","toAddr":"43D459eC504C7432959c086B0ac7F7855E984306","version":65537})");
     ASSERT_EQ(hex(output.signature().begin(), output.signature().end()), "437fb5c3ce2c6b01f9d490f670539fae4533c82a21fa7edfe6b23df70d732937e8c578c8d6ed24be9150f5126f7b7c977a467af8947ef92a720908a761a6eb0d");    
 }
+
+namespace {
+
+/// Preimage serialized with the protobuf message, as it used to be
+Data protobufPreImage(const Proto::SigningInput& input, const Address& address, const PublicKey& pubKey) {
+    auto padded = [](std::string bytes) {
+        return bytes.size() < 16 ? std::string(16 - bytes.size(), '\0') + bytes : bytes;
+    };
+    auto internal = ZilliqaMessage::ProtoTransactionCoreInfo();
+    internal.set_version(input.version());
+    internal.set_nonce(input.nonce());
+    internal.set_toaddr(address.getKeyHash().data(), address.getKeyHash().size());
+    internal.set_gaslimit(input.gas_limit());
+    internal.mutable_senderpubkey()->set_data(pubKey.bytes.data(), pubKey.bytes.size());
+    internal.mutable_gasprice()->set_data(padded(input.gas_price()));
+    std::string amount;
+    if (input.transaction().has_transfer()) {
+        amount = input.transaction().transfer().amount();
+    } else if (input.transaction().has_raw_transaction()) {
+        const auto& raw = input.transaction().raw_transaction();
+        amount = raw.amount();
+        if (!raw.code().empty()) {
+            internal.set_code(raw.code());
+        }
+        if (!raw.data().empty()) {
+            internal.set_data(raw.data());
+        }
+    }
+    internal.mutable_amount()->set_data(padded(amount));
+    const auto serialized = internal.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+Proto::SigningInput rawInput(uint64_t nonce, const Data& key, const std::string& data) {
+    auto input = Proto::SigningInput();
+    auto& raw = *input.mutable_transaction()->mutable_raw_transaction();
+    const auto amount = store(uint256_t(10000000000000) + nonce);
+    raw.set_amount(amount.data(), amount.size());
+    raw.set_data(data);
+    if (nonce % 3 == 0) {
+        raw.set_code(std::string(200, 'c'));
+    }
+    const auto gasPrice = store(uint256_t(2000000000));
+    input.set_version(nonce % 2 == 0 ? 65537 : 0);
+    input.set_nonce(nonce);
+    input.set_to("zil1g029nmzsf36r99vupp4s43lhs40fsscx3jjpuy");
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(uint64_t(5000) << (nonce % 40));
+    input.set_private_key(key.data(), key.size());
+    return input;
+}
+
+} // namespace
+
+TEST(ZilliqaSigner, PreImageMatchesProtobuf) {
+    const auto key = parse_hex("0x68ffa8ec149ce50da647166036555f73d57f662eb420e154621e5f24f6cf9748");
+    const auto pubKey = PrivateKey(key).getPublicKey(TWPublicKeyTypeSECP256k1);
+    std::vector<Proto::SigningInput> inputs;
+    for (uint64_t nonce : {0ull, 1ull, 127ull, 128ull, 300ull, 1ull << 40}) {
+        inputs.push_back(rawInput(nonce, key, nonce % 2 == 0 ? std::string(130, 'd') : ""));
+    }
+    // no transaction, no amount
+    inputs.push_back(rawInput(5, key, ""));
+    inputs.back().clear_transaction();
+    // amount wider than 16 bytes
+    inputs.push_back(rawInput(7, key, "x"));
+    inputs.back().mutable_transaction()->mutable_raw_transaction()->set_amount(std::string(20, '\x01'));
+
+    for (const auto& input : inputs) {
+        Address address;
+        const auto preImage = Signer::getPreImage(input, address);
+        EXPECT_EQ(hex(preImage), hex(protobufPreImage(input, address, pubKey)));
+    }
+}
+
+TEST(ZilliqaSigner, ContextSignSchnorr) {
+    const auto privateKey = PrivateKey(parse_hex("0x68ffa8ec149ce50da647166036555f73d57f662eb420e154621e5f24f6cf9748"));
+    const auto context = SigningContext(privateKey.bytes);
+    EXPECT_EQ(hex(context.publicKey().bytes), hex(privateKey.getPublicKey(TWPublicKeyTypeSECP256k1).bytes));
+    for (int i = 0; i < 8; ++i) {
+        const auto message = Hash::sha256(Data{static_cast<byte>(i)});
+        const auto signature = context.signSchnorr(message);
+        EXPECT_EQ(hex(signature), hex(privateKey.signSchnorr(message, TWCurveSECP256k1)));
+        EXPECT_TRUE(context.publicKey().verifySchnorr(signature, message));
+    }
+}
+
+TEST(ZilliqaSigner, SignBatch) {
+    expectBatchSigning<Signer>([](size_t i, BatchKey key) {
+        const auto privateKey = key == BatchKey::Invalid ? Data(32)
+                                : parse_hex(key == BatchKey::First ? "0x68ffa8ec149ce50da647166036555f73d57f662eb420e154621e5f24f6cf9748"
+                                                                   : "0E891B9DFF485000C7D1DC22ECF3A583CC50328684321D61947A86E57CF6C638");
+        return rawInput(i, privateKey, i % 2 == 0 ? "withdrawal" : "");
+    });
+}
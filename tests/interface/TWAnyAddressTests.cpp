@@ -134,3 +134,12 @@ TEST(AnyAddress, Data) {
         assertHexEqual(pubkey, "3b83b07cab54824a59c3d3f2e203a7cd913b7fcdc4439595983e2402c2cf791d");
     }
 }
+
+TEST(AnyAddress, ValidateAddresses) {
+    auto addresses = STRING("1BvBMSEYstWetqTFn5Au4m4GFg7xJaNVN2\nMPmoY6RX3Y3HFjGEnFxyuLPCQdjvHwMEny\n\nbc1q2ddhp55sq2l4xnqhpdv0xazg02v9dr7uu8c2p2");
+    auto result = WRAPD(TWAnyAddressValidateAddresses(addresses.get(), TWCoinTypeBitcoin));
+    assertHexEqual(result, "01000001");
+
+    auto empty = WRAPD(TWAnyAddressValidateAddresses(STRING("").get(), TWCoinTypeBitcoin));
+    EXPECT_EQ(TWDataSize(empty.get()), 0);
+}
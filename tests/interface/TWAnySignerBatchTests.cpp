@@ -0,0 +1,110 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Ethereum.pb.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace TW;
+
+static Data ethereumInput(uint64_t nonce) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonceData = store(uint256_t(nonce));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonceData.data(), nonceData.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return Data(serialized.begin(), serialized.end());
+}
+
+TEST(TWAnySignerBatch, Sign) {
+    const auto batch = std::shared_ptr<TWAnySignerBatch>(TWAnySignerBatchCreate(), TWAnySignerBatchDelete);
+    std::vector<std::shared_ptr<TWData>> expected;
+    for (auto i = 0; i < 20; ++i) {
+        const auto data = ethereumInput(i);
+        const auto input = WRAPD(TWDataCreateWithBytes(data.data(), data.size()));
+        expected.push_back(WRAPD(TWAnySignerSign(input.get(), TWCoinTypeEthereum)));
+        EXPECT_EQ(TWAnySignerBatchAdd(batch.get(), input.get(), TWCoinTypeEthereum), i);
+    }
+    const auto unsupported = DATA("0a0b0c");
+    EXPECT_EQ(TWAnySignerBatchAdd(batch.get(), unsupported.get(), static_cast<TWCoinType>(1)), 20);
+    ASSERT_EQ(TWAnySignerBatchSize(batch.get()), 21);
+
+    for (const auto threadCount : {1u, 4u, 0u}) {
+        TWAnySignerSignBatch(batch.get(), threadCount);
+        for (auto i = 0; i < 20; ++i) {
+            EXPECT_EQ(TWAnySignerBatchGetError(batch.get(), i), TWAnySignerBatchErrorNone);
+            const auto output = WRAPD(TWAnySignerBatchOutput(batch.get(), i));
+            ASSERT_GT(TWDataSize(output.get()), 0ul);
+            EXPECT_TRUE(TWDataEqual(output.get(), expected[i].get())) << i;
+        }
+        EXPECT_EQ(TWAnySignerBatchGetError(batch.get(), 20), TWAnySignerBatchErrorUnsupportedCoin);
+        EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerBatchOutput(batch.get(), 20)).get()), 0ul);
+    }
+
+    // out of range
+    EXPECT_EQ(TWAnySignerBatchGetError(batch.get(), 21), TWAnySignerBatchErrorSigningFailed);
+    EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerBatchOutput(batch.get(), -1)).get()), 0ul);
+}
+
+TEST(TWAnySignerBatch, Empty) {
+    const auto batch = std::shared_ptr<TWAnySignerBatch>(TWAnySignerBatchCreate(), TWAnySignerBatchDelete);
+    TWAnySignerSignBatch(batch.get(), 0);
+    EXPECT_EQ(TWAnySignerBatchSize(batch.get()), 0);
+    EXPECT_EQ(TWAnySignerBatchGetError(batch.get(), 0), TWAnySignerBatchErrorSigningFailed);
+}
+
+TEST(TWAnySigner, SignBytes) {
+    const auto data = ethereumInput(9);
+    const auto expected = WRAPD(TWAnySignerSign(WRAPD(TWDataCreateWithBytes(data.data(), data.size())).get(), TWCoinTypeEthereum));
+    const auto expectedSize = TWDataSize(expected.get());
+
+    // size query
+    EXPECT_EQ(TWAnySignerSignBytes(data.data(), data.size(), TWCoinTypeEthereum, nullptr, 0), expectedSize);
+
+    std::vector<uint8_t> output(expectedSize - 1, 0);
+    EXPECT_EQ(TWAnySignerSignBytes(data.data(), data.size(), TWCoinTypeEthereum, output.data(), output.size()), expectedSize);
+    EXPECT_EQ(output, std::vector<uint8_t>(expectedSize - 1, 0));
+
+    output.resize(4096);
+    ASSERT_EQ(TWAnySignerSignBytes(data.data(), data.size(), TWCoinTypeEthereum, output.data(), output.size()), expectedSize);
+    EXPECT_TRUE(std::equal(output.begin(), output.begin() + expectedSize, TWDataBytes(expected.get())));
+}
+
+TEST(TWAnySignerBatch, Bytes) {
+    const auto batch = std::shared_ptr<TWAnySignerBatch>(TWAnySignerBatchCreate(), TWAnySignerBatchDelete);
+    const auto data = ethereumInput(3);
+    EXPECT_EQ(TWAnySignerBatchAddBytes(batch.get(), data.data(), data.size(), TWCoinTypeEthereum), 0);
+    TWAnySignerSignBatch(batch.get(), 1);
+
+    const auto expected = WRAPD(TWAnySignerBatchOutput(batch.get(), 0));
+    const auto expectedSize = TWDataSize(expected.get());
+    ASSERT_GT(expectedSize, 0ul);
+    EXPECT_EQ(TWAnySignerBatchOutputBytes(batch.get(), 0, nullptr, 0), expectedSize);
+
+    std::vector<uint8_t> output(expectedSize);
+    ASSERT_EQ(TWAnySignerBatchOutputBytes(batch.get(), 0, output.data(), output.size()), expectedSize);
+    EXPECT_TRUE(std::equal(output.begin(), output.end(), TWDataBytes(expected.get())));
+    EXPECT_EQ(TWAnySignerBatchOutputBytes(batch.get(), 1, output.data(), output.size()), 0ul);
+}
@@ -0,0 +1,235 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+
+#include "Base58.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "uint256.h"
+#include "Cosmos/Address.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Cosmos.pb.h"
+#include "proto/Ethereum.pb.h"
+#include "proto/NEAR.pb.h"
+#include "proto/TxCompiler.pb.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <vector>
+
+using namespace TW;
+
+static const auto bitcoinKey0 = PrivateKey(parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866"));
+static const auto bitcoinKey1 = PrivateKey(parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9"));
+static const auto ethereumKey = PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646"));
+static const auto cosmosKey = PrivateKey(parse_hex("80e81ea269e66a0a05b11236df7919fb7fbeedba87452d667489d7403a02f005"));
+static const auto nearKey = PrivateKey(parse_hex("8737b99bf16fba78e1e753e23ba00c4b5423ac9c45d9b9caae9a519434786568"));
+
+template <typename Input>
+static std::shared_ptr<TWData> serialized(const Input& input) {
+    const auto serialized = input.SerializeAsString();
+    return WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+}
+
+static std::shared_ptr<TWData> bitcoinInput(DataView key0, DataView key1) {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(1);
+    input.set_amount(300'000'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    input.add_private_key(key0.data(), key0.size());
+    input.add_private_key(key1.data(), key1.size());
+    const auto addUtxo = [&input](const std::string& script, const std::string& hash, uint32_t index) {
+        const auto scriptData = parse_hex(script);
+        const auto hashData = parse_hex(hash);
+        auto utxo = input.add_utxo();
+        utxo->set_script(scriptData.data(), scriptData.size());
+        utxo->set_amount(210'000'000);
+        utxo->mutable_out_point()->set_hash(hashData.data(), hashData.size());
+        utxo->mutable_out_point()->set_index(index);
+        utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+    };
+    addUtxo("76a914b7cd046b6d522a3d61dbcb5235c0e9cc9726545788ac", "fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f", 0);
+    addUtxo("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1", "ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a", 1);
+    return serialized(input);
+}
+
+static std::shared_ptr<TWData> ethereumInput(DataView key) {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    return serialized(input);
+}
+
+static std::shared_ptr<TWData> cosmosInput(DataView key, Cosmos::Proto::SigningMode mode) {
+    Cosmos::Proto::SigningInput input;
+    input.set_signing_mode(mode);
+    input.set_account_number(1037);
+    input.set_chain_id("gaia-13003");
+    input.set_sequence(8);
+    auto& message = *input.add_messages()->mutable_send_coins_message();
+    message.set_from_address(Cosmos::Address("cosmos", parse_hex("BC2DA90C84049370D1B7C528BC164BC588833F21")).string());
+    message.set_to_address(Cosmos::Address("cosmos", parse_hex("12E8FE8B81ECC1F4F774EA6EC8DF267138B9F2D9")).string());
+    auto& amount = *message.add_amounts();
+    amount.set_denom("muon");
+    amount.set_amount(1);
+    auto& fee = *input.mutable_fee();
+    fee.set_gas(200000);
+    auto& feeAmount = *fee.add_amounts();
+    feeAmount.set_denom("muon");
+    feeAmount.set_amount(200);
+    input.set_private_key(key.data(), key.size());
+    return serialized(input);
+}
+
+static std::shared_ptr<TWData> nearInput(DataView key) {
+    NEAR::Proto::SigningInput input;
+    input.set_signer_id("test.near");
+    input.set_nonce(1);
+    input.set_receiver_id("whatever.near");
+    Data deposit(16, 0);
+    deposit[0] = 1;
+    input.add_actions()->mutable_transfer()->set_deposit(deposit.data(), deposit.size());
+    const auto blockHash = Base58::bitcoin.decode("244ZQ9cgj3CQ6bWBdytfrJMuMQ1jdXLFGnr4HhvtCTnM");
+    input.set_block_hash(blockHash.data(), blockHash.size());
+    input.set_private_key(key.data(), key.size());
+    return serialized(input);
+}
+
+static TxCompiler::Proto::PreSigningOutput preImageHashes(const std::shared_ptr<TWData>& input, TWCoinType coin) {
+    const auto data = WRAPD(TWAnySignerPreImageHashes(input.get(), coin));
+    TxCompiler::Proto::PreSigningOutput output;
+    EXPECT_TRUE(output.ParseFromArray(TWDataBytes(data.get()), static_cast<int>(TWDataSize(data.get()))));
+    return output;
+}
+
+/// The signatures of the digests, as a signing node makes them: 64 bytes, without the recovery id.
+static std::shared_ptr<TWData> signHashes(const TxCompiler::Proto::PreSigningOutput& output, const std::map<Data, PrivateKey>& keys) {
+    Data signatures;
+    for (const auto& hash : output.hashes()) {
+        const auto publicKey = PublicKey(Data(hash.public_key().begin(), hash.public_key().end()),
+                                         static_cast<TWPublicKeyType>(hash.public_key_type()));
+        const auto& key = keys.at(publicKey.compressed().bytes.toData());
+        auto signature = key.sign(Data(hash.digest().begin(), hash.digest().end()), static_cast<TWCurve>(hash.curve()));
+        signature.resize(64);
+        append(signatures, signature);
+    }
+    return WRAPD(TWDataCreateWithBytes(signatures.data(), signatures.size()));
+}
+
+TEST(TWAnySignerCompile, Bitcoin) {
+    const auto expected = WRAPD(TWAnySignerSign(bitcoinInput(bitcoinKey0.bytes, bitcoinKey1.bytes).get(), TWCoinTypeBitcoin));
+
+    const auto publicKey0 = bitcoinKey0.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto publicKey1 = bitcoinKey1.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto input = bitcoinInput(publicKey0.bytes, publicKey1.bytes);
+    const auto hashes = preImageHashes(input, TWCoinTypeBitcoin);
+    ASSERT_EQ(hashes.error(), Common::Proto::OK);
+    ASSERT_EQ(hashes.hashes_size(), 2);
+    EXPECT_EQ(hashes.hashes(0).curve(), static_cast<uint32_t>(TWCurveSECP256k1));
+    EXPECT_EQ(hex(hashes.hashes(0).public_key()), hex(publicKey0.bytes));
+    EXPECT_EQ(hex(hashes.hashes(1).public_key()), hex(publicKey1.bytes));
+
+    const auto signatures = signHashes(hashes, {{publicKey0.bytes.toData(), bitcoinKey0}, {publicKey1.bytes.toData(), bitcoinKey1}});
+    const auto output = WRAPD(TWAnySignerCompileWithSignatures(input.get(), signatures.get(), TWCoinTypeBitcoin));
+    EXPECT_EQ(hex(*reinterpret_cast<const Data*>(output.get())), hex(*reinterpret_cast<const Data*>(expected.get())));
+
+    // the signatures of other digests, or too few of them, make no transaction
+    const auto swapped = signHashes(hashes, {{publicKey0.bytes.toData(), bitcoinKey1}, {publicKey1.bytes.toData(), bitcoinKey0}});
+    Bitcoin::Proto::SigningOutput failed;
+    const auto swappedOutput = WRAPD(TWAnySignerCompileWithSignatures(input.get(), swapped.get(), TWCoinTypeBitcoin));
+    ASSERT_TRUE(failed.ParseFromArray(TWDataBytes(swappedOutput.get()), static_cast<int>(TWDataSize(swappedOutput.get()))));
+    EXPECT_NE(failed.error(), Common::Proto::OK);
+    const auto one = WRAPD(TWDataCreateWithBytes(TWDataBytes(signatures.get()), 64));
+    EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerCompileWithSignatures(input.get(), one.get(), TWCoinTypeBitcoin)).get()), 0ul);
+}
+
+TEST(TWAnySignerCompile, Ethereum) {
+    const auto expected = WRAPD(TWAnySignerSign(ethereumInput(ethereumKey.bytes).get(), TWCoinTypeEthereum));
+
+    const auto publicKey = ethereumKey.getPublicKey(TWPublicKeyTypeSECP256k1Extended);
+    const auto input = ethereumInput(publicKey.bytes);
+    const auto hashes = preImageHashes(input, TWCoinTypeEthereum);
+    ASSERT_EQ(hashes.error(), Common::Proto::OK);
+    ASSERT_EQ(hashes.hashes_size(), 1);
+
+    const auto signatures = signHashes(hashes, {{publicKey.compressed().bytes.toData(), ethereumKey}});
+    const auto output = WRAPD(TWAnySignerCompileWithSignatures(input.get(), signatures.get(), TWCoinTypeEthereum));
+    EXPECT_TRUE(TWDataEqual(output.get(), expected.get()));
+
+    const auto truncated = WRAPD(TWDataCreateWithBytes(TWDataBytes(signatures.get()), 63));
+    EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerCompileWithSignatures(input.get(), truncated.get(), TWCoinTypeEthereum)).get()), 0ul);
+}
+
+TEST(TWAnySignerCompile, Cosmos) {
+    const auto publicKey = cosmosKey.getPublicKey(TWPublicKeyTypeSECP256k1);
+    for (const auto mode : {Cosmos::Proto::JSON, Cosmos::Proto::Protobuf}) {
+        const auto expected = WRAPD(TWAnySignerSign(cosmosInput(cosmosKey.bytes, mode).get(), TWCoinTypeCosmos));
+
+        const auto input = cosmosInput(publicKey.bytes, mode);
+        const auto hashes = preImageHashes(input, TWCoinTypeCosmos);
+        ASSERT_EQ(hashes.error(), Common::Proto::OK) << mode;
+        ASSERT_EQ(hashes.hashes_size(), 1) << mode;
+        EXPECT_EQ(hashes.hashes(0).curve(), static_cast<uint32_t>(TWCurveSECP256k1)) << mode;
+        EXPECT_EQ(hex(hashes.hashes(0).public_key()), hex(publicKey.bytes)) << mode;
+
+        const auto signatures = signHashes(hashes, {{publicKey.bytes.toData(), cosmosKey}});
+        const auto output = WRAPD(TWAnySignerCompileWithSignatures(input.get(), signatures.get(), TWCoinTypeCosmos));
+        EXPECT_TRUE(TWDataEqual(output.get(), expected.get())) << mode;
+
+        const auto wrong = signHashes(hashes, {{publicKey.bytes.toData(), ethereumKey}});
+        Cosmos::Proto::SigningOutput failed;
+        const auto wrongOutput = WRAPD(TWAnySignerCompileWithSignatures(input.get(), wrong.get(), TWCoinTypeCosmos));
+        ASSERT_TRUE(failed.ParseFromArray(TWDataBytes(wrongOutput.get()), static_cast<int>(TWDataSize(wrongOutput.get()))));
+        EXPECT_NE(failed.error(), Common::Proto::OK) << mode;
+    }
+}
+
+TEST(TWAnySignerCompile, NEAR) {
+    const auto expected = WRAPD(TWAnySignerSign(nearInput(nearKey.bytes).get(), TWCoinTypeNEAR));
+
+    // an ed25519 key is referenced as 0x01 || public key, 32 bytes being a private key
+    const auto publicKey = nearKey.getPublicKey(TWPublicKeyTypeED25519);
+    auto reference = Data{0x01};
+    append(reference, publicKey.bytes.toData());
+    const auto input = nearInput(reference);
+    const auto hashes = preImageHashes(input, TWCoinTypeNEAR);
+    ASSERT_EQ(hashes.error(), Common::Proto::OK);
+    ASSERT_EQ(hashes.hashes_size(), 1);
+    EXPECT_EQ(hashes.hashes(0).curve(), static_cast<uint32_t>(TWCurveED25519));
+    EXPECT_EQ(hex(hashes.hashes(0).public_key()), hex(publicKey.bytes));
+
+    const auto signatures = signHashes(hashes, {{publicKey.bytes.toData(), nearKey}});
+    const auto output = WRAPD(TWAnySignerCompileWithSignatures(input.get(), signatures.get(), TWCoinTypeNEAR));
+    EXPECT_TRUE(TWDataEqual(output.get(), expected.get()));
+
+    const auto wrong = signHashes(hashes, {{publicKey.bytes.toData(), cosmosKey}});
+    EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerCompileWithSignatures(input.get(), wrong.get(), TWCoinTypeNEAR)).get()), 0ul);
+}
+
+TEST(TWAnySignerCompile, Unsupported) {
+    // the Decred signer takes private keys only
+    const auto publicKey0 = bitcoinKey0.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto publicKey1 = bitcoinKey1.getPublicKey(TWPublicKeyTypeSECP256k1);
+    const auto hashes = preImageHashes(bitcoinInput(publicKey0.bytes, publicKey1.bytes), TWCoinTypeDecred);
+    EXPECT_EQ(hashes.hashes_size(), 0);
+    EXPECT_EQ(hashes.error(), Common::Proto::Error_signing);
+}
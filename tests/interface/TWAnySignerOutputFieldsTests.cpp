@@ -0,0 +1,112 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+
+#include "HexCoding.h"
+#include "SigningOutputFields.h"
+#include "uint256.h"
+#include "proto/Bitcoin.pb.h"
+#include "proto/Ethereum.pb.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+
+#include <gtest/gtest.h>
+
+using namespace TW;
+
+static std::shared_ptr<TWData> bitcoinInput() {
+    Bitcoin::Proto::SigningInput input;
+    input.set_hash_type(1);
+    input.set_amount(300'000'000);
+    input.set_byte_fee(1);
+    input.set_to_address("1Bp9U1ogV3A14FMvKbRJms7ctyso4Z4Tcx");
+    input.set_change_address("1FQc5LdgGHMHEN9nwkjmz6tWkxhPpxBvBU");
+    const auto key0 = parse_hex("bbc27228ddcb9209d7fd6f36b02f7dfa6252af40bb2f1cbc7a557da8027ff866");
+    const auto key1 = parse_hex("619c335025c7f4012e556c2a58b2506e30b8511b53ade95ea316fd8c3286feb9");
+    input.add_private_key(key0.data(), key0.size());
+    input.add_private_key(key1.data(), key1.size());
+    const auto addUtxo = [&input](const std::string& script, const std::string& hash, uint32_t index) {
+        const auto scriptData = parse_hex(script);
+        const auto hashData = parse_hex(hash);
+        auto utxo = input.add_utxo();
+        utxo->set_script(scriptData.data(), scriptData.size());
+        utxo->set_amount(210'000'000);
+        utxo->mutable_out_point()->set_hash(hashData.data(), hashData.size());
+        utxo->mutable_out_point()->set_index(index);
+        utxo->mutable_out_point()->set_sequence(UINT32_MAX);
+    };
+    addUtxo("76a914b7cd046b6d522a3d61dbcb5235c0e9cc9726545788ac", "fff7f7881a8099afa6940d42d1e7f6362bec38171ea3edf433541db4e4ad969f", 0);
+    addUtxo("00141d0f172a0ecb48aee1be1f2687d2963ae33f71a1", "ef51e1b804cc89d182d279655c3aa89e815b1b309fe287d9b2b55d57b90ec68a", 1);
+    const auto serialized = input.SerializeAsString();
+    return WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+}
+
+static std::shared_ptr<TWData> ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+}
+
+template <typename Output>
+static Output parse(const std::shared_ptr<TWData>& data) {
+    Output output;
+    EXPECT_TRUE(output.ParseFromArray(TWDataBytes(data.get()), static_cast<int>(TWDataSize(data.get()))));
+    return output;
+}
+
+TEST(TWAnySignerOutputFields, Bitcoin) {
+    const auto input = bitcoinInput();
+    const auto full = parse<Bitcoin::Proto::SigningOutput>(WRAPD(TWAnySignerSign(input.get(), TWCoinTypeBitcoin)));
+    ASSERT_EQ(full.error(), Common::Proto::OK);
+    EXPECT_TRUE(full.has_transaction());
+
+    const auto broadcast = parse<Bitcoin::Proto::SigningOutput>(WRAPD(TWAnySignerSignWithFields(
+        input.get(), TWCoinTypeBitcoin, TWAnySignerOutputFieldEncoded | TWAnySignerOutputFieldTransactionId)));
+    EXPECT_FALSE(broadcast.has_transaction());
+    EXPECT_EQ(hex(broadcast.encoded()), hex(full.encoded()));
+    EXPECT_EQ(broadcast.transaction_id(), full.transaction_id());
+
+    const auto id = parse<Bitcoin::Proto::SigningOutput>(
+        WRAPD(TWAnySignerSignWithFields(input.get(), TWCoinTypeBitcoin, TWAnySignerOutputFieldTransactionId)));
+    EXPECT_TRUE(id.encoded().empty());
+    EXPECT_EQ(id.transaction_id(), full.transaction_id());
+
+    // the scope ends with the call
+    EXPECT_EQ(SigningOutputFields::current(), static_cast<uint32_t>(TWAnySignerOutputFieldAll));
+}
+
+TEST(TWAnySignerOutputFields, Ethereum) {
+    const auto input = ethereumInput();
+    const auto full = parse<Ethereum::Proto::SigningOutput>(WRAPD(TWAnySignerSign(input.get(), TWCoinTypeEthereum)));
+    ASSERT_FALSE(full.encoded().empty());
+
+    const auto encoded = parse<Ethereum::Proto::SigningOutput>(
+        WRAPD(TWAnySignerSignWithFields(input.get(), TWCoinTypeEthereum, TWAnySignerOutputFieldEncoded)));
+    EXPECT_EQ(hex(encoded.encoded()), hex(full.encoded()));
+    EXPECT_TRUE(encoded.v().empty());
+    EXPECT_TRUE(encoded.r().empty());
+    EXPECT_TRUE(encoded.s().empty());
+
+    const auto signature = parse<Ethereum::Proto::SigningOutput>(
+        WRAPD(TWAnySignerSignWithFields(input.get(), TWCoinTypeEthereum, TWAnySignerOutputFieldSignature)));
+    EXPECT_TRUE(signature.encoded().empty());
+    EXPECT_EQ(hex(signature.r()), hex(full.r()));
+    EXPECT_EQ(hex(signature.s()), hex(full.s()));
+}
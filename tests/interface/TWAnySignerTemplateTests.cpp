@@ -0,0 +1,267 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+
+#include "Coin.h"
+#include "HexCoding.h"
+#include "SigningTemplate.h"
+#include "uint256.h"
+#include "proto/Aion.pb.h"
+#include "proto/Ethereum.pb.h"
+#include "proto/Harmony.pb.h"
+#include "proto/Theta.pb.h"
+#include "proto/Tron.pb.h"
+#include "proto/VeChain.pb.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWAnySignerTemplate.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace TW;
+
+static std::shared_ptr<TWData> serialize(const google::protobuf::Message& message) {
+    const auto serialized = message.SerializeAsString();
+    return WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+}
+
+/// Expects the template outputs to be those of TWAnySignerSign for the inputs patched by `patchInput`.
+template <typename Input, typename Patcher>
+static void expectTemplateSigning(TWCoinType coin, const Input& base, const std::vector<SigningPatch>& patches, Patcher patchInput) {
+    const auto signerTemplate = WRAP(TWAnySignerTemplate, TWAnySignerTemplateCreate(serialize(base).get(), coin));
+    ASSERT_TRUE(signerTemplate != nullptr);
+    for (size_t i = 0; i < patches.size(); ++i) {
+        const auto& patch = patches[i];
+        auto input = base;
+        patchInput(input, patch);
+        const auto expected = WRAPD(TWAnySignerSign(serialize(input).get(), coin));
+        ASSERT_GT(TWDataSize(expected.get()), 0ul);
+
+        const auto amount = WRAPD(TWDataCreateWithBytes(patch.amount.data(), patch.amount.size()));
+        const auto output = WRAPD(TWAnySignerTemplateSign(signerTemplate.get(), patch.nonce, STRING(patch.toAddress.c_str()).get(), amount.get()));
+        EXPECT_EQ(hex(*reinterpret_cast<const Data*>(output.get())), hex(*reinterpret_cast<const Data*>(expected.get()))) << i;
+    }
+}
+
+static Ethereum::Proto::SigningInput ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_private_key(key.data(), key.size());
+    return input;
+}
+
+static const std::vector<SigningPatch> ethereumPatches = {
+    {0, "0x3535353535353535353535353535353535353535", store(uint256_t(1000000000000000000))},
+    {9, "0x5322b34c88ed0691971bf52a7047448f0f4efc84", store(uint256_t("10000000000000000000000000"))},
+    {200, "0x6b175474e89094c44da98b954eedeac495271d0f", Data()},
+};
+
+TEST(TWAnySignerTemplate, EthereumTransfer) {
+    auto input = ethereumInput();
+    input.mutable_transaction()->mutable_transfer()->set_data("memo");
+    expectTemplateSigning(TWCoinTypeEthereum, input, ethereumPatches, [](auto& input, const SigningPatch& patch) {
+        const auto nonce = store(uint256_t(patch.nonce));
+        input.set_nonce(nonce.data(), nonce.size());
+        input.set_to_address(patch.toAddress);
+        input.mutable_transaction()->mutable_transfer()->set_amount(patch.amount.data(), patch.amount.size());
+    });
+    input = ethereumInput();
+    input.mutable_transaction()->mutable_transfer();
+    expectTemplateSigning(TWCoinTypeSmartChain, input, ethereumPatches, [](auto& input, const SigningPatch& patch) {
+        const auto nonce = store(uint256_t(patch.nonce));
+        input.set_nonce(nonce.data(), nonce.size());
+        input.set_to_address(patch.toAddress);
+        input.mutable_transaction()->mutable_transfer()->set_amount(patch.amount.data(), patch.amount.size());
+    });
+}
+
+TEST(TWAnySignerTemplate, EthereumERC20Transfer) {
+    auto input = ethereumInput();
+    input.set_to_address("0x6b175474e89094c44da98b954eedeac495271d0f");
+    input.mutable_transaction()->mutable_erc20_transfer();
+    expectTemplateSigning(TWCoinTypeEthereum, input, ethereumPatches, [](auto& input, const SigningPatch& patch) {
+        const auto nonce = store(uint256_t(patch.nonce));
+        input.set_nonce(nonce.data(), nonce.size());
+        auto& transfer = *input.mutable_transaction()->mutable_erc20_transfer();
+        transfer.set_to(patch.toAddress);
+        transfer.set_amount(patch.amount.data(), patch.amount.size());
+    });
+}
+
+TEST(TWAnySignerTemplate, Harmony) {
+    Harmony::Proto::SigningInput input;
+    const auto key = parse_hex("4edef2c24995d15b0e25cbd152fb0e2c05d3b79b9c2afd134e6f59f91bf99e48");
+    input.set_private_key(key.data(), key.size());
+    const auto chainId = store(uint256_t(2));
+    input.set_chain_id(chainId.data(), chainId.size());
+    auto& transaction = *input.mutable_transaction_message();
+    const auto gasLimit = store(uint256_t(21000));
+    transaction.set_gas_limit(gasLimit.data(), gasLimit.size());
+    const auto fromShard = store(uint256_t(1));
+    transaction.set_from_shard_id(fromShard.data(), fromShard.size());
+
+    const auto patches = std::vector<SigningPatch>{
+        {1, "one129r9pj3sk0re76f7zs3qz92rggmdgjhtwge62k", store(uint256_t("0x6bfc8da5ee8220000"))},
+        {2, "one1d2rngmem4x2c6zxsjjz29dlah0jzkr0k2n88wc", store(uint256_t(1))},
+    };
+    expectTemplateSigning(TWCoinTypeHarmony, input, patches, [](auto& input, const SigningPatch& patch) {
+        auto& transaction = *input.mutable_transaction_message();
+        const auto nonce = store(uint256_t(patch.nonce));
+        transaction.set_nonce(nonce.data(), nonce.size());
+        transaction.set_to_address(patch.toAddress);
+        transaction.set_amount(patch.amount.data(), patch.amount.size());
+    });
+}
+
+TEST(TWAnySignerTemplate, Aion) {
+    Aion::Proto::SigningInput input;
+    const auto key = parse_hex("db33ffdf82c7ba903daf68d961d3c23c20471a8ce6b408e52d579fd8add80cc9");
+    input.set_private_key(key.data(), key.size());
+    const auto gasPrice = store(uint256_t(20000000000));
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    const auto gasLimit = store(uint256_t(21000));
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_timestamp(155157377101);
+
+    const auto patches = std::vector<SigningPatch>{
+        {9, "0xa082c3de528b7807dc27ad66debb16d4cfe4054209398cee619dd95955063d1e", store(uint256_t(10000))},
+        {10, "0xa0d2312facea71b740679c926d040c9056a65a4bfa2ddd18ec160064f82909e7", store(uint256_t(20000))},
+    };
+    expectTemplateSigning(TWCoinTypeAion, input, patches, [](auto& input, const SigningPatch& patch) {
+        const auto nonce = store(uint256_t(patch.nonce));
+        input.set_nonce(nonce.data(), nonce.size());
+        input.set_to_address(patch.toAddress);
+        input.set_amount(patch.amount.data(), patch.amount.size());
+    });
+}
+
+TEST(TWAnySignerTemplate, VeChain) {
+    VeChain::Proto::SigningInput input;
+    input.set_chain_tag(1);
+    input.set_block_ref(1);
+    input.set_expiration(1);
+    input.set_gas(21000);
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_private_key(key.data(), key.size());
+    input.add_clauses();
+
+    const auto patches = std::vector<SigningPatch>{
+        {1, "0x3535353535353535353535353535353535353535", parse_hex("31303030")},
+        {2, "0x5322b34c88ed0691971bf52a7047448f0f4efc84", store(uint256_t(5))},
+    };
+    expectTemplateSigning(TWCoinTypeVeChain, input, patches, [](auto& input, const SigningPatch& patch) {
+        input.set_nonce(patch.nonce);
+        input.mutable_clauses(0)->set_to(patch.toAddress);
+        input.mutable_clauses(0)->set_value(patch.amount.data(), patch.amount.size());
+    });
+
+    // the patch applies to a single clause
+    input.add_clauses();
+    EXPECT_EQ(TWAnySignerTemplateCreate(serialize(input).get(), TWCoinTypeVeChain), nullptr);
+}
+
+TEST(TWAnySignerTemplate, Theta) {
+    Theta::Proto::SigningInput input;
+    input.set_chain_id("privatenet");
+    const auto key = parse_hex("93a90ea508331dfdf27fb79757d4250b4e84954927ba0073cd67454ac432c737");
+    input.set_private_key(key.data(), key.size());
+    const auto fee = store(uint256_t(1000000000000));
+    input.set_fee(fee.data(), fee.size());
+
+    const auto patches = std::vector<SigningPatch>{
+        {1, "0x9F1233798E905E173560071255140b4A8aBd3Ec6", store(uint256_t(20))},
+        {2, "0x2E833968E5bB786Ae419c4d13189fB081Cc43bab", store(uint256_t(1000))},
+    };
+    expectTemplateSigning(TWCoinTypeTheta, input, patches, [](auto& input, const SigningPatch& patch) {
+        input.set_sequence(patch.nonce);
+        input.set_to_address(patch.toAddress);
+        input.set_tfuel_amount(patch.amount.data(), patch.amount.size());
+    });
+}
+
+static Tron::Proto::SigningInput tronInput() {
+    Tron::Proto::SigningInput input;
+    auto& transaction = *input.mutable_transaction();
+    transaction.set_timestamp(1539295479000);
+    auto& blockHeader = *transaction.mutable_block_header();
+    blockHeader.set_timestamp(1539295479000);
+    const auto txTrieRoot = parse_hex("64288c2db0641316762a99dbb02ef7c90f968b60f9f2e410835980614332f86d");
+    blockHeader.set_tx_trie_root(txTrieRoot.data(), txTrieRoot.size());
+    const auto parentHash = parse_hex("00000000002f7b3af4f5f8b9e23a30c530f719f165b742e7358536b280eead2d");
+    blockHeader.set_parent_hash(parentHash.data(), parentHash.size());
+    blockHeader.set_number(3111739);
+    const auto witnessAddress = parse_hex("415863f6091b8e71766da808b1dd3159790f61de7d");
+    blockHeader.set_witness_address(witnessAddress.data(), witnessAddress.size());
+    blockHeader.set_version(3);
+    const auto key = parse_hex("2d8f68944bdbfbc0769542fba8fc2d2a3de67393334471624364c7006da2aa54");
+    input.set_private_key(key.data(), key.size());
+    return input;
+}
+
+TEST(TWAnySignerTemplate, Tron) {
+    const auto patches = std::vector<SigningPatch>{
+        {0, "TW1dU4L3eNm7Lw8WvieLKEHpXWAussRG9Z", store(uint256_t(1000))},
+        {0, "THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV", store(uint256_t(2000000))},
+    };
+
+    auto input = tronInput();
+    input.mutable_transaction()->mutable_transfer()->set_owner_address("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC");
+    expectTemplateSigning(TWCoinTypeTron, input, patches, [](auto& input, const SigningPatch& patch) {
+        auto& transfer = *input.mutable_transaction()->mutable_transfer();
+        transfer.set_to_address(patch.toAddress);
+        transfer.set_amount(static_cast<int64_t>(load(patch.amount)));
+    });
+
+    input = tronInput();
+    auto& trc20 = *input.mutable_transaction()->mutable_transfer_trc20_contract();
+    trc20.set_owner_address("TJRyWwFs9wTFGZg3JbrVriFbNfCug5tDeC");
+    trc20.set_contract_address("THTR75o8xXAgCTQqpiot2AFRAjvW1tSbVV");
+    expectTemplateSigning(TWCoinTypeTron, input, patches, [](auto& input, const SigningPatch& patch) {
+        auto& transfer = *input.mutable_transaction()->mutable_transfer_trc20_contract();
+        transfer.set_to_address(patch.toAddress);
+        transfer.set_amount(std::string(patch.amount.begin(), patch.amount.end()));
+    });
+}
+
+TEST(TWAnySignerTemplate, SignBatch) {
+    auto input = ethereumInput();
+    input.mutable_transaction()->mutable_transfer();
+    const auto serialized = input.SerializeAsString();
+    const auto signerTemplate = anyCoinSigningTemplate(TWCoinTypeEthereum, Data(serialized.begin(), serialized.end()));
+    ASSERT_TRUE(signerTemplate != nullptr);
+
+    auto patches = ethereumPatches;
+    patches.push_back({1, "0x35353535", Data()});
+    patches.push_back({1, "0x3535353535353535353535353535353535353535", Data(33, 1)});
+    const auto outputs = signerTemplate->signBatch(patches, 2);
+    ASSERT_EQ(outputs.size(), patches.size());
+    for (size_t i = 0; i < ethereumPatches.size(); ++i) {
+        EXPECT_EQ(hex(outputs[i]), hex(signerTemplate->sign(patches[i]))) << i;
+    }
+    EXPECT_TRUE(outputs[3].empty());
+    EXPECT_TRUE(outputs[4].empty());
+}
+
+TEST(TWAnySignerTemplate, Unsupported) {
+    auto input = ethereumInput();
+    input.mutable_transaction()->mutable_erc721_transfer();
+    EXPECT_EQ(TWAnySignerTemplateCreate(serialize(input).get(), TWCoinTypeEthereum), nullptr);
+    EXPECT_EQ(TWAnySignerTemplateCreate(serialize(ethereumInput()).get(), TWCoinTypeBitcoin), nullptr);
+
+    input = ethereumInput();
+    input.set_private_key("");
+    input.mutable_transaction()->mutable_transfer();
+    EXPECT_EQ(TWAnySignerTemplateCreate(serialize(input).get(), TWCoinTypeEthereum), nullptr);
+}
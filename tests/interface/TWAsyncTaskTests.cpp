@@ -0,0 +1,115 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+
+#include "Async.h"
+#include "HexCoding.h"
+#include "uint256.h"
+#include "proto/Ethereum.pb.h"
+
+#include <TrustWalletCore/TWAnySigner.h>
+#include <TrustWalletCore/TWAsyncTask.h>
+#include <TrustWalletCore/TWStoredKey.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace TW;
+
+static std::shared_ptr<TWData> ethereumInput() {
+    Ethereum::Proto::SigningInput input;
+    const auto chainId = store(uint256_t(1));
+    const auto nonce = store(uint256_t(9));
+    const auto gasPrice = store(uint256_t(20000000000));
+    const auto gasLimit = store(uint256_t(21000));
+    const auto amount = store(uint256_t(1000000000000000000));
+    const auto key = parse_hex("4646464646464646464646464646464646464646464646464646464646464646");
+    input.set_chain_id(chainId.data(), chainId.size());
+    input.set_nonce(nonce.data(), nonce.size());
+    input.set_gas_price(gasPrice.data(), gasPrice.size());
+    input.set_gas_limit(gasLimit.data(), gasLimit.size());
+    input.set_to_address("0x3535353535353535353535353535353535353535");
+    input.set_private_key(key.data(), key.size());
+    input.mutable_transaction()->mutable_transfer()->set_amount(amount.data(), amount.size());
+    const auto serialized = input.SerializeAsString();
+    return WRAPD(TWDataCreateWithBytes(reinterpret_cast<const uint8_t*>(serialized.data()), serialized.size()));
+}
+
+TEST(TWAsyncTask, Sign) {
+    const auto input = ethereumInput();
+    const auto expected = WRAPD(TWAnySignerSign(input.get(), TWCoinTypeEthereum));
+
+    const auto task = WRAP(TWAsyncTask, TWAnySignerSignAsync(input.get(), TWCoinTypeEthereum, nullptr, nullptr));
+    EXPECT_EQ(TWAsyncTaskWait(task.get()), TWAsyncTaskStatusCompleted);
+    EXPECT_EQ(TWAsyncTaskGetStatus(task.get()), TWAsyncTaskStatusCompleted);
+    const auto output = WRAPD(TWAsyncTaskResult(task.get()));
+    ASSERT_NE(output.get(), nullptr);
+    EXPECT_TRUE(TWDataEqual(output.get(), expected.get()));
+}
+
+TEST(TWAsyncTask, Callback) {
+    std::promise<std::shared_ptr<TWData>> promise;
+    auto future = promise.get_future();
+    const auto callback = [](void* context, TWAsyncTask* task) {
+        auto& promise = *static_cast<std::promise<std::shared_ptr<TWData>>*>(context);
+        EXPECT_EQ(TWAsyncTaskGetStatus(task), TWAsyncTaskStatusCompleted);
+        promise.set_value(WRAPD(TWAsyncTaskResult(task)));
+        // deleting from the callback is allowed
+        TWAsyncTaskDelete(task);
+    };
+    const auto input = ethereumInput();
+    TWAnySignerSignAsync(input.get(), TWCoinTypeEthereum, callback, &promise);
+
+    const auto output = future.get();
+    const auto expected = WRAPD(TWAnySignerSign(input.get(), TWCoinTypeEthereum));
+    ASSERT_NE(output.get(), nullptr);
+    EXPECT_TRUE(TWDataEqual(output.get(), expected.get()));
+}
+
+TEST(TWAsyncTask, StoredKey) {
+    const auto privateKey = DATA("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+    const auto name = STRING("name");
+    const auto password = DATA("70617373776f7264");
+    const auto wrongPassword = DATA("00");
+    const auto key = WRAP(TWStoredKey, TWStoredKeyImportPrivateKey(privateKey.get(), name.get(), password.get(), TWCoinTypeBitcoin));
+
+    const auto task = WRAP(TWAsyncTask, TWStoredKeyDecryptPrivateKeyAsync(key.get(), password.get(), nullptr, nullptr));
+    const auto wrong = WRAP(TWAsyncTask, TWStoredKeyDecryptPrivateKeyAsync(key.get(), wrongPassword.get(), nullptr, nullptr));
+    EXPECT_EQ(TWAsyncTaskWait(task.get()), TWAsyncTaskStatusCompleted);
+    const auto decrypted = WRAPD(TWAsyncTaskResult(task.get()));
+    EXPECT_TRUE(TWDataEqual(decrypted.get(), privateKey.get()));
+
+    EXPECT_EQ(TWAsyncTaskWait(wrong.get()), TWAsyncTaskStatusFailed);
+    EXPECT_EQ(TWAsyncTaskResult(wrong.get()), nullptr);
+}
+
+TEST(TWAsyncTask, Cancel) {
+    const auto privateKey = DATA("3a1076bf45ab87712ad64ccb3b10217737f7faacbf2872e88fdd9a537d8fe266");
+    const auto name = STRING("name");
+    const auto password = DATA("70617373776f7264");
+    const auto key = WRAP(TWStoredKey, TWStoredKeyImportPrivateKey(privateKey.get(), name.get(), password.get(), TWCoinTypeBitcoin));
+
+    // keep the workers busy, so that the tasks are still queued when cancelled
+    std::promise<void> gate;
+    const auto open = gate.get_future().share();
+    auto& pool = WorkerPool::shared();
+    for (std::size_t i = 0; i < pool.size(); ++i) {
+        pool.submit([open] { open.wait(); });
+    }
+
+    const auto task = WRAP(TWAsyncTask, TWStoredKeyDecryptPrivateKeyAsync(key.get(), password.get(), nullptr, nullptr));
+    TWAsyncTaskCancel(task.get());
+    // deleting a pending task cancels it, its callback is not called
+    const auto callback = [](void*, TWAsyncTask*) { FAIL(); };
+    TWAsyncTaskDelete(TWStoredKeyDecryptPrivateKeyAsync(key.get(), password.get(), callback, nullptr));
+    EXPECT_EQ(TWAsyncTaskGetStatus(task.get()), TWAsyncTaskStatusPending);
+    gate.set_value();
+
+    EXPECT_EQ(TWAsyncTaskWait(task.get()), TWAsyncTaskStatusCancelled);
+    EXPECT_EQ(TWAsyncTaskResult(task.get()), nullptr);
+}
@@ -278,6 +278,21 @@ TEST(HDWallet, ExtendedKeys) {
     assertStringsEqual(emptyPub, "");
 }
 
+TEST(HDWallet, ExtendedPublicKeys) {
+    auto words = STRING("abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon abandon about");
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), STRING("").get()));
+
+    const TWCoinType coins[] = {TWCoinTypeBitcoin, TWCoinTypeEthereum, TWCoinTypeLitecoin, TWCoinTypeBitcoin};
+    auto joined = WRAPS(TWHDWalletGetExtendedPublicKeys(wallet.get(), coins, 4));
+    const auto zpub = WRAPS(TWHDWalletGetExtendedPublicKey(wallet.get(), TWPurposeBIP84, TWCoinTypeBitcoin, TWHDVersionZPUB));
+    const auto ltub = WRAPS(TWHDWalletGetExtendedPublicKey(wallet.get(), TWCoinTypePurpose(TWCoinTypeLitecoin), TWCoinTypeLitecoin, TWCoinTypeXpubVersion(TWCoinTypeLitecoin)));
+    const auto expected = std::string(TWStringUTF8Bytes(zpub.get())) + "\n\n" + TWStringUTF8Bytes(ltub.get()) + "\n" + TWStringUTF8Bytes(zpub.get());
+    assertStringsEqual(joined, expected.c_str());
+    assertStringsEqual(zpub, "zpub6rFR7y4Q2AijBEqTUquhVz398htDFrtymD9xYYfG1m4wAcvPhXNfE3EfH1r1ADqtfSdVCToUG868RvUUkgDKf31mGDtKsAYz2oz2AGutZYs");
+
+    assertStringsEqual(WRAPS(TWHDWalletGetExtendedPublicKeys(wallet.get(), coins, 0)), "");
+}
+
 TEST(HDWallet, PublicKeyFromX) {
     auto xpub = STRING("xpub6BosfCnifzxcFwrSzQiqu2DBVTshkCXacvNsWGYJVVhhawA7d4R5WSWGFNbi8Aw6ZRc1brxMyWMzG3DSSSSoekkudhUd9yLb6qx39T9nMdj");
     auto xpubAddr2 = WRAP(TWPublicKey, TWHDWalletGetPublicKeyFromExtended(xpub.get(), TWCoinTypeBitcoinCash, STRING("m/44'/145'/0'/0/2").get()));
@@ -385,3 +400,22 @@ TEST(HDWallet, GetDerivedKey) {
     const auto privateKeyData = WRAPD(TWPrivateKeyData(privateKey.get()));
     assertHexEqual(privateKeyData, "1901b5994f075af71397f65bd68a9fff8d3025d65f5a2c731cf90f5e259d6aac");
 }
+
+TEST(HDWallet, DeriveAddresses) {
+    auto wallet = WRAP(TWHDWallet, TWHDWalletCreateWithMnemonic(words.get(), passphrase.get()));
+    const auto addresses = WRAPS(TWHDWalletDeriveAddresses(wallet.get(), TWCoinTypeEthereum, 0, 0, 0, 3));
+    const auto joined = std::string(TWStringUTF8Bytes(addresses.get()));
+
+    std::string expected;
+    for (uint32_t i = 0; i < 3; ++i) {
+        const auto key = WRAP(TWPrivateKey, TWHDWalletGetDerivedKey(wallet.get(), TWCoinTypeEthereum, 0, 0, i));
+        const auto address = WRAPS(TWCoinTypeDeriveAddress(TWCoinTypeEthereum, key.get()));
+        expected += (i == 0 ? "" : "\n") + std::string(TWStringUTF8Bytes(address.get()));
+    }
+    EXPECT_EQ(joined, expected);
+    EXPECT_EQ(joined.substr(0, 42), "0x27Ef5cDBe01777D62438AfFeb695e33fC2335979");
+
+    // beyond the non-hardened indices
+    const auto none = WRAPS(TWHDWalletDeriveAddresses(wallet.get(), TWCoinTypeEthereum, 0, 0, 0x7fffffff, 2));
+    EXPECT_EQ(std::string(TWStringUTF8Bytes(none.get())), "");
+}
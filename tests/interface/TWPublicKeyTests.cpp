@@ -35,7 +35,7 @@ TEST(TWPublicKeyTests, CreateFromPrivateSecp256k1) {
     auto publicKeyData = WRAPD(TWPublicKeyData(publicKey.get()));
     EXPECT_EQ(hex(*((Data*)(publicKeyData.get()))), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
     EXPECT_EQ(*((std::string*)(WRAPS(TWPublicKeyDescription(publicKey.get())).get())), "0399c6f51ad6f98c9c583f8e92bb7758ab2ca9a04110c0a1126ec43e5453d196c1");
-    EXPECT_TRUE(TWPublicKeyIsValid(publicKey.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(publicKey.get())).get(), TWPublicKeyTypeSECP256k1));
     EXPECT_TRUE(TWPublicKeyIsCompressed(publicKey.get()));
 }
 
@@ -51,20 +51,20 @@ TEST(TWPublicKeyTests, CompressedExtended) {
     EXPECT_EQ(TWPublicKeyKeyType(publicKey.get()), TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(publicKey.get()->impl.bytes.size(), 33);
     EXPECT_EQ(TWPublicKeyIsCompressed(publicKey.get()), true);
-    EXPECT_TRUE(TWPublicKeyIsValid(publicKey.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(publicKey.get())).get(), TWPublicKeyTypeSECP256k1));
 
     auto extended = WRAP(TWPublicKey, TWPublicKeyUncompressed(publicKey.get()));
     EXPECT_EQ(TWPublicKeyKeyType(extended.get()), TWPublicKeyTypeSECP256k1Extended);
     EXPECT_EQ(extended.get()->impl.bytes.size(), 65);
     EXPECT_EQ(TWPublicKeyIsCompressed(extended.get()), false);
-    EXPECT_TRUE(TWPublicKeyIsValid(extended.get(), TWPublicKeyTypeSECP256k1Extended));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(extended.get())).get(), TWPublicKeyTypeSECP256k1Extended));
 
     auto compressed = WRAP(TWPublicKey, TWPublicKeyCompressed(extended.get()));
     //EXPECT_TRUE(compressed == publicKey.get());
     EXPECT_EQ(TWPublicKeyKeyType(compressed.get()), TWPublicKeyTypeSECP256k1);
     EXPECT_EQ(compressed.get()->impl.bytes.size(), 33);
     EXPECT_EQ(TWPublicKeyIsCompressed(compressed.get()), true);
-    EXPECT_TRUE(TWPublicKeyIsValid(compressed.get(), TWPublicKeyTypeSECP256k1));
+    EXPECT_TRUE(TWPublicKeyIsValid(WRAPD(TWPublicKeyData(compressed.get())).get(), TWPublicKeyTypeSECP256k1));
 }
 
 TEST(TWPublicKeyTests, Verify) {
@@ -115,3 +115,17 @@ TEST(TWPublicKeyTests, RecoverInvalid) {
     const auto publicKey = WRAP(TWPublicKey, TWPublicKeyRecover(deadbeef.get(), deadbeef.get()));
     EXPECT_EQ(publicKey.get(), nullptr);
 }
+
+TEST(TWPublicKeyTests, SignatureCache) {
+    const auto message = DATA("de4e9524586d6fce45667f9ff12f661e79870c4105fa0fb58af976619bb11432");
+    const auto signature = DATA("00000000000000000000000000000000000000000000000000000000000000020123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef80");
+    TWPublicKeySetSignatureCacheCapacity(16);
+    for (int i = 0; i < 2; ++i) {
+        const auto publicKey = WRAP(TWPublicKey, TWPublicKeyRecover(signature.get(), message.get()));
+        ASSERT_TRUE(publicKey.get() != nullptr);
+        const auto publicKeyData = WRAPD(TWPublicKeyData(publicKey.get()));
+        EXPECT_EQ(hex(*((Data*)(publicKeyData.get()))),
+            "0456d8089137b1fd0d890f8c7d4a04d0fd4520a30b19518ee87bd168ea12ed8090329274c4c6c0d9df04515776f2741eeffc30235d596065d718c3973e19711ad0");
+    }
+    TWPublicKeySetSignatureCacheCapacity(0);
+}
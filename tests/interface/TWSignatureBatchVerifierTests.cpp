@@ -0,0 +1,35 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "TWTestUtilities.h"
+
+#include <TrustWalletCore/TWPrivateKey.h>
+#include <TrustWalletCore/TWPublicKey.h>
+#include <TrustWalletCore/TWSignatureBatchVerifier.h>
+
+#include <gtest/gtest.h>
+
+TEST(TWSignatureBatchVerifier, Verify) {
+    const auto verifier = WRAP(TWSignatureBatchVerifier, TWSignatureBatchVerifierCreate());
+    const auto privateKey = WRAP(TWPrivateKey, TWPrivateKeyCreateWithData(DATA("afeefca74d9a325cf1d6b6911d61a65c32afa8e02bd5e78e2e4ac2910bab45f5").get()));
+    const auto publicKey = WRAP(TWPublicKey, TWPrivateKeyGetPublicKeyEd25519(privateKey.get()));
+    const auto message = DATA("48656c6c6f");
+    const auto signature = WRAPD(TWPrivateKeySign(privateKey.get(), message.get(), TWCurveED25519));
+
+    for (auto i = 0; i < 3; ++i) {
+        EXPECT_EQ(TWSignatureBatchVerifierAdd(verifier.get(), publicKey.get(), signature.get(), message.get()), i);
+    }
+    EXPECT_EQ(TWSignatureBatchVerifierSize(verifier.get()), 3);
+    EXPECT_TRUE(TWSignatureBatchVerifierVerify(verifier.get()));
+    EXPECT_TRUE(TWSignatureBatchVerifierIsValid(verifier.get(), 2));
+
+    const auto other = DATA("48656c6c6e");
+    EXPECT_EQ(TWSignatureBatchVerifierAdd(verifier.get(), publicKey.get(), signature.get(), other.get()), 3);
+    EXPECT_FALSE(TWSignatureBatchVerifierVerify(verifier.get()));
+    EXPECT_TRUE(TWSignatureBatchVerifierIsValid(verifier.get(), 0));
+    EXPECT_FALSE(TWSignatureBatchVerifierIsValid(verifier.get(), 3));
+    EXPECT_FALSE(TWSignatureBatchVerifierIsValid(verifier.get(), 4));
+}
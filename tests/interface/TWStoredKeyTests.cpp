@@ -14,6 +14,7 @@
 #include "../src/HexCoding.h"
 
 #include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
 
 #include <fstream>
 
@@ -224,3 +225,37 @@ TEST(TWStoredKey, getWalletPasswordInvalid) {
     ASSERT_NE(WRAP(TWHDWallet, TWStoredKeyWallet(key.get(), password.get())).get(), nullptr);
     ASSERT_EQ(WRAP(TWHDWallet, TWStoredKeyWallet(key.get(), passwordInvalid.get())).get(), nullptr);
 }
+
+TEST(TWStoredKey, calibrateKDF) {
+    EXPECT_FALSE(TWStoredKeyCalibrateScrypt(20, 512));
+    ASSERT_TRUE(TWStoredKeyCalibrateScrypt(20, 8 * 1024));
+    const auto key = createDefaultStoredKey();
+    const auto password = WRAPD(TWDataCreateWithBytes((const uint8_t *)"password", 8));
+    const auto json = WRAPD(TWStoredKeyExportJSON(key.get()));
+    const auto parsed = nlohmann::json::parse(string(reinterpret_cast<const char*>(TWDataBytes(json.get())), TWDataSize(json.get())));
+    EXPECT_EQ(parsed["crypto"]["kdf"], "scrypt");
+    EXPECT_LE(parsed["crypto"]["kdfparams"]["n"].get<uint32_t>(), 8 * 1024);
+
+    TWStoredKeyCalibratePBKDF2(20);
+    const auto pbkdf2Key = createDefaultStoredKey();
+    const auto pbkdf2Json = WRAPD(TWStoredKeyExportJSON(pbkdf2Key.get()));
+    const auto imported = WRAP(TWStoredKey, TWStoredKeyImportJSON(pbkdf2Json.get()));
+    ASSERT_NE(imported.get(), nullptr);
+    const auto mnemonic = WRAPS(TWStoredKeyDecryptMnemonic(imported.get(), password.get()));
+    ASSERT_NE(mnemonic.get(), nullptr);
+    EXPECT_EQ(string(TWStringUTF8Bytes(mnemonic.get())), "team engine square letter hero song dizzy scrub tornado fabric divert saddle");
+
+    TWStoredKeyResetKDFParameters();
+}
+
+TEST(TWStoredKey, changePassword) {
+    const auto key = createDefaultStoredKey();
+    const auto password = WRAPD(TWDataCreateWithBytes((const uint8_t *)"password", 8));
+    const auto newPassword = WRAPD(TWDataCreateWithBytes((const uint8_t *)"new password", 12));
+    EXPECT_FALSE(TWStoredKeyChangePassword(key.get(), newPassword.get(), newPassword.get()));
+    ASSERT_TRUE(TWStoredKeyChangePassword(key.get(), password.get(), newPassword.get()));
+    EXPECT_EQ(WRAPS(TWStoredKeyDecryptMnemonic(key.get(), password.get())).get(), nullptr);
+    const auto mnemonic = WRAPS(TWStoredKeyDecryptMnemonic(key.get(), newPassword.get()));
+    ASSERT_NE(mnemonic.get(), nullptr);
+    EXPECT_EQ(string(TWStringUTF8Bytes(mnemonic.get())), "team engine square letter hero song dizzy scrub tornado fabric divert saddle");
+}
@@ -0,0 +1,41 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include <TrustWalletCore/TWThreadPool.h>
+
+#include "Coin.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+static std::atomic<int> executedTasks(0);
+
+static void runInline(void* context, TWThreadPoolTask run, void* task) {
+    ++*static_cast<std::atomic<int>*>(context);
+    run(task);
+}
+
+TEST(TWThreadPool, Configure) {
+    const auto threadCount = TWThreadPoolThreadCount();
+    TWThreadPoolSetThreadCount(3);
+    EXPECT_EQ(TWThreadPoolThreadCount(), 3u);
+
+    TWThreadPoolSetExecutor(runInline, &executedTasks, 4);
+    EXPECT_EQ(TWThreadPoolThreadCount(), 4u);
+    const auto addresses = std::vector<std::string>(2000, "0x5aAeb6053F3E94C9b9A09f33669435E7Ef1BeAed");
+    const auto valid = TW::validateAddresses(TWCoinTypeEthereum, addresses);
+    EXPECT_EQ(valid, std::vector<bool>(2000, true));
+    EXPECT_GT(executedTasks, 0);
+
+    TWThreadPoolSetExecutor(nullptr, nullptr, 0);
+    EXPECT_EQ(TWThreadPoolThreadCount(), 3u);
+    EXPECT_TRUE(TWThreadPoolSetAffinity(nullptr, 0));
+    TWThreadPoolSetThreadCount(0);
+    EXPECT_EQ(TWThreadPoolThreadCount(), threadCount);
+}
@@ -0,0 +1,121 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Coin.h"
+#include "HexCoding.h"
+#include "PrivateKey.h"
+#include "proto/Bitcoin.pb.h"
+
+#include <TrustWalletCore/TWAnyAddress.h>
+#include <TrustWalletCore/TWAnySigner.h>
+
+#include "../interface/TWTestUtilities.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+namespace TW {
+
+namespace {
+
+/// Coins of blockchains left out by TW_COINS, among a few with no dependents.
+std::vector<TWCoinType> excludedCoins() {
+    return {
+#ifdef TW_EXCLUDE_SOLANA
+        TWCoinTypeSolana,
+#endif
+#ifdef TW_EXCLUDE_COSMOS
+        TWCoinTypeCosmos,
+#endif
+#ifdef TW_EXCLUDE_TRON
+        TWCoinTypeTron,
+#endif
+#ifdef TW_EXCLUDE_POLKADOT
+        TWCoinTypePolkadot,
+#endif
+#ifdef TW_EXCLUDE_STELLAR
+        TWCoinTypeStellar,
+#endif
+#ifdef TW_EXCLUDE_RIPPLE
+        TWCoinTypeXRP,
+#endif
+    };
+}
+
+const auto privateKey = PrivateKey(parse_hex("4646464646464646464646464646464646464646464646464646464646464646"));
+const auto someInput = parse_hex("0a0101120109");
+
+} // namespace
+
+TEST(CoinSubset, ExcludedCoinsHaveNoAddresses) {
+    const auto coins = excludedCoins();
+    if (coins.empty()) {
+        GTEST_SKIP();
+    }
+    for (const auto coin : coins) {
+        const auto address = deriveAddress(TWCoinTypeBitcoin, privateKey);
+        EXPECT_FALSE(validateAddress(coin, address)) << coin;
+        EXPECT_EQ(validateAddresses(coin, {address, address}), std::vector<bool>(2, false)) << coin;
+        EXPECT_FALSE(parseAddress(coin, address).has_value()) << coin;
+        EXPECT_EQ(normalizeAddress(coin, address), "") << coin;
+        EXPECT_EQ(deriveAddress(coin, privateKey), "") << coin;
+        EXPECT_TRUE(getSimilarCoinTypes(coin).empty()) << coin;
+
+        const auto string = STRING(address.c_str());
+        EXPECT_FALSE(TWAnyAddressIsValid(string.get(), coin)) << coin;
+        EXPECT_EQ(TWAnyAddressCreateWithString(string.get(), coin), nullptr) << coin;
+    }
+}
+
+TEST(CoinSubset, ExcludedCoinsHaveNoSigners) {
+    const auto coins = excludedCoins();
+    if (coins.empty()) {
+        GTEST_SKIP();
+    }
+    for (const auto coin : coins) {
+        Data output;
+        anyCoinSign(coin, someInput, output);
+        EXPECT_TRUE(output.empty()) << coin;
+        anyCoinPlan(coin, someInput, output);
+        EXPECT_TRUE(output.empty()) << coin;
+        anyCoinPreImageHashes(coin, someInput, output);
+        EXPECT_TRUE(output.empty()) << coin;
+        anyCoinCompileWithSignatures(coin, someInput, {Data(64)}, output);
+        EXPECT_TRUE(output.empty()) << coin;
+        EXPECT_EQ(anyCoinSigningTemplate(coin, someInput), nullptr) << coin;
+        EXPECT_EQ(anySignJSON(coin, "{}", privateKey.bytes.toData()), "") << coin;
+        EXPECT_FALSE(supportsJSONSigning(coin)) << coin;
+
+        Bitcoin::Proto::SigningInput input;
+        Bitcoin::Proto::SigningOutput signingOutput;
+        EXPECT_THROW(anyCoinSign(coin, input, signingOutput), std::invalid_argument) << coin;
+
+        const auto results = anyCoinSignBatch({{coin, someInput}, {coin, Data()}}, 1);
+        ASSERT_EQ(results.size(), 2ul);
+        for (const auto& result : results) {
+            EXPECT_EQ(result.error, TWAnySignerBatchErrorUnsupportedCoin) << coin;
+            EXPECT_TRUE(result.output.empty()) << coin;
+        }
+
+        const auto data = DATA("0a0101120109");
+        EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerSign(data.get(), coin)).get()), 0ul) << coin;
+        EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerPlan(data.get(), coin)).get()), 0ul) << coin;
+        EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerPreImageHashes(data.get(), coin)).get()), 0ul) << coin;
+        const auto signatures = DATA("00");
+        EXPECT_EQ(TWDataSize(WRAPD(TWAnySignerCompileWithSignatures(data.get(), signatures.get(), coin)).get()), 0ul) << coin;
+        EXPECT_FALSE(TWAnySignerSupportsJSON(coin)) << coin;
+    }
+}
+
+TEST(CoinSubset, BitcoinIsAlwaysBuilt) {
+    const auto address = deriveAddress(TWCoinTypeBitcoin, privateKey);
+    EXPECT_TRUE(validateAddress(TWCoinTypeBitcoin, address));
+    EXPECT_FALSE(getSimilarCoinTypes(TWCoinTypeBitcoin).empty());
+}
+
+} // namespace TW
@@ -0,0 +1,518 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Hardware accelerated AES, selected at runtime.
+//
+// AES-NI (x86) and the ARMv8 cryptography extensions run the rounds with the key
+// schedules of aeskey.c: the encryption schedule as is, and the decryption schedule,
+// which is stored in reverse order with InvMixColumns applied to the middle round
+// keys, as the equivalent inverse cipher of both instruction sets expects.
+// Independent blocks (ECB, CBC decryption, CTR) are processed AES_HW_LANES at a time
+// to hide the latency of the round instructions. The portable table code stays in
+// use elsewhere, and is also not constant-time.
+
+#include <string.h>
+
+#include <TrezorCrypto/aes_hw.h>
+#include <TrezorCrypto/options.h>
+
+#if USE_AES_HW && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define AES_HW_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if USE_AES_HW && defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define AES_HW_ARM 1
+#include <arm_neon.h>
+#endif
+
+#define AES_HW_LANES 8
+#define AES_HW_MAX_ROUNDS 14
+
+/* The lane loops are unrolled so that the round instructions of independent blocks interleave */
+#define AES_HW_UNROLL _Pragma("GCC unroll 8")
+#define AES_HW_INLINE __attribute__((always_inline)) static inline
+
+/* Number of rounds of a keyed context, 0 if it is not keyed */
+static int aes_hw_rounds(const aes_inf *inf) {
+	switch (inf->b[0]) {
+	case 10 * AES_BLOCK_SIZE:
+		return 10;
+	case 12 * AES_BLOCK_SIZE:
+		return 12;
+	case 14 * AES_BLOCK_SIZE:
+		return 14;
+	default:
+		return 0;
+	}
+}
+
+static uint64_t aes_hw_read_be64(const uint8_t *p) {
+	uint64_t v = 0;
+	for (int i = 0; i < 8; i++) {
+		v = (v << 8) | p[i];
+	}
+	return v;
+}
+
+static void aes_hw_write_be64(uint8_t *p, uint64_t v) {
+	for (int i = 7; i >= 0; i--) {
+		p[i] = (uint8_t)v;
+		v >>= 8;
+	}
+}
+
+#ifdef AES_HW_X86
+
+#define AES_HW_TARGET __attribute__((target("aes,sse2")))
+
+AES_HW_TARGET
+static void aesni_load_keys(const uint32_t *ks, int rounds, __m128i *k) {
+	for (int r = 0; r <= rounds; r++) {
+		k[r] = _mm_loadu_si128((const __m128i *)(ks + 4 * r));
+	}
+}
+
+AES_HW_TARGET
+AES_HW_INLINE void aesni_encrypt_lanes(__m128i *b, size_t n, const __m128i *k, int rounds) {
+	for (size_t i = 0; i < n; i++) {
+		b[i] = _mm_xor_si128(b[i], k[0]);
+	}
+	for (int r = 1; r < rounds; r++) {
+		AES_HW_UNROLL
+		for (size_t i = 0; i < n; i++) {
+			b[i] = _mm_aesenc_si128(b[i], k[r]);
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		b[i] = _mm_aesenclast_si128(b[i], k[rounds]);
+	}
+}
+
+AES_HW_TARGET
+AES_HW_INLINE void aesni_decrypt_lanes(__m128i *b, size_t n, const __m128i *k, int rounds) {
+	for (size_t i = 0; i < n; i++) {
+		b[i] = _mm_xor_si128(b[i], k[0]);
+	}
+	for (int r = 1; r < rounds; r++) {
+		AES_HW_UNROLL
+		for (size_t i = 0; i < n; i++) {
+			b[i] = _mm_aesdec_si128(b[i], k[r]);
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		b[i] = _mm_aesdeclast_si128(b[i], k[rounds]);
+	}
+}
+
+AES_HW_TARGET
+static void aesni_ecb(const uint8_t *in, uint8_t *out, size_t blocks, const uint32_t *ks, int rounds, int decrypt) {
+	__m128i k[AES_HW_MAX_ROUNDS + 1];
+	__m128i b[AES_HW_LANES];
+	aesni_load_keys(ks, rounds, k);
+	while (blocks > 0) {
+		const size_t n = blocks < AES_HW_LANES ? blocks : AES_HW_LANES;
+		for (size_t i = 0; i < n; i++) {
+			b[i] = _mm_loadu_si128((const __m128i *)(in + 16 * i));
+		}
+		if (n == AES_HW_LANES) {
+			/* constant lane count, unrolled by the compiler */
+			if (decrypt) {
+				aesni_decrypt_lanes(b, AES_HW_LANES, k, rounds);
+			} else {
+				aesni_encrypt_lanes(b, AES_HW_LANES, k, rounds);
+			}
+		} else if (decrypt) {
+			aesni_decrypt_lanes(b, n, k, rounds);
+		} else {
+			aesni_encrypt_lanes(b, n, k, rounds);
+		}
+		for (size_t i = 0; i < n; i++) {
+			_mm_storeu_si128((__m128i *)(out + 16 * i), b[i]);
+		}
+		in += 16 * n;
+		out += 16 * n;
+		blocks -= n;
+	}
+}
+
+AES_HW_TARGET
+static void aesni_cbc_encrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const uint32_t *ks, int rounds) {
+	__m128i k[AES_HW_MAX_ROUNDS + 1];
+	aesni_load_keys(ks, rounds, k);
+	__m128i b = _mm_loadu_si128((const __m128i *)iv);
+	for (size_t j = 0; j < blocks; j++) {
+		b = _mm_xor_si128(b, _mm_loadu_si128((const __m128i *)(in + 16 * j)));
+		aesni_encrypt_lanes(&b, 1, k, rounds);
+		_mm_storeu_si128((__m128i *)(out + 16 * j), b);
+	}
+	_mm_storeu_si128((__m128i *)iv, b);
+}
+
+AES_HW_TARGET
+static void aesni_cbc_decrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const uint32_t *ks, int rounds) {
+	__m128i k[AES_HW_MAX_ROUNDS + 1];
+	__m128i b[AES_HW_LANES], c[AES_HW_LANES];
+	aesni_load_keys(ks, rounds, k);
+	__m128i prev = _mm_loadu_si128((const __m128i *)iv);
+	while (blocks > 0) {
+		const size_t n = blocks < AES_HW_LANES ? blocks : AES_HW_LANES;
+		/* the ciphertext is read before the output is written, in and out may be the same */
+		for (size_t i = 0; i < n; i++) {
+			c[i] = b[i] = _mm_loadu_si128((const __m128i *)(in + 16 * i));
+		}
+		if (n == AES_HW_LANES) {
+			aesni_decrypt_lanes(b, AES_HW_LANES, k, rounds);
+		} else {
+			aesni_decrypt_lanes(b, n, k, rounds);
+		}
+		for (size_t i = 0; i < n; i++) {
+			_mm_storeu_si128((__m128i *)(out + 16 * i), _mm_xor_si128(b[i], prev));
+			prev = c[i];
+		}
+		in += 16 * n;
+		out += 16 * n;
+		blocks -= n;
+	}
+	_mm_storeu_si128((__m128i *)iv, prev);
+}
+
+AES_HW_TARGET
+static void aesni_ctr(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *cbuf, const uint32_t *ks, int rounds) {
+	__m128i k[AES_HW_MAX_ROUNDS + 1];
+	__m128i b[AES_HW_LANES];
+	aesni_load_keys(ks, rounds, k);
+	uint64_t hi = aes_hw_read_be64(cbuf), lo = aes_hw_read_be64(cbuf + 8);
+	while (blocks > 0) {
+		const size_t n = blocks < AES_HW_LANES ? blocks : AES_HW_LANES;
+		for (size_t i = 0; i < n; i++) {
+			b[i] = _mm_set_epi64x((long long)__builtin_bswap64(lo), (long long)__builtin_bswap64(hi));
+			if (++lo == 0) {
+				++hi;
+			}
+		}
+		if (n == AES_HW_LANES) {
+			aesni_encrypt_lanes(b, AES_HW_LANES, k, rounds);
+		} else {
+			aesni_encrypt_lanes(b, n, k, rounds);
+		}
+		for (size_t i = 0; i < n; i++) {
+			const __m128i data = _mm_loadu_si128((const __m128i *)(in + 16 * i));
+			_mm_storeu_si128((__m128i *)(out + 16 * i), _mm_xor_si128(data, b[i]));
+		}
+		in += 16 * n;
+		out += 16 * n;
+		blocks -= n;
+	}
+	aes_hw_write_be64(cbuf, hi);
+	aes_hw_write_be64(cbuf + 8, lo);
+}
+
+static unsigned aes_hw_detect(void) {
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	/* AES-NI, and SSE2 for the loads and stores */
+	if ((ecx & (1u << 25)) != 0 && (edx & (1u << 26)) != 0) {
+		return AES_HW_AESNI;
+	}
+	return 0;
+}
+
+#elif defined(AES_HW_ARM)
+
+static void armv8_load_keys(const uint32_t *ks, int rounds, uint8x16_t *k) {
+	for (int r = 0; r <= rounds; r++) {
+		k[r] = vld1q_u8((const uint8_t *)(ks + 4 * r));
+	}
+}
+
+/* AESE includes the AddRoundKey before SubBytes and ShiftRows, so the last
+   round key is added separately */
+AES_HW_INLINE void armv8_encrypt_lanes(uint8x16_t *b, size_t n, const uint8x16_t *k, int rounds) {
+	for (int r = 0; r < rounds - 1; r++) {
+		AES_HW_UNROLL
+		for (size_t i = 0; i < n; i++) {
+			b[i] = vaesmcq_u8(vaeseq_u8(b[i], k[r]));
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		b[i] = veorq_u8(vaeseq_u8(b[i], k[rounds - 1]), k[rounds]);
+	}
+}
+
+AES_HW_INLINE void armv8_decrypt_lanes(uint8x16_t *b, size_t n, const uint8x16_t *k, int rounds) {
+	for (int r = 0; r < rounds - 1; r++) {
+		AES_HW_UNROLL
+		for (size_t i = 0; i < n; i++) {
+			b[i] = vaesimcq_u8(vaesdq_u8(b[i], k[r]));
+		}
+	}
+	for (size_t i = 0; i < n; i++) {
+		b[i] = veorq_u8(vaesdq_u8(b[i], k[rounds - 1]), k[rounds]);
+	}
+}
+
+static void armv8_ecb(const uint8_t *in, uint8_t *out, size_t blocks, const uint32_t *ks, int rounds, int decrypt) {
+	uint8x16_t k[AES_HW_MAX_ROUNDS + 1];
+	uint8x16_t b[AES_HW_LANES];
+	armv8_load_keys(ks, rounds, k);
+	while (blocks > 0) {
+		const size_t n = blocks < AES_HW_LANES ? blocks : AES_HW_LANES;
+		for (size_t i = 0; i < n; i++) {
+			b[i] = vld1q_u8(in + 16 * i);
+		}
+		if (n == AES_HW_LANES) {
+			/* constant lane count, unrolled by the compiler */
+			if (decrypt) {
+				armv8_decrypt_lanes(b, AES_HW_LANES, k, rounds);
+			} else {
+				armv8_encrypt_lanes(b, AES_HW_LANES, k, rounds);
+			}
+		} else if (decrypt) {
+			armv8_decrypt_lanes(b, n, k, rounds);
+		} else {
+			armv8_encrypt_lanes(b, n, k, rounds);
+		}
+		for (size_t i = 0; i < n; i++) {
+			vst1q_u8(out + 16 * i, b[i]);
+		}
+		in += 16 * n;
+		out += 16 * n;
+		blocks -= n;
+	}
+}
+
+static void armv8_cbc_encrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const uint32_t *ks, int rounds) {
+	uint8x16_t k[AES_HW_MAX_ROUNDS + 1];
+	armv8_load_keys(ks, rounds, k);
+	uint8x16_t b = vld1q_u8(iv);
+	for (size_t j = 0; j < blocks; j++) {
+		b = veorq_u8(b, vld1q_u8(in + 16 * j));
+		armv8_encrypt_lanes(&b, 1, k, rounds);
+		vst1q_u8(out + 16 * j, b);
+	}
+	vst1q_u8(iv, b);
+}
+
+static void armv8_cbc_decrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const uint32_t *ks, int rounds) {
+	uint8x16_t k[AES_HW_MAX_ROUNDS + 1];
+	uint8x16_t b[AES_HW_LANES], c[AES_HW_LANES];
+	armv8_load_keys(ks, rounds, k);
+	uint8x16_t prev = vld1q_u8(iv);
+	while (blocks > 0) {
+		const size_t n = blocks < AES_HW_LANES ? blocks : AES_HW_LANES;
+		/* the ciphertext is read before the output is written, in and out may be the same */
+		for (size_t i = 0; i < n; i++) {
+			c[i] = b[i] = vld1q_u8(in + 16 * i);
+		}
+		if (n == AES_HW_LANES) {
+			armv8_decrypt_lanes(b, AES_HW_LANES, k, rounds);
+		} else {
+			armv8_decrypt_lanes(b, n, k, rounds);
+		}
+		for (size_t i = 0; i < n; i++) {
+			vst1q_u8(out + 16 * i, veorq_u8(b[i], prev));
+			prev = c[i];
+		}
+		in += 16 * n;
+		out += 16 * n;
+		blocks -= n;
+	}
+	vst1q_u8(iv, prev);
+}
+
+static void armv8_ctr(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *cbuf, const uint32_t *ks, int rounds) {
+	uint8x16_t k[AES_HW_MAX_ROUNDS + 1];
+	uint8x16_t b[AES_HW_LANES];
+	armv8_load_keys(ks, rounds, k);
+	uint64_t hi = aes_hw_read_be64(cbuf), lo = aes_hw_read_be64(cbuf + 8);
+	while (blocks > 0) {
+		const size_t n = blocks < AES_HW_LANES ? blocks : AES_HW_LANES;
+		for (size_t i = 0; i < n; i++) {
+			b[i] = vreinterpretq_u8_u64(vcombine_u64(vcreate_u64(__builtin_bswap64(hi)), vcreate_u64(__builtin_bswap64(lo))));
+			if (++lo == 0) {
+				++hi;
+			}
+		}
+		if (n == AES_HW_LANES) {
+			armv8_encrypt_lanes(b, AES_HW_LANES, k, rounds);
+		} else {
+			armv8_encrypt_lanes(b, n, k, rounds);
+		}
+		for (size_t i = 0; i < n; i++) {
+			vst1q_u8(out + 16 * i, veorq_u8(vld1q_u8(in + 16 * i), b[i]));
+		}
+		in += 16 * n;
+		out += 16 * n;
+		blocks -= n;
+	}
+	aes_hw_write_be64(cbuf, hi);
+	aes_hw_write_be64(cbuf + 8, lo);
+}
+
+static unsigned aes_hw_detect(void) {
+	/* The compiler targets the cryptography extensions, so they are present */
+	return AES_HW_ARMV8;
+}
+
+#else
+
+static unsigned aes_hw_detect(void) {
+	return 0;
+}
+
+#endif
+
+/* Supported features, detected on first use */
+static unsigned aes_hw_supported_features = 0;
+static int aes_hw_detected = 0;
+/* Features in use */
+static unsigned aes_hw_features = 0;
+static int aes_hw_initialized = 0;
+
+/* The state above may be initialized from several threads at once, so it is
+   accessed atomically; the flags are published last. */
+#define AES_HW_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define AES_HW_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static unsigned aes_hw_detected_features(void) {
+	if (!AES_HW_LOAD(&aes_hw_detected)) {
+		AES_HW_STORE(&aes_hw_supported_features, aes_hw_detect());
+		AES_HW_STORE(&aes_hw_detected, 1);
+	}
+	return AES_HW_LOAD(&aes_hw_supported_features);
+}
+
+unsigned aes_hw_supported(void) {
+	return aes_hw_detected_features();
+}
+
+unsigned aes_hw_selected(void) {
+	if (!AES_HW_LOAD(&aes_hw_initialized)) {
+		aes_hw_select(aes_hw_detected_features());
+	}
+	return AES_HW_LOAD(&aes_hw_features);
+}
+
+unsigned aes_hw_select(unsigned features) {
+	features &= aes_hw_detected_features();
+	AES_HW_STORE(&aes_hw_features, features);
+	AES_HW_STORE(&aes_hw_initialized, 1);
+	return features;
+}
+
+/* Rounds of the context if the hardware is in use, 0 otherwise */
+static int aes_hw_use(const aes_inf *inf) {
+	if (aes_hw_selected() == 0) {
+		return 0;
+	}
+	return aes_hw_rounds(inf);
+}
+
+int aes_hw_ecb_encrypt(const uint8_t *in, uint8_t *out, size_t blocks, const aes_encrypt_ctx *ctx) {
+	const int rounds = aes_hw_use(&ctx->inf);
+	if (rounds == 0) {
+		return 0;
+	}
+#ifdef AES_HW_X86
+	aesni_ecb(in, out, blocks, ctx->ks, rounds, 0);
+	return 1;
+#elif defined(AES_HW_ARM)
+	armv8_ecb(in, out, blocks, ctx->ks, rounds, 0);
+	return 1;
+#else
+	(void)in, (void)out, (void)blocks;
+	return 0;
+#endif
+}
+
+int aes_hw_ecb_decrypt(const uint8_t *in, uint8_t *out, size_t blocks, const aes_decrypt_ctx *ctx) {
+	const int rounds = aes_hw_use(&ctx->inf);
+	if (rounds == 0) {
+		return 0;
+	}
+#ifdef AES_HW_X86
+	aesni_ecb(in, out, blocks, ctx->ks, rounds, 1);
+	return 1;
+#elif defined(AES_HW_ARM)
+	armv8_ecb(in, out, blocks, ctx->ks, rounds, 1);
+	return 1;
+#else
+	(void)in, (void)out, (void)blocks;
+	return 0;
+#endif
+}
+
+int aes_hw_cbc_encrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const aes_encrypt_ctx *ctx) {
+	const int rounds = aes_hw_use(&ctx->inf);
+	if (rounds == 0) {
+		return 0;
+	}
+#ifdef AES_HW_X86
+	aesni_cbc_encrypt(in, out, blocks, iv, ctx->ks, rounds);
+	return 1;
+#elif defined(AES_HW_ARM)
+	armv8_cbc_encrypt(in, out, blocks, iv, ctx->ks, rounds);
+	return 1;
+#else
+	(void)in, (void)out, (void)blocks, (void)iv;
+	return 0;
+#endif
+}
+
+int aes_hw_cbc_decrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const aes_decrypt_ctx *ctx) {
+	const int rounds = aes_hw_use(&ctx->inf);
+	if (rounds == 0) {
+		return 0;
+	}
+#ifdef AES_HW_X86
+	aesni_cbc_decrypt(in, out, blocks, iv, ctx->ks, rounds);
+	return 1;
+#elif defined(AES_HW_ARM)
+	armv8_cbc_decrypt(in, out, blocks, iv, ctx->ks, rounds);
+	return 1;
+#else
+	(void)in, (void)out, (void)blocks, (void)iv;
+	return 0;
+#endif
+}
+
+int aes_hw_ctr_crypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *cbuf, const aes_encrypt_ctx *ctx) {
+	const int rounds = aes_hw_use(&ctx->inf);
+	if (rounds == 0) {
+		return 0;
+	}
+#ifdef AES_HW_X86
+	aesni_ctr(in, out, blocks, cbuf, ctx->ks, rounds);
+	return 1;
+#elif defined(AES_HW_ARM)
+	armv8_ctr(in, out, blocks, cbuf, ctx->ks, rounds);
+	return 1;
+#else
+	(void)in, (void)out, (void)blocks, (void)cbuf;
+	return 0;
+#endif
+}
@@ -30,6 +30,7 @@ Issue Date: 20/12/2007
 #include <stdint.h>
 
 #include <TrezorCrypto/aes/aesopt.h>
+#include <TrezorCrypto/aes_hw.h>
 
 #if defined( AES_MODES )
 #if defined(__cplusplus)
@@ -141,6 +142,10 @@ AES_RETURN aes_ecb_encrypt(const unsigned char *ibuf, unsigned char *obuf,
     if(len & (AES_BLOCK_SIZE - 1))
         return EXIT_FAILURE;
 
+    // [wallet-core] hardware AES
+    if(aes_hw_ecb_encrypt(ibuf, obuf, (size_t)nb, ctx))
+        return EXIT_SUCCESS;
+
 #if defined( USE_VIA_ACE_IF_PRESENT )
 
     if(ctx->inf.b[1] == 0xff)
@@ -203,6 +208,10 @@ AES_RETURN aes_ecb_decrypt(const unsigned char *ibuf, unsigned char *obuf,
     if(len & (AES_BLOCK_SIZE - 1))
         return EXIT_FAILURE;
 
+    // [wallet-core] hardware AES
+    if(aes_hw_ecb_decrypt(ibuf, obuf, (size_t)nb, ctx))
+        return EXIT_SUCCESS;
+
 #if defined( USE_VIA_ACE_IF_PRESENT )
 
     if(ctx->inf.b[1] == 0xff)
@@ -265,6 +274,10 @@ AES_RETURN aes_cbc_encrypt(const unsigned char *ibuf, unsigned char *obuf,
     if(len & (AES_BLOCK_SIZE - 1))
         return EXIT_FAILURE;
 
+    // [wallet-core] hardware AES
+    if(aes_hw_cbc_encrypt(ibuf, obuf, (size_t)nb, iv, ctx))
+        return EXIT_SUCCESS;
+
 #if defined( USE_VIA_ACE_IF_PRESENT )
 
     if(ctx->inf.b[1] == 0xff)
@@ -363,6 +376,10 @@ AES_RETURN aes_cbc_decrypt(const unsigned char *ibuf, unsigned char *obuf,
     if(len & (AES_BLOCK_SIZE - 1))
         return EXIT_FAILURE;
 
+    // [wallet-core] hardware AES
+    if(aes_hw_cbc_decrypt(ibuf, obuf, (size_t)nb, iv, ctx))
+        return EXIT_SUCCESS;
+
 #if defined( USE_VIA_ACE_IF_PRESENT )
 
     if(ctx->inf.b[1] == 0xff)
@@ -876,6 +893,14 @@ AES_RETURN aes_ctr_crypt(const unsigned char *ibuf, unsigned char *obuf,
             ctr_inc(cbuf), b_pos = 0;
     }
 
+    // [wallet-core] whole blocks with hardware AES, for the standard counter increment
+    if(ctr_inc == aes_ctr_cbuf_inc && len >= AES_BLOCK_SIZE
+        && aes_hw_ctr_crypt(ibuf, obuf, (size_t)(len >> AES_BLOCK_SIZE_P2), cbuf, ctx))
+    {
+        blen = len & ~(AES_BLOCK_SIZE - 1);
+        ibuf += blen, obuf += blen, len -= blen;
+    }
+
     while(len)
     {
         blen = (len > BFR_LENGTH ? BFR_LENGTH : len), len -= blen;
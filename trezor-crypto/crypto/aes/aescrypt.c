@@ -20,6 +20,7 @@ Issue Date: 20/12/2007
 
 #include <TrezorCrypto/aes/aesopt.h>
 #include <TrezorCrypto/aes/aestab.h>
+#include <TrezorCrypto/aes_hw.h>
 
 #if defined( USE_INTEL_AES_IF_PRESENT )
 #  include "aes_ni.h"
@@ -104,6 +105,10 @@ AES_RETURN aes_xi(encrypt)(const unsigned char *in, unsigned char *out, const ae
 	if(cx->inf.b[0] != 10 * AES_BLOCK_SIZE && cx->inf.b[0] != 12 * AES_BLOCK_SIZE && cx->inf.b[0] != 14 * AES_BLOCK_SIZE)
 		return EXIT_FAILURE;
 
+    // [wallet-core] hardware AES
+    if(aes_hw_ecb_encrypt(in, out, 1, cx))
+        return EXIT_SUCCESS;
+
 	kp = cx->ks;
     state_in(b0, in, kp);
 
@@ -239,6 +244,10 @@ AES_RETURN aes_xi(decrypt)(const unsigned char *in, unsigned char *out, const ae
 	if(cx->inf.b[0] != 10 * AES_BLOCK_SIZE && cx->inf.b[0] != 12 * AES_BLOCK_SIZE && cx->inf.b[0] != 14 * AES_BLOCK_SIZE)
 		return EXIT_FAILURE;
 
+    // [wallet-core] hardware AES
+    if(aes_hw_ecb_decrypt(in, out, 1, cx))
+        return EXIT_SUCCESS;
+
     kp = cx->ks + (key_ofs ? (cx->inf.b[0] >> 2) : 0);
     state_in(b0, in, kp);
 
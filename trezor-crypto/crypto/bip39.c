@@ -35,9 +35,10 @@
 
 #if USE_BIP39_CACHE
 
-int bip39_cache_index = 0;
+// [wallet-core] per thread, so that concurrent mnemonic_to_seed calls do not race
+static _Thread_local int bip39_cache_index = 0;
 
-CONFIDENTIAL struct {
+static _Thread_local CONFIDENTIAL struct {
   bool set;
   char mnemonic[256];
   char passphrase[64];
@@ -46,23 +47,25 @@ CONFIDENTIAL struct {
 
 #endif
 
-const char *mnemonic_generate(int strength) {
+const char *mnemonic_generate_r(int strength, char *mnemonic, size_t size) {
   if (strength % 32 || strength < 128 || strength > 256) {
     return 0;
   }
   uint8_t data[32] = {0};
   random_buffer(data, 32);
-  const char *r = mnemonic_from_data(data, strength / 8);
+  const char *r = mnemonic_from_data_r(data, strength / 8, mnemonic, size);
   memzero(data, sizeof(data));
   return r;
 }
 
-CONFIDENTIAL char mnemo[24 * 10];
-
-const char *mnemonic_from_data(const uint8_t *data, int len) {
+const char *mnemonic_from_data_r(const uint8_t *data, int len, char *mnemonic,
+                                 size_t size) {
   if (len % 4 || len < 16 || len > 32) {
     return 0;
   }
+  if (size < BIP39_MNEMONIC_MAX) {
+    return 0;
+  }
 
   uint8_t bits[32 + 1] = {0};
 
@@ -75,7 +78,7 @@ const char *mnemonic_from_data(const uint8_t *data, int len) {
   int mlen = len * 3 / 4;
 
   int i = 0, j = 0, idx = 0;
-  char *p = mnemo;
+  char *p = mnemonic;
   for (i = 0; i < mlen; i++) {
     idx = 0;
     for (j = 0; j < 11; j++) {
@@ -89,7 +92,19 @@ const char *mnemonic_from_data(const uint8_t *data, int len) {
   }
   memzero(bits, sizeof(bits));
 
-  return mnemo;
+  return mnemonic;
+}
+
+// [wallet-core] per thread: the returned pointer is only valid on the calling
+// thread, until its next call
+static _Thread_local CONFIDENTIAL char mnemo[BIP39_MNEMONIC_MAX];
+
+const char *mnemonic_generate(int strength) {
+  return mnemonic_generate_r(strength, mnemo, sizeof(mnemo));
+}
+
+const char *mnemonic_from_data(const uint8_t *data, int len) {
+  return mnemonic_from_data_r(data, len, mnemo, sizeof(mnemo));
 }
 
 void mnemonic_clear(void) { memzero(mnemo, sizeof(mnemo)); }
@@ -16,8 +16,10 @@
 #include <string.h>
 
 #include <TrezorCrypto/blake2b.h>
+#include <TrezorCrypto/blake2b_hw.h>
 #include <TrezorCrypto/blake2_common.h>
 #include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/options.h>
 
 typedef struct blake2b_param__
 {
@@ -216,6 +218,13 @@ static void blake2b_compress( blake2b_state *S, const uint8_t block[BLAKE2B_BLOC
   uint64_t v[16] = {0};
   size_t i = 0;
 
+#if USE_BLAKE2B_HW
+  // [wallet-core] vectorized compression
+  if( blake2b_hw_compress( S->h, block, S->t, S->f ) ) {
+    return;
+  }
+#endif
+
   for( i = 0; i < 16; ++i ) {
     m[i] = load64( block + i * sizeof( m[i] ) );
   }
@@ -0,0 +1,377 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Vectorized BLAKE2b.
+//
+// On ARM, the single message compression keeps the 4x4 state in 4 pairs of NEON
+// registers, one row each, and diagonalizes the rows between the column and the
+// diagonal steps. On x86, the batch compression runs 4 independent states at once,
+// one per 64-bit lane of the AVX2 registers; messages of any length are scheduled
+// over the lanes, as in keccak_x4.c.
+
+#include <string.h>
+
+#include <TrezorCrypto/blake2b_hw.h>
+#include <TrezorCrypto/blake2_common.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/options.h>
+
+#if USE_BLAKE2B_HW && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BLAKE2B_HW_X86 1
+#include <immintrin.h>
+#endif
+
+#if USE_BLAKE2B_HW && defined(__aarch64__) && defined(__ARM_NEON) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BLAKE2B_HW_ARM 1
+#include <arm_neon.h>
+#endif
+
+extern const uint64_t blake2b_IV[8];
+extern const uint8_t blake2b_sigma[12][16];
+
+#define BLAKE2B_ROUNDS 12
+
+#ifdef BLAKE2B_HW_X86
+
+#define BLAKE2B_ADD(a, b) _mm256_add_epi64((a), (b))
+#define BLAKE2B_XOR(a, b) _mm256_xor_si256((a), (b))
+#define BLAKE2B_ROT32(x) _mm256_shuffle_epi32((x), _MM_SHUFFLE(2, 3, 0, 1))
+#define BLAKE2B_ROT24(x) _mm256_shuffle_epi8((x), rot24)
+#define BLAKE2B_ROT16(x) _mm256_shuffle_epi8((x), rot16)
+#define BLAKE2B_ROT63(x) _mm256_xor_si256(_mm256_srli_epi64((x), 63), _mm256_add_epi64((x), (x)))
+
+/* The G function on 4 columns (or 4 messages) at once, with the message words m0 and m1 */
+#define BLAKE2B_G(a, b, c, d, m0, m1)                   \
+	do {                                                \
+		a = BLAKE2B_ADD(BLAKE2B_ADD(a, m0), b);         \
+		d = BLAKE2B_ROT32(BLAKE2B_XOR(d, a));           \
+		c = BLAKE2B_ADD(c, d);                          \
+		b = BLAKE2B_ROT24(BLAKE2B_XOR(b, c));           \
+		a = BLAKE2B_ADD(BLAKE2B_ADD(a, m1), b);         \
+		d = BLAKE2B_ROT16(BLAKE2B_XOR(d, a));           \
+		c = BLAKE2B_ADD(c, d);                          \
+		b = BLAKE2B_ROT63(BLAKE2B_XOR(b, c));           \
+	} while (0)
+
+#define BLAKE2B_ROT_MASKS                                                                                      \
+	const __m256i rot24 = _mm256_setr_epi8(3, 4, 5, 6, 7, 0, 1, 2, 11, 12, 13, 14, 15, 8, 9, 10, 3, 4, 5, 6, 7, 0, \
+	                                       1, 2, 11, 12, 13, 14, 15, 8, 9, 10);                                   \
+	const __m256i rot16 = _mm256_setr_epi8(2, 3, 4, 5, 6, 7, 0, 1, 10, 11, 12, 13, 14, 15, 8, 9, 2, 3, 4, 5, 6, 7, \
+	                                       0, 1, 10, 11, 12, 13, 14, 15, 8, 9)
+
+/* Compresses 4 states, word[i][lane] is word i of the lane */
+__attribute__((target("avx2")))
+static void blake2b_compress_x4_avx2(uint64_t h[8][4], const uint64_t m[16][4], const uint64_t t[2][4], const uint64_t f[2][4]) {
+	BLAKE2B_ROT_MASKS;
+	__m256i v[16], w[16];
+	for (int i = 0; i < 16; i++) {
+		w[i] = _mm256_loadu_si256((const __m256i *)m[i]);
+	}
+	for (int i = 0; i < 8; i++) {
+		v[i] = _mm256_loadu_si256((const __m256i *)h[i]);
+		v[i + 8] = _mm256_set1_epi64x((long long)blake2b_IV[i]);
+	}
+	v[12] = BLAKE2B_XOR(v[12], _mm256_loadu_si256((const __m256i *)t[0]));
+	v[13] = BLAKE2B_XOR(v[13], _mm256_loadu_si256((const __m256i *)t[1]));
+	v[14] = BLAKE2B_XOR(v[14], _mm256_loadu_si256((const __m256i *)f[0]));
+	v[15] = BLAKE2B_XOR(v[15], _mm256_loadu_si256((const __m256i *)f[1]));
+	for (int r = 0; r < BLAKE2B_ROUNDS; r++) {
+		const uint8_t *s = blake2b_sigma[r];
+		BLAKE2B_G(v[0], v[4], v[8], v[12], w[s[0]], w[s[1]]);
+		BLAKE2B_G(v[1], v[5], v[9], v[13], w[s[2]], w[s[3]]);
+		BLAKE2B_G(v[2], v[6], v[10], v[14], w[s[4]], w[s[5]]);
+		BLAKE2B_G(v[3], v[7], v[11], v[15], w[s[6]], w[s[7]]);
+		BLAKE2B_G(v[0], v[5], v[10], v[15], w[s[8]], w[s[9]]);
+		BLAKE2B_G(v[1], v[6], v[11], v[12], w[s[10]], w[s[11]]);
+		BLAKE2B_G(v[2], v[7], v[8], v[13], w[s[12]], w[s[13]]);
+		BLAKE2B_G(v[3], v[4], v[9], v[14], w[s[14]], w[s[15]]);
+	}
+	for (int i = 0; i < 8; i++) {
+		const __m256i hi = _mm256_loadu_si256((const __m256i *)h[i]);
+		_mm256_storeu_si256((__m256i *)h[i], BLAKE2B_XOR(hi, BLAKE2B_XOR(v[i], v[i + 8])));
+	}
+}
+
+static unsigned blake2b_hw_detect(void) {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? BLAKE2B_HW_AVX2 : 0;
+}
+
+#elif defined(BLAKE2B_HW_ARM)
+
+#define BLAKE2B_ROT32(x) vreinterpretq_u64_u32(vrev64q_u32(vreinterpretq_u32_u64(x)))
+#define BLAKE2B_ROTB(x, n)                                                                          \
+	vreinterpretq_u64_u8(vcombine_u8(vext_u8(vreinterpret_u8_u64(vget_low_u64(x)), vreinterpret_u8_u64(vget_low_u64(x)), (n)), \
+	                                 vext_u8(vreinterpret_u8_u64(vget_high_u64(x)), vreinterpret_u8_u64(vget_high_u64(x)), (n))))
+#define BLAKE2B_ROT63(x) veorq_u64(vshrq_n_u64((x), 63), vaddq_u64((x), (x)))
+
+/* Half of the G function on the two halves of the rows */
+#define BLAKE2B_G_HALF(al, ah, bl, bh, cl, ch, dl, dh, ml, mh, ROTD, ROTB) \
+	do {                                                                   \
+		al = vaddq_u64(vaddq_u64(al, ml), bl);                             \
+		ah = vaddq_u64(vaddq_u64(ah, mh), bh);                             \
+		dl = ROTD(veorq_u64(dl, al));                                      \
+		dh = ROTD(veorq_u64(dh, ah));                                      \
+		cl = vaddq_u64(cl, dl);                                            \
+		ch = vaddq_u64(ch, dh);                                            \
+		bl = ROTB(veorq_u64(bl, cl));                                      \
+		bh = ROTB(veorq_u64(bh, ch));                                      \
+	} while (0)
+
+#define BLAKE2B_ROT24(x) BLAKE2B_ROTB(x, 3)
+#define BLAKE2B_ROT16(x) BLAKE2B_ROTB(x, 2)
+
+#define BLAKE2B_PAIR(m, s, i0, i1) vcombine_u64(vcreate_u64((m)[(s)[i0]]), vcreate_u64((m)[(s)[i1]]))
+
+static void blake2b_compress_neon(uint64_t h[8], const uint8_t block[BLAKE2B_BLOCKBYTES], const uint64_t t[2], const uint64_t f[2]) {
+	uint64_t m[16];
+	for (int i = 0; i < 16; i++) {
+		m[i] = load64(block + 8 * i);
+	}
+	/* row r is held in rl (words 0 and 1) and rh (words 2 and 3) */
+	const uint64x2_t h0 = vld1q_u64(h), h1 = vld1q_u64(h + 2), h2 = vld1q_u64(h + 4), h3 = vld1q_u64(h + 6);
+	uint64x2_t al = h0, ah = h1, bl = h2, bh = h3;
+	uint64x2_t cl = vld1q_u64(blake2b_IV), ch = vld1q_u64(blake2b_IV + 2);
+	uint64x2_t dl = veorq_u64(vld1q_u64(blake2b_IV + 4), vld1q_u64(t));
+	uint64x2_t dh = veorq_u64(vld1q_u64(blake2b_IV + 6), vld1q_u64(f));
+	uint64x2_t tmp;
+	for (int r = 0; r < BLAKE2B_ROUNDS; r++) {
+		const uint8_t *s = blake2b_sigma[r];
+		/* columns */
+		BLAKE2B_G_HALF(al, ah, bl, bh, cl, ch, dl, dh, BLAKE2B_PAIR(m, s, 0, 2), BLAKE2B_PAIR(m, s, 4, 6), BLAKE2B_ROT32, BLAKE2B_ROT24);
+		BLAKE2B_G_HALF(al, ah, bl, bh, cl, ch, dl, dh, BLAKE2B_PAIR(m, s, 1, 3), BLAKE2B_PAIR(m, s, 5, 7), BLAKE2B_ROT16, BLAKE2B_ROT63);
+		/* diagonals: rotate row b by one word, c by two and d by three */
+		tmp = vextq_u64(bl, bh, 1);
+		bh = vextq_u64(bh, bl, 1);
+		bl = tmp;
+		tmp = cl;
+		cl = ch;
+		ch = tmp;
+		tmp = vextq_u64(dh, dl, 1);
+		dh = vextq_u64(dl, dh, 1);
+		dl = tmp;
+		BLAKE2B_G_HALF(al, ah, bl, bh, cl, ch, dl, dh, BLAKE2B_PAIR(m, s, 8, 10), BLAKE2B_PAIR(m, s, 12, 14), BLAKE2B_ROT32, BLAKE2B_ROT24);
+		BLAKE2B_G_HALF(al, ah, bl, bh, cl, ch, dl, dh, BLAKE2B_PAIR(m, s, 9, 11), BLAKE2B_PAIR(m, s, 13, 15), BLAKE2B_ROT16, BLAKE2B_ROT63);
+		tmp = vextq_u64(bh, bl, 1);
+		bh = vextq_u64(bl, bh, 1);
+		bl = tmp;
+		tmp = cl;
+		cl = ch;
+		ch = tmp;
+		tmp = vextq_u64(dl, dh, 1);
+		dh = vextq_u64(dh, dl, 1);
+		dl = tmp;
+	}
+	vst1q_u64(h, veorq_u64(h0, veorq_u64(al, cl)));
+	vst1q_u64(h + 2, veorq_u64(h1, veorq_u64(ah, ch)));
+	vst1q_u64(h + 4, veorq_u64(h2, veorq_u64(bl, dl)));
+	vst1q_u64(h + 6, veorq_u64(h3, veorq_u64(bh, dh)));
+	memzero(m, sizeof(m));
+}
+
+static unsigned blake2b_hw_detect(void) {
+	/* NEON is part of ARMv8 */
+	return BLAKE2B_HW_NEON;
+}
+
+#else
+
+static unsigned blake2b_hw_detect(void) {
+	return 0;
+}
+
+#endif
+
+/* Supported features, detected on first use */
+static unsigned blake2b_hw_supported_features = 0;
+static int blake2b_hw_detected = 0;
+/* Features in use */
+static unsigned blake2b_hw_features = 0;
+static int blake2b_hw_initialized = 0;
+
+/* The state above may be initialized from several threads at once, so it is
+   accessed atomically; the flags are published last. */
+#define BLAKE2B_HW_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define BLAKE2B_HW_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static unsigned blake2b_hw_detected_features(void) {
+	if (!BLAKE2B_HW_LOAD(&blake2b_hw_detected)) {
+		BLAKE2B_HW_STORE(&blake2b_hw_supported_features, blake2b_hw_detect());
+		BLAKE2B_HW_STORE(&blake2b_hw_detected, 1);
+	}
+	return BLAKE2B_HW_LOAD(&blake2b_hw_supported_features);
+}
+
+static unsigned blake2b_hw_selected(void) {
+	if (!BLAKE2B_HW_LOAD(&blake2b_hw_initialized)) {
+		blake2b_hw_select(blake2b_hw_detected_features());
+	}
+	return BLAKE2B_HW_LOAD(&blake2b_hw_features);
+}
+
+unsigned blake2b_hw_supported(void) {
+	return blake2b_hw_detected_features();
+}
+
+unsigned blake2b_hw_select(unsigned features) {
+	features &= blake2b_hw_detected_features();
+	BLAKE2B_HW_STORE(&blake2b_hw_features, features);
+	BLAKE2B_HW_STORE(&blake2b_hw_initialized, 1);
+	return features;
+}
+
+int blake2b_hw_compress(uint64_t h[8], const uint8_t block[BLAKE2B_BLOCKBYTES], const uint64_t t[2], const uint64_t f[2]) {
+#ifdef BLAKE2B_HW_ARM
+	if (blake2b_hw_selected() & BLAKE2B_HW_NEON) {
+		blake2b_compress_neon(h, block, t, f);
+		return 1;
+	}
+#else
+	/* on x86, a row-wise AVX2 compression is not faster than the portable code,
+	   AVX2 only helps batches */
+	(void)h, (void)block, (void)t, (void)f;
+#endif
+	return 0;
+}
+
+#ifdef BLAKE2B_HW_X86
+
+/* Number of compressed blocks of `len` bytes appended to `initial`, at least one */
+static size_t blake2b_block_count(const blake2b_state *initial, size_t len) {
+	const size_t total = initial->buflen + len;
+	return total == 0 ? 1 : (total + BLAKE2B_BLOCKBYTES - 1) / BLAKE2B_BLOCKBYTES;
+}
+
+/* Loads block `index` of the buffered bytes of `initial` followed by the message into the lane,
+   with its counter and flags */
+static void blake2b_lane_block(const blake2b_state *initial, const uint8_t *data, size_t len, size_t index,
+                               uint64_t m[16][4], uint64_t t[2][4], uint64_t f[2][4], int lane) {
+	const size_t total = initial->buflen + len;
+	const size_t offset = index * BLAKE2B_BLOCKBYTES;
+	const uint8_t *block = NULL;
+	uint8_t padded[BLAKE2B_BLOCKBYTES];
+	if (offset >= initial->buflen && offset - initial->buflen + BLAKE2B_BLOCKBYTES <= len) {
+		block = data + (offset - initial->buflen);
+	} else {
+		memset(padded, 0, sizeof(padded));
+		size_t filled = 0;
+		if (offset < initial->buflen) {
+			filled = initial->buflen - offset;
+			memcpy(padded, initial->buf + offset, filled);
+		}
+		const size_t start = offset + filled - initial->buflen;
+		if (start < len) {
+			const size_t rest = len - start < BLAKE2B_BLOCKBYTES - filled ? len - start : BLAKE2B_BLOCKBYTES - filled;
+			memcpy(padded + filled, data + start, rest);
+		}
+		block = padded;
+	}
+	for (int i = 0; i < 16; i++) {
+		m[i][lane] = load64(block + 8 * i);
+	}
+	if (block == padded) {
+		memzero(padded, sizeof(padded));
+	}
+
+	const size_t end = offset + BLAKE2B_BLOCKBYTES < total ? offset + BLAKE2B_BLOCKBYTES : total;
+	t[0][lane] = initial->t[0] + end;
+	t[1][lane] = initial->t[1] + (t[0][lane] < initial->t[0]);
+	const int last = index + 1 == blake2b_block_count(initial, len);
+	f[0][lane] = last ? (uint64_t)-1 : 0;
+	f[1][lane] = last && initial->last_node ? (uint64_t)-1 : 0;
+}
+
+static void blake2b_batch_avx2(const blake2b_state *initial, const uint8_t *const *data, const size_t *len, size_t count, uint8_t *digests) {
+	uint64_t h[8][4], m[16][4], t[2][4], f[2][4];
+	size_t message[4] = {0};
+	size_t block[4] = {0};
+	int active[4] = {0};
+	size_t next = 0;
+	int remaining = 0;
+
+	memset(m, 0, sizeof(m));
+	memset(t, 0, sizeof(t));
+	memset(f, 0, sizeof(f));
+	for (int lane = 0; lane < 4; lane++) {
+		for (int i = 0; i < 8; i++) {
+			h[i][lane] = initial->h[i];
+		}
+		if (next < count) {
+			message[lane] = next++;
+			active[lane] = 1;
+			remaining++;
+		}
+	}
+
+	while (remaining > 0) {
+		/* Idle lanes keep compressing leftover blocks, their results are ignored */
+		for (int lane = 0; lane < 4; lane++) {
+			if (active[lane]) {
+				blake2b_lane_block(initial, data[message[lane]], len[message[lane]], block[lane], m, t, f, lane);
+			}
+		}
+		blake2b_compress_x4_avx2(h, m, t, f);
+		for (int lane = 0; lane < 4; lane++) {
+			if (!active[lane] || ++block[lane] < blake2b_block_count(initial, len[message[lane]])) {
+				continue;
+			}
+			uint8_t buffer[BLAKE2B_OUTBYTES];
+			for (int i = 0; i < 8; i++) {
+				store64(buffer + 8 * i, h[i][lane]);
+				h[i][lane] = initial->h[i];
+			}
+			memcpy(digests + message[lane] * initial->outlen, buffer, initial->outlen);
+			memzero(buffer, sizeof(buffer));
+			block[lane] = 0;
+			if (next < count) {
+				message[lane] = next++;
+			} else {
+				active[lane] = 0;
+				remaining--;
+			}
+		}
+	}
+	memzero(h, sizeof(h));
+	memzero(m, sizeof(m));
+}
+
+#endif
+
+int blake2b_batch(const blake2b_state *initial, const uint8_t *const *data, const size_t *len, size_t count, uint8_t *digests) {
+	if (initial->f[0] != 0) {
+		return -1;
+	}
+#ifdef BLAKE2B_HW_X86
+	if (count > 1 && (blake2b_hw_selected() & BLAKE2B_HW_AVX2)) {
+		blake2b_batch_avx2(initial, data, len, count, digests);
+		return 0;
+	}
+#endif
+	for (size_t i = 0; i < count; i++) {
+		blake2b_state state = *initial;
+		blake2b_Update(&state, data[i], len[i]);
+		blake2b_Final(&state, digests + i * initial->outlen, initial->outlen);
+		memzero(&state, sizeof(state));
+	}
+	return 0;
+}
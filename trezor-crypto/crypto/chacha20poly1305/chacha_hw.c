@@ -0,0 +1,406 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Vectorized ChaCha20, selected at runtime.
+//
+// The blocks are computed several at a time, one block per vector lane: each of the
+// 16 state words is a vector holding that word of every block, the block counters
+// being consecutive across the lanes. The keystream is transposed back to the byte
+// order of the blocks before it is XORed with the input.
+
+#include <TrezorCrypto/chacha20poly1305/chacha_hw.h>
+#include <TrezorCrypto/options.h>
+
+#if USE_CHACHA_HW && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CHACHA_HW_X86 1
+#include <immintrin.h>
+#endif
+
+#if USE_CHACHA_HW && defined(__aarch64__) && defined(__ARM_NEON) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define CHACHA_HW_ARM 1
+#include <arm_neon.h>
+#endif
+
+#if USE_CHACHA_HW && defined(__wasm_simd128__)
+#define CHACHA_HW_WASM 1
+#include <wasm_simd128.h>
+#endif
+
+#define CHACHA_HW_BLOCK_SIZE 64
+#define CHACHA_HW_DOUBLE_ROUNDS 10
+
+/* One double round on the 16 words of the state, with the quarter round of the vector type */
+#define CHACHA_HW_DOUBLE_ROUND(QR, x)  \
+	QR(x[0], x[4], x[8], x[12]);       \
+	QR(x[1], x[5], x[9], x[13]);       \
+	QR(x[2], x[6], x[10], x[14]);      \
+	QR(x[3], x[7], x[11], x[15]);      \
+	QR(x[0], x[5], x[10], x[15]);      \
+	QR(x[1], x[6], x[11], x[12]);      \
+	QR(x[2], x[7], x[8], x[13]);       \
+	QR(x[3], x[4], x[9], x[14])
+
+#ifdef CHACHA_HW_X86
+
+#define CHACHA_SSE2_ROTL(v, n) _mm_or_si128(_mm_slli_epi32((v), (n)), _mm_srli_epi32((v), 32 - (n)))
+#define CHACHA_SSE2_QR(a, b, c, d)                                    \
+	do {                                                              \
+		a = _mm_add_epi32(a, b);                                      \
+		d = CHACHA_SSE2_ROTL(_mm_xor_si128(d, a), 16);                \
+		c = _mm_add_epi32(c, d);                                      \
+		b = CHACHA_SSE2_ROTL(_mm_xor_si128(b, c), 12);                \
+		a = _mm_add_epi32(a, b);                                      \
+		d = CHACHA_SSE2_ROTL(_mm_xor_si128(d, a), 8);                 \
+		c = _mm_add_epi32(c, d);                                      \
+		b = CHACHA_SSE2_ROTL(_mm_xor_si128(b, c), 7);                 \
+	} while (0)
+
+/* Transposes the 4x4 words a, b, c, d: afterwards a holds lane 0 of each, b lane 1, ... */
+#define CHACHA_SSE2_TRANSPOSE(a, b, c, d)                             \
+	do {                                                              \
+		const __m128i t0 = _mm_unpacklo_epi32(a, b);                  \
+		const __m128i t1 = _mm_unpacklo_epi32(c, d);                  \
+		const __m128i t2 = _mm_unpackhi_epi32(a, b);                  \
+		const __m128i t3 = _mm_unpackhi_epi32(c, d);                  \
+		a = _mm_unpacklo_epi64(t0, t1);                               \
+		b = _mm_unpackhi_epi64(t0, t1);                               \
+		c = _mm_unpacklo_epi64(t2, t3);                               \
+		d = _mm_unpackhi_epi64(t2, t3);                               \
+	} while (0)
+
+__attribute__((target("sse2")))
+static void chacha_sse2_4blocks(const uint32_t input[16], const uint8_t *in, uint8_t *out) {
+	__m128i j[16];
+	__m128i x[16];
+	for (int i = 0; i < 16; i++) {
+		j[i] = _mm_set1_epi32((int)input[i]);
+	}
+	j[12] = _mm_add_epi32(j[12], _mm_set_epi32(3, 2, 1, 0));
+	for (int i = 0; i < 16; i++) {
+		x[i] = j[i];
+	}
+	for (int r = 0; r < CHACHA_HW_DOUBLE_ROUNDS; r++) {
+		CHACHA_HW_DOUBLE_ROUND(CHACHA_SSE2_QR, x);
+	}
+	for (int i = 0; i < 16; i++) {
+		x[i] = _mm_add_epi32(x[i], j[i]);
+	}
+	for (int g = 0; g < 4; g++) {
+		/* words 4g..4g+3 of the 4 blocks */
+		CHACHA_SSE2_TRANSPOSE(x[4 * g], x[4 * g + 1], x[4 * g + 2], x[4 * g + 3]);
+		for (int b = 0; b < 4; b++) {
+			const size_t offset = CHACHA_HW_BLOCK_SIZE * b + 16 * g;
+			const __m128i m = _mm_loadu_si128((const __m128i *)(in + offset));
+			_mm_storeu_si128((__m128i *)(out + offset), _mm_xor_si128(m, x[4 * g + b]));
+		}
+	}
+}
+
+#define CHACHA_AVX2_ROTL(v, n) _mm256_or_si256(_mm256_slli_epi32((v), (n)), _mm256_srli_epi32((v), 32 - (n)))
+#define CHACHA_AVX2_QR(a, b, c, d)                                    \
+	do {                                                              \
+		a = _mm256_add_epi32(a, b);                                   \
+		d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot16);       \
+		c = _mm256_add_epi32(c, d);                                   \
+		b = CHACHA_AVX2_ROTL(_mm256_xor_si256(b, c), 12);             \
+		a = _mm256_add_epi32(a, b);                                   \
+		d = _mm256_shuffle_epi8(_mm256_xor_si256(d, a), rot8);        \
+		c = _mm256_add_epi32(c, d);                                   \
+		b = CHACHA_AVX2_ROTL(_mm256_xor_si256(b, c), 7);              \
+	} while (0)
+
+/* Transposes the 4x4 words a, b, c, d within each 128-bit half */
+#define CHACHA_AVX2_TRANSPOSE(a, b, c, d)                             \
+	do {                                                              \
+		const __m256i t0 = _mm256_unpacklo_epi32(a, b);               \
+		const __m256i t1 = _mm256_unpacklo_epi32(c, d);               \
+		const __m256i t2 = _mm256_unpackhi_epi32(a, b);               \
+		const __m256i t3 = _mm256_unpackhi_epi32(c, d);               \
+		a = _mm256_unpacklo_epi64(t0, t1);                            \
+		b = _mm256_unpackhi_epi64(t0, t1);                            \
+		c = _mm256_unpacklo_epi64(t2, t3);                            \
+		d = _mm256_unpackhi_epi64(t2, t3);                            \
+	} while (0)
+
+__attribute__((target("avx2")))
+static void chacha_avx2_xor32(const uint8_t *in, uint8_t *out, __m256i keystream) {
+	const __m256i m = _mm256_loadu_si256((const __m256i *)in);
+	_mm256_storeu_si256((__m256i *)out, _mm256_xor_si256(m, keystream));
+}
+
+__attribute__((target("avx2")))
+static void chacha_avx2_8blocks(const uint32_t input[16], const uint8_t *in, uint8_t *out) {
+	/* byte rotations of each 32-bit word */
+	const __m256i rot16 = _mm256_set_epi8(13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2,
+	                                      13, 12, 15, 14, 9, 8, 11, 10, 5, 4, 7, 6, 1, 0, 3, 2);
+	const __m256i rot8 = _mm256_set_epi8(14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3,
+	                                     14, 13, 12, 15, 10, 9, 8, 11, 6, 5, 4, 7, 2, 1, 0, 3);
+	__m256i j[16];
+	__m256i x[16];
+	for (int i = 0; i < 16; i++) {
+		j[i] = _mm256_set1_epi32((int)input[i]);
+	}
+	j[12] = _mm256_add_epi32(j[12], _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+	for (int i = 0; i < 16; i++) {
+		x[i] = j[i];
+	}
+	for (int r = 0; r < CHACHA_HW_DOUBLE_ROUNDS; r++) {
+		CHACHA_HW_DOUBLE_ROUND(CHACHA_AVX2_QR, x);
+	}
+	for (int i = 0; i < 16; i++) {
+		x[i] = _mm256_add_epi32(x[i], j[i]);
+	}
+	/* afterwards x[4g + b] holds words 4g..4g+3 of block b in its low half, and of block b + 4 in its high half */
+	for (int g = 0; g < 4; g++) {
+		CHACHA_AVX2_TRANSPOSE(x[4 * g], x[4 * g + 1], x[4 * g + 2], x[4 * g + 3]);
+	}
+	for (int b = 0; b < 4; b++) {
+		const size_t low = CHACHA_HW_BLOCK_SIZE * b;
+		const size_t high = CHACHA_HW_BLOCK_SIZE * (b + 4);
+		chacha_avx2_xor32(in + low, out + low, _mm256_permute2x128_si256(x[b], x[4 + b], 0x20));
+		chacha_avx2_xor32(in + low + 32, out + low + 32, _mm256_permute2x128_si256(x[8 + b], x[12 + b], 0x20));
+		chacha_avx2_xor32(in + high, out + high, _mm256_permute2x128_si256(x[b], x[4 + b], 0x31));
+		chacha_avx2_xor32(in + high + 32, out + high + 32, _mm256_permute2x128_si256(x[8 + b], x[12 + b], 0x31));
+	}
+}
+
+static unsigned chacha_hw_detect(void) {
+	__builtin_cpu_init();
+	unsigned features = 0;
+	if (__builtin_cpu_supports("sse2")) {
+		features |= CHACHA_HW_SSE2;
+	}
+	if (__builtin_cpu_supports("avx2")) {
+		features |= CHACHA_HW_AVX2;
+	}
+	return features;
+}
+
+#elif defined(CHACHA_HW_ARM)
+
+#define CHACHA_NEON_ROTL(v, n) vsriq_n_u32(vshlq_n_u32((v), (n)), (v), 32 - (n))
+#define CHACHA_NEON_ROTL16(v) vreinterpretq_u32_u16(vrev32q_u16(vreinterpretq_u16_u32(v)))
+#define CHACHA_NEON_QR(a, b, c, d)                                    \
+	do {                                                              \
+		a = vaddq_u32(a, b);                                          \
+		d = CHACHA_NEON_ROTL16(veorq_u32(d, a));                      \
+		c = vaddq_u32(c, d);                                          \
+		b = CHACHA_NEON_ROTL(veorq_u32(b, c), 12);                    \
+		a = vaddq_u32(a, b);                                          \
+		d = CHACHA_NEON_ROTL(veorq_u32(d, a), 8);                     \
+		c = vaddq_u32(c, d);                                          \
+		b = CHACHA_NEON_ROTL(veorq_u32(b, c), 7);                     \
+	} while (0)
+
+/* Transposes the 4x4 words a, b, c, d: afterwards a holds lane 0 of each, b lane 1, ... */
+#define CHACHA_NEON_TRANSPOSE(a, b, c, d)                                  \
+	do {                                                                   \
+		const uint32x4x2_t t0 = vtrnq_u32(a, b);                           \
+		const uint32x4x2_t t1 = vtrnq_u32(c, d);                           \
+		a = vcombine_u32(vget_low_u32(t0.val[0]), vget_low_u32(t1.val[0]));   \
+		b = vcombine_u32(vget_low_u32(t0.val[1]), vget_low_u32(t1.val[1]));   \
+		c = vcombine_u32(vget_high_u32(t0.val[0]), vget_high_u32(t1.val[0])); \
+		d = vcombine_u32(vget_high_u32(t0.val[1]), vget_high_u32(t1.val[1])); \
+	} while (0)
+
+static void chacha_neon_4blocks(const uint32_t input[16], const uint8_t *in, uint8_t *out) {
+	static const uint32_t lanes[4] = {0, 1, 2, 3};
+	uint32x4_t j[16];
+	uint32x4_t x[16];
+	for (int i = 0; i < 16; i++) {
+		j[i] = vdupq_n_u32(input[i]);
+	}
+	j[12] = vaddq_u32(j[12], vld1q_u32(lanes));
+	for (int i = 0; i < 16; i++) {
+		x[i] = j[i];
+	}
+	for (int r = 0; r < CHACHA_HW_DOUBLE_ROUNDS; r++) {
+		CHACHA_HW_DOUBLE_ROUND(CHACHA_NEON_QR, x);
+	}
+	for (int i = 0; i < 16; i++) {
+		x[i] = vaddq_u32(x[i], j[i]);
+	}
+	for (int g = 0; g < 4; g++) {
+		/* words 4g..4g+3 of the 4 blocks */
+		CHACHA_NEON_TRANSPOSE(x[4 * g], x[4 * g + 1], x[4 * g + 2], x[4 * g + 3]);
+		for (int b = 0; b < 4; b++) {
+			const size_t offset = CHACHA_HW_BLOCK_SIZE * b + 16 * g;
+			const uint8x16_t m = vld1q_u8(in + offset);
+			vst1q_u8(out + offset, veorq_u8(m, vreinterpretq_u8_u32(x[4 * g + b])));
+		}
+	}
+}
+
+static unsigned chacha_hw_detect(void) {
+	/* NEON is part of AArch64 */
+	return CHACHA_HW_NEON;
+}
+
+#elif defined(CHACHA_HW_WASM)
+
+#define CHACHA_WASM_ROTL(v, n) wasm_v128_or(wasm_i32x4_shl((v), (n)), wasm_u32x4_shr((v), 32 - (n)))
+#define CHACHA_WASM_ROTL16(v) wasm_i8x16_shuffle((v), (v), 2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13)
+#define CHACHA_WASM_ROTL8(v) wasm_i8x16_shuffle((v), (v), 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14)
+#define CHACHA_WASM_QR(a, b, c, d)                                    \
+	do {                                                              \
+		a = wasm_i32x4_add(a, b);                                     \
+		d = CHACHA_WASM_ROTL16(wasm_v128_xor(d, a));                  \
+		c = wasm_i32x4_add(c, d);                                     \
+		b = CHACHA_WASM_ROTL(wasm_v128_xor(b, c), 12);                \
+		a = wasm_i32x4_add(a, b);                                     \
+		d = CHACHA_WASM_ROTL8(wasm_v128_xor(d, a));                   \
+		c = wasm_i32x4_add(c, d);                                     \
+		b = CHACHA_WASM_ROTL(wasm_v128_xor(b, c), 7);                 \
+	} while (0)
+
+/* Transposes the 4x4 words a, b, c, d: afterwards a holds lane 0 of each, b lane 1, ... */
+#define CHACHA_WASM_TRANSPOSE(a, b, c, d)                             \
+	do {                                                              \
+		const v128_t t0 = wasm_i32x4_shuffle(a, b, 0, 4, 1, 5);       \
+		const v128_t t1 = wasm_i32x4_shuffle(c, d, 0, 4, 1, 5);       \
+		const v128_t t2 = wasm_i32x4_shuffle(a, b, 2, 6, 3, 7);       \
+		const v128_t t3 = wasm_i32x4_shuffle(c, d, 2, 6, 3, 7);       \
+		a = wasm_i64x2_shuffle(t0, t1, 0, 2);                         \
+		b = wasm_i64x2_shuffle(t0, t1, 1, 3);                         \
+		c = wasm_i64x2_shuffle(t2, t3, 0, 2);                         \
+		d = wasm_i64x2_shuffle(t2, t3, 1, 3);                         \
+	} while (0)
+
+static void chacha_simd128_4blocks(const uint32_t input[16], const uint8_t *in, uint8_t *out) {
+	v128_t j[16];
+	v128_t x[16];
+	for (int i = 0; i < 16; i++) {
+		j[i] = wasm_i32x4_splat((int32_t)input[i]);
+	}
+	j[12] = wasm_i32x4_add(j[12], wasm_i32x4_make(0, 1, 2, 3));
+	for (int i = 0; i < 16; i++) {
+		x[i] = j[i];
+	}
+	for (int r = 0; r < CHACHA_HW_DOUBLE_ROUNDS; r++) {
+		CHACHA_HW_DOUBLE_ROUND(CHACHA_WASM_QR, x);
+	}
+	for (int i = 0; i < 16; i++) {
+		x[i] = wasm_i32x4_add(x[i], j[i]);
+	}
+	for (int g = 0; g < 4; g++) {
+		/* words 4g..4g+3 of the 4 blocks */
+		CHACHA_WASM_TRANSPOSE(x[4 * g], x[4 * g + 1], x[4 * g + 2], x[4 * g + 3]);
+		for (int b = 0; b < 4; b++) {
+			const size_t offset = CHACHA_HW_BLOCK_SIZE * b + 16 * g;
+			const v128_t m = wasm_v128_load(in + offset);
+			wasm_v128_store(out + offset, wasm_v128_xor(m, x[4 * g + b]));
+		}
+	}
+}
+
+static unsigned chacha_hw_detect(void) {
+	/* SIMD128 is chosen at build time, modules using it don't load without support */
+	return CHACHA_HW_SIMD128;
+}
+
+#else
+
+static unsigned chacha_hw_detect(void) {
+	return 0;
+}
+
+#endif
+
+/* Supported features, detected on first use */
+static unsigned chacha_hw_supported_features = 0;
+static int chacha_hw_detected = 0;
+/* Features in use */
+static unsigned chacha_hw_features = 0;
+static int chacha_hw_initialized = 0;
+
+/* The state above may be initialized from several threads at once, so it is
+   accessed atomically; the flags are published last. */
+#define CHACHA_HW_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define CHACHA_HW_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static unsigned chacha_hw_detected_features(void) {
+	if (!CHACHA_HW_LOAD(&chacha_hw_detected)) {
+		CHACHA_HW_STORE(&chacha_hw_supported_features, chacha_hw_detect());
+		CHACHA_HW_STORE(&chacha_hw_detected, 1);
+	}
+	return CHACHA_HW_LOAD(&chacha_hw_supported_features);
+}
+
+unsigned chacha_hw_supported(void) {
+	return chacha_hw_detected_features();
+}
+
+static unsigned chacha_hw_selected(void) {
+	if (!CHACHA_HW_LOAD(&chacha_hw_initialized)) {
+		chacha_hw_select(chacha_hw_detected_features());
+	}
+	return CHACHA_HW_LOAD(&chacha_hw_features);
+}
+
+unsigned chacha_hw_select(unsigned features) {
+	features &= chacha_hw_detected_features();
+	CHACHA_HW_STORE(&chacha_hw_features, features);
+	CHACHA_HW_STORE(&chacha_hw_initialized, 1);
+	return features;
+}
+
+size_t chacha_hw_xor_blocks(uint32_t input[16], const uint8_t *in, uint8_t *out, size_t blocks) {
+	const unsigned features = chacha_hw_selected();
+	size_t done = 0;
+	/* the lanes must not wrap the 32-bit counter, whose carry the portable code handles */
+#ifdef CHACHA_HW_X86
+	if (features & CHACHA_HW_AVX2) {
+		while (blocks - done >= 8 && input[12] <= UINT32_MAX - 8) {
+			chacha_avx2_8blocks(input, in + CHACHA_HW_BLOCK_SIZE * done, out + CHACHA_HW_BLOCK_SIZE * done);
+			input[12] += 8;
+			done += 8;
+		}
+	}
+	if (features & CHACHA_HW_SSE2) {
+		while (blocks - done >= 4 && input[12] <= UINT32_MAX - 4) {
+			chacha_sse2_4blocks(input, in + CHACHA_HW_BLOCK_SIZE * done, out + CHACHA_HW_BLOCK_SIZE * done);
+			input[12] += 4;
+			done += 4;
+		}
+	}
+#elif defined(CHACHA_HW_ARM)
+	if (features & CHACHA_HW_NEON) {
+		while (blocks - done >= 4 && input[12] <= UINT32_MAX - 4) {
+			chacha_neon_4blocks(input, in + CHACHA_HW_BLOCK_SIZE * done, out + CHACHA_HW_BLOCK_SIZE * done);
+			input[12] += 4;
+			done += 4;
+		}
+	}
+#elif defined(CHACHA_HW_WASM)
+	if (features & CHACHA_HW_SIMD128) {
+		while (blocks - done >= 4 && input[12] <= UINT32_MAX - 4) {
+			chacha_simd128_4blocks(input, in + CHACHA_HW_BLOCK_SIZE * done, out + CHACHA_HW_BLOCK_SIZE * done);
+			input[12] += 4;
+			done += 4;
+		}
+	}
+#else
+	(void)features, (void)input, (void)in, (void)out, (void)blocks;
+#endif
+	return done;
+}
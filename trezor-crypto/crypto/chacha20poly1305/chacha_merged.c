@@ -6,6 +6,8 @@ Public domain.
 
 #include <TrezorCrypto/chacha20poly1305/ecrypt-sync.h>
 #include <TrezorCrypto/chacha20poly1305/ecrypt-portable.h>
+#include <TrezorCrypto/chacha20poly1305/chacha_hw.h>
+#include <TrezorCrypto/options.h>
 
 #define ROTATE(v,c) (ROTL32(v,c))
 #define XOR(v,w) ((v) ^ (w))
@@ -69,6 +71,17 @@ void ECRYPT_encrypt_bytes(ECRYPT_ctx *x,const u8 *m,u8 *c,u32 bytes)
 
   if (!bytes) return;
 
+#if USE_CHACHA_HW
+  // [wallet-core] whole blocks go to the vectorized code first, when it is in use
+  if (bytes >= 4 * 64) {
+    const size_t done = chacha_hw_xor_blocks(x->input, m, c, bytes / 64);
+    m += 64 * done;
+    c += 64 * done;
+    bytes -= (u32)(64 * done);
+    if (!bytes) return;
+  }
+#endif
+
   j0 = x->input[0];
   j1 = x->input[1];
   j2 = x->input[2];
@@ -1,5 +1,10 @@
 #include <TrezorCrypto/chacha20poly1305/poly1305-donna.h>
+// [wallet-core] the 64-bit implementation where the compiler has 128-bit integers
+#if defined(__SIZEOF_INT128__)
+#include <TrezorCrypto/chacha20poly1305/poly1305-donna-64.h>
+#else
 #include <TrezorCrypto/chacha20poly1305/poly1305-donna-32.h>
+#endif
 
 void
 poly1305_update(poly1305_context *ctx, const unsigned char *m, size_t bytes) {
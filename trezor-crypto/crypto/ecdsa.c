@@ -31,6 +31,9 @@
 #include <TrezorCrypto/base58.h>
 #include <TrezorCrypto/bignum.h>
 #include <TrezorCrypto/ecdsa.h>
+#if USE_ECDSA64
+#include <TrezorCrypto/ecdsa64.h>
+#endif
 #include <TrezorCrypto/hmac.h>
 #include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/rand.h>
@@ -412,6 +415,13 @@ void point_multiply(const ecdsa_curve *curve, const bignum256 *k,
   //  Side Channel Attacks.
   assert(bn_is_less(k, &curve->order));
 
+#if USE_ECDSA64
+  // [wallet-core] same algorithm with 64-bit limbs for the supported curves
+  if (ecdsa64_point_multiply(curve, k, p, res) == 0) {
+    return;
+  }
+#endif
+
   int i = 0, j = 0;
   CONFIDENTIAL bignum256 a;
   uint32_t *aptr = NULL;
@@ -533,6 +543,13 @@ void scalar_multiply(const ecdsa_curve *curve, const bignum256 *k,
                      curve_point *res) {
   assert(bn_is_less(k, &curve->order));
 
+#if USE_ECDSA64
+  // [wallet-core] same algorithm with 64-bit limbs for the supported curves
+  if (ecdsa64_scalar_multiply(curve, k, res) == 0) {
+    return;
+  }
+#endif
+
   int i = {0}, j = {0};
   CONFIDENTIAL bignum256 a;
   uint32_t is_even = (k->val[0] & 1) - 1;
@@ -665,6 +682,15 @@ int ecdsa_sign(const ecdsa_curve *curve, HasherType hasher_sign,
 int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
                       const uint8_t *digest, uint8_t *sig, uint8_t *pby,
                       int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
+  return ecdsa_sign_digest_with_key_state(curve, priv_key, NULL, digest, sig,
+                                          pby, is_canonical);
+}
+
+// key_state is optional
+int ecdsa_sign_digest_with_key_state(
+    const ecdsa_curve *curve, const uint8_t *priv_key,
+    const rfc6979_key_state *key_state, const uint8_t *digest, uint8_t *sig,
+    uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64])) {
   int i = 0;
   curve_point R = {0};
   bignum256 k = {0}, z = {0}, randk = {0};
@@ -673,7 +699,13 @@ int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
 
 #if USE_RFC6979
   rfc6979_state rng = {0};
-  init_rfc6979(priv_key, digest, &rng);
+  if (key_state) {
+    init_rfc6979_with_key(key_state, priv_key, digest, &rng);
+  } else {
+    init_rfc6979(priv_key, digest, &rng);
+  }
+#else
+  (void)key_state;
 #endif
 
   bn_read_be(digest, &z);
@@ -883,6 +915,12 @@ void compress_coords(const curve_point *cp, uint8_t *compressed) {
 
 void uncompress_coords(const ecdsa_curve *curve, uint8_t odd,
                        const bignum256 *x, bignum256 *y) {
+#if USE_ECDSA64
+  // [wallet-core] same computation with 64-bit limbs for the supported curves
+  if (ecdsa64_uncompress_coords(curve, odd, x, y) == 0) {
+    return;
+  }
+#endif
   // y^2 = x^3 + a*x + b
   memcpy(y, x, sizeof(bignum256));       // y is x
   bn_multiply(x, y, &curve->prime);      // y is x^2
@@ -1003,20 +1041,32 @@ int ecdsa_recover_pub_from_sig(const ecdsa_curve *curve, uint8_t *pub_key,
   bn_read_be(digest, &e);
   bn_mod(&e, &curve->order);
   bn_subtract(&curve->order, &e, &e);
-  // r = r^-1
-  bn_inverse(&r, &curve->order);
-  // e = -digest * r^-1
-  bn_multiply(&r, &e, &curve->order);
-  bn_mod(&e, &curve->order);
-  // s = s * r^-1
-  bn_multiply(&r, &s, &curve->order);
-  bn_mod(&s, &curve->order);
-  // cp = s * r^-1 * k * G
-  point_multiply(curve, &s, &cp, &cp);
-  // cp2 = -digest * r^-1 * G
-  scalar_multiply(curve, &e, &cp2);
-  // cp = (s * r^-1 * k - digest * r^-1) * G = Pub
-  point_add(curve, &cp2, &cp);
+#if USE_ECDSA64
+  // [wallet-core] e = -digest * r^-1, s = s * r^-1
+  if (ecdsa64_verify_scalars(curve, &s, &r, &e, &e, &s) != 0)
+#endif
+  {
+    // r = r^-1
+    bn_inverse(&r, &curve->order);
+    // e = -digest * r^-1
+    bn_multiply(&r, &e, &curve->order);
+    bn_mod(&e, &curve->order);
+    // s = s * r^-1
+    bn_multiply(&r, &s, &curve->order);
+    bn_mod(&s, &curve->order);
+  }
+#if USE_ECDSA64
+  // [wallet-core] cp = -digest * r^-1 * G + s * r^-1 * R in one pass
+  if (ecdsa64_double_multiply(curve, &e, &s, &cp, &cp) != 0)
+#endif
+  {
+    // cp = s * r^-1 * k * G
+    point_multiply(curve, &s, &cp, &cp);
+    // cp2 = -digest * r^-1 * G
+    scalar_multiply(curve, &e, &cp2);
+    // cp = (s * r^-1 * k - digest * r^-1) * G = Pub
+    point_add(curve, &cp2, &cp);
+  }
   pub_key[0] = 0x04;
   bn_write_be(&cp.x, pub_key + 1);
   bn_write_be(&cp.y, pub_key + 33);
@@ -1054,17 +1104,29 @@ int ecdsa_verify_digest(const ecdsa_curve *curve, const uint8_t *pub_key,
   }
 
   if (result == 0) {
-    bn_inverse(&s, &curve->order);       // s = s^-1
-    bn_multiply(&s, &z, &curve->order);  // z = z * s  [u1 = z * s^-1 mod n]
-    bn_mod(&z, &curve->order);
+#if USE_ECDSA64
+    // [wallet-core] z = u1 = z * s^-1 mod n, s = u2 = r * s^-1 mod n
+    if (ecdsa64_verify_scalars(curve, &r, &s, &z, &z, &s) != 0)
+#endif
+    {
+      bn_inverse(&s, &curve->order);       // s = s^-1
+      bn_multiply(&s, &z, &curve->order);  // z = z * s  [u1 = z * s^-1 mod n]
+      bn_mod(&z, &curve->order);
+      bn_multiply(&r, &s, &curve->order);  // s = r * s  [u2 = r * s^-1 mod n]
+      bn_mod(&s, &curve->order);
+    }
   }
 
   if (result == 0) {
-    bn_multiply(&r, &s, &curve->order);  // s = r * s  [u2 = r * s^-1 mod n]
-    bn_mod(&s, &curve->order);
-    scalar_multiply(curve, &z, &res);       // res = z * G    [= u1 * G]
-    point_multiply(curve, &s, &pub, &pub);  // pub = s * pub  [= u2 * Q]
-    point_add(curve, &pub, &res);  // res = pub + res  [R = u1 * G + u2 * Q]
+#if USE_ECDSA64
+    // [wallet-core] res = u1 * G + u2 * Q in one pass
+    if (ecdsa64_double_multiply(curve, &z, &s, &pub, &res) != 0)
+#endif
+    {
+      scalar_multiply(curve, &z, &res);       // res = z * G    [= u1 * G]
+      point_multiply(curve, &s, &pub, &pub);  // pub = s * pub  [= u2 * Q]
+      point_add(curve, &pub, &res);  // res = pub + res  [R = u1 * G + u2 * Q]
+    }
     if (point_is_infinity(&res)) {
       // R == Infinity
       result = 4;
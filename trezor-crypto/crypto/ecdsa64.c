@@ -0,0 +1,1078 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Point multiplication with 4 64-bit limbs.
+//
+// The elements modulo the field prime and modulo the group order are 4 little-endian
+// 64-bit limbs in Montgomery form (x * 2^256 mod m), always fully reduced. The
+// Montgomery multiplication works for any odd modulus, so the same code serves
+// secp256k1 (a = 0) and nist256p1 (a = -3), the two curves of the secp256k1 and
+// nist256p1 tables.
+//
+// The point formulas, the signed odd 4-bit recoding of the scalar and the random
+// Jacobian blinding are those of ecdsa.c; the results are identical, only faster.
+// Table lookups with secret indices scan the whole row.
+
+#include <string.h>
+
+#include <TrezorCrypto/ecdsa64.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/nist256p1.h>
+#include <TrezorCrypto/rand.h>
+#include <TrezorCrypto/secp256k1.h>
+
+#if defined(__SIZEOF_INT128__)
+
+__extension__ typedef unsigned __int128 ecdsa64_u128;
+
+/* Modulus with its Montgomery constants */
+typedef struct {
+	uint64_t m[4];
+	uint64_t r2[4];  /* 2^512 mod m */
+	uint64_t one[4]; /* 2^256 mod m */
+	uint64_t n0;     /* -m^-1 mod 2^64 */
+} ecdsa64_modulus;
+
+typedef struct {
+	const ecdsa_curve *curve;
+	ecdsa64_modulus prime;
+	ecdsa64_modulus order;
+} ecdsa64_params;
+
+/* Jacobian point, (x / z^2, y / z^3), coordinates in Montgomery form */
+typedef struct {
+	uint64_t x[4], y[4], z[4];
+} ecdsa64_jacobian;
+
+/* Affine point, coordinates in Montgomery form */
+typedef struct {
+	uint64_t x[4], y[4];
+} ecdsa64_affine;
+
+static const ecdsa64_params ecdsa64_curves[] = {
+	{
+		&secp256k1,
+		{
+			{0xFFFFFFFEFFFFFC2FULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFFFFFFFFFFULL},
+			{0x000007A2000E90A1ULL, 0x0000000000000001ULL, 0x0000000000000000ULL, 0x0000000000000000ULL},
+			{0x00000001000003D1ULL, 0x0000000000000000ULL, 0x0000000000000000ULL, 0x0000000000000000ULL},
+			0xD838091DD2253531ULL,
+		},
+		{
+			{0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL},
+			{0x896CF21467D7D140ULL, 0x741496C20E7CF878ULL, 0xE697F5E45BCD07C6ULL, 0x9D671CD581C69BC5ULL},
+			{0x402DA1732FC9BEBFULL, 0x4551231950B75FC4ULL, 0x0000000000000001ULL, 0x0000000000000000ULL},
+			0x4B0DFF665588B13FULL,
+		},
+	},
+	{
+		&nist256p1,
+		{
+			{0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFFULL, 0x0000000000000000ULL, 0xFFFFFFFF00000001ULL},
+			{0x0000000000000003ULL, 0xFFFFFFFBFFFFFFFFULL, 0xFFFFFFFFFFFFFFFEULL, 0x00000004FFFFFFFDULL},
+			{0x0000000000000001ULL, 0xFFFFFFFF00000000ULL, 0xFFFFFFFFFFFFFFFFULL, 0x00000000FFFFFFFEULL},
+			0x0000000000000001ULL,
+		},
+		{
+			{0xF3B9CAC2FC632551ULL, 0xBCE6FAADA7179E84ULL, 0xFFFFFFFFFFFFFFFFULL, 0xFFFFFFFF00000000ULL},
+			{0x83244C95BE79EEA2ULL, 0x4699799C49BD6FA6ULL, 0x2845B2392B6BEC59ULL, 0x66E12D94F3D95620ULL},
+			{0x0C46353D039CDAAFULL, 0x4319055258E8617BULL, 0x0000000000000000ULL, 0x00000000FFFFFFFFULL},
+			0xCCD1C8AAEE00BC4FULL,
+		},
+	},
+};
+
+static const ecdsa64_params *ecdsa64_find(const ecdsa_curve *curve) {
+	for (size_t i = 0; i < sizeof(ecdsa64_curves) / sizeof(ecdsa64_curves[0]); i++) {
+		if (ecdsa64_curves[i].curve == curve) {
+			return &ecdsa64_curves[i];
+		}
+	}
+	return NULL;
+}
+
+static void mod_select(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], uint64_t flag) {
+	/* r = flag ? b : a */
+	const uint64_t mask = 0 - flag;
+	for (int i = 0; i < 4; i++) {
+		r[i] = (a[i] & ~mask) | (b[i] & mask);
+	}
+}
+
+/* r = v - m if v >= m, for v = v[0..3] + carry * 2^256 < 2m */
+static void mod_reduce_once(uint64_t r[4], const uint64_t v[4], uint64_t carry, const ecdsa64_modulus *mod) {
+	uint64_t t[4];
+	uint64_t borrow = 0;
+	for (int i = 0; i < 4; i++) {
+		const ecdsa64_u128 d = (ecdsa64_u128)v[i] - mod->m[i] - borrow;
+		t[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	mod_select(r, v, t, carry | (borrow ^ 1));
+}
+
+static void mod_add(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], const ecdsa64_modulus *mod) {
+	uint64_t v[4];
+	ecdsa64_u128 acc = 0;
+	for (int i = 0; i < 4; i++) {
+		acc += (ecdsa64_u128)a[i] + b[i];
+		v[i] = (uint64_t)acc;
+		acc >>= 64;
+	}
+	mod_reduce_once(r, v, (uint64_t)acc, mod);
+}
+
+static void mod_sub(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], const ecdsa64_modulus *mod) {
+	uint64_t v[4];
+	uint64_t borrow = 0;
+	for (int i = 0; i < 4; i++) {
+		const ecdsa64_u128 d = (ecdsa64_u128)a[i] - b[i] - borrow;
+		v[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	/* on borrow, add m back */
+	const uint64_t mask = 0 - borrow;
+	ecdsa64_u128 acc = 0;
+	for (int i = 0; i < 4; i++) {
+		acc += (ecdsa64_u128)v[i] + (mod->m[i] & mask);
+		r[i] = (uint64_t)acc;
+		acc >>= 64;
+	}
+}
+
+/* r = flag ? -a : a */
+static void mod_cnegate(uint64_t r[4], const uint64_t a[4], uint64_t flag, const ecdsa64_modulus *mod) {
+	static const uint64_t zero[4] = {0, 0, 0, 0};
+	uint64_t neg[4];
+	mod_sub(neg, zero, a, mod);
+	mod_select(r, a, neg, flag);
+}
+
+/* r = a / 2 */
+static void mod_half(uint64_t r[4], const uint64_t a[4], const ecdsa64_modulus *mod) {
+	const uint64_t mask = 0 - (a[0] & 1);
+	uint64_t v[4];
+	ecdsa64_u128 acc = 0;
+	for (int i = 0; i < 4; i++) {
+		acc += (ecdsa64_u128)a[i] + (mod->m[i] & mask);
+		v[i] = (uint64_t)acc;
+		acc >>= 64;
+	}
+	for (int i = 0; i < 3; i++) {
+		r[i] = (v[i] >> 1) | (v[i + 1] << 63);
+	}
+	r[3] = (v[3] >> 1) | ((uint64_t)acc << 63);
+}
+
+/* r = a * b / 2^256 mod m, for a < 2^256 and b < m (coarsely integrated operand scanning) */
+static void mod_mul(uint64_t r[4], const uint64_t a[4], const uint64_t b[4], const ecdsa64_modulus *mod) {
+	uint64_t t[6] = {0};
+	for (int i = 0; i < 4; i++) {
+		ecdsa64_u128 acc = 0;
+		for (int j = 0; j < 4; j++) {
+			acc += (ecdsa64_u128)a[j] * b[i] + t[j];
+			t[j] = (uint64_t)acc;
+			acc >>= 64;
+		}
+		acc += t[4];
+		t[4] = (uint64_t)acc;
+		t[5] = (uint64_t)(acc >> 64);
+
+		const uint64_t q = t[0] * mod->n0;
+		acc = (ecdsa64_u128)q * mod->m[0] + t[0];
+		acc >>= 64;
+		for (int j = 1; j < 4; j++) {
+			acc += (ecdsa64_u128)q * mod->m[j] + t[j];
+			t[j - 1] = (uint64_t)acc;
+			acc >>= 64;
+		}
+		acc += t[4];
+		t[3] = (uint64_t)acc;
+		t[4] = t[5] + (uint64_t)(acc >> 64);
+	}
+	mod_reduce_once(r, t, t[4], mod);
+	memzero(t, sizeof(t));
+}
+
+static void mod_sqr(uint64_t r[4], const uint64_t a[4], const ecdsa64_modulus *mod) {
+	mod_mul(r, a, a, mod);
+}
+
+/* r = a^e in Montgomery form, with a fixed 4-bit window (the exponent is public) */
+static void mod_pow(uint64_t r[4], const uint64_t a[4], const uint64_t e[4], const ecdsa64_modulus *mod) {
+	uint64_t powers[16][4];
+	memcpy(powers[0], mod->one, sizeof(powers[0]));
+	memcpy(powers[1], a, sizeof(powers[1]));
+	for (int i = 2; i < 16; i++) {
+		mod_mul(powers[i], powers[i - 1], a, mod);
+	}
+
+	uint64_t acc[4];
+	memcpy(acc, mod->one, sizeof(acc));
+	for (int i = 63; i >= 0; i--) {
+		for (int j = 0; j < 4; j++) {
+			mod_sqr(acc, acc, mod);
+		}
+		const int digit = (int)((e[i >> 4] >> ((i & 15) * 4)) & 15);
+		mod_mul(acc, acc, powers[digit], mod);
+	}
+	memcpy(r, acc, sizeof(acc));
+	memzero(powers, sizeof(powers));
+	memzero(acc, sizeof(acc));
+}
+
+/* r = a^(m - 2) = a^-1 */
+static void mod_inverse(uint64_t r[4], const uint64_t a[4], const ecdsa64_modulus *mod) {
+	uint64_t e[4];
+	uint64_t borrow = 2;
+	for (int i = 0; i < 4; i++) {
+		const ecdsa64_u128 d = (ecdsa64_u128)mod->m[i] - borrow;
+		e[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	mod_pow(r, a, e, mod);
+}
+
+static void mod_to_montgomery(uint64_t r[4], const uint64_t a[4], const ecdsa64_modulus *mod) {
+	mod_mul(r, a, mod->r2, mod);
+}
+
+static void mod_from_montgomery(uint64_t r[4], const uint64_t a[4], const ecdsa64_modulus *mod) {
+	static const uint64_t one[4] = {1, 0, 0, 0};
+	mod_mul(r, a, one, mod);
+}
+
+static uint64_t mod_is_zero(const uint64_t a[4]) {
+	const uint64_t bits = a[0] | a[1] | a[2] | a[3];
+	return ((bits | (0 - bits)) >> 63) ^ 1;
+}
+
+/* 9 29-bit limbs to 4 64-bit limbs, x must be normalized */
+static void read_bignum(uint64_t r[4], const bignum256 *x) {
+	memset(r, 0, 4 * sizeof(uint64_t));
+	for (int i = 0; i < BN_LIMBS; i++) {
+		const int pos = i * BN_BITS_PER_LIMB;
+		const int limb = pos >> 6;
+		const int shift = pos & 63;
+		r[limb] |= (uint64_t)x->val[i] << shift;
+		if (shift + BN_BITS_PER_LIMB > 64 && limb < 3) {
+			r[limb + 1] |= (uint64_t)x->val[i] >> (64 - shift);
+		}
+	}
+}
+
+static void write_bignum(bignum256 *x, const uint64_t a[4]) {
+	for (int i = 0; i < BN_LIMBS; i++) {
+		const int pos = i * BN_BITS_PER_LIMB;
+		const int limb = pos >> 6;
+		const int shift = pos & 63;
+		uint64_t bits = a[limb] >> shift;
+		if (shift + BN_BITS_PER_LIMB > 64 && limb < 3) {
+			bits |= a[limb + 1] << (64 - shift);
+		}
+		x->val[i] = (uint32_t)bits & BN_LIMB_MASK;
+	}
+}
+
+static void read_point(ecdsa64_affine *r, const curve_point *p, const ecdsa64_modulus *prime) {
+	read_bignum(r->x, &p->x);
+	read_bignum(r->y, &p->y);
+	mod_to_montgomery(r->x, r->x, prime);
+	mod_to_montgomery(r->y, r->y, prime);
+}
+
+/* Jacobian coordinates of p with a random z, as curve_to_jacobian */
+static void to_jacobian(ecdsa64_jacobian *jp, const ecdsa64_affine *p, const ecdsa64_modulus *prime) {
+	/* any 0 < z < m, seen as Montgomery form, is a uniformly random z */
+	for (;;) {
+		random_buffer((uint8_t *)jp->z, sizeof(jp->z));
+		uint64_t borrow = 0;
+		for (int i = 0; i < 4; i++) {
+			const ecdsa64_u128 d = (ecdsa64_u128)jp->z[i] - prime->m[i] - borrow;
+			borrow = (uint64_t)(d >> 64) & 1;
+		}
+		if (borrow && !mod_is_zero(jp->z)) {
+			break;
+		}
+	}
+	uint64_t z2[4];
+	mod_sqr(z2, jp->z, prime);
+	mod_mul(jp->x, p->x, z2, prime);
+	mod_mul(z2, z2, jp->z, prime);
+	mod_mul(jp->y, p->y, z2, prime);
+	memzero(z2, sizeof(z2));
+}
+
+static void to_affine(ecdsa64_affine *p, const ecdsa64_jacobian *jp, const ecdsa64_modulus *prime) {
+	uint64_t zi[4], zi2[4];
+	mod_inverse(zi, jp->z, prime);
+	mod_sqr(zi2, zi, prime);
+	mod_mul(p->x, jp->x, zi2, prime);
+	mod_mul(zi2, zi2, zi, prime);
+	mod_mul(p->y, jp->y, zi2, prime);
+	memzero(zi, sizeof(zi));
+	memzero(zi2, sizeof(zi2));
+}
+
+static void write_point(curve_point *res, const ecdsa64_jacobian *jp, const ecdsa64_modulus *prime) {
+	ecdsa64_affine p;
+	to_affine(&p, jp, prime);
+	mod_from_montgomery(p.x, p.x, prime);
+	mod_from_montgomery(p.y, p.y, prime);
+	write_bignum(&res->x, p.x);
+	write_bignum(&res->y, p.y);
+	memzero(&p, sizeof(p));
+}
+
+/* p2 += p1, see point_jacobian_add for the derivation (p1 = p2 is handled, p1 = -p2 is not) */
+static void jacobian_add(const ecdsa64_affine *p1, ecdsa64_jacobian *p2, int a, const ecdsa64_modulus *prime) {
+	uint64_t xz[4], yz[4], az[4], h[4], r[4], r2[4], hsqx[4], hcby[4];
+
+	mod_sqr(xz, p2->z, prime);     // xz = z2^2
+	mod_mul(yz, xz, p2->z, prime); // yz = z2^3
+
+	if (a != 0) {
+		mod_sqr(az, xz, prime); // az = z2^4
+		uint64_t t[4];
+		memcpy(t, az, sizeof(t));
+		for (int i = 1; i < -a; i++) {
+			mod_add(az, az, t, prime); // az = -a z2^4
+		}
+	}
+
+	mod_mul(xz, p1->x, xz, prime); // xz = x1' = x1*z2^2
+	mod_sub(h, xz, p2->x, prime);  // h = x1' - x2
+	mod_add(xz, xz, p2->x, prime); // xz = x1' + x2
+	const uint64_t is_doubling = mod_is_zero(h);
+
+	mod_mul(yz, p1->y, yz, prime); // yz = y1' = y1*z2^3
+	mod_sub(r, yz, p2->y, prime);  // r = y1' - y2
+	mod_add(yz, yz, p2->y, prime); // yz = y1' + y2
+
+	uint64_t x2sq[4];
+	mod_sqr(x2sq, p2->x, prime);
+	mod_add(r2, x2sq, x2sq, prime);
+	mod_add(r2, r2, x2sq, prime); // r2 = 3 x2^2
+	if (a != 0) {
+		mod_sub(r2, r2, az, prime); // r2 = 3 x2^2 + a z2^4
+	}
+	mod_select(r, r, r2, is_doubling);
+	mod_select(h, h, yz, is_doubling);
+
+	mod_sqr(hsqx, h, prime);          // hsqx = h^2
+	mod_mul(hcby, hsqx, h, prime);    // hcby = h^3
+	mod_mul(hsqx, hsqx, xz, prime);   // hsqx = h^2 * (x1 + x2)
+	mod_mul(hcby, hcby, yz, prime);   // hcby = h^3 * (y1 + y2)
+	mod_mul(p2->z, p2->z, h, prime);  // z3 = h*z2
+
+	// x3 = r^2 - h^2 (x1 + x2)
+	mod_sqr(p2->x, r, prime);
+	mod_sub(p2->x, p2->x, hsqx, prime);
+
+	// y3 = 1/2 (r*(h^2 (x1 + x2) - 2x3) - h^3 (y1 + y2))
+	mod_sub(p2->y, hsqx, p2->x, prime);
+	mod_sub(p2->y, p2->y, p2->x, prime);
+	mod_mul(p2->y, p2->y, r, prime);
+	mod_sub(p2->y, p2->y, hcby, prime);
+	mod_half(p2->y, p2->y, prime);
+
+	memzero(xz, sizeof(xz));
+	memzero(yz, sizeof(yz));
+	memzero(az, sizeof(az));
+	memzero(h, sizeof(h));
+	memzero(r, sizeof(r));
+	memzero(r2, sizeof(r2));
+	memzero(x2sq, sizeof(x2sq));
+	memzero(hsqx, sizeof(hsqx));
+	memzero(hcby, sizeof(hcby));
+}
+
+/* p = 2p, see point_jacobian_double for the derivation */
+static void jacobian_double(ecdsa64_jacobian *p, int a, const ecdsa64_modulus *prime) {
+	uint64_t az4[4], m[4], msq[4], ysq[4], xysq[4], t[4];
+
+	mod_sqr(t, p->x, prime);
+	mod_add(m, t, t, prime);
+	mod_add(m, m, t, prime); // m = 3 x^2
+
+	if (a != 0) {
+		mod_sqr(az4, p->z, prime);
+		mod_sqr(az4, az4, prime);
+		memcpy(t, az4, sizeof(t));
+		for (int i = 1; i < -a; i++) {
+			mod_add(az4, az4, t, prime); // az4 = -a z^4
+		}
+		mod_sub(m, m, az4, prime);
+	}
+	mod_half(m, m, prime); // m = (3 x^2 + a z^4) / 2
+
+	mod_sqr(msq, m, prime);           // msq = m^2
+	mod_sqr(ysq, p->y, prime);        // ysq = y^2
+	mod_mul(xysq, p->x, ysq, prime);  // xysq = xy^2
+	mod_mul(p->z, p->y, p->z, prime); // z3 = yz
+
+	// x3 = m^2 - 2*xy^2
+	mod_add(t, xysq, xysq, prime);
+	mod_sub(p->x, msq, t, prime);
+
+	// y3 = m*(xy^2 - x3) - y^4
+	mod_sub(p->y, xysq, p->x, prime);
+	mod_mul(p->y, p->y, m, prime);
+	mod_sqr(ysq, ysq, prime);
+	mod_sub(p->y, p->y, ysq, prime);
+
+	memzero(az4, sizeof(az4));
+	memzero(m, sizeof(m));
+	memzero(msq, sizeof(msq));
+	memzero(ysq, sizeof(ysq));
+	memzero(xysq, sizeof(xysq));
+	memzero(t, sizeof(t));
+}
+
+/* Selects table[index] without an index dependent memory access */
+static void select_point(ecdsa64_affine *r, const ecdsa64_affine table[8], uint32_t index) {
+	memset(r, 0, sizeof(*r));
+	for (uint32_t i = 0; i < 8; i++) {
+		const uint64_t flag = ((i ^ index) - 1) >> 31 & 1;
+		mod_select(r->x, r->x, table[i].x, flag);
+		mod_select(r->y, r->y, table[i].y, flag);
+	}
+}
+
+/*
+ * a = k + 2^256 if k is odd, k + 2^256 - order otherwise, as in point_multiply: a is odd
+ * and a = k + 2^256 (mod order). Returns 0 if k is zero.
+ */
+static int recode_scalar(uint64_t a[5], const bignum256 *k, const ecdsa64_modulus *order) {
+	uint64_t kl[4];
+	read_bignum(kl, k);
+	const uint64_t is_even = (kl[0] & 1) ^ 1;
+	const uint64_t mask = 0 - is_even;
+	uint64_t borrow = 0;
+	for (int i = 0; i < 4; i++) {
+		const ecdsa64_u128 d = (ecdsa64_u128)kl[i] - (order->m[i] & mask) - borrow;
+		a[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	a[4] = 1 - borrow;
+	const int is_non_zero = mod_is_zero(kl) == 0;
+	memzero(kl, sizeof(kl));
+	return is_non_zero;
+}
+
+/* 5 bits of a starting at bit pos, pos is a multiple of 4 */
+static uint32_t scalar_bits(const uint64_t a[5], int pos) {
+	const int limb = pos >> 6;
+	const int shift = pos & 63;
+	uint64_t bits = a[limb] >> shift;
+	if (shift > 59) {
+		bits |= a[limb + 1] << (64 - shift);
+	}
+	return (uint32_t)bits & 31;
+}
+
+int ecdsa64_supported(void) {
+	return 1;
+}
+
+int ecdsa64_curve_supported(const ecdsa_curve *curve) {
+	return ecdsa64_find(curve) != NULL;
+}
+
+int ecdsa64_point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_point *p, curve_point *res) {
+	const ecdsa64_params *params = ecdsa64_find(curve);
+	if (params == NULL) {
+		return -1;
+	}
+	const ecdsa64_modulus *prime = &params->prime;
+
+	CONFIDENTIAL uint64_t a[5];
+	if (!recode_scalar(a, k, &params->order)) {
+		// special case 0*p: just return zero, as point_multiply
+		point_set_infinity(res);
+		return 0;
+	}
+
+	// pmult[i] = (2*i+1) * p: 2p is made affine, then added to the odd multiples in Jacobian
+	// coordinates, which are made affine with a single inversion
+	ecdsa64_affine pmult[8];
+	ecdsa64_jacobian jmult[8];
+	read_point(&pmult[0], p, prime);
+	memcpy(jmult[0].x, pmult[0].x, sizeof(jmult[0].x));
+	memcpy(jmult[0].y, pmult[0].y, sizeof(jmult[0].y));
+	memcpy(jmult[0].z, prime->one, sizeof(jmult[0].z));
+	ecdsa64_jacobian jdouble = jmult[0];
+	jacobian_double(&jdouble, curve->a, prime);
+	ecdsa64_affine pdouble;
+	to_affine(&pdouble, &jdouble, prime);
+	for (int i = 1; i < 8; i++) {
+		jmult[i] = jmult[i - 1];
+		jacobian_add(&pdouble, &jmult[i], curve->a, prime);
+	}
+	uint64_t prefix[8][4], inv[4], zi[4], zi2[4];
+	memcpy(prefix[0], jmult[0].z, sizeof(prefix[0]));
+	for (int i = 1; i < 8; i++) {
+		mod_mul(prefix[i], prefix[i - 1], jmult[i].z, prime);
+	}
+	mod_inverse(inv, prefix[7], prime);
+	for (int i = 7; i >= 0; i--) {
+		if (i > 0) {
+			mod_mul(zi, inv, prefix[i - 1], prime);
+			mod_mul(inv, inv, jmult[i].z, prime);
+		} else {
+			memcpy(zi, inv, sizeof(zi));
+		}
+		mod_sqr(zi2, zi, prime);
+		mod_mul(pmult[i].x, jmult[i].x, zi2, prime);
+		mod_mul(zi2, zi2, zi, prime);
+		mod_mul(pmult[i].y, jmult[i].y, zi2, prime);
+	}
+
+	// now compute res = sum_{i=0..63} a[i] * 16^i * p step by step, starting with i = 63,
+	// the digits are those of point_multiply
+	CONFIDENTIAL ecdsa64_jacobian jres;
+	ecdsa64_affine point;
+	uint32_t bits = scalar_bits(a, 252);
+	uint32_t sign = (bits >> 4) - 1;
+	bits ^= sign;
+	bits &= 15;
+	select_point(&point, pmult, bits >> 1);
+	to_jacobian(&jres, &point, prime);
+	for (int i = 62; i >= 0; i--) {
+		jacobian_double(&jres, curve->a, prime);
+		jacobian_double(&jres, curve->a, prime);
+		jacobian_double(&jres, curve->a, prime);
+		jacobian_double(&jres, curve->a, prime);
+
+		bits = scalar_bits(a, i * 4);
+		const uint32_t nsign = (bits >> 4) - 1;
+		bits ^= nsign;
+		bits &= 15;
+
+		// negate last result to make signs of this round and the last round equal
+		mod_cnegate(jres.z, jres.z, (sign ^ nsign) & 1, prime);
+
+		// add odd factor
+		select_point(&point, pmult, bits >> 1);
+		jacobian_add(&point, &jres, curve->a, prime);
+		sign = nsign;
+	}
+	mod_cnegate(jres.z, jres.z, sign & 1, prime);
+	write_point(res, &jres, prime);
+
+	memzero(a, sizeof(a));
+	memzero(pmult, sizeof(pmult));
+	memzero(jmult, sizeof(jmult));
+	memzero(&jdouble, sizeof(jdouble));
+	memzero(&pdouble, sizeof(pdouble));
+	memzero(prefix, sizeof(prefix));
+	memzero(inv, sizeof(inv));
+	memzero(zi, sizeof(zi));
+	memzero(zi2, sizeof(zi2));
+	memzero(&jres, sizeof(jres));
+	memzero(&point, sizeof(point));
+	return 0;
+}
+
+#if USE_PRECOMPUTED_CP
+
+/* Selects curve->cp[i][index] without an index dependent memory access */
+static void select_cp(ecdsa64_affine *r, const ecdsa_curve *curve, int i, uint32_t index, const ecdsa64_modulus *prime) {
+	curve_point p;
+	memset(&p, 0, sizeof(p));
+	for (uint32_t j = 0; j < 8; j++) {
+		const uint32_t flag = ((j ^ index) - 1) >> 31 & 1;
+		bn_cmov(&p.x, flag, &curve->cp[i][j].x, &p.x);
+		bn_cmov(&p.y, flag, &curve->cp[i][j].y, &p.y);
+	}
+	read_point(r, &p, prime);
+	memzero(&p, sizeof(p));
+}
+
+int ecdsa64_scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res) {
+	const ecdsa64_params *params = ecdsa64_find(curve);
+	if (params == NULL) {
+		return -1;
+	}
+	const ecdsa64_modulus *prime = &params->prime;
+
+	CONFIDENTIAL uint64_t a[5];
+	if (!recode_scalar(a, k, &params->order)) {
+		// special case 0*G: just return zero, as scalar_multiply
+		point_set_infinity(res);
+		return 0;
+	}
+
+	// res = sum_{i=0..63} a[i] * 16^i * G with curve->cp[i][j] = (2*j+1) * 16^i * G,
+	// the digits are those of scalar_multiply
+	CONFIDENTIAL ecdsa64_jacobian jres;
+	ecdsa64_affine point;
+	uint32_t lowbits = scalar_bits(a, 0);
+	lowbits ^= (lowbits >> 4) - 1;
+	lowbits &= 15;
+	select_cp(&point, curve, 0, lowbits >> 1, prime);
+	to_jacobian(&jres, &point, prime);
+	for (int i = 1; i < 64; i++) {
+		lowbits = scalar_bits(a, i * 4);
+		lowbits ^= (lowbits >> 4) - 1;
+		lowbits &= 15;
+		// negate last result to make signs of this round and the last round equal
+		mod_cnegate(jres.y, jres.y, ~lowbits & 1, prime);
+
+		// add odd factor
+		select_cp(&point, curve, i, lowbits >> 1, prime);
+		jacobian_add(&point, &jres, curve->a, prime);
+	}
+	mod_cnegate(jres.y, jres.y, ~a[4] & 1, prime);
+	write_point(res, &jres, prime);
+
+	memzero(a, sizeof(a));
+	memzero(&jres, sizeof(jres));
+	memzero(&point, sizeof(point));
+	return 0;
+}
+
+#else
+
+int ecdsa64_scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res) {
+	return ecdsa64_point_multiply(curve, k, &curve->G, res);
+}
+
+#endif
+
+int ecdsa64_verify_scalars(const ecdsa_curve *curve, const bignum256 *r, const bignum256 *s, const bignum256 *z,
+                           bignum256 *u1, bignum256 *u2) {
+	const ecdsa64_params *params = ecdsa64_find(curve);
+	if (params == NULL) {
+		return -1;
+	}
+	const ecdsa64_modulus *order = &params->order;
+
+	// (x / s) = x * (s^-1 * 2^256) / 2^256, so the products leave the Montgomery form
+	uint64_t sl[4], inv[4], v[4];
+	read_bignum(sl, s);
+	mod_to_montgomery(sl, sl, order);
+	mod_inverse(inv, sl, order);
+	read_bignum(v, z);
+	mod_mul(v, v, inv, order);
+	write_bignum(u1, v);
+	read_bignum(v, r);
+	mod_mul(v, v, inv, order);
+	write_bignum(u2, v);
+	return 0;
+}
+
+int ecdsa64_uncompress_coords(const ecdsa_curve *curve, uint8_t odd, const bignum256 *x, bignum256 *y) {
+	const ecdsa64_params *params = ecdsa64_find(curve);
+	if (params == NULL) {
+		return -1;
+	}
+	const ecdsa64_modulus *prime = &params->prime;
+
+	// y^2 = x^3 + a*x + b, and the square root is (y^2)^((p + 1) / 4) since p = 3 mod 4
+	uint64_t xl[4], t[4], b[4], e[4];
+	read_bignum(xl, x);
+	mod_to_montgomery(xl, xl, prime);
+	read_bignum(b, &curve->b);
+	mod_to_montgomery(b, b, prime);
+	mod_sqr(t, xl, prime);
+	for (int i = 0; i < -curve->a; i++) {
+		mod_sub(t, t, prime->one, prime);
+	}
+	mod_mul(t, t, xl, prime);
+	mod_add(t, t, b, prime);
+	ecdsa64_u128 acc = 1;
+	for (int i = 0; i < 4; i++) {
+		acc += prime->m[i];
+		e[i] = (uint64_t)acc;
+		acc >>= 64;
+	}
+	for (int i = 0; i < 4; i++) {
+		e[i] = (e[i] >> 2) | (i < 3 ? e[i + 1] << 62 : (uint64_t)acc << 62);
+	}
+	mod_pow(t, t, e, prime);
+	mod_from_montgomery(t, t, prime);
+	mod_cnegate(t, t, (t[0] ^ odd) & 1, prime);
+	write_bignum(y, t);
+	return 0;
+}
+
+/*
+ * Variable time double multiplication u1 * G + u2 * Q for signature verification and
+ * public key recovery, where all inputs are public.
+ *
+ * Strauss-Shamir: the multiples of the points share a single chain of doublings, each
+ * scalar being in width-5 NAF, that is with odd digits in (-16, 16) at least 5 positions
+ * apart, so that about one bit in six needs an addition of a precomputed odd multiple.
+ * On secp256k1 the endomorphism (x, y) -> (beta x, y) = lambda (x, y) halves the chain:
+ * each scalar is split into k1 + k2 lambda with k1 and k2 of 128 bits (GLV).
+ */
+
+#define ECDSA64_WNAF_WINDOW 5
+#define ECDSA64_WNAF_TABLE (1 << (ECDSA64_WNAF_WINDOW - 2))
+#define ECDSA64_WNAF_BITS 258
+
+/* Jacobian point which may be the point at infinity */
+typedef struct {
+	ecdsa64_jacobian p;
+	int infinity;
+} ecdsa64_gej;
+
+/* lambda, a cube root of unity modulo the secp256k1 order, and the GLV basis */
+static const uint64_t glv_g1[4] = {0xE893209A45DBB031ULL, 0x3DAA8A1471E8CA7FULL, 0xE86C90E49284EB15ULL, 0x3086D221A7D46BCDULL};
+static const uint64_t glv_g2[4] = {0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL, 0x6F547FA90ABFE4C4ULL, 0xE4437ED6010E8828ULL};
+/* -b1, -b2 and lambda, in Montgomery form modulo the order */
+static const uint64_t glv_minus_b1[4] = {0xC50468D00AD9263CULL, 0x1B1C8205FAA6ED42ULL, 0x1571B4AE8AC47F71ULL, 0x221208AC9DF506C6ULL};
+static const uint64_t glv_minus_b2[4] = {0x0CAC5E506A144696ULL, 0x1E8A8DC5F3BA5939ULL, 0x176CDF65BA244FCEULL, 0xC25575EB8E173580ULL};
+static const uint64_t glv_lambda[4] = {0xF07DEB3DC9926C9EULL, 0x2C93E7AD83C6944CULL, 0x73A9660652697D91ULL, 0x532840178558D639ULL};
+/* beta, a cube root of unity modulo the secp256k1 prime, in Montgomery form */
+static const uint64_t glv_beta[4] = {0x58A4361C8E81894EULL, 0x03FDE1631C4B80AFULL, 0xF8E98978D02E3905ULL, 0x7A4A36AEBCBB3D53ULL};
+
+static int mod_is_less(const uint64_t a[4], const uint64_t b[4]) {
+	for (int i = 3; i >= 0; i--) {
+		if (a[i] != b[i]) {
+			return a[i] < b[i];
+		}
+	}
+	return 0;
+}
+
+/* r = round(a * b / 2^384) */
+static void mul_shift_384(uint64_t r[4], const uint64_t a[4], const uint64_t b[4]) {
+	uint64_t t[8] = {0};
+	for (int i = 0; i < 4; i++) {
+		ecdsa64_u128 acc = 0;
+		for (int j = 0; j < 4; j++) {
+			acc += (ecdsa64_u128)a[i] * b[j] + t[i + j];
+			t[i + j] = (uint64_t)acc;
+			acc >>= 64;
+		}
+		t[i + 4] = (uint64_t)acc;
+	}
+	ecdsa64_u128 acc = (ecdsa64_u128)t[6] + (t[5] >> 63);
+	r[0] = (uint64_t)acc;
+	acc >>= 64;
+	acc += t[7];
+	r[1] = (uint64_t)acc;
+	r[2] = (uint64_t)(acc >> 64);
+	r[3] = 0;
+}
+
+/* k = k1 + k2 lambda (mod order) with |k1|, |k2| < 2^128, for k < order */
+static void glv_split(uint64_t k1[4], int *neg1, uint64_t k2[4], int *neg2, const uint64_t k[4],
+                      const ecdsa64_modulus *order) {
+	uint64_t c1[4], c2[4], t[4];
+	mul_shift_384(c1, k, glv_g1);
+	mul_shift_384(c2, k, glv_g2);
+	mod_mul(c1, c1, glv_minus_b1, order);
+	mod_mul(c2, c2, glv_minus_b2, order);
+	mod_add(k2, c1, c2, order);
+	mod_mul(t, k2, glv_lambda, order);
+	mod_sub(k1, k, t, order);
+
+	/* use the negation of the halves above order / 2 */
+	uint64_t half[4];
+	for (int i = 0; i < 4; i++) {
+		half[i] = (order->m[i] >> 1) | (i < 3 ? order->m[i + 1] << 63 : 0);
+	}
+	static const uint64_t zero[4] = {0, 0, 0, 0};
+	*neg1 = mod_is_less(half, k1);
+	if (*neg1) {
+		mod_sub(k1, zero, k1, order);
+	}
+	*neg2 = mod_is_less(half, k2);
+	if (*neg2) {
+		mod_sub(k2, zero, k2, order);
+	}
+}
+
+/* Width-5 NAF of k, returns the number of digits */
+static int wnaf(int digits[ECDSA64_WNAF_BITS], const uint64_t k[4]) {
+	/* the last digit may be at bit 256, the windows reach past it */
+	uint64_t s[6] = {k[0], k[1], k[2], k[3], 0, 0};
+	memset(digits, 0, ECDSA64_WNAF_BITS * sizeof(int));
+	int length = 0;
+	int carry = 0;
+	for (int bit = 0; bit < ECDSA64_WNAF_BITS;) {
+		if ((int)((s[bit >> 6] >> (bit & 63)) & 1) == carry) {
+			bit++;
+			continue;
+		}
+		const int limb = bit >> 6;
+		const int shift = bit & 63;
+		uint64_t bits = s[limb] >> shift;
+		if (shift > 64 - ECDSA64_WNAF_WINDOW) {
+			bits |= s[limb + 1] << (64 - shift);
+		}
+		int word = (int)(bits & ((1 << ECDSA64_WNAF_WINDOW) - 1)) + carry;
+		carry = (word >> (ECDSA64_WNAF_WINDOW - 1)) & 1;
+		word -= carry << ECDSA64_WNAF_WINDOW;
+		digits[bit] = word;
+		length = bit + 1;
+		bit += ECDSA64_WNAF_WINDOW;
+	}
+	return length;
+}
+
+/* r = 2r */
+static void gej_double_var(ecdsa64_gej *r, int a, const ecdsa64_modulus *prime) {
+	if (r->infinity) {
+		return;
+	}
+	if (mod_is_zero(r->p.y)) {
+		r->infinity = 1;
+		return;
+	}
+	jacobian_double(&r->p, a, prime);
+}
+
+/* r += b, for any r and b */
+static void gej_add_ge_var(ecdsa64_gej *r, const ecdsa64_affine *b, int a, const ecdsa64_modulus *prime) {
+	if (r->infinity) {
+		memcpy(r->p.x, b->x, sizeof(r->p.x));
+		memcpy(r->p.y, b->y, sizeof(r->p.y));
+		memcpy(r->p.z, prime->one, sizeof(r->p.z));
+		r->infinity = 0;
+		return;
+	}
+	uint64_t z2[4], u2[4], s2[4], h[4], rr[4];
+	mod_sqr(z2, r->p.z, prime);
+	mod_mul(u2, b->x, z2, prime);
+	mod_mul(z2, z2, r->p.z, prime);
+	mod_mul(s2, b->y, z2, prime);
+	mod_sub(h, u2, r->p.x, prime);
+	mod_sub(rr, s2, r->p.y, prime);
+	if (mod_is_zero(h)) {
+		if (mod_is_zero(rr)) {
+			gej_double_var(r, a, prime);
+		} else {
+			r->infinity = 1;
+		}
+		return;
+	}
+	uint64_t h2[4], h3[4], v[4], t[4];
+	mod_sqr(h2, h, prime);
+	mod_mul(h3, h2, h, prime);
+	mod_mul(v, r->p.x, h2, prime);
+	mod_mul(r->p.z, r->p.z, h, prime);
+	// x3 = rr^2 - h^3 - 2 v
+	mod_sqr(t, rr, prime);
+	mod_sub(t, t, h3, prime);
+	mod_sub(t, t, v, prime);
+	mod_sub(r->p.x, t, v, prime);
+	// y3 = rr (v - x3) - y1 h^3
+	mod_sub(t, v, r->p.x, prime);
+	mod_mul(t, t, rr, prime);
+	mod_mul(h3, h3, r->p.y, prime);
+	mod_sub(r->p.y, t, h3, prime);
+}
+
+/* table[i] = (2i + 1) p in affine coordinates, for a point p of odd order */
+static void odd_multiples_var(ecdsa64_affine table[ECDSA64_WNAF_TABLE], const ecdsa64_affine *p, int a,
+                              const ecdsa64_modulus *prime) {
+	ecdsa64_gej jdouble;
+	memcpy(jdouble.p.x, p->x, sizeof(jdouble.p.x));
+	memcpy(jdouble.p.y, p->y, sizeof(jdouble.p.y));
+	memcpy(jdouble.p.z, prime->one, sizeof(jdouble.p.z));
+	jdouble.infinity = 0;
+	jacobian_double(&jdouble.p, a, prime);
+	ecdsa64_affine pdouble;
+	to_affine(&pdouble, &jdouble.p, prime);
+
+	// the multiples are distinct and finite, so the Jacobian sums are made affine together
+	ecdsa64_gej jmult[ECDSA64_WNAF_TABLE];
+	jmult[0] = (ecdsa64_gej){{{0}, {0}, {0}}, 1};
+	gej_add_ge_var(&jmult[0], p, a, prime);
+	for (int i = 1; i < ECDSA64_WNAF_TABLE; i++) {
+		jmult[i] = jmult[i - 1];
+		gej_add_ge_var(&jmult[i], &pdouble, a, prime);
+	}
+	uint64_t prefix[ECDSA64_WNAF_TABLE][4], inv[4], zi[4], zi2[4];
+	memcpy(prefix[0], jmult[0].p.z, sizeof(prefix[0]));
+	for (int i = 1; i < ECDSA64_WNAF_TABLE; i++) {
+		mod_mul(prefix[i], prefix[i - 1], jmult[i].p.z, prime);
+	}
+	mod_inverse(inv, prefix[ECDSA64_WNAF_TABLE - 1], prime);
+	for (int i = ECDSA64_WNAF_TABLE - 1; i >= 0; i--) {
+		if (i > 0) {
+			mod_mul(zi, inv, prefix[i - 1], prime);
+			mod_mul(inv, inv, jmult[i].p.z, prime);
+		} else {
+			memcpy(zi, inv, sizeof(zi));
+		}
+		mod_sqr(zi2, zi, prime);
+		mod_mul(table[i].x, jmult[i].p.x, zi2, prime);
+		mod_mul(zi2, zi2, zi, prime);
+		mod_mul(table[i].y, jmult[i].p.y, zi2, prime);
+	}
+}
+
+/* One scalar of the Strauss-Shamir sum */
+typedef struct {
+	const ecdsa64_affine *table;
+	int digits[ECDSA64_WNAF_BITS];
+	int length;
+	int negate;
+} ecdsa64_term;
+
+static void term_init(ecdsa64_term *term, const ecdsa64_affine *table, const uint64_t k[4], int negate) {
+	term->table = table;
+	term->length = wnaf(term->digits, k);
+	term->negate = negate;
+}
+
+int ecdsa64_double_multiply(const ecdsa_curve *curve, const bignum256 *u1, const bignum256 *u2, const curve_point *q,
+                            curve_point *res) {
+	const ecdsa64_params *params = ecdsa64_find(curve);
+	if (params == NULL) {
+		return -1;
+	}
+	const ecdsa64_modulus *prime = &params->prime;
+	const int is_secp256k1 = curve == &secp256k1;
+
+	ecdsa64_affine gtable[2][ECDSA64_WNAF_TABLE], qtable[2][ECDSA64_WNAF_TABLE];
+#if USE_PRECOMPUTED_CP
+	// curve->cp[0][j] = (2*j+1) * G
+	for (int i = 0; i < ECDSA64_WNAF_TABLE; i++) {
+		read_point(&gtable[0][i], &curve->cp[0][i], prime);
+	}
+#else
+	ecdsa64_affine g;
+	read_point(&g, &curve->G, prime);
+	odd_multiples_var(gtable[0], &g, curve->a, prime);
+#endif
+	ecdsa64_affine point;
+	read_point(&point, q, prime);
+	odd_multiples_var(qtable[0], &point, curve->a, prime);
+
+	uint64_t k1[4], k2[4];
+	ecdsa64_term terms[4];
+	int count = 0;
+	if (is_secp256k1) {
+		// lambda (2i+1) p = (2i+1) lambda p has the same y and beta x
+		for (int i = 0; i < ECDSA64_WNAF_TABLE; i++) {
+			mod_mul(gtable[1][i].x, gtable[0][i].x, glv_beta, prime);
+			memcpy(gtable[1][i].y, gtable[0][i].y, sizeof(gtable[1][i].y));
+			mod_mul(qtable[1][i].x, qtable[0][i].x, glv_beta, prime);
+			memcpy(qtable[1][i].y, qtable[0][i].y, sizeof(qtable[1][i].y));
+		}
+		int neg1 = 0, neg2 = 0;
+		uint64_t k[4];
+		read_bignum(k, u1);
+		glv_split(k1, &neg1, k2, &neg2, k, &params->order);
+		term_init(&terms[count++], gtable[0], k1, neg1);
+		term_init(&terms[count++], gtable[1], k2, neg2);
+		read_bignum(k, u2);
+		glv_split(k1, &neg1, k2, &neg2, k, &params->order);
+		term_init(&terms[count++], qtable[0], k1, neg1);
+		term_init(&terms[count++], qtable[1], k2, neg2);
+	} else {
+		read_bignum(k1, u1);
+		term_init(&terms[count++], gtable[0], k1, 0);
+		read_bignum(k2, u2);
+		term_init(&terms[count++], qtable[0], k2, 0);
+	}
+
+	int length = 0;
+	for (int j = 0; j < count; j++) {
+		if (terms[j].length > length) {
+			length = terms[j].length;
+		}
+	}
+	ecdsa64_gej acc = {{{0}, {0}, {0}}, 1};
+	for (int i = length - 1; i >= 0; i--) {
+		gej_double_var(&acc, curve->a, prime);
+		for (int j = 0; j < count; j++) {
+			const int digit = terms[j].digits[i];
+			if (digit == 0) {
+				continue;
+			}
+			point = terms[j].table[((digit < 0 ? -digit : digit) - 1) >> 1];
+			mod_cnegate(point.y, point.y, (uint64_t)((digit < 0) ^ terms[j].negate), prime);
+			gej_add_ge_var(&acc, &point, curve->a, prime);
+		}
+	}
+
+	if (acc.infinity) {
+		point_set_infinity(res);
+	} else {
+		write_point(res, &acc.p, prime);
+	}
+	return 0;
+}
+
+#else
+
+int ecdsa64_supported(void) {
+	return 0;
+}
+
+int ecdsa64_curve_supported(const ecdsa_curve *curve) {
+	(void)curve;
+	return 0;
+}
+
+int ecdsa64_point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_point *p, curve_point *res) {
+	(void)curve;
+	(void)k;
+	(void)p;
+	(void)res;
+	return -1;
+}
+
+int ecdsa64_scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res) {
+	(void)curve;
+	(void)k;
+	(void)res;
+	return -1;
+}
+
+int ecdsa64_verify_scalars(const ecdsa_curve *curve, const bignum256 *r, const bignum256 *s, const bignum256 *z,
+                           bignum256 *u1, bignum256 *u2) {
+	(void)curve;
+	(void)r;
+	(void)s;
+	(void)z;
+	(void)u1;
+	(void)u2;
+	return -1;
+}
+
+int ecdsa64_uncompress_coords(const ecdsa_curve *curve, uint8_t odd, const bignum256 *x, bignum256 *y) {
+	(void)curve;
+	(void)odd;
+	(void)x;
+	(void)y;
+	return -1;
+}
+
+int ecdsa64_double_multiply(const ecdsa_curve *curve, const bignum256 *u1, const bignum256 *u2, const curve_point *q,
+                            curve_point *res) {
+	(void)curve;
+	(void)u1;
+	(void)u2;
+	(void)q;
+	(void)res;
+	return -1;
+}
+
+#endif
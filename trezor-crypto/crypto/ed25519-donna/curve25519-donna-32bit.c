@@ -7,6 +7,8 @@
 
 #include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
 
+#if !defined(ED25519_64BIT)
+
 const uint32_t reduce_mask_25 = (1 << 25) - 1;
 const uint32_t reduce_mask_26 = (1 << 26) - 1;
 
@@ -679,3 +681,5 @@ void curve25519_expand_reduce(bignum25519 out, const unsigned char in[32]) {
 	out[0] += 19 * (out[9] >> 25);
 	out[9] &= reduce_mask_25;
 }
+
+#endif /* !ED25519_64BIT */
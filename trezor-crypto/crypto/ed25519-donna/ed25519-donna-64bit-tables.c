@@ -0,0 +1,61 @@
+#include <TrezorCrypto/ed25519-donna/ed25519-donna.h>
+
+#if defined(ED25519_64BIT)
+
+const ge25519 ALIGN(16) ge25519_basepoint = {
+	{0x062d608f25d51a,0x0412a4b4f6592a,0x075b7171a4b31d,0x01ff60527118fe,0x0216936d3cd6e5},
+	{0x06666666666658,0x04cccccccccccc,0x01999999999999,0x03333333333333,0x06666666666666},
+	{0x00000000000001,0x00000000000000,0x00000000000000,0x00000000000000,0x00000000000000},
+	{0x068ab3a5b7dda3,0x000eea2a5eadbb,0x02af8df483c27e,0x0332b375274732,0x067875f0fd78b7}
+};
+
+/*
+	d
+*/
+
+const bignum25519 ALIGN(16) ge25519_ecd = {0x034dca135978a3,0x01a8283b156ebd,0x05e7a26001c029,0x0739c663a03cbb,0x052036cee2b6ff};
+
+const bignum25519 ALIGN(16) ge25519_ec2d = {0x069b9426b2f159,0x035050762add7a,0x03cf44c0038052,0x06738cc7407977,0x02406d9dc56dff};
+
+/*
+	sqrt(-1)
+*/
+
+const bignum25519 ALIGN(16) ge25519_sqrtneg1 = {0x061b274a0ea0b0,0x00d5a5fc8f189d,0x07ef5e9cbd0c60,0x078595a6804c9e,0x02b8324804fc1d};
+
+const ge25519_niels ALIGN(16) ge25519_niels_sliding_multiples[32] = {
+	{{0x003905d740913e,0x00ba2817d673a2,0x023e2827f4e67c,0x0133d2e0c21a34,0x044fd2f9298f81},{0x0493c6f58c3b85,0x00df7181c325f7,0x00f50b0b3e4cb7,0x05329385a44c32,0x007cf9d3a33d4b},{0x011205877aaa68,0x0479955893d579,0x050d66309b67a0,0x02d42d0dbee5ee,0x06f117b689f0c6}},
+	{{0x011fe8a4fcd265,0x07bcb8374faacc,0x052f5af4ef4d4f,0x05314098f98d10,0x02ab91587555bd},{0x05b0a84cee9730,0x061d10c97155e4,0x04059cc8096a10,0x047a608da8014f,0x07a164e1b9a80f},{0x06933f0dd0d889,0x044386bb4c4295,0x03cb6d3162508c,0x026368b872a2c6,0x05a2826af12b9b}},
+	{{0x0182c3a447d6ba,0x022964e536eff2,0x0192821f540053,0x02f9f19e788e5c,0x0154a7e73eb1b5},{0x02bc4408a5bb33,0x0078ebdda05442,0x02ffb112354123,0x0375ee8df5862d,0x02945ccf146e20},{0x03dbf1812a8285,0x00fa17ba3f9797,0x06f69cb49c3820,0x034d5a0db3858d,0x043aabe696b3bb}},
+	{{0x072c9aaa3221b1,0x0267774474f74d,0x0064b0e9b28085,0x03f04ef53b27c9,0x01d6edd5d2e531},{0x025cd0944ea3bf,0x075673b81a4d63,0x0150b925d1c0d4,0x013f38d9294114,0x0461bea69283c9},{0x036dc801b8b3a2,0x00e0a7d4935e30,0x01deb7cecc0d7d,0x0053a94e20dd2c,0x07a9fbb1c6a0f9}},
+	{{0x06217e039d8064,0x06dea408337e6d,0x057ac112628206,0x0647cb65e30473,0x049c05a51fadc9},{0x06678aa6a8632f,0x05ea3788d8b365,0x021bd6d6994279,0x07ace75919e4e3,0x034b9ed338add7},{0x04e8bf9045af1b,0x0514e33a45e0d6,0x07533c5b8bfe0f,0x0583557b7e14c9,0x073c172021b008}},
+	{{0x075b0249864348,0x052ee11070262b,0x0237ae54fb5acd,0x03bfd1d03aaab5,0x018ab598029d5c},{0x0700848a802ade,0x01e04605c4e5f7,0x05c0d01b9767fb,0x07d7889f42388b,0x04275aae2546d8},{0x032cc5fd6089e9,0x0426505c949b05,0x046a18880c7ad2,0x04a4221888ccda,0x03dc65522b53df}},
+	{{0x07013b327fbf93,0x01336eeded6a0d,0x02b565a2bbf3af,0x0253ce89591955,0x00267882d17602},{0x00c222a2007f6d,0x0356b79bdb77ee,0x041ee81efe12ce,0x0120a9bd07097d,0x0234fd7eec346f},{0x00a119732ea378,0x063bf1ba8e2a6c,0x069f94cc90df9a,0x0431d1779bfc48,0x0497ba6fdaa097}},
+	{{0x03cd86468ccf0b,0x048553221ac081,0x06c9464b4e0a6e,0x075fba84180403,0x043b5cd4218d05},{0x06cc0313cfeaa0,0x01a313848da499,0x07cb534219230a,0x039596dedefd60,0x061e22917f12de},{0x02762f9bd0b516,0x01c6e7fbddcbb3,0x075909c3ace2bd,0x042101972d3ec9,0x0511d61210ae4d}},
+	{{0x0386484420de87,0x02d6b25db68102,0x0650b4962873c0,0x04081cfd271394,0x071a7fe6fe2482},{0x0676ef950e9d81,0x01b81ae089f258,0x063c4922951883,0x02f1d54d9b3237,0x06d325924ddb85},{0x0182b8a5c8c854,0x073fcbe5406d8e,0x05de3430cff451,0x0554b967ac8c41,0x04746c4b6559ee}},
+	{{0x0546c864741147,0x03a1df99092690,0x01ca8cc9f4d6bb,0x036b7fc9cd3b03,0x0219663497db5e},{0x077b3c6dc69a2b,0x04edf13ec2fa6e,0x04e85ad77beac8,0x07dba2b28e7bda,0x05c9a51de34fe9},{0x00f1cf79f10e67,0x043ccb0a2b7ea2,0x005089dfff776a,0x01dd84e1d38b88,0x04804503c60822}},
+	{{0x0021d23a36d175,0x04fd3373c6476d,0x020e291eeed02a,0x062f2ecf2e7210,0x0771e098858de4},{0x049ed02ca37fc7,0x0474c2b5957884,0x05b8388e816683,0x04b6c454b76be4,0x0553398a516506},{0x02f5d278451edf,0x0730b133997342,0x06965420eb6975,0x0308a3bfa516cf,0x05a5ed1d68ff5a}},
+	{{0x05e0c558527359,0x03395b73afd75c,0x0072afa4e4b970,0x062214329e0f6d,0x0019b60135fefd},{0x05122afe150e83,0x04afc966bb0232,0x01c478833c8268,0x017839c3fc148f,0x044acb897d8bf9},{0x0068145e134b83,0x01e4860982c3cc,0x0068fb5f13d799,0x07c9283744547e,0x0150c49fde6ad2}},
+	{{0x01863c9cdca868,0x03770e295a1709,0x00d85a3720fd13,0x05e0ff1f71ab06,0x078a6d7791e05f},{0x03f29509471138,0x0729eeb4ca31cf,0x069c22b575bfbc,0x04910857bce212,0x06b2b5a075bb99},{0x07704b47a0b976,0x02ae82e91aab17,0x050bd6429806cd,0x068055158fd8ea,0x0725c7ffc4ad55}},
+	{{0x002bf71cd098c0,0x049dabcc6cd230,0x040a6533f905b2,0x0573efac2eb8a4,0x04cd54625f855f},{0x026715d1cf99b2,0x02205441a69c88,0x0448427dcd4b54,0x01d191e88abdc5,0x0794cc9277cb1f},{0x06c426c2ac5053,0x05a65ece4b095e,0x00c44086f26bb6,0x07429568197885,0x07008357b6fcc8}},
+	{{0x039fbb82584a34,0x047a568f257a03,0x014d88091ead91,0x02145b18b1ce24,0x013a92a3669d6d},{0x00672738773f01,0x0752bf799f6171,0x06b4a6dae33323,0x07b54696ead1dc,0x006ef7e9851ad0},{0x03771cc0577de5,0x03ca06bb8b9952,0x000b81c5d50390,0x043512340780ec,0x03c296ddf8a2af}},
+	{{0x034d2ebb1f2541,0x00e815b723ff9d,0x0286b416e25443,0x00bdfe38d1bee8,0x00a892c7007477},{0x0515f9d914a713,0x073191ff2255d5,0x054f5cc2a4bdef,0x03dd57fc118bcf,0x07a99d393490c7},{0x02ed2436bda3e8,0x002afd00f291ea,0x00be7381dea321,0x03e952d4b2b193,0x0286762d28302f}},
+	{{0x058e2bce2ef5bd,0x068ce8f78c6f8a,0x06ee26e39261b2,0x033d0aa50bcf9d,0x07686f2a3d6f17},{0x0036093ce35b25,0x03b64d7552e9cf,0x071ee0fe0b8460,0x069d0660c969e5,0x032f1da046a9d9},{0x0512a66d597c6a,0x00609a70a57551,0x0026c08a3c464c,0x04531fc8ee39e1,0x0561305f8a9ad2}},
+	{{0x02cc28e7b0c0d5,0x077b60eb8a6ce4,0x04042985c277a6,0x0636657b46d3eb,0x0030a1aef2c57c},{0x04978dec92aed1,0x0069adae7ca201,0x011ee923290f55,0x069641898d916c,0x000aaec53e35d4},{0x01f773003ad2aa,0x0005642cc10f76,0x003b48f82cfca6,0x02403c10ee4329,0x020be9c1c24065}},
+	{{0x00e44ae2025e60,0x05f97b9727041c,0x05683472c0ecec,0x0188882eb1ce7c,0x069764c545067e},{0x0387d8249673a6,0x05bea8dc927c2a,0x05bd8ed5650ef0,0x00ef0e3fcd40e1,0x0750ab3361f0ac},{0x023283a2f81037,0x0477aff97e23d1,0x00b8958dbcbb68,0x00205b97e8add6,0x054f96b3fb7075}},
+	{{0x05afc616b11ecd,0x039f4aec8f22ef,0x03b39e1625d92e,0x05f85bd4508873,0x078e6839fbe85d},{0x05f20429669279,0x008fafae4941f5,0x015d83c4eb7688,0x01cf379eca4146,0x03d7fe9c52bb75},{0x032df737b8856b,0x00608342f14e06,0x03967889d74175,0x01211907fba550,0x070f268f350088}},
+	{{0x04112070dcf355,0x07dcff9c22e464,0x054ada60e03325,0x025cd98eef769a,0x0404e56c039b8c},{0x064583b1805f47,0x022c1baf832cd0,0x0132c01bd4d717,0x04ecf4c3a75b8f,0x07c0d345cfad88},{0x071f4b8c78338a,0x062cfc16bc2b23,0x017cf51280d9aa,0x03bbae5e20a95a,0x020d754762aaec}},
+	{{0x04feb135b9f543,0x063bd192ad93ae,0x044e2ea612cdf7,0x0670f4991583ab,0x038b8ada8790b4},{0x07c36fc73bb758,0x04a6c797734bd1,0x00ef248ab3950e,0x063154c9a53ec8,0x02b8f1e46f3cee},{0x004a9cdf51f95d,0x05d963fbd596b8,0x022d9b68ace54a,0x04a98e8836c599,0x0049aeb32ceba1}},
+	{{0x067d3c63dcfe7e,0x0112f0adc81aee,0x053df04c827165,0x02fe5b33b430f0,0x051c665e0c8d62},{0x007d0b75fc7931,0x016f4ce4ba754a,0x05ace4c03fbe49,0x027e0ec12a159c,0x0795ee17530f67},{0x025b0a52ecbd81,0x05dc0695fce4a9,0x03b928c575047d,0x023bf3512686e5,0x06cd19bf49dc54}},
+	{{0x07619052179ca3,0x00c16593f0afd0,0x0265c4795c7428,0x031c40515d5442,0x07520f3db40b2e},{0x06612165afc386,0x01171aa36203ff,0x02642ea820a8aa,0x01f3bb7b313f10,0x05e01b3a7429e4},{0x050be3d39357a1,0x03ab33d294a7b6,0x04c479ba59edb3,0x04c30d184d326f,0x071092c9ccef3c}},
+	{{0x00523f0364918c,0x0687f56d638a7b,0x020796928ad013,0x05d38405a54f33,0x00ea15b03d0257},{0x03d8ac74051dcf,0x010ab6f543d0ad,0x05d0f3ac0fda90,0x05ef1d2573e5e4,0x04173a5bb7137a},{0x056e31f0f9218a,0x05635f88e102f8,0x02cbc5d969a5b8,0x0533fbc98b347a,0x05fc565614a4e3}},
+	{{0x06570dc46d7ae5,0x018a9f1b91e26d,0x0436b6183f42ab,0x0550acaa4f8198,0x062711c414c454},{0x02e1e67790988e,0x01e38b9ae44912,0x0648fbb4075654,0x028df1d840cd72,0x03214c7409d466},{0x01827406651770,0x04d144f286c265,0x017488f0ee9281,0x019e6cdb5c760c,0x05bea94073ecb8}},
+	{{0x05bf0912c89be4,0x062fadcaf38c83,0x025ec196b3ce2c,0x077655ff4f017b,0x03aacd5c148f61},{0x00ce63f343d2f8,0x01e0a87d1e368e,0x0045edbc019eea,0x06979aed28d0d1,0x04ad0785944f1b},{0x063b34c3318301,0x00e0e62d04d0b1,0x0676a233726701,0x029e9a042d9769,0x03aff0cb1d9028}},
+	{{0x05c7eb3a20405e,0x05fdb5aad930f8,0x04a757e63b8c47,0x028e9492972456,0x0110e7e86f4cd2},{0x06430bf4c53505,0x0264c3e4507244,0x074c9f19a39270,0x073f84f799bc47,0x02ccf9f732bd99},{0x00d89ed603f5e4,0x051e1604018af8,0x00b8eedc4a2218,0x051ba98b9384d0,0x005c557e0b9693}},
+	{{0x01ce311fc97e6f,0x06023f3fb5db1f,0x07b49775e8fc98,0x03ad70adbf5045,0x06e154c178fe98},{0x06bbb089c20eb0,0x06df41fb0b9eee,0x051087ed87e16f,0x0102db5c9fa731,0x0289fef0841861},{0x016336fed69abf,0x04f066b929f9ec,0x04e9ff9e6c5b93,0x018c89bc4bb2ba,0x06afbf642a95ca}},
+	{{0x00de0c62f5d2c1,0x049601cf734fb5,0x06b5c38263f0f6,0x04623ef5b56d06,0x00db4b851b9503},{0x055070f913a8cc,0x0765619eac2bbc,0x03ab5225f47459,0x076ced14ab5b48,0x012c093cedb801},{0x047f9308b8190f,0x0414235c621f82,0x031f5ff41a5a76,0x06736773aab96d,0x033aa8799c6635}},
+	{{0x07f51ebd085cf2,0x012cfa67e3f5e1,0x01800cf1e3d46a,0x054337615ff0a8,0x0233c6f29e8e21},{0x00f588fc156cb1,0x0363414da4f069,0x07296ad9b68aea,0x04d3711316ae43,0x0212cd0c1c8d58},{0x04d5107f18c781,0x064a4fd3a51a5e,0x04f4cd0448bb37,0x0671d38543151e,0x01db7778911914}},
+	{{0x0352397c6bc26f,0x018a7aa0227bbe,0x05e68cc1ea5f8b,0x06fe3e3a7a1d5f,0x031ad97ad26e2a},{0x014769dd701ab6,0x028339f1b4b667,0x04ab214b8ae37b,0x025f0aefa0b0fe,0x07ae2ca8a017d2},{0x0017ed0920b962,0x0187e33b53b6fd,0x055829907a1463,0x0641f248e0a792,0x01ed1fc53a6622}}
+};
+
+#endif /* ED25519_64BIT */
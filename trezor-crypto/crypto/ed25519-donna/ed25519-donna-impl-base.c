@@ -3,6 +3,21 @@
 #include <TrezorCrypto/memzero.h>
 
 /* sqrt(x) is such an integer y that 0 <= y <= p - 1, y % 2 = 0, and y^2 = x (mod p). */
+#if defined(ED25519_64BIT)
+/* d = -121665 / 121666 */
+#if !defined(NDEBUG)
+const bignum25519 ALIGN(16) fe_d = {0x034dca135978a3,0x01a8283b156ebd,0x05e7a26001c029,0x0739c663a03cbb,0x052036cee2b6ff}; /* d */
+#endif
+const bignum25519 ALIGN(16) fe_sqrtm1 = {0x061b274a0ea0b0,0x00d5a5fc8f189d,0x07ef5e9cbd0c60,0x078595a6804c9e,0x02b8324804fc1d}; /* sqrt(-1) */
+
+/* A = 2 * (1 - d) / (1 + d) = 486662 */
+const bignum25519 ALIGN(16) fe_ma2 = {0x07ffc8db3de3c9,0x07ffffffffffff,0x07ffffffffffff,0x07ffffffffffff,0x07ffffffffffff}; /* -A^2 */
+const bignum25519 ALIGN(16) fe_ma = {0x07fffffff892e7,0x07ffffffffffff,0x07ffffffffffff,0x07ffffffffffff,0x07ffffffffffff}; /* -A */
+const bignum25519 ALIGN(16) fe_fffb1 = {0x00968acde3bdff,0x02e8dab18e5bab,0x00139870b9afed,0x02746fab1d645f,0x0018e04102529e}; /* sqrt(-2 * A * (A + 2)) */
+const bignum25519 ALIGN(16) fe_fffb2 = {0x019b7c9f83650d,0x073f75210405a4,0x07a68106b887f2,0x0184b715d7241f,0x032f9e1f5fba5d}; /* sqrt(2 * A * (A + 2)) */
+const bignum25519 ALIGN(16) fe_fffb3 = {0x048278e8cfd387,0x062b4d37bad4fc,0x03c9744aff6c02,0x038823b55cdfe0,0x018b5eef2eb3df}; /* sqrt(-sqrt(-1) * A * (A + 2)) */
+const bignum25519 ALIGN(16) fe_fffb4 = {0x051903b6b39186,0x011427e94930a7,0x03dd0cbbb91bf0,0x05fc93607a443f,0x01a43f3031067d}; /* sqrt(sqrt(-1) * A * (A + 2)) */
+#else
 /* d = -121665 / 121666 */
 #if !defined(NDEBUG)
 const bignum25519 ALIGN(16) fe_d = {
@@ -26,6 +41,7 @@ const bignum25519 ALIGN(16) fe_fffb3 = {
 		0x0cfd387, 0x1209e3a, 0x3bad4fc, 0x18ad34d, 0x2ff6c02, 0x0f25d12, 0x15cdfe0, 0x0e208ed, 0x32eb3df, 0x062d7bb}; /* sqrt(-sqrt(-1) * A * (A + 2)) */
 const bignum25519 ALIGN(16) fe_fffb4 = {
 		0x2b39186, 0x14640ed, 0x14930a7, 0x04509fa, 0x3b91bf0, 0x0f7432e, 0x07a443f, 0x17f24d8, 0x031067d, 0x0690fcc}; /* sqrt(sqrt(-1) * A * (A + 2)) */
+#endif
 
 
 /*
@@ -317,6 +333,75 @@ void ge25519_double_scalarmult_vartime(ge25519 *r, const ge25519 *p1, const bign
 	memzero(slide2, sizeof(slide2));
 }
 
+/* computes [s]base + sum([scalars[i]]points[i]), n <= GE25519_MULTI_SCALARMULT_MAX_POINTS, interleaved sliding windows */
+void ge25519_multi_scalarmult_vartime(ge25519 *r, const ge25519 *points, const bignum256modm *scalars, size_t n, const bignum256modm s) {
+	signed char slides[GE25519_MULTI_SCALARMULT_MAX_POINTS][256] = {0}, slide2[256] = {0};
+	ge25519_pniels pre[GE25519_MULTI_SCALARMULT_MAX_POINTS][S1_TABLE_SIZE] = {0};
+#ifdef ED25519_NO_PRECOMP
+	ge25519_pniels pre2[S2_TABLE_SIZE] = {0};
+#endif
+	ge25519 dp = {0};
+	ge25519_p1p1 t = {0};
+	int32_t i = 0;
+	size_t j = 0;
+	signed char any = 0;
+
+	assert(n <= GE25519_MULTI_SCALARMULT_MAX_POINTS);
+
+	memzero(&t, sizeof(ge25519_p1p1));
+	contract256_slidingwindow_modm(slide2, s, S2_SWINDOWSIZE);
+	for (j = 0; j < n; j++) {
+		contract256_slidingwindow_modm(slides[j], scalars[j], S1_SWINDOWSIZE);
+
+		ge25519_double(&dp, &points[j]);
+		ge25519_full_to_pniels(pre[j], &points[j]);
+		for (i = 0; i < S1_TABLE_SIZE - 1; i++)
+			ge25519_pnielsadd(&pre[j][i+1], &dp, &pre[j][i]);
+	}
+
+#ifdef ED25519_NO_PRECOMP
+	ge25519_double(&dp, &ge25519_basepoint);
+	ge25519_full_to_pniels(pre2, &ge25519_basepoint);
+	for (i = 0; i < S2_TABLE_SIZE - 1; i++)
+		ge25519_pnielsadd(&pre2[i+1], &dp, &pre2[i]);
+#endif
+
+	ge25519_set_neutral(r);
+
+	for (i = 255; i >= 0; i--) {
+		any = slide2[i];
+		for (j = 0; j < n; j++)
+			any |= slides[j][i];
+		if (any)
+			break;
+	}
+
+	for (; i >= 0; i--) {
+		ge25519_double_p1p1(&t, r);
+
+		for (j = 0; j < n; j++) {
+			if (slides[j][i]) {
+				ge25519_p1p1_to_full(r, &t);
+				ge25519_pnielsadd_p1p1(&t, r, &pre[j][abs(slides[j][i]) / 2], (unsigned char)slides[j][i] >> 7);
+			}
+		}
+
+		if (slide2[i]) {
+			ge25519_p1p1_to_full(r, &t);
+#ifdef ED25519_NO_PRECOMP
+			ge25519_pnielsadd_p1p1(&t, r, &pre2[abs(slide2[i]) / 2], (unsigned char)slide2[i] >> 7);
+#else
+			ge25519_nielsadd2_p1p1(&t, r, &ge25519_niels_sliding_multiples[abs(slide2[i]) / 2], (unsigned char)slide2[i] >> 7);
+#endif
+		}
+
+		ge25519_p1p1_to_partial(r, &t);
+	}
+	curve25519_mul(r->t, t.x, t.y);
+	memzero(slides, sizeof(slides));
+	memzero(slide2, sizeof(slide2));
+}
+
 /* computes [s1]p1 + [s2]p2 */
 #if USE_MONERO
 void ge25519_double_scalarmult_vartime2(ge25519 *r, const ge25519 *p1, const bignum256modm s1, const ge25519 *p2, const bignum256modm s2) {
@@ -18,6 +18,7 @@
 #include <TrezorCrypto/ed25519.h>
 
 #include <TrezorCrypto/ed25519-donna/ed25519-hash-custom.h>
+#include <TrezorCrypto/rand.h>
 
 /*
 	Generates a (extsk[0..31]) and aExt (extsk[32..63])
@@ -54,6 +55,74 @@ ED25519_FN(ed25519_publickey) (const ed25519_secret_key sk, ed25519_public_key p
 	ge25519_pack(pk, &A);
 }
 
+/*
+	Expanded secret key: the clamped scalar a (extsk[0..31]) and the nonce prefix (extsk[32..63])
+*/
+void
+ED25519_FN(ed25519_secret_expand) (const ed25519_secret_key sk, ed25519_expanded_secret_key extsk) {
+	ed25519_extsk(extsk, sk);
+}
+
+void
+ED25519_FN(ed25519_publickey_expanded) (const ed25519_expanded_secret_key extsk, ed25519_public_key pk) {
+	bignum256modm a = {0};
+	ge25519 ALIGN(16) A;
+
+	/* A = aB */
+	expand256_modm(a, extsk, 32);
+	ge25519_scalarmult_base_niels(&A, ge25519_niels_base_multiples, a);
+	ge25519_pack(pk, &A);
+}
+
+/* public keys computed together, their affine conversions share a single inversion */
+#define ED25519_PUBLICKEY_BATCH_SIZE 16
+
+/*
+	Public keys of num secret keys. The Z coordinates are multiplied together and the product
+	inverted once, the inverse of each Z is then unwound from the partial products (Montgomery's trick).
+*/
+void
+ED25519_FN(ed25519_publickey_batch) (const ed25519_secret_key *sk, size_t num, ed25519_public_key *pk) {
+	bignum256modm a = {0};
+	ge25519 ALIGN(16) points[ED25519_PUBLICKEY_BATCH_SIZE];
+	bignum25519 products[ED25519_PUBLICKEY_BATCH_SIZE];
+	bignum25519 inverse = {0}, zi = {0}, tx = {0}, ty = {0};
+	hash_512bits extsk = {0};
+	unsigned char parity[32] = {0};
+	size_t i = 0, j = 0, count = 0;
+
+	for (i = 0; i < num; i += count) {
+		count = (num - i < ED25519_PUBLICKEY_BATCH_SIZE) ? (num - i) : ED25519_PUBLICKEY_BATCH_SIZE;
+
+		/* A_j = a_j B, products[j] = Z_0 ... Z_j */
+		for (j = 0; j < count; j++) {
+			ed25519_extsk(extsk, sk[i + j]);
+			expand256_modm(a, extsk, 32);
+			ge25519_scalarmult_base_niels(&points[j], ge25519_niels_base_multiples, a);
+			if (j == 0)
+				curve25519_copy(products[0], points[0].z);
+			else
+				curve25519_mul(products[j], products[j - 1], points[j].z);
+		}
+
+		/* inverse = 1 / (Z_0 ... Z_j) going down, 1 / Z_j = inverse * Z_0 ... Z_(j-1) */
+		curve25519_recip(inverse, products[count - 1]);
+		for (j = count; j-- > 0;) {
+			if (j > 0) {
+				curve25519_mul(zi, inverse, products[j - 1]);
+				curve25519_mul(inverse, inverse, points[j].z);
+			} else {
+				curve25519_copy(zi, inverse);
+			}
+			curve25519_mul(tx, points[j].x, zi);
+			curve25519_mul(ty, points[j].y, zi);
+			curve25519_contract(pk[i + j], ty);
+			curve25519_contract(parity, tx);
+			pk[i + j][31] ^= ((parity[0] & 1) << 7);
+		}
+	}
+}
+
 #if USE_CARDANO
 void
 ED25519_FN(ed25519_publickey_ext) (const ed25519_secret_key sk, const ed25519_secret_key skext, ed25519_public_key pk) {
@@ -99,13 +168,18 @@ ED25519_FN(ed25519_cosi_sign) (const unsigned char *m, size_t mlen, const ed2551
 
 void
 ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS) {
-	ed25519_hash_context ctx;
-	bignum256modm r = {0}, S = {0}, a = {0};
-	ge25519 ALIGN(16) R = {0};
-	hash_512bits extsk = {0}, hashr = {0}, hram = {0};
+	hash_512bits extsk = {0};
 
 	ed25519_extsk(extsk, sk);
+	ED25519_FN(ed25519_sign_expanded) (m, mlen, extsk, pk, RS);
+}
 
+void
+ED25519_FN(ed25519_sign_expanded) (const unsigned char *m, size_t mlen, const ed25519_expanded_secret_key extsk, const ed25519_public_key pk, ed25519_signature RS) {
+	ed25519_hash_context ctx;
+	bignum256modm r = {0}, S = {0}, a = {0};
+	ge25519 ALIGN(16) R = {0};
+	hash_512bits hashr = {0}, hram = {0};
 
 	/* r = H(aExt[32..64], m) */
 	ed25519_hash_init(&ctx);
@@ -136,41 +210,13 @@ ED25519_FN(ed25519_sign) (const unsigned char *m, size_t mlen, const ed25519_sec
 #if USE_CARDANO
 void
 ED25519_FN(ed25519_sign_ext) (const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_secret_key skext, const ed25519_public_key pk, ed25519_signature RS) {
-	ed25519_hash_context ctx;
-	bignum256modm r = {0}, S = {0}, a = {0};
-	ge25519 ALIGN(16) R = {0};
-	hash_512bits extsk = {0}, hashr = {0}, hram = {0};
+	hash_512bits extsk = {0};
 
 	/* we don't stretch the key through hashing first since its already 64 bytes */
 
 	memcpy(extsk, sk, 32);
 	memcpy(extsk+32, skext, 32);
-
-
-	/* r = H(aExt[32..64], m) */
-	ed25519_hash_init(&ctx);
-	ed25519_hash_update(&ctx, extsk + 32, 32);
-	ed25519_hash_update(&ctx, m, mlen);
-	ed25519_hash_final(&ctx, hashr);
-	expand256_modm(r, hashr, 64);
-
-	/* R = rB */
-	ge25519_scalarmult_base_niels(&R, ge25519_niels_base_multiples, r);
-	ge25519_pack(RS, &R);
-
-	/* S = H(R,A,m).. */
-	ed25519_hram(hram, RS, pk, m, mlen);
-	expand256_modm(S, hram, 64);
-
-	/* S = H(R,A,m)a */
-	expand256_modm(a, extsk, 32);
-	mul256_modm(S, S, a);
-
-	/* S = (r + H(R,A,m)a) */
-	add256_modm(S, S, r);
-
-	/* S = (r + H(R,A,m)a) mod L */
-	contract256_modm(RS + 32, S);
+	ED25519_FN(ed25519_sign_expanded) (m, mlen, extsk, pk, RS);
 }
 #endif
 
@@ -201,6 +247,98 @@ ED25519_FN(ed25519_sign_open) (const unsigned char *m, size_t mlen, const ed2551
 	return ed25519_verify(RS, checkR, 32) ? 0 : -1;
 }
 
+/* signatures checked together in a single multi-scalar multiplication, two points each */
+#define ED25519_BATCH_SIZE (GE25519_MULTI_SCALARMULT_MAX_POINTS / 2)
+
+/*
+	Check that p is the encoding ge25519_pack produces for the point it decodes to:
+	y < 2^255 - 19, and no sign bit for x = 0 (y = 1, y = -1)
+*/
+static int
+ed25519_is_canonical_point(const unsigned char p[32]) {
+	unsigned char ones = 0xff, zeros = p[31] & 0x7f;
+	size_t i = 0;
+
+	for (i = 1; i < 31; i++) {
+		ones &= p[i];
+		zeros |= p[i];
+	}
+	ones &= p[31] | 0x80;
+	if (ones == 0xff && p[0] >= 0xed)
+		return 0;
+	if ((p[31] & 0x80) && ((ones == 0xff && p[0] == 0xec) || (zeros == 0 && p[0] == 1)))
+		return 0;
+	return 1;
+}
+
+/*
+	Checks num <= ED25519_BATCH_SIZE signatures at once, using a random linear combination:
+	[sum(z_i s_i)]B - sum([z_i]R_i) - sum([z_i H(R_i,A_i,m_i)]A_i) = 0, with random 128-bit z_i.
+	Returns 0 if they are all valid; on failure, the signatures have to be checked one by one.
+*/
+static int
+ed25519_sign_open_batch_chunk(const unsigned char **m, const size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num) {
+	ge25519 ALIGN(16) points[GE25519_MULTI_SCALARMULT_MAX_POINTS], P;
+	bignum256modm scalars[GE25519_MULTI_SCALARMULT_MAX_POINTS];
+	bignum256modm S = {0}, z = {0}, t = {0};
+	hash_512bits hash = {0};
+	unsigned char rnd[16] = {0}, check[32] = {0};
+	static const unsigned char neutral[32] = {1};
+	size_t i = 0;
+
+	for (i = 0; i < num; i++) {
+		/* -R and -A */
+		if ((RS[i][63] & 224) || !ed25519_is_canonical_point(RS[i]) ||
+			!ge25519_unpack_negative_vartime(&points[2 * i], RS[i]) ||
+			!ge25519_unpack_negative_vartime(&points[2 * i + 1], pk[i]))
+			return -1;
+
+		expand_raw256_modm(t, RS[i] + 32);
+		if (!is_reduced256_modm(t))
+			return -1;
+
+		random_buffer(rnd, sizeof(rnd));
+		expand256_modm(z, rnd, sizeof(rnd));
+
+		/* S += z_i s_i */
+		mul256_modm(t, t, z);
+		add256_modm(S, S, t);
+
+		/* z_i, z_i H(R_i,A_i,m_i) */
+		memcpy(scalars[2 * i], z, sizeof(bignum256modm));
+		ed25519_hram(hash, RS[i], pk[i], m[i], mlen[i]);
+		expand256_modm(t, hash, 64);
+		mul256_modm(scalars[2 * i + 1], t, z);
+	}
+
+	ge25519_multi_scalarmult_vartime(&P, points, (const bignum256modm *)scalars, 2 * num, S);
+	ge25519_pack(check, &P);
+	return ed25519_verify(check, neutral, 32) ? 0 : -1;
+}
+
+int
+ED25519_FN(ed25519_sign_open_batch) (const unsigned char **m, const size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid) {
+	size_t i = 0, j = 0, count = 0;
+	int ret = 0;
+
+	for (i = 0; i < num; i += count) {
+		count = (num - i < ED25519_BATCH_SIZE) ? (num - i) : ED25519_BATCH_SIZE;
+		if (count > 1 && ed25519_sign_open_batch_chunk(m + i, mlen + i, pk + i, RS + i, count) == 0) {
+			for (j = 0; j < count; j++)
+				valid[i + j] = 1;
+			continue;
+		}
+
+		/* at least one of them is invalid, check them individually */
+		for (j = 0; j < count; j++) {
+			valid[i + j] = ED25519_FN(ed25519_sign_open)(m[i + j], mlen[i + j], pk[i + j], RS[i + j]) == 0;
+			if (!valid[i + j])
+				ret = -1;
+		}
+	}
+	return ret;
+}
+
 int
 ED25519_FN(ed25519_scalarmult) (ed25519_public_key res, const ed25519_secret_key sk, const ed25519_public_key pk) {
 	bignum256modm a = {0};
@@ -36,7 +36,9 @@
 
 #include <TrezorCrypto/groestl_internal.h>
 #include <TrezorCrypto/groestl.h>
+#include <TrezorCrypto/groestl_hw.h>
 #include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/options.h>
 
 
 #define C32e(x)     ((SPH_C32(x) >> 24) \
@@ -672,6 +674,39 @@ const sph_u32 T1dn[] = {
 	} while (0)
 
 
+void
+groestl512_compress_portable(uint32_t H[32], const uint8_t buf[128])
+{
+	COMPRESS_BIG;
+}
+
+void
+groestl512_output_portable(uint32_t H[32])
+{
+	FINAL_BIG;
+}
+
+// [wallet-core] dispatch to the hardware accelerated implementation, if any
+static void
+groestl_big_compress(sph_u32 *H, const unsigned char *buf)
+{
+#if USE_GROESTL_HW
+	groestl512_hw_compress(H, buf);
+#else
+	groestl512_compress_portable(H, buf);
+#endif
+}
+
+static void
+groestl_big_output(sph_u32 *H)
+{
+#if USE_GROESTL_HW
+	groestl512_hw_output(H);
+#else
+	groestl512_output_portable(H);
+#endif
+}
+
 static void
 groestl_big_init(sph_groestl_big_context *sc, unsigned out_size)
 {
@@ -713,7 +748,7 @@ groestl_big_core(sph_groestl_big_context *sc, const void *data, size_t len)
 		data = (const unsigned char *)data + clen;
 		len -= clen;
 		if (ptr == sizeof sc->buf) {
-			COMPRESS_BIG;
+			groestl_big_compress(H, buf);
 			sc->count ++;
 			ptr = 0;
 		}
@@ -746,7 +781,7 @@ groestl_big_close(sph_groestl_big_context *sc,
 	sph_enc64be(pad + pad_len - 8, count);
 	groestl_big_core(sc, pad, pad_len);
 	READ_STATE_BIG(sc);
-	FINAL_BIG;
+	groestl_big_output(H);
 	for (u2 = 0; u2 < 16; u2 ++)
 		enc32e(pad + (u2 << 2), H[u2 + 16]);
 	memcpy(dst, pad + 64 - out_len, out_len);
@@ -0,0 +1,281 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Hardware accelerated Groestl-512 compression, selected at runtime.
+//
+// The AES-NI code keeps the 8x16 byte state as one SSE register per row, so the
+// column-wise MixBytes becomes byte-wise arithmetic across the 8 registers.
+// SubBytes uses the AES S-box of AESENCLAST with a zero round key, and the byte
+// shuffle ahead of it performs ShiftBytes while undoing the AES ShiftRows.
+// The chaining state is stored as in the portable code, the raw bytes of the
+// state matrix, column by column (this assumes a little endian host, as x86 is).
+
+#include <TrezorCrypto/groestl_hw.h>
+#include <TrezorCrypto/options.h>
+
+#if USE_GROESTL_HW && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define GROESTL_HW_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+typedef void (*groestl512_compress_fn)(uint32_t state[32], const uint8_t block[128]);
+typedef void (*groestl512_output_fn)(uint32_t state[32]);
+
+#ifdef GROESTL_HW_X86
+
+#define GROESTL_AESNI __attribute__((target("aes,ssse3")))
+
+/* Rows are shifted left by these amounts by ShiftBytes */
+static const int groestl_shift_p[8] = {0, 1, 2, 3, 4, 5, 6, 11};
+static const int groestl_shift_q[8] = {1, 3, 5, 11, 0, 2, 4, 6};
+
+/* Shuffle shifting a row left by `shift` bytes, composed with the inverse AES ShiftRows */
+GROESTL_AESNI static inline __m128i groestl_shift_mask(int shift) {
+	const __m128i inverse_shift_rows = _mm_setr_epi8(0, 13, 10, 7, 4, 1, 14, 11, 8, 5, 2, 15, 12, 9, 6, 3);
+	return _mm_and_si128(_mm_add_epi8(inverse_shift_rows, _mm_set1_epi8((char)shift)), _mm_set1_epi8(0x0f));
+}
+
+/* Multiplication by 2 in GF(2^8), byte-wise */
+GROESTL_AESNI static inline __m128i groestl_mul2(__m128i x) {
+	const __m128i high = _mm_cmpgt_epi8(_mm_setzero_si128(), x);
+	return _mm_xor_si128(_mm_add_epi8(x, x), _mm_and_si128(high, _mm_set1_epi8(0x1b)));
+}
+
+/* Transposes 8x8 matrices of 16 bit elements, one row per register */
+GROESTL_AESNI static inline void groestl_transpose(const __m128i in[8], __m128i out[8]) {
+	const __m128i t0 = _mm_unpacklo_epi16(in[0], in[1]);
+	const __m128i t1 = _mm_unpackhi_epi16(in[0], in[1]);
+	const __m128i t2 = _mm_unpacklo_epi16(in[2], in[3]);
+	const __m128i t3 = _mm_unpackhi_epi16(in[2], in[3]);
+	const __m128i t4 = _mm_unpacklo_epi16(in[4], in[5]);
+	const __m128i t5 = _mm_unpackhi_epi16(in[4], in[5]);
+	const __m128i t6 = _mm_unpacklo_epi16(in[6], in[7]);
+	const __m128i t7 = _mm_unpackhi_epi16(in[6], in[7]);
+	const __m128i u0 = _mm_unpacklo_epi32(t0, t2);
+	const __m128i u1 = _mm_unpackhi_epi32(t0, t2);
+	const __m128i u2 = _mm_unpacklo_epi32(t1, t3);
+	const __m128i u3 = _mm_unpackhi_epi32(t1, t3);
+	const __m128i u4 = _mm_unpacklo_epi32(t4, t6);
+	const __m128i u5 = _mm_unpackhi_epi32(t4, t6);
+	const __m128i u6 = _mm_unpacklo_epi32(t5, t7);
+	const __m128i u7 = _mm_unpackhi_epi32(t5, t7);
+	out[0] = _mm_unpacklo_epi64(u0, u4);
+	out[1] = _mm_unpackhi_epi64(u0, u4);
+	out[2] = _mm_unpacklo_epi64(u1, u5);
+	out[3] = _mm_unpackhi_epi64(u1, u5);
+	out[4] = _mm_unpacklo_epi64(u2, u6);
+	out[5] = _mm_unpackhi_epi64(u2, u6);
+	out[6] = _mm_unpacklo_epi64(u3, u7);
+	out[7] = _mm_unpackhi_epi64(u3, u7);
+}
+
+/* Loads 16 columns of 8 bytes as 8 rows of 16 bytes */
+GROESTL_AESNI static inline void groestl_load_rows(const uint8_t* bytes, __m128i rows[8]) {
+	/* pairs the bytes of two consecutive columns, row by row */
+	const __m128i interleave = _mm_setr_epi8(0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15);
+	__m128i pairs[8];
+	for (int k = 0; k < 8; k++) {
+		pairs[k] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(bytes + 16 * k)), interleave);
+	}
+	groestl_transpose(pairs, rows);
+}
+
+/* Stores 8 rows of 16 bytes as 16 columns of 8 bytes */
+GROESTL_AESNI static inline void groestl_store_rows(const __m128i rows[8], uint8_t* bytes) {
+	const __m128i deinterleave = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+	__m128i pairs[8];
+	groestl_transpose(rows, pairs);
+	for (int k = 0; k < 8; k++) {
+		_mm_storeu_si128((__m128i*)(bytes + 16 * k), _mm_shuffle_epi8(pairs[k], deinterleave));
+	}
+}
+
+/* SubBytes and ShiftBytes */
+GROESTL_AESNI static inline void groestl_sub_shift(__m128i x[8], const __m128i shift[8]) {
+	const __m128i zero = _mm_setzero_si128();
+	for (int i = 0; i < 8; i++) {
+		x[i] = _mm_aesenclast_si128(_mm_shuffle_epi8(x[i], shift[i]), zero);
+	}
+}
+
+/* MixBytes: row i becomes the sum of row i+k multiplied by (02 02 03 04 05 03 05 07)[k],
+   computed as X + 2 (T + 2 F) where X, T and F sum the rows with the matching factor bits */
+GROESTL_AESNI static inline void groestl_mix_bytes(__m128i a[8]) {
+	__m128i y[8];
+	for (int i = 0; i < 8; i++) {
+		const __m128i a0 = a[i], a1 = a[(i + 1) & 7], a2 = a[(i + 2) & 7], a3 = a[(i + 3) & 7];
+		const __m128i a4 = a[(i + 4) & 7], a5 = a[(i + 5) & 7], a6 = a[(i + 6) & 7], a7 = a[(i + 7) & 7];
+		const __m128i a67 = _mm_xor_si128(a6, a7);
+		const __m128i x = _mm_xor_si128(_mm_xor_si128(a2, a4), _mm_xor_si128(a5, a67));
+		const __m128i t = _mm_xor_si128(_mm_xor_si128(a0, a1), _mm_xor_si128(_mm_xor_si128(a2, a5), a7));
+		const __m128i f = _mm_xor_si128(_mm_xor_si128(a3, a4), a67);
+		y[i] = _mm_xor_si128(x, groestl_mul2(_mm_xor_si128(t, groestl_mul2(f))));
+	}
+	for (int i = 0; i < 8; i++) {
+		a[i] = y[i];
+	}
+}
+
+/* Round constant column indices, (j << 4) for column j */
+#define GROESTL_COLUMNS _mm_setr_epi8(0x00, 0x10, 0x20, 0x30, 0x40, 0x50, 0x60, 0x70, \
+	(char)0x80, (char)0x90, (char)0xa0, (char)0xb0, (char)0xc0, (char)0xd0, (char)0xe0, (char)0xf0)
+
+GROESTL_AESNI static void groestl_perm_p(__m128i x[8]) {
+	const __m128i columns = GROESTL_COLUMNS;
+	__m128i shift[8];
+	for (int i = 0; i < 8; i++) {
+		shift[i] = groestl_shift_mask(groestl_shift_p[i]);
+	}
+	for (int r = 0; r < 14; r++) {
+		x[0] = _mm_xor_si128(x[0], _mm_xor_si128(columns, _mm_set1_epi8((char)r)));
+		groestl_sub_shift(x, shift);
+		groestl_mix_bytes(x);
+	}
+}
+
+GROESTL_AESNI static void groestl_perm_q(__m128i x[8]) {
+	const __m128i ones = _mm_set1_epi8((char)0xff);
+	const __m128i columns = _mm_xor_si128(GROESTL_COLUMNS, ones);
+	__m128i shift[8];
+	for (int i = 0; i < 8; i++) {
+		shift[i] = groestl_shift_mask(groestl_shift_q[i]);
+	}
+	for (int r = 0; r < 14; r++) {
+		for (int i = 0; i < 7; i++) {
+			x[i] = _mm_xor_si128(x[i], ones);
+		}
+		x[7] = _mm_xor_si128(x[7], _mm_xor_si128(columns, _mm_set1_epi8((char)r)));
+		groestl_sub_shift(x, shift);
+		groestl_mix_bytes(x);
+	}
+}
+
+/* H = P(H ^ M) ^ Q(M) ^ H */
+GROESTL_AESNI static void groestl512_compress_aesni(uint32_t state[32], const uint8_t block[128]) {
+	__m128i h[8], m[8], g[8];
+	groestl_load_rows((const uint8_t*)state, h);
+	groestl_load_rows(block, m);
+	for (int i = 0; i < 8; i++) {
+		g[i] = _mm_xor_si128(h[i], m[i]);
+	}
+	groestl_perm_p(g);
+	groestl_perm_q(m);
+	for (int i = 0; i < 8; i++) {
+		h[i] = _mm_xor_si128(h[i], _mm_xor_si128(g[i], m[i]));
+	}
+	groestl_store_rows(h, (uint8_t*)state);
+}
+
+/* H = P(H) ^ H */
+GROESTL_AESNI static void groestl512_output_aesni(uint32_t state[32]) {
+	__m128i h[8], x[8];
+	groestl_load_rows((const uint8_t*)state, h);
+	for (int i = 0; i < 8; i++) {
+		x[i] = h[i];
+	}
+	groestl_perm_p(x);
+	for (int i = 0; i < 8; i++) {
+		h[i] = _mm_xor_si128(h[i], x[i]);
+	}
+	groestl_store_rows(h, (uint8_t*)state);
+}
+
+static unsigned groestl_hw_detect(void) {
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	const int ssse3 = (ecx & (1u << 9)) != 0;
+	const int aes = (ecx & (1u << 25)) != 0;
+	return ssse3 && aes ? GROESTL_HW_AESNI : 0;
+}
+
+#else
+
+static unsigned groestl_hw_detect(void) {
+	return 0;
+}
+
+#endif
+
+/* Supported features, detected on first use */
+static unsigned groestl_hw_supported_features = 0;
+static int groestl_hw_detected = 0;
+/* Features in use, and the matching functions */
+static unsigned groestl_hw_features = 0;
+static groestl512_compress_fn groestl_hw_compress_fn = 0;
+static groestl512_output_fn groestl_hw_output_fn = 0;
+
+/* The state above may be initialized from several threads at once, so it is
+   accessed atomically; the detected flag and the functions are published last. */
+#define GROESTL_HW_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define GROESTL_HW_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static unsigned groestl_hw_detected_features(void) {
+	if (!GROESTL_HW_LOAD(&groestl_hw_detected)) {
+		GROESTL_HW_STORE(&groestl_hw_supported_features, groestl_hw_detect());
+		GROESTL_HW_STORE(&groestl_hw_detected, 1);
+	}
+	return GROESTL_HW_LOAD(&groestl_hw_supported_features);
+}
+
+static void groestl_hw_init(void) {
+	if (GROESTL_HW_LOAD(&groestl_hw_compress_fn) == 0) {
+		groestl_hw_select(groestl_hw_detected_features());
+	}
+}
+
+unsigned groestl_hw_supported(void) {
+	return groestl_hw_detected_features();
+}
+
+unsigned groestl_hw_selected(void) {
+	groestl_hw_init();
+	return GROESTL_HW_LOAD(&groestl_hw_features);
+}
+
+unsigned groestl_hw_select(unsigned features) {
+	features &= groestl_hw_detected_features();
+	groestl512_compress_fn compress = groestl512_compress_portable;
+	groestl512_output_fn output = groestl512_output_portable;
+#ifdef GROESTL_HW_X86
+	if (features & GROESTL_HW_AESNI) {
+		compress = groestl512_compress_aesni;
+		output = groestl512_output_aesni;
+	}
+#endif
+	GROESTL_HW_STORE(&groestl_hw_features, features);
+	GROESTL_HW_STORE(&groestl_hw_output_fn, output);
+	GROESTL_HW_STORE(&groestl_hw_compress_fn, compress);
+	return features;
+}
+
+void groestl512_hw_compress(uint32_t state[32], const uint8_t block[128]) {
+	groestl_hw_init();
+	GROESTL_HW_LOAD(&groestl_hw_compress_fn)(state, block);
+}
+
+void groestl512_hw_output(uint32_t state[32]) {
+	groestl_hw_init();
+	GROESTL_HW_LOAD(&groestl_hw_output_fn)(state);
+}
@@ -0,0 +1,233 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Fused hash160.
+//
+// The RIPEMD-160 input of hash160 is always a 32-byte SHA-256 digest, a single block whose padding
+// is constant, so RIPEMD-160 is one compression without the buffering of ripemd160_Update. Batches
+// compute the SHA-256 digests with sha256_Raw_batch, then compress 8 digests at once, one per
+// 32-bit lane of the AVX2 registers.
+
+#include <string.h>
+
+#include <TrezorCrypto/hash160.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha2_hw.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define HASH160_AVX2 1
+#include <immintrin.h>
+#endif
+
+/* SHA-256 digests hashed per sha256_Raw_batch call */
+#define HASH160_CHUNK 64
+
+static const uint32_t ripemd160_initial[5] = {
+	0x67452301UL, 0xEFCDAB89UL, 0x98BADCFEUL, 0x10325476UL, 0xC3D2E1F0UL,
+};
+
+/* Message word and rotation of each step, left and right lines */
+static const uint8_t ripemd160_rl[80] = {
+	0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+	7, 4, 13, 1, 10, 6, 15, 3, 12, 0, 9, 5, 2, 14, 11, 8,
+	3, 10, 14, 4, 9, 15, 8, 1, 2, 7, 0, 6, 13, 11, 5, 12,
+	1, 9, 11, 10, 0, 8, 12, 4, 13, 3, 7, 15, 14, 5, 6, 2,
+	4, 0, 5, 9, 7, 12, 2, 10, 14, 1, 3, 8, 11, 6, 15, 13,
+};
+static const uint8_t ripemd160_rr[80] = {
+	5, 14, 7, 0, 9, 2, 11, 4, 13, 6, 15, 8, 1, 10, 3, 12,
+	6, 11, 3, 7, 0, 13, 5, 10, 14, 15, 8, 12, 4, 9, 1, 2,
+	15, 5, 1, 3, 7, 14, 6, 9, 11, 8, 12, 2, 10, 0, 4, 13,
+	8, 6, 4, 1, 3, 11, 15, 0, 5, 12, 2, 13, 9, 7, 10, 14,
+	12, 15, 10, 4, 1, 5, 8, 7, 6, 2, 13, 14, 0, 3, 9, 11,
+};
+static const uint8_t ripemd160_sl[80] = {
+	11, 14, 15, 12, 5, 8, 7, 9, 11, 13, 14, 15, 6, 7, 9, 8,
+	7, 6, 8, 13, 11, 9, 7, 15, 7, 12, 15, 9, 11, 7, 13, 12,
+	11, 13, 6, 7, 14, 9, 13, 15, 14, 8, 13, 6, 5, 12, 7, 5,
+	11, 12, 14, 15, 14, 15, 9, 8, 9, 14, 5, 6, 8, 6, 5, 12,
+	9, 15, 5, 11, 6, 8, 13, 12, 5, 12, 13, 14, 11, 8, 5, 6,
+};
+static const uint8_t ripemd160_sr[80] = {
+	8, 9, 9, 11, 13, 15, 15, 5, 7, 7, 8, 11, 14, 14, 12, 6,
+	9, 13, 15, 7, 12, 8, 9, 11, 7, 7, 12, 7, 6, 15, 13, 11,
+	9, 7, 15, 11, 8, 6, 6, 14, 12, 13, 5, 14, 13, 13, 7, 5,
+	15, 5, 8, 11, 14, 14, 6, 14, 6, 9, 12, 9, 12, 5, 15, 8,
+	8, 5, 12, 9, 12, 5, 14, 6, 8, 13, 6, 5, 15, 13, 11, 11,
+};
+static const uint32_t ripemd160_kl[5] = {0x00000000UL, 0x5A827999UL, 0x6ED9EBA1UL, 0x8F1BBCDCUL, 0xA953FD4EUL};
+static const uint32_t ripemd160_kr[5] = {0x50A28BE6UL, 0x5C4DD124UL, 0x6D703EF3UL, 0x7A6D76E9UL, 0x00000000UL};
+
+/* Words of the padded block of a 32-byte message, x[8..15] */
+static const uint32_t ripemd160_padding[8] = {0x80, 0, 0, 0, 0, 0, 256, 0};
+
+#define ROTL32(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+
+static uint32_t ripemd160_f(int round, uint32_t x, uint32_t y, uint32_t z) {
+	switch (round) {
+	case 0: return x ^ y ^ z;
+	case 1: return (x & y) | (~x & z);
+	case 2: return (x | ~y) ^ z;
+	case 3: return (x & z) | (y & ~z);
+	default: return x ^ (y | ~z);
+	}
+}
+
+/* RIPEMD-160 of a 32-byte message */
+static void ripemd160_32(const uint8_t data[32], uint8_t digest[HASH160_DIGEST_LENGTH]) {
+	uint32_t x[16];
+	for (int i = 0; i < 8; i++) {
+		x[i] = (uint32_t)data[4 * i] | ((uint32_t)data[4 * i + 1] << 8) |
+			((uint32_t)data[4 * i + 2] << 16) | ((uint32_t)data[4 * i + 3] << 24);
+	}
+	memcpy(x + 8, ripemd160_padding, sizeof(ripemd160_padding));
+
+	uint32_t al = ripemd160_initial[0], bl = ripemd160_initial[1], cl = ripemd160_initial[2],
+		dl = ripemd160_initial[3], el = ripemd160_initial[4];
+	uint32_t ar = al, br = bl, cr = cl, dr = dl, er = el;
+	for (int j = 0; j < 80; j++) {
+		const int round = j / 16;
+		uint32_t t = al + ripemd160_f(round, bl, cl, dl) + x[ripemd160_rl[j]] + ripemd160_kl[round];
+		t = ROTL32(t, ripemd160_sl[j]) + el;
+		al = el; el = dl; dl = ROTL32(cl, 10); cl = bl; bl = t;
+		t = ar + ripemd160_f(4 - round, br, cr, dr) + x[ripemd160_rr[j]] + ripemd160_kr[round];
+		t = ROTL32(t, ripemd160_sr[j]) + er;
+		ar = er; er = dr; dr = ROTL32(cr, 10); cr = br; br = t;
+	}
+	const uint32_t h[5] = {
+		ripemd160_initial[1] + cl + dr,
+		ripemd160_initial[2] + dl + er,
+		ripemd160_initial[3] + el + ar,
+		ripemd160_initial[4] + al + br,
+		ripemd160_initial[0] + bl + cr,
+	};
+	for (int i = 0; i < 5; i++) {
+		digest[4 * i] = (uint8_t)h[i];
+		digest[4 * i + 1] = (uint8_t)(h[i] >> 8);
+		digest[4 * i + 2] = (uint8_t)(h[i] >> 16);
+		digest[4 * i + 3] = (uint8_t)(h[i] >> 24);
+	}
+	memzero(x, sizeof(x));
+}
+
+#ifdef HASH160_AVX2
+
+#define ROTL32X8(x, n) _mm256_or_si256(_mm256_sll_epi32((x), _mm_cvtsi32_si128(n)), _mm256_srl_epi32((x), _mm_cvtsi32_si128(32 - (n))))
+
+__attribute__((target("avx2")))
+static __m256i ripemd160_f_x8(int round, __m256i x, __m256i y, __m256i z) {
+	const __m256i ones = _mm256_set1_epi32(-1);
+	switch (round) {
+	case 0: return _mm256_xor_si256(_mm256_xor_si256(x, y), z);
+	case 1: return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z));
+	case 2: return _mm256_xor_si256(_mm256_or_si256(x, _mm256_xor_si256(y, ones)), z);
+	case 3: return _mm256_or_si256(_mm256_and_si256(x, z), _mm256_andnot_si256(z, y));
+	default: return _mm256_xor_si256(x, _mm256_or_si256(y, _mm256_xor_si256(z, ones)));
+	}
+}
+
+/* RIPEMD-160 of 8 messages of 32 bytes, stored consecutively */
+__attribute__((target("avx2")))
+static void ripemd160_32_x8_avx2(const uint8_t* data, uint8_t* digests) {
+	__m256i x[16];
+	/* the byte order of the words is the one of x86 */
+	for (int i = 0; i < 8; i++) {
+		x[i] = _mm256_i32gather_epi32((const int*)(data + 4 * i), _mm256_setr_epi32(0, 8, 16, 24, 32, 40, 48, 56), 4);
+	}
+	for (int i = 8; i < 16; i++) {
+		x[i] = _mm256_set1_epi32((int)ripemd160_padding[i - 8]);
+	}
+
+	__m256i al = _mm256_set1_epi32((int)ripemd160_initial[0]), bl = _mm256_set1_epi32((int)ripemd160_initial[1]),
+		cl = _mm256_set1_epi32((int)ripemd160_initial[2]), dl = _mm256_set1_epi32((int)ripemd160_initial[3]),
+		el = _mm256_set1_epi32((int)ripemd160_initial[4]);
+	__m256i ar = al, br = bl, cr = cl, dr = dl, er = el;
+	for (int j = 0; j < 80; j++) {
+		const int round = j / 16;
+		__m256i t = _mm256_add_epi32(_mm256_add_epi32(al, ripemd160_f_x8(round, bl, cl, dl)),
+			_mm256_add_epi32(x[ripemd160_rl[j]], _mm256_set1_epi32((int)ripemd160_kl[round])));
+		t = _mm256_add_epi32(ROTL32X8(t, ripemd160_sl[j]), el);
+		al = el; el = dl; dl = ROTL32X8(cl, 10); cl = bl; bl = t;
+		t = _mm256_add_epi32(_mm256_add_epi32(ar, ripemd160_f_x8(4 - round, br, cr, dr)),
+			_mm256_add_epi32(x[ripemd160_rr[j]], _mm256_set1_epi32((int)ripemd160_kr[round])));
+		t = _mm256_add_epi32(ROTL32X8(t, ripemd160_sr[j]), er);
+		ar = er; er = dr; dr = ROTL32X8(cr, 10); cr = br; br = t;
+	}
+	__m256i h[5];
+	h[0] = _mm256_add_epi32(_mm256_set1_epi32((int)ripemd160_initial[1]), _mm256_add_epi32(cl, dr));
+	h[1] = _mm256_add_epi32(_mm256_set1_epi32((int)ripemd160_initial[2]), _mm256_add_epi32(dl, er));
+	h[2] = _mm256_add_epi32(_mm256_set1_epi32((int)ripemd160_initial[3]), _mm256_add_epi32(el, ar));
+	h[3] = _mm256_add_epi32(_mm256_set1_epi32((int)ripemd160_initial[4]), _mm256_add_epi32(al, br));
+	h[4] = _mm256_add_epi32(_mm256_set1_epi32((int)ripemd160_initial[0]), _mm256_add_epi32(bl, cr));
+	uint32_t words[5][8];
+	for (int i = 0; i < 5; i++) {
+		_mm256_storeu_si256((__m256i*)words[i], h[i]);
+	}
+	for (int lane = 0; lane < 8; lane++) {
+		for (int i = 0; i < 5; i++) {
+			memcpy(digests + lane * HASH160_DIGEST_LENGTH + 4 * i, &words[i][lane], sizeof(uint32_t));
+		}
+	}
+	memzero(x, sizeof(x));
+}
+
+static int hash160_avx2_supported(void) {
+	/* may be detected from several threads at once */
+	static int supported = -1;
+	int result = __atomic_load_n(&supported, __ATOMIC_RELAXED);
+	if (result < 0) {
+		__builtin_cpu_init();
+		result = __builtin_cpu_supports("avx2") ? 1 : 0;
+		__atomic_store_n(&supported, result, __ATOMIC_RELAXED);
+	}
+	return result;
+}
+
+#endif
+
+void hash160(const uint8_t* data, size_t len, uint8_t digest[HASH160_DIGEST_LENGTH]) {
+	uint8_t sha[SHA256_DIGEST_LENGTH];
+	sha256_Raw(data, len, sha);
+	ripemd160_32(sha, digest);
+	memzero(sha, sizeof(sha));
+}
+
+void hash160_batch(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests) {
+	uint8_t sha[HASH160_CHUNK * SHA256_DIGEST_LENGTH];
+	for (size_t start = 0; start < count; start += HASH160_CHUNK) {
+		const size_t n = (count - start < HASH160_CHUNK) ? (count - start) : HASH160_CHUNK;
+		sha256_Raw_batch(data + start, len + start, n, sha);
+		size_t i = 0;
+#ifdef HASH160_AVX2
+		if (hash160_avx2_supported()) {
+			for (; i + 8 <= n; i += 8) {
+				ripemd160_32_x8_avx2(sha + i * SHA256_DIGEST_LENGTH, digests + (start + i) * HASH160_DIGEST_LENGTH);
+			}
+		}
+#endif
+		for (; i < n; i++) {
+			ripemd160_32(sha + i * SHA256_DIGEST_LENGTH, digests + (start + i) * HASH160_DIGEST_LENGTH);
+		}
+	}
+	memzero(sha, sizeof(sha));
+}
@@ -20,6 +20,7 @@
  * OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <TrezorCrypto/hash160.h>
 #include <TrezorCrypto/hasher.h>
 #include <TrezorCrypto/ripemd160.h>
 
@@ -139,6 +140,12 @@ void hasher_Final(Hasher *hasher, uint8_t hash[HASHER_DIGEST_LENGTH]) {
 
 void hasher_Raw(HasherType type, const uint8_t *data, size_t length,
                 uint8_t hash[HASHER_DIGEST_LENGTH]) {
+  // [wallet-core] fused, without the hasher context
+  if (type == HASHER_SHA2_RIPEMD) {
+    hash160(data, length, hash);
+    return;
+  }
+
   Hasher hasher = {0};
 
   hasher_Init(&hasher, type);
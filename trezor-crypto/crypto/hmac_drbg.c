@@ -25,6 +25,30 @@
 #include <TrezorCrypto/memzero.h>
 #include <TrezorCrypto/sha2.h>
 
+static void finish_k(HMAC_DRBG_CTX *ctx, const uint32_t *odig,
+                     uint32_t h[SHA256_BLOCK_LENGTH / sizeof(uint32_t)]) {
+  // Completes K = HMAC(K, ...) from the inner digest in h.
+
+  // Second hash operation of HMAC.
+  h[8] = 0x80000000;
+  h[15] = (SHA256_BLOCK_LENGTH + SHA256_DIGEST_LENGTH) * 8;
+  sha256_Transform(odig, h, h);
+
+  // Precompute the inner digest and outer digest of K.
+  h[8] = 0;
+  h[15] = 0;
+  for (size_t i = 0; i < SHA256_BLOCK_LENGTH / sizeof(uint32_t); i++) {
+    h[i] ^= 0x36363636;
+  }
+  sha256_Transform(sha256_initial_hash_value, h, ctx->idig);
+
+  for (size_t i = 0; i < SHA256_BLOCK_LENGTH / sizeof(uint32_t); i++) {
+    h[i] = h[i] ^ 0x36363636 ^ 0x5c5c5c5c;
+  }
+  sha256_Transform(sha256_initial_hash_value, h, ctx->odig);
+  memzero(h, SHA256_BLOCK_LENGTH);
+}
+
 static void update_k(HMAC_DRBG_CTX *ctx, uint8_t domain, const uint8_t *data1,
                      size_t len1, const uint8_t *data2, size_t len2) {
   // Computes K = HMAC(K, V || domain || data1 || data 2).
@@ -58,24 +82,15 @@ static void update_k(HMAC_DRBG_CTX *ctx, uint8_t domain, const uint8_t *data1,
 #endif
   }
 
-  // Second hash operation of HMAC.
-  h[8] = 0x80000000;
-  h[15] = (SHA256_BLOCK_LENGTH + SHA256_DIGEST_LENGTH) * 8;
-  sha256_Transform(ctx->odig, h, h);
-
-  // Precompute the inner digest and outer digest of K.
-  h[8] = 0;
-  h[15] = 0;
-  for (size_t i = 0; i < SHA256_BLOCK_LENGTH / sizeof(uint32_t); i++) {
-    h[i] ^= 0x36363636;
-  }
-  sha256_Transform(sha256_initial_hash_value, h, ctx->idig);
+  finish_k(ctx, ctx->odig, h);
+}
 
-  for (size_t i = 0; i < SHA256_BLOCK_LENGTH / sizeof(uint32_t); i++) {
-    h[i] = h[i] ^ 0x36363636 ^ 0x5c5c5c5c;
-  }
-  sha256_Transform(sha256_initial_hash_value, h, ctx->odig);
-  memzero(h, sizeof(h));
+static void init_v(HMAC_DRBG_CTX *ctx) {
+  // Let V = 0x01 ... 0x01.
+  memset(ctx->v, 1, SHA256_DIGEST_LENGTH);
+  for (size_t i = 9; i < 15; i++) ctx->v[i] = 0;
+  ctx->v[8] = 0x80000000;
+  ctx->v[15] = (SHA256_BLOCK_LENGTH + SHA256_DIGEST_LENGTH) * 8;
 }
 
 static void update_v(HMAC_DRBG_CTX *ctx) {
@@ -94,11 +109,7 @@ void hmac_drbg_init(HMAC_DRBG_CTX *ctx, const uint8_t *entropy,
   memset(h, 0x5c, sizeof(h));
   sha256_Transform(sha256_initial_hash_value, h, ctx->odig);
 
-  // Let V = 0x01 ... 0x01.
-  memset(ctx->v, 1, SHA256_DIGEST_LENGTH);
-  for (size_t i = 9; i < 15; i++) ctx->v[i] = 0;
-  ctx->v[8] = 0x80000000;
-  ctx->v[15] = (SHA256_BLOCK_LENGTH + SHA256_DIGEST_LENGTH) * 8;
+  init_v(ctx);
 
   hmac_drbg_reseed(ctx, entropy, entropy_len, nonce, nonce_len);
 
@@ -128,3 +139,55 @@ void hmac_drbg_generate(HMAC_DRBG_CTX *ctx, uint8_t *buf, size_t len) {
   update_k(ctx, 0, NULL, 0, NULL, 0);
   update_v(ctx);
 }
+
+void hmac_drbg_init_prefix(HMAC_DRBG_PREFIX *prefix, const uint8_t *entropy) {
+  uint32_t h[SHA256_BLOCK_LENGTH / sizeof(uint32_t)] = {0};
+  uint32_t idig[SHA256_DIGEST_LENGTH / sizeof(uint32_t)] = {0};
+
+  // The digests of K = 0x00 ... 0x00, as in hmac_drbg_init.
+  memset(h, 0x36, sizeof(h));
+  sha256_Transform(sha256_initial_hash_value, h, idig);
+  memset(h, 0x5c, sizeof(h));
+  sha256_Transform(sha256_initial_hash_value, h, prefix->odig);
+
+  // The first block of the inner hash of HMAC(K, V || 0x00 || entropy ...).
+  uint8_t block[SHA256_BLOCK_LENGTH] = {0};
+  memset(block, 1, SHA256_DIGEST_LENGTH);
+  block[SHA256_DIGEST_LENGTH] = 0;
+  memcpy(block + SHA256_DIGEST_LENGTH + 1, entropy, HMAC_DRBG_PREFIX_LENGTH);
+  for (size_t i = 0; i < SHA256_BLOCK_LENGTH / sizeof(uint32_t); i++) {
+    h[i] = ((uint32_t)block[4 * i] << 24) | ((uint32_t)block[4 * i + 1] << 16) |
+           ((uint32_t)block[4 * i + 2] << 8) | block[4 * i + 3];
+  }
+  sha256_Transform(idig, h, prefix->inner);
+
+  memzero(h, sizeof(h));
+  memzero(block, sizeof(block));
+}
+
+void hmac_drbg_init_with_prefix(HMAC_DRBG_CTX *ctx,
+                                const HMAC_DRBG_PREFIX *prefix,
+                                const uint8_t *entropy, size_t entropy_len,
+                                const uint8_t *nonce, size_t nonce_len) {
+  // K = HMAC(0, V || 0x00 || entropy || nonce), resuming after the prefix.
+  uint32_t h[SHA256_BLOCK_LENGTH / sizeof(uint32_t)] = {0};
+  SHA256_CTX sha_ctx = {0};
+  memcpy(sha_ctx.state, prefix->inner, SHA256_DIGEST_LENGTH);
+  sha_ctx.bitcount = 2 * SHA256_BLOCK_LENGTH * 8;
+  sha256_Update(&sha_ctx, entropy + HMAC_DRBG_PREFIX_LENGTH,
+                entropy_len - HMAC_DRBG_PREFIX_LENGTH);
+  sha256_Update(&sha_ctx, nonce, nonce_len);
+  sha256_Final(&sha_ctx, (uint8_t *)h);
+#if BYTE_ORDER == LITTLE_ENDIAN
+  for (size_t i = 0; i < SHA256_DIGEST_LENGTH / sizeof(uint32_t); i++)
+    REVERSE32(h[i], h[i]);
+#endif
+  finish_k(ctx, prefix->odig, h);
+
+  init_v(ctx);
+  update_v(ctx);
+  update_k(ctx, 1, entropy, entropy_len, nonce, nonce_len);
+  update_v(ctx);
+
+  memzero(h, sizeof(h));
+}
@@ -0,0 +1,263 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Multi-lane Keccak-256.
+//
+// Keccak-f[1600] is computed for 4 independent states at once, one per 64-bit
+// lane of the AVX2 registers. Messages of any length are scheduled over the
+// lanes, so a batch of differently sized messages keeps all lanes busy.
+
+#include <string.h>
+
+#include <TrezorCrypto/keccak_x4.h>
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/sha3.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define KECCAK_X4_AVX2 1
+#include <immintrin.h>
+#endif
+
+/* Keccak-256 block size and digest size in bytes */
+#define KECCAK_256_RATE 136
+#define KECCAK_256_DIGEST 32
+#define KECCAK_256_RATE_WORDS (KECCAK_256_RATE / 8)
+
+#ifdef KECCAK_X4_AVX2
+
+extern const uint64_t keccak_round_constants[24];
+
+#define ROTL64X4(x, n) _mm256_or_si256(_mm256_slli_epi64((x), (n)), _mm256_srli_epi64((x), 64 - (n)))
+#define XOR5X4(a, b, c, d, e) _mm256_xor_si256(_mm256_xor_si256(_mm256_xor_si256((a), (b)), _mm256_xor_si256((c), (d))), (e))
+
+/* Applies Keccak-f[1600] to 4 states, state[i][lane] is word i of the state of the lane */
+__attribute__((target("avx2")))
+static void keccak_permutation_x4_avx2(uint64_t state[25][4]) {
+	__m256i a[25], b[25], c[5], d[5];
+	for (int i = 0; i < 25; i++) {
+		a[i] = _mm256_loadu_si256((const __m256i*)state[i]);
+	}
+	for (int round = 0; round < 24; round++) {
+		/* theta */
+		c[0] = XOR5X4(a[0], a[5], a[10], a[15], a[20]);
+		c[1] = XOR5X4(a[1], a[6], a[11], a[16], a[21]);
+		c[2] = XOR5X4(a[2], a[7], a[12], a[17], a[22]);
+		c[3] = XOR5X4(a[3], a[8], a[13], a[18], a[23]);
+		c[4] = XOR5X4(a[4], a[9], a[14], a[19], a[24]);
+		d[0] = _mm256_xor_si256(c[4], ROTL64X4(c[1], 1));
+		d[1] = _mm256_xor_si256(c[0], ROTL64X4(c[2], 1));
+		d[2] = _mm256_xor_si256(c[1], ROTL64X4(c[3], 1));
+		d[3] = _mm256_xor_si256(c[2], ROTL64X4(c[4], 1));
+		d[4] = _mm256_xor_si256(c[3], ROTL64X4(c[0], 1));
+		a[ 0] = _mm256_xor_si256(a[ 0], d[0]);
+		a[ 1] = _mm256_xor_si256(a[ 1], d[1]);
+		a[ 2] = _mm256_xor_si256(a[ 2], d[2]);
+		a[ 3] = _mm256_xor_si256(a[ 3], d[3]);
+		a[ 4] = _mm256_xor_si256(a[ 4], d[4]);
+		a[ 5] = _mm256_xor_si256(a[ 5], d[0]);
+		a[ 6] = _mm256_xor_si256(a[ 6], d[1]);
+		a[ 7] = _mm256_xor_si256(a[ 7], d[2]);
+		a[ 8] = _mm256_xor_si256(a[ 8], d[3]);
+		a[ 9] = _mm256_xor_si256(a[ 9], d[4]);
+		a[10] = _mm256_xor_si256(a[10], d[0]);
+		a[11] = _mm256_xor_si256(a[11], d[1]);
+		a[12] = _mm256_xor_si256(a[12], d[2]);
+		a[13] = _mm256_xor_si256(a[13], d[3]);
+		a[14] = _mm256_xor_si256(a[14], d[4]);
+		a[15] = _mm256_xor_si256(a[15], d[0]);
+		a[16] = _mm256_xor_si256(a[16], d[1]);
+		a[17] = _mm256_xor_si256(a[17], d[2]);
+		a[18] = _mm256_xor_si256(a[18], d[3]);
+		a[19] = _mm256_xor_si256(a[19], d[4]);
+		a[20] = _mm256_xor_si256(a[20], d[0]);
+		a[21] = _mm256_xor_si256(a[21], d[1]);
+		a[22] = _mm256_xor_si256(a[22], d[2]);
+		a[23] = _mm256_xor_si256(a[23], d[3]);
+		a[24] = _mm256_xor_si256(a[24], d[4]);
+
+		/* rho and pi */
+		b[ 0] = a[ 0];
+		b[ 1] = ROTL64X4(a[ 6], 44);
+		b[ 2] = ROTL64X4(a[12], 43);
+		b[ 3] = ROTL64X4(a[18], 21);
+		b[ 4] = ROTL64X4(a[24], 14);
+		b[ 5] = ROTL64X4(a[ 3], 28);
+		b[ 6] = ROTL64X4(a[ 9], 20);
+		b[ 7] = ROTL64X4(a[10], 3);
+		b[ 8] = ROTL64X4(a[16], 45);
+		b[ 9] = ROTL64X4(a[22], 61);
+		b[10] = ROTL64X4(a[ 1], 1);
+		b[11] = ROTL64X4(a[ 7], 6);
+		b[12] = ROTL64X4(a[13], 25);
+		b[13] = ROTL64X4(a[19], 8);
+		b[14] = ROTL64X4(a[20], 18);
+		b[15] = ROTL64X4(a[ 4], 27);
+		b[16] = ROTL64X4(a[ 5], 36);
+		b[17] = ROTL64X4(a[11], 10);
+		b[18] = ROTL64X4(a[17], 15);
+		b[19] = ROTL64X4(a[23], 56);
+		b[20] = ROTL64X4(a[ 2], 62);
+		b[21] = ROTL64X4(a[ 8], 55);
+		b[22] = ROTL64X4(a[14], 39);
+		b[23] = ROTL64X4(a[15], 41);
+		b[24] = ROTL64X4(a[21], 2);
+
+		/* chi */
+		a[ 0] = _mm256_xor_si256(b[ 0], _mm256_andnot_si256(b[ 1], b[ 2]));
+		a[ 1] = _mm256_xor_si256(b[ 1], _mm256_andnot_si256(b[ 2], b[ 3]));
+		a[ 2] = _mm256_xor_si256(b[ 2], _mm256_andnot_si256(b[ 3], b[ 4]));
+		a[ 3] = _mm256_xor_si256(b[ 3], _mm256_andnot_si256(b[ 4], b[ 0]));
+		a[ 4] = _mm256_xor_si256(b[ 4], _mm256_andnot_si256(b[ 0], b[ 1]));
+		a[ 5] = _mm256_xor_si256(b[ 5], _mm256_andnot_si256(b[ 6], b[ 7]));
+		a[ 6] = _mm256_xor_si256(b[ 6], _mm256_andnot_si256(b[ 7], b[ 8]));
+		a[ 7] = _mm256_xor_si256(b[ 7], _mm256_andnot_si256(b[ 8], b[ 9]));
+		a[ 8] = _mm256_xor_si256(b[ 8], _mm256_andnot_si256(b[ 9], b[ 5]));
+		a[ 9] = _mm256_xor_si256(b[ 9], _mm256_andnot_si256(b[ 5], b[ 6]));
+		a[10] = _mm256_xor_si256(b[10], _mm256_andnot_si256(b[11], b[12]));
+		a[11] = _mm256_xor_si256(b[11], _mm256_andnot_si256(b[12], b[13]));
+		a[12] = _mm256_xor_si256(b[12], _mm256_andnot_si256(b[13], b[14]));
+		a[13] = _mm256_xor_si256(b[13], _mm256_andnot_si256(b[14], b[10]));
+		a[14] = _mm256_xor_si256(b[14], _mm256_andnot_si256(b[10], b[11]));
+		a[15] = _mm256_xor_si256(b[15], _mm256_andnot_si256(b[16], b[17]));
+		a[16] = _mm256_xor_si256(b[16], _mm256_andnot_si256(b[17], b[18]));
+		a[17] = _mm256_xor_si256(b[17], _mm256_andnot_si256(b[18], b[19]));
+		a[18] = _mm256_xor_si256(b[18], _mm256_andnot_si256(b[19], b[15]));
+		a[19] = _mm256_xor_si256(b[19], _mm256_andnot_si256(b[15], b[16]));
+		a[20] = _mm256_xor_si256(b[20], _mm256_andnot_si256(b[21], b[22]));
+		a[21] = _mm256_xor_si256(b[21], _mm256_andnot_si256(b[22], b[23]));
+		a[22] = _mm256_xor_si256(b[22], _mm256_andnot_si256(b[23], b[24]));
+		a[23] = _mm256_xor_si256(b[23], _mm256_andnot_si256(b[24], b[20]));
+		a[24] = _mm256_xor_si256(b[24], _mm256_andnot_si256(b[20], b[21]));
+
+		/* iota */
+		a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x((long long)keccak_round_constants[round]));
+	}
+	for (int i = 0; i < 25; i++) {
+		_mm256_storeu_si256((__m256i*)state[i], a[i]);
+	}
+}
+
+/* Number of absorbed blocks of a message of `len` bytes, including the padding */
+static size_t keccak_256_block_count(size_t len) {
+	return len / KECCAK_256_RATE + 1;
+}
+
+/* Absorbs block `index` of the padded message into the state of the lane */
+static void keccak_256_absorb_lane(const uint8_t* data, size_t len, size_t index, uint64_t state[25][4], int lane) {
+	uint8_t padded[KECCAK_256_RATE];
+	const size_t offset = index * KECCAK_256_RATE;
+	const uint8_t* block = data + offset;
+	if (offset + KECCAK_256_RATE > len) {
+		memset(padded, 0, KECCAK_256_RATE);
+		if (len > offset) {
+			memcpy(padded, block, len - offset);
+		}
+		padded[len - offset] |= 0x01;
+		padded[KECCAK_256_RATE - 1] |= 0x80;
+		block = padded;
+	}
+	/* x86 is little-endian, like the Keccak lanes */
+	for (int i = 0; i < KECCAK_256_RATE_WORDS; i++) {
+		uint64_t word = 0;
+		memcpy(&word, block + 8 * i, sizeof(word));
+		state[i][lane] ^= word;
+	}
+	if (block == padded) {
+		memzero(padded, sizeof(padded));
+	}
+}
+
+static void keccak_256_batch_avx2(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests) {
+	uint64_t state[25][4];
+	size_t message[4] = {0};
+	size_t block[4] = {0};
+	int active[4] = {0};
+	size_t next = 0;
+	int remaining = 0;
+
+	memset(state, 0, sizeof(state));
+	for (int lane = 0; lane < 4 && next < count; lane++, next++) {
+		message[lane] = next;
+		active[lane] = 1;
+		remaining++;
+	}
+
+	while (remaining > 0) {
+		/* Idle lanes keep permuting leftover states, their results are ignored */
+		for (int lane = 0; lane < 4; lane++) {
+			if (active[lane]) {
+				keccak_256_absorb_lane(data[message[lane]], len[message[lane]], block[lane], state, lane);
+			}
+		}
+		keccak_permutation_x4_avx2(state);
+		for (int lane = 0; lane < 4; lane++) {
+			if (!active[lane] || ++block[lane] < keccak_256_block_count(len[message[lane]])) {
+				continue;
+			}
+			uint8_t* digest = digests + message[lane] * KECCAK_256_DIGEST;
+			for (int i = 0; i < KECCAK_256_DIGEST / 8; i++) {
+				memcpy(digest + 8 * i, &state[i][lane], sizeof(uint64_t));
+			}
+			for (int i = 0; i < 25; i++) {
+				state[i][lane] = 0;
+			}
+			block[lane] = 0;
+			if (next < count) {
+				message[lane] = next++;
+			} else {
+				active[lane] = 0;
+				remaining--;
+			}
+		}
+	}
+	memzero(state, sizeof(state));
+}
+
+static int keccak_x4_avx2_supported(void) {
+	/* may be detected from several threads at once */
+	static int supported = -1;
+	int result = __atomic_load_n(&supported, __ATOMIC_RELAXED);
+	if (result < 0) {
+		__builtin_cpu_init();
+		result = __builtin_cpu_supports("avx2") ? 1 : 0;
+		__atomic_store_n(&supported, result, __ATOMIC_RELAXED);
+	}
+	return result;
+}
+
+#endif
+
+void keccak_256_x4(const uint8_t* const data[4], const size_t len[4], uint8_t* digests) {
+	keccak_256_batch(data, len, 4, digests);
+}
+
+void keccak_256_batch(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests) {
+#ifdef KECCAK_X4_AVX2
+	if (count > 1 && keccak_x4_avx2_supported()) {
+		keccak_256_batch_avx2(data, len, count, digests);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < count; i++) {
+		keccak_256(data[i], len[i], digests + i * KECCAK_256_DIGEST);
+	}
+}
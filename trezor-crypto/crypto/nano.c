@@ -26,7 +26,7 @@
 
 #include <string.h>
 
-const char *BASE32_ALPHABET_NANO = "13456789abcdefghijkmnopqrstuwxyz";
+const char *const BASE32_ALPHABET_NANO = "13456789abcdefghijkmnopqrstuwxyz";
 
 #define NANO_ADDRESS_BASE_LENGTH 60
 #define NANO_CHECKSUM_LEN 5
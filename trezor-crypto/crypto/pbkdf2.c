@@ -25,7 +25,17 @@
 #include <string.h>
 #include <TrezorCrypto/hmac.h>
 #include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/options.h>
 #include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha2_hw.h>
+
+// [wallet-core] multi-buffer PBKDF2-HMAC-SHA512, see pbkdf2_hmac_sha512_Update_batch
+#if USE_SHA256_HW && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PBKDF2_SHA512_X86 1
+#include <immintrin.h>
+
+extern const uint64_t K512[80];
+#endif
 
 void pbkdf2_hmac_sha256_Init(PBKDF2_HMAC_SHA256_CTX *pctx, const uint8_t *pass,
                              int passlen, const uint8_t *salt, int saltlen,
@@ -177,3 +187,269 @@ void pbkdf2_hmac_sha512(const uint8_t *pass, int passlen, const uint8_t *salt,
     }
   }
 }
+
+// [wallet-core] Multi-buffer PBKDF2-HMAC-SHA512.
+//
+// The iterations of independent contexts are computed together, one context per
+// 64-bit vector lane: 4 with AVX2, 8 with AVX-512. The contexts are transposed
+// once, every iteration is then two compressions of the lanes.
+
+#ifdef PBKDF2_SHA512_X86
+
+#define ROTR64X4(x, n) _mm256_or_si256(_mm256_srli_epi64((x), (n)), _mm256_slli_epi64((x), 64 - (n)))
+#define XOR3X4(a, b, c) _mm256_xor_si256(_mm256_xor_si256((a), (b)), (c))
+
+/* Compresses the 16-word blocks `data` with the states `in` into `out`, which may alias `data` */
+__attribute__((target("avx2")))
+static inline void sha512_Transform_x4_avx2(const __m256i in[8], const __m256i data[16], __m256i out[8]) {
+  __m256i w[16];
+  __m256i a = in[0], b = in[1], c = in[2], d = in[3];
+  __m256i e = in[4], f = in[5], g = in[6], h = in[7];
+
+  for (int j = 0; j < 80; j++) {
+    __m256i wj;
+    if (j < 16) {
+      wj = data[j];
+    } else {
+      const __m256i w15 = w[(j + 1) & 0x0f];
+      const __m256i w2 = w[(j + 14) & 0x0f];
+      const __m256i s0 = XOR3X4(ROTR64X4(w15, 1), ROTR64X4(w15, 8), _mm256_srli_epi64(w15, 7));
+      const __m256i s1 = XOR3X4(ROTR64X4(w2, 19), ROTR64X4(w2, 61), _mm256_srli_epi64(w2, 6));
+      wj = _mm256_add_epi64(_mm256_add_epi64(w[j & 0x0f], s0), _mm256_add_epi64(w[(j + 9) & 0x0f], s1));
+    }
+    w[j & 0x0f] = wj;
+
+    const __m256i sigma1 = XOR3X4(ROTR64X4(e, 14), ROTR64X4(e, 18), ROTR64X4(e, 41));
+    const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+    const __m256i t1 = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(h, sigma1), _mm256_add_epi64(ch, wj)),
+                                        _mm256_set1_epi64x((long long)K512[j]));
+    const __m256i sigma0 = XOR3X4(ROTR64X4(a, 28), ROTR64X4(a, 34), ROTR64X4(a, 39));
+    const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+    h = g;
+    g = f;
+    f = e;
+    e = _mm256_add_epi64(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm256_add_epi64(t1, _mm256_add_epi64(sigma0, maj));
+  }
+
+  out[0] = _mm256_add_epi64(a, in[0]);
+  out[1] = _mm256_add_epi64(b, in[1]);
+  out[2] = _mm256_add_epi64(c, in[2]);
+  out[3] = _mm256_add_epi64(d, in[3]);
+  out[4] = _mm256_add_epi64(e, in[4]);
+  out[5] = _mm256_add_epi64(f, in[5]);
+  out[6] = _mm256_add_epi64(g, in[6]);
+  out[7] = _mm256_add_epi64(h, in[7]);
+}
+
+/* Runs the remaining iterations of 4 contexts initialized together */
+__attribute__((target("avx2")))
+static void pbkdf2_hmac_sha512_Update_x4_avx2(PBKDF2_HMAC_SHA512_CTX *pctx, uint32_t iterations) {
+  __m256i idig[8], odig[8], f[8], g[16];
+  uint64_t lanes[4];
+
+  for (int j = 0; j < 8; j++) {
+    idig[j] = _mm256_set_epi64x((long long)pctx[3].idig[j], (long long)pctx[2].idig[j],
+                                (long long)pctx[1].idig[j], (long long)pctx[0].idig[j]);
+    odig[j] = _mm256_set_epi64x((long long)pctx[3].odig[j], (long long)pctx[2].odig[j],
+                                (long long)pctx[1].odig[j], (long long)pctx[0].odig[j]);
+    f[j] = _mm256_set_epi64x((long long)pctx[3].f[j], (long long)pctx[2].f[j],
+                             (long long)pctx[1].f[j], (long long)pctx[0].f[j]);
+  }
+  for (int j = 0; j < 16; j++) {
+    g[j] = _mm256_set_epi64x((long long)pctx[3].g[j], (long long)pctx[2].g[j],
+                             (long long)pctx[1].g[j], (long long)pctx[0].g[j]);
+  }
+
+  for (uint32_t i = pctx[0].first; i < iterations; i++) {
+    sha512_Transform_x4_avx2(idig, g, g);
+    sha512_Transform_x4_avx2(odig, g, g);
+    for (int j = 0; j < 8; j++) {
+      f[j] = _mm256_xor_si256(f[j], g[j]);
+    }
+  }
+
+  for (int j = 0; j < 8; j++) {
+    _mm256_storeu_si256((__m256i *)lanes, f[j]);
+    for (int lane = 0; lane < 4; lane++) {
+      pctx[lane].f[j] = lanes[lane];
+    }
+    _mm256_storeu_si256((__m256i *)lanes, g[j]);
+    for (int lane = 0; lane < 4; lane++) {
+      pctx[lane].g[j] = lanes[lane];
+    }
+  }
+  for (int lane = 0; lane < 4; lane++) {
+    pctx[lane].first = 0;
+  }
+  memzero(idig, sizeof(idig));
+  memzero(odig, sizeof(odig));
+  memzero(f, sizeof(f));
+  memzero(g, sizeof(g));
+  memzero(lanes, sizeof(lanes));
+}
+
+#define XOR3X8(a, b, c) _mm512_ternarylogic_epi64((a), (b), (c), 0x96)
+
+__attribute__((target("avx512f")))
+static inline void sha512_Transform_x8_avx512(const __m512i in[8], const __m512i data[16], __m512i out[8]) {
+  __m512i w[16];
+  __m512i a = in[0], b = in[1], c = in[2], d = in[3];
+  __m512i e = in[4], f = in[5], g = in[6], h = in[7];
+
+  for (int j = 0; j < 80; j++) {
+    __m512i wj;
+    if (j < 16) {
+      wj = data[j];
+    } else {
+      const __m512i w15 = w[(j + 1) & 0x0f];
+      const __m512i w2 = w[(j + 14) & 0x0f];
+      const __m512i s0 = XOR3X8(_mm512_ror_epi64(w15, 1), _mm512_ror_epi64(w15, 8), _mm512_srli_epi64(w15, 7));
+      const __m512i s1 = XOR3X8(_mm512_ror_epi64(w2, 19), _mm512_ror_epi64(w2, 61), _mm512_srli_epi64(w2, 6));
+      wj = _mm512_add_epi64(_mm512_add_epi64(w[j & 0x0f], s0), _mm512_add_epi64(w[(j + 9) & 0x0f], s1));
+    }
+    w[j & 0x0f] = wj;
+
+    const __m512i sigma1 = XOR3X8(_mm512_ror_epi64(e, 14), _mm512_ror_epi64(e, 18), _mm512_ror_epi64(e, 41));
+    /* ch = (e & f) ^ (~e & g), maj = majority of a, b, c */
+    const __m512i ch = _mm512_ternarylogic_epi64(e, f, g, 0xca);
+    const __m512i t1 = _mm512_add_epi64(_mm512_add_epi64(_mm512_add_epi64(h, sigma1), _mm512_add_epi64(ch, wj)),
+                                        _mm512_set1_epi64((long long)K512[j]));
+    const __m512i sigma0 = XOR3X8(_mm512_ror_epi64(a, 28), _mm512_ror_epi64(a, 34), _mm512_ror_epi64(a, 39));
+    const __m512i maj = _mm512_ternarylogic_epi64(a, b, c, 0xe8);
+    h = g;
+    g = f;
+    f = e;
+    e = _mm512_add_epi64(d, t1);
+    d = c;
+    c = b;
+    b = a;
+    a = _mm512_add_epi64(t1, _mm512_add_epi64(sigma0, maj));
+  }
+
+  out[0] = _mm512_add_epi64(a, in[0]);
+  out[1] = _mm512_add_epi64(b, in[1]);
+  out[2] = _mm512_add_epi64(c, in[2]);
+  out[3] = _mm512_add_epi64(d, in[3]);
+  out[4] = _mm512_add_epi64(e, in[4]);
+  out[5] = _mm512_add_epi64(f, in[5]);
+  out[6] = _mm512_add_epi64(g, in[6]);
+  out[7] = _mm512_add_epi64(h, in[7]);
+}
+
+/* Runs the remaining iterations of 8 contexts initialized together */
+__attribute__((target("avx512f")))
+static void pbkdf2_hmac_sha512_Update_x8_avx512(PBKDF2_HMAC_SHA512_CTX *pctx, uint32_t iterations) {
+  __m512i idig[8], odig[8], f[8], g[16];
+  uint64_t lanes[8];
+
+  for (int j = 0; j < 16; j++) {
+    for (int lane = 0; lane < 8; lane++) {
+      lanes[lane] = pctx[lane].g[j];
+    }
+    g[j] = _mm512_loadu_si512(lanes);
+    if (j >= 8) {
+      continue;
+    }
+    for (int lane = 0; lane < 8; lane++) {
+      lanes[lane] = pctx[lane].idig[j];
+    }
+    idig[j] = _mm512_loadu_si512(lanes);
+    for (int lane = 0; lane < 8; lane++) {
+      lanes[lane] = pctx[lane].odig[j];
+    }
+    odig[j] = _mm512_loadu_si512(lanes);
+    for (int lane = 0; lane < 8; lane++) {
+      lanes[lane] = pctx[lane].f[j];
+    }
+    f[j] = _mm512_loadu_si512(lanes);
+  }
+
+  for (uint32_t i = pctx[0].first; i < iterations; i++) {
+    sha512_Transform_x8_avx512(idig, g, g);
+    sha512_Transform_x8_avx512(odig, g, g);
+    for (int j = 0; j < 8; j++) {
+      f[j] = _mm512_xor_si512(f[j], g[j]);
+    }
+  }
+
+  for (int j = 0; j < 8; j++) {
+    _mm512_storeu_si512(lanes, f[j]);
+    for (int lane = 0; lane < 8; lane++) {
+      pctx[lane].f[j] = lanes[lane];
+    }
+    _mm512_storeu_si512(lanes, g[j]);
+    for (int lane = 0; lane < 8; lane++) {
+      pctx[lane].g[j] = lanes[lane];
+    }
+  }
+  for (int lane = 0; lane < 8; lane++) {
+    pctx[lane].first = 0;
+  }
+  memzero(idig, sizeof(idig));
+  memzero(odig, sizeof(odig));
+  memzero(f, sizeof(f));
+  memzero(g, sizeof(g));
+  memzero(lanes, sizeof(lanes));
+}
+
+#endif
+
+size_t pbkdf2_hmac_sha512_batch_lanes(void) {
+#ifdef PBKDF2_SHA512_X86
+  const unsigned features = sha256_hw_selected();
+  if (features & SHA512_HW_AVX512) {
+    return 8;
+  }
+  if (features & SHA512_HW_AVX2) {
+    return 4;
+  }
+#endif
+  return 1;
+}
+
+void pbkdf2_hmac_sha512_Update_batch(PBKDF2_HMAC_SHA512_CTX *pctx, size_t count,
+                                     uint32_t iterations) {
+  size_t i = 0;
+#ifdef PBKDF2_SHA512_X86
+  const size_t lanes = pbkdf2_hmac_sha512_batch_lanes();
+  /* the iterations of a group start together */
+  for (; lanes > 1 && i + lanes <= count; i += lanes) {
+    int aligned = 1;
+    for (size_t lane = 1; lane < lanes; lane++) {
+      aligned &= pctx[i + lane].first == pctx[i].first;
+    }
+    if (!aligned) {
+      break;
+    }
+    if (lanes == 8) {
+      pbkdf2_hmac_sha512_Update_x8_avx512(pctx + i, iterations);
+    } else {
+      pbkdf2_hmac_sha512_Update_x4_avx2(pctx + i, iterations);
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    pbkdf2_hmac_sha512_Update(pctx + i, iterations);
+  }
+}
+
+void pbkdf2_hmac_sha512_batch(const uint8_t *const *pass, const int *passlen,
+                              const uint8_t *const *salt, const int *saltlen,
+                              uint32_t iterations, uint8_t *keys, size_t count) {
+  PBKDF2_HMAC_SHA512_CTX pctx[8];
+  for (size_t start = 0; start < count; start += 8) {
+    const size_t group = count - start < 8 ? count - start : 8;
+    for (size_t i = 0; i < group; i++) {
+      pbkdf2_hmac_sha512_Init(&pctx[i], pass[start + i], passlen[start + i],
+                              salt[start + i], saltlen[start + i], 1);
+    }
+    pbkdf2_hmac_sha512_Update_batch(pctx, group, iterations);
+    for (size_t i = 0; i < group; i++) {
+      pbkdf2_hmac_sha512_Final(&pctx[i], keys + (start + i) * SHA512_DIGEST_LENGTH);
+    }
+  }
+}
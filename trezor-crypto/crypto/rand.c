@@ -23,35 +23,164 @@
 
 #include <TrezorCrypto/rand.h>
 
+#include <TrezorCrypto/chacha20poly1305/ecrypt-sync.h>
+#include <TrezorCrypto/memzero.h>
+
+#include <errno.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
-// [wallet-core]
-uint32_t __attribute__((weak)) random32() {
-    int randomData = open("/dev/urandom", O_RDONLY);
-    if (randomData < 0) {
-        return 0;
+// [wallet-core] random_buffer is a ChaCha20 generator per thread, seeded from
+// the entropy source, so that small requests do not each cost a system call.
+// Each refill rekeys from its own keystream (fast key erasure): bytes already
+// returned cannot be recomputed from the state. Generators reseed after
+// RANDOM_RESEED_INTERVAL bytes, in a forked child, after random_reseed, and
+// when the source changes.
+
+#define RANDOM_KEY_LENGTH 32
+// Keystream generated at once, starting with the next key
+#define RANDOM_BLOCK_LENGTH 512
+#define RANDOM_RESEED_INTERVAL (1 << 20)
+
+typedef struct {
+  uint8_t key[RANDOM_KEY_LENGTH];
+  uint8_t block[RANDOM_BLOCK_LENGTH];
+  // unused bytes, at the end of block
+  size_t available;
+  // bytes returned since seeded
+  size_t output;
+  // random_generation the generator was seeded at, 0 if not seeded
+  unsigned generation;
+} random_state;
+
+static _Thread_local random_state random_thread_state;
+
+// Incremented to reseed all generators: at fork, random_reseed, source change
+static unsigned random_generation = 1;
+
+static pthread_mutex_t random_source_mutex = PTHREAD_MUTEX_INITIALIZER;
+static random_source_function random_source = 0;
+static void *random_source_context = 0;
+static pthread_once_t random_fork_once = PTHREAD_ONCE_INIT;
+
+#define RANDOM_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define RANDOM_INCREMENT(p) __atomic_add_fetch((p), 1, __ATOMIC_ACQ_REL)
+
+void __attribute__((weak)) random_entropy(uint8_t *buf, size_t len) {
+  int randomData = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+  if (randomData < 0) {
+    abort();
+  }
+  while (len > 0) {
+    ssize_t n = read(randomData, buf, len);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      // no entropy: failing is safer than returning predictable keys
+      abort();
     }
+    buf += n;
+    len -= (size_t)n;
+  }
+  close(randomData);
+}
+
+static void random_fork_prepare(void) {
+  pthread_mutex_lock(&random_source_mutex);
+}
+
+static void random_fork_parent(void) {
+  pthread_mutex_unlock(&random_source_mutex);
+}
+
+static void random_fork_child(void) {
+  pthread_mutex_unlock(&random_source_mutex);
+  // the child must not repeat the bytes of its parent
+  memzero(&random_thread_state, sizeof(random_thread_state));
+  RANDOM_INCREMENT(&random_generation);
+}
 
-    uint32_t result;
-    if (read(randomData, &result, sizeof(result)) < 0) {
-        return 0;
+static void random_register_fork(void) {
+#ifndef __EMSCRIPTEN__
+  pthread_atfork(random_fork_prepare, random_fork_parent, random_fork_child);
+#endif
+}
+
+static void random_seed(random_state *state, unsigned generation) {
+  pthread_once(&random_fork_once, random_register_fork);
+
+  uint8_t seed[RANDOM_KEY_LENGTH] = {0};
+  pthread_mutex_lock(&random_source_mutex);
+  if (random_source) {
+    if (random_source(random_source_context, seed, sizeof(seed)) != 0) {
+      abort();
     }
+  } else {
+    random_entropy(seed, sizeof(seed));
+  }
+  pthread_mutex_unlock(&random_source_mutex);
 
-    close(randomData);
+  memcpy(state->key, seed, sizeof(state->key));
+  memzero(seed, sizeof(seed));
+  memzero(state->block, sizeof(state->block));
+  state->available = 0;
+  state->output = 0;
+  state->generation = generation;
+}
 
-    return result;
+static void random_refill(random_state *state) {
+  static const uint8_t iv[8] = {0};
+  ECRYPT_ctx ctx;
+  // keys are used once, the nonce can be constant
+  ECRYPT_keysetup(&ctx, state->key, RANDOM_KEY_LENGTH * 8, 64);
+  ECRYPT_ivsetup(&ctx, iv);
+  ECRYPT_keystream_bytes(&ctx, state->block, RANDOM_BLOCK_LENGTH);
+  memcpy(state->key, state->block, RANDOM_KEY_LENGTH);
+  memzero(state->block, RANDOM_KEY_LENGTH);
+  memzero(&ctx, sizeof(ctx));
+  state->available = RANDOM_BLOCK_LENGTH - RANDOM_KEY_LENGTH;
 }
 
 void __attribute__((weak)) random_buffer(uint8_t *buf, size_t len) {
-    int randomData = open("/dev/urandom", O_RDONLY);
-    if (randomData < 0) {
-        return;
+  random_state *state = &random_thread_state;
+  const unsigned generation = RANDOM_LOAD(&random_generation);
+  if (state->generation != generation ||
+      state->output >= RANDOM_RESEED_INTERVAL) {
+    random_seed(state, generation);
+  }
+  while (len > 0) {
+    if (state->available == 0) {
+      random_refill(state);
     }
-    if (read(randomData, buf, len) < 0) {
-        return;
-    }
-    close(randomData);
+    size_t n = len < state->available ? len : state->available;
+    uint8_t *chunk = state->block + RANDOM_BLOCK_LENGTH - state->available;
+    memcpy(buf, chunk, n);
+    // wiped once returned
+    memzero(chunk, n);
+    buf += n;
+    len -= n;
+    state->available -= n;
+    state->output += n;
+  }
+}
+
+uint32_t __attribute__((weak)) random32(void) {
+  uint32_t result = 0;
+  random_buffer((uint8_t *)&result, sizeof(result));
+  return result;
 }
+
+void random_set_source(random_source_function source, void *context) {
+  pthread_mutex_lock(&random_source_mutex);
+  random_source = source;
+  random_source_context = context;
+  pthread_mutex_unlock(&random_source_mutex);
+  random_reseed();
+}
+
+void random_reseed(void) { RANDOM_INCREMENT(&random_generation); }
@@ -31,6 +31,16 @@ void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash,
   hmac_drbg_init(state, priv_key, 32, hash, 32);
 }
 
+void init_rfc6979_key(const uint8_t *priv_key, rfc6979_key_state *key_state) {
+  hmac_drbg_init_prefix(key_state, priv_key);
+}
+
+void init_rfc6979_with_key(const rfc6979_key_state *key_state,
+                           const uint8_t *priv_key, const uint8_t *hash,
+                           rfc6979_state *state) {
+  hmac_drbg_init_with_prefix(state, key_state, priv_key, 32, hash, 32);
+}
+
 // generate next number from deterministic random number generator
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *state) {
   hmac_drbg_generate(state, rnd, 32);
@@ -21,13 +21,11 @@
  */
 
 #include <TrezorCrypto/schnorr.h>
+#include <TrezorCrypto/memzero.h>
 
-// r = H(Q, kpub, m)
-static void calc_r(const curve_point *Q, const uint8_t pub_key[33],
-                   const uint8_t *msg, const uint32_t msg_len, bignum256 *r) {
-  uint8_t Q_compress[33];
-  compress_coords(Q, Q_compress);
-
+// [wallet-core] r = H(Q, kpub, m), with Q compressed
+static void calc_r_compressed(const uint8_t Q_compress[33], const uint8_t pub_key[33],
+                              const uint8_t *msg, const uint32_t msg_len, bignum256 *r) {
   SHA256_CTX ctx;
   uint8_t digest[SHA256_DIGEST_LENGTH];
   sha256_Init(&ctx);
@@ -40,25 +38,49 @@ static void calc_r(const curve_point *Q, const uint8_t pub_key[33],
   bn_read_be(digest, r);
 }
 
+// r = H(Q, kpub, m)
+static void calc_r(const curve_point *Q, const uint8_t pub_key[33],
+                   const uint8_t *msg, const uint32_t msg_len, bignum256 *r) {
+  uint8_t Q_compress[33];
+  compress_coords(Q, Q_compress);
+  calc_r_compressed(Q_compress, pub_key, msg, msg_len, r);
+}
+
 // Returns 0 if signing succeeded
 int schnorr_sign(const ecdsa_curve *curve, const uint8_t *priv_key,
                  const bignum256 *k, const uint8_t *msg, const uint32_t msg_len,
                  schnorr_sign_pair *result) {
   uint8_t pub_key[33];
+  uint8_t Q_compress[33];
   curve_point Q;
+
+  ecdsa_get_public_key33(curve, priv_key, pub_key);
+
+  // Compute commitment Q = kG
+  // [wallet-core] fixed-base multiplication, using the precomputed tables of G
+  scalar_multiply(curve, k, &Q);
+  compress_coords(&Q, Q_compress);
+
+  int res = schnorr_sign_with_commitment(curve, priv_key, pub_key, k, Q_compress, msg, msg_len, result);
+  memzero(&Q, sizeof(Q));
+  memzero(Q_compress, sizeof(Q_compress));
+  return res;
+}
+
+// [wallet-core]
+int schnorr_sign_with_commitment(const ecdsa_curve *curve, const uint8_t *priv_key,
+                                 const uint8_t pub_key[33], const bignum256 *k,
+                                 const uint8_t Q_compress[33], const uint8_t *msg,
+                                 const uint32_t msg_len, schnorr_sign_pair *result) {
   bignum256 private_key_scalar;
   bignum256 r_temp;
   bignum256 s_temp;
   bignum256 r_kpriv_result;
 
   bn_read_be(priv_key, &private_key_scalar);
-  ecdsa_get_public_key33(curve, priv_key, pub_key);
-
-  // Compute commitment Q = kG
-  point_multiply(curve, k, &curve->G, &Q);
 
   // Compute challenge r = H(Q, kpub, m)
-  calc_r(&Q, pub_key, msg, msg_len, &r_temp);
+  calc_r_compressed(Q_compress, pub_key, msg, msg_len, &r_temp);
   
   // Fully reduce the bignum
   bn_mod(&r_temp, &curve->order);
@@ -84,9 +106,11 @@ int schnorr_sign(const ecdsa_curve *curve, const uint8_t *priv_key,
   // Convert the normalized, fully reduced bignum to a raw bigendian 256 bit value
   bn_write_be(&s_temp, result->s);
 
-  if (bn_is_zero(&r_temp) || bn_is_zero(&s_temp)) return 1;
-
-  return 0;
+  int res = (bn_is_zero(&r_temp) || bn_is_zero(&s_temp)) ? 1 : 0;
+  memzero(&private_key_scalar, sizeof(private_key_scalar));
+  memzero(&r_kpriv_result, sizeof(r_kpriv_result));
+  memzero(&s_temp, sizeof(s_temp));
+  return res;
 }
 
 // Returns 0 if verification succeeded
@@ -42,12 +42,22 @@
 #include <stdlib.h>
 #include <string.h>
 
+// [wallet-core]
+#if defined(__SSE2__) || defined(__ARM_NEON)
+#define SCRYPT_SIMD 1
+#endif
+
+// [wallet-core] smix polls the cancellation callback once per 1024 iterations
+#define CANCEL_CHECK(i) (cancelled != NULL && ((i) & 1023) == 0 && cancelled(context))
+
 static void blkcpy(void *, void *, size_t);
+#ifndef SCRYPT_SIMD
 static void blkxor(void *, void *, size_t);
 static void salsa20_8(uint32_t[16]);
 static void blockmix_salsa8(uint32_t *, uint32_t *, uint32_t *, size_t);
 static uint64_t integerify(void *, size_t);
-static void smix(uint8_t *, size_t, uint64_t, uint32_t *, uint32_t *);
+static int smix(uint8_t *, size_t, uint64_t, uint32_t *, uint32_t *, int (*)(void *), void *);
+#endif
 
 static void
 blkcpy(void * dest, void * src, size_t len)
@@ -61,6 +71,7 @@ blkcpy(void * dest, void * src, size_t len)
 		D[i] = S[i];
 }
 
+#ifndef SCRYPT_SIMD
 static void
 blkxor(void * dest, void * src, size_t len)
 {
@@ -164,15 +175,17 @@ integerify(void * B, size_t r)
 }
 
 /**
- * smix(B, r, N, V, XY):
+ * smix(B, r, N, V, XY, cancelled, context):
  * Compute B = SMix_r(B, N).  The input B must be 128r bytes in length;
  * the temporary storage V must be 128rN bytes in length; the temporary
  * storage XY must be 256r + 64 bytes in length.  The value N must be a
  * power of 2 greater than 1.  The arrays B, V, and XY must be aligned to a
- * multiple of 64 bytes.
+ * multiple of 64 bytes.  If cancelled is not NULL it is polled with context,
+ * and -1 is returned (B unchanged) as soon as it returns nonzero; 0 otherwise.
  */
-static void
-smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
+static int
+smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY,
+    int (*cancelled)(void *), void * context)
 {
 	uint32_t * X = XY;
 	uint32_t * Y = &XY[32 * r];
@@ -187,6 +200,9 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 
 	/* 2: for i = 0 to N - 1 do */
 	for (i = 0; i < N; i += 2) {
+		if (CANCEL_CHECK(i))
+			return -1;
+
 		/* 3: V_i <-- X */
 		blkcpy(&V[i * (32 * r)], X, 128 * r);
 
@@ -202,6 +218,9 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 
 	/* 6: for i = 0 to N - 1 do */
 	for (i = 0; i < N; i += 2) {
+		if (CANCEL_CHECK(i))
+			return -1;
+
 		/* 7: j <-- Integerify(X) mod N */
 		j = integerify(X, r) & (N - 1);
 
@@ -220,6 +239,211 @@ smix(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY)
 	/* 10: B' <-- X */
 	for (k = 0; k < 32 * r; k++)
 		le32enc(&B[4 * k], X[k]);
+	return 0;
+}
+#endif
+
+// [wallet-core] Vectorized Salsa20/8 core.
+//
+// The words of each 64-byte block are kept in the order in which the four
+// vectors hold the diagonals of the Salsa20 matrix, so that the column and
+// row rounds only rotate lanes. Blocks are permuted when loaded into and
+// stored from X, and V holds permuted blocks.
+#ifdef SCRYPT_SIMD
+#if defined(__SSE2__)
+#include <emmintrin.h>
+typedef __m128i simd_t;
+#define SIMD_LOAD(p) _mm_load_si128((const __m128i *)(const void *)(p))
+#define SIMD_STORE(p, v) _mm_store_si128((__m128i *)(void *)(p), (v))
+#define SIMD_ADD(a, b) _mm_add_epi32((a), (b))
+#define SIMD_XOR(a, b) _mm_xor_si128((a), (b))
+#define SIMD_ROTL(a, n) _mm_or_si128(_mm_slli_epi32((a), (n)), _mm_srli_epi32((a), 32 - (n)))
+#define SIMD_LANES1(a) _mm_shuffle_epi32((a), 0x39)
+#define SIMD_LANES2(a) _mm_shuffle_epi32((a), 0x4E)
+#define SIMD_LANES3(a) _mm_shuffle_epi32((a), 0x93)
+#else
+#include <arm_neon.h>
+typedef uint32x4_t simd_t;
+#define SIMD_LOAD(p) vld1q_u32(p)
+#define SIMD_STORE(p, v) vst1q_u32((p), (v))
+#define SIMD_ADD(a, b) vaddq_u32((a), (b))
+#define SIMD_XOR(a, b) veorq_u32((a), (b))
+#define SIMD_ROTL(a, n) vsriq_n_u32(vshlq_n_u32((a), (n)), (a), 32 - (n))
+#define SIMD_LANES1(a) vextq_u32((a), (a), 1)
+#define SIMD_LANES2(a) vextq_u32((a), (a), 2)
+#define SIMD_LANES3(a) vextq_u32((a), (a), 3)
+#endif
+
+#define SALSA_QUARTER(a, b, c, d) \
+	do { \
+		b = SIMD_XOR(b, SIMD_ROTL(SIMD_ADD(a, d), 7)); \
+		c = SIMD_XOR(c, SIMD_ROTL(SIMD_ADD(b, a), 9)); \
+		d = SIMD_XOR(d, SIMD_ROTL(SIMD_ADD(c, b), 13)); \
+		a = SIMD_XOR(a, SIMD_ROTL(SIMD_ADD(d, c), 18)); \
+	} while (0)
+
+/**
+ * blockmix_salsa8_simd(Bin, Bout, r):
+ * Compute Bout = BlockMix_{salsa20/8, r}(Bin) on permuted blocks.  The
+ * arrays must be 128r bytes in length and aligned to 16 bytes.
+ */
+static void
+blockmix_salsa8_simd(const uint32_t * Bin, uint32_t * Bout, size_t r)
+{
+	simd_t X0, X1, X2, X3, Y0, Y1, Y2, Y3;
+	size_t i;
+	int round;
+
+	/* 1: X <-- B_{2r - 1} */
+	X0 = SIMD_LOAD(&Bin[(2 * r - 1) * 16]);
+	X1 = SIMD_LOAD(&Bin[(2 * r - 1) * 16 + 4]);
+	X2 = SIMD_LOAD(&Bin[(2 * r - 1) * 16 + 8]);
+	X3 = SIMD_LOAD(&Bin[(2 * r - 1) * 16 + 12]);
+
+	/* 2: for i = 0 to 2r - 1 do */
+	for (i = 0; i < 2 * r; i++) {
+		uint32_t * out = &Bout[((i & 1) * r + i / 2) * 16];
+
+		/* 3: X <-- H(X \xor B_i) */
+		X0 = SIMD_XOR(X0, SIMD_LOAD(&Bin[i * 16]));
+		X1 = SIMD_XOR(X1, SIMD_LOAD(&Bin[i * 16 + 4]));
+		X2 = SIMD_XOR(X2, SIMD_LOAD(&Bin[i * 16 + 8]));
+		X3 = SIMD_XOR(X3, SIMD_LOAD(&Bin[i * 16 + 12]));
+		Y0 = X0; Y1 = X1; Y2 = X2; Y3 = X3;
+		for (round = 0; round < 8; round += 2) {
+			/* Operate on columns. */
+			SALSA_QUARTER(Y0, Y1, Y2, Y3);
+			Y1 = SIMD_LANES3(Y1);
+			Y2 = SIMD_LANES2(Y2);
+			Y3 = SIMD_LANES1(Y3);
+			/* Operate on rows. */
+			SALSA_QUARTER(Y0, Y3, Y2, Y1);
+			Y1 = SIMD_LANES1(Y1);
+			Y2 = SIMD_LANES2(Y2);
+			Y3 = SIMD_LANES3(Y3);
+		}
+		X0 = SIMD_ADD(X0, Y0);
+		X1 = SIMD_ADD(X1, Y1);
+		X2 = SIMD_ADD(X2, Y2);
+		X3 = SIMD_ADD(X3, Y3);
+
+		/* 4: Y_i <-- X */
+		/* 6: B' <-- (Y_0, Y_2 ... Y_{2r-2}, Y_1, Y_3 ... Y_{2r-1}) */
+		SIMD_STORE(out, X0);
+		SIMD_STORE(out + 4, X1);
+		SIMD_STORE(out + 8, X2);
+		SIMD_STORE(out + 12, X3);
+	}
+}
+
+/**
+ * blkxor_simd(dest, src, words):
+ * dest ^= src, for arrays aligned to 16 bytes.
+ */
+static void
+blkxor_simd(uint32_t * dest, const uint32_t * src, size_t words)
+{
+	size_t i;
+
+	for (i = 0; i < words; i += 4)
+		SIMD_STORE(&dest[i], SIMD_XOR(SIMD_LOAD(&dest[i]), SIMD_LOAD(&src[i])));
+}
+
+/**
+ * smix_simd(B, r, N, V, XY, cancelled, context):
+ * Same as smix, with the vectorized core.
+ */
+static int
+smix_simd(uint8_t * B, size_t r, uint64_t N, uint32_t * V, uint32_t * XY,
+    int (*cancelled)(void *), void * context)
+{
+	uint32_t * X = XY;
+	uint32_t * Y = &XY[32 * r];
+	uint64_t i;
+	uint64_t j;
+	size_t k;
+	size_t w;
+
+	/* 1: X <-- B, permuted */
+	for (k = 0; k < 2 * r; k++)
+		for (w = 0; w < 16; w++)
+			X[k * 16 + w] = le32dec(&B[(k * 16 + (w * 5 % 16)) * 4]);
+
+	/* 2: for i = 0 to N - 1 do */
+	for (i = 0; i < N; i += 2) {
+		if (CANCEL_CHECK(i))
+			return -1;
+
+		/* 3: V_i <-- X */
+		blkcpy(&V[i * (32 * r)], X, 128 * r);
+
+		/* 4: X <-- H(X) */
+		blockmix_salsa8_simd(X, Y, r);
+
+		/* 3: V_i <-- X */
+		blkcpy(&V[(i + 1) * (32 * r)], Y, 128 * r);
+
+		/* 4: X <-- H(X) */
+		blockmix_salsa8_simd(Y, X, r);
+	}
+
+	/* 6: for i = 0 to N - 1 do */
+	for (i = 0; i < N; i += 2) {
+		if (CANCEL_CHECK(i))
+			return -1;
+
+		/* 7: j <-- Integerify(X) mod N, word 1 of the last block is at 13 */
+		j = (((uint64_t)(X[(2 * r - 1) * 16 + 13]) << 32) + X[(2 * r - 1) * 16]) & (N - 1);
+
+		/* 8: X <-- H(X \xor V_j) */
+		blkxor_simd(X, &V[j * (32 * r)], 32 * r);
+		blockmix_salsa8_simd(X, Y, r);
+
+		/* 7: j <-- Integerify(X) mod N */
+		j = (((uint64_t)(Y[(2 * r - 1) * 16 + 13]) << 32) + Y[(2 * r - 1) * 16]) & (N - 1);
+
+		/* 8: X <-- H(X \xor V_j) */
+		blkxor_simd(Y, &V[j * (32 * r)], 32 * r);
+		blockmix_salsa8_simd(Y, X, r);
+	}
+
+	/* 10: B' <-- X */
+	for (k = 0; k < 2 * r; k++)
+		for (w = 0; w < 16; w++)
+			le32enc(&B[(k * 16 + (w * 5 % 16)) * 4], X[k * 16 + w]);
+	return 0;
+}
+#endif
+
+// [wallet-core]
+size_t
+scrypt_smix_scratch_size(uint64_t N, uint32_t r)
+{
+	if (r == 0 || N > (SIZE_MAX - 256 * (size_t)(r) - 127) / 128 / r)
+		return 0;
+	return 128 * (size_t)(r) * N + 256 * (size_t)(r) + 64 + 63;
+}
+
+// [wallet-core]
+void
+scrypt_smix(uint8_t * B, uint32_t r, uint64_t N, void * scratch)
+{
+	scrypt_smix_cancellable(B, r, N, scratch, NULL, NULL);
+}
+
+// [wallet-core]
+int
+scrypt_smix_cancellable(uint8_t * B, uint32_t r, uint64_t N, void * scratch,
+    int (*cancelled)(void *), void * context)
+{
+	uint32_t * V = (uint32_t *)(((uintptr_t)(scratch) + 63) & ~ (uintptr_t)(63));
+	uint32_t * XY = &V[32 * (size_t)(r) * N];
+
+#ifdef SCRYPT_SIMD
+	return smix_simd(B, r, N, V, XY, cancelled, context);
+#else
+	return smix(B, r, N, V, XY, cancelled, context);
+#endif
 }
 
 /**
@@ -314,7 +538,12 @@ scrypt(const uint8_t * passwd, size_t passwdlen,
 	/* 2: for i = 0 to p - 1 do */
 	for (i = 0; i < p; i++) {
 		/* 3: B_i <-- MF(B_i, N) */
-		smix(&B[i * 128 * r], r, N, V, XY);
+#ifdef SCRYPT_SIMD
+		// [wallet-core]
+		smix_simd(&B[i * 128 * r], r, N, V, XY, NULL, NULL);
+#else
+		smix(&B[i * 128 * r], r, N, V, XY, NULL, NULL);
+#endif
 	}
 
 	/* 5: DK <-- PBKDF2(P, B, 1, dkLen) */
@@ -0,0 +1,715 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Fast secp256k1 public key computation.
+//
+// The generator multiple k*G is the sum of one precomputed point per w-bit window
+// of k: the scalar is recoded into odd signed digits (as scalar_multiply in ecdsa.c
+// does with 4-bit windows), so every window contributes (2j+1) * 2^(w*i) * G or its
+// negation and the same number of additions is done for every key.
+// The field arithmetic uses 4 64-bit limbs and the special form of the prime
+// p = 2^256 - 0x1000003D1, which is much faster than the generic bignum code.
+
+#include <string.h>
+
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/secp256k1_comb.h>
+
+#if defined(__SIZEOF_INT128__)
+
+__extension__ typedef unsigned __int128 comb_u128;
+
+/* Field element, 4 little-endian limbs, always fully reduced (< p) */
+typedef struct {
+	uint64_t n[4];
+} comb_fe;
+
+/* Affine point */
+typedef struct {
+	comb_fe x, y;
+} comb_ge;
+
+/* Jacobian point, (x / z^2, y / z^3) */
+typedef struct {
+	comb_fe x, y, z;
+	int infinity;
+} comb_gej;
+
+/* 2^256 mod p */
+#define COMB_C 0x1000003D1ULL
+
+/* Points converted to affine coordinates with a single inversion by secp256k1_comb_get_public_keys33/65 */
+#define SECP256K1_COMB_BATCH_SIZE 32
+
+static const comb_fe comb_one = {{1, 0, 0, 0}};
+
+static const comb_ge comb_generator = {
+	{{0x59F2815B16F81798ULL, 0x029BFCDB2DCE28D9ULL, 0x55A06295CE870B07ULL, 0x79BE667EF9DCBBACULL}},
+	{{0x9C47D08FFB10D4B8ULL, 0xFD17B448A6855419ULL, 0x5DA4FBFC0E1108A8ULL, 0x483ADA7726A3C465ULL}},
+};
+
+/* Group order */
+static const uint64_t comb_order[4] = {0xBFD25E8CD0364141ULL, 0xBAAEDCE6AF48A03BULL, 0xFFFFFFFFFFFFFFFEULL, 0xFFFFFFFFFFFFFFFFULL};
+
+static void fe_select(comb_fe* r, const comb_fe* a, const comb_fe* b, uint64_t flag) {
+	/* r = flag ? b : a */
+	const uint64_t mask = 0 - flag;
+	for (int i = 0; i < 4; i++) {
+		r->n[i] = (a->n[i] & ~mask) | (b->n[i] & mask);
+	}
+}
+
+/* r = (v + carry * 2^256) mod p, for v < 2^256 and carry in {0, 1} */
+static void fe_reduce_once(comb_fe* r, const uint64_t v[4], uint64_t carry) {
+	comb_fe t;
+	comb_u128 acc = (comb_u128)v[0] + COMB_C;
+	t.n[0] = (uint64_t)acc;
+	acc >>= 64;
+	for (int i = 1; i < 4; i++) {
+		acc += v[i];
+		t.n[i] = (uint64_t)acc;
+		acc >>= 64;
+	}
+	/* v >= p iff v + 2^256 - p overflows */
+	comb_fe value = {{v[0], v[1], v[2], v[3]}};
+	fe_select(r, &value, &t, carry | (uint64_t)acc);
+}
+
+static void fe_add(comb_fe* r, const comb_fe* a, const comb_fe* b) {
+	uint64_t v[4];
+	comb_u128 acc = 0;
+	for (int i = 0; i < 4; i++) {
+		acc += (comb_u128)a->n[i] + b->n[i];
+		v[i] = (uint64_t)acc;
+		acc >>= 64;
+	}
+	fe_reduce_once(r, v, (uint64_t)acc);
+}
+
+static void fe_sub(comb_fe* r, const comb_fe* a, const comb_fe* b) {
+	uint64_t v[4];
+	uint64_t borrow = 0;
+	for (int i = 0; i < 4; i++) {
+		const comb_u128 d = (comb_u128)a->n[i] - b->n[i] - borrow;
+		v[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	/* on borrow, add p = 2^256 - C, that is subtract C and drop the borrow */
+	comb_fe t;
+	uint64_t borrow2 = 0;
+	for (int i = 0; i < 4; i++) {
+		const comb_u128 d = (comb_u128)v[i] - (i == 0 ? COMB_C : 0) - borrow2;
+		t.n[i] = (uint64_t)d;
+		borrow2 = (uint64_t)(d >> 64) & 1;
+	}
+	comb_fe value = {{v[0], v[1], v[2], v[3]}};
+	fe_select(r, &value, &t, borrow);
+}
+
+static void fe_negate(comb_fe* r, const comb_fe* a) {
+	const comb_fe zero = {{0, 0, 0, 0}};
+	fe_sub(r, &zero, a);
+}
+
+/* 192-bit accumulator c0:c1:c2 of the product scanning multiplication */
+#define COMB_MULADD(a, b)                                          \
+	{                                                              \
+		const comb_u128 prod = (comb_u128)(a) * (b);               \
+		const uint64_t lo = (uint64_t)prod;                        \
+		uint64_t hi = (uint64_t)(prod >> 64);                      \
+		c0 += lo;                                                  \
+		hi += (c0 < lo);                                           \
+		c1 += hi;                                                  \
+		c2 += (c1 < hi);                                           \
+	}
+
+/* accumulates 2 * a * b */
+#define COMB_MULADD2(a, b)                                         \
+	{                                                              \
+		const comb_u128 prod = (comb_u128)(a) * (b);               \
+		const uint64_t lo = (uint64_t)prod;                        \
+		const uint64_t hi = (uint64_t)(prod >> 64);                \
+		uint64_t hi2 = hi + hi;                                    \
+		c2 += (hi2 < hi);                                          \
+		const uint64_t lo2 = lo + lo;                              \
+		hi2 += (lo2 < lo);                                         \
+		c0 += lo2;                                                 \
+		hi2 += (c0 < lo2);                                         \
+		c1 += hi2;                                                 \
+		c2 += (c1 < hi2);                                          \
+	}
+
+#define COMB_EXTRACT(out) \
+	{                     \
+		(out) = c0;       \
+		c0 = c1;          \
+		c1 = c2;          \
+		c2 = 0;           \
+	}
+
+/* r = t mod p, for a 512-bit t */
+static void fe_reduce_wide(comb_fe* r, const uint64_t t[8]) {
+	/* fold the high half: 2^256 = C (mod p) */
+	uint64_t v[4];
+	comb_u128 acc = (comb_u128)t[4] * COMB_C + t[0];
+	v[0] = (uint64_t)acc;
+	acc >>= 64;
+	acc += (comb_u128)t[5] * COMB_C + t[1];
+	v[1] = (uint64_t)acc;
+	acc >>= 64;
+	acc += (comb_u128)t[6] * COMB_C + t[2];
+	v[2] = (uint64_t)acc;
+	acc >>= 64;
+	acc += (comb_u128)t[7] * COMB_C + t[3];
+	v[3] = (uint64_t)acc;
+	acc >>= 64;
+
+	/* acc < 2^34, fold again */
+	acc = acc * COMB_C + v[0];
+	v[0] = (uint64_t)acc;
+	acc >>= 64;
+	acc += v[1];
+	v[1] = (uint64_t)acc;
+	acc >>= 64;
+	acc += v[2];
+	v[2] = (uint64_t)acc;
+	acc >>= 64;
+	acc += v[3];
+	v[3] = (uint64_t)acc;
+	acc >>= 64;
+
+	/* on overflow the value is below 2^66, so the +C of the final reduction does not overflow */
+	fe_reduce_once(r, v, (uint64_t)acc);
+}
+
+static void fe_mul(comb_fe* r, const comb_fe* a, const comb_fe* b) {
+	const uint64_t* x = a->n;
+	const uint64_t* y = b->n;
+	uint64_t t[8];
+	uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+	COMB_MULADD(x[0], y[0]);
+	COMB_EXTRACT(t[0]);
+	COMB_MULADD(x[0], y[1]);
+	COMB_MULADD(x[1], y[0]);
+	COMB_EXTRACT(t[1]);
+	COMB_MULADD(x[0], y[2]);
+	COMB_MULADD(x[1], y[1]);
+	COMB_MULADD(x[2], y[0]);
+	COMB_EXTRACT(t[2]);
+	COMB_MULADD(x[0], y[3]);
+	COMB_MULADD(x[1], y[2]);
+	COMB_MULADD(x[2], y[1]);
+	COMB_MULADD(x[3], y[0]);
+	COMB_EXTRACT(t[3]);
+	COMB_MULADD(x[1], y[3]);
+	COMB_MULADD(x[2], y[2]);
+	COMB_MULADD(x[3], y[1]);
+	COMB_EXTRACT(t[4]);
+	COMB_MULADD(x[2], y[3]);
+	COMB_MULADD(x[3], y[2]);
+	COMB_EXTRACT(t[5]);
+	COMB_MULADD(x[3], y[3]);
+	COMB_EXTRACT(t[6]);
+	t[7] = c0;
+
+	fe_reduce_wide(r, t);
+}
+
+static void fe_sqr(comb_fe* r, const comb_fe* a) {
+	const uint64_t* x = a->n;
+	uint64_t t[8];
+	uint64_t c0 = 0, c1 = 0, c2 = 0;
+
+	COMB_MULADD(x[0], x[0]);
+	COMB_EXTRACT(t[0]);
+	COMB_MULADD2(x[0], x[1]);
+	COMB_EXTRACT(t[1]);
+	COMB_MULADD2(x[0], x[2]);
+	COMB_MULADD(x[1], x[1]);
+	COMB_EXTRACT(t[2]);
+	COMB_MULADD2(x[0], x[3]);
+	COMB_MULADD2(x[1], x[2]);
+	COMB_EXTRACT(t[3]);
+	COMB_MULADD2(x[1], x[3]);
+	COMB_MULADD(x[2], x[2]);
+	COMB_EXTRACT(t[4]);
+	COMB_MULADD2(x[2], x[3]);
+	COMB_EXTRACT(t[5]);
+	COMB_MULADD(x[3], x[3]);
+	COMB_EXTRACT(t[6]);
+	t[7] = c0;
+
+	fe_reduce_wide(r, t);
+}
+
+static void fe_sqr_n(comb_fe* r, const comb_fe* a, int n) {
+	*r = *a;
+	for (int i = 0; i < n; i++) {
+		fe_sqr(r, r);
+	}
+}
+
+/* r = a^(p - 2) */
+static void fe_inv(comb_fe* r, const comb_fe* a) {
+	comb_fe x2, x3, x6, x9, x11, x22, x44, x88, x176, x220, x223, t;
+
+	fe_sqr(&x2, a);
+	fe_mul(&x2, &x2, a);
+	fe_sqr(&x3, &x2);
+	fe_mul(&x3, &x3, a);
+	fe_sqr_n(&x6, &x3, 3);
+	fe_mul(&x6, &x6, &x3);
+	fe_sqr_n(&x9, &x6, 3);
+	fe_mul(&x9, &x9, &x3);
+	fe_sqr_n(&x11, &x9, 2);
+	fe_mul(&x11, &x11, &x2);
+	fe_sqr_n(&x22, &x11, 11);
+	fe_mul(&x22, &x22, &x11);
+	fe_sqr_n(&x44, &x22, 22);
+	fe_mul(&x44, &x44, &x22);
+	fe_sqr_n(&x88, &x44, 44);
+	fe_mul(&x88, &x88, &x44);
+	fe_sqr_n(&x176, &x88, 88);
+	fe_mul(&x176, &x176, &x88);
+	fe_sqr_n(&x220, &x176, 44);
+	fe_mul(&x220, &x220, &x44);
+	fe_sqr_n(&x223, &x220, 3);
+	fe_mul(&x223, &x223, &x3);
+
+	fe_sqr_n(&t, &x223, 23);
+	fe_mul(&t, &t, &x22);
+	fe_sqr_n(&t, &t, 5);
+	fe_mul(&t, &t, a);
+	fe_sqr_n(&t, &t, 3);
+	fe_mul(&t, &t, &x2);
+	fe_sqr_n(&t, &t, 2);
+	fe_mul(r, &t, a);
+}
+
+static int fe_is_zero(const comb_fe* a) {
+	return (a->n[0] | a->n[1] | a->n[2] | a->n[3]) == 0;
+}
+
+static void fe_write(uint8_t* out, const comb_fe* a) {
+	for (int i = 0; i < 4; i++) {
+		const uint64_t limb = a->n[3 - i];
+		for (int j = 0; j < 8; j++) {
+			out[i * 8 + j] = (uint8_t)(limb >> (56 - 8 * j));
+		}
+	}
+}
+
+/* r = 2a, for a curve with a = 0 (dbl-2009-l) */
+static void gej_double(comb_gej* r, const comb_gej* a) {
+	comb_fe t1, t2, t3, t4, t5;
+	if (a->infinity) {
+		r->infinity = 1;
+		return;
+	}
+	fe_mul(&t5, &a->y, &a->z);
+	fe_add(&r->z, &t5, &t5);      /* z3 = 2yz */
+	fe_sqr(&t1, &a->x);           /* A = x^2 */
+	fe_sqr(&t2, &a->y);           /* B = y^2 */
+	fe_sqr(&t3, &t2);             /* C = B^2 */
+	fe_add(&t4, &a->x, &t2);
+	fe_sqr(&t4, &t4);
+	fe_sub(&t4, &t4, &t1);
+	fe_sub(&t4, &t4, &t3);
+	fe_add(&t4, &t4, &t4);        /* D = 2((x + B)^2 - A - C) */
+	fe_add(&t5, &t1, &t1);
+	fe_add(&t1, &t5, &t1);        /* E = 3A */
+	fe_sqr(&t2, &t1);             /* F = E^2 */
+	fe_add(&t5, &t4, &t4);
+	fe_sub(&r->x, &t2, &t5);      /* x3 = F - 2D */
+	fe_sub(&t4, &t4, &r->x);
+	fe_mul(&t4, &t1, &t4);
+	fe_add(&t3, &t3, &t3);
+	fe_add(&t3, &t3, &t3);
+	fe_add(&t3, &t3, &t3);
+	fe_sub(&r->y, &t4, &t3);      /* y3 = E(D - x3) - 8C */
+	r->infinity = 0;
+}
+
+/* r = a + b, with b in affine coordinates */
+static void gej_add_ge(comb_gej* r, const comb_gej* a, const comb_ge* b) {
+	comb_fe z1z1, u2, s2, h, rr, hh, hhh, v, t;
+	if (a->infinity) {
+		r->x = b->x;
+		r->y = b->y;
+		r->z = comb_one;
+		r->infinity = 0;
+		return;
+	}
+	fe_sqr(&z1z1, &a->z);
+	fe_mul(&u2, &b->x, &z1z1);
+	fe_mul(&s2, &b->y, &a->z);
+	fe_mul(&s2, &s2, &z1z1);
+	fe_sub(&h, &u2, &a->x);
+	fe_sub(&rr, &s2, &a->y);
+	if (fe_is_zero(&h)) {
+		/* a = b or a = -b, negligible for scalars in the comb, handled for correctness */
+		if (fe_is_zero(&rr)) {
+			gej_double(r, a);
+		} else {
+			r->infinity = 1;
+		}
+		return;
+	}
+	fe_sqr(&hh, &h);
+	fe_mul(&hhh, &h, &hh);
+	fe_mul(&v, &a->x, &hh);
+	fe_mul(&r->z, &a->z, &h);
+	fe_mul(&t, &a->y, &hhh);      /* a->y is not needed after this, r may alias a */
+	fe_sqr(&r->x, &rr);
+	fe_sub(&r->x, &r->x, &hhh);
+	fe_sub(&r->x, &r->x, &v);
+	fe_sub(&r->x, &r->x, &v);     /* x3 = R^2 - HHH - 2V */
+	fe_sub(&v, &v, &r->x);
+	fe_mul(&v, &rr, &v);
+	fe_sub(&r->y, &v, &t);        /* y3 = R(V - x3) - y1 HHH */
+	r->infinity = 0;
+}
+
+static void gej_to_ge(comb_ge* r, const comb_gej* a) {
+	comb_fe zi, zi2;
+	fe_inv(&zi, &a->z);
+	fe_sqr(&zi2, &zi);
+	fe_mul(&r->x, &a->x, &zi2);
+	fe_mul(&zi2, &zi2, &zi);
+	fe_mul(&r->y, &a->y, &zi2);
+}
+
+static int comb_rows(int window) {
+	return (256 + window - 1) / window;
+}
+
+int secp256k1_comb_supported(void) {
+	return 1;
+}
+
+size_t secp256k1_comb_table_size(int window) {
+	if (window < SECP256K1_COMB_MIN_WINDOW || window > SECP256K1_COMB_MAX_WINDOW) {
+		return 0;
+	}
+	return (size_t)comb_rows(window) * ((size_t)1 << (window - 1)) * sizeof(comb_ge);
+}
+
+int secp256k1_comb_build(void* table, int window) {
+	if (secp256k1_comb_table_size(window) == 0) {
+		return -1;
+	}
+	comb_ge* points = (comb_ge*)table;
+	const int rows = comb_rows(window);
+	const int cols = 1 << (window - 1);
+
+	/* z coordinates of a row, the x and y are kept in the table until the row is converted */
+	comb_fe zs[1 << (SECP256K1_COMB_MAX_WINDOW - 1)];
+	comb_fe prefix[1 << (SECP256K1_COMB_MAX_WINDOW - 1)];
+
+	comb_ge base = comb_generator;
+	for (int row = 0; row < rows; row++) {
+		comb_ge* entries = points + row * cols;
+
+		/* (2j + 1) * base = base + j * 2 * base */
+		comb_gej p = {base.x, base.y, comb_one, 0};
+		comb_gej twice;
+		comb_ge twice_affine;
+		gej_double(&twice, &p);
+		gej_to_ge(&twice_affine, &twice);
+		for (int j = 0; j < cols; j++) {
+			entries[j].x = p.x;
+			entries[j].y = p.y;
+			zs[j] = p.z;
+			gej_add_ge(&p, &p, &twice_affine);
+		}
+
+		/* batch conversion to affine coordinates with a single inversion */
+		prefix[0] = zs[0];
+		for (int j = 1; j < cols; j++) {
+			fe_mul(&prefix[j], &prefix[j - 1], &zs[j]);
+		}
+		comb_fe inv;
+		fe_inv(&inv, &prefix[cols - 1]);
+		for (int j = cols - 1; j >= 0; j--) {
+			comb_fe zi, zi2;
+			if (j > 0) {
+				fe_mul(&zi, &inv, &prefix[j - 1]);
+				fe_mul(&inv, &inv, &zs[j]);
+			} else {
+				zi = inv;
+			}
+			fe_sqr(&zi2, &zi);
+			fe_mul(&entries[j].x, &entries[j].x, &zi2);
+			fe_mul(&zi2, &zi2, &zi);
+			fe_mul(&entries[j].y, &entries[j].y, &zi2);
+		}
+
+		/* next base = 2^window * base */
+		comb_gej next = {base.x, base.y, comb_one, 0};
+		for (int i = 0; i < window; i++) {
+			gej_double(&next, &next);
+		}
+		gej_to_ge(&base, &next);
+	}
+	return 0;
+}
+
+/* Computes priv_key * G in Jacobian coordinates, returns 0 on success */
+static int comb_multiply_gej(const void* table, int window, const uint8_t* priv_key, comb_gej* result) {
+	const comb_ge* points = (const comb_ge*)table;
+	const int rows = comb_rows(window);
+	const int cols = 1 << (window - 1);
+	if (secp256k1_comb_table_size(window) == 0) {
+		return -1;
+	}
+
+	uint64_t k[4];
+	for (int i = 0; i < 4; i++) {
+		uint64_t limb = 0;
+		for (int j = 0; j < 8; j++) {
+			limb = (limb << 8) | priv_key[(3 - i) * 8 + j];
+		}
+		k[i] = limb;
+	}
+
+	/* 0 < k < n */
+	uint64_t borrow = 0;
+	uint64_t nk[4];
+	for (int i = 0; i < 4; i++) {
+		const comb_u128 d = (comb_u128)comb_order[i] - k[i] - borrow;
+		nk[i] = (uint64_t)d;
+		borrow = (uint64_t)(d >> 64) & 1;
+	}
+	if ((k[0] | k[1] | k[2] | k[3]) == 0 || borrow || (nk[0] | nk[1] | nk[2] | nk[3]) == 0) {
+		memzero(k, sizeof(k));
+		memzero(nk, sizeof(nk));
+		return -1;
+	}
+
+	/* use n - k if k is even, and negate the result */
+	const uint64_t negate = (k[0] & 1) ^ 1;
+	const uint64_t mask = 0 - negate;
+	for (int i = 0; i < 4; i++) {
+		k[i] = (k[i] & ~mask) | (nk[i] & mask);
+	}
+
+	/* odd signed digits: a digit following an even one is made odd by borrowing 2^window */
+	int32_t digits[256 / SECP256K1_COMB_MIN_WINDOW];
+	for (int i = 0; i < rows; i++) {
+		const int pos = i * window;
+		const int limb = pos >> 6;
+		const int shift = pos & 63;
+		uint64_t bits = k[limb] >> shift;
+		if (shift + window > 64 && limb < 3) {
+			bits |= k[limb + 1] << (64 - shift);
+		}
+		digits[i] = (int32_t)(bits & (((uint64_t)1 << window) - 1));
+	}
+	for (int i = 0; i < rows - 1; i++) {
+		const int32_t even = (digits[i + 1] & 1) ^ 1;
+		digits[i + 1] += even;
+		digits[i] -= even << window;
+	}
+
+	comb_gej acc;
+	acc.infinity = 1;
+	for (int i = 0; i < rows; i++) {
+		const int32_t sign = digits[i] >> 31;
+		const int32_t abs = (digits[i] ^ sign) - sign;
+		comb_ge point = points[i * cols + ((abs - 1) >> 1)];
+		comb_fe neg;
+		fe_negate(&neg, &point.y);
+		fe_select(&point.y, &point.y, &neg, (uint64_t)(sign & 1));
+		gej_add_ge(&acc, &acc, &point);
+		memzero(&point, sizeof(point));
+	}
+
+	/* -(x, y, z) = (x, -y, z) */
+	*result = acc;
+	comb_fe neg;
+	fe_negate(&neg, &result->y);
+	fe_select(&result->y, &result->y, &neg, negate);
+
+	memzero(k, sizeof(k));
+	memzero(nk, sizeof(nk));
+	memzero(digits, sizeof(digits));
+	memzero(&acc, sizeof(acc));
+	return 0;
+}
+
+/* Computes priv_key * G in affine coordinates, returns 0 on success */
+static int comb_multiply(const void* table, int window, const uint8_t* priv_key, comb_ge* result) {
+	comb_gej point;
+	if (comb_multiply_gej(table, window, priv_key, &point) != 0) {
+		return -1;
+	}
+	gej_to_ge(result, &point);
+	memzero(&point, sizeof(point));
+	return 0;
+}
+
+static void comb_write_public_key(uint8_t* pub_key, const comb_ge* point, size_t pub_key_size) {
+	if (pub_key_size == 33) {
+		pub_key[0] = 0x02 | (uint8_t)(point->y.n[0] & 1);
+		fe_write(pub_key + 1, &point->x);
+	} else {
+		pub_key[0] = 0x04;
+		fe_write(pub_key + 1, &point->x);
+		fe_write(pub_key + 33, &point->y);
+	}
+}
+
+/* Public keys of pub_key_size bytes of a batch, converted to affine coordinates with a single inversion */
+static int comb_get_public_keys(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys, size_t pub_key_size) {
+	if (secp256k1_comb_table_size(window) == 0) {
+		return -1;
+	}
+	comb_gej points[SECP256K1_COMB_BATCH_SIZE];
+	comb_fe prefix[SECP256K1_COMB_BATCH_SIZE];
+	int status = 0;
+	for (size_t start = 0; start < count; start += SECP256K1_COMB_BATCH_SIZE) {
+		const size_t size = count - start < SECP256K1_COMB_BATCH_SIZE ? count - start : SECP256K1_COMB_BATCH_SIZE;
+		for (size_t i = 0; i < size; i++) {
+			if (comb_multiply_gej(table, window, priv_keys + (start + i) * 32, &points[i]) != 0) {
+				/* z = 1 keeps the product invertible, the key is zeroed below */
+				points[i].z = comb_one;
+				points[i].infinity = 1;
+				status = -1;
+			}
+			if (i == 0) {
+				prefix[0] = points[0].z;
+			} else {
+				fe_mul(&prefix[i], &prefix[i - 1], &points[i].z);
+			}
+		}
+
+		comb_fe inv;
+		fe_inv(&inv, &prefix[size - 1]);
+		for (size_t i = size; i-- > 0;) {
+			uint8_t* pub_key = pub_keys + (start + i) * pub_key_size;
+			comb_fe zi, zi2;
+			if (i > 0) {
+				fe_mul(&zi, &inv, &prefix[i - 1]);
+				fe_mul(&inv, &inv, &points[i].z);
+			} else {
+				zi = inv;
+			}
+			if (points[i].infinity) {
+				memzero(pub_key, pub_key_size);
+				continue;
+			}
+			comb_ge point;
+			fe_sqr(&zi2, &zi);
+			fe_mul(&point.x, &points[i].x, &zi2);
+			fe_mul(&zi2, &zi2, &zi);
+			fe_mul(&point.y, &points[i].y, &zi2);
+			comb_write_public_key(pub_key, &point, pub_key_size);
+			memzero(&point, sizeof(point));
+		}
+		memzero(&inv, sizeof(inv));
+	}
+	memzero(points, sizeof(points));
+	memzero(prefix, sizeof(prefix));
+	return status;
+}
+
+int secp256k1_comb_get_public_key33(const void* table, int window, const uint8_t* priv_key, uint8_t* pub_key) {
+	comb_ge point;
+	if (comb_multiply(table, window, priv_key, &point) != 0) {
+		return -1;
+	}
+	comb_write_public_key(pub_key, &point, 33);
+	memzero(&point, sizeof(point));
+	return 0;
+}
+
+int secp256k1_comb_get_public_key65(const void* table, int window, const uint8_t* priv_key, uint8_t* pub_key) {
+	comb_ge point;
+	if (comb_multiply(table, window, priv_key, &point) != 0) {
+		return -1;
+	}
+	comb_write_public_key(pub_key, &point, 65);
+	memzero(&point, sizeof(point));
+	return 0;
+}
+
+int secp256k1_comb_get_public_keys33(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys) {
+	return comb_get_public_keys(table, window, priv_keys, count, pub_keys, 33);
+}
+
+int secp256k1_comb_get_public_keys65(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys) {
+	return comb_get_public_keys(table, window, priv_keys, count, pub_keys, 65);
+}
+
+#else
+
+int secp256k1_comb_supported(void) {
+	return 0;
+}
+
+size_t secp256k1_comb_table_size(int window) {
+	(void)window;
+	return 0;
+}
+
+int secp256k1_comb_build(void* table, int window) {
+	(void)table;
+	(void)window;
+	return -1;
+}
+
+int secp256k1_comb_get_public_key33(const void* table, int window, const uint8_t* priv_key, uint8_t* pub_key) {
+	(void)table;
+	(void)window;
+	(void)priv_key;
+	(void)pub_key;
+	return -1;
+}
+
+int secp256k1_comb_get_public_key65(const void* table, int window, const uint8_t* priv_key, uint8_t* pub_key) {
+	(void)table;
+	(void)window;
+	(void)priv_key;
+	(void)pub_key;
+	return -1;
+}
+
+int secp256k1_comb_get_public_keys33(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys) {
+	(void)table;
+	(void)window;
+	(void)priv_keys;
+	(void)count;
+	(void)pub_keys;
+	return -1;
+}
+
+int secp256k1_comb_get_public_keys65(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys) {
+	(void)table;
+	(void)window;
+	(void)priv_keys;
+	(void)count;
+	(void)pub_keys;
+	return -1;
+}
+
+#endif
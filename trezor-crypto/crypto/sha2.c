@@ -31,7 +31,9 @@
 #include <string.h>
 #include <stdint.h>
 #include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha2_hw.h>
 #include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/options.h>
 
 /*
  * ASSERT NOTE:
@@ -288,7 +290,7 @@ const sha2_word64 sha512_256_initial_hash_value[8] = {
  * Constant used by SHA256/384/512_End() functions for converting the
  * digest to a readable hexadecimal character string:
  */
-const char *sha2_hex_digits = "0123456789abcdef";
+static const char *const sha2_hex_digits = "0123456789abcdef";
 
 
 /*** SHA-1: ***********************************************************/
@@ -710,7 +712,7 @@ void sha256_Init(SHA256_CTX* context) {
 	(h) = T1 + Sigma0_256(a) + Maj((a), (b), (c)); \
 	j++
 
-void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+void sha256_Transform_portable(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, s0 = 0, s1 = 0;
 	sha2_word32	T1 = 0;
 	sha2_word32 W256[16] = {0};
@@ -767,7 +769,7 @@ void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2
 
 #else /* SHA2_UNROLL_TRANSFORM */
 
-void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+void sha256_Transform_portable(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
 	sha2_word32	a = 0, b = 0, c = 0, d = 0, e = 0, f = 0, g = 0, h = 0, s0 = 0, s1 = 0;
 	sha2_word32	T1 = 0, T2 = 0 , W256[16] = {0};
 	int		j = 0;
@@ -838,6 +840,15 @@ void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2
 
 #endif /* SHA2_UNROLL_TRANSFORM */
 
+// [wallet-core] dispatch to the hardware accelerated implementation, if any
+void sha256_Transform(const sha2_word32* state_in, const sha2_word32* data, sha2_word32* state_out) {
+#if USE_SHA256_HW
+	sha256_hw_transform(state_in, data, state_out);
+#else
+	sha256_Transform_portable(state_in, data, state_out);
+#endif
+}
+
 void sha256_Update(SHA256_CTX* context, const sha2_byte *data, size_t len) {
 	unsigned int	freespace = 0, usedspace = 0;
 
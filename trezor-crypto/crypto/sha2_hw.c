@@ -0,0 +1,629 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+// [wallet-core] Hardware accelerated SHA-256 compression, selected at runtime.
+//
+// SHA extensions (x86) and ARMv8 cryptography extensions replace the portable
+// sha256_Transform. The AVX2 code compresses 8 independent messages at once and
+// is only used by sha256_Raw_batch. The SHA-512 AVX2 and AVX-512 features are
+// detected here and used by the multi-buffer PBKDF2 in pbkdf2.c.
+
+#include <string.h>
+
+#include <TrezorCrypto/memzero.h>
+#include <TrezorCrypto/options.h>
+#include <TrezorCrypto/sha2.h>
+#include <TrezorCrypto/sha2_hw.h>
+
+#if USE_SHA256_HW && (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define SHA256_HW_X86 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#if USE_SHA256_HW && defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2))
+#define SHA256_HW_ARM 1
+#include <arm_neon.h>
+#endif
+
+extern const uint32_t K256[64];
+
+typedef void (*sha256_transform_fn)(const uint32_t* state_in, const uint32_t* data, uint32_t* state_out);
+
+#ifdef SHA256_HW_X86
+
+__attribute__((target("sha,sse4.1")))
+static void sha256_Transform_shani(const uint32_t* state_in, const uint32_t* data, uint32_t* state_out) {
+	__m128i state0, state1, msg, tmp, msg0, msg1, msg2, msg3, abef, cdgh;
+
+	/* Load the state as ABEF and CDGH */
+	tmp = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state_in[0]), 0xB1);
+	state1 = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i*)&state_in[4]), 0x1B);
+	state0 = _mm_alignr_epi8(tmp, state1, 8);
+	state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+	abef = state0;
+	cdgh = state1;
+
+	/* The message words are already in host byte order */
+	/* Rounds 0-3 */
+	msg0 = _mm_loadu_si128((const __m128i*)(data + 0));
+	msg = _mm_add_epi32(msg0, _mm_loadu_si128((const __m128i*)(K256 + 0)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+	/* Rounds 4-7 */
+	msg1 = _mm_loadu_si128((const __m128i*)(data + 4));
+	msg = _mm_add_epi32(msg1, _mm_loadu_si128((const __m128i*)(K256 + 4)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+	/* Rounds 8-11 */
+	msg2 = _mm_loadu_si128((const __m128i*)(data + 8));
+	msg = _mm_add_epi32(msg2, _mm_loadu_si128((const __m128i*)(K256 + 8)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+	/* Rounds 12-15 */
+	msg3 = _mm_loadu_si128((const __m128i*)(data + 12));
+	msg = _mm_add_epi32(msg3, _mm_loadu_si128((const __m128i*)(K256 + 12)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg3, msg2, 4);
+	msg0 = _mm_add_epi32(msg0, tmp);
+	msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+	/* Rounds 16-19 */
+	msg = _mm_add_epi32(msg0, _mm_loadu_si128((const __m128i*)(K256 + 16)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg0, msg3, 4);
+	msg1 = _mm_add_epi32(msg1, tmp);
+	msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+	/* Rounds 20-23 */
+	msg = _mm_add_epi32(msg1, _mm_loadu_si128((const __m128i*)(K256 + 20)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg1, msg0, 4);
+	msg2 = _mm_add_epi32(msg2, tmp);
+	msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+	/* Rounds 24-27 */
+	msg = _mm_add_epi32(msg2, _mm_loadu_si128((const __m128i*)(K256 + 24)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg2, msg1, 4);
+	msg3 = _mm_add_epi32(msg3, tmp);
+	msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+	/* Rounds 28-31 */
+	msg = _mm_add_epi32(msg3, _mm_loadu_si128((const __m128i*)(K256 + 28)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg3, msg2, 4);
+	msg0 = _mm_add_epi32(msg0, tmp);
+	msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+	/* Rounds 32-35 */
+	msg = _mm_add_epi32(msg0, _mm_loadu_si128((const __m128i*)(K256 + 32)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg0, msg3, 4);
+	msg1 = _mm_add_epi32(msg1, tmp);
+	msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+	/* Rounds 36-39 */
+	msg = _mm_add_epi32(msg1, _mm_loadu_si128((const __m128i*)(K256 + 36)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg1, msg0, 4);
+	msg2 = _mm_add_epi32(msg2, tmp);
+	msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+	/* Rounds 40-43 */
+	msg = _mm_add_epi32(msg2, _mm_loadu_si128((const __m128i*)(K256 + 40)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg2, msg1, 4);
+	msg3 = _mm_add_epi32(msg3, tmp);
+	msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+	/* Rounds 44-47 */
+	msg = _mm_add_epi32(msg3, _mm_loadu_si128((const __m128i*)(K256 + 44)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg3, msg2, 4);
+	msg0 = _mm_add_epi32(msg0, tmp);
+	msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+	/* Rounds 48-51 */
+	msg = _mm_add_epi32(msg0, _mm_loadu_si128((const __m128i*)(K256 + 48)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg0, msg3, 4);
+	msg1 = _mm_add_epi32(msg1, tmp);
+	msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+	/* Rounds 52-55 */
+	msg = _mm_add_epi32(msg1, _mm_loadu_si128((const __m128i*)(K256 + 52)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg1, msg0, 4);
+	msg2 = _mm_add_epi32(msg2, tmp);
+	msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+	/* Rounds 56-59 */
+	msg = _mm_add_epi32(msg2, _mm_loadu_si128((const __m128i*)(K256 + 56)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	tmp = _mm_alignr_epi8(msg2, msg1, 4);
+	msg3 = _mm_add_epi32(msg3, tmp);
+	msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+
+	/* Rounds 60-63 */
+	msg = _mm_add_epi32(msg3, _mm_loadu_si128((const __m128i*)(K256 + 60)));
+	state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+	msg = _mm_shuffle_epi32(msg, 0x0E);
+	state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+	state0 = _mm_add_epi32(state0, abef);
+	state1 = _mm_add_epi32(state1, cdgh);
+
+	/* Store the state back as ABCD and EFGH */
+	tmp = _mm_shuffle_epi32(state0, 0x1B);
+	state1 = _mm_shuffle_epi32(state1, 0xB1);
+	_mm_storeu_si128((__m128i*)&state_out[0], _mm_blend_epi16(tmp, state1, 0xF0));
+	_mm_storeu_si128((__m128i*)&state_out[4], _mm_alignr_epi8(state1, tmp, 8));
+}
+
+#define ROTR32X8(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
+#define XOR3X8(a, b, c) _mm256_xor_si256(_mm256_xor_si256((a), (b)), (c))
+
+/* Compresses one block for each of 8 lanes; words[j][lane] is word j of the block of the lane. */
+__attribute__((target("avx2")))
+static void sha256_Transform_x8_avx2(uint32_t state[8][8], const uint32_t words[16][8]) {
+	__m256i w[16];
+	__m256i a = _mm256_loadu_si256((const __m256i*)state[0]);
+	__m256i b = _mm256_loadu_si256((const __m256i*)state[1]);
+	__m256i c = _mm256_loadu_si256((const __m256i*)state[2]);
+	__m256i d = _mm256_loadu_si256((const __m256i*)state[3]);
+	__m256i e = _mm256_loadu_si256((const __m256i*)state[4]);
+	__m256i f = _mm256_loadu_si256((const __m256i*)state[5]);
+	__m256i g = _mm256_loadu_si256((const __m256i*)state[6]);
+	__m256i h = _mm256_loadu_si256((const __m256i*)state[7]);
+
+	for (int j = 0; j < 64; j++) {
+		__m256i wj;
+		if (j < 16) {
+			wj = _mm256_loadu_si256((const __m256i*)words[j]);
+		} else {
+			const __m256i w15 = w[(j + 1) & 0x0f];
+			const __m256i w2 = w[(j + 14) & 0x0f];
+			const __m256i s0 = XOR3X8(ROTR32X8(w15, 7), ROTR32X8(w15, 18), _mm256_srli_epi32(w15, 3));
+			const __m256i s1 = XOR3X8(ROTR32X8(w2, 17), ROTR32X8(w2, 19), _mm256_srli_epi32(w2, 10));
+			wj = _mm256_add_epi32(_mm256_add_epi32(w[j & 0x0f], s0), _mm256_add_epi32(w[(j + 9) & 0x0f], s1));
+		}
+		w[j & 0x0f] = wj;
+
+		const __m256i sigma1 = XOR3X8(ROTR32X8(e, 6), ROTR32X8(e, 11), ROTR32X8(e, 25));
+		const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+		const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, sigma1), _mm256_add_epi32(ch, wj)),
+			_mm256_set1_epi32((int)K256[j]));
+		const __m256i sigma0 = XOR3X8(ROTR32X8(a, 2), ROTR32X8(a, 13), ROTR32X8(a, 22));
+		const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, _mm256_add_epi32(sigma0, maj));
+	}
+
+	_mm256_storeu_si256((__m256i*)state[0], _mm256_add_epi32(a, _mm256_loadu_si256((const __m256i*)state[0])));
+	_mm256_storeu_si256((__m256i*)state[1], _mm256_add_epi32(b, _mm256_loadu_si256((const __m256i*)state[1])));
+	_mm256_storeu_si256((__m256i*)state[2], _mm256_add_epi32(c, _mm256_loadu_si256((const __m256i*)state[2])));
+	_mm256_storeu_si256((__m256i*)state[3], _mm256_add_epi32(d, _mm256_loadu_si256((const __m256i*)state[3])));
+	_mm256_storeu_si256((__m256i*)state[4], _mm256_add_epi32(e, _mm256_loadu_si256((const __m256i*)state[4])));
+	_mm256_storeu_si256((__m256i*)state[5], _mm256_add_epi32(f, _mm256_loadu_si256((const __m256i*)state[5])));
+	_mm256_storeu_si256((__m256i*)state[6], _mm256_add_epi32(g, _mm256_loadu_si256((const __m256i*)state[6])));
+	_mm256_storeu_si256((__m256i*)state[7], _mm256_add_epi32(h, _mm256_loadu_si256((const __m256i*)state[7])));
+}
+
+static unsigned sha256_hw_detect(void) {
+	unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+	unsigned features = 0;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	const int sse41 = (ecx & (1u << 19)) != 0;
+	/* AVX2 also needs the OS to save the YMM registers */
+	int ymm = 0;
+	if ((ecx & (1u << 27)) != 0 && (ecx & (1u << 28)) != 0) {
+		unsigned xcr0 = 0, xcr0_high = 0;
+		__asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0_high) : "c"(0));
+		ymm = (xcr0 & 0x6) == 0x6;
+	}
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+		return 0;
+	}
+	if (sse41 && (ebx & (1u << 29)) != 0) {
+		features |= SHA256_HW_SHANI;
+	}
+	if (ymm && (ebx & (1u << 5)) != 0) {
+		features |= SHA256_HW_AVX2 | SHA512_HW_AVX2;
+	}
+	/* AVX-512 also needs the OS to save the opmask and ZMM registers */
+	if (ymm && (ebx & (1u << 16)) != 0) {
+		unsigned xcr0 = 0, xcr0_high = 0;
+		__asm__ volatile("xgetbv" : "=a"(xcr0), "=d"(xcr0_high) : "c"(0));
+		if ((xcr0 & 0xe0) == 0xe0) {
+			features |= SHA512_HW_AVX512;
+		}
+	}
+	return features;
+}
+
+#elif defined(SHA256_HW_ARM)
+
+static void sha256_Transform_armv8(const uint32_t* state_in, const uint32_t* data, uint32_t* state_out) {
+	uint32x4_t state0 = vld1q_u32(&state_in[0]);
+	uint32x4_t state1 = vld1q_u32(&state_in[4]);
+	const uint32x4_t abcd_save = state0;
+	const uint32x4_t efgh_save = state1;
+	uint32x4_t abcd, tmp0, tmp1;
+
+	/* The message words are already in host byte order */
+	uint32x4_t msg0 = vld1q_u32(data + 0);
+	uint32x4_t msg1 = vld1q_u32(data + 4);
+	uint32x4_t msg2 = vld1q_u32(data + 8);
+	uint32x4_t msg3 = vld1q_u32(data + 12);
+
+	tmp0 = vaddq_u32(msg0, vld1q_u32(K256));
+	/* Rounds 0-3 */
+	msg0 = vsha256su0q_u32(msg0, msg1);
+	abcd = state0;
+	tmp1 = vaddq_u32(msg1, vld1q_u32(K256 + 4));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+	msg0 = vsha256su1q_u32(msg0, msg2, msg3);
+
+	/* Rounds 4-7 */
+	msg1 = vsha256su0q_u32(msg1, msg2);
+	abcd = state0;
+	tmp0 = vaddq_u32(msg2, vld1q_u32(K256 + 8));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	msg1 = vsha256su1q_u32(msg1, msg3, msg0);
+
+	/* Rounds 8-11 */
+	msg2 = vsha256su0q_u32(msg2, msg3);
+	abcd = state0;
+	tmp1 = vaddq_u32(msg3, vld1q_u32(K256 + 12));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+	msg2 = vsha256su1q_u32(msg2, msg0, msg1);
+
+	/* Rounds 12-15 */
+	msg3 = vsha256su0q_u32(msg3, msg0);
+	abcd = state0;
+	tmp0 = vaddq_u32(msg0, vld1q_u32(K256 + 16));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	msg3 = vsha256su1q_u32(msg3, msg1, msg2);
+
+	/* Rounds 16-19 */
+	msg0 = vsha256su0q_u32(msg0, msg1);
+	abcd = state0;
+	tmp1 = vaddq_u32(msg1, vld1q_u32(K256 + 20));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+	msg0 = vsha256su1q_u32(msg0, msg2, msg3);
+
+	/* Rounds 20-23 */
+	msg1 = vsha256su0q_u32(msg1, msg2);
+	abcd = state0;
+	tmp0 = vaddq_u32(msg2, vld1q_u32(K256 + 24));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	msg1 = vsha256su1q_u32(msg1, msg3, msg0);
+
+	/* Rounds 24-27 */
+	msg2 = vsha256su0q_u32(msg2, msg3);
+	abcd = state0;
+	tmp1 = vaddq_u32(msg3, vld1q_u32(K256 + 28));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+	msg2 = vsha256su1q_u32(msg2, msg0, msg1);
+
+	/* Rounds 28-31 */
+	msg3 = vsha256su0q_u32(msg3, msg0);
+	abcd = state0;
+	tmp0 = vaddq_u32(msg0, vld1q_u32(K256 + 32));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	msg3 = vsha256su1q_u32(msg3, msg1, msg2);
+
+	/* Rounds 32-35 */
+	msg0 = vsha256su0q_u32(msg0, msg1);
+	abcd = state0;
+	tmp1 = vaddq_u32(msg1, vld1q_u32(K256 + 36));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+	msg0 = vsha256su1q_u32(msg0, msg2, msg3);
+
+	/* Rounds 36-39 */
+	msg1 = vsha256su0q_u32(msg1, msg2);
+	abcd = state0;
+	tmp0 = vaddq_u32(msg2, vld1q_u32(K256 + 40));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	msg1 = vsha256su1q_u32(msg1, msg3, msg0);
+
+	/* Rounds 40-43 */
+	msg2 = vsha256su0q_u32(msg2, msg3);
+	abcd = state0;
+	tmp1 = vaddq_u32(msg3, vld1q_u32(K256 + 44));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+	msg2 = vsha256su1q_u32(msg2, msg0, msg1);
+
+	/* Rounds 44-47 */
+	msg3 = vsha256su0q_u32(msg3, msg0);
+	abcd = state0;
+	tmp0 = vaddq_u32(msg0, vld1q_u32(K256 + 48));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	msg3 = vsha256su1q_u32(msg3, msg1, msg2);
+
+	/* Rounds 48-51 */
+	abcd = state0;
+	tmp1 = vaddq_u32(msg1, vld1q_u32(K256 + 52));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+
+	/* Rounds 52-55 */
+	abcd = state0;
+	tmp0 = vaddq_u32(msg2, vld1q_u32(K256 + 56));
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+
+	/* Rounds 56-59 */
+	abcd = state0;
+	tmp1 = vaddq_u32(msg3, vld1q_u32(K256 + 60));
+	state0 = vsha256hq_u32(state0, state1, tmp0);
+	state1 = vsha256h2q_u32(state1, abcd, tmp0);
+
+	/* Rounds 60-63 */
+	abcd = state0;
+	state0 = vsha256hq_u32(state0, state1, tmp1);
+	state1 = vsha256h2q_u32(state1, abcd, tmp1);
+	vst1q_u32(&state_out[0], vaddq_u32(state0, abcd_save));
+	vst1q_u32(&state_out[4], vaddq_u32(state1, efgh_save));
+}
+
+static unsigned sha256_hw_detect(void) {
+	/* The compiler targets the cryptography extensions, so they are present */
+	return SHA256_HW_ARMV8;
+}
+
+#else
+
+static unsigned sha256_hw_detect(void) {
+	return 0;
+}
+
+#endif
+
+/* Supported features, detected on first use */
+static unsigned sha256_hw_supported_features = 0;
+static int sha256_hw_detected = 0;
+/* Features in use, and the matching single-stream transform */
+static unsigned sha256_hw_features = 0;
+static sha256_transform_fn sha256_hw_transform_fn = 0;
+
+/* The state above may be initialized from several threads at once, so it is
+   accessed atomically; the detected flag and the transform are published last. */
+#define SHA256_HW_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SHA256_HW_STORE(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+static unsigned sha256_hw_detected_features(void) {
+	if (!SHA256_HW_LOAD(&sha256_hw_detected)) {
+		SHA256_HW_STORE(&sha256_hw_supported_features, sha256_hw_detect());
+		SHA256_HW_STORE(&sha256_hw_detected, 1);
+	}
+	return SHA256_HW_LOAD(&sha256_hw_supported_features);
+}
+
+static sha256_transform_fn sha256_hw_init(void) {
+	sha256_transform_fn transform = SHA256_HW_LOAD(&sha256_hw_transform_fn);
+	if (transform == 0) {
+		sha256_hw_select(sha256_hw_detected_features());
+		transform = SHA256_HW_LOAD(&sha256_hw_transform_fn);
+	}
+	return transform;
+}
+
+unsigned sha256_hw_supported(void) {
+	return sha256_hw_detected_features();
+}
+
+unsigned sha256_hw_selected(void) {
+	sha256_hw_init();
+	return SHA256_HW_LOAD(&sha256_hw_features);
+}
+
+unsigned sha256_hw_select(unsigned features) {
+	features &= sha256_hw_detected_features();
+	sha256_transform_fn transform = sha256_Transform_portable;
+#ifdef SHA256_HW_X86
+	if (features & SHA256_HW_SHANI) {
+		transform = sha256_Transform_shani;
+	}
+#elif defined(SHA256_HW_ARM)
+	if (features & SHA256_HW_ARMV8) {
+		transform = sha256_Transform_armv8;
+	}
+#endif
+	SHA256_HW_STORE(&sha256_hw_features, features);
+	SHA256_HW_STORE(&sha256_hw_transform_fn, transform);
+	return features;
+}
+
+void sha256_hw_transform(const uint32_t* state_in, const uint32_t* data, uint32_t* state_out) {
+	sha256_hw_init()(state_in, data, state_out);
+}
+
+#ifdef SHA256_HW_X86
+
+/* Number of compressed blocks of a message of `len` bytes, including the padding */
+static size_t sha256_block_count(size_t len) {
+	return (len + 8) / SHA256_BLOCK_LENGTH + 1;
+}
+
+/* Writes block `index` of the padded message, as host order words, into words[..][lane] */
+static void sha256_lane_block(const uint8_t* data, size_t len, size_t index, uint32_t words[16][8], int lane) {
+	uint8_t block[SHA256_BLOCK_LENGTH];
+	const size_t offset = index * SHA256_BLOCK_LENGTH;
+	if (offset + SHA256_BLOCK_LENGTH <= len) {
+		memcpy(block, data + offset, SHA256_BLOCK_LENGTH);
+	} else {
+		memset(block, 0, SHA256_BLOCK_LENGTH);
+		if (offset <= len) {
+			if (len > offset) {
+				memcpy(block, data + offset, len - offset);
+			}
+			block[len - offset] = 0x80;
+		}
+		if (index + 1 == sha256_block_count(len)) {
+			const uint64_t bitcount = (uint64_t)len << 3;
+			for (int i = 0; i < 8; i++) {
+				block[SHA256_BLOCK_LENGTH - 1 - i] = (uint8_t)(bitcount >> (8 * i));
+			}
+		}
+	}
+	for (int j = 0; j < 16; j++) {
+		words[j][lane] = ((uint32_t)block[4 * j] << 24) | ((uint32_t)block[4 * j + 1] << 16) |
+			((uint32_t)block[4 * j + 2] << 8) | (uint32_t)block[4 * j + 3];
+	}
+	memzero(block, sizeof(block));
+}
+
+static void sha256_Raw_batch_avx2(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests) {
+	static const uint32_t initial[8] = {
+		0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+		0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL,
+	};
+	uint32_t state[8][8];
+	uint32_t words[16][8];
+	size_t message[8] = {0};
+	size_t block[8] = {0};
+	int active[8] = {0};
+	size_t next = 0;
+	int remaining = 0;
+
+	memset(words, 0, sizeof(words));
+	memset(state, 0, sizeof(state));
+	for (int lane = 0; lane < 8 && next < count; lane++, next++) {
+		message[lane] = next;
+		active[lane] = 1;
+		remaining++;
+		for (int i = 0; i < 8; i++) {
+			state[i][lane] = initial[i];
+		}
+	}
+
+	while (remaining > 0) {
+		/* Idle lanes compress leftover words, their results are ignored */
+		for (int lane = 0; lane < 8; lane++) {
+			if (active[lane]) {
+				sha256_lane_block(data[message[lane]], len[message[lane]], block[lane], words, lane);
+			}
+		}
+		sha256_Transform_x8_avx2(state, words);
+		for (int lane = 0; lane < 8; lane++) {
+			if (!active[lane] || ++block[lane] < sha256_block_count(len[message[lane]])) {
+				continue;
+			}
+			uint8_t* digest = digests + message[lane] * SHA256_DIGEST_LENGTH;
+			for (int i = 0; i < 8; i++) {
+				digest[4 * i] = (uint8_t)(state[i][lane] >> 24);
+				digest[4 * i + 1] = (uint8_t)(state[i][lane] >> 16);
+				digest[4 * i + 2] = (uint8_t)(state[i][lane] >> 8);
+				digest[4 * i + 3] = (uint8_t)state[i][lane];
+				state[i][lane] = initial[i];
+			}
+			block[lane] = 0;
+			if (next < count) {
+				message[lane] = next++;
+			} else {
+				active[lane] = 0;
+				remaining--;
+			}
+		}
+	}
+	memzero(state, sizeof(state));
+	memzero(words, sizeof(words));
+}
+
+#endif
+
+void sha256_Raw_batch(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests) {
+	const unsigned features = sha256_hw_selected();
+#ifdef SHA256_HW_X86
+	/* A single SHA extensions stream is faster than AVX2 lanes */
+	if ((features & SHA256_HW_AVX2) && !(features & SHA256_HW_SHANI) && count > 1) {
+		sha256_Raw_batch_avx2(data, len, count, digests);
+		return;
+	}
+#endif
+	for (size_t i = 0; i < count; i++) {
+		sha256_Raw(data[i], len[i], digests + i * SHA256_DIGEST_LENGTH);
+	}
+}
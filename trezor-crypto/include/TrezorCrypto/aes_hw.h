@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __AES_HW_H__
+#define __AES_HW_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <TrezorCrypto/aes.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Hardware accelerated AES
+
+// x86 AES-NI
+#define AES_HW_AESNI 1
+// ARMv8 cryptography extensions
+#define AES_HW_ARMV8 2
+
+// Returns the AES_HW_* features supported by the CPU and the build.
+unsigned aes_hw_supported(void);
+
+// Returns the features in use.
+unsigned aes_hw_selected(void);
+
+// Restricts the implementations in use to `features` (0 selects the portable code),
+// and returns the features actually in use. All supported features are used by default.
+// Not thread-safe: call it before encrypting, or from tests.
+unsigned aes_hw_select(unsigned features);
+
+// The functions below process `blocks` whole blocks with the key schedule of the portable
+// code, and are used by the modes in aes_modes.c. They return 1 on success, or 0 if the
+// hardware is not in use or the context is not keyed, and the portable code must be used.
+
+int aes_hw_ecb_encrypt(const uint8_t *in, uint8_t *out, size_t blocks, const aes_encrypt_ctx *ctx);
+int aes_hw_ecb_decrypt(const uint8_t *in, uint8_t *out, size_t blocks, const aes_decrypt_ctx *ctx);
+int aes_hw_cbc_encrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const aes_encrypt_ctx *ctx);
+int aes_hw_cbc_decrypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *iv, const aes_decrypt_ctx *ctx);
+
+// CTR mode with a 128-bit big-endian counter in `cbuf`, incremented after each block as
+// aes_ctr_cbuf_inc does.
+int aes_hw_ctr_crypt(const uint8_t *in, uint8_t *out, size_t blocks, uint8_t *cbuf, const aes_encrypt_ctx *ctx);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
@@ -31,7 +31,7 @@
 extern "C" {
 #endif
 
-extern const char *BASE32_ALPHABET_RFC4648;
+extern const char *const BASE32_ALPHABET_RFC4648;
 
 char *base32_encode(const uint8_t *in, size_t inlen, char *out, size_t outlen,
                     const char *alphabet);
@@ -25,6 +25,7 @@
 #define __BIP39_H__
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #ifdef __cplusplus
@@ -33,11 +34,22 @@ extern "C" {
 
 #define BIP39_WORDS 2048
 #define BIP39_PBKDF2_ROUNDS 2048
+// Buffer size for the longest mnemonic (24 words of up to 8 letters), with
+// its terminator
+#define BIP39_MNEMONIC_MAX (24 * 10)
 
+// [wallet-core] These return a buffer local to the calling thread, valid until
+// the thread's next call, cleared by mnemonic_clear.
 const char *mnemonic_generate(int strength);  // strength in bits
 const char *mnemonic_from_data(const uint8_t *data, int len);
 void mnemonic_clear(void);
 
+// [wallet-core] Reentrant variants, writing into `mnemonic` of `size` bytes (at
+// least BIP39_MNEMONIC_MAX); return `mnemonic`, or 0 on error.
+const char *mnemonic_generate_r(int strength, char *mnemonic, size_t size);
+const char *mnemonic_from_data_r(const uint8_t *data, int len, char *mnemonic,
+                                 size_t size);
+
 int mnemonic_check(const char *mnemonic);
 
 int mnemonic_to_bits(const char *mnemonic, uint8_t *bits);
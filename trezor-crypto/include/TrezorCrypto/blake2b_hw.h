@@ -0,0 +1,64 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __BLAKE2B_HW_H__
+#define __BLAKE2B_HW_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <TrezorCrypto/blake2b.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Vectorized BLAKE2b
+
+// x86 AVX2, 4 messages at once (blake2b_batch only)
+#define BLAKE2B_HW_AVX2 1
+// ARM NEON, for single messages
+#define BLAKE2B_HW_NEON 2
+
+// Returns the BLAKE2B_HW_* features supported by the CPU and the build.
+unsigned blake2b_hw_supported(void);
+
+// Restricts the implementations in use to `features` (0 selects the portable code),
+// and returns the features actually in use. All supported features are used by default.
+// Not thread-safe: call it before hashing, or from tests.
+unsigned blake2b_hw_select(unsigned features);
+
+// BLAKE2b compression of `block` into `h`, with the counter `t` and the finalization flags `f`.
+// Returns 1 on success, or 0 if no vectorized implementation is in use.
+int blake2b_hw_compress(uint64_t h[8], const uint8_t block[BLAKE2B_BLOCKBYTES], const uint64_t t[2], const uint64_t f[2]);
+
+// Computes the hashes of `count` messages, each one appended to the state `initial`, which is not
+// modified: an initialized state (personalized or keyed), possibly updated with a common prefix.
+// Digests are written consecutively, initial->outlen bytes each.
+// Returns 0 on success, -1 if `initial` is already finalized.
+int blake2b_batch(const blake2b_state *initial, const uint8_t *const *data, const size_t *len, size_t count, uint8_t *digests);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
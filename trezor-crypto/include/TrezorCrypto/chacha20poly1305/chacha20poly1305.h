@@ -5,6 +5,10 @@
 #include <TrezorCrypto/chacha20poly1305/ecrypt-sync.h>
 #include <TrezorCrypto/chacha20poly1305/poly1305-donna.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 typedef struct {
     ECRYPT_ctx       chacha20;
     poly1305_context poly1305;
@@ -16,4 +20,8 @@ void chacha20poly1305_decrypt(chacha20poly1305_ctx *ctx, const uint8_t *in, uint
 void chacha20poly1305_auth(chacha20poly1305_ctx *ctx, const uint8_t *in, size_t n);
 void chacha20poly1305_finish(chacha20poly1305_ctx *ctx, uint8_t mac[16]);
 
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
 #endif // CHACHA20POLY1305_H
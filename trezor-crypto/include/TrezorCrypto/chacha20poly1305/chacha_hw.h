@@ -0,0 +1,63 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __CHACHA_HW_H__
+#define __CHACHA_HW_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Vectorized ChaCha20
+
+// x86 SSE2, 4 blocks at once
+#define CHACHA_HW_SSE2 1
+// x86 AVX2, 8 blocks at once
+#define CHACHA_HW_AVX2 2
+// ARM NEON, 4 blocks at once
+#define CHACHA_HW_NEON 4
+// WebAssembly SIMD128, 4 blocks at once
+#define CHACHA_HW_SIMD128 8
+
+// Returns the CHACHA_HW_* features supported by the CPU and the build.
+unsigned chacha_hw_supported(void);
+
+// Restricts the implementations in use to `features` (0 selects the portable code),
+// and returns the features actually in use. All supported features are used by default.
+// Not thread-safe: call it before encrypting, or from tests.
+unsigned chacha_hw_select(unsigned features);
+
+// XORs `in` with the keystream of up to `blocks` 64-byte blocks of the ChaCha20 state `input`
+// (the ECRYPT_ctx words), and advances the block counter input[12] as ECRYPT_encrypt_bytes does.
+// Returns the number of blocks processed: a multiple of 4, less than `blocks` when the
+// remainder is too short or the counter would wrap, and 0 if no vectorized implementation
+// is in use. The caller processes the remaining blocks.
+size_t chacha_hw_xor_blocks(uint32_t input[16], const uint8_t *in, uint8_t *out, size_t blocks);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
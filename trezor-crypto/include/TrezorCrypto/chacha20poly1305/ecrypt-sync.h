@@ -14,6 +14,10 @@
 
 #include "ecrypt-types.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 /* ------------------------------------------------------------------------- */
 
 /* Cipher parameters */
@@ -278,4 +282,8 @@ void ECRYPT_keystream_blocks(
 
 /* ------------------------------------------------------------------------- */
 
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
 #endif
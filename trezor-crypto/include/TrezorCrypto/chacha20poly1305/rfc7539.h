@@ -3,8 +3,16 @@
 
 #include <TrezorCrypto/chacha20poly1305/chacha20poly1305.h>
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 void rfc7539_init(chacha20poly1305_ctx *ctx, const uint8_t key[32], const uint8_t nonce[12]);
 void rfc7539_auth(chacha20poly1305_ctx *ctx, const uint8_t *in, size_t n);
 void rfc7539_finish(chacha20poly1305_ctx *ctx, int64_t alen, int64_t plen, uint8_t mac[16]);
 
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
 #endif // RFC7539_H
@@ -27,6 +27,7 @@
 #include <stdint.h>
 #include "bignum.h"
 #include "hasher.h"
+#include "rfc6979.h"
 #include <TrezorCrypto/options.h>
 
 #if defined(__cplusplus)
@@ -93,6 +94,12 @@ int ecdsa_sign(const ecdsa_curve *curve, HasherType hasher_sign,
 int ecdsa_sign_digest(const ecdsa_curve *curve, const uint8_t *priv_key,
                       const uint8_t *digest, uint8_t *sig, uint8_t *pby,
                       int (*is_canonical)(uint8_t by, uint8_t sig[64]));
+// [wallet-core] same as ecdsa_sign_digest, with the nonce generator state of
+// priv_key computed beforehand by init_rfc6979_key
+int ecdsa_sign_digest_with_key_state(
+    const ecdsa_curve *curve, const uint8_t *priv_key,
+    const rfc6979_key_state *key_state, const uint8_t *digest, uint8_t *sig,
+    uint8_t *pby, int (*is_canonical)(uint8_t by, uint8_t sig[64]));
 void ecdsa_get_public_key33(const ecdsa_curve *curve, const uint8_t *priv_key,
                             uint8_t *pub_key);
 void ecdsa_get_public_key65(const ecdsa_curve *curve, const uint8_t *priv_key,
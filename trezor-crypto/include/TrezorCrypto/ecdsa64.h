@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __ECDSA64_H__
+#define __ECDSA64_H__
+
+#include <TrezorCrypto/ecdsa.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Point multiplication for secp256k1 and nist256p1 with 4 64-bit limbs
+//
+// Same algorithms as point_multiply and scalar_multiply in ecdsa.c, with Montgomery
+// field arithmetic on 128-bit products instead of the 9 29-bit limbs of bignum256.
+// When USE_ECDSA64 is set, those functions use this engine for the supported curves.
+
+// Returns 1 if the engine is available on this platform (it needs 128-bit integers), 0 otherwise.
+int ecdsa64_supported(void);
+
+// Returns 1 if the engine supports `curve` on this platform, 0 otherwise.
+int ecdsa64_curve_supported(const ecdsa_curve *curve);
+
+// res = k * p, for 0 <= k < curve->order.
+// Returns 0 on success, -1 if the curve is not supported.
+int ecdsa64_point_multiply(const ecdsa_curve *curve, const bignum256 *k, const curve_point *p, curve_point *res);
+
+// res = k * G, for 0 <= k < curve->order.
+// Returns 0 on success, -1 if the curve is not supported.
+int ecdsa64_scalar_multiply(const ecdsa_curve *curve, const bignum256 *k, curve_point *res);
+
+// Computes the verification scalars u1 = z / s and u2 = r / s modulo the curve order,
+// for 0 < s < curve->order and z, r < curve->order.
+// Returns 0 on success, -1 if the curve is not supported.
+int ecdsa64_verify_scalars(const ecdsa_curve *curve, const bignum256 *r, const bignum256 *s, const bignum256 *z,
+                           bignum256 *u1, bignum256 *u2);
+
+// Computes y from x, with the parity of `odd`, as uncompress_coords (p = 3 mod 4 for both curves).
+// Returns 0 on success, -1 if the curve is not supported.
+int ecdsa64_uncompress_coords(const ecdsa_curve *curve, uint8_t odd, const bignum256 *x, bignum256 *y);
+
+// res = u1 * G + u2 * q, for u1, u2 < curve->order, in variable time: only for public inputs,
+// as in signature verification and public key recovery. Uses the GLV endomorphism on secp256k1.
+// Returns 0 on success, -1 if the curve is not supported.
+int ecdsa64_double_multiply(const ecdsa_curve *curve, const bignum256 *u1, const bignum256 *u2, const curve_point *q,
+                            curve_point *res);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
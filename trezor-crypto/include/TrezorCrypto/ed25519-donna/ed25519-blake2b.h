@@ -8,9 +8,15 @@ extern "C" {
 #endif
 
 void ed25519_publickey_blake2b(const ed25519_secret_key sk, ed25519_public_key pk);
+void ed25519_publickey_batch_blake2b(const ed25519_secret_key *sk, size_t num, ed25519_public_key *pk);
 
 int ed25519_sign_open_blake2b(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_batch_blake2b(const unsigned char **m, const size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
 void ed25519_sign_blake2b(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+// [wallet-core] signing with a secret key expanded once, see ed25519_secret_expand_blake2b
+void ed25519_secret_expand_blake2b(const ed25519_secret_key sk, ed25519_expanded_secret_key extsk);
+void ed25519_publickey_expanded_blake2b(const ed25519_expanded_secret_key extsk, ed25519_public_key pk);
+void ed25519_sign_expanded_blake2b(const unsigned char *m, size_t mlen, const ed25519_expanded_secret_key extsk, const ed25519_public_key pk, ed25519_signature RS);
 
 int ed25519_scalarmult_blake2b(ed25519_public_key res, const ed25519_secret_key sk, const ed25519_public_key pk);
 
@@ -62,6 +62,11 @@ void ge25519_set_neutral(ge25519 *r);
 /* computes [s1]p1 + [s2]base */
 void ge25519_double_scalarmult_vartime(ge25519 *r, const ge25519 *p1, const bignum256modm s1, const bignum256modm s2);
 
+#define GE25519_MULTI_SCALARMULT_MAX_POINTS 16
+
+/* computes [s]base + sum([scalars[i]]points[i]), for at most GE25519_MULTI_SCALARMULT_MAX_POINTS points */
+void ge25519_multi_scalarmult_vartime(ge25519 *r, const ge25519 *points, const bignum256modm *scalars, size_t n, const bignum256modm s);
+
 /* computes [s1]p1, constant time */
 void ge25519_scalarmult(ge25519 *r, const ge25519 *p1, const bignum256modm s1);
 
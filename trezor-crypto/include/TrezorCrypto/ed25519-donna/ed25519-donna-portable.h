@@ -9,6 +9,11 @@ extern "C" {
 #endif
 
 #define DONNA_INLINE
+
+/* Radix 2^51 field arithmetic where 64x64->128 bit multiplications are available, unless ED25519_FORCE_32BIT is defined */
+#if defined(__SIZEOF_INT128__) && !defined(ED25519_FORCE_32BIT)
+#define ED25519_64BIT
+#endif
 #undef ALIGN
 #define ALIGN(x) __attribute__((aligned(x)))
 
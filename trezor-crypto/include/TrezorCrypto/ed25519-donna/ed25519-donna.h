@@ -13,7 +13,11 @@
 
 #include <TrezorCrypto/ed25519-donna/ed25519-donna-portable.h>
 
+#if defined(ED25519_64BIT)
+#include <TrezorCrypto/ed25519-donna/curve25519-donna-64bit.h>
+#else
 #include <TrezorCrypto/ed25519-donna/curve25519-donna-32bit.h>
+#endif
 
 #include <TrezorCrypto/ed25519-donna/curve25519-donna-helpers.h>
 
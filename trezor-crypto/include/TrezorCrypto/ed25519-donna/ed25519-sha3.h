@@ -10,7 +10,12 @@ extern "C" {
 void ed25519_publickey_sha3(const ed25519_secret_key sk, ed25519_public_key pk);
 
 int ed25519_sign_open_sha3(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_batch_sha3(const unsigned char **m, const size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
 void ed25519_sign_sha3(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+// [wallet-core] signing with a secret key expanded once, see ed25519_secret_expand_sha3
+void ed25519_secret_expand_sha3(const ed25519_secret_key sk, ed25519_expanded_secret_key extsk);
+void ed25519_publickey_expanded_sha3(const ed25519_expanded_secret_key extsk, ed25519_public_key pk);
+void ed25519_sign_expanded_sha3(const unsigned char *m, size_t mlen, const ed25519_expanded_secret_key extsk, const ed25519_public_key pk, ed25519_signature RS);
 
 int ed25519_scalarmult_sha3(ed25519_public_key res, const ed25519_secret_key sk, const ed25519_public_key pk);
 
@@ -10,18 +10,27 @@ extern "C" {
 typedef unsigned char ed25519_signature[64];
 typedef unsigned char ed25519_public_key[32];
 typedef unsigned char ed25519_secret_key[32];
+// [wallet-core] clamped scalar and nonce prefix of a secret key
+typedef unsigned char ed25519_expanded_secret_key[64];
 
 typedef unsigned char curve25519_key[32];
 
 typedef unsigned char ed25519_cosi_signature[32];
 
 void ed25519_publickey(const ed25519_secret_key sk, ed25519_public_key pk);
+// [wallet-core] public keys of num secret keys, with one field inversion per 16 keys
+void ed25519_publickey_batch(const ed25519_secret_key *sk, size_t num, ed25519_public_key *pk);
 #if USE_CARDANO
 void ed25519_publickey_ext(const ed25519_secret_key sk, const ed25519_secret_key skext, ed25519_public_key pk);
 #endif
 
 int ed25519_sign_open(const unsigned char *m, size_t mlen, const ed25519_public_key pk, const ed25519_signature RS);
+int ed25519_sign_open_batch(const unsigned char **m, const size_t *mlen, const unsigned char **pk, const unsigned char **RS, size_t num, int *valid);
 void ed25519_sign(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_public_key pk, ed25519_signature RS);
+// [wallet-core] signing with a secret key expanded once, see ed25519_secret_expand
+void ed25519_secret_expand(const ed25519_secret_key sk, ed25519_expanded_secret_key extsk);
+void ed25519_publickey_expanded(const ed25519_expanded_secret_key extsk, ed25519_public_key pk);
+void ed25519_sign_expanded(const unsigned char *m, size_t mlen, const ed25519_expanded_secret_key extsk, const ed25519_public_key pk, ed25519_signature RS);
 #if USE_CARDANO
 void ed25519_sign_ext(const unsigned char *m, size_t mlen, const ed25519_secret_key sk, const ed25519_secret_key skext, const ed25519_public_key pk, ed25519_signature RS);
 #endif
@@ -0,0 +1,62 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __GROESTL_HW_H__
+#define __GROESTL_HW_H__
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Hardware accelerated Groestl-512
+
+// x86 AES-NI (with SSSE3)
+#define GROESTL_HW_AESNI 1
+
+// Returns the GROESTL_HW_* features supported by the CPU and the build.
+unsigned groestl_hw_supported(void);
+
+// Returns the features in use.
+unsigned groestl_hw_selected(void);
+
+// Restricts the implementations in use to `features` (0 selects the portable code),
+// and returns the features actually in use. All supported features are used by default.
+// Not thread-safe: call it before hashing, or from tests.
+unsigned groestl_hw_select(unsigned features);
+
+// Groestl-512 compression of a 128 byte block into the chaining state, with the selected implementation.
+void groestl512_hw_compress(uint32_t state[32], const uint8_t block[128]);
+
+// Groestl-512 output transformation of the chaining state, with the selected implementation.
+void groestl512_hw_output(uint32_t state[32]);
+
+// Portable Groestl-512 compression and output transformation.
+void groestl512_compress_portable(uint32_t state[32], const uint8_t block[128]);
+void groestl512_output_portable(uint32_t state[32]);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
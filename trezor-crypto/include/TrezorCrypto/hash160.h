@@ -0,0 +1,48 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __HASH160_H__
+#define __HASH160_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] RIPEMD-160 of SHA-256 (hash160), 8 messages at a time with AVX2 when the CPU supports it
+
+#define HASH160_DIGEST_LENGTH 20
+
+// Computes the RIPEMD-160 of the SHA-256 of a message, the SHA-256 digest staying on the stack.
+void hash160(const uint8_t* data, size_t len, uint8_t digest[HASH160_DIGEST_LENGTH]);
+
+// Computes the hash160 digests of `count` independent messages, digests are written consecutively,
+// HASH160_DIGEST_LENGTH bytes each.
+void hash160_batch(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
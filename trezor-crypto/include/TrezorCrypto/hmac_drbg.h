@@ -40,4 +40,22 @@ void hmac_drbg_reseed(HMAC_DRBG_CTX *ctx, const uint8_t *buf, size_t len,
                       const uint8_t *addin, size_t addin_len);
 void hmac_drbg_generate(HMAC_DRBG_CTX *ctx, uint8_t *buf, size_t len);
 
+// [wallet-core] The part of hmac_drbg_init which depends only on the first
+// HMAC_DRBG_PREFIX_LENGTH bytes of the entropy: the digests of the zero key and
+// the SHA-256 state of the first update after the block of V || 0x00 || prefix.
+#define HMAC_DRBG_PREFIX_LENGTH (SHA256_BLOCK_LENGTH - SHA256_DIGEST_LENGTH - 1)
+
+typedef struct _HMAC_DRBG_PREFIX {
+  uint32_t odig[SHA256_DIGEST_LENGTH / sizeof(uint32_t)];
+  uint32_t inner[SHA256_DIGEST_LENGTH / sizeof(uint32_t)];
+} HMAC_DRBG_PREFIX;
+
+void hmac_drbg_init_prefix(HMAC_DRBG_PREFIX *prefix, const uint8_t *entropy);
+// Same as hmac_drbg_init, for entropy_len >= HMAC_DRBG_PREFIX_LENGTH and a
+// prefix computed from the same entropy.
+void hmac_drbg_init_with_prefix(HMAC_DRBG_CTX *ctx,
+                                const HMAC_DRBG_PREFIX *prefix,
+                                const uint8_t *entropy, size_t entropy_len,
+                                const uint8_t *nonce, size_t nonce_len);
+
 #endif
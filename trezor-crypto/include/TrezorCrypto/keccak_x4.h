@@ -0,0 +1,45 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __KECCAK_X4_H__
+#define __KECCAK_X4_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Keccak-256 of many independent messages, 4 at a time with AVX2 when the CPU supports it
+
+// Computes the Keccak-256 digests of 4 messages, digests are written consecutively, 32 bytes each.
+void keccak_256_x4(const uint8_t* const data[4], const size_t len[4], uint8_t* digests);
+
+// Computes the Keccak-256 digests of `count` messages, digests are written consecutively, 32 bytes each.
+void keccak_256_batch(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
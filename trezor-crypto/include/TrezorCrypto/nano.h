@@ -33,7 +33,7 @@
 extern "C" {
 #endif
 
-extern const char *BASE32_ALPHABET_NANO;
+extern const char *const BASE32_ALPHABET_NANO;
 
 size_t nano_get_address(
     const ed25519_public_key public_key,
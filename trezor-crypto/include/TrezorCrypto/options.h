@@ -41,6 +41,11 @@
 #define USE_INVERSE_FAST 1
 #endif
 
+// use 64-bit limbs for secp256k1 and nist256p1 point multiplication where 128-bit integers are available
+#ifndef USE_ECDSA64
+#define USE_ECDSA64 1 // [wallet-core]
+#endif
+
 // support for printing bignum256 structures via printf
 #ifndef USE_BN_PRINT
 #define USE_BN_PRINT 0
@@ -65,7 +70,7 @@
 
 // implement BIP39 caching
 #ifndef USE_BIP39_CACHE
-#define USE_BIP39_CACHE 1
+#define USE_BIP39_CACHE 0 // [wallet-core] replaced by TW::SeedCache
 #define BIP39_CACHE_SIZE 4
 #endif
 
@@ -99,6 +104,31 @@
 #define USE_KECCAK 1
 #endif
 
+// use hardware accelerated SHA-256 when the CPU supports it
+#ifndef USE_SHA256_HW
+#define USE_SHA256_HW 1 // [wallet-core]
+#endif
+
+// use hardware accelerated Groestl-512 when the CPU supports it
+#ifndef USE_GROESTL_HW
+#define USE_GROESTL_HW 1 // [wallet-core]
+#endif
+
+// use vectorized BLAKE2b when the CPU supports it
+#ifndef USE_BLAKE2B_HW
+#define USE_BLAKE2B_HW 1 // [wallet-core]
+#endif
+
+// use hardware accelerated AES when the CPU supports it
+#ifndef USE_AES_HW
+#define USE_AES_HW 1 // [wallet-core]
+#endif
+
+// use vectorized ChaCha20 when the CPU supports it
+#ifndef USE_CHACHA_HW
+#define USE_CHACHA_HW 1 // [wallet-core]
+#endif
+
 // add way how to mark confidential data
 #ifndef CONFIDENTIAL
 #define CONFIDENTIAL
@@ -24,6 +24,7 @@
 #ifndef __PBKDF2_H__
 #define __PBKDF2_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include <TrezorCrypto/sha2.h>
 
@@ -67,6 +68,19 @@ void pbkdf2_hmac_sha512(const uint8_t *pass, int passlen, const uint8_t *salt,
                         int saltlen, uint32_t iterations, uint8_t *key,
                         int keylen);
 
+// [wallet-core] Number of contexts updated at once by pbkdf2_hmac_sha512_Update_batch
+// with the selected SHA-256/512 hardware features (see sha2_hw.h).
+size_t pbkdf2_hmac_sha512_batch_lanes(void);
+// [wallet-core] Same as pbkdf2_hmac_sha512_Update on each of `count` contexts,
+// computing the iterations of several contexts together when possible.
+void pbkdf2_hmac_sha512_Update_batch(PBKDF2_HMAC_SHA512_CTX *pctx, size_t count,
+                                     uint32_t iterations);
+// [wallet-core] Derives `count` keys of SHA512_DIGEST_LENGTH bytes, written
+// consecutively to `keys`.
+void pbkdf2_hmac_sha512_batch(const uint8_t *const *pass, const int *passlen,
+                              const uint8_t *const *salt, const int *saltlen,
+                              uint32_t iterations, uint8_t *keys, size_t count);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -32,8 +32,27 @@ extern "C" {
 #endif
 
 uint32_t random32(void);
+// [wallet-core] Cryptographically secure random bytes from a ChaCha20 generator
+// of the calling thread, seeded from the entropy source.
 void random_buffer(uint8_t *buf, size_t len);
 
+// [wallet-core] Operating system entropy, the default source. Defined weak:
+// platforms without /dev/urandom provide their own (Android, iOS). Aborts on
+// failure.
+void random_entropy(uint8_t *buf, size_t len);
+
+// [wallet-core] Entropy source seeding the generators instead of
+// random_entropy, e.g. a hardware RNG or HSM: fills `len` bytes, returns 0 on
+// success. A failing source aborts the process. Calls may come from any thread,
+// one at a time. NULL restores random_entropy. Generators of all threads reseed
+// from the new source on their next use.
+typedef int (*random_source_function)(void *context, uint8_t *buf,
+                                      size_t len);
+void random_set_source(random_source_function source, void *context);
+
+// [wallet-core] Generators of all threads reseed on their next use.
+void random_reseed(void);
+
 //uint32_t random_uniform(uint32_t n);
 //void random_permute(char *buf, size_t len);
 
@@ -29,6 +29,10 @@
 #include "bignum.h"
 #include "hmac_drbg.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 // rfc6979 pseudo random number generator state
 typedef HMAC_DRBG_CTX rfc6979_state;
 
@@ -37,4 +41,17 @@ void init_rfc6979(const uint8_t *priv_key, const uint8_t *hash,
 void generate_rfc6979(uint8_t rnd[32], rfc6979_state *rng);
 void generate_k_rfc6979(bignum256 *k, rfc6979_state *rng);
 
+// [wallet-core] key-dependent part of init_rfc6979, shared by all the digests signed with a key
+typedef HMAC_DRBG_PREFIX rfc6979_key_state;
+
+void init_rfc6979_key(const uint8_t *priv_key, rfc6979_key_state *key_state);
+// Same as init_rfc6979, with the key_state of priv_key.
+void init_rfc6979_with_key(const rfc6979_key_state *key_state,
+                           const uint8_t *priv_key, const uint8_t *hash,
+                           rfc6979_state *rng);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
 #endif
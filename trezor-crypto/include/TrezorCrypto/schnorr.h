@@ -42,6 +42,13 @@ typedef struct {
 int schnorr_sign(const ecdsa_curve *curve, const uint8_t *priv_key,
                  const bignum256 *k, const uint8_t *msg, const uint32_t msg_len,
                  schnorr_sign_pair *result);
+// [wallet-core] Same as schnorr_sign, with the compressed public key of priv_key and the
+// compressed commitment point k*G computed by the caller, e.g. once per key and with faster
+// fixed-base multiplication.
+int schnorr_sign_with_commitment(const ecdsa_curve *curve, const uint8_t *priv_key,
+                                 const uint8_t pub_key[33], const bignum256 *k,
+                                 const uint8_t Q_compress[33], const uint8_t *msg,
+                                 const uint32_t msg_len, schnorr_sign_pair *result);
 int schnorr_verify(const ecdsa_curve *curve, const uint8_t *pub_key,
                    const uint8_t *msg, const uint32_t msg_len,
                    const schnorr_sign_pair *sign);
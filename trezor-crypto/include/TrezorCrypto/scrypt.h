@@ -56,6 +56,33 @@ extern "C"{
 int scrypt(const uint8_t *, size_t, const uint8_t *, size_t, uint64_t,
     uint32_t, uint32_t, /*@out@*/ uint8_t *, size_t);
 
+// [wallet-core]
+/**
+ * scrypt_smix_scratch_size(N, r):
+ * Size of the scratch memory needed by scrypt_smix, or 0 if it overflows.
+ */
+size_t scrypt_smix_scratch_size(uint64_t N, uint32_t r);
+
+// [wallet-core]
+/**
+ * scrypt_smix(B, r, N, scratch):
+ * Compute B = SMix_r(B, N) for one of the p lanes of scrypt, the blocks
+ * produced by PBKDF2(P, S, 1, p * 128 * r).  B is 128r bytes; scratch must
+ * be scrypt_smix_scratch_size(N, r) bytes.  Lanes are independent and can be
+ * computed concurrently with separate scratch memory.
+ */
+void scrypt_smix(uint8_t * B, uint32_t r, uint64_t N, void * scratch);
+
+// [wallet-core]
+/**
+ * scrypt_smix_cancellable(B, r, N, scratch, cancelled, context):
+ * Same as scrypt_smix, polling cancelled(context) every 1024 iterations.
+ * Returns -1 as soon as it returns nonzero, B is then left unchanged;
+ * returns 0 when the lane is computed.
+ */
+int scrypt_smix_cancellable(uint8_t * B, uint32_t r, uint64_t N, void * scratch,
+    int (*cancelled)(void *), void * context);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,70 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __SECP256K1_COMB_H__
+#define __SECP256K1_COMB_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Fast secp256k1 public key computation with a precomputed comb table
+
+// Supported window widths, the table has ceil(256 / window) * 2^(window - 1) points of 64 bytes
+#define SECP256K1_COMB_MIN_WINDOW 2
+#define SECP256K1_COMB_MAX_WINDOW 8
+
+// Returns 1 if the engine is available on this platform (it needs 128-bit integers), 0 otherwise.
+int secp256k1_comb_supported(void);
+
+// Returns the size in bytes of the table for the given window width, 0 if the width is not supported.
+size_t secp256k1_comb_table_size(int window);
+
+// Fills `table` (of secp256k1_comb_table_size(window) bytes, 8-byte aligned).
+// Returns 0 on success, -1 if the window width is not supported.
+int secp256k1_comb_build(void* table, int window);
+
+// Computes the compressed public key of `priv_key` with a table built for `window`.
+// Returns 0 on success, -1 if the private key is not valid.
+int secp256k1_comb_get_public_key33(const void* table, int window, const uint8_t* priv_key, uint8_t* pub_key);
+
+// Computes the uncompressed public key of `priv_key` with a table built for `window`.
+// Returns 0 on success, -1 if the private key is not valid.
+int secp256k1_comb_get_public_key65(const void* table, int window, const uint8_t* priv_key, uint8_t* pub_key);
+
+// Computes the compressed public keys of `count` private keys, stored one after the other
+// (32 bytes each), into `pub_keys` (33 bytes each).  The points are converted to affine
+// coordinates with one field inversion per batch (Montgomery's trick) instead of one per key.
+// Returns 0 on success, -1 if a private key is not valid: its public key is zeroed, the others are computed.
+int secp256k1_comb_get_public_keys33(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys);
+
+// Same as secp256k1_comb_get_public_keys33, with uncompressed public keys (65 bytes each).
+int secp256k1_comb_get_public_keys65(const void* table, int window, const uint8_t* priv_keys, size_t count, uint8_t* pub_keys);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2021 Trust Wallet
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining
+ * a copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ * OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES
+ * OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#ifndef __SHA2_HW_H__
+#define __SHA2_HW_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// [wallet-core] Hardware accelerated SHA-256
+
+// x86 SHA extensions
+#define SHA256_HW_SHANI 1
+// ARMv8 cryptography extensions
+#define SHA256_HW_ARMV8 2
+// x86 AVX2, 8 messages at once (sha256_Raw_batch only)
+#define SHA256_HW_AVX2 4
+// x86 AVX2, 4 SHA-512 streams at once (pbkdf2_hmac_sha512_Update_batch only)
+#define SHA512_HW_AVX2 8
+// x86 AVX-512F, 8 SHA-512 streams at once (pbkdf2_hmac_sha512_Update_batch only)
+#define SHA512_HW_AVX512 16
+
+// Returns the SHA256_HW_* and SHA512_HW_* features supported by the CPU and the build.
+unsigned sha256_hw_supported(void);
+
+// Returns the features in use.
+unsigned sha256_hw_selected(void);
+
+// Restricts the implementations in use to `features` (0 selects the portable code),
+// and returns the features actually in use. All supported features are used by default.
+// Not thread-safe: call it before hashing, or from tests.
+unsigned sha256_hw_select(unsigned features);
+
+// SHA-256 compression with the selected implementation, used by sha256_Transform.
+void sha256_hw_transform(const uint32_t* state_in, const uint32_t* data, uint32_t* state_out);
+
+// Portable SHA-256 compression.
+void sha256_Transform_portable(const uint32_t* state_in, const uint32_t* data, uint32_t* state_out);
+
+// Computes the SHA-256 digests of `count` independent messages, digests are written
+// consecutively, SHA256_DIGEST_LENGTH bytes each.
+void sha256_Raw_batch(const uint8_t* const* data, const size_t* len, size_t count, uint8_t* digests);
+
+#ifdef __cplusplus
+} /* end of extern "C" */
+#endif
+
+#endif
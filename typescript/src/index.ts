@@ -6,5 +6,6 @@
 
 import { CoinType } from './generated/core_types'
 import { TW } from './generated/core_proto'
+import { WalletCoreModule, BatchResult, MessageType, signWith } from './wasm'
 
-export { TW, CoinType }
+export { TW, CoinType, WalletCoreModule, BatchResult, MessageType, signWith }
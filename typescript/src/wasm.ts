@@ -0,0 +1,36 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+import { CoinType } from './generated/core_types'
+
+// Bindings of the WebAssembly module (wasm/ in wallet core), loaded with the `WalletCore()` factory
+// of the emscripten generated wallet-core.js. Inputs and outputs are serialized protobuf messages.
+
+export interface BatchResult {
+    output: Uint8Array
+    // TWAnySignerBatchError: 0 none, 1 unsupported coin, 2 signing failed
+    error: number
+}
+
+export interface WalletCoreModule {
+    sign(input: Uint8Array, coin: CoinType): Uint8Array
+    plan(input: Uint8Array, coin: CoinType): Uint8Array
+    // Blocks on the signing threads: call it from a worker or Node.js, not the main browser thread
+    signBatch(inputs: Uint8Array[], coins: CoinType[], threadCount: number): BatchResult[]
+    supportsJSON(coin: CoinType): boolean
+}
+
+// Encoder and decoder of a generated message class, e.g. TW.Ethereum.Proto.SigningInput
+export interface MessageType<T> {
+    encode(message: T): { finish(): Uint8Array }
+    decode(bytes: Uint8Array): T
+}
+
+// Signs a typed signing input, e.g.
+// `signWith(core, TW.Ethereum.Proto.SigningInput, TW.Ethereum.Proto.SigningOutput, input, CoinType.ethereum)`
+export function signWith<I, O>(core: WalletCoreModule, inputType: MessageType<I>, outputType: MessageType<O>, input: I, coin: CoinType): O {
+    return outputType.decode(core.sign(inputType.encode(input).finish(), coin))
+}
@@ -0,0 +1,311 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Batch.h"
+#include "Keys.h"
+#include "Util.h"
+#include "WalletConsole.h"
+
+#include "Coin.h"
+#include "HexCoding.h"
+#include "Mnemonic.h"
+#include "PrivateKey.h"
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+namespace TW::WalletConsole {
+
+using namespace std;
+using namespace TW;
+using json = nlohmann::json;
+
+namespace {
+
+string lower(string s) {
+    Util::toLower(s);
+    return s;
+}
+
+bool isStateCommand(const string& op) {
+    return op == "coin" || op == "setmnemonic" || op == "newmnemonic";
+}
+
+bool isDerivationCommand(const string& op) {
+    return op == "addr" || op == "addrpub" || op == "addrpri" || op == "addrdefault" || op == "addrdp" ||
+           op == "addrxpub" || op == "addrrange" || op == "pridp" || op == "dumpdp" || op == "dumpxpub";
+}
+
+bool needsMnemonic(const string& op) {
+    return op == "addrdefault" || op == "addrdp" || op == "addrrange" || op == "pridp" || op == "dumpxpub";
+}
+
+/// Minimum number of arguments of a derivation command
+size_t minArgs(const string& op) {
+    if (op == "addrxpub" || op == "addrrange") {
+        return 2;
+    }
+    if (op == "addr" || op == "addrpub" || op == "addrpri" || op == "addrdp") {
+        return 1;
+    }
+    return 0;
+}
+
+DerivationPath rangePath(const Coin& coin, const vector<string>& args, size_t index) {
+    DerivationPath dp(args.size() >= 3 ? args[2] : coin.derivPath);
+    dp.setAddress(static_cast<uint32_t>(stoul(args[0]) + index));
+    return dp;
+}
+
+/// Computes item `index` of the job; throws on error. Only reads the job, safe to call from any thread.
+json compute(const string& op, const vector<string>& args, const Coin& coin, const HDWallet* wallet, size_t index) {
+    const auto ctype = TWCoinType(coin.c);
+    if (op == "addr") {
+        return TW::validateAddress(ctype, args[0]);
+    }
+    if (op == "addrpub") {
+        return TW::deriveAddress(ctype, PublicKey(parse_hex(args[0]), TWPublicKeyType(coin.pubKeyType)));
+    }
+    if (op == "addrpri") {
+        return TW::deriveAddress(ctype, PrivateKey(parse_hex(args[0])));
+    }
+    if (op == "addrdefault") {
+        return wallet->deriveAddress(ctype);
+    }
+    if (op == "addrdp") {
+        return TW::deriveAddress(ctype, wallet->getKey(ctype, DerivationPath(args[0])));
+    }
+    if (op == "addrrange") {
+        return TW::deriveAddress(ctype, wallet->getKey(ctype, rangePath(coin, args, index)));
+    }
+    if (op == "addrxpub") {
+        DerivationPath dp(coin.derivPath);
+        dp.setChange(0);
+        dp.setAddress(stoi(args[1]));
+        const auto publicKey = HDWallet::getPublicKeyFromExtended(args[0], ctype, dp);
+        if (!publicKey) {
+            throw invalid_argument("Invalid xpub");
+        }
+        return TW::deriveAddress(ctype, publicKey.value());
+    }
+    if (op == "pridp") {
+        const auto priKey = wallet->getKey(ctype, DerivationPath(args.empty() ? coin.derivPath : args[0]));
+        string res;
+        privateKeyToResult(priKey, res);
+        return res;
+    }
+    if (op == "dumpdp") {
+        return coin.derivPath;
+    }
+    if (op == "dumpxpub") {
+        return wallet->getExtendedPublicKey(TW::purpose(ctype), ctype, TW::xpubVersion(ctype));
+    }
+    throw invalid_argument("Unknown command");
+}
+
+} // namespace
+
+Batch::Batch(istream& in, ostream& out, size_t threadCount)
+    : _in(in), _out(out), _threadCount(threadCount), _coins(_log) {
+    _coins.init();
+    string error;
+    setCoin("btc", error);
+}
+
+void Batch::run() {
+    string line;
+    while (getline(_in, line)) {
+        Util::trimLeft(line);
+        if (WalletConsole::isExit(line)) {
+            break;
+        }
+        executeLine(line);
+    }
+    flush();
+}
+
+void Batch::executeLine(const string& line) {
+    ++_lineNumber;
+    if (line.empty()) {
+        flush();
+        return;
+    }
+
+    Job job;
+    job.id = _lineNumber;
+    if (line[0] == '{') {
+        try {
+            const auto request = json::parse(line);
+            if (request.contains("id")) {
+                job.id = request["id"];
+            }
+            job.cmd = request.value("cmd", "");
+            for (const auto& arg : request.value("args", json::array())) {
+                job.args.push_back(arg.is_string() ? arg.get<string>() : arg.dump());
+            }
+        } catch (const exception& ex) {
+            job.error = string("Invalid JSON request: ") + ex.what();
+        }
+    } else {
+        auto params = Util::tokenize(line);
+        job.cmd = params[0];
+        job.args.assign(params.begin() + 1, params.end());
+    }
+
+    const auto op = lower(job.cmd);
+    if (job.error.empty() && isStateCommand(op)) {
+        // following commands depend on the new state
+        flush();
+        string error;
+        if (op == "coin") {
+            if (job.args.empty()) {
+                writeError(job.id, job.cmd, "Missing coin");
+            } else if (setCoin(job.args[0], error)) {
+                writeResult(job.id, job.cmd, _activeCoin.id);
+            } else {
+                writeError(job.id, job.cmd, error);
+            }
+        } else if (op == "setmnemonic") {
+            string mnemonic;
+            for (const auto& word : job.args) {
+                mnemonic += (mnemonic.empty() ? "" : " ") + word;
+            }
+            if (!Mnemonic::isValid(mnemonic)) {
+                writeError(job.id, job.cmd, "Not a valid mnemonic");
+            } else {
+                _wallet = make_shared<const HDWallet>(mnemonic, "");
+                writeResult(job.id, job.cmd, job.args.size());
+            }
+        } else {
+            try {
+                const int strength = job.args.empty() ? 256 : stoi(job.args[0]);
+                if (strength < 128 || strength > 256 || (strength % 32 != 0)) {
+                    throw invalid_argument("strength must be between 128 and 256, and multiple of 32");
+                }
+                _wallet = make_shared<const HDWallet>(strength, "");
+                writeResult(job.id, job.cmd, _wallet->mnemonic);
+            } catch (const exception& ex) {
+                writeError(job.id, job.cmd, ex.what());
+            }
+        }
+        return;
+    }
+
+    size_t items = 1;
+    if (!job.error.empty()) {
+        items = 0;
+    } else if (!isDerivationCommand(op)) {
+        job.error = "Command not supported in batch mode: " + job.cmd;
+    } else if (job.args.size() < minArgs(op)) {
+        job.error = "Missing argument";
+    } else if (needsMnemonic(op) && _wallet == nullptr) {
+        job.error = "No mnemonic set";
+    } else if (op == "addrrange") {
+        try {
+            items = stoul(job.args[1]);
+            job.range = true;
+        } catch (const exception&) {
+            job.error = "Invalid count: " + job.args[1];
+        }
+    }
+    if (!job.error.empty()) {
+        items = 0;
+    }
+    job.coin = _activeCoin;
+    job.wallet = _wallet;
+    job.results.resize(items);
+    job.errors.resize(items);
+    _pending.push_back(move(job));
+    _pendingItems += items;
+    if (_pendingItems >= windowSize) {
+        flush();
+    }
+}
+
+void Batch::flush() {
+    // Items handed to a thread at a time
+    const size_t chunkSize = 16;
+
+    vector<pair<size_t, size_t>> items;
+    items.reserve(_pendingItems);
+    for (size_t j = 0; j < _pending.size(); ++j) {
+        for (size_t i = 0; i < _pending[j].results.size(); ++i) {
+            items.emplace_back(j, i);
+        }
+    }
+
+    atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (auto first = next.fetch_add(chunkSize); first < items.size(); first = next.fetch_add(chunkSize)) {
+            const auto last = min(first + chunkSize, items.size());
+            for (auto k = first; k < last; ++k) {
+                auto& job = _pending[items[k].first];
+                const auto index = items[k].second;
+                try {
+                    job.results[index] = compute(lower(job.cmd), job.args, job.coin, job.wallet.get(), index);
+                } catch (const exception& ex) {
+                    job.errors[index] = ex.what();
+                    if (job.errors[index].empty()) {
+                        job.errors[index] = "Error while executing command";
+                    }
+                }
+            }
+        }
+    };
+
+    auto threadCount = _threadCount;
+    if (threadCount == 0) {
+        threadCount = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    threadCount = min(threadCount, (items.size() + chunkSize - 1) / chunkSize);
+    vector<thread> threads;
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    for (const auto& job : _pending) {
+        const auto error = find_if(job.errors.begin(), job.errors.end(), [](const string& e) { return !e.empty(); });
+        if (!job.error.empty()) {
+            writeError(job.id, job.cmd, job.error);
+        } else if (error != job.errors.end()) {
+            writeError(job.id, job.cmd, *error);
+        } else if (job.range) {
+            writeResult(job.id, job.cmd, job.results);
+        } else {
+            writeResult(job.id, job.cmd, job.results[0]);
+        }
+    }
+    _out.flush();
+    _pending.clear();
+    _pendingItems = 0;
+}
+
+bool Batch::setCoin(const string& coinid, string& error) {
+    _log.str("");
+    Coin coin;
+    if (!_coins.findCoin(coinid, coin)) {
+        error = "No such coin: " + coinid;
+        return false;
+    }
+    _activeCoin = coin;
+    return true;
+}
+
+void Batch::writeResult(const json& id, const string& cmd, const json& result) {
+    _out << json{{"id", id}, {"cmd", cmd}, {"result", result}}.dump() << "\n";
+}
+
+void Batch::writeError(const json& id, const string& cmd, const string& error) {
+    _out << json{{"id", id}, {"cmd", cmd}, {"error", error}}.dump() << "\n";
+}
+
+} // namespace TW::WalletConsole
@@ -0,0 +1,84 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#pragma once
+
+#include "Coins.h"
+
+#include "HDWallet.h"
+
+#include <nlohmann/json.hpp>
+
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace TW::WalletConsole {
+
+using namespace std;
+
+/// Non-interactive mode: reads one command per line, writes one JSON result per line.
+///
+/// A line is either console syntax (`addrDP m/84'/0'/0'/0/0`) or a JSON object
+/// (`{"id": 1, "cmd": "addrDP", "args": ["m/84'/0'/0'/0/0"]}`). Results are written in input order as
+/// `{"id": ..., "cmd": ..., "result": ...}` or `{"id": ..., "cmd": ..., "error": "..."}`; without an
+/// id, the line number is used.
+///
+/// Derivation commands do not depend on each other and are computed on a thread pool. `coin`,
+/// `setMnemonic` and `newMnemonic` change the state the following commands use, so the pending
+/// commands are completed before them. An empty line also completes the pending commands, for
+/// callers waiting on results before sending more input.
+class Batch {
+public:
+    /// Commands held before being computed, at most
+    static const size_t windowSize = 4096;
+
+    /// Uses `threadCount` threads, 0 for one per core.
+    Batch(istream& in, ostream& out, size_t threadCount = 0);
+    /// Processes the input until its end, or until `exit` or `quit`.
+    void run();
+    /// Processes one line of input.
+    void executeLine(const string& line);
+    /// Completes the pending commands and writes their results.
+    void flush();
+
+private:
+    /// A command waiting for its results, with the state it was issued in
+    struct Job {
+        nlohmann::json id;
+        string cmd;
+        vector<string> args;
+        Coin coin;
+        shared_ptr<const HDWallet> wallet;
+        /// Set for commands rejected before being computed
+        string error;
+        /// Results are returned as an array (addrRange)
+        bool range = false;
+        /// One result, or error, per item
+        vector<nlohmann::json> results;
+        vector<string> errors;
+    };
+
+    bool setCoin(const string& coinid, string& error);
+    void writeResult(const nlohmann::json& id, const string& cmd, const nlohmann::json& result);
+    void writeError(const nlohmann::json& id, const string& cmd, const string& error);
+
+    istream& _in;
+    ostream& _out;
+    size_t _threadCount;
+    /// Coin lookups report errors to this stream
+    ostringstream _log;
+    Coins _coins;
+    Coin _activeCoin;
+    shared_ptr<const HDWallet> _wallet;
+    vector<Job> _pending;
+    size_t _pendingItems = 0;
+    size_t _lineNumber = 0;
+};
+
+} // namespace TW::WalletConsole
@@ -9,6 +9,7 @@
 #include "Coins.h"
 #include "HexCoding.h"
 #include "Data.h"
+#include "PrivateKey.h"
 
 #include <string>
 #include <iostream>
@@ -17,6 +18,9 @@ namespace TW::WalletConsole {
 
 using namespace std;
 
+/// Hex of the key, with its extension and chain code if any
+void privateKeyToResult(const PrivateKey& priKey, string& res_out);
+
 class Keys {
 private:
     ostream& _out;
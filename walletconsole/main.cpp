@@ -5,9 +5,30 @@
 // file LICENSE at the root of the source code distribution tree.
 
 #include "WalletConsole.h"
+#include "Batch.h"
+
+#include <cstring>
 #include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    bool batch = false;
+    size_t threads = 0;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--batch") == 0) {
+            batch = true;
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::stoul(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--batch [--threads <n>]]" << std::endl;
+            return 1;
+        }
+    }
 
-int main() {
+    if (batch) {
+        TW::WalletConsole::Batch(std::cin, std::cout, threads).run();
+        return 0;
+    }
     TW::WalletConsole::WalletConsole console(std::cin, std::cout);
     console.loop();
 }
@@ -0,0 +1,81 @@
+// Copyright © 2017-2021 Trust Wallet.
+//
+// This file is part of Trust. The full Trust copyright notice, including
+// terms governing use, modification, and redistribution, is contained in the
+// file LICENSE at the root of the source code distribution tree.
+
+#include "Coin.h"
+#include "Data.h"
+
+#include <emscripten/bind.h>
+#include <emscripten/val.h>
+
+#include <utility>
+#include <vector>
+
+using namespace TW;
+using namespace emscripten;
+
+// Signing inputs and outputs cross the JS boundary as serialized protobuf messages in Uint8Arrays,
+// encoded and decoded with the generated protobufjs classes of the package; no JSON in between.
+
+/// Copies a Uint8Array into the module heap with a single TypedArray.set.
+static Data fromUint8Array(const val& array) {
+    Data data(array["length"].as<size_t>());
+    val(typed_memory_view(data.size(), data.data())).call<void>("set", array);
+    return data;
+}
+
+/// Copies bytes out of the module heap; a view into it is detached when the memory grows.
+static val toUint8Array(const Data& data) {
+    return val::global("Uint8Array").new_(typed_memory_view(data.size(), data.data()));
+}
+
+static val sign(const val& input, uint32_t coin) {
+    Data output;
+    anyCoinSign(static_cast<TWCoinType>(coin), fromUint8Array(input), output);
+    return toUint8Array(output);
+}
+
+static val plan(const val& input, uint32_t coin) {
+    Data output;
+    anyCoinPlan(static_cast<TWCoinType>(coin), fromUint8Array(input), output);
+    return toUint8Array(output);
+}
+
+/// Signs `inputs[i]` for `coins[i]` on up to `threadCount` threads (0: one per pool worker).
+/// Returns an array of `{ output, error }`, error being a TWAnySignerBatchError code.
+///
+/// Blocks until all transactions are signed: call it from a worker (or Node.js), the main browser
+/// thread can't wait on the signing threads.
+static val signBatch(const val& inputs, const val& coins, uint32_t threadCount) {
+    const auto count = inputs["length"].as<size_t>();
+    if (coins["length"].as<size_t>() != count) {
+        val::global("Error").new_(std::string("inputs and coins differ in length")).throw_();
+    }
+    std::vector<std::pair<TWCoinType, Data>> batch;
+    batch.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        batch.emplace_back(static_cast<TWCoinType>(coins[i].as<uint32_t>()), fromUint8Array(inputs[i]));
+    }
+
+    const auto results = anyCoinSignBatch(batch, threadCount);
+
+    auto array = val::array();
+    for (const auto& result : results) {
+        auto item = val::object();
+        item.set("output", toUint8Array(result.output));
+        item.set("error", static_cast<int>(result.error));
+        array.call<void>("push", item);
+    }
+    return array;
+}
+
+EMSCRIPTEN_BINDINGS(wallet_core) {
+    function("sign", &sign);
+    function("plan", &plan);
+    function("signBatch", &signBatch);
+    function("supportsJSON", optional_override([](uint32_t coin) {
+        return supportsJSONSigning(static_cast<TWCoinType>(coin));
+    }));
+}